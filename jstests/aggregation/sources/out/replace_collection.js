@@ -87,4 +87,23 @@ assert.commandWorked(targetColl.insert({_id: 1, a: 0}));
 coll.aggregate(pipeline);
 assert.eq(1, targetColl.find().itcount());
 assert.eq(2, targetColl.getIndexes().length);
+
+//
+// Test that the indexes of the output collection, which $out builds once all the results have been
+// written, cover every document written.
+//
+coll.drop();
+assert.commandWorked(
+    coll.insert(Array.from({length: 1000}, (_, i) => ({_id: i, a: i % 10, b: i}))));
+dropWithoutImplicitRecreate(targetCollName);
+assert.commandWorked(targetColl.createIndex({a: 1, b: -1}));
+assert.commandWorked(targetColl.createIndex({b: 1}, {unique: true}));
+assert.commandWorked(targetColl.createIndex({a: 1}, {partialFilterExpression: {b: {$gte: 500}}}));
+
+coll.aggregate(pipeline);
+assert.eq(1000, targetColl.find().itcount());
+assert.eq(4, targetColl.getIndexes().length);
+assert.eq(100, targetColl.find({a: 3}).hint({a: 1, b: -1}).itcount());
+assert.eq(1000, targetColl.find({b: {$gte: 0}}).hint({b: 1}).itcount());
+assert.eq(50, targetColl.find({a: 3, b: {$gte: 500}}).hint({a: 1}).itcount());
 }());
@@ -4065,6 +4065,19 @@ var authCommandsLib = {
               {runOnDb: secondDbName, roles: {}}
           ]
         },
+        {
+          testname: "getCPUProfile",
+          command: {getCPUProfile: 1},
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: {__system: 1},
+                privileges: [{resource: {cluster: true}, actions: ["cpuProfiler"]}]
+              },
+              {runOnDb: firstDbName, roles: {}},
+              {runOnDb: secondDbName, roles: {}}
+          ]
+        },
         {
           testname: "getCmdLineOpts",
           command: {getCmdLineOpts: 1},
@@ -6177,6 +6190,27 @@ var authCommandsLib = {
               },
             ]
         },
+        {
+          testname: "aggregate_query_shape_stats",
+          command: {aggregate: 1, pipeline: [{$queryShapeStats: {}}], cursor: {}},
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: roles_monitoring,
+                privileges: [
+                    {resource: {cluster: true}, actions: ["top"]},
+                ],
+              },
+              {
+                runOnDb: firstDbName,
+                roles: roles_monitoring,
+                privileges: [
+                    {resource: {cluster: true}, actions: ["top"]},
+                ],
+                expectFail: true,
+              },
+            ]
+        },
         {
           testname: "validate_db_metadata_command_specific_db",
           command: {
@@ -0,0 +1,53 @@
+// Tests that a top-k sort on the text score only fetches the highest scoring documents from the
+// TEXT_OR stage, and returns the same documents as a full sort.
+// @tags: [
+//   assumes_no_implicit_index_creation,
+//   assumes_unsharded_collection,
+// ]
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+const coll = db.fts_score_sort_limit;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 20; ++i) {
+    // Documents with higher _id mention "apple" more often and so get a higher score.
+    docs.push({_id: i, content: "apple ".repeat(i + 1) + (i % 2 ? "banana" : "cherry")});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({content: "text"}));
+
+const projection = {score: {$meta: "textScore"}};
+const sort = {score: {$meta: "textScore"}};
+
+function assertTopK(search, limit, expectedFetches) {
+    const allResults = coll.find({$text: {$search: search}}, projection).sort(sort).toArray();
+    const topK =
+        coll.find({$text: {$search: search}}, projection).sort(sort).limit(limit).toArray();
+    assert.eq(allResults.slice(0, limit).map((doc) => doc.score),
+              topK.map((doc) => doc.score),
+              tojson(topK));
+
+    const explain = coll.find({$text: {$search: search}}, projection)
+                        .sort(sort)
+                        .limit(limit)
+                        .explain("executionStats");
+    const textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+    assert.neq(null, textOr, tojson(explain));
+    assert.eq(expectedFetches, textOr.fetches, tojson(textOr));
+}
+
+// Only the documents in the top-k set are fetched.
+assertTopK("apple banana", 3, 3);
+assertTopK("apple", 5, 5);
+
+// A limit larger than the number of matching documents fetches all of them.
+assertTopK("banana", 15, 10);
+
+// Negated terms are checked by TEXT_MATCH against the fetched document, so every candidate must
+// be fetched.
+assertTopK("apple -cherry", 3, 20);
+})();
@@ -0,0 +1,51 @@
+/**
+ * Tests that a $nearSphere query over a dense cluster of points surrounded by sparse outliers
+ * returns every point in distance order, while the annulus sizes adapt to the changing density.
+ *
+ * @tags: [
+ *   assumes_read_concern_local,
+ * ]
+ */
+(function() {
+'use strict';
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+
+const coll = db.geo_near_dense_and_sparse;
+coll.drop();
+
+const center = [-73.98, 40.75];
+const docs = [];
+let id = 0;
+
+// A dense cluster within a few hundred meters of the center.
+for (let i = 0; i < 1000; ++i) {
+    const coordinates = [center[0] + (i % 40) * 1e-4, center[1] + Math.floor(i / 40) * 1e-4];
+    docs.push({_id: id++, loc: {type: "Point", coordinates: coordinates}});
+}
+// Sparse points spread over the surrounding hundreds of kilometers.
+for (let i = 1; i <= 100; ++i) {
+    docs.push({_id: id++, loc: {type: "Point", coordinates: [center[0] + i * 0.05, center[1]]}});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+const results =
+    coll.aggregate([
+            {$geoNear: {near: {type: "Point", coordinates: center}, distanceField: "dist"}},
+        ])
+        .toArray();
+assert.eq(docs.length, results.length);
+assert.eq(docs.length, new Set(results.map(doc => doc._id)).size);
+for (let i = 1; i < results.length; ++i) {
+    assert.lte(results[i - 1].dist, results[i].dist, results);
+}
+
+const query = {loc: {$nearSphere: {$geometry: {type: "Point", coordinates: center}}}};
+assert.eq(docs.length, coll.find(query).itcount());
+
+const explain = coll.find(query).explain("executionStats");
+const nearStage = getPlanStage(explain, "GEO_NEAR_2DSPHERE");
+assert.neq(null, nearStage, explain);
+assert.eq(nearStage.inputStages.length, nearStage.searchIntervals.length, explain);
+})();
@@ -65,14 +65,11 @@ TimeseriesTest.run((insert) => {
         {[timeFieldName]: ISODate(), "measurement": {"A": "cpu"}, [metaFieldName]: {a: "A"}};
 
     // Query on a single field that is not the metaField.
-    testDelete([objA], [objA], 0, [{q: {measurement: "cpu"}, limit: 0}], {
-        expectedErrorCode: ErrorCodes.InvalidOptions
-    });
+    testDelete([objA], [objA], 0, [{q: {measurement: "cpu"}, limit: 0}]);
+    testDelete([objA], [], 1, [{q: {measurement: {"A": "cpu"}}, limit: 0}]);
 
     // Query on the "meta" field.
-    testDelete([objA], [objA], 0, [{q: {"meta": "A"}, limit: 0}], {
-        expectedErrorCode: ErrorCodes.InvalidOptions
-    });
+    testDelete([objA], [objA], 0, [{q: {"meta": "A"}, limit: 0}]);
 
     // Query on a single field that is the metaField using dot notation.
     testDelete([objA], [], 1, [{q: {[metaFieldName + ".a"]: "A"}, limit: 0}]);
@@ -89,11 +86,20 @@ TimeseriesTest.run((insert) => {
         {[timeFieldName]: ISODate(), "measurement": {"A": "cpu"}, [metaFieldName]: {d: "D"}};
 
     // Query on a single field that is not the metaField using dot notation.
-    testDelete([objA, objB, objC],
-               [objA, objB, objC],
-               0,
-               [{q: {"measurement.A": "cpu"}, limit: 0}],
-               {expectedErrorCode: ErrorCodes.InvalidOptions});
+    testDelete([objA, objB, objC], [], 3, [{q: {"measurement.A": "cpu"}, limit: 0}]);
+
+    const objD =
+        {[timeFieldName]: ISODate(), "measurement": {"A": "gpu"}, [metaFieldName]: {a: "A"}};
+
+    // Query on a field that is not the metaField, which deletes some of the measurements of a
+    // bucket.
+    testDelete([objA, objD], [objD], 1, [{q: {"measurement.A": "cpu"}, limit: 0}]);
+
+    // Query on both the metaField and a field that is not the metaField.
+    testDelete([objA, objB, objD],
+               [objB, objD],
+               1,
+               [{q: {"measurement.A": "cpu", [metaFieldName]: {a: "A"}}, limit: 0}]);
 
     // Multiple queries on a single field that is the metaField.
     testDelete([objA, objB, objC], [objB], 2, [
@@ -108,15 +114,13 @@ TimeseriesTest.run((insert) => {
                [
                    {q: {[metaFieldName]: {b: "B"}}, limit: 0},
                    {q: {measurement: "cpu", [metaFieldName]: {b: "B"}}, limit: 0}
-               ],
-               {expectedErrorCode: ErrorCodes.InvalidOptions});
+               ]);
 
     // Multiple queries on a field that is not the metaField.
     testDelete([objA, objB, objC],
                [objA, objB, objC],
                0,
-               [{q: {measurement: "cpu"}, limit: 0}, {q: {measurement: "cpu-1"}, limit: 0}],
-               {expectedErrorCode: ErrorCodes.InvalidOptions});
+               [{q: {measurement: "cpu"}, limit: 0}, {q: {measurement: "cpu-1"}, limit: 0}]);
 
     // Multiple queries on both the metaField and a field that is not the metaField.
     testDelete([objA, objB, objC],
@@ -127,8 +131,7 @@ TimeseriesTest.run((insert) => {
                    {q: {[metaFieldName]: {a: "A"}}, limit: 0},
                    {q: {[metaFieldName]: {d: "D"}}, limit: 0},
                    {q: {measurement: "cpu", [metaFieldName]: {b: "B"}}, limit: 0}
-               ],
-               {expectedErrorCode: ErrorCodes.InvalidOptions});
+               ]);
 
     // Query on a single field that is the metaField using limit: 1.
     testDelete([objA, objB, objC],
@@ -147,7 +150,7 @@ TimeseriesTest.run((insert) => {
                    {q: {[metaFieldName]: {a: "A"}}, limit: 0},
                    {q: {[metaFieldName]: {d: "D"}}, limit: 0}
                ],
-               {expectedErrorCode: ErrorCodes.InvalidOptions, ordered: false});
+               {ordered: false});
 
     const nestedObjA =
         {[timeFieldName]: ISODate(), "measurement": {"A": "cpu"}, [metaFieldName]: {a: {b: "B"}}};
@@ -169,9 +172,7 @@ TimeseriesTest.run((insert) => {
                [{q: {[metaFieldName + ".b.a"]: "A"}, limit: 0}]);
 
     // Query on a field that is the prefix of the metaField.
-    testDelete([objA], [objA], 0, [{q: {[metaFieldName + "b"]: "A"}, limit: 0}], {
-        expectedErrorCode: ErrorCodes.InvalidOptions
-    });
+    testDelete([objA], [objA], 0, [{q: {[metaFieldName + "b"]: "A"}, limit: 0}]);
 
     const objACollation = {[timeFieldName]: ISODate(), [metaFieldName]: "Günter"};
     const objBCollation = {[timeFieldName]: ISODate(), [metaFieldName]: "Gunter"};
@@ -241,10 +242,9 @@ TimeseriesTest.run((insert) => {
 
     // Query for documents using $jsonSchema with a field that is not the metaField required.
     testDelete([nestedObjA, nestedObjB, nestedObjC],
-               [nestedObjA, nestedObjB, nestedObjC],
-               0,
-               [{q: {"$jsonSchema": {"required": [metaFieldName, "measurement"]}}, limit: 0}],
-               {expectedErrorCode: ErrorCodes.InvalidOptions});
+               [],
+               3,
+               [{q: {"$jsonSchema": {"required": [metaFieldName, "measurement"]}}, limit: 0}]);
 
     const nestedMetaObj = {[timeFieldName]: ISODate(), [metaFieldName]: {[metaFieldName]: "A"}};
 
@@ -262,10 +262,7 @@ TimeseriesTest.run((insert) => {
 
     // Query for documents using $jsonSchema with the metaField required and an optional field that
     // is not the metaField.
-    testDelete([objA, nestedMetaObj],
-               [objA, nestedMetaObj],
-               0,
-               [{
+    testDelete([objA, nestedMetaObj], [], 2, [{
                    q: {
                        "$jsonSchema": {
                            "required": [metaFieldName],
@@ -273,8 +270,7 @@ TimeseriesTest.run((insert) => {
                        }
                    },
                    limit: 0
-               }],
-               {expectedErrorCode: ErrorCodes.InvalidOptions});
+               }]);
 
     // Query on the metaField with the metaField nested within nested operators.
     testDelete([objA, objB, objC], [objB, objC], 1, [{
@@ -299,10 +295,13 @@ TimeseriesTest.run((insert) => {
     });
 
     // Query on the "meta" field.
-    testDelete([objA],
-               [objA],
-               0,
+    testDelete([objA], [objA], 0, [{q: {"meta": "A"}, limit: 0}], {includeMetaField: false});
+    const objMetaA = {[timeFieldName]: ISODate(), "meta": "A"};
+    const objMetaB = {[timeFieldName]: ISODate(), "meta": "B"};
+    testDelete([objMetaA, objMetaB],
+               [objMetaB],
+               1,
                [{q: {"meta": "A"}, limit: 0}],
-               {expectedErrorCode: ErrorCodes.InvalidOptions, includeMetaField: false});
+               {includeMetaField: false});
 });
 })();
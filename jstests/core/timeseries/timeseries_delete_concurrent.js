@@ -62,9 +62,12 @@ const validateDeleteIndex =
 
                 assert.commandWorked(testDB.adminCommand(
                     {configureFailPoint: "hangDuringBatchRemove", mode: "alwaysOn"}));
-                assert.commandFailedWithCode(
-                    testDB.runCommand({delete: coll.getName(), deletes: deleteQuery}),
-                    expectedErrorCode);
+                const res = testDB.runCommand({delete: coll.getName(), deletes: deleteQuery});
+                if (expectedErrorCode) {
+                    assert.commandFailedWithCode(res, expectedErrorCode);
+                } else {
+                    assert.eq(assert.commandWorked(res).n, 0);
+                }
 
                 coll.drop();
             },
@@ -118,11 +121,11 @@ validateDeleteIndex([objA],
                     ErrorCodes.NamespaceNotFound,
                     testCases.REPLACE_COLLECTION);
 
-// Attempt to delete from a collection that has been replaced with a new time-series collection with
-// a different metaField.
+// Delete from a collection that has been replaced with a new time-series collection with a
+// different metaField. The query is then on a measurement field, and there are no measurements.
 validateDeleteIndex([objA],
                     [{q: {[metaFieldName]: {a: "A"}}, limit: 0}],
-                    ErrorCodes.InvalidOptions,
+                    null,
                     testCases.REPLACE_METAFIELD,
                     "meta");
 })();
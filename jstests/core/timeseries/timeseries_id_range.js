@@ -55,6 +55,27 @@ TimeseriesTest.run((insert) => {
         assert(dates[5], getPlanStage(expl, "COLLSCAN").maxRecord);
     })();
 
+    (function testIN() {
+        init();
+        for (let i = 0; i < 10; i++) {
+            assert.commandWorked(insert(coll, {_id: i, [timeFieldName]: dates[i]}));
+        }
+
+        const bucketsColl = db.getCollection("system.buckets." + coll.getName());
+        const bucketIds = bucketsColl.find().sort({_id: 1}).toArray().map(bucket => bucket._id);
+        assert.eq(10, bucketIds.length);
+
+        const query = {_id: {$in: [bucketIds[6], bucketIds[2], bucketIds[4]]}};
+        assert.eq(3, bucketsColl.find(query).itcount());
+
+        // The scan is bounded by the smallest and largest values in the $in list.
+        const expl = bucketsColl.find(query).explain("executionStats");
+        const collScan = getPlanStage(expl, "COLLSCAN");
+        assert(collScan.hasOwnProperty("minRecord"), expl);
+        assert(collScan.hasOwnProperty("maxRecord"), expl);
+        assert.eq(5, expl.executionStats.totalDocsExamined, expl);
+    })();
+
     (function testLTE() {
         init();
         // Just for this test, use a more complex pipeline with unwind.
@@ -0,0 +1,45 @@
+// Tests that updates which leave the size of a document unchanged but modify indexed fields, and
+// so may be applied to the record in place, keep the index entries of the document in sync.
+(function() {
+"use strict";
+
+const coll = db.update_indexed_field_in_place;
+coll.drop();
+assert.commandWorked(coll.createIndex({counter: 1}));
+assert.commandWorked(coll.createIndex({"arr.x": 1}));
+assert.commandWorked(coll.createIndex({s: 1}));
+
+const padding = "x".repeat(200 * 1024);
+assert.commandWorked(
+    coll.insert({_id: 0, counter: NumberInt(1), arr: [{x: 1}, {x: 2}], s: "aaaa", padding}));
+
+function assertIndexedOnlyAt(keyPattern, presentKey, absentKey) {
+    const find = (key) => coll.find(key, {_id: 1}).hint(keyPattern).toArray();
+    assert.eq([{_id: 0}], find(presentKey));
+    assert.eq([], find(absentKey));
+}
+
+// Same-size $inc on an indexed int.
+assert.commandWorked(coll.update({_id: 0}, {$inc: {counter: NumberInt(1)}}));
+assertIndexedOnlyAt({counter: 1}, {counter: 2}, {counter: 1});
+
+// Same-size $set of an element of an indexed array.
+assert.commandWorked(coll.update({_id: 0}, {$set: {"arr.0.x": 3}}));
+assertIndexedOnlyAt({"arr.x": 1}, {"arr.x": 3}, {"arr.x": 1});
+assertIndexedOnlyAt({"arr.x": 1}, {"arr.x": 2}, {"arr.x": 1});
+
+// Same-size $set of an indexed string.
+assert.commandWorked(coll.update({_id: 0}, {$set: {s: "bbbb"}}));
+assertIndexedOnlyAt({s: 1}, {s: "bbbb"}, {s: "aaaa"});
+
+// Multi-update through the index being modified must not revisit the document.
+assert.commandWorked(
+    coll.update({counter: {$gte: 0}}, {$inc: {counter: NumberInt(1)}}, {multi: true}));
+assertIndexedOnlyAt({counter: 1}, {counter: 3}, {counter: 2});
+
+const doc = coll.findOne({_id: 0});
+assert.eq(3, doc.counter);
+assert.eq([{x: 3}, {x: 2}], doc.arr);
+assert.eq("bbbb", doc.s);
+assert.eq(padding, doc.padding);
+})();
@@ -319,6 +319,7 @@ let viewsCommandTests = {
     fsyncUnlock: {skip: isUnrelated},
     getAuditConfig: {skip: isUnrelated},
     getDatabaseVersion: {skip: isUnrelated},
+    getCPUProfile: {skip: isUnrelated},
     getCmdLineOpts: {skip: isUnrelated},
     getDefaultRWConcern: {skip: isUnrelated},
     getDiagnosticData: {skip: isUnrelated},
@@ -464,6 +465,7 @@ let viewsCommandTests = {
     profile: {skip: isUnrelated},
     refineCollectionShardKey: {skip: isUnrelated},
     refreshLogicalSessionCacheNow: {skip: isAnInternalCommand},
+    refreshMaterializedView: {skip: "tested in refresh_materialized_view.js"},
     reapLogicalSessionCacheNow: {skip: isAnInternalCommand},
     recipientForgetMigration: {skip: isUnrelated},
     recipientSyncData: {skip: isUnrelated},
@@ -0,0 +1,73 @@
+/**
+ * Checks that a getMore on a tailable, awaitData cursor with 'awaitDataMinBytes' keeps waiting for
+ * inserts after the first result, and returns once the batch is large enough or the coalescing
+ * window has passed.
+ *
+ * @tags: [requires_capped]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const collName = jsTest.name();
+const coll = db.getCollection(collName);
+
+assert.commandWorked(db.createCollection(collName, {capped: true, size: 1024 * 1024}));
+assert.commandWorked(coll.insert({_id: 0}));
+
+function openCursor() {
+    const res = assert.commandWorked(
+        db.runCommand({find: collName, batchSize: 0, tailable: true, awaitData: true}));
+    assert.neq(res.cursor.id, NumberLong(0));
+    // Move the cursor to the end of the collection.
+    assert.eq(coll.count(),
+              assert.commandWorked(db.runCommand(
+                  {getMore: res.cursor.id, collection: collName, maxTimeMS: 1}))
+                  .cursor.nextBatch.length);
+    return res.cursor.id;
+}
+
+// These options are only valid for awaitData cursors.
+let res = assert.commandWorked(db.runCommand({find: collName, batchSize: 0, tailable: true}));
+assert.commandFailedWithCode(
+    db.runCommand({getMore: res.cursor.id, collection: collName, awaitDataMinBytes: 1}),
+    ErrorCodes.BadValue);
+
+// With a small coalescing window, the getMore returns the documents inserted while it waits, even
+// though they do not add up to 'awaitDataMinBytes'.
+let cursorId = openCursor();
+let awaitShell = startParallelShell(
+    funWithArgs(function(dbName, collName) {
+        const coll = db.getSiblingDB(dbName).getCollection(collName);
+        for (let i = 1; i <= 5; i++) {
+            assert.commandWorked(coll.insert({_id: i}));
+            sleep(50);
+        }
+    }, db.getName(), collName), conn.port);
+res = assert.commandWorked(db.runCommand({
+    getMore: cursorId,
+    collection: collName,
+    maxTimeMS: 60 * 1000,
+    awaitDataMinBytes: 1024 * 1024,
+    awaitDataCoalesceMS: 2000
+}));
+awaitShell();
+assert.eq(5, res.cursor.nextBatch.length, tojson(res));
+
+// Once the batch holds 'awaitDataMinBytes', the getMore returns without waiting for the window.
+cursorId = openCursor();
+assert.commandWorked(coll.insert({_id: 6, str: "x".repeat(1024)}));
+const start = Date.now();
+res = assert.commandWorked(db.runCommand({
+    getMore: cursorId,
+    collection: collName,
+    maxTimeMS: 60 * 1000,
+    awaitDataMinBytes: 1024,
+    awaitDataCoalesceMS: 60 * 1000
+}));
+assert.eq(1, res.cursor.nextBatch.length, tojson(res));
+assert.lt(Date.now() - start, 30 * 1000);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,68 @@
+// Tests that consecutive updates by _id in a write batch, which are applied under a single
+// acquisition of the collection lock, give the same results as updates applied one at a time,
+// including when the batch mixes them with other updates and when an ordered batch fails.
+// @tags: [requires_replication]
+(function() {
+"use strict";
+
+const rst = new ReplSetTest(
+    {nodes: 1, nodeOptions: {setParameter: {internalUpdateMaxIdQueryBatchSize: 7}}});
+rst.startSet();
+rst.initiate();
+
+const db = rst.getPrimary().getDB("test");
+const numDocs = 50;
+
+function runBulkUpserts(coll) {
+    // Upserts into a collection which does not exist yet must create it.
+    coll.drop();
+    let bulk = coll.initializeOrderedBulkOp();
+    for (let i = 0; i < numDocs; ++i) {
+        bulk.find({_id: i}).upsert().updateOne({$set: {x: i}});
+    }
+    let res = assert.commandWorked(bulk.execute());
+    assert.eq(numDocs, res.nUpserted);
+
+    // Updates by _id mixed with an update by another field and a multi-update.
+    bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; ++i) {
+        bulk.find({_id: i}).upsert().updateOne({$inc: {x: 1}});
+        if (i % 10 == 0) {
+            bulk.find({x: i + 1}).updateOne({$set: {y: true}});
+            bulk.find({}).update({$inc: {z: 1}});
+        }
+    }
+    for (let i = numDocs; i < 2 * numDocs; ++i) {
+        bulk.find({_id: i}).upsert().replaceOne({x: i});
+    }
+    res = assert.commandWorked(bulk.execute());
+    assert.eq(numDocs, res.nUpserted);
+
+    // An ordered batch stops at the first error.
+    res = db.runCommand({
+        update: coll.getName(),
+        updates: [
+            {q: {_id: 0}, u: {$set: {a: 1}}},
+            {q: {_id: 1}, u: {$set: {_id: 2}}},
+            {q: {_id: 3}, u: {$set: {a: 1}}},
+        ],
+        ordered: true,
+    });
+    assert.commandWorked(res);
+    assert.eq(1, res.n);
+    assert.eq(1, res.writeErrors.length);
+    assert.eq(1, res.writeErrors[0].index);
+
+    return coll.find().sort({_id: 1}).toArray();
+}
+
+const batched = runBulkUpserts(db.bulk_upsert_by_id_batched);
+
+assert.commandWorked(db.adminCommand({setParameter: 1, internalUpdateMaxIdQueryBatchSize: 1}));
+const unbatched = runBulkUpserts(db.bulk_upsert_by_id_unbatched);
+
+assert.eq(2 * numDocs, batched.length);
+assert.docEq(unbatched, batched);
+
+rst.stopSet();
+})();
@@ -0,0 +1,76 @@
+/**
+ * Tests that inserts into an unreplicated capped collection do not wait for a capped delete which
+ * is already in progress as long as the collection is within its slack allowance over the cap, and
+ * that they block once it grows past it.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+
+const localDB = conn.getDB("local");
+const collName = jsTestName();
+const coll = localDB[collName];
+
+// The slack allowance is a tenth of the cap, so about ten of these documents.
+const maxSize = 100 * 1024;
+const pad = "x".repeat(1000);
+assert.commandWorked(localDB.createCollection(collName, {capped: true, size: maxSize}));
+for (let i = 0; i < 200; ++i) {
+    assert.commandWorked(coll.insert({_id: i, pad: pad}));
+}
+assert.lte(coll.stats().size, maxSize);
+
+function countOpsWaitingForCappedDelete() {
+    return conn.getDB("admin")
+        .aggregate([
+            {$currentOp: {allUsers: true, idleConnections: false}},
+            {
+                $match: {
+                    ns: coll.getFullName(),
+                    "waitingForLatch.captureName":
+                        "CollectionImpl::SharedState::_cappedFirstRecordMutex"
+                }
+            },
+        ])
+        .itcount();
+}
+
+// Hold the capped delete of an insert which pushes the collection over its cap.
+const fp =
+    configureFailPoint(conn, "hangWithCappedFirstRecordMutex", {collectionNS: coll.getFullName()});
+const awaitDeletingInsert = startParallelShell(
+    `assert.commandWorked(
+         db.getSiblingDB("local")["${collName}"].insert({_id: 200, pad: "x".repeat(1000)}));`,
+    conn.port);
+fp.wait();
+
+// Other inserts return without waiting for the capped delete, leaving the collection over its cap.
+for (let i = 201; i < 205; ++i) {
+    assert.commandWorked(coll.insert({_id: i, pad: pad}));
+}
+assert.gt(coll.stats().size, maxSize);
+
+// Past the slack allowance, inserts wait for the capped delete in progress.
+const awaitBlockedInserts = startParallelShell(
+    `for (let i = 205; i < 230; ++i) {
+         assert.commandWorked(
+             db.getSiblingDB("local")["${collName}"].insert({_id: i, pad: "x".repeat(1000)}));
+     }`,
+    conn.port);
+assert.soon(() => countOpsWaitingForCappedDelete() === 1);
+
+fp.off();
+awaitDeletingInsert();
+awaitBlockedInserts();
+
+// The capped deletes catch up with the inserts.
+assert.commandWorked(coll.insert({_id: 230, pad: pad}));
+assert.lte(coll.stats().size, maxSize);
+assert.eq(230, coll.find().sort({$natural: -1}).limit(1).next()._id);
+
+MongoRunner.stopMongod(conn);
+})();
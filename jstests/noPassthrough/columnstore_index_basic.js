@@ -0,0 +1,49 @@
+/**
+ * Tests the creation and maintenance of columnstore indexes, which are gated behind a feature
+ * flag.
+ *
+ * @tags: [
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+"use strict";
+
+let conn = MongoRunner.runMongod();
+let testDB = conn.getDB("test");
+assert.commandFailedWithCode(testDB.coll.createIndex({"$**": "columnstore"}),
+                             ErrorCodes.CannotCreateIndex);
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({setParameter: {featureFlagColumnstoreIndexes: true}});
+testDB = conn.getDB("test");
+const coll = testDB.columnstore_index_basic;
+coll.drop();
+
+// Columnstore indexes cannot be compound, sparse or unique.
+assert.commandFailed(coll.createIndex({a: "columnstore", b: 1}));
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {sparse: true}),
+                             ErrorCodes.CannotCreateIndex);
+assert.commandFailedWithCode(coll.createIndex({a: "columnstore"}, {unique: true}),
+                             ErrorCodes.CannotCreateIndex);
+
+assert.commandWorked(coll.createIndex({"$**": "columnstore"}));
+assert.commandWorked(coll.createIndex({"a.b": "columnstore"}));
+
+for (let i = 0; i < 100; ++i) {
+    assert.commandWorked(
+        coll.insert({_id: i, a: {b: i, c: [i, i + 1, i + 2]}, d: "str" + i, e: [{f: i}]}));
+}
+assert.commandWorked(coll.update({_id: 10}, {$set: {"a.b": "updated"}}));
+assert.commandWorked(coll.update({_id: 11}, {$unset: {a: 1}}));
+assert.commandWorked(coll.remove({_id: {$lt: 5}}));
+
+// Queries never use a columnstore index.
+assert.eq(1, coll.find({"a.b": "updated"}).itcount());
+assert.eq(95, coll.find().itcount());
+
+const res = assert.commandWorked(coll.validate({full: true}));
+assert(res.valid, tojson(res));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,40 @@
+/**
+ * Checks that the compact command reclaims space in throttled steps when 'maxCompactMBperSec' is
+ * set, and that it still exits cleanly on EBUSY.
+ *
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {maxCompactMBperSec: 10, compactStepSecs: 1}});
+const db = conn.getDB("test");
+const coll = db.getCollection(jsTest.name());
+
+const bigStr = "x".repeat(1024);
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 20000; i++) {
+    bulk.insert({_id: i, x: i, str: bigStr});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({x: 1}));
+
+// Free most of the space in the files, like a bulk TTL delete would.
+assert.commandWorked(coll.remove({_id: {$gte: 2000}}));
+assert.commandWorked(db.adminCommand({fsync: 1}));
+
+const res = assert.commandWorked(db.runCommand({compact: jsTest.name()}));
+assert.gte(res.bytesFreed, 0, tojson(res));
+assert.eq(2000, coll.find().itcount());
+assert.eq(2000, coll.find({x: {$lt: 2000}}).hint({x: 1}).itcount());
+assert(coll.validate({full: true}).valid);
+
+const failPoints = ["WTCompactRecordStoreEBUSY", "WTCompactIndexEBUSY"];
+for (const failPoint of failPoints) {
+    assert.commandWorked(db.adminCommand({configureFailPoint: failPoint, mode: "alwaysOn"}));
+    assert.commandFailedWithCode(db.runCommand({compact: jsTest.name()}), ErrorCodes.Interrupted);
+    assert.commandWorked(db.adminCommand({configureFailPoint: failPoint, mode: "off"}));
+}
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,49 @@
+/**
+ * Tests that the CPU profiler, started through the cpuProfilerSampleIntervalMicros server
+ * parameter, attributes its samples to the commands that were running.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const testDB = conn.getDB("test");
+const adminDB = conn.getDB("admin");
+const coll = testDB.cpu_profiler;
+
+// Intervals must be 0 or at least a millisecond.
+assert.commandFailedWithCode(
+    adminDB.runCommand({setParameter: 1, cpuProfilerSampleIntervalMicros: 10}), ErrorCodes.BadValue);
+
+const res = adminDB.runCommand({setParameter: 1, cpuProfilerSampleIntervalMicros: 1000});
+if (res.code === ErrorCodes.IllegalOperation) {
+    jsTestLog("Skipping test since the CPU profiler is not available on this platform");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+assert.commandWorked(res);
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; ++i) {
+    bulk.insert({a: i, s: "x".repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+
+// Collection scans with a regex keep the server busy in the find command.
+assert.soon(() => {
+    coll.find({s: /y$/}).itcount();
+    const profile = assert.commandWorked(adminDB.runCommand({getCPUProfile: 1}));
+    assert(profile.running, tojson(profile));
+    return profile.stacks.some(({stack}) => stack.startsWith("find;test.cpu_profiler;"));
+});
+
+assert.commandWorked(adminDB.runCommand({setParameter: 1, cpuProfilerSampleIntervalMicros: 0}));
+let profile = assert.commandWorked(adminDB.runCommand({getCPUProfile: 1, clear: true}));
+assert(!profile.running, tojson(profile));
+assert.gt(profile.samples, 0, tojson(profile));
+
+profile = assert.commandWorked(adminDB.runCommand({getCPUProfile: 1}));
+assert.eq(profile.samples, 0, tojson(profile));
+assert.eq(profile.stacks, [], tojson(profile));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,50 @@
+/**
+ * Tests that a distinct without a query uses a covered DISTINCT_SCAN over a compound index whose
+ * leading field is not the distinct key only when
+ * 'internalQueryPlannerGenerateDistinctScansOnNonLeadingFields' is enabled.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getWinningPlan, isCollscan and planHasStage.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db[jsTestName()];
+
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.insert({a: 1, b: 1, c: i}));
+    assert.commandWorked(coll.insert({a: 1, b: 2, c: i}));
+    assert.commandWorked(coll.insert({a: 2, b: 1, c: i}));
+    assert.commandWorked(coll.insert({a: 2, b: 3, c: i}));
+}
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+
+function setKnob(value) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQueryPlannerGenerateDistinctScansOnNonLeadingFields: value}));
+}
+
+// By default the distinct on 'b' falls back to a collection scan.
+assert.sameMembers([1, 2, 3], coll.distinct('b'));
+let explain = coll.explain("executionStats").distinct('b');
+assert(isCollscan(db, getWinningPlan(explain.queryPlanner)), explain);
+assert.eq(40, explain.executionStats.nReturned);
+
+// With the knob enabled, the distinct scan visits each distinct {a, b} pair of the index once.
+setKnob(true);
+assert.sameMembers([1, 2, 3], coll.distinct('b'));
+explain = coll.explain("executionStats").distinct('b');
+assert(planHasStage(db, getWinningPlan(explain.queryPlanner), "DISTINCT_SCAN"), explain);
+assert(planHasStage(db, getWinningPlan(explain.queryPlanner), "PROJECTION_COVERED"), explain);
+assert.eq(4, explain.executionStats.nReturned);
+
+// A multikey index can only be used for a distinct on its first field.
+assert.commandWorked(coll.insert({a: 3, b: [4, 5]}));
+assert.sameMembers([1, 2, 3, 4, 5], coll.distinct('b'));
+explain = coll.explain().distinct('b');
+assert(isCollscan(db, getWinningPlan(explain.queryPlanner)), explain);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,73 @@
+/**
+ * Tests that the stages of a plan report the CPU time they used in explain and in the profiler
+ * when internalQueryCollectExecutionCpuTime is set.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStage().
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryCollectExecutionCpuTime: true}});
+const testDB = conn.getDB("test");
+const coll = testDB.explain_execution_cpu_time;
+
+// The CPU time of a thread can only be measured on Linux.
+if (testDB.adminCommand("buildInfo").buildEnvironment.target_os !== "linux") {
+    jsTestLog("Skipping test since the CPU time cannot be measured on this platform");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; ++i) {
+    bulk.insert({a: i, b: i % 10});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({a: 1}));
+
+// Checks that every stage of 'stats' that reports its execution time also reports its CPU time,
+// or that none does if 'expectCpuTime' is false. Returns the number of stages checked.
+function checkCpuTime(stats, expectCpuTime) {
+    let numStages = 0;
+    if (stats.hasOwnProperty("executionTimeMillisEstimate")) {
+        ++numStages;
+        if (expectCpuTime) {
+            assert.gte(stats.executionCpuTimeMicros, 0, stats);
+        } else {
+            assert(!stats.hasOwnProperty("executionCpuTimeMicros"), stats);
+        }
+    }
+    for (const child of ["inputStage", "thenStage", "elseStage", "outerStage", "innerStage"]) {
+        if (stats.hasOwnProperty(child)) {
+            numStages += checkCpuTime(stats[child], expectCpuTime);
+        }
+    }
+    for (const child of stats.inputStages || []) {
+        numStages += checkCpuTime(child, expectCpuTime);
+    }
+    return numStages;
+}
+
+let explain = coll.find({a: {$gte: 100}, b: 1}).explain("executionStats");
+assert.gt(checkCpuTime(explain.executionStats.executionStages, true), 0, explain);
+
+explain = coll.explain("executionStats").aggregate([{$group: {_id: "$b", n: {$sum: 1}}}]);
+const groupStage = getAggPlanStage(explain, "$group");
+assert.neq(groupStage, null, explain);
+assert.gte(groupStage.executionCpuTimeMicros, 0, explain);
+assert.gte(groupStage.maxTotalMemoryUsageBytes, 0, explain);
+
+// The profiler records the CPU time of the plan.
+assert.commandWorked(testDB.setProfilingLevel(2));
+assert.eq(coll.find({a: {$gte: 100}, b: 1}).comment("cpuTime").itcount(), 90);
+assert.commandWorked(testDB.setProfilingLevel(0));
+const profileEntry = testDB.system.profile.findOne({"command.comment": "cpuTime"});
+assert.gte(profileEntry.planExecutionCpuMicros, 0, profileEntry);
+
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, internalQueryCollectExecutionCpuTime: false}));
+explain = coll.find({a: {$gte: 100}, b: 1}).explain("executionStats");
+assert.gt(checkCpuTime(explain.executionStats.executionStages, false), 0, explain);
+
+MongoRunner.stopMongod(conn);
+}());
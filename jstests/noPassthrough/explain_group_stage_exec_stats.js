@@ -1,6 +1,6 @@
 /**
- * Tests that $group stage reports memory footprint per accumulator when explain is run with
- * verbosities "executionStats" and "allPlansExecution".
+ * Tests that $group stage reports memory footprint per accumulator and in total when explain is
+ * run with verbosities "executionStats" and "allPlansExecution".
  */
 (function() {
 "use strict";
@@ -69,6 +69,13 @@ function checkGroupStages(stage, expectedAccumMemUsages, isExecExplain, expected
             }
         }
 
+        // The peak of the total also counts the group keys, and is at least the peak of any
+        // accumulator.
+        assert(stage.hasOwnProperty("maxTotalMemoryUsageBytes"), stage);
+        for (const field of Object.keys(maxAccmMemUsages)) {
+            assert.gte(stage.maxTotalMemoryUsageBytes, maxAccmMemUsages[field], stage);
+        }
+
         // Don't verify spill count for debug builds, since for debug builds a spill occurs on every
         // duplicate id in a group.
         if (!debugBuild) {
@@ -80,6 +87,7 @@ function checkGroupStages(stage, expectedAccumMemUsages, isExecExplain, expected
         assert(!stage.hasOwnProperty("usedDisk"), stage);
         assert(!stage.hasOwnProperty("spills"), stage);
         assert(!stage.hasOwnProperty("maxAccumulatorMemoryUsageBytes"), stage);
+        assert(!stage.hasOwnProperty("maxTotalMemoryUsageBytes"), stage);
     }
 
     // Add some wiggle room to the total memory used compared to the limit parameter since the check
@@ -0,0 +1,52 @@
+/**
+ * Tests that histogram-based pruning discards candidate plans which are estimated to be far more
+ * expensive than the best one only when 'internalQueryPlannerHistogramPruningMinCandidates' is set.
+ * The histograms are built from a deterministic sample so that the plans chosen are reproducible.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage, getRejectedPlans and getWinningPlan.
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryHistogramSampleDeterministically: true,
+        internalQueryHistogramSampleSize: 500,
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db[jsTestName()];
+
+assert.commandWorked(
+    coll.insert(Array.from({length: 2000}, (_, i) => ({_id: i, a: i, b: i % 2, c: 0}))));
+assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}, {c: 1}]));
+
+const query = {
+    a: 5,
+    b: 1,
+    c: 0
+};
+
+function runQuery() {
+    assert.eq(1, coll.find(query).itcount());
+    const explain = coll.find(query).explain();
+    const ixscan = getPlanStage(getWinningPlan(explain.queryPlanner), "IXSCAN");
+    assert.neq(null, ixscan, explain);
+    assert.docEq({a: 1}, ixscan.keyPattern, explain);
+    return explain;
+}
+
+// By default every candidate plan takes part in multi-planning.
+let explain = runQuery();
+assert.gte(getRejectedPlans(explain).length, 2, explain);
+
+// Once pruning is enabled, the scans over 'b' and 'c' are estimated to read far more keys than
+// the scan over 'a' and are discarded before multi-planning.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryPlannerHistogramPruningMinCandidates: 2}));
+explain = runQuery();
+assert.eq(0, getRejectedPlans(explain).length, explain);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,43 @@
+/*
+ * Tests that index builds record the duration of the drains that block writes in the
+ * 'metrics.indexBuilds.blockingDrainDurationMillis' serverStatus histogram, and that side writes
+ * drained in key order produce a valid index.
+ */
+(function() {
+"use strict";
+
+load("jstests/noPassthrough/libs/index_build.js");
+
+const conn = MongoRunner.runMongod({});
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.getCollection("coll");
+
+function blockingDrainCount() {
+    const histogram =
+        assert.commandWorked(testDB.serverStatus()).metrics.indexBuilds.blockingDrainDurationMillis;
+    return Object.values(histogram).reduce((total, count) => total + count, 0);
+}
+
+assert.commandWorked(coll.insert({_id: 0, a: 0}));
+const drainsBefore = blockingDrainCount();
+
+IndexBuildTest.pauseIndexBuilds(conn);
+const createIdx = IndexBuildTest.startIndexBuild(conn, coll.getFullName(), {a: 1});
+IndexBuildTest.waitForIndexBuildToScanCollection(testDB, coll.getName(), "a_1");
+
+// Insert keys in descending order so that the side writes are recorded out of key order.
+for (let i = 1000; i > 0; i--) {
+    assert.commandWorked(coll.insert({_id: i, a: i}));
+}
+assert.commandWorked(coll.remove({_id: {$gte: 500}}));
+
+IndexBuildTest.resumeIndexBuilds(conn);
+createIdx();
+
+assert.gt(blockingDrainCount(), drainsBefore);
+assert.eq(500, coll.find().hint({a: 1}).itcount());
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+
+MongoRunner.stopMongod(conn);
+})();
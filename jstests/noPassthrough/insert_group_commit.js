@@ -0,0 +1,101 @@
+/**
+ * Tests that concurrent single-document inserts into a collection are committed together, and that
+ * each operation falls back to inserting its own document when the combined insert fails, either
+ * because one of the documents is a duplicate or because of a write conflict.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+load("jstests/libs/parallel_shell_helpers.js");
+
+const rst = new ReplSetTest(
+    {nodes: 1, nodeOptions: {setParameter: {internalInsertGroupCommitMaxBatchSize: 10}}});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const dbName = "test";
+const collName = jsTestName();
+const testDB = primary.getDB(dbName);
+const coll = testDB[collName];
+assert.commandWorked(coll.insert({_id: "existing"}));
+
+function getGroupCommitMetrics() {
+    return assert.commandWorked(testDB.serverStatus()).metrics.insertGroupCommit;
+}
+
+function insertDoc(dbName, collName, doc, expectedCode) {
+    const res = db.getSiblingDB(dbName)[collName].insert(doc);
+    if (expectedCode) {
+        assert.commandFailedWithCode(res, expectedCode);
+    } else {
+        assert.commandWorked(res);
+    }
+}
+
+function startInsert(doc, expectedCode) {
+    return startParallelShell(funcWithArgs(insertDoc, dbName, collName, doc, expectedCode),
+                              primary.port);
+}
+
+function countWaitingInserts() {
+    return primary.getDB("admin")
+        .aggregate([
+            {$currentOp: {}},
+            {$match: {ns: coll.getFullName(), msg: "waiting for insert group commit"}},
+        ])
+        .itcount();
+}
+
+/**
+ * Inserts 'leaderDoc' and holds it as the leader of the collection's inserts until the inserts of
+ * 'followerDocs' are queued behind it. Once it is done, one of the followers becomes the leader and
+ * commits the other followers' inserts along with its own.
+ */
+function runInserts(leaderDoc, followerDocs) {
+    const fp = configureFailPoint(primary, "hangBeforeInsertGroupCommit");
+    const awaitShells = [startInsert(leaderDoc)];
+    fp.wait();
+
+    for (let {doc, expectedCode} of followerDocs) {
+        awaitShells.push(startInsert(doc, expectedCode));
+    }
+    assert.soon(() => countWaitingInserts() === followerDocs.length + 1);
+
+    fp.off();
+    awaitShells.forEach((awaitShell) => awaitShell());
+}
+
+// The queued inserts are committed as a single batch.
+let metrics = getGroupCommitMetrics();
+runInserts({_id: 0}, [{doc: {_id: 1}}, {doc: {_id: 2}}, {doc: {_id: 3}}]);
+assert.eq(metrics.batches + 1, getGroupCommitMetrics().batches);
+assert.eq(metrics.documents + 3, getGroupCommitMetrics().documents);
+assert.eq(4, coll.find({_id: {$in: [0, 1, 2, 3]}}).itcount());
+
+// A duplicate fails the combined insert, after which only the duplicate insert reports an error.
+metrics = getGroupCommitMetrics();
+runInserts({_id: 4}, [
+    {doc: {_id: 5}},
+    {doc: {_id: "existing"}, expectedCode: ErrorCodes.DuplicateKey},
+    {doc: {_id: 6}},
+]);
+assert.eq(metrics.batches, getGroupCommitMetrics().batches);
+assert.eq(3, coll.find({_id: {$in: [4, 5, 6]}}).itcount());
+
+// So does a write conflict while the leader commits, after which every insert succeeds on its own.
+metrics = getGroupCommitMetrics();
+const wceFp = configureFailPoint(primary, "failInsertGroupCommitWithWriteConflict");
+runInserts({_id: 7}, [{doc: {_id: 8}}, {doc: {_id: 9}}, {doc: {_id: 10}}]);
+wceFp.off();
+assert.eq(metrics.batches, getGroupCommitMetrics().batches);
+assert.eq(4, coll.find({_id: {$in: [7, 8, 9, 10]}}).itcount());
+
+// Each insert is logged once.
+assert.eq(12, primary.getDB("local").oplog.rs.find({op: "i", ns: coll.getFullName()}).itcount());
+
+rst.stopSet();
+})();
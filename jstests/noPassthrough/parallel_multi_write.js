@@ -0,0 +1,71 @@
+/**
+ * Checks that multi-updates and multi-deletes which scan the whole collection write every matching
+ * document exactly once when they are split into ranges of RecordIds written concurrently.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest(
+    {nodes: 1, nodeOptions: {setParameter: {internalMultiWriteMaxParallelism: 4}}});
+rst.startSet();
+rst.initiate();
+
+const db = rst.getPrimary().getDB("test");
+const coll = db.getCollection(jsTest.name());
+const numDocs = 10000;
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; i++) {
+    bulk.insert({_id: i, x: i, n: 0});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({x: 1}));
+
+// Leave gaps in the RecordIds, so that the ranges hold different numbers of documents.
+assert.commandWorked(coll.remove({_id: {$gte: 2000, $lt: 5000}}));
+const numLeft = numDocs - 3000;
+
+let res = assert.commandWorked(coll.updateMany({n: 0}, {$inc: {n: 1}}, {writeConcern: {w: 1}}));
+assert.eq(numLeft, res.matchedCount, tojson(res));
+assert.eq(numLeft, res.modifiedCount, tojson(res));
+assert.eq(numLeft, coll.find({n: 1}).itcount());
+const oplog = rst.getPrimary().getDB("local").oplog.rs;
+assert.eq(numLeft, oplog.find({ns: coll.getFullName(), op: "u"}).itcount());
+
+// A matching document written by several ranges would be incremented more than once.
+res = assert.commandWorked(
+    coll.updateMany({x: {$mod: [2, 0]}}, {$inc: {n: 1}}, {writeConcern: {w: "majority"}}));
+assert.eq(numLeft / 2, res.modifiedCount, tojson(res));
+assert.eq(numLeft / 2, coll.find({n: 2}).itcount());
+assert.eq(0, coll.find({n: {$gt: 2}}).itcount());
+
+// Selective predicates on an index, and writes in a transaction, run as a single plan and must
+// give the same results.
+res = assert.commandWorked(coll.updateMany({x: {$lt: 10}}, {$set: {small: true}}));
+assert.eq(10, res.modifiedCount, tojson(res));
+
+const session = db.getMongo().startSession();
+const sessionColl = session.getDatabase(db.getName()).getCollection(coll.getName());
+session.startTransaction();
+res = assert.commandWorked(sessionColl.updateMany({n: 2}, {$set: {inTxn: true}}));
+assert.eq(numLeft / 2, res.modifiedCount, tojson(res));
+assert.commandWorked(session.commitTransaction_forTesting());
+session.endSession();
+
+// Errors from any range fail the write.
+assert.commandFailedWithCode(coll.updateMany({}, {$inc: {x: "a"}}), ErrorCodes.TypeMismatch);
+
+const numToDelete = coll.find({x: {$mod: [3, 0]}}).itcount();
+res = assert.commandWorked(coll.deleteMany({x: {$mod: [3, 0]}}));
+assert.eq(numToDelete, res.deletedCount, tojson(res));
+assert.eq(numLeft - numToDelete, coll.find().itcount());
+
+res = assert.commandWorked(coll.deleteMany({}));
+assert.eq(numLeft - numToDelete, res.deletedCount, tojson(res));
+assert.eq(0, coll.find().itcount());
+assert(coll.validate({full: true}).valid);
+
+rst.stopSet();
+})();
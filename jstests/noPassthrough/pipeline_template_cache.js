@@ -0,0 +1,67 @@
+/**
+ * Tests that identical aggregate commands against the same collection reuse the cached optimized
+ * pipeline, and that pipelines whose optimized form depends on more than the request are not
+ * cached.
+ */
+(function() {
+"use strict";
+
+const conn =
+    MongoRunner.runMongod({setParameter: {internalQueryEnablePipelineTemplateCache: true}});
+assert.neq(null, conn, "mongod failed to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.pipeline_template_cache;
+coll.drop();
+assert.commandWorked(coll.insert([{_id: 0, a: 1, b: 1}, {_id: 1, a: 1, b: 2}, {_id: 2, a: 2}]));
+
+function getCacheStats() {
+    return assert.commandWorked(testDb.serverStatus()).pipelineTemplateCache;
+}
+
+function runAgg(pipeline, extra) {
+    return coll.aggregate(pipeline, extra).toArray();
+}
+
+// The first execution is a miss that populates the cache, the second reuses the cached pipeline
+// and returns the same results.
+const pipeline = [{$match: {a: 1}}, {$match: {b: {$gt: 1}}}, {$project: {_id: 1}}];
+let stats = getCacheStats();
+assert.eq([{_id: 1}], runAgg(pipeline));
+assert.eq(stats.misses + 1, getCacheStats().misses);
+assert.eq(stats.entries + 1, getCacheStats().entries);
+assert.eq([{_id: 1}], runAgg(pipeline));
+assert.eq(stats.hits + 1, getCacheStats().hits);
+
+// A different constant or collation is a different cache entry.
+stats = getCacheStats();
+assert.eq([], runAgg([{$match: {a: 2}}, {$match: {b: {$gt: 1}}}, {$project: {_id: 1}}]));
+assert.eq([{_id: 1}], runAgg(pipeline, {collation: {locale: "fr"}}));
+assert.eq(stats.hits, getCacheStats().hits);
+
+// $sort absorbs the following $limit, which its serialization does not capture.
+stats = getCacheStats();
+assert.eq([{_id: 2, a: 2}], runAgg([{$sort: {a: -1}}, {$limit: 1}]));
+assert.eq([{_id: 2, a: 2}], runAgg([{$sort: {a: -1}}, {$limit: 1}]));
+assert.eq(stats.uncacheable + 2, getCacheStats().uncacheable);
+assert.eq(stats.entries, getCacheStats().entries);
+
+// Pipelines referring to system variables, 'let' variables or other collections are never
+// looked up.
+stats = getCacheStats();
+runAgg([{$match: {$expr: {$lt: ["$$NOW", new Date(0)]}}}]);
+runAgg([{$match: {$expr: {$eq: ["$a", "$$x"]}}}], {let: {x: 1}});
+runAgg([{$lookup: {from: coll.getName(), as: "self", pipeline: []}}]);
+assert.eq(stats.hits, getCacheStats().hits);
+assert.eq(stats.misses, getCacheStats().misses);
+
+// Dropping and recreating the collection gives it a new UUID, so the cached pipeline is not
+// reused.
+assert(coll.drop());
+assert.commandWorked(coll.insert({_id: 1, a: 1, b: 2}));
+stats = getCacheStats();
+assert.eq([{_id: 1}], runAgg(pipeline));
+assert.eq(stats.hits, getCacheStats().hits);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,70 @@
+/**
+ * Tests that the results of identical find commands are served from the query result cache until a
+ * write to the collection commits.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryEnableResultCache: true}});
+assert.neq(null, conn, "mongod failed to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.query_result_cache;
+coll.drop();
+assert.commandWorked(coll.insert([{_id: 0, a: 1}, {_id: 1, a: 1}, {_id: 2, a: 2}]));
+
+function getCacheStats() {
+    return assert.commandWorked(testDb.serverStatus()).queryResultCache;
+}
+
+function runFind(filter, extra) {
+    const res = assert.commandWorked(
+        testDb.runCommand(Object.assign({find: coll.getName(), filter: filter}, extra)));
+    assert.eq(0, res.cursor.id, tojson(res));
+    return res.cursor.firstBatch;
+}
+
+// The first execution is a miss that populates the cache, the second is served from it.
+let stats = getCacheStats();
+assert.sameMembers([{_id: 0, a: 1}, {_id: 1, a: 1}], runFind({a: 1}));
+assert.eq(stats.hits, getCacheStats().hits);
+assert.sameMembers([{_id: 0, a: 1}, {_id: 1, a: 1}], runFind({a: 1}));
+assert.eq(stats.hits + 1, getCacheStats().hits);
+assert.gt(getCacheStats().sizeEstimateBytes, 0);
+
+// A different constant or option is a different cache entry.
+stats = getCacheStats();
+assert.sameMembers([{_id: 2, a: 2}], runFind({a: 2}));
+assert.eq([{_id: 0, a: 1}], runFind({a: 1}, {limit: 1, sort: {_id: 1}}));
+assert.eq(stats.hits, getCacheStats().hits);
+
+// A committed write invalidates the cached results of the collection.
+assert.commandWorked(coll.insert({_id: 3, a: 1}));
+stats = getCacheStats();
+assert.sameMembers([{_id: 0, a: 1}, {_id: 1, a: 1}, {_id: 3, a: 1}], runFind({a: 1}));
+assert.eq(stats.hits, getCacheStats().hits);
+assert.gt(getCacheStats().invalidations, 0);
+assert.sameMembers([{_id: 0, a: 1}, {_id: 1, a: 1}, {_id: 3, a: 1}], runFind({a: 1}));
+assert.eq(stats.hits + 1, getCacheStats().hits);
+
+assert.commandWorked(coll.update({_id: 0}, {$set: {a: 5}}));
+assert.sameMembers([{_id: 1, a: 1}, {_id: 3, a: 1}], runFind({a: 1}));
+assert.commandWorked(coll.remove({_id: 1}));
+assert.sameMembers([{_id: 3, a: 1}], runFind({a: 1}));
+
+// Queries that depend on more than the data, or that read at a timestamp, are never cached.
+stats = getCacheStats();
+runFind({$expr: {$lt: ["$$NOW", new Date(0)]}});
+runFind({$expr: {$lt: ["$$NOW", new Date(0)]}});
+runFind({a: 1}, {readConcern: {level: "majority"}});
+runFind({a: 1}, {readConcern: {level: "majority"}});
+assert.eq(stats.hits, getCacheStats().hits);
+
+// Dropping and recreating the collection does not serve results of the old collection.
+runFind({a: 1});
+assert(coll.drop());
+assert.commandWorked(coll.insert({_id: 4, a: 1}));
+assert.sameMembers([{_id: 4, a: 1}], runFind({a: 1}));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,55 @@
+/**
+ * Tests that the $queryShapeStats aggregation stage reports the execution statistics of queries
+ * aggregated by query shape.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const testDB = conn.getDB("test");
+const adminDB = conn.getDB("admin");
+const coll = testDB.query_shape_stats;
+
+assert.commandWorked(coll.insert([{a: 1, b: 1}, {a: 2, b: 2}, {a: 3, b: 3}]));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function getQueryShapeStats(queryHash) {
+    return adminDB
+        .aggregate([{$queryShapeStats: {}}, {$match: {queryHash: queryHash}}])
+        .toArray();
+}
+
+const queryHash = coll.find({a: 1}).explain().queryPlanner.queryHash;
+const otherQueryHash = coll.find({b: 2}).explain().queryPlanner.queryHash;
+assert.neq(queryHash, otherQueryHash);
+
+// Start from empty statistics.
+adminDB.aggregate([{$queryShapeStats: {clearStats: true}}]).itcount();
+
+// Queries with the same shape but different constants share a single entry.
+for (let i = 1; i <= 3; ++i) {
+    assert.eq(1, coll.find({a: i}).itcount());
+}
+let stats = getQueryShapeStats(queryHash);
+assert.eq(1, stats.length, tojson(stats));
+assert.eq(3, stats[0].count, tojson(stats));
+assert.eq(3, stats[0].nreturned, tojson(stats));
+assert.gte(stats[0].keysExamined, 3, tojson(stats));
+assert.gte(stats[0].p99ExecMicros, stats[0].p50ExecMicros, tojson(stats));
+assert(stats[0].hasOwnProperty("execMicrosHistogram"), tojson(stats));
+
+// A query of another shape gets its own entry.
+assert.eq(1, coll.find({b: 2}).itcount());
+assert.eq(1, getQueryShapeStats(otherQueryHash).length);
+
+// Clearing the statistics removes every entry.
+adminDB.aggregate([{$queryShapeStats: {clearStats: true}}]).itcount();
+assert.eq(0, getQueryShapeStats(queryHash).length);
+
+// The stage can only run against the admin database.
+assert.commandFailedWithCode(
+    testDB.runCommand({aggregate: 1, pipeline: [{$queryShapeStats: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+
+MongoRunner.stopMongod(conn);
+})();
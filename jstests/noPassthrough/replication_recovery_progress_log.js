@@ -0,0 +1,39 @@
+/**
+ * Tests that startup recovery periodically reports its oplog application progress.
+ *
+ * @tags: [
+ *   requires_persistence,
+ *   requires_replication,
+ * ]
+ */
+(function() {
+'use strict';
+
+load('jstests/libs/fail_point_util.js');
+
+const replTest = new ReplSetTest({nodes: 1});
+replTest.startSet();
+replTest.initiate();
+
+let primary = replTest.getPrimary();
+const testDB = primary.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+const ts = assert.commandWorked(testDB.runCommand({insert: coll.getName(), documents: [{_id: 0}]}))
+               .operationTime;
+configureFailPoint(primary, 'holdStableTimestampAtSpecificTimestamp', {timestamp: ts});
+
+const numDocs = 100;
+for (let i = 1; i <= numDocs; ++i) {
+    assert.commandWorked(coll.insert({_id: i}));
+}
+
+// Log after every batch so that even a short recovery reports its progress.
+replTest.restart(primary, {setParameter: {recoveryProgressLogIntervalSecs: 0}});
+primary = replTest.getPrimary();
+
+checkLog.containsJson(primary, 6170431);
+assert.eq(numDocs + 1, primary.getDB('test').getCollection(jsTestName()).find().itcount());
+
+replTest.stopSet();
+})();
@@ -0,0 +1,103 @@
+/**
+ * Tests that SBE splits an unindexed collection scan across several threads when
+ * 'internalQuerySlotBasedExecutionParallelCollScanDegree' is set and the read is at a point in
+ * time, that the results match those of a serial scan, and that the producers of a parallel scan
+ * do not hold on to their collection lock between getMores.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/sbe_util.js");  // For checkSBEEnabled.
+
+const rst = new ReplSetTest({nodes: [{}, {rsConfig: {priority: 0}}]});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const primaryDB = primary.getDB("test");
+if (!checkSBEEnabled(primaryDB)) {
+    jsTestLog("Skipping test because the SBE feature flag is disabled");
+    rst.stopSet();
+    return;
+}
+
+// Reads on a secondary are at the last applied timestamp, while local reads on the primary are not
+// at a point in time.
+const secondary = rst.getSecondary();
+secondary.setSecondaryOk();
+const secondaryDB = secondary.getDB("test");
+
+const numDocs = 50 * 1000;
+const docs = [];
+for (let i = 0; i < numDocs; ++i) {
+    docs.push({_id: i, a: i % 10, b: "str" + i});
+}
+assert.commandWorked(primaryDB.coll.insertMany(docs, {writeConcern: {w: 2}}));
+assert.commandWorked(primaryDB.other.insertMany(docs, {writeConcern: {w: 2}}));
+
+function setParallelScan(conn, degree, minRecords) {
+    assert.commandWorked(conn.adminCommand({
+        setParameter: 1,
+        internalQuerySlotBasedExecutionParallelCollScanDegree: degree,
+        internalQuerySlotBasedExecutionParallelCollScanMinRecords: minRecords
+    }));
+}
+
+function usesExchange(coll) {
+    const plan = coll.explain().find({a: {$gte: 8}}).finish();
+    return plan.queryPlanner.winningPlan.slotBasedPlan.stages.includes("exchange");
+}
+
+function runQueries(coll, readConcern) {
+    const ids = coll.find().readConcern(readConcern).toArray().map(doc => doc._id);
+    return {
+        all: ids.sort((x, y) => x - y),
+        filtered: coll.find({a: {$gte: 8}}, {_id: 1}).readConcern(readConcern).itcount(),
+        grouped: coll.aggregate([{$match: {a: 3}}, {$group: {_id: null, c: {$sum: 1}}}],
+                                {readConcern: {level: readConcern}})
+                     .toArray(),
+    };
+}
+
+const serialResults = runQueries(primaryDB.coll, "local");
+assert.eq(numDocs, serialResults.all.length);
+assert.eq(numDocs / 5, serialResults.filtered);
+
+setParallelScan(primary, 4, 1000);
+setParallelScan(secondary, 4, 1000);
+
+// Local reads on the primary keep using a serial scan, as the producers would not see the same
+// snapshot of the collection.
+assert(!usesExchange(primaryDB.coll));
+assert.eq(serialResults, runQueries(primaryDB.coll, "local"));
+assert.eq(serialResults, runQueries(primaryDB.coll, "majority"));
+
+assert(usesExchange(secondaryDB.coll));
+assert.eq(serialResults, runQueries(secondaryDB.coll, "local"));
+
+// A query asking for natural order keeps using a serial scan.
+let plan = secondaryDB.coll.explain().find({a: {$gte: 8}}).sort({$natural: 1}).finish();
+assert(!plan.queryPlanner.winningPlan.slotBasedPlan.stages.includes("exchange"), tojson(plan));
+
+// The producers release their collection lock while they wait for the next getMore, so that the
+// secondary can apply a drop of the collection. Reading past the buffered documents then fails.
+let cursor = secondaryDB.other.find().batchSize(10);
+assert(cursor.hasNext());
+assert(primaryDB.other.drop({writeConcern: {w: 2}}));
+const error = assert.throws(() => cursor.itcount());
+assert.commandFailedWithCode(error, [ErrorCodes.NamespaceNotFound, ErrorCodes.QueryPlanKilled]);
+
+// Killing a cursor stops its producers.
+cursor = secondaryDB.coll.find().batchSize(10);
+assert(cursor.hasNext());
+cursor.close();
+assert.eq(serialResults, runQueries(secondaryDB.coll, "local"));
+
+// Collections below the size threshold are scanned serially.
+setParallelScan(secondary, 4, numDocs + 1);
+assert(!usesExchange(secondaryDB.coll));
+
+rst.stopSet();
+})();
@@ -0,0 +1,66 @@
+// Tests that the TTL monitor deletes expired documents from several collections at once in batches,
+// that each delete of a batch is logged with an OpTime of its own, and that the progress of each
+// collection is reported by the "ttl" serverStatus section.
+// @tags: [requires_replication]
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions: {
+        setParameter: {
+            ttlMonitorSleepSecs: 1,
+            ttlMonitorMaxConcurrency: 4,
+            ttlMonitorBatchedDeleteTargetDocs: 7,
+        }
+    }
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const numColls = 3;
+const numDocs = 100;
+
+const expired = new Date(0);
+for (let i = 0; i < numColls; ++i) {
+    const coll = db.getCollection("ttl_batched_parallel_" + i);
+    assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 0}));
+    const docs = [];
+    for (let j = 0; j < numDocs; ++j) {
+        docs.push({_id: j, x: expired});
+    }
+    docs.push({_id: numDocs, x: new Date(Date.now() + 1000 * 60 * 60)});
+    assert.commandWorked(coll.insert(docs));
+}
+
+assert.soon(() => {
+    for (let i = 0; i < numColls; ++i) {
+        if (db.getCollection("ttl_batched_parallel_" + i).count() !== 1) {
+            return false;
+        }
+    }
+    return true;
+}, "TTL monitor didn't delete the expired documents before timing out.");
+
+// Every delete is a separate oplog entry with a distinct timestamp.
+const deletes = primary.getDB("local")
+                    .oplog.rs.find({op: "d", ns: /^test\.ttl_batched_parallel_/})
+                    .toArray();
+assert.eq(numColls * numDocs, deletes.length, tojson(deletes));
+const timestamps = new Set(deletes.map((entry) => tojson(entry.ts)));
+assert.eq(deletes.length, timestamps.size, tojson(deletes));
+
+const ttlStatus = assert.commandWorked(db.adminCommand({serverStatus: 1, ttl: 1})).ttl;
+for (let i = 0; i < numColls; ++i) {
+    const progress = ttlStatus.collections["test.ttl_batched_parallel_" + i];
+    assert(progress, tojson(ttlStatus));
+    assert.eq(numDocs, progress.deletedDocuments, tojson(progress));
+    assert.gte(progress.subPasses, 1, tojson(progress));
+    assert(progress.caughtUp, tojson(progress));
+}
+assert.gte(db.serverStatus().metrics.ttl.subPasses, 1);
+
+rst.stopSet();
+})();
@@ -0,0 +1,50 @@
+/**
+ * Tests that collMod can make a collection resident in the WiredTiger cache, that the setting is
+ * replicated, and that collStats reports the collection's cache usage.
+ * @tags: [
+ *   requires_replication,
+ *   requires_wiredtiger,
+ * ]
+ */
+(function() {
+'use strict';
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB('test');
+const coll = db.getCollection('hot');
+
+assert.commandWorked(coll.insert([{_id: 0}, {_id: 1}, {_id: 2}]));
+
+function creationString(node) {
+    const stats = node.getDB('test').hot.stats();
+    return stats.wiredTiger.creationString;
+}
+
+assert.commandWorked(db.runCommand({collMod: coll.getName(), cacheResident: true}));
+assert.gte(creationString(primary).indexOf('cache_resident=true'), 0, creationString(primary));
+
+rst.awaitReplication();
+const secondary = rst.getSecondary();
+secondary.setSecondaryOk();
+assert.gte(
+    creationString(secondary).indexOf('cache_resident=true'), 0, creationString(secondary));
+
+const storageStats =
+    coll.aggregate([{$collStats: {storageStats: {}}}]).toArray()[0].storageStats;
+assert(storageStats.hasOwnProperty('cacheUsageSize'), tojson(storageStats));
+assert.gt(storageStats.cacheUsageSize, 0, tojson(storageStats));
+
+assert.commandWorked(db.runCommand({collMod: coll.getName(), cacheResident: false}));
+assert.gte(creationString(primary).indexOf('cache_resident=false'), 0, creationString(primary));
+
+// Views have no storage of their own.
+assert.commandWorked(db.createView('hotView', coll.getName(), []));
+assert.commandFailedWithCode(db.runCommand({collMod: 'hotView', cacheResident: true}),
+                             ErrorCodes.InvalidOptions);
+
+rst.stopSet();
+})();
@@ -0,0 +1,39 @@
+/**
+ * Tests that --wiredTigerIndexBlockCompressor sets the block compressor of new indexes, and that
+ * index-specific options still take precedence over it.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+function getCreationString(coll, indexName) {
+    const collStats = assert.commandWorked(coll.runCommand({collStats: coll.getName()}));
+    return collStats.indexDetails[indexName].creationString;
+}
+
+// Indexes are not block compressed by default.
+let conn = MongoRunner.runMongod();
+assert.neq(null, conn, 'mongod was unable to start up');
+let coll = conn.getDB('test').coll;
+assert.commandWorked(coll.createIndex({a: 1}));
+let creationString = getCreationString(coll, 'a_1');
+assert.lte(0, creationString.indexOf('block_compressor=none,'), creationString);
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({wiredTigerIndexBlockCompressor: 'zstd'});
+assert.neq(null, conn, 'mongod was unable to start up');
+coll = conn.getDB('test').coll;
+assert.commandWorked(coll.createIndex({a: 1}));
+creationString = getCreationString(coll, 'a_1');
+assert.lte(0, creationString.indexOf('block_compressor=zstd,'), creationString);
+
+// An index-specific block compressor overrides the system-wide one.
+assert.commandWorked(coll.createIndex(
+    {b: 1}, {storageEngine: {wiredTiger: {configString: 'block_compressor=snappy'}}}));
+creationString = getCreationString(coll, 'b_1');
+assert.lte(0, creationString.indexOf('block_compressor=snappy'), creationString);
+assert.eq(-1, creationString.indexOf('block_compressor=zstd,'), creationString);
+MongoRunner.stopMongod(conn);
+
+assert.throws(() => MongoRunner.runMongod({wiredTigerIndexBlockCompressor: 'lz4'}));
+})();
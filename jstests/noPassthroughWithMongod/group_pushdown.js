@@ -101,11 +101,72 @@ assertNoGroupPushdown(coll,
                       [{$group: {_id: {"i": "$item"}, s: {$sum: "$price"}}}],
                       [{_id: {i: "a"}, s: 15}, {_id: {i: "b"}, s: 30}, {_id: {i: "c"}, s: 5}]);
 
-// Spilling isn't supported yet so $group with 'allowDiskUse' true won't get pushed down.
-assertNoGroupPushdown(coll,
-                      [{$group: {_id: "$item", s: {$sum: "$price"}}}],
-                      [{"_id": "b", "s": 30}, {"_id": "a", "s": 15}, {"_id": "c", "s": 5}],
-                      {allowDiskUse: true, cursor: {batchSize: 1}});
+// $group with 'allowDiskUse' true gets pushed down, and produces the same results when the SBE
+// HashAgg stage has to spill.
+(function() {
+const pipeline = [{$group: {_id: "$item", s: {$sum: "$price"}}}];
+const expectedResults = [{"_id": "b", "s": 30}, {"_id": "a", "s": 15}, {"_id": "c", "s": 5}];
+const options = {allowDiskUse: true, cursor: {batchSize: 1}};
+const explain = coll.explain().aggregate(pipeline, options);
+assert.neq(null, getAggPlanStage(explain, "GROUP"), explain);
+assert.sameMembers(coll.aggregate(pipeline, options).toArray(), expectedResults);
+
+const spillParam = "internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill";
+const originalSpillLimit =
+    assert.commandWorked(db.adminCommand({getParameter: 1, [spillParam]: 1}))[spillParam];
+assert.commandWorked(db.adminCommand({setParameter: 1, [spillParam]: 1}));
+try {
+    assert.sameMembers(coll.aggregate(pipeline, options).toArray(), expectedResults);
+} finally {
+    assert.commandWorked(db.adminCommand({setParameter: 1, [spillParam]: originalSpillLimit}));
+}
+})();
+
+// $unwind stages over the output fields of a pushed down $group are pushed down along with it.
+(function() {
+const pipeline = [
+    {$group: {_id: "$item", p: {$push: "$price"}, q: {$push: "$quantity"}}},
+    {$unwind: "$p"},
+    {$unwind: {path: "$q", includeArrayIndex: "i"}},
+    {$project: {q: 0}}
+];
+const explain = coll.explain().aggregate(pipeline);
+assert(!aggPlanHasStage(explain, "$unwind"), explain);
+assertResultsMatchWithAndWithoutPushdown(coll,
+                                         pipeline,
+                                         [
+                                             {_id: "a", p: 10, i: 0},
+                                             {_id: "a", p: 10, i: 1},
+                                             {_id: "a", p: 5, i: 0},
+                                             {_id: "a", p: 5, i: 1},
+                                             {_id: "b", p: 20, i: 0},
+                                             {_id: "b", p: 20, i: 1},
+                                             {_id: "b", p: 10, i: 0},
+                                             {_id: "b", p: 10, i: 1},
+                                             {_id: "c", p: 5, i: 0},
+                                         ],
+                                         1);
+})();
+
+// An $unwind of an empty array keeps the document only with 'preserveNullAndEmptyArrays', without
+// the unwound field and with a null index.
+assertResultsMatchWithAndWithoutPushdown(
+    coll,
+    [
+        {$match: {item: "c"}},
+        {$group: {_id: "$item", p: {$push: "$missing"}}},
+        {$unwind: {path: "$p", preserveNullAndEmptyArrays: true, includeArrayIndex: "i"}}
+    ],
+    [{_id: "c", i: null}],
+    1);
+
+// An $unwind of a field which the $group does not output is left in the pipeline.
+(function() {
+const explain = coll.explain().aggregate(
+    [{$group: {_id: "$item", p: {$push: "$price"}}}, {$unwind: "$item"}]);
+assert.neq(null, getAggPlanStage(explain, "GROUP"), explain);
+assert(aggPlanHasStage(explain, "$unwind"), explain);
+})();
 
 // Run a pipeline with match, sort, group to check if the whole pipeline gets pushed down.
 assertGroupPushdown(coll,
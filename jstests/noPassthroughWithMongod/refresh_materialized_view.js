@@ -0,0 +1,75 @@
+/**
+ * Tests that refreshMaterializedView folds the documents inserted into the source collection of a
+ * view within a watermark range into the collection storing the results of the view.
+ */
+(function() {
+"use strict";
+
+const testDB = db.getSiblingDB(jsTestName());
+assert.commandWorked(testDB.dropDatabase());
+const source = testDB.orders;
+const totals = testDB.dailyTotals;
+
+assert.commandWorked(testDB.createView("dailyTotalsView", source.getName(), [
+    {$match: {status: "A"}},
+    {$group: {_id: "$day", total: {$sum: "$amount"}, largest: {$max: "$amount"}}},
+]));
+
+function refresh(lowerBound, upperBound) {
+    const cmd = {
+        refreshMaterializedView: "dailyTotalsView",
+        into: totals.getName(),
+        watermarkField: "ts",
+        upperBound: upperBound,
+    };
+    if (lowerBound !== undefined) {
+        cmd.lowerBound = lowerBound;
+    }
+    assert.commandWorked(testDB.runCommand(cmd));
+}
+
+function assertResultsMatchView() {
+    const expected = testDB.dailyTotalsView.find().sort({_id: 1}).toArray();
+    assert.eq(expected, totals.find().sort({_id: 1}).toArray());
+}
+
+assert.commandWorked(source.insert([
+    {ts: 1, day: 1, status: "A", amount: 10},
+    {ts: 2, day: 1, status: "B", amount: 100},
+    {ts: 3, day: 2, status: "A", amount: 5},
+]));
+refresh(undefined, 3);
+assertResultsMatchView();
+
+// Only the documents inserted since the previous refresh are folded in.
+assert.commandWorked(source.insert([
+    {ts: 4, day: 1, status: "A", amount: 20},
+    {ts: 5, day: 3, status: "A", amount: 1},
+]));
+refresh(3, 5);
+assertResultsMatchView();
+assert.docEq({_id: 1, total: 30, largest: 20}, totals.findOne({_id: 1}));
+
+// Documents beyond the upper bound are left for a later refresh.
+assert.commandWorked(source.insert({ts: 6, day: 2, status: "A", amount: 7}));
+refresh(5, 5);
+assert.docEq({_id: 2, total: 5, largest: 5}, totals.findOne({_id: 2}));
+refresh(5, 6);
+assertResultsMatchView();
+
+// Views which cannot be maintained incrementally are rejected.
+assert.commandWorked(
+    testDB.createView("sortedView", source.getName(), [{$sort: {ts: 1}}, {$group: {_id: null}}]));
+let res = testDB.runCommand(
+    {refreshMaterializedView: "sortedView", into: "sorted", watermarkField: "ts", upperBound: 6});
+assert.commandFailedWithCode(res, 5899701);
+
+// So are namespaces which are not views.
+res = testDB.runCommand({
+    refreshMaterializedView: source.getName(),
+    into: totals.getName(),
+    watermarkField: "ts",
+    upperBound: 6,
+});
+assert.commandFailedWithCode(res, ErrorCodes.NamespaceNotFound);
+})();
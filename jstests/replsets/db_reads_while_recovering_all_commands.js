@@ -190,6 +190,7 @@ const allCommands = {
     fsync: {skip: isNotAUserDataRead},
     fsyncUnlock: {skip: isNotAUserDataRead},
     getAuditConfig: {skip: isNotAUserDataRead},
+    getCPUProfile: {skip: isNotAUserDataRead},
     getCmdLineOpts: {skip: isNotAUserDataRead},
     getDatabaseVersion: {skip: isNotAUserDataRead},
     getDefaultRWConcern: {skip: isNotAUserDataRead},
@@ -271,6 +272,7 @@ const allCommands = {
     recipientForgetMigration: {skip: isPrimaryOnly},
     recipientSyncData: {skip: isPrimaryOnly},
     refreshLogicalSessionCacheNow: {skip: isNotAUserDataRead},
+    refreshMaterializedView: {skip: isPrimaryOnly},
     refreshSessions: {skip: isNotAUserDataRead},
     reIndex: {skip: isNotAUserDataRead},
     renameCollection: {skip: isPrimaryOnly},
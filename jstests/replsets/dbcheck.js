@@ -196,8 +196,40 @@ function concurrentTestConsistent() {
     forEachSecondary(secondary => checkLogAllConsistent(secondary, true));
 }
 
+// Check a collection in parallel ranges with the cheaper hash, and with throughput and replication
+// lag limits which are loose enough not to slow the test down.
+function parallelTestConsistent() {
+    let primary = replSet.getPrimary();
+    clearLog();
+
+    let db = primary.getDB(dbName);
+    assert.commandWorked(db.runCommand({
+        "dbCheck": multiBatchSimpleCollName,
+        parallelism: 4,
+        hashType: "murmur3",
+        maxBytesPerSecond: 100 * 1024 * 1024,
+        maxReplicationLagSecs: 60
+    }));
+
+    awaitDbCheckCompletion(db);
+
+    forEachNode(function(node) {
+        checkLogAllConsistent(node);
+        checkTotalCounts(node, node.getDB(dbName)[multiBatchSimpleCollName]);
+
+        let healthlog = node.getDB("local").system.healthlog;
+        assert.eq(healthlog.find({operation: "dbCheckBatch", "data.hashType": {$ne: "murmur3"}})
+                      .itcount(),
+                  0);
+    });
+
+    assert.commandFailedWithCode(
+        db.runCommand({"dbCheck": multiBatchSimpleCollName, parallelism: 0}), ErrorCodes.BadValue);
+}
+
 simpleTestConsistent();
 concurrentTestConsistent();
+parallelTestConsistent();
 
 // Test the various other parameters.
 function testDbCheckParameters() {
@@ -1,6 +1,7 @@
 // Do a transaction and commit with w: majority. Confirm that if there are no writes in the
 // transaction, there is a noop write at the end, and confirm that commitTransaction awaits
-// writeConcern majority.
+// writeConcern majority. A read-only transaction committed with a write concern which does not wait
+// for other nodes has nothing to wait on and must not do the noop write.
 //
 // @tags: [uses_transactions, requires_majority_read_concern]
 (function() {
@@ -23,13 +24,15 @@ const testDB = primary.getDB(dbName);
 testDB.runCommand({drop: name, writeConcern: {w: "majority"}});
 assert.commandWorked(testDB.getCollection(name).insert({}, {writeConcern: {w: "majority"}}));
 
-function runTest({readConcernLevel, shouldWrite, provokeWriteConcernError}) {
+function runTest({readConcernLevel, shouldWrite, provokeWriteConcernError, writeConcern}) {
+    writeConcern = writeConcern || {w: "majority"};
     jsTestLog(`Read concern level "${readConcernLevel}", shouldWrite: ${
-        shouldWrite}, provokeWriteConcernError: ${provokeWriteConcernError}`);
+        shouldWrite}, provokeWriteConcernError: ${provokeWriteConcernError}, writeConcern: ${
+        tojson(writeConcern)}`);
 
     const session = primary.startSession();
     const sessionDB = session.getDatabase(dbName);
-    const txnOptions = {writeConcern: {w: "majority"}};
+    const txnOptions = {writeConcern: Object.assign({}, writeConcern)};
     if (readConcernLevel)
         txnOptions.readConcern = {level: readConcernLevel};
 
@@ -64,7 +67,7 @@ function runTest({readConcernLevel, shouldWrite, provokeWriteConcernError}) {
                         .toArray();
 
     // If the transaction had a write, it should not *also* do a noop.
-    if (shouldWrite) {
+    if (shouldWrite || writeConcern.w === 1) {
         assert.eq(0, entries.length, "shouldn't have written noop oplog entry");
     } else {
         assert.eq(1, entries.length, "should have written noop oplog entry");
@@ -85,6 +88,15 @@ for (let readConcernLevel of [null, "local", "majority", "snapshot"]) {
             });
         }
     }
+
+    for (let writeConcern of [{w: 1}, {w: 1, j: true}]) {
+        runTest({
+            readConcernLevel: readConcernLevel,
+            shouldWrite: false,
+            provokeWriteConcernError: false,
+            writeConcern: writeConcern
+        });
+    }
 }
 
 rst.stopSet();
@@ -155,6 +155,8 @@ function doTest(storageEngine) {
         assert.commandWorked(res);
         assert.eq(res.oplogTruncation.truncateCount, 1, tojson(res.oplogTruncation));
         assert.gt(res.oplogTruncation.totalTimeTruncatingMicros, 0, tojson(res.oplogTruncation));
+        assert.gte(res.oplogTruncation.numStones, 0, tojson(res.oplogTruncation));
+        assert.gte(res.oplogTruncation.bytesPendingTruncation, 0, tojson(res.oplogTruncation));
     } else {
         // Let the oplog cap maintainer thread start truncating the oplog.
         assert.commandWorked(primary.adminCommand(
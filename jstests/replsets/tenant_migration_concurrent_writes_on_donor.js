@@ -794,6 +794,7 @@ const testCases = {
     flushRouterConfig: {skip: isNotRunOnUserDatabase},
     fsync: {skip: isNotRunOnUserDatabase},
     fsyncUnlock: {skip: isNotRunOnUserDatabase},
+    getCPUProfile: {skip: isNotRunOnUserDatabase},
     getCmdLineOpts: {skip: isNotRunOnUserDatabase},
     getDatabaseVersion: {skip: isNotRunOnUserDatabase},
     getDefaultRWConcern: {skip: isNotRunOnUserDatabase},
@@ -577,6 +577,10 @@ let MongosAPIParametersUtil = (function() {
                 command: () => ({fsync: 1})
             }
         },
+        {
+            commandName: "getCPUProfile",
+            skip: "executes locally on mongos (not sent to any remote node)"
+        },
         {
             commandName: "getCmdLineOpts",
             skip: "executes locally on mongos (not sent to any remote node)"
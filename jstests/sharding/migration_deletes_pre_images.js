@@ -0,0 +1,68 @@
+/**
+ * Tests that the deletes done by range deletion after a chunk migration only record pre-images
+ * when 'recordPreImagesForMigrationDeletes' is set, while the other deletes of a collection which
+ * records pre-images always do.
+ *
+ * @tags: [requires_fcv_50]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, rs: {nodes: 1}});
+
+const dbName = "test";
+const collName = jsTestName();
+const ns = dbName + "." + collName;
+const mongosDB = st.s.getDB(dbName);
+const donorOplog = st.rs0.getPrimary().getDB("local").oplog.rs;
+
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+assert.commandWorked(mongosDB.runCommand({create: collName, recordPreImages: true}));
+assert.commandWorked(st.s.adminCommand({shardCollection: ns, key: {_id: 1}}));
+assert.commandWorked(st.s.adminCommand({split: ns, middle: {_id: 0}}));
+assert.commandWorked(st.s.adminCommand({split: ns, middle: {_id: 10}}));
+assert.commandWorked(
+    mongosDB[collName].insert(Array.from({length: 30}, (_, i) => ({_id: i - 10, x: i}))));
+
+function countDonorDeletes(range, withPreImage) {
+    return donorOplog
+        .find({
+            op: "d",
+            ns: ns,
+            "o._id": range,
+            preImageOpTime: {$exists: withPreImage},
+        })
+        .itcount();
+}
+
+// By default the range deleter does not record pre-images.
+assert.commandWorked(st.s.adminCommand({
+    moveChunk: ns,
+    find: {_id: 0},
+    to: st.shard1.shardName,
+    _waitForDelete: true,
+}));
+assert.eq(10, countDonorDeletes({$gte: 0, $lt: 10}, false));
+assert.eq(0, countDonorDeletes({$gte: 0, $lt: 10}, true));
+
+// It does once the parameter is set.
+assert.commandWorked(st.rs0.getPrimary().adminCommand(
+    {setParameter: 1, recordPreImagesForMigrationDeletes: true}));
+assert.commandWorked(st.s.adminCommand({
+    moveChunk: ns,
+    find: {_id: 10},
+    to: st.shard1.shardName,
+    _waitForDelete: true,
+}));
+assert.eq(10, countDonorDeletes({$gte: 10}, true));
+assert.eq(0, countDonorDeletes({$gte: 10}, false));
+
+// Other deletes always record their pre-images.
+assert.commandWorked(st.rs0.getPrimary().adminCommand(
+    {setParameter: 1, recordPreImagesForMigrationDeletes: false}));
+assert.commandWorked(mongosDB[collName].remove({_id: -1}));
+assert.eq(1, countDonorDeletes(-1, true));
+
+st.stop();
+})();
@@ -229,7 +229,7 @@ let testConnReadPreference = function(conn, isMongos, rst, {readPref, expectedNo
             comment: comment
         },
                 allowedOnSecondary.kAlways,
-                false,
+                true,
                 formatProfileQuery(kShardedNs, {aggregate: kShardedCollName, comment: comment}));
     }
 
@@ -245,7 +245,7 @@ let testConnReadPreference = function(conn, isMongos, rst, {readPref, expectedNo
                 comment: comment
             },
             allowedOnSecondary.kAlways,
-            false,
+            true,
             formatProfileQuery(kUnshardedNs, {aggregate: kUnshardedCollName, comment: comment}));
     } else {
         cmdTest({mapreduce: kUnshardedCollName, map: mapFunc, reduce: reduceFunc, out: {inline: 1}},
@@ -317,7 +317,7 @@ let testConnReadPreference = function(conn, isMongos, rst, {readPref, expectedNo
     // Test on sharded
     cmdTest({aggregate: kShardedCollName, pipeline: [{$project: {x: 1}}], cursor: {}},
             allowedOnSecondary.kAlways,
-            false,
+            true,
             formatProfileQuery(kShardedNs, {
                 aggregate: kShardedCollName,
                 pipeline: [isMongos ? {$project: {_id: true, x: true}} : {$project: {x: 1}}]
@@ -326,7 +326,7 @@ let testConnReadPreference = function(conn, isMongos, rst, {readPref, expectedNo
     // Test on non-sharded
     cmdTest({aggregate: kUnshardedCollName, pipeline: [{$project: {x: 1}}], cursor: {}},
             allowedOnSecondary.kAlways,
-            false,
+            true,
             formatProfileQuery(kUnshardedNs,
                                {aggregate: kUnshardedCollName, pipeline: [{$project: {x: 1}}]}));
 
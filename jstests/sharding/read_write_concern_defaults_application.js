@@ -433,6 +433,7 @@ let testCases = {
     fsync: {skip: "does not accept read or write concern"},
     fsyncUnlock: {skip: "does not accept read or write concern"},
     getAuditConfig: {skip: "does not accept read or write concern"},
+    getCPUProfile: {skip: "does not accept read or write concern"},
     getCmdLineOpts: {skip: "does not accept read or write concern"},
     getDatabaseVersion: {skip: "does not accept read or write concern"},
     getDefaultRWConcern: {skip: "does not accept read or write concern"},
@@ -543,6 +544,7 @@ let testCases = {
     recipientSyncData: {skip: "does not accept read or write concern"},
     refineCollectionShardKey: {skip: "does not accept read or write concern"},
     refreshLogicalSessionCacheNow: {skip: "does not accept read or write concern"},
+    refreshMaterializedView: {skip: "not supported in sharded clusters"},
     refreshSessions: {skip: "does not accept read or write concern"},
     refreshSessionsInternal: {skip: "internal command"},
     removeShard: {skip: "does not accept read or write concern"},
@@ -194,6 +194,7 @@ let testCases = {
     fsync: {skip: "does not return user data"},
     fsyncUnlock: {skip: "does not return user data"},
     getAuditConfig: {skip: "does not return user data"},
+    getCPUProfile: {skip: "does not return user data"},
     getCmdLineOpts: {skip: "does not return user data"},
     getDefaultRWConcern: {skip: "does not return user data"},
     getDiagnosticData: {skip: "does not return user data"},
@@ -266,6 +267,7 @@ let testCases = {
     reapLogicalSessionCacheNow: {skip: "does not return user data"},
     refineCollectionShardKey: {skip: "primary only"},
     refreshLogicalSessionCacheNow: {skip: "does not return user data"},
+    refreshMaterializedView: {skip: "primary only"},
     refreshSessions: {skip: "does not return user data"},
     refreshSessionsInternal: {skip: "does not return user data"},
     removeShard: {skip: "primary only"},
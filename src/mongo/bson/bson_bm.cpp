@@ -59,6 +59,19 @@ BSONObj buildSampleObj(long long unsigned int i) {
                        << "random" << random << "phone_no" << phone_no << "long_string"
                        << long_string);
 }
+
+/**
+ * Builds a wide document dominated by string values and long field names, which is the case that
+ * makes the field name scan the bottleneck of validation.
+ */
+BSONObj buildStringHeavyObj(long long unsigned int i) {
+    BSONObjBuilder builder;
+    for (int field = 0; field < 100; ++field) {
+        builder.append(fmt::format("attribute_with_descriptive_name_{:03d}", field),
+                       fmt::format("{}{:x<100s}", i * 7919 + field, ""));
+    }
+    return builder.obj();
+}
 }  // namespace
 
 void BM_arrayBuilder(benchmark::State& state) {
@@ -112,8 +125,26 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+void BM_validateStrings(benchmark::State& state) {
+    BSONArrayBuilder builder;
+    auto len = state.range(0);
+    size_t totalSize = 0;
+    for (auto j = 0; j < len; j++)
+        builder.append(buildStringHeavyObj(j));
+    BSONObj array = builder.done();
+    invariant(validateBSON(array.objdata(), array.objsize()).isOK());
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(array.objdata(), array.objsize()));
+        totalSize += array.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateStrings)->Ranges({{{1}, {100}}});
 
 }  // namespace mongo
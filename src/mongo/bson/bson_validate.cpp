@@ -31,11 +31,16 @@
 #include <cstring>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "mongo/base/data_view.h"
 #include "mongo/bson/bson_depth.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonelement.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 
 namespace mongo {
 namespace {
@@ -147,9 +152,29 @@ private:
         }
 
         size_t strlen() const {
-            // This is actually by far the hottest code in all of BSON validation.
+            // This is actually by far the hottest code in all of BSON validation, so scan a block
+            // of bytes at a time while the whole block is known to lie within the buffer. The
+            // buffer always ends in a NUL byte, so the byte loop at the tail needs no bounds check.
             dassert(ptr < end);
             size_t len = 0;
+#if defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            for (; end - (ptr + len) >= 16; len += 16) {
+                auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + len));
+                if (uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)))
+                    return len + countTrailingZeros64(mask);
+            }
+#else
+            constexpr uint64_t kLow = 0x0101010101010101ULL;
+            constexpr uint64_t kHigh = 0x8080808080808080ULL;
+            for (; end - (ptr + len) >= 8; len += 8) {
+                // Sets the high bit of every NUL byte. Bytes above a NUL may get false positives
+                // from the borrow, but the lowest set bit always marks the first NUL.
+                auto word = ConstDataView(ptr + len).read<LittleEndian<uint64_t>>();
+                if (uint64_t mask = (word - kLow) & ~word & kHigh)
+                    return len + countTrailingZeros64(mask) / 8;
+            }
+#endif
             while (ptr[len])
                 ++len;
             return len;
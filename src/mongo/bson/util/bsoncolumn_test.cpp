@@ -28,6 +28,7 @@
  */
 
 #include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/bson/util/bsoncolumn_util.h"
 #include "mongo/bson/util/bsoncolumnbuilder.h"
 #include "mongo/bson/util/simple8b_type_util.h"
 
@@ -2430,6 +2431,28 @@ TEST_F(BSONColumnTest, AppendMaxKey) {
     verifyBinary(cb.finalize(), expected);
 }
 
+TEST(BSONColumnUtil, ExpandDeltas) {
+    std::vector<uint64_t> deltas;
+    for (int64_t delta : {4, 2, -3, 0, 6}) {
+        deltas.push_back(Simple8bTypeUtil::encodeInt64(delta));
+    }
+
+    std::vector<int64_t> values(deltas.size());
+    ASSERT_EQ(bsoncolumn::expandDeltas(deltas.data(), deltas.size(), 1, values.data()), 10);
+    ASSERT(values == std::vector<int64_t>({5, 7, 4, 4, 10}));
+}
+
+TEST(BSONColumnUtil, ExpandDeltaOfDeltas) {
+    std::vector<uint64_t> deltas;
+    for (int64_t deltaOfDelta : {10, 0, 0, 5, -15}) {
+        deltas.push_back(Simple8bTypeUtil::encodeInt64(deltaOfDelta));
+    }
+
+    std::vector<int64_t> values(deltas.size());
+    ASSERT_EQ(bsoncolumn::expandDeltaOfDeltas(deltas.data(), deltas.size(), 0, 0, values.data()),
+              45);
+    ASSERT(values == std::vector<int64_t>({10, 20, 30, 45, 45}));
+}
 
 }  // namespace
 }  // namespace mongo
@@ -29,6 +29,8 @@
 
 #include "mongo/bson/util/bsoncolumn_util.h"
 
+#include "mongo/bson/util/simple8b_type_util.h"
+
 namespace mongo::bsoncolumn {
 bool usesDeltaOfDelta(BSONType type) {
     return type == bsonTimestamp;
@@ -61,4 +63,22 @@ int128_t expandDelta(int128_t prev, int128_t delta) {
     // instead of undefined behavior.
     return static_cast<int128_t>(static_cast<uint128_t>(prev) + static_cast<uint128_t>(delta));
 }
+
+int64_t expandDeltas(const uint64_t* deltas, size_t count, int64_t prev, int64_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        prev = expandDelta(prev, Simple8bTypeUtil::decodeInt64(deltas[i]));
+        out[i] = prev;
+    }
+    return prev;
+}
+
+int64_t expandDeltaOfDeltas(
+    const uint64_t* deltas, size_t count, int64_t prevDelta, int64_t prev, int64_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        prevDelta = expandDelta(prevDelta, Simple8bTypeUtil::decodeInt64(deltas[i]));
+        prev = expandDelta(prev, prevDelta);
+        out[i] = prev;
+    }
+    return prev;
+}
 }  // namespace mongo::bsoncolumn
@@ -45,4 +45,16 @@ int128_t calcDelta(int128_t val, int128_t prev);
 int64_t expandDelta(int64_t prev, int64_t delta);
 int128_t expandDelta(int128_t prev, int128_t delta);
 
+/**
+ * Bulk versions of expandDelta for values decoded with Simple8b::decodeAll. Each of the 'count'
+ * encoded deltas in 'deltas' is decoded with Simple8bTypeUtil::decodeInt64 and the running sum
+ * starting at 'prev' is written to 'out', which may alias 'deltas'. Returns the last value.
+ *
+ * The deltas may not contain skips for expandDeltaOfDeltas, 'prevDelta' is the last delta before
+ * the first delta-of-delta.
+ */
+int64_t expandDeltas(const uint64_t* deltas, size_t count, int64_t prev, int64_t* out);
+int64_t expandDeltaOfDeltas(
+    const uint64_t* deltas, size_t count, int64_t prevDelta, int64_t prev, int64_t* out);
+
 }  // namespace mongo::bsoncolumn
@@ -267,6 +267,136 @@ uint8_t _getSelectorIndex(uint8_t intsNeeded, uint8_t extensionType) {
     return iteratorIdx - kIntsStoreForSelector[extensionType].begin();
 }
 
+/*
+ * Returns the number of values stored in a Simple8b block, including RLE blocks.
+ */
+uint16_t _countValuesInBlock(uint64_t block) {
+    uint8_t selector = block & kBaseSelectorMask;
+    uint8_t selectorExtension = (block >> kSelectorBits) & kBaseSelectorMask;
+    if (selector == kRleSelector) {
+        return (selectorExtension + 1) * kRleMultiplier;
+    }
+
+    if (selector == 7 || selector == 8) {
+        uint8_t extensionType = kSelectorToExtension[selector - 7][selectorExtension];
+        if (extensionType != kBaseSelector) {
+            return kIntsStoreForSelector[extensionType][selectorExtension];
+        }
+    }
+    return kIntsStoreForSelector[kBaseSelector][selector];
+}
+
+/*
+ * Decodes a Simple8b block using one of the base selectors into 'out' and returns the number of
+ * values decoded. The slot size and count are known at compile time so the compiler can unroll
+ * and vectorize the loop, there is no branching per value.
+ */
+template <typename T, uint8_t bitsPerValue, uint8_t shift>
+uint8_t _decodeBaseBlock(uint64_t block, T* out, size_t& skips, bool& lastSkipped) {
+    constexpr uint8_t count = kMaxDataBits[kBaseSelector] / bitsPerValue;
+    constexpr uint64_t mask = (1ull << bitsPerValue) - 1;
+
+    uint8_t skipped = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        uint64_t value = (block >> (shift + i * bitsPerValue)) & mask;
+        bool skip = value == mask;
+        skipped += skip;
+        out[i] = skip ? 0 : static_cast<T>(value);
+    }
+
+    skips += skipped;
+    lastSkipped = ((block >> (shift + (count - 1) * bitsPerValue)) & mask) == mask;
+    return count;
+}
+
+/*
+ * Decodes a Simple8b block using one of the extended selectors 7 and 8 into 'out' and returns the
+ * number of values decoded.
+ */
+template <typename T>
+uint8_t _decodeExtendedBlock(uint64_t block,
+                             uint8_t extensionType,
+                             uint8_t selector,
+                             T* out,
+                             size_t& skips,
+                             bool& lastSkipped) {
+    const uint64_t mask = kDecodeMask[extensionType][selector];
+    const uint8_t countBits = kTrailingZeroBitSize[extensionType];
+    const uint8_t countMask = kTrailingZerosMask[extensionType];
+    const uint8_t countMultiplier = kTrailingZerosMultiplier[extensionType];
+    const uint8_t bitsPerValue = kBitsPerIntForSelector[extensionType][selector] + countBits;
+    const uint8_t count = kIntsStoreForSelector[extensionType][selector];
+
+    uint8_t shift = kSelectorBits + kNibbleShiftSize;
+    for (uint8_t i = 0; i < count; ++i, shift += bitsPerValue) {
+        uint64_t value = (block >> shift) & mask;
+        lastSkipped = value == mask;
+        if (lastSkipped) {
+            ++skips;
+            out[i] = 0;
+            continue;
+        }
+
+        out[i] = static_cast<T>(value >> countBits) << ((value & countMask) * countMultiplier);
+    }
+    return count;
+}
+
+/*
+ * Decodes a Simple8b block, that is not RLE, into 'out' and returns the number of values decoded.
+ */
+template <typename T>
+uint8_t _decodeBlock(uint64_t block, T* out, size_t& skips, bool& lastSkipped) {
+    uint8_t selector = block & kBaseSelectorMask;
+    uint8_t selectorExtension = (block >> kSelectorBits) & kBaseSelectorMask;
+
+    // Selectors 7 and 8 store an extension in the next nibble, which is skipped for the base
+    // extension type as well.
+    if (selector == 7 || selector == 8) {
+        uint8_t extensionType = kSelectorToExtension[selector - 7][selectorExtension];
+        if (extensionType != kBaseSelector) {
+            return _decodeExtendedBlock(
+                block, extensionType, selectorExtension, out, skips, lastSkipped);
+        }
+    }
+
+    constexpr uint8_t kShift = kSelectorBits;
+    constexpr uint8_t kExtendedShift = kSelectorBits + kNibbleShiftSize;
+    switch (selector) {
+        case 1:
+            return _decodeBaseBlock<T, 1, kShift>(block, out, skips, lastSkipped);
+        case 2:
+            return _decodeBaseBlock<T, 2, kShift>(block, out, skips, lastSkipped);
+        case 3:
+            return _decodeBaseBlock<T, 3, kShift>(block, out, skips, lastSkipped);
+        case 4:
+            return _decodeBaseBlock<T, 4, kShift>(block, out, skips, lastSkipped);
+        case 5:
+            return _decodeBaseBlock<T, 5, kShift>(block, out, skips, lastSkipped);
+        case 6:
+            return _decodeBaseBlock<T, 6, kShift>(block, out, skips, lastSkipped);
+        case 7:
+            return _decodeBaseBlock<T, 7, kExtendedShift>(block, out, skips, lastSkipped);
+        case 8:
+            return _decodeBaseBlock<T, 8, kExtendedShift>(block, out, skips, lastSkipped);
+        case 9:
+            return _decodeBaseBlock<T, 10, kShift>(block, out, skips, lastSkipped);
+        case 10:
+            return _decodeBaseBlock<T, 12, kShift>(block, out, skips, lastSkipped);
+        case 11:
+            return _decodeBaseBlock<T, 15, kShift>(block, out, skips, lastSkipped);
+        case 12:
+            return _decodeBaseBlock<T, 20, kShift>(block, out, skips, lastSkipped);
+        case 13:
+            return _decodeBaseBlock<T, 30, kShift>(block, out, skips, lastSkipped);
+        case 14:
+            return _decodeBaseBlock<T, 60, kShift>(block, out, skips, lastSkipped);
+        default:
+            // Selector 0 holds no values.
+            return 0;
+    }
+}
+
 }  // namespace
 
 // This is called in _encode while iterating through _pendingValues. For the base selector, we just
@@ -860,6 +990,46 @@ typename Simple8b<T>::Iterator Simple8b<T>::end() const {
     return {_buffer + _size, _buffer + _size};
 }
 
+template <typename T>
+size_t Simple8b<T>::decodeAll(std::vector<T>* values) const {
+    const char* end = _buffer + _size;
+
+    // Size the output once from the selectors, so blocks can be decoded directly into it.
+    size_t total = 0;
+    for (const char* pos = _buffer; pos != end; pos += sizeof(uint64_t)) {
+        uint64_t block = ConstDataView(pos).read<LittleEndian<uint64_t>>();
+        total += _countValuesInBlock(block);
+    }
+
+    size_t offset = values->size();
+    values->resize(offset + total);
+    T* out = values->data() + offset;
+    size_t skips = 0;
+
+    // RLE blocks repeat the last value of the previous block, which is 0 at the beginning.
+    T last = 0;
+    bool lastSkipped = false;
+    for (const char* pos = _buffer; pos != end; pos += sizeof(uint64_t)) {
+        uint64_t block = ConstDataView(pos).read<LittleEndian<uint64_t>>();
+        if ((block & kBaseSelectorMask) == kRleSelector) {
+            size_t count = _countValuesInBlock(block);
+            std::fill_n(out, count, last);
+            out += count;
+            if (lastSkipped) {
+                skips += count;
+            }
+            continue;
+        }
+
+        uint8_t count = _decodeBlock(block, out, skips, lastSkipped);
+        if (count > 0) {
+            out += count;
+            last = *(out - 1);
+        }
+    }
+    return skips;
+}
+
 template class Simple8b<uint64_t>;
 template class Simple8b<uint128_t>;
 template class Simple8bBuilder<uint64_t>;
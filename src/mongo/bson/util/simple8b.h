@@ -390,6 +390,15 @@ public:
     Iterator begin() const;
     Iterator end() const;
 
+    /**
+     * Decodes all values and appends them to 'values'. Decoding is done a Simple8b block at a time
+     * with the selector resolved once per block, which is considerably faster than Iterator.
+     *
+     * Skipped values are stored as 0. Returns the number of skipped values, callers that need to
+     * tell them apart from 0 should use Iterator when this is not 0.
+     */
+    size_t decodeAll(std::vector<T>* values) const;
+
 private:
     const char* _buffer;
     int _size;
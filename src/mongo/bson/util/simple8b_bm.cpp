@@ -30,7 +30,9 @@
 #include "third_party/benchmark/dist/include/benchmark/benchmark.h"
 #include <benchmark/benchmark.h>
 
+#include "mongo/bson/util/bsoncolumn_util.h"
 #include "mongo/bson/util/simple8b.h"
+#include "mongo/bson/util/simple8b_type_util.h"
 #include "mongo/platform/bits.h"
 
 namespace mongo {
@@ -109,9 +111,10 @@ void BM_selectorSeven(benchmark::State& state) {
     state.SetBytesProcessed(totalBytes);
 }
 
-void BM_decode(benchmark::State& state) {
-    size_t totalBytes = 0;
-
+/**
+ * Builds a Simple8b buffer with a mix of small values, RLE and large values.
+ */
+std::pair<SharedBuffer, int> buildMixedSimple8b() {
     BufBuilder _buffer;
     Simple8bBuilder<uint64_t> s8bBuilder(
         [&_buffer](uint64_t simple8bBlock) { _buffer.appendNum(simple8bBlock); });
@@ -133,7 +136,13 @@ void BM_decode(benchmark::State& state) {
     s8bBuilder.flush();
 
     auto size = _buffer.len();
-    auto buf = _buffer.release();
+    return {_buffer.release(), size};
+}
+
+void BM_decode(benchmark::State& state) {
+    size_t totalBytes = 0;
+
+    auto [buf, size] = buildMixedSimple8b();
     Simple8b<uint64_t> s8b(buf.get(), size);
 
     for (auto _ : state) {
@@ -146,11 +155,61 @@ void BM_decode(benchmark::State& state) {
     state.SetBytesProcessed(totalBytes);
 }
 
+void BM_decodeAll(benchmark::State& state) {
+    size_t totalBytes = 0;
+
+    auto [buf, size] = buildMixedSimple8b();
+    Simple8b<uint64_t> s8b(buf.get(), size);
+    std::vector<uint64_t> values;
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        values.clear();
+        benchmark::DoNotOptimize(s8b.decodeAll(&values));
+        totalBytes += size;
+    }
+
+    state.SetBytesProcessed(totalBytes);
+}
+
+void BM_decodeAllDeltas(benchmark::State& state) {
+    size_t totalBytes = 0;
+
+    // Timestamps 1 second apart with some jitter, as found in time-series buckets.
+    BufBuilder _buffer;
+    Simple8bBuilder<uint64_t> s8bBuilder(
+        [&_buffer](uint64_t simple8bBlock) { _buffer.appendNum(simple8bBlock); });
+    for (auto j = 0; j < state.range(0); j++) {
+        s8bBuilder.append(Simple8bTypeUtil::encodeInt64(1000 + (j % 7) - 3));
+    }
+    s8bBuilder.flush();
+
+    auto size = _buffer.len();
+    auto buf = _buffer.release();
+    Simple8b<uint64_t> s8b(buf.get(), size);
+    std::vector<uint64_t> deltas;
+    std::vector<int64_t> values;
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        deltas.clear();
+        s8b.decodeAll(&deltas);
+        values.resize(deltas.size());
+        benchmark::DoNotOptimize(
+            bsoncolumn::expandDeltas(deltas.data(), deltas.size(), 0, values.data()));
+        totalBytes += size;
+    }
+
+    state.SetBytesProcessed(totalBytes);
+}
+
 BENCHMARK(BM_increasingValues)->Arg(100);
 BENCHMARK(BM_rle)->Arg(100);
 BENCHMARK(BM_changingSmallValues)->Arg(100);
 BENCHMARK(BM_changingLargeValues)->Arg(100);
 BENCHMARK(BM_selectorSeven)->Arg(100);
 BENCHMARK(BM_decode);
+BENCHMARK(BM_decodeAll);
+BENCHMARK(BM_decodeAllDeltas)->Arg(1000);
 
 }  // namespace mongo
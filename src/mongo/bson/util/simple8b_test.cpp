@@ -30,6 +30,7 @@
 #include "mongo/bson/util/simple8b.h"
 #include "mongo/unittest/unittest.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <boost/optional/optional_io.hpp>
 #include <vector>
@@ -48,6 +49,15 @@ void assertValuesEqual(const Simple8b<T>& actual, const std::vector<boost::optio
 
     ASSERT(it == end);
     ASSERT_EQ(i, expected.size());
+
+    // Bulk decoding must produce the same values, with skips stored as 0.
+    std::vector<T> decoded;
+    ASSERT_EQ(actual.decodeAll(&decoded),
+              static_cast<size_t>(std::count(expected.begin(), expected.end(), boost::none)));
+    ASSERT_EQ(decoded.size(), expected.size());
+    for (i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(decoded[i], expected[i].value_or(0));
+    }
 }
 
 template <typename T>
@@ -38,11 +38,18 @@
 #include "mongo/platform/random.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/password_digest.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/str.h"
+#include "mongo/util/synchronized_value.h"
 #include "mongo/util/text.h"
 
 namespace mongo {
 
+namespace {
+// Shared so that each client nonce doesn't pay for filling a new SecureRandom's buffer.
+StaticImmortal<synchronized_value<SecureRandom>> nonceGen;
+}  // namespace
+
 using std::string;
 using std::unique_ptr;
 
@@ -85,7 +92,7 @@ StatusWith<bool> SaslSCRAMClientConversation::_firstStep(std::string* outputData
     static constexpr size_t nonceLenQWords = 3;
     uint64_t binaryNonce[nonceLenQWords];
 
-    SecureRandom().fill(binaryNonce, sizeof(binaryNonce));
+    (*nonceGen)->fill(binaryNonce, sizeof(binaryNonce));
 
     std::string user =
         _saslClientSession->getParameter(SaslClientSession::parameterUser).toString();
@@ -44,6 +44,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/bson_extract_optime.h"
 #include "mongo/db/server_options.h"
+#include "mongo/executor/host_latency_tracker.h"
 #include "mongo/executor/thread_pool_task_executor.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
@@ -324,6 +325,16 @@ SemiFuture<HostAndPort> StreamableReplicaSetMonitor::getHostOrRefresh(
         .thenRunOn(_executor)
         .then([self = shared_from_this()](const std::vector<HostAndPort>& result) {
             invariant(result.size());
+            if (sdam::sdamLatencyAwareServerSelection.load()) {
+                // The hello round trip time used for the latency window does not reflect how
+                // loaded a host is, so prefer the hosts which are currently serving operations
+                // quickly.
+                return executor::HostLatencyTracker::get().selectHost(
+                    result,
+                    sdam::sdamLatencyAwareServerSelectionPercentile.load(),
+                    self->_executor->now(),
+                    self->_random);
+            }
             return result[self->_random.nextInt64(result.size())];
         })
         .semi();
@@ -493,6 +493,14 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
         return userHandle;
     }
 
+    const bool canCacheUserNotFound = !request.roles;
+    if (canCacheUserNotFound) {
+        if (auto userNotFound = _getCachedUserNotFound(opCtx, userName)) {
+            return *userNotFound;
+        }
+    }
+    const auto cacheGenerationBeforeLookup = getCacheGeneration();
+
     // Track wait time and user cache access statistics for the current op for logging. An extra
     // second of delay is added via the failpoint for testing.
     UserAcquisitionStatsHandle userAcquisitionStatsHandle =
@@ -503,7 +511,16 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
         sleepsecs(1);
     }
 
-    auto cachedUser = _userCache.acquire(opCtx, request);
+    auto cachedUser = [&] {
+        try {
+            return _userCache.acquire(opCtx, request);
+        } catch (const ExceptionFor<ErrorCodes::UserNotFound>& ex) {
+            if (canCacheUserNotFound) {
+                _cacheUserNotFound(opCtx, userName, ex.toStatus(), cacheGenerationBeforeLookup);
+            }
+            throw;
+        }
+    }();
 
     userAcquisitionStatsHandle.recordTimerEnd();
     invariant(cachedUser);
@@ -514,6 +531,49 @@ StatusWith<UserHandle> AuthorizationManagerImpl::acquireUser(OperationContext* o
     return ex.toStatus();
 }
 
+boost::optional<Status> AuthorizationManagerImpl::_getCachedUserNotFound(
+    OperationContext* opCtx, const UserName& userName) {
+    stdx::lock_guard<Latch> lk(_usersNotFoundMutex);
+    auto it = _usersNotFound.find(userName);
+    if (it == _usersNotFound.end()) {
+        return boost::none;
+    }
+
+    if (it->second.expiresAt <= opCtx->getServiceContext()->getFastClockSource()->now()) {
+        _usersNotFound.erase(it);
+        return boost::none;
+    }
+
+    LOGV2_DEBUG(6170440, 1, "Returning cached user not found", "user"_attr = userName);
+    return it->second.status;
+}
+
+void AuthorizationManagerImpl::_cacheUserNotFound(OperationContext* opCtx,
+                                                  const UserName& userName,
+                                                  Status status,
+                                                  const OID& cacheGenerationBeforeLookup) {
+    const Milliseconds expiration(authorizationManagerUserNotFoundCacheMillis.load());
+    if (expiration <= Milliseconds(0)) {
+        return;
+    }
+
+    const auto expiresAt = opCtx->getServiceContext()->getFastClockSource()->now() + expiration;
+
+    stdx::lock_guard<Latch> lk(_usersNotFoundMutex);
+    // Don't remember the user if anything was invalidated since the lookup started, as that may
+    // have been the user being created. Invalidations which come after this check clear the entry
+    // again, since they take '_usersNotFoundMutex' after updating the cache generation.
+    if (cacheGenerationBeforeLookup != getCacheGeneration()) {
+        return;
+    }
+
+    // Bound the memory used by lookups of arbitrary user names.
+    if (_usersNotFound.size() >= static_cast<size_t>(authorizationManagerCacheSize)) {
+        _usersNotFound.clear();
+    }
+    _usersNotFound.insert_or_assign(userName, UserNotFoundEntry{std::move(status), expiresAt});
+}
+
 StatusWith<UserHandle> AuthorizationManagerImpl::reacquireUser(OperationContext* opCtx,
                                                                const UserHandle& user) {
     const UserName& userName = user->getName();
@@ -650,6 +710,9 @@ void AuthorizationManagerImpl::invalidateUserByName(OperationContext* opCtx,
     // Invalidate the named User, assuming no externally provided roles. When roles are defined
     // externally, there exists no user document which may become invalid.
     _userCache.invalidate(UserRequest(userName, boost::none));
+
+    stdx::lock_guard<Latch> lk(_usersNotFoundMutex);
+    _usersNotFound.erase(userName);
 }
 
 void AuthorizationManagerImpl::invalidateUsersFromDB(OperationContext* opCtx, StringData dbname) {
@@ -658,6 +721,11 @@ void AuthorizationManagerImpl::invalidateUsersFromDB(OperationContext* opCtx, St
     _authSchemaVersionCache.invalidateAll();
     _userCache.invalidateKeyIf(
         [&](const UserRequest& userRequest) { return userRequest.name.getDB() == dbname; });
+
+    stdx::lock_guard<Latch> lk(_usersNotFoundMutex);
+    for (auto it = _usersNotFound.begin(); it != _usersNotFound.end();) {
+        it = it->first.getDB() == dbname ? _usersNotFound.erase(it) : std::next(it);
+    }
 }
 
 void AuthorizationManagerImpl::invalidateUserCache(OperationContext* opCtx) {
@@ -665,6 +733,9 @@ void AuthorizationManagerImpl::invalidateUserCache(OperationContext* opCtx) {
     _updateCacheGeneration();
     _authSchemaVersionCache.invalidateAll();
     _userCache.invalidateAll();
+
+    stdx::lock_guard<Latch> lk(_usersNotFoundMutex);
+    _usersNotFound.clear();
 }
 
 Status AuthorizationManagerImpl::initialize(OperationContext* opCtx) {
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <map>
+
 #include "mongo/db/auth/authorization_manager.h"
 #include "mongo/db/auth/privilege.h"
 #include "mongo/platform/atomic_word.h"
@@ -198,6 +200,27 @@ private:
         AuthzManagerExternalState* const _externalState;
     } _userCache;
 
+    /**
+     * Remembers the users which were recently found not to exist, so that storms of failed
+     * authentication attempts for them don't each have to look in storage. Only requests without
+     * externally provided roles are remembered, and the entries are dropped by the same
+     * invalidations which apply to '_userCache'.
+     */
+    struct UserNotFoundEntry {
+        Status status;
+        Date_t expiresAt;
+    };
+
+    boost::optional<Status> _getCachedUserNotFound(OperationContext* opCtx,
+                                                   const UserName& userName);
+    void _cacheUserNotFound(OperationContext* opCtx,
+                            const UserName& userName,
+                            Status status,
+                            const OID& cacheGenerationBeforeLookup);
+
+    Mutex _usersNotFoundMutex = MONGO_MAKE_LATCH("AuthorizationManagerImpl::_usersNotFoundMutex");
+    std::map<UserName, UserNotFoundEntry> _usersNotFound;
+
     // Thread pool on which to perform the blocking activities that load the user credentials from
     // storage
     ThreadPool _threadPool;
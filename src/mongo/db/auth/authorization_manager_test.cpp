@@ -49,6 +49,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/recovery_unit_noop.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_mock.h"
 #include "mongo/unittest/unittest.h"
@@ -167,6 +168,32 @@ TEST_F(AuthorizationManagerTest, testAcquireV2User) {
     // Make sure user's refCount is 0 at the end of the test to avoid an assertion failure
 }
 
+TEST_F(AuthorizationManagerTest, UserNotFoundIsCachedUntilTheUserIsInvalidated) {
+    RAIIServerParameterControllerForTest userNotFoundCache(
+        "authorizationManagerUserNotFoundCacheMillis", 60 * 1000);
+    const UserName userName("notyet", "test");
+    ASSERT_EQ(ErrorCodes::UserNotFound, authzManager->acquireUser(opCtx.get(), userName));
+
+    // The mock external state does not invalidate the user when its document is inserted, so the
+    // cached lookup failure is still returned.
+    ASSERT_OK(externalState->insertPrivilegeDocument(opCtx.get(),
+                                                     BSON("_id"
+                                                          << "test.notyet"
+                                                          << "user"
+                                                          << "notyet"
+                                                          << "db"
+                                                          << "test"
+                                                          << "credentials" << credentials << "roles"
+                                                          << BSONArray()),
+                                                     BSONObj()));
+    ASSERT_EQ(ErrorCodes::UserNotFound, authzManager->acquireUser(opCtx.get(), userName));
+
+    authzManager->invalidateUserByName(opCtx.get(), userName);
+    auto swu = authzManager->acquireUser(opCtx.get(), userName);
+    ASSERT_OK(swu.getStatus());
+    ASSERT_EQUALS(userName, swu.getValue()->getName());
+}
+
 #ifdef MONGO_CONFIG_SSL
 TEST_F(AuthorizationManagerTest, testLocalX509Authorization) {
     setX509PeerInfo(session,
@@ -47,11 +47,19 @@
 #include "mongo/platform/random.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/sequence_util.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/str.h"
+#include "mongo/util/synchronized_value.h"
 #include "mongo/util/text.h"
 
 namespace mongo {
 
+namespace {
+// Shared by all conversations. A SecureRandom reads a whole buffer from the OS the first time it is
+// used, which is wasted on a one-off instance that only needs enough bytes for a single nonce.
+StaticImmortal<synchronized_value<SecureRandom>> nonceGen;
+}  // namespace
+
 template <typename Policy>
 StatusWith<std::tuple<bool, std::string>> SaslSCRAMServerMechanism<Policy>::stepImpl(
     OperationContext* opCtx, StringData inputData) {
@@ -251,7 +259,7 @@ StatusWith<std::tuple<bool, std::string>> SaslSCRAMServerMechanism<Policy>::_fir
     const int nonceLenQWords = 3;
     uint64_t binaryNonce[nonceLenQWords];
 
-    SecureRandom().fill(binaryNonce, sizeof(binaryNonce));
+    (*nonceGen)->fill(binaryNonce, sizeof(binaryNonce));
 
     _nonce = clientNonce +
         base64::encode(StringData(reinterpret_cast<char*>(binaryNonce), sizeof(binaryNonce)));
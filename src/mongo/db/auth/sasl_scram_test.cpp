@@ -31,7 +31,9 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "mongo/client/native_sasl_client_session.h"
 #include "mongo/client/scram_client_cache.h"
@@ -48,6 +50,7 @@
 #include "mongo/db/auth/sasl_scram_server_conversation.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/base64.h"
 #include "mongo/util/password_digest.h"
@@ -399,6 +402,79 @@ TEST_F(SCRAMFixture, testSCRAM) {
     ASSERT_EQ(goalState, runSteps());
 }
 
+TEST_F(SCRAMFixture, testConcurrentSCRAM) {
+    ASSERT_OK(authzManagerExternalState->insertPrivilegeDocument(
+        opCtx.get(), generateSCRAMUserDocument("sajack", "sajack"), BSONObj()));
+
+    // All conversations draw their nonces from the same SecureRandom, so run several of them at
+    // once and check that each one succeeds with a nonce of its own.
+    const size_t kConversations = 8;
+    const auto password = createPasswordDigest("sajack", "sajack");
+    const bool useSHA1 = _digestPassword;
+    std::vector<Status> statuses(kConversations, Status::OK());
+    std::vector<std::string> nonces(kConversations);
+
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < kConversations; ++i) {
+        threads.emplace_back([&, i] {
+            auto threadClient = serviceContext->makeClient(str::stream() << "scram" << i);
+            auto threadOpCtx = threadClient->makeOperationContext();
+
+            std::unique_ptr<ServerMechanismBase> server;
+            if (useSHA1) {
+                server = std::make_unique<SaslSCRAMSHA1ServerMechanism>("test");
+            } else {
+                server = std::make_unique<SaslSCRAMSHA256ServerMechanism>("test");
+            }
+
+            NativeSaslClientSession client;
+            client.setParameter(NativeSaslClientSession::parameterMechanism,
+                                server->mechanismName());
+            client.setParameter(NativeSaslClientSession::parameterServiceName, "mongodb");
+            client.setParameter(NativeSaslClientSession::parameterServiceHostname,
+                                "MockServer.test");
+            client.setParameter(NativeSaslClientSession::parameterServiceHostAndPort,
+                                "MockServer.test:27017");
+            client.setParameter(NativeSaslClientSession::parameterUser, "sajack");
+            client.setParameter(NativeSaslClientSession::parameterPassword, password);
+
+            auto& status = statuses[i];
+            status = client.initialize();
+
+            std::string clientOutput;
+            std::string serverOutput;
+            for (size_t step = 1; status.isOK() && step <= 3; step++) {
+                status = client.step(serverOutput, &clientOutput);
+                if (!status.isOK()) {
+                    break;
+                }
+
+                auto swServerOutput = server->step(threadOpCtx.get(), clientOutput);
+                status = swServerOutput.getStatus();
+                if (status.isOK()) {
+                    serverOutput = std::move(swServerOutput.getValue());
+                }
+                if (step == 1) {
+                    // The server's first message starts with the combined client and server nonce.
+                    nonces[i] = serverOutput.substr(0, serverOutput.find(','));
+                }
+            }
+            if (status.isOK() && !(client.isSuccess() && server->isSuccess())) {
+                status = Status(ErrorCodes::AuthenticationFailed, "conversation did not finish");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& status : statuses) {
+        ASSERT_OK(status);
+    }
+    std::sort(nonces.begin(), nonces.end());
+    ASSERT(std::adjacent_find(nonces.begin(), nonces.end()) == nonces.end());
+}
+
 TEST_F(SCRAMFixture, testSCRAMWithChannelBindingSupportedByClient) {
     ASSERT_OK(authzManagerExternalState->insertPrivilegeDocument(
         opCtx.get(), generateSCRAMUserDocument("sajack", "sajack"), BSONObj()));
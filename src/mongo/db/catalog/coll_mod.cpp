@@ -113,6 +113,7 @@ struct CollModRequest {
     boost::optional<ValidationLevelEnum> collValidationLevel;
     bool recordPreImages = false;
     OptionalBool changeStreamPreAndPostImagesEnabled;
+    boost::optional<bool> cacheResident;
 };
 
 StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
@@ -318,6 +319,13 @@ StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
             }
 
             cmr.recordPreImages = e.trueValue();
+        } else if (fieldName == "cacheResident") {
+            if (isView) {
+                return {ErrorCodes::InvalidOptions,
+                        str::stream() << "option not supported on a view: " << fieldName};
+            }
+
+            cmr.cacheResident = e.trueValue();
         } else if (fieldName == "changeStreamPreAndPostImages") {
             if (nss.isTimeseriesBucketsCollection()) {
                 return {ErrorCodes::InvalidOptions,
@@ -671,6 +679,21 @@ Status _collModInternal(OperationContext* opCtx,
             coll.getWritableCollection()->setRecordPreImages(opCtx, cmrNew.recordPreImages);
         }
 
+        if (cmrNew.cacheResident) {
+            auto status = coll->getRecordStore()->setCacheResident(opCtx, *cmrNew.cacheResident);
+            if (!status.isOK()) {
+                // Cache residency does not affect correctness, so a secondary that cannot apply it
+                // keeps applying the oplog rather than failing the collMod.
+                if (opCtx->writesAreReplicated()) {
+                    uassertStatusOKWithContext(status, "Failed to set cacheResident");
+                }
+                LOGV2_WARNING(6170455,
+                              "Failed to set cacheResident while applying collMod",
+                              "namespace"_attr = nss,
+                              "error"_attr = status);
+            }
+        }
+
         // TODO SERVER-58584: remove the feature flag.
         if (feature_flags::gFeatureFlagChangeStreamPreAndPostImages.isEnabledAndIgnoreFCV() &&
             cmrNew.changeStreamPreAndPostImagesEnabled.has_value() &&
@@ -369,15 +369,19 @@ public:
      * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
      * 'noWarn' if unindexing the record causes an error, if noWarn is true the error
      * will not be logged.
+     * 'oplogSlot' the OpTime reserved for the delete by a caller which deletes several documents in
+     * one WriteUnitOfWork. The caller must have timestamped the write with it already.
      */
-    virtual void deleteDocument(OperationContext* opCtx,
-                                Snapshotted<BSONObj> doc,
-                                StmtId stmtId,
-                                RecordId loc,
-                                OpDebug* opDebug,
-                                bool fromMigrate = false,
-                                bool noWarn = false,
-                                StoreDeletedDoc storeDeletedDoc = StoreDeletedDoc::Off) const = 0;
+    virtual void deleteDocument(
+        OperationContext* opCtx,
+        Snapshotted<BSONObj> doc,
+        StmtId stmtId,
+        RecordId loc,
+        OpDebug* opDebug,
+        bool fromMigrate = false,
+        bool noWarn = false,
+        StoreDeletedDoc storeDeletedDoc = StoreDeletedDoc::Off,
+        const boost::optional<OplogSlot>& oplogSlot = boost::none) const = 0;
 
     /*
      * Inserts all documents inside one WUOW.
@@ -443,10 +447,13 @@ public:
     virtual bool updateWithDamagesSupported() const = 0;
 
     /**
-     * Not allowed to modify indexes.
+     * Applies 'damages' to the record @ loc in place, so that the storage engine only writes the
+     * changed bytes. If 'indexesAffected' is true, the index entries of the document are updated
+     * from its pre- and post-images.
      * Illegal to call if updateWithDamagesSupported() returns false.
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
+     * 'opDebug' Optional argument. When not null, will be used to record operation statistics.
      * @return the contents of the updated record.
      */
     virtual StatusWith<RecordData> updateDocumentWithDamages(
@@ -455,6 +462,8 @@ public:
         const Snapshotted<RecordData>& oldRec,
         const char* damageSource,
         const mutablebson::DamageVector& damages,
+        bool indexesAffected,
+        OpDebug* opDebug,
         CollectionUpdateArgs* args) const = 0;
 
     // -----------
@@ -37,6 +37,7 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/copy_on_write_hash_map.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -74,10 +75,7 @@ public:
         using value_type = CollectionPtr;
 
         iterator(OperationContext* opCtx, StringData dbName, const CollectionCatalog& catalog);
-        iterator(OperationContext* opCtx,
-                 std::map<std::pair<std::string, CollectionUUID>,
-                          std::shared_ptr<Collection>>::const_iterator mapIter,
-                 const CollectionCatalog& catalog);
+        iterator(OperationContext* opCtx, const CollectionCatalog& catalog);
         value_type operator*();
         iterator operator++();
         iterator operator++(int);
@@ -96,10 +94,12 @@ public:
         bool _exhausted();
 
         OperationContext* _opCtx;
-        std::string _dbName;
         boost::optional<CollectionUUID> _uuid;
-        std::map<std::pair<std::string, CollectionUUID>,
-                 std::shared_ptr<Collection>>::const_iterator _mapIter;
+
+        // The collections of the database being iterated, or null once the iterator is exhausted.
+        std::shared_ptr<const std::map<CollectionUUID, std::shared_ptr<Collection>>>
+            _dbCollections;
+        std::map<CollectionUUID, std::shared_ptr<Collection>>::const_iterator _mapIter;
         const CollectionCatalog* _catalog;
     };
 
@@ -441,16 +441,24 @@ private:
         mongo::stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>>
         _shadowCatalog;
 
+    /**
+     * Returns the collections of 'dbName' for modification, copying them first if they are shared
+     * with another catalog instance.
+     */
+    std::map<CollectionUUID, std::shared_ptr<Collection>>& _writableDbCollections(
+        const std::string& dbName);
+
+    // The maps below that grow with the number of collections share their contents between
+    // catalog instances, so that cloning the catalog for a write does not copy every entry.
     using CollectionCatalogMap =
-        stdx::unordered_map<CollectionUUID, std::shared_ptr<Collection>, CollectionUUID::Hash>;
-    using OrderedCollectionMap =
-        std::map<std::pair<std::string, CollectionUUID>, std::shared_ptr<Collection>>;
-    using NamespaceCollectionMap =
-        stdx::unordered_map<NamespaceString, std::shared_ptr<Collection>>;
+        CopyOnWriteHashMap<CollectionUUID, std::shared_ptr<Collection>, CollectionUUID::Hash>;
+    using DbCollectionMap = std::map<CollectionUUID, std::shared_ptr<Collection>>;
+    using OrderedCollectionMap = std::map<std::string, std::shared_ptr<const DbCollectionMap>>;
+    using NamespaceCollectionMap = CopyOnWriteHashMap<NamespaceString, std::shared_ptr<Collection>>;
     using DatabaseProfileSettingsMap = StringMap<ProfileSettings>;
 
     CollectionCatalogMap _catalog;
-    OrderedCollectionMap _orderedCollections;  // Ordered by <dbName, collUUID> pair
+    OrderedCollectionMap _orderedCollections;  // Ordered by dbName, then collUUID
     NamespaceCollectionMap _collections;
 
     // Map of database names to a set of their views. Only databases with views are present.
@@ -469,7 +477,7 @@ private:
     uint64_t _epoch = 0;
 
     // Mapping from ResourceId to a set of strings that contains collection and database namespaces.
-    std::map<ResourceId, std::set<std::string>> _resourceInformation;
+    CopyOnWriteHashMap<ResourceId, std::set<std::string>> _resourceInformation;
 
     /**
      * Contains non-default database profile settings. New collections, current collections and
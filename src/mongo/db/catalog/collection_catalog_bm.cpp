@@ -96,7 +96,28 @@ void BM_CollectionCatalogWriteWithGlobalExclusiveLock(benchmark::State& state) {
     }
 }
 
+void BM_CollectionCatalogRegisterAndDeregister(benchmark::State& state) {
+    auto serviceContext = setupServiceContext();
+    ThreadClient threadClient(serviceContext);
+    ServiceContext::UniqueOperationContext opCtx = threadClient->makeOperationContext();
+
+    createCollectionsAndLocker(opCtx.get(), state.range(0));
+
+    const NamespaceString nss("collection_catalog_bm", "registered");
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        auto uuid = UUID::gen();
+        CollectionCatalog::write(opCtx.get(), [&](CollectionCatalog& catalog) {
+            catalog.registerCollection(opCtx.get(), uuid, std::make_shared<CollectionMock>(nss));
+        });
+        CollectionCatalog::write(opCtx.get(), [&](CollectionCatalog& catalog) {
+            catalog.deregisterCollection(opCtx.get(), uuid);
+        });
+    }
+}
+
 BENCHMARK(BM_CollectionCatalogWrite)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_CollectionCatalogWriteWithGlobalExclusiveLock)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_CollectionCatalogRegisterAndDeregister)->Ranges({{{1}, {100'000}}});
 
 }  // namespace mongo
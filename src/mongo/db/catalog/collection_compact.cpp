@@ -35,14 +35,18 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/progress_meter.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -68,6 +72,75 @@ CollectionPtr getCollectionForCompact(OperationContext* opCtx,
     return collection;
 }
 
+/**
+ * A file to compact in steps: either the record store or one of the indexes of the collection.
+ */
+struct CompactionTarget {
+    std::string name;
+    std::function<StatusWith<bool>(Seconds)> compactIncrementally;
+    std::function<int64_t()> storageSize;
+};
+
+/**
+ * Compacts every target in steps of at most 'compactStepSecs' seconds. After each step, pauses for
+ * as long as needed to keep the space reclaimed per second under 'maxCompactMBperSec'. Since
+ * WiredTiger reclaims space by moving the blocks at the end of a file into its free space, the
+ * space reclaimed is a good estimate of the amount of data written.
+ *
+ * The progress is reported in units of MB reclaimed, against the amount of free space the targets
+ * had to begin with.
+ */
+Status compactThrottled(OperationContext* opCtx,
+                        const std::vector<CompactionTarget>& targets,
+                        int64_t initialFreeBytes) {
+    const int64_t kMB = 1024 * 1024;
+
+    ProgressMeterHolder progress;
+    {
+        stdx::unique_lock<Client> lk(*opCtx->getClient());
+        progress.set(CurOp::get(opCtx)->setProgress_inlock(
+            "Compact: reclaiming space", std::max<int64_t>(initialFreeBytes / kMB, 1)));
+        progress->setUnits("MB");
+    }
+
+    int64_t totalFreedBytes = 0;
+    for (const auto& target : targets) {
+        LOGV2_DEBUG(6010500, 1, "Compacting", "target"_attr = target.name);
+
+        bool done = false;
+        while (!done) {
+            opCtx->checkForInterrupt();
+
+            const auto sizeBefore = target.storageSize();
+            Timer timer;
+            auto swDone = target.compactIncrementally(Seconds(gCompactStepSecs.load()));
+            if (!swDone.isOK()) {
+                return swDone.getStatus();
+            }
+            done = swDone.getValue();
+
+            // The file may grow while it is compacted, if it is written to.
+            const auto freedBytes = std::max<int64_t>(sizeBefore - target.storageSize(), 0);
+            const auto reportedMB = totalFreedBytes / kMB;
+            totalFreedBytes += freedBytes;
+            progress->hit(static_cast<int>(totalFreedBytes / kMB - reportedMB));
+
+            const auto maxBytesPerSec = static_cast<int64_t>(gMaxCompactMBperSec.load()) * kMB;
+            if (done || maxBytesPerSec == 0) {
+                continue;
+            }
+            const Milliseconds pause =
+                Milliseconds(freedBytes * 1000 / maxBytesPerSec) - Milliseconds(timer.millis());
+            if (pause > Milliseconds(0)) {
+                opCtx->sleepFor(pause);
+            }
+        }
+    }
+
+    progress.finished();
+    return Status::OK();
+}
+
 }  // namespace
 
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
@@ -112,14 +185,40 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
     auto oldTotalSize = recordStore->storageSize(opCtx) + collection->getIndexSize(opCtx);
     auto indexCatalog = collection->getIndexCatalog();
 
-    Status status = recordStore->compact(opCtx);
-    if (!status.isOK())
-        return status;
-
-    // Compact all indexes (not including unfinished indexes)
-    status = indexCatalog->compactIndexes(opCtx);
-    if (!status.isOK())
-        return status;
+    if (gMaxCompactMBperSec.load() > 0) {
+        std::vector<CompactionTarget> targets;
+        int64_t initialFreeBytes = recordStore->freeStorageSize(opCtx);
+        targets.push_back({collectionNss.ns(),
+                           [&](Seconds maxTime) {
+                               return recordStore->compactIncrementally(opCtx, maxTime);
+                           },
+                           [&] { return recordStore->storageSize(opCtx); }});
+
+        // Compact all indexes (not including unfinished indexes)
+        auto it = indexCatalog->getIndexIterator(opCtx, /*includeUnfinished*/ false);
+        while (it->more()) {
+            const IndexCatalogEntry* entry = it->next();
+            auto iam = entry->accessMethod();
+            initialFreeBytes += iam->getFreeStorageBytes(opCtx);
+            targets.push_back(
+                {entry->descriptor()->indexName(),
+                 [=](Seconds maxTime) { return iam->compactIncrementally(opCtx, maxTime); },
+                 [=] { return iam->getSpaceUsedBytes(opCtx); }});
+        }
+
+        Status status = compactThrottled(opCtx, targets, initialFreeBytes);
+        if (!status.isOK())
+            return status;
+    } else {
+        Status status = recordStore->compact(opCtx);
+        if (!status.isOK())
+            return status;
+
+        // Compact all indexes (not including unfinished indexes)
+        status = indexCatalog->compactIndexes(opCtx);
+        if (!status.isOK())
+            return status;
+    }
 
     auto totalSizeDiff =
         oldTotalSize - recordStore->storageSize(opCtx) - collection->getIndexSize(opCtx);
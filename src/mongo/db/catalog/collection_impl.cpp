@@ -117,6 +117,17 @@ MONGO_FAIL_POINT_DEFINE(corruptDocumentOnInsert);
 
 MONGO_FAIL_POINT_DEFINE(skipCappedDeletes);
 
+// Used to pause a capped delete which holds '_cappedFirstRecordMutex'. Supports limiting the pause
+// to a collection:
+//  data: {
+//      collectionNS: <fully-qualified collection namespace>
+//  }
+MONGO_FAIL_POINT_DEFINE(hangWithCappedFirstRecordMutex);
+
+// Upper bound on how far past its size cap an unreplicated capped collection may grow while
+// another writer holds '_cappedFirstRecordMutex' before inserters block on the capped delete.
+const long long kCappedMaxSizeSlackBytes = 16 * 1024 * 1024;
+
 /**
  * Checks the 'failCollectionInserts' fail point at the beginning of an insert operation to see if
  * the insert should fail. Returns Status::OK if The function should proceed with the insertion.
@@ -979,12 +990,31 @@ void CollectionImpl::_cappedDeleteAsNeeded(OperationContext* opCtx,
         // two-phase locking semantics.
         invariant(opCtx->lockState()->getLockMode(ResourceId(RESOURCE_METADATA, _ns.ns())) ==
                   MODE_X);
-    } else {
+    } else if (!cappedFirstRecordMutex.try_lock()) {
         // Capped deletes not performed under the capped lock need the '_cappedFirstRecordMutex'
-        // mutex.
+        // mutex. Another writer is already deleting old records and will account for this insert
+        // when it recomputes how far over the cap the collection is, so only block when the
+        // collection has grown past the slack allowance to apply back-pressure to inserters.
+        const auto cappedMaxSize = _shared->_collectionLatest->getCollectionOptions().cappedSize;
+        const long long sizeSlack = std::min(cappedMaxSize / 10, kCappedMaxSizeSlackBytes);
+        const long long docsSlack = _shared->_cappedMaxDocs / 10;
+        if (dataSize(opCtx) - cappedMaxSize < sizeSlack &&
+            (_shared->_cappedMaxDocs == 0 ||
+             numRecords(opCtx) - _shared->_cappedMaxDocs < docsSlack)) {
+            return;
+        }
         cappedFirstRecordMutex.lock();
     }
 
+    if (cappedFirstRecordMutex.owns_lock()) {
+        hangWithCappedFirstRecordMutex.executeIf(
+            [&](const BSONObj&) { hangWithCappedFirstRecordMutex.pauseWhileSet(opCtx); },
+            [&](const BSONObj& data) {
+                const auto collElem = data["collectionNS"];
+                return !collElem || ns().ns() == collElem.str();
+            });
+    }
+
     boost::optional<CappedDeleteSideTxn> cappedDeleteSideTxn;
     if (useOldCappedDeleteBehaviour || !_shared->_needCappedLock) {
         // In FCV < 5.0, all capped deletes are performed in a side transaction. Additionally, any
@@ -1149,7 +1179,8 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
                                     OpDebug* opDebug,
                                     bool fromMigrate,
                                     bool noWarn,
-                                    Collection::StoreDeletedDoc storeDeletedDoc) const {
+                                    Collection::StoreDeletedDoc storeDeletedDoc,
+                                    const boost::optional<OplogSlot>& oplogSlot) const {
     if (isCapped() && opCtx->isEnforcingConstraints()) {
         // System operations such as tenant migration or secondary batch application can delete from
         // capped collections.
@@ -1157,15 +1188,28 @@ void CollectionImpl::deleteDocument(OperationContext* opCtx,
         uasserted(10089, "cannot remove from a capped collection");
     }
 
-    const auto oplogSlot = reserveOplogSlotsForRetryableFindAndModify(opCtx);
-    OpObserver::OplogDeleteEntryArgs deleteArgs{
-        nullptr, fromMigrate, getRecordPreImages(), oplogSlot, oplogSlot != boost::none};
+    // Change streams filter out the deletes done by chunk migrations and range deletion, so unless
+    // asked to, don't log the whole document a second time for them.
+    const bool recordPreImage = getRecordPreImages() &&
+        (!fromMigrate || repl::recordPreImagesForMigrationDeletes.load());
+
+    // A pre-image is logged ahead of the delete with an OpTime of its own, which would come after
+    // an OpTime that the caller reserved for the delete.
+    invariant(!oplogSlot || (!recordPreImage && !opCtx->getTxnNumber()));
+
+    const auto retryableFindAndModifySlot =
+        oplogSlot ? boost::none : reserveOplogSlotsForRetryableFindAndModify(opCtx);
+    OpObserver::OplogDeleteEntryArgs deleteArgs{nullptr,
+                                                fromMigrate,
+                                                recordPreImage,
+                                                oplogSlot ? oplogSlot : retryableFindAndModifySlot,
+                                                retryableFindAndModifySlot != boost::none};
 
     getGlobalServiceContext()->getOpObserver()->aboutToDelete(opCtx, ns(), doc.value());
 
     boost::optional<BSONObj> deletedDoc;
     if ((storeDeletedDoc == Collection::StoreDeletedDoc::On && opCtx->getTxnNumber()) ||
-        getRecordPreImages()) {
+        recordPreImage) {
         deletedDoc.emplace(doc.value().getOwned());
     }
     int64_t keysDeleted;
@@ -1307,15 +1351,18 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
     const Snapshotted<RecordData>& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages,
+    bool indexesAffected,
+    OpDebug* opDebug,
     CollectionUpdateArgs* args) const {
     dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
     invariant(oldRec.snapshotId() == opCtx->recoveryUnit()->getSnapshotId());
     invariant(updateWithDamagesSupported());
 
     // For in-place updates we need to grab an owned copy of the pre-image doc if pre-image
-    // recording is enabled and we haven't already set the pre-image due to this update being
-    // a retryable findAndModify or a possible update to the shard key.
-    if (!args->preImageDoc && getRecordPreImages()) {
+    // recording is enabled or the index keys of the old document must be removed, and we haven't
+    // already set the pre-image due to this update being a retryable findAndModify or a possible
+    // update to the shard key.
+    if (!args->preImageDoc && (indexesAffected || getRecordPreImages())) {
         args->preImageDoc = oldRec.value().toBson().getOwned();
     }
     const bool storePrePostImage =
@@ -1336,6 +1383,24 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
 
     if (newRecStatus.isOK()) {
         args->updatedDoc = newRecStatus.getValue().toBson();
+
+        if (indexesAffected) {
+            int64_t keysInserted, keysDeleted;
+
+            uassertStatusOK(_indexCatalog->updateRecord(opCtx,
+                                                        {this, CollectionPtr::NoYieldTag{}},
+                                                        *args->preImageDoc,
+                                                        args->updatedDoc,
+                                                        loc,
+                                                        &keysInserted,
+                                                        &keysDeleted));
+
+            if (opDebug) {
+                opDebug->additiveMetrics.incrementKeysInserted(keysInserted);
+                opDebug->additiveMetrics.incrementKeysDeleted(keysDeleted);
+            }
+        }
+
         args->preImageRecordingEnabledForCollection = getRecordPreImages();
         OplogUpdateEntryArgs entryArgs(*args, ns(), _uuid);
         getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, entryArgs);
@@ -164,6 +164,8 @@ public:
      * 'noWarn' if unindexing the record causes an error, if noWarn is true the error
      * will not be logged.
      * 'storeDeletedDoc' whether to store the document deleted in the oplog.
+     * 'oplogSlot' the OpTime reserved for the delete by the caller, which has timestamped the
+     * write with it.
      */
     void deleteDocument(
         OperationContext* opCtx,
@@ -173,7 +175,8 @@ public:
         OpDebug* opDebug,
         bool fromMigrate = false,
         bool noWarn = false,
-        Collection::StoreDeletedDoc storeDeletedDoc = Collection::StoreDeletedDoc::Off) const final;
+        Collection::StoreDeletedDoc storeDeletedDoc = Collection::StoreDeletedDoc::Off,
+        const boost::optional<OplogSlot>& oplogSlot = boost::none) const final;
 
     /*
      * Inserts all documents inside one WUOW.
@@ -238,7 +241,8 @@ public:
     bool updateWithDamagesSupported() const final;
 
     /**
-     * Not allowed to modify indexes.
+     * Applies 'damages' to the record @ loc in place, updating the index entries of the document
+     * if 'indexesAffected' is true.
      * Illegal to call if updateWithDamagesSupported() returns false.
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
@@ -249,6 +253,8 @@ public:
                                                      const Snapshotted<RecordData>& oldRec,
                                                      const char* damageSource,
                                                      const mutablebson::DamageVector& damages,
+                                                     bool indexesAffected,
+                                                     OpDebug* opDebug,
                                                      CollectionUpdateArgs* args) const final;
 
     // -----------
@@ -134,7 +134,8 @@ public:
         OpDebug* opDebug,
         bool fromMigrate = false,
         bool noWarn = false,
-        Collection::StoreDeletedDoc storeDeletedDoc = Collection::StoreDeletedDoc::Off) const {
+        Collection::StoreDeletedDoc storeDeletedDoc = Collection::StoreDeletedDoc::Off,
+        const boost::optional<OplogSlot>& oplogSlot = boost::none) const {
         std::abort();
     }
 
@@ -184,6 +185,8 @@ public:
                                                      const Snapshotted<RecordData>& oldRec,
                                                      const char* damageSource,
                                                      const mutablebson::DamageVector& damages,
+                                                     bool indexesAffected,
+                                                     OpDebug* opDebug,
                                                      CollectionUpdateArgs* args) const {
         std::abort();
     }
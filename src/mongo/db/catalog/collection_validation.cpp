@@ -38,12 +38,17 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_consistency.h"
+#include "mongo/db/catalog/throttle_cursor.h"
 #include "mongo/db/catalog/validate_adaptor.h"
+#include "mongo/db/catalog/validate_gen.h"
+#include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 
@@ -104,6 +109,193 @@ void _validateIndexesInternalStructure(OperationContext* opCtx,
     }
 }
 
+/**
+ * Returns the number of threads to use to traverse the indexes during the first phase of
+ * validation.
+ */
+size_t _getNumIndexTraversalThreads(ValidateState* validateState) {
+    // Adjusting the multikey metadata writes to the catalog from the index traversal, which must
+    // happen from the thread holding the collection lock.
+    if (validateState->adjustMultikey()) {
+        return 1;
+    }
+
+    // Without a read timestamp, a snapshot opened by another thread could see writes that happened
+    // after the record store was traversed.
+    if (validateState->isBackground() && !validateState->getValidateTimestamp()) {
+        return 1;
+    }
+
+    return std::min(static_cast<size_t>(gMaxValidateIndexTraversalThreads.load()),
+                    validateState->getIndexes().size());
+}
+
+/**
+ * Traverses 'index' from a thread other than the one running the validation, with its own client,
+ * OperationContext and cursor. The index key counts in 'indexConsistency' are updated as usual,
+ * but the results of the traversal are reported in 'results', which is owned by the caller.
+ *
+ * No locks are taken: the thread running the validation holds its locks, and does not yield
+ * them, until all the indexes have been traversed. Taking locks here could deadlock with a
+ * pending exclusive lock request queued behind those.
+ */
+void _traverseIndexConcurrently(OperationContext* parentOpCtx,
+                                ValidateState* validateState,
+                                IndexConsistency* indexConsistency,
+                                const IndexCatalogEntry* index,
+                                int64_t* numTraversedKeys,
+                                ValidateResults* results) {
+    auto client = parentOpCtx->getServiceContext()->makeClient("ValidateIndexTraversal");
+    AlternativeClientRegion acr(client);
+    auto opCtxHolder = cc().makeOperationContext();
+    auto opCtx = opCtxHolder.get();
+
+    if (validateState->isBackground()) {
+        // Read from the same point in time as the record store traversal.
+        opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
+                                                      *validateState->getValidateTimestamp());
+    } else {
+        // The collection is locked exclusively, so this is the same data the record store
+        // traversal saw. Ignore prepare conflicts like the foreground validation does.
+        opCtx->recoveryUnit()->setPrepareConflictBehavior(
+            PrepareConflictBehavior::kIgnoreConflicts);
+    }
+    ON_BLOCK_EXIT([&] { opCtx->recoveryUnit()->abandonSnapshot(); });
+
+    DataThrottle dataThrottle(opCtx);
+    if (!validateState->isBackground()) {
+        dataThrottle.turnThrottlingOff();
+    }
+    SortedDataInterfaceThrottleCursor indexCursor(opCtx, index->accessMethod(), &dataThrottle);
+
+    ValidateAdaptor indexValidator(indexConsistency, validateState);
+    indexValidator.traverseIndex(
+        opCtx,
+        index,
+        &indexCursor,
+        [&] {
+            // Stop as soon as the validation is interrupted. The parent OperationContext cannot
+            // be checked for interrupts from this thread, but its kill status can be read.
+            auto killStatus = parentOpCtx->getKillStatus();
+            if (killStatus != ErrorCodes::OK) {
+                uasserted(killStatus, "Interrupted while traversing index for validation");
+            }
+
+            // Release the snapshot to avoid building cache pressure. The history needed to read
+            // at the same point in time is kept by the snapshot of the parent OperationContext.
+            indexCursor.save();
+            opCtx->recoveryUnit()->abandonSnapshot();
+            indexCursor.restore();
+        },
+        numTraversedKeys,
+        results);
+}
+
+/**
+ * Traverses every index in 'validateState' and stores the number of keys traversed in each in
+ * 'numTraversedKeysPerIndex'. The indexes are traversed concurrently when possible.
+ */
+void _traverseIndexes(OperationContext* opCtx,
+                      ValidateState* validateState,
+                      IndexConsistency* indexConsistency,
+                      ValidateAdaptor* indexValidator,
+                      ValidateResults* results,
+                      std::map<std::string, int64_t>* numTraversedKeysPerIndex) {
+    const auto numThreads = _getNumIndexTraversalThreads(validateState);
+    if (numThreads <= 1) {
+        for (const auto& index : validateState->getIndexes()) {
+            opCtx->checkForInterrupt();
+
+            const IndexDescriptor* descriptor = index->descriptor();
+
+            LOGV2_OPTIONS(20296,
+                          {LogComponent::kIndex},
+                          "Validating index consistency",
+                          "index"_attr = descriptor->indexName(),
+                          "namespace"_attr = validateState->nss());
+
+            int64_t numTraversedKeys;
+            indexValidator->traverseIndex(opCtx, index.get(), &numTraversedKeys, results);
+            (*numTraversedKeysPerIndex)[descriptor->indexName()] = numTraversedKeys;
+        }
+        return;
+    }
+
+    LOGV2_OPTIONS(6010400,
+                  {LogComponent::kIndex},
+                  "Validating index consistency concurrently",
+                  "numIndexes"_attr = validateState->getIndexes().size(),
+                  "numThreads"_attr = numThreads,
+                  "namespace"_attr = validateState->nss());
+
+    ThreadPool::Options options;
+    options.poolName = "ValidateIndexTraversal";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    ThreadPool pool(options);
+    pool.startup();
+
+    // Each index gets its own results, which are merged once all the indexes have been traversed.
+    struct IndexTraversal {
+        const IndexCatalogEntry* index;
+        int64_t numTraversedKeys = 0;
+        ValidateResults results;
+        Status status = Status::OK();
+    };
+    std::vector<IndexTraversal> traversals;
+    traversals.reserve(validateState->getIndexes().size());
+    for (const auto& index : validateState->getIndexes()) {
+        traversals.push_back(IndexTraversal{index.get()});
+    }
+
+    for (auto& traversal : traversals) {
+        pool.schedule([&](Status status) {
+            if (!status.isOK()) {
+                traversal.status = status;
+                return;
+            }
+
+            LOGV2_OPTIONS(6010401,
+                          {LogComponent::kIndex},
+                          "Validating index consistency",
+                          "index"_attr = traversal.index->descriptor()->indexName(),
+                          "namespace"_attr = validateState->nss());
+            try {
+                _traverseIndexConcurrently(opCtx,
+                                           validateState,
+                                           indexConsistency,
+                                           traversal.index,
+                                           &traversal.numTraversedKeys,
+                                           &traversal.results);
+            } catch (const DBException& ex) {
+                traversal.status = ex.toStatus();
+            }
+        });
+    }
+
+    pool.shutdown();
+    pool.join();
+
+    opCtx->checkForInterrupt();
+    for (auto& traversal : traversals) {
+        uassertStatusOK(traversal.status);
+
+        const auto& indexName = traversal.index->descriptor()->indexName();
+        (*numTraversedKeysPerIndex)[indexName] = traversal.numTraversedKeys;
+        results->indexResultsMap[indexName] =
+            std::move(traversal.results.indexResultsMap[indexName]);
+        results->errors.insert(results->errors.end(),
+                               std::make_move_iterator(traversal.results.errors.begin()),
+                               std::make_move_iterator(traversal.results.errors.end()));
+        results->warnings.insert(results->warnings.end(),
+                                 std::make_move_iterator(traversal.results.warnings.begin()),
+                                 std::make_move_iterator(traversal.results.warnings.end()));
+        if (!traversal.results.valid) {
+            results->valid = false;
+        }
+    }
+}
+
 /**
  * Validates each index in the Index Catalog using the cursors in 'indexCursors'.
  *
@@ -112,22 +304,17 @@ void _validateIndexesInternalStructure(OperationContext* opCtx,
  */
 void _validateIndexes(OperationContext* opCtx,
                       ValidateState* validateState,
+                      IndexConsistency* indexConsistency,
                       ValidateAdaptor* indexValidator,
                       ValidateResults* results) {
     // Validate Indexes, checking for mismatch between index entries and collection records.
-    for (const auto& index : validateState->getIndexes()) {
-        opCtx->checkForInterrupt();
+    std::map<std::string, int64_t> numTraversedKeysPerIndex;
+    _traverseIndexes(
+        opCtx, validateState, indexConsistency, indexValidator, results, &numTraversedKeysPerIndex);
 
+    for (const auto& index : validateState->getIndexes()) {
         const IndexDescriptor* descriptor = index->descriptor();
-
-        LOGV2_OPTIONS(20296,
-                      {LogComponent::kIndex},
-                      "Validating index consistency",
-                      "index"_attr = descriptor->indexName(),
-                      "namespace"_attr = validateState->nss());
-
-        int64_t numTraversedKeys;
-        indexValidator->traverseIndex(opCtx, index.get(), &numTraversedKeys, results);
+        const int64_t numTraversedKeys = numTraversedKeysPerIndex[descriptor->indexName()];
 
         auto& curIndexResults = (results->indexResultsMap)[descriptor->indexName()];
         curIndexResults.keysTraversed = numTraversedKeys;
@@ -544,7 +731,7 @@ Status validate(OperationContext* opCtx,
         }
 
         // Validate indexes and check for mismatches.
-        _validateIndexes(opCtx, &validateState, &indexValidator, results);
+        _validateIndexes(opCtx, &validateState, &indexConsistency, &indexValidator, results);
 
         if (indexConsistency.haveEntryMismatch()) {
             LOGV2_OPTIONS(20305,
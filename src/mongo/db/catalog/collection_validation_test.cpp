@@ -34,6 +34,8 @@
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
@@ -316,5 +318,121 @@ TEST_F(BackgroundCollectionValidationTest, BackgroundValidateRunsConcurrentlyWit
                        0);
 }
 
+/**
+ * Creates the indexes {a: 1}, {b: 1} and {c: 1} on the empty kNss collection, then inserts
+ * 'numDocs' documents into it.
+ */
+void setUpIndexedData(OperationContext* opCtx, int numDocs) {
+    AutoGetCollection coll(opCtx, kNss, MODE_X);
+    {
+        WriteUnitOfWork wuow(opCtx);
+        auto writableColl = coll.getWritableCollection();
+        for (auto field : {"a", "b", "c"}) {
+            ASSERT_OK(writableColl->getIndexCatalog()->createIndexOnEmptyCollection(
+                opCtx,
+                writableColl,
+                BSON("v" << 2 << "name" << std::string(field) + "_1" << "key"
+                         << BSON(field << 1))));
+        }
+        wuow.commit();
+    }
+
+    std::vector<InsertStatement> inserts;
+    for (int i = 0; i < numDocs; ++i) {
+        inserts.push_back(InsertStatement(BSON("_id" << i << "a" << i << "b" << -i << "c" << 0)));
+    }
+    WriteUnitOfWork wuow(opCtx);
+    ASSERT_OK(coll->insertDocuments(opCtx, inserts.begin(), inserts.end(), nullptr, false));
+    wuow.commit();
+}
+
+/**
+ * Removes the key {b: -'id'} pointing to the document with _id 'id' from the {b: 1} index.
+ */
+void removeIndexKeyForB(OperationContext* opCtx, int id) {
+    AutoGetCollection coll(opCtx, kNss, MODE_X);
+    auto descriptor = coll->getIndexCatalog()->findIndexByName(opCtx, "b_1");
+    ASSERT(descriptor);
+    auto iam = coll->getIndexCatalog()->getEntry(descriptor)->accessMethod();
+
+    RecordId recordId;
+    auto cursor = coll->getCursor(opCtx);
+    while (auto record = cursor->next()) {
+        if (record->data.toBson()["_id"].numberInt() == id) {
+            recordId = record->id;
+            break;
+        }
+    }
+    ASSERT(!recordId.isNull());
+
+    auto sdi = iam->getSortedDataInterface();
+    KeyString::HeapBuilder keyString(
+        sdi->getKeyStringVersion(), BSON("" << -id), sdi->getOrdering(), recordId);
+
+    WriteUnitOfWork wuow(opCtx);
+    sdi->unindex(opCtx, keyString.getValueCopy(), /*dupsAllowed*/ true);
+    wuow.commit();
+}
+
+/**
+ * Runs validate in 'mode' with 'numThreads' index traversal threads.
+ */
+BSONObj validateWithIndexTraversalThreads(OperationContext* opCtx,
+                                          CollectionValidation::ValidateMode mode,
+                                          int numThreads,
+                                          ValidateResults* validateResults) {
+    RAIIServerParameterControllerForTest controller("maxValidateIndexTraversalThreads",
+                                                    numThreads);
+    BSONObjBuilder output;
+    ASSERT_OK(CollectionValidation::validate(opCtx,
+                                             kNss,
+                                             mode,
+                                             CollectionValidation::RepairMode::kNone,
+                                             validateResults,
+                                             &output));
+    return output.obj();
+}
+
+TEST_F(CollectionValidationTest, ValidateTraversesIndexesConcurrently) {
+    auto opCtx = operationContext();
+    setUpIndexedData(opCtx, 100);
+
+    for (auto mode : {CollectionValidation::ValidateMode::kForeground,
+                      CollectionValidation::ValidateMode::kForegroundFull}) {
+        ValidateResults validateResults;
+        auto obj = validateWithIndexTraversalThreads(opCtx, mode, 4, &validateResults);
+        ASSERT(validateResults.valid) << obj;
+        ASSERT_EQ(validateResults.errors.size(), 0U) << obj;
+        ASSERT_EQ(obj.getIntField("nIndexes"), 4);
+
+        auto keysPerIndex = obj.getObjectField("keysPerIndex");
+        for (auto indexName : {"_id_", "a_1", "b_1", "c_1"}) {
+            ASSERT_EQ(keysPerIndex.getIntField(indexName), 100) << obj;
+        }
+    }
+}
+
+TEST_F(CollectionValidationTest, ConcurrentIndexTraversalReportsSameErrorsAsSerial) {
+    auto opCtx = operationContext();
+    setUpIndexedData(opCtx, 100);
+    removeIndexKeyForB(opCtx, 42);
+
+    ValidateResults serialResults;
+    validateWithIndexTraversalThreads(
+        opCtx, CollectionValidation::ValidateMode::kForeground, 1, &serialResults);
+    ASSERT_FALSE(serialResults.valid);
+    ASSERT_EQ(serialResults.missingIndexEntries.size(), 1U);
+
+    ValidateResults concurrentResults;
+    auto obj = validateWithIndexTraversalThreads(
+        opCtx, CollectionValidation::ValidateMode::kForeground, 4, &concurrentResults);
+    ASSERT_FALSE(concurrentResults.valid);
+    ASSERT(concurrentResults.errors == serialResults.errors);
+    ASSERT_EQ(concurrentResults.missingIndexEntries.size(), 1U);
+    ASSERT_BSONOBJ_EQ(concurrentResults.missingIndexEntries[0],
+                      serialResults.missingIndexEntries[0]);
+    ASSERT_EQ(obj.getObjectField("keysPerIndex").getIntField("b_1"), 99) << obj;
+}
+
 }  // namespace
 }  // namespace mongo
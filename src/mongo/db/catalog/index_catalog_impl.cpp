@@ -712,6 +712,40 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx,
         }
     }
 
+    if (pluginName == IndexNames::COLUMN) {
+        if (!feature_flags::gColumnstoreIndexes.isEnabled(
+                serverGlobalParams.featureCompatibility)) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' requires featureFlagColumnstoreIndexes");
+        }
+
+        if (isSparse) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' does not support the sparse option");
+        }
+
+        if (spec["unique"].trueValue()) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' does not support the unique option");
+        }
+
+        if (spec.getField("expireAfterSeconds")) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream()
+                              << "Index type '" << pluginName << "' cannot be a TTL index");
+        }
+
+        // The cells of a columnstore index are ordered by RecordId, which is encoded as a long.
+        if (collection->isClustered()) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          str::stream() << "Index type '" << pluginName
+                                        << "' is not supported on clustered collections");
+        }
+    }
+
     // Create an ExpressionContext, used to parse the match expression and to house the collator for
     // the remaining checks.
     boost::intrusive_ptr<ExpressionContext> expCtx(
@@ -32,6 +32,7 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/validate_state.h"
 #include "mongo/db/storage/key_string.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -115,6 +116,8 @@ public:
      * corresponding `_indexKeyCount` by hashing it.
      * For the second phase of validation, try to match the index entry keys that hashed to
      * inconsistent hash buckets during the first phase of validation to document keys.
+     *
+     * During the first phase, this may be called concurrently for keys of different indexes.
      */
     void addIndexKey(OperationContext* opCtx,
                      const KeyString::Value& ks,
@@ -178,9 +181,11 @@ public:
     bool limitMemoryUsageForSecondPhase(ValidateResults* result);
 
 private:
+    // The counters are atomic so that several indexes can be traversed concurrently during the
+    // first phase of validation.
     struct IndexKeyBucket {
-        uint32_t indexKeyCount;
-        uint32_t bucketSizeBytes;
+        AtomicWord<uint32_t> indexKeyCount;
+        AtomicWord<uint32_t> bucketSizeBytes;
     };
 
     IndexConsistency() = delete;
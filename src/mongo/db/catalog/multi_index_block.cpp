@@ -53,6 +53,7 @@
 #include "mongo/db/repl/tenant_migration_conflict_info.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/db/worker_pool.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
@@ -74,6 +75,14 @@ MONGO_FAIL_POINT_DEFINE(leaveIndexBuildUnfinishedForShutdown);
 
 namespace {
 
+// Generates the keys of the documents read by index build collection scans concurrently.
+const WorkerPool indexBuildKeyGenerationWorkers("IndexBuildKeyGeneration", 64);
+
+// Limits on the documents buffered by the collection scan before their keys are generated
+// concurrently.
+constexpr size_t kMaxDocumentsPerKeyGenerationBatch = 1024;
+constexpr size_t kMaxKeyGenerationBatchBytes = 16 * 1024 * 1024;
+
 size_t getEachIndexBuildMaxMemoryUsageBytes(size_t numIndexSpecs) {
     if (numIndexSpecs == 0) {
         return 0;
@@ -574,6 +583,25 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
               IndexBuildPhase_serializer(_phase).toString());
     _phase = IndexBuildPhaseEnum::kCollectionScan;
 
+    // The collection scan and all writes remain on this thread, which keeps the order of the
+    // inserts, and thereby '_lastRecordIdInserted', consistent with the scan. Only the key
+    // generation of batches of documents is spread across threads.
+    const auto numKeyGenerationThreads =
+        static_cast<size_t>(maxIndexBuildKeyGenerationThreads.load());
+    std::vector<std::pair<BSONObj, RecordId>> batch;
+    size_t batchBytes = 0;
+    auto insertBatch = [&] {
+        _insertBatch(opCtx,
+                     collection,
+                     batch,
+                     numKeyGenerationThreads,
+                     progress,
+                     /*saveCursorBeforeWrite*/ [&exec] { exec->saveState(); },
+                     /*restoreCursorAfterWrite*/ [&] { exec->restoreState(&collection); });
+        batch.clear();
+        batchBytes = 0;
+    };
+
     BSONObj objToIndex;
     RecordId loc;
     PlanExecutor::ExecState state;
@@ -592,7 +620,19 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
                                       &hangIndexBuildDuringCollectionScanPhaseBeforeInsertion,
                                       "before",
                                       objToIndex,
-                                      (*progress)->hits()));
+                                      (*progress)->hits() + batch.size()));
+
+        if (numKeyGenerationThreads > 1) {
+            // The document must outlive the position of the cursor, which moves on before the
+            // keys of the batch are generated.
+            batchBytes += objToIndex.objsize();
+            batch.emplace_back(objToIndex.getOwned(), loc);
+            if (batch.size() >= kMaxDocumentsPerKeyGenerationBatch ||
+                batchBytes >= kMaxKeyGenerationBatchBytes) {
+                insertBatch();
+            }
+            continue;
+        }
 
         // The external sorter is not part of the storage engine and therefore does not need
         // a WriteUnitOfWork to write keys.
@@ -620,6 +660,80 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
         // Go to the next document.
         progress->hit();
     }
+
+    if (!batch.empty()) {
+        insertBatch();
+    }
+}
+
+void MultiIndexBlock::_insertBatch(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   const std::vector<std::pair<BSONObj, RecordId>>& batch,
+                                   size_t numThreads,
+                                   ProgressMeterHolder* progress,
+                                   const std::function<void()>& saveCursorBeforeWrite,
+                                   const std::function<void()>& restoreCursorAfterWrite) {
+    invariant(!_buildIsCleanedUp);
+    using GeneratedKeys = IndexAccessMethod::BulkBuilder::GeneratedKeys;
+
+    // The keys of document 'j' for index 'i' are in slot 'j * _indexes.size() + i', which stays
+    // empty if the document does not match the filter of the index.
+    std::vector<boost::optional<GeneratedKeys>> generatedKeys(batch.size() * _indexes.size());
+
+    // Every thread generates the keys of a contiguous range of the batch.
+    const size_t numRanges = std::min(numThreads, batch.size());
+    const size_t rangeSize = (batch.size() + numRanges - 1) / numRanges;
+    auto generateKeysForRange = [&](OperationContext* keyGenOpCtx, size_t rangeId) {
+        const size_t end = std::min(batch.size(), (rangeId + 1) * rangeSize);
+        for (size_t j = rangeId * rangeSize; j < end; ++j) {
+            const auto& [doc, loc] = batch[j];
+            for (size_t i = 0; i < _indexes.size(); ++i) {
+                if (_indexes[i].filterExpression &&
+                    !_indexes[i].filterExpression->matchesBSON(doc)) {
+                    continue;
+                }
+
+                auto& slot = generatedKeys[j * _indexes.size() + i];
+                slot.emplace();
+                _indexes[i].bulk->generateKeys(
+                    keyGenOpCtx, collection, doc, loc, _indexes[i].options, &*slot);
+            }
+        }
+    };
+
+    uassertStatusOK(indexBuildKeyGenerationWorkers.runTasks(
+        opCtx, numRanges, [&](OperationContext* keyGenOpCtx, size_t rangeId) {
+            generateKeysForRange(keyGenOpCtx, rangeId);
+        }));
+
+    // The keys are inserted in the order of the collection scan, on this thread, since inserting
+    // them may write to the skipped records side table of the index build.
+    for (size_t j = 0; j < batch.size(); ++j) {
+        const auto& [doc, loc] = batch[j];
+        for (size_t i = 0; i < _indexes.size(); ++i) {
+            auto& slot = generatedKeys[j * _indexes.size() + i];
+            if (!slot) {
+                continue;
+            }
+
+            uassertStatusOK(_indexes[i].bulk->insertGeneratedKeys(opCtx,
+                                                                  doc,
+                                                                  loc,
+                                                                  std::move(*slot),
+                                                                  saveCursorBeforeWrite,
+                                                                  restoreCursorAfterWrite));
+        }
+        _lastRecordIdInserted = loc;
+
+        _failPointHangDuringBuild(opCtx,
+                                  &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
+                                  "after",
+                                  doc,
+                                  (*progress)->hits())
+            .ignore();
+
+        progress->hit();
+    }
 }
 
 Status MultiIndexBlock::insertSingleDocumentForInitialSyncOrRecovery(
@@ -328,6 +328,19 @@ private:
                    const std::function<void()>& saveCursorBeforeWrite,
                    const std::function<void()>& restoreCursorAfterWrite);
 
+    /**
+     * Generates the keys of the documents in 'batch' on up to 'numThreads' threads, then inserts
+     * them in the order of 'batch', as if by calling _insert() for each document. Throws if the
+     * keys of any document could not be generated or inserted.
+     */
+    void _insertBatch(OperationContext* opCtx,
+                      const CollectionPtr& collection,
+                      const std::vector<std::pair<BSONObj, RecordId>>& batch,
+                      size_t numThreads,
+                      ProgressMeterHolder* progress,
+                      const std::function<void()>& saveCursorBeforeWrite,
+                      const std::function<void()>& restoreCursorAfterWrite);
+
     /**
      * Performs a collection scan on the given collection and inserts the relevant index keys into
      * the external sorter.
@@ -32,9 +32,11 @@
 #include "mongo/db/catalog/multi_index_block.h"
 
 #include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog/multi_index_block_gen.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -195,5 +197,61 @@ TEST_F(MultiIndexBlockTest, InitWriteConflictException) {
     indexer->abortIndexBuild(operationContext(), coll, MultiIndexBlock::kNoopOnCleanUpFn);
 }
 
+TEST_F(MultiIndexBlockTest, GenerateKeysOnMultipleThreadsDuringCollectionScan) {
+    RAIIServerParameterControllerForTest controller{"maxIndexBuildKeyGenerationThreads", 4};
+    auto indexer = getIndexer();
+
+    AutoGetCollection autoColl(operationContext(), getNSS(), MODE_X);
+    CollectionWriter coll(autoColl);
+
+    // Enough documents for several batches, every tenth of which makes the index on 'a' multikey.
+    const int numDocs = 3000;
+    for (int j = 0; j < numDocs; ++j) {
+        auto doc = j % 10 == 0 ? BSON("_id" << j << "a" << BSON_ARRAY(j << j + 1) << "b" << j)
+                               : BSON("_id" << j << "a" << j << "b" << j);
+        WriteUnitOfWork wuow(operationContext());
+        ASSERT_OK(coll->insertDocument(operationContext(), InsertStatement(doc), nullptr));
+        wuow.commit();
+    }
+
+    const auto indexVersion = static_cast<int>(IndexDescriptor::kLatestIndexVersion);
+    BSONObj aSpec = BSON("key" << BSON("a" << 1) << "name"
+                               << "a_1"
+                               << "v" << indexVersion);
+    BSONObj bSpec = BSON("key" << BSON("b" << 1) << "name"
+                               << "b_1"
+                               << "v" << indexVersion << "partialFilterExpression"
+                               << BSON("b" << BSON("$gte" << numDocs / 2)));
+    {
+        WriteUnitOfWork wuow(operationContext());
+        ASSERT_OK(
+            indexer->init(operationContext(), coll, {aSpec, bSpec}, MultiIndexBlock::kNoopOnInitFn)
+                .getStatus());
+        wuow.commit();
+    }
+
+    ASSERT_OK(indexer->insertAllDocumentsInCollection(operationContext(), coll.get()));
+    ASSERT_OK(indexer->dumpInsertsFromBulk(operationContext(), coll.get()));
+    ASSERT_OK(indexer->checkConstraints(operationContext(), coll.get()));
+    {
+        WriteUnitOfWork wuow(operationContext());
+        ASSERT_OK(indexer->commit(operationContext(),
+                                  coll.getWritableCollection(),
+                                  MultiIndexBlock::kNoopOnCreateEachFn,
+                                  MultiIndexBlock::kNoopOnCommitFn));
+        wuow.commit();
+    }
+
+    auto indexCatalog = coll->getIndexCatalog();
+    auto aEntry = indexCatalog->getEntry(indexCatalog->findIndexByName(operationContext(), "a_1"));
+    auto bEntry = indexCatalog->getEntry(indexCatalog->findIndexByName(operationContext(), "b_1"));
+    ASSERT_EQ(numDocs + numDocs / 10,
+              aEntry->accessMethod()->getSortedDataInterface()->numEntries(operationContext()));
+    ASSERT_EQ(numDocs / 2,
+              bEntry->accessMethod()->getSortedDataInterface()->numEntries(operationContext()));
+    ASSERT_TRUE(aEntry->isMultikey(operationContext(), coll.get()));
+    ASSERT_FALSE(bEntry->isMultikey(operationContext(), coll.get()));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -155,8 +155,9 @@ void DataThrottle::awaitIfNeeded(OperationContext* opCtx, const int64_t dataSize
         return;
     }
 
-    // No throttling should take place if 'gMaxValidateMBperSec' is zero.
-    uint64_t maxValidateBytesPerSec = gMaxValidateMBperSec.load() * 1024 * 1024;
+    // No throttling should take place if the limit is zero.
+    uint64_t maxMBPerSec = _getMaxMBPerSec ? _getMaxMBPerSec() : gMaxValidateMBperSec.load();
+    uint64_t maxValidateBytesPerSec = maxMBPerSec * 1024 * 1024;
     if (maxValidateBytesPerSec == 0) {
         return;
     }
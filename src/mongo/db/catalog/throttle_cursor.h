@@ -30,6 +30,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 #include "mongo/db/storage/record_store.h"
@@ -118,26 +119,28 @@ private:
 
 /**
  * Throttles the amount of data processed within a unit of time. Puts the thread to sleep via an
- * opCtx -- so it is interruptible -- whenever the data limit set by the 'maxValidateMBperSec'
- * server parameter is exceeded before the time unit is done.
+ * opCtx -- so it is interruptible -- whenever the data limit is exceeded before the time unit is
+ * done. The limit is set by the 'maxValidateMBperSec' server parameter, unless a different source
+ * for the limit is passed in.
  */
 class DataThrottle {
 public:
-    DataThrottle(OperationContext* opCtx)
+    DataThrottle(OperationContext* opCtx, std::function<int()> getMaxMBPerSec = nullptr)
         : _startMillis(
               opCtx->getServiceContext()->getFastClockSource()->now().toMillisSinceEpoch()),
           _bytesProcessed(0),
           _totalElapsedTimeSec(0),
           _totalMBProcessed(0),
-          _shouldNotThrottle(false) {}
+          _shouldNotThrottle(false),
+          _getMaxMBPerSec(std::move(getMaxMBPerSec)) {}
 
     /**
-     * If throttling is not enabled by calling turnThrottlingOff(), or if
-     * 'maxValidateMBperSec' == 0, then this is a no-op.
+     * If throttling is not enabled by calling turnThrottlingOff(), or if the limit is 0, then this
+     * is a no-op.
      *
-     * When the accumulated number of bytes processed in each second reaches or exceeds the limit
-     * set by the 'maxValidateMBperSec' server parameter, the throttle mechanism gets engaged to
-     * wait for the remainder of that second by putting the thread to sleep.
+     * When the accumulated number of bytes processed in each second reaches or exceeds the limit,
+     * the throttle mechanism gets engaged to wait for the remainder of that second by putting the
+     * thread to sleep.
      *
      * In addition to throttling, while the thread is waiting, its operation context remains
      * interruptible.
@@ -161,6 +164,9 @@ private:
 
     // Whether the throttle should be active.
     bool _shouldNotThrottle;
+
+    // Returns the limit in MB per second, or null to use 'maxValidateMBperSec'.
+    std::function<int()> _getMaxMBPerSec;
 };
 
 }  // namespace mongo
@@ -261,6 +261,25 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
                                     const IndexCatalogEntry* index,
                                     int64_t* numTraversedKeys,
                                     ValidateResults* results) {
+    // Ensure that this index has an open index cursor.
+    const auto indexName = index->descriptor()->indexName();
+    const auto indexCursorIt = _validateState->getIndexCursors().find(indexName);
+    invariant(indexCursorIt != _validateState->getIndexCursors().end());
+
+    traverseIndex(opCtx,
+                  index,
+                  indexCursorIt->second.get(),
+                  [&] { _validateState->yield(opCtx); },
+                  numTraversedKeys,
+                  results);
+}
+
+void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
+                                    const IndexCatalogEntry* index,
+                                    SortedDataInterfaceThrottleCursor* indexCursor,
+                                    const std::function<void()>& yield,
+                                    int64_t* numTraversedKeys,
+                                    ValidateResults* results) {
     const IndexDescriptor* descriptor = index->descriptor();
     auto indexName = descriptor->indexName();
     auto& indexResults = results->indexResultsMap[indexName];
@@ -289,12 +308,6 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
     KeyString::Value firstKeyString = firstKeyStringBuilder.release();
     KeyString::Value prevIndexKeyStringValue;
 
-    // Ensure that this index has an open index cursor.
-    const auto indexCursorIt = _validateState->getIndexCursors().find(indexName);
-    invariant(indexCursorIt != _validateState->getIndexCursors().end());
-
-    const std::unique_ptr<SortedDataInterfaceThrottleCursor>& indexCursor = indexCursorIt->second;
-
     boost::optional<KeyStringEntry> indexEntry;
     try {
         indexEntry = indexCursor->seekForKeyString(opCtx, firstKeyString);
@@ -342,7 +355,7 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
         if (numKeys % kInterruptIntervalNumRecords == 0) {
             // Periodically checks for interrupts and yields.
             opCtx->checkForInterrupt();
-            _validateState->yield(opCtx);
+            yield();
         }
 
         try {
@@ -632,10 +645,11 @@ void ValidateAdaptor::validateIndexKeyCount(OperationContext* opCtx,
 
     // Confirm that the number of index entries is not greater than the number of documents in the
     // collection. This check is only valid for indexes that are not multikey (indexed arrays
-    // produce an index key per array entry) and not $** indexes which can produce index keys for
-    // multiple paths within a single document.
+    // produce an index key per array entry) and not $** or columnstore indexes which can produce
+    // index keys for multiple paths within a single document.
     if (results.valid && !index->isMultikey(opCtx, _validateState->getCollection()) &&
-        desc->getIndexType() != IndexType::INDEX_WILDCARD && numTotalKeys > _numRecords) {
+        desc->getIndexType() != IndexType::INDEX_WILDCARD &&
+        desc->getIndexType() != IndexType::INDEX_COLUMN && numTotalKeys > _numRecords) {
         std::string err = str::stream()
             << "index " << desc->indexName() << " is not multi-key, but has more entries ("
             << numTotalKeys << ") than documents in the index (" << _numRecords << ")";
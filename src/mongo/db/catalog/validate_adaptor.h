@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "mongo/db/catalog/validate_state.h"
 #include "mongo/util/progress_meter.h"
 
@@ -68,6 +70,19 @@ public:
                        int64_t* numTraversedKeys,
                        ValidateResults* results);
 
+    /**
+     * Same as above, but traverses the index with 'indexCursor' instead of the shared index cursor
+     * of the ValidateState, and calls 'yield' instead of yielding the ValidateState. This allows
+     * several indexes to be traversed concurrently from different threads, each with its own
+     * OperationContext.
+     */
+    void traverseIndex(OperationContext* opCtx,
+                       const IndexCatalogEntry* index,
+                       SortedDataInterfaceThrottleCursor* indexCursor,
+                       const std::function<void()>& yield,
+                       int64_t* numTraversedKeys,
+                       ValidateResults* results);
+
     /**
      * Traverses the record store to retrieve every record and go through its document key
      * set to keep track of the index consistency during a validation.
@@ -742,6 +742,15 @@ public:
         return false;
     }
 
+    /**
+     * Hints to the rpc system how much space this invocation will need in its reply. Defaults to
+     * the hint of the command definition; invocations that can estimate their reply size from the
+     * request should override this to avoid growing the reply buffer repeatedly.
+     */
+    virtual std::size_t reserveBytesForReply() const {
+        return definition()->reserveBytesForReply();
+    }
+
     /**
      * The command definition that this invocation runs.
      * Note: nonvirtual.
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/commands.h"
+#include "mongo/util/cpu_profiler.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns the folded stacks sampled by the CPU profiler, see cpu_profiler.h. The profiler is
+ * started and stopped through the cpuProfilerSampleIntervalMicros server parameter.
+ */
+class GetCPUProfileCmd : public BasicCommand {
+public:
+    GetCPUProfileCmd() : BasicCommand("getCPUProfile") {}
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const final {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const final {
+        return false;
+    }
+
+    bool adminOnly() const final {
+        return true;
+    }
+
+    Status checkAuthForOperation(OperationContext* opCtx,
+                                 const std::string&,
+                                 const BSONObj&) const final {
+        auto* as = AuthorizationSession::get(opCtx->getClient());
+        if (!as->isAuthorizedForActionsOnResource(ResourcePattern::forClusterResource(),
+                                                  ActionType::cpuProfiler)) {
+            return {ErrorCodes::Unauthorized, "Not authorized to get the CPU profile"};
+        }
+        return Status::OK();
+    }
+
+    std::string help() const final {
+        return "{ getCPUProfile : 1, clear : <bool> }\n"
+               "Returns the samples of the CPU profiler, and drops them if 'clear' is true.";
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& db,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) final {
+        cpu_profiler::appendProfile(&result);
+        if (cmdObj["clear"].trueValue()) {
+            cpu_profiler::clear();
+        }
+        return true;
+    }
+} getCPUProfileCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -203,6 +203,18 @@ public:
                             mustBeTopLevel("metaField"),
                             !hasDot(*metaField));
                 }
+
+                if (auto bloomFilterFields = timeseries->getBloomFilterFields()) {
+                    for (const auto& field : *bloomFilterFields) {
+                        uassert(ErrorCodes::InvalidOptions,
+                                "'bloomFilterFields' cannot contain the 'timeField' or 'metaField'",
+                                field != timeseries->getTimeField() &&
+                                    field != timeseries->getMetaField().value_or(""_sd));
+                        uassert(ErrorCodes::InvalidOptions,
+                                mustBeTopLevel("bloomFilterFields"),
+                                !field.empty() && !hasDot(field));
+                    }
+                }
             }
 
             if (cmd.getExpireAfterSeconds()) {
@@ -36,16 +36,21 @@
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/health_log.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/dbcheck.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/idl/command_generic_argument.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/background.h"
 
 #include "mongo/logv2/log.h"
@@ -67,6 +72,10 @@ struct DbCheckCollectionInfo {
     int64_t maxCount;
     int64_t maxSize;
     int64_t maxRate;
+    int64_t maxBytesRate;
+    boost::optional<int64_t> maxReplicationLagSecs;
+    int64_t parallelism;
+    DbCheckHashTypeEnum hashType;
 };
 
 /**
@@ -117,7 +126,16 @@ std::unique_ptr<DbCheckRun> singleCollectionRun(OperationContext* opCtx,
     auto maxCount = invocation.getMaxCount();
     auto maxSize = invocation.getMaxSize();
     auto maxRate = invocation.getMaxCountPerSecond();
-    auto info = DbCheckCollectionInfo{nss, start, end, maxCount, maxSize, maxRate};
+    auto info = DbCheckCollectionInfo{nss,
+                                      start,
+                                      end,
+                                      maxCount,
+                                      maxSize,
+                                      maxRate,
+                                      invocation.getMaxBytesPerSecond(),
+                                      invocation.getMaxReplicationLagSecs(),
+                                      invocation.getParallelism(),
+                                      invocation.getHashType()};
     auto result = std::make_unique<DbCheckRun>();
     result->push_back(info);
     return result;
@@ -146,7 +164,16 @@ std::unique_ptr<DbCheckRun> fullDatabaseRun(OperationContext* opCtx,
             break;
         }
 
-        DbCheckCollectionInfo info{coll->ns(), BSONKey::min(), BSONKey::max(), max, max, rate};
+        DbCheckCollectionInfo info{coll->ns(),
+                                   BSONKey::min(),
+                                   BSONKey::max(),
+                                   max,
+                                   max,
+                                   rate,
+                                   invocation.getMaxBytesPerSecond(),
+                                   invocation.getMaxReplicationLagSecs(),
+                                   invocation.getParallelism(),
+                                   invocation.getHashType()};
         result->push_back(info);
     }
 
@@ -182,6 +209,149 @@ std::unique_ptr<DbCheckRun> getRun(OperationContext* opCtx,
     }
 }
 
+/**
+ * Limits the rate at which the threads checking a collection hash documents and bytes, over
+ * intervals of one second.
+ */
+class DbCheckRateLimiter {
+public:
+    DbCheckRateLimiter(int64_t maxDocsPerSecond, int64_t maxBytesPerSecond)
+        : _maxDocsPerSecond(maxDocsPerSecond), _maxBytesPerSecond(maxBytesPerSecond) {}
+
+    /**
+     * Accounts for a batch of `docs` documents totalling `bytes` bytes, and sleeps if this
+     * exceeds either limit in the current interval.
+     */
+    void consume(int64_t docs, int64_t bytes) {
+        using namespace std::literals::chrono_literals;
+
+        Clock::duration sleepTime{0};
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (Clock::now() - _intervalStart > 1s) {
+                _intervalStart = Clock::now();
+                _docsInInterval = 0;
+                _bytesInInterval = 0;
+            }
+
+            _docsInInterval += docs;
+            _bytesInInterval += bytes;
+
+            // If an extremely low max rate has been set (substantially smaller than the batch
+            // size) we might want to sleep for multiple seconds between batches.
+            int64_t timesExceeded = 0;
+            if (_maxDocsPerSecond > 0 && _docsInInterval > _maxDocsPerSecond) {
+                timesExceeded = _docsInInterval / _maxDocsPerSecond;
+            }
+            if (_maxBytesPerSecond > 0 && _bytesInInterval > _maxBytesPerSecond) {
+                timesExceeded = std::max(timesExceeded, _bytesInInterval / _maxBytesPerSecond);
+            }
+
+            if (timesExceeded > 0) {
+                sleepTime = timesExceeded * 1s - (Clock::now() - _intervalStart);
+            }
+        }
+
+        if (sleepTime > Clock::duration{0}) {
+            stdx::this_thread::sleep_for(sleepTime);
+        }
+    }
+
+private:
+    using Clock = stdx::chrono::system_clock;
+
+    const int64_t _maxDocsPerSecond;
+    const int64_t _maxBytesPerSecond;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("DbCheckRateLimiter::_mutex");
+    Clock::time_point _intervalStart = Clock::now();
+    int64_t _docsInInterval = 0;
+    int64_t _bytesInInterval = 0;
+};
+
+/**
+ * Hands out consecutive ranges of a collection's _id index to the threads checking it in
+ * parallel. Each range holds at most kBatchDocs documents; its end is found by scanning only the
+ * keys of the _id index, which is much cheaper than fetching and hashing the documents in it.
+ */
+class DbCheckRangeProducer {
+public:
+    explicit DbCheckRangeProducer(const DbCheckCollectionInfo& info)
+        : _info(info), _next(info.start) {}
+
+    /**
+     * Returns the bounds (exclusive, inclusive] of the next range to check, or boost::none once
+     * the whole collection, or as much of it as the limits of the check allow, has been handed
+     * out.
+     */
+    StatusWith<boost::optional<std::pair<BSONKey, BSONKey>>> next(OperationContext* opCtx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_exhausted || _next >= _info.end || _docsHandedOut >= _info.maxCount ||
+            _bytesChecked.load() >= _info.maxSize) {
+            _exhausted = true;
+            return {boost::none};
+        }
+
+        AutoGetCollectionForDbCheck agc(opCtx, _info.nss, OplogEntriesEnum::Batch);
+        const auto& collection = agc.getCollection();
+        if (!collection) {
+            return {ErrorCodes::NamespaceNotFound, "dbCheck collection no longer exists"};
+        }
+
+        const IndexDescriptor* desc = collection->getIndexCatalog()->findIdIndex(opCtx);
+        if (!desc) {
+            return {ErrorCodes::IndexNotFound, "dbCheck needs _id index"};
+        }
+
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               &collection,
+                                               desc,
+                                               _next.obj(),
+                                               _info.end.obj(),
+                                               BoundInclusion::kIncludeEndKeyOnly,
+                                               PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                               InternalPlanner::FORWARD);
+
+        const int64_t maxDocs =
+            std::min(static_cast<int64_t>(kBatchDocs), _info.maxCount - _docsHandedOut);
+        auto first = _next;
+        auto last = _info.end;
+        int64_t docs = 0;
+        BSONObj key;
+        while (docs < maxDocs && exec->getNext(&key, nullptr) == PlanExecutor::ADVANCED) {
+            last = BSONKey::parseFromBSON(key.firstElement());
+            ++docs;
+        }
+
+        // If the scan ran out of keys, the range extends to the end of the check.
+        if (docs < maxDocs) {
+            last = _info.end;
+            _exhausted = true;
+        }
+
+        _docsHandedOut += docs;
+        _next = last;
+        return {std::make_pair(first, last)};
+    }
+
+    /**
+     * Accounts for `bytes` bytes checked, so that no ranges are handed out once the check has
+     * reached its size limit. Ranges already handed out may overshoot the limit.
+     */
+    void addBytesChecked(int64_t bytes) {
+        _bytesChecked.fetchAndAdd(bytes);
+    }
+
+private:
+    const DbCheckCollectionInfo& _info;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("DbCheckRangeProducer::_mutex");
+    BSONKey _next;
+    int64_t _docsHandedOut = 0;
+    bool _exhausted = false;
+
+    AtomicWord<int64_t> _bytesChecked{0};
+};
 
 /**
  * The BackgroundJob in which dbCheck actually executes on the primary.
@@ -210,7 +380,7 @@ protected:
                 return;
             }
 
-            if (_done) {
+            if (_done.load()) {
                 LOGV2(20451, "dbCheck terminated due to stepdown");
                 return;
             }
@@ -224,7 +394,15 @@ private:
             return;
         }
 
-        if (_done) {
+        if (_done.load()) {
+            return;
+        }
+
+        // Limit the rate of the check.
+        DbCheckRateLimiter rateLimiter(info.maxRate, info.maxBytesRate);
+
+        if (info.parallelism > 1) {
+            _doCollectionInParallel(info, &rateLimiter);
             return;
         }
 
@@ -236,44 +414,23 @@ private:
         int64_t totalBytesSeen = 0;
         int64_t totalDocsSeen = 0;
 
-        // Limit the rate of the check.
-        using Clock = stdx::chrono::system_clock;
-        using TimePoint = stdx::chrono::time_point<Clock>;
-        TimePoint lastStart = Clock::now();
-        int64_t docsInCurrentInterval = 0;
-
         do {
-            using namespace std::literals::chrono_literals;
-
-            if (Clock::now() - lastStart > 1s) {
-                lastStart = Clock::now();
-                docsInCurrentInterval = 0;
+            _waitForReplicationLag(info);
+            if (_done.load()) {
+                return;
             }
 
-            auto result = _runBatch(info, start, kBatchDocs, kBatchBytes);
+            auto result = _runBatch(info, start, info.end, kBatchDocs, kBatchBytes);
 
-            if (_done) {
+            if (_done.load()) {
                 return;
             }
 
-            std::unique_ptr<HealthLogEntry> entry;
-
             if (!result.isOK()) {
-                entry = dbCheckErrorHealthLogEntry(
+                auto entry = dbCheckErrorHealthLogEntry(
                     info.nss, "dbCheck batch failed", OplogEntriesEnum::Batch, result.getStatus());
                 HealthLog::get(Client::getCurrent()->getServiceContext()).log(*entry);
                 return;
-            } else {
-                auto stats = result.getValue();
-                entry = dbCheckBatchEntry(info.nss,
-                                          stats.nDocs,
-                                          stats.nBytes,
-                                          stats.md5,
-                                          stats.md5,
-                                          start,
-                                          stats.lastKey,
-                                          stats.time);
-                HealthLog::get(Client::getCurrent()->getServiceContext()).log(*entry);
             }
 
             auto stats = result.getValue();
@@ -283,7 +440,6 @@ private:
             // Update our running totals.
             totalDocsSeen += stats.nDocs;
             totalBytesSeen += stats.nBytes;
-            docsInCurrentInterval += stats.nDocs;
 
             // Check if we've exceeded any limits.
             bool reachedLast = stats.lastKey >= info.end;
@@ -291,14 +447,111 @@ private:
             bool tooManyBytes = totalBytesSeen >= info.maxSize;
             reachedEnd = reachedLast || tooManyDocs || tooManyBytes;
 
-            if (docsInCurrentInterval > info.maxRate && info.maxRate > 0) {
-                // If an extremely low max rate has been set (substantially smaller than the batch
-                // size) we might want to sleep for multiple seconds between batches.
-                int64_t timesExceeded = docsInCurrentInterval / info.maxRate;
+            rateLimiter.consume(stats.nDocs, stats.nBytes);
+        } while (!reachedEnd);
+    }
+
+    /**
+     * Checks the collection with `info.parallelism` threads, each of which repeatedly takes the
+     * next range of the collection from a shared DbCheckRangeProducer and checks it in batches.
+     * The batches are logged to the oplog in the order they complete, but together they still
+     * cover the collection without gaps or overlaps.
+     */
+    void _doCollectionInParallel(const DbCheckCollectionInfo& info,
+                                 DbCheckRateLimiter* rateLimiter) {
+        DbCheckRangeProducer producer(info);
+        AtomicWord<bool> failed{false};
+
+        auto checkRanges = [&] {
+            auto checkRange = [&](BSONKey first, const BSONKey& last) -> Status {
+                do {
+                    _waitForReplicationLag(info);
+                    if (_done.load() || failed.load()) {
+                        return Status::OK();
+                    }
+
+                    auto result = _runBatch(info, first, last, kBatchDocs, kBatchBytes);
+                    if (!result.isOK()) {
+                        return result.getStatus();
+                    }
+
+                    const auto& stats = result.getValue();
+                    producer.addBytesChecked(stats.nBytes);
+                    rateLimiter->consume(stats.nDocs, stats.nBytes);
+                    first = stats.lastKey;
+                } while (first < last);
+                return Status::OK();
+            };
+
+            Status status = Status::OK();
+            try {
+                while (status.isOK() && !_done.load() && !failed.load()) {
+                    auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
+                    auto range = producer.next(uniqueOpCtx.get());
+                    uniqueOpCtx.reset();
+                    if (!range.isOK()) {
+                        status = range.getStatus();
+                    } else if (!range.getValue()) {
+                        return;
+                    } else {
+                        status = checkRange(range.getValue()->first, range.getValue()->second);
+                    }
+                }
+            } catch (const DBException& e) {
+                status = e.toStatus();
+            }
 
-                stdx::this_thread::sleep_for(timesExceeded * 1s - (Clock::now() - lastStart));
+            // Only the first failure is reported, as the others are most likely caused by it.
+            if (!status.isOK() && !_done.load() && !failed.swap(true)) {
+                auto entry = dbCheckErrorHealthLogEntry(
+                    info.nss, "dbCheck batch failed", OplogEntriesEnum::Batch, status);
+                HealthLog::get(Client::getCurrent()->getServiceContext()).log(*entry);
             }
-        } while (!reachedEnd);
+        };
+
+        std::vector<stdx::thread> workers;
+        for (int64_t i = 1; i < info.parallelism; ++i) {
+            workers.emplace_back([&] {
+                ThreadClient tc(name(), getGlobalServiceContext());
+                checkRanges();
+            });
+        }
+
+        checkRanges();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Secondaries check each batch as they apply its oplog entry, one after the other, so a fast
+     * check on the primary can make them lag. If the check has a replication lag limit, waits until
+     * the majority commit point is within that limit of this node's last applied write.
+     */
+    void _waitForReplicationLag(const DbCheckCollectionInfo& info) {
+        if (!info.maxReplicationLagSecs) {
+            return;
+        }
+
+        auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
+        auto opCtx = uniqueOpCtx.get();
+        auto coord = repl::ReplicationCoordinator::get(opCtx);
+        const Seconds maxLag(*info.maxReplicationLagSecs);
+
+        while (!_done.load()) {
+            if (!coord->getMemberState().primary()) {
+                _done.store(true);
+                return;
+            }
+
+            auto lag = coord->getMyLastAppliedOpTimeAndWallTime().wallTime -
+                coord->getLastCommittedOpTimeAndWallTime().wallTime;
+            if (lag <= maxLag) {
+                return;
+            }
+
+            opCtx->sleepFor(Milliseconds(100));
+        }
     }
 
     /**
@@ -313,7 +566,7 @@ private:
     };
 
     // Set if the job cannot proceed.
-    bool _done;
+    AtomicWord<bool> _done;
     std::string _dbName;
     std::unique_ptr<DbCheckRun> _run;
 
@@ -326,7 +579,7 @@ private:
         AutoGetDbForDbCheck agd(opCtx, info.nss);
 
         if (_stepdownHasOccurred(opCtx, info.nss)) {
-            _done = true;
+            _done.store(true);
             return true;
         }
 
@@ -378,8 +631,13 @@ private:
         return true;
     }
 
+    /**
+     * Checks the documents after `first`, up to and including `last`, or as many of them as fit
+     * in one batch, and logs the batch to the oplog and the health log.
+     */
     StatusWith<BatchStats> _runBatch(const DbCheckCollectionInfo& info,
                                      const BSONKey& first,
+                                     const BSONKey& last,
                                      int64_t batchDocs,
                                      int64_t batchBytes) {
         // New OperationContext for each batch.
@@ -391,7 +649,7 @@ private:
         AutoGetCollectionForDbCheck agc(opCtx, info.nss, OplogEntriesEnum::Batch);
 
         if (_stepdownHasOccurred(opCtx, info.nss)) {
-            _done = true;
+            _done.store(true);
             return Status(ErrorCodes::PrimarySteppedDown, "dbCheck terminated due to stepdown");
         }
 
@@ -406,9 +664,10 @@ private:
             hasher.emplace(opCtx,
                            collection,
                            first,
-                           info.end,
+                           last,
                            std::min(batchDocs, info.maxCount),
-                           std::min(batchBytes, info.maxSize));
+                           std::min(batchBytes, info.maxSize),
+                           info.hashType);
         } catch (const DBException& e) {
             return e.toStatus();
         }
@@ -426,6 +685,11 @@ private:
         batch.setMd5(md5);
         batch.setMinKey(first);
         batch.setMaxKey(BSONKey(hasher->lastKey()));
+        // Leave out the default, so that secondaries which do not know the field can still
+        // check batches hashed with MD5.
+        if (info.hashType != DbCheckHashTypeEnum::kMd5) {
+            batch.setHashType(info.hashType);
+        }
 
         BatchStats result;
 
@@ -437,6 +701,17 @@ private:
         result.lastKey = hasher->lastKey();
         result.md5 = md5;
 
+        auto entry = dbCheckBatchEntry(info.nss,
+                                       result.nDocs,
+                                       result.nBytes,
+                                       result.md5,
+                                       result.md5,
+                                       first,
+                                       result.lastKey,
+                                       result.time,
+                                       info.hashType);
+        HealthLog::get(opCtx).log(*entry);
+
         return result;
     }
 
@@ -511,7 +786,11 @@ public:
                "              maxKey: <last key, inclusive>,\n"
                "              maxCount: <max number of docs>,\n"
                "              maxSize: <max size of docs>,\n"
-               "              maxCountPerSecond: <max rate in docs/sec> } "
+               "              maxCountPerSecond: <max rate in docs/sec>,\n"
+               "              maxBytesPerSecond: <max rate in bytes/sec>,\n"
+               "              maxReplicationLagSecs: <max majority commit lag in secs>,\n"
+               "              parallelism: <number of ranges checked at once>,\n"
+               "              hashType: <'md5' or 'murmur3'> } "
                "to check a collection.\n"
                "Invoke with {dbCheck: 1} to check all collections in the database.";
     }
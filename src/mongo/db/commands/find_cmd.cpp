@@ -50,6 +50,7 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
@@ -259,6 +260,18 @@ public:
             return true;
         }
 
+        std::size_t reserveBytesForReply() const override {
+            // A first batch larger than the default is likely to fill the reply, so size the
+            // buffer for a full batch up front rather than growing it from the default size. See
+            // GetMoreCmd::reserveBytesForReply() for the extra 1K.
+            auto batchSize = _request.body[FindCommandRequest::kBatchSizeFieldName];
+            if (batchSize.isNumber() &&
+                batchSize.safeNumberLong() > query_request_helper::kDefaultBatchSize) {
+                return FindCommon::kMaxBytesToReturnToClientAtOnce + 1024u;
+            }
+            return definition()->reserveBytesForReply();
+        }
+
         bool allowsSpeculativeMajorityReads() const override {
             // Find queries are only allowed to use speculative behavior if the 'allowsSpeculative'
             // flag is passed. The find command will check for this flag internally and fail if
@@ -424,6 +437,11 @@ public:
                 opCtx->lockState()->skipAcquireTicket();
             }
 
+            // Results computed from the snapshot opened below may only be added to the result
+            // cache if no write to the collection commits after this point.
+            auto& resultCache = QueryResultCache::get(opCtx->getServiceContext());
+            const auto resultCacheReadSequence = resultCache.getReadSequence();
+
             // Acquire locks. If the query is on a view, we release our locks and convert the query
             // request into an aggregation command.
             boost::optional<AutoGetCollectionForReadCommandMaybeLockFree> ctx;
@@ -484,6 +502,15 @@ public:
 
             const auto& collection = ctx->getCollection();
 
+            boost::optional<BSONObj> resultCacheKey;
+            if (QueryResultCache::isEligible(opCtx, collection, *cq)) {
+                resultCacheKey = QueryResultCache::makeKey(*cq);
+                if (auto docs = resultCache.lookup(collection->uuid(), *resultCacheKey)) {
+                    _replyFromResultCache(opCtx, nss, *docs, result);
+                    return;
+                }
+            }
+
             if (cq->getFindCommandRequest().getReadOnce()) {
                 // The readOnce option causes any storage-layer cursors created during plan
                 // execution to assume read data will not be needed again and need not be cached.
@@ -532,6 +559,7 @@ public:
             std::uint64_t numResults = 0;
             bool stashedResult = false;
             ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+            std::vector<BSONObj> resultCacheDocs;
 
             try {
                 while (!FindCommon::enoughForFirstBatch(originalFC, numResults) &&
@@ -551,6 +579,9 @@ public:
                     firstBatch.append(obj);
                     numResults++;
                     docUnitsReturned.observeOne(obj.objsize());
+                    if (resultCacheKey) {
+                        resultCacheDocs.push_back(obj.getOwned());
+                    }
                 }
             } catch (DBException& exception) {
                 firstBatch.abandon();
@@ -614,6 +645,15 @@ public:
                 endQueryOp(opCtx, collection, *cursorExec, numResults, cursorId);
             } else {
                 endQueryOp(opCtx, collection, *exec, numResults, cursorId);
+
+                // The first batch holds the complete result, so identical queries can be answered
+                // from the cache until the collection is next written to.
+                if (resultCacheKey) {
+                    resultCache.add(collection->uuid(),
+                                    *resultCacheKey,
+                                    resultCacheReadSequence,
+                                    std::move(resultCacheDocs));
+                }
             }
 
             // Generate the response object to send to the client.
@@ -651,6 +691,37 @@ public:
         }
 
     private:
+        /**
+         * Answers the find command with 'docs', the complete result of an identical earlier find
+         * command taken from the QueryResultCache, without planning or executing the query.
+         */
+        void _replyFromResultCache(OperationContext* opCtx,
+                                   const NamespaceString& nss,
+                                   const std::vector<BSONObj>& docs,
+                                   rpc::ReplyBuilderInterface* result) {
+            {
+                stdx::lock_guard<Client> lk(*opCtx->getClient());
+                CurOp::get(opCtx)->setPlanSummary_inlock("RESULT_CACHE"_sd);
+            }
+            auto& opDebug = CurOp::get(opCtx)->debug();
+            opDebug.nreturned = docs.size();
+            opDebug.cursorid = -1;
+            opDebug.cursorExhausted = true;
+
+            CursorResponseBuilder::Options options;
+            options.isInitialResponse = true;
+            CursorResponseBuilder firstBatch(result, options);
+            ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+            for (auto&& doc : docs) {
+                firstBatch.append(doc);
+                docUnitsReturned.observeOne(doc.objsize());
+            }
+            firstBatch.done(CursorId(0), nss.ns());
+
+            ResourceConsumption::MetricsCollector::get(opCtx).incrementDocUnitsReturned(
+                docUnitsReturned);
+        }
+
         const OpMsgRequest _request;
         const StringData _dbName;
     };
@@ -56,6 +56,7 @@
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/getmore_command_gen.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/plan_insert_listener.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
@@ -340,8 +341,10 @@ public:
                         break;
                     }
 
-                    // As soon as we get a result, this operation no longer waits.
-                    awaitDataState(opCtx).shouldWaitForInserts = false;
+                    // As soon as we get a result, this operation no longer waits, unless it
+                    // asked for results to be coalesced into larger batches.
+                    insert_listener::onResultAddedToBatch(
+                        opCtx, nextBatch->bytesUsed() + obj.objsize(), *numResults == 0);
 
                     // If this executor produces a postBatchResumeToken, add it to the response.
                     nextBatch->setPostBatchResumeToken(exec->getPostBatchResumeToken());
@@ -511,6 +514,13 @@ public:
                           "cannot set maxTimeMS on getMore command for a non-awaitData cursor");
             }
 
+            if ((_cmd.getAwaitDataMinBytes() || _cmd.getAwaitDataCoalesceMS()) &&
+                !cursorPin->isAwaitData()) {
+                uasserted(ErrorCodes::BadValue,
+                          "cannot set awaitDataMinBytes or awaitDataCoalesceMS on getMore command "
+                          "for a non-awaitData cursor");
+            }
+
             // On early return, get rid of the cursor.
             ScopeGuard cursorFreer([&] { cursorPin.deleteUnderlying(); });
 
@@ -614,6 +624,10 @@ public:
                 }
 
                 awaitDataState(opCtx).shouldWaitForInserts = true;
+                awaitDataState(opCtx).minBatchBytes = _cmd.getAwaitDataMinBytes().value_or(0);
+                if (auto coalesceMS = _cmd.getAwaitDataCoalesceMS()) {
+                    awaitDataState(opCtx).coalesceWindow = Milliseconds(*coalesceMS);
+                }
             }
 
             // We're about to begin running the PlanExecutor in order to fill the getMore batch. If
@@ -0,0 +1,154 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/refresh_materialized_view_gen.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/server_options.h"
+#include "mongo/db/views/materialized_view_refresh.h"
+#include "mongo/db/views/view_catalog.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Incrementally refreshes the results of a $match/$project/$group view which are stored in a
+ * collection by folding in the documents inserted into the source collection of the view since the
+ * previous refresh.
+ *
+ * {
+ *     refreshMaterializedView: <view>,
+ *     into: <collection storing the results of the view>,
+ *     watermarkField: <field>,
+ *     lowerBound: <upper bound of the previous refresh, omitted on the first refresh>,
+ *     upperBound: <value>,
+ * }
+ */
+class RefreshMaterializedViewCommand final : public TypedCommand<RefreshMaterializedViewCommand> {
+public:
+    using Request = RefreshMaterializedView;
+
+    std::string help() const override {
+        return "Folds the documents of the source collection of a view whose watermark field is "
+               "within (lowerBound, upperBound] into a collection storing the results of the "
+               "view.";
+    }
+
+    bool adminOnly() const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    class Invocation final : public InvocationBase {
+    public:
+        using InvocationBase::InvocationBase;
+
+        void typedRun(OperationContext* opCtx) {
+            // Each shard would only fold its own documents of a sharded source collection.
+            uassert(ErrorCodes::IllegalOperation,
+                    "refreshMaterializedView is not supported in sharded clusters",
+                    serverGlobalParams.clusterRole != ClusterRole::ShardServer);
+
+            const auto& viewNss = request().getNamespace();
+            const NamespaceString backingNss(viewNss.db(), request().getInto());
+            uassert(ErrorCodes::InvalidNamespace,
+                    str::stream() << "Invalid collection name: " << backingNss,
+                    backingNss.isValid());
+
+            auto resolvedView = [&] {
+                AutoGetDb autoDb(opCtx, viewNss.db(), MODE_IS);
+                auto viewCatalog = autoDb.getDb() ? ViewCatalog::get(autoDb.getDb()) : nullptr;
+                uassert(ErrorCodes::NamespaceNotFound,
+                        str::stream() << "View " << viewNss << " does not exist",
+                        viewCatalog && viewCatalog->lookup(opCtx, viewNss));
+                return uassertStatusOK(viewCatalog->resolveView(opCtx, viewNss));
+            }();
+
+            MaterializedViewRefreshBounds bounds{request().getWatermarkField().toString(),
+                                                 boost::none,
+                                                 Value(request().getUpperBound().getElement())};
+            if (auto lowerBound = request().getLowerBound()) {
+                bounds.lowerBound = Value(lowerBound->getElement());
+            }
+
+            auto expCtx =
+                make_intrusive<ExpressionContext>(opCtx, nullptr, resolvedView.getNamespace());
+            auto refreshPipeline = makeMaterializedViewRefreshPipeline(
+                expCtx, resolvedView.getPipeline(), backingNss, bounds);
+
+            // The aggregate is authorized on its own, which requires the privileges to read the
+            // source collection and to write the results into 'backingNss'.
+            BSONObjBuilder cmdBuilder;
+            cmdBuilder.append("aggregate", resolvedView.getNamespace().coll());
+            cmdBuilder.append("pipeline", refreshPipeline);
+            cmdBuilder.append("cursor", BSONObj());
+            if (!resolvedView.getDefaultCollation().isEmpty()) {
+                cmdBuilder.append("collation", resolvedView.getDefaultCollation());
+            }
+
+            DBDirectClient client(opCtx);
+            BSONObj result;
+            client.runCommand(viewNss.db().toString(), cmdBuilder.obj(), result);
+            uassertStatusOK(getStatusFromCommandResult(result));
+        }
+
+    private:
+        NamespaceString ns() const override {
+            return request().getNamespace();
+        }
+
+        bool supportsWriteConcern() const override {
+            return true;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            uassert(ErrorCodes::Unauthorized,
+                    "Unauthorized",
+                    AuthorizationSession::get(opCtx->getClient())
+                        ->isAuthorizedForActionsOnResource(
+                            ResourcePattern::forExactNamespace(request().getNamespace()),
+                            ActionType::find));
+        }
+    };
+
+} refreshMaterializedViewCmd;
+
+}  // namespace
+}  // namespace mongo
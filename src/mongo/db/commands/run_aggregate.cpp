@@ -57,6 +57,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/pipeline_d.h"
+#include "mongo/db/pipeline/pipeline_template_cache.h"
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
 #include "mongo/db/pipeline/process_interface/mongo_process_interface.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
@@ -746,8 +747,21 @@ Status runAggregate(OperationContext* opCtx,
         expCtx = makeExpressionContext(
             opCtx, request, std::move(*collatorToUse), uuid, collatorToUseMatchesDefault);
 
+        boost::optional<std::string> templateKey;
+        if (uuid && PipelineTemplateCache::isEligible(opCtx, request, liteParsedPipeline)) {
+            templateKey = PipelineTemplateCache::makeKey(*expCtx, request);
+        }
+
+        auto& templateCache = PipelineTemplateCache::get(opCtx->getServiceContext());
+        std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
         expCtx->startExpressionCounters();
-        auto pipeline = Pipeline::parse(request.getPipeline(), expCtx);
+        if (templateKey) {
+            pipeline = templateCache.lookup(*templateKey, expCtx);
+        }
+        const bool pipelineFromTemplate = bool(pipeline);
+        if (!pipelineFromTemplate) {
+            pipeline = Pipeline::parse(request.getPipeline(), expCtx);
+        }
         expCtx->stopExpressionCounters();
 
         // Check that the view's collation matches the collation of any views involved in the
@@ -760,7 +774,13 @@ Status runAggregate(OperationContext* opCtx,
             }
         }
 
-        pipeline->optimizePipeline();
+        // A pipeline served by the template cache was optimized before it was cached.
+        if (!pipelineFromTemplate) {
+            pipeline->optimizePipeline();
+            if (templateKey) {
+                templateCache.add(*templateKey, *pipeline);
+            }
+        }
 
         constexpr bool alreadyOptimized = true;
         pipeline->validateCommon(alreadyOptimized);
@@ -42,6 +42,7 @@
 #include "mongo/db/commands/write_commands_common.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/doc_validation_error.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
@@ -56,6 +57,7 @@
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/internal_plans.h"
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/tenant_migration_access_blocker_registry.h"
@@ -68,6 +70,7 @@
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/catalog_helper.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/views/view_catalog.h"
@@ -76,8 +79,11 @@
 #include "mongo/logv2/redaction.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/string_map.h"
 
+#include <numeric>
+
 namespace mongo {
 namespace {
 
@@ -147,9 +153,16 @@ write_ops::UpdateOpEntry makeTimeseriesUpdateOpEntry(
     const BSONObj& metadata) {
     BSONObjBuilder updateBuilder;
     {
-        if (!batch->min().isEmpty() || !batch->max().isEmpty()) {
+        if (!batch->min().isEmpty() || !batch->max().isEmpty() ||
+            !batch->bloomFilters().isEmpty()) {
             BSONObjBuilder controlBuilder(updateBuilder.subobjStart(
                 str::stream() << doc_diff::kSubDiffSectionFieldPrefix << "control"));
+            if (!batch->bloomFilters().isEmpty()) {
+                // The update section must precede the sub-diff sections.
+                controlBuilder.append(doc_diff::kUpdateSectionFieldName,
+                                      BSON(timeseries::kBucketControlBloomFieldName
+                                           << batch->bloomFilters()));
+            }
             if (!batch->min().isEmpty()) {
                 controlBuilder.append(
                     str::stream() << doc_diff::kSubDiffSectionFieldPrefix << "min", batch->min());
@@ -254,6 +267,9 @@ BSONObj makeTimeseriesInsertDocument(std::shared_ptr<BucketCatalog::WriteBatch>
                                     kTimeseriesControlDefaultVersion);
         bucketControlBuilder.append(kBucketControlMinFieldName, batch->min());
         bucketControlBuilder.append(kBucketControlMaxFieldName, batch->max());
+        if (!batch->bloomFilters().isEmpty()) {
+            bucketControlBuilder.append(kBucketControlBloomFieldName, batch->bloomFilters());
+        }
     }
     if (metadataElem) {
         builder.appendAs(metadataElem, kBucketMetaFieldName);
@@ -309,6 +325,71 @@ boost::optional<Status> checkFailUnorderedTimeseriesInsertFailPoint(const BSONOb
     return boost::none;
 }
 
+/**
+ * Returns the bucket with the latest control.min time at or before 'time', within the bucket span,
+ * among the buckets for the given normalized metadata. Requires an index on the metadata and
+ * control.min time fields, and returns boost::none if there is none.
+ */
+boost::optional<BSONObj> findBucketToReopen(OperationContext* opCtx,
+                                            const NamespaceString& bucketsNs,
+                                            const TimeseriesOptions& options,
+                                            const BSONElement& metadata,
+                                            Date_t time) {
+    if (opCtx->inMultiDocumentTransaction()) {
+        return boost::none;
+    }
+
+    // The lookup must not use a snapshot which was opened before the bucket catalog started to
+    // look for changes to bucket documents, and must not leave its snapshot open for the write.
+    opCtx->recoveryUnit()->abandonSnapshot();
+    ON_BLOCK_EXIT([&] { opCtx->recoveryUnit()->abandonSnapshot(); });
+
+    AutoGetCollectionForRead coll(opCtx, bucketsNs);
+    if (!coll) {
+        return boost::none;
+    }
+
+    auto index = timeseries::findMetaTimeIndex(opCtx, coll.getCollection(), options);
+    if (!index) {
+        return boost::none;
+    }
+
+    // Scan backwards from the given time, so that the first bucket found is the most recent one.
+    BSONObjBuilder startKey;
+    BSONObjBuilder endKey;
+    startKey.appendAs(metadata, "");
+    startKey.append("", time);
+    endKey.appendAs(metadata, "");
+    endKey.append("", time - Seconds(*options.getBucketMaxSpanSeconds()));
+    BSONObjIterator keyIt(index->keyPattern());
+    keyIt.next();
+    keyIt.next();
+    while (keyIt.more()) {
+        if (keyIt.next().number() >= 0) {
+            startKey.appendMaxKey("");
+            endKey.appendMinKey("");
+        } else {
+            startKey.appendMinKey("");
+            endKey.appendMaxKey("");
+        }
+    }
+
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           &coll.getCollection(),
+                                           index,
+                                           startKey.obj(),
+                                           endKey.obj(),
+                                           BoundInclusion::kIncludeBothStartAndEndKeys,
+                                           PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                           InternalPlanner::BACKWARD,
+                                           InternalPlanner::IXSCAN_FETCH);
+    BSONObj bucketDoc;
+    if (exec->getNext(&bucketDoc, nullptr) != PlanExecutor::ADVANCED) {
+        return boost::none;
+    }
+    return bucketDoc.getOwned();
+}
+
 boost::optional<BSONObj> generateError(OperationContext* opCtx,
                                        const Status& status,
                                        int index,
@@ -692,7 +773,15 @@ public:
 
             auto bucketCompressionFunc =
                 [&closedBucket](const BSONObj& bucketDoc) -> boost::optional<BSONObj> {
-                auto compressed = timeseries::compressBucket(bucketDoc, closedBucket.timeField);
+                // Prefer the columns that were compressed as the measurements were committed, and
+                // only compress the whole bucket if they do not match the bucket document.
+                boost::optional<BSONObj> compressed;
+                if (closedBucket.compressor) {
+                    compressed = closedBucket.compressor->compress(bucketDoc);
+                }
+                if (!compressed) {
+                    compressed = timeseries::compressBucket(bucketDoc, closedBucket.timeField);
+                }
                 // If compressed object size is larger than uncompressed, skip compression update.
                 if (compressed && compressed->objsize() > bucketDoc.objsize()) {
                     LOGV2_DEBUG(5857802,
@@ -922,7 +1011,14 @@ public:
                     bucketsColl->getDefaultCollator(),
                     *bucketsColl->getTimeseriesOptions(),
                     request().getDocuments()[start + index],
-                    _canCombineTimeseriesInsertWithOtherClients(opCtx));
+                    _canCombineTimeseriesInsertWithOtherClients(opCtx),
+                    [&](const BSONElement& metadata, Date_t time) {
+                        return findBucketToReopen(opCtx,
+                                                  bucketsNs,
+                                                  *bucketsColl->getTimeseriesOptions(),
+                                                  metadata,
+                                                  time);
+                    });
 
                 if (auto error = generateError(opCtx, result, start + index, errors->size())) {
                     errors->push_back(*error);
@@ -1104,6 +1200,54 @@ public:
             return docsToRetry;
         }
 
+        /**
+         * Returns the indices of the measurements in [start, start + numDocs) grouped by their
+         * metaField value and sorted by time within each group. Inserting the measurements of a
+         * bucket one after another avoids bouncing between bucket locks for interleaved batches,
+         * and avoids closing buckets because of measurements that are out of order in time.
+         *
+         * Returns no indices when the measurements should be inserted in order instead.
+         */
+        std::vector<size_t> _groupMeasurementsByBucket(OperationContext* opCtx,
+                                                       size_t start,
+                                                       size_t numDocs) const {
+            std::vector<size_t> indices;
+            if (numDocs < 2) {
+                return indices;
+            }
+
+            // Errors about the buckets collection are reported when inserting the measurements.
+            auto bucketsColl = CollectionCatalog::get(opCtx)->lookupCollectionByNamespaceForRead(
+                opCtx, makeTimeseriesBucketsNamespace(ns()));
+            if (!bucketsColl || !bucketsColl->getTimeseriesOptions()) {
+                return indices;
+            }
+
+            const auto& options = *bucketsColl->getTimeseriesOptions();
+            const auto& docs = request().getDocuments();
+            std::vector<std::pair<BSONElement, BSONElement>> keys;
+            keys.reserve(numDocs);
+            for (size_t i = 0; i < numDocs; ++i) {
+                const auto& doc = docs[start + i];
+                keys.emplace_back(options.getMetaField() ? doc[*options.getMetaField()]
+                                                         : BSONElement(),
+                                  doc[options.getTimeField()]);
+            }
+
+            indices.resize(numDocs);
+            std::iota(indices.begin(), indices.end(), 0);
+            const auto* collator = bucketsColl->getDefaultCollator();
+            std::stable_sort(indices.begin(), indices.end(), [&](size_t lhs, size_t rhs) {
+                const auto& [lhsMeta, lhsTime] = keys[lhs];
+                const auto& [rhsMeta, rhsTime] = keys[rhs];
+                if (auto cmp = lhsMeta.woCompare(rhsMeta, 0, collator)) {
+                    return cmp < 0;
+                }
+                return lhsTime.woCompare(rhsTime, 0) < 0;
+            });
+            return indices;
+        }
+
         void _performUnorderedTimeseriesWritesWithRetries(OperationContext* opCtx,
                                                           size_t start,
                                                           size_t numDocs,
@@ -1111,7 +1255,7 @@ public:
                                                           boost::optional<repl::OpTime>* opTime,
                                                           boost::optional<OID>* electionId,
                                                           bool* containsRetry) const {
-            std::vector<size_t> docsToRetry;
+            auto docsToRetry = _groupMeasurementsByBucket(opCtx, start, numDocs);
             do {
                 docsToRetry = _performUnorderedTimeseriesWrites(
                     opCtx, start, numDocs, docsToRetry, errors, opTime, electionId, containsRetry);
@@ -1169,6 +1313,13 @@ public:
                                                              &electionId,
                                                              &containsRetry);
                 baseReply.setN(request().getDocuments().size() - errors.size());
+
+                // The measurements may have been inserted out of order, report the errors in the
+                // order of the measurements.
+                std::stable_sort(
+                    errors.begin(), errors.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+                        return lhs["index"].numberInt() < rhs["index"].numberInt();
+                    });
             }
 
             if (!errors.empty()) {
@@ -100,12 +100,12 @@ StatusWith<std::unique_ptr<AutoGetCollection>> DeferredWriter::_getCollection(
     return std::move(agc);
 }
 
-void DeferredWriter::_worker(InsertStatement stmt) {
-    auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
-    OperationContext* opCtx = uniqueOpCtx.get();
+void DeferredWriter::_insertBatch(OperationContext* opCtx,
+                                  const std::vector<InsertStatement>& batch) {
     auto result = _getCollection(opCtx);
 
     if (!result.isOK()) {
+        stdx::lock_guard<Latch> lock(_mutex);
         _logFailure(result.getStatus());
         return;
     }
@@ -114,24 +114,71 @@ void DeferredWriter::_worker(InsertStatement stmt) {
 
     const CollectionPtr& collection = agc->getCollection();
 
-    Status status = writeConflictRetry(opCtx, "deferred insert", _nss.ns(), [&] {
-        WriteUnitOfWork wuow(opCtx);
-        Status status = collection->insertDocument(opCtx, stmt, nullptr, false);
+    auto insert = [&](std::vector<InsertStatement>::const_iterator begin,
+                      std::vector<InsertStatement>::const_iterator end) {
+        return writeConflictRetry(opCtx, "deferred insert", _nss.ns(), [&] {
+            WriteUnitOfWork wuow(opCtx);
+            Status status = collection->insertDocuments(opCtx, begin, end, nullptr, false);
+            if (!status.isOK()) {
+                return status;
+            }
+
+            wuow.commit();
+            return Status::OK();
+        });
+    };
+
+    Status status = Status::OK();
+    try {
+        status = insert(batch.begin(), batch.end());
+    } catch (const DBException& ex) {
+        status = ex.toStatus();
+    }
+    if (status.isOK() || batch.size() == 1) {
         if (!status.isOK()) {
-            return status;
+            stdx::lock_guard<Latch> lock(_mutex);
+            _logFailure(status);
         }
+        return;
+    }
 
-        wuow.commit();
-        return Status::OK();
-    });
+    // Retry the documents individually so that only the ones that cannot be written are lost.
+    for (auto it = batch.begin(); it != batch.end(); ++it) {
+        try {
+            status = insert(it, it + 1);
+        } catch (const DBException& ex) {
+            status = ex.toStatus();
+        }
 
-    stdx::lock_guard<Latch> lock(_mutex);
+        // If a write to a deferred collection fails, periodically tell the log.
+        if (!status.isOK()) {
+            stdx::lock_guard<Latch> lock(_mutex);
+            _logFailure(status);
+        }
+    }
+}
 
-    _numBytes -= stmt.doc.objsize();
+void DeferredWriter::_worker() {
+    auto uniqueOpCtx = Client::getCurrent()->makeOperationContext();
+    OperationContext* opCtx = uniqueOpCtx.get();
 
-    // If a write to a deferred collection fails, periodically tell the log.
-    if (!status.isOK()) {
-        _logFailure(status);
+    std::vector<InsertStatement> batch;
+    while (true) {
+        {
+            stdx::lock_guard<Latch> lock(_mutex);
+            for (const auto& stmt : batch) {
+                _numBytes -= stmt.doc.objsize();
+            }
+            batch.clear();
+
+            if (_buffer.empty()) {
+                _workerScheduled = false;
+                return;
+            }
+            batch.swap(_buffer);
+        }
+
+        _insertBatch(opCtx, batch);
     }
 }
 
@@ -139,6 +186,7 @@ DeferredWriter::DeferredWriter(NamespaceString nss, CollectionOptions opts, int6
     : _collectionOptions(opts),
       _maxNumBytes(maxSize),
       _nss(nss),
+      _workerScheduled(false),
       _numBytes(0),
       _droppedEntries(0),
       _lastLogged(TimePoint::clock::now() - kLogInterval) {}
@@ -183,13 +231,18 @@ bool DeferredWriter::insertDocument(BSONObj obj) {
         return false;
     }
 
-    // Add the object to the buffer.
+    // Add the object to the buffer. If no worker is scheduled to drain the buffer, schedule one;
+    // otherwise the running worker will write the object along with the rest of its next batch.
     _numBytes += obj.objsize();
-    _pool->schedule([this, obj](auto status) {
-        fassert(40588, status);
-
-        _worker(InsertStatement(obj.getOwned()));
-    });
+    _buffer.emplace_back(obj.getOwned());
+    if (!_workerScheduled) {
+        _workerScheduled = true;
+        _pool->schedule([this](auto status) {
+            fassert(40588, status);
+
+            _worker();
+        });
+    }
     return true;
 }
 
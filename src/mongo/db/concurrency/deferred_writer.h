@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
@@ -53,6 +55,11 @@ class ThreadPool;
  * caller, it cannot report most errors to the client; it instead periodically logs any errors to
  * the system log.
  *
+ * Documents buffered while the worker thread is busy are written together, in a single write unit
+ * of work, the next time it runs. A burst of inserts therefore costs one collection lock
+ * acquisition and one storage transaction rather than one per document, while each document is
+ * still written as soon as the worker gets to it.
+ *
  * Instances of this class are unconditionally thread-safe, and cannot cause deadlock barring
  * improper use of the ctor, `flush` and `shutdown` methods below.
  */
@@ -134,9 +141,16 @@ private:
     StatusWith<std::unique_ptr<AutoGetCollection>> _getCollection(OperationContext* opCtx);
 
     /**
-     * The method that the worker thread will run.
+     * The method that the worker thread will run. Writes the buffered documents in batches until
+     * the buffer is empty.
+     */
+    void _worker();
+
+    /**
+     * Inserts 'batch' into the backing collection in one write unit of work. If that fails, inserts
+     * the documents one at a time so that a single bad document does not drop the whole batch.
      */
-    void _worker(InsertStatement stmt);
+    void _insertBatch(OperationContext* opCtx, const std::vector<InsertStatement>& batch);
 
     /**
      * The options for the collection, in case we need to create it.
@@ -161,7 +175,17 @@ private:
     Mutex _mutex = MONGO_MAKE_LATCH("DeferredWriter::_mutex");
 
     /**
-     * The number of bytes currently in the in-memory buffer.
+     * The documents waiting to be written by the worker thread.
+     */
+    std::vector<InsertStatement> _buffer;
+
+    /**
+     * Whether a worker task has been scheduled and has not yet found the buffer empty.
+     */
+    bool _workerScheduled;
+
+    /**
+     * The number of bytes currently in the in-memory buffer, including the batch being written.
      */
     int64_t _numBytes;
 
@@ -38,7 +38,9 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
+#include "mongo/db/concurrency/lock_stats_gen.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_wait_stats.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/flow_control.h"
 #include "mongo/logv2/log.h"
@@ -127,6 +129,9 @@ AtomicWord<unsigned long long> idCounter(0);
 // indexed by LockerId in order to minimize concurrent access conflicts.
 PartitionedInstanceWideLockStats globalStats;
 
+// Tracks sampled lock waits for individual resources across all Locker instances.
+ResourceWaitStats globalResourceWaitStats;
+
 }  // namespace
 
 bool LockerImpl::_shouldDelayUnlock(ResourceId resId, LockMode mode) const {
@@ -293,6 +298,18 @@ void Locker::setGlobalThrottling(class TicketHolder* reading, class TicketHolder
     ticketHolders[MODE_IX] = writing;
 }
 
+/* static */
+void Locker::appendGlobalThrottlingStats(BSONObjBuilder* builder) {
+    if (auto reading = ticketHolders[MODE_S]) {
+        BSONObjBuilder readBuilder(builder->subobjStart("read"));
+        reading->appendStats(readBuilder);
+    }
+    if (auto writing = ticketHolders[MODE_IX]) {
+        BSONObjBuilder writeBuilder(builder->subobjStart("write"));
+        writing->appendStats(writeBuilder);
+    }
+}
+
 LockerImpl::LockerImpl()
     : _id(idCounter.addAndFetch(1)), _wuowNestingLevel(0), _threadId(stdx::this_thread::get_id()) {}
 
@@ -376,9 +393,10 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
+        ScopedWaitTimer waitTimer(opCtx, OperationWaitStats::WaitState::kTicket);
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, getTicketPriority());
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, getTicketPriority())) {
             return false;
         }
         restoreStateOnErrorGuard.dismiss();
@@ -974,6 +992,16 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
     const uint64_t startOfTotalWaitTime = curTimeMicros64();
     uint64_t startOfCurrentWaitTime = startOfTotalWaitTime;
 
+    // Account for the whole wait on this resource, including waits that time out or are
+    // interrupted, which are the ones most worth knowing about.
+    ScopeGuard recordResourceWait([&] {
+        const int sampleRate = gLockWaitStatsSampleRate.load();
+        if (sampleRate > 0 && _numResourceWaits++ % sampleRate == 0) {
+            globalResourceWaitStats.recordWait(
+                resId, mode, curTimeMicros64() - startOfTotalWaitTime);
+        }
+    });
+
     while (true) {
         // It is OK if this call wakes up spuriously, because we re-evaluate the remaining
         // wait time anyways.
@@ -1144,8 +1172,16 @@ void reportGlobalLockingStats(SingleThreadedLockStats* outStats) {
     globalStats.report(outStats);
 }
 
+void reportGlobalResourceWaitStats(BSONObjBuilder* builder, size_t numResources) {
+    globalResourceWaitStats.report(builder, numResources);
+}
+
 void resetGlobalLockStats() {
     globalStats.reset();
 }
 
+void resetGlobalResourceWaitStats() {
+    globalResourceWaitStats.reset();
+}
+
 }  // namespace mongo
@@ -380,6 +380,9 @@ private:
     // there is no resource currently waiting.
     ResourceId _waitingResource;
 
+    // Number of lock waits of this Locker, used for sampling the waits recorded per resource.
+    uint64_t _numResourceWaits = 0;
+
     //////////////////////////////////////////////////////////////////////////////////////////
     //
     // Methods merged from LockState, which should eventually be removed or changed to methods
@@ -435,6 +438,28 @@ private:
     const bool _shouldAcquireTicket;
 };
 
+/**
+ * RAII-style class to make an operation wait for tickets in a lower priority lane, for background
+ * work that should not delay user operations when tickets are scarce.
+ */
+class ScopedTicketPriority {
+public:
+    ScopedTicketPriority(const ScopedTicketPriority&) = delete;
+    ScopedTicketPriority& operator=(const ScopedTicketPriority&) = delete;
+    ScopedTicketPriority(OperationContext* opCtx, TicketHolder::Priority priority)
+        : _opCtx(opCtx), _originalPriority(_opCtx->lockState()->getTicketPriority()) {
+        _opCtx->lockState()->setTicketPriority(priority);
+    }
+
+    ~ScopedTicketPriority() {
+        _opCtx->lockState()->setTicketPriority(_originalPriority);
+    }
+
+private:
+    OperationContext* _opCtx;
+    const TicketHolder::Priority _originalPriority;
+};
+
 /**
  * Retrieves the global lock manager instance.
  * Legacy global lock manager accessor for internal lock implementation * and debugger scripts
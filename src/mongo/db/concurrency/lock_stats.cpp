@@ -31,10 +31,15 @@
 
 #include "mongo/db/concurrency/lock_stats.h"
 
+#include <algorithm>
+
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/mutex.h"
 
 namespace mongo {
 
+using namespace fmt::literals;
+
 template <typename CounterType>
 LockStats<CounterType>::LockStats() {
     reset();
@@ -131,6 +136,88 @@ void LockStats<CounterType>::reset() {
 }
 
 
+void ResourceWaitStats::recordWait(ResourceId resId, LockMode mode, int64_t waitMicros) {
+    auto& partition = _partitions[resId % kNumPartitions];
+    stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+
+    auto& resources = partition.resources;
+    auto it = std::find_if(resources.begin(), resources.end(), [&](const ResourceStats& stats) {
+        return stats.resId == resId;
+    });
+    if (it == resources.end()) {
+        if (resources.size() < kMaxResourcesPerPartition) {
+            it = resources.emplace(resources.end());
+        } else {
+            it = std::min_element(resources.begin(),
+                                  resources.end(),
+                                  [](const ResourceStats& a, const ResourceStats& b) {
+                                      return a.combinedWaitTimeMicros < b.combinedWaitTimeMicros;
+                                  });
+            *it = ResourceStats();
+        }
+        it->resId = resId;
+    }
+
+    it->numWaits[mode]++;
+    it->combinedWaitTimeMicros += waitMicros;
+    auto bucket = std::upper_bound(kWaitMicrosBounds.begin(), kWaitMicrosBounds.end(), waitMicros);
+    it->waitMicrosBuckets[bucket - kWaitMicrosBounds.begin()]++;
+}
+
+std::vector<ResourceWaitStats::ResourceStats> ResourceWaitStats::getTopResources(
+    size_t numResources) const {
+    std::vector<ResourceStats> result;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+        result.insert(result.end(), partition.resources.begin(), partition.resources.end());
+    }
+
+    numResources = std::min(numResources, result.size());
+    std::partial_sort(result.begin(),
+                      result.begin() + numResources,
+                      result.end(),
+                      [](const ResourceStats& a, const ResourceStats& b) {
+                          return a.combinedWaitTimeMicros > b.combinedWaitTimeMicros;
+                      });
+    result.resize(numResources);
+    return result;
+}
+
+void ResourceWaitStats::report(BSONObjBuilder* builder, size_t numResources) const {
+    BSONArrayBuilder resourcesBuilder(builder->subarrayStart("hotResources"));
+    for (const auto& stats : getTopResources(numResources)) {
+        BSONObjBuilder resourceBuilder(resourcesBuilder.subobjStart());
+        resourceBuilder.append("resource", stats.resId.toString());
+        resourceBuilder.append("timeAcquiringMicros",
+                               static_cast<long long>(stats.combinedWaitTimeMicros));
+
+        {
+            BSONObjBuilder numWaits(resourceBuilder.subobjStart("acquireWaitCount"));
+            for (int mode = 1; mode < LockModesCount; mode++) {
+                if (stats.numWaits[mode] > 0) {
+                    numWaits.append(legacyModeName(static_cast<LockMode>(mode)),
+                                    static_cast<long long>(stats.numWaits[mode]));
+                }
+            }
+        }
+
+        BSONObjBuilder histogram(resourceBuilder.subobjStart("waitMicros"));
+        for (size_t i = 0; i < stats.waitMicrosBuckets.size(); ++i) {
+            auto key = i < kWaitMicrosBounds.size() ? "lt{}"_format(kWaitMicrosBounds[i])
+                                                    : "gte{}"_format(kWaitMicrosBounds.back());
+            histogram.append(key, static_cast<long long>(stats.waitMicrosBuckets[i]));
+        }
+    }
+}
+
+void ResourceWaitStats::reset() {
+    for (auto& partition : _partitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.mutex);
+        partition.resources.clear();
+    }
+}
+
+
 // Ensures that there are instances compiled for LockStats for AtomicWord<long long> and int64_t
 template class LockStats<int64_t>;
 template class LockStats<AtomicWord<long long>>;
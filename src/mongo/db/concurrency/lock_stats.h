@@ -29,8 +29,13 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/new.h"
+#include "mongo/util/concurrency/mutex.h"
 
 namespace mongo {
 
@@ -216,14 +221,77 @@ typedef LockStats<int64_t> SingleThreadedLockStats;
 typedef LockStats<AtomicWord<long long>> AtomicLockStats;
 
 
+/**
+ * Lock wait statistics for individual resources, which complement the per resource type LockStats
+ * in identifying the collections and databases that contended locks are for.
+ *
+ * Only waits are recorded, so uncontended acquisitions never reach this class, and the number of
+ * resources tracked is bounded: once a partition is full, a resource that is not tracked yet
+ * replaces the one with the least combined wait time in that partition.
+ */
+class ResourceWaitStats {
+    ResourceWaitStats(const ResourceWaitStats&) = delete;
+    ResourceWaitStats& operator=(const ResourceWaitStats&) = delete;
+
+public:
+    // Upper bounds of the wait time histogram buckets. The last bucket has no upper bound.
+    static constexpr std::array<int64_t, 4> kWaitMicrosBounds{1000, 10'000, 100'000, 1'000'000};
+
+    struct ResourceStats {
+        ResourceId resId;
+        int64_t numWaits[LockModesCount] = {};
+        int64_t combinedWaitTimeMicros = 0;
+        std::array<int64_t, kWaitMicrosBounds.size() + 1> waitMicrosBuckets = {};
+    };
+
+    ResourceWaitStats() = default;
+
+    /**
+     * Records a completed wait of 'waitMicros' for a lock on 'resId' in 'mode'.
+     */
+    void recordWait(ResourceId resId, LockMode mode, int64_t waitMicros);
+
+    /**
+     * Returns the stats of up to 'numResources' resources with the most combined wait time, in
+     * decreasing order of that time.
+     */
+    std::vector<ResourceStats> getTopResources(size_t numResources) const;
+
+    /**
+     * Appends the stats of the top 'numResources' resources to 'builder' as an array.
+     */
+    void report(BSONObjBuilder* builder, size_t numResources) const;
+
+    void reset();
+
+private:
+    static constexpr size_t kNumPartitions = 16;
+    static constexpr size_t kMaxResourcesPerPartition = 64;
+
+    struct alignas(stdx::hardware_destructive_interference_size) Partition {
+        mutable SimpleMutex mutex;
+        std::vector<ResourceStats> resources;
+    };
+
+    std::array<Partition, kNumPartitions> _partitions;
+};
+
+
 /**
  * Reports instance-wide locking statistics, which can then be converted to BSON or logged.
  */
 void reportGlobalLockingStats(SingleThreadedLockStats* outStats);
 
+/**
+ * Reports the instance-wide lock wait statistics of the 'numResources' resources with the most
+ * combined wait time as an array.
+ */
+void reportGlobalResourceWaitStats(BSONObjBuilder* builder, size_t numResources);
+
 /**
  * Currently used for testing only.
  */
 void resetGlobalLockStats();
+void resetGlobalResourceWaitStats();
 
 }  // namespace mongo
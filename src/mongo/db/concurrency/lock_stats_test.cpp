@@ -36,6 +36,8 @@
 
 namespace mongo {
 
+using namespace fmt::literals;
+
 class LockStatsTest : public ServiceContextTest {};
 
 TEST_F(LockStatsTest, NoWait) {
@@ -152,6 +154,71 @@ TEST_F(LockStatsTest, Subtraction) {
     ASSERT_GREATER_THAN(stats2.get(resId, MODE_S).combinedWaitTimeMicros, 0);
 }
 
+TEST_F(LockStatsTest, ResourceWaitStatsRecordsWaitsPerResource) {
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("LockStats.ResourceWait"));
+
+    resetGlobalResourceWaitStats();
+
+    auto opCtx = makeOperationContext();
+    LockerForTests locker(opCtx.get(), MODE_IX);
+    locker.lock(resId, MODE_X);
+
+    {
+        LockerForTests lockerConflict(opCtx.get(), MODE_IX);
+        ASSERT_THROWS_CODE(
+            lockerConflict.lock(opCtx.get(), resId, MODE_S, Date_t::now() + Milliseconds(5)),
+            AssertionException,
+            ErrorCodes::LockTimeout);
+    }
+
+    BSONObjBuilder builder;
+    reportGlobalResourceWaitStats(&builder, 10);
+    auto hotResources = builder.obj()["hotResources"].Array();
+    ASSERT_EQ(1U, hotResources.size());
+
+    auto resourceObj = hotResources[0].Obj();
+    ASSERT_EQ(resId.toString(), resourceObj["resource"].String());
+    ASSERT_GREATER_THAN(resourceObj["timeAcquiringMicros"].numberLong(), 0);
+    ASSERT_BSONOBJ_EQ(BSON("R" << 1LL), resourceObj["acquireWaitCount"].Obj());
+}
+
+TEST(ResourceWaitStatsTest, ReportsTopResourcesByWaitTime) {
+    ResourceWaitStats stats;
+    const ResourceId cold(RESOURCE_COLLECTION, std::string("LockStats.Cold"));
+    const ResourceId hot(RESOURCE_COLLECTION, std::string("LockStats.Hot"));
+
+    stats.recordWait(cold, MODE_IX, 10);
+    stats.recordWait(hot, MODE_X, 2000);
+    stats.recordWait(hot, MODE_X, 5'000'000);
+
+    auto top = stats.getTopResources(1);
+    ASSERT_EQ(1U, top.size());
+    ASSERT_EQ(hot, top[0].resId);
+    ASSERT_EQ(2, top[0].numWaits[MODE_X]);
+    ASSERT_EQ(5'002'000, top[0].combinedWaitTimeMicros);
+    ASSERT_EQ(0, top[0].waitMicrosBuckets[0]);
+    ASSERT_EQ(1, top[0].waitMicrosBuckets[1]);
+    ASSERT_EQ(1, top[0].waitMicrosBuckets.back());
+
+    ASSERT_EQ(2U, stats.getTopResources(10).size());
+
+    stats.reset();
+    ASSERT(stats.getTopResources(10).empty());
+}
+
+TEST(ResourceWaitStatsTest, BoundsTheNumberOfResources) {
+    ResourceWaitStats stats;
+    for (int i = 0; i < 10'000; ++i) {
+        stats.recordWait(ResourceId(RESOURCE_COLLECTION, "LockStats.{}"_format(i)), MODE_IX, 1);
+    }
+    const ResourceId hot(RESOURCE_COLLECTION, std::string("LockStats.Hot"));
+    stats.recordWait(hot, MODE_X, 1000);
+
+    auto top = stats.getTopResources(20'000);
+    ASSERT_LT(top.size(), 10'000U);
+    ASSERT_EQ(hot, top[0].resId);
+}
+
 namespace {
 /**
  * Locks 'rid' and then checks the global lock stat is reported correctly. Either the global lock is
@@ -37,6 +37,7 @@
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/ticketholder.h"
 
 namespace mongo {
 
@@ -76,6 +77,12 @@ public:
      */
     static void setGlobalThrottling(class TicketHolder* reading, class TicketHolder* writing);
 
+    /**
+     * Appends the state of the ticket holders passed to setGlobalThrottling as "read" and "write"
+     * sub-objects. Appends nothing for a ticket holder that has not been set.
+     */
+    static void appendGlobalThrottlingStats(BSONObjBuilder* builder);
+
     /**
      * State for reporting the number of active and queued reader and writer clients.
      */
@@ -506,6 +513,19 @@ public:
         return _shouldAcquireTicket;
     }
 
+    /**
+     * Sets the priority lane this locker waits in when no ticket is available.
+     */
+    void setTicketPriority(TicketHolder::Priority priority) {
+        // Should not hold or wait for the ticket.
+        invariant(isNoop() || getClientState() == Locker::ClientState::kInactive);
+        _ticketPriority = priority;
+    }
+
+    TicketHolder::Priority getTicketPriority() const {
+        return _ticketPriority;
+    }
+
     /**
      * Acquire a flow control admission ticket into the system. Flow control is used as a
      * backpressure mechanism to limit replication majority point lag.
@@ -555,6 +575,7 @@ private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAllowLockAcquisitionOnTimestampedUnitOfWork = false;
     bool _shouldAcquireTicket = true;
+    TicketHolder::Priority _ticketPriority = TicketHolder::Priority::kNormal;
     std::string _debugInfo;  // Extra info about this locker for debugging purpose
 };
 
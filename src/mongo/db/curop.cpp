@@ -37,6 +37,7 @@
 
 #include <iomanip>
 
+#include "mongo/base/init.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/config.h"
 #include "mongo/db/auth/authorization_manager.h"
@@ -46,14 +47,17 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/json.h"
+#include "mongo/db/operation_wait_stats.h"
 #include "mongo/db/prepare_conflict_tracker.h"
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_command_gen.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
 #include "mongo/transport/service_executor.h"
+#include "mongo/util/heap_profiler.h"
 #include "mongo/util/hex.h"
 #include "mongo/util/log_with_sampling.h"
 #include "mongo/util/net/socket_utils.h"
@@ -71,6 +75,23 @@ TimerStats oplogGetMoreStats;
 ServerStatusMetricField<TimerStats> displayBatchesReceived("repl.network.oplogGetMoresProcessed",
                                                            &oplogGetMoreStats);
 
+/**
+ * Charges the bytes of an allocation sampled by the heap profiler to the operation running on the
+ * allocating thread, if any.
+ */
+void chargeSampledAllocationToCurOp(size_t bytes) {
+    if (!haveClient())
+        return;
+
+    if (auto opCtx = cc().getOperationContext()) {
+        CurOp::get(opCtx)->debug().additiveMetrics.incrementSampledAllocatedBytes(bytes);
+    }
+}
+
+MONGO_INITIALIZER(ChargeSampledAllocationsToCurOp)(InitializerContext*) {
+    heap_profiler::setSampleObserver(chargeSampledAllocationToCurOp);
+}
+
 }  // namespace
 
 /**
@@ -425,6 +446,20 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
         oplogGetMoreStats.recordMillis(executionTimeMillis);
     }
 
+    if (_debug.queryHash) {
+        QueryShapeStats::Sample sample;
+        sample.latency = _debug.executionTime;
+        sample.keysExamined = _debug.additiveMetrics.keysExamined.value_or(0);
+        sample.docsExamined = _debug.additiveMetrics.docsExamined.value_or(0);
+        sample.nreturned = std::max(0LL, _debug.nreturned);
+        sample.bytesReturned = std::max(0, _debug.responseLength);
+        if (auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
+            metricsCollector.hasCollectedMetrics()) {
+            sample.resourceMetrics = &metricsCollector.getMetrics();
+        }
+        QueryShapeStats::get(opCtx).record(*_debug.queryHash, sample);
+    }
+
     bool shouldLogSlowOp, shouldProfileAtLevel1;
 
     if (auto filter =
@@ -704,9 +739,20 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
     if (auto n = _debug.additiveMetrics.writeConflicts.load(); n > 0) {
         builder->append("writeConflicts", n);
     }
+    if (auto n = _debug.additiveMetrics.sampledAllocatedBytes.load(); n > 0) {
+        builder->append("sampledAllocatedBytes", n);
+    }
+    if (auto waitStats = OperationWaitStats::get(opCtx).toBSON(); !waitStats.isEmpty()) {
+        builder->append("waitStates", waitStats);
+    }
 
     builder->append("numYields", _numYields.load());
 
+    if (_memoryTracker) {
+        builder->append("trackedMemBytes", _memoryTracker->currentMemoryBytes());
+        builder->append("maxTrackedMemBytes", _memoryTracker->maxMemoryBytes());
+    }
+
     if (_debug.dataThroughputLastSecond) {
         builder->append("dataThroughputLastSecond", *_debug.dataThroughputLastSecond);
     }
@@ -840,6 +886,7 @@ void OpDebug::report(OperationContext* opCtx,
         OPDEBUG_TOATTR_HELP_BOOL(replanned);
         pAttrs->add("replanReason", redact(*replanReason));
     }
+    OPDEBUG_TOATTR_HELP_OPTIONAL("planExecutionCpuMicros", planExecutionCpuMicros);
     OPDEBUG_TOATTR_HELP_OPTIONAL("nMatched", additiveMetrics.nMatched);
     OPDEBUG_TOATTR_HELP_OPTIONAL("nModified", additiveMetrics.nModified);
     OPDEBUG_TOATTR_HELP_OPTIONAL("ninserted", additiveMetrics.ninserted);
@@ -851,6 +898,7 @@ void OpDebug::report(OperationContext* opCtx,
     OPDEBUG_TOATTR_HELP_OPTIONAL("keysDeleted", additiveMetrics.keysDeleted);
     OPDEBUG_TOATTR_HELP_ATOMIC("prepareReadConflicts", additiveMetrics.prepareReadConflicts);
     OPDEBUG_TOATTR_HELP_ATOMIC("writeConflicts", additiveMetrics.writeConflicts);
+    OPDEBUG_TOATTR_HELP_ATOMIC("sampledAllocatedBytes", additiveMetrics.sampledAllocatedBytes);
 
     pAttrs->add("numYields", curop.numYields());
     OPDEBUG_TOATTR_HELP(nreturned);
@@ -916,6 +964,10 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("storage", storageStats->toBSON());
     }
 
+    if (auto waitStats = OperationWaitStats::get(opCtx).toBSON(); !waitStats.isEmpty()) {
+        pAttrs->add("waitStates", waitStats);
+    }
+
     if (operationMetrics) {
         BSONObjBuilder builder;
         operationMetrics->toBsonNonZeroFields(&builder);
@@ -994,6 +1046,7 @@ void OpDebug::append(OperationContext* opCtx,
         OPDEBUG_APPEND_BOOL(b, replanned);
         b.append("replanReason", *replanReason);
     }
+    OPDEBUG_APPEND_OPTIONAL(b, "planExecutionCpuMicros", planExecutionCpuMicros);
     OPDEBUG_APPEND_OPTIONAL(b, "nMatched", additiveMetrics.nMatched);
     OPDEBUG_APPEND_OPTIONAL(b, "nModified", additiveMetrics.nModified);
     OPDEBUG_APPEND_OPTIONAL(b, "ninserted", additiveMetrics.ninserted);
@@ -1005,6 +1058,7 @@ void OpDebug::append(OperationContext* opCtx,
     OPDEBUG_APPEND_OPTIONAL(b, "keysDeleted", additiveMetrics.keysDeleted);
     OPDEBUG_APPEND_ATOMIC(b, "prepareReadConflicts", additiveMetrics.prepareReadConflicts);
     OPDEBUG_APPEND_ATOMIC(b, "writeConflicts", additiveMetrics.writeConflicts);
+    OPDEBUG_APPEND_ATOMIC(b, "sampledAllocatedBytes", additiveMetrics.sampledAllocatedBytes);
 
     OPDEBUG_APPEND_OPTIONAL(b, "dataThroughputLastSecond", dataThroughputLastSecond);
     OPDEBUG_APPEND_OPTIONAL(b, "dataThroughputAverage", dataThroughputAverage);
@@ -1060,6 +1114,10 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("storage", storageStats->toBSON());
     }
 
+    if (auto waitStats = OperationWaitStats::get(opCtx).toBSON(); !waitStats.isEmpty()) {
+        b.append("waitStates", waitStats);
+    }
+
     if (!errInfo.isOK()) {
         b.appendNumber("ok", 0.0);
         if (!errInfo.reason().empty()) {
@@ -1232,6 +1290,9 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
             b.append(field, *args.op.replanReason);
         }
     });
+    addIfNeeded("planExecutionCpuMicros", [](auto field, auto args, auto& b) {
+        OPDEBUG_APPEND_OPTIONAL(b, field, args.op.planExecutionCpuMicros);
+    });
     addIfNeeded("nMatched", [](auto field, auto args, auto& b) {
         OPDEBUG_APPEND_OPTIONAL(b, field, args.op.additiveMetrics.nMatched);
     });
@@ -1263,6 +1324,9 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
     addIfNeeded("writeConflicts", [](auto field, auto args, auto& b) {
         OPDEBUG_APPEND_ATOMIC(b, field, args.op.additiveMetrics.writeConflicts);
     });
+    addIfNeeded("sampledAllocatedBytes", [](auto field, auto args, auto& b) {
+        OPDEBUG_APPEND_ATOMIC(b, field, args.op.additiveMetrics.sampledAllocatedBytes);
+    });
 
     addIfNeeded("dataThroughputLastSecond", [](auto field, auto args, auto& b) {
         OPDEBUG_APPEND_OPTIONAL(b, field, args.op.dataThroughputLastSecond);
@@ -1332,6 +1396,12 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         }
     });
 
+    addIfNeeded("waitStates", [](auto field, auto args, auto& b) {
+        if (auto waitStats = OperationWaitStats::get(args.opCtx).toBSON(); !waitStats.isEmpty()) {
+            b.append(field, waitStats);
+        }
+    });
+
     // Don't short-circuit: call needs() for every supported field, so that at the end we can
     // uassert that no unsupported fields were requested.
     bool needsOk = needs("ok");
@@ -1424,6 +1494,7 @@ void OpDebug::setPlanSummaryMetrics(const PlanSummaryStats& planSummaryStats) {
     usedDisk = planSummaryStats.usedDisk;
     fromMultiPlanner = planSummaryStats.fromMultiPlanner;
     replanReason = planSummaryStats.replanReason;
+    planExecutionCpuMicros = planSummaryStats.executionCpuTimeMicros;
 }
 
 BSONObj OpDebug::makeFlowControlObject(FlowControlTicketholder::CurOp stats) {
@@ -1531,6 +1602,7 @@ void OpDebug::AdditiveMetrics::add(const AdditiveMetrics& otherMetrics) {
     keysDeleted = addOptionalLongs(keysDeleted, otherMetrics.keysDeleted);
     prepareReadConflicts.fetchAndAdd(otherMetrics.prepareReadConflicts.load());
     writeConflicts.fetchAndAdd(otherMetrics.writeConflicts.load());
+    sampledAllocatedBytes.fetchAndAdd(otherMetrics.sampledAllocatedBytes.load());
 }
 
 void OpDebug::AdditiveMetrics::reset() {
@@ -1545,6 +1617,7 @@ void OpDebug::AdditiveMetrics::reset() {
     keysDeleted = boost::none;
     prepareReadConflicts.store(0);
     writeConflicts.store(0);
+    sampledAllocatedBytes.store(0);
 }
 
 bool OpDebug::AdditiveMetrics::equals(const AdditiveMetrics& otherMetrics) const {
@@ -1554,7 +1627,8 @@ bool OpDebug::AdditiveMetrics::equals(const AdditiveMetrics& otherMetrics) const
         nUpserted == otherMetrics.nUpserted && keysInserted == otherMetrics.keysInserted &&
         keysDeleted == otherMetrics.keysDeleted &&
         prepareReadConflicts.load() == otherMetrics.prepareReadConflicts.load() &&
-        writeConflicts.load() == otherMetrics.writeConflicts.load();
+        writeConflicts.load() == otherMetrics.writeConflicts.load() &&
+        sampledAllocatedBytes.load() == otherMetrics.sampledAllocatedBytes.load();
 }
 
 void OpDebug::AdditiveMetrics::incrementWriteConflicts(long long n) {
@@ -1593,6 +1667,10 @@ void OpDebug::AdditiveMetrics::incrementPrepareReadConflicts(long long n) {
     prepareReadConflicts.fetchAndAdd(n);
 }
 
+void OpDebug::AdditiveMetrics::incrementSampledAllocatedBytes(long long n) {
+    sampledAllocatedBytes.fetchAndAdd(n);
+}
+
 string OpDebug::AdditiveMetrics::report() const {
     StringBuilder s;
 
@@ -1607,6 +1685,7 @@ string OpDebug::AdditiveMetrics::report() const {
     OPDEBUG_TOSTRING_HELP_OPTIONAL("keysDeleted", keysDeleted);
     OPDEBUG_TOSTRING_HELP_ATOMIC("prepareReadConflicts", prepareReadConflicts);
     OPDEBUG_TOSTRING_HELP_ATOMIC("writeConflicts", writeConflicts);
+    OPDEBUG_TOSTRING_HELP_ATOMIC("sampledAllocatedBytes", sampledAllocatedBytes);
 
     return s.str();
 }
@@ -1623,6 +1702,7 @@ void OpDebug::AdditiveMetrics::report(logv2::DynamicAttributes* pAttrs) const {
     OPDEBUG_TOATTR_HELP_OPTIONAL("keysDeleted", keysDeleted);
     OPDEBUG_TOATTR_HELP_ATOMIC("prepareReadConflicts", prepareReadConflicts);
     OPDEBUG_TOATTR_HELP_ATOMIC("writeConflicts", writeConflicts);
+    OPDEBUG_TOATTR_HELP_ATOMIC("sampledAllocatedBytes", sampledAllocatedBytes);
 }
 
 BSONObj OpDebug::AdditiveMetrics::reportBSON() const {
@@ -1638,6 +1718,7 @@ BSONObj OpDebug::AdditiveMetrics::reportBSON() const {
     OPDEBUG_APPEND_OPTIONAL(b, "keysDeleted", keysDeleted);
     OPDEBUG_APPEND_ATOMIC(b, "prepareReadConflicts", prepareReadConflicts);
     OPDEBUG_APPEND_ATOMIC(b, "writeConflicts", writeConflicts);
+    OPDEBUG_APPEND_ATOMIC(b, "sampledAllocatedBytes", sampledAllocatedBytes);
     return b.obj();
 }
 
@@ -40,6 +40,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
@@ -129,6 +130,11 @@ public:
          */
         void incrementPrepareReadConflicts(long long n);
 
+        /**
+         * Increments sampledAllocatedBytes by n.
+         */
+        void incrementSampledAllocatedBytes(long long n);
+
         /**
          * Generates a string showing all non-empty fields. For every non-empty field field1,
          * field2, ..., with corresponding values value1, value2, ..., we will output a string in
@@ -163,6 +169,10 @@ public:
         // Number of read conflicts caused by a prepared transaction.
         AtomicWord<long long> prepareReadConflicts{0};
         AtomicWord<long long> writeConflicts{0};
+
+        // Bytes charged by the sampling heap profiler to allocations made while running the
+        // operation. Always 0 unless heap profiling is enabled.
+        AtomicWord<long long> sampledAllocatedBytes{0};
     };
 
     OpDebug() = default;
@@ -244,6 +254,10 @@ public:
     // True if a replan was triggered during the execution of this operation.
     boost::optional<std::string> replanReason;
 
+    // CPU time used by the stages of the plan, when it was collected. See
+    // internalQueryCollectExecutionCpuTime.
+    boost::optional<long long> planExecutionCpuMicros;
+
     bool cursorExhausted{
         false};  // true if the cursor has been closed at end a find/getMore operation
 
@@ -766,6 +780,17 @@ public:
 
     void setGenericCursor_inlock(GenericCursor gc);
 
+    /**
+     * The tracker of the memory used by the aggregation stages of this operation, if any.
+     */
+    const std::shared_ptr<SharedMemoryUsageTracker>& getMemoryTracker() const {
+        return _memoryTracker;
+    }
+
+    void setMemoryTracker_inlock(std::shared_ptr<SharedMemoryUsageTracker> memoryTracker) {
+        _memoryTracker = std::move(memoryTracker);
+    }
+
     boost::optional<SingleThreadedLockStats> getLockStatsBase() const {
         return _lockStatsBase;
     }
@@ -847,6 +872,8 @@ private:
     // A GenericCursor containing information about the active cursor for a getMore operation.
     boost::optional<GenericCursor> _genericCursor;
 
+    std::shared_ptr<SharedMemoryUsageTracker> _memoryTracker;
+
     std::string _planSummary;
     boost::optional<SingleThreadedLockStats>
         _lockStatsBase;  // This is the snapshot of lock stats taken when curOp is constructed.
@@ -83,6 +83,8 @@ TEST(CurOpTest, AddingAdditiveMetricsObjectsTogetherShouldAddFieldsTogether) {
     additiveMetricsToAdd.prepareReadConflicts.store(5);
     currentAdditiveMetrics.writeConflicts.store(7);
     additiveMetricsToAdd.writeConflicts.store(0);
+    currentAdditiveMetrics.sampledAllocatedBytes.store(1024);
+    additiveMetricsToAdd.sampledAllocatedBytes.store(2048);
 
     // Save the current AdditiveMetrics object before adding.
     OpDebug::AdditiveMetrics additiveMetricsBeforeAdd;
@@ -114,6 +116,9 @@ TEST(CurOpTest, AddingAdditiveMetricsObjectsTogetherShouldAddFieldsTogether) {
     ASSERT_EQ(currentAdditiveMetrics.writeConflicts.load(),
               additiveMetricsBeforeAdd.writeConflicts.load() +
                   additiveMetricsToAdd.writeConflicts.load());
+    ASSERT_EQ(currentAdditiveMetrics.sampledAllocatedBytes.load(),
+              additiveMetricsBeforeAdd.sampledAllocatedBytes.load() +
+                  additiveMetricsToAdd.sampledAllocatedBytes.load());
 }
 
 TEST(CurOpTest, AddingUninitializedAdditiveMetricsFieldsShouldBeTreatedAsZero) {
@@ -183,6 +188,7 @@ TEST(CurOpTest, AdditiveMetricsFieldsShouldIncrementByN) {
     additiveMetrics.incrementNinserted(3);
     additiveMetrics.incrementNUpserted(6);
     additiveMetrics.incrementPrepareReadConflicts(2);
+    additiveMetrics.incrementSampledAllocatedBytes(4096);
 
     ASSERT_EQ(additiveMetrics.writeConflicts.load(), 2);
     ASSERT_EQ(*additiveMetrics.keysInserted, 7);
@@ -190,6 +196,7 @@ TEST(CurOpTest, AdditiveMetricsFieldsShouldIncrementByN) {
     ASSERT_EQ(*additiveMetrics.ninserted, 3);
     ASSERT_EQ(*additiveMetrics.nUpserted, 6);
     ASSERT_EQ(additiveMetrics.prepareReadConflicts.load(), 8);
+    ASSERT_EQ(additiveMetrics.sampledAllocatedBytes.load(), 4096);
 }
 
 TEST(CurOpTest, OptionalAdditiveMetricsNotDisplayedIfUninitialized) {
@@ -494,4 +494,12 @@ Status CursorManager::checkAuthForKillCursors(OperationContext* opCtx, CursorId
     return auth::checkAuthForKillCursors(as, cursor->nss(), cursor->getAuthenticatedUsers());
 }
 
+bool CursorManager::isTailable(CursorId id) const {
+    auto lockedPartition = _cursorMap->lockOnePartition(id);
+    auto it = lockedPartition->find(id);
+    // As in checkAuthForKillCursors(), the cursor is not pinned, but its tailable mode never
+    // changes after its creation and the partition's lock keeps it from being destroyed.
+    return it != lockedPartition->end() && it->second->isTailable();
+}
+
 }  // namespace mongo
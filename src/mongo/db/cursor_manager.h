@@ -148,6 +148,11 @@ public:
      */
     Status checkAuthForKillCursors(OperationContext* opCtx, CursorId id);
 
+    /**
+     * Returns whether 'id' names a tailable cursor of this cursor manager, without pinning it.
+     */
+    bool isTailable(CursorId id) const;
+
     /**
      * Appends sessions that have open cursors in this cursor manager to the given set of lsids.
      * 'userMode': If auth is on, calling with userMode as kExcludeOthers will cause this function
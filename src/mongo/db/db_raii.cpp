@@ -34,6 +34,7 @@
 #include "mongo/db/db_raii.h"
 
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -67,6 +68,43 @@ bool supportsLockFreeRead(OperationContext* opCtx) {
         !(opCtx->recoveryUnit()->isActive() && !opCtx->isLockFreeReadsOp());
 }
 
+// Count the reads that acquire collection or database locks, by the reason they could not read
+// lock-free. Only the locking path is counted, so lock-free reads do not pay for a shared counter.
+Counter64 lockedReadsLockFreeDisabled;
+Counter64 lockedReadsInMultiDocumentTransaction;
+Counter64 lockedReadsUnderWriteLock;
+Counter64 lockedReadsWithOpenStorageTransaction;
+Counter64 lockedReadsLockFreeNotRequested;
+ServerStatusMetricField<Counter64> displayLockedReadsLockFreeDisabled(
+    "query.lockedReads.lockFreeReadsDisabled", &lockedReadsLockFreeDisabled);
+ServerStatusMetricField<Counter64> displayLockedReadsInMultiDocumentTransaction(
+    "query.lockedReads.inMultiDocumentTransaction", &lockedReadsInMultiDocumentTransaction);
+ServerStatusMetricField<Counter64> displayLockedReadsUnderWriteLock(
+    "query.lockedReads.underWriteLock", &lockedReadsUnderWriteLock);
+ServerStatusMetricField<Counter64> displayLockedReadsWithOpenStorageTransaction(
+    "query.lockedReads.withOpenStorageTransaction", &lockedReadsWithOpenStorageTransaction);
+ServerStatusMetricField<Counter64> displayLockedReadsLockFreeNotRequested(
+    "query.lockedReads.lockFreeNotRequested", &lockedReadsLockFreeNotRequested);
+
+/**
+ * Records a read that is about to acquire locks under the first condition that makes
+ * supportsLockFreeRead() false. If lock-free reads were supported, the caller chose a locking
+ * helper itself, which is counted as lockFreeNotRequested.
+ */
+void recordLockedRead(OperationContext* opCtx) {
+    if (storageGlobalParams.disableLockFreeReads) {
+        lockedReadsLockFreeDisabled.increment();
+    } else if (opCtx->inMultiDocumentTransaction()) {
+        lockedReadsInMultiDocumentTransaction.increment();
+    } else if (opCtx->lockState()->isWriteLocked()) {
+        lockedReadsUnderWriteLock.increment();
+    } else if (opCtx->recoveryUnit()->isActive() && !opCtx->isLockFreeReadsOp()) {
+        lockedReadsWithOpenStorageTransaction.increment();
+    } else {
+        lockedReadsLockFreeNotRequested.increment();
+    }
+}
+
 /**
  * Type that pretends to be a Collection. It implements the minimal interface used by
  * acquireCollectionAndConsistentSnapshot(). We are tricking acquireCollectionAndConsistentSnapshot
@@ -456,6 +494,8 @@ EmplaceAutoGetCollectionForRead::EmplaceAutoGetCollectionForRead(
     AutoGetCollectionViewMode viewMode,
     Date_t deadline)
     : _opCtx(opCtx), _nsOrUUID(nsOrUUID), _viewMode(viewMode), _deadline(deadline) {
+    recordLockedRead(opCtx);
+
     // Multi-document transactions need MODE_IX locks, otherwise MODE_IS.
     _collectionLockMode = getLockModeForQuery(opCtx, nsOrUUID.nss());
 }
@@ -826,6 +866,7 @@ AutoGetDbForReadMaybeLockFree::AutoGetDbForReadMaybeLockFree(OperationContext* o
     if (supportsLockFreeRead(opCtx)) {
         _autoGetLockFree.emplace(opCtx, dbName, deadline);
     } else {
+        recordLockedRead(opCtx);
         _autoGet.emplace(opCtx, dbName, MODE_IS, deadline);
     }
 }
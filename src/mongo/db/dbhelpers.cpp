@@ -203,12 +203,12 @@ RecordId Helpers::findById(OperationContext* opCtx,
         opCtx, collection, idquery["_id"].wrap());
 }
 
-// Acquires necessary locks to read the collection with the given namespace. If this is an oplog
-// read, use AutoGetOplog for simplified locking.
+// Acquires the collection with the given namespace for reading, lock-free when the operation
+// supports it. If this is an oplog read, use AutoGetOplog for simplified locking.
 const CollectionPtr& getCollectionForRead(
     OperationContext* opCtx,
     const NamespaceString& ns,
-    boost::optional<AutoGetCollectionForReadCommand>& autoColl,
+    boost::optional<AutoGetCollectionForReadCommandMaybeLockFree>& autoColl,
     boost::optional<AutoGetOplog>& autoOplog) {
     if (ns.isOplog()) {
         // Simplify locking rules for oplog collection.
@@ -221,7 +221,7 @@ const CollectionPtr& getCollectionForRead(
 }
 
 bool Helpers::getSingleton(OperationContext* opCtx, const char* ns, BSONObj& result) {
-    boost::optional<AutoGetCollectionForReadCommand> autoColl;
+    boost::optional<AutoGetCollectionForReadCommandMaybeLockFree> autoColl;
     boost::optional<AutoGetOplog> autoOplog;
     const auto& collection = getCollectionForRead(opCtx, NamespaceString(ns), autoColl, autoOplog);
     if (!collection) {
@@ -246,7 +246,7 @@ bool Helpers::getSingleton(OperationContext* opCtx, const char* ns, BSONObj& res
 }
 
 bool Helpers::getLast(OperationContext* opCtx, const char* ns, BSONObj& result) {
-    boost::optional<AutoGetCollectionForReadCommand> autoColl;
+    boost::optional<AutoGetCollectionForReadCommandMaybeLockFree> autoColl;
     boost::optional<AutoGetOplog> autoOplog;
     const auto& collection = getCollectionForRead(opCtx, NamespaceString(ns), autoColl, autoOplog);
     if (!collection) {
@@ -36,7 +36,6 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
 #include "mongo/stdx/unordered_map.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -91,16 +90,18 @@ private:
     // we place that result here.
     std::vector<WorkingSetID> _lookAheadResults;
 
+    // A result of the first child, along with the last child whose results it was found in.
+    // Entries whose 'lastChildSeen' falls behind _currentChild are dropped once that child is EOF.
+    struct HashedResult {
+        WorkingSetID id;
+        size_t lastChildSeen;
+    };
+
     // _dataMap is filled out by the first child and probed by subsequent children.  This is the
     // hash table that we create by intersecting _children and probe with the last child.
-    typedef stdx::unordered_map<RecordId, WorkingSetID, RecordId::Hasher> DataMap;
+    typedef stdx::unordered_map<RecordId, HashedResult, RecordId::Hasher> DataMap;
     DataMap _dataMap;
 
-    // Keeps track of what elements from _dataMap subsequent children have seen.
-    // Only used while _hashingChildren.
-    typedef stdx::unordered_set<RecordId, RecordId::Hasher> SeenMap;
-    SeenMap _seenMap;
-
     // True if we're still intersecting _children[0..._children.size()-1].
     bool _hashingChildren;
 
@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/util/bsoncolumn.h"
 #include "mongo/db/exec/bucket_unpacker.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
@@ -46,6 +47,11 @@ public:
                          const BSONElement& metaValue,
                          bool includeTimeField,
                          bool includeMetaField) = 0;
+    virtual bool getNext(BSONObjBuilder& builder,
+                         const BucketSpec& spec,
+                         const BSONElement& metaValue,
+                         bool includeTimeField,
+                         bool includeMetaField) = 0;
     virtual void extractSingleMeasurement(MutableDocument& measurement,
                                           int j,
                                           const BucketSpec& spec,
@@ -90,6 +96,11 @@ public:
                  const BSONElement& metaValue,
                  bool includeTimeField,
                  bool includeMetaField) override;
+    bool getNext(BSONObjBuilder& builder,
+                 const BucketSpec& spec,
+                 const BSONElement& metaValue,
+                 bool includeTimeField,
+                 bool includeMetaField) override;
     void extractSingleMeasurement(MutableDocument& measurement,
                                   int j,
                                   const BucketSpec& spec,
@@ -174,6 +185,31 @@ bool BucketUnpackerV1::getNext(MutableDocument& measurement,
     return _timeFieldIter.more();
 }
 
+bool BucketUnpackerV1::getNext(BSONObjBuilder& builder,
+                               const BucketSpec& spec,
+                               const BSONElement& metaValue,
+                               bool includeTimeField,
+                               bool includeMetaField) {
+    auto&& timeElem = _timeFieldIter.next();
+    if (includeTimeField) {
+        builder.appendAs(timeElem, spec.timeField);
+    }
+
+    if (includeMetaField && metaValue) {
+        builder.appendAs(metaValue, *spec.metaField);
+    }
+
+    auto& currentIdx = timeElem.fieldNameStringData();
+    for (auto&& [colName, colIter] : _fieldIters) {
+        if (auto&& elem = *colIter; colIter.more() && elem.fieldNameStringData() == currentIdx) {
+            builder.appendAs(elem, colName);
+            colIter.advance(elem);
+        }
+    }
+
+    return _timeFieldIter.more();
+}
+
 void BucketUnpackerV1::extractSingleMeasurement(MutableDocument& measurement,
                                                 int j,
                                                 const BucketSpec& spec,
@@ -214,6 +250,11 @@ public:
                  const BSONElement& metaValue,
                  bool includeTimeField,
                  bool includeMetaField) override;
+    bool getNext(BSONObjBuilder& builder,
+                 const BucketSpec& spec,
+                 const BSONElement& metaValue,
+                 bool includeTimeField,
+                 bool includeMetaField) override;
     void extractSingleMeasurement(MutableDocument& measurement,
                                   int j,
                                   const BucketSpec& spec,
@@ -279,6 +320,31 @@ bool BucketUnpackerV2::getNext(MutableDocument& measurement,
     return _timeColumn.it != _timeColumn.column.end();
 }
 
+bool BucketUnpackerV2::getNext(BSONObjBuilder& builder,
+                               const BucketSpec& spec,
+                               const BSONElement& metaValue,
+                               bool includeTimeField,
+                               bool includeMetaField) {
+    const auto& timeElem = *(_timeColumn.it++);
+    if (includeTimeField) {
+        builder.appendAs(timeElem, spec.timeField);
+    }
+
+    if (includeMetaField && metaValue) {
+        builder.appendAs(metaValue, *spec.metaField);
+    }
+
+    for (auto& fieldColumn : _fieldColumns) {
+        const BSONElement& elem = *(fieldColumn.it++);
+        // EOO represents missing field
+        if (!elem.eoo()) {
+            builder.appendAs(elem, fieldColumn.column.name());
+        }
+    }
+
+    return _timeColumn.it != _timeColumn.column.end();
+}
+
 void BucketUnpackerV2::extractSingleMeasurement(MutableDocument& measurement,
                                                 int j,
                                                 const BucketSpec& spec,
@@ -356,6 +422,24 @@ Document BucketUnpacker::getNext() {
     return measurement.freeze();
 }
 
+BSONObj BucketUnpacker::getNextBson() {
+    tassert(5521510, "'getNextBson()' requires the bucket to be owned", _bucket.isOwned());
+    tassert(5521511, "'getNextBson()' was called after the bucket has been exhausted", hasNext());
+
+    BSONObjBuilder builder;
+    _hasNext = _unpackingImpl->getNext(
+        builder, _spec, _metaValue, _includeTimeField, _includeMetaField);
+
+    // Add computed meta projections.
+    for (auto&& name : _spec.computedMetaProjFields) {
+        if (auto&& elem = _computedMetaProjections[name]) {
+            builder.appendAs(elem, name);
+        }
+    }
+
+    return builder.obj();
+}
+
 Document BucketUnpacker::extractSingleMeasurement(int j) {
     tassert(5422101,
             "'extractSingleMeasurment' expects j to be greater than or equal to zero and less than "
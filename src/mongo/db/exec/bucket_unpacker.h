@@ -87,6 +87,14 @@ public:
      */
     Document getNext();
 
+    /**
+     * Same as 'getNext()', but materializes the measurement as a BSONObj rather than a Document.
+     * Building the BSON directly from the bucket's columns is considerably cheaper than building a
+     * Document field by field, so this is used when the measurement may be discarded right away
+     * (for example, by an event-level filter).
+     */
+    BSONObj getNextBson();
+
     /**
      * This method will extract the j-th measurement from the bucket. A precondition of this method
      * is that j >= 0 && j <= the number of measurements within the underlying bucket.
@@ -42,6 +42,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
@@ -54,6 +55,11 @@ using std::vector;
 // static
 const char* CollectionScan::kStageType = "COLLSCAN";
 
+namespace {
+// The number of oplog entries which a scan takes from the SharedOplogBuffer at once.
+constexpr size_t kSharedOplogEntriesBatchSize = 64;
+}  // namespace
+
 CollectionScan::CollectionScan(ExpressionContext* expCtx,
                                const CollectionPtr& collection,
                                const CollectionScanParams& params,
@@ -70,12 +76,11 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     _specificStats.tailable = params.tailable;
     if (params.minRecord || params.maxRecord) {
         // The 'minRecord' and 'maxRecord' parameters are used for a special optimization that
-        // applies only to forwards scans of the oplog and scans on collections clustered by _id.
+        // applies only to forwards scans of the oplog and scans on collections clustered by _id,
+        // and to split forwards scans of other collections into ranges of RecordIds.
         invariant(!params.resumeAfterRecordId);
-        if (collection->ns().isOplog()) {
+        if (!collection->isClustered()) {
             invariant(params.direction == CollectionScanParams::FORWARD);
-        } else {
-            invariant(collection->isClustered());
         }
     }
     LOGV2_DEBUG(5400802,
@@ -102,6 +107,24 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    const bool shareOplogEntries = canShareOplogEntries();
+    if (shareOplogEntries) {
+        if (_sharedOplogEntries.empty()) {
+            SharedOplogBuffer::get(opCtx()).getNext(
+                _lastSeenId, kSharedOplogEntriesBatchSize, &_sharedOplogEntries);
+        }
+        if (!_sharedOplogEntries.empty()) {
+            auto entry = std::move(_sharedOplogEntries.front());
+            _sharedOplogEntries.pop_front();
+
+            // The cursor is left behind, so it is made again and positioned at '_lastSeenId' when
+            // the scan next reads from it.
+            _cursor.reset();
+            _lastSeenIdFromSharedOplogBuffer = true;
+            return returnRecord(entry.id, std::move(entry.obj), out);
+        }
+    }
+
     boost::optional<Record> record;
     const bool needToMakeCursor = !_cursor;
     try {
@@ -137,6 +160,12 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
                 // only time we'd need to create a cursor after already getting a record out of it
                 // and updating our _lastSeenId.
                 if (!_cursor->seekExact(_lastSeenId)) {
+                    if (_lastSeenIdFromSharedOplogBuffer) {
+                        // The entry was taken from the SharedOplogBuffer and may be newer than
+                        // our snapshot. Retry once we have a newer one.
+                        _cursor.reset();
+                        return PlanStage::IS_EOF;
+                    }
                     uasserted(ErrorCodes::CappedPositionLost,
                               str::stream() << "CollectionScan died due to failure to restore "
                                             << "tailable cursor position. "
@@ -170,6 +199,13 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             _params.minRecord) {
             // Seek to the approximate start location.
             record = _cursor->seekNear(*_params.minRecord);
+
+            // The scan of a range of another collection must not return the record before the
+            // range, which is part of the previous range. Scans of the oplog rely on seeing it to
+            // check that the oplog has not rolled over.
+            if (record && record->id < *_params.minRecord && !collection()->ns().isOplog()) {
+                record = _cursor->next();
+            }
         }
 
         if (_lastSeenId.isNull() && _params.direction == CollectionScanParams::BACKWARD &&
@@ -200,29 +236,54 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    _lastSeenId = record->id;
     if (_params.assertTsHasNotFallenOffOplog) {
         assertTsHasNotFallenOffOplog(*record);
     }
+
+    // The record follows '_lastSeenId' in the collection, since the cursor was positioned there.
+    BSONObj obj = record->data.releaseToBson();
+    _lastSeenIdFromSharedOplogBuffer = false;
+    if (shareOplogEntries) {
+        SharedOplogBuffer::get(opCtx()).append(_lastSeenId, record->id, obj);
+    }
+
+    return returnRecord(record->id, std::move(obj), out);
+}
+
+PlanStage::StageState CollectionScan::returnRecord(const RecordId& recordId,
+                                                   BSONObj obj,
+                                                   WorkingSetID* out) {
+    _lastSeenId = recordId;
     if (_params.shouldTrackLatestOplogTimestamp) {
-        setLatestOplogEntryTimestamp(*record);
+        setLatestOplogEntryTimestamp(obj);
     }
 
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
-    member->recordId = record->id;
-    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson());
+    member->recordId = recordId;
+    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), std::move(obj));
     _workingSet->transitionToRecordIdAndObj(id);
 
     return returnIfMatches(member, id, out);
 }
 
-void CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
-    auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
+bool CollectionScan::canShareOplogEntries() const {
+    // Only forward scans of the majority committed snapshot of the oplog share entries, since any
+    // entry which one of them has seen is visible to all of them. The first entry is always read
+    // from the cursor, which checks that the scan has not fallen off the oplog.
+    return _params.tailable && _params.direction == CollectionScanParams::FORWARD &&
+        !_params.maxRecord && !_lastSeenId.isNull() && !_params.assertTsHasNotFallenOffOplog &&
+        collection()->ns().isOplog() && internalQuerySharedOplogBufferMaxBytes.load() > 0 &&
+        opCtx()->recoveryUnit()->getTimestampReadSource() ==
+        RecoveryUnit::ReadSource::kMajorityCommitted;
+}
+
+void CollectionScan::setLatestOplogEntryTimestamp(const BSONObj& entry) {
+    auto tsElem = entry[repl::OpTime::kTimestampFieldName];
     uassert(ErrorCodes::Error(4382100),
             str::stream() << "CollectionScan was asked to track latest operation time, "
                              "but found a result without a valid 'ts' field: "
-                          << record.data.toBson().toString(),
+                          << entry.toString(),
             tsElem.type() == BSONType::bsonTimestamp);
     LOGV2_DEBUG(550450,
                 5,
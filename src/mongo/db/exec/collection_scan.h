@@ -29,10 +29,12 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/exec/shared_oplog_buffer.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 #include "mongo/s/resharding/resume_token_gen.h"
@@ -106,11 +108,23 @@ private:
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
     /**
-     * Extracts the timestamp from the 'ts' field of 'record', and sets '_latestOplogEntryTimestamp'
+     * Makes the record 'id' with contents 'obj' the last one seen, and returns it if it passes our
+     * filter.
+     */
+    StageState returnRecord(const RecordId& id, BSONObj obj, WorkingSetID* out);
+
+    /**
+     * Whether this scan may take the oplog entries which follow '_lastSeenId' from the
+     * SharedOplogBuffer, and add those it reads from its cursor.
+     */
+    bool canShareOplogEntries() const;
+
+    /**
+     * Extracts the timestamp from the 'ts' field of 'entry', and sets '_latestOplogEntryTimestamp'
      * to that time if it isn't already greater. Throws an exception if the 'ts' field cannot be
      * extracted.
      */
-    void setLatestOplogEntryTimestamp(const Record& record);
+    void setLatestOplogEntryTimestamp(const BSONObj& entry);
 
     /**
      * Asserts that the minimum timestamp in the query filter has not already fallen off the oplog.
@@ -129,6 +143,11 @@ private:
 
     RecordId _lastSeenId;  // Null if nothing has been returned from _cursor yet.
 
+    // Oplog entries which follow '_lastSeenId', taken from the SharedOplogBuffer. While there are
+    // any, the scan returns them instead of reading its cursor.
+    std::deque<SharedOplogBuffer::Entry> _sharedOplogEntries;
+    bool _lastSeenIdFromSharedOplogBuffer = false;
+
     // If _params.shouldTrackLatestOplogTimestamp is set and the collection is the oplog, the latest
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
@@ -177,6 +177,14 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
     Snapshotted<Document> memberDoc = member->doc;
     BSONObj bsonObjDoc = memberDoc.value().toBson();
 
+    boost::optional<DeleteStageParams::PartialDeleteResult> partialDelete;
+    if (_params->partialDeleter) {
+        partialDelete = _params->partialDeleter(bsonObjDoc);
+        if (partialDelete->numDeleted == 0) {
+            return PlanStage::NEED_TIME;
+        }
+    }
+
     if (_params->removeSaver) {
         uassertStatusOK(_params->removeSaver->goingToDelete(bsonObjDoc));
     }
@@ -194,22 +202,42 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
     if (!_params->isExplain) {
         try {
             WriteUnitOfWork wunit(opCtx());
-            collection()->deleteDocument(opCtx(),
-                                         Snapshotted(memberDoc.snapshotId(), bsonObjDoc),
-                                         _params->stmtId,
-                                         recordId,
-                                         _params->opDebug,
-                                         _params->fromMigrate,
-                                         false,
-                                         _params->returnDeleted ? Collection::StoreDeletedDoc::On
-                                                                : Collection::StoreDeletedDoc::Off);
+            if (partialDelete && partialDelete->remainingDoc) {
+                CollectionUpdateArgs args;
+                args.stmtIds = {_params->stmtId};
+                args.update = *partialDelete->remainingDoc;
+                args.criteria = bsonObjDoc["_id"].wrap();
+                collection()->updateDocument(opCtx(),
+                                             recordId,
+                                             Snapshotted(memberDoc.snapshotId(), bsonObjDoc),
+                                             *partialDelete->remainingDoc,
+                                             true /* indexesAffected */,
+                                             _params->opDebug,
+                                             &args);
+            } else {
+                collection()->deleteDocument(opCtx(),
+                                             Snapshotted(memberDoc.snapshotId(), bsonObjDoc),
+                                             _params->stmtId,
+                                             recordId,
+                                             _params->opDebug,
+                                             _params->fromMigrate,
+                                             false,
+                                             _params->returnDeleted
+                                                 ? Collection::StoreDeletedDoc::On
+                                                 : Collection::StoreDeletedDoc::Off);
+            }
             wunit.commit();
         } catch (const WriteConflictException&) {
             memberFreer.dismiss();  // Keep this member around so we can retry deleting it.
             return prepareToRetryWSM(id, out);
         }
     }
-    _specificStats.docsDeleted += _params->numStatsForDoc ? _params->numStatsForDoc(bsonObjDoc) : 1;
+    if (partialDelete) {
+        _specificStats.docsDeleted += partialDelete->numDeleted;
+    } else {
+        _specificStats.docsDeleted +=
+            _params->numStatsForDoc ? _params->numStatsForDoc(bsonObjDoc) : 1;
+    }
 
     if (_params->returnDeleted) {
         // After deleting the document, the RecordId associated with this member is invalid.
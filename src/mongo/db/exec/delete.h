@@ -44,6 +44,17 @@ class PlanExecutor;
 struct DeleteStageParams {
     using DocumentCounter = std::function<size_t(const BSONObj&)>;
 
+    /**
+     * The outcome of deleting part of a document. 'remainingDoc' is the document to replace the
+     * original with, or boost::none if nothing of it remains. 'numDeleted' is added to the delete
+     * stats, and the document is left as it is when it is 0.
+     */
+    struct PartialDeleteResult {
+        boost::optional<BSONObj> remainingDoc;
+        size_t numDeleted = 0;
+    };
+    using PartialDeleter = std::function<PartialDeleteResult(const BSONObj&)>;
+
     DeleteStageParams()
         : isMulti(false),
           fromMigrate(false),
@@ -90,6 +101,12 @@ struct DeleteStageParams {
     // Determines how the delete stats should be incremented. Will be incremented by 1 if the
     // function is empty.
     DocumentCounter numStatsForDoc;
+
+    // Optional. When set, determines which part of each document returned from the child is
+    // deleted, such as the matching measurements of a time-series bucket. A document of which
+    // something remains is replaced with the remainder, in a single write to that document.
+    // Overrides 'numStatsForDoc'.
+    PartialDeleter partialDeleter;
 };
 
 /**
@@ -44,6 +44,20 @@ using boost::intrusive_ptr;
 using std::string;
 using std::vector;
 
+namespace {
+// The field cache of a DocumentStorage is allocated like the storage itself, from the current
+// thread's RefCountedArena if there is one.
+char* allocateCache(size_t size) {
+    return static_cast<char*>(RefCountedArena::allocate(size));
+}
+
+struct CacheDeleter {
+    void operator()(char* cache) const {
+        RefCountedArena::release(cache);
+    }
+};
+}  // namespace
+
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
 const StringDataSet Document::allMetadataFieldNames{Document::metaFieldTextScore,
@@ -258,8 +272,8 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    std::unique_ptr<char, CacheDeleter> oldBuf(_cache);
+    _cache = allocateCache(capacity);
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
@@ -291,7 +305,7 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
+    _cache = allocateCache(newSize + hashTabBytes());
     _cacheEnd = _cache + newSize;
 }
 
@@ -303,7 +317,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = allocateCache(bufferBytes);
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -335,7 +349,7 @@ size_t DocumentStorage::getMetadataApproximateSize() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
+    std::unique_ptr<char, CacheDeleter> deleteBufferAtScopeEnd(_cache);
 
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
@@ -39,6 +39,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/stdx/variant.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/ref_counted_arena.h"
 
 namespace mongo {
 /** Helper class to make the position in a document abstract
@@ -280,6 +281,18 @@ class DocumentStorage : public RefCountable {
 public:
     DocumentStorage() : DocumentStorage(BSONObj(), false, false, 0) {}
 
+    /**
+     * Storages are allocated from the current thread's RefCountedArena if there is one, since many
+     * of them are created and destroyed while processing documents.
+     */
+    static void* operator new(size_t size) {
+        return RefCountedArena::allocate(size);
+    }
+
+    static void operator delete(void* ptr) {
+        RefCountedArena::release(ptr);
+    }
+
     /**
      * Construct a storage from the BSON. The BSON is lazily processed as fields are requested from
      * the document. If we know that the BSON does not contain any metadata fields we can set the
@@ -110,6 +110,13 @@ public:
     explicit Value(const std::vector<Document>& vec);
     explicit Value(std::vector<Value> vec)
         : _storage(Array, make_intrusive<RCVector>(std::move(vec))) {}
+
+    /**
+     * Shares 'vec' as the storage of an Array, without copying its elements. Since Values are
+     * immutable, the owner of 'vec' may only modify it again once it is no longer shared (see
+     * RefCountable::isShared()), and must copy it otherwise.
+     */
+    explicit Value(boost::intrusive_ptr<RCVector> vec) : _storage(Array, std::move(vec)) {}
     explicit Value(const BSONBinData& bd) : _storage(BinData, bd) {}
     explicit Value(const BSONRegEx& re) : _storage(RegEx, re) {}
     explicit Value(const BSONCodeWScope& cws) : _storage(CodeWScope, cws) {}
@@ -40,6 +40,7 @@
 #include "mongo/bson/timestamp.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/intrusive_counter.h"
+#include "mongo/util/ref_counted_arena.h"
 
 
 namespace mongo {
@@ -53,6 +54,16 @@ class RCVector : public RefCountable {
 public:
     RCVector() {}
     RCVector(std::vector<Value> v) : vec(std::move(v)) {}
+
+    // Allocated from the current thread's RefCountedArena if there is one, like DocumentStorage.
+    static void* operator new(size_t size) {
+        return RefCountedArena::allocate(size);
+    }
+
+    static void operator delete(void* ptr) {
+        RefCountedArena::release(ptr);
+    }
+
     std::vector<Value> vec;
 };
 
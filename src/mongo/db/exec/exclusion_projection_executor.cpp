@@ -32,6 +32,74 @@
 #include "mongo/db/exec/exclusion_projection_executor.h"
 
 namespace mongo::projection_executor {
+Document FastPathEligibleExclusionNode::applyToDocument(const Document& inputDoc) const {
+    // A fast-path exclusion projection supports exclusion-only fields, so make sure we have no
+    // computed fields in the specification.
+    invariant(!_subtreeContainsComputedFields);
+
+    // If we can get the backing BSON object off the input document without allocating an owned
+    // copy, then we can apply a fast-path BSON-to-BSON exclusion projection.
+    if (auto bson = inputDoc.toBsonIfTriviallyConvertible()) {
+        BSONObjBuilder bob(bson->objsize());
+        _applyProjections(*bson, &bob);
+
+        Document outputDoc{bob.obj()};
+        // Make sure that we always pass through any metadata present in the input doc.
+        if (inputDoc.metadata()) {
+            MutableDocument md{std::move(outputDoc)};
+            md.copyMetaDataFrom(inputDoc);
+            return md.freeze();
+        }
+        return outputDoc;
+    }
+
+    // A fast-path projection is not feasible, fall back to default implementation.
+    return ExclusionNode::applyToDocument(inputDoc);
+}
+
+void FastPathEligibleExclusionNode::_applyProjections(BSONObj bson, BSONObjBuilder* bob) const {
+    for (auto&& bsonElement : bson) {
+        const auto fieldName{bsonElement.fieldNameStringData()};
+
+        if (_projectedFields.find(fieldName) != _projectedFields.end()) {
+            // The field is excluded.
+        } else if (auto childIt = _children.find(fieldName); childIt != _children.end()) {
+            auto child = static_cast<FastPathEligibleExclusionNode*>(childIt->second.get());
+
+            if (bsonElement.type() == BSONType::Object) {
+                BSONObjBuilder subBob{bob->subobjStart(fieldName)};
+                child->_applyProjections(bsonElement.embeddedObject(), &subBob);
+            } else if (bsonElement.type() == BSONType::Array) {
+                BSONArrayBuilder subBab{bob->subarrayStart(fieldName)};
+                child->_applyProjectionsToArray(bsonElement.embeddedObject(), &subBab);
+            } else {
+                // The projection semantics dictate to keep the field in this case if it contains
+                // a scalar.
+                bob->append(bsonElement);
+            }
+        } else {
+            bob->append(bsonElement);
+        }
+    }
+}
+
+void FastPathEligibleExclusionNode::_applyProjectionsToArray(BSONObj array,
+                                                             BSONArrayBuilder* bab) const {
+    for (auto&& bsonElement : array) {
+        if (bsonElement.type() == BSONType::Object) {
+            BSONObjBuilder subBob{bab->subobjStart()};
+            _applyProjections(bsonElement.embeddedObject(), &subBob);
+        } else if (bsonElement.type() == BSONType::Array &&
+                   _policies.arrayRecursionPolicy !=
+                       ProjectionPolicies::ArrayRecursionPolicy::kDoNotRecurseNestedArrays) {
+            BSONArrayBuilder subBab{bab->subarrayStart()};
+            _applyProjectionsToArray(bsonElement.embeddedObject(), &subBab);
+        } else {
+            // Scalars, and nested arrays we don't recurse into, are kept as they are.
+            bab->append(bsonElement);
+        }
+    }
+}
 
 std::pair<BSONObj, bool> ExclusionNode::extractProjectOnFieldAndRename(const StringData& oldName,
                                                                        const StringData& newName) {
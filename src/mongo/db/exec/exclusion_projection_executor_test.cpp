@@ -37,6 +37,7 @@
 
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/base/exact_cast.h"
 #include "mongo/bson/json.h"
 #include "mongo/bson/unordered_fields_bsonobj_comparator.h"
 #include "mongo/db/exec/document_value/document.h"
@@ -615,5 +616,75 @@ TEST(ExclusionProjectionExecutionTest, ShouldNotExtractWhenFieldIsNotPresent) {
     ASSERT_BSONOBJ_EQ(fromjson("{a: {b: false}, _id: true}"),
                       exclusion->serializeTransformation(boost::none).toBson());
 }
+
+//
+// Fast-path BSON-to-BSON exclusion.
+//
+
+auto createFastPathProjectionExecutor(const BSONObj& spec, const ProjectionPolicies& policies) {
+    const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto projection = projection_ast::parseAndAnalyze(expCtx, spec, policies);
+    auto executor = buildProjectionExecutor(expCtx, &projection, policies, kDefaultBuilderParams);
+    invariant(executor->getType() == TransformerInterface::TransformerType::kExclusionProjection);
+    return executor;
+}
+
+bool hasFastPathRoot(ProjectionExecutor* executor) {
+    return exact_pointer_cast<FastPathEligibleExclusionNode*>(
+        static_cast<ExclusionProjectionExecutor*>(executor)->getRoot());
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathMatchesDefaultOnBsonDocuments) {
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"{a: 0}", "{_id: 1, a: 1, b: 2}"},
+        {"{_id: 0, b: 0}", "{_id: 1, a: 1, b: 2, c: 3}"},
+        {"{'a.b': 0}", "{a: {b: 1, c: 2}, d: 3}"},
+        {"{'a.b': 0}", "{a: 5, d: 3}"},
+        {"{'a.b': 0, 'a.c.d': 0}", "{a: [{b: 1, c: {d: 2, e: 3}}, 4, [{b: 5, x: 6}]], z: 1}"},
+        {"{'a.b': 0}", "{a: [[{b: 1, c: 2}], {b: 3, c: 4}]}"},
+        {"{x: 0}", "{a: 1}"},
+    };
+
+    for (auto arrayRecursionPolicy :
+         {ProjectionPolicies::ArrayRecursionPolicy::kRecurseNestedArrays,
+          ProjectionPolicies::ArrayRecursionPolicy::kDoNotRecurseNestedArrays}) {
+        ProjectionPolicies policies{ProjectionPolicies::kDefaultIdPolicyDefault,
+                                    arrayRecursionPolicy,
+                                    ProjectionPolicies::kComputedFieldsPolicyDefault};
+        for (auto&& [spec, doc] : cases) {
+            auto fastPath = createFastPathProjectionExecutor(fromjson(spec), policies);
+            auto defaultPath = createProjectionExecutor(fromjson(spec), policies);
+            ASSERT_TRUE(hasFastPathRoot(fastPath.get()));
+            ASSERT_FALSE(hasFastPathRoot(defaultPath.get()));
+
+            Document input{fromjson(doc)};
+            ASSERT_BSONOBJ_EQ(defaultPath->applyTransformation(input).toBson(),
+                              fastPath->applyTransformation(input).toBson());
+        }
+    }
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathFallsBackOnModifiedDocument) {
+    auto exclusion = createFastPathProjectionExecutor(fromjson("{a: 0}"), {});
+    MutableDocument input{Document{fromjson("{a: 1, b: 2}")}};
+    input.addField("c", Value(3));
+    auto result = exclusion->applyTransformation(input.freeze());
+    ASSERT_DOCUMENT_EQ(result, Document(fromjson("{b: 2, c: 3}")));
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathPreservesMetadata) {
+    auto exclusion = createFastPathProjectionExecutor(fromjson("{a: 0}"), {});
+    MutableDocument input{Document{fromjson("{a: 1, b: 2}")}};
+    input.metadata().setTextScore(0.5);
+    auto result = exclusion->applyTransformation(input.freeze());
+    ASSERT_DOCUMENT_EQ(result, Document(fromjson("{b: 2}")));
+    ASSERT_EQ(0.5, result.metadata().getTextScore());
+}
+
+TEST(ExclusionProjectionExecutionTest, MetaProjectionDoesNotUseFastPath) {
+    auto exclusion =
+        createFastPathProjectionExecutor(fromjson("{a: 0, b: {$meta: 'textScore'}}"), {});
+    ASSERT_FALSE(hasFastPathRoot(exclusion.get()));
+}
 }  // namespace
 }  // namespace mongo::projection_executor
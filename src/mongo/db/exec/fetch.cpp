@@ -31,14 +31,19 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/worker_pool.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -46,6 +51,13 @@ namespace mongo {
 using std::unique_ptr;
 using std::vector;
 
+namespace {
+
+// Loads the records read ahead by FETCH stages into the storage engine cache.
+const WorkerPool fetchPrefetchWorkers("FetchPrefetch", 16);
+
+}  // namespace
+
 // static
 const char* FetchStage::kStageType = "FETCH";
 
@@ -57,11 +69,17 @@ FetchStage::FetchStage(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ws(ws),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _idRetrying(WorkingSet::INVALID_ID),
+      _readAheadWindowSize(static_cast<size_t>(internalQueryFetchReadAheadWindowSize.load())),
+      _prefetchState(_readAheadWindowSize > 0 ? std::make_shared<PrefetchState>() : nullptr) {
     _children.emplace_back(std::move(child));
 }
 
-FetchStage::~FetchStage() {}
+FetchStage::~FetchStage() {
+    if (_prefetchState) {
+        _prefetchState->cancelled.store(true);
+    }
+}
 
 bool FetchStage::isEOF() {
     if (WorkingSet::INVALID_ID != _idRetrying) {
@@ -69,6 +87,10 @@ bool FetchStage::isEOF() {
         return false;
     }
 
+    if (!_readAheadIds.empty()) {
+        return false;
+    }
+
     return child()->isEOF();
 }
 
@@ -81,7 +103,7 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     WorkingSetID id;
     StageState status;
     if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
+        status = _readAheadWindowSize > 0 ? readAhead(&id) : child()->work(&id);
     } else {
         status = ADVANCED;
         id = _idRetrying;
@@ -126,6 +148,88 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::readAhead(WorkingSetID* out) {
+    StageState childStatus = PlanStage::NEED_TIME;
+    while (_readAheadIds.size() < _readAheadWindowSize && !child()->isEOF()) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        childStatus = child()->work(&id);
+        if (PlanStage::NEED_YIELD == childStatus) {
+            // The members already read ahead are returned after the yield.
+            *out = id;
+            return childStatus;
+        }
+        if (PlanStage::ADVANCED != childStatus) {
+            break;
+        }
+
+        WorkingSetMember* member = _ws->get(id);
+        if (member->hasObj()) {
+            // The member may be returned after a yield, which can free unowned data.
+            member->makeObjOwnedIfNeeded();
+        } else {
+            _recordIdsToPrefetch.push_back(member->recordId);
+        }
+        _readAheadIds.push_back(id);
+    }
+
+    schedulePrefetch();
+
+    if (_readAheadIds.empty()) {
+        return childStatus;
+    }
+
+    *out = _readAheadIds.front();
+    _readAheadIds.pop_front();
+    return PlanStage::ADVANCED;
+}
+
+void FetchStage::schedulePrefetch() {
+    if (_recordIdsToPrefetch.empty() || _prefetchState->inProgress.load()) {
+        return;
+    }
+
+    // Any RecordIds read ahead while the prefetcher is busy are handed to it with the next batch,
+    // which bounds the prefetching work of a stage to one task at a time.
+    _prefetchState->inProgress.store(true);
+    const auto& coll = collection();
+    // If the pool has shut down the task never runs, and the stage simply stops prefetching.
+    fetchPrefetchWorkers.schedule(
+        opCtx()->getServiceContext(),
+        [nsOrUUID = NamespaceStringOrUUID(coll->ns().db().toString(), coll->uuid()),
+         recordIds = std::move(_recordIdsToPrefetch),
+         state = _prefetchState](OperationContext* prefetchOpCtx) mutable {
+            ON_BLOCK_EXIT([&] { state->inProgress.store(false); });
+            if (state->cancelled.load()) {
+                return;
+            }
+
+            // The records read are discarded, so the prefetcher neither waits for prepared
+            // transactions nor for the collection lock, and gives up instead. Prefetching is only
+            // an optimization, so the stage does not need to know about its failures.
+            prefetchOpCtx->recoveryUnit()->setPrepareConflictBehavior(
+                PrepareConflictBehavior::kIgnoreConflicts);
+            AutoGetCollection prefetchColl(prefetchOpCtx,
+                                           nsOrUUID,
+                                           MODE_IS,
+                                           AutoGetCollectionViewMode::kViewsForbidden,
+                                           Date_t::now());
+            if (!prefetchColl) {
+                return;
+            }
+
+            // Reading in RecordId order keeps consecutive reads close together in storage.
+            std::sort(recordIds.begin(), recordIds.end());
+            auto cursor = prefetchColl->getCursor(prefetchOpCtx);
+            for (auto&& recordId : recordIds) {
+                if (state->cancelled.load()) {
+                    return;
+                }
+                cursor->seekExact(recordId);
+            }
+        });
+    _recordIdsToPrefetch.clear();
+}
+
 void FetchStage::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->saveUnpositioned();
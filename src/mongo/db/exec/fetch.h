@@ -29,12 +29,15 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -47,6 +50,11 @@ class SeekableRecordCursor;
  * the record at the provided RecordId.  Returns verbatim any data that already has an object.
  *
  * Preconditions: Valid RecordId.
+ *
+ * If 'internalQueryFetchReadAheadWindowSize' is positive, the stage reads up to that many members
+ * ahead from its child, and hands the RecordIds of the members read ahead to a background
+ * prefetcher. The prefetcher loads their records into the storage engine cache, so that fetching
+ * them later does not have to wait for the disk.
  */
 class FetchStage : public RequiresCollectionStage {
 public:
@@ -86,6 +94,28 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Fills the read-ahead window from the child, then returns the oldest member read ahead in
+     * 'out'. Returns the state of the child instead if it needs to yield, or if no member has been
+     * read ahead.
+     */
+    StageState readAhead(WorkingSetID* out);
+
+    /**
+     * Hands the RecordIds read ahead since the last call to the prefetcher, unless the prefetcher
+     * of this stage is still busy.
+     */
+    void schedulePrefetch();
+
+    // Shared between the stage and its prefetch task, which may outlive the stage.
+    struct PrefetchState {
+        // Set while a prefetch task of the stage is scheduled or running.
+        AtomicWord<bool> inProgress{false};
+
+        // Set when the stage is destroyed, after which its prefetch task stops early.
+        AtomicWord<bool> cancelled{false};
+    };
+
     // Used to fetch Records from _collection.
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
@@ -98,6 +128,17 @@ private:
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The maximum number of members read ahead from the child, or 0 if read-ahead is disabled.
+    const size_t _readAheadWindowSize;
+
+    // The members read ahead from the child, in the order in which the child returned them.
+    std::deque<WorkingSetID> _readAheadIds;
+
+    // The RecordIds of the members read ahead which have not been handed to the prefetcher yet.
+    std::vector<RecordId> _recordIdsToPrefetch;
+
+    std::shared_ptr<PrefetchState> _prefetchState;
+
     // Stats
     FetchStats _specificStats;
 };
@@ -705,6 +705,52 @@ S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Takes ownership of caps
     return new S2RegionIntersection(&regions);
 }
+
+// Number of documents which each annulus after the first is sized to contain.
+const double kTargetResultsPerInterval = 300;
+
+// Limits how much the annulus width may change from one interval to the next, so that a single
+// unusually dense or sparse annulus cannot throw the size of the following one too far off.
+const double kMaxBoundsIncrementGrowth = 8;
+const double kMaxBoundsIncrementShrink = 8;
+
+/**
+ * Returns the area of the spherical cap of the given radius, with both in meters.
+ */
+double sphericalCapArea(double radius) {
+    const double angle = std::min(std::max(radius, 0.0) / kRadiusOfEarthInMeters, M_PI);
+    return 2 * M_PI * kRadiusOfEarthInMeters * kRadiusOfEarthInMeters * (1 - std::cos(angle));
+}
+
+/**
+ * Returns the width of the annulus to search after 'lastBounds', which contained 'numResults'
+ * documents and was 'lastIncrement' wide. Assuming the density observed in 'lastBounds' carries
+ * over, the returned width makes the next annulus hold about kTargetResultsPerInterval documents.
+ */
+double adaptBoundsIncrement(const R2Annulus& lastBounds,
+                            long long numResults,
+                            double lastIncrement) {
+    const double minIncrement = lastIncrement / kMaxBoundsIncrementShrink;
+    const double maxIncrement = lastIncrement * kMaxBoundsIncrementGrowth;
+    if (numResults <= 0) {
+        return maxIncrement;
+    }
+
+    const double outer = lastBounds.getOuter();
+    const double lastArea = sphericalCapArea(outer) - sphericalCapArea(lastBounds.getInner());
+    if (lastArea <= 0) {
+        return lastIncrement;
+    }
+
+    // Find the radius whose cap is 'targetArea' larger than the cap of radius 'outer'.
+    const double targetArea = lastArea * kTargetResultsPerInterval / numResults;
+    const double nextCos = std::cos(std::min(outer / kRadiusOfEarthInMeters, M_PI)) -
+        targetArea / (2 * M_PI * kRadiusOfEarthInMeters * kRadiusOfEarthInMeters);
+    const double nextOuter =
+        nextCos <= -1 ? kMaxEarthDistanceInMeters : std::acos(nextCos) * kRadiusOfEarthInMeters;
+
+    return std::max(minIncrement, std::min(nextOuter - outer, maxIncrement));
+}
 }  // namespace
 
 GeoNear2DSphereStage::DensityEstimator::DensityEstimator(const CollectionPtr& collection,
@@ -875,13 +921,13 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
     //
 
     if (!_specificStats.intervalStats.empty()) {
+        // Size the next annulus from the density of the one just searched, rather than by a fixed
+        // factor, so that the search quickly crosses sparse areas without overshooting into dense
+        // ones. Every document in the last interval was returned before we got here, so the
+        // number returned is exactly the number of documents inside it.
         const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
-
-        // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        _boundsIncrement = adaptBoundsIncrement(
+            _currBounds, lastIntervalStats.numResultsReturned, _boundsIncrement);
     }
 
     invariant(_boundsIncrement > 0.0);
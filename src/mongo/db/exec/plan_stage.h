@@ -116,7 +116,7 @@ public:
         if (expCtx->explain || expCtx->mayDbProfile) {
             // Populating the field for execution time indicates that this stage should time each
             // call to work().
-            _commonStats.executionTimeMillis.emplace(0);
+            markShouldCollectTimingInfo();
         }
     }
 
@@ -351,6 +351,9 @@ public:
     void markShouldCollectTimingInfo() {
         invariant(!_commonStats.executionTimeMillis || *_commonStats.executionTimeMillis == 0);
         _commonStats.executionTimeMillis.emplace(0);
+        if (internalQueryCollectExecutionCpuTime.load() && ScopedTimer::canMeasureCPUTime()) {
+            _commonStats.executionCpuTimeMicros.emplace(0);
+        }
     }
 
 protected:
@@ -404,7 +407,9 @@ protected:
      */
     boost::optional<ScopedTimer> getOptTimer() {
         if (_commonStats.executionTimeMillis) {
-            return {{getClock(), _commonStats.executionTimeMillis.get_ptr()}};
+            return {{getClock(),
+                     _commonStats.executionTimeMillis.get_ptr(),
+                     _commonStats.executionCpuTimeMicros.get_ptr()}};
         }
 
         return boost::none;
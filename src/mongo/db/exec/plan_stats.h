@@ -103,6 +103,11 @@ struct CommonStats {
     // cache.
     boost::optional<long long> executionTimeMillis;
 
+    // CPU time used by the thread while working inside this stage, in microseconds. Only collected
+    // along with 'executionTimeMillis', and only when internalQueryCollectExecutionCpuTime is set,
+    // since reading the CPU clock of the thread is much more costly than the fast clock source.
+    boost::optional<long long> executionCpuTimeMicros;
+
     // TODO: have some way of tracking WSM sizes (or really any series of #s).  We can measure
     // the size of our inputs and the size of our outputs.  We can do a lot with the WS here.
 
@@ -589,6 +589,22 @@ vm::CodeFragment EFunction::compileDirect(CompileCtx& ctx) const {
         }
         vm::CodeFragment code;
 
+        // A lookup of a constant field name, which is how most paths get compiled, is emitted as a
+        // single instruction carrying the name inline. This saves pushing the name on the stack
+        // and dispatching one more instruction for every evaluation.
+        if (_name == "getField") {
+            if (auto fieldName = dynamic_cast<const EConstant*>(_nodes[1].get()); fieldName) {
+                auto [tag, val] = fieldName->getConstant();
+                if (value::isString(tag) &&
+                    value::getStringView(tag, val).size() <=
+                        std::numeric_limits<uint8_t>::max()) {
+                    code.append(_nodes[0]->compileDirect(ctx));
+                    code.appendGetField(value::getStringView(tag, val));
+                    return code;
+                }
+            }
+        }
+
         if (it->second.aggregate) {
             uassert(4822846,
                     str::stream() << "aggregate function call: " << _name
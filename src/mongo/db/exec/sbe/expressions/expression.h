@@ -377,6 +377,9 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const override;
     size_t estimateSize() const final;
 
+    std::pair<value::TypeTags, value::Value> getConstant() const {
+        return {_tag, _val};
+    }
 
 private:
     value::TypeTags _tag;
@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+
+namespace mongo::sbe {
+
+class SBEGetFieldTest : public EExpressionTestFixture {
+protected:
+    /**
+     * Returns a bsonObject value holding a copy of 'obj'. The caller owns the returned value.
+     */
+    static std::pair<value::TypeTags, value::Value> makeBsonObject(const BSONObj& obj) {
+        return value::copyValue(value::TypeTags::bsonObject,
+                                value::bitcastFrom<const char*>(obj.objdata()));
+    }
+
+    /**
+     * Compiles 'getField(input, fieldName)' and evaluates it against 'input', with the field name
+     * either given as a constant or read from a slot.
+     */
+    std::pair<value::TypeTags, value::Value> runGetField(
+        std::pair<value::TypeTags, value::Value> input, StringData fieldName, bool constantName) {
+        value::ViewOfValueAccessor inputAccessor;
+        auto inputSlot = bindAccessor(&inputAccessor);
+        inputAccessor.reset(input.first, input.second);
+
+        auto [nameTag, nameVal] = value::makeNewString(fieldName);
+        value::OwnedValueAccessor nameAccessor;
+        nameAccessor.reset(nameTag, nameVal);
+
+        std::unique_ptr<EExpression> nameExpr;
+        if (constantName) {
+            nameExpr = makeE<EConstant>(fieldName);
+        } else {
+            nameExpr = makeE<EVariable>(bindAccessor(&nameAccessor));
+        }
+
+        auto expr = makeE<EFunction>("getField",
+                                     makeEs(makeE<EVariable>(inputSlot), std::move(nameExpr)));
+        auto compiledExpr = compileExpression(*expr);
+        return runCompiledExpression(compiledExpr.get());
+    }
+
+    void assertGetField(std::pair<value::TypeTags, value::Value> input,
+                        StringData fieldName,
+                        std::pair<value::TypeTags, value::Value> expected) {
+        for (auto constantName : {true, false}) {
+            auto [tag, val] = runGetField(input, fieldName, constantName);
+            value::ValueGuard guard{tag, val};
+            ASSERT_EQ(tag, expected.first);
+            auto [cmpTag, cmpVal] = value::compareValue(tag, val, expected.first, expected.second);
+            ASSERT_EQ(cmpTag, value::TypeTags::NumberInt32);
+            ASSERT_EQ(value::bitcastTo<int32_t>(cmpVal), 0);
+        }
+    }
+
+    void assertGetFieldNothing(std::pair<value::TypeTags, value::Value> input,
+                               StringData fieldName) {
+        for (auto constantName : {true, false}) {
+            auto [tag, val] = runGetField(input, fieldName, constantName);
+            value::ValueGuard guard{tag, val};
+            ASSERT_EQ(tag, value::TypeTags::Nothing);
+        }
+    }
+};
+
+TEST_F(SBEGetFieldTest, BsonObject) {
+    auto input = makeBsonObject(BSON("a" << 1 << "b" << 2.5));
+    value::ValueGuard guard{input};
+
+    assertGetField(input, "a", makeInt32(1));
+    assertGetField(input, "b", makeDouble(2.5));
+    assertGetFieldNothing(input, "c");
+    assertGetFieldNothing(input, "");
+}
+
+TEST_F(SBEGetFieldTest, SbeObject) {
+    auto [objTag, objVal] = value::makeNewObject();
+    value::ValueGuard guard{objTag, objVal};
+    value::getObjectView(objVal)->push_back("a", value::TypeTags::NumberInt64, 7);
+
+    assertGetField({objTag, objVal}, "a", makeInt64(7));
+    assertGetFieldNothing({objTag, objVal}, "b");
+}
+
+TEST_F(SBEGetFieldTest, NonObjectInput) {
+    assertGetFieldNothing(makeInt32(1), "a");
+    assertGetFieldNothing(makeNothing(), "a");
+}
+
+TEST_F(SBEGetFieldTest, LongFieldName) {
+    // Field names which do not fit the inline encoding of the instruction are looked up through
+    // the generic path.
+    for (auto size : {255, 256, 1024}) {
+        const std::string fieldName(size, 'x');
+        auto input = makeBsonObject(BSON(fieldName << 42));
+        value::ValueGuard guard{input};
+
+        assertGetField(input, fieldName, makeInt32(42));
+        assertGetFieldNothing(input, fieldName.substr(1));
+    }
+}
+
+TEST_F(SBEGetFieldTest, NestedPath) {
+    auto input = makeBsonObject(BSON("a" << BSON("b" << BSON("c"
+                                                              << "value"))));
+    value::ValueGuard guard{input};
+
+    value::ViewOfValueAccessor inputAccessor;
+    auto inputSlot = bindAccessor(&inputAccessor);
+    inputAccessor.reset(input.first, input.second);
+
+    std::unique_ptr<EExpression> expr = makeE<EVariable>(inputSlot);
+    for (auto fieldName : {"a"_sd, "b"_sd, "c"_sd}) {
+        expr = makeE<EFunction>("getField", makeEs(std::move(expr), makeE<EConstant>(fieldName)));
+    }
+    auto compiledExpr = compileExpression(*expr);
+
+    auto [tag, val] = runCompiledExpression(compiledExpr.get());
+    value::ValueGuard resultGuard{tag, val};
+    ASSERT_TRUE(value::isString(tag));
+    ASSERT_EQ(value::getStringView(tag, val), "value");
+}
+}  // namespace mongo::sbe
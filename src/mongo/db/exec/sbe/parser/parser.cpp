@@ -1151,6 +1151,7 @@ void Parser::walkGroup(AstQuery& ast) {
         true,
         collatorSlotPos ? lookupSlot(std::move(ast.nodes[collatorSlotPos]->identifier))
                         : boost::none,
+        true /* allowDiskUse */,
         getCurrentPlanNodeId());
 }
 
@@ -1174,6 +1175,7 @@ void Parser::walkHashJoin(AstQuery& ast) {
                              lookupSlots(innerNode->nodes[0]->identifiers),  // inner conditions
                              lookupSlots(innerNode->nodes[1]->identifiers),  // inner projections
                              collatorSlot,                                   // collator
+                             true,                                           // allowDiskUse
                              getCurrentPlanNodeId());
 }
 
@@ -1289,6 +1291,7 @@ void Parser::walkExchange(AstQuery& ast) {
                                         policy,
                                         nullptr,
                                         nullptr,
+                                        boost::none,
                                         getCurrentPlanNodeId());
 }
 
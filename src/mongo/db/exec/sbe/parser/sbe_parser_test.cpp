@@ -360,6 +360,7 @@ protected:
                 sbe::makeSV(),
                 true,
                 boost::none, /* optional collator slot */
+                true,        /* allowDiskUse */
                 planNodeId),
             // GROUP with a collator slot.
             sbe::makeS<sbe::HashAggStage>(
@@ -374,6 +375,7 @@ protected:
                 sbe::makeSV(),
                 true,
                 sbe::value::SlotId{4}, /* optional collator slot */
+                true,                  /* allowDiskUse */
                 planNodeId),
             // LIMIT
             sbe::makeS<sbe::LimitSkipStage>(
@@ -422,6 +424,7 @@ protected:
                                            sbe::makeSV(1, 2) /* inner conditions */,
                                            sbe::makeSV(5, 6) /* inner projections */,
                                            boost::none, /* optional collator slot */
+                                           true,        /* allowDiskUse */
                                            planNodeId),
             // HJOIN with a collator slot.
             sbe::makeS<sbe::HashJoinStage>(sbe::makeS<sbe::CoScanStage>(planNodeId),
@@ -431,6 +434,7 @@ protected:
                                            sbe::makeSV(1, 2) /* inner conditions */,
                                            sbe::makeSV(5, 6) /* inner projections */,
                                            sbe::value::SlotId{7}, /* optional collator slot */
+                                           true,                  /* allowDiskUse */
                                            planNodeId),
             // FILTER
             sbe::makeS<sbe::FilterStage<false>>(
@@ -460,6 +464,7 @@ protected:
                                               sbe::ExchangePolicy::roundrobin,
                                               nullptr,
                                               nullptr,
+                                              boost::none,
                                               planNodeId),
             // UNWIND
             sbe::makeS<sbe::UnwindStage>(sbe::makeS<sbe::CoScanStage>(planNodeId),
@@ -47,14 +47,16 @@ public:
         BSONArray inputArr,
         BSONArray expectedOutputArray,
         bool shouldSpill = false,
-        std::unique_ptr<mongo::CollatorInterfaceMock> optionalCollator = nullptr);
+        std::unique_ptr<mongo::CollatorInterfaceMock> optionalCollator = nullptr,
+        bool allowDiskUse = false);
 };
 
 void HashAggStageTest::performHashAggWithSpillChecking(
     BSONArray inputArr,
     BSONArray expectedOutputArray,
     bool shouldSpill,
-    std::unique_ptr<mongo::CollatorInterfaceMock> optionalCollator) {
+    std::unique_ptr<mongo::CollatorInterfaceMock> optionalCollator,
+    bool allowDiskUse) {
     using namespace std::literals;
 
     auto [inputTag, inputVal] = stage_builder::makeValue(inputArr);
@@ -66,7 +68,7 @@ void HashAggStageTest::performHashAggWithSpillChecking(
     auto collatorSlot = generateSlotId();
     auto shouldUseCollator = optionalCollator.get() != nullptr;
 
-    auto makeStageFn = [this, collatorSlot, shouldUseCollator](
+    auto makeStageFn = [this, collatorSlot, shouldUseCollator, allowDiskUse](
                            value::SlotId scanSlot, std::unique_ptr<PlanStage> scanStage) {
         auto countsSlot = generateSlotId();
 
@@ -80,6 +82,7 @@ void HashAggStageTest::performHashAggWithSpillChecking(
             makeSV(),
             true,
             boost::optional<value::SlotId>{shouldUseCollator, collatorSlot},
+            allowDiskUse,
             kEmptyPlanNodeId);
 
         return std::make_pair(countsSlot, std::move(hashAggStage));
@@ -99,7 +102,7 @@ void HashAggStageTest::performHashAggWithSpillChecking(
     auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
 
     // Prepare the tree and get the 'SlotAccessor' for the output slot.
-    if (shouldSpill) {
+    if (shouldSpill && !allowDiskUse) {
         auto hashAggStage = makeStageFn(scanSlot, std::move(scanStage));
         // 'prepareTree()' also opens the tree after preparing it thus the spilling error should
         // occur in 'prepareTree()'.
@@ -116,6 +119,10 @@ void HashAggStageTest::performHashAggWithSpillChecking(
     auto [resultsTag, resultsVal] = getAllResults(stage.get(), resultAccessor);
     value::ValueGuard resultsGuard{resultsTag, resultsVal};
 
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_EQ(shouldSpill, stats->spilledRecords > 0);
+    ASSERT_FALSE(stats->usedDisk);
+
     // Sort results for stable compare, since the counts could come out in any order.
     using ValuePair = std::pair<value::TypeTags, value::Value>;
     std::vector<ValuePair> resultsContents;
@@ -189,6 +196,7 @@ TEST_F(HashAggStageTest, HashAggMinMaxTest) {
             makeSV(),
             true,
             boost::none,
+            false,
             kEmptyPlanNodeId);
 
         auto outSlot = generateSlotId();
@@ -245,6 +253,7 @@ TEST_F(HashAggStageTest, HashAggAddToSetTest) {
             makeSV(),
             true,
             boost::none,
+            false,
             kEmptyPlanNodeId);
 
         return std::make_pair(hashAggSlot, std::move(hashAggStage));
@@ -342,6 +351,7 @@ TEST_F(HashAggStageTest, HashAggSeekKeysTest) {
             makeSV(seekSlot),
             true,
             boost::none,
+            false,
             kEmptyPlanNodeId);
 
         return std::make_pair(countsSlot, std::move(hashAggStage));
@@ -418,6 +428,24 @@ TEST_F(HashAggStageTest, HashAggMemUsageTest) {
     // Should spill to disk because internalQuerySlotBasedExecutionHashAggMemoryUsageThreshold is
     // set to 128 * 5. (256 + padding) * 5 > 128 * 5
     performHashAggWithSpillChecking(spillInputArr, expectedOutputArr, true);
+    // Should produce the same groups when the rows that do not fit in memory are spilled.
+    performHashAggWithSpillChecking(spillInputArr, expectedOutputArr, true, nullptr, true);
+
+    // The hash table fills up after ["A"], ["b"] and ["c"], so the rows of the "d" group are
+    // spilled and must be grouped together using the collator when they are read back. Collator
+    // groups the values as: ["A", "a"], ["b", "B"], ["d", "D"], ["c"].
+    auto collatorSpillInputArr = BSON_ARRAY(
+        std::string(256, 'A') << std::string(256, 'b') << std::string(256, 'c')
+                              << std::string(256, 'd') << std::string(256, 'a')
+                              << std::string(256, 'B') << std::string(256, 'D'));
+    auto collatorExpectedOutputArr = BSON_ARRAY(2 << 2 << 2 << 1);
+    auto lowerStringCollator =
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString);
+    performHashAggWithSpillChecking(collatorSpillInputArr,
+                                    collatorExpectedOutputArr,
+                                    true,
+                                    std::move(lowerStringCollator),
+                                    true);
 }
 
 }  // namespace mongo::sbe
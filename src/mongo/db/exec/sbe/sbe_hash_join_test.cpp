@@ -37,6 +37,7 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_join.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 
@@ -79,6 +80,7 @@ TEST_F(HashJoinStageTest, HashJoinCollationTest) {
                                      makeSV(innerCondSlot),
                                      makeSV(),
                                      boost::optional<value::SlotId>{useCollator, collatorSlot},
+                                     false,
                                      kEmptyPlanNodeId);
 
             return std::make_pair(makeSV(innerCondSlot, outerCondSlot), std::move(hashJoinStage));
@@ -137,4 +139,118 @@ TEST_F(HashJoinStageTest, HashJoinCollationTest) {
     }
 }
 
+TEST_F(HashJoinStageTest, HashJoinSpillTest) {
+    auto defaultMemoryUseInBytesBeforeSpill =
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(
+            defaultMemoryUseInBytesBeforeSpill);
+    });
+
+    // A limit of one byte makes every partition overflow, so partitions keep being split until
+    // the maximum depth is reached. The larger limit lets most partitions fit at the first level.
+    for (long long memoryLimit : {1LL, 4LL * 1024}) {
+        for (auto useCollator : {false, true}) {
+            internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(memoryLimit);
+
+            // Every outer key appears twice and matches exactly one inner key. With the collator,
+            // the inner keys only differ from the outer keys by case.
+            BSONArrayBuilder outerBab;
+            for (int i = 0; i < 64; ++i) {
+                outerBab.append("k" + std::to_string(i));
+                outerBab.append("k" + std::to_string(i));
+            }
+            BSONArrayBuilder innerBab;
+            for (int i = 0; i < 128; ++i) {
+                innerBab.append((useCollator ? "K" : "k") + std::to_string(i));
+            }
+
+            auto [outerTag, outerVal] = stage_builder::makeValue(outerBab.arr());
+            auto [innerTag, innerVal] = stage_builder::makeValue(innerBab.arr());
+            auto [outerCondSlot, outerStage] = generateVirtualScan(outerTag, outerVal);
+            auto [innerCondSlot, innerStage] = generateVirtualScan(innerTag, innerVal);
+
+            auto collatorSlot = generateSlotId();
+            auto stage =
+                makeS<HashJoinStage>(std::move(outerStage),
+                                     std::move(innerStage),
+                                     makeSV(outerCondSlot),
+                                     makeSV(),
+                                     makeSV(innerCondSlot),
+                                     makeSV(),
+                                     boost::optional<value::SlotId>{useCollator, collatorSlot},
+                                     true,
+                                     kEmptyPlanNodeId);
+
+            auto ctx = makeCompileCtx();
+            auto collator = std::make_unique<CollatorInterfaceMock>(
+                CollatorInterfaceMock::MockType::kToLowerString);
+            value::OwnedValueAccessor collatorAccessor;
+            ctx->pushCorrelated(collatorSlot, &collatorAccessor);
+            collatorAccessor.reset(value::TypeTags::collator,
+                                   value::bitcastFrom<CollatorInterface*>(collator.get()));
+
+            auto resultAccessors =
+                prepareTree(ctx.get(), stage.get(), makeSV(innerCondSlot, outerCondSlot));
+            auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), resultAccessors);
+            value::ValueGuard resultsGuard{resultsTag, resultsVal};
+            ASSERT_EQ(resultsTag, value::TypeTags::Array);
+            auto resultsView = value::getArrayView(resultsVal);
+            ASSERT_EQ(resultsView->size(), 128U);
+
+            for (size_t i = 0; i < resultsView->size(); ++i) {
+                auto [pairTag, pairVal] = resultsView->getAt(i);
+                ASSERT_EQ(pairTag, value::TypeTags::Array);
+                auto pairView = value::getArrayView(pairVal);
+                auto [innerKeyTag, innerKeyVal] = pairView->getAt(0);
+                auto [outerKeyTag, outerKeyVal] = pairView->getAt(1);
+                auto innerKey = str::toLower(value::getStringView(innerKeyTag, innerKeyVal));
+                ASSERT_EQ(innerKey, value::getStringView(outerKeyTag, outerKeyVal));
+            }
+
+            auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+            ASSERT_GT(stats->spilledRecords, 0U);
+            ASSERT_EQ(memoryLimit == 1, stats->repartitions > 0);
+
+            stage->close();
+        }
+    }
+}
+
+TEST_F(HashJoinStageTest, HashJoinDoesNotSpillWithoutAllowDiskUse) {
+    auto defaultMemoryUseInBytesBeforeSpill =
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
+    internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(1);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(
+            defaultMemoryUseInBytesBeforeSpill);
+    });
+
+    auto [outerTag, outerVal] = stage_builder::makeValue(BSON_ARRAY(1 << 2 << 3));
+    auto [innerTag, innerVal] = stage_builder::makeValue(BSON_ARRAY(2 << 3 << 4));
+    auto [outerCondSlot, outerStage] = generateVirtualScan(outerTag, outerVal);
+    auto [innerCondSlot, innerStage] = generateVirtualScan(innerTag, innerVal);
+
+    auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                      std::move(innerStage),
+                                      makeSV(outerCondSlot),
+                                      makeSV(),
+                                      makeSV(innerCondSlot),
+                                      makeSV(),
+                                      boost::none,
+                                      false,
+                                      kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessor = prepareTree(ctx.get(), stage.get(), innerCondSlot);
+    auto [resultsTag, resultsVal] = getAllResults(stage.get(), resultAccessor);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+    ASSERT_EQ(value::getArrayView(resultsVal)->size(), 2U);
+
+    auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+    ASSERT_EQ(stats->spilledRecords, 0U);
+
+    stage->close();
+}
+
 }  // namespace mongo::sbe
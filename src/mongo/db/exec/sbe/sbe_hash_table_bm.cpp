@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <unordered_map>
+
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo::sbe {
+namespace {
+
+// The node-based tables previously used by the SBE hash stages.
+using NodeTable = stdx::unordered_map<value::MaterializedRow,
+                                      value::MaterializedRow,
+                                      value::MaterializedRowHasher,
+                                      value::MaterializedRowEq>;
+using StdTable = std::unordered_map<value::MaterializedRow,  // NOLINT
+                                    value::MaterializedRow,
+                                    value::MaterializedRowHasher,
+                                    value::MaterializedRowEq>;
+using FlatTable = value::MaterializedRowHashMap<value::MaterializedRow>;
+
+constexpr uint32_t kSeed = 34862;
+
+/**
+ * Generates 'num' single-column keys drawn from 'cardinality' distinct values, either as 64-bit
+ * integers or as strings too long to be stored inline in a value.
+ */
+std::vector<value::MaterializedRow> generateKeys(int64_t num, int64_t cardinality, bool strings) {
+    std::mt19937_64 gen(kSeed);
+    std::uniform_int_distribution<int64_t> dist(0, cardinality - 1);
+
+    std::vector<value::MaterializedRow> keys;
+    keys.reserve(num);
+    for (int64_t i = 0; i < num; ++i) {
+        value::MaterializedRow key{1};
+        auto n = dist(gen);
+        if (strings) {
+            auto [tag, val] = value::makeNewString("group-by-key-" + std::to_string(n));
+            key.reset(0, true, tag, val);
+        } else {
+            key.reset(0, false, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(n));
+        }
+        keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+/**
+ * Mimics the hash table of a HashAgg stage computing a count: every key is looked up and inserted
+ * if it is not present yet, then its accumulator is updated. 'state.range(0)' is the number of
+ * distinct keys out of the kNumKeys keys inserted per iteration.
+ */
+template <typename Table, bool Strings>
+void BM_GroupByInsert(benchmark::State& state) {
+    constexpr int64_t kNumKeys = 1 << 18;
+    auto keys = generateKeys(kNumKeys, state.range(0), Strings);
+
+    for (auto _ : state) {
+        Table table;
+        for (auto& key : keys) {
+            auto [it, inserted] = table.try_emplace(key, value::MaterializedRow{1});
+            auto [tag, val] = it->second.getViewOfValue(0);
+            auto count = inserted ? 0 : value::bitcastTo<int64_t>(val);
+            it->second.reset(
+                0, false, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(count + 1));
+        }
+        benchmark::DoNotOptimize(table.size());
+    }
+
+    state.SetItemsProcessed(state.iterations() * kNumKeys);
+}
+
+/**
+ * Probes a table holding 'state.range(0)' distinct keys, half of the probes missing, as the inner
+ * side of a hash join or lookup does.
+ */
+template <typename Table, bool Strings>
+void BM_Probe(benchmark::State& state) {
+    const int64_t cardinality = state.range(0);
+    Table table;
+    for (auto& key : generateKeys(cardinality, cardinality, Strings)) {
+        table.try_emplace(std::move(key), value::MaterializedRow{0});
+    }
+    auto probes = generateKeys(cardinality, cardinality * 2, Strings);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.find(probes[i]));
+        if (++i == probes.size()) {
+            i = 0;
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_GroupByInsert, StdTable, false)->Range(1 << 4, 1 << 18);
+BENCHMARK_TEMPLATE(BM_GroupByInsert, NodeTable, false)->Range(1 << 4, 1 << 18);
+BENCHMARK_TEMPLATE(BM_GroupByInsert, FlatTable, false)->Range(1 << 4, 1 << 18);
+BENCHMARK_TEMPLATE(BM_GroupByInsert, StdTable, true)->Range(1 << 4, 1 << 18);
+BENCHMARK_TEMPLATE(BM_GroupByInsert, NodeTable, true)->Range(1 << 4, 1 << 18);
+BENCHMARK_TEMPLATE(BM_GroupByInsert, FlatTable, true)->Range(1 << 4, 1 << 18);
+
+BENCHMARK_TEMPLATE(BM_Probe, StdTable, false)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Probe, NodeTable, false)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Probe, FlatTable, false)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Probe, StdTable, true)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Probe, NodeTable, true)->Range(1 << 4, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Probe, FlatTable, true)->Range(1 << 4, 1 << 20);
+
+}  // namespace
+}  // namespace mongo::sbe
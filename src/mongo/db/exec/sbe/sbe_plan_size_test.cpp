@@ -31,6 +31,7 @@
 #include "mongo/db/exec/sbe/stages/bson_scan.h"
 #include "mongo/db/exec/sbe/stages/check_bounds.h"
 #include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/stages/column_scan.h"
 #include "mongo/db/exec/sbe/stages/exchange.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
@@ -126,8 +127,14 @@ TEST_F(PlanSizeTest, CoScan) {
 }
 
 TEST_F(PlanSizeTest, Exchange) {
-    auto stage = makeS<ExchangeConsumer>(
-        mockS(), 1, makeSV(), ExchangePolicy::broadcast, nullptr, mockE(), kEmptyPlanNodeId);
+    auto stage = makeS<ExchangeConsumer>(mockS(),
+                                         1,
+                                         makeSV(),
+                                         ExchangePolicy::broadcast,
+                                         nullptr,
+                                         mockE(),
+                                         boost::none,
+                                         kEmptyPlanNodeId);
     assertPlanSize(*stage);
 }
 
@@ -143,6 +150,7 @@ TEST_F(PlanSizeTest, HashAgg) {
                                      makeSV(),
                                      true,
                                      generateSlotId(),
+                                     false,
                                      kEmptyPlanNodeId);
     assertPlanSize(*stage);
 }
@@ -155,10 +163,23 @@ TEST_F(PlanSizeTest, HashJoin) {
                                       mockSV(),
                                       makeSV(),
                                       generateSlotId(),
+                                      false,
                                       kEmptyPlanNodeId);
     assertPlanSize(*stage);
 }
 
+TEST_F(PlanSizeTest, ColumnScan) {
+    auto collUuid = CollectionUUID::parse("00000000-0000-0000-0000-000000000000").getValue();
+    auto stage = makeS<ColumnScanStage>(collUuid,
+                                        StringData(),
+                                        std::vector<std::string>{"a"},
+                                        mockSV(),
+                                        generateSlotId(),
+                                        nullptr,
+                                        kEmptyPlanNodeId);
+    assertPlanSize(*stage);
+}
+
 TEST_F(PlanSizeTest, IndexScan) {
     auto collUuid = CollectionUUID::parse("00000000-0000-0000-0000-000000000000").getValue();
     auto stage = makeS<IndexScanStage>(collUuid,
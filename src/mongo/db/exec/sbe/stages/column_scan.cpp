@@ -0,0 +1,422 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/column_scan.h"
+
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/exec/trial_run_tracker.h"
+#include "mongo/db/index/index_access_method.h"
+
+namespace mongo::sbe {
+ColumnScanStage::ColumnScanStage(CollectionUUID collUuid,
+                                 StringData columnIndexName,
+                                 std::vector<std::string> paths,
+                                 value::SlotVector vars,
+                                 boost::optional<value::SlotId> recordIdSlot,
+                                 PlanYieldPolicy* yieldPolicy,
+                                 PlanNodeId nodeId)
+    : PlanStage("columnscan"_sd, yieldPolicy, nodeId),
+      _collUuid(collUuid),
+      _columnIndexName(columnIndexName),
+      _paths(std::move(paths)),
+      _vars(std::move(vars)),
+      _recordIdSlot(recordIdSlot) {
+    invariant(_paths.size() == _vars.size());
+}
+
+std::unique_ptr<PlanStage> ColumnScanStage::clone() const {
+    return std::make_unique<ColumnScanStage>(_collUuid,
+                                             _columnIndexName,
+                                             _paths,
+                                             _vars,
+                                             _recordIdSlot,
+                                             _yieldPolicy,
+                                             _commonStats.nodeId);
+}
+
+void ColumnScanStage::prepare(CompileCtx& ctx) {
+    if (_recordIdSlot) {
+        _recordIdAccessor = std::make_unique<value::OwnedValueAccessor>();
+    }
+
+    _outAccessors.resize(_vars.size());
+    for (size_t idx = 0; idx < _outAccessors.size(); ++idx) {
+        auto [it, inserted] = _accessorMap.emplace(_vars[idx], &_outAccessors[idx]);
+        uassert(6010301, str::stream() << "duplicate slot: " << _vars[idx], inserted);
+    }
+
+    tassert(6010302, "'_coll' should not be initialized prior to 'acquireCollection()'", !_coll);
+    std::tie(_coll, _collName, _catalogEpoch) = acquireCollection(_opCtx, _collUuid);
+
+    auto indexCatalog = _coll->getIndexCatalog();
+    auto indexDesc = indexCatalog->findIndexByName(_opCtx, _columnIndexName);
+    tassert(6010303,
+            str::stream() << "could not find index named '" << _columnIndexName
+                          << "' in collection '" << _collName << "'",
+            indexDesc);
+    tassert(6010304,
+            str::stream() << "index named '" << _columnIndexName << "' is not a columnstore index",
+            indexDesc->getIndexType() == IndexType::INDEX_COLUMN);
+    _weakIndexCatalogEntry = indexCatalog->getEntryShared(indexDesc);
+    auto entry = _weakIndexCatalogEntry.lock();
+    tassert(6010305,
+            str::stream() << "expected IndexCatalogEntry for index named: " << _columnIndexName,
+            static_cast<bool>(entry));
+
+    auto sdi = entry->accessMethod()->getSortedDataInterface();
+    _ordering = sdi->getOrdering();
+    _keyStringVersion = sdi->getKeyStringVersion();
+
+    // A column store on a single path can only serve that path.
+    ColumnKeyGenerator keyGen(indexDesc->keyPattern(), _keyStringVersion, *_ordering);
+    for (auto&& path : _paths) {
+        tassert(6010306,
+                str::stream() << "columnstore index '" << _columnIndexName
+                              << "' does not store path '" << path << "'",
+                keyGen.isPathIndexed(path));
+    }
+}
+
+value::SlotAccessor* ColumnScanStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    if (_recordIdSlot && *_recordIdSlot == slot) {
+        return _recordIdAccessor.get();
+    }
+
+    if (auto it = _accessorMap.find(slot); it != _accessorMap.end()) {
+        return it->second;
+    }
+
+    return ctx.getAccessor(slot);
+}
+
+void ColumnScanStage::doSaveState() {
+    if (slotsAccessible()) {
+        if (_recordIdAccessor) {
+            _recordIdAccessor->makeOwned();
+        }
+        for (auto& accessor : _outAccessors) {
+            accessor.makeOwned();
+        }
+    }
+
+    if (_rowCursor) {
+        _rowCursor->save();
+    }
+
+    // The columns are re-positioned from the next row onwards after the yield, so that the values
+    // they produce come from the same snapshot as the row markers.
+    for (auto& column : _columnCursors) {
+        column.cursor->save();
+        column.cell = boost::none;
+        column.needsSeek = true;
+    }
+
+    _coll.reset();
+}
+
+void ColumnScanStage::restoreCollectionAndIndex() {
+    tassert(6010307, "Collection name should be initialized", _collName);
+    tassert(6010308, "Catalog epoch should be initialized", _catalogEpoch);
+    _coll = restoreCollection(_opCtx, *_collName, _collUuid, *_catalogEpoch);
+    auto indexCatalogEntry = _weakIndexCatalogEntry.lock();
+    uassert(ErrorCodes::QueryPlanKilled,
+            str::stream() << "query plan killed :: index '" << _columnIndexName << "' dropped",
+            indexCatalogEntry && !indexCatalogEntry->isDropped());
+}
+
+void ColumnScanStage::doRestoreState() {
+    invariant(_opCtx);
+    invariant(!_coll);
+
+    // If this stage has not been prepared, then yield recovery is a no-op.
+    if (!_collName) {
+        return;
+    }
+    restoreCollectionAndIndex();
+
+    if (_rowCursor) {
+        _rowCursor->restore();
+    }
+    for (auto& column : _columnCursors) {
+        column.cursor->restore();
+    }
+}
+
+void ColumnScanStage::doDetachFromOperationContext() {
+    if (_rowCursor) {
+        _rowCursor->detachFromOperationContext();
+    }
+    for (auto& column : _columnCursors) {
+        column.cursor->detachFromOperationContext();
+    }
+}
+
+void ColumnScanStage::doAttachToOperationContext(OperationContext* opCtx) {
+    if (_rowCursor) {
+        _rowCursor->reattachToOperationContext(opCtx);
+    }
+    for (auto& column : _columnCursors) {
+        column.cursor->reattachToOperationContext(opCtx);
+    }
+}
+
+void ColumnScanStage::doDetachFromTrialRunTracker() {
+    _tracker = nullptr;
+}
+
+void ColumnScanStage::doAttachToTrialRunTracker(TrialRunTracker* tracker) {
+    _tracker = tracker;
+}
+
+void ColumnScanStage::open(bool reOpen) {
+    auto optTimer(getOptTimer(_opCtx));
+
+    _commonStats.opens++;
+    invariant(_opCtx);
+
+    if (_open) {
+        tassert(6010309, "reopened ColumnScanStage but reOpen=false", reOpen);
+        tassert(6010310, "ColumnScanStage is open but _coll is null", _coll);
+        tassert(6010311, "ColumnScanStage is open but don't have _rowCursor", _rowCursor);
+    } else {
+        tassert(6010312, "first open to ColumnScanStage but reOpen=true", !reOpen);
+        if (!_coll) {
+            // We're being opened after 'close()'. We need to re-acquire '_coll' in this case and
+            // make some validity checks (the collection has not been dropped, renamed, etc.).
+            tassert(6010313, "ColumnScanStage is not open but have _rowCursor", !_rowCursor);
+            restoreCollectionAndIndex();
+        }
+    }
+
+    _open = true;
+    _firstGetNext = true;
+
+    auto entry = _weakIndexCatalogEntry.lock();
+    tassert(6010314,
+            str::stream() << "expected IndexCatalogEntry for index named: " << _columnIndexName,
+            static_cast<bool>(entry));
+    auto sdi = entry->accessMethod()->getSortedDataInterface();
+    if (!_rowCursor) {
+        _rowCursor = sdi->newCursor(_opCtx, true /* forward */);
+        _columnCursors.resize(_paths.size());
+        for (auto& column : _columnCursors) {
+            column.cursor = sdi->newCursor(_opCtx, true /* forward */);
+        }
+    }
+
+    for (auto& column : _columnCursors) {
+        column.cell = boost::none;
+        column.needsSeek = true;
+    }
+}
+
+boost::optional<ColumnKeyGenerator::Cell> ColumnScanStage::decodeCellOfPath(
+    const boost::optional<KeyStringEntry>& entry, StringData path) const {
+    if (!entry) {
+        return boost::none;
+    }
+
+    auto cell = ColumnKeyGenerator::decodeCell(entry->keyString, *_ordering);
+    if (!cell.path || *cell.path != path) {
+        return boost::none;
+    }
+    return cell;
+}
+
+void ColumnScanStage::readColumn(size_t idx, int64_t rid) {
+    auto& column = _columnCursors[idx];
+    const auto& path = _paths[idx];
+
+    if (column.needsSeek) {
+        column.needsSeek = false;
+        auto seekKey = ColumnKeyGenerator::makeSeekKey(
+            _keyStringVersion, *_ordering, StringData(path), rid);
+        column.cell = decodeCellOfPath(column.cursor->seekForKeyString(seekKey), path);
+        ++_specificStats.seeks;
+        ++_specificStats.numReads;
+    }
+
+    // Every document has at most one cell per path, and the cells of a path are sorted by
+    // RecordId, so the cursor only ever needs to move forward.
+    while (column.cell && column.cell->recordId.getLong() < rid) {
+        column.cell = decodeCellOfPath(column.cursor->nextKeyString(), path);
+        ++_specificStats.numReads;
+    }
+
+    auto& accessor = _outAccessors[idx];
+    if (!column.cell || column.cell->recordId.getLong() != rid) {
+        accessor.reset();
+        return;
+    }
+
+    ++_specificStats.keysExamined;
+    auto value = column.cell->value;
+    auto [tag, val] = bson::convertFrom<true>(
+        value.rawdata(), value.rawdata() + value.size(), value.fieldNameSize() - 1);
+    accessor.reset(false, tag, val);
+}
+
+PlanState ColumnScanStage::getNext() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    // We are about to get next record from a storage cursor so do not bother saving our internal
+    // state in case it yields as the state will be completely overwritten after the call.
+    disableSlotAccess();
+
+    if (!_rowCursor) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    checkForInterrupt(_opCtx);
+
+    boost::optional<KeyStringEntry> rowEntry;
+    if (_firstGetNext) {
+        _firstGetNext = false;
+        rowEntry = _rowCursor->seekForKeyString(ColumnKeyGenerator::makeSeekKey(
+            _keyStringVersion, *_ordering, boost::none, RecordId::kMinRepr));
+        ++_specificStats.seeks;
+    } else {
+        rowEntry = _rowCursor->nextKeyString();
+    }
+
+    ++_specificStats.numReads;
+    if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumReads>(1)) {
+        // If we're collecting execution stats during multi-planning and reached the end of the
+        // trial period because we've performed enough physical reads, bail out from the trial run
+        // by raising a special exception to signal a runtime planner that this candidate plan has
+        // completed its trial run early. Note that a trial period is executed only once per a
+        // PlanStage tree, and once completed never run again on the same tree.
+        _tracker = nullptr;
+        uasserted(ErrorCodes::QueryTrialRunCompleted, "Trial run early exit in columnscan");
+    }
+
+    if (!rowEntry) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    // The row markers sort before all the cells, so the first cell ends the scan.
+    auto row = ColumnKeyGenerator::decodeCell(rowEntry->keyString, *_ordering);
+    if (row.path) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    ++_specificStats.keysExamined;
+    const int64_t rid = row.recordId.getLong();
+    for (size_t idx = 0; idx < _columnCursors.size(); ++idx) {
+        readColumn(idx, rid);
+    }
+
+    if (_recordIdAccessor) {
+        _recordIdAccessor->reset(
+            false, value::TypeTags::RecordId, value::bitcastFrom<int64_t>(rid));
+    }
+
+    return trackPlanState(PlanState::ADVANCED);
+}
+
+void ColumnScanStage::close() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    trackClose();
+
+    _columnCursors.clear();
+    _rowCursor.reset();
+    _coll.reset();
+    _open = false;
+}
+
+std::unique_ptr<PlanStageStats> ColumnScanStage::getStats(bool includeDebugInfo) const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<IndexScanStats>(_specificStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendNumber("keysExamined", static_cast<long long>(_specificStats.keysExamined));
+        bob.appendNumber("seeks", static_cast<long long>(_specificStats.seeks));
+        bob.appendNumber("numReads", static_cast<long long>(_specificStats.numReads));
+        if (_recordIdSlot) {
+            bob.appendNumber("recordIdSlot", static_cast<long long>(*_recordIdSlot));
+        }
+        bob.append("paths", _paths);
+        bob.append("outputSlots", _vars.begin(), _vars.end());
+        ret->debugInfo = bob.obj();
+    }
+
+    return ret;
+}
+
+const SpecificStats* ColumnScanStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+std::vector<DebugPrinter::Block> ColumnScanStage::debugPrint() const {
+    auto ret = PlanStage::debugPrint();
+
+    if (_recordIdSlot) {
+        DebugPrinter::addIdentifier(ret, _recordIdSlot.get());
+    } else {
+        DebugPrinter::addIdentifier(ret, DebugPrinter::kNoneKeyword);
+    }
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _vars.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+        DebugPrinter::addIdentifier(ret, _vars[idx]);
+        ret.emplace_back("=");
+        ret.emplace_back(str::stream() << "\"" << _paths[idx] << "\"");
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back("@\"`");
+    DebugPrinter::addIdentifier(ret, _collUuid.toString());
+    ret.emplace_back("`\"");
+
+    ret.emplace_back("@\"`");
+    DebugPrinter::addIdentifier(ret, _columnIndexName);
+    ret.emplace_back("`\"");
+
+    return ret;
+}
+
+size_t ColumnScanStage::estimateCompileTimeSize() const {
+    size_t size = sizeof(*this);
+    size += size_estimator::estimate(_vars);
+    size += size_estimator::estimate(_paths);
+    size += size_estimator::estimate(_columnIndexName);
+    size += size_estimator::estimate(_specificStats);
+    return size;
+}
+
+}  // namespace mongo::sbe
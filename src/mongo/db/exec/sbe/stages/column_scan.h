@@ -0,0 +1,154 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/bson/ordering.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/exec/sbe/stages/collection_helpers.h"
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo::sbe {
+/**
+ * A stage that scans a columnstore index and, for every document in the index, produces the values
+ * of a set of paths in the 'vars' slots. Only the columns of the requested 'paths' are read, so the
+ * documents themselves are never fetched.
+ *
+ * The value produced for a path is the one found by traversing sub-objects only, as a chain of
+ * getField() calls would. If a document has no such value, the corresponding slot is Nothing.
+ *
+ * The "output" slots are
+ *   - 'recordIdSlot': the RecordId of the current document,
+ *   - 'vars': one slot for each path in 'paths', in the same order.
+ *
+ * Debug string representation:
+ *
+ *   columnscan recordIdSlot? [slot_1 = path_1, ..., slot_n = path_n]
+ *              collectionUuid indexName
+ */
+class ColumnScanStage final : public PlanStage {
+public:
+    ColumnScanStage(CollectionUUID collUuid,
+                    StringData columnIndexName,
+                    std::vector<std::string> paths,
+                    value::SlotVector vars,
+                    boost::optional<value::SlotId> recordIdSlot,
+                    PlanYieldPolicy* yieldPolicy,
+                    PlanNodeId nodeId);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+    size_t estimateCompileTimeSize() const final;
+
+protected:
+    void doSaveState() override;
+    void doRestoreState() override;
+    void doDetachFromOperationContext() override;
+    void doAttachToOperationContext(OperationContext* opCtx) override;
+    void doDetachFromTrialRunTracker() override;
+    void doAttachToTrialRunTracker(TrialRunTracker* tracker) override;
+
+private:
+    /**
+     * A cursor over the cells of a single path. 'cell' holds the first cell of the path whose
+     * RecordId is not less than the one of the current row, or boost::none once the column is
+     * exhausted. 'needsSeek' is set when the cursor has not been positioned yet.
+     */
+    struct ColumnCursor {
+        std::unique_ptr<SortedDataInterface::Cursor> cursor;
+        boost::optional<ColumnKeyGenerator::Cell> cell;
+        bool needsSeek{true};
+    };
+
+    /**
+     * When this stage is re-opened after being closed, or during yield recovery, called to verify
+     * that the index (and the index's collection) remain valid. If any validity check fails, throws
+     * a UserException that terminates execution of the query.
+     */
+    void restoreCollectionAndIndex();
+
+    /**
+     * Positions the cursor of the column 'idx' on the cell of the row 'rid', if any, and binds its
+     * value to the corresponding output slot.
+     */
+    void readColumn(size_t idx, int64_t rid);
+
+    /**
+     * Decodes 'entry' if it is a cell of 'path', and returns boost::none otherwise.
+     */
+    boost::optional<ColumnKeyGenerator::Cell> decodeCellOfPath(
+        const boost::optional<KeyStringEntry>& entry, StringData path) const;
+
+    const CollectionUUID _collUuid;
+    const std::string _columnIndexName;
+    const std::vector<std::string> _paths;
+    const value::SlotVector _vars;
+    const boost::optional<value::SlotId> _recordIdSlot;
+
+    // These members are default constructed to boost::none and are initialized when 'prepare()'
+    // is called. Once they are set, they are never modified again.
+    boost::optional<NamespaceString> _collName;
+    boost::optional<uint64_t> _catalogEpoch;
+
+    CollectionPtr _coll;
+
+    std::unique_ptr<value::OwnedValueAccessor> _recordIdAccessor;
+
+    // One accessor for each path. The values are views into the current cell of each column.
+    std::vector<value::OwnedValueAccessor> _outAccessors;
+    value::SlotAccessorMap _accessorMap;
+
+    std::weak_ptr<const IndexCatalogEntry> _weakIndexCatalogEntry;
+    boost::optional<Ordering> _ordering{boost::none};
+    KeyString::Version _keyStringVersion{KeyString::Version::kLatestVersion};
+
+    // Iterates over the row markers of the index, which determine the documents returned.
+    std::unique_ptr<SortedDataInterface::Cursor> _rowCursor;
+    std::vector<ColumnCursor> _columnCursors;
+
+    bool _open{false};
+    bool _firstGetNext{true};
+    IndexScanStats _specificStats;
+
+    // If provided, used during a trial run to accumulate certain execution stats. Once the trial
+    // run is complete, this pointer is reset to nullptr.
+    TrialRunTracker* _tracker{nullptr};
+};
+}  // namespace mongo::sbe
@@ -34,6 +34,7 @@
 #include "mongo/base/init.h"
 #include "mongo/db/client.h"
 #include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 std::unique_ptr<ThreadPool> s_globalThreadPool;
@@ -69,12 +70,11 @@ void ExchangePipe::close() {
     _cond.notify_all();
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
+std::unique_ptr<ExchangeBuffer> ExchangePipe::tryGetEmptyBuffer(bool* closed) {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _emptyCount > 0; });
-
-    if (_closed) {
+    *closed = _closed;
+    if (_closed || _emptyCount == 0) {
         return nullptr;
     }
 
@@ -83,10 +83,18 @@ std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
     return std::move(_emptyBuffers[_emptyCount]);
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer() {
+void ExchangePipe::waitForEmptyBuffer(OperationContext* opCtx) {
+    stdx::unique_lock lock(_mutex);
+
+    opCtx->waitForConditionOrInterrupt(
+        _cond, lock, [this]() { return _closed || _emptyCount > 0; });
+}
+
+std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer(OperationContext* opCtx) {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _fullCount != _fullPosition; });
+    opCtx->waitForConditionOrInterrupt(
+        _cond, lock, [this]() { return _closed || _fullCount != _fullPosition; });
 
     if (_closed) {
         return nullptr;
@@ -122,17 +130,50 @@ ExchangeState::ExchangeState(size_t numOfProducers,
                              value::SlotVector fields,
                              ExchangePolicy policy,
                              std::unique_ptr<EExpression> partition,
-                             std::unique_ptr<EExpression> orderLess)
+                             std::unique_ptr<EExpression> orderLess,
+                             boost::optional<NamespaceStringOrUUID> lockedCollection)
     : _policy(policy),
       _numOfProducers(numOfProducers),
       _fields(std::move(fields)),
       _partition(std::move(partition)),
-      _orderLess(std::move(orderLess)) {}
+      _orderLess(std::move(orderLess)),
+      _lockedCollection(std::move(lockedCollection)) {}
 
 ExchangePipe* ExchangeState::pipe(size_t consumerTid, size_t producerTid) {
     return _consumers[consumerTid]->pipe(producerTid);
 }
 
+void ExchangeState::addProducerOpCtx(OperationContext* opCtx) {
+    stdx::lock_guard<Latch> lk(_producerOpCtxsMutex);
+    if (_producerKillCode) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, *_producerKillCode);
+    }
+    _producerOpCtxs.push_back(opCtx);
+}
+
+void ExchangeState::removeProducerOpCtx(OperationContext* opCtx) {
+    stdx::lock_guard<Latch> lk(_producerOpCtxsMutex);
+    _producerOpCtxs.erase(std::find(_producerOpCtxs.begin(), _producerOpCtxs.end(), opCtx));
+}
+
+void ExchangeState::killProducers(ErrorCodes::Error code) {
+    stdx::lock_guard<Latch> lk(_producerOpCtxsMutex);
+    if (_producerKillCode) {
+        return;
+    }
+    _producerKillCode = code;
+    for (auto opCtx : _producerOpCtxs) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, code);
+    }
+}
+
+bool ExchangeState::producersKilled() {
+    stdx::lock_guard<Latch> lk(_producerOpCtxsMutex);
+    return _producerKillCode.has_value();
+}
+
 size_t ExchangeState::estimateCompileTimeSize() const {
     size_t size = sizeof(*this);
     size += size_estimator::estimate(_fields);
@@ -148,7 +189,7 @@ ExchangeBuffer* ExchangeConsumer::getBuffer(size_t producerId) {
         return _fullBuffers[producerId].get();
     }
 
-    _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer();
+    _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer(_opCtx);
 
     return _fullBuffers[producerId].get();
 }
@@ -170,11 +211,16 @@ ExchangeConsumer::ExchangeConsumer(std::unique_ptr<PlanStage> input,
                                    ExchangePolicy policy,
                                    std::unique_ptr<EExpression> partition,
                                    std::unique_ptr<EExpression> orderLess,
+                                   boost::optional<NamespaceStringOrUUID> lockedCollection,
                                    PlanNodeId planNodeId)
     : PlanStage("exchange"_sd, planNodeId) {
     _children.emplace_back(std::move(input));
-    _state = std::make_shared<ExchangeState>(
-        numOfProducers, std::move(fields), policy, std::move(partition), std::move(orderLess));
+    _state = std::make_shared<ExchangeState>(numOfProducers,
+                                             std::move(fields),
+                                             policy,
+                                             std::move(partition),
+                                             std::move(orderLess),
+                                             std::move(lockedCollection));
 
     _tid = _state->addConsumer(this);
     _orderPreserving = _state->isOrderPreserving();
@@ -271,17 +317,34 @@ void ExchangeConsumer::open(bool reOpen) {
                 }
             }
 
+            // The producers read from the same point in time as this consumer, which is required
+            // for them to see the same snapshot of a collection.
+            auto readTimestamp = _opCtx->recoveryUnit()->getPointInTimeReadTimestamp(_opCtx);
+            uassert(6170462,
+                    "Exchange producers reading a collection require a read timestamp",
+                    readTimestamp || !_state->lockedCollection());
+
             // Start n producers.
             invariant(_state->producerCompileCtxs().size() == _state->numOfProducers());
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 auto pf = makePromiseFuture<void>();
                 s_globalThreadPool->schedule(
-                    [this, idx, promise = std::move(pf.promise)](auto status) mutable {
+                    [this, idx, readTimestamp, promise = std::move(pf.promise)](
+                        auto status) mutable {
                         invariant(status);
 
                         auto opCtx = cc().makeOperationContext();
 
                         promise.setWith([&] {
+                            // The consumer may go away as soon as the promise is fulfilled.
+                            _state->addProducerOpCtx(opCtx.get());
+                            ON_BLOCK_EXIT([&] { _state->removeProducerOpCtx(opCtx.get()); });
+
+                            if (readTimestamp) {
+                                opCtx->recoveryUnit()->setTimestampReadSource(
+                                    RecoveryUnit::ReadSource::kProvided, *readTimestamp);
+                            }
+
                             ExchangeProducer::start(opCtx.get(),
                                                     _state->producerCompileCtxs()[idx],
                                                     std::move(_state->producerPlans()[idx]));
@@ -320,9 +383,16 @@ PlanState ExchangeConsumer::getNext() {
         uasserted(4822834, "ordere exchange not yet implemented");
     } else {
         while (_eofs < _state->numOfProducers()) {
-            auto buffer = getBuffer(0);
+            ExchangeBuffer* buffer;
+            try {
+                buffer = getBuffer(0);
+            } catch (const DBException& ex) {
+                _state->killProducers(ex.code());
+                throw;
+            }
             if (!buffer) {
-                // early out
+                // The pipe is only closed before all producers are done if one of them failed.
+                rethrowProducerError();
                 return trackPlanState(PlanState::IS_EOF);
             }
             if (_bufferPos[0] < buffer->count()) {
@@ -362,6 +432,12 @@ void ExchangeConsumer::close() {
 
         if (_tid == 0) {
             // Consumer ID 0
+            // Stop the producers which are still running, for instance because the cursor is
+            // killed before it is exhausted.
+            if (_eofs < _state->numOfProducers()) {
+                _state->killProducers(ErrorCodes::Interrupted);
+            }
+
             // Wait for n producers to finish.
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 _state->producerResults()[idx].wait();
@@ -377,9 +453,10 @@ void ExchangeConsumer::close() {
                 lock, [this]() { return _state->consumerClose() == _state->numOfConsumers(); });
         }
     }
-    // Rethrow the first stored exception from producers.
-    // We can do it outside of the lock as everybody else is gone by now.
-    if (_tid == 0) {
+    // Rethrow the first stored exception from producers, unless they were interrupted because the
+    // consumer did not need their results. We can do it outside of the lock as everybody else is
+    // gone by now.
+    if (_tid == 0 && !_state->producersKilled()) {
         // Consumer ID 0
         for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
             _state->producerResults()[idx].get();
@@ -387,9 +464,18 @@ void ExchangeConsumer::close() {
     }
 }
 
+void ExchangeConsumer::rethrowProducerError() {
+    for (auto& result : _state->producerResults()) {
+        uassertStatusOK(result.getNoThrow(_opCtx));
+    }
+}
+
 std::unique_ptr<PlanStageStats> ExchangeConsumer::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
-    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    // Once opened, the subtree has been handed over to the producers.
+    if (!_children.empty()) {
+        ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    }
     return ret;
 }
 
@@ -429,7 +515,9 @@ std::vector<DebugPrinter::Block> ExchangeConsumer::debugPrint() const {
     }
 
     DebugPrinter::addNewLine(ret);
-    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    if (!_children.empty()) {
+        DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    }
 
     return ret;
 }
@@ -454,7 +542,18 @@ ExchangeBuffer* ExchangeProducer::getBuffer(size_t consumerId) {
         return _emptyBuffers[consumerId].get();
     }
 
-    _emptyBuffers[consumerId] = _pipes[consumerId]->getEmptyBuffer();
+    _opCtx->checkForInterrupt();
+
+    bool closed = false;
+    _emptyBuffers[consumerId] = _pipes[consumerId]->tryGetEmptyBuffer(&closed);
+    while (!_emptyBuffers[consumerId] && !closed) {
+        // The consumer is not keeping up, typically because its cursor waits for the next getMore.
+        // Do not block operations which need an exclusive lock on the collection meanwhile.
+        releaseCollection();
+        _pipes[consumerId]->waitForEmptyBuffer(_opCtx);
+        reacquireCollection();
+        _emptyBuffers[consumerId] = _pipes[consumerId]->tryGetEmptyBuffer(&closed);
+    }
 
     if (!_emptyBuffers[consumerId]) {
         closePipes();
@@ -477,6 +576,25 @@ void ExchangeProducer::closePipes() {
     }
 }
 
+void ExchangeProducer::releaseCollection() {
+    if (!_autoColl) {
+        return;
+    }
+
+    // The current row, if any, is kept by the accessors of the saved subtree.
+    _children[0]->saveState();
+    _autoColl.reset();
+    _opCtx->recoveryUnit()->abandonSnapshot();
+}
+
+void ExchangeProducer::reacquireCollection() {
+    if (auto& nssOrUuid = _state->lockedCollection(); nssOrUuid && !_autoColl) {
+        // The read timestamp is unchanged, so the subtree keeps reading from the same snapshot.
+        _autoColl.emplace(_opCtx, *nssOrUuid, MODE_IS);
+        _children[0]->restoreState();
+    }
+}
+
 ExchangeProducer::ExchangeProducer(std::unique_ptr<PlanStage> input,
                                    std::shared_ptr<ExchangeState> state,
                                    PlanNodeId planNodeId)
@@ -499,7 +617,14 @@ void ExchangeProducer::start(OperationContext* opCtx,
 
     p->attachToOperationContext(opCtx);
 
+    // The lock must be released on this thread, before 'opCtx' goes away.
+    ON_BLOCK_EXIT([&] { p->_autoColl.reset(); });
+
     try {
+        if (auto& nssOrUuid = p->_state->lockedCollection(); nssOrUuid) {
+            p->_autoColl.emplace(opCtx, *nssOrUuid, MODE_IS);
+        }
+
         p->prepare(ctx);
         p->open(false);
 
@@ -31,8 +31,10 @@
 
 #include <vector>
 
+#include "mongo/db/catalog_raii.h"
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/thread_pool.h"
@@ -122,11 +124,21 @@ public:
     ExchangePipe(size_t size);
 
     void close();
-    std::unique_ptr<ExchangeBuffer> getEmptyBuffer();
-    std::unique_ptr<ExchangeBuffer> getFullBuffer();
+    std::unique_ptr<ExchangeBuffer> getFullBuffer(OperationContext* opCtx);
     void putEmptyBuffer(std::unique_ptr<ExchangeBuffer>);
     void putFullBuffer(std::unique_ptr<ExchangeBuffer>);
 
+    /**
+     * Returns an empty buffer if one is available without waiting, or nullptr otherwise, in which
+     * case 'closed' tells whether the pipe is closed.
+     */
+    std::unique_ptr<ExchangeBuffer> tryGetEmptyBuffer(bool* closed);
+
+    /**
+     * Waits until an empty buffer is available or the pipe is closed.
+     */
+    void waitForEmptyBuffer(OperationContext* opCtx);
+
 private:
     Mutex _mutex = MONGO_MAKE_LATCH("ExchangePipe::_mutex");
     stdx::condition_variable _cond;
@@ -150,7 +162,8 @@ public:
                   value::SlotVector fields,
                   ExchangePolicy policy,
                   std::unique_ptr<EExpression> partition,
-                  std::unique_ptr<EExpression> orderLess);
+                  std::unique_ptr<EExpression> orderLess,
+                  boost::optional<NamespaceStringOrUUID> lockedCollection);
 
     bool isOrderPreserving() const {
         return !!_orderLess;
@@ -220,8 +233,25 @@ public:
         return _partition.get();
     }
 
+    const auto& lockedCollection() const {
+        return _lockedCollection;
+    }
+
     ExchangePipe* pipe(size_t consumerTid, size_t producerTid);
 
+    /**
+     * Tracks the OperationContext a producer runs on while it is running, so that it can be
+     * interrupted on behalf of the consumers.
+     */
+    void addProducerOpCtx(OperationContext* opCtx);
+    void removeProducerOpCtx(OperationContext* opCtx);
+
+    /**
+     * Interrupts the running producers with 'code', as well as the ones which have yet to start.
+     */
+    void killProducers(ErrorCodes::Error code);
+    bool producersKilled();
+
     size_t estimateCompileTimeSize() const;
 
 private:
@@ -242,6 +272,10 @@ private:
     // The '<' function for order preserving exchange.
     const std::unique_ptr<EExpression> _orderLess;
 
+    // The collection the producer subtrees read from, if any. Every producer runs on its own
+    // OperationContext and acquires an intent lock on this collection for its whole lifetime.
+    const boost::optional<NamespaceStringOrUUID> _lockedCollection;
+
     // This is verbose and heavyweight. Recondsider something lighter
     // at minimum try to share a single mutex (i.e. _stateMutex) if safe
     mongo::Mutex _consumerOpenMutex;
@@ -251,8 +285,24 @@ private:
     mongo::Mutex _consumerCloseMutex;
     stdx::condition_variable _consumerCloseCond;
     size_t _consumerClose{0};
+
+    Mutex _producerOpCtxsMutex = MONGO_MAKE_LATCH("ExchangeState::_producerOpCtxsMutex");
+    std::vector<OperationContext*> _producerOpCtxs;
+    boost::optional<ErrorCodes::Error> _producerKillCode;
 };
 
+/**
+ * Runs 'numOfProducers' copies of the 'input' subtree on the parallel execution pool and returns
+ * the values of the 'fields' slots they produce.
+ *
+ * Every producer runs on a fresh OperationContext, which is interrupted when the consumer is
+ * interrupted or closed before the producers are done. If 'lockedCollection' is provided, the
+ * consumer must be reading at a point in time: every producer reads from the same timestamp and
+ * holds an intent lock on that collection while it runs. A producer which waits for the consumer
+ * to catch up, for instance while the cursor of the consumer waits for the next getMore, releases
+ * the lock and yields its subtree until then. Subtrees which access a collection must not be given
+ * a yield policy, as the producers yield them by themselves.
+ */
 class ExchangeConsumer final : public PlanStage {
 public:
     ExchangeConsumer(std::unique_ptr<PlanStage> input,
@@ -261,6 +311,7 @@ public:
                      ExchangePolicy policy,
                      std::unique_ptr<EExpression> partition,
                      std::unique_ptr<EExpression> orderLess,
+                     boost::optional<NamespaceStringOrUUID> lockedCollection,
                      PlanNodeId planNodeId);
 
     ExchangeConsumer(std::shared_ptr<ExchangeState> state, PlanNodeId planNodeId);
@@ -284,6 +335,11 @@ private:
     ExchangeBuffer* getBuffer(size_t producerId);
     void putBuffer(size_t producerId);
 
+    /**
+     * Throws the first error of a producer, waiting for all of them to be done.
+     */
+    void rethrowProducerError();
+
     std::shared_ptr<ExchangeState> _state;
     size_t _tid{0};
 
@@ -341,6 +397,11 @@ private:
     void closePipes();
     bool appendData(size_t consumerId);
 
+    // Release and reacquire the lock on the collection the subtree reads from, if any, yielding the
+    // subtree in between.
+    void releaseCollection();
+    void reacquireCollection();
+
     std::shared_ptr<ExchangeState> _state;
     size_t _tid{0};
     size_t _roundRobinCounter{0};
@@ -356,5 +417,8 @@ private:
 
     // Current empty buffers that this producer is processing.
     std::vector<std::unique_ptr<ExchangeBuffer>> _emptyBuffers;
+
+    // The lock on the collection the subtree reads from, while it is held.
+    boost::optional<AutoGetCollection> _autoColl;
 };
 }  // namespace mongo::sbe
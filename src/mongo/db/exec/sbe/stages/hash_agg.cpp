@@ -31,25 +31,67 @@
 
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 
+#include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/util/str.h"
 
-#include "mongo/db/exec/sbe/size_estimator.h"
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashAggFileCounter;
+    return "extsort-hash-agg-sbe." + std::to_string(hashAggFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
 
 namespace mongo {
 namespace sbe {
+namespace {
+/**
+ * Compares the first 'numKeys' values of the two rows. 'Nothing' sorts before any other value so
+ * that it forms a group of its own.
+ */
+int compareGroupByKeys(const value::MaterializedRow& lhs,
+                       const value::MaterializedRow& rhs,
+                       size_t numKeys,
+                       const CollatorInterface* collator) {
+    for (size_t idx = 0; idx < numKeys; ++idx) {
+        auto [lhsTag, lhsVal] = lhs.getViewOfValue(idx);
+        auto [rhsTag, rhsVal] = rhs.getViewOfValue(idx);
+        if (lhsTag == value::TypeTags::Nothing || rhsTag == value::TypeTags::Nothing) {
+            if (lhsTag == rhsTag) {
+                continue;
+            }
+            return lhsTag == value::TypeTags::Nothing ? -1 : 1;
+        }
+
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal, collator);
+        auto result = value::bitcastTo<int32_t>(val);
+        if (result) {
+            return result;
+        }
+    }
+
+    return 0;
+}
+}  // namespace
+
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
                            value::SlotMap<std::unique_ptr<EExpression>> aggs,
                            value::SlotVector seekKeysSlots,
                            bool optimizedClose,
                            boost::optional<value::SlotId> collatorSlot,
+                           bool allowDiskUse,
                            PlanNodeId planNodeId)
     : PlanStage("group"_sd, planNodeId),
       _gbs(std::move(gbs)),
       _aggs(std::move(aggs)),
       _collatorSlot(collatorSlot),
       _seekKeysSlots(std::move(seekKeysSlots)),
-      _optimizedClose(optimizedClose) {
+      _optimizedClose(optimizedClose),
+      _allowDiskUse(allowDiskUse) {
     _children.emplace_back(std::move(input));
     invariant(_seekKeysSlots.empty() || _seekKeysSlots.size() == _gbs.size());
     tassert(5843100,
@@ -57,6 +99,8 @@ HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
             _seekKeysSlots.empty() || _optimizedClose);
 }
 
+HashAggStage::~HashAggStage() {}
+
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
     value::SlotMap<std::unique_ptr<EExpression>> aggs;
     for (auto& [k, v] : _aggs) {
@@ -68,6 +112,7 @@ std::unique_ptr<PlanStage> HashAggStage::clone() const {
                                           _seekKeysSlots,
                                           _optimizedClose,
                                           _collatorSlot,
+                                          _allowDiskUse,
                                           _commonStats.nodeId);
 }
 
@@ -115,7 +160,9 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         ctx.aggExpression = true;
         ctx.accumulator = _outAggAccessors.back().get();
 
+        _compilingAggs = true;
         _aggCodes.emplace_back(expr->compile(ctx));
+        _compilingAggs = false;
         ctx.aggExpression = false;
     }
     _compiled = true;
@@ -126,6 +173,29 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
         if (auto it = _outAccessors.find(slot); it != _outAccessors.end()) {
             return it->second;
         }
+    } else if (_compilingAggs && _seekKeysSlots.empty()) {
+        // Slots that are bound outside of this stage (correlated slots and the runtime
+        // environment) keep their values while the input is consumed and are never spilled.
+        auto isCorrelated = std::any_of(ctx.correlated.begin(),
+                                        ctx.correlated.end(),
+                                        [slot](auto&& elem) { return elem.first == slot; });
+        auto accessor = _children[0]->getAccessor(ctx, slot);
+        if (isCorrelated || dynamic_cast<RuntimeEnvironment::Accessor*>(accessor)) {
+            return accessor;
+        }
+
+        auto it = std::find(_spilledSlots.begin(), _spilledSlots.end(), slot);
+        if (it != _spilledSlots.end()) {
+            return _switchAccessors[it - _spilledSlots.begin()].get();
+        }
+
+        _outSpilledAccessors.emplace_back(
+            std::make_unique<SpilledRowAccessor>(_spilledRowIt, _spilledSlots.size()));
+        _switchAccessors.emplace_back(std::make_unique<value::SwitchAccessor>(
+            std::vector<value::SlotAccessor*>{accessor, _outSpilledAccessors.back().get()}));
+        _spilledSlots.push_back(slot);
+        _inSpilledAccessors.push_back(accessor);
+        return _switchAccessors.back().get();
     } else {
         return _children[0]->getAccessor(ctx, slot);
     }
@@ -156,6 +226,14 @@ void HashAggStage::open(bool reOpen) {
 
         _seekKeys.resize(_seekKeysAccessors.size());
 
+        _spilledIt.reset();
+        _hasPendingSpilledRow = false;
+        _readingSpilledRows = false;
+        _spilledRowsCounter = 0;
+        for (auto& accessor : _switchAccessors) {
+            accessor->setIndex(0);
+        }
+
         // A counter to check memory usage periodically.
         auto memoryUseCheckCounter = 0;
 
@@ -168,6 +246,21 @@ void HashAggStage::open(bool reOpen) {
                 key.reset(idx++, false, tag, val);
             }
 
+            if (_sorter) {
+                // The memory limit has been reached, so only the groups already present in the
+                // hash table are accumulated in memory. Rows of all other groups are spilled.
+                if (auto it = _ht->find(key); it != _ht->end()) {
+                    _htIt = it;
+                    for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+                        auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
+                        _outAggAccessors[idx]->reset(owned, tag, val);
+                    }
+                } else {
+                    spillRow();
+                }
+                continue;
+            }
+
             auto [it, inserted] = _ht->try_emplace(std::move(key), value::MaterializedRow{0});
             if (inserted) {
                 // Copy keys.
@@ -191,12 +284,24 @@ void HashAggStage::open(bool reOpen) {
                 long estimatedSizeForOneRow =
                     it->first.memUsageForSorter() + it->second.memUsageForSorter();
                 long long estimatedTotalSize = _ht->size() * estimatedSizeForOneRow;
-                uassert(5859000,
-                        "Need to spill to disk",
-                        estimatedTotalSize < _approxMemoryUseInBytesBeforeSpill);
+                if (estimatedTotalSize >= _approxMemoryUseInBytesBeforeSpill) {
+                    uassert(5859000,
+                            "Need to spill to disk",
+                            _allowDiskUse && _seekKeysAccessors.empty());
+                    makeSorter();
+                }
             }
         }
 
+        if (_sorter) {
+            _spilledIt.reset(_sorter->done());
+            _specificStats.spills += _sorter->numSpills();
+            _specificStats.usedDisk = _specificStats.usedDisk || _sorter->numSpills() > 0;
+            ResourceConsumption::MetricsCollector::get(_opCtx).incrementSorterSpills(
+                _sorter->numSpills());
+            _sorter.reset();
+        }
+
         if (_optimizedClose) {
             _children[0]->close();
             _childOpened = false;
@@ -215,9 +320,106 @@ void HashAggStage::open(bool reOpen) {
     _htIt = _ht->end();
 }
 
+void HashAggStage::makeSorter() {
+    SortOptions opts;
+    opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+    opts.maxMemoryUsageBytes = internalQueryMaxBlockingSortMemoryUsageBytes.load();
+    opts.extSortAllowed = true;
+    opts.moveSortedDataIntoIterator = true;
+
+    auto collator = _collatorAccessor
+        ? value::getCollatorView(_collatorAccessor->getViewOfValue().second)
+        : nullptr;
+    const auto numKeys = _gbs.size();
+    // The trailing sequence number keeps the spilled rows of each group in input order.
+    auto comp = [collator, numKeys](const SpilledRow& lhs, const SpilledRow& rhs) {
+        if (auto result = compareGroupByKeys(lhs.first, rhs.first, numKeys, collator)) {
+            return result;
+        }
+        auto lhsSeq = value::bitcastTo<int64_t>(lhs.first.getViewOfValue(numKeys).second);
+        auto rhsSeq = value::bitcastTo<int64_t>(rhs.first.getViewOfValue(numKeys).second);
+        return lhsSeq < rhsSeq ? -1 : (lhsSeq > rhsSeq ? 1 : 0);
+    };
+
+    _sorter.reset(Sorter<value::MaterializedRow, value::MaterializedRow>::make(opts, comp, {}));
+    _spilledIt.reset();
+}
+
+void HashAggStage::spillRow() {
+    value::MaterializedRow keys{_inKeyAccessors.size() + 1};
+    value::MaterializedRow vals{_inSpilledAccessors.size()};
+
+    size_t idx = 0;
+    for (auto accessor : _inKeyAccessors) {
+        auto [tag, val] = accessor->getViewOfValue();
+        auto [cTag, cVal] = value::copyValue(tag, val);
+        keys.reset(idx++, true, cTag, cVal);
+    }
+    keys.reset(idx,
+               false,
+               value::TypeTags::NumberInt64,
+               value::bitcastFrom<int64_t>(_spilledRowsCounter++));
+
+    idx = 0;
+    for (auto accessor : _inSpilledAccessors) {
+        auto [tag, val] = accessor->getViewOfValue();
+        auto [cTag, cVal] = value::copyValue(tag, val);
+        vals.reset(idx++, true, cTag, cVal);
+    }
+
+    _sorter->emplace(std::move(keys), std::move(vals));
+    ++_specificStats.spilledRecords;
+}
+
+PlanState HashAggStage::getNextSpilledGroup() {
+    if (!_hasPendingSpilledRow) {
+        if (!_spilledIt->more()) {
+            return PlanState::IS_EOF;
+        }
+        _spilledRow = _spilledIt->next();
+    }
+
+    value::MaterializedRow key{_gbs.size()};
+    for (size_t idx = 0; idx < _gbs.size(); ++idx) {
+        auto [tag, val] = _spilledRow.first.copyOrMoveValue(idx);
+        key.reset(idx, true, tag, val);
+    }
+
+    _ht->clear();
+    auto [it, inserted] =
+        _ht->try_emplace(std::move(key), value::MaterializedRow{_outAggAccessors.size()});
+    _htIt = it;
+
+    const auto collator = _collatorAccessor
+        ? value::getCollatorView(_collatorAccessor->getViewOfValue().second)
+        : nullptr;
+    while (true) {
+        for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+            auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
+            _outAggAccessors[idx]->reset(owned, tag, val);
+        }
+
+        if (!_spilledIt->more()) {
+            _hasPendingSpilledRow = false;
+            break;
+        }
+        _spilledRow = _spilledIt->next();
+        if (compareGroupByKeys(_htIt->first, _spilledRow.first, _gbs.size(), collator) != 0) {
+            _hasPendingSpilledRow = true;
+            break;
+        }
+    }
+
+    return PlanState::ADVANCED;
+}
+
 PlanState HashAggStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
+    if (_readingSpilledRows) {
+        return trackPlanState(getNextSpilledGroup());
+    }
+
     if (_htIt == _ht->end()) {
         // First invocation of getNext() after open().
         if (!_seekKeysAccessors.empty()) {
@@ -234,6 +436,15 @@ PlanState HashAggStage::getNext() {
     }
 
     if (_htIt == _ht->end()) {
+        if (_spilledIt) {
+            // All in-memory groups have been returned, continue with the spilled ones. From now
+            // on the aggregate expressions read their inputs from the spilled rows.
+            _readingSpilledRows = true;
+            for (auto& accessor : _switchAccessors) {
+                accessor->setIndex(1);
+            }
+            return trackPlanState(getNextSpilledGroup());
+        }
         return trackPlanState(PlanState::IS_EOF);
     }
 
@@ -242,6 +453,7 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
 
     if (includeDebugInfo) {
         DebugPrinter printer;
@@ -253,6 +465,9 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
                 childrenBob.append(str::stream() << slot, printer.print(expr->debugPrint()));
             }
         }
+        bob.appendBool("usedDisk", _specificStats.usedDisk);
+        bob.appendNumber("spilledRecords", static_cast<long long>(_specificStats.spilledRecords));
+        bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
         ret->debugInfo = bob.obj();
     }
 
@@ -261,7 +476,7 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
@@ -269,6 +484,8 @@ void HashAggStage::close() {
 
     trackClose();
     _ht = boost::none;
+    _spilledIt.reset();
+    _sorter.reset();
 
     if (_childOpened) {
         _children[0]->close();
@@ -29,15 +29,17 @@
 
 #pragma once
 
-#include <unordered_map>
-
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/db/query/query_knobs_gen.h"
-#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class Sorter;
+
 namespace sbe {
 /**
  * Performs a hash-based aggregation. Appears as the "group" stage in debug output. Groups the input
@@ -60,6 +62,14 @@ namespace sbe {
  * determining whether two group-by keys are equal. For instance, the plan may require us to do a
  * case-insensitive group on a string field.
  *
+ * If the estimated size of the hash table exceeds the memory limit and 'allowDiskUse' is false,
+ * this stage throws a query-fatal exception. If 'allowDiskUse' is true, the hash table stops
+ * admitting new group-by keys: input rows whose key is already in the table keep accumulating in
+ * memory, while all other rows are spilled, together with the input slots read by the aggregate
+ * expressions, to a 'Sorter' ordered by the group-by keys. Once the in-memory groups have been
+ * returned, the spilled rows are read back in key order and aggregated one group at a time. Spilling
+ * is not supported together with 'seekKeysSlots'.
+ *
  * Debug string representation:
  *
  *  group [<group by slots>] [slot_1 = expr_1, ..., slot_n = expr_n] [<seek slots>]? reopen?
@@ -73,8 +83,11 @@ public:
                  value::SlotVector seekKeysSlots,
                  bool optimizedClose,
                  boost::optional<value::SlotId> collatorSlot,
+                 bool allowDiskUse,
                  PlanNodeId planNodeId);
 
+    ~HashAggStage();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -89,14 +102,25 @@ public:
     size_t estimateCompileTimeSize() const final;
 
 private:
-    using TableType = stdx::unordered_map<value::MaterializedRow,
-                                          value::MaterializedRow,
-                                          value::MaterializedRowHasher,
-                                          value::MaterializedRowEq>;
+    using TableType = value::MaterializedRowHashMap<value::MaterializedRow>;
 
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    // A spilled row holds the group-by keys followed by a sequence number in its key, and the
+    // values of the input slots read by the aggregate expressions in its value.
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpilledRowAccessor = value::MaterializedRowValueAccessor<SpilledRow*>;
+
+    void makeSorter();
+    void spillRow();
+
+    /**
+     * Aggregates the next run of spilled rows sharing the same group-by keys into a single entry
+     * of the (otherwise empty) hash table and positions '_htIt' on it.
+     */
+    PlanState getNextSpilledGroup();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
     const boost::optional<value::SlotId> _collatorSlot;
@@ -104,6 +128,7 @@ private:
     // When this operator does not expect to be reopened (almost always) then it can close the child
     // early.
     const bool _optimizedClose{true};
+    const bool _allowDiskUse{false};
     // Memory tracking variables.
     const long long _approxMemoryUseInBytesBeforeSpill =
         internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.load();
@@ -125,12 +150,33 @@ private:
     // Only set if collator slot provided on construction.
     value::SlotAccessor* _collatorAccessor = nullptr;
 
+    // Input slots read by the aggregate expressions. The expressions access them through the switch
+    // accessors so that they can be re-run over rows read back from the spilled data.
+    value::SlotVector _spilledSlots;
+    std::vector<value::SlotAccessor*> _inSpilledAccessors;
+    std::vector<std::unique_ptr<SpilledRowAccessor>> _outSpilledAccessors;
+    std::vector<std::unique_ptr<value::SwitchAccessor>> _switchAccessors;
+
+    std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>> _sorter;
+    std::unique_ptr<SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>>
+        _spilledIt;
+    SpilledRow _spilledRow;
+    SpilledRow* _spilledRowIt{&_spilledRow};
+    // True when '_spilledRow' holds a row that has been read from '_spilledIt' but not yet
+    // aggregated.
+    bool _hasPendingSpilledRow{false};
+    bool _readingSpilledRows{false};
+    int64_t _spilledRowsCounter{0};
+
     boost::optional<TableType> _ht;
     TableType::iterator _htIt;
 
     vm::ByteCode _bytecode;
 
+    HashAggStats _specificStats;
+
     bool _compiled{false};
+    bool _compilingAggs{false};
     bool _childOpened{false};
 };
 }  // namespace sbe
@@ -31,12 +31,78 @@
 
 #include "mongo/db/exec/sbe/stages/hash_join.h"
 
+#include <absl/hash/hash.h>
+
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashJoinFileCounter;
+    return "extsort-hash-join-sbe." + std::to_string(hashJoinFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
+namespace {
+/**
+ * Moves the values of 'lhs' followed by the values of 'rhs' into a single row.
+ */
+value::MaterializedRow concatRows(value::MaterializedRow& lhs, value::MaterializedRow& rhs) {
+    value::MaterializedRow row{lhs.size() + rhs.size()};
+    size_t idx = 0;
+    for (size_t lhsIdx = 0; lhsIdx < lhs.size(); ++lhsIdx) {
+        auto [tag, val] = lhs.copyOrMoveValue(lhsIdx);
+        row.reset(idx++, true, tag, val);
+    }
+    for (size_t rhsIdx = 0; rhsIdx < rhs.size(); ++rhsIdx) {
+        auto [tag, val] = rhs.copyOrMoveValue(rhsIdx);
+        row.reset(idx++, true, tag, val);
+    }
+    return row;
+}
+
+/**
+ * Splits 'row' into its first 'numKeys' values and the remaining ones, moving the values out.
+ */
+std::pair<value::MaterializedRow, value::MaterializedRow> splitRow(value::MaterializedRow& row,
+                                                                   size_t numKeys) {
+    value::MaterializedRow key{numKeys};
+    value::MaterializedRow project{row.size() - numKeys};
+    for (size_t idx = 0; idx < row.size(); ++idx) {
+        auto [tag, val] = row.copyOrMoveValue(idx);
+        if (idx < numKeys) {
+            key.reset(idx, true, tag, val);
+        } else {
+            project.reset(idx - numKeys, true, tag, val);
+        }
+    }
+    return {std::move(key), std::move(project)};
+}
+}  // namespace
+
+boost::optional<int64_t> HashJoinStage::SpilledSide::peekPartition() {
+    if (!peeked) {
+        if (!it->more()) {
+            return boost::none;
+        }
+        peeked = it->next();
+    }
+    return value::bitcastTo<int64_t>(peeked->first.getViewOfValue(0).second);
+}
+
+HashJoinStage::SpilledRow HashJoinStage::SpilledSide::next() {
+    invariant(peekPartition());
+    auto row = std::move(*peeked);
+    peeked = boost::none;
+    return row;
+}
 HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              std::unique_ptr<PlanStage> inner,
                              value::SlotVector outerCond,
@@ -44,6 +110,7 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              value::SlotVector innerCond,
                              value::SlotVector innerProjects,
                              boost::optional<value::SlotId> collatorSlot,
+                             bool allowDiskUse,
                              PlanNodeId planNodeId)
     : PlanStage("hj"_sd, planNodeId),
       _outerCond(std::move(outerCond)),
@@ -51,6 +118,7 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
       _innerCond(std::move(innerCond)),
       _innerProjects(std::move(innerProjects)),
       _collatorSlot(collatorSlot),
+      _allowDiskUse(allowDiskUse),
       _probeKey(0) {
     if (_outerCond.size() != _innerCond.size()) {
         uasserted(4822823, "left and right size do not match");
@@ -60,6 +128,8 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
     _children.emplace_back(std::move(inner));
 }
 
+HashJoinStage::~HashJoinStage() = default;
+
 std::unique_ptr<PlanStage> HashJoinStage::clone() const {
     return std::make_unique<HashJoinStage>(_children[0]->clone(),
                                            _children[1]->clone(),
@@ -68,6 +138,7 @@ std::unique_ptr<PlanStage> HashJoinStage::clone() const {
                                            _innerCond,
                                            _innerProjects,
                                            _collatorSlot,
+                                           _allowDiskUse,
                                            _commonStats.nodeId);
 }
 
@@ -112,6 +183,26 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         _outOuterAccessors[slot] = _outOuterProjectAccessors.back().get();
     }
 
+    if (_allowDiskUse) {
+        for (auto& slot : _innerProjects) {
+            _inInnerProjectAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+        }
+
+        // Spilled inner rows hold the condition values followed by the projected values. If a slot
+        // is listed twice, the first occurrence is the one exposed to the stages above.
+        auto innerSlots = _innerCond;
+        innerSlots.insert(innerSlots.end(), _innerProjects.begin(), _innerProjects.end());
+        for (size_t idx = 0; idx < innerSlots.size(); ++idx) {
+            _outInnerSpilledAccessors.emplace_back(
+                std::make_unique<SpilledRowAccessor>(_spilledInnerRowIt, idx));
+            _innerSwitchAccessors.emplace_back(
+                std::make_unique<value::SwitchAccessor>(std::vector<value::SlotAccessor*>{
+                    _children[1]->getAccessor(ctx, innerSlots[idx]),
+                    _outInnerSpilledAccessors.back().get()}));
+            _outInnerAccessors.emplace(innerSlots[idx], _innerSwitchAccessors.back().get());
+        }
+    }
+
     _probeKey.resize(_inInnerKeyAccessors.size());
 
     _compiled = true;
@@ -123,6 +214,10 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
             return it->second;
         }
 
+        if (auto it = _outInnerAccessors.find(slot); it != _outInnerAccessors.end()) {
+            return it->second;
+        }
+
         return _children[1]->getAccessor(ctx, slot);
     }
 
@@ -135,14 +230,21 @@ void HashJoinStage::open(bool reOpen) {
     if (_collatorAccessor) {
         auto [tag, collatorVal] = _collatorAccessor->getViewOfValue();
         uassert(5402504, "collatorSlot must be of collator type", tag == value::TypeTags::collator);
-        auto collatorView = value::getCollatorView(collatorVal);
-        const value::MaterializedRowHasher hasher(collatorView);
-        const value::MaterializedRowEq equator(collatorView);
+        _collator = value::getCollatorView(collatorVal);
+        const value::MaterializedRowHasher hasher(_collator);
+        const value::MaterializedRowEq equator(_collator);
         _ht.emplace(0, hasher, equator);
     } else {
         _ht.emplace();
     }
 
+    _htMemUsage = 0;
+    _spilledLevels.clear();
+    _readingSpilledRows = false;
+    for (auto& accessor : _innerSwitchAccessors) {
+        accessor->setIndex(0);
+    }
+
     _commonStats.opens++;
     _children[0]->open(reOpen);
     // Insert the outer side into the hash table.
@@ -164,13 +266,37 @@ void HashJoinStage::open(bool reOpen) {
             project.reset(idx++, true, tag, val);
         }
 
+        if (_outerSorter) {
+            auto partition = partitionOf(key, 0);
+            spillRow(*_outerSorter, partition, concatRows(key, project));
+            continue;
+        }
+
+        if (_allowDiskUse) {
+            _htMemUsage += key.memUsageForSorter() + project.memUsageForSorter();
+        }
         _ht->emplace(std::move(key), std::move(project));
+
+        if (_allowDiskUse && _htMemUsage >= _approxMemoryUseInBytesBeforeSpill) {
+            makeSorters();
+            spillHashTable(0);
+        }
     }
 
     _children[0]->close();
 
     _children[1]->open(reOpen);
 
+    if (_outerSorter) {
+        // The outer side did not fit in memory, so the inner side is partitioned the same way and
+        // the matching partitions of both sides are joined one at a time.
+        while (_children[1]->getNext() == PlanState::ADVANCED) {
+            spillInnerRow();
+        }
+        finishSpilling(0);
+        _readingSpilledRows = true;
+    }
+
     _htIt = _ht->end();
     _htItEnd = _ht->end();
 }
@@ -184,17 +310,28 @@ PlanState HashJoinStage::getNext() {
 
     if (_htIt == _htItEnd) {
         while (_htIt == _htItEnd) {
-            auto state = _children[1]->getNext();
-            if (state == PlanState::IS_EOF) {
-                // LEFT and OUTER joins should enumerate "non-returned" rows here.
-                return trackPlanState(state);
-            }
-
-            // Copy keys in order to do the lookup.
-            size_t idx = 0;
-            for (auto& p : _inInnerKeyAccessors) {
-                auto [tag, val] = p->getViewOfValue();
-                _probeKey.reset(idx++, false, tag, val);
+            if (_readingSpilledRows) {
+                if (!getNextSpilledInnerRow()) {
+                    return trackPlanState(PlanState::IS_EOF);
+                }
+
+                for (size_t idx = 0; idx < _probeKey.size(); ++idx) {
+                    auto [tag, val] = _spilledInnerRow.second.getViewOfValue(idx);
+                    _probeKey.reset(idx, false, tag, val);
+                }
+            } else {
+                auto state = _children[1]->getNext();
+                if (state == PlanState::IS_EOF) {
+                    // LEFT and OUTER joins should enumerate "non-returned" rows here.
+                    return trackPlanState(state);
+                }
+
+                // Copy keys in order to do the lookup.
+                size_t idx = 0;
+                for (auto& p : _inInnerKeyAccessors) {
+                    auto [tag, val] = p->getViewOfValue();
+                    _probeKey.reset(idx++, false, tag, val);
+                }
             }
 
             auto [low, hi] = _ht->equal_range(_probeKey);
@@ -214,17 +351,192 @@ void HashJoinStage::close() {
     trackClose();
     _children[1]->close();
     _ht = boost::none;
+    _outerSorter.reset();
+    _innerSorter.reset();
+    _spilledLevels.clear();
+    _readingSpilledRows = false;
+}
+
+int64_t HashJoinStage::partitionOf(const value::MaterializedRow& row, size_t depth) const {
+    // Only the condition values, which come first in both the hash table keys and the spilled
+    // rows, are hashed. Mixing in the depth gives each level of partitions its own hash function.
+    size_t hash = value::hashInit();
+    for (size_t idx = 0; idx < _outerCond.size(); ++idx) {
+        auto [tag, val] = row.getViewOfValue(idx);
+        hash = value::hashCombine(hash, value::hashValue(tag, val, _collator));
+    }
+    return absl::Hash<std::pair<size_t, size_t>>{}(std::make_pair(hash, depth)) %
+        kNumSpillPartitions;
+}
+
+void HashJoinStage::makeSorters() {
+    SortOptions opts;
+    opts.tempDir = storageGlobalParams.dbpath + "/_tmp";
+    opts.maxMemoryUsageBytes = internalQueryMaxBlockingSortMemoryUsageBytes.load();
+    opts.extSortAllowed = true;
+    opts.moveSortedDataIntoIterator = true;
+
+    // Rows are only ordered by partition; the order within a partition does not matter.
+    auto comp = [](const SpilledRow& lhs, const SpilledRow& rhs) {
+        auto lhsPartition = value::bitcastTo<int64_t>(lhs.first.getViewOfValue(0).second);
+        auto rhsPartition = value::bitcastTo<int64_t>(rhs.first.getViewOfValue(0).second);
+        return lhsPartition < rhsPartition ? -1 : (lhsPartition > rhsPartition ? 1 : 0);
+    };
+
+    _outerSorter.reset(SpillSorter::make(opts, comp, {}));
+    _innerSorter.reset(SpillSorter::make(opts, comp, {}));
+}
+
+void HashJoinStage::spillRow(SpillSorter& sorter, int64_t partition, value::MaterializedRow row) {
+    value::MaterializedRow key{1};
+    key.reset(0, false, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(partition));
+    sorter.emplace(std::move(key), std::move(row));
+    ++_specificStats.spilledRecords;
+}
+
+void HashJoinStage::spillHashTable(size_t depth) {
+    while (!_ht->empty()) {
+        auto node = _ht->extract(_ht->begin());
+        auto row = concatRows(node.key(), node.mapped());
+        auto partition = partitionOf(row, depth);
+        spillRow(*_outerSorter, partition, std::move(row));
+    }
+    _htMemUsage = 0;
+}
+
+void HashJoinStage::spillInnerRow() {
+    value::MaterializedRow row{_inInnerKeyAccessors.size() + _inInnerProjectAccessors.size()};
+
+    size_t idx = 0;
+    for (auto accessor : _inInnerKeyAccessors) {
+        auto [tag, val] = accessor->getViewOfValue();
+        auto [cTag, cVal] = value::copyValue(tag, val);
+        row.reset(idx++, true, cTag, cVal);
+    }
+    for (auto accessor : _inInnerProjectAccessors) {
+        auto [tag, val] = accessor->getViewOfValue();
+        auto [cTag, cVal] = value::copyValue(tag, val);
+        row.reset(idx++, true, cTag, cVal);
+    }
+
+    auto partition = partitionOf(row, 0);
+    spillRow(*_innerSorter, partition, std::move(row));
+}
+
+void HashJoinStage::finishSpilling(size_t depth) {
+    SpilledLevel level;
+    level.outer.it.reset(_outerSorter->done());
+    level.inner.it.reset(_innerSorter->done());
+    level.depth = depth;
+
+    auto numSpills = _outerSorter->numSpills() + _innerSorter->numSpills();
+    _specificStats.spills += numSpills;
+    _specificStats.usedDisk = _specificStats.usedDisk || numSpills > 0;
+    ResourceConsumption::MetricsCollector::get(_opCtx).incrementSorterSpills(numSpills);
+
+    _outerSorter.reset();
+    _innerSorter.reset();
+    _spilledLevels.push_back(std::move(level));
+
+    for (auto& accessor : _innerSwitchAccessors) {
+        accessor->setIndex(1);
+    }
+}
+
+bool HashJoinStage::loadNextPartition() {
+    auto& level = _spilledLevels.back();
+    auto partition = level.outer.peekPartition();
+    if (!partition) {
+        // Any inner rows left over belong to partitions without outer rows and cannot match.
+        return false;
+    }
+
+    for (auto innerPartition = level.inner.peekPartition();
+         innerPartition && *innerPartition < *partition;
+         innerPartition = level.inner.peekPartition()) {
+        level.inner.next();
+    }
+
+    _ht->clear();
+    _htMemUsage = 0;
+    while (level.outer.peekPartition() == partition) {
+        auto row = level.outer.next();
+        auto [key, project] = splitRow(row.second, _outerCond.size());
+        _htMemUsage += key.memUsageForSorter() + project.memUsageForSorter();
+        _ht->emplace(std::move(key), std::move(project));
+
+        if (_htMemUsage >= _approxMemoryUseInBytesBeforeSpill &&
+            level.depth + 1 < kMaxSpillDepth) {
+            repartition(*partition);
+            return true;
+        }
+    }
+
+    level.loadedPartition = partition;
+    return true;
+}
+
+void HashJoinStage::repartition(int64_t partition) {
+    auto& level = _spilledLevels.back();
+    const auto depth = level.depth + 1;
+
+    makeSorters();
+    spillHashTable(depth);
+    while (level.outer.peekPartition() == partition) {
+        auto row = std::move(level.outer.next().second);
+        auto rowPartition = partitionOf(row, depth);
+        spillRow(*_outerSorter, rowPartition, std::move(row));
+    }
+    while (level.inner.peekPartition() == partition) {
+        auto row = std::move(level.inner.next().second);
+        auto rowPartition = partitionOf(row, depth);
+        spillRow(*_innerSorter, rowPartition, std::move(row));
+    }
+
+    ++_specificStats.repartitions;
+    finishSpilling(depth);
+}
+
+bool HashJoinStage::getNextSpilledInnerRow() {
+    while (!_spilledLevels.empty()) {
+        auto& level = _spilledLevels.back();
+        if (level.loadedPartition) {
+            if (level.inner.peekPartition() == level.loadedPartition) {
+                _spilledInnerRow = level.inner.next();
+                return true;
+            }
+            level.loadedPartition = boost::none;
+        }
+
+        // Loading a partition may push a new level, so 'level' must not be used past this point.
+        if (!loadNextPartition()) {
+            _spilledLevels.pop_back();
+        }
+    }
+
+    return false;
 }
 
 std::unique_ptr<PlanStageStats> HashJoinStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashJoinStats>(_specificStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendBool("usedDisk", _specificStats.usedDisk);
+        bob.appendNumber("spilledRecords", static_cast<long long>(_specificStats.spilledRecords));
+        bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+        bob.appendNumber("repartitions", static_cast<long long>(_specificStats.repartitions));
+        ret->debugInfo = bob.obj();
+    }
+
     ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
     ret->children.emplace_back(_children[1]->getStats(includeDebugInfo));
     return ret;
 }
 
 const SpecificStats* HashJoinStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> HashJoinStage::debugPrint() const {
@@ -33,8 +33,15 @@
 
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
-namespace mongo::sbe {
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class Sorter;
+
+namespace sbe {
 /**
  * Performs a traditional hash join. All rows from the 'outer' side are used to construct a hash
  * table. Keys from the 'inner' side are used to probe the hash table and produce output rows.  This
@@ -51,6 +58,15 @@ namespace mongo::sbe {
  * for string equality. For example, this can be used to perform a case-insensitive join on string
  * values.
  *
+ * If 'allowDiskUse' is true and the estimated size of the hash table exceeds the memory limit, the
+ * stage falls back to a grace hash join: the rows of both sides are hash partitioned on their join
+ * keys and spilled to a 'Sorter' ordered by partition, after which the partitions are joined one at
+ * a time. A partition whose outer rows still do not fit in memory is re-partitioned with a
+ * different hash seed, up to 'kMaxSpillDepth' levels deep; beyond that (for instance when most
+ * rows share one key) the partition is joined in memory regardless of its size. Once the join has
+ * spilled, only the 'innerCond' and 'innerProjects' slots of the inner side are visible to stages
+ * higher in the tree.
+ *
  * Debug string representation:
  *
  *   hj collatorSlot?
@@ -66,8 +82,11 @@ public:
                   value::SlotVector innerCond,
                   value::SlotVector innerProjects,
                   boost::optional<value::SlotId> collatorSlot,
+                  bool allowDiskUse,
                   PlanNodeId planNodeId);
 
+    ~HashJoinStage();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -90,11 +109,75 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashProjectAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    // A spilled row holds its partition number in the key, and the condition values followed by
+    // the projected values of one side of the join in the value.
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpilledRowAccessor = value::MaterializedRowValueAccessor<SpilledRow*>;
+    using SpillSorter = Sorter<value::MaterializedRow, value::MaterializedRow>;
+    using SpillIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
+    static constexpr int64_t kNumSpillPartitions = 16;
+    static constexpr size_t kMaxSpillDepth = 4;
+
+    /**
+     * The spilled rows of one side of the join, read back in partition order.
+     */
+    struct SpilledSide {
+        /**
+         * Returns the partition of the next row, or boost::none once all rows have been read.
+         */
+        boost::optional<int64_t> peekPartition();
+        SpilledRow next();
+
+        std::unique_ptr<SpillIterator> it;
+        boost::optional<SpilledRow> peeked;
+    };
+
+    /**
+     * Both sides of the join partitioned with the hash seed 'depth'. Deeper levels hold a single
+     * partition of the level below them which did not fit in memory.
+     */
+    struct SpilledLevel {
+        SpilledSide outer;
+        SpilledSide inner;
+        size_t depth{0};
+        // The partition whose outer rows are currently loaded into the hash table, if any.
+        boost::optional<int64_t> loadedPartition;
+    };
+
+    int64_t partitionOf(const value::MaterializedRow& row, size_t depth) const;
+    void makeSorters();
+    void spillRow(SpillSorter& sorter, int64_t partition, value::MaterializedRow row);
+    void spillHashTable(size_t depth);
+    void spillInnerRow();
+
+    /**
+     * Hands the spilled rows over to a new level of partitions at the given depth.
+     */
+    void finishSpilling(size_t depth);
+
+    /**
+     * Loads the outer rows of the next partition of the deepest level into the hash table, or
+     * re-partitions them into a new level if they do not fit in memory. Returns false if the level
+     * has no partitions left.
+     */
+    bool loadNextPartition();
+    void repartition(int64_t partition);
+
+    /**
+     * Reads the next spilled inner row into '_spilledInnerRow', loading partitions as needed.
+     * Returns false once all partitions have been joined.
+     */
+    bool getNextSpilledInnerRow();
+
     const value::SlotVector _outerCond;
     const value::SlotVector _outerProjects;
     const value::SlotVector _innerCond;
     const value::SlotVector _innerProjects;
     const boost::optional<value::SlotId> _collatorSlot;
+    const bool _allowDiskUse{false};
+    const long long _approxMemoryUseInBytesBeforeSpill =
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
 
     // All defined values from the outer side (i.e. they come from the hash table).
     value::SlotAccessorMap _outOuterAccessors;
@@ -114,8 +197,18 @@ private:
     // Accessors of input condition values (keys) that are being inserted into the hash table.
     std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
 
+    // Accessors of input projection values from the inner side. Only used for spilling.
+    std::vector<value::SlotAccessor*> _inInnerProjectAccessors;
+
+    // Inner condition and projection slots, switching between the inner child and the spilled
+    // inner rows. Only set if disk use is allowed.
+    value::SlotAccessorMap _outInnerAccessors;
+    std::vector<std::unique_ptr<SpilledRowAccessor>> _outInnerSpilledAccessors;
+    std::vector<std::unique_ptr<value::SwitchAccessor>> _innerSwitchAccessors;
+
     // Accessor for collator. Only set if collatorSlot provided during construction.
     value::SlotAccessor* _collatorAccessor = nullptr;
+    CollatorInterface* _collator = nullptr;
 
     // Key used to probe inside the hash table.
     value::MaterializedRow _probeKey;
@@ -124,8 +217,21 @@ private:
     TableType::iterator _htIt;
     TableType::iterator _htItEnd;
 
+    // Approximate size of the rows in the hash table. Only tracked if disk use is allowed.
+    long long _htMemUsage{0};
+
+    std::unique_ptr<SpillSorter> _outerSorter;
+    std::unique_ptr<SpillSorter> _innerSorter;
+    std::vector<SpilledLevel> _spilledLevels;
+    SpilledRow _spilledInnerRow;
+    SpilledRow* _spilledInnerRowIt{&_spilledInnerRow};
+    bool _readingSpilledRows{false};
+
     vm::ByteCode _bytecode;
 
+    HashJoinStats _specificStats;
+
     bool _compiled{false};
 };
-}  // namespace mongo::sbe
+}  // namespace sbe
+}  // namespace mongo
@@ -60,6 +60,11 @@ struct CommonStats {
     // cache.
     boost::optional<long long> executionTimeMillis;
 
+    // CPU time used by the thread while working inside this stage, in microseconds. Only collected
+    // along with 'executionTimeMillis', and only when internalQueryCollectExecutionCpuTime is set,
+    // since reading the CPU clock of the thread is much more costly than the fast clock source.
+    boost::optional<long long> executionCpuTimeMicros;
+
     size_t advances{0};
     size_t opens{0};
     size_t closes{0};
@@ -183,6 +188,44 @@ struct LoopJoinStats final : public SpecificStats {
     size_t innerCloses{0};
 };
 
+struct HashAggStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashAggStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& summary) const final {
+        summary.usedDisk = summary.usedDisk || usedDisk;
+    }
+
+    bool usedDisk{false};
+    size_t spilledRecords{0};
+    size_t spills{0};
+};
+
+struct HashJoinStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashJoinStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& summary) const final {
+        summary.usedDisk = summary.usedDisk || usedDisk;
+    }
+
+    bool usedDisk{false};
+    size_t spilledRecords{0};
+    size_t spills{0};
+    // Number of partitions that did not fit in memory and were split up further.
+    size_t repartitions{0};
+};
+
 struct TraverseStats : public SpecificStats {
     std::unique_ptr<SpecificStats> clone() const final {
         return std::make_unique<TraverseStats>(*this);
@@ -36,6 +36,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/plan_yield_policy.h"
 #include "mongo/util/str.h"
 
@@ -243,6 +244,9 @@ public:
     void markShouldCollectTimingInfo() {
         invariant(!_commonStats.executionTimeMillis || *_commonStats.executionTimeMillis == 0);
         _commonStats.executionTimeMillis.emplace(0);
+        if (internalQueryCollectExecutionCpuTime.load() && ScopedTimer::canMeasureCPUTime()) {
+            _commonStats.executionCpuTimeMicros.emplace(0);
+        }
 
         auto stage = static_cast<T*>(this);
         for (auto&& child : stage->_children) {
@@ -290,7 +294,8 @@ protected:
     boost::optional<ScopedTimer> getOptTimer(OperationContext* opCtx) {
         if (_commonStats.executionTimeMillis && opCtx) {
             return {{opCtx->getServiceContext()->getFastClockSource(),
-                     _commonStats.executionTimeMillis.get_ptr()}};
+                     _commonStats.executionTimeMillis.get_ptr(),
+                     _commonStats.executionCpuTimeMicros.get_ptr()}};
         }
 
         return boost::none;
@@ -74,10 +74,7 @@ private:
     std::vector<value::SlotAccessor*> _inKeyAccessors;
 
     // Table of keys that have been seen.
-    stdx::unordered_set<value::MaterializedRow,
-                        value::MaterializedRowHasher,
-                        value::MaterializedRowEq>
-        _seen;
+    value::MaterializedRowHashSet _seen;
     UniqueStats _specificStats;
 };
 }  // namespace mongo::sbe
@@ -32,6 +32,7 @@
 #include <type_traits>
 
 #include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/stdx/trusted_hasher.h"
 #include "mongo/util/id_generator.h"
 
 namespace mongo {
@@ -658,6 +659,19 @@ using SlotAccessorMap = SlotMap<SlotAccessor*>;
 using FieldAccessorMap = StringMap<std::unique_ptr<OwnedValueAccessor>>;
 using FieldViewAccessorMap = StringMap<std::unique_ptr<ViewOfValueAccessor>>;
 using SlotSet = absl::flat_hash_set<SlotId>;
+
+/**
+ * Hash tables keyed by materialized rows. These are open-addressing tables which store the rows
+ * inline and probe a group of control bytes at a time, so unlike node-based tables they do not
+ * allocate per entry and rarely compare rows whose hashes differ. Iterators and references are
+ * invalidated by insertions.
+ */
+using MaterializedRowTableHasher = EnsureTrustedHasher<MaterializedRowHasher, MaterializedRow>;
+template <typename T>
+using MaterializedRowHashMap =
+    absl::flat_hash_map<MaterializedRow, T, MaterializedRowTableHasher, MaterializedRowEq>;
+using MaterializedRowHashSet =
+    absl::flat_hash_set<MaterializedRow, MaterializedRowTableHasher, MaterializedRowEq>;
 using SlotVector = absl::InlinedVector<SlotId, 2>;
 
 using SlotIdGenerator = IdGenerator<value::SlotId, SlotVector>;
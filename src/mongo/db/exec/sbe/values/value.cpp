@@ -145,13 +145,12 @@ std::pair<TypeTags, Value> makeCopyPcreRegex(const PcreRegex& regex) {
 void PcreRegex::_compile() {
     const auto pcreOptions = regex_util::flagsToPcreOptions(_options.c_str()).all_options();
     const char* compile_error;
-    int eoffset;
-    _pcrePtr = pcre_compile(_pattern.c_str(), pcreOptions, &compile_error, &eoffset, nullptr);
+    _pcrePtr = regex_util::compilePattern(_pattern, pcreOptions, &compile_error);
     uassert(5073402, str::stream() << "Invalid Regex: " << compile_error, _pcrePtr != nullptr);
 }
 
 int PcreRegex::execute(StringData stringView, int startPos, std::vector<int>& buf) {
-    return pcre_exec(_pcrePtr,
+    return pcre_exec(_pcrePtr.get(),
                      nullptr,
                      stringView.rawData(),
                      stringView.size(),
@@ -163,7 +162,7 @@ int PcreRegex::execute(StringData stringView, int startPos, std::vector<int>& bu
 
 size_t PcreRegex::getNumberCaptures() const {
     int numCaptures;
-    pcre_fullinfo(_pcrePtr, nullptr, PCRE_INFO_CAPTURECOUNT, &numCaptures);
+    pcre_fullinfo(_pcrePtr.get(), nullptr, PCRE_INFO_CAPTURECOUNT, &numCaptures);
     invariant(numCaptures >= 0);
     return static_cast<size_t>(numCaptures);
 }
@@ -35,6 +35,7 @@
 #include <bitset>
 #include <boost/predef/hardware/simd.h>
 #include <cstdint>
+#include <memory>
 #include <ostream>
 #include <pcre.h>
 #include <string>
@@ -845,9 +846,8 @@ bool operator!=(const ArraySet& lhs, const ArraySet& rhs);
 
 /**
  * Implements a wrapper of PCRE regular expression.
- * Storing the pattern and the options allows for copying of the sbe::value::PcreRegex expression,
- * which includes recompilation.
- * The compiled expression pcre* allows for direct usage of the pcre C library functionality.
+ * The compiled expression pcre* allows for direct usage of the pcre C library functionality. It is
+ * immutable once compiled, so copies of the sbe::value::PcreRegex expression share it.
  */
 class PcreRegex {
 public:
@@ -855,22 +855,6 @@ public:
         _compile();
     }
 
-    PcreRegex(const PcreRegex& other) : PcreRegex(other._pattern, other._options) {}
-
-    PcreRegex& operator=(const PcreRegex& other) {
-        if (this != &other) {
-            (*pcre_free)(_pcrePtr);
-            _pattern = other._pattern;
-            _options = other._options;
-            _compile();
-        }
-        return *this;
-    }
-
-    ~PcreRegex() {
-        (*pcre_free)(_pcrePtr);
-    }
-
     const std::string& pattern() const {
         return _pattern;
     }
@@ -900,7 +884,7 @@ private:
     std::string _pattern;
     std::string _options;
 
-    pcre* _pcrePtr = nullptr;
+    std::shared_ptr<const pcre> _pcrePtr;
 };
 
 constexpr size_t kSmallStringMaxLength = 7;
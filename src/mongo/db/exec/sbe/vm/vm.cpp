@@ -103,6 +103,7 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
 
     -1,  // fillEmpty
     -1,  // getField
+    0,   // getFieldImm
     -1,  // getElement
     -1,  // collComparisonKey
     -1,  // getFieldOrElement
@@ -346,6 +347,21 @@ void CodeFragment::appendGetField() {
     appendSimpleInstruction(Instruction::getField);
 }
 
+void CodeFragment::appendGetField(StringData fieldName) {
+    Instruction i;
+    i.tag = Instruction::getFieldImm;
+    adjustStackSimple(i);
+
+    invariant(fieldName.size() <= std::numeric_limits<uint8_t>::max());
+    auto size = static_cast<uint8_t>(fieldName.size());
+
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(size) + size);
+
+    offset += writeToMemory(offset, i);
+    offset += writeToMemory(offset, size);
+    std::copy(fieldName.rawData(), fieldName.rawData() + size, offset);
+}
+
 void CodeFragment::appendGetElement() {
     appendSimpleInstruction(Instruction::getElement);
 }
@@ -524,8 +540,12 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTa
         return {false, value::TypeTags::Nothing, 0};
     }
 
-    auto fieldStr = value::getStringView(fieldTag, fieldValue);
+    return getField(objTag, objValue, value::getStringView(fieldTag, fieldValue));
+}
 
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTags objTag,
+                                                                   value::Value objValue,
+                                                                   StringData fieldStr) {
     if (MONGO_unlikely(failOnPoisonedFieldLookup.shouldFail())) {
         uassert(4623399, "Lookup of $POISON", fieldStr != "POISON");
     }
@@ -3821,18 +3841,120 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::runLambdaInternal(
     return {retOwn, retTag, retVal};
 }
 
+#if defined(__GNUC__)
+// Use labels-as-values to thread the interpreter dispatch when the compiler supports it.
+#define MONGO_SBE_VM_THREADED_DISPATCH
+#define SBE_VM_INSTRUCTION(name) \
+    case Instruction::name:      \
+    label_##name:
+#define SBE_VM_DISPATCH_NEXT()                      \
+    if (pcPointer == pcEnd) {                       \
+        return;                                     \
+    }                                               \
+    i = readFromMemory<Instruction>(pcPointer);     \
+    pcPointer += sizeof(i);                         \
+    goto* kDispatchTable[i.tag]
+#else
+#define SBE_VM_INSTRUCTION(name) case Instruction::name:
+#define SBE_VM_DISPATCH_NEXT() break
+#endif
+
 void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
     auto pcPointer = code->instrs().data() + position;
     auto pcEnd = pcPointer + code->instrs().size();
+    Instruction i;
+
+#ifdef MONGO_SBE_VM_THREADED_DISPATCH
+    // Handler addresses indexed by Instruction::Tags. Each handler decodes the following
+    // instruction and jumps straight to its handler, so the hardware gets a separate indirect
+    // branch per instruction to predict instead of the single shared one at the top of the switch.
+    static void* const kDispatchTable[] = {
+        &&label_pushConstVal,
+        &&label_pushAccessVal,
+        &&label_pushMoveVal,
+        &&label_pushLocalVal,
+        &&label_pushMoveLocalVal,
+        &&label_pushLocalLambda,
+        &&label_pop,
+        &&label_swap,
+        &&label_add,
+        &&label_sub,
+        &&label_mul,
+        &&label_div,
+        &&label_idiv,
+        &&label_mod,
+        &&label_negate,
+        &&label_numConvert,
+        &&label_logicNot,
+        &&label_less,
+        &&label_lessEq,
+        &&label_greater,
+        &&label_greaterEq,
+        &&label_eq,
+        &&label_neq,
+        &&label_cmp3w,
+        &&label_collLess,
+        &&label_collLessEq,
+        &&label_collGreater,
+        &&label_collGreaterEq,
+        &&label_collEq,
+        &&label_collNeq,
+        &&label_collCmp3w,
+        &&label_fillEmpty,
+        &&label_getField,
+        &&label_getFieldImm,
+        &&label_getElement,
+        &&label_collComparisonKey,
+        &&label_getFieldOrElement,
+        &&label_traverseP,
+        &&label_traverseF,
+        &&label_setField,
+        &&label_getArraySize,
+        &&label_aggSum,
+        &&label_aggDoubleDoubleSum,
+        &&label_doubleDoubleSumFinalize,
+        &&label_aggMin,
+        &&label_aggMax,
+        &&label_aggFirst,
+        &&label_aggLast,
+        &&label_aggCollMin,
+        &&label_aggCollMax,
+        &&label_exists,
+        &&label_isNull,
+        &&label_isObject,
+        &&label_isArray,
+        &&label_isString,
+        &&label_isNumber,
+        &&label_isBinData,
+        &&label_isDate,
+        &&label_isNaN,
+        &&label_isInfinity,
+        &&label_isRecordId,
+        &&label_isMinKey,
+        &&label_isMaxKey,
+        &&label_isTimestamp,
+        &&label_typeMatch,
+        &&label_function,
+        &&label_functionSmall,
+        &&label_jmp,
+        &&label_jmpTrue,
+        &&label_jmpNothing,
+        &&label_ret,
+        &&label_fail,
+    };
+    static_assert(sizeof(kDispatchTable) / sizeof(kDispatchTable[0]) ==
+                      Instruction::Tags::lastInstruction,
+                  "kDispatchTable must be kept in sync with Instruction::Tags");
+#endif
 
     for (;;) {
         if (pcPointer == pcEnd) {
             break;
         } else {
-            Instruction i = readFromMemory<Instruction>(pcPointer);
+            i = readFromMemory<Instruction>(pcPointer);
             pcPointer += sizeof(i);
             switch (i.tag) {
-                case Instruction::pushConstVal: {
+                SBE_VM_INSTRUCTION(pushConstVal) {
                     auto tag = readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
                     auto val = readFromMemory<value::Value>(pcPointer);
@@ -3840,27 +3962,27 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
 
                     pushStack(false, tag, val);
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::pushAccessVal: {
+                SBE_VM_INSTRUCTION(pushAccessVal) {
                     auto accessor = readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->getViewOfValue();
                     pushStack(false, tag, val);
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::pushMoveVal: {
+                SBE_VM_INSTRUCTION(pushMoveVal) {
                     auto accessor = readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->copyOrMoveValue();
                     pushStack(true, tag, val);
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::pushLocalVal: {
+                SBE_VM_INSTRUCTION(pushLocalVal) {
                     auto stackOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(stackOffset);
 
@@ -3868,9 +3990,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
 
                     pushStack(false, tag, val);
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::pushMoveLocalVal: {
+                SBE_VM_INSTRUCTION(pushMoveLocalVal) {
                     auto stackOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(stackOffset);
 
@@ -3879,9 +4001,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
 
                     pushStack(owned, tag, val);
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::pushLocalLambda: {
+                SBE_VM_INSTRUCTION(pushLocalLambda) {
                     auto offset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(offset);
                     auto newPosition = pcPointer - code->instrs().data() + offset;
@@ -3889,9 +4011,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     pushStack(false,
                               value::TypeTags::LocalLambda,
                               value::bitcastFrom<int64_t>(newPosition));
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::pop: {
+                SBE_VM_INSTRUCTION(pop) {
                     auto [owned, tag, val] = getFromStack(0);
                     popStack();
 
@@ -3899,13 +4021,13 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                         value::releaseValue(tag, val);
                     }
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::swap: {
+                SBE_VM_INSTRUCTION(swap) {
                     swapStack();
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::add: {
+                SBE_VM_INSTRUCTION(add) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3920,9 +4042,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::sub: {
+                SBE_VM_INSTRUCTION(sub) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3937,9 +4059,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::mul: {
+                SBE_VM_INSTRUCTION(mul) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3954,9 +4076,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::div: {
+                SBE_VM_INSTRUCTION(div) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3971,9 +4093,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::idiv: {
+                SBE_VM_INSTRUCTION(idiv) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -3988,9 +4110,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::mod: {
+                SBE_VM_INSTRUCTION(mod) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4005,9 +4127,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::negate: {
+                SBE_VM_INSTRUCTION(negate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] = genericSub(
@@ -4019,9 +4141,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                         value::releaseValue(resultTag, resultVal);
                     }
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::numConvert: {
+                SBE_VM_INSTRUCTION(numConvert) {
                     auto tag = readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
 
@@ -4035,9 +4157,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::logicNot: {
+                SBE_VM_INSTRUCTION(logicNot) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultTag, resultVal] = genericNot(tag, val);
@@ -4047,9 +4169,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::less: {
+                SBE_VM_INSTRUCTION(less) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4064,9 +4186,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::collLess: {
+                SBE_VM_INSTRUCTION(collLess) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4087,9 +4209,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::lessEq: {
+                SBE_VM_INSTRUCTION(lessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4105,9 +4227,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::collLessEq: {
+                SBE_VM_INSTRUCTION(collLessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4128,9 +4250,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::greater: {
+                SBE_VM_INSTRUCTION(greater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4146,9 +4268,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::collGreater: {
+                SBE_VM_INSTRUCTION(collGreater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4169,9 +4291,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::greaterEq: {
+                SBE_VM_INSTRUCTION(greaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4187,9 +4309,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::collGreaterEq: {
+                SBE_VM_INSTRUCTION(collGreaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4210,9 +4332,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::eq: {
+                SBE_VM_INSTRUCTION(eq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4228,9 +4350,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::collEq: {
+                SBE_VM_INSTRUCTION(collEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4251,9 +4373,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::neq: {
+                SBE_VM_INSTRUCTION(neq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4270,9 +4392,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::collNeq: {
+                SBE_VM_INSTRUCTION(collNeq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4294,9 +4416,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::cmp3w: {
+                SBE_VM_INSTRUCTION(cmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4311,9 +4433,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::collCmp3w: {
+                SBE_VM_INSTRUCTION(collCmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4333,9 +4455,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::fillEmpty: {
+                SBE_VM_INSTRUCTION(fillEmpty) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4351,9 +4473,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                             value::releaseValue(rhsTag, rhsVal);
                         }
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::getField: {
+                SBE_VM_INSTRUCTION(getField) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4368,9 +4490,26 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::getElement: {
+                SBE_VM_INSTRUCTION(getFieldImm) {
+                    auto size = readFromMemory<uint8_t>(pcPointer);
+                    pcPointer += sizeof(size);
+                    StringData fieldName(reinterpret_cast<const char*>(pcPointer), size);
+                    pcPointer += size;
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(lhsTag, lhsVal, fieldName);
+
+                    topStack(owned, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    SBE_VM_DISPATCH_NEXT();
+                }
+                SBE_VM_INSTRUCTION(getElement) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4385,9 +4524,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::getArraySize: {
+                SBE_VM_INSTRUCTION(getArraySize) {
                     auto [owned, tag, val] = getFromStack(0);
                     auto [resultOwned, resultTag, resultVal] = getArraySize(tag, val);
                     topStack(resultOwned, resultTag, resultVal);
@@ -4395,9 +4534,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::collComparisonKey: {
+                SBE_VM_INSTRUCTION(collComparisonKey) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4425,9 +4564,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::getFieldOrElement: {
+                SBE_VM_INSTRUCTION(getFieldOrElement) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4442,36 +4581,36 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::traverseP: {
+                SBE_VM_INSTRUCTION(traverseP) {
                     auto [owned, tag, val] = traverseP(code);
                     for (uint8_t cnt = 0; cnt < 2; ++cnt) {
                         popAndReleaseStack();
                     }
 
                     pushStack(owned, tag, val);
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::traverseF: {
+                SBE_VM_INSTRUCTION(traverseF) {
                     auto [owned, tag, val] = traverseF(code);
                     for (uint8_t cnt = 0; cnt < 3; ++cnt) {
                         popAndReleaseStack();
                     }
 
                     pushStack(owned, tag, val);
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::setField: {
+                SBE_VM_INSTRUCTION(setField) {
                     auto [owned, tag, val] = setField();
                     popAndReleaseStack();
                     popAndReleaseStack();
                     popAndReleaseStack();
 
                     pushStack(owned, tag, val);
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::aggSum: {
+                SBE_VM_INSTRUCTION(aggSum) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4486,9 +4625,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::aggDoubleDoubleSum: {
+                SBE_VM_INSTRUCTION(aggDoubleDoubleSum) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4503,9 +4642,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::doubleDoubleSumFinalize: {
+                SBE_VM_INSTRUCTION(doubleDoubleSumFinalize) {
                     auto [sumArrayOwned, sumArrayTag, sumArrayVal] = getFromStack(0);
                     auto [finalSumOwned, finalSumTag, finalSumVal] =
                         doubleDoubleSumFinalize(sumArrayTag, sumArrayVal);
@@ -4515,9 +4654,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (sumArrayOwned) {
                         value::releaseValue(sumArrayTag, sumArrayVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::aggMin: {
+                SBE_VM_INSTRUCTION(aggMin) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4532,9 +4671,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::aggCollMin: {
+                SBE_VM_INSTRUCTION(aggCollMin) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [collOwned, collTag, collVal] = getFromStack(0);
@@ -4555,9 +4694,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::aggMax: {
+                SBE_VM_INSTRUCTION(aggMax) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4572,9 +4711,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::aggCollMax: {
+                SBE_VM_INSTRUCTION(aggCollMax) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [collOwned, collTag, collVal] = getFromStack(0);
@@ -4595,9 +4734,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::aggFirst: {
+                SBE_VM_INSTRUCTION(aggFirst) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4612,9 +4751,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::aggLast: {
+                SBE_VM_INSTRUCTION(aggLast) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4629,9 +4768,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::exists: {
+                SBE_VM_INSTRUCTION(exists) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     topStack(false,
@@ -4641,9 +4780,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isNull: {
+                SBE_VM_INSTRUCTION(isNull) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4655,9 +4794,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isObject: {
+                SBE_VM_INSTRUCTION(isObject) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4669,9 +4808,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isArray: {
+                SBE_VM_INSTRUCTION(isArray) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4683,9 +4822,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isString: {
+                SBE_VM_INSTRUCTION(isString) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4697,9 +4836,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isNumber: {
+                SBE_VM_INSTRUCTION(isNumber) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4711,9 +4850,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isBinData: {
+                SBE_VM_INSTRUCTION(isBinData) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4725,9 +4864,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isDate: {
+                SBE_VM_INSTRUCTION(isDate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4739,9 +4878,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isNaN: {
+                SBE_VM_INSTRUCTION(isNaN) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4753,9 +4892,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isInfinity: {
+                SBE_VM_INSTRUCTION(isInfinity) {
                     auto [owned, tag, val] = getFromStack(0);
                     if (tag != value::TypeTags::Nothing) {
                         topStack(false,
@@ -4765,9 +4904,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isRecordId: {
+                SBE_VM_INSTRUCTION(isRecordId) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4779,9 +4918,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isMinKey: {
+                SBE_VM_INSTRUCTION(isMinKey) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4793,9 +4932,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isMaxKey: {
+                SBE_VM_INSTRUCTION(isMaxKey) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4807,9 +4946,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::isTimestamp: {
+                SBE_VM_INSTRUCTION(isTimestamp) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -4821,9 +4960,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::typeMatch: {
+                SBE_VM_INSTRUCTION(typeMatch) {
                     auto typeMask = readFromMemory<uint32_t>(pcPointer);
                     pcPointer += sizeof(typeMask);
 
@@ -4838,10 +4977,10 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::function:
-                case Instruction::functionSmall: {
+                SBE_VM_INSTRUCTION(function)
+                SBE_VM_INSTRUCTION(functionSmall) {
                     auto f = readFromMemory<Builtin>(pcPointer);
                     pcPointer += sizeof(f);
                     ArityType arity{0};
@@ -4861,16 +5000,16 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
 
                     pushStack(owned, tag, val);
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::jmp: {
+                SBE_VM_INSTRUCTION(jmp) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
                     pcPointer += jumpOffset;
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::jmpTrue: {
+                SBE_VM_INSTRUCTION(jmpTrue) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -4884,9 +5023,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::jmpNothing: {
+                SBE_VM_INSTRUCTION(jmpNothing) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -4894,13 +5033,13 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (tag == value::TypeTags::Nothing) {
                         pcPointer += jumpOffset;
                     }
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::ret: {
+                SBE_VM_INSTRUCTION(ret) {
                     pcPointer = pcEnd;
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
-                case Instruction::fail: {
+                SBE_VM_INSTRUCTION(fail) {
                     auto [ownedCode, tagCode, valCode] = getFromStack(1);
                     invariant(tagCode == value::TypeTags::NumberInt64);
 
@@ -4913,7 +5052,7 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
 
                     uasserted(code, message);
 
-                    break;
+                    SBE_VM_DISPATCH_NEXT();
                 }
                 default:
                     MONGO_UNREACHABLE;
@@ -4922,6 +5061,10 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
     }
 }
 
+#undef SBE_VM_DISPATCH_NEXT
+#undef SBE_VM_INSTRUCTION
+#undef MONGO_SBE_VM_THREADED_DISPATCH
+
 std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragment* code) {
     runInternal(code, 0);
 
@@ -255,6 +255,7 @@ struct Instruction {
 
         fillEmpty,
         getField,
+        getFieldImm,  // getField with the field name stored inline in the instruction
         getElement,
         collComparisonKey,
         getFieldOrElement,
@@ -505,6 +506,7 @@ public:
         appendSimpleInstruction(Instruction::fillEmpty);
     }
     void appendGetField();
+    void appendGetField(StringData fieldName);
     void appendGetElement();
     void appendCollComparisonKey();
     void appendGetFieldOrElement();
@@ -682,6 +684,9 @@ private:
                                                              value::Value objValue,
                                                              value::TypeTags fieldTag,
                                                              value::Value fieldValue);
+    std::tuple<bool, value::TypeTags, value::Value> getField(value::TypeTags objTag,
+                                                             value::Value objValue,
+                                                             StringData fieldStr);
 
     std::tuple<bool, value::TypeTags, value::Value> getElement(value::TypeTags objTag,
                                                                value::Value objValue,
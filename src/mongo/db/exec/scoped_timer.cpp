@@ -27,19 +27,68 @@
  *    it in the license file.
  */
 
+
 #include "mongo/platform/basic.h"
 
+#if defined(__linux__)
+#include <time.h>
+#endif  // defined(__linux__)
+
+#include <utility>
+
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/util/clock_source.h"
 
 namespace mongo {
+namespace {
+
+// Returns the CPU time used by the current thread, or zero if it cannot be measured.
+Nanoseconds getThreadCPUTime() {
+#if defined(__linux__)
+    struct timespec t;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0) {
+        return Seconds(t.tv_sec) + Nanoseconds(t.tv_nsec);
+    }
+#endif  // defined(__linux__)
+    return Nanoseconds(0);
+}
 
-ScopedTimer::ScopedTimer(ClockSource* cs, long long* counter)
-    : _clock(cs), _counter(counter), _start(cs->now()) {}
+}  // namespace
+
+ScopedTimer::ScopedTimer(ClockSource* cs, long long* counter, long long* cpuMicrosCounter)
+    : _clock(cs),
+      _counter(counter),
+      _cpuMicrosCounter(cpuMicrosCounter),
+      _start(cs->now()),
+      _cpuStart(cpuMicrosCounter ? getThreadCPUTime() : Nanoseconds(0)) {}
+
+ScopedTimer::ScopedTimer(ScopedTimer&& other)
+    : _clock(other._clock),
+      _counter(std::exchange(other._counter, nullptr)),
+      _cpuMicrosCounter(std::exchange(other._cpuMicrosCounter, nullptr)),
+      _start(other._start),
+      _cpuStart(other._cpuStart) {}
 
 ScopedTimer::~ScopedTimer() {
-    long long elapsed = durationCount<Milliseconds>(_clock->now() - _start);
-    *_counter += elapsed;
+    // A moved-from timer does not count anything.
+    if (_counter) {
+        *_counter += durationCount<Milliseconds>(_clock->now() - _start);
+    }
+    if (_cpuMicrosCounter) {
+        *_cpuMicrosCounter += durationCount<Microseconds>(getThreadCPUTime() - _cpuStart);
+    }
+}
+
+bool ScopedTimer::canMeasureCPUTime() {
+#if defined(__linux__)
+    static const bool canMeasure = [] {
+        struct timespec t;
+        return clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0;
+    }();
+    return canMeasure;
+#else
+    return false;
+#endif  // defined(__linux__)
 }
 
 }  // namespace mongo
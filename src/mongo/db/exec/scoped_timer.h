@@ -38,25 +38,36 @@ class ClockSource;
 
 /**
  * This class increments a counter by a rough estimate of the time elapsed since its
- * construction when it goes out of scope.
+ * construction when it goes out of scope. If 'cpuMicrosCounter' is set, it also increments it by
+ * the CPU time that the current thread used in the meantime, in microseconds.
  */
 class ScopedTimer {
     ScopedTimer(const ScopedTimer&) = delete;
     ScopedTimer& operator=(const ScopedTimer&) = delete;
 
 public:
-    ScopedTimer(ScopedTimer&& other) = default;
-    ScopedTimer(ClockSource* cs, long long* counter);
+    ScopedTimer(ScopedTimer&& other);
+    ScopedTimer(ClockSource* cs, long long* counter, long long* cpuMicrosCounter = nullptr);
 
     ~ScopedTimer();
 
+    /**
+     * Returns whether the CPU time of the current thread can be measured on this platform. A CPU
+     * time counter must only be passed to the timer if it can.
+     */
+    static bool canMeasureCPUTime();
+
 private:
     ClockSource* const _clock;
     // Reference to the counter that we are incrementing with the elapsed time.
     long long* _counter;
+    // Reference to the counter that we are incrementing with the CPU time, if any.
+    long long* _cpuMicrosCounter;
 
     // Time at which the timer was constructed.
     const Date_t _start;
+    // CPU time of the thread at which the timer was constructed.
+    const Nanoseconds _cpuStart;
 };
 
 }  // namespace mongo
@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/shared_oplog_buffer.h"
+
+#include <algorithm>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+namespace {
+
+const auto getSharedOplogBuffer = ServiceContext::declareDecoration<SharedOplogBuffer>();
+
+Counter64 sharedOplogBufferEntriesBuffered;
+Counter64 sharedOplogBufferEntriesReturned;
+
+ServerStatusMetricField<Counter64> sharedOplogBufferEntriesBufferedDisplay(
+    "query.sharedOplogBuffer.entriesBuffered", &sharedOplogBufferEntriesBuffered);
+ServerStatusMetricField<Counter64> sharedOplogBufferEntriesReturnedDisplay(
+    "query.sharedOplogBuffer.entriesReturned", &sharedOplogBufferEntriesReturned);
+
+}  // namespace
+
+SharedOplogBuffer& SharedOplogBuffer::get(ServiceContext* serviceContext) {
+    return getSharedOplogBuffer(serviceContext);
+}
+
+SharedOplogBuffer& SharedOplogBuffer::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void SharedOplogBuffer::getNext(const RecordId& after,
+                                size_t maxEntries,
+                                std::deque<Entry>* out) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_entries.empty() || after < _anchor || after >= _entries.back().id) {
+        return;
+    }
+
+    auto it = _entries.begin();
+    if (after != _anchor) {
+        it = std::lower_bound(_entries.begin(),
+                              _entries.end(),
+                              after,
+                              [](const Entry& entry, const RecordId& id) { return entry.id < id; });
+        if (it->id != after) {
+            return;
+        }
+        ++it;
+    }
+
+    const size_t numEntries = std::min<size_t>(maxEntries, std::distance(it, _entries.end()));
+    out->insert(out->end(), it, it + numEntries);
+    sharedOplogBufferEntriesReturned.increment(numEntries);
+}
+
+void SharedOplogBuffer::append(const RecordId& prev, const RecordId& id, const BSONObj& obj) {
+    const size_t maxBytes = internalQuerySharedOplogBufferMaxBytes.load();
+    if (maxBytes == 0) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_entries.empty() || prev != _entries.back().id) {
+        if (!_entries.empty() && id <= _entries.back().id) {
+            return;
+        }
+        _entries.clear();
+        _bytes = 0;
+        _anchor = prev;
+    }
+
+    _entries.push_back({id, obj.getOwned()});
+    _bytes += obj.objsize();
+    sharedOplogBufferEntriesBuffered.increment();
+
+    while (_bytes > maxBytes && _entries.size() > 1) {
+        _anchor = _entries.front().id;
+        _bytes -= _entries.front().obj.objsize();
+        _entries.pop_front();
+    }
+}
+
+void SharedOplogBuffer::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _bytes = 0;
+    _anchor = RecordId();
+}
+
+}  // namespace mongo
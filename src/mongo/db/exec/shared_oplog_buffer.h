@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * Holds the most recent oplog entries read by tailable scans of the majority committed oplog, such
+ * as those of change streams, so that the scans which follow the same stretch of the oplog read and
+ * copy each entry out of the storage engine once between them.
+ *
+ * The buffer holds a contiguous run of the oplog: each entry is the one which follows the previous
+ * entry in the oplog, and the first entry follows the entry called the anchor. The scan which reads
+ * furthest ahead extends the run, and the other scans take the entries which follow their position
+ * from the run instead of their storage cursor. Entries are forgotten from the front once the
+ * buffer holds more than 'internalQuerySharedOplogBufferMaxBytes'.
+ *
+ * Majority committed oplog entries never change, so an entry which one scan saw may be returned to
+ * any other scan of the majority committed snapshot. The buffer is cleared on rollback regardless.
+ */
+class SharedOplogBuffer {
+public:
+    struct Entry {
+        RecordId id;
+        BSONObj obj;
+    };
+
+    static SharedOplogBuffer& get(ServiceContext* serviceContext);
+    static SharedOplogBuffer& get(OperationContext* opCtx);
+
+    /**
+     * Appends to 'out' up to 'maxEntries' of the buffered entries which follow the entry 'after'
+     * in the oplog. Appends nothing unless 'after' is the anchor or a buffered entry.
+     */
+    void getNext(const RecordId& after, size_t maxEntries, std::deque<Entry>* out) const;
+
+    /**
+     * Records that the entry 'obj' with RecordId 'id' follows the entry 'prev' in the oplog, as
+     * read by a forward storage cursor. The entry is copied into the buffer if it extends the run.
+     * Otherwise the entry starts a new run, unless it is already buffered or comes before the run.
+     */
+    void append(const RecordId& prev, const RecordId& id, const BSONObj& obj);
+
+    /**
+     * Forgets every entry.
+     */
+    void clear();
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("SharedOplogBuffer::_mutex");
+
+    // The RecordId of the entry which '_entries.front()' follows in the oplog.
+    RecordId _anchor;
+
+    std::deque<Entry> _entries;
+    size_t _bytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/shared_oplog_buffer.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class SharedOplogBufferTest : public unittest::Test {
+protected:
+    void setUp() override {
+        _maxBytes = internalQuerySharedOplogBufferMaxBytes.load();
+        internalQuerySharedOplogBufferMaxBytes.store(1024 * 1024);
+    }
+
+    void tearDown() override {
+        internalQuerySharedOplogBufferMaxBytes.store(_maxBytes);
+    }
+
+    static BSONObj entry(int64_t id) {
+        return BSON("ts" << Timestamp(id, 0) << "o" << BSON("_id" << id));
+    }
+
+    /**
+     * Appends the entries with RecordIds in the range (first, last], each following the one before.
+     */
+    void appendRange(int64_t first, int64_t last) {
+        for (int64_t id = first + 1; id <= last; ++id) {
+            buffer.append(RecordId(id - 1), RecordId(id), entry(id));
+        }
+    }
+
+    std::vector<int64_t> getNext(int64_t after, size_t maxEntries = 100) {
+        std::deque<SharedOplogBuffer::Entry> entries;
+        buffer.getNext(RecordId(after), maxEntries, &entries);
+
+        std::vector<int64_t> ids;
+        for (auto&& entry : entries) {
+            ASSERT_BSONOBJ_EQ(entry.obj, SharedOplogBufferTest::entry(entry.id.getLong()));
+            ids.push_back(entry.id.getLong());
+        }
+        return ids;
+    }
+
+    SharedOplogBuffer buffer;
+
+private:
+    long long _maxBytes;
+};
+
+TEST_F(SharedOplogBufferTest, ReturnsEntriesFollowingAnchorOrBufferedEntry) {
+    appendRange(10, 15);
+
+    ASSERT(getNext(10) == std::vector<int64_t>({11, 12, 13, 14, 15}));
+    ASSERT(getNext(13) == std::vector<int64_t>({14, 15}));
+    ASSERT(getNext(11, 2) == std::vector<int64_t>({12, 13}));
+    ASSERT(getNext(15).empty());
+    ASSERT(getNext(9).empty());
+    ASSERT(getNext(16).empty());
+}
+
+TEST_F(SharedOplogBufferTest, IgnoresEntriesAlreadyBuffered) {
+    appendRange(10, 15);
+    buffer.append(RecordId(11), RecordId(12), entry(12));
+    buffer.append(RecordId(3), RecordId(4), entry(4));
+
+    ASSERT(getNext(10) == std::vector<int64_t>({11, 12, 13, 14, 15}));
+}
+
+TEST_F(SharedOplogBufferTest, EntryWhichDoesNotExtendRunStartsNewRun) {
+    appendRange(10, 15);
+    appendRange(20, 22);
+
+    ASSERT(getNext(10).empty());
+    ASSERT(getNext(15).empty());
+    ASSERT(getNext(20) == std::vector<int64_t>({21, 22}));
+}
+
+TEST_F(SharedOplogBufferTest, ForgetsOldestEntriesBeyondMaxBytes) {
+    const auto entrySize = entry(1).objsize();
+    internalQuerySharedOplogBufferMaxBytes.store(3 * entrySize);
+    appendRange(0, 5);
+
+    ASSERT(getNext(0).empty());
+    ASSERT(getNext(1).empty());
+    ASSERT(getNext(2) == std::vector<int64_t>({3, 4, 5}));
+}
+
+TEST_F(SharedOplogBufferTest, ClearForgetsEveryEntry) {
+    appendRange(10, 15);
+    buffer.clear();
+
+    ASSERT(getNext(10).empty());
+    ASSERT(getNext(12).empty());
+
+    appendRange(15, 16);
+    ASSERT(getNext(15) == std::vector<int64_t>({16}));
+}
+
+TEST_F(SharedOplogBufferTest, BuffersNothingWhenDisabled) {
+    internalQuerySharedOplogBufferMaxBytes.store(0);
+    appendRange(10, 15);
+
+    ASSERT(getNext(10).empty());
+}
+
+}  // namespace
+}  // namespace mongo
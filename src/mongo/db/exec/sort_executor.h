@@ -34,8 +34,10 @@
 #include "mongo/db/exec/sort_key_comparator.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
 /**
@@ -47,6 +49,12 @@ namespace mongo {
  * The template parameter is the type of data being sorted. In DocumentSource execution, we sort
  * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. The type of
  * the sort key, on the other hand, is always Value.
+ *
+ * Unless disabled by 'internalQuerySortUseNormalizedKeys', each sort key is encoded once as a
+ * KeyString under the Ordering of the sort pattern when it is added, so that the sorter compares
+ * keys with memcmp rather than field by field. The Value sort key is decoded again on the way out.
+ * Sort patterns with as many parts as an Ordering can describe, or more, always use the Value
+ * comparator, since a normalized key may need one element more than the sort pattern.
  */
 template <typename T>
 class SortExecutor {
@@ -64,6 +72,15 @@ public:
         SortKeyComparator _sortKeyComparator;
     };
 
+    using NormalizedDocumentSorter = Sorter<KeyString::Value, T>;
+    class NormalizedComparator {
+    public:
+        int operator()(const typename NormalizedDocumentSorter::Data& lhs,
+                       const typename NormalizedDocumentSorter::Data& rhs) const {
+            return lhs.first.compare(rhs.first);
+        }
+    };
+
     /**
      * If the passed in limit is 0, this is treated as no limit.
      */
@@ -75,6 +92,14 @@ public:
         : _sortPattern(std::move(sortPattern)),
           _tempDir(std::move(tempDir)),
           _diskUseAllowed(allowDiskUse) {
+        if (internalQuerySortUseNormalizedKeys.load() && !_sortPattern.empty() &&
+            _sortPattern.size() < Ordering::kMaxCompoundIndexKeys) {
+            BSONObjBuilder orderingBob;
+            for (auto&& part : _sortPattern) {
+                orderingBob.append("", part.isAscending ? 1 : -1);
+            }
+            _normalizedKeyOrdering = Ordering::make(orderingBob.done());
+        }
         _stats.sortPattern =
             _sortPattern.serialize(SortPattern::SortKeySerialization::kForExplain).toBson();
         _stats.limit = limit;
@@ -123,6 +148,14 @@ public:
      * Should only be called before 'loadingDone()' is called.
      */
     void add(const Value& sortKey, const T& data) {
+        if (_normalizedKeyOrdering) {
+            if (!_normalizedSorter) {
+                _normalizedSorter.reset(makeNormalizedSorter());
+            }
+            _normalizedSorter->add(normalizeSortKey(sortKey), data);
+            return;
+        }
+
         if (!_sorter) {
             _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
         }
@@ -133,6 +166,19 @@ public:
      * Signals to the sort executor that there will be no more input documents.
      */
     void loadingDone() {
+        if (_normalizedKeyOrdering) {
+            // This conditional should only pass if no documents were added to the sorter.
+            if (!_normalizedSorter) {
+                _normalizedSorter.reset(makeNormalizedSorter());
+            }
+            _normalizedOutput.reset(_normalizedSorter->done());
+            _stats.keysSorted += _normalizedSorter->numSorted();
+            _stats.spills += _normalizedSorter->numSpills();
+            _stats.totalDataSizeBytes += _normalizedSorter->totalDataSizeSorted();
+            _normalizedSorter.reset();
+            return;
+        }
+
         // This conditional should only pass if no documents were added to the sorter.
         if (!_sorter) {
             _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
@@ -153,8 +199,9 @@ public:
             return false;
         }
 
-        if (!_output->more()) {
+        if (_normalizedKeyOrdering ? !_normalizedOutput->more() : !_output->more()) {
             _output.reset();
+            _normalizedOutput.reset();
             _isEOF = true;
             return false;
         }
@@ -168,6 +215,10 @@ public:
      * end-of-stream must be detected with 'hasNext()'.
      */
     std::pair<Value, T> getNext() {
+        if (_normalizedKeyOrdering) {
+            auto next = _normalizedOutput->next();
+            return {denormalizeSortKey(next.first), std::move(next.second)};
+        }
         return _output->next();
     }
 
@@ -191,13 +242,94 @@ private:
         return opts;
     }
 
+    NormalizedDocumentSorter* makeNormalizedSorter() const {
+        typename NormalizedDocumentSorter::Settings settings{KeyString::Version::kLatestVersion,
+                                                             {}};
+        return NormalizedDocumentSorter::make(makeSortOptions(), NormalizedComparator(), settings);
+    }
+
+    /**
+     * Encodes 'sortKey' as a KeyString under '_normalizedKeyOrdering'.
+     *
+     * A missing component is encoded as undefined, which the Value comparator orders equal to
+     * missing. So that it can be restored as missing, a key with missing components gets one more
+     * element: a mask with bit i set for each missing component i. The mask only breaks ties
+     * between keys that compare equal under the Value comparator.
+     */
+    KeyString::Value normalizeSortKey(const Value& sortKey) const {
+        BSONObjBuilder keyBob;
+        int missingMask = 0;
+        auto appendPart = [&](const Value& part, size_t i) {
+            if (part.missing()) {
+                keyBob.appendUndefined("");
+                missingMask |= 1 << i;
+            } else {
+                part.addToBsonObj(&keyBob, ""_sd);
+            }
+        };
+
+        if (_sortPattern.isSingleElementKey()) {
+            appendPart(sortKey, 0);
+        } else {
+            for (size_t i = 0; i < _sortPattern.size(); ++i) {
+                appendPart(sortKey[i], i);
+            }
+        }
+        if (missingMask) {
+            keyBob.append("", missingMask);
+        }
+
+        KeyString::HeapBuilder builder(
+            KeyString::Version::kLatestVersion, keyBob.done(), *_normalizedKeyOrdering);
+        return builder.release();
+    }
+
+    /**
+     * Recovers the Value sort key from its KeyString encoding, including the exact numeric types
+     * and missing components.
+     */
+    Value denormalizeSortKey(const KeyString::Value& keyString) const {
+        auto keyObj = KeyString::toBson(keyString.getBuffer(),
+                                        keyString.getSize(),
+                                        *_normalizedKeyOrdering,
+                                        keyString.getTypeBits());
+
+        std::vector<Value> parts;
+        parts.reserve(_sortPattern.size());
+        int missingMask = 0;
+        for (auto&& elem : keyObj) {
+            if (parts.size() == _sortPattern.size()) {
+                missingMask = elem.numberInt();
+                break;
+            }
+            parts.emplace_back(elem);
+        }
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (missingMask & (1 << i)) {
+                parts[i] = Value();
+            }
+        }
+
+        if (_sortPattern.isSingleElementKey()) {
+            return std::move(parts.front());
+        }
+        return Value(std::move(parts));
+    }
+
     const SortPattern _sortPattern;
     const std::string _tempDir;
     const bool _diskUseAllowed;
 
+    // Set when the sort keys are normalized into KeyStrings, in which case '_normalizedSorter'
+    // and '_normalizedOutput' are used instead of '_sorter' and '_output'.
+    boost::optional<Ordering> _normalizedKeyOrdering;
+
     std::unique_ptr<DocumentSorter> _sorter;
     std::unique_ptr<typename DocumentSorter::Iterator> _output;
 
+    std::unique_ptr<NormalizedDocumentSorter> _normalizedSorter;
+    std::unique_ptr<typename NormalizedDocumentSorter::Iterator> _normalizedOutput;
+
     SortStats _stats;
 
     bool _isEOF = false;
@@ -37,11 +37,13 @@
 #include <memory>
 
 #include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/exec/sort_executor.h"
 #include "mongo/db/json.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/collation/collator_factory_mock.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 
@@ -304,4 +306,77 @@ TEST_F(SortStageDefaultTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+// Runs a SortExecutor over 'keys', using each key's position as the data, and returns the pairs
+// in sorted order.
+std::vector<std::pair<Value, BSONObj>> sortWithExecutor(const SortPattern& pattern,
+                                                        const std::vector<Value>& keys) {
+    SortExecutor<BSONObj> executor(pattern,
+                                   0 /* limit */,
+                                   SortStageDefaultTest::kMaxMemoryUsageBytes,
+                                   "" /* tempDir */,
+                                   false /* allowDiskUse */);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        executor.add(keys[i], BSON("i" << static_cast<int>(i)));
+    }
+    executor.loadingDone();
+
+    std::vector<std::pair<Value, BSONObj>> sorted;
+    while (executor.hasNext()) {
+        sorted.push_back(executor.getNext());
+    }
+    return sorted;
+}
+
+TEST_F(SortStageDefaultTest, NormalizedKeysSortLikeValueComparator) {
+    auto expCtx = make_intrusive<ExpressionContext>(opCtx(), nullptr, kNss);
+    SortPattern pattern{fromjson("{a: 1, b: -1}"), expCtx};
+
+    // Mixed numeric types that compare equal must keep their input order, and must come back with
+    // their original types.
+    std::vector<Value> keys;
+    for (auto&& key : fromjson("{keys: [[1, 'x'], [1.0, 'y'], [NumberLong(1), 'y'], [-0.0, 'z'], "
+                               "[null, 2], [{b: 1}, [1, 2]], ['str', NumberDecimal('2.5')], "
+                               "[MinKey, 0], [NaN, 1], [2, 'x\u0000y'], [2, 'x']]}")["keys"]
+                           .Array()) {
+        keys.emplace_back(key);
+    }
+
+    // A missing component sorts like undefined, after MinKey and before null, and must come back as
+    // missing.
+    keys.emplace_back(std::vector<Value>{Value(), Value("x"_sd)});
+    keys.emplace_back(std::vector<Value>{Value(BSONUndefined), Value("x"_sd)});
+    keys.emplace_back(std::vector<Value>{Value(1), Value()});
+    keys.emplace_back(std::vector<Value>{Value(MINKEY), Value()});
+
+    auto normalized = sortWithExecutor(pattern, keys);
+    std::vector<std::pair<Value, BSONObj>> expected;
+    {
+        RAIIServerParameterControllerForTest controller("internalQuerySortUseNormalizedKeys",
+                                                        false);
+        expected = sortWithExecutor(pattern, keys);
+    }
+
+    ASSERT_EQ(expected.size(), normalized.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(expected[i].second, normalized[i].second);
+        for (size_t part = 0; part < pattern.size(); ++part) {
+            ASSERT_EQ(expected[i].first.getArray()[part].getType(),
+                      normalized[i].first.getArray()[part].getType());
+        }
+        ASSERT_EQ(0, ValueComparator().compare(expected[i].first, normalized[i].first));
+    }
+}
+
+TEST_F(SortStageDefaultTest, NormalizedKeysRestoreMissingSingleElementKey) {
+    auto expCtx = make_intrusive<ExpressionContext>(opCtx(), nullptr, kNss);
+    SortPattern pattern{fromjson("{a: -1}"), expCtx};
+
+    auto sorted = sortWithExecutor(pattern, {Value(), Value(BSONNULL), Value(MINKEY), Value(1)});
+    ASSERT_EQ(4U, sorted.size());
+    ASSERT_EQ(NumberInt, sorted[0].first.getType());
+    ASSERT_EQ(jstNULL, sorted[1].first.getType());
+    ASSERT(sorted[2].first.missing());
+    ASSERT_EQ(MinKey, sorted[3].first.getType());
+}
 }  // namespace
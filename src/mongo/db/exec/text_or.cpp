@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -56,13 +57,13 @@ TextOrStage::TextOrStage(ExpressionContext* expCtx,
                          size_t keyPrefixSize,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         const CollectionPtr& collection)
+                         const CollectionPtr& collection,
+                         size_t limit)
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _keyPrefixSize(keyPrefixSize),
+      _limit(limit),
       _ws(ws),
-      _scoreIterator(_scores.end()),
-      _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {}
+      _filter(filter) {}
 
 void TextOrStage::addChild(unique_ptr<PlanStage> child) {
     _children.push_back(std::move(child));
@@ -170,19 +171,11 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
     invariant(_currentChild < _children.size());
 
-    // Either retry the last WSM we worked on or get a new one from our current child.
-    WorkingSetID id;
-    StageState childState;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        childState = _children[_currentChild]->work(&id);
-    } else {
-        childState = ADVANCED;
-        id = _idRetrying;
-        _idRetrying = WorkingSet::INVALID_ID;
-    }
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    StageState childState = _children[_currentChild]->work(&id);
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        return addTerm(id);
     } else if (PlanStage::IS_EOF == childState) {
         // Done with this child.
         ++_currentChild;
@@ -192,8 +185,16 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
             return PlanStage::NEED_TIME;
         }
 
-        // If we're here we are done reading results.  Move to the next state.
-        _scoreIterator = _scores.begin();
+        // If we're here we are done reading results. Collect the documents which matched, and
+        // move to the next state.
+        _candidates.reserve(_scores.size());
+        for (auto&& [recordId, textRecordData] : _scores) {
+            if (textRecordData.score >= 0) {
+                _candidates.push_back(textRecordData);
+            }
+        }
+        _scores = ScoreMap();
+        _selectedEnd = _limit ? 0 : _candidates.size();
         _internalState = State::kReturningResults;
 
         return PlanStage::NEED_TIME;
@@ -205,20 +206,44 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
 }
 
 PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
-    if (_scoreIterator == _scores.end()) {
+    if (_limit && _nextCandidate == _selectedEnd) {
+        selectTopCandidates();
+    }
+
+    if (_nextCandidate == _selectedEnd) {
+        // Release the documents which did not make it into the top-k set.
+        for (size_t i = _nextCandidate; i < _candidates.size(); ++i) {
+            _ws->free(_candidates[i].wsid);
+        }
+        _candidates.clear();
         _internalState = State::kDone;
         return PlanStage::IS_EOF;
     }
 
     // Retrieve the record that contains the text score.
-    TextRecordData textRecordData = _scoreIterator->second;
-    ++_scoreIterator;
+    const TextRecordData textRecordData = _candidates[_nextCandidate];
 
-    // Ignore non-matched documents.
-    if (textRecordData.score < 0) {
-        invariant(textRecordData.wsid == WorkingSet::INVALID_ID);
-        return PlanStage::NEED_TIME;
+    // Our parent expects RID_AND_OBJ members, so we fetch the document now that we know it is
+    // going to be returned.
+    try {
+        if (!WorkingSetCommon::fetch(opCtx(),
+                                     _ws,
+                                     textRecordData.wsid,
+                                     _recordCursor.get(),
+                                     collection(),
+                                     collection()->ns())) {
+            _ws->free(textRecordData.wsid);
+            ++_nextCandidate;
+            return PlanStage::NEED_TIME;
+        }
+        ++_specificStats.fetches;
+    } catch (const WriteConflictException&) {
+        // Fetch the same document again after yielding.
+        *out = WorkingSet::INVALID_ID;
+        return PlanStage::NEED_YIELD;
     }
+    ++_nextCandidate;
+    ++_numReturned;
 
     WorkingSetMember* wsm = _ws->get(textRecordData.wsid);
 
@@ -228,7 +253,22 @@ PlanStage::StageState TextOrStage::returnResults(WorkingSetID* out) {
     return PlanStage::ADVANCED;
 }
 
-PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out) {
+void TextOrStage::selectTopCandidates() {
+    invariant(_numReturned <= _limit);
+    const size_t numToSelect =
+        std::min(_limit - _numReturned, _candidates.size() - _nextCandidate);
+
+    auto begin = _candidates.begin() + _nextCandidate;
+    std::nth_element(begin,
+                     begin + numToSelect,
+                     _candidates.end(),
+                     [](const TextRecordData& lhs, const TextRecordData& rhs) {
+                         return lhs.score > rhs.score;
+                     });
+    _selectedEnd = _nextCandidate + numToSelect;
+}
+
+PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid) {
     WorkingSetMember* wsm = _ws->get(wsid);
     invariant(wsm->getState() == WorkingSetMember::RID_AND_IDX);
     invariant(1 == wsm->keyData.size());
@@ -252,27 +292,9 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
             return NEED_TIME;
         }
 
-        // Our parent expects RID_AND_OBJ members, so we fetch the document here if we haven't
-        // already.
-        try {
-            if (!WorkingSetCommon::fetch(
-                    opCtx(), _ws, wsid, _recordCursor.get(), collection(), collection()->ns())) {
-                _ws->free(wsid);
-                textRecordData->score = -1;
-                return NEED_TIME;
-            }
-            ++_specificStats.fetches;
-        } catch (const WriteConflictException&) {
-            wsm->makeObjOwnedIfNeeded();
-            _idRetrying = wsid;
-            *out = WorkingSet::INVALID_ID;
-            return NEED_YIELD;
-        }
-
+        // Keep the index key around so that the document can be checked against it when it is
+        // fetched, once we know whether it is going to be returned.
         textRecordData->wsid = wsid;
-
-        // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
-        wsm->makeObjOwnedIfNeeded();
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
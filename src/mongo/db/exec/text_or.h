@@ -30,6 +30,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/fts/fts_spec.h"
@@ -46,6 +47,10 @@ class OperationContext;
  * A blocking stage that returns the set of WSMs with RecordIDs of all of the documents that contain
  * the positive terms in the search query, as well as their scores.
  *
+ * Documents are only fetched once their final score is known, as they are returned. If the stage
+ * is given a non-zero 'limit', it returns only the 'limit' highest scoring documents and never
+ * fetches the others.
+ *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
  */
 class TextOrStage final : public RequiresCollectionStage {
@@ -71,7 +76,8 @@ public:
                 size_t keyPrefixSize,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                const CollectionPtr& collection);
+                const CollectionPtr& collection,
+                size_t limit = 0);
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -116,16 +122,26 @@ private:
      * Helper called from readFromChildren to update aggregate score with a newfound (term, score)
      * pair for this document.
      */
-    StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
+    StageState addTerm(WorkingSetID wsid);
 
     /**
      * Worker for kReturningResults. Returns a wsm with RecordID and Score.
      */
     StageState returnResults(WorkingSetID* out);
 
+    /**
+     * Moves the highest scoring of the candidates which have not been returned yet to the front
+     * of the remaining candidates, so that the stage returns no more than '_limit' documents in
+     * total.
+     */
+    void selectTopCandidates();
+
     // The key prefix length within a possibly compound key: {prefix,term,score,suffix}.
     const size_t _keyPrefixSize;
 
+    // The number of highest scoring documents to return, or zero to return all of them.
+    const size_t _limit;
+
     // Not owned by us.
     WorkingSet* _ws;
 
@@ -148,13 +164,19 @@ private:
 
     typedef stdx::unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
     ScoreMap _scores;
-    ScoreMap::const_iterator _scoreIterator;
+
+    // The documents which matched, built from '_scores' once all of the terms have been read.
+    // Entries before '_nextCandidate' have already been handled, and, when there is a limit,
+    // entries before '_selectedEnd' are the ones chosen to be returned.
+    std::vector<TextRecordData> _candidates;
+    size_t _nextCandidate = 0;
+    size_t _selectedEnd = 0;
+    size_t _numReturned = 0;
 
     TextOrStats _specificStats;
 
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
-    WorkingSetID _idRetrying;
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 };
 }  // namespace mongo
@@ -283,8 +283,15 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
                 }
 
                 WriteUnitOfWork wunit(opCtx());
-                StatusWith<RecordData> newRecStatus = collection()->updateDocumentWithDamages(
-                    opCtx(), recordId, std::move(snap), source, _damages, &args);
+                StatusWith<RecordData> newRecStatus =
+                    collection()->updateDocumentWithDamages(opCtx(),
+                                                            recordId,
+                                                            std::move(snap),
+                                                            source,
+                                                            _damages,
+                                                            driver->modsAffectIndices(),
+                                                            _params.opDebug,
+                                                            &args);
                 invariant(oldObj.snapshotId() == opCtx()->recoveryUnit()->getSnapshotId());
                 wunit.commit();
 
@@ -48,6 +48,8 @@ extern const char kFTDCDocsField[];
 extern const char kFTDCCollectStartField[];
 extern const char kFTDCCollectEndField[];
 
+extern const char kFTDCHighFrequencyField[];
+
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
 }  // namespace mongo
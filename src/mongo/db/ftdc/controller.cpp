@@ -33,10 +33,12 @@
 
 #include "mongo/db/ftdc/controller.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/collector.h"
+#include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/logv2/log.h"
@@ -49,6 +51,22 @@
 
 namespace mongo {
 
+namespace {
+
+/**
+ * Returns how many high-frequency samples are recorded with each periodic sample.
+ */
+size_t getHighFrequencySamplesPerPeriod(const FTDCConfig& config) {
+    if (config.highFrequencyPeriod <= Milliseconds(0)) {
+        return 0;
+    }
+
+    return static_cast<size_t>(
+        std::max<int64_t>(1, config.period.count() / config.highFrequencyPeriod.count()));
+}
+
+}  // namespace
+
 Status FTDCController::setEnabled(bool enabled) {
     stdx::lock_guard<Latch> lock(_mutex);
 
@@ -59,7 +77,7 @@ Status FTDCController::setEnabled(bool enabled) {
     }
 
     _configTemp.enabled = enabled;
-    _condvar.notify_one();
+    _condvar.notify_all();
 
     return Status::OK();
 }
@@ -67,31 +85,37 @@ Status FTDCController::setEnabled(bool enabled) {
 void FTDCController::setPeriod(Milliseconds millis) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.period = millis;
-    _condvar.notify_one();
+    _condvar.notify_all();
+}
+
+void FTDCController::setHighFrequencyPeriod(Milliseconds millis) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.highFrequencyPeriod = millis;
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxFileSizeBytes(std::uint64_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxFileSizeBytes = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxSamplesPerArchiveMetricChunk(size_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxSamplesPerArchiveMetricChunk = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 void FTDCController::setMaxSamplesPerInterimMetricChunk(size_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxSamplesPerInterimMetricChunk = size;
-    _condvar.notify_one();
+    _condvar.notify_all();
 }
 
 Status FTDCController::setDirectory(const boost::filesystem::path& path) {
@@ -120,6 +144,15 @@ void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addHighFrequencyCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        _highFrequencyCollectors.add(std::move(collector));
+    }
+}
+
 void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -144,6 +177,10 @@ void FTDCController::start() {
     // Start the thread
     _thread = stdx::thread([this] { doLoop(); });
 
+    if (!_highFrequencyCollectors.empty()) {
+        _highFrequencyThread = stdx::thread([this] { doHighFrequencyLoop(); });
+    }
+
     {
         stdx::lock_guard<Latch> lock(_mutex);
 
@@ -171,11 +208,15 @@ void FTDCController::stop() {
         _state = State::kStopRequested;
 
         // Wake up the thread if sleeping so that it will check if we are done
-        _condvar.notify_one();
+        _condvar.notify_all();
     }
 
     _thread.join();
 
+    if (_highFrequencyThread.joinable()) {
+        _highFrequencyThread.join();
+    }
+
     _state = State::kDone;
 
     if (_mgr) {
@@ -247,16 +288,96 @@ void FTDCController::doLoop() noexcept {
             }
 
             auto collectSample = _periodicCollectors.collect(client);
+            auto sample = appendHighFrequencySamples(std::get<0>(collectSample));
 
-            Status s = _mgr->writeSampleAndRotateIfNeeded(
-                client, std::get<0>(collectSample), std::get<1>(collectSample));
+            Status s =
+                _mgr->writeSampleAndRotateIfNeeded(client, sample, std::get<1>(collectSample));
 
             uassertStatusOK(s);
 
             // Store a reference to the most recent document from the periodic collectors
             {
                 stdx::lock_guard<Latch> lock(_mutex);
-                _mostRecentPeriodicDocument = std::get<0>(collectSample);
+                _mostRecentPeriodicDocument = sample;
+            }
+        }
+    }
+}
+
+BSONObj FTDCController::appendHighFrequencySamples(const BSONObj& sample) {
+    std::deque<BSONObj> samples;
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        samples.swap(_highFrequencySamples);
+    }
+
+    auto numSamples = getHighFrequencySamplesPerPeriod(_config);
+    if (samples.empty() || sample.isEmpty() || numSamples == 0) {
+        return sample;
+    }
+
+    // Record exactly one entry per high-frequency period so that the schema of the sample does
+    // not change when a sampling round is late or early, which would start a new metric chunk.
+    // Missing samples are filled in with the oldest one we have.
+    while (samples.size() > numSamples) {
+        samples.pop_front();
+    }
+    while (samples.size() < numSamples) {
+        samples.push_front(samples.front());
+    }
+
+    BSONObjBuilder builder;
+    builder.appendElements(sample);
+    BSONArrayBuilder arrayBuilder(builder.subarrayStart(kFTDCHighFrequencyField));
+    for (auto&& highFrequencySample : samples) {
+        arrayBuilder.append(highFrequencySample);
+    }
+    arrayBuilder.done();
+    return builder.obj();
+}
+
+void FTDCController::doHighFrequencyLoop() noexcept {
+    // Note: As in doLoop(), all exceptions thrown in this loop are considered process fatal.
+    Client::initThread(kFTDCHighFrequencyThreadName);
+    Client* client = &cc();
+
+    while (true) {
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            MONGO_IDLE_THREAD_BLOCK;
+
+            if (_state == State::kStopRequested) {
+                break;
+            }
+
+            auto period = _configTemp.highFrequencyPeriod;
+            if (!_configTemp.enabled || period <= Milliseconds(0)) {
+                // Sleep until the configuration changes, and drop any samples that have not been
+                // recorded so that they do not show up when sampling is turned back on.
+                _highFrequencySamples.clear();
+                _condvar.wait(lock);
+                continue;
+            }
+
+            auto now = getGlobalServiceContext()->getPreciseClockSource()->now();
+            auto next_time = FTDCUtil::roundTime(now, period);
+
+            auto status = _condvar.wait_until(lock, next_time.toSystemTimePoint());
+            if (status == stdx::cv_status::no_timeout) {
+                continue;
+            }
+        }
+
+        auto collectSample = _highFrequencyCollectors.collect(client);
+
+        {
+            stdx::lock_guard<Latch> lock(_mutex);
+            _highFrequencySamples.push_back(std::get<0>(collectSample));
+
+            // Bound the samples kept in case the periodic collection falls behind.
+            auto maxSamples = getHighFrequencySamplesPerPeriod(_configTemp);
+            while (_highFrequencySamples.size() > maxSamples) {
+                _highFrequencySamples.pop_front();
             }
         }
     }
@@ -31,6 +31,7 @@
 
 #include <boost/filesystem/path.hpp>
 #include <cstdint>
+#include <deque>
 #include <memory>
 
 #include "mongo/db/ftdc/collector.h"
@@ -75,6 +76,11 @@ public:
      */
     void setPeriod(Milliseconds millis);
 
+    /**
+     * Set the period for sampling the high-frequency collectors. Zero disables them.
+     */
+    void setHighFrequencyPeriod(Milliseconds millis);
+
     /**
      * Set the maximum directory size in bytes.
      */
@@ -111,6 +117,15 @@ public:
      */
     void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a metric collector to sample at the high-frequency period, i.e. queue depths.
+     *
+     * These collectors run on their own thread, many times per period, so they must be cheap. The
+     * samples taken since the last periodic collection are recorded with the next one, under the
+     * "highFrequency" field, as an array that always has one entry per high-frequency period.
+     */
+    void addHighFrequencyCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+
     /**
      * Add a collector to collect on server start, and file rotation. i.e. hostInfo
      *
@@ -148,6 +163,17 @@ private:
      */
     void doLoop() noexcept;
 
+    /**
+     * Sample the high-frequency collectors on a second background thread.
+     */
+    void doHighFrequencyLoop() noexcept;
+
+    /**
+     * Returns 'sample' with the high-frequency samples taken since the last call appended, and
+     * clears them.
+     */
+    BSONObj appendHighFrequencySamples(const BSONObj& sample);
+
 private:
     /**
      * Private enum to track state.
@@ -186,7 +212,8 @@ private:
     // Directory to store files
     boost::filesystem::path _path;
 
-    // Mutex to protect the condvar, configuration changes, and most recent periodic document.
+    // Mutex to protect the condvar, configuration changes, most recent periodic document, and
+    // high-frequency samples.
     Mutex _mutex = MONGO_MAKE_LATCH("FTDCController::_mutex");
     stdx::condition_variable _condvar;
 
@@ -204,6 +231,12 @@ private:
     // Owned
     BSONObj _mostRecentPeriodicDocument;
 
+    // Set of high-frequency collectors, only used by the high-frequency thread after start
+    FTDCCollectorCollection _highFrequencyCollectors;
+
+    // Samples from the high-frequency collectors since the last periodic collection, oldest first
+    std::deque<BSONObj> _highFrequencySamples;
+
     // Set of file rotation collectors
     FTDCCollectorCollection _rotateCollectors;
 
@@ -212,6 +245,10 @@ private:
 
     // Background collection and writing thread
     stdx::thread _thread;
+
+    // Background high-frequency sampling thread, only started if there are high-frequency
+    // collectors
+    stdx::thread _highFrequencyThread;
 };
 
 }  // namespace mongo
@@ -283,4 +283,52 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+// Test the samples of the high-frequency collectors are recorded with the periodic samples, with
+// one entry per high-frequency period
+TEST_F(FTDCControllerTest, TestHighFrequencyCollectors) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path dir(tempdir.path());
+
+    createDirectoryClean(dir);
+
+    FTDCConfig config;
+    config.enabled = true;
+    config.period = Milliseconds(20);
+    config.highFrequencyPeriod = Milliseconds(5);
+    config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+    config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+
+    FTDCController c(dir, config);
+
+    auto c1 = std::make_unique<FTDCMetricsCollectorMock2>();
+    auto c2 = std::make_unique<FTDCMetricsCollectorMock2>();
+
+    auto c1Ptr = c1.get();
+    auto c2Ptr = c2.get();
+
+    c1Ptr->setSignalOnCount(10);
+    c2Ptr->setSignalOnCount(20);
+
+    c.addPeriodicCollector(std::move(c1));
+
+    c.addHighFrequencyCollector(std::move(c2));
+
+    c.start();
+
+    // Wait for enough samples that the latest periodic sample has high-frequency samples
+    c2Ptr->wait();
+    c1Ptr->wait();
+
+    c.stop();
+
+    auto doc = c.getMostRecentPeriodicDocument();
+    ASSERT_TRUE(doc.hasField("mock"));
+
+    auto samples = doc[kFTDCHighFrequencyField].Array();
+    ASSERT_EQUALS(samples.size(), 4UL);
+    for (auto&& sample : samples) {
+        ASSERT_EQUALS(sample.Obj()["mock"]["name"].String(), "joe");
+    }
+}
+
 }  // namespace mongo
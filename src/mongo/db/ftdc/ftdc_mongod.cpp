@@ -33,6 +33,7 @@
 
 #include <boost/filesystem.hpp>
 
+#include "mongo/db/concurrency/locker.h"
 #include "mongo/db/ftdc/constants.h"
 #include "mongo/db/ftdc/controller.h"
 #include "mongo/db/ftdc/ftdc_server.h"
@@ -42,7 +43,24 @@
 namespace mongo {
 
 namespace {
+
+/**
+ * A high-frequency FTDC Collector for the read and write tickets of the global lock.
+ */
+class FTDCTicketsCollector : public FTDCCollectorInterface {
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        Locker::appendGlobalThrottlingStats(&builder);
+    }
+
+    std::string name() const final {
+        return "tickets";
+    }
+};
+
 void registerMongoDCollectors(FTDCController* controller) {
+    controller->addHighFrequencyCollector(std::make_unique<FTDCTicketsCollector>());
+
     // These metrics are only collected if replication is enabled
     if (repl::ReplicationCoordinator::get(getGlobalServiceContext())->getReplicationMode() !=
         repl::ReplicationCoordinator::modeNone) {
@@ -31,6 +31,8 @@
 
 #include "mongo/db/ftdc/ftdc_server.h"
 
+#include <algorithm>
+#include <array>
 #include <boost/filesystem.hpp>
 #include <fstream>
 #include <memory>
@@ -38,6 +40,7 @@
 #include "mongo/base/status.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/controller.h"
@@ -117,6 +120,25 @@ Status onUpdateFTDCPeriod(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status validateFTDCHighFrequencyPeriod(const std::int32_t& value) {
+    if (value != 0 && (value < 10 || value > 1000)) {
+        return Status(ErrorCodes::BadValue,
+                      "diagnosticDataCollectionHighFrequencyPeriodMillis must be 0 to disable "
+                      "high-frequency sampling, or between 10 and 1000");
+    }
+
+    return Status::OK();
+}
+
+Status onUpdateFTDCHighFrequencyPeriod(const std::int32_t potentialNewValue) {
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setHighFrequencyPeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
 Status onUpdateFTDCDirectorySize(const std::int32_t potentialNewValue) {
     if (potentialNewValue < ftdcStartupParams.maxFileSizeMB.load()) {
         return Status(
@@ -231,6 +253,10 @@ public:
         // frequent schema changes.
         commandBuilder.append("transactions", BSON("includeLastCommitted" << false));
 
+        // Exclude 'serverStatus.locks.hotResources' because the set of resources it lists changes
+        // with the workload.
+        commandBuilder.append("locks", BSON("includeHotResources" << false));
+
         if (gDiagnosticDataCollectionEnableLatencyHistograms.load()) {
             BSONObjBuilder subObjBuilder(commandBuilder.subobjStart("opLatencies"));
             subObjBuilder.append("histograms", true);
@@ -268,6 +294,36 @@ private:
     bool _serverShuttingDown;
 };
 
+/**
+ * A FTDC Collector for the serverStatus sections that are cheap enough to sample at the
+ * high-frequency period. The sections are generated directly, since running serverStatus would
+ * also generate every other section.
+ */
+class FTDCHighFrequencyServerStatusCollector : public FTDCCollectorInterface {
+private:
+    constexpr static StringData kName = "serverStatus"_sd;
+
+    // "connections" has the number of open and active connections, and "globalLock" has the
+    // number of clients queued for and holding the global lock.
+    constexpr static std::array<StringData, 2> kSections{"connections"_sd, "globalLock"_sd};
+
+public:
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        auto registry = ServerStatusSectionRegistry::get();
+        for (auto i = registry->begin(); i != registry->end(); ++i) {
+            ServerStatusSection* section = i->second;
+            if (std::find(kSections.begin(), kSections.end(), section->getSectionName()) !=
+                kSections.end()) {
+                section->appendSection(opCtx, BSONElement(), &builder);
+            }
+        }
+    }
+
+    std::string name() const final {
+        return kName.toString();
+    }
+};
+
 // Register the FTDC system
 // Note: This must be run before the server parameters are parsed during startup
 // so that the FTDCController is initialized.
@@ -277,6 +333,7 @@ void startFTDC(boost::filesystem::path& path,
                RegisterCollectorsFunction registerCollectors) {
     FTDCConfig config;
     config.period = Milliseconds(ftdcStartupParams.periodMillis.load());
+    config.highFrequencyPeriod = Milliseconds(ftdcStartupParams.highFrequencyPeriodMillis.load());
     // Only enable FTDC if our caller says to enable FTDC, MongoS may not have a valid path to write
     // files to so update the diagnosticDataCollectionEnabled set parameter to reflect that.
     ftdcStartupParams.enabled.store(startupMode == FTDCStartMode::kStart &&
@@ -299,6 +356,11 @@ void startFTDC(boost::filesystem::path& path,
     // GetDiagnosticDataCommand
     controller->addPeriodicCollector(std::make_unique<FTDCServerStatusCommandCollector>());
 
+    // Install high-frequency collectors
+    // These are sampled on the high-frequency period in FTDCConfig, if it is set.
+    controller->addHighFrequencyCollector(
+        std::make_unique<FTDCHighFrequencyServerStatusCollector>());
+
     registerCollectors(controller.get());
 
     // Install System Metric Collector as a periodic collector
@@ -106,6 +106,7 @@ private:
 struct FTDCStartupParams {
     AtomicWord<bool> enabled;
     AtomicWord<int> periodMillis;
+    AtomicWord<int> highFrequencyPeriodMillis;
 
     AtomicWord<int> maxDirectorySizeMB;
     AtomicWord<int> maxFileSizeMB;
@@ -115,6 +116,7 @@ struct FTDCStartupParams {
     FTDCStartupParams()
         : enabled(FTDCConfig::kEnabledDefault),
           periodMillis(FTDCConfig::kPeriodMillisDefault),
+          highFrequencyPeriodMillis(FTDCConfig::kHighFrequencyPeriodMillisDefault),
           // Scale the values down since are defaults are in bytes, but the user interface is MB
           maxDirectorySizeMB(FTDCConfig::kMaxDirectorySizeBytesDefault / (1024 * 1024)),
           maxFileSizeMB(FTDCConfig::kMaxFileSizeBytesDefault / (1024 * 1024)),
@@ -129,6 +131,8 @@ extern FTDCStartupParams ftdcStartupParams;
  */
 Status onUpdateFTDCEnabled(bool value);
 Status onUpdateFTDCPeriod(std::int32_t value);
+Status validateFTDCHighFrequencyPeriod(const std::int32_t& value);
+Status onUpdateFTDCHighFrequencyPeriod(std::int32_t value);
 Status onUpdateFTDCDirectorySize(std::int32_t value);
 Status onUpdateFTDCFileSize(std::int32_t value);
 Status onUpdateFTDCSamplesPerChunk(std::int32_t value);
@@ -64,7 +64,10 @@ const char kFTDCDocsField[] = "docs";
 const char kFTDCCollectStartField[] = "start";
 const char kFTDCCollectEndField[] = "end";
 
+const char kFTDCHighFrequencyField[] = "highFrequency";
+
 const std::int64_t FTDCConfig::kPeriodMillisDefault = 1000;
+const std::int64_t FTDCConfig::kHighFrequencyPeriodMillisDefault = 0;
 
 const std::size_t kMaxRecursion = 10;
 
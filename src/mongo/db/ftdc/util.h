@@ -40,6 +40,7 @@
 namespace mongo {
 
 constexpr StringData kFTDCThreadName = "ftdc"_sd;
+constexpr StringData kFTDCHighFrequencyThreadName = "ftdcHighFrequency"_sd;
 
 /**
  * Utilities for inflating and deflating BSON documents and metric arrays
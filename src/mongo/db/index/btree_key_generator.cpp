@@ -29,6 +29,7 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <memory>
 
@@ -170,11 +171,12 @@ void BtreeKeyGenerator::_getKeysArrEltFixed(const std::vector<const char*>& fiel
                                             KeyStringSet::sequence_type* keys,
                                             unsigned numNotFound,
                                             const BSONElement& arrObjElt,
-                                            const std::set<size_t>& arrIdxs,
+                                            const ArrayFieldIndexes& arrIdxs,
                                             bool mayExpandArrayUnembedded,
                                             const std::vector<PositionalPathInfo>& positionalInfo,
                                             MultikeyPaths* multikeyPaths,
-                                            boost::optional<RecordId> id) const {
+                                            boost::optional<RecordId> id,
+                                            CollationKeyCache* collationKeys) const {
     // fieldNamesTemp and fixedTemp are passed in by the caller to be used as temporary data
     // structures as we need them to be mutable in the recursion. When they are stored outside we
     // can reuse their memory.
@@ -201,7 +203,8 @@ void BtreeKeyGenerator::_getKeysArrEltFixed(const std::vector<const char*>& fiel
                       numNotFound,
                       positionalInfo,
                       multikeyPaths,
-                      id);
+                      id,
+                      collationKeys);
 }
 
 void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
@@ -209,7 +212,67 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
                                 bool skipMultikey,
                                 KeyStringSet* keys,
                                 MultikeyPaths* multikeyPaths,
-                                boost::optional<RecordId> id) const {
+                                boost::optional<RecordId> id,
+                                CollationKeyCache* collationKeys) const {
+    invariant(!collationKeys || collationKeys->getCollator() == _collator);
+    KeyGenerationScratch scratch;
+    _getKeys(
+        pooledBufferBuilder, obj, skipMultikey, keys, multikeyPaths, id, &scratch, collationKeys);
+}
+
+void BtreeKeyGenerator::getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                        const std::vector<BSONObj>& objs,
+                                        bool skipMultikey,
+                                        std::vector<KeyStringSet>* keys,
+                                        std::vector<MultikeyPaths>* multikeyPaths,
+                                        const std::vector<RecordId>* ids) const {
+    invariant(!ids || ids->size() == objs.size());
+
+    keys->resize(objs.size());
+    if (multikeyPaths) {
+        multikeyPaths->resize(objs.size());
+    }
+
+    KeyGenerationScratch scratch;
+    size_t expectedNumKeys = 0;
+    for (size_t i = 0; i < objs.size(); ++i) {
+        auto& docKeys = (*keys)[i];
+        docKeys.clear();
+        docKeys.reserve(expectedNumKeys);
+
+        MultikeyPaths* docMultikeyPaths = nullptr;
+        if (multikeyPaths) {
+            docMultikeyPaths = &(*multikeyPaths)[i];
+            docMultikeyPaths->clear();
+        }
+
+        _getKeys(pooledBufferBuilder,
+                 objs[i],
+                 skipMultikey,
+                 &docKeys,
+                 docMultikeyPaths,
+                 ids ? boost::make_optional((*ids)[i]) : boost::none,
+                 &scratch,
+                 nullptr);
+        expectedNumKeys = docKeys.size();
+    }
+}
+
+void BtreeKeyGenerator::_getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                 const BSONObj& obj,
+                                 bool skipMultikey,
+                                 KeyStringSet* keys,
+                                 MultikeyPaths* multikeyPaths,
+                                 boost::optional<RecordId> id,
+                                 KeyGenerationScratch* scratch,
+                                 CollationKeyCache* collationKeys) const {
+    if (_collator && !collationKeys) {
+        if (!scratch->collationKeys) {
+            scratch->collationKeys = std::make_unique<CollationKeyCache>(_collator);
+        }
+        collationKeys = scratch->collationKeys.get();
+    }
+
     if (_isIdIndex) {
         // we special case for speed
         BSONElement e = obj["_id"];
@@ -217,14 +280,7 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
             keys->insert(_nullKeyString);
         } else {
             KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
-
-            if (_collator) {
-                keyString.appendBSONElement(e, [&](StringData stringData) {
-                    return _collator->getComparisonString(stringData);
-                });
-            } else {
-                keyString.appendBSONElement(e);
-            }
+            _appendElement(&keyString, e, collationKeys);
 
             if (id) {
                 keyString.appendRecordId(*id);
@@ -245,7 +301,7 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
             invariant(multikeyPaths->empty());
             multikeyPaths->resize(_fieldNames.size());
         }
-        _getKeysWithoutArray(pooledBufferBuilder, obj, id, keys);
+        _getKeysWithoutArray(pooledBufferBuilder, obj, id, keys, collationKeys);
     } else {
         if (multikeyPaths) {
             invariant(multikeyPaths->empty());
@@ -255,17 +311,18 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
         // inserting element by element if array
         auto seq = keys->extract_sequence();
         // '_fieldNames' and '_fixed' are mutated by _getKeysWithArray so pass in copies
-        auto fieldNamesCopy = _fieldNames;
-        auto fixedCopy = _fixed;
-        _getKeysWithArray(&fieldNamesCopy,
-                          &fixedCopy,
+        scratch->fieldNames.assign(_fieldNames.begin(), _fieldNames.end());
+        scratch->fixed.assign(_fixed.begin(), _fixed.end());
+        _getKeysWithArray(&scratch->fieldNames,
+                          &scratch->fixed,
                           pooledBufferBuilder,
                           obj,
                           &seq,
                           0,
                           _emptyPositionalInfo,
                           multikeyPaths,
-                          id);
+                          id,
+                          collationKeys);
         // Put the sequence back into the set, it will sort and guarantee uniqueness, this is
         // O(NlogN)
         keys->adopt_sequence(std::move(seq));
@@ -276,10 +333,24 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
     }
 }
 
+void BtreeKeyGenerator::_appendElement(KeyString::PooledBuilder* keyString,
+                                       const BSONElement& elem,
+                                       CollationKeyCache* collationKeys) const {
+    if (!_collator) {
+        keyString->appendBSONElement(elem);
+        return;
+    }
+
+    keyString->appendBSONElement(elem, [&](StringData stringData) {
+        return collationKeys->getComparisonKeyData(stringData).toString();
+    });
+}
+
 void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                              const BSONObj& obj,
                                              boost::optional<RecordId> id,
-                                             KeyStringSet* keys) const {
+                                             KeyStringSet* keys,
+                                             CollationKeyCache* collationKeys) const {
 
     KeyString::PooledBuilder keyString{pooledBufferBuilder, _keyStringVersion, _ordering};
     size_t numNotFound{0};
@@ -290,13 +361,7 @@ void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooled
             ++numNotFound;
         }
 
-        if (_collator) {
-            keyString.appendBSONElement(elem, [&](StringData stringData) {
-                return _collator->getComparisonString(stringData);
-            });
-        } else {
-            keyString.appendBSONElement(elem);
-        }
+        _appendElement(&keyString, elem, collationKeys);
     }
 
     if (_isSparse && numNotFound == _fieldNames.size()) {
@@ -317,12 +382,13 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                                           unsigned numNotFound,
                                           const std::vector<PositionalPathInfo>& positionalInfo,
                                           MultikeyPaths* multikeyPaths,
-                                          boost::optional<RecordId> id) const {
+                                          boost::optional<RecordId> id,
+                                          CollationKeyCache* collationKeys) const {
     BSONElement arrElt;
 
     // A set containing the position of any indexed fields in the key pattern that traverse through
     // the 'arrElt' array value.
-    std::set<size_t> arrIdxs;
+    ArrayFieldIndexes arrIdxs;
 
     // A vector with size equal to the number of elements in the index key pattern. Each element in
     // the vector, if initialized, refers to the component within the indexed field that traverses
@@ -344,7 +410,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
     // path "a.b" causes the index to be multikey, but the key pattern "a.b.0" only indexes the
     // first element of the array, so we'd have a
     // std::vector<boost::optional<size_t>>{{1U}, boost::none}.
-    std::vector<boost::optional<size_t>> arrComponents(fieldNames->size());
+    boost::container::small_vector<boost::optional<size_t>, kFewCompoundIndexFields> arrComponents(
+        fieldNames->size());
 
     bool mayExpandArrayUnembedded = true;
     for (size_t i = 0; i < fieldNames->size(); ++i) {
@@ -364,7 +431,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
             (*fieldNames)[i] = "";
             numNotFound++;
         } else if (e.type() == Array) {
-            arrIdxs.insert(i);
+            // The fields are visited in order, so 'arrIdxs' stays sorted.
+            arrIdxs.push_back(i);
             if (arrElt.eoo()) {
                 // we only expand arrays on a single path -- track the path here
                 arrElt = e;
@@ -388,13 +456,7 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
         }
         KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
         for (const auto& elem : *fixed) {
-            if (_collator) {
-                keyString.appendBSONElement(elem, [&](StringData stringData) {
-                    return _collator->getComparisonString(stringData);
-                });
-            } else {
-                keyString.appendBSONElement(elem);
-            }
+            _appendElement(&keyString, elem, collationKeys);
         }
         if (id) {
             keyString.appendRecordId(*id);
@@ -433,7 +495,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                             true,
                             _emptyPositionalInfo,
                             multikeyPaths,
-                            id);
+                            id,
+                            collationKeys);
     } else {
         BSONObj arrObj = arrElt.embeddedObject();
 
@@ -443,7 +506,7 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
         // array element).
         std::vector<PositionalPathInfo> subPositionalInfo(fixed->size());
         for (size_t i = 0; i < fieldNames->size(); ++i) {
-            const bool fieldIsArray = arrIdxs.find(i) != arrIdxs.end();
+            const bool fieldIsArray = std::find(arrIdxs.begin(), arrIdxs.end(), i) != arrIdxs.end();
 
             if (*(*fieldNames)[i] == '\0') {
                 // We've reached the end of the path.
@@ -521,7 +584,8 @@ void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
                                 mayExpandArrayUnembedded,
                                 subPositionalInfo,
                                 multikeyPaths,
-                                id);
+                                id,
+                                collationKeys);
         }
     }
 
@@ -29,14 +29,15 @@
 
 #pragma once
 
+#include <boost/container/small_vector.hpp>
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "mongo/bson/bsonobj_comparator_interface.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/query/collation/collation_key_cache.h"
 #include "mongo/db/storage/key_string.h"
 
 namespace mongo {
@@ -74,15 +75,56 @@ public:
      * 'true' to be able to use an optimized algorithm for the index key generation. Otherwise,
      * this parameter must be set to 'false'. In this case a generic algorithm will be used, which
      * can handle both multikey and non-multikey indexes.
+     *
+     * If this index has a collation, the caller may pass a 'collationKeys' cache for that collator
+     * to reuse the comparison keys of strings across calls, e.g. to generate the sort keys of all
+     * the documents of an operation.
      */
     void getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
                  const BSONObj& obj,
                  bool skipMultikey,
                  KeyStringSet* keys,
                  MultikeyPaths* multikeyPaths,
-                 boost::optional<RecordId> id = boost::none) const;
+                 boost::optional<RecordId> id = boost::none,
+                 CollationKeyCache* collationKeys = nullptr) const;
+
+    /**
+     * Generates the index keys for each document in 'objs' as getKeys() does, and stores the keys
+     * of 'objs[i]' in '(*keys)[i]'. If 'multikeyPaths' is non-null, the multikey paths of
+     * 'objs[i]' are stored in '(*multikeyPaths)[i]'. If 'ids' is non-null, it must hold the
+     * RecordId of every document in 'objs', which is appended to its keys.
+     *
+     * The output vectors are resized to the number of documents. Their elements are cleared
+     * first, so the same vectors can be passed for consecutive batches to reuse their memory.
+     *
+     * Generating the keys of many documents in one call reuses the scratch space of the key
+     * generator across documents, and sizes the keys of each document for the number of keys of
+     * the previous one, which avoids most reallocations for documents of a similar shape. With a
+     * collation, the comparison keys of strings which repeat across the batch are computed once.
+     */
+    void getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                         const std::vector<BSONObj>& objs,
+                         bool skipMultikey,
+                         std::vector<KeyStringSet>* keys,
+                         std::vector<MultikeyPaths>* multikeyPaths,
+                         const std::vector<RecordId>* ids = nullptr) const;
 
 private:
+    // The positions of the indexed fields which traverse an array value. Most key patterns have
+    // few fields, so this rarely allocates, even though one is needed for every array element.
+    using ArrayFieldIndexes = boost::container::small_vector<size_t, kFewCompoundIndexFields>;
+
+    // Copies of '_fieldNames' and '_fixed', which are mutated while generating the keys of a
+    // document. Kept outside of the key generation, so that their memory can be reused when
+    // generating the keys of several documents.
+    struct KeyGenerationScratch {
+        std::vector<const char*> fieldNames;
+        std::vector<BSONElement> fixed;
+
+        // Only created for indexes with a collation, when the caller did not provide a cache.
+        std::unique_ptr<CollationKeyCache> collationKeys;
+    };
+
     /**
      * Stores info regarding traversal of a positional path. A path through a document is
      * considered positional if this path element names an array element. Generally this means
@@ -136,6 +178,26 @@ private:
         const char* remainingPath;
     };
 
+    /**
+     * Shared implementation of getKeys() and getKeysForBatch().
+     */
+    void _getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                  const BSONObj& obj,
+                  bool skipMultikey,
+                  KeyStringSet* keys,
+                  MultikeyPaths* multikeyPaths,
+                  boost::optional<RecordId> id,
+                  KeyGenerationScratch* scratch,
+                  CollationKeyCache* collationKeys) const;
+
+    /**
+     * Appends 'elem' to 'keyString', translating its strings to comparison keys through
+     * 'collationKeys' if this index has a collation.
+     */
+    void _appendElement(KeyString::PooledBuilder* keyString,
+                        const BSONElement& elem,
+                        CollationKeyCache* collationKeys) const;
+
     /**
      * This recursive method does the heavy-lifting for getKeys().
      * It will modify 'fieldNames' and 'fixed'.
@@ -148,7 +210,8 @@ private:
                            unsigned numNotFound,
                            const std::vector<PositionalPathInfo>& positionalInfo,
                            MultikeyPaths* multikeyPaths,
-                           boost::optional<RecordId> id) const;
+                           boost::optional<RecordId> id,
+                           CollationKeyCache* collationKeys) const;
 
     /**
      * An optimized version of the key generation algorithm to be used when it is known that 'obj'
@@ -157,7 +220,8 @@ private:
     void _getKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                               const BSONObj& obj,
                               boost::optional<RecordId> id,
-                              KeyStringSet* keys) const;
+                              KeyStringSet* keys,
+                              CollationKeyCache* collationKeys) const;
 
     /**
      * A call to _getKeysWithArray() begins by calling this for each field in the key pattern. It
@@ -213,11 +277,12 @@ private:
                              KeyStringSet::sequence_type* keys,
                              unsigned numNotFound,
                              const BSONElement& arrObjElt,
-                             const std::set<size_t>& arrIdxs,
+                             const ArrayFieldIndexes& arrIdxs,
                              bool mayExpandArrayUnembedded,
                              const std::vector<PositionalPathInfo>& positionalInfo,
                              MultikeyPaths* multikeyPaths,
-                             boost::optional<RecordId> id) const;
+                             boost::optional<RecordId> id,
+                             CollationKeyCache* collationKeys) const;
 
     KeyString::Value _buildNullKeyString() const;
 
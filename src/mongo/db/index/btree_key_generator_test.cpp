@@ -1421,4 +1421,52 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeysForBatchMatchesKeysOfEachDocument) {
+    BtreeKeyGenerator keyGen({"a", "b.c"},
+                             {BSONElement(), BSONElement()},
+                             false,
+                             nullptr,
+                             KeyString::Version::kLatestVersion,
+                             Ordering::make(BSONObj()));
+
+    std::vector<BSONObj> docs{fromjson("{a: [1, 2, 3], b: {c: 4}}"),
+                              fromjson("{a: 1, b: [{c: 2}, {c: 3}]}"),
+                              fromjson("{b: {c: 'x'}}"),
+                              fromjson("{a: [], b: []}"),
+                              fromjson("{a: [1, 2, 3, 4, 5, 6], b: {c: [7, 7]}}"),
+                              fromjson("{a: 5}")};
+    std::vector<RecordId> ids;
+    for (size_t i = 0; i < docs.size(); ++i) {
+        ids.emplace_back(static_cast<int64_t>(i + 1));
+    }
+
+    SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
+    std::vector<KeyStringSet> batchKeys;
+    std::vector<MultikeyPaths> batchMultikeyPaths;
+    auto assertBatchMatchesEachDocument = [&](size_t numDocs) {
+        std::vector<BSONObj> batchDocs(docs.begin(), docs.begin() + numDocs);
+        std::vector<RecordId> batchIds(ids.begin(), ids.begin() + numDocs);
+        keyGen.getKeysForBatch(
+            allocator, batchDocs, false, &batchKeys, &batchMultikeyPaths, &batchIds);
+        ASSERT_EQ(numDocs, batchKeys.size());
+        ASSERT_EQ(numDocs, batchMultikeyPaths.size());
+
+        for (size_t i = 0; i < numDocs; ++i) {
+            KeyStringSet keys;
+            MultikeyPaths multikeyPaths;
+            keyGen.getKeys(allocator, batchDocs[i], false, &keys, &multikeyPaths, batchIds[i]);
+            ASSERT(keysetsEqual(keys, batchKeys[i]))
+                << "expected: " << dumpKeyset(keys) << ", actual: " << dumpKeyset(batchKeys[i]);
+            ASSERT(multikeyPaths == batchMultikeyPaths[i])
+                << "expected: " << dumpMultikeyPaths(multikeyPaths)
+                << ", actual: " << dumpMultikeyPaths(batchMultikeyPaths[i]);
+        }
+    };
+
+    assertBatchMatchesEachDocument(docs.size());
+
+    // Reusing the output of a larger batch must not leave keys of the previous batch behind.
+    assertBatchMatchesEachDocument(2);
+}
+
 }  // namespace
@@ -0,0 +1,227 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_key_generator.h"
+
+#include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/bson/util/bsoncolumnbuilder.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/db/jsobj.h"
+
+namespace mongo {
+namespace {
+
+const BSONObj kRowMarkerPath = BSON("" << MINKEY);
+
+/**
+ * Returns the value at 'path' in 'obj', only traversing sub-objects, or EOO if there is none.
+ */
+BSONElement getValueAtPath(const BSONObj& obj, const FieldRef& path) {
+    BSONElement elem;
+    BSONObj current = obj;
+    for (FieldIndex i = 0; i < path.numParts(); ++i) {
+        elem = current[path.getPart(i)];
+        if (i + 1 < path.numParts()) {
+            if (elem.type() != BSONType::Object) {
+                return BSONElement();
+            }
+            current = elem.Obj();
+        }
+    }
+    return elem;
+}
+
+/**
+ * Returns true if the elements of 'arr' can be appended to a BSONColumnBuilder.
+ */
+bool canCompressArrayElements(const BSONObj& arr) {
+    for (auto&& elem : arr) {
+        if (elem.type() == BSONType::MinKey || elem.type() == BSONType::MaxKey) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+ColumnKeyGenerator::ColumnKeyGenerator(BSONObj keyPattern,
+                                       KeyString::Version keyStringVersion,
+                                       Ordering ordering)
+    : _keyStringVersion(keyStringVersion), _ordering(ordering) {
+    invariant(keyPattern.nFields() == 1);
+    auto fieldName = keyPattern.firstElementFieldNameStringData();
+    if (fieldName != kAllPathsFieldName) {
+        _path = fieldName.toString();
+    }
+}
+
+bool ColumnKeyGenerator::isPathIndexed(StringData path) const {
+    return !_path || *_path == path;
+}
+
+void ColumnKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                      const BSONObj& obj,
+                                      KeyStringSet* keys,
+                                      const RecordId& id) const {
+    uassert(ErrorCodes::BadValue,
+            "Columnstore indexes can only index documents with a RecordId of type long",
+            id.isLong());
+
+    auto keysSequence = keys->extract_sequence();
+
+    // Every document has a row marker, even if it has no value for any of the indexed paths.
+    KeyString::PooledBuilder rowMarker(pooledBufferBuilder, _keyStringVersion, _ordering);
+    rowMarker.appendBSONElement(kRowMarkerPath.firstElement());
+    rowMarker.appendNumberLong(id.getLong());
+    rowMarker.appendRecordId(id);
+    keysSequence.push_back(rowMarker.release());
+
+    if (_path) {
+        auto value = getValueAtPath(obj, FieldRef(*_path));
+        if (!value.eoo()) {
+            _appendKey(pooledBufferBuilder, *_path, value, id, &keysSequence);
+        }
+    } else {
+        std::string pathPrefix;
+        _appendCellsForObject(pooledBufferBuilder, obj, &pathPrefix, id, &keysSequence);
+    }
+
+    keys->adopt_sequence(std::move(keysSequence));
+}
+
+void ColumnKeyGenerator::_appendCellsForObject(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                               const BSONObj& obj,
+                                               std::string* pathPrefix,
+                                               const RecordId& id,
+                                               KeyStringSet::sequence_type* keys) const {
+    const auto prefixSize = pathPrefix->size();
+    for (auto&& elem : obj) {
+        if (prefixSize) {
+            pathPrefix->push_back('.');
+        }
+        pathPrefix->append(elem.fieldName(), elem.fieldNameSize() - 1);
+
+        _appendKey(pooledBufferBuilder, *pathPrefix, elem, id, keys);
+        if (elem.type() == BSONType::Object) {
+            _appendCellsForObject(pooledBufferBuilder, elem.Obj(), pathPrefix, id, keys);
+        }
+
+        pathPrefix->resize(prefixSize);
+    }
+}
+
+void ColumnKeyGenerator::_appendKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                    StringData path,
+                                    BSONElement value,
+                                    const RecordId& id,
+                                    KeyStringSet::sequence_type* keys) const {
+    KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
+    keyString.appendString(path);
+    keyString.appendNumberLong(id.getLong());
+
+    // Arrays of homogeneous values, such as series of measurements, usually compress well with
+    // delta encoding. Only use the compressed form if it is actually smaller.
+    if (value.type() == BSONType::Array && canCompressArrayElements(value.Obj())) {
+        BSONColumnBuilder column(""_sd);
+        for (auto&& elem : value.Obj()) {
+            column.append(elem);
+        }
+        BSONBinData binary = column.finalize();
+        if (binary.length < value.valuesize()) {
+            keyString.appendNumberLong(static_cast<long long>(CellKind::kCompressedArray));
+            keyString.appendBinData(binary);
+            keyString.appendRecordId(id);
+            keys->push_back(keyString.release());
+            return;
+        }
+    }
+
+    keyString.appendNumberLong(static_cast<long long>(CellKind::kValue));
+    keyString.appendBSONElement(value);
+    keyString.appendRecordId(id);
+    keys->push_back(keyString.release());
+}
+
+KeyString::Value ColumnKeyGenerator::makeSeekKey(KeyString::Version keyStringVersion,
+                                                 Ordering ordering,
+                                                 boost::optional<StringData> path,
+                                                 long long id) {
+    KeyString::Builder keyString(keyStringVersion, ordering);
+    if (path) {
+        keyString.appendString(*path);
+    } else {
+        keyString.appendBSONElement(kRowMarkerPath.firstElement());
+    }
+    keyString.appendNumberLong(id);
+    keyString.appendDiscriminator(KeyString::Discriminator::kExclusiveBefore);
+    return keyString.getValueCopy();
+}
+
+ColumnKeyGenerator::Cell ColumnKeyGenerator::decodeCell(const KeyString::Value& keyString,
+                                                        Ordering ordering) {
+    Cell cell;
+    cell.owned = KeyString::toBson(keyString, ordering);
+
+    BSONObjIterator it(cell.owned);
+    auto pathElem = it.next();
+    cell.recordId = RecordId(it.next().numberLong());
+    if (pathElem.type() == BSONType::MinKey) {
+        return cell;
+    }
+
+    const auto kind = static_cast<CellKind>(it.next().numberLong());
+    auto valueElem = it.next();
+    if (kind == CellKind::kValue) {
+        cell.path = pathElem.valueStringData();
+        cell.value = valueElem;
+        return cell;
+    }
+
+    invariant(kind == CellKind::kCompressedArray);
+    BSONObjBuilder builder;
+    builder.append(pathElem);
+    {
+        BSONArrayBuilder arr(builder.subarrayStart(""));
+        BSONColumn column(valueElem);
+        for (auto&& elem : column) {
+            arr.append(elem);
+        }
+    }
+    cell.owned = builder.obj();
+
+    BSONObjIterator ownedIt(cell.owned);
+    cell.path = ownedIt.next().valueStringData();
+    cell.value = ownedIt.next();
+    return cell;
+}
+
+}  // namespace mongo
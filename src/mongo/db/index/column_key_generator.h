@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/ordering.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+/**
+ * Generates the keys of a columnstore index. A columnstore index is created with either
+ * { "$**": "columnstore" }, which stores a column for every path in the documents, or with
+ * { "path.to.field": "columnstore" }, which stores a single column.
+ *
+ * Every document contributes one "cell" per indexed path it has a value for, in the format:
+ *      { '': 'path.to.field', '': <RecordId>, '': <CellKind>, '': <value> }
+ * The value at a path is the one reached by traversing sub-objects only; a path going through an
+ * array has no value, but the array itself is stored at its own path. When all paths are indexed,
+ * every path reaching a sub-object is stored as well, so that a reader never needs to reassemble
+ * an object from the cells of its sub-paths.
+ *
+ * Every document also contributes one row marker, { '': MinKey, '': <RecordId> }, so that the rows
+ * of the index can be enumerated without reading any column.
+ *
+ * Since the RecordId comes right after the path, the cells of one path are sorted by RecordId. A
+ * reader can therefore scan only the columns it needs and zip them together by RecordId. Arrays
+ * are stored compressed with BSONColumn when that makes them smaller.
+ */
+class ColumnKeyGenerator {
+public:
+    static constexpr StringData kAllPathsFieldName = "$**"_sd;
+
+    /**
+     * Describes how the value of a cell is stored.
+     */
+    enum class CellKind : int {
+        // The value is stored as is.
+        kValue = 0,
+        // The value is an array whose elements are stored in a BSONColumn binary.
+        kCompressedArray = 1,
+    };
+
+    /**
+     * A decoded index entry. For row markers, 'path' is boost::none and 'value' is EOO. All the
+     * data is owned by 'owned'.
+     */
+    struct Cell {
+        boost::optional<StringData> path;
+        RecordId recordId;
+        BSONElement value;
+        BSONObj owned;
+    };
+
+    ColumnKeyGenerator(BSONObj keyPattern, KeyString::Version keyStringVersion, Ordering ordering);
+
+    /**
+     * Returns true if this index stores a column for every path.
+     */
+    bool indexesAllPaths() const {
+        return !_path;
+    }
+
+    /**
+     * Returns true if this index stores a column for 'path'.
+     */
+    bool isPathIndexed(StringData path) const;
+
+    /**
+     * Adds the row marker and the cells of 'obj' to 'keys'. Only documents whose RecordId is a long
+     * can be indexed.
+     */
+    void generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                      const BSONObj& obj,
+                      KeyStringSet* keys,
+                      const RecordId& id) const;
+
+    /**
+     * Returns a key sorting right before the cell of 'path' for the record 'id'. If 'path' is
+     * boost::none the key sorts right before the row marker of the record 'id' instead.
+     */
+    static KeyString::Value makeSeekKey(KeyString::Version keyStringVersion,
+                                        Ordering ordering,
+                                        boost::optional<StringData> path,
+                                        long long id);
+
+    /**
+     * Decodes an index entry produced by generateKeys().
+     */
+    static Cell decodeCell(const KeyString::Value& keyString, Ordering ordering);
+
+private:
+    void _appendKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                    StringData path,
+                    BSONElement value,
+                    const RecordId& id,
+                    KeyStringSet::sequence_type* keys) const;
+
+    void _appendCellsForObject(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                               const BSONObj& obj,
+                               std::string* pathPrefix,
+                               const RecordId& id,
+                               KeyStringSet::sequence_type* keys) const;
+
+    // The indexed path, or boost::none if all paths are indexed.
+    boost::optional<std::string> _path;
+    const KeyString::Version _keyStringVersion;
+    const Ordering _ordering;
+};
+
+}  // namespace mongo
@@ -0,0 +1,225 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const Ordering kOrdering = Ordering::make(BSONObj());
+
+struct ColumnKeyGeneratorTest : public unittest::Test {
+    /**
+     * Generates the keys of 'doc' and returns them decoded, in index order.
+     */
+    std::vector<ColumnKeyGenerator::Cell> generateCells(const ColumnKeyGenerator& keyGen,
+                                                        const BSONObj& doc,
+                                                        RecordId id = RecordId(1)) {
+        KeyStringSet keys;
+        keyGen.generateKeys(allocator, doc, &keys, id);
+
+        std::vector<ColumnKeyGenerator::Cell> cells;
+        for (auto&& key : keys) {
+            cells.push_back(ColumnKeyGenerator::decodeCell(key, kOrdering));
+        }
+        return cells;
+    }
+
+    void assertCell(const ColumnKeyGenerator::Cell& cell,
+                    StringData path,
+                    RecordId id,
+                    const BSONObj& expectedValue) {
+        ASSERT(cell.path);
+        ASSERT_EQ(*cell.path, path);
+        ASSERT_EQ(cell.recordId, id);
+        ASSERT_BSONELT_EQ(cell.value, expectedValue.firstElement());
+    }
+
+    void assertRowMarker(const ColumnKeyGenerator::Cell& cell, RecordId id) {
+        ASSERT_FALSE(cell.path);
+        ASSERT_EQ(cell.recordId, id);
+        ASSERT(cell.value.eoo());
+    }
+
+    SharedBufferFragmentBuilder allocator{KeyString::HeapBuilder::kHeapAllocatorDefaultBytes};
+};
+
+TEST_F(ColumnKeyGeneratorTest, AllPathsProducesRowMarkerAndCellPerPath) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{'$**': 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+    ASSERT(keyGen.indexesAllPaths());
+
+    auto cells = generateCells(keyGen, fromjson("{b: 'x', a: {c: 1, d: [1, 2]}}"));
+    ASSERT_EQ(cells.size(), 5U);
+    assertRowMarker(cells[0], RecordId(1));
+    assertCell(cells[1], "a", RecordId(1), fromjson("{'': {c: 1, d: [1, 2]}}"));
+    assertCell(cells[2], "a.c", RecordId(1), fromjson("{'': 1}"));
+    assertCell(cells[3], "a.d", RecordId(1), fromjson("{'': [1, 2]}"));
+    assertCell(cells[4], "b", RecordId(1), fromjson("{'': 'x'}"));
+}
+
+TEST_F(ColumnKeyGeneratorTest, AllPathsDoesNotTraverseArrays) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{'$**': 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+
+    auto cells = generateCells(keyGen, fromjson("{a: [{b: 1}, {b: 2}]}"));
+    ASSERT_EQ(cells.size(), 2U);
+    assertRowMarker(cells[0], RecordId(1));
+    assertCell(cells[1], "a", RecordId(1), fromjson("{'': [{b: 1}, {b: 2}]}"));
+}
+
+TEST_F(ColumnKeyGeneratorTest, SinglePathOnlyProducesCellForThatPath) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{'a.b': 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+    ASSERT_FALSE(keyGen.indexesAllPaths());
+    ASSERT(keyGen.isPathIndexed("a.b"));
+    ASSERT_FALSE(keyGen.isPathIndexed("a"));
+
+    auto cells = generateCells(keyGen, fromjson("{a: {b: {c: 1}, d: 2}, e: 3}"));
+    ASSERT_EQ(cells.size(), 2U);
+    assertRowMarker(cells[0], RecordId(1));
+    assertCell(cells[1], "a.b", RecordId(1), fromjson("{'': {c: 1}}"));
+}
+
+TEST_F(ColumnKeyGeneratorTest, SinglePathMissingOnlyProducesRowMarker) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{'a.b': 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+
+    auto cells = generateCells(keyGen, fromjson("{a: 1}"));
+    ASSERT_EQ(cells.size(), 1U);
+    assertRowMarker(cells[0], RecordId(1));
+
+    // A path going through an array has no value.
+    cells = generateCells(keyGen, fromjson("{a: [{b: 1}]}"));
+    ASSERT_EQ(cells.size(), 1U);
+    assertRowMarker(cells[0], RecordId(1));
+}
+
+TEST_F(ColumnKeyGeneratorTest, LargeArrayIsCompressedAndRoundTrips) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{a: 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+
+    BSONObjBuilder builder;
+    {
+        BSONArrayBuilder arr(builder.subarrayStart("a"));
+        for (int i = 0; i < 1000; ++i) {
+            arr.append(1000 + i);
+        }
+    }
+    auto doc = builder.obj();
+
+    KeyStringSet keys;
+    keyGen.generateKeys(allocator, doc, &keys, RecordId(7));
+    ASSERT_EQ(keys.size(), 2U);
+
+    // The cell must be smaller than the array it holds.
+    auto& cellKey = *keys.rbegin();
+    ASSERT_LT(cellKey.getSize(), static_cast<size_t>(doc["a"].valuesize()));
+
+    auto cell = ColumnKeyGenerator::decodeCell(cellKey, kOrdering);
+    ASSERT(cell.path);
+    ASSERT_EQ(*cell.path, "a");
+    ASSERT_EQ(cell.recordId, RecordId(7));
+    ASSERT_EQ(cell.value.type(), BSONType::Array);
+    ASSERT_BSONOBJ_EQ(cell.value.Obj(), doc["a"].Obj());
+}
+
+TEST_F(ColumnKeyGeneratorTest, ArrayWithMinKeyIsNotCompressed) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{a: 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+
+    auto cells = generateCells(keyGen, fromjson("{a: [{$minKey: 1}, 1, 2, 3]}"));
+    ASSERT_EQ(cells.size(), 2U);
+    assertCell(cells[1], "a", RecordId(1), fromjson("{'': [{$minKey: 1}, 1, 2, 3]}"));
+}
+
+TEST_F(ColumnKeyGeneratorTest, CellsOfOnePathAreSortedByRecordId) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{'$**': 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+
+    KeyStringSet keys;
+    keyGen.generateKeys(allocator, fromjson("{a: 1, b: 1}"), &keys, RecordId(20));
+    keyGen.generateKeys(allocator, fromjson("{a: 2}"), &keys, RecordId(10));
+
+    std::vector<std::pair<boost::optional<std::string>, RecordId>> order;
+    for (auto&& key : keys) {
+        auto cell = ColumnKeyGenerator::decodeCell(key, kOrdering);
+        order.emplace_back(cell.path ? boost::make_optional(cell.path->toString()) : boost::none,
+                           cell.recordId);
+    }
+
+    decltype(order) expected{{boost::none, RecordId(10)},
+                             {boost::none, RecordId(20)},
+                             {std::string("a"), RecordId(10)},
+                             {std::string("a"), RecordId(20)},
+                             {std::string("b"), RecordId(20)}};
+    ASSERT(order == expected);
+}
+
+TEST_F(ColumnKeyGeneratorTest, SeekKeySortsRightBeforeCell) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{'$**': 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+
+    KeyStringSet keys;
+    keyGen.generateKeys(allocator, fromjson("{a: 1}"), &keys, RecordId(5));
+    ASSERT_EQ(keys.size(), 2U);
+    const auto& rowMarker = *keys.begin();
+    const auto& cell = *keys.rbegin();
+
+    auto seekRow = ColumnKeyGenerator::makeSeekKey(
+        KeyString::Version::kLatestVersion, kOrdering, boost::none, 5);
+    ASSERT_LT(seekRow.compareWithoutRecordIdLong(rowMarker), 0);
+
+    auto seekCell = ColumnKeyGenerator::makeSeekKey(
+        KeyString::Version::kLatestVersion, kOrdering, "a"_sd, 5);
+    ASSERT_GT(seekCell.compareWithoutRecordIdLong(rowMarker), 0);
+    ASSERT_LT(seekCell.compareWithoutRecordIdLong(cell), 0);
+
+    auto seekPastCell = ColumnKeyGenerator::makeSeekKey(
+        KeyString::Version::kLatestVersion, kOrdering, "a"_sd, 6);
+    ASSERT_GT(seekPastCell.compareWithoutRecordIdLong(cell), 0);
+}
+
+TEST_F(ColumnKeyGeneratorTest, RejectsNonLongRecordId) {
+    ColumnKeyGenerator keyGen{
+        fromjson("{'$**': 'columnstore'}"), KeyString::Version::kLatestVersion, kOrdering};
+
+    KeyStringSet keys;
+    ASSERT_THROWS_CODE(
+        keyGen.generateKeys(allocator, fromjson("{a: 1}"), &keys, RecordId("key", 3)),
+        DBException,
+        ErrorCodes::BadValue);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -99,6 +99,14 @@ Status S2GetKeysForElement(const BSONElement& element,
 
     invariant(geoContainer.hasS2Region());
 
+    // Points are indexed at the leaf level, where their covering is exactly the leaf cell that
+    // contains them. Skip the region coverer, which would otherwise descend through every cell
+    // level from the face down to the leaf to find that same cell.
+    if (params.indexVersion >= S2_INDEX_VERSION_3 && geoContainer.isPoint()) {
+        out->push_back(geoContainer.getPoint().cell.id());
+        return Status::OK();
+    }
+
     coverer.GetCovering(geoContainer.getS2Region(), out);
     return Status::OK();
 }
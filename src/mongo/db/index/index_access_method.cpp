@@ -87,7 +87,8 @@ SortOptions makeSortOptions(size_t maxMemoryUsageBytes, StringData dbName) {
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
         .MaxMemoryUsageBytes(maxMemoryUsageBytes)
-        .DBName(dbName.toString());
+        .DBName(dbName.toString())
+        .MergeThreads(maxIndexBuildSortMergeThreads.load());
 }
 
 MultikeyPaths createMultikeyPaths(const std::vector<MultikeyPath>& multikeyPathsVec) {
@@ -486,6 +487,11 @@ Status AbstractIndexAccessMethod::compact(OperationContext* opCtx) {
     return this->_newInterface->compact(opCtx);
 }
 
+StatusWith<bool> AbstractIndexAccessMethod::compactIncrementally(OperationContext* opCtx,
+                                                                 Seconds maxTime) {
+    return this->_newInterface->compactIncrementally(opCtx, maxTime);
+}
+
 class AbstractIndexAccessMethod::BulkBuilderImpl : public IndexAccessMethod::BulkBuilder {
 public:
     BulkBuilderImpl(const IndexCatalogEntry* indexCatalogEntry,
@@ -505,6 +511,20 @@ public:
                   const std::function<void()>& saveCursorBeforeWrite,
                   const std::function<void()>& restoreCursorAfterWrite) final;
 
+    void generateKeys(OperationContext* opCtx,
+                      const CollectionPtr& collection,
+                      const BSONObj& obj,
+                      const RecordId& loc,
+                      const InsertDeleteOptions& options,
+                      GeneratedKeys* generatedKeys) const final;
+
+    Status insertGeneratedKeys(OperationContext* opCtx,
+                               const BSONObj& obj,
+                               const RecordId& loc,
+                               GeneratedKeys&& generatedKeys,
+                               const std::function<void()>& saveCursorBeforeWrite,
+                               const std::function<void()>& restoreCursorAfterWrite) final;
+
     const MultikeyPaths& getMultikeyPaths() const final;
 
     bool isMultikey() const final;
@@ -520,6 +540,24 @@ public:
     Sorter::PersistedState persistDataForShutdown() final;
 
 private:
+    /**
+     * Records the document at 'loc' as skipped, so that the index builder retries its key
+     * generation once the data is consistent.
+     */
+    void _recordSuppressedError(OperationContext* opCtx,
+                                const Status& status,
+                                const BSONObj& obj,
+                                const RecordId& loc,
+                                const std::function<void()>& saveCursorBeforeWrite,
+                                const std::function<void()>& restoreCursorAfterWrite);
+
+    /**
+     * Adds the keys of one document to the sorter and merges its multikey paths into the paths of
+     * the index. The multikey metadata keys of the document must already be in
+     * '_multikeyMetadataKeys'.
+     */
+    void _addKeys(const KeyStringSet& keys, const MultikeyPaths& multikeyPaths);
+
     void _insertMultikeyMetadataKeysIntoSorter();
 
     Sorter* _makeSorter(
@@ -599,52 +637,118 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(
             multikeyPaths.get(),
             loc,
             [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                // If a key generation error was suppressed, record the document as "skipped" so the
-                // index builder can retry at a point when data is consistent.
-                auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
-                if (interceptor && interceptor->getSkippedRecordTracker()) {
-                    LOGV2_DEBUG(20684,
-                                1,
-                                "Recording suppressed key generation error to retry later: "
-                                "{error} on {loc}: {obj}",
-                                "error"_attr = status,
-                                "loc"_attr = loc,
-                                "obj"_attr = redact(obj));
-
-                    // Save and restore the cursor around the write in case it throws a WCE
-                    // internally and causes the cursor to be unpositioned.
-                    saveCursorBeforeWrite();
-                    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
-                    restoreCursorAfterWrite();
-                }
+                _recordSuppressedError(
+                    opCtx, status, obj, loc, saveCursorBeforeWrite, restoreCursorAfterWrite);
             });
     } catch (...) {
         return exceptionToStatus();
     }
 
-    if (!multikeyPaths->empty()) {
+    _addKeys(*keys, *multikeyPaths);
+    return Status::OK();
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::generateKeys(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const BSONObj& obj,
+    const RecordId& loc,
+    const InsertDeleteOptions& options,
+    GeneratedKeys* generatedKeys) const {
+    _indexCatalogEntry->accessMethod()->getKeys(
+        opCtx,
+        collection,
+        StorageExecutionContext::get(opCtx).pooledBufferBuilder(),
+        obj,
+        options.getKeysMode,
+        GetKeysContext::kAddingKeys,
+        &generatedKeys->keys,
+        &generatedKeys->multikeyMetadataKeys,
+        &generatedKeys->multikeyPaths,
+        loc,
+        [&](Status status, const BSONObj&, boost::optional<RecordId>) {
+            // The skipped record tracker writes to a side table, which can only be done once the
+            // keys are inserted.
+            generatedKeys->suppressedError = std::move(status);
+        });
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::insertGeneratedKeys(
+    OperationContext* opCtx,
+    const BSONObj& obj,
+    const RecordId& loc,
+    GeneratedKeys&& generatedKeys,
+    const std::function<void()>& saveCursorBeforeWrite,
+    const std::function<void()>& restoreCursorAfterWrite) {
+    try {
+        if (generatedKeys.suppressedError) {
+            _recordSuppressedError(opCtx,
+                                   *generatedKeys.suppressedError,
+                                   obj,
+                                   loc,
+                                   saveCursorBeforeWrite,
+                                   restoreCursorAfterWrite);
+        }
+
+        _multikeyMetadataKeys.insert(generatedKeys.multikeyMetadataKeys.begin(),
+                                     generatedKeys.multikeyMetadataKeys.end());
+        _addKeys(generatedKeys.keys, generatedKeys.multikeyPaths);
+    } catch (...) {
+        return exceptionToStatus();
+    }
+    return Status::OK();
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_recordSuppressedError(
+    OperationContext* opCtx,
+    const Status& status,
+    const BSONObj& obj,
+    const RecordId& loc,
+    const std::function<void()>& saveCursorBeforeWrite,
+    const std::function<void()>& restoreCursorAfterWrite) {
+    // If a key generation error was suppressed, record the document as "skipped" so the index
+    // builder can retry at a point when data is consistent.
+    auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
+    if (interceptor && interceptor->getSkippedRecordTracker()) {
+        LOGV2_DEBUG(20684,
+                    1,
+                    "Recording suppressed key generation error to retry later: "
+                    "{error} on {loc}: {obj}",
+                    "error"_attr = status,
+                    "loc"_attr = loc,
+                    "obj"_attr = redact(obj));
+
+        // Save and restore the cursor around the write in case it throws a WCE internally and
+        // causes the cursor to be unpositioned.
+        saveCursorBeforeWrite();
+        interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+        restoreCursorAfterWrite();
+    }
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_addKeys(const KeyStringSet& keys,
+                                                          const MultikeyPaths& multikeyPaths) {
+    if (!multikeyPaths.empty()) {
         if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
+            _indexMultikeyPaths = multikeyPaths;
         } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
+            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
                 _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
+                                              multikeyPaths[i].begin(),
+                                              multikeyPaths[i].end());
             }
         }
     }
 
-    for (const auto& keyString : *keys) {
+    for (const auto& keyString : keys) {
         _sorter->add(keyString, mongo::NullValue());
         ++_keysInserted;
     }
 
     _isMultiKey = _isMultiKey ||
         _indexCatalogEntry->accessMethod()->shouldMarkIndexAsMultikey(
-            keys->size(), _multikeyMetadataKeys, *multikeyPaths);
-
-    return Status::OK();
+            keys.size(), _multikeyMetadataKeys, multikeyPaths);
 }
 
 const MultikeyPaths& AbstractIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
@@ -222,6 +222,12 @@ public:
      */
     virtual Status compact(OperationContext* opCtx) = 0;
 
+    /**
+     * Attempt compaction for at most 'maxTime'. Returns true if there was nothing left to compact,
+     * or false if the time limit was reached first.
+     */
+    virtual StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds maxTime) = 0;
+
     /**
      * Sets this index as multikey with the provided paths.
      */
@@ -259,6 +265,47 @@ public:
                               const std::function<void()>& saveCursorBeforeWrite,
                               const std::function<void()>& restoreCursorAfterWrite) = 0;
 
+        /**
+         * The keys generated for a single document by generateKeys(), which have not been added
+         * to the BulkBuilder yet.
+         */
+        struct GeneratedKeys {
+            KeyStringSet keys;
+            KeyStringSet multikeyMetadataKeys;
+            MultikeyPaths multikeyPaths;
+
+            // Set if key generation failed for the document and the error was suppressed because
+            // of the GetKeysMode in the InsertDeleteOptions.
+            boost::optional<Status> suppressedError;
+        };
+
+        /**
+         * Generates the keys of 'obj' without modifying the BulkBuilder, so that keys may be
+         * generated for several documents concurrently, each on its own OperationContext. The
+         * keys are added to the BulkBuilder by a later call to insertGeneratedKeys().
+         */
+        virtual void generateKeys(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  const BSONObj& obj,
+                                  const RecordId& loc,
+                                  const InsertDeleteOptions& options,
+                                  GeneratedKeys* generatedKeys) const = 0;
+
+        /**
+         * Adds the keys produced by generateKeys() for the document 'obj' at 'loc', with the same
+         * effect as insert() of that document. Must not be called concurrently with any other
+         * method modifying the BulkBuilder.
+         *
+         * 'saveCursorBeforeWrite' and 'restoreCursorAfterWrite' are used as for insert().
+         */
+        virtual Status insertGeneratedKeys(
+            OperationContext* opCtx,
+            const BSONObj& obj,
+            const RecordId& loc,
+            GeneratedKeys&& generatedKeys,
+            const std::function<void()>& saveCursorBeforeWrite,
+            const std::function<void()>& restoreCursorAfterWrite) = 0;
+
         virtual const MultikeyPaths& getMultikeyPaths() const = 0;
 
         virtual bool isMultikey() const = 0;
@@ -548,6 +595,8 @@ public:
 
     Status compact(OperationContext* opCtx) final;
 
+    StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds maxTime) final;
+
     void setIndexIsMultikey(OperationContext* opCtx,
                             const CollectionPtr& collection,
                             KeyStringSet multikeyMetadataKeys,
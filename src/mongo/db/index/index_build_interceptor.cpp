@@ -33,10 +33,14 @@
 
 #include "mongo/db/index/index_build_interceptor.h"
 
+#include <algorithm>
+#include <array>
 #include <vector>
 
+#include "mongo/base/counter.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
@@ -57,6 +61,41 @@ MONGO_FAIL_POINT_DEFINE(hangDuringIndexBuildDrainYieldSecond);
 MONGO_FAIL_POINT_DEFINE(hangIndexBuildDuringDrainWritesPhase);
 MONGO_FAIL_POINT_DEFINE(hangIndexBuildDuringDrainWritesPhaseSecond);
 
+namespace {
+
+/**
+ * Histogram of the durations of drains which do not yield. Those hold an S or X collection lock
+ * from start to end, so they are the window during which an index build blocks writes. Exposed in
+ * serverStatus as 'metrics.indexBuilds.blockingDrainDurationMillis'.
+ */
+class BlockingDrainDurationHistogram {
+public:
+    BlockingDrainDurationHistogram() {
+        for (size_t i = 0; i < _buckets.size(); ++i) {
+            auto bucketName = i < kBoundsMillis.size()
+                ? "lt" + std::to_string(kBoundsMillis[i])
+                : "gte" + std::to_string(kBoundsMillis.back());
+            _metrics.push_back(std::make_unique<ServerStatusMetricField<Counter64>>(
+                "indexBuilds.blockingDrainDurationMillis." + bucketName, &_buckets[i]));
+        }
+    }
+
+    void record(long long durationMillis) {
+        auto bound = std::upper_bound(kBoundsMillis.begin(), kBoundsMillis.end(), durationMillis);
+        _buckets[bound - kBoundsMillis.begin()].increment();
+    }
+
+private:
+    static constexpr std::array<long long, 4> kBoundsMillis{10, 100, 1000, 10000};
+
+    std::array<Counter64, kBoundsMillis.size() + 1> _buckets;
+    std::vector<std::unique_ptr<ServerStatusMetricField<Counter64>>> _metrics;
+};
+
+BlockingDrainDurationHistogram blockingDrainDurationHistogram;
+
+}  // namespace
+
 IndexBuildInterceptor::IndexBuildInterceptor(OperationContext* opCtx, IndexCatalogEntry* entry)
     : _indexCatalogEntry(entry),
       _sideWritesTable(
@@ -163,6 +202,9 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     invariant(kBatchMaxMB <= std::numeric_limits<int32_t>::max() / kMB);
     const int32_t kBatchMaxBytes = kBatchMaxMB * kMB;
 
+    const auto keyStringVersion =
+        _indexCatalogEntry->accessMethod()->getSortedDataInterface()->getKeyStringVersion();
+
     // In a single WriteUnitOfWork, scan the side table up to the batch or memory limit, apply the
     // keys to the index, and delete the side table records.
     // Returns true if the cursor has reached the end of the table, false if there are more records,
@@ -179,6 +221,9 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
         // table matters.
         std::vector<RecordId> recordsAddedToIndex;
 
+        // The writes read in this batch, in side table order until they are sorted below.
+        std::vector<std::pair<KeyString::Value, Op>> batch;
+
         auto record = cursor->next();
         while (record) {
             opCtx->checkForInterrupt();
@@ -200,9 +245,40 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             batchSize += 1;
             batchSizeBytes += objSize;
 
+            // Deserialize the encoded KeyString::Value.
+            int keyLen;
+            const char* binKey = unownedDoc["key"].binData(keyLen);
+            BufReader reader(binKey, keyLen);
+            const Op opType =
+                (strcmp(unownedDoc.getStringField("op"), "i") == 0) ? Op::kInsert : Op::kDelete;
+            if (kDebugBuild && opType == Op::kDelete)
+                invariant(strcmp(unownedDoc.getStringField("op"), "d") == 0);
+            batch.emplace_back(KeyString::Value::deserialize(reader, keyStringVersion), opType);
+
+            // Save the record ids of the documents read for deletion later. We can't delete
+            // records while holding a positioned cursor.
+            recordsAddedToIndex.push_back(currentRecordId);
+
+            // Don't continue if the batch is full. Allow the transaction to commit.
+            if (batchSize == kBatchMaxSize) {
+                break;
+            }
+
+            record = cursor->next();
+        }
+
+        // Apply the batch in key order rather than in the order the writes were recorded, so that
+        // consecutive writes go to neighbouring parts of the index instead of all over it. Index
+        // builds always allow duplicates until commit, so writes on different keys commute. The
+        // keys include the RecordId, and the stable sort keeps the writes on the same key in order.
+        std::stable_sort(batch.begin(), batch.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first.compare(rhs.first) < 0;
+        });
+        for (const auto& [keyString, opType] : batch) {
             if (auto status = _applyWrite(opCtx,
                                           coll,
-                                          unownedDoc,
+                                          keyString,
+                                          opType,
                                           options,
                                           trackDuplicates,
                                           &totalInserted,
@@ -210,17 +286,6 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
                 !status.isOK()) {
                 return status;
             }
-
-            // Save the record ids of the documents inserted into the index for deletion later.
-            // We can't delete records while holding a positioned cursor.
-            recordsAddedToIndex.push_back(currentRecordId);
-
-            // Don't continue if the batch is full. Allow the transaction to commit.
-            if (batchSize == kBatchMaxSize) {
-                break;
-            }
-
-            record = cursor->next();
         }
 
         // Delete documents from the side table as soon as they have been inserted into the index.
@@ -265,6 +330,10 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
 
     progress->finished();
 
+    if (DrainYieldPolicy::kNoYield == drainYieldPolicy) {
+        blockingDrainDurationHistogram.record(timer.millis());
+    }
+
     int logLevel = (_numApplied - appliedAtStart > 0) ? 0 : 1;
     LOGV2_DEBUG(20689,
                 logLevel,
@@ -282,22 +351,12 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
 
 Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
                                           const CollectionPtr& coll,
-                                          const BSONObj& operation,
+                                          const KeyString::Value& keyString,
+                                          Op opType,
                                           const InsertDeleteOptions& options,
                                           TrackDuplicates trackDups,
                                           int64_t* const keysInserted,
                                           int64_t* const keysDeleted) {
-    // Deserialize the encoded KeyString::Value.
-    int keyLen;
-    const char* binKey = operation["key"].binData(keyLen);
-    BufReader reader(binKey, keyLen);
-    const KeyString::Value keyString = KeyString::Value::deserialize(
-        reader,
-        _indexCatalogEntry->accessMethod()->getSortedDataInterface()->getKeyStringVersion());
-
-    const Op opType =
-        (strcmp(operation.getStringField("op"), "i") == 0) ? Op::kInsert : Op::kDelete;
-
     const KeyStringSet keySet{keyString};
     const RecordId opRecordId = [&]() {
         auto keyFormat = coll->getRecordStore()->keyFormat();
@@ -335,8 +394,6 @@ Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
             [keysInserted, numInserted] { *keysInserted -= numInserted; });
     } else {
         invariant(opType == Op::kDelete);
-        if (kDebugBuild)
-            invariant(strcmp(operation.getStringField("op"), "d") == 0);
 
         int64_t numDeleted;
         Status s = accessMethod->removeKeys(
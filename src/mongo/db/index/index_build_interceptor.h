@@ -184,7 +184,8 @@ private:
 
     Status _applyWrite(OperationContext* opCtx,
                        const CollectionPtr& coll,
-                       const BSONObj& doc,
+                       const KeyString::Value& keyString,
+                       Op opType,
                        const InsertDeleteOptions& options,
                        TrackDuplicates trackDups,
                        int64_t* keysInserted,
@@ -30,10 +30,14 @@
 #include "mongo/platform/basic.h"
 
 #include <benchmark/benchmark.h>
+#include <cmath>
 #include <random>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/index/btree_key_generator.h"
+#include "mongo/db/index/expression_keys_private.h"
+#include "mongo/db/index/expression_params.h"
+#include "mongo/db/index/s2_common.h"
 
 namespace mongo {
 namespace {
@@ -165,6 +169,108 @@ void BM_KeyGenArrayOfArray(benchmark::State& state, int32_t elements) {
     }
 }
 
+// Generates the keys of a batch of documents for a compound index, whose first field holds an
+// array of 'elements' values, either one document at a time or with a single batch call.
+void BM_KeyGenCompoundArrayBatch(benchmark::State& state, int32_t elements, bool batched) {
+    constexpr size_t kBatchSize = 100;
+    constexpr const char* kSecondFieldName = "b";
+    std::mt19937 gen(numGen());
+
+    std::vector<BSONObj> docs;
+    for (size_t doc = 0; doc < kBatchSize; ++doc) {
+        BSONObjBuilder builder;
+        BSONArrayBuilder arrBuilder(builder.subarrayStart(kFieldName));
+        for (int32_t i = 0; i < elements; ++i) {
+            arrBuilder.append(static_cast<int32_t>(gen()));
+        }
+        arrBuilder.done();
+        builder.append(kSecondFieldName, static_cast<int32_t>(gen()));
+        docs.push_back(builder.obj());
+    }
+
+    BtreeKeyGenerator generator({kFieldName, kSecondFieldName},
+                                {BSONElement{}, BSONElement{}},
+                                false,
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSON(kFieldName << 1 << kSecondFieldName << 1)));
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    std::vector<KeyStringSet> keys;
+    std::vector<MultikeyPaths> multikeyPaths;
+
+    for (auto _ : state) {
+        if (batched) {
+            generator.getKeysForBatch(allocator, docs, false, &keys, &multikeyPaths);
+        } else {
+            keys.resize(docs.size());
+            multikeyPaths.resize(docs.size());
+            for (size_t doc = 0; doc < docs.size(); ++doc) {
+                keys[doc].clear();
+                multikeyPaths[doc].clear();
+                generator.getKeys(allocator, docs[doc], false, &keys[doc], &multikeyPaths[doc]);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+// Generates the keys of a 2dsphere index for a document whose geo field holds a polygon with
+// 'vertices' vertices, or a single GeoJSON point when 'vertices' is zero.
+void BM_KeyGenS2(benchmark::State& state, int32_t vertices) {
+    std::mt19937 gen(numGen());
+    std::uniform_real_distribution<double> lng(-179.0, 179.0);
+    std::uniform_real_distribution<double> lat(-80.0, 80.0);
+    const double centerLng = lng(gen);
+    const double centerLat = lat(gen);
+
+    BSONObjBuilder builder;
+    {
+        BSONObjBuilder geoBuilder(builder.subobjStart(kFieldName));
+        if (vertices == 0) {
+            geoBuilder.append("type", "Point");
+            geoBuilder.append("coordinates", BSON_ARRAY(centerLng << centerLat));
+        } else {
+            // A closed ring of 'vertices' distinct points around a circle of radius 0.5 degrees.
+            geoBuilder.append("type", "Polygon");
+            BSONArrayBuilder ringsBuilder(geoBuilder.subarrayStart("coordinates"));
+            BSONArrayBuilder ringBuilder(ringsBuilder.subarrayStart());
+            for (int32_t i = 0; i <= vertices; ++i) {
+                const double angle = 2 * M_PI * (i % vertices) / vertices;
+                ringBuilder.append(BSON_ARRAY(centerLng + 0.5 * std::cos(angle)
+                                              << centerLat + 0.5 * std::sin(angle)));
+            }
+        }
+    }
+    BSONObj obj = builder.obj();
+
+    BSONObj keyPattern = BSON(kFieldName << "2dsphere");
+    S2IndexingParams params;
+    ExpressionParams::initialize2dsphereParams(
+        BSON("key" << keyPattern << "2dsphereIndexVersion" << 3), nullptr, &params);
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    KeyStringSet keys;
+    MultikeyPaths multikeyPaths;
+
+    for (auto _ : state) {
+        ExpressionKeysPrivate::getS2Keys(allocator,
+                                         obj,
+                                         keyPattern,
+                                         params,
+                                         &keys,
+                                         &multikeyPaths,
+                                         KeyString::Version::kLatestVersion,
+                                         makeOrdering(kFieldName));
+        benchmark::ClobberMemory();
+        keys.clear();
+        multikeyPaths.clear();
+    }
+}
+
 BENCHMARK_CAPTURE(BM_KeyGenBasic, Generic, false);
 BENCHMARK_CAPTURE(BM_KeyGenBasic, SkipMultikey, true);
 
@@ -180,5 +286,14 @@ BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 10x10, 10);
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 100x100, 100);
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 1Kx1K, 1000);
 
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArrayBatch, PerDocument10, 10, false);
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArrayBatch, Batch10, 10, true);
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArrayBatch, PerDocument500, 500, false);
+BENCHMARK_CAPTURE(BM_KeyGenCompoundArrayBatch, Batch500, 500, true);
+
+BENCHMARK_CAPTURE(BM_KeyGenS2, Point, 0);
+BENCHMARK_CAPTURE(BM_KeyGenS2, Polygon100, 100);
+BENCHMARK_CAPTURE(BM_KeyGenS2, Polygon1K, 1000);
+
 }  // namespace
 }  // namespace mongo
@@ -37,6 +37,7 @@
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/geo/geometry_container.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/json.h"
@@ -44,6 +45,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/str.h"
+#include "third_party/s2/s2regioncoverer.h"
 
 using namespace mongo;
 
@@ -668,4 +670,51 @@ TEST_F(S2KeyGeneratorTest, MidPathSingleElementArrayIsConsideredMultikey) {
     assertMultikeyPathsEqual(MultikeyPaths{{0U}, MultikeyComponents{}}, actualMultikeyPaths);
 }
 
+
+TEST_F(S2KeyGeneratorTest, PointKeysMatchRegionCovererCovering) {
+    BSONObj keyPattern = fromjson("{a: '2dsphere'}");
+    BSONObj infoObj = fromjson("{key: {a: '2dsphere'}, '2dsphereIndexVersion': 3}");
+    S2IndexingParams params;
+    const CollatorInterface* collator = nullptr;
+    ExpressionParams::initialize2dsphereParams(infoObj, collator, &params);
+
+    // Includes points on face and cell boundaries as well as legacy coordinate pairs.
+    for (auto&& json : {"{a: {type: 'Point', coordinates: [0, 0]}}",
+                        "{a: {type: 'Point', coordinates: [-180, 90]}}",
+                        "{a: {type: 'Point', coordinates: [45, 35.264389682754654]}}",
+                        "{a: {type: 'Point', coordinates: [-73.9857, 40.7484]}}",
+                        "{a: [-122.4194, 37.7749]}"}) {
+        BSONObj obj = fromjson(json);
+
+        GeometryContainer geoContainer;
+        ASSERT_OK(geoContainer.parseFromStorage(obj.firstElement()));
+        geoContainer.projectInto(SPHERE);
+        S2RegionCoverer coverer;
+        params.configureCoverer(geoContainer, &coverer);
+        std::vector<S2CellId> covering;
+        coverer.GetCovering(geoContainer.getS2Region(), &covering);
+
+        KeyStringSet expectedKeys;
+        for (auto&& cellId : covering) {
+            KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion,
+                                             S2CellIdToIndexKey(cellId, params.indexVersion),
+                                             Ordering::make(BSONObj()));
+            expectedKeys.insert(keyString.release());
+        }
+
+        KeyStringSet actualKeys;
+        MultikeyPaths actualMultikeyPaths;
+        ExpressionKeysPrivate::getS2Keys(allocator,
+                                         obj,
+                                         keyPattern,
+                                         params,
+                                         &actualKeys,
+                                         &actualMultikeyPaths,
+                                         KeyString::Version::kLatestVersion,
+                                         Ordering::make(BSONObj()));
+
+        ASSERT_TRUE(areKeysetsEqual(expectedKeys, actualKeys)) << json;
+    }
+}
+
 }  // namespace
@@ -39,6 +39,10 @@ namespace mongo {
 
 SortKeyGenerator::SortKeyGenerator(SortPattern sortPattern, const CollatorInterface* collator)
     : _collator(collator), _sortPattern(std::move(sortPattern)) {
+    if (_collator) {
+        _collationKeys = std::make_unique<CollationKeyCache>(_collator);
+    }
+
     BSONObjBuilder btreeBob;
     size_t nFields = 0;
 
@@ -168,7 +172,8 @@ StatusWith<BSONObj> SortKeyGenerator::computeSortKeyFromDocumentWithoutMetadata(
         // multikey when getting the index keys for sorting.
         MultikeyPaths* multikeyPaths = nullptr;
         const auto skipMultikey = false;
-        _indexKeyGen->getKeys(allocator, obj, skipMultikey, &keys, multikeyPaths);
+        _indexKeyGen->getKeys(
+            allocator, obj, skipMultikey, &keys, multikeyPaths, boost::none, _collationKeys.get());
     } catch (const AssertionException& e) {
         // Probably a parallel array.
         if (ErrorCodes::CannotIndexParallelArrays == e.code()) {
@@ -200,8 +205,7 @@ Value SortKeyGenerator::getCollationComparisonKey(const Value& val) const {
 
     // If 'val' is a string, directly use the collator to obtain a comparison key.
     if (val.getType() == BSONType::String) {
-        auto compKey = _collator->getComparisonKey(val.getString());
-        return Value(compKey.getKeyData());
+        return Value(_collationKeys->getComparisonKeyData(val.getString()));
     }
 
     // Otherwise, for non-string collatable types, take the slow path and round-trip the value
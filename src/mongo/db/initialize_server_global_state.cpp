@@ -357,6 +357,8 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
         lv2Config.fileOpenMode = serverGlobalParams.logAppend
             ? logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kAppend
             : logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kTruncate;
+        lv2Config.fileAsyncQueueBytes = static_cast<size_t>(gLogAsyncQueueSizeKB) * 1024;
+        lv2Config.fileAsyncDropOnOverflow = gLogAsyncDropOnOverflow;
 
         if (serverGlobalParams.logAppend && exists) {
             writeServerRestartedAfterLogConfig = true;
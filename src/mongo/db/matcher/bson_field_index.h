@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * A lazily built index from top-level field name to element for a single BSONObj.
+ *
+ * Looking up a field in raw BSON is a linear scan, so evaluating many predicates against a
+ * document with hundreds of top-level fields costs O(fields x predicates). This class answers the
+ * first few lookups with a plain scan, and once a document has seen enough of them, builds a hash
+ * index over its top-level fields in one pass if the document is wide enough to benefit. Narrow
+ * documents never pay for the index.
+ *
+ * The index holds pointers into the object's buffer, so the object must outlive it and must be
+ * the same object passed to every call of getField().
+ */
+class BSONFieldIndex {
+public:
+    // Number of scanning lookups on an object before we consider indexing it.
+    static constexpr size_t kLookupsBeforeIndexing = 4;
+
+    // Minimum number of top-level fields for an object to be worth indexing.
+    static constexpr size_t kMinFieldsToIndex = 64;
+
+    BSONFieldIndex() = default;
+
+    BSONFieldIndex(const BSONFieldIndex&) = delete;
+    BSONFieldIndex& operator=(const BSONFieldIndex&) = delete;
+
+    /**
+     * Returns the same element as obj.getField(name): the first top-level field called 'name', or
+     * EOO if there is none.
+     */
+    BSONElement getField(const BSONObj& obj, StringData name);
+
+    /**
+     * Discards the index so that this instance may be used with a different object.
+     */
+    void reset();
+
+    bool isIndexed() const {
+        return _state == State::kIndexed;
+    }
+
+private:
+    enum class State { kScanning, kIndexed, kNotWorthIndexing };
+
+    void _buildIndex(const BSONObj& obj);
+
+    State _state = State::kScanning;
+    size_t _numLookups = 0;
+    StringDataMap<BSONElement> _fields;
+};
+
+}  // namespace mongo
@@ -0,0 +1,219 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include <cmath>
+
+#include "mongo/db/matcher/bson_field_index.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_path.h"
+#include "mongo/db/matcher/path_internal.h"
+
+namespace mongo {
+namespace {
+
+template <typename T>
+bool compare(MatchExpression::MatchType comparison, T lhs, T rhs) {
+    switch (comparison) {
+        case MatchExpression::LT:
+            return lhs < rhs;
+        case MatchExpression::LTE:
+            return lhs <= rhs;
+        case MatchExpression::EQ:
+            return lhs == rhs;
+        case MatchExpression::GT:
+            return lhs > rhs;
+        case MatchExpression::GTE:
+            return lhs >= rhs;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+}  // namespace
+
+CompiledMatchExpression::CompiledMatchExpression(const MatchExpression* expr) {
+    auto jumps = _compile(expr);
+    _patch(jumps.onTrue, kMatch);
+    _patch(jumps.onFalse, kNoMatch);
+}
+
+CompiledMatchExpression::PendingJumps CompiledMatchExpression::_compile(
+    const MatchExpression* expr) {
+    PendingJumps jumps;
+    const auto matchType = expr->matchType();
+    switch (matchType) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR: {
+            const size_t numChildren = expr->numChildren();
+            if (numChildren == 0) {
+                break;
+            }
+
+            // A child of an $and which is true, or of an $or or $nor which is false, continues
+            // with the next child. The last child decides the result.
+            const bool isAnd = matchType == MatchExpression::AND;
+            for (size_t i = 0; i < numChildren; ++i) {
+                auto child = _compile(expr->getChild(i));
+                auto& decided = isAnd ? child.onFalse : child.onTrue;
+                auto& undecided = isAnd ? child.onTrue : child.onFalse;
+                auto& decidedOut = isAnd ? jumps.onFalse : jumps.onTrue;
+                auto& undecidedOut = isAnd ? jumps.onTrue : jumps.onFalse;
+
+                decidedOut.insert(decidedOut.end(), decided.begin(), decided.end());
+                if (i + 1 < numChildren) {
+                    _patch(undecided, _program.size());
+                } else {
+                    undecidedOut.insert(undecidedOut.end(), undecided.begin(), undecided.end());
+                }
+            }
+
+            if (matchType == MatchExpression::NOR) {
+                std::swap(jumps.onTrue, jumps.onFalse);
+            }
+            return jumps;
+        }
+        case MatchExpression::NOT:
+            jumps = _compile(expr->getChild(0));
+            std::swap(jumps.onTrue, jumps.onFalse);
+            return jumps;
+        default:
+            break;
+    }
+
+    Instruction instruction{Op::kMatchesBSON, matchType, expr};
+    if (auto pathExpr = dynamic_cast<const PathMatchExpression*>(expr)) {
+        instruction.op = Op::kMatchesElement;
+        instruction.pathExpr = pathExpr;
+        instruction.path = pathExpr->fieldRef();
+
+        if (matchType == MatchExpression::EXISTS) {
+            instruction.op = Op::kExists;
+        } else if (auto comparisonExpr = dynamic_cast<const ComparisonMatchExpression*>(expr)) {
+            const auto& rhs = comparisonExpr->getData();
+            switch (rhs.type()) {
+                case String:
+                    if (matchType == MatchExpression::EQ && !comparisonExpr->getCollator()) {
+                        instruction.op = Op::kStringEquals;
+                        instruction.rhsString = rhs.valueStringData();
+                    }
+                    break;
+                case NumberInt:
+                case NumberLong:
+                    instruction.op = Op::kCompareIntegral;
+                    instruction.rhsIntegral = rhs.numberLong();
+                    break;
+                case NumberDouble:
+                    // NaN compares by rules of its own.
+                    if (!std::isnan(rhs._numberDouble())) {
+                        instruction.op = Op::kCompareDouble;
+                        instruction.rhsDouble = rhs._numberDouble();
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    _emit(instruction, &jumps);
+    return jumps;
+}
+
+void CompiledMatchExpression::_emit(Instruction instruction, PendingJumps* jumps) {
+    const uint32_t index = _program.size();
+    _program.push_back(instruction);
+    jumps->onTrue.push_back(2 * index + 1);
+    jumps->onFalse.push_back(2 * index);
+}
+
+void CompiledMatchExpression::_patch(const std::vector<uint32_t>& jumps, uint32_t target) {
+    for (auto jump : jumps) {
+        auto& instruction = _program[jump / 2];
+        (jump % 2 ? instruction.onTrue : instruction.onFalse) = target;
+    }
+}
+
+bool CompiledMatchExpression::matchesBSON(const BSONObj& doc) const {
+    // Shared by the lookups of every path, like the index of a BSONMatchableDocument.
+    BSONFieldIndex fieldIndex;
+
+    auto evaluate = [&](const Instruction& instruction) {
+        if (instruction.op == Op::kMatchesBSON) {
+            return instruction.expr->matchesBSON(doc);
+        }
+
+        size_t idxPath;
+        const auto e = getFieldDottedOrArray(doc, *instruction.path, &idxPath, 0, &fieldIndex);
+        if (e.type() == Array) {
+            // The expression decides how to traverse arrays.
+            return instruction.pathExpr->matchesBSON(doc);
+        }
+
+        switch (instruction.op) {
+            case Op::kExists:
+                return !e.eoo();
+            case Op::kStringEquals:
+                if (e.type() == String) {
+                    return e.valueStringData() == instruction.rhsString;
+                }
+                break;
+            case Op::kCompareIntegral:
+                if (e.type() == NumberInt || e.type() == NumberLong) {
+                    return compare<int64_t>(
+                        instruction.comparison, e.numberLong(), instruction.rhsIntegral);
+                }
+                break;
+            case Op::kCompareDouble:
+                if (e.type() == NumberDouble && !std::isnan(e._numberDouble())) {
+                    return compare(
+                        instruction.comparison, e._numberDouble(), instruction.rhsDouble);
+                }
+                break;
+            default:
+                break;
+        }
+        return instruction.pathExpr->matchesSingleElement(e);
+    };
+
+    uint32_t next = 0;
+    while (true) {
+        const auto& instruction = _program[next];
+        next = evaluate(instruction) ? instruction.onTrue : instruction.onFalse;
+        if (next >= kNoMatch) {
+            return next == kMatch;
+        }
+    }
+}
+
+}  // namespace mongo
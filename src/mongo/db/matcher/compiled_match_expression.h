@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+class FieldRef;
+class PathMatchExpression;
+
+/**
+ * A MatchExpression compiled into a flat program, which evaluates the same predicate against BSON
+ * documents without walking the expression tree.
+ *
+ * The logical nodes ($and, $or, $nor and $not) are compiled away into jumps between the
+ * predicates of the program, so that evaluation short-circuits exactly like the tree does. Each
+ * predicate on a path looks up its path directly, and compares against the most common kinds of
+ * operand with code specialized for their type. A predicate falls back to the MatchExpression it
+ * was compiled from whenever that would give a different answer, which is when an array is found
+ * along its path or its operand is not one of the specialized kinds. Nodes which do not match
+ * against a path are evaluated by their MatchExpression.
+ *
+ * The program refers to the MatchExpression it was compiled from, which must outlive it and must
+ * not be changed.
+ */
+class CompiledMatchExpression {
+public:
+    explicit CompiledMatchExpression(const MatchExpression* expr);
+
+    CompiledMatchExpression(const CompiledMatchExpression&) = delete;
+    CompiledMatchExpression& operator=(const CompiledMatchExpression&) = delete;
+
+    /**
+     * Returns the same result as calling matchesBSON() on the MatchExpression.
+     */
+    bool matchesBSON(const BSONObj& doc) const;
+
+    size_t numInstructions() const {
+        return _program.size();
+    }
+
+private:
+    enum class Op : uint8_t {
+        // Evaluates 'expr' against the whole document.
+        kMatchesBSON,
+        // Looks up 'path', and evaluates 'pathExpr' against the element found.
+        kMatchesElement,
+        // Looks up 'path', and checks that an element was found.
+        kExists,
+        // Looks up 'path', and compares a string element to 'rhs' byte by byte.
+        kStringEquals,
+        // Looks up 'path', and compares a NumberInt or NumberLong element to 'rhs' as integers.
+        kCompareIntegral,
+        // Looks up 'path', and compares a NumberDouble element to 'rhs' as doubles.
+        kCompareDouble,
+    };
+
+    // The targets of a jump which end the program.
+    static constexpr uint32_t kMatch = UINT32_MAX;
+    static constexpr uint32_t kNoMatch = UINT32_MAX - 1;
+
+    struct Instruction {
+        Op op;
+        MatchExpression::MatchType comparison;
+        const MatchExpression* expr;
+        const PathMatchExpression* pathExpr;
+        const FieldRef* path;
+        int64_t rhsIntegral;
+        double rhsDouble;
+        StringData rhsString;
+
+        // The instruction to run next depending on the result of this one.
+        uint32_t onTrue;
+        uint32_t onFalse;
+    };
+
+    // The jumps out of a compiled subexpression, whose targets are not known yet, by the result of
+    // the subexpression they are taken on. A jump is given as twice the index of its instruction,
+    // plus one if it is the jump taken when that instruction is true.
+    struct PendingJumps {
+        std::vector<uint32_t> onTrue;
+        std::vector<uint32_t> onFalse;
+    };
+
+    PendingJumps _compile(const MatchExpression* expr);
+    void _emit(Instruction instruction, PendingJumps* jumps);
+    void _patch(const std::vector<uint32_t>& jumps, uint32_t target);
+
+    std::vector<Instruction> _program;
+};
+
+}  // namespace mongo
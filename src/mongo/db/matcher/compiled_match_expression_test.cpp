@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const std::vector<BSONObj> kDocs = {
+    fromjson("{}"),
+    fromjson("{a: 1}"),
+    fromjson("{a: 1.5}"),
+    fromjson("{a: NumberLong(3)}"),
+    fromjson("{a: NumberDecimal('2')}"),
+    fromjson("{a: NaN}"),
+    fromjson("{a: null}"),
+    fromjson("{a: undefined}"),
+    fromjson("{a: 'foo'}"),
+    fromjson("{a: 'fo'}"),
+    fromjson("{a: 'FOO'}"),
+    fromjson("{a: {$minKey: 1}}"),
+    fromjson("{a: {$maxKey: 1}}"),
+    fromjson("{a: [1, 5]}"),
+    fromjson("{a: [[2]]}"),
+    fromjson("{a: []}"),
+    fromjson("{a: {b: 2}}"),
+    fromjson("{a: {b: 'foo', c: [1, {d: 2}]}}"),
+    fromjson("{a: [{b: 1}, {b: 3}]}"),
+    fromjson("{a: 5, b: 'bar'}"),
+    fromjson("{a: 2, b: {c: null}}"),
+    fromjson("{b: 1}"),
+};
+
+/**
+ * Asserts that the compiled program of 'filter' matches the same documents as the filter does.
+ */
+void assertMatchesLikeExpression(const BSONObj& filter,
+                                 const CollatorInterface* collator = nullptr) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    expCtx->setCollator(collator ? collator->clone() : nullptr);
+    auto expr = uassertStatusOK(MatchExpressionParser::parse(filter, expCtx));
+    CompiledMatchExpression compiled(expr.get());
+    for (const auto& doc : kDocs) {
+        ASSERT_EQ(expr->matchesBSON(doc), compiled.matchesBSON(doc))
+            << "filter: " << filter << ", document: " << doc;
+    }
+}
+
+TEST(CompiledMatchExpressionTest, Comparisons) {
+    for (auto op : {"$eq", "$lt", "$lte", "$gt", "$gte"}) {
+        for (auto operand : {fromjson("{v: 1}"),
+                             fromjson("{v: 1.5}"),
+                             fromjson("{v: NumberLong(3)}"),
+                             fromjson("{v: NumberDecimal('2')}"),
+                             fromjson("{v: NaN}"),
+                             fromjson("{v: null}"),
+                             fromjson("{v: 'foo'}"),
+                             fromjson("{v: {$minKey: 1}}"),
+                             fromjson("{v: {$maxKey: 1}}"),
+                             fromjson("{v: [1, 5]}"),
+                             fromjson("{v: {b: 2}}")}) {
+            for (auto path : {"a", "a.b", "a.c.d", "b.c"}) {
+                assertMatchesLikeExpression(BSON(path << BSON(op << operand["v"])));
+            }
+        }
+    }
+}
+
+TEST(CompiledMatchExpressionTest, StringEqualityRespectsCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    assertMatchesLikeExpression(fromjson("{a: 'foo'}"), &collator);
+    assertMatchesLikeExpression(fromjson("{a: 'foo'}"));
+}
+
+TEST(CompiledMatchExpressionTest, Exists) {
+    assertMatchesLikeExpression(fromjson("{a: {$exists: true}}"));
+    assertMatchesLikeExpression(fromjson("{a: {$exists: false}}"));
+    assertMatchesLikeExpression(fromjson("{'a.b': {$exists: true}}"));
+    assertMatchesLikeExpression(fromjson("{'a.c.d': {$exists: false}}"));
+}
+
+TEST(CompiledMatchExpressionTest, LogicalOperators) {
+    assertMatchesLikeExpression(fromjson("{a: {$gt: 1, $lt: 5}, b: 'bar'}"));
+    assertMatchesLikeExpression(fromjson("{$or: [{a: 1}, {b: 1}, {'a.b': 2}]}"));
+    assertMatchesLikeExpression(fromjson("{$nor: [{a: 1}, {b: {$exists: true}}]}"));
+    assertMatchesLikeExpression(fromjson("{a: {$not: {$gt: 1}}}"));
+    assertMatchesLikeExpression(
+        fromjson("{$and: [{$or: [{a: {$lt: 2}}, {a: 'foo'}]}, {$nor: [{b: null}, {a: NaN}]}]}"));
+    assertMatchesLikeExpression(fromjson("{$or: [{$and: [{a: 1}, {b: 1}]}, {$nor: [{a: 5}]}]}"));
+}
+
+TEST(CompiledMatchExpressionTest, OtherExpressions) {
+    assertMatchesLikeExpression(fromjson("{a: {$in: [1, 'foo', null, /^f/]}}"));
+    assertMatchesLikeExpression(fromjson("{a: {$elemMatch: {$gt: 1}}}"));
+    assertMatchesLikeExpression(fromjson("{a: {$type: 'number'}}"));
+    assertMatchesLikeExpression(fromjson("{a: {$size: 0}}"));
+    assertMatchesLikeExpression(fromjson("{$expr: {$eq: ['$a', 5]}}"));
+    assertMatchesLikeExpression(fromjson("{$alwaysFalse: 1}"));
+    assertMatchesLikeExpression(fromjson("{}"));
+}
+
+TEST(CompiledMatchExpressionTest, LogicalOperatorsCompileAway) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto expr = uassertStatusOK(MatchExpressionParser::parse(
+        fromjson("{$or: [{a: 1, b: 2}, {$nor: [{c: 3}]}, {d: {$not: {$exists: true}}}]}"),
+        expCtx));
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_EQ(4U, compiled.numInstructions());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -237,16 +237,16 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
                                            clonable_ptr<ErrorAnnotation> annotation)
     : LeafMatchExpression(REGEX, path, std::move(annotation)),
       _regex(regex.toString()),
-      _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags))) {
+      _flags(options.toString()) {
+    const auto pcreOptions = regex_util::flagsToPcreOptions(_flags).all_options();
 
     uassert(ErrorCodes::BadValue,
             "Regular expression cannot contain an embedded null byte",
             _regex.find('\0') == std::string::npos);
 
-    uassert(51091,
-            str::stream() << "Regular expression is invalid: " << _re->error(),
-            _re->error().empty());
+    const char* compileError = nullptr;
+    _re = regex_util::compilePattern(_regex, pcreOptions, &compileError);
+    uassert(51091, str::stream() << "Regular expression is invalid: " << compileError, _re);
 }
 
 RegexMatchExpression::~RegexMatchExpression() {}
@@ -264,11 +264,17 @@ bool RegexMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetai
     switch (e.type()) {
         case String:
         case Symbol: {
-            // String values stored in documents can contain embedded NUL bytes. We construct a
-            // pcrecpp::StringPiece instance using the full length of the string to avoid truncating
-            // 'data' early.
-            pcrecpp::StringPiece data(e.valuestr(), e.valuestrsize() - 1);
-            return _re->PartialMatch(data);
+            // String values stored in documents can contain embedded NUL bytes. We match against
+            // the full length of the string to avoid truncating the subject early.
+            int ovector[3];
+            return pcre_exec(_re.get(),
+                             nullptr,
+                             e.valuestr(),
+                             e.valuestrsize() - 1,
+                             0,
+                             0,
+                             ovector,
+                             std::size(ovector)) >= 0;
         }
         case RegEx:
             return _regex == e.regex() && _flags == e.regexFlags();
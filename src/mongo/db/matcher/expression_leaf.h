@@ -31,6 +31,7 @@
 
 #include <boost/optional.hpp>
 #include <memory>
+#include <pcre.h>
 
 #include "mongo/bson/bsonelement_comparator.h"
 #include "mongo/bson/bsonmisc.h"
@@ -494,7 +495,7 @@ private:
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+    std::shared_ptr<const pcre> _re;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -822,6 +822,17 @@ TEST(RegexMatchExpression, MatchesElementCaseInsensitive) {
     ASSERT(!regex.matchesSingleElement(notMatch.firstElement()));
 }
 
+TEST(RegexMatchExpression, SamePatternWithDifferentFlagsIsCompiledSeparately) {
+    BSONObj uppercase = BSON("x"
+                             << "ABC");
+    for (int i = 0; i < 2; ++i) {
+        RegexMatchExpression caseSensitive("", "abc", "");
+        RegexMatchExpression caseInsensitive("", "abc", "i");
+        ASSERT(!caseSensitive.matchesSingleElement(uppercase.firstElement()));
+        ASSERT(caseInsensitive.matchesSingleElement(uppercase.firstElement()));
+    }
+}
+
 TEST(RegexMatchExpression, MatchesElementMultilineOff) {
     BSONObj match = BSON("x"
                          << "az");
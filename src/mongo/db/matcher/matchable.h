@@ -32,6 +32,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/matcher/bson_field_index.h"
 #include "mongo/db/matcher/path.h"
 
 namespace mongo {
@@ -85,9 +86,9 @@ public:
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
         if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+            return new BSONElementIterator(path, _obj, &_fieldIndex);
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, _obj, &_fieldIndex);
         return &_iterator;
     }
 
@@ -103,6 +104,10 @@ private:
     BSONObj _obj;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
+
+    // Shared by all the predicates evaluated against '_obj', so that wide documents are indexed
+    // once they have been probed for enough paths.
+    mutable BSONFieldIndex _fieldIndex;
 };
 
 /**
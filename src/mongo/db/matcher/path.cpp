@@ -82,10 +82,12 @@ BSONElementIterator::BSONElementIterator(const ElementPath* path,
     _setTraversalStart(suffixIndex, elementToIterate);
 }
 
-BSONElementIterator::BSONElementIterator(const ElementPath* path, const BSONObj& objectToIterate)
+BSONElementIterator::BSONElementIterator(const ElementPath* path,
+                                         const BSONObj& objectToIterate,
+                                         BSONFieldIndex* fieldIndex)
     : _path(path), _state(BEGIN) {
-    _traversalStart =
-        getFieldDottedOrArray(objectToIterate, _path->fieldRef(), &_traversalStartIndex);
+    _traversalStart = getFieldDottedOrArray(
+        objectToIterate, _path->fieldRef(), &_traversalStartIndex, 0, fieldIndex);
 }
 
 BSONElementIterator::~BSONElementIterator() {}
@@ -104,11 +106,13 @@ void BSONElementIterator::reset(const ElementPath* path,
     _subCursorPath.reset();
 }
 
-void BSONElementIterator::reset(const ElementPath* path, const BSONObj& objectToIterate) {
+void BSONElementIterator::reset(const ElementPath* path,
+                                const BSONObj& objectToIterate,
+                                BSONFieldIndex* fieldIndex) {
     _path = path;
     _traversalStartIndex = 0;
-    _traversalStart =
-        getFieldDottedOrArray(objectToIterate, _path->fieldRef(), &_traversalStartIndex);
+    _traversalStart = getFieldDottedOrArray(
+        objectToIterate, _path->fieldRef(), &_traversalStartIndex, 0, fieldIndex);
     _state = BEGIN;
     _next.reset();
 
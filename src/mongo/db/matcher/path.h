@@ -34,6 +34,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/field_ref.h"
+#include "mongo/db/matcher/bson_field_index.h"
 
 namespace mongo {
 
@@ -205,14 +206,19 @@ public:
 
     /**
      * Constructs an iterator over 'objectToIterate', where the desired element(s) is/are at the end
-     * of 'path'.
+     * of 'path'. If 'fieldIndex' is non-null, it must be dedicated to 'objectToIterate' and is used
+     * to find the first part of 'path'.
      */
-    BSONElementIterator(const ElementPath* path, const BSONObj& objectToIterate);
+    BSONElementIterator(const ElementPath* path,
+                        const BSONObj& objectToIterate,
+                        BSONFieldIndex* fieldIndex = nullptr);
 
     virtual ~BSONElementIterator();
 
     void reset(const ElementPath* path, size_t suffixIndex, BSONElement elementToIterate);
-    void reset(const ElementPath* path, const BSONObj& objectToIterate);
+    void reset(const ElementPath* path,
+               const BSONObj& objectToIterate,
+               BSONFieldIndex* fieldIndex = nullptr);
 
     bool more();
     Context next();
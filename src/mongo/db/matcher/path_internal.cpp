@@ -42,9 +42,10 @@ bool isAllDigits(StringData str) {
 BSONElement getFieldDottedOrArray(const BSONObj& doc,
                                   const FieldRef& path,
                                   size_t* idxPath,
-                                  size_t startIndex) {
+                                  size_t startIndex,
+                                  BSONFieldIndex* fieldIndex) {
     if (path.numParts() == startIndex)
-        return doc.getField("");
+        return fieldIndex ? fieldIndex->getField(doc, ""_sd) : doc.getField("");
 
     BSONElement res;
 
@@ -52,7 +53,11 @@ BSONElement getFieldDottedOrArray(const BSONObj& doc,
     bool stop = false;
     size_t partNum = startIndex;
     while (partNum < path.numParts() && !stop) {
-        res = curr.getField(path.getPart(partNum));
+        if (fieldIndex && partNum == startIndex) {
+            res = fieldIndex->getField(curr, path.getPart(partNum));
+        } else {
+            res = curr.getField(path.getPart(partNum));
+        }
 
         switch (res.type()) {
             case EOO:
@@ -34,6 +34,7 @@
 #include "mongo/base/string_data.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/bson_field_index.h"
 
 namespace mongo {
 
@@ -43,10 +44,14 @@ bool isAllDigits(StringData str);
  * Finds the element at 'path' in 'doc', starting at 'startIndex' in 'path'. If none is found, an
  * EOO element is returned. If an array is encountered along 'path', the traversal stops early, and
  * the array is returned. 'idxPath' is set to the furthest index reached in 'path'.
+ *
+ * If 'fieldIndex' is non-null, it must be dedicated to 'doc' and is used to look up the first part
+ * of 'path' in 'doc'.
  */
 BSONElement getFieldDottedOrArray(const BSONObj& doc,
                                   const FieldRef& path,
                                   size_t* idxPath,
-                                  size_t startIndex = 0);
+                                  size_t startIndex = 0,
+                                  BSONFieldIndex* fieldIndex = nullptr);
 
 }  // namespace mongo
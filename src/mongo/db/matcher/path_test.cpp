@@ -593,4 +593,67 @@ TEST(SingleElementElementIterator, Simple1) {
 
     ASSERT(!i.more());
 }
+
+BSONObj buildWideObj(size_t numFields) {
+    BSONObjBuilder bob;
+    for (size_t i = 0; i < numFields; ++i)
+        bob.append("f" + std::to_string(i), static_cast<int>(i));
+    bob.append("sub", BSON("x" << 1));
+    bob.append("f0", "duplicate");
+    return bob.obj();
+}
+
+TEST(BSONFieldIndex, WideObjectIsIndexedAfterRepeatedLookups) {
+    BSONObj doc = buildWideObj(BSONFieldIndex::kMinFieldsToIndex);
+    BSONFieldIndex index;
+
+    for (size_t i = 0; i < BSONFieldIndex::kLookupsBeforeIndexing; ++i) {
+        ASSERT_EQ(3, index.getField(doc, "f3").numberInt());
+        ASSERT_FALSE(index.isIndexed());
+    }
+
+    ASSERT_EQ(5, index.getField(doc, "f5").numberInt());
+    ASSERT_TRUE(index.isIndexed());
+    ASSERT_EQ(doc["f7"].rawdata(), index.getField(doc, "f7").rawdata());
+    ASSERT_TRUE(index.getField(doc, "missing").eoo());
+
+    // Like BSONObj::getField(), the first of several fields with the same name wins.
+    ASSERT_EQ(BSONType::NumberInt, index.getField(doc, "f0").type());
+
+    index.reset();
+    ASSERT_FALSE(index.isIndexed());
+}
+
+TEST(BSONFieldIndex, NarrowObjectIsNeverIndexed) {
+    BSONObj doc = buildWideObj(8);
+    BSONFieldIndex index;
+
+    for (size_t i = 0; i <= 2 * BSONFieldIndex::kLookupsBeforeIndexing; ++i)
+        ASSERT_EQ(2, index.getField(doc, "f2").numberInt());
+    ASSERT_FALSE(index.isIndexed());
+}
+
+TEST(Path, IteratorUsesFieldIndexForFirstPathPart) {
+    BSONObj doc = buildWideObj(BSONFieldIndex::kMinFieldsToIndex);
+    BSONFieldIndex index;
+    ElementPath leaf{"f9"};
+    ElementPath dotted{"sub.x"};
+    ElementPath missing{"f9.x"};
+
+    for (size_t i = 0; i <= BSONFieldIndex::kLookupsBeforeIndexing; ++i) {
+        BSONElementIterator cursor(&leaf, doc, &index);
+        ASSERT(cursor.more());
+        ASSERT_EQUALS(9, cursor.next().element().numberInt());
+        ASSERT(!cursor.more());
+    }
+    ASSERT_TRUE(index.isIndexed());
+
+    BSONElementIterator cursor(&dotted, doc, &index);
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(1, cursor.next().element().numberInt());
+    ASSERT(!cursor.more());
+
+    cursor.reset(&missing, doc, &index);
+    ASSERT(!cursor.more());
+}
 }  // namespace mongo
@@ -109,6 +109,8 @@
 #include "mongo/db/periodic_runner_job_abort_expired_transactions.h"
 #include "mongo/db/pipeline/process_interface/replica_set_node_process_interface.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/query_result_cache.h"
+#include "mongo/db/query/query_result_cache_op_observer.h"
 #include "mongo/db/read_write_concern_defaults_cache_lookup_mongod.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/initial_syncer_factory.h"
@@ -169,10 +171,12 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/system_index.h"
+#include "mongo/db/timeseries/bucket_merger.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/ttl.h"
 #include "mongo/db/vector_clock_metadata_hook.h"
 #include "mongo/db/wire_version.h"
+#include "mongo/db/worker_pool.h"
 #include "mongo/executor/network_connection_hook.h"
 #include "mongo/executor/network_interface_factory.h"
 #include "mongo/executor/network_interface_thread_pool.h"
@@ -723,6 +727,7 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
                 "http://dochub.mongodb.org/core/ttlcollections");
         } else {
             startTTLMonitor(serviceContext);
+            startTimeseriesBucketMerger(serviceContext);
         }
 
         if (replSettings.usingReplSets() || !gInternalValidateFeaturesAsPrimary) {
@@ -1084,6 +1089,9 @@ void setUpObservers(ServiceContext* serviceContext) {
     opObserverRegistry->addObserver(
         std::make_unique<repl::PrimaryOnlyServiceOpObserver>(serviceContext));
     opObserverRegistry->addObserver(std::make_unique<FcvOpObserver>());
+    if (QueryResultCache::isEnabled()) {
+        opObserverRegistry->addObserver(std::make_unique<QueryResultCacheOpObserver>());
+    }
 
     setupFreeMonitoringOpObserver(opObserverRegistry.get());
 
@@ -1262,7 +1270,8 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         // marked as killed and will not be usable other than to kill all transactions directly
         // below.
         LOGV2_OPTIONS(4784912, {LogComponent::kDefault}, "Killing all operations for shutdown");
-        const std::set<std::string> excludedClients = {std::string(kFTDCThreadName)};
+        const std::set<std::string> excludedClients = {std::string(kFTDCThreadName),
+                                                       std::string(kFTDCHighFrequencyThreadName)};
         serviceContext->setKillAllOperations(excludedClients);
 
         // Clear tenant migration access blockers after killing all operation contexts to ensure
@@ -1367,6 +1376,12 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
     LOGV2(4784928, "Shutting down the TTL monitor");
     shutdownTTLMonitor(serviceContext);
 
+    LOGV2(6170424, "Shutting down the time-series bucket merger");
+    shutdownTimeseriesBucketMerger(serviceContext);
+
+    LOGV2(6170461, "Shutting down the worker thread pools");
+    shutdownWorkerPools(serviceContext);
+
     // We should always be able to acquire the global lock at shutdown.
     // An OperationContext is not necessary to call lockGlobal() during shutdown, as it's only used
     // to check that lockGlobal() is not called after a transaction timestamp has been set.
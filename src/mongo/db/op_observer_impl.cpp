@@ -46,6 +46,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/dbhelpers.h"
+#include "mongo/db/exec/shared_oplog_buffer.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/internal_transactions_feature_flag_gen.h"
 #include "mongo/db/keys_collection_document_gen.h"
@@ -688,7 +689,7 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
     } else if (args.nss.isTimeseriesBucketsCollection()) {
         if (args.updateArgs.source != OperationSource::kTimeseriesInsert) {
             auto& bucketCatalog = BucketCatalog::get(opCtx);
-            bucketCatalog.clear(args.updateArgs.updatedDoc["_id"].OID());
+            bucketCatalog.clearForDirectWrite(opCtx, args.updateArgs.updatedDoc["_id"].OID());
         }
     }
 }
@@ -710,7 +711,7 @@ void OpObserverImpl::aboutToDelete(OperationContext* opCtx,
 
     if (nss.isTimeseriesBucketsCollection()) {
         auto& bucketCatalog = BucketCatalog::get(opCtx);
-        bucketCatalog.clear(doc["_id"].OID());
+        bucketCatalog.clearForDirectWrite(opCtx, doc["_id"].OID());
     }
 }
 
@@ -749,6 +750,9 @@ void OpObserverImpl::onDelete(OperationContext* opCtx,
             if (args.oplogSlot) {
                 oplogEntry.setOpTime(*args.oplogSlot);
             }
+        } else if (args.oplogSlot && !args.storeImageInSideCollection) {
+            // The caller reserved the OpTime of the delete, and timestamped the write with it.
+            oplogEntry.setOpTime(*args.oplogSlot);
         }
 
         boost::optional<BSONObj> deletedDocForOplog = boost::none;
@@ -1615,6 +1619,10 @@ void OpObserverImpl::onReplicationRollback(OperationContext* opCtx,
     BucketCatalog::get(opCtx).clear([&timeseriesNamespaces](const NamespaceString& bucketNs) {
         return timeseriesNamespaces.contains(bucketNs);
     });
+
+    // Oplog scans must not be handed entries from before the rollback, since the RecordIds they
+    // follow may have been truncated and reused.
+    SharedOplogBuffer::get(opCtx).clear();
 }
 
 }  // namespace mongo
@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/tick_source.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * Accumulates the time an operation spends in each of the states below, so that slow operation
+ * logs, the profiler and $currentOp can show where a slow operation spent its time.
+ *
+ * The states can overlap: a ticket wait while reacquiring locks after a yield counts towards both
+ * kTicket and kYield.
+ *
+ * Only the thread running the operation adds time, but the totals are atomic so that $currentOp
+ * can read them from other threads.
+ */
+class OperationWaitStats {
+public:
+    enum class WaitState {
+        // Waiting for a read or write ticket to take the global lock.
+        kTicket,
+        // Waiting for a prepared transaction to commit or abort.
+        kPrepareConflict,
+        // Yielded by a query plan, including the time spent reacquiring the locks.
+        kYield,
+        // Reading and writing the files an external sort spilled to.
+        kSpillIO,
+        // Running JavaScript functions.
+        kJavaScript,
+        kNumStates,
+    };
+
+    static const OperationContext::Decoration<OperationWaitStats> get;
+
+    OperationWaitStats() = default;
+
+    /**
+     * Adds 'duration' to the time spent in 'state'.
+     */
+    void add(WaitState state, Microseconds duration) {
+        _waitMicros[static_cast<size_t>(state)].fetchAndAddRelaxed(
+            durationCount<Microseconds>(duration));
+    }
+
+    /**
+     * Returns the time spent in 'state'.
+     */
+    Microseconds getWaitTime(WaitState state) const {
+        return Microseconds(_waitMicros[static_cast<size_t>(state)].loadRelaxed());
+    }
+
+    /**
+     * Appends a field for each state the operation has spent time in, in microseconds. States with
+     * no time are omitted.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+    /**
+     * Returns the fields appended by append() as a document, which is empty if the operation has
+     * not spent time in any state.
+     */
+    BSONObj toBSON() const;
+
+    static StringData toString(WaitState state);
+
+private:
+    std::array<AtomicWord<long long>, static_cast<size_t>(WaitState::kNumStates)> _waitMicros{};
+};
+
+/**
+ * Adds the time between its construction and destruction to a state of the wait statistics of an
+ * operation. Does nothing if constructed without an operation.
+ */
+class ScopedWaitTimer {
+    ScopedWaitTimer(const ScopedWaitTimer&) = delete;
+    ScopedWaitTimer& operator=(const ScopedWaitTimer&) = delete;
+
+public:
+    ScopedWaitTimer(OperationContext* opCtx, OperationWaitStats::WaitState state);
+
+    /**
+     * Times the operation of the client attached to the current thread, if any.
+     */
+    explicit ScopedWaitTimer(OperationWaitStats::WaitState state);
+
+    ~ScopedWaitTimer();
+
+private:
+    OperationContext* const _opCtx;
+    const OperationWaitStats::WaitState _state;
+    TickSource::Tick _start{0};
+};
+
+}  // namespace mongo
@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/operation_wait_stats.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/tick_source_mock.h"
+
+namespace mongo {
+namespace {
+
+using WaitState = OperationWaitStats::WaitState;
+
+class OperationWaitStatsTest : public ServiceContextTest {
+public:
+    void setUp() override {
+        auto tickSource = std::make_unique<TickSourceMock<Microseconds>>();
+        _tickSource = tickSource.get();
+        getServiceContext()->setTickSource(std::move(tickSource));
+        _opCtx = makeOperationContext();
+    }
+
+    OperationContext* opCtx() const {
+        return _opCtx.get();
+    }
+
+    TickSourceMock<Microseconds>* tickSource() const {
+        return _tickSource;
+    }
+
+private:
+    TickSourceMock<Microseconds>* _tickSource;
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+TEST_F(OperationWaitStatsTest, EmptyByDefault) {
+    auto& waitStats = OperationWaitStats::get(opCtx());
+    ASSERT_EQ(waitStats.getWaitTime(WaitState::kTicket), Microseconds(0));
+    ASSERT_BSONOBJ_EQ(waitStats.toBSON(), BSONObj());
+}
+
+TEST_F(OperationWaitStatsTest, AddAccumulatesPerState) {
+    auto& waitStats = OperationWaitStats::get(opCtx());
+    waitStats.add(WaitState::kTicket, Microseconds(10));
+    waitStats.add(WaitState::kTicket, Microseconds(5));
+    waitStats.add(WaitState::kSpillIO, Microseconds(7));
+
+    ASSERT_EQ(waitStats.getWaitTime(WaitState::kTicket), Microseconds(15));
+    ASSERT_EQ(waitStats.getWaitTime(WaitState::kSpillIO), Microseconds(7));
+    ASSERT_EQ(waitStats.getWaitTime(WaitState::kYield), Microseconds(0));
+    ASSERT_BSONOBJ_EQ(waitStats.toBSON(), BSON("ticketMicros" << 15LL << "spillIOMicros" << 7LL));
+}
+
+TEST_F(OperationWaitStatsTest, ScopedWaitTimerAddsElapsedTime) {
+    {
+        ScopedWaitTimer timer(opCtx(), WaitState::kPrepareConflict);
+        tickSource()->advance(Microseconds(42));
+    }
+    {
+        // Times the operation of the current client.
+        ScopedWaitTimer timer(WaitState::kPrepareConflict);
+        tickSource()->advance(Microseconds(8));
+    }
+
+    ASSERT_EQ(OperationWaitStats::get(opCtx()).getWaitTime(WaitState::kPrepareConflict),
+              Microseconds(50));
+}
+
+TEST_F(OperationWaitStatsTest, ScopedWaitTimerWithoutOperationDoesNothing) {
+    ScopedWaitTimer timer(nullptr, WaitState::kJavaScript);
+    tickSource()->advance(Microseconds(42));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,383 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kWrite
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ops/parallel_multi_write.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/exec/collection_scan.h"
+#include "mongo/db/exec/delete.h"
+#include "mongo/db/exec/update_stage.h"
+#include "mongo/db/matcher/extensions_callback_real.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_executor_factory.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner.h"
+#include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/s/sharding_state.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/worker_pool.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace {
+
+// Writes the ranges of the multi-updates and multi-deletes which run in parallel.
+const WorkerPool multiWriteWorkers("MultiWrite", 64);
+
+// Splitting a scan is not worth starting the worker operations for fewer documents per range.
+constexpr long long kMinRecordsPerRange = 1000;
+
+/**
+ * The result of writing one range, which is merged into the result of the whole write.
+ */
+struct RangeResult {
+    long long numMatched = 0;
+    long long numModified = 0;
+    bool modifiers = false;
+    bool containsDotsAndDollarsField = false;
+    PlanSummaryStats summary;
+    OpDebug::AdditiveMetrics metrics;
+};
+
+using RangeWriter = std::function<RangeResult(
+    OperationContext* opCtx, const CollectionPtr& collection, const RecordIdRange& range)>;
+
+std::vector<RecordIdRange> partitionCollectionScan(OperationContext* opCtx,
+                                                   const CollectionPtr& collection,
+                                                   const CanonicalQuery* cq,
+                                                   const BSONObj& hint,
+                                                   const BSONObj& collation) {
+    const long long maxRanges = internalMultiWriteMaxParallelism.load();
+    if (maxRanges <= 1 || !collection || !cq || !hint.isEmpty()) {
+        return {};
+    }
+
+    // Each range is written by an operation of its own, outside of any session, so writes which
+    // must be atomic or retryable, and writes which need the shard versioning of this operation,
+    // always run as a single plan.
+    if (opCtx->getTxnNumber() || opCtx->inMultiDocumentTransaction() ||
+        !opCtx->writesAreReplicated() || ShardingState::get(opCtx)->enabled()) {
+        return {};
+    }
+
+    // The ranges divide the RecordIds evenly, which requires integer RecordIds. The workers
+    // resolve the collection by name, so they would not apply the collection default collation
+    // the same way as getExecutorUpdate() does.
+    const auto& nss = collection->ns();
+    if (nss.isSystem() || nss.isOplog() || nss.isTimeseriesBucketsCollection() ||
+        collection->isCapped() || collection->isClustered() ||
+        collection->getRecordStore()->keyFormat() != KeyFormat::Long ||
+        (collation.isEmpty() && collection->getDefaultCollator())) {
+        return {};
+    }
+
+    const auto numRanges = std::min(maxRanges, collection->numRecords(opCtx) / kMinRecordsPerRange);
+    if (numRanges <= 1) {
+        return {};
+    }
+
+    // Only split writes which would scan the whole collection anyway, since an index scan over a
+    // selective predicate usually beats several collection scans. fillOutPlannerParams() does not
+    // modify the query.
+    QueryPlannerParams plannerParams;
+    fillOutPlannerParams(opCtx, collection, const_cast<CanonicalQuery*>(cq), &plannerParams);
+    auto planned = QueryPlanner::plan(*cq, plannerParams);
+    if (!planned.multiPlannedCandidates.isOK() || planned.postMultiPlan ||
+        planned.multiPlannedCandidates.getValue().size() != 1 ||
+        planned.multiPlannedCandidates.getValue()[0]->root()->getType() != STAGE_COLLSCAN) {
+        return {};
+    }
+
+    auto first = collection->getCursor(opCtx, true /* forward */)->next();
+    auto last = collection->getCursor(opCtx, false /* forward */)->next();
+    if (!first || !last || last->id.getLong() - first->id.getLong() < numRanges) {
+        return {};
+    }
+
+    // The outermost ranges are left open, so that they include documents inserted at either end
+    // of the collection while the write runs, as a single collection scan might.
+    const long long minId = first->id.getLong();
+    const long long step = (last->id.getLong() - minId) / numRanges;
+    std::vector<RecordIdRange> ranges(numRanges);
+    for (long long i = 0; i < numRanges; ++i) {
+        if (i > 0) {
+            ranges[i].min = RecordId(minId + step * i);
+        }
+        if (i < numRanges - 1) {
+            ranges[i].max = RecordId(minId + step * (i + 1) - 1);
+        }
+    }
+    return ranges;
+}
+
+std::unique_ptr<PlanStage> makeRangeScan(ExpressionContext* expCtx,
+                                         const CollectionPtr& collection,
+                                         WorkingSet* ws,
+                                         const MatchExpression* filter,
+                                         const RecordIdRange& range) {
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    params.minRecord = range.min;
+    params.maxRecord = range.max;
+    return std::make_unique<CollectionScan>(expCtx, collection, params, ws, filter);
+}
+
+/**
+ * Writes 'range' from a new operation on the current thread, which must have its own client.
+ */
+RangeResult writeRangeOnWorker(OperationContext* opCtx,
+                               const NamespaceString& nss,
+                               const UUID& uuid,
+                               const RecordIdRange& range,
+                               const RangeWriter& writeRange) {
+    AutoGetCollection collection(opCtx, nss, MODE_IX);
+    uassert(ErrorCodes::QueryPlanKilled,
+            str::stream() << "Collection " << nss << " was dropped during a parallel multi-write",
+            collection && collection->uuid() == uuid);
+    uassert(ErrorCodes::PrimarySteppedDown,
+            str::stream() << "Not primary while writing to " << nss,
+            repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss));
+
+    auto result = writeRange(opCtx, collection.getCollection(), range);
+    result.metrics = CurOp::get(opCtx)->debug().additiveMetrics;
+    return result;
+}
+
+RangeResult writeRangesInParallel(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  const std::vector<RecordIdRange>& ranges,
+                                  const RangeWriter& writeRange) {
+    invariant(ranges.size() > 1);
+
+    // The workers run as separate operations, which inherit the time limit and the document
+    // validation settings of this one.
+    const auto nss = collection->ns();
+    const auto uuid = collection->uuid();
+    const auto deadline = opCtx->getDeadline();
+    const auto timeoutError = opCtx->getTimeoutError();
+    const auto validationSettings = DocumentValidationSettings::get(opCtx);
+
+    std::vector<RangeResult> results(ranges.size());
+    Status status = multiWriteWorkers.runTasks(
+        opCtx, ranges.size(), [&](OperationContext* workerOpCtx, size_t rangeId) {
+            if (rangeId == 0) {
+                results[0] = writeRange(workerOpCtx, collection, ranges[0]);
+                return;
+            }
+
+            {
+                stdx::lock_guard<Client> lk(*workerOpCtx->getClient());
+                workerOpCtx->getClient()->setSystemOperationKillableByStepdown(lk);
+            }
+            workerOpCtx->setDeadlineByDate(deadline, timeoutError);
+            DocumentValidationSettings::get(workerOpCtx) = validationSettings;
+            results[rangeId] =
+                writeRangeOnWorker(workerOpCtx, nss, uuid, ranges[rangeId], writeRange);
+        });
+
+    // The writes of the workers are not tracked by the client of this operation, which must wait
+    // for all of them to satisfy its write concern.
+    repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
+    uassertStatusOK(status);
+
+    RangeResult total;
+    auto& opDebug = CurOp::get(opCtx)->debug();
+    for (size_t rangeId = 0; rangeId < results.size(); ++rangeId) {
+        const auto& result = results[rangeId];
+        total.numMatched += result.numMatched;
+        total.numModified += result.numModified;
+        total.modifiers |= result.modifiers;
+        total.containsDotsAndDollarsField |= result.containsDotsAndDollarsField;
+        total.summary.accumulate(result.summary);
+        if (rangeId > 0) {
+            opDebug.additiveMetrics.add(result.metrics);
+        }
+    }
+
+    LOGV2_DEBUG(6170430,
+                2,
+                "Performed parallel multi-write",
+                "namespace"_attr = nss,
+                "numRanges"_attr = ranges.size(),
+                "numMatched"_attr = total.numMatched);
+    return total;
+}
+
+}  // namespace
+
+std::vector<RecordIdRange> partitionMultiUpdate(OperationContext* opCtx,
+                                                const CollectionPtr& collection,
+                                                const ParsedUpdate& parsedUpdate) {
+    const auto request = parsedUpdate.getRequest();
+    if (!request->isMulti() || request->isUpsert() || request->explain() ||
+        request->shouldReturnAnyDocs() || !parsedUpdate.hasParsedQuery()) {
+        return {};
+    }
+    return partitionCollectionScan(opCtx,
+                                   collection,
+                                   parsedUpdate.getParsedQuery(),
+                                   request->getHint(),
+                                   request->getCollation());
+}
+
+UpdateResult performParallelMultiUpdate(OperationContext* opCtx,
+                                        const CollectionPtr& collection,
+                                        const UpdateRequest& request,
+                                        const std::vector<RecordIdRange>& ranges,
+                                        PlanSummaryStats* summary) {
+    auto writeRange = [&request](OperationContext* opCtx,
+                                 const CollectionPtr& collection,
+                                 const RecordIdRange& range) {
+        // Each range parses the request again, since the parsed query and the update driver may
+        // only be used by one operation.
+        UpdateRequest rangeRequest(request);
+        const ExtensionsCallbackReal extensionsCallback(opCtx,
+                                                        &rangeRequest.getNamespaceString());
+        ParsedUpdate parsedUpdate(opCtx, &rangeRequest, extensionsCallback);
+        uassertStatusOK(parsedUpdate.parseRequest());
+        if (!parsedUpdate.hasParsedQuery()) {
+            uassertStatusOK(parsedUpdate.parseQueryToCQ());
+        }
+        auto driver = parsedUpdate.getDriver();
+        driver->refreshIndexKeys(&CollectionQueryInfo::get(collection).getIndexKeys(opCtx));
+
+        auto cq = parsedUpdate.releaseParsedQuery();
+        auto expCtx = cq->getExpCtxRaw();
+        auto ws = std::make_unique<WorkingSet>();
+        UpdateStageParams params(&rangeRequest, driver, &CurOp::get(opCtx)->debug());
+        params.canonicalQuery = cq.get();
+        auto root = std::make_unique<UpdateStage>(
+            expCtx,
+            params,
+            ws.get(),
+            collection,
+            makeRangeScan(expCtx, collection, ws.get(), cq->root(), range).release());
+        auto exec = uassertStatusOK(plan_executor_factory::make(std::move(cq),
+                                                                std::move(ws),
+                                                                std::move(root),
+                                                                &collection,
+                                                                parsedUpdate.yieldPolicy(),
+                                                                QueryPlannerParams::DEFAULT));
+
+        auto updateResult = exec->executeUpdate();
+        RangeResult result;
+        result.numMatched = updateResult.numMatched;
+        result.numModified = updateResult.numDocsModified;
+        result.modifiers = updateResult.modifiers;
+        result.containsDotsAndDollarsField = updateResult.containsDotsAndDollarsField;
+        exec->getPlanExplainer().getSummaryStats(&result.summary);
+        return result;
+    };
+
+    auto total = writeRangesInParallel(opCtx, collection, ranges, writeRange);
+    *summary = total.summary;
+    return UpdateResult(total.numMatched > 0,
+                        total.modifiers,
+                        total.numModified,
+                        total.numMatched,
+                        BSONObj(),
+                        total.containsDotsAndDollarsField);
+}
+
+std::vector<RecordIdRange> partitionMultiDelete(OperationContext* opCtx,
+                                                const CollectionPtr& collection,
+                                                const ParsedDelete& parsedDelete) {
+    const auto request = parsedDelete.getRequest();
+    if (!request->getMulti() || request->getIsExplain() || request->getReturnDeleted() ||
+        request->getGod() || request->getFromMigrate() || !parsedDelete.hasParsedQuery()) {
+        return {};
+    }
+    return partitionCollectionScan(opCtx,
+                                   collection,
+                                   parsedDelete.parsedQuery(),
+                                   request->getHint(),
+                                   request->getCollation());
+}
+
+long long performParallelMultiDelete(OperationContext* opCtx,
+                                     const CollectionPtr& collection,
+                                     const DeleteRequest& request,
+                                     const std::vector<RecordIdRange>& ranges,
+                                     PlanSummaryStats* summary) {
+    auto writeRange = [&request](OperationContext* opCtx,
+                                 const CollectionPtr& collection,
+                                 const RecordIdRange& range) {
+        DeleteRequest rangeRequest(request);
+        ParsedDelete parsedDelete(opCtx, &rangeRequest);
+        uassertStatusOK(parsedDelete.parseRequest());
+        if (!parsedDelete.hasParsedQuery()) {
+            uassertStatusOK(parsedDelete.parseQueryToCQ());
+        }
+
+        auto cq = parsedDelete.releaseParsedQuery();
+        auto expCtx = cq->getExpCtxRaw();
+        auto ws = std::make_unique<WorkingSet>();
+        auto params = std::make_unique<DeleteStageParams>();
+        params->isMulti = true;
+        params->opDebug = &CurOp::get(opCtx)->debug();
+        params->stmtId = rangeRequest.getStmtId();
+        params->canonicalQuery = cq.get();
+        auto root = std::make_unique<DeleteStage>(
+            expCtx,
+            std::move(params),
+            ws.get(),
+            collection,
+            makeRangeScan(expCtx, collection, ws.get(), cq->root(), range).release());
+        auto exec = uassertStatusOK(plan_executor_factory::make(std::move(cq),
+                                                                std::move(ws),
+                                                                std::move(root),
+                                                                &collection,
+                                                                parsedDelete.yieldPolicy(),
+                                                                QueryPlannerParams::DEFAULT));
+
+        RangeResult result;
+        result.numMatched = exec->executeDelete();
+        exec->getPlanExplainer().getSummaryStats(&result.summary);
+        return result;
+    };
+
+    auto total = writeRangesInParallel(opCtx, collection, ranges, writeRange);
+    *summary = total.summary;
+    return total.numMatched;
+}
+
+}  // namespace mongo
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/ops/parsed_delete.h"
+#include "mongo/db/ops/parsed_update.h"
+#include "mongo/db/ops/update_result.h"
+#include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+class CollectionPtr;
+class OperationContext;
+
+/**
+ * Multi-updates and multi-deletes which have to scan the whole collection can split the scan into
+ * ranges of RecordIds, up to 'internalMultiWriteMaxParallelism' of them, and write each range from
+ * its own operation on a worker thread. Every document is written in its own WriteUnitOfWork
+ * either way, so this only changes the order in which the documents are written.
+ */
+struct RecordIdRange {
+    // Both bounds are inclusive. A missing bound leaves that end of the range open.
+    boost::optional<RecordId> min;
+    boost::optional<RecordId> max;
+};
+
+/**
+ * Returns the ranges of RecordIds that the multi-update 'parsedUpdate' on 'collection' should be
+ * split into, or an empty vector if it should be executed as a single plan instead.
+ */
+std::vector<RecordIdRange> partitionMultiUpdate(OperationContext* opCtx,
+                                                const CollectionPtr& collection,
+                                                const ParsedUpdate& parsedUpdate);
+
+/**
+ * Applies 'request' to every range of 'ranges' concurrently, and returns the combined result. The
+ * first range is written by 'opCtx' itself. If any range fails, the others are interrupted and
+ * the error is thrown once they have all stopped; the documents written until then stay written,
+ * as for a multi-update which fails part way.
+ */
+UpdateResult performParallelMultiUpdate(OperationContext* opCtx,
+                                        const CollectionPtr& collection,
+                                        const UpdateRequest& request,
+                                        const std::vector<RecordIdRange>& ranges,
+                                        PlanSummaryStats* summary);
+
+/**
+ * Same as partitionMultiUpdate(), for the multi-delete 'parsedDelete'.
+ */
+std::vector<RecordIdRange> partitionMultiDelete(OperationContext* opCtx,
+                                                const CollectionPtr& collection,
+                                                const ParsedDelete& parsedDelete);
+
+/**
+ * Same as performParallelMultiUpdate(), for a multi-delete. Returns the number of documents
+ * deleted.
+ */
+long long performParallelMultiDelete(OperationContext* opCtx,
+                                     const CollectionPtr& collection,
+                                     const DeleteRequest& request,
+                                     const std::vector<RecordIdRange>& ranges,
+                                     PlanSummaryStats* summary);
+
+}  // namespace mongo
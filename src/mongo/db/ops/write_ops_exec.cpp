@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 
 #include "mongo/base/checked_cast.h"
@@ -42,6 +44,7 @@
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/curop_metrics.h"
@@ -50,10 +53,12 @@
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/update_stage.h"
 #include "mongo/db/introspect.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/not_primary_error_tracker.h"
 #include "mongo/db/ops/delete_request_gen.h"
 #include "mongo/db/ops/insert.h"
+#include "mongo/db/ops/parallel_multi_write.h"
 #include "mongo/db/ops/parsed_delete.h"
 #include "mongo/db/ops/parsed_update.h"
 #include "mongo/db/ops/update_request.h"
@@ -62,6 +67,8 @@
 #include "mongo/db/ops/write_ops_retryability.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
@@ -78,6 +85,7 @@
 #include "mongo/db/stats/server_write_concern_metrics.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
+#include "mongo/db/timeseries/bucket_measurement_deleter.h"
 #include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 #include "mongo/db/timeseries/timeseries_update_delete_util.h"
 #include "mongo/db/transaction_participant.h"
@@ -86,8 +94,11 @@
 #include "mongo/db/update/update_oplog_entry_serialization.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/s/would_change_owning_shard_exception.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_and_backoff.h"
 #include "mongo/util/scopeguard.h"
@@ -115,6 +126,8 @@ MONGO_FAIL_POINT_DEFINE(hangWithLockDuringBatchInsert);
 MONGO_FAIL_POINT_DEFINE(hangWithLockDuringBatchUpdate);
 MONGO_FAIL_POINT_DEFINE(hangWithLockDuringBatchRemove);
 MONGO_FAIL_POINT_DEFINE(failAtomicTimeseriesWrites);
+MONGO_FAIL_POINT_DEFINE(hangBeforeInsertGroupCommit);
+MONGO_FAIL_POINT_DEFINE(failInsertGroupCommitWithWriteConflict);
 
 void updateRetryStats(OperationContext* opCtx, bool containsRetry) {
     if (containsRetry) {
@@ -374,6 +387,191 @@ void insertDocuments(OperationContext* opCtx,
     wuow.commit();
 }
 
+Counter64 insertGroupCommitBatches;
+Counter64 insertGroupCommitDocuments;
+ServerStatusMetricField<Counter64> displayInsertGroupCommitBatches("insertGroupCommit.batches",
+                                                                  &insertGroupCommitBatches);
+ServerStatusMetricField<Counter64> displayInsertGroupCommitDocuments(
+    "insertGroupCommit.documents", &insertGroupCommitDocuments);
+
+/**
+ * Combines concurrent single-document inserts into a collection from different operations into one
+ * storage transaction, so that they share a single oplog slot reservation and commit.
+ *
+ * There is no dedicated thread: an operation that arrives while no batch is being committed for
+ * the collection becomes the leader and commits its own insert along with the ones queued at that
+ * point, while the other operations wait for it. A leader never waits for more inserts to arrive,
+ * so a combined insert adds no latency when there is no concurrency. If the combined insert fails,
+ * for instance because one of the documents is a duplicate, none of the documents are inserted and
+ * every operation inserts its own document instead, so that each one only observes its own errors.
+ */
+class InsertGroupCommitter {
+public:
+    static InsertGroupCommitter& get(OperationContext* opCtx);
+
+    /**
+     * Returns true if 'stmt' was inserted into 'collection' as part of a combined batch, in which
+     * case its oplog slot is filled in, or false if the caller must insert it by itself.
+     */
+    bool insert(OperationContext* opCtx, const CollectionPtr& collection, InsertStatement* stmt);
+
+private:
+    struct Request {
+        InsertStatement* stmt;
+        bool done = false;
+        bool inserted = false;
+    };
+
+    struct Group {
+        Mutex mutex = MONGO_MAKE_LATCH("InsertGroupCommitter::Group::mutex");
+        stdx::condition_variable cv;
+        std::deque<Request*> queue;
+        bool leaderActive = false;
+    };
+
+    void _commitBatch(OperationContext* opCtx,
+                      const CollectionPtr& collection,
+                      const std::vector<Request*>& batch);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("InsertGroupCommitter::_mutex");
+    stdx::unordered_map<UUID, std::shared_ptr<Group>, UUID::Hash> _groups;
+};
+
+const auto getInsertGroupCommitter = ServiceContext::declareDecoration<InsertGroupCommitter>();
+
+InsertGroupCommitter& InsertGroupCommitter::get(OperationContext* opCtx) {
+    return getInsertGroupCommitter(opCtx->getServiceContext());
+}
+
+bool InsertGroupCommitter::insert(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  InsertStatement* stmt) {
+    const auto uuid = collection->uuid();
+    std::shared_ptr<Group> group;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& entry = _groups[uuid];
+        if (!entry) {
+            entry = std::make_shared<Group>();
+        }
+        group = entry;
+    }
+
+    Request request{stmt};
+    stdx::unique_lock<Latch> lk(group->mutex);
+    group->queue.push_back(&request);
+    {
+        stdx::lock_guard<Client> clientLk(*opCtx->getClient());
+        CurOp::get(opCtx)->setMessage_inlock("waiting for insert group commit");
+    }
+
+    try {
+        opCtx->waitForConditionOrInterrupt(
+            group->cv, lk, [&] { return request.done || !group->leaderActive; });
+    } catch (const DBException&) {
+        auto it = std::find(group->queue.begin(), group->queue.end(), &request);
+        if (it != group->queue.end()) {
+            group->queue.erase(it);
+            throw;
+        }
+
+        // A leader is already inserting the document, which must remain valid until it is done.
+        group->cv.wait(lk, [&] { return request.done; });
+        return request.inserted;
+    }
+
+    if (request.done) {
+        return request.inserted;
+    }
+
+    // Become the leader. Our own insert goes first, in case there are more queued inserts than fit
+    // in a batch.
+    group->leaderActive = true;
+    group->queue.erase(std::find(group->queue.begin(), group->queue.end(), &request));
+    std::vector<Request*> batch{&request};
+    const size_t maxBatchSize = internalInsertGroupCommitMaxBatchSize.load();
+    while (!group->queue.empty() && batch.size() < maxBatchSize) {
+        batch.push_back(group->queue.front());
+        group->queue.pop_front();
+    }
+    lk.unlock();
+
+    hangBeforeInsertGroupCommit.pauseWhileSet(opCtx);
+
+    ON_BLOCK_EXIT([&] {
+        {
+            stdx::lock_guard<Latch> groupLk(group->mutex);
+            for (auto batchRequest : batch) {
+                batchRequest->done = true;
+            }
+            group->leaderActive = false;
+            group->cv.notify_all();
+        }
+
+        // Stop tracking collections without inserts in progress. Operations that still hold on to
+        // the group can keep using it, as they don't need it to be the one in the map.
+        stdx::lock_guard<Latch> registryLk(_mutex);
+        stdx::lock_guard<Latch> groupLk(group->mutex);
+        auto it = _groups.find(uuid);
+        if (it != _groups.end() && it->second == group && !group->leaderActive &&
+            group->queue.empty()) {
+            _groups.erase(it);
+        }
+    });
+
+    _commitBatch(opCtx, collection, batch);
+    return request.inserted;
+}
+
+void InsertGroupCommitter::_commitBatch(OperationContext* opCtx,
+                                        const CollectionPtr& collection,
+                                        const std::vector<Request*>& batch) {
+    // A single insert gains nothing from being committed on behalf of its operation.
+    if (batch.size() < 2) {
+        return;
+    }
+
+    std::vector<InsertStatement> stmts;
+    stmts.reserve(batch.size());
+    for (auto request : batch) {
+        stmts.push_back(*request->stmt);
+    }
+
+    try {
+        if (MONGO_unlikely(failInsertGroupCommitWithWriteConflict.shouldFail())) {
+            throw WriteConflictException();
+        }
+        insertDocuments(opCtx, collection, stmts.begin(), stmts.end(), false /* fromMigrate */);
+    } catch (const DBException&) {
+        // Leave every insert to its own operation, which reports its own errors.
+        return;
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i]->stmt->oplogSlot = stmts[i].oplogSlot;
+        batch[i]->inserted = true;
+    }
+    insertGroupCommitBatches.increment();
+    insertGroupCommitDocuments.increment(batch.size());
+}
+
+/**
+ * Returns true if the single-document insert 'wholeOp' may be committed together with the inserts
+ * of other operations, which requires that the insert has no per-operation semantics that a
+ * storage transaction shared with other operations could not preserve. In particular, the leader
+ * logs the whole batch according to its own operation, so only replicated writes are combined.
+ */
+bool canGroupCommitInsert(OperationContext* opCtx,
+                          const write_ops::InsertCommandRequest& wholeOp,
+                          const CollectionPtr& collection,
+                          OperationSource source) {
+    return internalInsertGroupCommitMaxBatchSize.load() > 1 &&
+        source == OperationSource::kStandard && opCtx->writesAreReplicated() &&
+        !opCtx->getTxnNumber() && !opCtx->inMultiDocumentTransaction() && !collection->isCapped() &&
+        !wholeOp.getNamespace().isSystem() &&
+        DocumentValidationSettings::get(opCtx).isDocumentValidationEnabled();
+}
+
 /**
  * Returns a OperationNotSupportedInTransaction error Status if we are in a transaction and
  * operating on a capped collection.
@@ -515,6 +713,36 @@ bool insertBatchAndHandleErrors(OperationContext* opCtx,
         }
     }
 
+    // Try to commit a singular batch along with the concurrent inserts of other operations into the
+    // same collection. If that is not possible, insert it by itself below.
+    if (collection && batch.size() == 1 &&
+        canGroupCommitInsert(opCtx, wholeOp, collection->getCollection(), source)) {
+        try {
+            lastOpFixer->startingOp();
+            if (InsertGroupCommitter::get(opCtx).insert(
+                    opCtx, collection->getCollection(), &batch.front())) {
+                // The combined insert may have been logged by another operation, in which case
+                // this operation's last op is that of its own document.
+                auto& replClientInfo = repl::ReplClientInfo::forClient(opCtx->getClient());
+                if (batch.front().oplogSlot > replClientInfo.getLastOp()) {
+                    replClientInfo.setLastOp(opCtx, batch.front().oplogSlot);
+                }
+                lastOpFixer->finishedOpSuccessfully();
+                globalOpCounters.gotInsert();
+                ServerWriteConcernMetrics::get(opCtx)->recordWriteConcernForInsert(
+                    opCtx->getWriteConcern());
+                SingleWriteResult result;
+                result.setN(1);
+                out->results.emplace_back(std::move(result));
+                curOp.debug().additiveMetrics.incrementNinserted(1);
+                return true;
+            }
+        } catch (const DBException&) {
+            // Insert the document by itself below, which reports any error that persists.
+            collection.reset();
+        }
+    }
+
     // Try to insert the batch one-at-a-time. This path is executed for singular batches,
     // multi-statement transactions, capped collections, and if we failed all-at-once inserting.
     for (auto it = batch.begin(); it != batch.end(); ++it) {
@@ -861,49 +1089,61 @@ static SingleWriteResult performSingleUpdateOp(OperationContext* opCtx,
 
     assertCanWrite_inlock(opCtx, ns);
 
-    auto exec = uassertStatusOK(
-        getExecutorUpdate(&curOp.debug(),
-                          collection ? &collection->getCollection() : &CollectionPtr::null,
-                          &parsedUpdate,
-                          boost::none /* verbosity */,
-                          std::move(documentCounter)));
+    PlanSummaryStats summary;
+    boost::optional<UpdateResult> updateResult;
+    if (auto ranges = partitionMultiUpdate(opCtx, collection->getCollection(), parsedUpdate);
+        !ranges.empty()) {
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            CurOp::get(opCtx)->setPlanSummary_inlock("COLLSCAN"_sd);
+        }
+        updateResult.emplace(performParallelMultiUpdate(
+            opCtx, collection->getCollection(), *updateRequest, ranges, &summary));
+    } else {
+        auto exec = uassertStatusOK(
+            getExecutorUpdate(&curOp.debug(),
+                              collection ? &collection->getCollection() : &CollectionPtr::null,
+                              &parsedUpdate,
+                              boost::none /* verbosity */,
+                              std::move(documentCounter)));
 
-    {
-        stdx::lock_guard<Client> lk(*opCtx->getClient());
-        CurOp::get(opCtx)->setPlanSummary_inlock(exec->getPlanExplainer().getPlanSummary());
-    }
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            CurOp::get(opCtx)->setPlanSummary_inlock(exec->getPlanExplainer().getPlanSummary());
+        }
 
-    auto updateResult = exec->executeUpdate();
+        updateResult.emplace(exec->executeUpdate());
 
-    PlanSummaryStats summary;
-    auto&& explainer = exec->getPlanExplainer();
-    explainer.getSummaryStats(&summary);
-    if (const auto& coll = collection->getCollection()) {
-        CollectionQueryInfo::get(coll).notifyOfQuery(opCtx, coll, summary);
+        auto&& explainer = exec->getPlanExplainer();
+        explainer.getSummaryStats(&summary);
+        if (curOp.shouldDBProfile(opCtx)) {
+            auto&& [stats, _] =
+                explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
+            curOp.debug().execStats = std::move(stats);
+        }
     }
 
-    if (curOp.shouldDBProfile(opCtx)) {
-        auto&& [stats, _] = explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
-        curOp.debug().execStats = std::move(stats);
+    if (const auto& coll = collection->getCollection()) {
+        CollectionQueryInfo::get(coll).notifyOfQuery(opCtx, coll, summary);
     }
 
     if (source != OperationSource::kTimeseriesInsert &&
         source != OperationSource::kTimeseriesUpdate) {
-        recordUpdateResultInOpDebug(updateResult, &curOp.debug());
+        recordUpdateResultInOpDebug(*updateResult, &curOp.debug());
     }
     curOp.debug().setPlanSummaryMetrics(summary);
 
-    const bool didInsert = !updateResult.upsertedId.isEmpty();
-    const long long nMatchedOrInserted = didInsert ? 1 : updateResult.numMatched;
+    const bool didInsert = !updateResult->upsertedId.isEmpty();
+    const long long nMatchedOrInserted = didInsert ? 1 : updateResult->numMatched;
     SingleWriteResult result;
     result.setN(nMatchedOrInserted);
-    result.setNModified(updateResult.numDocsModified);
-    result.setUpsertedId(updateResult.upsertedId);
+    result.setNModified(updateResult->numDocsModified);
+    result.setUpsertedId(updateResult->upsertedId);
 
     CurOpFailpointHelpers::waitWhileFailPointEnabled(
         &hangAfterBatchUpdate, opCtx, "hangAfterBatchUpdate");
 
-    if (containsDotsAndDollarsField && updateResult.containsDotsAndDollarsField) {
+    if (containsDotsAndDollarsField && updateResult->containsDotsAndDollarsField) {
         *containsDotsAndDollarsField = true;
     }
 
@@ -1018,6 +1258,37 @@ WriteResult performUpdates(OperationContext* opCtx,
     const auto& runtimeConstants =
         wholeOp.getLegacyRuntimeConstants().value_or(Variables::generateRuntimeConstants(opCtx));
 
+    // Consecutive single-document updates by _id, such as those of a bulk upsert, are applied
+    // under a single acquisition of the collection lock, which each update then takes recursively.
+    // Each of them looks up a single document through the _id index, so it has no need to yield.
+    boost::optional<AutoGetCollection> heldCollection;
+    int numUpdatesUnderHeldCollection = 0;
+    auto holdCollectionForUpdate = [&](const write_ops::UpdateOpEntry& op) {
+        if (source != OperationSource::kStandard || opCtx->inMultiDocumentTransaction() ||
+            op.getMulti() || !CanonicalQuery::isSimpleIdQuery(op.getQ())) {
+            heldCollection.reset();
+            return;
+        }
+
+        if (heldCollection &&
+            numUpdatesUnderHeldCollection >= internalUpdateMaxIdQueryBatchSize.load()) {
+            heldCollection.reset();
+        }
+        if (!heldCollection) {
+            const auto& ns = wholeOp.getNamespace();
+            heldCollection.emplace(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
+            numUpdatesUnderHeldCollection = 0;
+
+            // An upsert into a collection which does not exist must create it, which it cannot do
+            // while we hold the collection lock.
+            if (!*heldCollection) {
+                heldCollection.reset();
+                return;
+            }
+        }
+        ++numUpdatesUnderHeldCollection;
+    };
+
     for (auto&& singleOp : wholeOp.getUpdates()) {
         const auto stmtId = getStmtIdForWriteOp(opCtx, wholeOp, stmtIdIndex++);
         if (opCtx->getTxnNumber()) {
@@ -1056,18 +1327,35 @@ WriteResult performUpdates(OperationContext* opCtx,
                 ? *wholeOp.getStmtIds()
                 : std::vector<StmtId>{stmtId};
 
-            out.results.emplace_back(performSingleUpdateOpWithDupKeyRetry(
-                opCtx,
-                source == OperationSource::kTimeseriesUpdate
-                    ? wholeOp.getNamespace().makeTimeseriesBucketsNamespace()
-                    : wholeOp.getNamespace(),
-                stmtIds,
-                singleOp,
-                runtimeConstants,
-                wholeOp.getLet(),
-                source));
+            auto performUpdate = [&] {
+                return performSingleUpdateOpWithDupKeyRetry(
+                    opCtx,
+                    source == OperationSource::kTimeseriesUpdate
+                        ? wholeOp.getNamespace().makeTimeseriesBucketsNamespace()
+                        : wholeOp.getNamespace(),
+                    stmtIds,
+                    singleOp,
+                    runtimeConstants,
+                    wholeOp.getLet(),
+                    source);
+            };
+
+            holdCollectionForUpdate(singleOp);
+            if (heldCollection) {
+                try {
+                    out.results.emplace_back(performUpdate());
+                } catch (const WriteConflictException&) {
+                    // The update cannot yield to retry after a write conflict while we hold the
+                    // collection lock, so release it and retry the update on its own.
+                    heldCollection.reset();
+                    out.results.emplace_back(performUpdate());
+                }
+            } else {
+                out.results.emplace_back(performUpdate());
+            }
             lastOpFixer.finishedOpSuccessfully();
         } catch (const DBException& ex) {
+            heldCollection.reset();
             const bool canContinue = handleError(opCtx,
                                                  ex,
                                                  wholeOp.getNamespace(),
@@ -1134,6 +1422,7 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
     AutoGetCollection collection(opCtx, ns, fixLockModeForSystemDotViewsChanges(ns, MODE_IX));
 
     DeleteStageParams::DocumentCounter documentCounter = nullptr;
+    DeleteStageParams::PartialDeleter partialDeleter = nullptr;
 
     if (source == OperationSource::kTimeseriesDelete) {
         uassert(ErrorCodes::NamespaceNotFound,
@@ -1153,30 +1442,52 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
                     *timeseriesOptions, request.getHint())));
         }
 
-        uassert(ErrorCodes::InvalidOptions,
-                "Cannot perform a delete with a non-empty query on a time-series collection that "
-                "does not have a metaField",
-                timeseriesOptions->getMetaField() || request.getQuery().isEmpty());
-
-        uassert(ErrorCodes::InvalidOptions,
-                str::stream() << "Cannot perform a delete on a time-series collection "
-                                 "when querying on a field that is not the metaField '"
-                              << timeseriesOptions->getMetaField() << "'",
-                timeseriesQueryOnlyDependsOnMetaField(opCtx,
-                                                      ns,
-                                                      request.getQuery(),
-                                                      timeseriesOptions->getMetaField(),
-                                                      runtimeConstants,
-                                                      letParams));
         uassert(ErrorCodes::IllegalOperation,
                 "Cannot perform a non-multi delete on a time-series collection",
                 request.getMulti());
-        if (auto metaField = timeseriesOptions->getMetaField()) {
-            request.setQuery(timeseries::translateQuery(request.getQuery(), *metaField));
-        }
 
-        documentCounter =
-            timeseries::numMeasurementsForBucketCounter(timeseriesOptions->getTimeField());
+        if (timeseriesQueryOnlyDependsOnMetaField(opCtx,
+                                                  ns,
+                                                  request.getQuery(),
+                                                  timeseriesOptions->getMetaField(),
+                                                  runtimeConstants,
+                                                  letParams)) {
+            // Every measurement of a matching bucket matches, so whole buckets are deleted.
+            if (auto metaField = timeseriesOptions->getMetaField()) {
+                request.setQuery(timeseries::translateQuery(request.getQuery(), *metaField));
+            }
+
+            documentCounter =
+                timeseries::numMeasurementsForBucketCounter(timeseriesOptions->getTimeField());
+        } else {
+            // Scan the buckets which may hold matching measurements, and rewrite each of them
+            // without its matching measurements in a single write.
+            std::unique_ptr<CollatorInterface> collator;
+            if (!request.getCollation().isEmpty()) {
+                collator = uassertStatusOK(CollatorFactoryInterface::get(opCtx->getServiceContext())
+                                               ->makeFromBSON(request.getCollation()));
+            } else if (collection->getDefaultCollator()) {
+                collator = collection->getDefaultCollator()->clone();
+            }
+            auto expCtx = make_intrusive<ExpressionContext>(
+                opCtx, std::move(collator), ns, runtimeConstants, letParams);
+            auto predicate = uassertStatusOK(
+                MatchExpressionParser::parse(request.getQuery(),
+                                             expCtx,
+                                             ExtensionsCallbackReal(opCtx, &ns),
+                                             MatchExpressionParser::kAllowAllSpecialFeatures));
+            partialDeleter = timeseries::makeMeasurementDeleter(
+                std::move(expCtx),
+                std::move(predicate),
+                *timeseriesOptions,
+                collection->getDefaultCollator() ? collection->getDefaultCollator()->clone()
+                                                 : nullptr);
+
+            request.setQuery(
+                timeseries::getBucketLevelQuery(request.getQuery(),
+                                                timeseriesOptions->getTimeField(),
+                                                timeseriesOptions->getMetaField()));
+        }
     }
 
     ParsedDelete parsedDelete(opCtx, &request);
@@ -1191,33 +1502,46 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
     CurOpFailpointHelpers::waitWhileFailPointEnabled(
         &hangWithLockDuringBatchRemove, opCtx, "hangWithLockDuringBatchRemove");
 
-    auto exec = uassertStatusOK(getExecutorDelete(&curOp.debug(),
-                                                  &collection.getCollection(),
-                                                  &parsedDelete,
-                                                  boost::none /* verbosity */,
-                                                  std::move(documentCounter)));
+    PlanSummaryStats summary;
+    long long nDeleted = 0;
+    if (auto ranges = partitionMultiDelete(opCtx, collection.getCollection(), parsedDelete);
+        !ranges.empty()) {
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            CurOp::get(opCtx)->setPlanSummary_inlock("COLLSCAN"_sd);
+        }
+        nDeleted = performParallelMultiDelete(
+            opCtx, collection.getCollection(), request, ranges, &summary);
+    } else {
+        auto exec = uassertStatusOK(getExecutorDelete(&curOp.debug(),
+                                                      &collection.getCollection(),
+                                                      &parsedDelete,
+                                                      boost::none /* verbosity */,
+                                                      std::move(documentCounter),
+                                                      std::move(partialDeleter)));
 
-    {
-        stdx::lock_guard<Client> lk(*opCtx->getClient());
-        CurOp::get(opCtx)->setPlanSummary_inlock(exec->getPlanExplainer().getPlanSummary());
-    }
+        {
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            CurOp::get(opCtx)->setPlanSummary_inlock(exec->getPlanExplainer().getPlanSummary());
+        }
 
-    auto nDeleted = exec->executeDelete();
+        nDeleted = exec->executeDelete();
+
+        auto&& explainer = exec->getPlanExplainer();
+        explainer.getSummaryStats(&summary);
+        if (curOp.shouldDBProfile(opCtx)) {
+            auto&& [stats, _] =
+                explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
+            curOp.debug().execStats = std::move(stats);
+        }
+    }
     curOp.debug().additiveMetrics.ndeleted = nDeleted;
 
-    PlanSummaryStats summary;
-    auto&& explainer = exec->getPlanExplainer();
-    explainer.getSummaryStats(&summary);
     if (const auto& coll = collection.getCollection()) {
         CollectionQueryInfo::get(coll).notifyOfQuery(opCtx, coll, summary);
     }
     curOp.debug().setPlanSummaryMetrics(summary);
 
-    if (curOp.shouldDBProfile(opCtx)) {
-        auto&& [stats, _] = explainer.getWinningPlanStats(ExplainOptions::Verbosity::kExecStats);
-        curOp.debug().execStats = std::move(stats);
-    }
-
     SingleWriteResult result;
     result.setN(nDeleted);
     return result;
@@ -81,6 +81,16 @@ public:
         processInternal(input, merging);
     }
 
+    /**
+     * Processes each of 'inputs' in order, as process(input, false) would. Accumulators that can
+     * consume a run of values more cheaply than one value at a time override this.
+     */
+    virtual void processBatch(const std::vector<Value>& inputs) {
+        for (auto&& input : inputs) {
+            processInternal(input, false);
+        }
+    }
+
     /**
      * Finish processing all the pending operations, and clean up memory. Some accumulators
      * ($accumulator for example) might do a batch processing in order to improve performace. In
@@ -190,6 +200,125 @@ private:
     int _maxMemUsageBytes;
 };
 
+/**
+ * Estimates the number of distinct input values with a HyperLogLog sketch. Unlike $addToSet, the
+ * memory used is fixed, regardless of how many distinct values there are; in exchange the result
+ * has a relative standard error of about 1.04 / sqrt(kNumRegisters), or 1.6%. Values are distinct
+ * according to the collation of the query, as for $addToSet.
+ *
+ * The partial result of this accumulator is the register array of its sketch, which is merged by
+ * taking the maximum of every register.
+ */
+class AccumulatorApproxCountDistinct final : public AccumulatorState {
+public:
+    static constexpr auto kName = "$approxCountDistinct"_sd;
+
+    // The number of bits of a value's hash which select its register.
+    static constexpr int kPrecision = 12;
+    static constexpr size_t kNumRegisters = size_t{1} << kPrecision;
+
+    const char* getOpName() const final {
+        return kName.rawData();
+    }
+
+    explicit AccumulatorApproxCountDistinct(ExpressionContext* expCtx);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    void reset() final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* expCtx);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    // For each register, the maximum number of leading zeros plus one seen among the hash bits
+    // which do not select the register. Empty until the first value is seen.
+    std::vector<uint8_t> _registers;
+};
+
+/**
+ * Estimates the 'percentile'-th percentile, between 0 and 1, of the numeric input values with a
+ * merging t-digest. The digest summarizes the values as at most about kCompression weighted
+ * centroids, which are smaller near the extremes, so the estimate is most accurate for percentiles
+ * close to 0 or 1. Non-numeric and NaN values are ignored. The result is null if there were no
+ * numeric values.
+ *
+ * The partial result of this accumulator is its digest, which is merged by combining the centroids
+ * of both digests.
+ */
+class AccumulatorApproxPercentile final : public AccumulatorState {
+public:
+    static constexpr auto kName = "$approxPercentile"_sd;
+    static constexpr auto kInputArg = "input"_sd;
+    static constexpr auto kPercentileArg = "p"_sd;
+
+    // Bounds the number of centroids kept by the digest.
+    static constexpr double kCompression = 100;
+
+    const char* getOpName() const final {
+        return kName.rawData();
+    }
+
+    AccumulatorApproxPercentile(ExpressionContext* expCtx, double percentile);
+
+    /**
+     * Parses the argument of $approxPercentile, {input: <expression>, p: <number>}, into the input
+     * expression and the percentile.
+     */
+    static std::pair<boost::intrusive_ptr<Expression>, double> parseArgs(
+        ExpressionContext* expCtx, BSONElement elem, VariablesParseState vps);
+
+    void processInternal(const Value& input, bool merging) final;
+    Value getValue(bool toBeMerged) final;
+    void reset() final;
+
+    Document serialize(boost::intrusive_ptr<Expression> initializer,
+                       boost::intrusive_ptr<Expression> argument,
+                       bool explain) const final;
+
+    static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* expCtx,
+                                                         double percentile);
+
+    bool isAssociative() const final {
+        return true;
+    }
+
+    bool isCommutative() const final {
+        return true;
+    }
+
+private:
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    void addCentroid(Centroid centroid);
+
+    /**
+     * Merges '_unmerged' into '_centroids', combining neighbouring centroids as long as the
+     * t-digest size bound allows it.
+     */
+    void compress();
+
+    double _percentile;
+
+    // Sorted by mean.
+    std::vector<Centroid> _centroids;
+    std::vector<Centroid> _unmerged;
+
+    double _totalWeight = 0;
+    double _min = 0;
+    double _max = 0;
+};
+
 class AccumulatorFirst final : public AccumulatorState {
 public:
     static constexpr auto kName = "$first"_sd;
@@ -239,6 +368,16 @@ private:
     Value _last;
 };
 
+/**
+ * Finds the end of the run of values in 'inputs' starting at 'begin' that share its type. If that
+ * type is NumberInt, NumberLong or NumberDouble, the whole run is added to 'total' in order using
+ * the batch kernels of DoubleDoubleSummation; values of any other type are left to the caller.
+ * Returns the end of the run.
+ */
+size_t addNonDecimalRun(const std::vector<Value>& inputs,
+                        size_t begin,
+                        DoubleDoubleSummation* total);
+
 class AccumulatorSum final : public AccumulatorState {
 public:
     static constexpr auto kName = "$sum"_sd;
@@ -250,6 +389,7 @@ public:
     explicit AccumulatorSum(ExpressionContext* expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatch(const std::vector<Value>& inputs) final;
     Value getValue(bool toBeMerged) final;
     void reset() final;
 
@@ -343,7 +483,15 @@ public:
     static boost::intrusive_ptr<AccumulatorState> create(ExpressionContext* expCtx);
 
 private:
-    std::vector<Value> _array;
+    /**
+     * Returns the array being accumulated for modification, copying it first if a Value returned
+     * by getValue() still shares it.
+     */
+    std::vector<Value>& _mutableArray();
+
+    // Shared with the Values returned by getValue(), so that producing the result of a group does
+    // not copy every element. Null until the first element is accumulated.
+    boost::intrusive_ptr<RCVector> _array;
     int _maxMemUsageBytes;
 };
 
@@ -358,6 +506,7 @@ public:
     explicit AccumulatorAvg(ExpressionContext* expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatch(const std::vector<Value>& inputs) final;
     Value getValue(bool toBeMerged) final;
     void reset() final;
 
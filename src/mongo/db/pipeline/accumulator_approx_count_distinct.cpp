@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/window_function/window_function_expression.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_ACCUMULATOR_CONDITIONALLY(
+    approxCountDistinct,
+    genericParseSBEUnsupportedSingleExpressionAccumulator<AccumulatorApproxCountDistinct>,
+    AllowedWithApiStrict::kNeverInVersion1,
+    AllowedWithClientType::kAny,
+    multiversion::FeatureCompatibilityVersion::kVersion_5_1,
+    true);
+REGISTER_WINDOW_FUNCTION_WITH_MIN_VERSION(
+    approxCountDistinct,
+    window_function::ExpressionFromAccumulator<AccumulatorApproxCountDistinct>::parse,
+    multiversion::FeatureCompatibilityVersion::kVersion_5_1);
+
+namespace {
+/**
+ * The finalizer of MurmurHash3. The hash of a Value combines the hashes of its parts without mixing
+ * their bits well, while HyperLogLog relies on every bit of the hash being uniformly distributed.
+ */
+uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+}  // namespace
+
+void AccumulatorApproxCountDistinct::processInternal(const Value& input, bool merging) {
+    auto allocateRegisters = [&] {
+        if (_registers.empty()) {
+            _registers.resize(kNumRegisters, 0);
+            _memUsageBytes = sizeof(*this) + _registers.capacity();
+        }
+    };
+
+    if (!merging) {
+        if (input.missing()) {
+            return;
+        }
+
+        allocateRegisters();
+        const uint64_t hash = mixHash(getExpressionContext()->getValueComparator().hash(input));
+        const auto index = hash >> (64 - kPrecision);
+        // Set the lowest bit so that the rank is at most 64 - kPrecision + 1.
+        const uint64_t remainder = (hash << kPrecision) | (uint64_t{1} << (kPrecision - 1));
+        const auto rank = static_cast<uint8_t>(countLeadingZeros64(remainder) + 1);
+        _registers[index] = std::max(_registers[index], rank);
+        return;
+    }
+
+    uassert(5899600,
+            str::stream() << "Expected a partial " << kName << " sketch of " << kNumRegisters
+                          << " bytes when merging, but found " << input.toString(),
+            input.getType() == BSONType::BinData);
+    auto binData = input.getBinData();
+    if (binData.length == 0) {
+        // The partial result of a group which did not see any value.
+        return;
+    }
+    uassert(5899601,
+            str::stream() << "Expected a partial " << kName << " sketch of " << kNumRegisters
+                          << " bytes when merging, but found " << binData.length << " bytes",
+            static_cast<size_t>(binData.length) == kNumRegisters);
+    allocateRegisters();
+    auto otherRegisters = static_cast<const uint8_t*>(binData.data);
+    for (size_t i = 0; i < kNumRegisters; ++i) {
+        _registers[i] = std::max(_registers[i], otherRegisters[i]);
+    }
+}
+
+Value AccumulatorApproxCountDistinct::getValue(bool toBeMerged) {
+    if (toBeMerged) {
+        return Value(BSONBinData(_registers.data(), _registers.size(), BinDataGeneral));
+    }
+
+    if (_registers.empty()) {
+        return Value(0LL);
+    }
+
+    const double numRegisters = kNumRegisters;
+    double sum = 0;
+    size_t numZeroRegisters = 0;
+    for (auto reg : _registers) {
+        sum += std::ldexp(1.0, -reg);
+        numZeroRegisters += reg == 0;
+    }
+
+    const double alpha = 0.7213 / (1 + 1.079 / numRegisters);
+    double estimate = alpha * numRegisters * numRegisters / sum;
+    if (estimate <= 2.5 * numRegisters && numZeroRegisters > 0) {
+        // Linear counting is more accurate for small cardinalities. A 64-bit hash makes the large
+        // range correction of the original algorithm unnecessary.
+        estimate = numRegisters * std::log(numRegisters / numZeroRegisters);
+    }
+    return Value(std::llround(estimate));
+}
+
+AccumulatorApproxCountDistinct::AccumulatorApproxCountDistinct(ExpressionContext* const expCtx)
+    : AccumulatorState(expCtx) {
+    _memUsageBytes = sizeof(*this);
+}
+
+void AccumulatorApproxCountDistinct::reset() {
+    _registers = {};
+    _memUsageBytes = sizeof(*this);
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorApproxCountDistinct::create(
+    ExpressionContext* const expCtx) {
+    return new AccumulatorApproxCountDistinct(expCtx);
+}
+
+}  // namespace mongo
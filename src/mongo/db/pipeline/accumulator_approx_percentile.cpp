@@ -0,0 +1,282 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/db/pipeline/accumulator.h"
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/window_function/window_function_expression.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+namespace {
+AccumulationExpression parseApproxPercentile(ExpressionContext* const expCtx,
+                                             BSONElement elem,
+                                             VariablesParseState vps) {
+    expCtx->sbeGroupCompatible = false;
+    auto [input, percentile] = AccumulatorApproxPercentile::parseArgs(expCtx, elem, vps);
+    return {ExpressionConstant::create(expCtx, Value(BSONNULL)),
+            std::move(input),
+            [expCtx, percentile = percentile]() {
+                return AccumulatorApproxPercentile::create(expCtx, percentile);
+            },
+            AccumulatorApproxPercentile::kName};
+}
+
+// The number of centroids buffered before they are merged into the digest.
+constexpr size_t kMaxUnmergedCentroids = 5 * AccumulatorApproxPercentile::kCompression;
+
+// Field names of the partial result.
+constexpr auto kMinField = "min"_sd;
+constexpr auto kMaxField = "max"_sd;
+constexpr auto kMeansField = "means"_sd;
+constexpr auto kWeightsField = "weights"_sd;
+
+/**
+ * The k1 scale function of the t-digest, which maps a quantile to [-kCompression/4,
+ * kCompression/4], and its inverse. A centroid may span at most one unit of the scale, which keeps
+ * the centroids near the extremes small.
+ */
+double scale(double quantile) {
+    return AccumulatorApproxPercentile::kCompression / (2 * M_PI) * std::asin(2 * quantile - 1);
+}
+
+double inverseScale(double k) {
+    constexpr auto kCompression = AccumulatorApproxPercentile::kCompression;
+    return (std::sin(std::min(k, kCompression / 4) * 2 * M_PI / kCompression) + 1) / 2;
+}
+}  // namespace
+
+REGISTER_ACCUMULATOR_CONDITIONALLY(approxPercentile,
+                                   parseApproxPercentile,
+                                   AllowedWithApiStrict::kNeverInVersion1,
+                                   AllowedWithClientType::kAny,
+                                   multiversion::FeatureCompatibilityVersion::kVersion_5_1,
+                                   true);
+REGISTER_WINDOW_FUNCTION_WITH_MIN_VERSION(approxPercentile,
+                                          window_function::ExpressionApproxPercentile::parse,
+                                          multiversion::FeatureCompatibilityVersion::kVersion_5_1);
+
+std::pair<intrusive_ptr<Expression>, double> AccumulatorApproxPercentile::parseArgs(
+    ExpressionContext* const expCtx, BSONElement elem, VariablesParseState vps) {
+    uassert(5899602,
+            str::stream() << kName << " specification must be an object; found " << elem,
+            elem.type() == BSONType::Object);
+
+    intrusive_ptr<Expression> input;
+    boost::optional<double> percentile;
+    for (auto&& arg : elem.embeddedObject()) {
+        auto argName = arg.fieldNameStringData();
+        if (argName == kInputArg) {
+            input = Expression::parseOperand(expCtx, arg, vps);
+        } else if (argName == kPercentileArg) {
+            uassert(5899603,
+                    str::stream() << "'" << kPercentileArg << "' for " << kName
+                                  << " must be a number between 0 and 1, found " << arg,
+                    arg.isNumber() && arg.numberDouble() >= 0 && arg.numberDouble() <= 1);
+            percentile = arg.numberDouble();
+        } else {
+            uasserted(5899604,
+                      str::stream() << "Unknown argument for " << kName << ": " << argName);
+        }
+    }
+    uassert(5899605, str::stream() << "Missing '" << kInputArg << "' for " << kName, input);
+    uassert(
+        5899606, str::stream() << "Missing '" << kPercentileArg << "' for " << kName, percentile);
+    return {std::move(input), *percentile};
+}
+
+void AccumulatorApproxPercentile::processInternal(const Value& input, bool merging) {
+    auto extendRange = [&](double min, double max) {
+        _min = _totalWeight == 0 ? min : std::min(_min, min);
+        _max = _totalWeight == 0 ? max : std::max(_max, max);
+    };
+
+    if (!merging) {
+        if (!input.numeric()) {
+            return;
+        }
+        auto value = input.coerceToDouble();
+        if (std::isnan(value)) {
+            return;
+        }
+        extendRange(value, value);
+        addCentroid({value, 1});
+        return;
+    }
+
+    uassert(5899607,
+            str::stream() << "Expected a partial " << kName
+                          << " digest when merging, but found " << input.toString(),
+            input.getType() == BSONType::Object);
+    auto partial = input.getDocument();
+    auto means = partial[kMeansField];
+    auto weights = partial[kWeightsField];
+    uassert(5899608,
+            str::stream() << "Invalid partial " << kName << " digest: " << input.toString(),
+            means.isArray() && weights.isArray() &&
+                means.getArrayLength() == weights.getArrayLength());
+    if (means.getArrayLength() == 0) {
+        return;
+    }
+
+    extendRange(partial[kMinField].coerceToDouble(), partial[kMaxField].coerceToDouble());
+    for (size_t i = 0; i < means.getArrayLength(); ++i) {
+        addCentroid({means[i].coerceToDouble(), weights[i].coerceToDouble()});
+    }
+}
+
+void AccumulatorApproxPercentile::addCentroid(Centroid centroid) {
+    _unmerged.push_back(centroid);
+    _totalWeight += centroid.weight;
+    if (_unmerged.size() >= kMaxUnmergedCentroids) {
+        compress();
+    }
+    _memUsageBytes =
+        sizeof(*this) + (_centroids.capacity() + _unmerged.capacity()) * sizeof(Centroid);
+}
+
+void AccumulatorApproxPercentile::compress() {
+    if (_unmerged.empty()) {
+        return;
+    }
+
+    std::vector<Centroid> centroids;
+    centroids.reserve(_centroids.size() + _unmerged.size());
+    centroids.insert(centroids.end(), _centroids.begin(), _centroids.end());
+    centroids.insert(centroids.end(), _unmerged.begin(), _unmerged.end());
+    std::sort(centroids.begin(), centroids.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.mean < rhs.mean;
+    });
+
+    _centroids.clear();
+    _unmerged.clear();
+
+    double weightSoFar = 0;
+    double weightLimit = _totalWeight * inverseScale(scale(0) + 1);
+    Centroid current = centroids.front();
+    for (auto it = std::next(centroids.begin()); it != centroids.end(); ++it) {
+        if (weightSoFar + current.weight + it->weight <= weightLimit) {
+            current.weight += it->weight;
+            current.mean += (it->mean - current.mean) * it->weight / current.weight;
+        } else {
+            weightSoFar += current.weight;
+            _centroids.push_back(current);
+            weightLimit = _totalWeight * inverseScale(scale(weightSoFar / _totalWeight) + 1);
+            current = *it;
+        }
+    }
+    _centroids.push_back(current);
+}
+
+Value AccumulatorApproxPercentile::getValue(bool toBeMerged) {
+    compress();
+
+    if (toBeMerged) {
+        std::vector<Value> means;
+        std::vector<Value> weights;
+        means.reserve(_centroids.size());
+        weights.reserve(_centroids.size());
+        for (auto&& centroid : _centroids) {
+            means.emplace_back(centroid.mean);
+            weights.emplace_back(centroid.weight);
+        }
+        return Value(Document{{kMinField, _min},
+                              {kMaxField, _max},
+                              {kMeansField, std::move(means)},
+                              {kWeightsField, std::move(weights)}});
+    }
+
+    if (_centroids.empty()) {
+        return Value(BSONNULL);
+    }
+
+    // Every centroid is assumed to be centered on its mean, and the values between the centers of
+    // neighbouring centroids to be spread uniformly. The minimum and maximum are exact, and bound
+    // the first and last centroids.
+    const double target = _percentile * _totalWeight;
+    const auto& first = _centroids.front();
+    if (target <= first.weight / 2) {
+        return Value(_min + (first.mean - _min) * target / (first.weight / 2));
+    }
+    const auto& last = _centroids.back();
+    if (target >= _totalWeight - last.weight / 2) {
+        const double lastCenter = _totalWeight - last.weight / 2;
+        return Value(last.mean + (_max - last.mean) * (target - lastCenter) / (last.weight / 2));
+    }
+
+    double center = first.weight / 2;
+    for (size_t i = 0; i + 1 < _centroids.size(); ++i) {
+        const double gap = (_centroids[i].weight + _centroids[i + 1].weight) / 2;
+        if (target <= center + gap) {
+            return Value(_centroids[i].mean +
+                         (_centroids[i + 1].mean - _centroids[i].mean) * (target - center) / gap);
+        }
+        center += gap;
+    }
+    return Value(_max);
+}
+
+AccumulatorApproxPercentile::AccumulatorApproxPercentile(ExpressionContext* const expCtx,
+                                                         double percentile)
+    : AccumulatorState(expCtx), _percentile(percentile) {
+    _memUsageBytes = sizeof(*this);
+}
+
+void AccumulatorApproxPercentile::reset() {
+    _centroids = {};
+    _unmerged = {};
+    _totalWeight = 0;
+    _min = 0;
+    _max = 0;
+    _memUsageBytes = sizeof(*this);
+}
+
+Document AccumulatorApproxPercentile::serialize(intrusive_ptr<Expression> initializer,
+                                                intrusive_ptr<Expression> argument,
+                                                bool explain) const {
+    return DOC(getOpName() << DOC(kInputArg << argument->serialize(explain) << kPercentileArg
+                                            << _percentile));
+}
+
+intrusive_ptr<AccumulatorState> AccumulatorApproxPercentile::create(ExpressionContext* const expCtx,
+                                                                    double percentile) {
+    return new AccumulatorApproxPercentile(expCtx, percentile);
+}
+
+}  // namespace mongo
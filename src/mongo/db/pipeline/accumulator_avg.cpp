@@ -94,6 +94,22 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+void AccumulatorAvg::processBatch(const std::vector<Value>& inputs) {
+    size_t begin = 0;
+    while (begin < inputs.size()) {
+        const BSONType type = inputs[begin].getType();
+        const size_t end = addNonDecimalRun(inputs, begin, &_nonDecimalTotal);
+        if (type == NumberInt || type == NumberLong || type == NumberDouble) {
+            _count += end - begin;
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                processInternal(inputs[i], false);
+            }
+        }
+        begin = end;
+    }
+}
+
 intrusive_ptr<AccumulatorState> AccumulatorAvg::create(ExpressionContext* const expCtx) {
     return new AccumulatorAvg(expCtx);
 }
@@ -49,7 +49,7 @@ REGISTER_REMOVABLE_WINDOW_FUNCTION(push, AccumulatorPush, WindowFunctionPush);
 void AccumulatorPush::processInternal(const Value& input, bool merging) {
     if (!merging) {
         if (!input.missing()) {
-            _array.push_back(input);
+            _mutableArray().push_back(input);
             _memUsageBytes += input.getApproximateSize();
             uassert(ErrorCodes::ExceededMemoryLimit,
                     str::stream()
@@ -72,12 +72,22 @@ void AccumulatorPush::processInternal(const Value& input, bool merging) {
                         << _maxMemUsageBytes << " bytes",
                     _memUsageBytes < _maxMemUsageBytes);
         }
-        _array.insert(_array.end(), vec.begin(), vec.end());
+        auto& array = _mutableArray();
+        array.insert(array.end(), vec.begin(), vec.end());
     }
 }
 
+std::vector<Value>& AccumulatorPush::_mutableArray() {
+    if (!_array) {
+        _array = make_intrusive<RCVector>();
+    } else if (_array->isShared()) {
+        _array = make_intrusive<RCVector>(_array->vec);
+    }
+    return _array->vec;
+}
+
 Value AccumulatorPush::getValue(bool toBeMerged) {
-    return Value(_array);
+    return _array ? Value(_array) : Value(std::vector<Value>());
 }
 
 AccumulatorPush::AccumulatorPush(ExpressionContext* const expCtx,
@@ -88,7 +98,7 @@ AccumulatorPush::AccumulatorPush(ExpressionContext* const expCtx,
 }
 
 void AccumulatorPush::reset() {
-    vector<Value>().swap(_array);
+    _array.reset();
     _memUsageBytes = sizeof(*this);
 }
 
@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <array>
 #include <cmath>
 #include <limits>
 
@@ -58,8 +59,70 @@ REGISTER_WINDOW_FUNCTION(count, window_function::parseCountWindowFunction);
 namespace {
 const char subTotalName[] = "subTotal";
 const char subTotalErrorName[] = "subTotalError";  // Used for extra precision.
+
+/**
+ * Copies the values in [begin, end) out of 'inputs' into a fixed-size buffer using 'get', passing
+ * each full or final partial buffer to 'add'.
+ */
+template <typename T, typename Getter, typename Adder>
+void addInBatches(const std::vector<Value>& inputs,
+                  size_t begin,
+                  size_t end,
+                  const Getter& get,
+                  const Adder& add) {
+    constexpr size_t kBatchSize = 64;
+    std::array<T, kBatchSize> batch;
+    while (begin < end) {
+        const size_t count = std::min(kBatchSize, end - begin);
+        for (size_t i = 0; i < count; ++i) {
+            batch[i] = get(inputs[begin + i]);
+        }
+        add(batch.data(), count);
+        begin += count;
+    }
+}
 }  // namespace
 
+size_t addNonDecimalRun(const std::vector<Value>& inputs,
+                        size_t begin,
+                        DoubleDoubleSummation* total) {
+    const BSONType type = inputs[begin].getType();
+    size_t end = begin + 1;
+    while (end < inputs.size() && inputs[end].getType() == type) {
+        ++end;
+    }
+
+    switch (type) {
+        case NumberInt:
+            addInBatches<int>(
+                inputs,
+                begin,
+                end,
+                [](const Value& input) { return input.getInt(); },
+                [&](const int* values, size_t count) { total->addInts(values, count); });
+            break;
+        case NumberLong:
+            addInBatches<long long>(
+                inputs,
+                begin,
+                end,
+                [](const Value& input) { return input.getLong(); },
+                [&](const long long* values, size_t count) { total->addLongs(values, count); });
+            break;
+        case NumberDouble:
+            addInBatches<double>(
+                inputs,
+                begin,
+                end,
+                [](const Value& input) { return input.getDouble(); },
+                [&](const double* values, size_t count) { total->addDoubles(values, count); });
+            break;
+        default:
+            break;
+    }
+    return end;
+}
+
 
 void AccumulatorSum::processInternal(const Value& input, bool merging) {
     if (!input.numeric()) {
@@ -92,6 +155,22 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+void AccumulatorSum::processBatch(const std::vector<Value>& inputs) {
+    size_t begin = 0;
+    while (begin < inputs.size()) {
+        const BSONType type = inputs[begin].getType();
+        const size_t end = addNonDecimalRun(inputs, begin, &nonDecimalTotal);
+        if (type == NumberInt || type == NumberLong || type == NumberDouble) {
+            totalType = Value::getWidestNumeric(totalType, type);
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                processInternal(inputs[i], false);
+            }
+        }
+        begin = end;
+    }
+}
+
 intrusive_ptr<AccumulatorState> AccumulatorSum::create(ExpressionContext* const expCtx) {
     return new AccumulatorSum(expCtx);
 }
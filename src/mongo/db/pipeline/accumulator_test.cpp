@@ -84,6 +84,15 @@ static void assertExpectedResults(
                 ASSERT_EQUALS(op.second.getType(), result.getType());
             }
 
+            // Asserts that processing the input as a single batch gives the same result.
+            {
+                auto accum = initializeAccumulator();
+                accum->processBatch(op.first);
+                Value result = accum->getValue(false);
+                ASSERT_VALUE_EQ(op.second, result);
+                ASSERT_EQUALS(op.second.getType(), result.getType());
+            }
+
             // Asserts that result equals expected result when all input is on one shard.
             if (!skipMerging) {
                 auto accum = initializeAccumulator();
@@ -580,6 +589,33 @@ TEST(Accumulators, Sum) {
          {{Value(9), Value()}, Value(9)}});
 }
 
+TEST(Accumulators, SumAndAvgBatchesMatchSingleValues) {
+    auto expCtx = ExpressionContextForTest{};
+    // Runs longer than the internal batch size, interleaved with other types, with fractional
+    // values forcing the compensated path and large longs overflowing the integer fast path.
+    std::vector<Value> inputs;
+    for (int i = 0; i < 300; ++i) {
+        inputs.push_back(Value(i * 1000003));
+        inputs.push_back(Value(static_cast<long long>(i % 100) << 55));
+        if (i % 50 == 0) {
+            inputs.push_back(Value("ignored"_sd));
+            inputs.push_back(Value(i + 0.1));
+        }
+    }
+    inputs.push_back(Value(Decimal128("0.5")));
+
+    for (auto create : {&AccumulatorSum::create, &AccumulatorAvg::create}) {
+        auto single = create(&expCtx);
+        for (auto&& input : inputs) {
+            single->process(input, false);
+        }
+        auto batched = create(&expCtx);
+        batched->processBatch(inputs);
+        ASSERT_VALUE_EQ(single->getValue(false), batched->getValue(false));
+        ASSERT_VALUE_EQ(single->getValue(true), batched->getValue(true));
+    }
+}
+
 TEST(Accumulators, Rank) {
     auto expCtx = ExpressionContextForTest{};
     assertExpectedResults<AccumulatorRank>(
@@ -652,6 +688,162 @@ TEST(Accumulators, AddToSetRespectsCollation) {
                                                  Value(std::vector<Value>{Value("a"_sd)})}});
 }
 
+TEST(Accumulators, ApproxCountDistinct) {
+    auto expCtx = ExpressionContextForTest{};
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx,
+        {
+            // No input.
+            {{}, Value(0LL)},
+            // Missing values are not counted.
+            {{Value()}, Value(0LL)},
+            // Values which compare as equal are counted once.
+            {{Value(1), Value(1.0), Value(1LL), Value(Decimal128(1))}, Value(1LL)},
+            {{Value(BSONNULL), Value(BSONNULL)}, Value(1LL)},
+        });
+}
+
+TEST(Accumulators, ApproxCountDistinctRespectsCollation) {
+    auto expCtx = ExpressionContextForTest{};
+    auto collator =
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kAlwaysEqual);
+    expCtx.setCollator(std::move(collator));
+    assertExpectedResults<AccumulatorApproxCountDistinct>(
+        &expCtx, {{{Value("a"_sd), Value("b"_sd), Value("c"_sd)}, Value(1LL)}});
+}
+
+TEST(Accumulators, ApproxCountDistinctEstimatesLargeCardinalities) {
+    auto expCtx = ExpressionContextForTest{};
+    const int numDistinct = 100000;
+    const int numShards = 4;
+
+    auto unsharded = AccumulatorApproxCountDistinct::create(&expCtx);
+    std::vector<intrusive_ptr<AccumulatorState>> shards;
+    for (int i = 0; i < numShards; ++i) {
+        shards.push_back(AccumulatorApproxCountDistinct::create(&expCtx));
+    }
+    for (int i = 0; i < numDistinct; ++i) {
+        // Every value is seen twice, once as a string.
+        unsharded->process(Value(i), false);
+        unsharded->process(Value(std::to_string(i)), false);
+        shards[i % numShards]->process(Value(i), false);
+        shards[(i + 1) % numShards]->process(Value(std::to_string(i)), false);
+    }
+
+    auto estimate = unsharded->getValue(false);
+    ASSERT_EQ(estimate.getType(), BSONType::NumberLong);
+    ASSERT_APPROX_EQUAL(estimate.getLong(), 2 * numDistinct, 0.1 * 2 * numDistinct);
+
+    // The sketches of the shards merge into the same sketch as that of the unsharded input.
+    auto merger = AccumulatorApproxCountDistinct::create(&expCtx);
+    for (auto&& shard : shards) {
+        merger->process(shard->getValue(true), true);
+    }
+    ASSERT_VALUE_EQ(merger->getValue(false), estimate);
+
+    // The memory used does not depend on the number of distinct values.
+    ASSERT_LT(unsharded->getMemUsage(), 2 * AccumulatorApproxCountDistinct::kNumRegisters);
+}
+
+/**
+ * Feeds 'values' to a $approxPercentile accumulator for 'percentile', either directly or through
+ * 'numShards' partial accumulators, and returns the result.
+ */
+Value approxPercentile(ExpressionContext* expCtx,
+                       double percentile,
+                       const std::vector<Value>& values,
+                       int numShards = 0) {
+    auto accum = AccumulatorApproxPercentile::create(expCtx, percentile);
+    if (numShards == 0) {
+        for (auto&& value : values) {
+            accum->process(value, false);
+        }
+        return accum->getValue(false);
+    }
+
+    std::vector<intrusive_ptr<AccumulatorState>> shards;
+    for (int i = 0; i < numShards; ++i) {
+        shards.push_back(AccumulatorApproxPercentile::create(expCtx, percentile));
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        shards[i % numShards]->process(values[i], false);
+    }
+    for (auto&& shard : shards) {
+        accum->process(shard->getValue(true), true);
+    }
+    return accum->getValue(false);
+}
+
+TEST(Accumulators, ApproxPercentileIsExactForFewValues) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<Value> values{
+        Value(5), Value(3LL), Value("ignored"_sd), Value(1.0), Value(BSONNULL), Value(4), Value(2)};
+    for (int numShards : {0, 1, 3, 7}) {
+        ASSERT_VALUE_EQ(approxPercentile(&expCtx, 0, values, numShards), Value(1.0));
+        ASSERT_VALUE_EQ(approxPercentile(&expCtx, 0.5, values, numShards), Value(3.0));
+        ASSERT_VALUE_EQ(approxPercentile(&expCtx, 1, values, numShards), Value(5.0));
+    }
+
+    // Without numeric input there is no percentile.
+    ASSERT_VALUE_EQ(approxPercentile(&expCtx, 0.5, {}), Value(BSONNULL));
+    ASSERT_VALUE_EQ(approxPercentile(&expCtx, 0.5, {Value("a"_sd)}, 2), Value(BSONNULL));
+}
+
+TEST(Accumulators, ApproxPercentileEstimatesLargeInputs) {
+    auto expCtx = ExpressionContextForTest{};
+    const int numValues = 100000;
+    std::vector<Value> values;
+    for (int i = 0; i < numValues; ++i) {
+        // Visit the values in a scattered order.
+        values.push_back(Value((i * 7919) % numValues));
+    }
+
+    for (double percentile : {0.01, 0.25, 0.5, 0.9, 0.999}) {
+        for (int numShards : {0, 5}) {
+            auto estimate = approxPercentile(&expCtx, percentile, values, numShards);
+            ASSERT_EQ(estimate.getType(), BSONType::NumberDouble);
+            ASSERT_APPROX_EQUAL(estimate.getDouble(), percentile * numValues, 0.01 * numValues);
+        }
+    }
+}
+
+TEST(Accumulators, ApproxPercentileValidatesArguments) {
+    auto expCtx = ExpressionContextForTest{};
+    auto parse = [&](BSONObj spec) {
+        return AccumulatorApproxPercentile::parseArgs(
+            &expCtx, spec.firstElement(), expCtx.variablesParseState);
+    };
+
+    auto [input, percentile] = parse(BSON("" << BSON("input"
+                                                     << "$x"
+                                                     << "p" << 0.95)));
+    ASSERT_EQ(percentile, 0.95);
+    ASSERT_VALUE_EQ(input->serialize(false), Value("$x"_sd));
+
+    ASSERT_THROWS_CODE(parse(BSON("" << 1)), AssertionException, 5899602);
+    ASSERT_THROWS_CODE(parse(BSON("" << BSON("input"
+                                             << "$x"
+                                             << "p" << 1.5))),
+                       AssertionException,
+                       5899603);
+    ASSERT_THROWS_CODE(parse(BSON("" << BSON("input"
+                                             << "$x"
+                                             << "p"
+                                             << "$y"))),
+                       AssertionException,
+                       5899603);
+    ASSERT_THROWS_CODE(parse(BSON("" << BSON("input"
+                                             << "$x"
+                                             << "p" << 0.5 << "q" << 1))),
+                       AssertionException,
+                       5899604);
+    ASSERT_THROWS_CODE(parse(BSON("" << BSON("p" << 0.5))), AssertionException, 5899605);
+    ASSERT_THROWS_CODE(parse(BSON("" << BSON("input"
+                                             << "$x"))),
+                       AssertionException,
+                       5899606);
+}
+
 TEST(Accumulators, AddToSetRespectsMaxMemoryConstraint) {
     auto expCtx = ExpressionContextForTest{};
     const int maxMemoryBytes = 20ull;
@@ -674,6 +866,29 @@ TEST(Accumulators, PushRespectsMaxMemoryConstraint) {
         ErrorCodes::ExceededMemoryLimit);
 }
 
+TEST(Accumulators, PushResultIsUnaffectedByLaterInput) {
+    auto expCtx = ExpressionContextForTest{};
+    auto push = AccumulatorPush(&expCtx);
+    ASSERT_VALUE_EQ(Value(std::vector<Value>()), push.getValue(false));
+
+    push.process(Value(1), false);
+    push.process(Value(2), false);
+    Value first = push.getValue(false);
+
+    // The accumulated array is shared with 'first', so it must be copied before it is modified.
+    push.process(Value(3), false);
+    ASSERT_VALUE_EQ(Value(std::vector<Value>{Value(1), Value(2)}), first);
+    ASSERT_VALUE_EQ(Value(std::vector<Value>{Value(1), Value(2), Value(3)}), push.getValue(false));
+
+    push.process(Value(std::vector<Value>{Value(4)}), true);
+    ASSERT_VALUE_EQ(Value(std::vector<Value>{Value(1), Value(2)}), first);
+    ASSERT_EQ(4U, push.getValue(false).getArrayLength());
+
+    push.reset();
+    ASSERT_VALUE_EQ(Value(std::vector<Value>()), push.getValue(false));
+    ASSERT_VALUE_EQ(Value(std::vector<Value>{Value(1), Value(2)}), first);
+}
+
 /* ------------------------- AccumulatorCorvariance(Samp/Pop) -------------------------- */
 
 // Calculate covariance using the offline algorithm.
@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <exception>
+
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+/**
+ * Takes change stream events from a stage's source a window at a time, so that the stage can look
+ * up what it needs for every event in the window together. Whatever the source produced after the
+ * last event of the window, such as a pause, EOF or an exception, is held back until every event
+ * in the window has been returned, exactly as if the events had been taken one at a time.
+ */
+class ChangeStreamEventWindow {
+public:
+    /**
+     * Whether every event of the window, and the result which followed it, has been returned.
+     */
+    bool exhausted() const {
+        return _events.empty() && !_resultAfterEvents && !_exceptionAfterEvents;
+    }
+
+    /**
+     * Takes up to 'maxEvents' events from 'source' into the window, stopping at the first result
+     * which is not an event. Must only be called once the window is exhausted.
+     */
+    void fill(DocumentSource* source, size_t maxEvents) {
+        invariant(exhausted());
+        while (_events.size() < maxEvents) {
+            try {
+                auto next = source->getNext();
+                if (!next.isAdvanced()) {
+                    _resultAfterEvents = std::move(next);
+                    return;
+                }
+                _events.push_back(next.releaseDocument());
+            } catch (...) {
+                if (_events.empty()) {
+                    throw;
+                }
+                _exceptionAfterEvents = std::current_exception();
+                return;
+            }
+        }
+    }
+
+    const std::deque<Document>& events() const {
+        return _events;
+    }
+
+    /**
+     * Returns the next event of the window, or once there are none left, what followed them.
+     */
+    DocumentSource::GetNextResult next() {
+        invariant(!exhausted());
+        if (!_events.empty()) {
+            auto event = std::move(_events.front());
+            _events.pop_front();
+            return DocumentSource::GetNextResult(std::move(event));
+        }
+        if (_exceptionAfterEvents) {
+            std::rethrow_exception(std::exchange(_exceptionAfterEvents, nullptr));
+        }
+        auto result = std::move(*_resultAfterEvents);
+        _resultAfterEvents = boost::none;
+        return result;
+    }
+
+private:
+    std::deque<Document> _events;
+    boost::optional<DocumentSource::GetNextResult> _resultAfterEvents;
+    std::exception_ptr _exceptionAfterEvents;
+};
+
+}  // namespace mongo
@@ -0,0 +1,255 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/common_subexpressions.h"
+
+#include <map>
+#include <string>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/expression_function.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Returns whether 'expr' alone, not counting its children, always gives the same result for the
+ * same current document.
+ */
+bool isDeterministicNode(const Expression* expr) {
+    if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expr)) {
+        // Variables other than ROOT and CURRENT may be bound by an enclosing $let, $map, $filter
+        // or $reduce, and differ between two occurrences of the same path.
+        return !fieldPath->isVariableReference();
+    }
+    return !dynamic_cast<const ExpressionRandom*>(expr) &&
+        !dynamic_cast<const ExpressionFunction*>(expr);
+}
+
+/**
+ * Returns whether sharing 'expr' could be cheaper than evaluating each occurrence.
+ */
+bool isWorthSharing(const Expression* expr) {
+    if (dynamic_cast<const ExpressionConstant*>(expr)) {
+        return false;
+    }
+    if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expr)) {
+        // The first component of the path is CURRENT or ROOT, so only dotted paths qualify.
+        return fieldPath->getFieldPath().getPathLength() > 2;
+    }
+    return !expr->getChildren().empty();
+}
+
+/**
+ * Finds the repeated subexpressions among a set of expressions, identifying them by their
+ * serialization. Only the outermost of nested repeated subexpressions is shared, unless an inner
+ * one also occurs elsewhere.
+ */
+class Analysis {
+public:
+    explicit Analysis(const std::vector<const Expression*>& exprs) {
+        for (auto expr : exprs) {
+            _count(expr);
+        }
+        for (auto expr : exprs) {
+            _decide(expr);
+        }
+    }
+
+    /**
+     * Visits the expression tree rooted at 'expr' top-down, calling 'onShared' with a reference to
+     * each node which should be shared and whether it is the first occurrence of its subexpression.
+     * The children of shared nodes are only visited for the first occurrence.
+     */
+    template <typename OnShared>
+    void visitShared(boost::intrusive_ptr<Expression>& expr, const OnShared& onShared) {
+        if (auto key = _keyOf.find(expr.get()); key != _keyOf.end()) {
+            auto& entry = _entries[key->second];
+            if (entry.count >= 2) {
+                const bool first = !entry.visited;
+                entry.visited = true;
+                if (first) {
+                    _visitChildren(expr.get(), onShared);
+                }
+                onShared(expr, key->second, first);
+                return;
+            }
+        }
+        _visitChildren(expr.get(), onShared);
+    }
+
+private:
+    struct Entry {
+        int count = 0;
+        bool decided = false;
+        bool visited = false;
+    };
+
+    /**
+     * Counts the occurrences of each subexpression of 'expr' which could be shared, returning
+     * whether 'expr' is deterministic.
+     */
+    bool _count(const Expression* expr) {
+        bool deterministic = isDeterministicNode(expr);
+        for (auto&& child : expr->getChildren()) {
+            if (child && !_count(child.get())) {
+                deterministic = false;
+            }
+        }
+
+        if (deterministic && isWorthSharing(expr)) {
+            BSONObjBuilder builder;
+            expr->serialize(false).addToBsonObj(&builder, "");
+            auto key = builder.obj();
+            auto it = _keyOf.emplace(expr, std::string(key.objdata(), key.objsize())).first;
+            ++_entries[it->second].count;
+        }
+        return deterministic;
+    }
+
+    /**
+     * Once a repeated subexpression is shared, the subexpressions inside its other occurrences are
+     * never evaluated, so they no longer count as occurrences.
+     */
+    void _decide(const Expression* expr) {
+        if (auto key = _keyOf.find(expr); key != _keyOf.end()) {
+            auto& entry = _entries[key->second];
+            if (entry.count >= 2) {
+                if (!entry.decided) {
+                    entry.decided = true;
+                    for (auto&& child : expr->getChildren()) {
+                        if (child) {
+                            _decide(child.get());
+                        }
+                    }
+                } else {
+                    _discount(expr);
+                }
+                return;
+            }
+        }
+        for (auto&& child : expr->getChildren()) {
+            if (child) {
+                _decide(child.get());
+            }
+        }
+    }
+
+    void _discount(const Expression* expr) {
+        for (auto&& child : expr->getChildren()) {
+            if (!child) {
+                continue;
+            }
+            if (auto key = _keyOf.find(child.get()); key != _keyOf.end()) {
+                --_entries[key->second].count;
+            }
+            _discount(child.get());
+        }
+    }
+
+    template <typename OnShared>
+    void _visitChildren(Expression* expr, const OnShared& onShared) {
+        for (auto&& child : expr->getChildren()) {
+            if (child) {
+                visitShared(child, onShared);
+            }
+        }
+    }
+
+    stdx::unordered_map<const Expression*, std::string> _keyOf;
+    std::map<std::string, Entry> _entries;
+};
+
+}  // namespace
+
+std::unique_ptr<CommonSubexpressions> CommonSubexpressions::eliminate(
+    const std::vector<boost::intrusive_ptr<Expression>*>& exprs) {
+    std::vector<const Expression*> roots;
+    for (auto expr : exprs) {
+        roots.push_back(expr->get());
+    }
+    Analysis analysis(roots);
+
+    std::unique_ptr<CommonSubexpressions> result{new CommonSubexpressions()};
+    std::map<std::string, std::shared_ptr<ExpressionSharedSubexpression::Cache>> caches;
+    for (auto expr : exprs) {
+        analysis.visitShared(*expr, [&](auto& node, const std::string& key, bool first) {
+            auto& cache = caches[key];
+            if (first) {
+                // The children of 'node' have already been rewritten, so 'node' itself is
+                // evaluated through the caches of any subexpressions shared within it.
+                cache = std::make_shared<ExpressionSharedSubexpression::Cache>();
+                cache->expr = node;
+                cache->documentCount = result->_documentCount;
+                result->_sharedExpressions.push_back(node);
+            }
+            node = make_intrusive<ExpressionSharedSubexpression>(node->getExpressionContext(),
+                                                                 cache);
+        });
+    }
+
+    if (result->_sharedExpressions.empty()) {
+        return nullptr;
+    }
+    return result;
+}
+
+std::vector<boost::intrusive_ptr<Expression>> CommonSubexpressions::find(
+    const std::vector<boost::intrusive_ptr<Expression>>& exprs) {
+    std::vector<const Expression*> roots;
+    for (auto&& expr : exprs) {
+        roots.push_back(expr.get());
+    }
+    Analysis analysis(roots);
+
+    std::vector<boost::intrusive_ptr<Expression>> shared;
+    for (auto expr : exprs) {
+        analysis.visitShared(expr, [&](auto& node, const std::string& key, bool first) {
+            if (first) {
+                shared.push_back(node);
+            }
+        });
+    }
+    return shared;
+}
+
+Value ExpressionSharedSubexpression::evaluate(const Document& root, Variables* variables) const {
+    if (_cache->evaluatedFor != *_cache->documentCount) {
+        _cache->value = _cache->expr->evaluate(root, variables);
+        _cache->evaluatedFor = *_cache->documentCount;
+    }
+    return _cache->value;
+}
+
+}  // namespace mongo
@@ -0,0 +1,140 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+
+/**
+ * Shares the evaluation of subexpressions which occur more than once among a set of expressions
+ * evaluated against the same document, such as the _id and accumulator arguments of a $group.
+ *
+ * Each repeated subexpression is replaced by an ExpressionSharedSubexpression, which evaluates it
+ * the first time it is referenced for a document and returns the cached result after that. The
+ * evaluation is lazy rather than done up front, so that a subexpression in a branch of a $cond or
+ * $switch which is not taken is still not evaluated, and errors are raised in the same order.
+ *
+ * Only subexpressions which are deterministic and read nothing but the current document are
+ * shared. Constants and single field lookups are left alone, as they cost no more to evaluate
+ * than the cache does to read.
+ */
+class CommonSubexpressions {
+public:
+    /**
+     * Replaces the subexpressions repeated among 'exprs' in place. Returns nullptr, leaving 'exprs'
+     * untouched, if there are none.
+     */
+    static std::unique_ptr<CommonSubexpressions> eliminate(
+        const std::vector<boost::intrusive_ptr<Expression>*>& exprs);
+
+    /**
+     * Returns the subexpressions eliminate() would share among 'exprs', without modifying them.
+     */
+    static std::vector<boost::intrusive_ptr<Expression>> find(
+        const std::vector<boost::intrusive_ptr<Expression>>& exprs);
+
+    /**
+     * Discards the cached values. Must be called before evaluating the expressions against each
+     * new document.
+     */
+    void startNewDocument() {
+        ++*_documentCount;
+    }
+
+    /**
+     * Returns the shared subexpressions, in the order they were first found.
+     */
+    const std::vector<boost::intrusive_ptr<Expression>>& getSharedExpressions() const {
+        return _sharedExpressions;
+    }
+
+private:
+    CommonSubexpressions() : _documentCount(std::make_shared<uint64_t>(1)) {}
+
+    // Shared with every ExpressionSharedSubexpression created by this object. The cached values
+    // are valid for as long as it stays unchanged.
+    std::shared_ptr<uint64_t> _documentCount;
+
+    std::vector<boost::intrusive_ptr<Expression>> _sharedExpressions;
+};
+
+/**
+ * One of the references to a subexpression shared by CommonSubexpressions. It serializes as the
+ * subexpression itself, so that the rewrite is invisible to anything which re-parses the result.
+ */
+class ExpressionSharedSubexpression final : public Expression {
+public:
+    /**
+     * The state shared by all the references to one subexpression.
+     */
+    struct Cache {
+        boost::intrusive_ptr<Expression> expr;
+        std::shared_ptr<const uint64_t> documentCount;
+        uint64_t evaluatedFor = 0;
+        Value value;
+    };
+
+    ExpressionSharedSubexpression(ExpressionContext* expCtx, std::shared_ptr<Cache> cache)
+        : Expression(expCtx), _cache(std::move(cache)) {}
+
+    Value evaluate(const Document& root, Variables* variables) const final;
+
+    boost::intrusive_ptr<Expression> optimize() final {
+        return this;
+    }
+
+    Value serialize(bool explain) const final {
+        return _cache->expr->serialize(explain);
+    }
+
+    void acceptVisitor(ExpressionMutableVisitor* visitor) final {
+        return visitor->visit(this);
+    }
+
+    void acceptVisitor(ExpressionConstVisitor* visitor) const final {
+        return visitor->visit(this);
+    }
+
+protected:
+    void _doAddDependencies(DepsTracker* deps) const final {
+        _cache->expr->addDependencies(deps);
+    }
+
+private:
+    std::shared_ptr<Cache> _cache;
+};
+
+}  // namespace mongo
@@ -62,6 +62,9 @@ DocumentSource::DocumentSource(const StringData stageName,
     : pSource(nullptr), pExpCtx(pCtx), _commonStats(stageName.rawData()) {
     if (pExpCtx->shouldCollectDocumentSourceExecStats()) {
         _commonStats.executionTimeMillis.emplace(0);
+        if (internalQueryCollectExecutionCpuTime.load() && ScopedTimer::canMeasureCPUTime()) {
+            _commonStats.executionCpuTimeMicros.emplace(0);
+        }
     }
 }
 
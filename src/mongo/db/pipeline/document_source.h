@@ -323,7 +323,9 @@ public:
         invariant(fcs);
 
         invariant(_commonStats.executionTimeMillis);
-        ScopedTimer timer(fcs, _commonStats.executionTimeMillis.get_ptr());
+        ScopedTimer timer(fcs,
+                          _commonStats.executionTimeMillis.get_ptr(),
+                          _commonStats.executionCpuTimeMicros.get_ptr());
         ++_commonStats.works;
 
         GetNextResult next = doGetNext();
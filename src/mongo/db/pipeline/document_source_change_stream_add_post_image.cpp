@@ -32,6 +32,9 @@
 #include "mongo/db/pipeline/document_source_change_stream_add_post_image.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/pipeline/document_source_change_stream_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -70,7 +73,12 @@ DocumentSourceChangeStreamAddPostImage::createFromBson(
 }
 
 DocumentSource::GetNextResult DocumentSourceChangeStreamAddPostImage::doGetNext() {
-    auto input = pSource->getNext();
+    if (_window.exhausted()) {
+        _window.fill(pSource, internalChangeStreamImageLookupBatchSize.load());
+        lookupPostImages(_window.events());
+    }
+
+    auto input = _window.next();
     if (!input.isAdvanced()) {
         return input;
     }
@@ -126,14 +134,114 @@ Value DocumentSourceChangeStreamAddPostImage::lookupPostImage(const Document& up
     // Update lookup queries sent from mongoS to shards are allowed to use speculative majority
     // reads.
     invariant(resumeToken.getData().uuid);
-    auto lookedUpDoc = pExpCtx->mongoProcessInterface->lookupSingleDocument(
-        pExpCtx, nss, *resumeToken.getData().uuid, documentKey, std::move(readConcern));
+    auto lookedUpDoc = findLookedUpPostImage(*resumeToken.getData().uuid, documentKey);
+    if (!lookedUpDoc) {
+        lookedUpDoc = pExpCtx->mongoProcessInterface->lookupSingleDocument(
+            pExpCtx, nss, *resumeToken.getData().uuid, documentKey, std::move(readConcern));
+    }
 
     // Check whether the lookup returned any documents. Even if the lookup itself succeeded, it may
     // not have returned any results if the document was deleted in the time since the update op.
     return (lookedUpDoc ? Value(*lookedUpDoc) : Value(BSONNULL));
 }
 
+void DocumentSourceChangeStreamAddPostImage::lookupPostImages(const std::deque<Document>& events) {
+    _lookedUpPostImages.clear();
+
+    struct CollectionLookup {
+        NamespaceString nss;
+        UUID uuid;
+        Timestamp clusterTime;
+        BSONObjSet documentKeys = SimpleBSONObjComparator::kInstance.makeBSONObjSet();
+    };
+    std::vector<CollectionLookup> lookups;
+
+    for (auto&& event : events) {
+        auto opType = event[DocumentSourceChangeStream::kOperationTypeField];
+        if (opType.getType() != BSONType::String ||
+            opType.getStringData() != DocumentSourceChangeStream::kUpdateOpType) {
+            continue;
+        }
+
+        // Any malformed event is left for lookupPostImage() to report when doGetNext() reaches it.
+        // Parsing the event does not check for interrupts, so nothing else can be thrown here.
+        try {
+            auto nss = assertValidNamespace(event);
+            auto documentKey = assertFieldHasType(event,
+                                                  DocumentSourceChangeStream::kDocumentKeyField,
+                                                  BSONType::Object)
+                                   .getDocument();
+            auto resumeToken =
+                ResumeToken::parse(event[DocumentSourceChangeStream::kIdField].getDocument());
+            const auto& uuid = resumeToken.getData().uuid;
+            if (!uuid) {
+                continue;
+            }
+
+            auto lookup = std::find_if(lookups.begin(), lookups.end(), [&](const auto& lookup) {
+                return lookup.uuid == *uuid && lookup.nss == nss;
+            });
+            if (lookup == lookups.end()) {
+                lookup = lookups.insert(lookups.end(), {nss, *uuid, Timestamp()});
+            }
+            lookup->clusterTime = std::max(lookup->clusterTime, resumeToken.getData().clusterTime);
+            lookup->documentKeys.insert(documentKey.toBson());
+        } catch (const DBException&) {
+            continue;
+        }
+    }
+
+    for (auto&& lookup : lookups) {
+        // A single document is looked up when its event is reached, as it would be without
+        // batching.
+        if (lookup.documentKeys.size() < 2) {
+            continue;
+        }
+
+        // The documents are looked up after the last of their events, which gives each event a
+        // version of its document at least as recent as the event, just as looking it up alone
+        // would.
+        BSONObjBuilder filter;
+        {
+            BSONArrayBuilder documentKeys(filter.subarrayStart("$or"));
+            for (auto&& documentKey : lookup.documentKeys) {
+                documentKeys.append(documentKey);
+            }
+        }
+        auto readConcern = BSON("level"
+                                << "majority"
+                                << "afterClusterTime" << lookup.clusterTime);
+
+        auto lookedUpDocs = pExpCtx->mongoProcessInterface->lookupDocuments(
+            pExpCtx, lookup.nss, lookup.uuid, Document{filter.obj()}, std::move(readConcern));
+        for (auto&& lookedUpDoc : lookedUpDocs) {
+            _lookedUpPostImages.emplace_back(lookup.uuid, std::move(lookedUpDoc));
+        }
+    }
+}
+
+boost::optional<Document> DocumentSourceChangeStreamAddPostImage::findLookedUpPostImage(
+    const UUID& collectionUUID, const Document& documentKey) const {
+    for (auto&& [uuid, lookedUpDoc] : _lookedUpPostImages) {
+        if (uuid != collectionUUID) {
+            continue;
+        }
+
+        // The document keys of the looked up documents are compared with the simple collation, so
+        // that an event is only given the document it updated.
+        bool matches = true;
+        for (auto it = documentKey.fieldIterator(); matches && it.more();) {
+            auto field = it.next();
+            matches = ValueComparator().evaluate(
+                lookedUpDoc.getNestedField(FieldPath(field.first)) == field.second);
+        }
+        if (matches) {
+            return lookedUpDoc;
+        }
+    }
+    return boost::none;
+}
+
 Value DocumentSourceChangeStreamAddPostImage::serializeLatest(
     boost::optional<ExplainOptions::Verbosity> explain) const {
     return explain
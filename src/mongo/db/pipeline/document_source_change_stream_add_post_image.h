@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/pipeline/change_stream_event_window.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -132,6 +133,19 @@ private:
      */
     Value lookupPostImage(const Document& updateOp) const;
 
+    /**
+     * Looks up the current versions of the documents updated by 'events' with a single query per
+     * collection, and keeps them in '_lookedUpPostImages'.
+     */
+    void lookupPostImages(const std::deque<Document>& events);
+
+    /**
+     * Returns the document looked up by lookupPostImages() in the collection 'collectionUUID' whose
+     * fields are equal to those of 'documentKey', if there is one.
+     */
+    boost::optional<Document> findLookedUpPostImage(const UUID& collectionUUID,
+                                                    const Document& documentKey) const;
+
     /**
      * Throws a AssertionException if the namespace found in 'inputDoc' doesn't match the one on the
      * ExpressionContext. If the namespace on the ExpressionContext is 'collectionless', then this
@@ -146,6 +160,13 @@ private:
     // and whether to return a point-in-time post-image or the most current majority-committed
     // version of the updated document.
     FullDocumentModeEnum _fullDocumentMode = FullDocumentModeEnum::kDefault;
+
+    // The events whose post-images are looked up together.
+    ChangeStreamEventWindow _window;
+
+    // The documents looked up for the events in '_window', with the UUIDs of their collections. The
+    // post-image of any event whose document is not among them is looked up on its own.
+    std::vector<std::pair<UUID, Document>> _lookedUpPostImages;
 };
 
 }  // namespace mongo
@@ -376,5 +376,73 @@ TEST_F(DocumentSourceChangeStreamAddPostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
+
+TEST_F(DocumentSourceChangeStreamAddPostImageTest, ShouldLookUpPostImagesOfWindowTogether) {
+    auto expCtx = getExpCtx();
+    auto lookupChangeStage = DocumentSourceChangeStreamAddPostImage::create(expCtx, getSpec());
+
+    auto makeUpdate = [&](int id) {
+        return Document{{"_id", makeResumeToken(id)},
+                        {"documentKey", Document{{"_id", id}}},
+                        {"operationType", "update"_sd},
+                        {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}};
+    };
+    auto withPostImage = [](Document update, Value postImage) {
+        MutableDocument doc(std::move(update));
+        doc["fullDocument"] = std::move(postImage);
+        return doc.freeze();
+    };
+
+    // The updates to documents 0, 1 and 2 are looked up together. Document 2 no longer exists.
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {makeUpdate(0), makeUpdate(1), makeUpdate(0), makeUpdate(2)}, expCtx);
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}, {"x", 0}},
+                                                             Document{{"_id", 1}, {"x", 1}}};
+    getExpCtx()->mongoProcessInterface =
+        std::make_unique<MockMongoInterface>(std::move(mockForeignContents));
+
+    for (auto&& [id, postImage] : std::vector<std::pair<int, Value>>{
+             {0, Value(Document{{"_id", 0}, {"x", 0}})},
+             {1, Value(Document{{"_id", 1}, {"x", 1}})},
+             {0, Value(Document{{"_id", 0}, {"x", 0}})},
+             {2, Value(BSONNULL)}}) {
+        auto next = lookupChangeStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), withPostImage(makeUpdate(id), postImage));
+    }
+
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceChangeStreamAddPostImageTest,
+       ShouldReturnEarlierEventsOfWindowBeforeErrorOnLaterEvent) {
+    auto expCtx = getExpCtx();
+    auto lookupChangeStage = DocumentSourceChangeStreamAddPostImage::create(expCtx, getSpec());
+
+    // The second update has no document key, which is reported only once the first update has
+    // been returned.
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document{{"_id", makeResumeToken(0)},
+                  {"documentKey", Document{{"_id", 0}}},
+                  {"operationType", "update"_sd},
+                  {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}},
+         Document{{"_id", makeResumeToken(1)},
+                  {"operationType", "update"_sd},
+                  {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}}},
+        expCtx);
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"_id", 0}}};
+    getExpCtx()->mongoProcessInterface =
+        std::make_unique<MockMongoInterface>(std::move(mockForeignContents));
+
+    auto next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_VALUE_EQ(next.releaseDocument()["fullDocument"], Value(Document{{"_id", 0}}));
+
+    ASSERT_THROWS_CODE(lookupChangeStage->getNext(), AssertionException, 40578);
+}
 }  // namespace
 }  // namespace mongo
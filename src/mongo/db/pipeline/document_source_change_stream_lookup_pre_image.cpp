@@ -35,6 +35,7 @@
 #include "mongo/db/pipeline/document_source_change_stream_lookup_pre_image.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -72,7 +73,12 @@ DocumentSourceChangeStreamAddPreImage::createFromBson(
 }
 
 DocumentSource::GetNextResult DocumentSourceChangeStreamAddPreImage::doGetNext() {
-    auto input = pSource->getNext();
+    if (_window.exhausted()) {
+        _window.fill(pSource, internalChangeStreamImageLookupBatchSize.load());
+        lookupPreImages(_window.events());
+    }
+
+    auto input = _window.next();
     if (!input.isAdvanced()) {
         return input;
     }
@@ -112,22 +118,80 @@ DocumentSource::GetNextResult DocumentSourceChangeStreamAddPreImage::doGetNext()
     return outputDoc.freeze();
 }
 
-boost::optional<Document> DocumentSourceChangeStreamAddPreImage::lookupPreImage(
-    const Document& inputDoc, const repl::OpTime& opTime) const {
+UUID DocumentSourceChangeStreamAddPreImage::getOplogUUID() const {
     // We need the oplog's UUID for lookup, so obtain the collection info via MongoProcessInterface.
     auto localOplogInfo = pExpCtx->mongoProcessInterface->getCollectionOptions(
         pExpCtx->opCtx, NamespaceString::kRsOplogNamespace);
 
     // Extract the UUID from the collection information. We should always have a valid uuid here.
-    auto oplogUUID = invariantStatusOK(UUID::parse(localOplogInfo["uuid"]));
-
-    // Look up the pre-image oplog entry using the opTime as the query filter.
-    auto lookedUpDoc =
-        pExpCtx->mongoProcessInterface->lookupSingleDocument(pExpCtx,
-                                                             NamespaceString::kRsOplogNamespace,
-                                                             oplogUUID,
-                                                             Document{opTime.asQuery()},
-                                                             boost::none);
+    return invariantStatusOK(UUID::parse(localOplogInfo["uuid"]));
+}
+
+void DocumentSourceChangeStreamAddPreImage::lookupPreImages(const std::deque<Document>& events) {
+    _lookedUpPreImages.clear();
+
+    // Any malformed optimes are left for doGetNext() to report when it reaches their events.
+    std::vector<Timestamp> timestamps;
+    for (auto&& event : events) {
+        auto preImageOpTimeVal = event[kFullDocumentBeforeChangeFieldName];
+        if (preImageOpTimeVal.getType() != BSONType::Object) {
+            continue;
+        }
+        auto preImageOpTime =
+            repl::OpTime::parseFromOplogEntry(preImageOpTimeVal.getDocument().toBson());
+        if (preImageOpTime.isOK()) {
+            timestamps.push_back(preImageOpTime.getValue().getTimestamp());
+        }
+    }
+
+    // A single pre-image is looked up when its event is reached, as it would be without batching.
+    if (timestamps.size() < 2) {
+        return;
+    }
+
+    // The range bounds the scan of the oplog, which holds the pre-images of a window of events
+    // close together.
+    const auto [minTs, maxTs] = std::minmax_element(timestamps.begin(), timestamps.end());
+    BSONObjBuilder filter;
+    {
+        BSONObjBuilder tsFilter(filter.subobjStart(repl::OpTime::kTimestampFieldName));
+        tsFilter.append("$gte", *minTs);
+        tsFilter.append("$lte", *maxTs);
+        BSONArrayBuilder inTimestamps(tsFilter.subarrayStart("$in"));
+        for (auto&& ts : timestamps) {
+            inTimestamps.append(ts);
+        }
+    }
+
+    auto lookedUpDocs =
+        pExpCtx->mongoProcessInterface->lookupDocuments(pExpCtx,
+                                                        NamespaceString::kRsOplogNamespace,
+                                                        getOplogUUID(),
+                                                        Document{filter.obj()},
+                                                        boost::none);
+    for (auto&& lookedUpDoc : lookedUpDocs) {
+        auto opTime = repl::OpTime::parseFromOplogEntry(lookedUpDoc.toBson());
+        if (opTime.isOK()) {
+            _lookedUpPreImages.emplace(opTime.getValue(), std::move(lookedUpDoc));
+        }
+    }
+}
+
+boost::optional<Document> DocumentSourceChangeStreamAddPreImage::lookupPreImage(
+    const Document& inputDoc, const repl::OpTime& opTime) const {
+    // Use the pre-image oplog entry if it was looked up with the others in the window. Otherwise,
+    // look it up using the opTime as the query filter.
+    boost::optional<Document> lookedUpDoc;
+    if (auto it = _lookedUpPreImages.find(opTime); it != _lookedUpPreImages.end()) {
+        lookedUpDoc = it->second;
+    } else {
+        lookedUpDoc = pExpCtx->mongoProcessInterface->lookupSingleDocument(
+            pExpCtx,
+            NamespaceString::kRsOplogNamespace,
+            getOplogUUID(),
+            Document{opTime.asQuery()},
+            boost::none);
+    }
 
     // Failing to find an oplog entry implies that the pre-image has rolled off the oplog. This is
     // acceptable if the mode is "kWhenAvailable", but not if the mode is "kRequired".
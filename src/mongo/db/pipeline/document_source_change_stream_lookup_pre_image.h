@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/pipeline/change_stream_event_window.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -126,12 +127,30 @@ private:
     boost::optional<Document> lookupPreImage(const Document& inputDoc,
                                              const repl::OpTime& opTime) const;
 
+    /**
+     * Looks up the pre-image oplog entries of all of 'events' with a single query over the range of
+     * the oplog which holds them, and keeps them in '_lookedUpPreImages'.
+     */
+    void lookupPreImages(const std::deque<Document>& events);
+
+    /**
+     * Returns the UUID of the oplog, in which pre-images are looked up.
+     */
+    UUID getOplogUUID() const;
+
     Value serializeLegacy(boost::optional<ExplainOptions::Verbosity> explain) const final;
     Value serializeLatest(boost::optional<ExplainOptions::Verbosity> explain) const final;
 
     // Determines whether pre-images are strictly required or may be included only when available.
     FullDocumentBeforeChangeModeEnum _fullDocumentBeforeChangeMode =
         FullDocumentBeforeChangeModeEnum::kOff;
+
+    // The events whose pre-images are looked up together.
+    ChangeStreamEventWindow _window;
+
+    // The pre-image oplog entries looked up for the events in '_window', by optime. The pre-image
+    // of any other event is looked up on its own.
+    std::map<repl::OpTime, Document> _lookedUpPreImages;
 };
 
 }  // namespace mongo
@@ -173,6 +173,22 @@ struct MockMongoInterface final : public StubMongoProcessInterface {
         return (it != _documentsForLookup.end() ? *it : boost::optional<Document>{});
     }
 
+    std::vector<Document> lookupDocuments(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                          const NamespaceString& nss,
+                                          UUID collectionUUID,
+                                          const Document& filter,
+                                          boost::optional<BSONObj> readConcern) final {
+        Matcher matcher(filter.toBson(), expCtx);
+        std::vector<Document> lookedUpDocs;
+        std::copy_if(_documentsForLookup.begin(),
+                     _documentsForLookup.end(),
+                     std::back_inserter(lookedUpDocs),
+                     [&](const Document& lookedUpDoc) {
+                         return matcher.matches(lookedUpDoc.toBson(), nullptr);
+                     });
+        return lookedUpDocs;
+    }
+
     // For "insert" tests.
     std::pair<std::vector<FieldPath>, bool> collectDocumentKeyFieldsForHostedCollection(
         OperationContext*, const NamespaceString&, UUID) const final {
@@ -192,7 +208,7 @@ struct MockMongoInterface final : public StubMongoProcessInterface {
     // TransactionHistoryIterator, which is the _reverse_ of the order they appear in the oplog.
     std::vector<repl::OplogEntry> _transactionEntries;
 
-    // These documents are used to feed the 'lookupSingleDocument' method.
+    // These documents are used to feed the 'lookupSingleDocument' and 'lookupDocuments' methods.
     std::vector<Document> _documentsForLookup;
 };
 
@@ -73,6 +73,7 @@ DocumentSourceChangeStreamUnwindTransaction::DocumentSourceChangeStreamUnwindTra
 void DocumentSourceChangeStreamUnwindTransaction::rebuild(BSONObj filter) {
     _filter = filter.getOwned();
     _expression = MatchExpressionParser::parseAndNormalize(filter, pExpCtx);
+    _compiledExpression = std::make_unique<CompiledMatchExpression>(_expression.get());
 }
 
 StageConstraints DocumentSourceChangeStreamUnwindTransaction::constraints(
@@ -162,7 +163,7 @@ DocumentSource::GetNextResult DocumentSourceChangeStreamUnwindTransaction::doGet
         // to be empty of any relevant operations, meaning that this loop may need to execute
         // multiple times before it encounters a relevant change to return.
         _txnIterator.emplace(
-            pExpCtx->opCtx, pExpCtx->mongoProcessInterface, doc, _expression.get());
+            pExpCtx->opCtx, pExpCtx->mongoProcessInterface, doc, _compiledExpression.get());
     }
 }
 
@@ -188,7 +189,7 @@ DocumentSourceChangeStreamUnwindTransaction::TransactionOpIterator::TransactionO
     OperationContext* opCtx,
     std::shared_ptr<MongoProcessInterface> mongoProcessInterface,
     const Document& input,
-    const MatchExpression* expression)
+    const CompiledMatchExpression* expression)
     : _mongoProcessInterface(mongoProcessInterface), _expression(expression) {
     Value lsidValue = input["lsid"];
     DocumentSourceChangeStream::checkValueType(lsidValue, "lsid", BSONType::Object);
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
 namespace mongo {
@@ -120,7 +121,7 @@ private:
         TransactionOpIterator(OperationContext* opCtx,
                               std::shared_ptr<MongoProcessInterface> mongoProcessInterface,
                               const Document& input,
-                              const MatchExpression* expression);
+                              const CompiledMatchExpression* expression);
 
         /**
          * Returns the index for the last operation returned by getNextTransactionOp(). It is
@@ -206,7 +207,7 @@ private:
         std::shared_ptr<MongoProcessInterface> _mongoProcessInterface;
 
         // Only return entries matching this expression.
-        const MatchExpression* _expression;
+        const CompiledMatchExpression* _expression;
     };
 
     // All transaction entries are filtered through this expression. This extra filtering step is
@@ -218,6 +219,9 @@ private:
     BSONObj _filter;
     std::unique_ptr<MatchExpression> _expression;
 
+    // '_expression' compiled for matching each transaction entry.
+    std::unique_ptr<CompiledMatchExpression> _compiledExpression;
+
     // Represents the current transaction we're unwinding, if any.
     boost::optional<TransactionOpIterator> _txnIterator;
 };
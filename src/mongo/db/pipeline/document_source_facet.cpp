@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_facet.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -45,7 +46,10 @@
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/worker_pool.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -55,6 +59,11 @@ using std::pair;
 using std::string;
 using std::vector;
 
+namespace {
+// Runs the $facet sub-pipelines which are executed concurrently.
+const WorkerPool facetWorkers("Facet", 64);
+}  // namespace
+
 DocumentSourceFacet::DocumentSourceFacet(std::vector<FacetPipeline> facetPipelines,
                                          const intrusive_ptr<ExpressionContext>& expCtx,
                                          size_t bufferSizeBytes,
@@ -65,8 +74,8 @@ DocumentSourceFacet::DocumentSourceFacet(std::vector<FacetPipeline> facetPipelin
       _maxOutputDocSizeBytes(maxOutputDocBytes) {
     for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
         auto& facet = _facets[facetId];
-        facet.pipeline->addInitialSource(
-            DocumentSourceTeeConsumer::create(pExpCtx, facetId, _teeBuffer));
+        facet.pipeline->addInitialSource(DocumentSourceTeeConsumer::create(
+            facet.pipeline->getContext(), facetId, _teeBuffer));
     }
 }
 
@@ -161,17 +170,21 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     };
 
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
-    while (!allPipelinesEOF) {
-        allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
-        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
-            const auto& pipeline = _facets[facetId].pipeline;
-            auto next = pipeline->getSources().back()->getNext();
-            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
-                ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
-                results[facetId].emplace_back(next.releaseDocument());
+    if (canRunFacetsConcurrently()) {
+        runFacetsConcurrently(&results);
+    } else {
+        bool allPipelinesEOF = false;
+        while (!allPipelinesEOF) {
+            allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
+            for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+                const auto& pipeline = _facets[facetId].pipeline;
+                auto next = pipeline->getSources().back()->getNext();
+                for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                    ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
+                    results[facetId].emplace_back(next.releaseDocument());
+                }
+                allPipelinesEOF = allPipelinesEOF && next.isEOF();
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
         }
     }
 
@@ -184,6 +197,97 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     return resultDoc.freeze();
 }
 
+bool DocumentSourceFacet::canRunFacetsConcurrently() const {
+    if (internalQueryFacetMaxConcurrency.load() <= 1 || _facets.size() <= 1) {
+        return false;
+    }
+
+    // The sub-pipelines must have been parsed with expression contexts of their own, so that they
+    // neither share variables nor interrupt checks with each other.
+    for (auto&& facet : _facets) {
+        if (facet.pipeline->getContext() == pExpCtx) {
+            return false;
+        }
+    }
+
+    // Worker threads run without any locks, so they must not read from any collection.
+    stdx::unordered_set<NamespaceString> involvedCollections;
+    addInvolvedCollections(&involvedCollections);
+    return involvedCollections.empty();
+}
+
+void DocumentSourceFacet::runFacetsConcurrently(vector<vector<Value>>* results) {
+    const size_t maxBytes = _maxOutputDocSizeBytes;
+    AtomicWord<long long> usedBytes{0};
+    auto ensureUnderMemoryLimit = [&](long long additional) {
+        const auto totalBytes = usedBytes.addAndFetch(additional);
+        uassert(6170458,
+                str::stream() << "document constructed by $facet is " << totalBytes
+                              << " bytes, which exceeds the limit of " << maxBytes << " bytes",
+                totalBytes <= static_cast<long long>(maxBytes));
+    };
+
+    // Drains the facets in 'group' until each of them has consumed the current batch. Returns
+    // true if all of them are EOF.
+    auto runGroup = [&](const std::vector<size_t>& group) {
+        bool allPipelinesEOF = true;
+        for (auto facetId : group) {
+            const auto& pipeline = _facets[facetId].pipeline;
+            auto next = pipeline->getSources().back()->getNext();
+            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+                ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
+                (*results)[facetId].emplace_back(next.releaseDocument());
+            }
+            allPipelinesEOF = allPipelinesEOF && next.isEOF();
+        }
+        return allPipelinesEOF;
+    };
+
+    // The facets are spread over the groups round-robin. The first group runs on this thread, the
+    // others on the thread pool.
+    const size_t numGroups =
+        std::min(static_cast<size_t>(internalQueryFacetMaxConcurrency.load()), _facets.size());
+    std::vector<std::vector<size_t>> groups(numGroups);
+    for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+        groups[facetId % numGroups].push_back(facetId);
+    }
+
+    bool allPipelinesEOF = false;
+    while (!allPipelinesEOF) {
+        // Every consumer has paused or reached EOF, so it is safe to load the next batch. Once the
+        // input is exhausted, the consumers see EOF and the sub-pipelines produce their remaining
+        // results.
+        _teeBuffer->loadNextBatchForConcurrentConsumers();
+
+        // Every group records whether all of its facets are EOF in its own slot.
+        std::vector<char> groupEOF(numGroups, false);
+        auto status = facetWorkers.runTasks(
+            pExpCtx->opCtx, numGroups, [&](OperationContext* opCtx, size_t groupId) {
+                if (groupId == 0) {
+                    groupEOF[groupId] = runGroup(groups[groupId]);
+                    return;
+                }
+
+                for (auto facetId : groups[groupId]) {
+                    _facets[facetId].pipeline->reattachToOperationContext(opCtx);
+                }
+                ON_BLOCK_EXIT([&] {
+                    for (auto facetId : groups[groupId]) {
+                        _facets[facetId].pipeline->detachFromOperationContext();
+                    }
+                });
+                groupEOF[groupId] = runGroup(groups[groupId]);
+            });
+        uassertStatusOK(status);
+        allPipelinesEOF =
+            std::all_of(groupEOF.begin(), groupEOF.end(), [](char isEOF) { return isEOF; });
+
+        for (auto&& facet : _facets) {
+            facet.pipeline->reattachToOperationContext(pExpCtx->opCtx);
+        }
+    }
+}
+
 Value DocumentSourceFacet::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument serialized;
     for (auto&& facet : _facets) {
@@ -305,11 +409,18 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
     boost::optional<std::string> needsMongoS;
     boost::optional<std::string> needsShard;
 
+    // Sub-pipelines which may be run concurrently each get an expression context of their own. This
+    // is only done for top-level pipelines on mongod, since the variables of a sub-pipeline, such
+    // as those bound by $lookup, can change as it runs.
+    const bool mayRunConcurrently = internalQueryFacetMaxConcurrency.load() > 1 &&
+        !expCtx->inMongos && expCtx->subPipelineDepth == 0;
+
     std::vector<FacetPipeline> facetPipelines;
     for (auto&& rawFacet : extractRawPipelines(elem)) {
         const auto facetName = rawFacet.first;
 
-        auto pipeline = Pipeline::parse(rawFacet.second, expCtx, [](const Pipeline& pipeline) {
+        auto facetExpCtx = mayRunConcurrently ? expCtx->copyWith(expCtx->ns, expCtx->uuid) : expCtx;
+        auto pipeline = Pipeline::parse(rawFacet.second, facetExpCtx, [](const Pipeline& pipeline) {
             auto sources = pipeline.getSources();
             std::for_each(sources.begin(), sources.end(), [](auto& stage) {
                 auto stageConstraints = stage->constraints();
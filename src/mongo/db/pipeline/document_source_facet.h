@@ -157,6 +157,20 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Returns true if the sub-pipelines can be run concurrently on multiple threads, as allowed by
+     * 'internalQueryFacetMaxConcurrency'.
+     */
+    bool canRunFacetsConcurrently() const;
+
+    /**
+     * Runs the sub-pipelines to completion on up to 'internalQueryFacetMaxConcurrency' threads,
+     * appending the documents produced by each of them to the corresponding entry of 'results'.
+     * Every batch of input is loaded on this thread, then consumed by all of the sub-pipelines
+     * concurrently.
+     */
+    void runFacetsConcurrently(std::vector<std::vector<Value>>* results);
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
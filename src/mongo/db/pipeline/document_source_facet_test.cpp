@@ -44,6 +44,7 @@
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -455,6 +456,47 @@ TEST_F(DocumentSourceFacetTest, ShouldBeAbleToEvaluateMultipleStagesWithinOneSub
     ASSERT_DOCUMENT_EQ(output.getDocument(), Document(fromjson("{subPipe: [{_id: 0}, {_id: 1}]}")));
 }
 
+TEST_F(DocumentSourceFacetTest, ConcurrentSubPipelinesProduceSameResultsAsSerialOnes) {
+    // Use a tiny buffer so that the input is consumed over many batches.
+    RAIIServerParameterControllerForTest bufferSize("internalQueryFacetBufferSizeBytes", 100);
+
+    auto spec = fromjson(
+        "{$facet: {"
+        "  total: [{$group: {_id: null, sum: {$sum: '$a'}, count: {$sum: 1}}}],"
+        "  even: [{$match: {b: 0}}, {$project: {_id: 1}}],"
+        "  first: [{$limit: 3}],"
+        "  let: [{$project: {c: {$let: {vars: {x: '$a'}, in: {$multiply: ['$$x', 2]}}}}}],"
+        "  buckets: [{$group: {_id: '$b', n: {$sum: 1}}}, {$sort: {_id: 1}}]"
+        "}}");
+
+    auto run = [&](int maxConcurrency) {
+        RAIIServerParameterControllerForTest concurrency("internalQueryFacetMaxConcurrency",
+                                                         maxConcurrency);
+        deque<DocumentSource::GetNextResult> inputs;
+        for (int i = 0; i < 200; ++i) {
+            inputs.emplace_back(Document{{"_id", i}, {"a", i}, {"b", i % 2}});
+        }
+        auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+        auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), getExpCtx());
+        facetStage->setSource(mock.get());
+
+        auto output = facetStage->getNext();
+        ASSERT(output.isAdvanced());
+        ASSERT(facetStage->getNext().isEOF());
+        return output.releaseDocument();
+    };
+
+    auto serialResult = run(1);
+    ASSERT_VALUE_EQ(serialResult["total"],
+                    Value(BSON_ARRAY(BSON("_id" << BSONNULL << "sum" << 19900 << "count" << 200))));
+    ASSERT_EQ(serialResult["even"].getArrayLength(), 100U);
+    ASSERT_EQ(serialResult["first"].getArrayLength(), 3U);
+
+    for (int maxConcurrency : {2, 3, 5, 8}) {
+        ASSERT_DOCUMENT_EQ(run(maxConcurrency), serialResult);
+    }
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldPropagateDisposeThroughToSource) {
     auto ctx = getExpCtx();
 
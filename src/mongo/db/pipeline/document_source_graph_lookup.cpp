@@ -47,6 +47,7 @@
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
 
@@ -54,6 +55,21 @@ namespace mongo {
 
 namespace {
 
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number.
+ *
+ * Each user of the Sorter must implement this function to ensure that all temporary files that the
+ * Sorter instances produce are uniquely identified using a unique file name extension with separate
+ * atomic variable. This is necessary because the sorter.cpp code is separately included in multiple
+ * places, rather than compiled in one place and linked, and so cannot provide a globally unique ID.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookupFileCounter;
+    return "extsort-doc-graphlookup." +
+        std::to_string(documentSourceGraphLookupFileCounter.fetchAndAdd(1));
+}
+
 // Parses $graphLookup 'from' field. The 'from' field must be a string with the exception of
 // 'local.system.tenantMigration.oplogView'.
 //
@@ -135,11 +151,9 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasVisited()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisited()));
     }
 
     MutableDocument output(*_input);
@@ -147,7 +161,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     _visitedUsageBytes = 0;
 
-    invariant(_visited.empty());
+    invariant(!hasVisited());
 
     return output.freeze();
 }
@@ -158,7 +172,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -174,7 +188,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasVisited()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -188,13 +202,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
@@ -205,6 +217,27 @@ void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    _spilledVisited.clear();
+    _spilledVisitedIds.clear();
+    _spillFile.reset();
+}
+
+bool DocumentSourceGraphLookUp::hasVisited() {
+    while (!_spilledVisited.empty() && !_spilledVisited.back()->more()) {
+        _spilledVisited.pop_back();
+    }
+    return !_visited.empty() || !_spilledVisited.empty();
+}
+
+Document DocumentSourceGraphLookUp::popVisited() {
+    invariant(hasVisited());
+    if (!_visited.empty()) {
+        auto it = _visited.begin();
+        auto result = std::move(it->second);
+        _visited.erase(it);
+        return result;
+    }
+    return _spilledVisited.back()->next().second;
 }
 
 bool DocumentSourceGraphLookUp::foreignShardedGraphLookupAllowed() const {
@@ -317,8 +350,8 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
                 shouldPerformAnotherQuery =
                     addToVisitedAndFrontier(*next, depth) || shouldPerformAnotherQuery;
                 addToCache(std::move(*next), queried);
+                checkMemoryUsage();
             }
-            checkMemoryUsage();
         }
 
         ++depth;
@@ -332,7 +365,8 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() ||
+        _spilledVisitedIds.find(id) != _spilledVisitedIds.end()) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -432,6 +466,10 @@ void DocumentSourceGraphLookUp::performSearch() {
     // Make sure _input is set before calling performSearch().
     invariant(_input);
 
+    // The documents spilled by the previous search have all been returned.
+    _spilledVisited.clear();
+    _spillFile.reset();
+
     Value startingValue = _startWith->evaluate(*_input, &pExpCtx->variables);
 
     // If _startWith evaluates to an array, treat each value as a separate starting point.
@@ -447,6 +485,7 @@ void DocumentSourceGraphLookUp::performSearch() {
 
     try {
         doBreadthFirstSearch();
+        _spilledVisitedIds.clear();
     } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
         // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
         // throw a custom exception.
@@ -497,13 +536,47 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if (_visitedUsageBytes + _frontierUsageBytes >= _maxMemoryUsageBytes && !_visited.empty() &&
+        pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
+        spillVisited();
+    }
+
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
 }
 
+void DocumentSourceGraphLookUp::spillVisited() {
+    if (!_spillFile) {
+        _spillFile = std::make_shared<Sorter<Value, Document>::File>(pExpCtx->tempDir + "/" +
+                                                                     nextFileName());
+    }
+
+    // The order in which the visited documents are returned is unspecified, so there is no need to
+    // sort them before writing.
+    // Only the '_id' values of the spilled documents remain accounted for in '_visitedUsageBytes'.
+    SortedFileWriter<Value, Document> writer(SortOptions().TempDir(pExpCtx->tempDir), _spillFile);
+    for (auto&& [id, doc] : _visited) {
+        writer.addAlreadySorted(id, doc);
+        _spilledVisitedIds.insert(id);
+        _visitedUsageBytes -= std::min(_visitedUsageBytes, doc.getApproximateSize());
+    }
+    _spilledVisited.emplace_back(writer.done());
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(pExpCtx->opCtx);
+    metricsCollector.incrementSorterSpills(1);
+
+    LOGV2_DEBUG(5899500,
+                3,
+                "$graphLookup spilled visited documents to disk",
+                "numDocuments"_attr = _visited.size(),
+                "numSpilledIds"_attr = _spilledVisitedIds.size());
+
+    _visited.clear();
+    _usedDisk = true;
+}
+
 void DocumentSourceGraphLookUp::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
     auto fromValue = (pExpCtx->ns.db() == _from.db())
@@ -575,8 +648,10 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _spilledVisitedIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
       _variables(expCtx->variables),
@@ -603,8 +678,10 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(const DocumentSourceGraphLo
       _maxDepth(original._maxDepth),
       _fromExpCtx(original._fromExpCtx->copyWith(original.pExpCtx->getResolvedNamespace(_from).ns)),
       _fromPipeline(original._fromPipeline),
+      _maxMemoryUsageBytes(original._maxMemoryUsageBytes),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _spilledVisitedIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _variables(original._variables),
       _variablesParseState(original._variablesParseState.copyWith(_variables.useIdGenerator())) {
@@ -753,3 +830,6 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
     }
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
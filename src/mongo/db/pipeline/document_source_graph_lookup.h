@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -113,7 +114,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      hostRequirement,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -132,6 +133,10 @@ public:
 
     void addInvolvedCollections(stdx::unordered_set<NamespaceString>* collectionNames) const final;
 
+    bool usedDisk() final {
+        return _usedDisk;
+    }
+
     void detachFromOperationContext() final;
 
     void reattachToOperationContext(OperationContext* opCtx) final;
@@ -218,10 +223,29 @@ private:
 
     /**
      * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'. If disk use
+     * is allowed, the documents in '_visited' are spilled before giving up.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents in '_visited' to '_spillFile' and keeps only their '_id' values in
+     * memory, in '_spilledVisitedIds', so that later results can still be de-duplicated.
+     */
+    void spillVisited();
+
+    /**
+     * Returns whether any document discovered by the last search, either in memory or spilled to
+     * disk, has yet to be returned.
+     */
+    bool hasVisited();
+
+    /**
+     * Removes and returns one of the documents discovered by the last search. The in-memory
+     * documents are returned before the spilled ones. Must only be called if hasVisited() is true.
+     */
+    Document popVisited();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -252,7 +276,7 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
@@ -266,6 +290,16 @@ private:
     // using the simple collation.
     ValueUnorderedMap<Document> _visited;
 
+    // When disk use is allowed and '_visited' exceeds the memory limit, its documents are written
+    // to '_spillFile' as a sorted run keyed by '_id'. A new file is used for every search that
+    // spills, as a file cannot be written to once reading from it has begun. The '_id' values of
+    // the spilled documents, compared using the simple collation, are kept in memory until the
+    // search completes.
+    std::shared_ptr<Sorter<Value, Document>::File> _spillFile;
+    std::vector<std::shared_ptr<Sorter<Value, Document>::Iterator>> _spilledVisited;
+    ValueUnorderedSet _spilledVisitedIds;
+    bool _usedDisk = false;
+
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
     LookupSetCache _cache;
@@ -39,6 +39,9 @@
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
@@ -713,5 +716,82 @@ TEST_F(DocumentSourceGraphLookUpTest, ShouldNotExpandArraysWithinArraysAtEndOfCo
     ASSERT(graphLookupStage->getNext().isEOF());
 }
 
+/**
+ * Builds a $graphLookup over a chain of 'numNodes' foreign documents with large string fields,
+ * where document 'i' connects to document 'i + 1', starting from document 0.
+ */
+boost::intrusive_ptr<DocumentSourceGraphLookUp> makeChainGraphLookup(
+    const boost::intrusive_ptr<ExpressionContextForTest>& expCtx, int numNodes) {
+    std::deque<DocumentSource::GetNextResult> fromContents;
+    for (int i = 0; i < numNodes; ++i) {
+        fromContents.push_back(
+            Document{{"_id", i}, {"to", i + 1}, {"padding", std::string(1024, 'x')}});
+    }
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    return DocumentSourceGraphLookUp::create(
+        expCtx,
+        fromNs,
+        "results",
+        "to",
+        "_id",
+        ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+        boost::none,
+        boost::none,
+        boost::none,
+        boost::none);
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldSpillVisitedDocumentsWhenDiskUseIsAllowed) {
+    RAIIServerParameterControllerForTest maxMemory{
+        "internalDocumentSourceGraphLookupMaxMemoryBytes", 16 * 1024};
+    auto expCtx = getExpCtx();
+    unittest::TempDir tempDir("DocumentSourceGraphLookUpTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+
+    const int numNodes = 100;
+    auto inputMock =
+        DocumentSourceMock::createForTest(Document{{"_id", 0}, {"startVal", 0}}, expCtx);
+    auto graphLookupStage = makeChainGraphLookup(expCtx, numNodes);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto resultsValue = next.getDocument().getField("results");
+    ASSERT(resultsValue.isArray());
+
+    std::vector<int> ids;
+    for (auto&& result : resultsValue.getArray()) {
+        ids.push_back(result.getDocument().getField("_id").getInt());
+    }
+    std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(ids.size(), static_cast<size_t>(numNodes));
+    for (int i = 0; i < numNodes; ++i) {
+        ASSERT_EQ(ids[i], i);
+    }
+
+    ASSERT_TRUE(graphLookupStage->usedDisk());
+    ASSERT(graphLookupStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldFailWhenMemoryLimitIsExceededWithoutDiskUse) {
+    RAIIServerParameterControllerForTest maxMemory{
+        "internalDocumentSourceGraphLookupMaxMemoryBytes", 16 * 1024};
+    auto expCtx = getExpCtx();
+    expCtx->allowDiskUse = false;
+
+    auto inputMock =
+        DocumentSourceMock::createForTest(Document{{"_id", 0}, {"startVal", 0}}, expCtx);
+    auto graphLookupStage = makeChainGraphLookup(expCtx, 100);
+    graphLookupStage->setSource(inputMock.get());
+
+    ASSERT_THROWS_CODE(graphLookupStage->getNext(), AssertionException, 40099);
+    ASSERT_FALSE(graphLookupStage->usedDisk());
+}
+
 }  // namespace
 }  // namespace mongo
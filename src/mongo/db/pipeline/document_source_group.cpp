@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
@@ -133,14 +134,11 @@ const char* DocumentSourceGroup::getSourceName() const {
 }
 
 bool DocumentSourceGroup::shouldSpillWithAttemptToSaveMemory() {
-    if (!_memoryTracker._allowDiskUse &&
-        (_memoryTracker.currentMemoryBytes() >
-         static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes))) {
+    if (!_memoryTracker._allowDiskUse && _memoryTracker.exceedsMemoryLimit()) {
         freeMemory();
     }
 
-    if (_memoryTracker.currentMemoryBytes() >
-        static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes)) {
+    if (_memoryTracker.exceedsMemoryLimit()) {
         uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
                 "Exceeded memory limit for $group, but didn't allow external sort."
                 " Pass allowDiskUse:true to opt in.",
@@ -229,7 +227,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
         _firstPartOfNextGroup = _sorterIterator->next();
     }
 
-    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge && _willBeMerged);
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
@@ -237,7 +235,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     if (_groups->empty())
         return GetNextResult::makeEOF();
 
-    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    Document out = makeDocument(
+        groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge && _willBeMerged);
 
     if (++groupsIterator == _groups->end())
         dispose();
@@ -249,6 +248,9 @@ void DocumentSourceGroup::doDispose() {
     // Free our resources.
     _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
     _sorterIterator.reset();
+    if (_topK) {
+        _topK->groups.clear();
+    }
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -270,6 +272,69 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
     return this;
 }
 
+Pipeline::SourceContainer::iterator DocumentSourceGroup::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    auto nextStage = std::next(itr);
+    if (nextStage == container->end()) {
+        return nextStage;
+    }
+
+    auto nextSort = dynamic_cast<DocumentSourceSort*>(nextStage->get());
+    if (!nextSort || !nextSort->getLimit()) {
+        return nextStage;
+    }
+
+    // The group key is the only part of a group's output document which is known before the whole
+    // input has been consumed. Accumulated values may change until then: even for a monotone
+    // accumulator the current value only bounds the final value from one side, so a $sort on
+    // accumulated fields cannot be used to discard groups early.
+    const auto& sortPattern = nextSort->getSortKeyPattern();
+    for (auto&& part : sortPattern) {
+        if (!part.fieldPath || part.fieldPath->getFieldName(0) != "_id"_sd) {
+            return nextStage;
+        }
+    }
+
+    _topK.emplace(sortPattern, pExpCtx->getCollator(), *nextSort->getLimit());
+    return nextStage;
+}
+
+boost::optional<Value> DocumentSourceGroup::admitTopKGroup(const Value& id) {
+    auto sortKey = _topK->sortKeyGen.computeSortKeyFromDocument(Document{{"_id", expandId(id)}});
+    auto& ranked = _topK->groups;
+    if (ranked.size() >= _topK->limit &&
+        ranked.key_comp()(std::prev(ranked.end())->first, sortKey)) {
+        return boost::none;
+    }
+    return sortKey;
+}
+
+void DocumentSourceGroup::evictTopKGroups() {
+    auto& ranked = _topK->groups;
+    while (ranked.size() > _topK->limit) {
+        // Groups which share the same sort key are kept or evicted together, so that the groups
+        // kept never depend on the order of the input.
+        auto [first, last] = ranked.equal_range(std::prev(ranked.end())->first);
+        if (ranked.size() - std::distance(first, last) < _topK->limit) {
+            return;
+        }
+
+        for (auto it = first; it != last; ++it) {
+            auto group = _groups->find(it->second);
+            invariant(group != _groups->end());
+            _memoryTracker.update(-1 * it->second.getApproximateSize());
+            for (size_t i = 0; i < group->second.size(); i++) {
+                _memoryTracker.update(_accumulatedFields[i].fieldName,
+                                      -1 * group->second[i]->getMemUsage());
+            }
+            _groups->erase(group);
+        }
+        ranked.erase(first, last);
+    }
+}
+
 Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument insides;
 
@@ -302,6 +367,10 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         insides["$doingMerge"] = Value(true);
     }
 
+    if (!_willBeMerged) {
+        insides["$willBeMerged"] = Value(false);
+    }
+
     MutableDocument out;
     out[getSourceName()] = Value(insides.freeze());
 
@@ -314,12 +383,35 @@ Value DocumentSourceGroup::serialize(boost::optional<ExplainOptions::Verbosity>
         }
 
         out["maxAccumulatorMemoryUsageBytes"] = Value(md.freezeToValue());
+        out["maxTotalMemoryUsageBytes"] =
+            Value(static_cast<long long>(_memoryTracker.maxMemoryBytes()));
         out["totalOutputDataSizeBytes"] =
             Value(static_cast<long long>(_stats.totalOutputDataSizeBytes));
         out["usedDisk"] = Value(_stats.spills > 0);
         out["spills"] = Value(static_cast<long long>(_stats.spills));
     }
 
+    if (explain && internalQueryGroupShareCommonSubexpressions.load()) {
+        std::vector<intrusive_ptr<Expression>> shared;
+        if (_commonSubexpressions) {
+            shared = _commonSubexpressions->getSharedExpressions();
+        } else if (!_commonSubexpressionsEliminated) {
+            std::vector<intrusive_ptr<Expression>> exprs(_idExpressions);
+            for (auto&& accumulatedField : _accumulatedFields) {
+                exprs.push_back(accumulatedField.expr.argument);
+            }
+            shared = CommonSubexpressions::find(exprs);
+        }
+
+        if (!shared.empty()) {
+            std::vector<Value> serialized;
+            for (auto&& expr : shared) {
+                serialized.push_back(expr->serialize(true));
+            }
+            out["commonSubexpressions"] = Value(std::move(serialized));
+        }
+    }
+
     return Value(out.freezeToValue());
 }
 
@@ -395,10 +487,12 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
                                          boost::optional<size_t> maxMemoryUsageBytes)
     : DocumentSource(kStageName, expCtx),
       _doingMerge(false),
+      _willBeMerged(true),
       _memoryTracker{expCtx->allowDiskUse && !expCtx->inMongos,
                      maxMemoryUsageBytes
                          ? *maxMemoryUsageBytes
-                         : static_cast<size_t>(internalDocumentSourceGroupMaxMemoryBytes.load())},
+                         : static_cast<size_t>(internalDocumentSourceGroupMaxMemoryBytes.load()),
+                     expCtx->getOperationMemoryTracker()},
       // We spill to disk in debug mode, regardless of allowDiskUse, to stress the system.
       _file(
           !expCtx->inMongos && (expCtx->allowDiskUse || kDebugBuild)
@@ -488,6 +582,12 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
             massert(17030, "$doingMerge should be true if present", groupField.Bool());
 
             groupStage->setDoingMerge(true);
+        } else if (pFieldName == "$willBeMerged") {
+            uassert(ErrorCodes::TypeMismatch,
+                    "$willBeMerged must be a boolean",
+                    groupField.type() == BSONType::Bool);
+
+            groupStage->setWillBeMerged(groupField.Bool());
         } else {
             // Any other field will be treated as an accumulator specification.
             groupStage->addAccumulator(
@@ -533,9 +633,28 @@ private:
 };
 }  // namespace
 
+std::vector<intrusive_ptr<Expression>*> DocumentSourceGroup::getPerDocumentExpressions() {
+    std::vector<intrusive_ptr<Expression>*> exprs;
+    for (auto&& idExpression : _idExpressions) {
+        exprs.push_back(&idExpression);
+    }
+    // The initializers are evaluated against the group key rather than the input document.
+    for (auto&& accumulatedField : _accumulatedFields) {
+        exprs.push_back(&accumulatedField.expr.argument);
+    }
+    return exprs;
+}
+
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     const size_t numAccumulators = _accumulatedFields.size();
 
+    if (!_commonSubexpressionsEliminated) {
+        if (internalQueryGroupShareCommonSubexpressions.load()) {
+            _commonSubexpressions = CommonSubexpressions::eliminate(getPerDocumentExpressions());
+        }
+        _commonSubexpressionsEliminated = true;
+    }
+
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
 
@@ -547,8 +666,19 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         // We release the result document here so that it does not outlive the end of this loop
         // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
+        if (_commonSubexpressions) {
+            _commonSubexpressions->startNewDocument();
+        }
         Value id = computeId(rootDocument);
 
+        boost::optional<Value> topKSortKey;
+        if (_topK && _groups->find(id) == _groups->end()) {
+            topKSortKey = admitTopKGroup(id);
+            if (!topKSortKey) {
+                continue;
+            }
+        }
+
         // Look for the _id value in the map. If it's not there, add a new entry with a blank
         // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
         // looking it up in '_groups' multiple times.
@@ -590,6 +720,11 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
             _memoryTracker.update(_accumulatedFields[i].fieldName, group[i]->getMemUsage());
         }
 
+        if (topKSortKey) {
+            _topK->groups.emplace(std::move(*topKSortKey), id);
+            evictTopKGroups();
+        }
+
         if (kDebugBuild && !storageGlobalParams.readOnly) {
             // In debug mode, spill every time we have a duplicate id to stress merge logic.
             if (!inserted &&           // is a dup
@@ -688,6 +823,9 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     metricsCollector.incrementSorterSpills(1);
 
     _groups->clear();
+    if (_topK) {
+        _topK->groups.clear();
+    }
     // Zero out the current per-accumulation statement memory consumption, as the memory has been
     // freed by spilling.
     for (auto accum : _accumulatedFields) {
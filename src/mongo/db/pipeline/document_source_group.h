@@ -29,11 +29,15 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <utility>
 
+#include "mongo/db/exec/sort_key_comparator.h"
+#include "mongo/db/index/sort_key_generator.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/common_subexpressions.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/pipeline/transformer_interface.h"
@@ -157,6 +161,22 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * Returns false if this $group stage produces its final results on a shard even though the
+     * pipeline's results will be merged, because no group can span more than one shard.
+     */
+    bool willBeMerged() const {
+        return _willBeMerged;
+    }
+
+    /**
+     * Tell this source whether its output will be merged by a later $group. Defaults to true. When
+     * false, the accumulators produce their final values even if the pipeline 'needsMerge'.
+     */
+    void setWillBeMerged(bool willBeMerged) {
+        _willBeMerged = willBeMerged;
+    }
+
     /**
      * Returns true if this $group stage used disk during execution and false otherwise.
      */
@@ -198,7 +218,39 @@ protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
 
+    /**
+     * If this $group is immediately followed by a $sort on the group key which has absorbed a
+     * $limit, only the groups which can still be among the first 'limit' groups in sort order need
+     * to be kept, bounding the number of groups held in memory by the limit.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
 private:
+    /**
+     * Tracks the groups of a $group feeding a $sort on the group key with a limit, ordered by the
+     * sort key which the $sort will compute for their output documents.
+     */
+    struct TopKGroups {
+        struct SortKeyLess {
+            bool operator()(const Value& lhs, const Value& rhs) const {
+                return comparator(lhs, rhs) < 0;
+            }
+            SortKeyComparator comparator;
+        };
+
+        TopKGroups(const SortPattern& sortPattern,
+                   const CollatorInterface* collator,
+                   uint64_t limit)
+            : sortKeyGen(sortPattern, collator), limit(limit), groups(SortKeyLess{sortPattern}) {}
+
+        SortKeyGenerator sortKeyGen;
+        uint64_t limit;
+
+        // Maps the sort key of each group in '_groups' to its group key.
+        std::multimap<Value, Value, SortKeyLess> groups;
+    };
+
     explicit DocumentSourceGroup(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                  boost::optional<size_t> maxMemoryUsageBytes = boost::none);
 
@@ -261,10 +313,32 @@ private:
      */
     bool shouldSpillWithAttemptToSaveMemory();
 
+    /**
+     * Returns the sort key of the group with internal key 'id' if it may still be among the first
+     * '_topK->limit' groups in sort order, or boost::none if it is ranked strictly behind that many
+     * groups which are already known. The documents of such a group can be discarded, since the
+     * $sort following this stage will never return it.
+     */
+    boost::optional<Value> admitTopKGroup(const Value& id);
+
+    /**
+     * Removes the groups which are ranked strictly behind '_topK->limit' other groups from
+     * '_groups'.
+     */
+    void evictTopKGroups();
+
+    /**
+     * Returns the expressions evaluated against each input document: the _id expressions followed
+     * by the accumulator arguments.
+     */
+    std::vector<boost::intrusive_ptr<Expression>*> getPerDocumentExpressions();
+
     std::vector<AccumulationStatement> _accumulatedFields;
 
     bool _doingMerge;
 
+    bool _willBeMerged;
+
     MemoryUsageTracker _memoryTracker;
 
     GroupStats _stats;
@@ -295,6 +369,15 @@ private:
 
     std::pair<Value, Value> _firstPartOfNextGroup;
 
+    // Only set if this $group feeds a $sort on the group key with a limit.
+    boost::optional<TopKGroups> _topK;
+
+    // Shares the evaluation of the subexpressions repeated among the _id expressions and the
+    // accumulator arguments. Set up when execution starts, so that a $group lowered to SBE is never
+    // rewritten. Null if there are no such subexpressions.
+    std::unique_ptr<CommonSubexpressions> _commonSubexpressions;
+    bool _commonSubexpressionsEliminated = false;
+
     bool _sbeCompatible;
 };
 
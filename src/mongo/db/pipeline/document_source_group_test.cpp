@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <boost/intrusive_ptr.hpp>
 #include <deque>
 #include <map>
@@ -52,6 +53,7 @@
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
@@ -174,6 +176,45 @@ TEST_F(DocumentSourceGroupTest, ShouldErrorIfNotAllowedToSpillToDiskAndResultSet
         group->getNext(), AssertionException, ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldErrorIfOperationMemoryBudgetIsExceededWithoutDiskUse) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+    // Neither stage exceeds its own limit, but together they exceed the budget of the operation.
+    expCtx->operationMemoryTracker = std::make_shared<SharedMemoryUsageTracker>(nullptr, 3000);
+
+    auto makePushGroup = [&] {
+        auto&& [parser, _1, _2, _3] = AccumulationStatement::getParser("$push");
+        auto accumulatorArg = BSON(""
+                                   << "$largeStr");
+        auto accExpr =
+            parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+        AccumulationStatement pushStatement{"spaceHog", accExpr};
+        auto groupByExpression =
+            ExpressionFieldPath::parse(expCtx.get(), "$_id", expCtx->variablesParseState);
+        return DocumentSourceGroup::create(expCtx, groupByExpression, {pushStatement});
+    };
+
+    string largeStr(1000, 'x');
+    auto firstGroup = makePushGroup();
+    auto firstMock =
+        DocumentSourceMock::createForTest({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                           Document{{"_id", 0}, {"largeStr", largeStr}}},
+                                          expCtx);
+    firstGroup->setSource(firstMock.get());
+    ASSERT_TRUE(firstGroup->getNext().isAdvanced());
+    ASSERT_GT(expCtx->operationMemoryTracker->currentMemoryBytes(), 2000);
+
+    auto secondGroup = makePushGroup();
+    auto secondMock =
+        DocumentSourceMock::createForTest({Document{{"_id", 0}, {"largeStr", largeStr}},
+                                           Document{{"_id", 1}, {"largeStr", largeStr}}},
+                                          expCtx);
+    secondGroup->setSource(secondMock.get());
+    ASSERT_THROWS_CODE(secondGroup->getNext(),
+                       AssertionException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldCorrectlyTrackMemoryUsageBetweenPauses) {
     auto expCtx = getExpCtx();
     const size_t maxMemoryUsageBytes = 1000;
@@ -245,6 +286,63 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldOnlyKeepTopKGroupsWhenFollowedBySortOnGroupKeyWithLimit) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+    RAIIServerParameterControllerForTest maxMemory{"internalDocumentSourceGroupMaxMemoryBytes",
+                                                   2000};
+
+    auto pipeline = Pipeline::parse({fromjson("{$group: {_id: '$_id', spaceHog: {$push: '$str'}}}"),
+                                     fromjson("{$sort: {_id: -1}}"),
+                                     fromjson("{$limit: 2}")},
+                                    expCtx);
+    pipeline->optimizePipeline();
+
+    // Holding on to all ten groups would exceed the memory limit.
+    string largeStr(500, 'x');
+    deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < 10; ++i) {
+        input.emplace_back(Document{{"_id", i}, {"str", largeStr}});
+    }
+    input.emplace_back(Document{{"_id", 9}, {"str", "a"_sd}});
+    input.emplace_back(Document{{"_id", 3}, {"str", "b"_sd}});
+    pipeline->addInitialSource(DocumentSourceMock::createForTest(std::move(input), expCtx));
+
+    auto next = pipeline->getNext();
+    ASSERT_TRUE(next);
+    ASSERT_DOCUMENT_EQ(
+        *next, (Document{{"_id", 9}, {"spaceHog", vector<Value>{Value(largeStr), Value("a"_sd)}}}));
+    next = pipeline->getNext();
+    ASSERT_TRUE(next);
+    ASSERT_DOCUMENT_EQ(*next,
+                       (Document{{"_id", 8}, {"spaceHog", vector<Value>{Value(largeStr)}}}));
+    ASSERT_FALSE(pipeline->getNext());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldKeepAllGroupsWhenFollowedBySortOnAccumulatedField) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+    RAIIServerParameterControllerForTest maxMemory{"internalDocumentSourceGroupMaxMemoryBytes",
+                                                   2000};
+
+    auto pipeline = Pipeline::parse({fromjson("{$group: {_id: '$_id', spaceHog: {$push: '$str'}}}"),
+                                     fromjson("{$sort: {spaceHog: -1}}"),
+                                     fromjson("{$limit: 2}")},
+                                    expCtx);
+    pipeline->optimizePipeline();
+
+    string largeStr(500, 'x');
+    deque<DocumentSource::GetNextResult> input;
+    for (int i = 0; i < 10; ++i) {
+        input.emplace_back(Document{{"_id", i}, {"str", largeStr}});
+    }
+    pipeline->addInitialSource(DocumentSourceMock::createForTest(std::move(input), expCtx));
+
+    ASSERT_THROWS_CODE(pipeline->getNext(),
+                       AssertionException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -252,6 +350,93 @@ BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     return arr[0].getDocument().toBson();
 }
 
+/**
+ * Runs 'group' over 'inputs', returning its output documents ordered by _id.
+ */
+std::vector<Document> runGroup(const intrusive_ptr<DocumentSource>& group,
+                               const intrusive_ptr<ExpressionContext>& expCtx,
+                               const std::initializer_list<const char*>& inputs) {
+    auto mock = DocumentSourceMock::createForTest(inputs, expCtx);
+    group->setSource(mock.get());
+
+    std::vector<Document> results;
+    for (auto next = group->getNext(); next.isAdvanced(); next = group->getNext()) {
+        results.push_back(next.releaseDocument());
+    }
+    std::sort(results.begin(), results.end(), [&](const Document& lhs, const Document& rhs) {
+        return expCtx->getValueComparator().evaluate(lhs["_id"] < rhs["_id"]);
+    });
+    return results;
+}
+
+Value explainCommonSubexpressions(const intrusive_ptr<DocumentSource>& group) {
+    vector<Value> arr;
+    group->serializeToArray(arr, ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_EQUALS(arr.size(), 1UL);
+    return arr[0]["commonSubexpressions"];
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldShareSubexpressionsRepeatedInKeyAndAccumulators) {
+    auto expCtx = getExpCtx();
+    auto spec = fromjson(
+        "{$group: {_id: {$add: ['$a.b', 1]}, total: {$sum: {$add: ['$a.b', 1]}}, "
+        "doubled: {$max: {$multiply: [{$add: ['$a.b', 1]}, 2]}}, c: {$sum: '$a.c'}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+
+    // A lone field path, even a dotted one, is not shared.
+    auto expected = Value(std::vector<Value>{Value(fromjson("{$add: ['$a.b', {$const: 1}]}"))});
+    ASSERT_VALUE_EQ(explainCommonSubexpressions(group), expected);
+
+    auto results =
+        runGroup(group, expCtx, {"{a: {b: 1, c: 1}}", "{a: {b: 2, c: 1}}", "{a: {b: 1, c: 1}}"});
+    ASSERT_EQ(results.size(), 2UL);
+    ASSERT_DOCUMENT_EQ(results[0], (Document{{"_id", 2}, {"total", 4}, {"doubled", 4}, {"c", 2}}));
+    ASSERT_DOCUMENT_EQ(results[1], (Document{{"_id", 3}, {"total", 3}, {"doubled", 6}, {"c", 1}}));
+
+    // Sharing is invisible to serialization, and still reported once the stage has run.
+    ASSERT_VALUE_EQ(explainCommonSubexpressions(group), expected);
+    ASSERT_BSONOBJ_EQ(toBson(group),
+                      toBson(DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx)));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotEvaluateSharedSubexpressionsInBranchesNotTaken) {
+    auto expCtx = getExpCtx();
+    auto spec = fromjson(
+        "{$group: {_id: null, "
+        "sum: {$sum: {$cond: [{$eq: ['$x', 0]}, 0, {$divide: [1, '$x']}]}}, "
+        "max: {$max: {$cond: [{$eq: ['$x', 0]}, -1, {$divide: [1, '$x']}]}}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    ASSERT_EQ(explainCommonSubexpressions(group).getArrayLength(), 2UL);
+
+    auto results = runGroup(group, expCtx, {"{x: 0}", "{x: 2}", "{x: 0}"});
+    ASSERT_EQ(results.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(results[0], (Document{{"_id", BSONNULL}, {"sum", 0.5}, {"max", 0.5}}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotShareSubexpressionsWhenDisabled) {
+    RAIIServerParameterControllerForTest controller{"internalQueryGroupShareCommonSubexpressions",
+                                                    false};
+    auto expCtx = getExpCtx();
+    auto spec = fromjson("{$group: {_id: {$add: ['$a', 1]}, total: {$sum: {$add: ['$a', 1]}}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    ASSERT_TRUE(explainCommonSubexpressions(group).missing());
+
+    auto results = runGroup(group, expCtx, {"{a: 1}", "{a: 1}"});
+    ASSERT_EQ(results.size(), 1UL);
+    ASSERT_DOCUMENT_EQ(results[0], (Document{{"_id", 2}, {"total", 4}}));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldNotShareSubexpressionsReadingLocalVariablesOrRandom) {
+    auto expCtx = getExpCtx();
+    auto spec = fromjson(
+        "{$group: {_id: null, "
+        "a: {$push: {$map: {input: '$arr', in: {$add: ['$$this', 1]}}}}, "
+        "b: {$push: {$map: {input: '$arr', in: {$add: ['$$this', 1]}}}}, "
+        "c: {$sum: {$add: [{$rand: {}}, 1]}}, d: {$sum: {$add: [{$rand: {}}, 1]}}}}");
+    auto group = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    ASSERT_TRUE(explainCommonSubexpressions(group).missing());
+}
+
 class Base : public ServiceContextTest {
 public:
     Base()
@@ -44,6 +44,10 @@
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_internal_bucket_geo_within.h"
 #include "mongo/db/matcher/expression_internal_expr_comparison.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/matcher/expression_tree.h"
+#include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
 #include "mongo/db/pipeline/document_source_group.h"
@@ -54,7 +58,9 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/timeseries/bucket_bloom_filter.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/duration.h"
@@ -206,6 +212,24 @@ void optimizePrefix(Pipeline::SourceContainer::iterator itr, Pipeline::SourceCon
     container->splice(itr, prefix);
 }
 
+// The field of the summaries returned for a $group rewritten by rewriteGroupByBucketWindow() which
+// holds the number of measurements summarized.
+constexpr StringData kSummaryCountFieldName = "count"_sd;
+
+// Returns the summary of measurements in the shape of a bucket, for a $group rewritten by
+// rewriteGroupByBucketWindow().
+Document makeGroupSummary(Value min, Value max, int count, Value meta) {
+    MutableDocument control;
+    control.addField(timeseries::kBucketControlMinFieldName, std::move(min));
+    control.addField(timeseries::kBucketControlMaxFieldName, std::move(max));
+    control.addField(kSummaryCountFieldName, Value{count});
+
+    MutableDocument summary;
+    summary.addField(timeseries::kBucketControlFieldName, control.freezeToValue());
+    summary.addField(timeseries::kBucketMetaFieldName, std::move(meta));
+    return summary.freeze();
+}
+
 // Returns whether 'field' depends on a pushed down $addFields or computed $project.
 bool fieldIsComputed(BucketSpec spec, std::string field) {
     return std::any_of(
@@ -220,10 +244,68 @@ bool fieldIsComputed(BucketSpec spec, std::string field) {
 DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     BucketUnpacker bucketUnpacker,
-    int bucketMaxSpanSeconds)
+    int bucketMaxSpanSeconds,
+    const boost::optional<BSONObj>& eventFilterBson)
     : DocumentSource(kStageNameInternal, expCtx),
       _bucketUnpacker(std::move(bucketUnpacker)),
-      _bucketMaxSpanSeconds{bucketMaxSpanSeconds} {}
+      _bucketMaxSpanSeconds{bucketMaxSpanSeconds} {
+    if (eventFilterBson) {
+        setEventFilter(*eventFilterBson);
+    }
+}
+
+void DocumentSourceInternalUnpackBucket::setEventFilter(BSONObj eventFilterBson) {
+    _eventFilterBson = eventFilterBson.getOwned();
+    _eventFilter = uassertStatusOK(MatchExpressionParser::parse(*_eventFilterBson,
+                                                                pExpCtx,
+                                                                ExtensionsCallbackNoop(),
+                                                                Pipeline::kAllowedMatcherFeatures));
+
+    // Collect the top-level equality predicates which a bucket's bloom filters can rule out. A
+    // predicate on null also matches missing fields, and strings are compared with the collation,
+    // so neither can be looked up by hash.
+    _bloomFilterProbes.clear();
+    const auto& spec = _bucketUnpacker.bucketSpec();
+    auto addProbe = [&](const MatchExpression* expr) {
+        if (expr->matchType() != MatchExpression::EQ) {
+            return;
+        }
+        auto path = expr->path();
+        auto value = static_cast<const EqualityMatchExpression*>(expr)->getData();
+        if (path.find('.') != std::string::npos || (spec.metaField && path == *spec.metaField) ||
+            fieldIsComputed(spec, path.toString()) || value.isNull() ||
+            (pExpCtx->getCollator() &&
+             (value.type() == BSONType::String || value.type() == BSONType::Symbol ||
+              value.isABSONObj()))) {
+            return;
+        }
+        _bloomFilterProbes.emplace_back(path.toString(),
+                                        timeseries::BucketBloomFilter::hash(value));
+    };
+    if (_eventFilter->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < _eventFilter->numChildren(); ++i) {
+            addProbe(_eventFilter->getChild(i));
+        }
+    } else {
+        addProbe(_eventFilter.get());
+    }
+}
+
+bool DocumentSourceInternalUnpackBucket::bucketMayMatchEventFilter(const BSONObj& bucket) const {
+    if (_bloomFilterProbes.empty()) {
+        return true;
+    }
+
+    auto bloom = bucket.getObjectField(timeseries::kBucketControlFieldName)
+                     .getObjectField(timeseries::kBucketControlBloomFieldName);
+    for (const auto& [field, hash] : _bloomFilterProbes) {
+        if (auto filter = bloom[field];
+            filter && !timeseries::BucketBloomFilter::mayContain(filter, hash)) {
+            return false;
+        }
+    }
+    return true;
+}
 
 boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBsonInternal(
     BSONElement specElem, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
@@ -241,6 +323,8 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
     auto hasBucketMaxSpanSeconds = false;
     auto bucketMaxSpanSeconds = 0;
     std::vector<std::string> computedMetaProjFields;
+    boost::optional<BSONObj> eventFilterBson;
+    boost::intrusive_ptr<Expression> preAggregateGroupKey;
     for (auto&& elem : specElem.embeddedObject()) {
         auto fieldName = elem.fieldNameStringData();
         if (fieldName == kInclude || fieldName == kExclude) {
@@ -311,6 +395,14 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
                         field.find('.') == std::string::npos);
                 bucketSpec.computedMetaProjFields.emplace_back(field);
             }
+        } else if (fieldName == kEventFilter) {
+            uassert(5521512,
+                    str::stream() << "eventFilter field must be an object, got: " << elem.type(),
+                    elem.type() == BSONType::Object);
+            eventFilterBson = elem.Obj();
+        } else if (fieldName == kPreAggregateGroupKey) {
+            preAggregateGroupKey =
+                Expression::parseOperand(expCtx.get(), elem, expCtx->variablesParseState);
         } else {
             uasserted(5346506,
                       str::stream()
@@ -325,8 +417,13 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
             "The $_internalUnpackBucket stage requires a bucketMaxSpanSeconds parameter",
             hasBucketMaxSpanSeconds);
 
-    return make_intrusive<DocumentSourceInternalUnpackBucket>(
-        expCtx, BucketUnpacker{std::move(bucketSpec), unpackerBehavior}, bucketMaxSpanSeconds);
+    auto unpack = make_intrusive<DocumentSourceInternalUnpackBucket>(
+        expCtx,
+        BucketUnpacker{std::move(bucketSpec), unpackerBehavior},
+        bucketMaxSpanSeconds,
+        eventFilterBson);
+    unpack->_preAggregateGroupKey = std::move(preAggregateGroupKey);
+    return unpack;
 }
 
 boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBsonExternal(
@@ -405,6 +502,30 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
                          return compFields;
                      }()});
 
+    if (_eventFilterBson) {
+        out.addField(kEventFilter, Value{*_eventFilterBson});
+    }
+
+    if (_preAggregateGroupKey) {
+        out.addField(kPreAggregateGroupKey,
+                     _preAggregateGroupKey->serialize(static_cast<bool>(explain)));
+    }
+
+    if (explain && *explain >= ExplainOptions::Verbosity::kExecStats &&
+        !_liftedPredicates.empty()) {
+        std::vector<Value> liftedPredicates;
+        for (auto&& predicate : _liftedPredicates) {
+            liftedPredicates.emplace_back(predicate);
+        }
+        out.addField("liftedPredicates", Value{std::move(liftedPredicates)});
+    }
+
+    if (explain && *explain >= ExplainOptions::Verbosity::kExecStats &&
+        !_bloomFilterProbes.empty()) {
+        out.addField("numBucketsSkippedByBloomFilter",
+                     Value{static_cast<long long>(_numBucketsSkippedByBloomFilter)});
+    }
+
     if (!explain) {
         array.push_back(Value(DOC(getSourceName() << out.freeze())));
         if (_sampleSize) {
@@ -423,6 +544,89 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
 DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
     tassert(5521502, "calling doGetNext() when '_sampleSize' is set is disallowed", !_sampleSize);
 
+    // When the following $group aggregates summaries, return the control fields of each bucket
+    // whose measurements all have the same group key, and unpack the other buckets into a summary
+    // per measurement.
+    if (_preAggregateGroupKey) {
+        while (true) {
+            if (_bucketUnpacker.hasNext()) {
+                Value meta{_bucketUnpacker.bucket()[timeseries::kBucketMetaFieldName]};
+                Value measurement{_bucketUnpacker.getNext()};
+                return makeGroupSummary(measurement, measurement, 1, std::move(meta));
+            }
+
+            auto nextResult = pSource->getNext();
+            if (!nextResult.isAdvanced()) {
+                return nextResult;
+            }
+
+            auto bucket = nextResult.getDocument().toBson();
+            const auto& timeField = _bucketUnpacker.bucketSpec().timeField;
+            auto control = bucket.getObjectField(timeseries::kBucketControlFieldName);
+            auto controlMin = control.getObjectField(timeseries::kBucketControlMinFieldName);
+            auto controlMax = control.getObjectField(timeseries::kBucketControlMaxFieldName);
+            auto maxTime = controlMax[timeField];
+            auto summary = makeGroupSummary(
+                Value{controlMin},
+                Value{controlMax},
+                BucketUnpacker::computeMeasurementCount(bucket, timeField),
+                Value{bucket[timeseries::kBucketMetaFieldName]});
+
+            // The group key is monotonic in time, so all measurements have the same key if the
+            // bucket's minimum and maximum time do.
+            if (maxTime.type() == BSONType::Date) {
+                MutableDocument atMaxTime{summary};
+                atMaxTime.setNestedField(
+                    FieldPath{std::string{timeseries::kControlMinFieldNamePrefix} + timeField},
+                    Value{maxTime.date()});
+                auto& variables = pExpCtx->variables;
+                if (pExpCtx->getValueComparator().evaluate(
+                        _preAggregateGroupKey->evaluate(summary, &variables) ==
+                        _preAggregateGroupKey->evaluate(atMaxTime.freeze(), &variables))) {
+                    return summary;
+                }
+            }
+
+            _bucketUnpacker.reset(std::move(bucket));
+            uassert(6170425,
+                    str::stream()
+                        << "A bucket with _id "
+                        << _bucketUnpacker.bucket()[timeseries::kBucketIdFieldName].toString()
+                        << " contains an empty data region",
+                    _bucketUnpacker.hasNext());
+        }
+    }
+
+    // When an event filter is present, unpack each measurement to BSON first and only build a
+    // Document for the measurements which pass the filter.
+    if (_eventFilter) {
+        while (true) {
+            while (_bucketUnpacker.hasNext()) {
+                auto measurement = _bucketUnpacker.getNextBson();
+                if (_eventFilter->matchesBSON(measurement)) {
+                    return Document{measurement};
+                }
+            }
+
+            auto nextResult = pSource->getNext();
+            if (!nextResult.isAdvanced()) {
+                return nextResult;
+            }
+            auto bucket = nextResult.getDocument().toBson();
+            if (!bucketMayMatchEventFilter(bucket)) {
+                ++_numBucketsSkippedByBloomFilter;
+                continue;
+            }
+            _bucketUnpacker.reset(std::move(bucket));
+            uassert(5521513,
+                    str::stream()
+                        << "A bucket with _id "
+                        << _bucketUnpacker.bucket()[timeseries::kBucketIdFieldName].toString()
+                        << " contains an empty data region",
+                    _bucketUnpacker.hasNext());
+        }
+    }
+
     // Otherwise, fallback to unpacking every measurement in all buckets until the child stage is
     // exhausted.
     if (_bucketUnpacker.hasNext()) {
@@ -542,7 +746,7 @@ std::pair<BSONObj, bool> DocumentSourceInternalUnpackBucket::extractOrBuildProje
 }
 
 std::unique_ptr<MatchExpression> createComparisonPredicate(
-    const ComparisonMatchExpression* matchExpr,
+    const ComparisonMatchExpressionBase* matchExpr,
     const BucketSpec& bucketSpec,
     int bucketMaxSpanSeconds,
     ExpressionContext::CollationMatchesDefault collationMatchesDefault) {
@@ -600,6 +804,7 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
 
     switch (matchExpr->matchType()) {
         case MatchExpression::EQ:
+        case MatchExpression::INTERNAL_EXPR_EQ:
             // For $eq, make both a $lte against 'control.min' and a $gte predicate against
             // 'control.max'.
             //
@@ -630,6 +835,7 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
                       MatchExprPredicate<InternalExprGTEMatchExpression>(maxPath, matchExprData));
 
         case MatchExpression::GT:
+        case MatchExpression::INTERNAL_EXPR_GT:
             // For $gt, make a $gt predicate against 'control.max'. In addition, if the comparison
             // is against the 'time' field, include a predicate against the _id field which is
             // converted to the maximum for the corresponding range of ObjectIds and is adjusted
@@ -651,6 +857,7 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
                       MatchExprPredicate<InternalExprGTMatchExpression>(maxPath, matchExprData));
 
         case MatchExpression::GTE:
+        case MatchExpression::INTERNAL_EXPR_GTE:
             // For $gte, make a $gte predicate against 'control.max'. In addition, if the comparison
             // is against the 'time' field, include a predicate against the _id field which is
             // converted to the minimum for the corresponding range of ObjectIds and is adjusted
@@ -672,6 +879,7 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
                       MatchExprPredicate<InternalExprGTEMatchExpression>(maxPath, matchExprData));
 
         case MatchExpression::LT:
+        case MatchExpression::INTERNAL_EXPR_LT:
             // For $lt, make a $lt predicate against 'control.min'. In addition, if the comparison
             // is against the 'time' field, include a predicate against the _id field which is
             // converted to the minimum for the corresponding range of ObjectIds. In
@@ -689,6 +897,7 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
                       MatchExprPredicate<InternalExprLTMatchExpression>(minPath, matchExprData));
 
         case MatchExpression::LTE:
+        case MatchExpression::INTERNAL_EXPR_LTE:
             // For $lte, make a $lte predicate against 'control.min'. In addition, if the comparison
             // is against the 'time' field, include a predicate against the _id field which is
             // converted to the maximum for the corresponding range of ObjectIds. In
@@ -712,35 +921,143 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
     MONGO_UNREACHABLE_TASSERT(5348303);
 }
 
+/**
+ * Maps a $in predicate onto a range over the control fields. The range is bounded by the smallest
+ * and the largest of the values, so it keeps every bucket which could contain any of them.
+ */
+std::unique_ptr<MatchExpression> createInPredicate(
+    const InMatchExpression* matchExpr,
+    const BucketSpec& bucketSpec,
+    int bucketMaxSpanSeconds,
+    ExpressionContext::CollationMatchesDefault collationMatchesDefault) {
+    const auto& equalities = matchExpr->getEqualities();
+    if (equalities.empty() || !matchExpr->getRegexes().empty()) {
+        return nullptr;
+    }
+
+    // The bounds of the range are checked by createComparisonPredicate(), but the values in
+    // between must not be ones the control fields cannot be compared against either.
+    for (auto&& elem : equalities) {
+        if (elem.type() == BSONType::Object || elem.type() == BSONType::Array ||
+            elem.type() == BSONType::jstNULL ||
+            (elem.type() == BSONType::String &&
+             collationMatchesDefault == ExpressionContext::CollationMatchesDefault::kNo)) {
+            return nullptr;
+        }
+    }
+
+    // The equalities are sorted by the collator of the $in.
+    GTEMatchExpression lowerBound(matchExpr->path(), equalities.front());
+    LTEMatchExpression upperBound(matchExpr->path(), equalities.back());
+    auto lower = createComparisonPredicate(
+        &lowerBound, bucketSpec, bucketMaxSpanSeconds, collationMatchesDefault);
+    auto upper = createComparisonPredicate(
+        &upperBound, bucketSpec, bucketMaxSpanSeconds, collationMatchesDefault);
+    if (!lower || !upper) {
+        return nullptr;
+    }
+
+    auto andMatchExpr = std::make_unique<AndMatchExpression>();
+    andMatchExpr->add(std::move(lower));
+    andMatchExpr->add(std::move(upper));
+    return andMatchExpr;
+}
+
+/**
+ * Maps {$exists: true} on a top-level measurement field to the same predicate on 'control.min',
+ * which has the field whenever any of the measurements in the bucket has it.
+ */
+std::unique_ptr<MatchExpression> createExistsPredicate(const ExistsMatchExpression* matchExpr,
+                                                       const BucketSpec& bucketSpec) {
+    using namespace timeseries;
+    const auto matchExprPath = matchExpr->path();
+    if (matchExprPath.find('.') != std::string::npos ||
+        (bucketSpec.metaField && matchExprPath == bucketSpec.metaField.get()) ||
+        fieldIsComputed(bucketSpec, matchExprPath.toString())) {
+        return nullptr;
+    }
+
+    return std::make_unique<ExistsMatchExpression>(std::string{kControlMinFieldNamePrefix} +
+                                                   matchExprPath);
+}
+
 std::unique_ptr<MatchExpression>
 DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(
-    const MatchExpression* matchExpr) const {
+    const MatchExpression* matchExpr, std::vector<BSONObj>* liftedPredicates) const {
     if (matchExpr->matchType() == MatchExpression::AND) {
         auto nextAnd = static_cast<const AndMatchExpression*>(matchExpr);
         auto andMatchExpr = std::make_unique<AndMatchExpression>();
 
         for (size_t i = 0; i < nextAnd->numChildren(); i++) {
-            if (auto child = createPredicatesOnBucketLevelField(nextAnd->getChild(i))) {
+            if (auto child =
+                    createPredicatesOnBucketLevelField(nextAnd->getChild(i), liftedPredicates)) {
                 andMatchExpr->add(std::move(child));
             }
         }
         if (andMatchExpr->numChildren() > 0) {
             return andMatchExpr;
         }
-    } else if (ComparisonMatchExpression::isComparisonMatchExpression(matchExpr)) {
-        return createComparisonPredicate(static_cast<const ComparisonMatchExpression*>(matchExpr),
+        return nullptr;
+    }
+
+    auto predicate = [&]() -> std::unique_ptr<MatchExpression> {
+        switch (matchExpr->matchType()) {
+            case MatchExpression::OR: {
+                // A bucket can only be skipped if it matches none of the branches, so every branch
+                // must be mapped.
+                auto nextOr = static_cast<const OrMatchExpression*>(matchExpr);
+                auto orMatchExpr = std::make_unique<OrMatchExpression>();
+                for (size_t i = 0; i < nextOr->numChildren(); i++) {
+                    auto child = createPredicatesOnBucketLevelField(nextOr->getChild(i));
+                    if (!child) {
+                        return nullptr;
+                    }
+                    orMatchExpr->add(std::move(child));
+                }
+                return orMatchExpr;
+            }
+            case MatchExpression::LT:
+            case MatchExpression::LTE:
+            case MatchExpression::EQ:
+            case MatchExpression::GTE:
+            case MatchExpression::GT:
+            // $expr treats a missing field as smaller than any value, so the $lt and $lte
+            // comparisons rewritten from $expr are not mapped: they match measurements without
+            // the field, which 'control.min' has no value for.
+            case MatchExpression::INTERNAL_EXPR_EQ:
+            case MatchExpression::INTERNAL_EXPR_GTE:
+            case MatchExpression::INTERNAL_EXPR_GT:
+                return createComparisonPredicate(
+                    static_cast<const ComparisonMatchExpressionBase*>(matchExpr),
+                    _bucketUnpacker.bucketSpec(),
+                    _bucketMaxSpanSeconds,
+                    pExpCtx->collationMatchesDefault);
+            case MatchExpression::MATCH_IN:
+                return createInPredicate(static_cast<const InMatchExpression*>(matchExpr),
                                          _bucketUnpacker.bucketSpec(),
                                          _bucketMaxSpanSeconds,
                                          pExpCtx->collationMatchesDefault);
-    } else if (matchExpr->matchType() == MatchExpression::GEO) {
-        auto& geoExpr = static_cast<const GeoMatchExpression*>(matchExpr)->getGeoExpression();
-        if (geoExpr.getPred() == GeoExpression::WITHIN) {
-            return std::make_unique<InternalBucketGeoWithinMatchExpression>(
-                geoExpr.getGeometryPtr(), geoExpr.getField());
+            case MatchExpression::EXISTS:
+                return createExistsPredicate(static_cast<const ExistsMatchExpression*>(matchExpr),
+                                             _bucketUnpacker.bucketSpec());
+            case MatchExpression::GEO: {
+                auto& geoExpr =
+                    static_cast<const GeoMatchExpression*>(matchExpr)->getGeoExpression();
+                if (geoExpr.getPred() == GeoExpression::WITHIN) {
+                    return std::make_unique<InternalBucketGeoWithinMatchExpression>(
+                        geoExpr.getGeometryPtr(), geoExpr.getField());
+                }
+                return nullptr;
+            }
+            default:
+                return nullptr;
         }
-    }
+    }();
 
-    return nullptr;
+    if (predicate && liftedPredicates) {
+        liftedPredicates->push_back(matchExpr->serialize(true));
+    }
+    return predicate;
 }
 
 std::pair<boost::intrusive_ptr<DocumentSourceMatch>, boost::intrusive_ptr<DocumentSourceMatch>>
@@ -869,6 +1186,171 @@ DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContain
     return {};
 }
 
+std::pair<bool, Pipeline::SourceContainer::iterator>
+DocumentSourceInternalUnpackBucket::rewriteGroupByBucketWindow(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    const auto* groupPtr = dynamic_cast<DocumentSourceGroup*>(std::next(itr)->get());
+    const auto& spec = _bucketUnpacker.bucketSpec();
+    if (groupPtr == nullptr || _sampleSize || !spec.metaField ||
+        _bucketUnpacker.behavior() != BucketUnpacker::Behavior::kExclude ||
+        !spec.fieldSet.empty() || !spec.computedMetaProjFields.empty()) {
+        return {};
+    }
+
+    // Each part of the group key must be a path in the metaField, or a $dateTrunc of the
+    // timeField, which is monotonic in time. Rewrite them to refer to the summaries instead.
+    const std::string timeFieldPath = "$" + spec.timeField;
+    auto rewriteKey = [&](const Expression* expr,
+                          const Value& serialized) -> boost::optional<Value> {
+        if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expr)) {
+            const auto& path = fieldPath->getFieldPath();
+            if (path.getPathLength() < 2 || path.getFieldName(1) != *spec.metaField) {
+                return boost::none;
+            }
+
+            std::string rewritten = "$" + timeseries::kBucketMetaFieldName.toString();
+            for (size_t index = 2; index < path.getPathLength(); index++) {
+                rewritten += "." + path.getFieldName(index).toString();
+            }
+            return Value{rewritten};
+        }
+
+        if (dynamic_cast<const ExpressionDateTrunc*>(expr)) {
+            auto deps = expr->getDependencies();
+            auto dateTrunc = serialized.getDocument()["$dateTrunc"].getDocument();
+            if (deps.needWholeDocument || !deps.vars.empty() ||
+                deps.fields != std::set<std::string>{spec.timeField} ||
+                dateTrunc["date"].getType() != BSONType::String ||
+                dateTrunc["date"].getStringData() != timeFieldPath) {
+                return boost::none;
+            }
+
+            MutableDocument rewritten{dateTrunc};
+            rewritten["date"] =
+                Value{std::string{"$"} + timeseries::kControlMinFieldNamePrefix + spec.timeField};
+            return Value{DOC("$dateTrunc" << rewritten.freeze())};
+        }
+
+        return boost::none;
+    };
+
+    auto serializedId = groupPtr->serialize()["$group"]["_id"];
+    const auto idFields = groupPtr->getIdFields();
+    Value newId;
+    if (idFields.size() == 1 && idFields.begin()->first == "_id") {
+        auto rewritten = rewriteKey(idFields.begin()->second.get(), serializedId);
+        if (!rewritten) {
+            return {};
+        }
+        newId = *rewritten;
+    } else {
+        MutableDocument rewrittenId;
+        for (auto it = serializedId.getDocument().fieldIterator(); it.more();) {
+            auto [name, serialized] = it.next();
+            auto expr = idFields.find("_id." + name.toString());
+            if (expr == idFields.end()) {
+                return {};
+            }
+            auto rewritten = rewriteKey(expr->second.get(), serialized);
+            if (!rewritten) {
+                return {};
+            }
+            rewrittenId.addField(name, *rewritten);
+        }
+        newId = rewrittenId.freezeToValue();
+    }
+
+    // The aggregates must be $min or $max of a measurement field, which can be computed from
+    // 'control.min' and 'control.max', or a count of the measurements, which is the sum of the
+    // counts of the summaries. The timeField is excluded because 'control.min' holds its rounded
+    // down value.
+    std::set<std::string> unpackedFields{spec.timeField};
+    BSONObjBuilder newGroupSpec;
+    newId.addToBsonObj(&newGroupSpec, "_id");
+    for (const AccumulationStatement& stmt : groupPtr->getAccumulatedFields()) {
+        const auto op = stmt.expr.name;
+        const auto* exprArg = stmt.expr.argument.get();
+        if (op == "$min" || op == "$max") {
+            const auto* exprArgPath = dynamic_cast<const ExpressionFieldPath*>(exprArg);
+            if (!exprArgPath || exprArgPath->getFieldPath().getPathLength() <= 1) {
+                return {};
+            }
+            const auto& path = exprArgPath->getFieldPath();
+            if (path.getFieldName(1) == spec.timeField || path.getFieldName(1) == *spec.metaField) {
+                return {};
+            }
+
+            unpackedFields.insert(path.getFieldName(1).toString());
+            auto controlPath = (op == "$min" ? timeseries::kControlMinFieldNamePrefix
+                                             : timeseries::kControlMaxFieldNamePrefix) +
+                path.tail().fullPath();
+            newGroupSpec.append(stmt.fieldName, BSON(op << "$" + controlPath));
+        } else if (const auto* constant = dynamic_cast<const ExpressionConstant*>(exprArg);
+                   op == "$sum" && constant && constant->getValue().numeric() &&
+                   constant->getValue().coerceToDouble() == 1) {
+            newGroupSpec.append(stmt.fieldName,
+                                BSON("$sum" << std::string{"$"} +
+                                         timeseries::kBucketControlFieldName + "." +
+                                         kSummaryCountFieldName));
+        } else {
+            return {};
+        }
+    }
+
+    auto newGroupObj = newGroupSpec.obj();
+    std::vector<AccumulationStatement> accumulationStatements;
+    for (auto&& elem : newGroupObj) {
+        if (elem.fieldNameStringData() != "_id") {
+            accumulationStatements.push_back(AccumulationStatement::parseAccumulationStatement(
+                pExpCtx.get(), elem, pExpCtx->variablesParseState));
+        }
+    }
+    auto newGroup = DocumentSourceGroup::create(
+        pExpCtx,
+        Expression::parseOperand(pExpCtx.get(), newGroupObj["_id"], pExpCtx->variablesParseState),
+        std::move(accumulationStatements),
+        groupPtr->getMaxMemoryUsageBytes());
+
+    _preAggregateGroupKey =
+        Expression::parseOperand(pExpCtx.get(), newGroupObj["_id"], pExpCtx->variablesParseState);
+    _bucketUnpacker.setBucketSpecAndBehavior(
+        {spec.timeField, spec.metaField, std::move(unpackedFields)},
+        BucketUnpacker::Behavior::kInclude);
+    *std::next(itr) = std::move(newGroup);
+
+    // Give the previous stage a chance to optimize against this stage.
+    return {true, itr == container->begin() ? itr : std::prev(itr)};
+}
+
+bool DocumentSourceInternalUnpackBucket::absorbEventFilter(Pipeline::SourceContainer::iterator itr,
+                                                           Pipeline::SourceContainer* container) {
+    if (!internalQueryTimeseriesEnableEventFilter.load() || _eventFilter || _sampleSize ||
+        std::next(itr) == container->end()) {
+        return false;
+    }
+
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get());
+    if (!nextMatch || nextMatch->isTextQuery()) {
+        return false;
+    }
+
+    // The filter is evaluated against the unpacked measurement alone, so it must not depend on
+    // metadata such as a text score.
+    DepsTracker deps;
+    nextMatch->getDependencies(&deps);
+    if (deps.getNeedsAnyMetadata()) {
+        return false;
+    }
+
+    setEventFilter(nextMatch->getQuery());
+    container->erase(std::next(itr));
+
+    // The set of unpacked fields must stay as it is now, since the filter was written against the
+    // measurement as it is currently materialized.
+    _triedInternalizeProject = true;
+    return true;
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
@@ -915,6 +1397,13 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
             return container->end();
         }
     }
+
+    // Once a $match has been absorbed as the event filter, this stage no longer produces every
+    // measurement of every bucket, so the rewrites below which reason about the full contents of a
+    // bucket, or which change the set of unpacked fields, are no longer safe.
+    if (_eventFilter || _preAggregateGroupKey) {
+        return container->end();
+    }
     {
         // Check if we can avoid unpacking if we have a group stage with min/max aggregates.
         auto [success, result] = rewriteGroupByMinMax(itr, container);
@@ -922,6 +1411,14 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
             return result;
         }
     }
+    {
+        // Check if we can avoid unpacking the buckets whose measurements all fall into the same
+        // group of a following $group by metadata and time window.
+        auto [success, result] = rewriteGroupByBucketWindow(itr, container);
+        if (success) {
+            return result;
+        }
+    }
 
     {
         // Check if the rest of the pipeline needs any fields. For example we might only be
@@ -997,7 +1494,8 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         nextMatch && !_triedBucketLevelFieldsPredicatesPushdown) {
         _triedBucketLevelFieldsPredicatesPushdown = true;
 
-        if (auto match = createPredicatesOnBucketLevelField(nextMatch->getMatchExpression())) {
+        if (auto match = createPredicatesOnBucketLevelField(nextMatch->getMatchExpression(),
+                                                            &_liftedPredicates)) {
             BSONObjBuilder bob;
             match->serialize(&bob);
             container->insert(itr, DocumentSourceMatch::create(bob.obj(), pExpCtx));
@@ -1047,6 +1545,12 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         }
     }
 
+    // As the last rewrite, evaluate a following $match while unpacking so that we avoid building
+    // Documents for the measurements it would discard.
+    if (absorbEventFilter(itr, container)) {
+        return itr;
+    }
+
     return container->end();
 }
 }  // namespace mongo
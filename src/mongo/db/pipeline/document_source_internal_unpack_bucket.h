@@ -44,15 +44,19 @@ public:
     static constexpr StringData kInclude = "include"_sd;
     static constexpr StringData kExclude = "exclude"_sd;
     static constexpr StringData kBucketMaxSpanSeconds = "bucketMaxSpanSeconds"_sd;
+    static constexpr StringData kEventFilter = "eventFilter"_sd;
+    static constexpr StringData kPreAggregateGroupKey = "preAggregateGroupKey"_sd;
 
     static boost::intrusive_ptr<DocumentSource> createFromBsonInternal(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
     static boost::intrusive_ptr<DocumentSource> createFromBsonExternal(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
-    DocumentSourceInternalUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
-                                       BucketUnpacker bucketUnpacker,
-                                       int bucketMaxSpanSeconds);
+    DocumentSourceInternalUnpackBucket(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        BucketUnpacker bucketUnpacker,
+        int bucketMaxSpanSeconds,
+        const boost::optional<BSONObj>& eventFilterBson = boost::none);
 
     const char* getSourceName() const override {
         return kStageNameInternal.rawData();
@@ -105,6 +109,14 @@ public:
         return _bucketUnpacker.copy();
     }
 
+    /**
+     * Returns the filter applied to each unpacked measurement before it is materialized as a
+     * Document, or nullptr if every measurement is returned.
+     */
+    const MatchExpression* eventFilter() const {
+        return _eventFilter.get();
+    }
+
     Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
                                                      Pipeline::SourceContainer* container) final;
 
@@ -155,10 +167,16 @@ public:
      *      {control.min.time: {$_internalExprLt: new Date(...)}}
      * ]}
      *
+     * Besides comparisons, $in, {$exists: true}, $geoWithin, the comparisons rewritten from $expr
+     * and $or of any of these are mapped. Within an $and, the children which cannot be mapped are
+     * left out.
+     *
+     * If 'liftedPredicates' is set, the predicates which were mapped are appended to it.
+     *
      * If the provided predicate is ineligible for this mapping, the function will return a nullptr.
      */
     std::unique_ptr<MatchExpression> createPredicatesOnBucketLevelField(
-        const MatchExpression* matchExpr) const;
+        const MatchExpression* matchExpr, std::vector<BSONObj>* liftedPredicates = nullptr) const;
 
     /**
      * Sets the sample size to 'n' and the maximum number of measurements in a bucket to be
@@ -199,18 +217,68 @@ public:
     std::pair<bool, Pipeline::SourceContainer::iterator> rewriteGroupByMinMax(
         Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container);
 
+    /**
+     * Helper method which checks if the following $group, keyed by the metaField and $dateTrunc of
+     * the timeField with $min, $max and $count aggregates, can be computed from the control fields
+     * of the buckets whose measurements all fall into the same group. If so, the $group is
+     * rewritten to aggregate the summaries this stage then returns: one per such bucket, and one
+     * per measurement of the other buckets. If a rewrite is possible, 'container' is modified, and
+     * we return the result value for 'doOptimizeAt'.
+     */
+    std::pair<bool, Pipeline::SourceContainer::iterator> rewriteGroupByBucketWindow(
+        Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container);
+
+    /**
+     * If the stage after $_internalUnpackBucket is a $match, absorbs it into this stage as the
+     * 'eventFilter' so that measurements which do not pass the filter are never materialized as
+     * Documents. Returns true if the $match was removed from 'container'.
+     */
+    bool absorbEventFilter(Pipeline::SourceContainer::iterator itr,
+                           Pipeline::SourceContainer* container);
+
 private:
     GetNextResult doGetNext() final;
 
+    /**
+     * Sets '_eventFilterBson' and parses it into '_eventFilter', and collects the predicates of the
+     * filter which can be checked against the bloom filters of a bucket.
+     */
+    void setEventFilter(BSONObj eventFilterBson);
+
+    /**
+     * Returns false if the bloom filters in the control field of 'bucket' show that none of its
+     * measurements can match the event filter.
+     */
+    bool bucketMayMatchEventFilter(const BSONObj& bucket) const;
+
     BucketUnpacker _bucketUnpacker;
     int _bucketMaxSpanSeconds;
 
+    // A predicate on measurements which is evaluated against the unpacked BSON of each measurement
+    // before a Document is built for it. Only set when a $match following this stage has been
+    // absorbed.
+    boost::optional<BSONObj> _eventFilterBson;
+    std::unique_ptr<MatchExpression> _eventFilter;
+
+    // The field and value hash of each top-level equality predicate of the event filter, which are
+    // looked up in the 'control.bloom' filters of each bucket before unpacking it.
+    std::vector<std::pair<std::string, long long>> _bloomFilterProbes;
+    size_t _numBucketsSkippedByBloomFilter = 0;
+
     int _bucketMaxCount = 0;
     boost::optional<long long> _sampleSize;
 
+    // The group key of the following $group, over the summaries returned by this stage, when it
+    // has been rewritten by rewriteGroupByBucketWindow().
+    boost::intrusive_ptr<Expression> _preAggregateGroupKey;
+
     // Used to avoid infinite loops after we step backwards to optimize a $match on bucket level
     // fields, otherwise we may do an infinite number of $match pushdowns.
     bool _triedBucketLevelFieldsPredicatesPushdown = false;
+
+    // The predicates of the following $match which were mapped to bucket-level predicates, shown
+    // in explain with executionStats verbosity.
+    std::vector<BSONObj> _liftedPredicates;
     bool _optimizedEndOfPipeline = false;
     bool _triedInternalizeProject = false;
 };
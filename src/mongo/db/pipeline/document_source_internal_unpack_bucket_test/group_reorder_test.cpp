@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/query/util/make_data_structure.h"
 
 namespace mongo {
@@ -126,5 +127,51 @@ TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnMetadataNegative1) {
     ASSERT_BSONOBJ_EQ(groupSpecObj, serialized[1]);
 }
 
+
+TEST_F(InternalUnpackBucketGroupReorder, PreAggregateGroupByMetaAndTimeWindow) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { exclude: [], metaField: 'meta1', timeField: 't', "
+        "bucketMaxSpanSeconds: 3600}}");
+    auto groupSpecObj = fromjson(
+        "{$group: {_id: {m: '$meta1.a', h: {$dateTrunc: {date: '$t', unit: 'hour'}}}, "
+        "lo: {$min: '$b'}, hi: {$max: '$c.d'}, n: {$count: {}}}}");
+
+    auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(2, serialized.size());
+
+    auto optimizedUnpack = fromjson(
+        "{$_internalUnpackBucket: { include: ['b', 'c', 't'], timeField: 't', metaField: "
+        "'meta1', bucketMaxSpanSeconds: 3600, preAggregateGroupKey: {m: '$meta.a', h: "
+        "{$dateTrunc: {date: '$control.min.t', unit: {$const: 'hour'}}}}}}");
+    ASSERT_BSONOBJ_EQ(optimizedUnpack, serialized[0]);
+
+    auto optimizedGroup = fromjson(
+        "{$group: {_id: {m: '$meta.a', h: {$dateTrunc: {date: '$control.min.t', unit: {$const: "
+        "'hour'}}}}, lo: {$min: '$control.min.b'}, hi: {$max: '$control.max.c.d'}, n: {$sum: "
+        "'$control.count'}}}");
+    ASSERT_BSONOBJ_EQ(optimizedGroup, serialized[1]);
+}
+
+TEST_F(InternalUnpackBucketGroupReorder, PreAggregateGroupByTimeWindowNegative) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { exclude: [], metaField: 'meta1', timeField: 't', "
+        "bucketMaxSpanSeconds: 3600}}");
+    // $avg cannot be computed from the control fields of a bucket.
+    auto groupSpecObj = fromjson(
+        "{$group: {_id: {$dateTrunc: {date: '$t', unit: 'hour'}}, a: {$avg: '$b'}}}");
+
+    auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(2, serialized.size());
+    ASSERT_FALSE(serialized[0]
+                     .firstElement()
+                     .Obj()
+                     .hasField(DocumentSourceInternalUnpackBucket::kPreAggregateGroupKey));
+}
 }  // namespace
 }  // namespace mongo
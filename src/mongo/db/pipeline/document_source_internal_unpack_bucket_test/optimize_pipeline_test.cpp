@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/bson_test_util.h"
 
 namespace mongo {
@@ -805,5 +806,32 @@ TEST_F(OptimizePipeline, MatchWithGeoWithinOnMetaFieldIsPushedDown) {
                                "'time', metaField: 'myMeta', bucketMaxSpanSeconds: 3600}}"),
                       serialized[1]);
 }
+TEST_F(OptimizePipeline, EventFilterAbsorbedWhenEnabled) {
+    RAIIServerParameterControllerForTest controller("internalQueryTimeseriesEnableEventFilter",
+                                                    true);
+    auto unpack = fromjson(
+        "{$_internalUnpackBucket: { exclude: [], timeField: 'time', metaField: 'myMeta', "
+        "bucketMaxSpanSeconds: 3600}}");
+    auto pipeline = Pipeline::parse(
+        makeVector(unpack, fromjson("{$match: {myMeta: {$gte: 0, $lte: 5}, a: {$lte: 4}}}")),
+        getExpCtx());
+    ASSERT_EQ(2u, pipeline->getSources().size());
+
+    pipeline->optimizePipeline();
+
+    auto stages = pipeline->writeExplainOps(ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_EQ(2u, stages.size());
+
+    // The $match on the metaField and the control predicates are still pushed down, while the
+    // remaining predicate is evaluated by $_internalUnpackBucket itself.
+    ASSERT_BSONOBJ_EQ(fromjson("{$match: {$and: [{meta: {$gte: 0}}, {meta: {$lte: 5}}, "
+                               "{'control.min.a': {$_internalExprLte: 4}}]}}"),
+                      stages[0].getDocument().toBson());
+    ASSERT_BSONOBJ_EQ(fromjson("{$_internalUnpackBucket: { exclude: [], timeField: 'time', "
+                               "metaField: 'myMeta', bucketMaxSpanSeconds: 3600, "
+                               "eventFilter: {a: {$lte: 4}}}}"),
+                      stages[1].getDocument().toBson());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -31,6 +31,7 @@
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/timeseries/bucket_bloom_filter.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 
 namespace mongo {
@@ -905,5 +906,168 @@ TEST_F(InternalUnpackBucketExecTest, ParserRoundtripsComputedMetaProjFieldOverri
     unpackBucket->serializeToArray(array);
     ASSERT_BSONOBJ_EQ(array[0].getDocument().toBson(), bson);
 }
+TEST_F(InternalUnpackBucketExecTest, UnpackWithEventFilterSkipsNonMatchingMeasurements) {
+    auto expCtx = getExpCtx();
+    auto spec = fromjson(
+        "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+        "bucketMaxSpanSeconds: 3600, eventFilter: {$or: [{a: {$gt: 1}}, {'myMeta.m1': 9}]}}}");
+    auto unpack =
+        DocumentSourceInternalUnpackBucket::createFromBsonInternal(spec.firstElement(), expCtx);
+
+    auto source = DocumentSourceMock::createForTest(
+        {"{control: {'version': 1}, meta: {'m1': 999, 'm2': 9999}, data: {_id: {'0':1, '1':2}, "
+         "time: {'0':1, '1':2}, a:{'0':1, '1':2}, b:{'1':1}}}",
+         "{control: {'version': 1}, meta: {'m1': 999}, data: {_id: {'0':3}, time: {'0':3}, "
+         "a:{'0':0}}}",
+         "{control: {'version': 1}, meta: {'m1': 9}, data: {_id: {'0':4}, time: {'0':4}, "
+         "a:{'0':0}}}"},
+        expCtx);
+    unpack->setSource(source.get());
+
+    // Only the second measurement of the first bucket passes the filter, and the second bucket is
+    // skipped entirely.
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.getDocument(),
+        Document(fromjson("{time: 2, myMeta: {m1: 999, m2: 9999}, _id: 2, a: 2, b: 1}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(fromjson("{time: 4, myMeta: {m1: 9}, _id: 4, a: 0}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
+TEST_F(InternalUnpackBucketExecTest, UnpackWithEventFilterSkipsBucketsByBloomFilter) {
+    auto expCtx = getExpCtx();
+    auto spec = fromjson(
+        "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+        "bucketMaxSpanSeconds: 3600, eventFilter: {$and: [{a: 1}, {b: {$gt: 0}}]}}}");
+    auto unpack =
+        DocumentSourceInternalUnpackBucket::createFromBsonInternal(spec.firstElement(), expCtx);
+
+    auto makeBucket = [](int id, boost::optional<int> bloomValue) {
+        BSONObjBuilder builder;
+        {
+            BSONObjBuilder control(builder.subobjStart(timeseries::kBucketControlFieldName));
+            control.append(timeseries::kBucketControlVersionFieldName, 1);
+            if (bloomValue) {
+                timeseries::BucketBloomFilter filter;
+                filter.add(BSON("" << *bloomValue).firstElement());
+                BSONObjBuilder bloom(control.subobjStart(timeseries::kBucketControlBloomFieldName));
+                filter.appendTo(&bloom, "a");
+            }
+        }
+        builder.append(timeseries::kBucketDataFieldName,
+                       BSON("_id" << BSON("0" << id) << "time" << BSON("0" << id) << "a"
+                                  << BSON("0" << 1) << "b" << BSON("0" << 1)));
+        return Document{builder.obj()};
+    };
+
+    // The filter of the second bucket does not contain the value, so the bucket is skipped even
+    // though its measurement would match. A bucket without a filter is always unpacked.
+    auto source = DocumentSourceMock::createForTest(
+        {makeBucket(1, 1), makeBucket(2, 2), makeBucket(3, boost::none)}, expCtx);
+    unpack->setSource(source.get());
+
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson("{time: 1, _id: 1, a: 1, b: 1}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson("{time: 3, _id: 3, a: 1, b: 1}")));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
+
+TEST_F(InternalUnpackBucketExecTest, ParserRoundtripsEventFilter) {
+    auto bson = fromjson(
+        "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'meta', "
+        "bucketMaxSpanSeconds: 3600, eventFilter: {a: {$gt: 5}}}}");
+    auto array = std::vector<Value>{};
+    DocumentSourceInternalUnpackBucket::createFromBsonInternal(bson.firstElement(), getExpCtx())
+        ->serializeToArray(array);
+    ASSERT_BSONOBJ_EQ(array[0].getDocument().toBson(), bson);
+}
+
+TEST_F(InternalUnpackBucketExecTest, ParserRejectsNonObjectEventFilter) {
+    ASSERT_THROWS_CODE(DocumentSourceInternalUnpackBucket::createFromBsonInternal(
+                           fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', "
+                                    "bucketMaxSpanSeconds: 3600, eventFilter: 1}}")
+                               .firstElement(),
+                           getExpCtx()),
+                       AssertionException,
+                       5521512);
+}
+
+TEST_F(InternalUnpackBucketExecTest, PreAggregateGroupKeySummarizesAlignedBuckets) {
+    auto expCtx = getExpCtx();
+    auto spec = BSON(DocumentSourceInternalUnpackBucket::kStageNameInternal << BSON(
+                         DocumentSourceInternalUnpackBucket::kInclude
+                         << BSON_ARRAY(kUserDefinedTimeName << "a") << timeseries::kTimeFieldName
+                         << kUserDefinedTimeName << timeseries::kMetaFieldName
+                         << kUserDefinedMetaName
+                         << DocumentSourceInternalUnpackBucket::kBucketMaxSpanSeconds << 3600
+                         << DocumentSourceInternalUnpackBucket::kPreAggregateGroupKey
+                         << fromjson("{h: {$dateTrunc: {date: '$control.min.time', unit: "
+                                     "'hour'}}}")));
+    auto unpack =
+        DocumentSourceInternalUnpackBucket::createFromBsonInternal(spec.firstElement(), expCtx);
+
+    auto minute = [](int n) { return Date_t::fromMillisSinceEpoch(n * 60 * 1000); };
+    // The first bucket lies within a single hour, while the second straddles two hours.
+    auto alignedBucket =
+        BSON("control" << BSON("version" << 1 << "min" << BSON("time" << minute(10) << "a" << 1)
+                                         << "max" << BSON("time" << minute(20) << "a" << 5))
+                       << "meta" << 1 << "data"
+                       << BSON("time" << BSON("0" << minute(10) << "1" << minute(20)) << "a"
+                                      << BSON("0" << 1 << "1" << 5)));
+    auto straddlingBucket =
+        BSON("control" << BSON("version" << 1 << "min" << BSON("time" << minute(50) << "a" << 2)
+                                         << "max" << BSON("time" << minute(70) << "a" << 3))
+                       << "meta" << 2 << "data"
+                       << BSON("time" << BSON("0" << minute(50) << "1" << minute(70)) << "a"
+                                      << BSON("0" << 2 << "1" << 3)));
+    auto source = DocumentSourceMock::createForTest(
+        {Document{alignedBucket}, Document{straddlingBucket}}, expCtx);
+    unpack->setSource(source.get());
+
+    // The aligned bucket is summarized from its control fields.
+    auto next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.getDocument(),
+                       Document(BSON("control" << BSON("min" << BSON("time" << minute(10) << "a"
+                                                                            << 1)
+                                                               << "max"
+                                                               << BSON("time" << minute(20) << "a"
+                                                                              << 5)
+                                                               << "count" << 2)
+                                               << "meta" << 1)));
+
+    // The straddling bucket is unpacked into a summary per measurement.
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto first = BSON("time" << minute(50) << "a" << 2);
+    ASSERT_DOCUMENT_EQ(
+        next.getDocument(),
+        Document(BSON("control" << BSON("min" << first << "max" << first << "count" << 1)
+                                << "meta" << 2)));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    auto second = BSON("time" << minute(70) << "a" << 3);
+    ASSERT_DOCUMENT_EQ(
+        next.getDocument(),
+        Document(BSON("control" << BSON("min" << second << "max" << second << "count" << 1)
+                                << "meta" << 2)));
+
+    next = unpack->getNext();
+    ASSERT_TRUE(next.isEOF());
+}
 }  // namespace
 }  // namespace mongo
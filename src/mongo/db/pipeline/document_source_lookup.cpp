@@ -54,6 +54,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
@@ -81,6 +82,42 @@ BSONObj buildEqualityOrQuery(const std::string& fieldName, const BSONArray& valu
     return orBuilder.obj();
 }
 
+/**
+ * Invokes 'callback' on every value that an equality predicate on the non-positional path 'path'
+ * compares against in 'doc': the values reached by traversing arrays along the path, as well as any
+ * array found at the end of the path and each of its elements. Arrays nested directly within arrays
+ * are not expanded, matching the query system's array traversal rules.
+ */
+void visitEqualityValuesAtPath(const Document& doc,
+                               const FieldPath& path,
+                               size_t fieldPathIndex,
+                               const std::function<void(const Value&)>& callback) {
+    auto nextValue = doc.getField(path.getFieldName(fieldPathIndex));
+    ++fieldPathIndex;
+
+    if (fieldPathIndex == path.getPathLength()) {
+        if (nextValue.isArray()) {
+            callback(nextValue);
+            for (auto&& element : nextValue.getArray()) {
+                callback(element);
+            }
+        } else if (!nextValue.missing()) {
+            callback(nextValue);
+        }
+        return;
+    }
+
+    if (nextValue.isArray()) {
+        for (auto&& element : nextValue.getArray()) {
+            if (element.getType() == BSONType::Object) {
+                visitEqualityValuesAtPath(element.getDocument(), path, fieldPathIndex, callback);
+            }
+        }
+    } else if (nextValue.getType() == BSONType::Object) {
+        visitEqualityValuesAtPath(nextValue.getDocument(), path, fieldPathIndex, callback);
+    }
+}
+
 void lookupPipeValidator(const Pipeline& pipeline) {
     const auto& sources = pipeline.getSources();
     std::for_each(sources.begin(), sources.end(), [](auto& src) {
@@ -435,7 +472,44 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
 
+    std::vector<Value> results;
+    long long objsize = 0;
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    auto appendResult = [&](Document result) {
+        long long safeSum = 0;
+        bool hasOverflowed = overflow::add(objsize, result.getApproximateSize(), &safeSum);
+        uassert(4568,
+                str::stream() << "Total size of documents in " << _fromNs.coll()
+                              << " matching pipeline's $lookup stage exceeds " << maxBytes
+                              << " bytes",
+
+                !hasOverflowed && objsize <= maxBytes);
+        objsize = safeSum;
+        results.emplace_back(std::move(result));
+    };
+
     if (hasLocalFieldForeignFieldJoin()) {
+        if (_hashJoinState == HashJoinState::kUndecided &&
+            _numLocalDocsJoined >= internalDocumentSourceLookupHashJoinMinLocalDocuments.load()) {
+            if (canUseHashJoin()) {
+                buildHashJoinTable();
+            } else {
+                _hashJoinState = HashJoinState::kAbandoned;
+            }
+        }
+
+        if (_hashJoinState == HashJoinState::kActive) {
+            if (auto matches = probeHashJoinTable(inputDoc)) {
+                for (auto docIdx : *matches) {
+                    appendResult(_hashJoinDocs[docIdx]);
+                }
+                MutableDocument output(std::move(inputDoc));
+                output.setNestedField(_as, Value(std::move(results)));
+                return output.freeze();
+            }
+        }
+
+        ++_numLocalDocsJoined;
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
         // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
@@ -463,21 +537,8 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         throw;
     }
 
-    std::vector<Value> results;
-    long long objsize = 0;
-    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
-
     while (auto result = pipeline->getNext()) {
-        long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline's $lookup stage exceeds " << maxBytes
-                              << " bytes",
-
-                !hasOverflowed && objsize <= maxBytes);
-        objsize = safeSum;
-        results.emplace_back(std::move(*result));
+        appendResult(std::move(*result));
     }
 
     recordPlanSummaryStats(*pipeline);
@@ -486,6 +547,107 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     return output.freeze();
 }
 
+bool DocumentSourceLookUp::canUseHashJoin() const {
+    if (!hasLocalFieldForeignFieldJoin() || hasPipeline() || _unwindSrc || _additionalFilter ||
+        pExpCtx->inMongos || internalDocumentSourceLookupHashJoinMaxMemoryBytes.load() <= 0) {
+        return false;
+    }
+
+    // Numeric path components may refer to array positions, which the hash table's key extraction
+    // does not follow.
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (str::parseUnsignedBase10Integer(_foreignField->getFieldName(i))) {
+            return false;
+        }
+    }
+
+    // A sharded foreign collection would have to be scanned in full on every shard.
+    return !pExpCtx->mongoProcessInterface->isSharded(pExpCtx->opCtx, _resolvedNs);
+}
+
+void DocumentSourceLookUp::buildHashJoinTable() {
+    invariant(_hashJoinState == HashJoinState::kUndecided);
+    _hashJoinState = HashJoinState::kAbandoned;
+
+    // Scan the entire foreign collection by leaving the join predicate empty.
+    _resolvedPipeline[*_fieldMatchPipelineIdx] = BSON("$match" << BSONObj());
+    auto pipeline = buildPipeline(Document());
+
+    const long long maxMemoryBytes = internalDocumentSourceLookupHashJoinMaxMemoryBytes.load();
+    auto table = _fromExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    std::vector<Document> docs;
+    long long memoryBytes = 0;
+
+    while (auto result = pipeline->getNext()) {
+        const auto docIdx = docs.size();
+        memoryBytes += result->getApproximateSize();
+        visitEqualityValuesAtPath(*result, *_foreignField, 0, [&](const Value& value) {
+            // Nullish local values are never answered from the table, so there is no need to
+            // index the foreign documents they would match.
+            if (value.nullish()) {
+                return;
+            }
+            auto& positions = table[value];
+            if (positions.empty()) {
+                memoryBytes += value.getApproximateSize();
+            }
+            // A document reaches the same key several times if the key is repeated in an array.
+            if (positions.empty() || positions.back() != docIdx) {
+                positions.push_back(docIdx);
+                memoryBytes += sizeof(size_t);
+            }
+        });
+        docs.push_back(std::move(*result));
+
+        if (memoryBytes > maxMemoryBytes) {
+            LOGV2_DEBUG(5899400,
+                        3,
+                        "Abandoning $lookup hash join as the foreign collection exceeds the "
+                        "memory limit",
+                        "foreignNs"_attr = _resolvedNs,
+                        "maxMemoryBytes"_attr = maxMemoryBytes);
+            recordPlanSummaryStats(*pipeline);
+            return;
+        }
+    }
+
+    recordPlanSummaryStats(*pipeline);
+    _hashJoinDocs = std::move(docs);
+    _hashJoinTable = std::move(table);
+    _hashJoinState = HashJoinState::kActive;
+}
+
+boost::optional<std::vector<size_t>> DocumentSourceLookUp::probeHashJoinTable(
+    const Document& inputDoc) const {
+    invariant(_hashJoinTable);
+    std::vector<size_t> matches;
+    size_t numLocalValues = 0;
+    bool hasNullishLocalValue = false;
+    document_path_support::visitAllValuesAtPath(
+        inputDoc, *_localField, [&](const Value& localValue) {
+            ++numLocalValues;
+            if (localValue.nullish()) {
+                hasNullishLocalValue = true;
+                return;
+            }
+            if (auto it = _hashJoinTable->find(localValue); it != _hashJoinTable->end()) {
+                matches.insert(matches.end(), it->second.begin(), it->second.end());
+            }
+        });
+
+    // Missing local values are treated as null.
+    if (hasNullishLocalValue || numLocalValues == 0) {
+        return boost::none;
+    }
+
+    // Report each foreign document once, even if it matches several local values.
+    if (numLocalValues > 1) {
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+    }
+    return matches;
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipelineFromViewDefinition(
     std::vector<BSONObj> serializedPipeline,
     ExpressionContext::ResolvedNamespace resolvedNamespace) {
@@ -805,6 +967,11 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    if (_hashJoinState == HashJoinState::kActive) {
+        _hashJoinState = HashJoinState::kAbandoned;
+        _hashJoinTable.reset();
+        _hashJoinDocs.clear();
+    }
     if (_pipeline) {
         recordPlanSummaryStats(*_pipeline);
         _pipeline->dispose(pExpCtx->opCtx);
@@ -270,6 +270,30 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns true if this stage may join local documents by probing an in-memory hash table built
+     * from a single scan of the foreign collection rather than by executing a sub-pipeline per
+     * local document. Only the plain localField/foreignField syntax against an unsharded foreign
+     * collection is eligible.
+     */
+    bool canUseHashJoin() const;
+
+    /**
+     * Runs the foreign pipeline once without a join predicate and indexes the returned documents by
+     * the values of '_foreignField'. If the documents exceed
+     * 'internalDocumentSourceLookupHashJoinMaxMemoryBytes' the partially built table is discarded
+     * and the stage permanently falls back to per-document sub-pipelines.
+     */
+    void buildHashJoinTable();
+
+    /**
+     * Returns the positions in '_hashJoinDocs' of the foreign documents matching 'inputDoc', in
+     * ascending order. Returns boost::none if the local values cannot be answered from the table,
+     * which is the case when they include null or undefined, since those also match foreign
+     * documents that are missing '_foreignField'.
+     */
+    boost::optional<std::vector<size_t>> probeHashJoinTable(const Document& inputDoc) const;
+
     /**
      * Resolves let defined variables against 'localDoc' and stores the results in 'variables'.
      */
@@ -376,6 +400,17 @@ private:
 
     std::vector<LetVariable> _letVariables;
 
+    // State of the hash join for the localField/foreignField syntax. The decision to build the
+    // table is made once 'internalDocumentSourceLookupHashJoinMinLocalDocuments' local documents
+    // have been joined using sub-pipelines.
+    enum class HashJoinState { kUndecided, kActive, kAbandoned };
+    HashJoinState _hashJoinState = HashJoinState::kUndecided;
+    long long _numLocalDocsJoined = 0;
+    // The foreign documents, in the order in which the foreign pipeline returned them, and a map
+    // from every value of '_foreignField' to the positions of the documents containing it.
+    std::vector<Document> _hashJoinDocs;
+    boost::optional<ValueUnorderedMap<std::vector<size_t>>> _hashJoinTable;
+
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
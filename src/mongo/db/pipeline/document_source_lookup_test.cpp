@@ -50,6 +50,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo {
 namespace {
@@ -1000,6 +1001,111 @@ TEST_F(DocumentSourceLookUpTest, LookupReportsFieldsModifiedByAbsorbedUnwind) {
     lookup->dispose();
 }
 
+/**
+ * Runs a localField/foreignField $lookup from 'localField' to 'foreignField' over 'localDocs'
+ * against the foreign collection 'foreignDocs' and returns the looked up documents.
+ */
+std::vector<Document> runLocalFieldForeignFieldLookup(
+    const boost::intrusive_ptr<ExpressionContextForTest>& expCtx,
+    std::deque<DocumentSource::GetNextResult> localDocs,
+    std::deque<DocumentSource::GetNextResult> foreignDocs,
+    bool removeLeadingQueryStages) {
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(foreignDocs), removeLeadingQueryStages);
+
+    auto mockLocalSource = DocumentSourceMock::createForTest(std::move(localDocs), expCtx);
+    auto docSource = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {from: 'foreign', localField: 'a', foreignField: 'b', as: 'as'}}")
+            .firstElement(),
+        expCtx);
+    docSource->setSource(mockLocalSource.get());
+
+    std::vector<Document> results;
+    for (auto next = docSource->getNext(); next.isAdvanced(); next = docSource->getNext()) {
+        results.push_back(next.releaseDocument());
+    }
+    docSource->dispose();
+    return results;
+}
+
+TEST_F(DocumentSourceLookUpTest, LocalFieldForeignFieldJoinProbesHashTable) {
+    RAIIServerParameterControllerForTest minLocalDocs{
+        "internalDocumentSourceLookupHashJoinMinLocalDocuments", 0};
+
+    // The mock ignores the join predicate, so any document joined using a sub-pipeline rather than
+    // the hash table would be matched with the entire foreign collection.
+    Document foreign0 = DOC("_id" << 0 << "b" << 1);
+    Document foreign1 = DOC("_id" << 1 << "b" << DOC_ARRAY(1 << 5));
+    Document foreign2 = DOC("_id" << 2 << "b" << 2);
+    auto results = runLocalFieldForeignFieldLookup(
+        getExpCtx(),
+        {DOC("a" << 1),
+         DOC("a" << DOC_ARRAY(1 << 5)),
+         DOC("a" << DOC_ARRAY(2 << 3)),
+         DOC("a" << 7)},
+        {Document(foreign0), Document(foreign1), Document(foreign2), Document{{"_id", 3}}},
+        true /* removeLeadingQueryStages */);
+
+    ASSERT_EQ(results.size(), 4U);
+    ASSERT_VALUE_EQ(results[0]["as"], Value(DOC_ARRAY(foreign0 << foreign1)));
+    ASSERT_VALUE_EQ(results[1]["as"], Value(DOC_ARRAY(foreign0 << foreign1)));
+    ASSERT_VALUE_EQ(results[2]["as"], Value(DOC_ARRAY(foreign2)));
+    ASSERT_VALUE_EQ(results[3]["as"], Value(std::vector<Value>{}));
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinMatchesArraysAsWholeValues) {
+    RAIIServerParameterControllerForTest minLocalDocs{
+        "internalDocumentSourceLookupHashJoinMinLocalDocuments", 0};
+
+    auto results = runLocalFieldForeignFieldLookup(
+        getExpCtx(),
+        {DOC("a" << DOC_ARRAY(DOC_ARRAY(1 << 5)))},
+        {DOC("_id" << 0 << "b" << 1), DOC("_id" << 1 << "b" << DOC_ARRAY(1 << 5))},
+        true /* removeLeadingQueryStages */);
+
+    ASSERT_EQ(results.size(), 1U);
+    ASSERT_VALUE_EQ(results[0]["as"],
+                    Value(DOC_ARRAY(DOC("_id" << 1 << "b" << DOC_ARRAY(1 << 5)))));
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinUsesSubPipelineForNullishLocalValues) {
+    RAIIServerParameterControllerForTest minLocalDocs{
+        "internalDocumentSourceLookupHashJoinMinLocalDocuments", 0};
+
+    auto results = runLocalFieldForeignFieldLookup(
+        getExpCtx(),
+        {DOC("a" << BSONNULL), Document(), DOC("a" << 2)},
+        {DOC("_id" << 0 << "b" << 1), DOC("_id" << 1 << "b" << BSONNULL), DOC("_id" << 2)},
+        false /* removeLeadingQueryStages */);
+
+    ASSERT_EQ(results.size(), 3U);
+    auto nullMatches = Value(DOC_ARRAY(DOC("_id" << 1 << "b" << BSONNULL) << DOC("_id" << 2)));
+    ASSERT_VALUE_EQ(results[0]["as"], nullMatches);
+    ASSERT_VALUE_EQ(results[1]["as"], nullMatches);
+    ASSERT_VALUE_EQ(results[2]["as"], Value(std::vector<Value>{}));
+}
+
+TEST_F(DocumentSourceLookUpTest, HashJoinIsAbandonedWhenForeignCollectionExceedsMemoryLimit) {
+    RAIIServerParameterControllerForTest minLocalDocs{
+        "internalDocumentSourceLookupHashJoinMinLocalDocuments", 0};
+    RAIIServerParameterControllerForTest maxMemory{
+        "internalDocumentSourceLookupHashJoinMaxMemoryBytes", 1};
+
+    // Every document is joined using a sub-pipeline, so the mock returns the entire foreign
+    // collection for each of them.
+    auto results = runLocalFieldForeignFieldLookup(getExpCtx(),
+                                                   {DOC("a" << 1), DOC("a" << 2)},
+                                                   {DOC("_id" << 0 << "b" << 1)},
+                                                   true /* removeLeadingQueryStages */);
+
+    ASSERT_EQ(results.size(), 2U);
+    ASSERT_VALUE_EQ(results[0]["as"], Value(DOC_ARRAY(DOC("_id" << 0 << "b" << 1))));
+    ASSERT_VALUE_EQ(results[1]["as"], Value(DOC_ARRAY(DOC("_id" << 0 << "b" << 1))));
+}
+
 BSONObj sequentialCacheStageObj(const StringData status = "kBuilding"_sd,
                                 const long long maxSizeBytes = kDefaultMaxCacheSize) {
     return BSON("$sequentialCache" << BSON("maxSizeBytes" << maxSizeBytes << "status" << status));
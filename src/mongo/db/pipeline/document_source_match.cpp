@@ -82,6 +82,7 @@ intrusive_ptr<DocumentSource> DocumentSourceMatch::optimize() {
     }
 
     _expression = MatchExpression::optimize(std::move(_expression));
+    _compiledExpression.reset();
 
     return this;
 }
@@ -90,6 +91,10 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
     // The user facing error should have been generated earlier.
     massert(17309, "Should never call getNext on a $match stage with $text clause", !_isTextQuery);
 
+    if (!_compiledExpression) {
+        _compiledExpression = std::make_unique<CompiledMatchExpression>(_expression.get());
+    }
+
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
         // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
@@ -99,7 +104,7 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
             : document_path_support::documentToBsonWithPaths(nextInput.getDocument(),
                                                              _dependencies.fields);
 
-        if (_expression->matchesBSON(toMatch)) {
+        if (_compiledExpression->matchesBSON(toMatch)) {
             return nextInput;
         }
 
@@ -427,6 +432,7 @@ DocumentSourceMatch::splitSourceByFunc(const std::set<std::string>& fields,
                                        expression::ShouldSplitExprFunc func) && {
     pair<unique_ptr<MatchExpression>, unique_ptr<MatchExpression>> newExpr(
         expression::splitMatchExpressionBy(std::move(_expression), fields, renames, func));
+    _compiledExpression.reset();
 
     invariant(newExpr.first || newExpr.second);
 
@@ -575,6 +581,7 @@ DocumentSourceMatch::DocumentSourceMatch(const BSONObj& query,
 
 void DocumentSourceMatch::rebuild(BSONObj filter) {
     _predicate = filter.getOwned();
+    _compiledExpression.reset();
     _expression = uassertStatusOK(MatchExpressionParser::parse(
         _predicate, pExpCtx, ExtensionsCallbackNoop(), Pipeline::kAllowedMatcherFeatures));
     _isTextQuery = isTextQuery(_predicate);
@@ -147,25 +147,26 @@ void DocumentSourceOut::initialize() {
             LOGV2(20901,
                   "Hanging aggregation due to 'outWaitAfterTempCollectionCreation' failpoint");
         });
-    if (_originalIndexes.empty()) {
-        return;
-    }
-
-    // Copy the indexes of the output collection to the temp collection.
-    try {
-        std::vector<BSONObj> tempNsIndexes = {std::begin(_originalIndexes),
-                                              std::end(_originalIndexes)};
-        pExpCtx->mongoProcessInterface->createIndexesOnEmptyCollection(
-            pExpCtx->opCtx, _tempNs, tempNsIndexes);
-    } catch (DBException& ex) {
-        ex.addContext("Copying indexes for $out failed");
-        throw;
-    }
 }
 
 void DocumentSourceOut::finalize() {
     DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
 
+    // Copy the indexes of the output collection to the temp collection. They are built only now
+    // that all the results have been inserted, since building an index over existing documents
+    // is much cheaper than maintaining it on every insert.
+    if (!_originalIndexes.empty()) {
+        try {
+            std::vector<BSONObj> tempNsIndexes = {std::begin(_originalIndexes),
+                                                  std::end(_originalIndexes)};
+            pExpCtx->mongoProcessInterface->createIndexesOnPopulatedCollection(
+                pExpCtx->opCtx, _tempNs, tempNsIndexes);
+        } catch (DBException& ex) {
+            ex.addContext("Copying indexes for $out failed");
+            throw;
+        }
+    }
+
     const auto& outputNs = getOutputNs();
     auto renameCommandObj =
         BSON("renameCollection" << _tempNs.ns() << "to" << outputNs.ns() << "dropTarget" << true);
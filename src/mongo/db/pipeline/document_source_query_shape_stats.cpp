@@ -0,0 +1,118 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_query_shape_stats.h"
+
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/stats/query_shape_stats.h"
+#include "mongo/util/hex.h"
+#include "mongo/util/net/socket_utils.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_DOCUMENT_SOURCE(queryShapeStats,
+                         DocumentSourceQueryShapeStats::LiteParsed::parse,
+                         DocumentSourceQueryShapeStats::createFromBson,
+                         AllowedWithApiStrict::kNeverInVersion1);
+
+const char* DocumentSourceQueryShapeStats::getSourceName() const {
+    return kStageName.rawData();
+}
+
+namespace {
+static constexpr StringData kClearStats = "clearStats"_sd;
+static constexpr StringData kQueryHashFieldName = "queryHash"_sd;
+static constexpr StringData kHostFieldName = "host"_sd;
+static constexpr StringData kLocalTimeFieldName = "localTime"_sd;
+}  // namespace
+
+DocumentSource::GetNextResult DocumentSourceQueryShapeStats::doGetNext() {
+    if (!_statsFetched) {
+        auto& queryShapeStats = QueryShapeStats::get(pExpCtx->opCtx);
+        auto stats = _clearStats ? queryShapeStats.getAndClearStats() : queryShapeStats.getStats();
+
+        // The host is included so that the statistics of several nodes can be told apart, and
+        // merged, when the stage runs through mongos.
+        auto host = getHostNameCachedAndPort();
+        auto localTime = jsTime();
+        for (auto&& [queryHash, entry] : stats) {
+            BSONObjBuilder builder;
+            builder.append(kQueryHashFieldName, zeroPaddedHex(queryHash));
+            builder.append(kHostFieldName, host);
+            builder.appendDate(kLocalTimeFieldName, localTime);
+            entry.append(&builder);
+            _queryShapeStats.push_back(builder.obj());
+        }
+
+        _queryShapeStatsIter = _queryShapeStats.begin();
+        _statsFetched = true;
+    }
+
+    if (_queryShapeStatsIter != _queryShapeStats.end()) {
+        auto doc = Document(std::move(*_queryShapeStatsIter));
+        _queryShapeStatsIter++;
+        return doc;
+    }
+
+    return GetNextResult::makeEOF();
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceQueryShapeStats::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    const NamespaceString& nss = pExpCtx->ns;
+    uassert(ErrorCodes::InvalidNamespace,
+            "$queryShapeStats must be run against the 'admin' database with {aggregate: 1}",
+            nss.db() == NamespaceString::kAdminDb && nss.isCollectionlessAggregateNS());
+
+    uassert(ErrorCodes::BadValue,
+            "The $queryShapeStats stage specification must be an object",
+            elem.type() == Object);
+
+    auto stageObj = elem.Obj();
+    bool clearStats = false;
+    if (auto clearElem = stageObj.getField(kClearStats); !clearElem.eoo()) {
+        clearStats = clearElem.trueValue();
+    } else if (!stageObj.isEmpty()) {
+        uasserted(
+            ErrorCodes::BadValue,
+            "The $queryShapeStats stage specification must be empty or contain valid options");
+    }
+    return new DocumentSourceQueryShapeStats(pExpCtx, clearStats);
+}
+
+Value DocumentSourceQueryShapeStats::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    return Value(DOC(getSourceName() << (_clearStats ? DOC(kClearStats << true) : Document())));
+}
+}  // namespace mongo
@@ -31,12 +31,16 @@
 
 #include "mongo/db/pipeline/document_source_sample.h"
 
+#include <cmath>
+#include <limits>
+
 #include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 using boost::intrusive_ptr;
@@ -51,15 +55,31 @@ REGISTER_DOCUMENT_SOURCE(sample,
                          DocumentSourceSample::createFromBson,
                          AllowedWithApiStrict::kAlways);
 
+namespace {
+
+/**
+ * Returns a uniformly distributed random value in (0, 1].
+ */
+double nextUniform(PseudoRandom& prng) {
+    return 1.0 - prng.nextCanonicalDouble();
+}
+
+}  // namespace
+
 DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
     if (_size == 0)
         return GetNextResult::makeEOF();
 
     if (!_sortStage->isPopulated()) {
-        // Exhaust source stage, add random metadata, and push all into sorter.
+        // Exhaust source stage, keeping a uniform sample of the input in the reservoir. Once the
+        // reservoir has been flushed, the input is pushed into the sorter with random metadata.
         PseudoRandom& prng = pExpCtx->opCtx->getClient()->getPrng();
         auto nextInput = pSource->getNext();
         for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
+            if (!_reservoirFlushed) {
+                addToReservoir(nextInput.releaseDocument(), prng);
+                continue;
+            }
             MutableDocument doc(nextInput.releaseDocument());
             doc.metadata().setRandVal(prng.nextCanonicalDouble());
             _sortStage->loadDocument(doc.freeze());
@@ -72,6 +92,9 @@ DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
                 return nextInput;  // Propagate the pause.
             }
             case GetNextResult::ReturnStatus::kEOF: {
+                if (!_reservoirFlushed) {
+                    flushReservoir(prng);
+                }
                 _sortStage->loadingDone();
             }
         }
@@ -81,6 +104,64 @@ DocumentSource::GetNextResult DocumentSourceSample::doGetNext() {
     return _sortStage->getNext();
 }
 
+void DocumentSourceSample::addToReservoir(Document&& doc, PseudoRandom& prng) {
+    ++_numSeen;
+
+    auto drawNextAdmittedPosition = [&] {
+        _weight *= std::exp(std::log(nextUniform(prng)) / _size);
+        double gap = std::floor(std::log(nextUniform(prng)) / std::log1p(-_weight));
+        _nextAdmittedPosition = gap < static_cast<double>(std::numeric_limits<long long>::max() / 2)
+            ? _numSeen + static_cast<long long>(gap) + 1
+            : std::numeric_limits<long long>::max();
+    };
+
+    if (static_cast<long long>(_reservoir.size()) < _size) {
+        _reservoirBytes += doc.getApproximateSize();
+        _reservoir.push_back(std::move(doc));
+        if (static_cast<long long>(_reservoir.size()) == _size) {
+            _weight = 1.0;
+            drawNextAdmittedPosition();
+        }
+    } else if (_numSeen == _nextAdmittedPosition) {
+        auto& replaced = _reservoir[prng.nextInt64(_size)];
+        _reservoirBytes -= replaced.getApproximateSize();
+        _reservoirBytes += doc.getApproximateSize();
+        replaced = std::move(doc);
+        drawNextAdmittedPosition();
+    }
+
+    if (_reservoirBytes > _maxReservoirBytes) {
+        flushReservoir(prng);
+    }
+}
+
+void DocumentSourceSample::flushReservoir(PseudoRandom& prng) {
+    // A top-k sort on random values would hold the documents with the largest of '_numSeen'
+    // uniformly distributed random values, which are a uniform sample of the input like those of
+    // the reservoir. Draw these largest values from the highest one down, and assign them to the
+    // documents of the reservoir in random order.
+    std::vector<double> randVals;
+    randVals.reserve(_reservoir.size());
+    double randVal = 1.0;
+    for (size_t i = 0; i < _reservoir.size(); ++i) {
+        randVal *= std::pow(nextUniform(prng), 1.0 / static_cast<double>(_numSeen - i));
+        randVals.push_back(randVal);
+    }
+    for (size_t i = randVals.size(); i > 1; --i) {
+        std::swap(randVals[i - 1], randVals[prng.nextInt64(i)]);
+    }
+
+    for (size_t i = 0; i < _reservoir.size(); ++i) {
+        MutableDocument doc(std::move(_reservoir[i]));
+        doc.metadata().setRandVal(randVals[i]);
+        _sortStage->loadDocument(doc.freeze());
+    }
+    _reservoir.clear();
+    _reservoir.shrink_to_fit();
+    _reservoirBytes = 0;
+    _reservoirFlushed = true;
+}
+
 Value DocumentSourceSample::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     return Value(DOC(kStageName << DOC("size" << _size)));
 }
@@ -119,6 +200,8 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceSample::create(
     intrusive_ptr<DocumentSourceSample> sample(new DocumentSourceSample(expCtx));
     sample->_size = size;
     sample->_sortStage = DocumentSourceSort::create(expCtx, {randSortSpec, expCtx}, sample->_size);
+    sample->_maxReservoirBytes =
+        static_cast<size_t>(internalQueryMaxBlockingSortMemoryUsageBytes.load());
     return sample;
 }
 
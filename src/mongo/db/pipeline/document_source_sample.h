@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 
@@ -76,10 +78,41 @@ private:
 
     GetNextResult doGetNext() final;
 
+    /**
+     * Offers the next input document to the reservoir, following Algorithm L: once the reservoir
+     * is full, the number of documents skipped before the next one replaces a random member of the
+     * reservoir is drawn directly, so that only the admitted documents require random draws.
+     */
+    void addToReservoir(Document&& doc, PseudoRandom& prng);
+
+    /**
+     * Moves the documents of the reservoir into '_sortStage'. The documents are given the random
+     * values they would have had if every document seen so far had been loaded into the sort
+     * stage, so that further documents can be loaded into it directly and so that the output can
+     * be merged with that of other shards.
+     */
+    void flushReservoir(PseudoRandom& prng);
+
     long long _size;
 
     // Uses a $sort stage to randomly sort the documents.
     boost::intrusive_ptr<DocumentSourceSort> _sortStage;
+
+    // A uniform sample of at most '_size' of the input documents seen so far. Documents are loaded
+    // into '_sortStage' directly once the reservoir has been flushed, which happens early if it
+    // exceeds the memory limit of blocking sorts.
+    std::vector<Document> _reservoir;
+    size_t _reservoirBytes = 0;
+    size_t _maxReservoirBytes = 0;
+    bool _reservoirFlushed = false;
+
+    // The number of input documents offered to the reservoir.
+    long long _numSeen = 0;
+
+    // The position among the input documents of the next one to enter the full reservoir, and the
+    // weight 'W' of Algorithm L from which the gap to the one after is drawn.
+    long long _nextAdmittedPosition = 0;
+    double _weight = 0;
 };
 
 }  // namespace mongo
@@ -31,6 +31,8 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <memory>
+#include <set>
+#include <vector>
 
 #include "mongo/bson/bsonelement.h"
 #include "mongo/bson/bsonobj.h"
@@ -41,7 +43,9 @@
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/tick_source_mock.h"
@@ -188,6 +192,62 @@ TEST_F(SampleBasics, ShouldPropagatePauses) {
     assertEOF();
 }
 
+/**
+ * Every input document should be equally likely to be part of the sample, wherever it is in the
+ * input.
+ */
+TEST_F(SampleBasics, ShouldSampleDocumentsUniformly) {
+    const int nDocs = 20;
+    const int nTrials = 4000;
+    std::vector<int> timesSampled(nDocs, 0);
+    for (int trial = 0; trial < nTrials; ++trial) {
+        _mock = DocumentSourceMock::createForTest(getExpCtx());
+        loadDocuments(nDocs);
+        createSample(5);
+        for (auto next = sample()->getNext(); next.isAdvanced(); next = sample()->getNext()) {
+            ++timesSampled[next.getDocument()["_id"].getInt()];
+        }
+    }
+
+    // Each document is expected to be sampled 1000 times, with a standard deviation of about 27.
+    for (int i = 0; i < nDocs; ++i) {
+        ASSERT_GT(timesSampled[i], 800) << "document " << i;
+        ASSERT_LT(timesSampled[i], 1200) << "document " << i;
+    }
+}
+
+/**
+ * A reservoir which exceeds the memory limit should be moved into a sort on random values, which
+ * spills to disk.
+ */
+TEST_F(SampleBasics, ShouldSortOnRandomValuesIfReservoirExceedsMemoryLimit) {
+    RAIIServerParameterControllerForTest maxMemory{"internalQueryMaxBlockingSortMemoryUsageBytes",
+                                                   1000};
+    unittest::TempDir tempDir("DocumentSourceSampleTest");
+    getExpCtx()->tempDir = tempDir.path();
+    getExpCtx()->allowDiskUse = true;
+
+    const std::string largeStr(200, 'x');
+    for (int i = 0; i < 100; ++i) {
+        _mock->push_back(DOC("_id" << i << "largeStr" << largeStr));
+    }
+    createSample(20);
+
+    std::set<int> sampledIds;
+    boost::optional<double> prevRandVal;
+    for (int i = 0; i < 20; ++i) {
+        auto next = sample()->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        auto doc = next.releaseDocument();
+        ASSERT_TRUE(sampledIds.insert(doc["_id"].getInt()).second);
+        if (prevRandVal) {
+            ASSERT_LTE(doc.metadata().getRandVal(), *prevRandVal);
+        }
+        prevRandVal = doc.metadata().getRandVal();
+    }
+    assertEOF();
+}
+
 /**
  * Fixture to test error cases of the $sample stage.
  */
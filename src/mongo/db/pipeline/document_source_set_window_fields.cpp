@@ -33,12 +33,15 @@
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_project.h"
+#include "mongo/db/pipeline/document_source_queue.h"
 #include "mongo/db/pipeline/document_source_set_window_fields.h"
 #include "mongo/db/pipeline/document_source_set_window_fields_gen.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sort_pattern.h"
+#include "mongo/db/worker_pool.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/visit_helper.h"
 
 using boost::intrusive_ptr;
@@ -50,6 +53,28 @@ namespace mongo {
 
 namespace {
 
+// Evaluates the partitions of the $setWindowFields stages which run concurrently.
+const WorkerPool setWindowFieldsWorkers("SetWindowFields", 64);
+
+// The maximum number of partitions given to each evaluator in one batch of concurrent evaluation.
+constexpr size_t kMaxPartitionsPerEvaluator = 32;
+
+/**
+ * Returns the documents loaded into the queue, followed by those of its source if it has one.
+ */
+class DocumentSourceQueueThenSource final : public DocumentSourceQueue {
+public:
+    using DocumentSourceQueue::DocumentSourceQueue;
+
+protected:
+    GetNextResult doGetNext() final {
+        if (!_queue.empty() || !pSource) {
+            return DocumentSourceQueue::doGetNext();
+        }
+        return pSource->getNext();
+    }
+};
+
 /**
  * Does a sort pattern contain a path that has been modified?
  */
@@ -430,11 +455,198 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalSetWindowFields::doOpt
     return std::prev(itr);
 }
 
+bool DocumentSourceInternalSetWindowFields::canEvaluatePartitionsConcurrently() const {
+    return _partitionBy && internalDocumentSourceSetWindowFieldsMaxConcurrency.load() > 1 &&
+        !pExpCtx->inMongos && pExpCtx->subPipelineDepth == 0;
+}
+
+void DocumentSourceInternalSetWindowFields::fallBackToSequentialEvaluation(
+    std::vector<Document> bufferedDocs) {
+    std::deque<GetNextResult> queue;
+    for (auto&& doc : bufferedDocs) {
+        queue.emplace_back(std::move(doc));
+    }
+    auto replaySource = make_intrusive<DocumentSourceQueueThenSource>(std::move(queue), pExpCtx);
+    if (!_inputExhausted) {
+        replaySource->setSource(pSource);
+    }
+    _replaySource = std::move(replaySource);
+    _iterator.setSource(_replaySource.get());
+
+    _evaluationMode = EvaluationMode::kSequential;
+    _evaluators.clear();
+    _pendingPartition.clear();
+    _pendingPartitionBytes = 0;
+}
+
+std::vector<Document> DocumentSourceInternalSetWindowFields::evaluatePartition(
+    const PartitionEvaluator& evaluator, const std::vector<Document>& partition) const {
+    auto stage = make_intrusive<DocumentSourceInternalSetWindowFields>(
+        evaluator.expCtx,
+        evaluator.stage->_partitionBy,
+        evaluator.stage->_sortBy,
+        evaluator.stage->_outputFields,
+        _memoryTracker._maxAllowedMemoryUsageBytes);
+    stage->_evaluationMode = EvaluationMode::kSequential;
+
+    std::deque<GetNextResult> queue;
+    for (auto&& doc : partition) {
+        queue.emplace_back(Document(doc));
+    }
+    auto source = make_intrusive<DocumentSourceQueue>(std::move(queue), evaluator.expCtx);
+    stage->setSource(source.get());
+
+    std::vector<Document> results;
+    results.reserve(partition.size());
+    for (auto next = stage->getNext(); next.isAdvanced(); next = stage->getNext()) {
+        results.push_back(next.releaseDocument());
+    }
+    return results;
+}
+
+void DocumentSourceInternalSetWindowFields::evaluateNextBatchConcurrently() {
+    const size_t maxMemoryBytes = _memoryTracker._maxAllowedMemoryUsageBytes;
+
+    if (_evaluators.empty()) {
+        // Each evaluator parses its own copy of this stage, since evaluating expressions modifies
+        // the variables of their ExpressionContext. The evaluators cannot spill, as they do not run
+        // on the operation executing the query.
+        const auto spec = serialize(boost::none).getDocument().toBson();
+        const auto numEvaluators =
+            static_cast<size_t>(internalDocumentSourceSetWindowFieldsMaxConcurrency.load());
+        for (size_t i = 0; i < numEvaluators; ++i) {
+            auto expCtx = pExpCtx->copyWith(pExpCtx->ns);
+            expCtx->allowDiskUse = false;
+            auto stage = createFromBson(spec.firstElement(), expCtx)->optimize();
+            _evaluators.push_back(
+                {expCtx, static_cast<DocumentSourceInternalSetWindowFields*>(stage.get())});
+        }
+    }
+
+    // Read complete partitions until the batch is full or holds as much data as the memory limit
+    // allows. The input is sorted by the partition key, so a partition is complete once a document
+    // with another key, or the end of the input, is reached.
+    std::vector<std::vector<Document>> partitions;
+    size_t bufferedBytes = _pendingPartitionBytes;
+    const size_t maxPartitions = _evaluators.size() * kMaxPartitionsPerEvaluator;
+    while (!_inputExhausted && partitions.size() < maxPartitions &&
+           bufferedBytes <= maxMemoryBytes) {
+        auto next = pSource->getNext();
+        if (next.isEOF()) {
+            _inputExhausted = true;
+            break;
+        }
+        if (!next.isAdvanced()) {
+            continue;
+        }
+
+        auto doc = next.releaseDocument();
+        doc.fillCache();
+        if (!_partitionComparator) {
+            _partitionComparator.emplace(pExpCtx.get(), *_partitionBy, doc);
+        } else if (_partitionComparator->isDocumentNewPartition(doc)) {
+            partitions.push_back(std::exchange(_pendingPartition, {}));
+            _pendingPartitionBytes = 0;
+        }
+        const auto docBytes = doc.getApproximateSize();
+        _pendingPartitionBytes += docBytes;
+        bufferedBytes += docBytes;
+        _pendingPartition.push_back(std::move(doc));
+    }
+
+    if (_inputExhausted && !_pendingPartition.empty()) {
+        partitions.push_back(std::exchange(_pendingPartition, {}));
+        _pendingPartitionBytes = 0;
+    }
+
+    if (partitions.empty()) {
+        if (!_pendingPartition.empty()) {
+            // A single partition exceeds the memory limit, so it has to be streamed through
+            // '_iterator', which can spill.
+            fallBackToSequentialEvaluation(std::exchange(_pendingPartition, {}));
+        }
+        return;
+    }
+
+    // Give each partition to the evaluator with the fewest documents so far.
+    std::vector<std::vector<size_t>> assignments(_evaluators.size());
+    std::vector<size_t> numAssignedDocs(_evaluators.size(), 0);
+    for (size_t partitionId = 0; partitionId < partitions.size(); ++partitionId) {
+        auto evaluatorId =
+            std::distance(numAssignedDocs.begin(),
+                          std::min_element(numAssignedDocs.begin(), numAssignedDocs.end()));
+        assignments[evaluatorId].push_back(partitionId);
+        numAssignedDocs[evaluatorId] += partitions[partitionId].size();
+    }
+
+    // Every partition has its own slot, which keeps the output in input order.
+    std::vector<std::vector<Document>> outputs(partitions.size());
+    auto runEvaluator = [&](size_t evaluatorId) {
+        for (auto partitionId : assignments[evaluatorId]) {
+            outputs[partitionId] =
+                evaluatePartition(_evaluators[evaluatorId], partitions[partitionId]);
+        }
+    };
+
+    // Ties go to the lowest evaluator, so the evaluators given any partitions form a prefix.
+    const size_t numEvaluatorsUsed = std::distance(
+        assignments.begin(),
+        std::find_if(assignments.begin(), assignments.end(), [](auto&& assigned) {
+            return assigned.empty();
+        }));
+    auto status = setWindowFieldsWorkers.runTasks(
+        pExpCtx->opCtx, numEvaluatorsUsed, [&](OperationContext* opCtx, size_t evaluatorId) {
+            auto& evaluatorExpCtx = _evaluators[evaluatorId].expCtx;
+            evaluatorExpCtx->opCtx = opCtx;
+            ON_BLOCK_EXIT([&] {
+                if (evaluatorId > 0) {
+                    evaluatorExpCtx->opCtx = nullptr;
+                }
+            });
+            runEvaluator(evaluatorId);
+        });
+
+    if (status.code() == 5414201 && _memoryTracker._allowDiskUse) {
+        // A partition needs more memory than the evaluators may use, so evaluate the whole batch
+        // again on this thread, where spilling is possible.
+        std::vector<Document> bufferedDocs;
+        for (auto&& partition : partitions) {
+            std::move(partition.begin(), partition.end(), std::back_inserter(bufferedDocs));
+        }
+        std::move(
+            _pendingPartition.begin(), _pendingPartition.end(), std::back_inserter(bufferedDocs));
+        fallBackToSequentialEvaluation(std::move(bufferedDocs));
+        return;
+    }
+    uassertStatusOK(status);
+
+    for (auto&& output : outputs) {
+        std::move(output.begin(), output.end(), std::back_inserter(_concurrentResults));
+    }
+}
+
 DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext() {
     if (!_init) {
         initialize();
     }
 
+    if (_evaluationMode == EvaluationMode::kUndecided) {
+        _evaluationMode = canEvaluatePartitionsConcurrently() ? EvaluationMode::kConcurrent
+                                                              : EvaluationMode::kSequential;
+    }
+
+    while (_evaluationMode == EvaluationMode::kConcurrent) {
+        if (!_concurrentResults.empty()) {
+            auto next = std::move(_concurrentResults.front());
+            _concurrentResults.pop_front();
+            return std::move(next);
+        }
+        if (_inputExhausted && _pendingPartition.empty()) {
+            return DocumentSource::GetNextResult::makeEOF();
+        }
+        evaluateNextBatchConcurrently();
+    }
+
     if (_eof)
         return DocumentSource::GetNextResult::makeEOF();
 
@@ -457,14 +669,16 @@ DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext()
             throw;
         }
 
-        if (_memoryTracker.currentMemoryBytes() >=
-                static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes) &&
+        if ((_memoryTracker.currentMemoryBytes() >=
+                 static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes) ||
+             _memoryTracker.exceedsSharedMemoryBudget()) &&
             _memoryTracker._allowDiskUse) {
             // Attempt to spill where possible.
             _iterator.spillToDisk();
         }
         if (_memoryTracker.currentMemoryBytes() >
-            static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes)) {
+                static_cast<long long>(_memoryTracker._maxAllowedMemoryUsageBytes) ||
+            (!_memoryTracker._allowDiskUse && _memoryTracker.exceedsSharedMemoryBudget())) {
             _iterator.finalize();
             uasserted(5414201,
                       str::stream()
@@ -35,6 +35,7 @@
 #include "mongo/db/pipeline/document_source_set_window_fields_gen.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/memory_usage_tracker.h"
+#include "mongo/db/pipeline/partition_key_comparator.h"
 #include "mongo/db/pipeline/window_function/partition_iterator.h"
 #include "mongo/db/pipeline/window_function/window_bounds.h"
 #include "mongo/db/pipeline/window_function/window_function_exec.h"
@@ -145,7 +146,8 @@ public:
           _partitionBy(partitionBy),
           _sortBy(std::move(sortBy)),
           _outputFields(std::move(outputFields)),
-          _memoryTracker{expCtx->allowDiskUse, maxMemoryBytes},
+          _memoryTracker{
+              expCtx->allowDiskUse, maxMemoryBytes, expCtx->getOperationMemoryTracker()},
           _iterator(expCtx.get(), pSource, &_memoryTracker, std::move(partitionBy), _sortBy){};
 
     GetModPathsReturn getModifiedPaths() const final {
@@ -207,7 +209,11 @@ public:
 
     void setSource(DocumentSource* source) final {
         pSource = source;
-        _iterator.setSource(source);
+        if (!_replaySource) {
+            _iterator.setSource(source);
+        } else {
+            _replaySource->setSource(source);
+        }
     }
 
     bool usedDisk() final {
@@ -215,8 +221,43 @@ public:
     };
 
 private:
+    // A copy of this stage, parsed with its own ExpressionContext, which evaluates whole partitions
+    // on one thread.
+    struct PartitionEvaluator {
+        boost::intrusive_ptr<ExpressionContext> expCtx;
+        boost::intrusive_ptr<DocumentSourceInternalSetWindowFields> stage;
+    };
+
     void initialize();
 
+    /**
+     * Returns true if whole partitions may be handed to the window function thread pool. This
+     * requires a partitionBy expression, since the input is then sorted by the partition key and
+     * the partitions are independent of each other.
+     */
+    bool canEvaluatePartitionsConcurrently() const;
+
+    /**
+     * Reads the next batch of complete partitions from 'pSource', evaluates them concurrently and
+     * appends their results, in input order, to '_concurrentResults'. Switches to sequential
+     * evaluation if a single partition does not fit in memory, or if a partition exceeded the
+     * memory limit while being evaluated and disk use is allowed.
+     */
+    void evaluateNextBatchConcurrently();
+
+    /**
+     * Evaluates the window functions over the whole of 'partition' using 'evaluator', returning
+     * the output documents in order.
+     */
+    std::vector<Document> evaluatePartition(const PartitionEvaluator& evaluator,
+                                            const std::vector<Document>& partition) const;
+
+    /**
+     * Makes '_iterator' read 'bufferedDocs' before continuing with the remaining input, and
+     * evaluates the rest of the input sequentially.
+     */
+    void fallBackToSequentialEvaluation(std::vector<Document> bufferedDocs);
+
     boost::optional<boost::intrusive_ptr<Expression>> _partitionBy;
     boost::optional<SortPattern> _sortBy;
     std::vector<WindowFunctionStatement> _outputFields;
@@ -225,6 +266,21 @@ private:
     StringMap<std::unique_ptr<WindowFunctionExec>> _executableOutputs;
     bool _init = false;
     bool _eof = false;
+
+    // State used when whole partitions are evaluated concurrently. The partitions of a batch are
+    // spread over '_evaluators', the first of which runs on the thread executing the query.
+    enum class EvaluationMode { kUndecided, kConcurrent, kSequential };
+    EvaluationMode _evaluationMode = EvaluationMode::kUndecided;
+    std::vector<PartitionEvaluator> _evaluators;
+    boost::optional<PartitionKeyComparator> _partitionComparator;
+    // The documents read so far for the partition following the last complete one.
+    std::vector<Document> _pendingPartition;
+    size_t _pendingPartitionBytes = 0;
+    bool _inputExhausted = false;
+    std::deque<Document> _concurrentResults;
+    // Replays to '_iterator' the documents read for concurrent evaluation which have not been
+    // evaluated, once the stage has fallen back to sequential evaluation.
+    boost::intrusive_ptr<DocumentSource> _replaySource;
 };
 
 }  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_set_window_fields.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -212,5 +213,93 @@ TEST_F(DocumentSourceSetWindowFieldsTest, ReportsModifiedFields) {
     ASSERT_EQUALS(modified.paths.count("b"), 1U);
     ASSERT_TRUE(modified.renames.empty());
 }
+
+TEST_F(DocumentSourceSetWindowFieldsTest, ApproximateWindowFunctionsUseNonRemovableWindows) {
+    auto spec = fromjson(R"(
+        {$_internalSetWindowFields: {partitionBy: '$state', sortBy: {city: 1}, output: {
+        distinctPops: {$approxCountDistinct: '$pop', window: {documents: ["unbounded", "current"]}},
+        medianPop: {$approxPercentile: {input: '$pop', p: 0.5}}}}})");
+    auto stage =
+        DocumentSourceInternalSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    std::vector<Value> serializedArray;
+    stage->serializeToArray(serializedArray);
+    ASSERT_BSONOBJ_EQ(serializedArray[0].getDocument().toBson(), fromjson(R"(
+        {$_internalSetWindowFields: {partitionBy: '$state', sortBy: {city: 1}, output: {
+        distinctPops: {$approxCountDistinct: '$pop',
+                       window: {documents: ["unbounded", "current"]}},
+        medianPop: {$approxPercentile: {input: '$pop', p: 0.5},
+                    window: {documents: ["unbounded", "unbounded"]}}}}})"));
+
+    auto mock = DocumentSourceMock::createForTest({"{state: 'CA', city: 'a', pop: 10}",
+                                                   "{state: 'CA', city: 'b', pop: 30}",
+                                                   "{state: 'CA', city: 'c', pop: 10}",
+                                                   "{state: 'NY', city: 'a', pop: 5}"},
+                                                  getExpCtx());
+    stage->setSource(mock.get());
+
+    std::vector<std::pair<long long, double>> expected{{1, 10}, {2, 10}, {2, 10}, {1, 5}};
+    for (auto&& [distinctPops, medianPop] : expected) {
+        auto next = stage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        auto doc = next.releaseDocument();
+        ASSERT_VALUE_EQ(doc["distinctPops"], Value(distinctPops));
+        ASSERT_VALUE_EQ(doc["medianPop"], Value(medianPop));
+    }
+    ASSERT_TRUE(stage->getNext().isEOF());
+
+    spec = fromjson(R"(
+        {$_internalSetWindowFields: {sortBy: {city: 1}, output: {
+        medianPop: {$approxPercentile: {input: '$pop', p: 0.5}, window: {documents: [-1, 1]}}}}})");
+    stage = DocumentSourceInternalSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+    mock = DocumentSourceMock::createForTest({"{city: 'a', pop: 10}"}, getExpCtx());
+    stage->setSource(mock.get());
+    ASSERT_THROWS_CODE(stage->getNext(), AssertionException, 5899609);
+}
+
+TEST_F(DocumentSourceSetWindowFieldsTest, ConcurrentEvaluationPreservesOrderAndResults) {
+    auto spec = fromjson(R"(
+        {$_internalSetWindowFields: {partitionBy: '$state', sortBy: {city: 1}, output: {
+        mySum: {$sum: '$pop', window: {documents: [-1, 1]}},
+        myRank: {$rank: {}},
+        myCities: {$push: '$city', window: {documents: ["unbounded", "current"]}}}}})");
+
+    // The input is sorted by partition key, as $setWindowFields expects.
+    std::deque<DocumentSource::GetNextResult> input;
+    for (int state = 0; state < 50; ++state) {
+        for (int city = 0; city < state % 7 + 1; ++city) {
+            input.emplace_back(Document{{"state", state}, {"city", city / 2}, {"pop", city * 10}});
+            if (city % 3 == 0) {
+                input.emplace_back(DocumentSource::GetNextResult::makePauseExecution());
+            }
+        }
+    }
+
+    auto runWithConcurrency = [&](int concurrency) {
+        RAIIServerParameterControllerForTest controller{
+            "internalDocumentSourceSetWindowFieldsMaxConcurrency", concurrency};
+        auto stage =
+            DocumentSourceInternalSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+        auto mock = DocumentSourceMock::createForTest(input, getExpCtx());
+        stage->setSource(mock.get());
+
+        std::vector<Document> results;
+        for (auto next = stage->getNext(); !next.isEOF(); next = stage->getNext()) {
+            if (next.isAdvanced()) {
+                results.push_back(next.releaseDocument());
+            }
+        }
+        return results;
+    };
+
+    const auto expected = runWithConcurrency(1);
+    ASSERT_EQ(expected.size(), 197U);
+    for (auto concurrency : {2, 3, 8}) {
+        const auto results = runWithConcurrency(concurrency);
+        ASSERT_EQ(results.size(), expected.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            ASSERT_DOCUMENT_EQ(results[i], expected[i]);
+        }
+    }
+}
 }  // namespace
 }  // namespace mongo
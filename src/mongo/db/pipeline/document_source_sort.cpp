@@ -38,6 +38,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/skip_and_limit.h"
@@ -147,9 +148,17 @@ Pipeline::SourceContainer::iterator DocumentSourceSort::doOptimizeAt(
 
     auto stageItr = std::next(itr);
     auto limit = extractLimitForPushdown(stageItr, container);
-    if (limit)
+    if (limit) {
         _sortExecutor->setLimit(*limit);
 
+        // A preceding $group may be able to discard the groups which cannot make the limit, so
+        // give it another chance to optimize now that the limit is known.
+        if (itr != container->begin() &&
+            dynamic_cast<DocumentSourceGroup*>(std::prev(itr)->get())) {
+            return std::prev(itr);
+        }
+    }
+
     auto nextStage = std::next(itr);
     if (nextStage == container->end()) {
         return container->end();
@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
 
@@ -196,6 +197,14 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     if (_executionState == ExecutionProgress::kIteratingSource) {
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
+            if (!_subPipelineAttached && !pExpCtx->explain &&
+                internalDocumentSourceUnionWithPrefetch.load()) {
+                // Start the sub-pipeline now so that remote shards can produce their first batch
+                // while we are still returning documents from 'pSource'. We wait for the first
+                // input so that stages such as $search have had a chance to set $$SEARCH_META.
+                attachSubPipelineCursor();
+                pExpCtx->mongoProcessInterface->prefetchRemoteResults(_pipeline.get());
+            }
             return nextInput;
         }
         _executionState = ExecutionProgress::kStartingSubPipeline;
@@ -204,28 +213,10 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kStartingSubPipeline) {
-        auto serializedPipe = _pipeline->serializeToBson();
-        logStartingSubPipeline(serializedPipe);
-        // $$SEARCH_META can be set during runtime earlier in the pipeline, and therefore must be
-        // copied to the subpipeline manually.
-        if (pExpCtx->variables.hasConstantValue(Variables::kSearchMetaId)) {
-            _pipeline->getContext()->variables.setReservedValue(
-                Variables::kSearchMetaId,
-                pExpCtx->variables.getValue(Variables::kSearchMetaId, Document()),
-                true);
-        }
-        try {
-            _pipeline =
-                pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
-            _executionState = ExecutionProgress::kIteratingSubPipeline;
-        } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
-            _pipeline = buildPipelineFromViewDefinition(
-                pExpCtx,
-                ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()},
-                serializedPipe);
-            logShardedViewFound(e);
-            return doGetNext();
+        if (!_subPipelineAttached) {
+            attachSubPipelineCursor();
         }
+        _executionState = ExecutionProgress::kIteratingSubPipeline;
     }
 
     // The $unionWith stage takes responsibility for disposing of its Pipeline. When the outer
@@ -244,6 +235,31 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     return GetNextResult::makeEOF();
 }
 
+void DocumentSourceUnionWith::attachSubPipelineCursor() {
+    auto serializedPipe = _pipeline->serializeToBson();
+    logStartingSubPipeline(serializedPipe);
+    // $$SEARCH_META can be set during runtime earlier in the pipeline, and therefore must be
+    // copied to the subpipeline manually.
+    if (pExpCtx->variables.hasConstantValue(Variables::kSearchMetaId)) {
+        _pipeline->getContext()->variables.setReservedValue(
+            Variables::kSearchMetaId,
+            pExpCtx->variables.getValue(Variables::kSearchMetaId, Document()),
+            true);
+    }
+    try {
+        _pipeline =
+            pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
+        _subPipelineAttached = true;
+    } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
+        _pipeline = buildPipelineFromViewDefinition(
+            pExpCtx,
+            ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()},
+            serializedPipe);
+        logShardedViewFound(e);
+        attachSubPipelineCursor();
+    }
+}
+
 // The use of these logging macros is done in separate NOINLINE functions to reduce the stack space
 // used on the hot getNext() path. This is done to avoid stack overflows.
 MONGO_COMPILER_NOINLINE void DocumentSourceUnionWith::logStartingSubPipeline(
@@ -170,6 +170,12 @@ private:
 
     void addViewDefinition(NamespaceString nss, std::vector<BSONObj> viewPipeline);
 
+    /**
+     * Attaches a cursor source to '_pipeline', rebuilding it from the view definition first if it
+     * turns out to read from a sharded view.
+     */
+    void attachSubPipelineCursor();
+
     void recordPlanSummaryStats(const Pipeline& pipeline);
 
     void logStartingSubPipeline(const std::vector<BSONObj>& serializedPipeline);
@@ -179,6 +185,9 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     Pipeline::SourceContainer _cachedPipeline;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
+    // Set once '_pipeline' has a cursor source. This normally happens when we start on the sub-
+    // pipeline, but may happen earlier when 'internalDocumentSourceUnionWithPrefetch' is enabled.
+    bool _subPipelineAttached = false;
     UnionWithStats _stats;
 };
 
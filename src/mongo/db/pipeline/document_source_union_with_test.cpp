@@ -49,6 +49,7 @@
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
 #include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -60,6 +61,38 @@ using MockMongoInterface = StubLookupSingleDocumentProcessInterface;
 // This provides access to getExpCtx(), but we'll use a different name for this test suite.
 using DocumentSourceUnionWithTest = AggregationContextFixture;
 
+/**
+ * Serves a mocked foreign pipeline and records when its cursor source is attached and when remote
+ * results are prefetched.
+ */
+class PrefetchRecordingInterface final : public StubMongoProcessInterface {
+public:
+    PrefetchRecordingInterface(std::deque<DocumentSource::GetNextResult> mockResults)
+        : _mockResults(std::move(mockResults)) {}
+
+    std::unique_ptr<Pipeline, PipelineDeleter> attachCursorSourceToPipeline(
+        Pipeline* ownedPipeline,
+        ShardTargetingPolicy shardTargetingPolicy = ShardTargetingPolicy::kAllowed,
+        boost::optional<BSONObj> readConcern = boost::none) final {
+        ++numAttached;
+        std::unique_ptr<Pipeline, PipelineDeleter> pipeline(
+            ownedPipeline, PipelineDeleter(ownedPipeline->getContext()->opCtx));
+        pipeline->addInitialSource(
+            DocumentSourceMock::createForTest(_mockResults, pipeline->getContext()));
+        return pipeline;
+    }
+
+    void prefetchRemoteResults(Pipeline* pipeline) final {
+        ++numPrefetched;
+    }
+
+    int numAttached = 0;
+    int numPrefetched = 0;
+
+private:
+    std::deque<DocumentSource::GetNextResult> _mockResults;
+};
+
 TEST_F(DocumentSourceUnionWithTest, BasicSerialUnions) {
     const auto docs = std::array{Document{{"a", 1}}, Document{{"b", 1}}, Document{{"c", 1}}};
     const auto mock = DocumentSourceMock::createForTest(docs[0], getExpCtx());
@@ -591,5 +624,58 @@ TEST_F(DocumentSourceUnionWithTest, StricterConstraintsFromSubSubPipelineAreInhe
                                          StageConstraints::UnionRequirement::kAllowed);
     ASSERT_TRUE(unionStage.constraints(Pipeline::SplitState::kUnsplit) == expectedConstraints);
 }
+
+TEST_F(DocumentSourceUnionWithTest, PrefetchStartsSubPipelineEarlyAndPreservesOrder) {
+    RAIIServerParameterControllerForTest prefetch("internalDocumentSourceUnionWithPrefetch", true);
+    const auto mock = DocumentSourceMock::createForTest(
+        {Document{{"a", 1}}, Document{{"a", 2}}}, getExpCtx());
+    const auto mockCtx = getExpCtx()->copyWith({});
+    mockCtx->mongoProcessInterface = std::make_unique<PrefetchRecordingInterface>(
+        std::deque<DocumentSource::GetNextResult>{Document{{"b", 1}}, Document{{"b", 2}}});
+    auto interface =
+        static_cast<PrefetchRecordingInterface*>(mockCtx->mongoProcessInterface.get());
+    auto unionWith = DocumentSourceUnionWith(
+        mockCtx, Pipeline::create(std::list<boost::intrusive_ptr<DocumentSource>>{}, mockCtx));
+    unionWith.setSource(mock.get());
+
+    // The sub-pipeline is started as soon as the first input document has been returned, and is
+    // never attached a second time.
+    ASSERT_DOCUMENT_EQ(unionWith.getNext().releaseDocument(), (Document{{"a", 1}}));
+    ASSERT_EQ(interface->numAttached, 1);
+    ASSERT_EQ(interface->numPrefetched, 1);
+
+    for (auto&& expected : {Document{{"a", 2}}, Document{{"b", 1}}, Document{{"b", 2}}}) {
+        auto next = unionWith.getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), expected);
+    }
+    ASSERT_TRUE(unionWith.getNext().isEOF());
+    ASSERT_EQ(interface->numAttached, 1);
+    ASSERT_EQ(interface->numPrefetched, 1);
+
+    unionWith.dispose();
+}
+
+TEST_F(DocumentSourceUnionWithTest, SubPipelineIsNotStartedEarlyWithoutPrefetch) {
+    RAIIServerParameterControllerForTest prefetch("internalDocumentSourceUnionWithPrefetch",
+                                                  false);
+    const auto mock = DocumentSourceMock::createForTest(Document{{"a", 1}}, getExpCtx());
+    const auto mockCtx = getExpCtx()->copyWith({});
+    mockCtx->mongoProcessInterface = std::make_unique<PrefetchRecordingInterface>(
+        std::deque<DocumentSource::GetNextResult>{Document{{"b", 1}}});
+    auto interface =
+        static_cast<PrefetchRecordingInterface*>(mockCtx->mongoProcessInterface.get());
+    auto unionWith = DocumentSourceUnionWith(
+        mockCtx, Pipeline::create(std::list<boost::intrusive_ptr<DocumentSource>>{}, mockCtx));
+    unionWith.setSource(mock.get());
+
+    ASSERT_DOCUMENT_EQ(unionWith.getNext().releaseDocument(), (Document{{"a", 1}}));
+    ASSERT_EQ(interface->numAttached, 0);
+    ASSERT_DOCUMENT_EQ(unionWith.getNext().releaseDocument(), (Document{{"b", 1}}));
+    ASSERT_EQ(interface->numAttached, 1);
+    ASSERT_EQ(interface->numPrefetched, 0);
+
+    unionWith.dispose();
+}
 }  // namespace
 }  // namespace mongo
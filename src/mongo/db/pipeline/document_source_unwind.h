@@ -93,6 +93,10 @@ public:
         return _indexPath;
     }
 
+    bool isStrict() const {
+        return _strict;
+    }
+
 protected:
     /**
      * Attempts to swap with a subsequent $sort stage if the $sort is on a different field.
@@ -117,6 +121,8 @@ private:
     // If set, the $unwind stage will include the array index in the specified path, overwriting any
     // existing value, setting to null when the value was a non-array or empty array.
     const boost::optional<FieldPath> _indexPath;
+    // If true, the $unwind stage fails on a value which is not an array.
+    const bool _strict;
 
     // Iteration state.
     class Unwinder;
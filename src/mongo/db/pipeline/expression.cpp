@@ -6721,15 +6721,14 @@ void ExpressionRegex::_compile(RegexExecutionState* executionState) const {
     }
 
     const char* compile_error;
-    int eoffset;
 
     // The C++ interface pcreccp.h doesn't have a way to capture the matched string (or the index of
     // the match). So we are using the C interface. First we compile all the regex options to
-    // generate pcre object, which will later be used to match against the input string.
-    executionState->pcrePtr = std::shared_ptr<pcre>(
-        pcre_compile(
-            executionState->pattern->c_str(), pcreOptions, &compile_error, &eoffset, nullptr),
-        pcre_free);
+    // generate pcre object, which will later be used to match against the input string. A regex
+    // that is not constant is compiled for every document, so share the compiled patterns through
+    // the process-wide cache.
+    executionState->pcrePtr =
+        regex_util::compilePattern(*executionState->pattern, pcreOptions, &compile_error);
     uassert(51111,
             str::stream() << "Invalid Regex in " << _opName << ": " << compile_error,
             executionState->pcrePtr);
@@ -500,9 +500,7 @@ public:
         if (n == 1) {
             Value singleVal = this->_children[0]->evaluate(root, variables);
             if (singleVal.getType() == Array) {
-                for (const Value& val : singleVal.getArray()) {
-                    accum.process(val, false);
-                }
+                accum.processBatch(singleVal.getArray());
             } else {
                 accum.process(singleVal, false);
             }
@@ -3590,7 +3588,7 @@ public:
          * and '_initialExecStateForConstantRegex'. If not, then the active RegexExecutionState is
          * the sole owner.
          */
-        std::shared_ptr<pcre> pcrePtr;
+        std::shared_ptr<const pcre> pcrePtr;
 
         /**
          * The input text and starting position for the current execution context.
@@ -31,6 +31,7 @@
 
 #include <utility>
 
+#include "mongo/db/curop.h"
 #include "mongo/db/pipeline/aggregate_command_gen.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
@@ -43,6 +44,40 @@ namespace mongo {
 
 using boost::intrusive_ptr;
 
+namespace {
+
+/**
+ * Returns the memory tracker of the operation running on 'opCtx', creating it if this is the first
+ * ExpressionContext of the operation to ask for it. Returns null if no memory budget is set.
+ */
+std::shared_ptr<SharedMemoryUsageTracker> getSharedOperationMemoryTracker(
+    OperationContext* opCtx) {
+    const auto maxOperationBytes = internalQueryMaxMemoryUsageBytesPerOperation.load();
+    const auto maxNodeBytes = internalQueryMaxMemoryUsageBytesPerNode.load();
+    if (maxOperationBytes == 0 && maxNodeBytes == 0) {
+        return nullptr;
+    }
+
+    auto& nodeTracker = SharedMemoryUsageTracker::getNodeTracker();
+    nodeTracker.setMaxAllowedMemoryUsageBytes(maxNodeBytes);
+    auto makeTracker = [&] {
+        return std::make_shared<SharedMemoryUsageTracker>(&nodeTracker, maxOperationBytes);
+    };
+
+    if (!opCtx || !opCtx->getClient()) {
+        return makeTracker();
+    }
+
+    auto curOp = CurOp::get(opCtx);
+    stdx::lock_guard<Client> lk(*opCtx->getClient());
+    if (!curOp->getMemoryTracker()) {
+        curOp->setMemoryTracker_inlock(makeTracker());
+    }
+    return curOp->getMemoryTracker();
+}
+
+}  // namespace
+
 ExpressionContext::ResolvedNamespace::ResolvedNamespace(NamespaceString ns,
                                                         std::vector<BSONObj> pipeline)
     : ns(std::move(ns)), pipeline(std::move(pipeline)) {}
@@ -209,6 +244,7 @@ intrusive_ptr<ExpressionContext> ExpressionContext::copyWith(
     expCtx->subPipelineDepth = subPipelineDepth;
     expCtx->tempDir = tempDir;
     expCtx->jsHeapLimitMB = jsHeapLimitMB;
+    expCtx->operationMemoryTracker = operationMemoryTracker;
 
     expCtx->variables = variables;
     expCtx->variablesParseState = variablesParseState.copyWith(expCtx->variables.useIdGenerator());
@@ -225,6 +261,13 @@ intrusive_ptr<ExpressionContext> ExpressionContext::copyWith(
     return expCtx;
 }
 
+SharedMemoryUsageTracker* ExpressionContext::getOperationMemoryTracker() {
+    if (!operationMemoryTracker) {
+        operationMemoryTracker = getSharedOperationMemoryTracker(opCtx);
+    }
+    return operationMemoryTracker.get();
+}
+
 void ExpressionContext::startExpressionCounters() {
     if (!_expressionCounters) {
         _expressionCounters = boost::make_optional<ExpressionCounters>({});
@@ -43,6 +43,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/javascript_execution.h"
 #include "mongo/db/pipeline/legacy_runtime_constants_gen.h"
+#include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/pipeline/process_interface/mongo_process_interface.h"
 #include "mongo/db/pipeline/variables.h"
 #include "mongo/db/query/collation/collator_interface.h"
@@ -238,6 +239,13 @@ public:
     std::unique_ptr<CollatorStash> temporarilyChangeCollator(
         std::unique_ptr<CollatorInterface> newCollator);
 
+    /**
+     * Returns the tracker of the memory used by the stages of the operation, which all its
+     * ExpressionContexts share, creating it on first use. Returns null if neither the
+     * per-operation nor the per-node memory budget is set, so that stages report nothing.
+     */
+    SharedMemoryUsageTracker* getOperationMemoryTracker();
+
     /**
      * Returns an ExpressionContext that is identical to 'this' that can be used to execute a
      * separate aggregation pipeline on 'ns' with the optional 'uuid' and an updated collator.
@@ -374,6 +382,11 @@ public:
     // 'jsHeapLimitMB' server parameter.
     boost::optional<int> jsHeapLimitMB;
 
+    // Tracks the memory used by the stages of the operation, against the per-operation and
+    // per-node memory budgets. All the ExpressionContexts of an operation share this tracker. Set
+    // by getOperationMemoryTracker().
+    std::shared_ptr<SharedMemoryUsageTracker> operationMemoryTracker;
+
     // An interface for accessing information or performing operations that have different
     // implementations on mongod and mongos, or that only make sense on one of the two.
     // Additionally, putting some of this functionality behind an interface prevents aggregation
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/bson/bsonmisc.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/logical_time.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -37,6 +38,7 @@
 #include "mongo/db/query/datetime/date_time_support.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/vector_clock_mutable.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 #define ASSERT_DOES_NOT_THROW(EXPRESSION)                                          \
@@ -231,5 +233,26 @@ TEST_F(ExpressionContextTest, ParametersCauseGracefulFailuresIfUppercase) {
         DBException,
         ErrorCodes::FailedToParse);
 }
+
+TEST_F(ExpressionContextTest, OperationMemoryTrackerIsOnlyCreatedWhenABudgetIsSet) {
+    auto opCtx = makeOperationContext();
+    const NamespaceString nss{"test"_sd, "namespace"_sd};
+    auto expCtx = make_intrusive<ExpressionContext>(opCtx.get(), nullptr, nss);
+    ASSERT_FALSE(expCtx->getOperationMemoryTracker());
+    ASSERT_FALSE(CurOp::get(opCtx.get())->getMemoryTracker());
+
+    RAIIServerParameterControllerForTest operationBudget(
+        "internalQueryMaxMemoryUsageBytesPerOperation", 1024 * 1024);
+    auto tracker = expCtx->getOperationMemoryTracker();
+    ASSERT(tracker);
+    ASSERT_EQ(tracker, CurOp::get(opCtx.get())->getMemoryTracker().get());
+
+    // The other ExpressionContexts of the operation share its tracker.
+    ASSERT_EQ(tracker, expCtx->copyWith(nss)->getOperationMemoryTracker());
+    ASSERT_EQ(tracker,
+              make_intrusive<ExpressionContext>(opCtx.get(), nullptr, nss)
+                  ->getOperationMemoryTracker());
+}
+
 }  // namespace
 }  // namespace mongo
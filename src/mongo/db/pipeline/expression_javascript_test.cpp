@@ -34,6 +34,7 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/expression_function.h"
+#include "mongo/db/pipeline/javascript_execution.h"
 #include "mongo/db/pipeline/process_interface/standalone_process_interface.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context_d_test_fixture.h"
@@ -274,5 +275,32 @@ TEST_F(MapReduceFixture, ExpressionInternalJsErrorsIfProducesTooManyDocumentsFor
     ASSERT_THROWS_CODE(
         expr->evaluate(Document{BSON("val" << 1)}, getVariables()), AssertionException, 31292);
 }
+
+TEST_F(MapReduceFixture, JsExecutionReusesScopeAndCompiledFunctionsOfEarlierOperation) {
+    const std::string code = "function(a) { return a + 1; }";
+    Scope* firstScope;
+    ScriptingFunction firstFunc;
+    {
+        auto opCtx = makeOperationContext();
+        auto exec = JsExecution::get(opCtx.get(), BSONObj(), "test", false, boost::none);
+        firstScope = exec->getScope();
+        firstFunc = exec->createFunction(code);
+    }
+
+    {
+        auto opCtx = makeOperationContext();
+        auto exec = JsExecution::get(opCtx.get(), BSONObj(), "test", false, boost::none);
+        ASSERT_EQ(firstScope, exec->getScope());
+        ASSERT_EQ(firstFunc, exec->createFunction(code));
+        ASSERT_VALUE_EQ(Value(3), exec->callFunction(firstFunc, BSON("arg" << 2), BSONObj()));
+    }
+
+    {
+        // A scope is not shared with operations on another database.
+        auto opCtx = makeOperationContext();
+        auto exec = JsExecution::get(opCtx.get(), BSONObj(), "other", false, boost::none);
+        ASSERT_NE(firstScope, exec->getScope());
+    }
+}
 }  // namespace
 }  // namespace mongo
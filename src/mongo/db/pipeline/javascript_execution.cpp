@@ -34,14 +34,64 @@
 #include <iostream>
 
 #include "mongo/base/status_with.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/operation_wait_stats.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace {
 const auto getExec = OperationContext::declareDecoration<std::unique_ptr<JsExecution>>();
+
+// Scopes are only reused by operations on the same database, run by the same users, which agree
+// on whether stored procedures are loaded.
+std::string makePoolName(Client* client, StringData database, bool loadStoredProcedures) {
+    StringBuilder sb;
+    sb << database << (loadStoredProcedures ? "jsStored" : "js");
+
+    if (AuthorizationSession::exists(client)) {
+        auto as = AuthorizationSession::get(client);
+        for (auto nameIter = as->getAuthenticatedUserNames(); nameIter.more(); nameIter.next()) {
+            // Using a NUL byte which isn't valid in usernames to separate them.
+            sb << '\0' << nameIter->getUnambiguousName();
+        }
+    }
+
+    return sb.str();
+}
 }  // namespace
 
+JsExecution::JsExecution(OperationContext* opCtx,
+                         const BSONObj& scopeVars,
+                         std::string poolName,
+                         boost::optional<int> jsHeapLimitMB)
+    : _opCtx(opCtx),
+      _poolName(std::move(poolName)),
+      _jsHeapLimitMB(jsHeapLimitMB),
+      _scope(getGlobalScriptEngine()->getPooledScopeForCurrentThread(_poolName, jsHeapLimitMB)) {
+    _scopeVars = scopeVars.getOwned();
+    _scope->init(&_scopeVars);
+    _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
+    _scope->registerOperation(opCtx);
+}
+
+JsExecution::~JsExecution() {
+    _scope->unregisterOperation();
+
+    try {
+        // The injected 'emit' function calls back into this operation, so it must not survive
+        // into whichever operation reuses the scope next.
+        if (_emitCreated) {
+            static const BSONObj kNoEmit = BSON("emit" << BSONNULL);
+            _scope->setElement("emit", kNoEmit.firstElement(), kNoEmit);
+        }
+        getGlobalScriptEngine()->releaseScopeForCurrentThread(
+            _poolName, _jsHeapLimitMB, std::move(_scope));
+    } catch (const DBException&) {
+        // The scope is simply not reused.
+    }
+}
+
 JsExecution* JsExecution::get(OperationContext* opCtx,
                               const BSONObj& scope,
                               StringData database,
@@ -49,7 +99,11 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
                               boost::optional<int> jsHeapLimitMB) {
     auto& exec = getExec(opCtx);
     if (!exec) {
-        exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        exec = std::make_unique<JsExecution>(
+            opCtx,
+            scope,
+            makePoolName(opCtx->getClient(), database, loadStoredProcedures),
+            jsHeapLimitMB);
         exec->getScope()->setLocalDB(database);
         if (loadStoredProcedures) {
             exec->getScope()->loadStored(opCtx, true);
@@ -66,6 +120,7 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
 Value JsExecution::callFunction(ScriptingFunction func,
                                 const BSONObj& params,
                                 const BSONObj& thisObj) {
+    ScopedWaitTimer waitTimer(_opCtx, OperationWaitStats::WaitState::kJavaScript);
     int err = _scope->invoke(func, &params, &thisObj, _fnCallTimeoutMillis, false);
     uassert(
         31439, str::stream() << "js function failed to execute: " << _scope->getError(), err == 0);
@@ -78,6 +133,7 @@ Value JsExecution::callFunction(ScriptingFunction func,
 void JsExecution::callFunctionWithoutReturn(ScriptingFunction func,
                                             const BSONObj& params,
                                             const BSONObj& thisObj) {
+    ScopedWaitTimer waitTimer(_opCtx, OperationWaitStats::WaitState::kJavaScript);
     int err = _scope->invoke(func, &params, &thisObj, _fnCallTimeoutMillis, true);
     uassert(
         31470, str::stream() << "js function failed to execute: " << _scope->getError(), err == 0);
@@ -59,21 +59,16 @@ public:
                             bool loadStoredProcedures,
                             boost::optional<int> jsHeapLimitMB);
     /**
-     * Construct with a thread-local scope and initialize with the given scope variables.
+     * Construct with a thread-local scope and initialize with the given scope variables. The scope
+     * is reused from an earlier operation on this thread with the same 'poolName' if possible, and
+     * is handed back for reuse by a later one on destruction.
      */
     JsExecution(OperationContext* opCtx,
                 const BSONObj& scopeVars,
-                boost::optional<int> jsHeapLimitMB = boost::none)
-        : _scope(getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB)) {
-        _scopeVars = scopeVars.getOwned();
-        _scope->init(&_scopeVars);
-        _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
-        _scope->registerOperation(opCtx);
-    }
+                std::string poolName,
+                boost::optional<int> jsHeapLimitMB = boost::none);
 
-    ~JsExecution() {
-        _scope->unregisterOperation();
-    };
+    ~JsExecution();
 
     /**
      * Invokes the javascript function given by 'func' with the arguments 'params' and input object
@@ -116,6 +111,9 @@ public:
     }
 
 private:
+    OperationContext* const _opCtx;
+    const std::string _poolName;
+    const boost::optional<int> _jsHeapLimitMB;
     BSONObj _scopeVars;
     std::unique_ptr<Scope> _scope;
     bool _emitCreated = false;
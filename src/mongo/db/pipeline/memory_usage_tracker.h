@@ -29,14 +29,112 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
+/**
+ * Tracks the memory used by a group of members, such as all the stages of an operation or all the
+ * operations running on this node, and enforces a budget over it. Members may report their usage
+ * concurrently.
+ *
+ * A member is asked to release memory when the group is over its budget and the member holds at
+ * least its fair share of the budget, or when the group itself has to release memory on behalf of
+ * its parent and the member holds at least its fair share of the group's usage. Since at least one
+ * member of a group holds its fair share, some member always releases memory while the group is
+ * over budget.
+ */
+class SharedMemoryUsageTracker {
+public:
+    /**
+     * Returns the tracker of all the operations running on this node.
+     */
+    static SharedMemoryUsageTracker& getNodeTracker() {
+        static SharedMemoryUsageTracker nodeTracker{nullptr, 0};
+        return nodeTracker;
+    }
+
+    /**
+     * A 'maxAllowedMemoryUsageBytes' of zero indicates that the memory usage is unbounded.
+     */
+    SharedMemoryUsageTracker(SharedMemoryUsageTracker* parent, long long maxAllowedMemoryUsageBytes)
+        : _parent(parent), _maxAllowedMemoryUsageBytes(maxAllowedMemoryUsageBytes) {
+        if (_parent) {
+            _parent->_numMembers.addAndFetch(1);
+        }
+    }
+
+    ~SharedMemoryUsageTracker() {
+        if (_parent) {
+            _parent->update(-_memoryUsageBytes.load());
+            _parent->_numMembers.subtractAndFetch(1);
+        }
+    }
+
+    SharedMemoryUsageTracker(const SharedMemoryUsageTracker&) = delete;
+    SharedMemoryUsageTracker& operator=(const SharedMemoryUsageTracker&) = delete;
+
+    /**
+     * Adds 'diff' to the memory usage of this tracker and of its ancestors.
+     */
+    void update(long long diff) {
+        auto total = _memoryUsageBytes.addAndFetch(diff);
+        auto max = _maxMemoryUsageBytes.load();
+        while (total > max && !_maxMemoryUsageBytes.compareAndSwap(&max, total)) {
+        }
+        if (_parent) {
+            _parent->update(diff);
+        }
+    }
+
+    /**
+     * Returns true if a member of this tracker currently using 'memberBytes' should release memory.
+     */
+    bool shouldReleaseMemory(long long memberBytes) const {
+        if (memberBytes <= 0) {
+            return false;
+        }
+
+        auto numMembers = std::max(_numMembers.load(), 1LL);
+        auto currentBytes = _memoryUsageBytes.load();
+        auto maxAllowedBytes = _maxAllowedMemoryUsageBytes.load();
+        if (maxAllowedBytes > 0 && currentBytes > maxAllowedBytes &&
+            memberBytes >= maxAllowedBytes / numMembers) {
+            return true;
+        }
+        return _parent && _parent->shouldReleaseMemory(currentBytes) &&
+            memberBytes >= currentBytes / numMembers;
+    }
+
+    void setMaxAllowedMemoryUsageBytes(long long maxAllowedMemoryUsageBytes) {
+        _maxAllowedMemoryUsageBytes.store(maxAllowedMemoryUsageBytes);
+    }
+
+    long long currentMemoryBytes() const {
+        return _memoryUsageBytes.load();
+    }
+
+    long long maxMemoryBytes() const {
+        return _maxMemoryUsageBytes.load();
+    }
+
+private:
+    friend class MemoryUsageTracker;
+
+    SharedMemoryUsageTracker* const _parent;
+    AtomicWord<long long> _maxAllowedMemoryUsageBytes;
+
+    AtomicWord<long long> _memoryUsageBytes{0};
+    AtomicWord<long long> _maxMemoryUsageBytes{0};
+    AtomicWord<long long> _numMembers{0};
+};
+
 /**
  * This is a utility class for tracking memory usage across multiple arbitrary operators or
  * functions, which are identified by their string names.
@@ -81,8 +179,31 @@ public:
         long long _currentMemoryBytes = 0;
     };
 
-    MemoryUsageTracker(bool allowDiskUse = false, size_t maxMemoryUsageBytes = 0)
-        : _allowDiskUse(allowDiskUse), _maxAllowedMemoryUsageBytes(maxMemoryUsageBytes) {}
+    /**
+     * If 'sharedTracker' is provided, the memory tracked by this object is also reported to it, so
+     * that a budget can be enforced over several trackers. Only provide one when such a budget is
+     * set, since reporting to it costs atomic operations on every update.
+     */
+    MemoryUsageTracker(bool allowDiskUse = false,
+                       size_t maxMemoryUsageBytes = 0,
+                       SharedMemoryUsageTracker* sharedTracker = nullptr)
+        : _allowDiskUse(allowDiskUse),
+          _maxAllowedMemoryUsageBytes(maxMemoryUsageBytes),
+          _sharedTracker(sharedTracker) {
+        if (_sharedTracker) {
+            _sharedTracker->_numMembers.addAndFetch(1);
+        }
+    }
+
+    ~MemoryUsageTracker() {
+        if (_sharedTracker) {
+            _sharedTracker->update(-_memoryUsageBytes);
+            _sharedTracker->_numMembers.subtractAndFetch(1);
+        }
+    }
+
+    MemoryUsageTracker(const MemoryUsageTracker&) = delete;
+    MemoryUsageTracker& operator=(const MemoryUsageTracker&) = delete;
 
     /**
      * Sets the new total for 'name', and updates the current total memory usage.
@@ -95,6 +216,9 @@ public:
      * Sets the new current memory usage in bytes.
      */
     void set(long long total) {
+        if (_sharedTracker && total != _memoryUsageBytes) {
+            _sharedTracker->update(total - _memoryUsageBytes);
+        }
         _memoryUsageBytes = total;
         if (_memoryUsageBytes > _maxMemoryUsageBytes) {
             _maxMemoryUsageBytes = _memoryUsageBytes;
@@ -109,7 +233,7 @@ public:
         for (auto& [_, funcTracker] : _functionMemoryTracker) {
             funcTracker.set(0);
         }
-        _memoryUsageBytes = 0;
+        set(0);
     }
 
     /**
@@ -158,6 +282,23 @@ public:
         return _maxMemoryUsageBytes;
     }
 
+    /**
+     * Returns true if the operation or node this tracker belongs to is over its memory budget and
+     * this tracker should release some of its memory.
+     */
+    bool exceedsSharedMemoryBudget() const {
+        return _sharedTracker && _sharedTracker->shouldReleaseMemory(_memoryUsageBytes);
+    }
+
+    /**
+     * Returns true if the memory used exceeds the limit of this tracker, or if this tracker should
+     * release memory on behalf of its operation or node.
+     */
+    bool exceedsMemoryLimit() const {
+        return _memoryUsageBytes > static_cast<long long>(_maxAllowedMemoryUsageBytes) ||
+            exceedsSharedMemoryBudget();
+    }
+
     const bool _allowDiskUse;
     const size_t _maxAllowedMemoryUsageBytes;
 
@@ -166,6 +307,8 @@ private:
         return {s.rawData(), s.size()};
     }
 
+    SharedMemoryUsageTracker* const _sharedTracker;
+
     // Tracks current memory used.
     long long _memoryUsageBytes = 0;
     long long _maxMemoryUsageBytes = 0;
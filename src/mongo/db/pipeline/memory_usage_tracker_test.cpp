@@ -119,5 +119,76 @@ DEATH_TEST_F(MemoryUsageTrackerTest,
     _funcTracker.update(-100);
 }
 
+TEST(SharedMemoryUsageTrackerTest, MembersReportTheirUsageToAllAncestors) {
+    SharedMemoryUsageTracker nodeTracker{nullptr, 0};
+    auto operationTracker = std::make_unique<SharedMemoryUsageTracker>(&nodeTracker, 0);
+    {
+        MemoryUsageTracker stageTracker{false, 1024, operationTracker.get()};
+        stageTracker.set("push", 100);
+        stageTracker.update(50);
+        ASSERT_EQ(operationTracker->currentMemoryBytes(), 150LL);
+        ASSERT_EQ(nodeTracker.currentMemoryBytes(), 150LL);
+
+        stageTracker.resetCurrent();
+        ASSERT_EQ(operationTracker->currentMemoryBytes(), 0LL);
+        ASSERT_EQ(operationTracker->maxMemoryBytes(), 150LL);
+
+        stageTracker.set(75);
+    }
+
+    // The memory of a tracker is released when it is destroyed.
+    ASSERT_EQ(operationTracker->currentMemoryBytes(), 0LL);
+    ASSERT_EQ(nodeTracker.maxMemoryBytes(), 150LL);
+
+    operationTracker->update(200);
+    ASSERT_EQ(nodeTracker.currentMemoryBytes(), 200LL);
+    operationTracker.reset();
+    ASSERT_EQ(nodeTracker.currentMemoryBytes(), 0LL);
+}
+
+TEST(SharedMemoryUsageTrackerTest, OnlyMembersHoldingTheirShareReleaseMemory) {
+    SharedMemoryUsageTracker operationTracker{nullptr, 1000};
+    MemoryUsageTracker bigStage{false, 1024, &operationTracker};
+    MemoryUsageTracker smallStage{false, 1024, &operationTracker};
+
+    bigStage.set(700);
+    smallStage.set(200);
+    ASSERT_FALSE(bigStage.exceedsMemoryLimit());
+    ASSERT_FALSE(smallStage.exceedsMemoryLimit());
+
+    // Each stage is entitled to half of the budget of the operation once it is exceeded.
+    smallStage.set(400);
+    ASSERT_TRUE(bigStage.exceedsSharedMemoryBudget());
+    ASSERT_TRUE(bigStage.exceedsMemoryLimit());
+    ASSERT_FALSE(smallStage.exceedsSharedMemoryBudget());
+
+    bigStage.set(0);
+    ASSERT_FALSE(smallStage.exceedsSharedMemoryBudget());
+}
+
+TEST(SharedMemoryUsageTrackerTest, NodeBudgetIsSharedBetweenOperations) {
+    SharedMemoryUsageTracker nodeTracker{nullptr, 1000};
+    SharedMemoryUsageTracker firstOperation{&nodeTracker, 0};
+    SharedMemoryUsageTracker secondOperation{&nodeTracker, 0};
+    MemoryUsageTracker firstOperationGroup{false, 1024, &firstOperation};
+    MemoryUsageTracker firstOperationSort{false, 1024, &firstOperation};
+    MemoryUsageTracker secondOperationGroup{false, 1024, &secondOperation};
+
+    firstOperationGroup.set(500);
+    firstOperationSort.set(100);
+    secondOperationGroup.set(300);
+    ASSERT_FALSE(firstOperationGroup.exceedsSharedMemoryBudget());
+
+    // The node is over budget and the first operation holds more than its share, so its stage
+    // holding most of its memory has to release some.
+    secondOperationGroup.set(450);
+    ASSERT_TRUE(firstOperationGroup.exceedsSharedMemoryBudget());
+    ASSERT_FALSE(firstOperationSort.exceedsSharedMemoryBudget());
+    ASSERT_FALSE(secondOperationGroup.exceedsSharedMemoryBudget());
+
+    nodeTracker.setMaxAllowedMemoryUsageBytes(0);
+    ASSERT_FALSE(firstOperationGroup.exceedsSharedMemoryBudget());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#pragma once
+
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/memory_usage_tracker.h"
 namespace mongo {
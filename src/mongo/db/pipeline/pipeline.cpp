@@ -52,8 +52,8 @@ namespace mongo {
 
 namespace {
 
-// Given a serialized document source, appends execution stats 'nReturned' and
-// 'executionTimeMillisEstimate' to it.
+// Given a serialized document source, appends execution stats 'nReturned',
+// 'executionTimeMillisEstimate' and, if it was collected, 'executionCpuTimeMicros' to it.
 Value appendCommonExecStats(Value docSource, const CommonStats& stats) {
     invariant(docSource.getType() == BSONType::Object);
     MutableDocument doc(docSource.getDocument());
@@ -62,6 +62,10 @@ Value appendCommonExecStats(Value docSource, const CommonStats& stats) {
     auto executionTimeMillisEstimate = static_cast<long long>(*stats.executionTimeMillis);
     doc.addField("nReturned", Value(nReturned));
     doc.addField("executionTimeMillisEstimate", Value(executionTimeMillisEstimate));
+    if (stats.executionCpuTimeMicros) {
+        doc.addField("executionCpuTimeMicros",
+                     Value(static_cast<long long>(*stats.executionCpuTimeMicros)));
+    }
     return Value(doc.freeze());
 }
 
@@ -69,6 +69,7 @@
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/inner_pipeline_stage_impl.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/skip_and_limit.h"
@@ -98,14 +99,39 @@ using std::unique_ptr;
 using write_ops::InsertCommandRequest;
 
 namespace {
+/**
+ * Returns whether 'unwindStage' can be pushed down to SBE along with the preceding $group, whose
+ * output has the top-level fields 'groupOutputFields'. The $unwind is then applied to the output
+ * values of the group before they are put into a document, which is only possible for an $unwind
+ * of one of these fields. The 'includeArrayIndex' field must be a new top-level field, so that
+ * appending it to the document puts it where the classic $unwind would. Such fields are recorded in
+ * 'addedFields' as the $unwind stages after the same $group are checked.
+ */
+bool canPushDownUnwindAfterGroup(const DocumentSourceUnwind& unwindStage,
+                                 const StringSet& groupOutputFields,
+                                 StringSet* addedFields) {
+    if (unwindStage.isStrict() || !groupOutputFields.contains(unwindStage.getUnwindPath())) {
+        return false;
+    }
+
+    if (const auto& indexPath = unwindStage.indexPath()) {
+        const auto indexFieldName = indexPath->fullPath();
+        if (indexPath->getPathLength() != 1 || groupOutputFields.contains(indexFieldName) ||
+            !addedFields->insert(indexFieldName).second) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * Extracts a prefix of 'DocumentSourceGroup' stages from the given pipeline to prepare for
- * pushdown of $group into the inner query layer so that it can be executed using SBE. Group stages
- * are extracted from the pipeline under when all of the following conditions are met:
+ * pushdown of $group into the inner query layer so that it can be executed using SBE. Each group
+ * may be followed by $unwind stages over its output fields, which are pushed down along with it
+ * (see canPushDownUnwindAfterGroup()). Group stages are extracted from the pipeline under when all
+ * of the following conditions are met:
  *    0. When the 'internalQueryEnableSlotBasedExecutionEngine' feature flag is 'true'.
- *    1. When 'allowDiskUse' is false. We currently don't support spilling in the SBE HashAgg
- *       stage. This will change once that is supported when SERVER-58436 is complete.
- *    2. When there's only a single index other than the implicit '_id' index on the provided
+ *    1. When there's only a single index other than the implicit '_id' index on the provided
  *       collection. This case is necessary because we don't currently support extending the
  *       QuerySolution with the 'postMultiPlan' QuerySolutionNode when the PlanCache is involved in
  *       the query. This will be resolved when SERVER-58429 is complete.
@@ -123,19 +149,36 @@ std::vector<std::unique_ptr<InnerPipelineStageInterface>> extractSbeCompatibleGr
         collection && collection->getIndexCatalog()->numIndexesTotal(expCtx->opCtx) == 1;
     if (!feature_flags::gFeatureFlagSBEGroupPushdown.isEnabled(
             serverGlobalParams.featureCompatibility) ||
-        !cq->getEnableSlotBasedExecutionEngine() || expCtx->allowDiskUse || !isSingleIndex) {
+        !cq->getEnableSlotBasedExecutionEngine() || !isSingleIndex) {
         return {};
     }
 
     auto&& sources = pipeline->getSources();
 
+    // The top-level fields of the output of the last extracted group, and the fields which the
+    // $unwind stages extracted after it add.
+    StringSet groupOutputFields;
+    StringSet addedFields;
     for (auto itr = sources.begin(); itr != sources.end();) {
-        auto groupStage = dynamic_cast<DocumentSourceGroup*>(itr->get());
-        if (!(groupStage && groupStage->sbeCompatible())) {
-            // Only pushdown a prefix of group stages that are supported by sbe.
+        if (auto groupStage = dynamic_cast<DocumentSourceGroup*>(itr->get())) {
+            if (!groupStage->sbeCompatible()) {
+                break;
+            }
+            groupOutputFields = {"_id"};
+            for (auto&& acc : groupStage->getAccumulatedFields()) {
+                groupOutputFields.insert(acc.fieldName);
+            }
+            addedFields.clear();
+        } else if (auto unwindStage = dynamic_cast<DocumentSourceUnwind*>(itr->get())) {
+            if (groupsForPushdown.empty() ||
+                !canPushDownUnwindAfterGroup(*unwindStage, groupOutputFields, &addedFields)) {
+                break;
+            }
+        } else {
+            // Only pushdown a prefix of stages that are supported by sbe.
             break;
         }
-        groupsForPushdown.push_back(std::make_unique<InnerPipelineStageImpl>(groupStage));
+        groupsForPushdown.push_back(std::make_unique<InnerPipelineStageImpl>(*itr));
         sources.erase(itr++);
     }
 
@@ -314,6 +357,12 @@ std::pair<DocumentSourceSample*, DocumentSourceInternalUnpackBucket*> extractSam
         unpackStage = dynamic_cast<DocumentSourceInternalUnpackBucket*>(sourcesIt->get());
         ++sourcesIt;
 
+        // Sampling directly from buckets bypasses the unpack stage's event filter, so the
+        // $sample cannot be pushed down in that case.
+        if (unpackStage && unpackStage->eventFilter()) {
+            return std::pair{sampleStage, unpackStage};
+        }
+
         if (unpackStage && sourcesIt != sources.end()) {
             sampleStage = dynamic_cast<DocumentSourceSample*>(sourcesIt->get());
             return std::pair{sampleStage, unpackStage};
@@ -0,0 +1,240 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/pipeline_template_cache.h"
+
+#include <algorithm>
+
+#include "mongo/db/api_parameters.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/pipeline/variables.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getPipelineTemplateCache = ServiceContext::declareDecoration<PipelineTemplateCache>();
+
+class PipelineTemplateCacheServerStatusSection final : public ServerStatusSection {
+public:
+    PipelineTemplateCacheServerStatusSection() : ServerStatusSection("pipelineTemplateCache") {}
+
+    bool includeByDefault() const override {
+        return PipelineTemplateCache::isEnabled();
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        PipelineTemplateCache::get(opCtx->getServiceContext()).appendStats(&builder);
+        return builder.obj();
+    }
+} pipelineTemplateCacheServerStatusSection;
+
+/**
+ * Returns true if 'elem' refers to a system variable other than $$ROOT or $$REMOVE anywhere.
+ */
+bool refersToSystemVariable(const BSONElement& elem) {
+    if (elem.isABSONObj()) {
+        for (auto&& child : elem.embeddedObject()) {
+            if (refersToSystemVariable(child)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    if (elem.type() != BSONType::String || !elem.valueStringData().startsWith("$$")) {
+        return false;
+    }
+
+    auto name = elem.valueStringData().substr(2);
+    name = name.substr(0, name.find('.'));
+    auto it = Variables::kBuiltinVarNameToId.find(name);
+    return it != Variables::kBuiltinVarNameToId.end() && it->second != Variables::kRootId &&
+        it->second != Variables::kRemoveId;
+}
+
+bool sameStages(const std::vector<BSONObj>& lhs, const std::vector<BSONObj>& rhs) {
+    return std::equal(lhs.begin(),
+                      lhs.end(),
+                      rhs.begin(),
+                      rhs.end(),
+                      [](const BSONObj& l, const BSONObj& r) { return l.binaryEqual(r); });
+}
+
+}  // namespace
+
+PipelineTemplateCache::PipelineTemplateCache()
+    : PipelineTemplateCache(internalQueryPipelineTemplateCacheMaxEntries) {}
+
+PipelineTemplateCache::PipelineTemplateCache(size_t maxEntries) : _entries(maxEntries) {}
+
+PipelineTemplateCache& PipelineTemplateCache::get(ServiceContext* serviceContext) {
+    return getPipelineTemplateCache(serviceContext);
+}
+
+bool PipelineTemplateCache::isEnabled() {
+    return internalQueryEnablePipelineTemplateCache;
+}
+
+bool PipelineTemplateCache::isEligible(OperationContext* opCtx,
+                                       const AggregateCommandRequest& request,
+                                       const LiteParsedPipeline& liteParsedPipeline) {
+    if (!isEnabled() || opCtx->inMultiDocumentTransaction() ||
+        MONGO_unlikely(disablePipelineOptimization.shouldFail())) {
+        return false;
+    }
+
+    // Requests from a router, exchange producers and mapReduce are parsed with extra state, and
+    // 'let' variables are folded into the optimized pipeline just like system variables.
+    if (request.getExplain() || request.getFromMongos() || request.getNeedsMerge() ||
+        request.getExchange() || request.getLet() || request.getLegacyRuntimeConstants() ||
+        request.getIsMapReduceCommand()) {
+        return false;
+    }
+
+    // Stages which read other namespaces are resolved against the catalog at parse time, for
+    // instance a $lookup from a view inlines the view's pipeline.
+    if (liteParsedPipeline.hasChangeStream() ||
+        !liteParsedPipeline.getInvolvedNamespaces().empty()) {
+        return false;
+    }
+
+    const auto& pipeline = request.getPipeline();
+    return std::none_of(pipeline.begin(), pipeline.end(), [](const BSONObj& stage) {
+        for (auto&& elem : stage) {
+            if (refersToSystemVariable(elem)) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+std::string PipelineTemplateCache::makeKey(const ExpressionContext& expCtx,
+                                           const AggregateCommandRequest& request) {
+    invariant(expCtx.uuid);
+
+    BSONObjBuilder builder;
+    expCtx.uuid->appendToBuilder(&builder, "uuid");
+    builder.append("pipeline", request.getPipeline());
+    builder.append("collation", request.getCollation().get_value_or(BSONObj()));
+    builder.append("allowDiskUse", expCtx.allowDiskUse);
+    // The API parameters decide which stages and expressions may be parsed.
+    APIParameters::get(expCtx.opCtx).appendInfo(&builder);
+
+    auto key = builder.obj();
+    return std::string(key.objdata(), key.objsize());
+}
+
+std::unique_ptr<Pipeline, PipelineDeleter> PipelineTemplateCache::lookup(
+    const std::string& key, const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    Stages stages;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (auto it = _entries.find(key); it != _entries.end()) {
+            stages = it->second;
+        }
+    }
+
+    if (!stages) {
+        _misses.fetchAndAddRelaxed(1);
+        return nullptr;
+    }
+
+    _hits.fetchAndAddRelaxed(1);
+    return Pipeline::parse(*stages, expCtx);
+}
+
+bool PipelineTemplateCache::add(const std::string& key, const Pipeline& pipeline) {
+    auto stages = pipeline.serializeToBson();
+
+    // Check the round trip with a copy of the ExpressionContext, so that parsing the stages again
+    // leaves no trace on the original one.
+    auto isFixedPoint = [&] {
+        const auto& expCtx = pipeline.getContext();
+        auto reparsed = Pipeline::parse(stages, expCtx->copyWith(expCtx->ns, expCtx->uuid));
+        if (reparsed->getSources().size() != pipeline.getSources().size() ||
+            !sameStages(reparsed->serializeToBson(), stages)) {
+            return false;
+        }
+
+        reparsed->optimizePipeline();
+        return reparsed->getSources().size() == pipeline.getSources().size() &&
+            sameStages(reparsed->serializeToBson(), stages);
+    };
+
+    bool cacheable;
+    try {
+        cacheable = isFixedPoint();
+    } catch (const DBException&) {
+        cacheable = false;
+    }
+
+    if (!cacheable) {
+        _uncacheable.fetchAndAddRelaxed(1);
+        return false;
+    }
+
+    for (auto& stage : stages) {
+        stage = stage.getOwned();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.add(key, std::make_shared<const std::vector<BSONObj>>(std::move(stages)));
+    return true;
+}
+
+void PipelineTemplateCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+}
+
+size_t PipelineTemplateCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+void PipelineTemplateCache::appendStats(BSONObjBuilder* builder) const {
+    builder->append("hits", _hits.load());
+    builder->append("misses", _misses.load());
+    builder->append("uncacheable", _uncacheable.load());
+    builder->append("entries", static_cast<long long>(size()));
+}
+
+}  // namespace mongo
@@ -0,0 +1,126 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+
+namespace mongo {
+
+class AggregateCommandRequest;
+class BSONObjBuilder;
+class ExpressionContext;
+class LiteParsedPipeline;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Opt-in cache of optimized aggregation pipelines, keyed by the collection UUID, the raw pipeline
+ * and the request options that affect how it is parsed. On a hit the cached optimized stages are
+ * parsed with the new request's ExpressionContext and Pipeline::optimizePipeline() is skipped.
+ *
+ * Optimization may rely on state that a stage's serialization does not capture, for instance a
+ * $sort which has absorbed a following $limit serializes as two stages. A pipeline is therefore
+ * only cached if its optimized form is a fixed point: parsing its serialization must produce the
+ * same stages, and optimizing those again must not change them. Pipelines which read other
+ * namespaces or refer to system variables such as $$NOW, whose values optimization folds into
+ * constants, are never cached.
+ *
+ * This class is thread-safe.
+ */
+class PipelineTemplateCache {
+public:
+    /**
+     * Creates a cache sized according to internalQueryPipelineTemplateCacheMaxEntries.
+     */
+    PipelineTemplateCache();
+
+    explicit PipelineTemplateCache(size_t maxEntries);
+
+    static PipelineTemplateCache& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns true if the cache was enabled at startup.
+     */
+    static bool isEnabled();
+
+    /**
+     * Returns true if the pipeline of 'request' may be cached or served from the cache.
+     */
+    static bool isEligible(OperationContext* opCtx,
+                           const AggregateCommandRequest& request,
+                           const LiteParsedPipeline& liteParsedPipeline);
+
+    /**
+     * Returns the key of the pipeline of 'request', which is about to be parsed with 'expCtx'.
+     * The ExpressionContext must be bound to a collection.
+     */
+    static std::string makeKey(const ExpressionContext& expCtx,
+                               const AggregateCommandRequest& request);
+
+    /**
+     * Returns the pipeline cached under 'key', parsed with 'expCtx' and already optimized, or
+     * nullptr if there is none.
+     */
+    std::unique_ptr<Pipeline, PipelineDeleter> lookup(
+        const std::string& key, const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    /**
+     * Caches 'pipeline', which must have just been optimized, under 'key' if its optimized form is
+     * a fixed point. Returns whether it was cached.
+     */
+    bool add(const std::string& key, const Pipeline& pipeline);
+
+    void clear();
+
+    size_t size() const;
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    using Stages = std::shared_ptr<const std::vector<BSONObj>>;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("PipelineTemplateCache::_mutex");
+    LRUCache<std::string, Stages> _entries;
+
+    AtomicWord<long long> _hits{0};
+    AtomicWord<long long> _misses{0};
+    AtomicWord<long long> _uncacheable{0};
+};
+
+}  // namespace mongo
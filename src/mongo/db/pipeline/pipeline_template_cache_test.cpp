@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/pipeline_template_cache.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class PipelineTemplateCacheTest : public AggregationContextFixture {
+public:
+    PipelineTemplateCacheTest() {
+        getExpCtx()->uuid = UUID::gen();
+    }
+
+    AggregateCommandRequest makeRequest(const std::string& pipelineJson) {
+        std::vector<BSONObj> pipeline;
+        for (auto&& stage : fromjson("{pipeline: " + pipelineJson + "}")["pipeline"].Array()) {
+            pipeline.push_back(stage.Obj().getOwned());
+        }
+        return AggregateCommandRequest(getExpCtx()->ns, std::move(pipeline));
+    }
+
+    bool isEligible(const AggregateCommandRequest& request) {
+        return PipelineTemplateCache::isEligible(
+            getOpCtx(), request, LiteParsedPipeline(request));
+    }
+
+    std::unique_ptr<Pipeline, PipelineDeleter> parseAndOptimize(
+        const AggregateCommandRequest& request) {
+        auto pipeline = Pipeline::parse(request.getPipeline(), getExpCtx());
+        pipeline->optimizePipeline();
+        return pipeline;
+    }
+
+private:
+    RAIIServerParameterControllerForTest _controller{"internalQueryEnablePipelineTemplateCache",
+                                                     true};
+};
+
+TEST_F(PipelineTemplateCacheTest, CachesOptimizedPipeline) {
+    PipelineTemplateCache cache(10);
+    auto request = makeRequest("[{$match: {a: 1}}, {$match: {b: 1}}, {$project: {a: 1}}]");
+    ASSERT_TRUE(isEligible(request));
+
+    auto key = PipelineTemplateCache::makeKey(*getExpCtx(), request);
+    ASSERT_FALSE(cache.lookup(key, getExpCtx()));
+
+    auto pipeline = parseAndOptimize(request);
+    ASSERT_TRUE(cache.add(key, *pipeline));
+    ASSERT_EQ(cache.size(), 1U);
+
+    auto cached = cache.lookup(key, getExpCtx());
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(cached->getSources().size(), pipeline->getSources().size());
+    auto expected = pipeline->serializeToBson();
+    auto actual = cached->serializeToBson();
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(actual[i], expected[i]);
+    }
+
+    BSONObjBuilder stats;
+    cache.appendStats(&stats);
+    ASSERT_BSONOBJ_EQ(stats.obj(), BSON("hits" << 1LL << "misses" << 1LL << "uncacheable" << 0LL
+                                               << "entries" << 1LL));
+}
+
+TEST_F(PipelineTemplateCacheTest, KeyDependsOnCollectionAndOptions) {
+    auto request = makeRequest("[{$match: {a: 1}}]");
+    auto key = PipelineTemplateCache::makeKey(*getExpCtx(), request);
+    ASSERT_EQ(key, PipelineTemplateCache::makeKey(*getExpCtx(), request));
+
+    auto withCollation = request;
+    withCollation.setCollation(BSON("locale"
+                                    << "fr"));
+    ASSERT_NE(key, PipelineTemplateCache::makeKey(*getExpCtx(), withCollation));
+
+    auto otherCollection = getExpCtx()->copyWith(getExpCtx()->ns, UUID::gen());
+    ASSERT_NE(key, PipelineTemplateCache::makeKey(*otherCollection, request));
+}
+
+TEST_F(PipelineTemplateCacheTest, DoesNotCachePipelineWhichIsNotAFixedPoint) {
+    PipelineTemplateCache cache(10);
+    // The $sort absorbs the $limit, but serializes as separate $sort and $limit stages.
+    auto request = makeRequest("[{$sort: {a: 1}}, {$limit: 5}]");
+    ASSERT_TRUE(isEligible(request));
+
+    auto key = PipelineTemplateCache::makeKey(*getExpCtx(), request);
+    ASSERT_FALSE(cache.add(key, *parseAndOptimize(request)));
+    ASSERT_EQ(cache.size(), 0U);
+    ASSERT_FALSE(cache.lookup(key, getExpCtx()));
+}
+
+TEST_F(PipelineTemplateCacheTest, PipelineReferringToSystemVariablesIsIneligible) {
+    ASSERT_FALSE(isEligible(makeRequest("[{$match: {$expr: {$lt: ['$a', '$$NOW']}}}]")));
+    ASSERT_FALSE(isEligible(makeRequest("[{$project: {t: '$$CLUSTER_TIME.ts'}}]")));
+    ASSERT_TRUE(isEligible(makeRequest("[{$replaceWith: '$$ROOT'}]")));
+}
+
+TEST_F(PipelineTemplateCacheTest, RequestOptionsMakePipelineIneligible) {
+    auto request = makeRequest("[{$match: {a: 1}}]");
+    ASSERT_TRUE(isEligible(request));
+
+    auto withLet = request;
+    withLet.setLet(BSON("x" << 1));
+    ASSERT_FALSE(isEligible(withLet));
+
+    auto fromMongos = request;
+    fromMongos.setFromMongos(true);
+    ASSERT_FALSE(isEligible(fromMongos));
+
+    auto withLookup = makeRequest("[{$lookup: {from: 'other', as: 'out', pipeline: []}}]");
+    ASSERT_FALSE(isEligible(withLookup));
+}
+
+TEST_F(PipelineTemplateCacheTest, PipelineIsIneligibleWhenCacheIsDisabled) {
+    RAIIServerParameterControllerForTest controller("internalQueryEnablePipelineTemplateCache",
+                                                    false);
+    ASSERT_FALSE(isEligible(makeRequest("[{$match: {a: 1}}]")));
+}
+
+}  // namespace
+}  // namespace mongo
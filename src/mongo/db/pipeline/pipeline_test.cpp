@@ -2960,6 +2960,11 @@ public:
         return NamespaceString("a", "lookupColl");
     }
 
+    // Allows tests to split the pipeline as though it runs on a collection with this shard key.
+    virtual boost::optional<std::set<std::string>> getShardKeyPaths() {
+        return boost::none;
+    }
+
     BSONObj pipelineFromJsonArray(const string& array) {
         return fromjson("{pipeline: " + array + "}");
     }
@@ -2988,7 +2993,8 @@ public:
         mergePipe = Pipeline::parse(request.getPipeline(), ctx);
         mergePipe->optimizePipeline();
 
-        auto splitPipeline = sharded_agg_helpers::splitPipeline(std::move(mergePipe));
+        auto splitPipeline =
+            sharded_agg_helpers::splitPipeline(std::move(mergePipe), getShardKeyPaths());
 
         ASSERT_VALUE_EQ(Value(splitPipeline.shardsPipeline->writeExplainOps(
                             ExplainOptions::Verbosity::kQueryPlanner)),
@@ -3621,6 +3627,66 @@ class LookUp : public ShardMergerBase {
 
 }  // namespace needsPrimaryShardMerger
 
+namespace groupOnShardKey {
+
+class ShardKeyBase : public Base {
+    boost::optional<std::set<std::string>> getShardKeyPaths() override {
+        return std::set<std::string>{"a"};
+    }
+};
+
+class GroupChainOnShardKeyRunsOnShards : public ShardKeyBase {
+    string inputPipeJson() {
+        return "[{$group: {_id: {a: '$a', b: '$b'}, c: {$sum: '$c'}}}"
+               ",{$group: {_id: '$_id.a', c: {$sum: '$c'}}}"
+               "]";
+    }
+    string shardPipeJson() {
+        return "[{$group: {_id: {a: '$a', b: '$b'}, c: {$sum: '$c'}, $willBeMerged: false}}"
+               ",{$group: {_id: '$_id.a', c: {$sum: '$c'}, $willBeMerged: false}}"
+               "]";
+    }
+    string mergePipeJson() {
+        return "[]";
+    }
+};
+
+class GroupNotOnShardKeyAfterGroupOnShardKeyIsSplit : public ShardKeyBase {
+    string inputPipeJson() {
+        return "[{$group: {_id: '$a', c: {$sum: '$c'}}}"
+               ",{$group: {_id: '$c', n: {$sum: {$const: 1}}}}"
+               "]";
+    }
+    string shardPipeJson() {
+        return "[{$group: {_id: '$a', c: {$sum: '$c'}, $willBeMerged: false}}"
+               ",{$group: {_id: '$c', n: {$sum: {$const: 1}}}}"
+               "]";
+    }
+    string mergePipeJson() {
+        return "[{$group: {_id: '$$ROOT._id', n: {$sum: '$$ROOT.n'}, $doingMerge: true}}"
+               "]";
+    }
+};
+
+class GroupAfterShardKeyIsModifiedIsSplit : public ShardKeyBase {
+    string inputPipeJson() {
+        return "[{$addFields: {a: '$b'}}"
+               ",{$group: {_id: '$a', c: {$sum: '$c'}}}"
+               "]";
+    }
+    string shardPipeJson() {
+        return "[{$addFields: {a: '$b'}}"
+               ",{$group: {_id: '$a', c: {$sum: '$c'}}}"
+               "]";
+    }
+    string mergePipeJson() {
+        return "[{$group: {_id: '$$ROOT._id', c: {$sum: '$$ROOT.c'}, $doingMerge: true}}"
+               "]";
+    }
+};
+
+}  // namespace groupOnShardKey
+
 namespace mustRunOnMongoS {
 
 // Like a DocumentSourceMock, but must run on mongoS and can be used anywhere in the pipeline.
@@ -4751,6 +4817,10 @@ public:
         add<Optimizations::Sharded::needsPrimaryShardMerger::MergeWithShardedCollection>();
         add<Optimizations::Sharded::needsPrimaryShardMerger::Project>();
         add<Optimizations::Sharded::needsPrimaryShardMerger::LookUp>();
+        add<Optimizations::Sharded::groupOnShardKey::GroupChainOnShardKeyRunsOnShards>();
+        add<Optimizations::Sharded::groupOnShardKey::
+                GroupNotOnShardKeyAfterGroupOnShardKeyIsSplit>();
+        add<Optimizations::Sharded::groupOnShardKey::GroupAfterShardKeyIsModifiedIsSplit>();
     }
 };
 
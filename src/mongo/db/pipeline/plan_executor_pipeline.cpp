@@ -31,14 +31,50 @@
 
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
 
+#include <algorithm>
+
 #include "mongo/db/pipeline/change_stream_start_after_invalidate_info.h"
 #include "mongo/db/pipeline/change_stream_topology_change_info.h"
+#include "mongo/db/pipeline/document_source_add_fields.h"
+#include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_limit.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_project.h"
+#include "mongo/db/pipeline/document_source_redact.h"
+#include "mongo/db/pipeline/document_source_replace_root.h"
+#include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/pipeline_d.h"
 #include "mongo/db/pipeline/plan_explainer_pipeline.h"
 #include "mongo/db/pipeline/resume_token.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/speculative_majority_read_info.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
+namespace {
+
+/**
+ * Returns true if 'stage' is known to release each document it is given or produces before
+ * returning the next one.
+ */
+bool releasesDocuments(const DocumentSource& stage) {
+    static const StringDataSet kStages{DocumentSourceAddFields::kStageName,
+                                       DocumentSourceAddFields::kAliasNameSet,
+                                       DocumentSourceCursor::kStageName,
+                                       DocumentSourceLimit::kStageName,
+                                       DocumentSourceMatch::kStageName,
+                                       DocumentSourceProject::kStageName,
+                                       DocumentSourceProject::kAliasNameUnset,
+                                       DocumentSourceRedact::kStageName,
+                                       DocumentSourceReplaceRoot::kStageName,
+                                       DocumentSourceReplaceRoot::kAliasNameReplaceWith,
+                                       DocumentSourceSkip::kStageName,
+                                       DocumentSourceUnwind::kStageName};
+    return kStages.contains(stage.getSourceName());
+}
+
+}  // namespace
 
 PlanExecutorPipeline::PlanExecutorPipeline(boost::intrusive_ptr<ExpressionContext> expCtx,
                                            std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
@@ -55,6 +91,20 @@ PlanExecutorPipeline::PlanExecutorPipeline(boost::intrusive_ptr<ExpressionContex
     // again when it is destroyed.
     _pipeline.get_deleter().dismissDisposal();
 
+    // A document which outlives its batch keeps the arena block it was allocated from alive, so
+    // stages which hold on to documents, such as blocking stages or the cache of $lookup, would
+    // waste memory that their own accounting does not see.
+    const auto& sources = _pipeline->getSources();
+    if (internalPipelineUseDocumentArena.load() &&
+        std::all_of(sources.begin(), sources.end(), [](const auto& stage) {
+            return releasesDocuments(*stage);
+        })) {
+        _documentArena = std::make_unique<RefCountedArena>();
+        _documentArenaMemoryTracker.emplace(false /* allowDiskUse */,
+                                            0 /* maxMemoryUsageBytes */,
+                                            _expCtx->getOperationMemoryTracker());
+    }
+
     if (ResumableScanType::kNone != resumableScanType) {
         // For a resumable scan, set the initial _latestOplogTimestamp and _postBatchResumeToken.
         _initializeResumableScanState();
@@ -115,6 +165,10 @@ bool PlanExecutorPipeline::isEOF() {
 
 boost::optional<Document> PlanExecutorPipeline::_getNext() {
     auto nextDoc = _tryGetNext();
+    if (_documentArena &&
+        _documentArena->bytesAllocated() != _documentArenaMemoryTracker->currentMemoryBytes()) {
+        _documentArenaMemoryTracker->set(_documentArena->bytesAllocated());
+    }
     if (!nextDoc) {
         _pipelineIsEof = true;
     }
@@ -126,6 +180,10 @@ boost::optional<Document> PlanExecutorPipeline::_getNext() {
 }
 
 boost::optional<Document> PlanExecutorPipeline::_tryGetNext() try {
+    boost::optional<RefCountedArena::Scope> arenaScope;
+    if (_documentArena) {
+        arenaScope.emplace(_documentArena.get());
+    }
     return _pipeline->getNext();
 } catch (const ExceptionFor<ErrorCodes::ChangeStreamTopologyChange>& ex) {
     // This exception contains the next document to be returned by the pipeline.
@@ -32,9 +32,11 @@
 #include <queue>
 
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/plan_explainer_pipeline.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/util/ref_counted_arena.h"
 
 namespace mongo {
 
@@ -202,6 +204,13 @@ private:
 
     PlanExplainerPipeline _planExplainer;
 
+    // If set, the documents and values created while running '_pipeline' are allocated from this
+    // arena. Only used for pipelines which do not hold on to the documents flowing through them.
+    std::unique_ptr<RefCountedArena> _documentArena;
+
+    // Reports the memory held by the blocks of '_documentArena' to the operation's memory budget.
+    boost::optional<MemoryUsageTracker> _documentArenaMemoryTracker;
+
     std::queue<BSONObj> _stash;
 
     // If _killStatus has a non-OK value, then we have been killed and the value represents the
@@ -274,11 +274,8 @@ Status CommonMongodProcessInterface::appendQueryExecStats(OperationContext* opCt
 
 BSONObj CommonMongodProcessInterface::getCollectionOptionsLocally(OperationContext* opCtx,
                                                                   const NamespaceString& nss) {
-    AutoGetCollectionForReadCommand collection(opCtx, nss);
+    AutoGetCollectionForReadCommandMaybeLockFree collection(opCtx, nss);
     BSONObj collectionOptions = {};
-    if (!collection.getDb()) {
-        return collectionOptions;
-    }
     if (!collection) {
         return collectionOptions;
     }
@@ -330,13 +327,12 @@ std::vector<GenericCursor> CommonMongodProcessInterface::getIdleCursors(
     return CursorManager::get(expCtx->opCtx)->getIdleCursors(expCtx->opCtx, userMode);
 }
 
-boost::optional<Document> CommonMongodProcessInterface::doLookupSingleDocument(
+std::unique_ptr<Pipeline, PipelineDeleter> CommonMongodProcessInterface::_makeLookupPipeline(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
     UUID collectionUUID,
-    const Document& documentKey,
+    const Document& filter,
     MakePipelineOptions opts) {
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
     try {
         // Be sure to do the lookup using the collection default collation
         auto foreignExpCtx = expCtx->copyWith(
@@ -349,8 +345,20 @@ boost::optional<Document> CommonMongodProcessInterface::doLookupSingleDocument(
         // context so that we actually retrieve the document.
         foreignExpCtx->explain = boost::none;
 
-        pipeline = Pipeline::makePipeline({BSON("$match" << documentKey)}, foreignExpCtx, opts);
+        return Pipeline::makePipeline({BSON("$match" << filter)}, foreignExpCtx, opts);
     } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        return nullptr;
+    }
+}
+
+boost::optional<Document> CommonMongodProcessInterface::doLookupSingleDocument(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const Document& documentKey,
+    MakePipelineOptions opts) {
+    auto pipeline = _makeLookupPipeline(expCtx, nss, collectionUUID, documentKey, std::move(opts));
+    if (!pipeline) {
         return boost::none;
     }
 
@@ -365,6 +373,24 @@ boost::optional<Document> CommonMongodProcessInterface::doLookupSingleDocument(
     return lookedUpDocument;
 }
 
+std::vector<Document> CommonMongodProcessInterface::doLookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const Document& filter,
+    MakePipelineOptions opts) {
+    auto pipeline = _makeLookupPipeline(expCtx, nss, collectionUUID, filter, std::move(opts));
+    if (!pipeline) {
+        return {};
+    }
+
+    std::vector<Document> documents;
+    while (auto next = pipeline->getNext()) {
+        documents.push_back(std::move(*next));
+    }
+    return documents;
+}
+
 BackupCursorState CommonMongodProcessInterface::openBackupCursor(
     OperationContext* opCtx, const StorageEngine::BackupOptions& options) {
     auto backupCursorHooks = BackupCursorHooks::get(opCtx->getServiceContext());
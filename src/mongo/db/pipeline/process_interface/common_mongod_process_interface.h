@@ -133,6 +133,12 @@ protected:
         const Document& documentKey,
         MakePipelineOptions opts);
 
+    std::vector<Document> doLookupDocuments(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                            const NamespaceString& nss,
+                                            UUID collectionUUID,
+                                            const Document& filter,
+                                            MakePipelineOptions opts);
+
     /**
      * Builds an ordered insert op on namespace 'nss' and documents to be written 'objs'.
      */
@@ -188,6 +194,18 @@ private:
                                                                      StringData dbName,
                                                                      UUID collectionUUID);
 
+    /**
+     * Makes a pipeline which returns the documents matching 'filter' in the collection given by
+     * 'collectionUUID', using the collection default collation. Returns nullptr if the collection
+     * does not exist.
+     */
+    std::unique_ptr<Pipeline, PipelineDeleter> _makeLookupPipeline(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const Document& filter,
+        MakePipelineOptions opts);
+
     std::map<UUID, std::unique_ptr<const CollatorInterface>> _collatorCache;
 
     // Object which contains a JavaScript Scope, used for executing JS in pipeline stages and
@@ -254,6 +254,15 @@ public:
                                                 const NamespaceString& ns,
                                                 const std::vector<BSONObj>& indexSpecs) = 0;
 
+    /**
+     * Builds the given indexes on 'ns', which may already hold documents, the way the
+     * createIndexes command does. If running on a shardsvr this targets the primary shard of the
+     * database part of 'ns'.
+     */
+    virtual void createIndexesOnPopulatedCollection(OperationContext* opCtx,
+                                                    const NamespaceString& ns,
+                                                    const std::vector<BSONObj>& indexSpecs) = 0;
+
     virtual void dropCollection(OperationContext* opCtx, const NamespaceString& collection) = 0;
 
     /**
@@ -274,6 +283,14 @@ public:
         ShardTargetingPolicy shardTargetingPolicy = ShardTargetingPolicy::kAllowed,
         boost::optional<BSONObj> readConcern = boost::none) = 0;
 
+    /**
+     * Given a pipeline returned by attachCursorSourceToPipeline(), starts any remote work needed
+     * to produce its first results without waiting for that work to complete. A pipeline which
+     * reads locally shares this operation's OperationContext and so cannot make progress ahead of
+     * being iterated; in that case this does nothing.
+     */
+    virtual void prefetchRemoteResults(Pipeline* pipeline) {}
+
     /**
      * Accepts a pipeline and attaches a cursor source to it. Returns a BSONObj of the form
      * {"pipeline": <explainOutput>}. Note that <explainOutput> can be an object (shardsvr) or an
@@ -366,6 +383,22 @@ public:
         const Document& documentKey,
         boost::optional<BSONObj> readConcern) = 0;
 
+    /**
+     * Returns the documents which match 'filter', so that several documents can be looked up with a
+     * single request rather than one lookupSingleDocument() call each. Returns no documents if the
+     * namespace does not exist. The lookup may return only those matches which fit in a single
+     * batch from each node it sends a request to, so callers must look up individually any document
+     * they expected but did not find.
+     *
+     * 'readConcern' is attached to any requests as in lookupSingleDocument().
+     */
+    virtual std::vector<Document> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const Document& filter,
+        boost::optional<BSONObj> readConcern) = 0;
+
     /**
      * Returns a vector of all idle (non-pinned) local cursors.
      */
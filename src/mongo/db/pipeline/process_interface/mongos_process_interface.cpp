@@ -78,6 +78,77 @@ StatusWith<ChunkManager> getCollectionRoutingInfo(
     return swRoutingInfo;
 }
 
+/**
+ * Sends a find command with the filter 'filterObj' to the shards which may own matching documents
+ * of the collection 'nss' with UUID 'collectionUUID', and returns the cursors it establishes. The
+ * fields of 'cmdExtras' are added to each find command.
+ */
+std::vector<RemoteCursor> establishLookupCursors(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const BSONObj& filterObj,
+    const BSONObj& cmdExtras,
+    boost::optional<BSONObj> readConcern) {
+    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID);
+
+    // Create the find command to be dispatched to the shard(s) in order to return the documents.
+    BSONObjBuilder cmdBuilder;
+    bool findCmdIsByUuid(foreignExpCtx->uuid);
+    if (findCmdIsByUuid) {
+        foreignExpCtx->uuid->appendToBuilder(&cmdBuilder, "find");
+    } else {
+        cmdBuilder.append("find", nss.coll());
+    }
+    cmdBuilder.append("filter", filterObj);
+    cmdBuilder.append("allowSpeculativeMajorityRead", true);
+    cmdBuilder.appendElements(cmdExtras);
+    if (readConcern) {
+        cmdBuilder.append(repl::ReadConcernArgs::kReadConcernFieldName, *readConcern);
+    }
+
+    auto findCmd = cmdBuilder.obj();
+    auto catalogCache = Grid::get(expCtx->opCtx)->catalogCache();
+    return shardVersionRetry(
+        expCtx->opCtx,
+        catalogCache,
+        foreignExpCtx->ns,
+        str::stream() << "Looking up document matching " << redact(filterObj),
+        [&]() -> std::vector<RemoteCursor> {
+            // Verify that the collection exists, with the correct UUID.
+            auto cm = uassertStatusOK(getCollectionRoutingInfo(foreignExpCtx));
+
+            // Finalize the 'find' command object based on the routing table information.
+            if (findCmdIsByUuid && cm.isSharded()) {
+                // Find by UUID and shard versioning do not work together (SERVER-31946).  In
+                // the sharded case we've already checked the UUID, so find by namespace is
+                // safe.  In the unlikely case that the collection has been deleted and a new
+                // collection with the same name created through a different mongos or the
+                // collection had its shard key refined, the shard version will be detected as
+                // stale, as shard versions contain an 'epoch' field unique to the collection.
+                findCmd = findCmd.addField(BSON("find" << nss.coll()).firstElement());
+                findCmdIsByUuid = false;
+            }
+
+            // Build the versioned requests to be dispatched to the shards. Typically, only a
+            // single shard will be targeted here; however, in certain cases where only the _id
+            // is present, we may need to scatter-gather the query to all shards in order to
+            // find the document.
+            auto requests = getVersionedRequestsForTargetedShards(
+                expCtx->opCtx, nss, cm, findCmd, filterObj, CollationSpec::kSimpleSpec);
+
+            // Dispatch the requests. The 'establishCursors' method conveniently prepares the
+            // result into a vector of cursor responses for us.
+            return establishCursors(
+                expCtx->opCtx,
+                Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                nss,
+                ReadPreferenceSetting::get(expCtx->opCtx),
+                std::move(requests),
+                false);
+        });
+}
+
 bool supportsUniqueKey(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                        const BSONObj& index,
                        const std::set<FieldPath>& uniqueKeyPaths) {
@@ -112,6 +183,10 @@ std::unique_ptr<Pipeline, PipelineDeleter> MongosProcessInterface::attachCursorS
         ownedPipeline, shardTargetingPolicy, std::move(readConcern));
 }
 
+void MongosProcessInterface::prefetchRemoteResults(Pipeline* pipeline) {
+    sharded_agg_helpers::prefetchRemoteCursors(pipeline);
+}
+
 BSONObj MongosProcessInterface::preparePipelineAndExplain(Pipeline* ownedPipeline,
                                                           ExplainOptions::Verbosity verbosity) {
     auto firstStage = ownedPipeline->peekFront();
@@ -130,64 +205,9 @@ boost::optional<Document> MongosProcessInterface::lookupSingleDocument(
     UUID collectionUUID,
     const Document& filter,
     boost::optional<BSONObj> readConcern) {
-    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID);
-
-    // Create the find command to be dispatched to the shard(s) in order to return the post-image.
-    auto filterObj = filter.toBson();
-    BSONObjBuilder cmdBuilder;
-    bool findCmdIsByUuid(foreignExpCtx->uuid);
-    if (findCmdIsByUuid) {
-        foreignExpCtx->uuid->appendToBuilder(&cmdBuilder, "find");
-    } else {
-        cmdBuilder.append("find", nss.coll());
-    }
-    cmdBuilder.append("filter", filterObj);
-    cmdBuilder.append("allowSpeculativeMajorityRead", true);
-    if (readConcern) {
-        cmdBuilder.append(repl::ReadConcernArgs::kReadConcernFieldName, *readConcern);
-    }
-
     try {
-        auto findCmd = cmdBuilder.obj();
-        auto catalogCache = Grid::get(expCtx->opCtx)->catalogCache();
-        auto shardResults = shardVersionRetry(
-            expCtx->opCtx,
-            catalogCache,
-            foreignExpCtx->ns,
-            str::stream() << "Looking up document matching " << redact(filter.toBson()),
-            [&]() -> std::vector<RemoteCursor> {
-                // Verify that the collection exists, with the correct UUID.
-                auto cm = uassertStatusOK(getCollectionRoutingInfo(foreignExpCtx));
-
-                // Finalize the 'find' command object based on the routing table information.
-                if (findCmdIsByUuid && cm.isSharded()) {
-                    // Find by UUID and shard versioning do not work together (SERVER-31946).  In
-                    // the sharded case we've already checked the UUID, so find by namespace is
-                    // safe.  In the unlikely case that the collection has been deleted and a new
-                    // collection with the same name created through a different mongos or the
-                    // collection had its shard key refined, the shard version will be detected as
-                    // stale, as shard versions contain an 'epoch' field unique to the collection.
-                    findCmd = findCmd.addField(BSON("find" << nss.coll()).firstElement());
-                    findCmdIsByUuid = false;
-                }
-
-                // Build the versioned requests to be dispatched to the shards. Typically, only a
-                // single shard will be targeted here; however, in certain cases where only the _id
-                // is present, we may need to scatter-gather the query to all shards in order to
-                // find the document.
-                auto requests = getVersionedRequestsForTargetedShards(
-                    expCtx->opCtx, nss, cm, findCmd, filterObj, CollationSpec::kSimpleSpec);
-
-                // Dispatch the requests. The 'establishCursors' method conveniently prepares the
-                // result into a vector of cursor responses for us.
-                return establishCursors(
-                    expCtx->opCtx,
-                    Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor(),
-                    nss,
-                    ReadPreferenceSetting::get(expCtx->opCtx),
-                    std::move(requests),
-                    false);
-            });
+        auto shardResults = establishLookupCursors(
+            expCtx, nss, collectionUUID, filter.toBson(), BSONObj(), std::move(readConcern));
 
         // Iterate all shard results and build a single composite batch. We also enforce the
         // requirement that only a single document should have been returned from across the
@@ -218,6 +238,34 @@ boost::optional<Document> MongosProcessInterface::lookupSingleDocument(
     }
 }
 
+std::vector<Document> MongosProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const Document& filter,
+    boost::optional<BSONObj> readConcern) {
+    try {
+        // Each shard closes its cursor after the first batch, which holds every match unless they
+        // exceed the maximum batch size. The caller looks up any which are missing individually.
+        auto shardResults = establishLookupCursors(expCtx,
+                                                   nss,
+                                                   collectionUUID,
+                                                   filter.toBson(),
+                                                   BSON("singleBatch" << true),
+                                                   std::move(readConcern));
+
+        std::vector<Document> documents;
+        for (auto&& shardResult : shardResults) {
+            for (auto&& obj : shardResult.getCursorResponse().getBatch()) {
+                documents.emplace_back(obj);
+            }
+        }
+        return documents;
+    } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        return {};
+    }
+}
+
 BSONObj MongosProcessInterface::_reportCurrentOpForClient(
     OperationContext* opCtx,
     Client* client,
@@ -52,6 +52,12 @@ public:
         const Document& documentKey,
         boost::optional<BSONObj> readConcern) final;
 
+    std::vector<Document> lookupDocuments(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                          const NamespaceString& nss,
+                                          UUID collectionUUID,
+                                          const Document& filter,
+                                          boost::optional<BSONObj> readConcern) final;
+
     std::vector<GenericCursor> getIdleCursors(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                               CurrentOpUserMode userMode) const final;
 
@@ -143,6 +149,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    void createIndexesOnPopulatedCollection(OperationContext* opCtx,
+                                            const NamespaceString& ns,
+                                            const std::vector<BSONObj>& indexSpecs) final {
+        MONGO_UNREACHABLE;
+    }
+
     void dropCollection(OperationContext* opCtx, const NamespaceString& collection) final {
         MONGO_UNREACHABLE;
     }
@@ -237,6 +249,8 @@ public:
         ShardTargetingPolicy shardTargetingPolicy = ShardTargetingPolicy::kAllowed,
         boost::optional<BSONObj> readConcern = boost::none) final;
 
+    void prefetchRemoteResults(Pipeline* pipeline) final;
+
     std::unique_ptr<TemporaryRecordStore> createTemporaryRecordStore(
         const boost::intrusive_ptr<ExpressionContext>& expCtx) const final {
         MONGO_UNREACHABLE;
@@ -35,14 +35,41 @@
 #include "mongo/db/catalog/drop_collection.h"
 #include "mongo/db/catalog/list_indexes.h"
 #include "mongo/db/catalog/rename_collection.h"
+#include "mongo/db/client.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index_builds_coordinator.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/repl/repl_client_info.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/speculative_majority_read_info.h"
+#include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
 
 namespace mongo {
+namespace {
+
+/**
+ * Sets the speculative read timestamp appropriately after we do a document lookup locally. We set
+ * the speculative read timestamp based on the timestamp used by the transaction.
+ */
+void setSpeculativeReadTimestampAfterLookup(OperationContext* opCtx) {
+    repl::SpeculativeMajorityReadInfo& speculativeMajorityReadInfo =
+        repl::SpeculativeMajorityReadInfo::get(opCtx);
+    if (speculativeMajorityReadInfo.isSpeculativeRead()) {
+        // Speculative majority reads are required to use the 'kNoOverlap' read source.
+        // Storage engine operations require at least Global IS.
+        Lock::GlobalLock lk(opCtx, MODE_IS);
+        invariant(opCtx->recoveryUnit()->getTimestampReadSource() ==
+                  RecoveryUnit::ReadSource::kNoOverlap);
+        boost::optional<Timestamp> readTs =
+            opCtx->recoveryUnit()->getPointInTimeReadTimestamp(opCtx);
+        invariant(readTs);
+        speculativeMajorityReadInfo.setSpeculativeReadTimestampForward(*readTs);
+    }
+}
+
+}  // namespace
 
 std::unique_ptr<Pipeline, PipelineDeleter>
 NonShardServerProcessInterface::attachCursorSourceToPipeline(
@@ -81,24 +108,24 @@ boost::optional<Document> NonShardServerProcessInterface::lookupSingleDocument(
 
     auto lookedUpDocument =
         doLookupSingleDocument(expCtx, nss, collectionUUID, documentKey, std::move(opts));
+    setSpeculativeReadTimestampAfterLookup(expCtx->opCtx);
+    return lookedUpDocument;
+}
 
-    // Set the speculative read timestamp appropriately after we do a document lookup locally. We
-    // set the speculative read timestamp based on the timestamp used by the transaction.
-    repl::SpeculativeMajorityReadInfo& speculativeMajorityReadInfo =
-        repl::SpeculativeMajorityReadInfo::get(expCtx->opCtx);
-    if (speculativeMajorityReadInfo.isSpeculativeRead()) {
-        // Speculative majority reads are required to use the 'kNoOverlap' read source.
-        // Storage engine operations require at least Global IS.
-        Lock::GlobalLock lk(expCtx->opCtx, MODE_IS);
-        invariant(expCtx->opCtx->recoveryUnit()->getTimestampReadSource() ==
-                  RecoveryUnit::ReadSource::kNoOverlap);
-        boost::optional<Timestamp> readTs =
-            expCtx->opCtx->recoveryUnit()->getPointInTimeReadTimestamp(expCtx->opCtx);
-        invariant(readTs);
-        speculativeMajorityReadInfo.setSpeculativeReadTimestampForward(*readTs);
-    }
+std::vector<Document> NonShardServerProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const Document& filter,
+    boost::optional<BSONObj> readConcern) {
+    MakePipelineOptions opts;
+    opts.shardTargetingPolicy = ShardTargetingPolicy::kNotAllowed;
+    opts.readConcern = std::move(readConcern);
 
-    return lookedUpDocument;
+    auto lookedUpDocuments =
+        doLookupDocuments(expCtx, nss, collectionUUID, filter, std::move(opts));
+    setSpeculativeReadTimestampAfterLookup(expCtx->opCtx);
+    return lookedUpDocuments;
 }
 
 Status NonShardServerProcessInterface::insert(const boost::intrusive_ptr<ExpressionContext>& expCtx,
@@ -179,6 +206,77 @@ void NonShardServerProcessInterface::createIndexesOnEmptyCollection(
             wuow.commit();
         });
 }
+
+void NonShardServerProcessInterface::createIndexesOnPopulatedCollection(
+    OperationContext* opCtx, const NamespaceString& ns, const std::vector<BSONObj>& indexSpecs) {
+    // Build the indexes as the createIndexes command does. Unless the writes to 'ns' are not
+    // replicated, this is a two-phase build: it yields its locks while scanning the collection,
+    // and the secondaries build the indexes concurrently rather than while applying the oplog.
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    auto protocol = !replCoord->isOplogDisabledFor(opCtx, ns) ? IndexBuildProtocol::kTwoPhase
+                                                              : IndexBuildProtocol::kSinglePhase;
+    IndexBuildsCoordinator::IndexBuildOptions indexBuildOptions;
+    if (IndexBuildProtocol::kTwoPhase == protocol) {
+        // Setting the commit quorum to 0 opts the index build out of the voting process.
+        const bool commitQuorumEnabled = replCoord->isReplEnabled() && enableIndexBuildCommitQuorum;
+        indexBuildOptions.commitQuorum = commitQuorumEnabled
+            ? CommitQuorumOptions(CommitQuorumOptions::kVotingMembers)
+            : CommitQuorumOptions(CommitQuorumOptions::kDisabled);
+        uassertStatusOK(
+            replCoord->checkIfCommitQuorumCanBeSatisfied(*indexBuildOptions.commitQuorum));
+    }
+
+    auto collectionUUID = [&] {
+        AutoGetCollection autoColl(opCtx, ns, MODE_IS);
+        uassert(ErrorCodes::DatabaseDropPending,
+                str::stream() << "The database is in the process of being dropped " << ns.db(),
+                autoColl.getDb() && !autoColl.getDb()->isDropPending(opCtx));
+
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Failed to create indexes for aggregation because collection "
+                                 "does not exist: "
+                              << ns << ": " << BSON("indexes" << indexSpecs),
+                autoColl.getCollection());
+        return autoColl->uuid();
+    }();
+
+    auto indexBuildsCoord = IndexBuildsCoordinator::get(opCtx);
+    auto buildUUID = UUID::gen();
+    auto buildIndexFuture = uassertStatusOK(indexBuildsCoord->startIndexBuild(opCtx,
+                                                                              ns.db().toString(),
+                                                                              collectionUUID,
+                                                                              indexSpecs,
+                                                                              buildUUID,
+                                                                              protocol,
+                                                                              indexBuildOptions));
+    try {
+        buildIndexFuture.get(opCtx);
+    } catch (const DBException& ex) {
+        // After a stepdown, a two-phase build is committed or aborted by the new primary.
+        if (IndexBuildProtocol::kTwoPhase == protocol &&
+            (ex.code() == ErrorCodes::InterruptedDueToReplStateChange ||
+             ErrorCodes::isNotPrimaryError(ex.code()))) {
+            throw;
+        }
+
+        // Otherwise abort the build, which is a no-op if it already failed, rather than leave it
+        // running on the temporary collection. The current OperationContext may be interrupted,
+        // so use a new one.
+        auto newClient = opCtx->getServiceContext()->makeClient("abort-index-build");
+        AlternativeClientRegion acr(newClient);
+        const auto abortCtx = cc().makeOperationContext();
+        indexBuildsCoord->abortIndexBuildByBuildUUID(
+            abortCtx.get(),
+            buildUUID,
+            IndexBuildAction::kPrimaryAbort,
+            str::stream() << "Index build aborted: " << buildUUID << ": " << ex.toString());
+        throw;
+    }
+
+    // The IndexBuildsCoordinator may write the oplog entries of the build on a different thread.
+    repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOpToSystemLastOpTime(opCtx);
+}
+
 void NonShardServerProcessInterface::renameIfOptionsAndIndexesHaveNotChanged(
     OperationContext* opCtx,
     const BSONObj& renameCommandObj,
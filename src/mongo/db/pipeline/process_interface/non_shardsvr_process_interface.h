@@ -88,6 +88,12 @@ public:
         const Document& documentKey,
         boost::optional<BSONObj> readConcern) final;
 
+    std::vector<Document> lookupDocuments(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                          const NamespaceString& nss,
+                                          UUID collectionUUID,
+                                          const Document& filter,
+                                          boost::optional<BSONObj> readConcern) final;
+
     Status insert(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                   const NamespaceString& ns,
                   std::vector<BSONObj>&& objs,
@@ -119,6 +125,10 @@ public:
                                         const NamespaceString& ns,
                                         const std::vector<BSONObj>& indexSpecs) override;
 
+    void createIndexesOnPopulatedCollection(OperationContext* opCtx,
+                                            const NamespaceString& ns,
+                                            const std::vector<BSONObj>& indexSpecs) override;
+
     void setExpectedShardVersion(OperationContext* opCtx,
                                  const NamespaceString& nss,
                                  boost::optional<ChunkVersion> chunkVersion) override {
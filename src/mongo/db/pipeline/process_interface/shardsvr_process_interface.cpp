@@ -142,6 +142,21 @@ boost::optional<Document> ShardServerProcessInterface::lookupSingleDocument(
     return doLookupSingleDocument(expCtx, nss, collectionUUID, documentKey, std::move(opts));
 }
 
+std::vector<Document> ShardServerProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const Document& filter,
+    boost::optional<BSONObj> readConcern) {
+    MakePipelineOptions opts;
+    opts.shardTargetingPolicy = nss.isNamespaceAlwaysUnsharded()
+        ? ShardTargetingPolicy::kNotAllowed
+        : ShardTargetingPolicy::kForceTargetingWithSimpleCollation;
+    opts.readConcern = std::move(readConcern);
+
+    return doLookupDocuments(expCtx, nss, collectionUUID, filter, std::move(opts));
+}
+
 Status ShardServerProcessInterface::insert(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                            const NamespaceString& ns,
                                            std::vector<BSONObj>&& objs,
@@ -374,6 +389,13 @@ void ShardServerProcessInterface::createIndexesOnEmptyCollection(
         });
 }
 
+void ShardServerProcessInterface::createIndexesOnPopulatedCollection(
+    OperationContext* opCtx, const NamespaceString& ns, const std::vector<BSONObj>& indexSpecs) {
+    // The createIndexes command run against the primary shard builds the indexes whether or not
+    // the collection holds documents.
+    createIndexesOnEmptyCollection(opCtx, ns, indexSpecs);
+}
+
 void ShardServerProcessInterface::dropCollection(OperationContext* opCtx,
                                                  const NamespaceString& ns) {
     // Build and execute the dropCollection command against the primary shard of the given
@@ -411,6 +433,10 @@ ShardServerProcessInterface::attachCursorSourceToPipeline(Pipeline* ownedPipelin
         ownedPipeline, shardTargetingPolicy, std::move(readConcern));
 }
 
+void ShardServerProcessInterface::prefetchRemoteResults(Pipeline* pipeline) {
+    sharded_agg_helpers::prefetchRemoteCursors(pipeline);
+}
+
 void ShardServerProcessInterface::setExpectedShardVersion(
     OperationContext* opCtx,
     const NamespaceString& nss,
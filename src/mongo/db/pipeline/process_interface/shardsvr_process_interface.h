@@ -78,6 +78,12 @@ public:
         const Document& documentKey,
         boost::optional<BSONObj> readConcern) final;
 
+    std::vector<Document> lookupDocuments(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                          const NamespaceString& nss,
+                                          UUID collectionUUID,
+                                          const Document& filter,
+                                          boost::optional<BSONObj> readConcern) final;
+
     /**
      * Inserts the documents 'objs' into the namespace 'ns' using the ClusterWriter for locking,
      * routing, stale config handling, etc.
@@ -122,6 +128,9 @@ public:
     void createIndexesOnEmptyCollection(OperationContext* opCtx,
                                         const NamespaceString& ns,
                                         const std::vector<BSONObj>& indexSpecs) final;
+    void createIndexesOnPopulatedCollection(OperationContext* opCtx,
+                                            const NamespaceString& ns,
+                                            const std::vector<BSONObj>& indexSpecs) final;
     void dropCollection(OperationContext* opCtx, const NamespaceString& collection) final;
 
     /**
@@ -135,6 +144,8 @@ public:
         ShardTargetingPolicy shardTargetingPolicy = ShardTargetingPolicy::kAllowed,
         boost::optional<BSONObj> readConcern = boost::none) final;
 
+    void prefetchRemoteResults(Pipeline* pipeline) final;
+
     void setExpectedShardVersion(OperationContext* opCtx,
                                  const NamespaceString& nss,
                                  boost::optional<ChunkVersion> chunkVersion) final;
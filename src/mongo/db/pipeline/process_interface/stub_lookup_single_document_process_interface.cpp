@@ -83,4 +83,25 @@ boost::optional<Document> StubLookupSingleDocumentProcessInterface::lookupSingle
     return lookedUpDocument;
 }
 
+std::vector<Document> StubLookupSingleDocumentProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const Document& filter,
+    boost::optional<BSONObj> readConcern) {
+    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID, boost::none);
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    try {
+        pipeline = Pipeline::makePipeline({BSON("$match" << filter)}, foreignExpCtx);
+    } catch (ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        return {};
+    }
+
+    std::vector<Document> lookedUpDocuments;
+    while (auto next = pipeline->getNext()) {
+        lookedUpDocuments.push_back(std::move(*next));
+    }
+    return lookedUpDocuments;
+}
+
 }  // namespace mongo
@@ -87,6 +87,12 @@ public:
         const Document& documentKey,
         boost::optional<BSONObj> readConcern);
 
+    std::vector<Document> lookupDocuments(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                          const NamespaceString& nss,
+                                          UUID collectionUUID,
+                                          const Document& filter,
+                                          boost::optional<BSONObj> readConcern) final;
+
     std::unique_ptr<ShardFilterer> getShardFilterer(
         const boost::intrusive_ptr<ExpressionContext>& expCtx) const override {
         // Try to emulate the behavior mongos and mongod would each follow.
@@ -140,6 +140,11 @@ public:
                                         const std::vector<BSONObj>& indexSpecs) override {
         MONGO_UNREACHABLE;
     }
+    void createIndexesOnPopulatedCollection(OperationContext* opCtx,
+                                            const NamespaceString& ns,
+                                            const std::vector<BSONObj>& indexSpecs) override {
+        MONGO_UNREACHABLE;
+    }
     void dropCollection(OperationContext* opCtx, const NamespaceString& ns) override {
         MONGO_UNREACHABLE;
     }
@@ -203,6 +208,14 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<Document> lookupDocuments(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                          const NamespaceString& nss,
+                                          UUID collectionUUID,
+                                          const Document& filter,
+                                          boost::optional<BSONObj> readConcern) override {
+        MONGO_UNREACHABLE;
+    }
+
     std::vector<GenericCursor> getIdleCursors(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                               CurrentOpUserMode userMode) const {
         MONGO_UNREACHABLE;
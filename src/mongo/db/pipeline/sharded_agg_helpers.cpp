@@ -50,6 +50,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/pipeline/semantic_analysis.h"
+#include "mongo/db/query/query_feature_flags_gen.h"
 #include "mongo/db/vector_clock.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
@@ -237,21 +238,58 @@ std::set<ShardId> getTargetedShards(boost::intrusive_ptr<ExpressionContext> expC
     return getTargetedShardsForQuery(expCtx, *cm, shardQuery, collation);
 }
 
+/**
+ * Returns true if 'stage' is a $group which groups on all of 'shardKeyPaths', the names of the
+ * shard key fields as they are on entry to the stage. Every document of such a group lives on the
+ * same shard, so the group can be computed entirely on the shards without a merging $group.
+ */
+bool groupCanRunEntirelyOnShards(DocumentSource* stage,
+                                 const boost::optional<std::set<std::string>>& shardKeyPaths) {
+    auto group = dynamic_cast<DocumentSourceGroup*>(stage);
+    return group && shardKeyPaths && !group->doingMerge() &&
+        group->canRunInParallelBeforeWriteStage(*shardKeyPaths);
+}
+
 /**
  * Moves everything before a splittable stage to the shards. If there are no splittable stages,
  * moves everything to the shards.
  *
+ * If 'shardKeyPaths' is given, a $group which groups on the shard key is not treated as a split
+ * point and runs in full on the shards. The names of the shard key fields are tracked through the
+ * stages moved to the shards, so that a chain of such $group stages can all run on the shards.
+ *
  * It is not safe to call this optimization multiple times.
  *
  * Returns the sort specification if the input streams are sorted, and false otherwise.
  */
-boost::optional<BSONObj> findSplitPoint(Pipeline::SourceContainer* shardPipe, Pipeline* mergePipe) {
+boost::optional<BSONObj> findSplitPoint(Pipeline::SourceContainer* shardPipe,
+                                        Pipeline* mergePipe,
+                                        boost::optional<std::set<std::string>> shardKeyPaths) {
     while (!mergePipe->getSources().empty()) {
         boost::intrusive_ptr<DocumentSource> current = mergePipe->popFront();
 
+        const bool groupOnShardKey = groupCanRunEntirelyOnShards(current.get(), shardKeyPaths);
+        if (groupOnShardKey) {
+            static_cast<DocumentSourceGroup*>(current.get())->setWillBeMerged(false);
+        }
+
         // Check if this source is splittable.
-        auto distributedPlanLogic = current->distributedPlanLogic();
+        auto distributedPlanLogic = groupOnShardKey ? boost::none : current->distributedPlanLogic();
         if (!distributedPlanLogic) {
+            // Keep track of the names of the shard key fields after this stage, or stop looking for
+            // $group stages on the shard key if this stage modifies any of them.
+            if (shardKeyPaths) {
+                auto renames = semantic_analysis::renamedPaths(
+                    *shardKeyPaths, *current, semantic_analysis::Direction::kForward);
+                shardKeyPaths = boost::none;
+                if (renames) {
+                    shardKeyPaths.emplace();
+                    for (auto&& rename : *renames) {
+                        shardKeyPaths->insert(rename.second);
+                    }
+                }
+            }
+
             // Move the source from the merger _sources to the shard _sources.
             shardPipe->push_back(current);
             continue;
@@ -783,14 +821,16 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, cm);
 }
 
-SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
+SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+                            boost::optional<std::set<std::string>> shardKeyPaths) {
     auto& expCtx = pipeline->getContext();
     // Re-brand 'pipeline' as the merging pipeline. We will move stages one by one from the merging
     // half to the shards, as possible.
     auto mergePipeline = std::move(pipeline);
 
     Pipeline::SourceContainer shardStages;
-    boost::optional<BSONObj> inputsSort = findSplitPoint(&shardStages, mergePipeline.get());
+    boost::optional<BSONObj> inputsSort =
+        findSplitPoint(&shardStages, mergePipeline.get(), std::move(shardKeyPaths));
     auto shardsPipeline = Pipeline::create(std::move(shardStages), expCtx);
 
     // The order in which optimizations are applied can have significant impact on the efficiency of
@@ -961,7 +1001,20 @@ DispatchShardPipelineResults dispatchShardPipeline(
                     "shardIds_size"_attr = shardIds.size(),
                     "needsMongosMerge"_attr = needsMongosMerge,
                     "needsPrimaryShardMerge"_attr = needsPrimaryShardMerge);
-        splitPipelines = splitPipeline(std::move(pipeline));
+        // A $group on the shard key can be computed entirely on the shards, since every document
+        // with a given shard key value lives on the same shard. This only holds when the group key
+        // is compared with the simple collation, the same one used to place documents in chunks.
+        boost::optional<std::set<std::string>> shardKeyPaths;
+        if (executionNsRoutingInfo && executionNsRoutingInfo->isSharded() &&
+            !expCtx->getCollator() &&
+            feature_flags::gFeatureFlagShardKeyGroupPushdown.isEnabled(
+                serverGlobalParams.featureCompatibility)) {
+            shardKeyPaths.emplace();
+            for (auto&& path : executionNsRoutingInfo->getShardKeyPattern().getKeyPatternFields()) {
+                shardKeyPaths->emplace(path->dottedField().toString());
+            }
+        }
+        splitPipelines = splitPipeline(std::move(pipeline), std::move(shardKeyPaths));
 
         exchangeSpec = checkIfEligibleForExchange(opCtx, splitPipelines->mergePipeline.get());
     }
@@ -1298,4 +1351,14 @@ std::unique_ptr<Pipeline, PipelineDeleter> attachCursorToPipeline(
         });
 }
 
+void prefetchRemoteCursors(Pipeline* pipeline) {
+    if (pipeline->getSources().empty()) {
+        return;
+    }
+    if (auto mergeCursors =
+            dynamic_cast<DocumentSourceMergeCursors*>(pipeline->getSources().front().get())) {
+        mergeCursors->prefetch();
+    }
+}
+
 }  // namespace mongo::sharded_agg_helpers
@@ -113,8 +113,13 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
  * The 'mergePipeline' returned as part of the SplitPipeline here is not ready to execute until the
  * 'shardsPipeline' has been sent to the shards and cursors have been established. Once cursors have
  * been established, the merge pipeline can be made executable by calling 'addMergeCursorsSource()'
+ *
+ * If 'shardKeyPaths' is given, any $group ahead of the split point which groups on all of those
+ * paths is run to completion on the shards instead of being split, since none of its groups can
+ * span more than one shard.
  */
-SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline);
+SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline,
+                            boost::optional<std::set<std::string>> shardKeyPaths = boost::none);
 
 /**
  * Targets shards for the pipeline and returns a struct with the remote cursors or results, and
@@ -198,6 +203,13 @@ std::unique_ptr<Pipeline, PipelineDeleter> attachCursorToPipeline(
     ShardTargetingPolicy shardTargetingPolicy = ShardTargetingPolicy::kAllowed,
     boost::optional<BSONObj> readConcern = boost::none);
 
+/**
+ * If 'pipeline' begins with a $mergeCursors stage, asks each of its remote cursors to start
+ * producing the next batch without waiting for the responses. Pipelines which read locally are
+ * left untouched.
+ */
+void prefetchRemoteCursors(Pipeline* pipeline);
+
 /**
  * For a sharded collection, establishes remote cursors on each shard that may have results, and
  * creates a DocumentSourceMergeCursors stage to merge the remote cursors. Returns a pipeline
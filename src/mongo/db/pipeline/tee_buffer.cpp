@@ -34,6 +34,7 @@
 #include <algorithm>
 
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/util/bufreader.h"
 
 namespace mongo {
 
@@ -50,13 +51,15 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
-    size_t nConsumersStillProcessingThisBatch =
-        std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-            return info.nLeftToReturn > 0;
-        });
-
-    if (_buffer.empty() || nConsumersStillProcessingThisBatch == 0) {
-        loadNextBatch();
+    if (!_concurrentConsumers) {
+        size_t nConsumersStillProcessingThisBatch =
+            std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+                return info.nLeftToReturn > 0;
+            });
+
+        if (_buffer.empty() || nConsumersStillProcessingThisBatch == 0) {
+            loadNextBatch();
+        }
     }
 
     if (_buffer.empty()) {
@@ -73,9 +76,37 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     const size_t bufferIndex = _buffer.size() - _consumers[consumerId].nLeftToReturn;
     --_consumers[consumerId].nLeftToReturn;
 
+    if (_concurrentConsumers) {
+        const auto offset = _serializedOffsets[bufferIndex];
+        BufReader reader(_serializedBatch.buf() + offset,
+                         _serializedOffsets[bufferIndex + 1] - offset);
+        return Document::deserializeForSorter(reader, Document::SorterDeserializeSettings());
+    }
     return _buffer[bufferIndex];
 }
 
+bool TeeBuffer::loadNextBatchForConcurrentConsumers() {
+    _concurrentConsumers = true;
+    if (noConsumersInUse()) {
+        disposeSource();
+        return false;
+    }
+
+    loadNextBatch();
+
+    // Documents lazily populate their field caches, including those of their nested documents, as
+    // they are read, so the consumers must not share them. The batch is serialized once here, and
+    // every consumer reads its own fully materialized copy of each document from it.
+    _serializedBatch.reset();
+    _serializedOffsets.clear();
+    for (auto&& input : _buffer) {
+        _serializedOffsets.push_back(_serializedBatch.len());
+        input.getDocument().serializeForSorter(_serializedBatch);
+    }
+    _serializedOffsets.push_back(_serializedBatch.len());
+    return !_buffer.empty();
+}
+
 void TeeBuffer::loadNextBatch() {
     _buffer.clear();
     size_t bytesInBuffer = 0;
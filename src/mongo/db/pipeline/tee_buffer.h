@@ -33,6 +33,7 @@
 #include <boost/intrusive_ptr.hpp>
 #include <vector>
 
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/query/query_knobs_gen.h"
@@ -66,13 +67,13 @@ public:
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
-        if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-                return info.stillInUse;
-            })) {
-            _buffer.clear();
-            if (_source) {
-                _source->dispose();
-            }
+        if (_concurrentConsumers) {
+            // The other consumers may be running, so the source is disposed of when the next batch
+            // is loaded.
+            return;
+        }
+        if (noConsumersInUse()) {
+            disposeSource();
         }
     }
 
@@ -83,6 +84,17 @@ public:
      */
     DocumentSource::GetNextResult getNext(size_t consumerId);
 
+    /**
+     * Loads the next batch of input on behalf of all of the consumers, so that each of them can
+     * then consume it concurrently on its own thread. Once this has been called, the consumers
+     * never load batches themselves: the caller must call this again after every consumer has
+     * paused or reached EOF, and must not call it while any consumer is running. Each consumer
+     * then gets its own copy of every document, since reading a document may populate its caches.
+     *
+     * Returns false if the input is exhausted, or if none of the consumers is in use anymore.
+     */
+    bool loadNextBatchForConcurrentConsumers();
+
 private:
     TeeBuffer(size_t nConsumers, size_t bufferSizeBytes);
 
@@ -93,15 +105,39 @@ private:
      */
     void loadNextBatch();
 
+    bool noConsumersInUse() const {
+        return std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        });
+    }
+
+    void disposeSource() {
+        _buffer.clear();
+        if (_source) {
+            _source->dispose();
+        }
+    }
+
     DocumentSource* _source = nullptr;
 
     const size_t _bufferSizeBytes;
     std::vector<DocumentSource::GetNextResult> _buffer;
 
+    // The documents of '_buffer' serialized back to back, which concurrent consumers deserialize
+    // their own copies from. '_serializedOffsets' has one more entry than '_buffer', so that the
+    // document at index i spans [_serializedOffsets[i], _serializedOffsets[i + 1]).
+    BufBuilder _serializedBatch;
+    std::vector<int> _serializedOffsets;
+
     struct ConsumerInfo {
         bool stillInUse = true;
         int nLeftToReturn = 0;
     };
     std::vector<ConsumerInfo> _consumers;
+
+    // Set once the batches are loaded by loadNextBatchForConcurrentConsumers(). From then on, a
+    // consumer only ever touches its own ConsumerInfo, and the buffer is read-only while the
+    // consumers are running.
+    bool _concurrentConsumers = false;
 };
 }  // namespace mongo
@@ -170,5 +170,37 @@ TEST_F(TeeBufferTest, ShouldAllowOtherConsumersToAdvanceOnceTrailingConsumerIsDi
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
 }
+
+TEST_F(TeeBufferTest, ConcurrentConsumersGetTheirOwnCopiesOfEachDocument) {
+    MutableDocument input(Document{{"a", Document{{"b", 1}}}});
+    input.metadata().setTextScore(2.5);
+    std::deque<DocumentSource::GetNextResult> inputs{input.freeze()};
+    auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+
+    const size_t nConsumers = 2;
+    auto teeBuffer = TeeBuffer::create(nConsumers);
+    teeBuffer->setSource(mock.get());
+    ASSERT_TRUE(teeBuffer->loadNextBatchForConcurrentConsumers());
+
+    auto next0 = teeBuffer->getNext(0);
+    auto next1 = teeBuffer->getNext(1);
+    ASSERT_TRUE(next0.isAdvanced());
+    ASSERT_TRUE(next1.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next0.getDocument(), inputs.front().getDocument());
+    ASSERT_DOCUMENT_EQ(next1.getDocument(), inputs.front().getDocument());
+    ASSERT_EQ(next0.getDocument().metadata().getTextScore(), 2.5);
+    ASSERT_EQ(next1.getDocument().metadata().getTextScore(), 2.5);
+
+    // Neither the consumers nor the input share the storage of the nested document.
+    const auto nested0 = next0.getDocument()["a"].getDocument();
+    const auto nested1 = next1.getDocument()["a"].getDocument();
+    ASSERT_NE(nested0.getPtr(), nested1.getPtr());
+    ASSERT_NE(nested0.getPtr(), inputs.front().getDocument()["a"].getDocument().getPtr());
+
+    ASSERT_TRUE(teeBuffer->getNext(0).isPaused());
+    ASSERT_FALSE(teeBuffer->loadNextBatchForConcurrentConsumers());
+    ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
+    ASSERT_TRUE(teeBuffer->getNext(1).isEOF());
+}
 }  // namespace
 }  // namespace mongo
@@ -187,6 +187,36 @@ boost::intrusive_ptr<Expression> ExpressionExpMovingAvg::parse(
     }
 }
 
+boost::intrusive_ptr<Expression> ExpressionApproxPercentile::parse(
+    BSONObj obj, const boost::optional<SortPattern>& sortBy, ExpressionContext* expCtx) {
+    // 'obj' is something like '{$approxPercentile: {input: <arg>, p: <number>}, window: {...}}'
+    WindowBounds bounds = WindowBounds::defaultBounds();
+    boost::intrusive_ptr<::mongo::Expression> input;
+    boost::optional<double> percentile;
+    for (const auto& arg : obj) {
+        auto argName = arg.fieldNameStringData();
+        if (argName == kWindowArg) {
+            uassert(ErrorCodes::FailedToParse,
+                    "'window' field must be an object",
+                    arg.type() == BSONType::Object);
+            bounds = WindowBounds::parse(arg.embeddedObject(), sortBy, expCtx);
+        } else if (argName == AccumulatorApproxPercentile::kName) {
+            std::tie(input, percentile) = AccumulatorApproxPercentile::parseArgs(
+                expCtx, arg, expCtx->variablesParseState);
+        } else {
+            uasserted(ErrorCodes::FailedToParse,
+                      str::stream() << "Window function found an unknown argument: " << argName);
+        }
+    }
+
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << "Must specify " << AccumulatorApproxPercentile::kName
+                          << " in output field",
+            percentile);
+    return make_intrusive<ExpressionApproxPercentile>(
+        expCtx, std::move(input), std::move(bounds), *percentile);
+}
+
 boost::intrusive_ptr<Expression> ExpressionFirstLast::parse(
     BSONObj obj,
     const boost::optional<SortPattern>& sortBy,
@@ -433,6 +433,48 @@ protected:
     boost::optional<Decimal128> _alpha;
 };
 
+class ExpressionApproxPercentile : public Expression {
+public:
+    static boost::intrusive_ptr<Expression> parse(BSONObj obj,
+                                                  const boost::optional<SortPattern>& sortBy,
+                                                  ExpressionContext* expCtx);
+
+    ExpressionApproxPercentile(ExpressionContext* expCtx,
+                               boost::intrusive_ptr<::mongo::Expression> input,
+                               WindowBounds bounds,
+                               double percentile)
+        : Expression(expCtx,
+                     AccumulatorApproxPercentile::kName.toString(),
+                     std::move(input),
+                     std::move(bounds)),
+          _percentile(percentile) {}
+
+    boost::intrusive_ptr<AccumulatorState> buildAccumulatorOnly() const final {
+        return AccumulatorApproxPercentile::create(_expCtx, _percentile);
+    }
+
+    std::unique_ptr<WindowFunctionState> buildRemovable() const final {
+        uasserted(5899609,
+                  str::stream() << "Window function " << _accumulatorName
+                                << " is not supported with a removable window");
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const final {
+        MutableDocument args;
+        args[_accumulatorName] =
+            Value(DOC(AccumulatorApproxPercentile::kInputArg
+                      << _input->serialize(static_cast<bool>(explain))
+                      << AccumulatorApproxPercentile::kPercentileArg << _percentile));
+        MutableDocument windowField;
+        _bounds.serialize(windowField);
+        args[kWindowArg] = windowField.freezeToValue();
+        return args.freezeToValue();
+    }
+
+private:
+    double _percentile;
+};
+
 class ExpressionWithUnit : public Expression {
 public:
     static constexpr StringData kArgInput = "input"_sd;
@@ -35,6 +35,8 @@ namespace mongo {
 namespace {
 ServerStatusMetricField<Counter64> totalPlanCacheSizeEstimateBytesMetric(
     "query.planCacheTotalSizeEstimateBytes", &PlanCacheEntry::planCacheTotalSizeEstimateBytes);
+ServerStatusMetricField<Counter64> planCacheEvictionsMetric(
+    "query.planCacheEvictions", &PlanCacheEntry::planCacheEvictions);
 }  // namespace
 
 
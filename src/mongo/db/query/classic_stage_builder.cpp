@@ -279,7 +279,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
 
             auto node = static_cast<const TextOrNode*>(root);
             auto ret = std::make_unique<TextOrStage>(
-                expCtx, *_ftsKeyPrefixSize, _ws, node->filter.get(), _collection);
+                expCtx, *_ftsKeyPrefixSize, _ws, node->filter.get(), _collection, node->limit);
             for (auto childNode : root->children) {
                 ret->addChild(build(childNode));
             }
@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "mongo/base/string_data.h"
+#include "mongo/util/lru_cache.h"
+
+namespace mongo {
+
+class CollatorInterface;
+
+/**
+ * Remembers the comparison keys most recently computed by a collator, so that an operation which
+ * collates the same strings over and over, such as index key or sort key generation over a field
+ * with few distinct values, only pays for computing the key of each of them once.
+ *
+ * Instances are meant to live for the duration of a single operation and are not thread-safe.
+ */
+class CollationKeyCache {
+    CollationKeyCache(const CollationKeyCache&) = delete;
+    CollationKeyCache& operator=(const CollationKeyCache&) = delete;
+
+public:
+    static constexpr std::size_t kDefaultMaxEntries = 128;
+
+    // Longer strings are unlikely to repeat, so their keys are computed without being cached.
+    static constexpr std::size_t kMaxCachedStringBytes = 256;
+
+    explicit CollationKeyCache(const CollatorInterface* collator,
+                               std::size_t maxEntries = kDefaultMaxEntries);
+
+    const CollatorInterface* getCollator() const {
+        return _collator;
+    }
+
+    /**
+     * Returns the comparison key data for 'stringData', as CollatorInterface::getComparisonKey()
+     * would. The returned StringData is only valid until the next call on this cache.
+     */
+    StringData getComparisonKeyData(StringData stringData);
+
+    std::size_t size() const {
+        return _keys.size();
+    }
+
+private:
+    const CollatorInterface* const _collator;
+
+    LRUCache<std::string, std::string> _keys;
+
+    // Holds the key of the last string which was too long to be cached.
+    std::string _uncachedKey;
+};
+
+}  // namespace mongo
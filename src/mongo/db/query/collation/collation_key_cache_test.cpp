@@ -0,0 +1,79 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/collation/collation_key_cache.h"
+
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(CollationKeyCacheTest, ReturnsTheKeysOfTheCollator) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    CollationKeyCache cache(&collator);
+
+    ASSERT_EQ(cache.getComparisonKeyData("abc"), "cba");
+    ASSERT_EQ(cache.getComparisonKeyData("xy"), "yx");
+    ASSERT_EQ(cache.getComparisonKeyData("abc"), "cba");
+    ASSERT_EQ(cache.getComparisonKeyData(""), "");
+    ASSERT_EQ(cache.size(), 3U);
+}
+
+TEST(CollationKeyCacheTest, DoesNotCacheLongStrings) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    CollationKeyCache cache(&collator);
+
+    const std::string longString(CollationKeyCache::kMaxCachedStringBytes + 1, 'A');
+    ASSERT_EQ(cache.getComparisonKeyData(longString),
+              std::string(CollationKeyCache::kMaxCachedStringBytes + 1, 'a'));
+    ASSERT_EQ(cache.size(), 0U);
+}
+
+TEST(CollationKeyCacheTest, EvictsLeastRecentlyUsedKeys) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    CollationKeyCache cache(&collator, 2);
+
+    ASSERT_EQ(cache.getComparisonKeyData("ab"), "ba");
+    ASSERT_EQ(cache.getComparisonKeyData("cd"), "dc");
+    ASSERT_EQ(cache.getComparisonKeyData("ab"), "ba");
+
+    // "cd" is now the least recently used key, so adding "ef" evicts it.
+    ASSERT_EQ(cache.getComparisonKeyData("ef"), "fe");
+    ASSERT_EQ(cache.size(), 2U);
+    ASSERT_EQ(cache.getComparisonKeyData("ab"), "ba");
+    ASSERT_EQ(cache.getComparisonKeyData("cd"), "dc");
+    ASSERT_EQ(cache.size(), 2U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -44,4 +44,14 @@ std::string CollatorInterface::getComparisonString(StringData stringData) const
     return getComparisonKey(stringData).getKeyData().toString();
 }
 
+std::vector<CollatorInterface::ComparisonKey> CollatorInterface::getComparisonKeys(
+    const std::vector<StringData>& strings) const {
+    std::vector<ComparisonKey> keys;
+    keys.reserve(strings.size());
+    for (auto&& str : strings) {
+        keys.push_back(getComparisonKey(str));
+    }
+    return keys;
+}
+
 }  // namespace mongo
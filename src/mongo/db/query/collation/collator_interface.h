@@ -31,6 +31,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/base/string_data_comparator_interface.h"
@@ -120,6 +121,14 @@ public:
      */
     std::string getComparisonString(StringData stringData) const;
 
+    /**
+     * Returns the comparison keys for each string in 'strings', in the same order. Equivalent to
+     * calling getComparisonKey() on each of them, but lets implementations reuse state between the
+     * strings.
+     */
+    virtual std::vector<ComparisonKey> getComparisonKeys(
+        const std::vector<StringData>& strings) const;
+
     /**
      * Returns whether this collation has the same matching and sorting semantics as 'other'.
      */
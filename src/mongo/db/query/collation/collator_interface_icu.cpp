@@ -74,12 +74,31 @@ int CollatorInterfaceICU::compare(StringData left, StringData right) const {
 
 CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     StringData stringData) const {
+    icu::CollationKey icuKey;
+    return _getComparisonKey(stringData, &icuKey);
+}
+
+std::vector<CollatorInterface::ComparisonKey> CollatorInterfaceICU::getComparisonKeys(
+    const std::vector<StringData>& strings) const {
+    std::vector<ComparisonKey> keys;
+    keys.reserve(strings.size());
+
+    // ICU grows the sort key buffer of a CollationKey as needed and keeps it when the key is
+    // overwritten, so sharing one across the strings avoids allocating a buffer for each of them.
+    icu::CollationKey icuKey;
+    for (auto&& str : strings) {
+        keys.push_back(_getComparisonKey(str, &icuKey));
+    }
+    return keys;
+}
+
+CollatorInterface::ComparisonKey CollatorInterfaceICU::_getComparisonKey(
+    StringData stringData, icu::CollationKey* icuKey) const {
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
 
     UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), *icuKey, status);
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
     // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
@@ -87,7 +106,7 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     fassert(34439, U_SUCCESS(status));
 
     int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
+    const uint8_t* keyBuffer = icuKey->getByteArray(keyLength);
     invariant(keyLength > 0);
     invariant(keyBuffer);
 
@@ -34,6 +34,7 @@
 #include <memory>
 
 namespace icu {
+class CollationKey;
 class Collator;
 }  // namespace icu
 
@@ -53,7 +54,15 @@ public:
 
     ComparisonKey getComparisonKey(StringData stringData) const final;
 
+    std::vector<ComparisonKey> getComparisonKeys(
+        const std::vector<StringData>& strings) const final;
+
 private:
+    /**
+     * Computes the comparison key for 'stringData' using 'icuKey' as the ICU output buffer.
+     */
+    ComparisonKey _getComparisonKey(StringData stringData, icu::CollationKey* icuKey) const;
+
     // The ICU implementation of the collator to which we delegate interesting work. Const methods
     // on the ICU collator are expected to be thread-safe.
     const std::unique_ptr<icu::Collator> _collator;
@@ -175,6 +175,26 @@ TEST(CollatorInterfaceICUTest, ASCIIComparisonWorksUsingComparisonKeys) {
     ASSERT_LT(comparisonKeyABB.getKeyData().compare(comparisonKeyBA.getKeyData()), 0);
 }
 
+TEST(CollatorInterfaceICUTest, BatchComparisonKeysMatchSingleComparisonKeys) {
+    Collation collationSpec;
+    collationSpec.setLocale("en_US");
+    UErrorCode status = U_ZERO_ERROR;
+    std::unique_ptr<icu::Collator> coll(
+        icu::Collator::createInstance(icu::Locale("en", "US"), status));
+    ASSERT(U_SUCCESS(status));
+    CollatorInterfaceICU icuCollator(collationSpec, std::move(coll));
+
+    // Include a long string followed by a short one, so that the shared ICU key buffer is reused
+    // for a key shorter than the one it last held.
+    const std::string longString(1000, 'z');
+    const std::vector<StringData> strings{"ab", "", longString, "ba", "ab"};
+    const auto keys = icuCollator.getComparisonKeys(strings);
+    ASSERT_EQ(keys.size(), strings.size());
+    for (size_t i = 0; i < strings.size(); ++i) {
+        ASSERT_EQ(keys[i].getKeyData(), icuCollator.getComparisonKey(strings[i]).getKeyData());
+    }
+}
+
 TEST(CollatorInterfaceICUTest, ZeroLengthStringsCompareCorrectly) {
     Collation collationSpec;
     collationSpec.setLocale("en_US");
@@ -43,6 +43,7 @@
 #include "mongo/db/exec/projection_executor.h"
 #include "mongo/db/exec/projection_executor_utils.h"
 #include "mongo/db/fts/fts_spec.h"
+#include "mongo/db/index/column_key_generator.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/query/classic_plan_cache.h"
@@ -88,7 +89,8 @@ const UpdateIndexData& CollectionQueryInfo::getIndexKeys(OperationContext* opCtx
 
 std::shared_ptr<PlanCache> CollectionQueryInfo::makePlanCache() {
     return std::make_shared<PlanCache>(
-        PlanCache::BudgetTracker(internalQueryCacheMaxEntriesPerCollection.load()));
+        PlanCache::BudgetTracker(internalQueryCacheMaxEntriesPerCollection.load()),
+        true /* enforceMemoryBudget */);
 }
 
 void CollectionQueryInfo::computeIndexKeys(OperationContext* opCtx, const CollectionPtr& coll) {
@@ -119,6 +121,14 @@ void CollectionQueryInfo::computeIndexKeys(OperationContext* opCtx, const Collec
                     _indexedPaths.addPath(path);
                 }
             }
+        } else if (descriptor->getAccessMethodName() == IndexNames::COLUMN) {
+            // A columnstore index either stores every path or a single one.
+            auto indexedPath = descriptor->keyPattern().firstElementFieldNameStringData();
+            if (indexedPath == ColumnKeyGenerator::kAllPathsFieldName) {
+                _indexedPaths.allPathsIndexed();
+            } else {
+                _indexedPaths.addPath(FieldRef(indexedPath));
+            }
         } else if (descriptor->getAccessMethodName() == IndexNames::TEXT) {
             fts::FTSSpec ftsSpec(descriptor->infoObj());
 
@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <timelib.h>
@@ -485,7 +486,22 @@ void TimeZone::TimelibTZInfoDeleter::operator()(timelib_tzinfo* tzInfo) {
 }
 
 TimeZone::TimeZone(timelib_tzinfo* tzInfo)
-    : _tzInfo(tzInfo, TimelibTZInfoDeleter()), _utcOffset(0) {}
+    : _tzInfo(tzInfo, TimelibTZInfoDeleter()), _utcOffset(0) {
+    if (!tzInfo || !tzInfo->trans || tzInfo->bit64.timecnt < 2) {
+        return;
+    }
+
+    auto table = std::make_shared<TransitionTable>();
+    table->transitions.reserve(tzInfo->bit64.timecnt);
+    table->offsets.reserve(tzInfo->bit64.timecnt);
+    for (uint64_t i = 0; i < tzInfo->bit64.timecnt; ++i) {
+        auto* offset = timelib_get_time_zone_info(tzInfo->trans[i], tzInfo);
+        table->transitions.push_back(tzInfo->trans[i]);
+        table->offsets.push_back(offset->offset);
+        timelib_time_offset_dtor(offset);
+    }
+    _transitionTable = std::move(table);
+}
 
 TimeZone::TimeZone(Seconds utcOffsetSeconds) : _tzInfo(nullptr), _utcOffset(utcOffsetSeconds) {}
 
@@ -504,20 +520,50 @@ std::unique_ptr<timelib_time, TimeZone::TimelibTimeDeleter> TimeZone::getTimelib
     return time;
 }
 
+Seconds TimeZone::_offsetAt(long long secs) const {
+    if (!isTimeZoneIDZone()) {
+        return _utcOffset;
+    }
+
+    if (_transitionTable) {
+        const auto& transitions = _transitionTable->transitions;
+        if (secs >= transitions.front() && secs < transitions.back()) {
+            // The offset in effect is the one from the last transition at or before 'secs'.
+            auto it = std::upper_bound(transitions.begin(), transitions.end(), secs);
+            return Seconds(_transitionTable->offsets[std::distance(transitions.begin(), it) - 1]);
+        }
+    }
+
+    auto* offset = timelib_get_time_zone_info(secs, _tzInfo.get());
+    auto timezoneOffsetFromUTC = Seconds(offset->offset);
+    timelib_time_offset_dtor(offset);
+    return timezoneOffsetFromUTC;
+}
+
+void TimeZone::_fillLocalTime(Date_t date, timelib_time* localTime) const {
+    // This mirrors what timelib_unixtime2local() does in getTimelibTime(), without building a
+    // time zone aware timelib_time on the heap.
+    auto secs = seconds(date);
+    timelib_unixtime2gmt(localTime, secs + durationCount<Seconds>(_offsetAt(secs)));
+}
+
 TimeZone::Iso8601DateParts TimeZone::dateIso8601Parts(Date_t date) const {
-    auto time = getTimelibTime(date);
-    return Iso8601DateParts(*time, date);
+    timelib_time time{};
+    _fillLocalTime(date, &time);
+    return Iso8601DateParts(time, date);
 }
 
 TimeZone::DateParts TimeZone::dateParts(Date_t date) const {
-    auto time = getTimelibTime(date);
-    return DateParts(*time, date);
+    timelib_time time{};
+    _fillLocalTime(date, &time);
+    return DateParts(time, date);
 }
 
 int TimeZone::dayOfWeek(Date_t date) const {
-    auto time = getTimelibTime(date);
+    timelib_time time{};
+    _fillLocalTime(date, &time);
     // timelib_day_of_week() returns a number in the range [0,6], we want [1,7], so add one.
-    return timelib_day_of_week(time->y, time->m, time->d) + 1;
+    return timelib_day_of_week(time.y, time.m, time.d) + 1;
 }
 
 int TimeZone::week(Date_t date) const {
@@ -534,47 +580,44 @@ int TimeZone::week(Date_t date) const {
 }
 
 int TimeZone::dayOfYear(Date_t date) const {
-    auto time = getTimelibTime(date);
+    timelib_time time{};
+    _fillLocalTime(date, &time);
     // timelib_day_of_year() returns a number in the range [0,365], we want [1,366], so add one.
-    return timelib_day_of_year(time->y, time->m, time->d) + 1;
+    return timelib_day_of_year(time.y, time.m, time.d) + 1;
 }
 
 int TimeZone::dayOfMonth(Date_t date) const {
-    auto time = getTimelibTime(date);
-    return time->d;
+    timelib_time time{};
+    _fillLocalTime(date, &time);
+    return time.d;
 }
 
 int TimeZone::isoDayOfWeek(Date_t date) const {
-    auto time = getTimelibTime(date);
-    return timelib_iso_day_of_week(time->y, time->m, time->d);
+    timelib_time time{};
+    _fillLocalTime(date, &time);
+    return timelib_iso_day_of_week(time.y, time.m, time.d);
 }
 
 int TimeZone::isoWeek(Date_t date) const {
-    auto time = getTimelibTime(date);
+    timelib_time time{};
+    _fillLocalTime(date, &time);
     long long isoWeek;
     long long isoYear;
-    timelib_isoweek_from_date(time->y, time->m, time->d, &isoWeek, &isoYear);
+    timelib_isoweek_from_date(time.y, time.m, time.d, &isoWeek, &isoYear);
     return isoWeek;
 }
 
 long long TimeZone::isoYear(Date_t date) const {
-    auto time = getTimelibTime(date);
+    timelib_time time{};
+    _fillLocalTime(date, &time);
     long long isoWeek;
     long long isoYear;
-    timelib_isoweek_from_date(time->y, time->m, time->d, &isoWeek, &isoYear);
+    timelib_isoweek_from_date(time.y, time.m, time.d, &isoWeek, &isoYear);
     return isoYear;
 }
 
 Seconds TimeZone::utcOffset(Date_t date) const {
-    if (isTimeZoneIDZone()) {
-        auto* offset = timelib_get_time_zone_info(
-            durationCount<Seconds>(date.toDurationSinceEpoch()), _tzInfo.get());
-        auto timezoneOffsetFromUTC = Seconds(offset->offset);
-        timelib_time_offset_dtor(offset);
-        return timezoneOffsetFromUTC;
-    } else {
-        return _utcOffset;
-    }
+    return _offsetAt(durationCount<Seconds>(date.toDurationSinceEpoch()));
 }
 
 void TimeZone::validateToStringFormat(StringData format) {
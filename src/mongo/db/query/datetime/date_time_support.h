@@ -32,6 +32,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/db/service_context.h"
@@ -385,9 +386,36 @@ private:
         void operator()(_timelib_tzinfo* tzInfo);
     };
 
+    /**
+     * The UTC offset in effect from each of a time zone's transitions up to its last one, flattened
+     * out of the timelib_tzinfo so that looking up an offset needs neither a heap allocation nor a
+     * call into timelib. Instants outside [transitions.front(), transitions.back()) are left to
+     * timelib, since the offset before the first transition and the POSIX rules which apply after
+     * the last one are not described by the table.
+     */
+    struct TransitionTable {
+        std::vector<long long> transitions;
+        std::vector<int> offsets;
+    };
+
+    /**
+     * Returns the UTC offset in effect at 'secs' seconds since the epoch.
+     */
+    Seconds _offsetAt(long long secs) const;
+
+    /**
+     * Fills in the calendar fields (y, m, d, h, i, s) of 'localTime' with 'date' expressed in this
+     * time zone. This is a cheaper alternative to getTimelibTime() for callers which only need the
+     * broken-down local time.
+     */
+    void _fillLocalTime(Date_t date, _timelib_time* localTime) const;
+
     // null if this TimeZone represents the default UTC time zone, or a UTC-offset time zone
     std::shared_ptr<_timelib_tzinfo> _tzInfo;
 
+    // null unless '_tzInfo' has at least two transitions; shared between copies of this TimeZone
+    std::shared_ptr<const TransitionTable> _transitionTable;
+
     // represents the UTC offset in seconds if _tzInfo is null and it is not 0
     Seconds _utcOffset{0};
 };
@@ -97,6 +97,33 @@ TEST(GetTimeZone, DoesParseHourMinuteOffsetWithColon) {
     ASSERT_EQ(durationCount<Minutes>(zone.utcOffset(date)), -37);
 }
 
+TEST(GetTimeZone, LocalTimeMatchesTimelibAcrossTransitions) {
+    // Covers dates before the first transition, between transitions, and after the last one, where
+    // the POSIX rules of the zone apply.
+    const auto start = Date_t::fromMillisSinceEpoch(-3786825600000LL);  // 1850-01-01
+    const auto end = Date_t::fromMillisSinceEpoch(4102444800000LL);     // 2100-01-01
+    for (auto&& zoneName :
+         {"America/New_York", "Australia/Sydney", "Europe/Dublin", "Asia/Kolkata"}) {
+        auto zone = kDefaultTimeZoneDatabase.getTimeZone(zoneName);
+        for (auto date = start; date < end; date += Days(1) + Minutes(37) + Milliseconds(1)) {
+            auto expected = zone.getTimelibTime(date);
+            auto parts = zone.dateParts(date);
+            ASSERT_EQ(parts.year, expected->y) << zoneName << " " << date.toString();
+            ASSERT_EQ(parts.month, expected->m) << zoneName << " " << date.toString();
+            ASSERT_EQ(parts.dayOfMonth, expected->d) << zoneName << " " << date.toString();
+            ASSERT_EQ(parts.hour, expected->h) << zoneName << " " << date.toString();
+            ASSERT_EQ(parts.minute, expected->i) << zoneName << " " << date.toString();
+            ASSERT_EQ(parts.second, expected->s) << zoneName << " " << date.toString();
+
+            auto* offset = timelib_get_time_zone_info(
+                durationCount<Seconds>(date.toDurationSinceEpoch()), zone.getTzInfo().get());
+            ASSERT_EQ(durationCount<Seconds>(zone.utcOffset(date)), offset->offset)
+                << zoneName << " " << date.toString();
+            timelib_time_offset_dtor(offset);
+        }
+    }
+}
+
 TEST(GetTimeZone, DoesNotReturnUnknownTimeZone) {
     ASSERT_THROWS_CODE(kDefaultTimeZoneDatabase.getTimeZone("The moon"), AssertionException, 40485);
     ASSERT_THROWS_CODE(kDefaultTimeZoneDatabase.getTimeZone("xyz"), AssertionException, 40485);
@@ -32,6 +32,7 @@
 #include "mongo/db/query/explain.h"
 
 #include "mongo/bson/util/builder.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count_scan.h"
@@ -337,6 +338,12 @@ void Explain::explainPipeline(PlanExecutor* exec,
     out->appendElements(explainVersionToBson(explainer.getVersion()));
     *out << "stages" << Value(pipelineExec->writeExplainOps(verbosity));
 
+    if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+        if (auto&& memoryTracker = CurOp::get(pipelineExec->getOpCtx())->getMemoryTracker()) {
+            *out << "maxTrackedMemBytes" << memoryTracker->maxMemoryBytes();
+        }
+    }
+
     explain_common::generateServerInfo(out);
     explain_common::generateServerParameters(out);
 
@@ -393,6 +400,22 @@ void Explain::planCacheEntryToBSON(const PlanCacheEntry& entry, BSONObjBuilder*
     out->append("works", static_cast<long long>(entry.works));
     out->append("timeOfCreation", entry.timeOfCreation);
 
+    {
+        const auto& runtimeStats = entry.runtimeStats;
+        BSONObjBuilder runtimeStatsBuilder(out->subobjStart("runtimeStats"));
+        runtimeStatsBuilder.append("decisionProductivity", runtimeStats.decisionProductivity);
+        runtimeStatsBuilder.appendNumber("numExecutions",
+                                         static_cast<long long>(runtimeStats.numExecutions));
+        runtimeStatsBuilder.appendNumber("totalKeysExamined",
+                                         static_cast<long long>(runtimeStats.totalKeysExamined));
+        runtimeStatsBuilder.appendNumber("totalDocsExamined",
+                                         static_cast<long long>(runtimeStats.totalDocsExamined));
+        runtimeStatsBuilder.appendNumber("totalDocsReturned",
+                                         static_cast<long long>(runtimeStats.totalDocsReturned));
+        runtimeStatsBuilder.appendNumber("totalWorks",
+                                         static_cast<long long>(runtimeStats.totalWorks));
+    }
+
     if (entry.debugInfo) {
         const auto& debugInfo = *entry.debugInfo;
         invariant(debugInfo.decision);
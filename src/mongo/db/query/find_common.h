@@ -48,6 +48,18 @@ struct AwaitDataState {
      * which causes results to become available.
      */
     bool shouldWaitForInserts;
+
+    /**
+     * If non-zero, the system keeps waiting for inserts after results became available, until the
+     * batch holds this many bytes or 'coalesceWindow' has passed since the first result.
+     */
+    std::size_t minBatchBytes = 0;
+
+    /**
+     * How long after the first result the system keeps waiting for inserts to coalesce results
+     * into a batch of 'minBatchBytes' bytes. Bounded by 'waitForInsertsDeadline'.
+     */
+    Milliseconds coalesceWindow = Milliseconds::max();
 };
 
 extern const OperationContext::Decoration<AwaitDataState> awaitDataState;
@@ -68,6 +68,7 @@
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/histogram_estimator.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor_factory.h"
@@ -291,6 +292,11 @@ void fillOutPlannerParams(OperationContext* opCtx,
         // Skip the addition of hidden indexes to prevent use in query planning.
         if (ice->descriptor()->hidden())
             continue;
+
+        // Columnstore indexes cannot provide index scans, they are only read by column scans.
+        if (indexType == IndexType::INDEX_COLUMN)
+            continue;
+
         plannerParams->indices.push_back(
             indexEntryFromIndexCatalogEntry(opCtx, collection, *ice, canonicalQuery));
     }
@@ -349,6 +355,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
 
+    if (internalQueryPlannerGenerateSkipScans.load()) {
+        plannerParams->options |= QueryPlannerParams::GENERATE_SKIP_SCANS;
+    }
+
     if (shouldWaitForOplogVisibility(
             opCtx, collection, canonicalQuery->getFindCommandRequest().getTailable())) {
         plannerParams->options |= QueryPlannerParams::OPLOG_SCAN_WAIT_FOR_VISIBLE;
@@ -644,6 +654,10 @@ public:
             }
         }
 
+        // Discard the candidates which are estimated to be far more expensive than the best one
+        // so that they don't take part in multi-planning.
+        histogram_estimator::pruneSolutions(_opCtx, _collection, *_cq, &solutions);
+
         if (1 == solutions.size()) {
             auto result = makeResult();
             // Only one possible plan. Run it. Build the stages from the solution.
@@ -1258,7 +1272,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
     const CollectionPtr* coll,
     ParsedDelete* parsedDelete,
     boost::optional<ExplainOptions::Verbosity> verbosity,
-    DeleteStageParams::DocumentCounter&& documentCounter) {
+    DeleteStageParams::DocumentCounter&& documentCounter,
+    DeleteStageParams::PartialDeleter&& partialDeleter) {
     const auto& collection = *coll;
     auto expCtx = parsedDelete->expCtx();
     OperationContext* opCtx = expCtx->opCtx;
@@ -1297,6 +1312,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDele
     deleteStageParams->opDebug = opDebug;
     deleteStageParams->stmtId = request->getStmtId();
     deleteStageParams->numStatsForDoc = std::move(documentCounter);
+    deleteStageParams->partialDeleter = std::move(partialDeleter);
 
     std::unique_ptr<WorkingSet> ws = std::make_unique<WorkingSet>();
     const auto policy = parsedDelete->yieldPolicy();
@@ -1743,9 +1759,18 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
 /**
  * Returns true if indices contains an index that can be used with DistinctNode (the "fast distinct
  * hack" node, which can be used only if there is an empty query predicate).  Sets indexOut to the
- * array index of PlannerParams::indices.  Look for the index for the fewest fields.  Criteria for
- * suitable index is that the index should be of type BTREE or HASHED and the index cannot be a
- * partial index.
+ * array index of PlannerParams::indices and fieldNoOut to the position of 'field' in its key
+ * pattern.  Criteria for suitable index is that the index should be of type BTREE or HASHED and the
+ * index cannot be a partial index.
+ *
+ * Indexes which lead with 'field' are preferred, and among those the index with the fewest fields.
+ * If the internalQueryPlannerGenerateDistinctScansOnNonLeadingFields knob is enabled and
+ * 'strictDistinctOnly' is not set, 'field' may also come later in the key pattern. The distinct
+ * scan then visits each distinct combination of the fields up to and including 'field', and the
+ * caller discards the repeated values. This is only done when the scan can be covered, that is,
+ * for indexes which are neither multikey nor have a collation. It is off by default, since without
+ * statistics on the preceding fields the planner cannot tell whether the scan is cheaper than a
+ * collection scan.
  *
  * Multikey indices are not suitable for DistinctNode when the projection is on an array element.
  * Arrays are flattened in a multikey index which makes it impossible for the distinct scan stage
@@ -1758,9 +1783,14 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
 bool getDistinctNodeIndex(const std::vector<IndexEntry>& indices,
                           const std::string& field,
                           const CollatorInterface* collator,
-                          size_t* indexOut) {
+                          bool strictDistinctOnly,
+                          size_t* indexOut,
+                          size_t* fieldNoOut) {
     invariant(indexOut);
-    int minFields = std::numeric_limits<int>::max();
+    invariant(fieldNoOut);
+    const bool allowNonLeadingField = !strictDistinctOnly &&
+        internalQueryPlannerGenerateDistinctScansOnNonLeadingFields.load();
+    auto best = std::make_pair(std::numeric_limits<size_t>::max(), 0);
     for (size_t i = 0; i < indices.size(); ++i) {
         // Skip indices with non-matching collator.
         if (!CollatorInterface::collatorsMatch(indices[i].collator, collator)) {
@@ -1770,13 +1800,25 @@ bool getDistinctNodeIndex(const std::vector<IndexEntry>& indices,
         if (indices[i].filterExpr) {
             continue;
         }
-        // Skip indices where the first key is not 'field'.
-        auto firstIndexField = indices[i].keyPattern.firstElement();
-        if (firstIndexField.fieldNameStringData() != StringData(field)) {
+        // Find the position of 'field' in the key pattern.
+        size_t fieldNo = 0;
+        BSONElement distinctIndexField;
+        for (auto&& elem : indices[i].keyPattern) {
+            if (elem.fieldNameStringData() == field) {
+                distinctIndexField = elem;
+                break;
+            }
+            ++fieldNo;
+        }
+        if (!distinctIndexField) {
             continue;
         }
-        // Skip the index if the first key is a "plugin" such as "hashed", "2dsphere", and so on.
-        if (!firstIndexField.isNumber()) {
+        // Skip indices where 'field' is not the first key, unless the scan can be covered.
+        if (fieldNo > 0 && (!allowNonLeadingField || indices[i].multikey || indices[i].collator)) {
+            continue;
+        }
+        // Skip the index if 'field' is a "plugin" such as "hashed", "2dsphere", and so on.
+        if (!distinctIndexField.isNumber()) {
             continue;
         }
         // Compound hashed indexes can use distinct scan if the first field is 1 or -1. For the
@@ -1794,14 +1836,16 @@ bool getDistinctNodeIndex(const std::vector<IndexEntry>& indices,
                 continue;
         }
 
-        int nFields = indices[i].keyPattern.nFields();
-        // Pick the index with the lowest number of fields.
-        if (nFields < minFields) {
-            minFields = nFields;
+        // Pick the index with 'field' earliest in its key pattern, then the lowest number of
+        // fields.
+        auto candidate = std::make_pair(fieldNo, indices[i].keyPattern.nFields());
+        if (candidate < best) {
+            best = candidate;
             *indexOut = i;
+            *fieldNoOut = fieldNo;
         }
     }
-    return minFields != std::numeric_limits<int>::max();
+    return best.first != std::numeric_limits<size_t>::max();
 }
 
 }  // namespace
@@ -2105,6 +2149,8 @@ QueryPlannerParams fillOutPlannerParamsForDistinct(OperationContext* opCtx,
         // Skip the addition of hidden indexes to prevent use in query planning.
         if (desc->hidden())
             continue;
+        if (desc->getIndexType() == IndexType::INDEX_COLUMN)
+            continue;
         if (desc->keyPattern().hasField(parsedDistinct.getKey())) {
             if (!mayUnwindArrays &&
                 isAnyComponentOfPathMultikey(desc->keyPattern(),
@@ -2182,10 +2228,15 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorForS
     // If there's no query, we can just distinct-scan one of the indices. Not every index in
     // plannerParams.indices may be suitable. Refer to getDistinctNodeIndex().
     size_t distinctNodeIndex = 0;
+    size_t distinctFieldNo = 0;
     if (!parsedDistinct->getQuery()->getFindCommandRequest().getFilter().isEmpty() ||
         parsedDistinct->getQuery()->getSortPattern() ||
-        !getDistinctNodeIndex(
-            plannerParams.indices, parsedDistinct->getKey(), collator, &distinctNodeIndex)) {
+        !getDistinctNodeIndex(plannerParams.indices,
+                              parsedDistinct->getKey(),
+                              collator,
+                              plannerParams.options & QueryPlannerParams::STRICT_DISTINCT_ONLY,
+                              &distinctNodeIndex,
+                              &distinctFieldNo)) {
         // Not a "simple" DISTINCT_SCAN or no suitable index was found.
         return {nullptr};
     }
@@ -2194,7 +2245,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorForS
     dn->direction = 1;
     IndexBoundsBuilder::allValuesBounds(dn->index.keyPattern, &dn->bounds);
     dn->queryCollator = collator;
-    dn->fieldNo = 0;
+    dn->fieldNo = distinctFieldNo;
 
     // An index with a non-simple collation requires a FETCH stage.
     std::unique_ptr<QuerySolutionNode> solnRoot = std::move(dn);
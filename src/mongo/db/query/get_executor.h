@@ -245,13 +245,17 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorCoun
  * PlanExecutor.
  *
  * If the query cannot be executed, returns a Status indicating why.
+ *
+ * 'partialDeleter' is an optional function which determines the part of each matching document
+ * to delete; see DeleteStageParams::partialDeleter.
  */
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorDelete(
     OpDebug* opDebug,
     const CollectionPtr* collection,
     ParsedDelete* parsedDelete,
     boost::optional<ExplainOptions::Verbosity> verbosity,
-    DeleteStageParams::DocumentCounter&& documentCounter = nullptr);
+    DeleteStageParams::DocumentCounter&& documentCounter = nullptr,
+    DeleteStageParams::PartialDeleter&& partialDeleter = nullptr);
 
 /**
  * Get a PlanExecutor for an update operation. 'parsedUpdate' describes the query predicate
@@ -0,0 +1,213 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+namespace {
+/**
+ * Returns the estimated fraction of the values in the open range ('lower', 'upper') which are
+ * less than 'value'. Linear interpolation is used for numbers and dates, otherwise the value is
+ * assumed to lie in the middle of the range.
+ */
+double interpolate(const BSONElement* lower, const BSONElement& upper, const BSONElement& value) {
+    constexpr double kUnknown = 0.5;
+    if (!lower) {
+        // Nothing is known about the smallest values of the first bucket, except that a value of
+        // a lower canonical type than its upper bound (such as MinKey) precedes all of them.
+        return value.canonicalType() < upper.canonicalType() ? 0.0 : kUnknown;
+    }
+
+    double lo, hi, v;
+    if (lower->isNumber() && upper.isNumber() && value.isNumber()) {
+        lo = lower->numberDouble();
+        hi = upper.numberDouble();
+        v = value.numberDouble();
+    } else if (lower->type() == BSONType::Date && upper.type() == BSONType::Date &&
+               value.type() == BSONType::Date) {
+        lo = lower->date().toMillisSinceEpoch();
+        hi = upper.date().toMillisSinceEpoch();
+        v = value.date().toMillisSinceEpoch();
+    } else {
+        return kUnknown;
+    }
+
+    if (!(hi > lo) || std::isnan(v)) {
+        return kUnknown;
+    }
+    return std::clamp((v - lo) / (hi - lo), 0.0, 1.0);
+}
+}  // namespace
+
+Histogram Histogram::make(std::vector<BSONElement>* values, size_t maxBuckets) {
+    invariant(values);
+    invariant(maxBuckets > 0);
+
+    Histogram histogram;
+    if (values->empty()) {
+        return histogram;
+    }
+
+    std::sort(values->begin(), values->end(), [](const BSONElement& lhs, const BSONElement& rhs) {
+        return lhs.woCompare(rhs, false) < 0;
+    });
+
+    const double depth = std::ceil(static_cast<double>(values->size()) / maxBuckets);
+
+    // Walk the runs of equal values, closing a bucket at the end of the run which makes it reach
+    // the target depth. A run is never split across buckets.
+    BSONArrayBuilder boundsBuilder;
+    std::vector<Bucket> buckets;
+    double rangeCount = 0;
+    double rangeDistinctCount = 0;
+    for (size_t runStart = 0; runStart < values->size();) {
+        const auto& runValue = (*values)[runStart];
+        size_t runEnd = runStart + 1;
+        while (runEnd < values->size() && (*values)[runEnd].woCompare(runValue, false) == 0) {
+            ++runEnd;
+        }
+
+        const double runLength = runEnd - runStart;
+        if (rangeCount + runLength >= depth || runEnd == values->size()) {
+            boundsBuilder.append(runValue);
+            Bucket bucket;
+            bucket.equalCount = runLength;
+            bucket.rangeCount = rangeCount;
+            bucket.rangeDistinctCount = rangeDistinctCount;
+            buckets.push_back(bucket);
+            rangeCount = 0;
+            rangeDistinctCount = 0;
+        } else {
+            rangeCount += runLength;
+            rangeDistinctCount += 1;
+        }
+        runStart = runEnd;
+    }
+
+    histogram._boundsHolder = boundsBuilder.obj();
+    BSONObjIterator boundsIt(histogram._boundsHolder);
+    for (auto&& bucket : buckets) {
+        bucket.upperBound = boundsIt.next();
+    }
+    histogram._buckets = std::move(buckets);
+    histogram._totalCount = values->size();
+    return histogram;
+}
+
+double Histogram::estimateEqualityCount(const BSONElement& value) const {
+    for (auto&& bucket : _buckets) {
+        const int cmp = value.woCompare(bucket.upperBound, false);
+        if (cmp == 0) {
+            return bucket.equalCount;
+        } else if (cmp < 0) {
+            // Assume the values strictly inside the bucket are uniformly distributed among its
+            // distinct values.
+            return bucket.rangeDistinctCount > 0 ? bucket.rangeCount / bucket.rangeDistinctCount
+                                                 : 0;
+        }
+    }
+    return 0;
+}
+
+double Histogram::estimateCumulativeCount(const BSONElement& value, bool inclusive) const {
+    double count = 0;
+    const BSONElement* lowerBound = nullptr;
+    for (auto&& bucket : _buckets) {
+        const int cmp = value.woCompare(bucket.upperBound, false);
+        if (cmp > 0) {
+            count += bucket.rangeCount + bucket.equalCount;
+            lowerBound = &bucket.upperBound;
+            continue;
+        }
+
+        if (cmp == 0) {
+            return count + bucket.rangeCount + (inclusive ? bucket.equalCount : 0);
+        }
+
+        // The value lies strictly inside this bucket.
+        double below = bucket.rangeCount * interpolate(lowerBound, bucket.upperBound, value);
+        if (inclusive) {
+            below += std::min(estimateEqualityCount(value), bucket.rangeCount - below);
+        }
+        return count + below;
+    }
+    return count;
+}
+
+double Histogram::estimateCardinality(const Interval& interval) const {
+    if (_buckets.empty()) {
+        return 0;
+    }
+
+    if (interval.isPoint()) {
+        return estimateEqualityCount(interval.start);
+    }
+
+    const bool ascending = interval.getDirection() != Interval::Direction::kDirectionDescending;
+    const auto& low = ascending ? interval.start : interval.end;
+    const bool lowInclusive = ascending ? interval.startInclusive : interval.endInclusive;
+    const auto& high = ascending ? interval.end : interval.start;
+    const bool highInclusive = ascending ? interval.endInclusive : interval.startInclusive;
+
+    return std::max(0.0,
+                    estimateCumulativeCount(high, highInclusive) -
+                        estimateCumulativeCount(low, !lowInclusive));
+}
+
+double Histogram::estimateSelectivity(const Interval& interval) const {
+    if (_totalCount <= 0) {
+        return 1.0;
+    }
+    return std::min(1.0, estimateCardinality(interval) / _totalCount);
+}
+
+BSONObj Histogram::toBSON() const {
+    BSONObjBuilder bob;
+    {
+        BSONArrayBuilder bucketsBuilder(bob.subarrayStart("buckets"));
+        for (auto&& bucket : _buckets) {
+            BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+            bucketBuilder.appendAs(bucket.upperBound, "upperBound");
+            bucketBuilder.append("equalCount", bucket.equalCount);
+            bucketBuilder.append("rangeCount", bucket.rangeCount);
+            bucketBuilder.append("rangeDistinctCount", bucket.rangeDistinctCount);
+        }
+    }
+    bob.append("totalCount", _totalCount);
+    return bob.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/interval.h"
+
+namespace mongo {
+
+/**
+ * An equi-depth histogram over the values of a single field, built from a sample of documents or
+ * index keys. Values are ordered the same way as they are in an index with the simple collation,
+ * so the histogram can be used to estimate the number of keys an index scan over a given set of
+ * intervals will examine.
+ *
+ * Each bucket stores its inclusive upper bound, the number of values equal to that bound, and the
+ * number and distinct count of the values which lie strictly between the previous bucket's upper
+ * bound and its own.
+ */
+class Histogram {
+public:
+    /**
+     * Builds a histogram with at most 'maxBuckets' buckets from 'values'. The elements of
+     * 'values' are only referenced while building; the histogram owns copies of the bucket
+     * boundaries. 'values' is sorted in place.
+     */
+    static Histogram make(std::vector<BSONElement>* values, size_t maxBuckets);
+
+    Histogram() = default;
+
+    /**
+     * Returns the number of values the histogram was built from.
+     */
+    double getTotalCount() const {
+        return _totalCount;
+    }
+
+    size_t getNumBuckets() const {
+        return _buckets.size();
+    }
+
+    /**
+     * Returns the estimated number of values which fall into 'interval'. The interval may be
+     * oriented in either direction.
+     */
+    double estimateCardinality(const Interval& interval) const;
+
+    /**
+     * Returns the estimated fraction of values which fall into 'interval', between 0 and 1.
+     */
+    double estimateSelectivity(const Interval& interval) const;
+
+    /**
+     * Serializes the buckets of the histogram for debugging purposes.
+     */
+    BSONObj toBSON() const;
+
+private:
+    struct Bucket {
+        BSONElement upperBound;
+
+        // The number of values equal to 'upperBound'.
+        double equalCount = 0;
+
+        // The number of values, and the number of distinct values, strictly between the previous
+        // bucket's upper bound and 'upperBound'.
+        double rangeCount = 0;
+        double rangeDistinctCount = 0;
+    };
+
+    /**
+     * Returns the estimated number of values less than 'value', or less than or equal to it if
+     * 'inclusive' is true.
+     */
+    double estimateCumulativeCount(const BSONElement& value, bool inclusive) const;
+
+    /**
+     * Returns the estimated number of values equal to 'value'.
+     */
+    double estimateEqualityCount(const BSONElement& value) const;
+
+    // Owns the values that the 'upperBound' of each bucket points into.
+    BSONObj _boundsHolder;
+    std::vector<Bucket> _buckets;
+    double _totalCount = 0;
+};
+
+}  // namespace mongo
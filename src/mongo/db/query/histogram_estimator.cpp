@@ -0,0 +1,331 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram_estimator.h"
+
+#include <set>
+
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo::histogram_estimator {
+namespace {
+/**
+ * Process-wide cache of the histograms built for each collection and field.
+ */
+class HistogramCache {
+public:
+    static HistogramCache& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns the histogram for 'path' in the collection 'uuid' if one was built no earlier than
+     * 'notBefore', or nullptr otherwise.
+     */
+    std::shared_ptr<const Histogram> lookup(const UUID& uuid, StringData path, Date_t notBefore) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _entries.find(makeKey(uuid, path));
+        if (it == _entries.end() || it->second.timeOfCreation < notBefore) {
+            return nullptr;
+        }
+        return it->second.histogram;
+    }
+
+    void insert(const UUID& uuid,
+                StringData path,
+                std::shared_ptr<const Histogram> histogram,
+                Date_t now) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        // Entries of dropped collections are never looked up again, so bound the size of the
+        // cache by starting afresh once it grows too large.
+        if (_entries.size() >= kMaxEntries) {
+            _entries.clear();
+        }
+        _entries[makeKey(uuid, path)] = {std::move(histogram), now};
+    }
+
+private:
+    static constexpr size_t kMaxEntries = 10 * 1000;
+
+    struct Entry {
+        std::shared_ptr<const Histogram> histogram;
+        Date_t timeOfCreation;
+    };
+
+    static std::string makeKey(const UUID& uuid, StringData path) {
+        return str::stream() << uuid.toString() << '/' << path;
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("HistogramCache::_mutex");
+    StringMap<Entry> _entries;
+};
+
+const auto getHistogramCache = ServiceContext::declareDecoration<HistogramCache>();
+
+HistogramCache& HistogramCache::get(ServiceContext* serviceContext) {
+    return getHistogramCache(serviceContext);
+}
+
+/**
+ * Collects the paths of the fields of every index scanned by the plan rooted at 'node'.
+ */
+void collectIndexScanPaths(const QuerySolutionNode* node, std::set<std::string>* paths) {
+    if (node->getType() == STAGE_IXSCAN) {
+        for (auto&& elem : static_cast<const IndexScanNode*>(node)->index.keyPattern) {
+            paths->insert(elem.fieldName());
+        }
+    }
+    for (auto&& child : node->children) {
+        collectIndexScanPaths(child, paths);
+    }
+}
+
+/**
+ * Builds histograms over 'paths' from a sample of the documents in 'collection'. Returns an empty
+ * map if the collection cannot be sampled.
+ */
+HistogramMap buildHistograms(OperationContext* opCtx,
+                             const CollectionPtr& collection,
+                             const std::set<std::string>& paths) {
+    const auto sampleSize = static_cast<size_t>(internalQueryHistogramSampleSize.load());
+    auto recordStore = collection->getRecordStore();
+
+    // Small collections are read in their entirety, larger ones are sampled with a random cursor
+    // unless tests asked for a reproducible sample.
+    std::vector<BSONObj> docs;
+    const bool readAll = collection->numRecords(opCtx) <= static_cast<long long>(sampleSize) ||
+        internalQueryHistogramSampleDeterministically.load();
+    auto cursor = readAll ? recordStore->getCursor(opCtx) : recordStore->getRandomCursor(opCtx);
+    if (!cursor) {
+        return {};
+    }
+    while (docs.size() < sampleSize) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+        docs.push_back(record->data.toBson().getOwned());
+    }
+    if (docs.empty()) {
+        return {};
+    }
+
+    // Documents which are missing the field are indexed as null.
+    static const BSONObj kNullObj = BSON("" << BSONNULL);
+    const auto maxBuckets = static_cast<size_t>(internalQueryHistogramMaxBuckets.load());
+
+    HistogramMap histograms;
+    for (auto&& path : paths) {
+        std::vector<BSONElement> values;
+        for (auto&& doc : docs) {
+            BSONElementSet elements;
+            dotted_path_support::extractAllElementsAlongPath(doc, path, elements);
+            if (elements.empty()) {
+                values.push_back(kNullObj.firstElement());
+            }
+            values.insert(values.end(), elements.begin(), elements.end());
+        }
+        histograms[path] =
+            std::make_shared<const Histogram>(Histogram::make(&values, maxBuckets));
+    }
+    return histograms;
+}
+
+/**
+ * Returns the estimated fraction of the index keys which fall into 'bounds', assuming the fields
+ * of the index are independent, or boost::none if estimation is not possible.
+ */
+boost::optional<double> estimateIndexScanSelectivity(const IndexScanNode& node,
+                                                     const HistogramMap& histograms) {
+    const auto& index = node.index;
+    if (index.type != INDEX_BTREE || index.collator || node.bounds.isSimpleRange ||
+        node.bounds.fields.size() != static_cast<size_t>(index.keyPattern.nFields())) {
+        return boost::none;
+    }
+
+    double selectivity = 1.0;
+    for (auto&& oil : node.bounds.fields) {
+        if (oil.intervals.size() == 1 &&
+            (oil.intervals[0].isMinToMax() || oil.intervals[0].isMaxToMin())) {
+            continue;
+        }
+
+        auto it = histograms.find(oil.name);
+        if (it == histograms.end()) {
+            return boost::none;
+        }
+
+        double fieldSelectivity = 0;
+        for (auto&& interval : oil.intervals) {
+            fieldSelectivity += it->second->estimateSelectivity(interval);
+        }
+        selectivity *= std::min(1.0, fieldSelectivity);
+    }
+    return selectivity;
+}
+}  // namespace
+
+boost::optional<double> estimateSolutionCost(const QuerySolutionNode* root,
+                                             const HistogramMap& histograms,
+                                             double numRecords) {
+    switch (root->getType()) {
+        case STAGE_COLLSCAN:
+            return numRecords;
+        case STAGE_IXSCAN: {
+            auto selectivity =
+                estimateIndexScanSelectivity(*static_cast<const IndexScanNode*>(root), histograms);
+            if (!selectivity) {
+                return boost::none;
+            }
+            return *selectivity * numRecords;
+        }
+        default:
+            break;
+    }
+
+    // We only know how to estimate collection and index scans. Any other kind of leaf makes the
+    // cost of the whole plan unknown.
+    if (root->children.empty()) {
+        return boost::none;
+    }
+
+    double cost = 0;
+    for (auto&& child : root->children) {
+        auto childCost = estimateSolutionCost(child, histograms, numRecords);
+        if (!childCost) {
+            return boost::none;
+        }
+        cost += *childCost;
+    }
+    return cost;
+}
+
+void pruneSolutions(OperationContext* opCtx,
+                    const CollectionPtr& collection,
+                    const CanonicalQuery& cq,
+                    std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    const auto minCandidates =
+        static_cast<size_t>(internalQueryPlannerHistogramPruningMinCandidates.load());
+    if (minCandidates == 0 || solutions->size() < minCandidates || !collection) {
+        return;
+    }
+
+    // The cost of a blocking sort is not modeled, and the histograms are built using the simple
+    // collation.
+    if (cq.getSortPattern() || cq.getCollator()) {
+        return;
+    }
+
+    const double numRecords = collection->numRecords(opCtx);
+    if (numRecords <= 0) {
+        return;
+    }
+
+    std::set<std::string> paths;
+    for (auto&& solution : *solutions) {
+        collectIndexScanPaths(solution->root(), &paths);
+    }
+
+    // Look up the histograms which are still fresh and build the rest from a single sample.
+    auto& cache = HistogramCache::get(opCtx->getServiceContext());
+    const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+    const auto notBefore = now - Seconds{internalQueryHistogramRefreshIntervalSecs.load()};
+    const auto uuid = collection->uuid();
+
+    HistogramMap histograms;
+    std::set<std::string> missingPaths;
+    for (auto&& path : paths) {
+        if (auto histogram = cache.lookup(uuid, path, notBefore)) {
+            histograms[path] = std::move(histogram);
+        } else {
+            missingPaths.insert(path);
+        }
+    }
+    if (!missingPaths.empty()) {
+        for (auto&& [path, histogram] : buildHistograms(opCtx, collection, missingPaths)) {
+            cache.insert(uuid, path, histogram, now);
+            histograms[path] = histogram;
+        }
+    }
+
+    std::vector<boost::optional<double>> costs;
+    boost::optional<double> bestCost;
+    double sampleCount = 0;
+    for (auto&& [path, histogram] : histograms) {
+        sampleCount = std::max(sampleCount, histogram->getTotalCount());
+    }
+    for (auto&& solution : *solutions) {
+        costs.push_back(estimateSolutionCost(solution->root(), histograms, numRecords));
+        if (costs.back() && (!bestCost || *costs.back() < *bestCost)) {
+            bestCost = costs.back();
+        }
+    }
+    if (!bestCost) {
+        return;
+    }
+
+    // A sampled value stands for about 'numRecords / sampleCount' documents, so estimates below
+    // that resolution are not meaningful.
+    const double resolution = sampleCount > 0 ? numRecords / sampleCount : numRecords;
+    const double threshold = internalQueryPlannerHistogramPruningRatio.load() *
+        std::max({*bestCost, resolution, 1.0});
+
+    const auto numCandidates = solutions->size();
+    size_t idx = 0;
+    solutions->erase(std::remove_if(solutions->begin(),
+                                    solutions->end(),
+                                    [&](const auto&) {
+                                        auto&& cost = costs[idx++];
+                                        return cost && *cost > threshold;
+                                    }),
+                     solutions->end());
+    invariant(!solutions->empty());
+
+    if (solutions->size() < numCandidates) {
+        LOGV2_DEBUG(5899200,
+                    2,
+                    "Pruned candidate plans using histogram-based cardinality estimates",
+                    "query"_attr = redact(cq.toStringShort()),
+                    "numCandidates"_attr = numCandidates,
+                    "numRemaining"_attr = solutions->size(),
+                    "bestEstimatedCost"_attr = *bestCost);
+    }
+}
+
+}  // namespace mongo::histogram_estimator
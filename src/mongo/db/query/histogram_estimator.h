@@ -0,0 +1,79 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/histogram.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class CanonicalQuery;
+class CollectionPtr;
+class OperationContext;
+class QuerySolution;
+struct QuerySolutionNode;
+
+namespace histogram_estimator {
+
+/**
+ * Histograms over the fields of a collection, keyed by field path.
+ */
+using HistogramMap = StringMap<std::shared_ptr<const Histogram>>;
+
+/**
+ * Returns the estimated cost of executing the plan rooted at 'root' against a collection of
+ * 'numRecords' documents, measured as the number of index keys and documents scanned. Returns
+ * boost::none if the plan contains a scan whose cost cannot be estimated using 'histograms'.
+ */
+boost::optional<double> estimateSolutionCost(const QuerySolutionNode* root,
+                                             const HistogramMap& histograms,
+                                             double numRecords);
+
+/**
+ * When there are at least 'internalQueryPlannerHistogramPruningMinCandidates' solutions, uses
+ * histograms sampled from 'collection' to estimate the cost of each solution and removes those
+ * whose estimated cost exceeds 'internalQueryPlannerHistogramPruningRatio' times the cost of the
+ * cheapest one, so that they do not take part in the multi-planning trial period. Solutions whose
+ * cost cannot be estimated are always kept, as is at least one solution.
+ *
+ * Histograms are cached per collection and field and rebuilt once they are older than
+ * 'internalQueryHistogramRefreshIntervalSecs'.
+ */
+void pruneSolutions(OperationContext* opCtx,
+                    const CollectionPtr& collection,
+                    const CanonicalQuery& cq,
+                    std::vector<std::unique_ptr<QuerySolution>>* solutions);
+
+}  // namespace histogram_estimator
+}  // namespace mongo
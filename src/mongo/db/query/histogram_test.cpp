@@ -0,0 +1,177 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/histogram.h"
+
+#include "mongo/db/catalog/index_catalog_entry.h"
+#include "mongo/db/index_names.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/histogram_estimator.h"
+#include "mongo/db/query/index_entry.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+IndexEntry buildSimpleIndexEntry(const BSONObj& kp) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            IndexDescriptor::kLatestIndexVersion,
+            false,
+            {},
+            {},
+            false,
+            false,
+            CoreIndexInfo::Identifier("test_foo"),
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+/**
+ * Builds a histogram over the integers [0, 'n'), each of which appears 'repeat' times.
+ */
+Histogram makeUniformHistogram(int n, int repeat, size_t maxBuckets) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < repeat; ++j) {
+            bab.append(i);
+        }
+    }
+    BSONArray arr = bab.arr();
+    std::vector<BSONElement> values;
+    for (auto&& elem : arr) {
+        values.push_back(elem);
+    }
+    return Histogram::make(&values, maxBuckets);
+}
+
+Interval makeInterval(BSONObj bounds, bool startInclusive, bool endInclusive) {
+    return Interval(bounds, startInclusive, endInclusive);
+}
+
+TEST(HistogramTest, EmptyHistogram) {
+    std::vector<BSONElement> values;
+    auto histogram = Histogram::make(&values, 10);
+    ASSERT_EQ(histogram.getTotalCount(), 0);
+    ASSERT_EQ(histogram.getNumBuckets(), 0U);
+    ASSERT_EQ(histogram.estimateCardinality(makeInterval(BSON("" << 1 << "" << 1), true, true)),
+              0);
+}
+
+TEST(HistogramTest, RespectsMaxBuckets) {
+    auto histogram = makeUniformHistogram(1000, 1, 16);
+    ASSERT_EQ(histogram.getTotalCount(), 1000);
+    ASSERT_LTE(histogram.getNumBuckets(), 16U);
+    ASSERT_GT(histogram.getNumBuckets(), 0U);
+}
+
+TEST(HistogramTest, EstimatesPointInterval) {
+    auto histogram = makeUniformHistogram(100, 5, 10);
+    auto estimate =
+        histogram.estimateCardinality(makeInterval(BSON("" << 42 << "" << 42), true, true));
+    ASSERT_APPROX_EQUAL(estimate, 5.0, 1.0);
+
+    // Values outside of the range of the histogram are not expected to exist.
+    ASSERT_EQ(histogram.estimateCardinality(makeInterval(BSON("" << 500 << "" << 500), true, true)),
+              0);
+}
+
+TEST(HistogramTest, EstimatesRangeInterval) {
+    auto histogram = makeUniformHistogram(1000, 1, 20);
+    auto estimate =
+        histogram.estimateCardinality(makeInterval(BSON("" << 100 << "" << 300), true, false));
+    ASSERT_APPROX_EQUAL(estimate, 200.0, 20.0);
+
+    ASSERT_APPROX_EQUAL(
+        histogram.estimateSelectivity(makeInterval(BSON("" << 100 << "" << 300), true, false)),
+        0.2,
+        0.02);
+}
+
+TEST(HistogramTest, DescendingIntervalMatchesAscending) {
+    auto histogram = makeUniformHistogram(1000, 1, 20);
+    auto ascending =
+        histogram.estimateCardinality(makeInterval(BSON("" << 100 << "" << 300), true, true));
+    auto descending =
+        histogram.estimateCardinality(makeInterval(BSON("" << 300 << "" << 100), true, true));
+    ASSERT_APPROX_EQUAL(ascending, descending, 1e-9);
+}
+
+TEST(HistogramTest, EntireRangeSelectsEverything) {
+    auto histogram = makeUniformHistogram(1000, 1, 20);
+    BSONObjBuilder bob;
+    bob.appendMinKey("");
+    bob.appendMaxKey("");
+    ASSERT_APPROX_EQUAL(histogram.estimateSelectivity(makeInterval(bob.obj(), true, true)),
+                        1.0,
+                        1e-9);
+}
+
+TEST(HistogramEstimatorTest, CollectionScanCostsEveryRecord) {
+    CollectionScanNode node;
+    histogram_estimator::HistogramMap histograms;
+    auto cost = histogram_estimator::estimateSolutionCost(&node, histograms, 1000);
+    ASSERT(cost);
+    ASSERT_EQ(*cost, 1000);
+}
+
+TEST(HistogramEstimatorTest, IndexScanCostUsesHistogram) {
+    histogram_estimator::HistogramMap histograms;
+    histograms["a"] = std::make_shared<const Histogram>(makeUniformHistogram(1000, 1, 20));
+
+    auto ixscan = std::make_unique<IndexScanNode>(buildSimpleIndexEntry(BSON("a" << 1)));
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(makeInterval(BSON("" << 0 << "" << 100), true, false));
+    ixscan->bounds.fields.push_back(oil);
+
+    FetchNode fetch;
+    fetch.children.push_back(ixscan.release());
+
+    auto cost = histogram_estimator::estimateSolutionCost(&fetch, histograms, 10000);
+    ASSERT(cost);
+    ASSERT_APPROX_EQUAL(*cost, 1000.0, 100.0);
+}
+
+TEST(HistogramEstimatorTest, IndexScanCostUnknownWithoutHistogram) {
+    histogram_estimator::HistogramMap histograms;
+    IndexScanNode ixscan(buildSimpleIndexEntry(BSON("a" << 1)));
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(makeInterval(BSON("" << 0 << "" << 100), true, false));
+    ixscan.bounds.fields.push_back(oil);
+
+    ASSERT_FALSE(histogram_estimator::estimateSolutionCost(&ixscan, histograms, 10000));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include <fmt/format.h>
 #include <list>
 #include <memory>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/stdx/unordered_map.h"
@@ -133,10 +134,11 @@ public:
      * The least recently used entry is evicted if the
      * kv-store is full prior to the add() operation.
      *
-     * If an entry is evicted, it will be returned in
-     * an unique_ptr for the caller to use before disposing.
+     * As many of the least recently used entries as needed
+     * to get back within budget are evicted, and returned
+     * for the caller to use before disposing.
      */
-    std::unique_ptr<V> add(const K& key, V* entry) {
+    std::vector<std::unique_ptr<V>> add(const K& key, V* entry) {
         // If the key already exists, delete it first.
         KVMapConstIt i = _kvMap.find(key);
         if (i != _kvMap.end()) {
@@ -153,21 +155,31 @@ public:
 
         // If the store has grown beyond its allowed size,
         // evict the least recently used entries.
+        std::vector<std::unique_ptr<V>> evictedEntries;
         while (_budgetTracker.isOverBudget()) {
             invariant(!_kvList.empty());
-            V* evictedEntry = _kvList.back().second;
-            invariant(evictedEntry);
-
-            _budgetTracker.onRemove(*evictedEntry);
-            _kvMap.erase(_kvList.back().first);
-            _kvList.pop_back();
+            evictedEntries.push_back(evictLeastRecentlyUsed());
+        }
+        return evictedEntries;
+    }
 
-            // Pass ownership of evicted entry to caller.
-            // If caller chooses to ignore this unique_ptr,
-            // the evicted entry will be deleted automatically.
-            return std::unique_ptr<V>(evictedEntry);
+    /**
+     * Removes the least recently used entry from the kv-store and passes its ownership to the
+     * caller. If the caller chooses to ignore the returned unique_ptr, the evicted entry will be
+     * deleted automatically. Returns nullptr if the kv-store is empty.
+     */
+    std::unique_ptr<V> evictLeastRecentlyUsed() {
+        if (_kvList.empty()) {
+            return nullptr;
         }
-        return std::unique_ptr<V>();
+
+        V* evictedEntry = _kvList.back().second;
+        invariant(evictedEntry);
+
+        _budgetTracker.onRemove(*evictedEntry);
+        _kvMap.erase(_kvList.back().first);
+        _kvList.pop_back();
+        return std::unique_ptr<V>(evictedEntry);
     }
 
     /**
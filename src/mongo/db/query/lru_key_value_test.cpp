@@ -107,8 +107,8 @@ TEST(LRUKeyValueTest, EvictionTest) {
     int maxSize = 10;
     TestKeyValue cache{BudgetTracker(maxSize)};
     for (int i = 0; i < maxSize; ++i) {
-        std::unique_ptr<int> evicted = cache.add(i, new int(i));
-        ASSERT(nullptr == evicted.get());
+        auto evicted = cache.add(i, new int(i));
+        ASSERT(evicted.empty());
     }
     ASSERT_EQUALS(cache.size(), (size_t)maxSize);
 
@@ -122,10 +122,10 @@ TEST(LRUKeyValueTest, EvictionTest) {
     }
 
     // Adding another entry causes an eviction.
-    std::unique_ptr<int> evicted = cache.add(maxSize + 1, new int(maxSize + 1));
+    auto evicted = cache.add(maxSize + 1, new int(maxSize + 1));
     ASSERT_EQUALS(cache.size(), (size_t)maxSize);
-    ASSERT(nullptr != evicted.get());
-    ASSERT_EQUALS(*evicted, evictKey);
+    ASSERT_EQUALS(evicted.size(), 1U);
+    ASSERT_EQUALS(*evicted[0], evictKey);
 
     // Check that the least recently accessed has been evicted.
     for (int i = 0; i < maxSize; ++i) {
@@ -147,8 +147,8 @@ TEST(LRUKeyValueTest, PromotionTest) {
     int maxSize = 10;
     TestKeyValue cache{BudgetTracker(maxSize)};
     for (int i = 0; i < maxSize; ++i) {
-        std::unique_ptr<int> evicted = cache.add(i, new int(i));
-        ASSERT(nullptr == evicted.get());
+        auto evicted = cache.add(i, new int(i));
+        ASSERT(evicted.empty());
     }
     ASSERT_EQUALS(cache.size(), (size_t)maxSize);
 
@@ -158,8 +158,8 @@ TEST(LRUKeyValueTest, PromotionTest) {
 
     // Evict all but one of the original entries.
     for (int i = maxSize; i < (maxSize + maxSize - 1); ++i) {
-        std::unique_ptr<int> evicted = cache.add(i, new int(i));
-        ASSERT(nullptr != evicted.get());
+        auto evicted = cache.add(i, new int(i));
+        ASSERT_EQUALS(evicted.size(), 1U);
     }
     ASSERT_EQUALS(cache.size(), (size_t)maxSize);
 
@@ -173,6 +173,41 @@ TEST(LRUKeyValueTest, PromotionTest) {
     }
 }
 
+/**
+ * Test that adding an entry which is larger than the least recently used one evicts as many
+ * entries as needed to get back within budget.
+ */
+TEST(LRUKeyValueTest, EvictsMultipleEntriesToStayWithinBudget) {
+    struct ValueEstimator {
+        size_t operator()(int value) {
+            return value;
+        }
+    };
+    LRUKeyValue<int, int, ValueEstimator> cache{LRUBudgetTracker<int, ValueEstimator>(10)};
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(cache.add(i, new int(2)).empty());
+    }
+    ASSERT_EQUALS(cache.size(), 10U);
+
+    // An entry of size 5 requires the three least recently used entries to go.
+    auto evicted = cache.add(5, new int(5));
+    ASSERT_EQUALS(evicted.size(), 3U);
+    ASSERT_EQUALS(cache.size(), 9U);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_FALSE(cache.hasKey(i));
+    }
+    ASSERT_TRUE(cache.hasKey(3));
+    ASSERT_TRUE(cache.hasKey(4));
+    ASSERT_TRUE(cache.hasKey(5));
+
+    // Evicting explicitly removes the least recently used entry.
+    auto lru = cache.evictLeastRecentlyUsed();
+    ASSERT(lru);
+    ASSERT_EQUALS(*lru, 2);
+    ASSERT_FALSE(cache.hasKey(3));
+    ASSERT_EQUALS(cache.size(), 7U);
+}
+
 /**
  * Test that calling add() with a key that already exists
  * in the kv-store deletes the existing entry.
@@ -123,6 +123,21 @@ void logPromoteCacheEntry(std::string&& query,
                 "oldWorks"_attr = works,
                 "newWorks"_attr = newWorks);
 }
+
+void logRecreateEvictedCacheEntry(std::string&& query,
+                                  std::string&& queryHash,
+                                  std::string&& planCacheKey,
+                                  size_t evictedWorks,
+                                  size_t newWorks) {
+    LOGV2_DEBUG(5899300,
+                1,
+                "Recreating evicted cache entry for query as an active entry",
+                "query"_attr = redact(query),
+                "queryHash"_attr = queryHash,
+                "planCacheKey"_attr = planCacheKey,
+                "evictedWorks"_attr = evictedWorks,
+                "newWorks"_attr = newWorks);
+}
 }  // namespace log_detail
 
 namespace plan_cache_detail {
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/optional/optional.hpp>
 #include <set>
 
@@ -40,6 +41,7 @@
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/container_size_helper.h"
 
 namespace mongo {
@@ -86,6 +88,11 @@ void logPromoteCacheEntry(std::string&& query,
                           std::string&& planCacheKey,
                           size_t works,
                           size_t newWorks);
+void logRecreateEvictedCacheEntry(std::string&& query,
+                                  std::string&& queryHash,
+                                  std::string&& planCacheKey,
+                                  size_t evictedWorks,
+                                  size_t newWorks);
 }  // namespace log_detail
 
 class QuerySolution;
@@ -94,6 +101,59 @@ struct QuerySolutionNode;
 template <class CachedPlanType>
 class PlanCacheEntryBase;
 
+/**
+ * Statistics accumulated over executions of a cached plan. They are compared with the productivity
+ * the plan had when it was ranked in order to detect plans which no longer perform as well as when
+ * they were cached, for example because the data is skewed and the plan was chosen for a parameter
+ * value which is not representative.
+ */
+struct PlanCacheEntryRuntimeStats {
+    /**
+     * Returns the number of documents returned per unit of work, guarding against division by
+     * zero.
+     */
+    static double productivity(size_t docsReturned, size_t works) {
+        return static_cast<double>(docsReturned) / std::max(works, static_cast<size_t>(1));
+    }
+
+    double observedProductivity() const {
+        return productivity(totalDocsReturned, totalWorks);
+    }
+
+    /**
+     * Returns true if at least 'minExecutions' executions have been recorded and the observed
+     * productivity has fallen below 'driftRatio' times the productivity at decision time. A
+     * 'driftRatio' of zero disables the check.
+     */
+    bool hasDrifted(size_t minExecutions, double driftRatio) const {
+        return driftRatio > 0 && numExecutions >= minExecutions && decisionProductivity > 0 &&
+            observedProductivity() < decisionProductivity * driftRatio;
+    }
+
+    void recordExecution(size_t keysExamined,
+                         size_t docsExamined,
+                         size_t docsReturned,
+                         size_t works) {
+        ++numExecutions;
+        totalKeysExamined += keysExamined;
+        totalDocsExamined += docsExamined;
+        totalDocsReturned += docsReturned;
+        totalWorks += works;
+    }
+
+    // The productivity of the winning plan during the trial period in which it was ranked.
+    double decisionProductivity = 0;
+
+    size_t numExecutions = 0;
+    size_t totalKeysExamined = 0;
+    size_t totalDocsExamined = 0;
+    size_t totalDocsReturned = 0;
+
+    // Measured in the same units as the 'works' of the cache entry: work cycles for the classic
+    // engine and physical reads for SBE.
+    size_t totalWorks = 0;
+};
+
 /**
  * Information returned from a get(...) query.
  */
@@ -218,6 +278,21 @@ public:
         size_t works) {
         invariant(decision);
 
+        PlanCacheEntryRuntimeStats runtimeStats;
+        runtimeStats.decisionProductivity = stdx::visit(
+            visit_helper::Overloaded{[](const plan_ranker::StatsDetails& details) {
+                                         const auto& common = details.candidatePlanStats[0]->common;
+                                         return PlanCacheEntryRuntimeStats::productivity(
+                                             common.advanced, common.works);
+                                     },
+                                     [](const plan_ranker::SBEStatsDetails& details) {
+                                         auto stats = details.candidatePlanStats[0].get();
+                                         return PlanCacheEntryRuntimeStats::productivity(
+                                             stats->common.advances,
+                                             calculateNumberOfReads(stats));
+                                     }},
+            decision->stats);
+
         // If the cumulative size of the plan caches is estimated to remain within a predefined
         // threshold, then then include additional debug info which is not strictly necessary for
         // the plan cache to be functional. Once the cumulative plan cache size exceeds this
@@ -254,7 +329,8 @@ public:
                                                    planCacheKey,
                                                    isActive,
                                                    works,
-                                                   std::move(debugInfo)));
+                                                   std::move(debugInfo),
+                                                   runtimeStats));
     }
 
     ~PlanCacheEntryBase() {
@@ -277,7 +353,8 @@ public:
                                                    planCacheKey,
                                                    isActive,
                                                    works,
-                                                   std::move(debugInfoCopy)));
+                                                   std::move(debugInfoCopy),
+                                                   runtimeStats));
     }
 
     std::string debugString() const {
@@ -315,6 +392,9 @@ public:
     // cause this value to be increased.
     size_t works = 0;
 
+    // Statistics from executions of this cached plan since the entry was created.
+    PlanCacheEntryRuntimeStats runtimeStats;
+
     // Optional debug info containing detailed statistics. Includes a description of the query which
     // resulted in this plan cache's creation as well as runtime stats from the multi-planner trial
     // period that resulted in this cache entry.
@@ -333,6 +413,12 @@ public:
      */
     inline static Counter64 planCacheTotalSizeEstimateBytes;
 
+    /**
+     * Tracks the number of entries evicted from the plan caches across all the collections in
+     * order to stay within their budget.
+     */
+    inline static Counter64 planCacheEvictions;
+
 private:
     /**
      * All arguments constructor.
@@ -343,13 +429,15 @@ private:
                        uint32_t planCacheKey,
                        bool isActive,
                        size_t works,
-                       boost::optional<DebugInfo> debugInfo)
+                       boost::optional<DebugInfo> debugInfo,
+                       PlanCacheEntryRuntimeStats runtimeStats)
         : cachedPlan(std::move(cachedPlan)),
           timeOfCreation(timeOfCreation),
           queryHash(queryHash),
           planCacheKey(planCacheKey),
           isActive(isActive),
           works(works),
+          runtimeStats(runtimeStats),
           debugInfo(std::move(debugInfo)),
           estimatedEntrySizeBytes(_estimateObjectSizeInBytes()) {
         invariant(this->cachedPlan);
@@ -470,7 +558,14 @@ public:
 
     PlanCacheBase(size_t size) : PlanCacheBase(BudgetTracker(size)) {}
 
-    PlanCacheBase(BudgetTracker&& budgetTracker) : _cache{std::move(budgetTracker)} {}
+    /**
+     * If 'enforceMemoryBudget' is true, then in addition to the budget of 'budgetTracker' the
+     * cache evicts its least recently used entries whenever their estimated size exceeds
+     * 'internalQueryCacheMaxSizeBytesPerCollection', or whenever the estimated size of all the
+     * plan caches of this type exceeds 'internalQueryCacheMaxTotalSizeBytes'.
+     */
+    PlanCacheBase(BudgetTracker&& budgetTracker, bool enforceMemoryBudget = false)
+        : _cache{std::move(budgetTracker)}, _enforceMemoryBudget{enforceMemoryBudget} {}
 
     ~PlanCacheBase() = default;
 
@@ -550,11 +645,20 @@ public:
                 queryHash = key.queryHash();
             }
 
+            boost::optional<size_t> evictedWorks;
+            if (!oldEntry) {
+                if (auto it = _evictedEntryWorks.find(planCacheKey);
+                    it != _evictedEntryWorks.end()) {
+                    evictedWorks = it->second;
+                }
+            }
+
             const auto newState = getNewEntryState(
                 query,
                 queryHash,
                 planCacheKey,
                 oldEntry,
+                evictedWorks,
                 newWorks,
                 worksGrowthCoefficient.get_value_or(internalQueryCacheWorksGrowthCoefficient));
 
@@ -574,11 +678,8 @@ public:
                                     isNewEntryActive,
                                     newWorks));
 
-        auto evictedEntry = _cache.add(key, newEntry.release());
-
-        if (nullptr != evictedEntry.get()) {
-            log_detail::logCacheEviction(query.nss(), evictedEntry->debugString());
-        }
+        _evictedEntryWorks.erase(planCacheKey);
+        addEntry(query.nss(), key, std::move(newEntry));
 
         return Status::OK();
     }
@@ -606,6 +707,29 @@ public:
         entry->isActive = false;
     }
 
+    /**
+     * Folds the statistics of one execution of the cached plan for 'query' into the runtime
+     * statistics of its cache entry. Returns a copy of the updated statistics, or boost::none if
+     * there is no cache entry for 'query'.
+     */
+    boost::optional<PlanCacheEntryRuntimeStats> recordRuntimeStats(const CanonicalQuery& query,
+                                                                   size_t keysExamined,
+                                                                   size_t docsExamined,
+                                                                   size_t docsReturned,
+                                                                   size_t works) {
+        KeyType key = computeKey(query);
+        stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+        Entry* entry = nullptr;
+        Status cacheStatus = _cache.get(key, &entry);
+        if (!cacheStatus.isOK()) {
+            invariant(cacheStatus == ErrorCodes::NoSuchKey);
+            return boost::none;
+        }
+        invariant(entry);
+        entry->runtimeStats.recordExecution(keysExamined, docsExamined, docsReturned, works);
+        return entry->runtimeStats;
+    }
+
     /**
      * Look up the cached data access for the provided 'query'.  Used by the query planner
      * to shortcut planning.
@@ -660,8 +784,14 @@ public:
      * was present and removed and an error status otherwise.
      */
     Status remove(const CanonicalQuery& cq) {
+        const auto key = computeKey(cq);
         stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-        return _cache.remove(computeKey(cq));
+        _evictedEntryWorks.erase(key.planCacheKeyHash());
+        Entry* entry = nullptr;
+        if (_cache.get(key, &entry).isOK()) {
+            _cachedBytes -= entry->estimatedEntrySizeBytes;
+        }
+        return _cache.remove(key);
     }
 
     /**
@@ -670,6 +800,8 @@ public:
     void clear() {
         stdx::lock_guard<Latch> cacheLock(_cacheMutex);
         _cache.clear();
+        _cachedBytes = 0;
+        _evictedEntryWorks.clear();
     }
 
     /**
@@ -736,6 +868,14 @@ public:
         return _cache.size();
     }
 
+    /**
+     * Returns the estimated size in bytes of the entries in the cache.
+     */
+    size_t sizeBytes() const {
+        stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+        return _cachedBytes;
+    }
+
     /**
      * Updates internal state kept about the collection's indexes.  Must be called when the set
      * of indexes on the associated collection have changed.
@@ -773,19 +913,97 @@ private:
         bool shouldBeActive = false;
     };
 
+    /**
+     * Adds 'entry' to the cache under 'key', replacing any existing entry, and evicts the least
+     * recently used entries until the cache is within its budget again. Must be called with
+     * '_cacheMutex' held.
+     */
+    void addEntry(const NamespaceString& nss, const KeyType& key, std::unique_ptr<Entry> entry) {
+        Entry* replacedEntry = nullptr;
+        if (_cache.get(key, &replacedEntry).isOK()) {
+            _cachedBytes -= replacedEntry->estimatedEntrySizeBytes;
+        }
+        _cachedBytes += entry->estimatedEntrySizeBytes;
+
+        auto onEviction = [&](std::unique_ptr<Entry> evictedEntry) {
+            _cachedBytes -= evictedEntry->estimatedEntrySizeBytes;
+            Entry::planCacheEvictions.increment();
+            log_detail::logCacheEviction(nss, evictedEntry->debugString());
+            rememberEvictedEntry(*evictedEntry);
+        };
+
+        for (auto&& evictedEntry : _cache.add(key, entry.release())) {
+            onEviction(std::move(evictedEntry));
+        }
+        while (_enforceMemoryBudget && isOverMemoryBudget()) {
+            auto evictedEntry = _cache.evictLeastRecentlyUsed();
+            if (!evictedEntry) {
+                break;
+            }
+            onEviction(std::move(evictedEntry));
+        }
+    }
+
+    /**
+     * Returns true if the entries of this cache, or of all the caches of this type, take more
+     * memory than allowed. Must be called with '_cacheMutex' held.
+     */
+    bool isOverMemoryBudget() const {
+        const auto maxBytes = internalQueryCacheMaxSizeBytesPerCollection.load();
+        if (maxBytes > 0 && _cachedBytes > static_cast<size_t>(maxBytes)) {
+            return true;
+        }
+        const auto maxTotalBytes = internalQueryCacheMaxTotalSizeBytes.load();
+        return maxTotalBytes > 0 &&
+            Entry::planCacheTotalSizeEstimateBytes.get() > static_cast<uint64_t>(maxTotalBytes);
+    }
+
+    /**
+     * Remembers the works value of an entry which was evicted by the LRU policy, so that the entry
+     * need not be vetted again if its shape comes back. Must be called with '_cacheMutex' held.
+     */
+    void rememberEvictedEntry(const Entry& evictedEntry) {
+        const auto maxSize =
+            static_cast<size_t>(internalQueryCacheMaxEvictedEntriesRemembered.load());
+        if (maxSize == 0) {
+            return;
+        }
+        if (_evictedEntryWorks.size() >= maxSize) {
+            _evictedEntryWorks.clear();
+        }
+        _evictedEntryWorks[evictedEntry.planCacheKey] = evictedEntry.works;
+    }
+
     /**
      * Given a query, and an (optional) current cache entry for its shape ('oldEntry'), determine
      * whether:
      * - We should create a new entry
      * - The new entry should be marked 'active'
+     *
+     * If there is no current entry but one with the same plan cache key was evicted by the LRU
+     * policy, 'evictedWorks' holds the works value of that entry.
      */
     NewEntryState getNewEntryState(const CanonicalQuery& query,
                                    uint32_t queryHash,
                                    uint32_t planCacheKey,
                                    Entry* oldEntry,
+                                   boost::optional<size_t> evictedWorks,
                                    size_t newWorks,
                                    double growthCoefficient) {
         NewEntryState res;
+        if (!oldEntry && evictedWorks && newWorks <= *evictedWorks) {
+            // The shape was already vetted before its entry was evicted, and the new plan does at
+            // least as well, so there is no need to go through the inactive state again.
+            log_detail::logRecreateEvictedCacheEntry(query.toStringShort(),
+                                                     zeroPaddedHex(queryHash),
+                                                     zeroPaddedHex(planCacheKey),
+                                                     *evictedWorks,
+                                                     newWorks);
+            res.shouldBeCreated = true;
+            res.shouldBeActive = true;
+            return res;
+        }
+
         if (!oldEntry) {
             log_detail::logCreateInactiveCacheEntry(query.toStringShort(),
                                                     zeroPaddedHex(queryHash),
@@ -855,7 +1073,17 @@ private:
 
     LRUKeyValue<KeyType, PlanCacheEntryBase<CachedPlanType>, BudgetEstimator, KeyHasher> _cache;
 
-    // Protects _cache.
+    // Maps the plan cache key hash of recently evicted entries to their works value. Bounded by
+    // 'internalQueryCacheMaxEvictedEntriesRemembered'.
+    stdx::unordered_map<uint32_t, size_t> _evictedEntryWorks;
+
+    // The estimated size in bytes of the entries in '_cache'.
+    size_t _cachedBytes = 0;
+
+    // Whether the memory budgets from the query knobs apply to this cache.
+    const bool _enforceMemoryBudget;
+
+    // Protects _cache, _evictedEntryWorks and _cachedBytes.
     mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
 
     // Holds computed information about the collection's indexes.  Used for generating plan
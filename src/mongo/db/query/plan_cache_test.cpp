@@ -604,6 +604,75 @@ TEST(PlanCacheTest, PlanCacheLRUPolicyRemovesInactiveEntries) {
     ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+TEST(PlanCacheTest, PlanCacheEvictsEntriesToStayWithinMemoryBudget) {
+    PlanCache planCache(PlanCache::BudgetTracker(5000), true /* enforceMemoryBudget */);
+    QueryTestServiceContext serviceContext;
+
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    addCacheEntryForShape(*cqA, &planCache);
+    const auto entrySize = planCache.sizeBytes();
+    ASSERT_GT(entrySize, 0U);
+
+    // Leave room for two entries of about the same size.
+    RAIIServerParameterControllerForTest controller{
+        "internalQueryCacheMaxSizeBytesPerCollection",
+        static_cast<long long>(entrySize * 2 + entrySize / 2)};
+    const auto evictionsBefore = PlanCacheEntry::planCacheEvictions.get();
+
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    addCacheEntryForShape(*cqB, &planCache);
+    ASSERT_EQ(planCache.size(), 2U);
+
+    // A third entry does not fit, so the least recently used one is evicted.
+    unique_ptr<CanonicalQuery> cqC(canonicalize("{c: 1}"));
+    addCacheEntryForShape(*cqC, &planCache);
+    ASSERT_EQ(planCache.size(), 2U);
+    ASSERT_LTE(planCache.sizeBytes(), entrySize * 2 + entrySize / 2);
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(planCache.get(*cqB).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(PlanCacheEntry::planCacheEvictions.get(), evictionsBefore + 1);
+
+    // Removing and clearing entries keeps the size in bytes accurate.
+    ASSERT_OK(planCache.remove(*cqB));
+    ASSERT_LTE(planCache.sizeBytes(), entrySize + entrySize / 2);
+    planCache.clear();
+    ASSERT_EQ(planCache.sizeBytes(), 0U);
+}
+
+TEST(PlanCacheTest, EvictedEntryIsRecreatedActive) {
+    PlanCache planCache(1);
+    QueryTestServiceContext serviceContext;
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    ASSERT_OK(planCache.set(*cqA, qs->cacheData->clone(), solns, createDecision(1U, 10), Date_t{}));
+    ASSERT_OK(planCache.set(*cqA, qs->cacheData->clone(), solns, createDecision(1U, 10), Date_t{}));
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentActive);
+
+    // Adding an entry for another shape evicts the entry for {a: 1}.
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    addCacheEntryForShape(*cqB, &planCache);
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kNotPresent);
+
+    // A plan which performs worse than the evicted one has to go through the inactive state.
+    ASSERT_OK(planCache.set(*cqA, qs->cacheData->clone(), solns, createDecision(1U, 20), Date_t{}));
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentInactive);
+
+    // Evicting the inactive entry remembers its works value. A plan which does at least as well
+    // is cached as active right away, as if the inactive entry had been promoted.
+    addCacheEntryForShape(*cqB, &planCache);
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_OK(planCache.set(*cqA, qs->cacheData->clone(), solns, createDecision(1U, 10), Date_t{}));
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentActive);
+
+    // Clearing the cache forgets about evicted entries.
+    planCache.clear();
+    ASSERT_OK(planCache.set(*cqA, qs->cacheData->clone(), solns, createDecision(1U, 10), Date_t{}));
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentInactive);
+}
+
 TEST(PlanCacheTest, PlanCacheRemoveDeletesInactiveEntries) {
     PlanCache planCache(5000);
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -863,6 +932,49 @@ TEST(PlanCacheTest, DeactivateCacheEntry) {
     ASSERT_EQ(entry->works, 20U);
 }
 
+TEST(PlanCacheTest, RecordRuntimeStatsAccumulatesAndDetectsDrift) {
+    PlanCache planCache(5000);
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+
+    // Nothing is recorded for a query which has no cache entry.
+    ASSERT_FALSE(planCache.recordRuntimeStats(*cq, 1, 1, 1, 1));
+
+    // The winning plan returned 25 documents in 50 works when it was ranked.
+    auto decision = createDecision(1U, 50);
+    decision->getStats<PlanStageStats>().candidatePlanStats[0]->common.advanced = 25;
+    ASSERT_OK(planCache.set(*cq, qs->cacheData->clone(), solns, std::move(decision), Date_t{}));
+    auto entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->runtimeStats.decisionProductivity, 0.5);
+    ASSERT_EQ(entry->runtimeStats.numExecutions, 0U);
+
+    auto runtimeStats = planCache.recordRuntimeStats(*cq, 40, 30, 20, 40);
+    ASSERT(runtimeStats);
+    ASSERT_EQ(runtimeStats->numExecutions, 1U);
+    ASSERT_FALSE(runtimeStats->hasDrifted(2, 0.1));
+
+    // Executions which return very few documents per work bring the observed productivity below
+    // a tenth of the productivity at decision time.
+    runtimeStats = planCache.recordRuntimeStats(*cq, 500, 500, 1, 500);
+    runtimeStats = planCache.recordRuntimeStats(*cq, 500, 500, 1, 500);
+    ASSERT(runtimeStats);
+    ASSERT_EQ(runtimeStats->numExecutions, 3U);
+    ASSERT_EQ(runtimeStats->totalKeysExamined, 1040U);
+    ASSERT_EQ(runtimeStats->totalDocsExamined, 1030U);
+    ASSERT_EQ(runtimeStats->totalDocsReturned, 22U);
+    ASSERT_EQ(runtimeStats->totalWorks, 1040U);
+    ASSERT_TRUE(runtimeStats->hasDrifted(2, 0.1));
+
+    // The check is disabled by a ratio of zero, and requires enough executions.
+    ASSERT_FALSE(runtimeStats->hasDrifted(2, 0.0));
+    ASSERT_FALSE(runtimeStats->hasDrifted(4, 0.1));
+
+    // The statistics are kept in the cache entry.
+    entry = assertGet(planCache.getEntry(*cq));
+    ASSERT_EQ(entry->runtimeStats.numExecutions, 3U);
+}
+
 TEST(PlanCacheTest, GetMatchingStatsMatchesAndSerializesCorrectly) {
     PlanCache planCache(5000);
 
@@ -260,6 +260,7 @@ PlanEnumerator::PlanEnumerator(const PlanEnumeratorParams& params)
       _indices(params.indices),
       _ixisect(params.intersect),
       _enumerateOrChildrenLockstep(params.enumerateOrChildrenLockstep),
+      _generateSkipScans(params.generateSkipScans),
       _orLimit(params.maxSolutionsPerOr),
       _intersectLimit(params.maxIntersectPerAnd) {}
 
@@ -1018,6 +1019,38 @@ void PlanEnumerator::enumerateOneIndex(
             andAssignment->choices.push_back(std::move(state));
         }
     }
+
+    if (!_generateSkipScans) {
+        return;
+    }
+
+    // Finally, output a skip scan assignment for each index that only has predicates over its
+    // non-leading fields. Its leading fields get all-values bounds, and the index scan's bounds
+    // checker seeks past each of their distinct values to the next key that can match. Whether
+    // that beats the alternatives depends on the number of distinct leading values, which is left
+    // to the multi-planner. Multikey indexes are skipped to avoid the compounding rules, and
+    // sparse indexes because they omit documents which may match predicates on missing fields.
+    for (IndexToPredMap::const_iterator it = idxToNotFirst.begin(); it != idxToNotFirst.end();
+         ++it) {
+        const IndexEntry& thisIndex = (*_indices)[it->first];
+        if (idxToFirst.find(it->first) != idxToFirst.end() ||
+            thisIndex.type != IndexType::INDEX_BTREE || thisIndex.multikey || thisIndex.sparse) {
+            continue;
+        }
+
+        OneIndexAssignment indexAssign;
+        indexAssign.index = it->first;
+        for (auto pred : it->second) {
+            assignPredicate(outsidePreds, pred, getPosition(thisIndex, pred), &indexAssign);
+        }
+
+        // Do not output this assignment if it consists only of outside predicates.
+        if (!indexAssign.preds.empty()) {
+            AndEnumerableState state;
+            state.assignments.push_back(std::move(indexAssign));
+            andAssignment->choices.push_back(std::move(state));
+        }
+    }
 }
 
 void PlanEnumerator::enumerateAndIntersect(const IndexToPredMap& idxToFirst,
@@ -54,6 +54,11 @@ struct PlanEnumeratorParams {
     // same assignment on each branch?
     bool enumerateOrChildrenLockstep = false;
 
+    // Do we assign predicates to an index which has none over its leading field? The resulting
+    // scan has unbounded leading fields and relies on the bounds checker to skip across their
+    // distinct values.
+    bool generateSkipScans = false;
+
     // Not owned here.
     MatchExpression* root;
 
@@ -589,6 +594,9 @@ private:
     // same assignment on each branch?
     bool _enumerateOrChildrenLockstep;
 
+    // Do we output skip scan assignments for indexes with no predicate over their leading field?
+    bool _generateSkipScans;
+
     // How many enumerations are we willing to produce from each OR?
     size_t _orLimit;
 
@@ -219,6 +219,9 @@ void statsToBSON(const PlanStageStats& stats,
         if (stats.common.executionTimeMillis) {
             bob->appendNumber("executionTimeMillisEstimate", *stats.common.executionTimeMillis);
         }
+        if (stats.common.executionCpuTimeMicros) {
+            bob->appendNumber("executionCpuTimeMicros", *stats.common.executionCpuTimeMicros);
+        }
 
         bob->appendNumber("works", static_cast<long long>(stats.common.works));
         bob->appendNumber("advanced", static_cast<long long>(stats.common.advanced));
@@ -533,6 +536,7 @@ PlanSummaryStats collectExecutionStatsSummary(const PlanStageStats* stats,
     if (stats->common.executionTimeMillis) {
         summary.executionTimeMillisEstimate = *stats->common.executionTimeMillis;
     }
+    summary.executionCpuTimeMicros = stats->common.executionCpuTimeMicros;
 
     // Flatten the stats tree into a list.
     std::vector<const PlanStageStats*> statsNodes;
@@ -223,6 +223,9 @@ void statsToBSONHelper(const sbe::PlanStageStats* stats,
     if (stats->common.executionTimeMillis) {
         bob->appendNumber("executionTimeMillisEstimate", *stats->common.executionTimeMillis);
     }
+    if (stats->common.executionCpuTimeMicros) {
+        bob->appendNumber("executionCpuTimeMicros", *stats->common.executionCpuTimeMicros);
+    }
     bob->appendNumber("opens", static_cast<long long>(stats->common.opens));
     bob->appendNumber("closes", static_cast<long long>(stats->common.closes));
     bob->appendNumber("saveState", static_cast<long long>(stats->common.yields));
@@ -291,6 +294,7 @@ PlanSummaryStats collectExecutionStatsSummary(const sbe::PlanStageStats* stats)
     if (stats->common.executionTimeMillis) {
         summary.executionTimeMillisEstimate = *stats->common.executionTimeMillis;
     }
+    summary.executionCpuTimeMicros = stats->common.executionCpuTimeMicros;
 
     // Collect cumulative execution stats for the plan.
     std::queue<const sbe::PlanStageStats*> queue;
@@ -117,4 +117,19 @@ void waitForInserts(OperationContext* opCtx,
 
     uassertStatusOK(yieldResult);
 }
+
+void onResultAddedToBatch(OperationContext* opCtx, std::size_t batchBytes, bool isFirstResult) {
+    auto& state = awaitDataState(opCtx);
+    if (!state.shouldWaitForInserts || batchBytes >= state.minBatchBytes) {
+        state.shouldWaitForInserts = false;
+        return;
+    }
+
+    if (isFirstResult && state.coalesceWindow != Milliseconds::max()) {
+        state.waitForInsertsDeadline =
+            std::min(state.waitForInsertsDeadline,
+                     opCtx->getServiceContext()->getPreciseClockSource()->now() +
+                         state.coalesceWindow);
+    }
+}
 }  // namespace mongo::insert_listener
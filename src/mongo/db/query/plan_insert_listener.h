@@ -78,4 +78,13 @@ std::shared_ptr<CappedInsertNotifier> getCappedInsertNotifier(OperationContext*
 void waitForInserts(OperationContext* opCtx,
                     PlanYieldPolicy* yieldPolicy,
                     CappedInsertNotifierData* notifierData);
+
+/**
+ * Called each time a result is added to the batch of a tailable, awaitData cursor, with the number
+ * of bytes the batch holds so far. Stops waiting for inserts, unless the operation asked for
+ * results to be coalesced into batches of at least 'minBatchBytes' and the batch is still smaller
+ * than that. In that case, the wait for inserts is bounded by the coalescing window that started
+ * with the first result of the batch.
+ */
+void onResultAddedToBatch(OperationContext* opCtx, std::size_t batchBytes, bool isFirstResult);
 }  // namespace mongo::insert_listener
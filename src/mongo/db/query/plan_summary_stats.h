@@ -94,6 +94,10 @@ struct PlanSummaryStats {
     // Time elapsed while executing this plan.
     long long executionTimeMillisEstimate = 0;
 
+    // CPU time used while executing this plan, if it was collected. See
+    // CommonStats::executionCpuTimeMicros.
+    boost::optional<long long> executionCpuTimeMicros;
+
     // Did this plan use an in-memory sort stage?
     bool hasSortStage = false;
 
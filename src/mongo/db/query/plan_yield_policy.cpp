@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/operation_wait_stats.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
 
@@ -87,6 +88,8 @@ Status PlanYieldPolicy::yieldOrInterrupt(OperationContext* opCtx,
     ON_BLOCK_EXIT([this]() { resetTimer(); });
     _forceYield = false;
 
+    ScopedWaitTimer yieldTimer(opCtx, OperationWaitStats::WaitState::kYield);
+
     for (int attempt = 1; true; attempt++) {
         try {
             // Saving and restoring can modifies '_yieldable', so we make a copy before we start.
@@ -241,6 +241,18 @@ void handleRIDRangeScan(const MatchExpression* conjunct, CollectionScanNode* col
             collScan->maxRecord = collScan->minRecord;
             return;
         }
+
+        // A collection scan can only be bounded by a single range, so an $in over _id is turned
+        // into a scan from its smallest to its largest value, with the filter discarding the
+        // records in between. The equalities are kept sorted by the $in's comparator, which only
+        // matches RecordId order when no collator is in use.
+        if (auto in = dynamic_cast<const InMatchExpression*>(conjunct)) {
+            if (in->getRegexes().empty() && !in->getEqualities().empty() && !in->getCollator()) {
+                collScan->minRecord = record_id_helpers::keyForElem(in->getEqualities().front());
+                collScan->maxRecord = record_id_helpers::keyForElem(in->getEqualities().back());
+                return;
+            }
+        }
     }
 
     if (!hasMaxRecord) {
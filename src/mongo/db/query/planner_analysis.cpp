@@ -36,6 +36,7 @@
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
@@ -553,6 +554,37 @@ bool canUseSimpleSort(const QuerySolutionNode& solnRoot,
         !(plannerParams.options & QueryPlannerParams::PRESERVE_RECORD_ID);
 }
 
+/**
+ * If 'sortNode' is a top-k sort on the text score whose input is TEXT_MATCH => TEXT_OR, and the
+ * TEXT_MATCH stage cannot reject any document produced by the TEXT_OR stage, passes the limit
+ * down to the TEXT_OR stage so that it only fetches the documents which can make it into the
+ * top-k set.
+ */
+void tryPushdownTopKIntoTextOr(const SortNode& sortNode) {
+    if (sortNode.limit == 0 || sortNode.pattern.nFields() != 1 ||
+        !query_request_helper::isTextScoreMeta(sortNode.pattern.firstElement())) {
+        return;
+    }
+
+    auto child = sortNode.children[0];
+    if (child->getType() != STAGE_TEXT_MATCH || child->filter ||
+        child->children.size() != 1u || child->children[0]->getType() != STAGE_TEXT_OR) {
+        return;
+    }
+
+    // The TEXT_MATCH stage only filters out documents when the query has negations or phrases, or
+    // when it must re-check the positive terms because of case or diacritic sensitivity.
+    auto textMatchNode = static_cast<TextMatchNode*>(child);
+    auto ftsQuery = dynamic_cast<const fts::FTSQueryImpl*>(textMatchNode->ftsQuery.get());
+    if (!ftsQuery || !ftsQuery->getNegatedTerms().empty() ||
+        !ftsQuery->getPositivePhr().empty() || !ftsQuery->getNegatedPhr().empty() ||
+        ftsQuery->getCaseSensitive() || ftsQuery->getDiacriticSensitive()) {
+        return;
+    }
+
+    static_cast<TextOrNode*>(textMatchNode->children[0])->limit = sortNode.limit;
+}
+
 }  // namespace
 
 // static
@@ -841,6 +873,7 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
     } else {
         sortNodeRaw->limit = 0;
     }
+    tryPushdownTopKIntoTextOr(*sortNodeRaw);
 
     *blockingSortOut = true;
 
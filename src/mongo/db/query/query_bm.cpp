@@ -0,0 +1,240 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <functional>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+const StringData kDbName = "query_bm"_sd;
+const std::string kCollNs = "query_bm.coll";
+const std::string kForeignNs = "query_bm.foreign";
+const std::string kTimeseriesNs = "query_bm.ts";
+
+constexpr int kNumDocs = 10000;
+constexpr int kNumForeignDocs = 100;
+constexpr int kNumBuckets = 100;
+constexpr size_t kInsertBatchSize = 1000;
+
+/**
+ * Starts a mongod storage layer on the ephemeralForTest engine and populates a regular collection,
+ * a small collection to $lookup into, and a time-series collection. Commands are run through a
+ * DBDirectClient so that each benchmark covers parsing, planning, execution and reply building.
+ *
+ * The benchmark argument selects the execution engine: 0 for classic, 1 for SBE.
+ */
+class QueryBenchmarkFixture : public ServiceContextMongoDTest {
+public:
+    explicit QueryBenchmarkFixture(bool useSbe)
+        : _sbeController("internalQueryEnableSlotBasedExecutionEngine", useSbe) {
+        auto service = getServiceContext();
+        repl::ReplicationCoordinator::set(
+            service, std::make_unique<repl::ReplicationCoordinatorMock>(service));
+
+        _opCtx = makeOperationContext();
+        _client.emplace(_opCtx.get());
+
+        _populate();
+    }
+
+    ~QueryBenchmarkFixture() {
+        _client.reset();
+        _opCtx.reset();
+        tearDown();
+    }
+
+    /**
+     * Runs 'cmd' against the benchmark database and fails the benchmark if it does not succeed.
+     * The batch size of find and aggregate commands should be large enough that the whole result
+     * set is returned in the first batch.
+     */
+    void run(benchmark::State& state, const BSONObj& cmd) {
+        for (auto _ : state) {
+            BSONObj reply;
+            invariant(_client->runCommand(kDbName.toString(), cmd, reply), reply.toString());
+            benchmark::DoNotOptimize(reply);
+        }
+    }
+
+private:
+    void _doTest() override {}
+
+    void _insert(const std::string& ns, int numDocs, std::function<BSONObj(int)> makeDoc) {
+        std::vector<BSONObj> batch;
+        for (int i = 0; i < numDocs; ++i) {
+            batch.push_back(makeDoc(i));
+            if (batch.size() == kInsertBatchSize || i == numDocs - 1) {
+                _client->insert(ns, batch);
+                batch.clear();
+            }
+        }
+    }
+
+    void _populate() {
+        _insert(kCollNs, kNumDocs, [](int i) {
+            return BSON("_id" << i << "a" << i % 100 << "b" << i % 7 << "c"
+                              << ("str" + std::to_string(i)) << "d" << BSON("e" << i << "f" << -i)
+                              << "foreignId" << i % kNumForeignDocs);
+        });
+        _client->createIndex(kCollNs, BSON("a" << 1));
+
+        _insert(kForeignNs, kNumForeignDocs, [](int i) {
+            return BSON("_id" << i << "name" << ("name" + std::to_string(i)));
+        });
+
+        BSONObj reply;
+        invariant(_client->runCommand(kDbName.toString(),
+                                      BSON("create" << NamespaceString(kTimeseriesNs).coll()
+                                                    << "timeseries"
+                                                    << BSON("timeField"
+                                                            << "t"
+                                                            << "metaField"
+                                                            << "m")),
+                                      reply),
+                  reply.toString());
+        const auto start = Date_t::fromMillisSinceEpoch(1600000000000LL);
+        _insert(kTimeseriesNs, kNumDocs, [&](int i) {
+            return BSON("t" << start + Seconds(i / kNumBuckets) << "m"
+                            << BSON("sensor" << i % kNumBuckets) << "v" << i << "w" << i % 13);
+        });
+    }
+
+    RAIIServerParameterControllerForTest _sbeController;
+    ServiceContext::UniqueOperationContext _opCtx;
+    boost::optional<DBDirectClient> _client;
+};
+
+BSONObj findCmd(BSONObj filter, BSONObj projection = {}, BSONObj sort = {}) {
+    BSONObjBuilder bob;
+    bob.append("find", NamespaceString(kCollNs).coll());
+    bob.append("filter", filter);
+    if (!projection.isEmpty()) {
+        bob.append("projection", projection);
+    }
+    if (!sort.isEmpty()) {
+        bob.append("sort", sort);
+    }
+    bob.append("batchSize", kNumDocs);
+    return bob.obj();
+}
+
+BSONObj aggregateCmd(StringData ns, std::vector<BSONObj> pipeline) {
+    return BSON("aggregate" << NamespaceString(ns).coll() << "pipeline" << pipeline << "cursor"
+                            << BSON("batchSize" << kNumDocs));
+}
+
+void BM_FindCollScan(benchmark::State& state) {
+    QueryBenchmarkFixture fixture(state.range(0));
+    fixture.run(state, findCmd(BSON("b" << 3 << "d.e" << BSON("$gte" << kNumDocs / 2))));
+}
+
+void BM_FindIndexScan(benchmark::State& state) {
+    QueryBenchmarkFixture fixture(state.range(0));
+    fixture.run(state, findCmd(BSON("a" << BSON("$in" << BSON_ARRAY(1 << 17 << 42)))));
+}
+
+void BM_FindProjection(benchmark::State& state) {
+    QueryBenchmarkFixture fixture(state.range(0));
+    fixture.run(state,
+                findCmd(BSON("b" << BSON("$lt" << 3)), BSON("_id" << 0 << "c" << 1 << "d.f" << 1)));
+}
+
+void BM_FindSort(benchmark::State& state) {
+    QueryBenchmarkFixture fixture(state.range(0));
+    fixture.run(state, findCmd(BSON("b" << 1), {}, BSON("d.f" << 1 << "c" << -1)));
+}
+
+void BM_AggregateGroup(benchmark::State& state) {
+    QueryBenchmarkFixture fixture(state.range(0));
+    fixture.run(state,
+                aggregateCmd(kCollNs,
+                             {BSON("$match" << BSON("b" << BSON("$ne" << 0))),
+                              BSON("$group" << BSON("_id"
+                                                    << "$a"
+                                                    << "count" << BSON("$sum" << 1) << "total"
+                                                    << BSON("$sum"
+                                                            << "$d.e")))}));
+}
+
+void BM_AggregateLookup(benchmark::State& state) {
+    QueryBenchmarkFixture fixture(state.range(0));
+    fixture.run(state,
+                aggregateCmd(kCollNs,
+                             {BSON("$match" << BSON("a" << BSON("$lt" << 10))),
+                              BSON("$lookup" << BSON("from" << NamespaceString(kForeignNs).coll()
+                                                            << "localField"
+                                                            << "foreignId"
+                                                            << "foreignField"
+                                                            << "_id"
+                                                            << "as"
+                                                            << "foreign"))}));
+}
+
+void BM_AggregateTimeseriesUnpack(benchmark::State& state) {
+    QueryBenchmarkFixture fixture(state.range(0));
+    fixture.run(state,
+                aggregateCmd(kTimeseriesNs,
+                             {BSON("$match" << BSON("w" << BSON("$gt" << 6))),
+                              BSON("$project" << BSON("_id" << 0 << "m" << 1 << "v" << 1))}));
+}
+
+void BM_AggregateTimeseriesGroup(benchmark::State& state) {
+    QueryBenchmarkFixture fixture(state.range(0));
+    fixture.run(state,
+                aggregateCmd(kTimeseriesNs,
+                             {BSON("$group" << BSON("_id"
+                                                    << "$m.sensor"
+                                                    << "avg"
+                                                    << BSON("$avg"
+                                                            << "$v")))}));
+}
+
+BENCHMARK(BM_FindCollScan)->Arg(0)->Arg(1);
+BENCHMARK(BM_FindIndexScan)->Arg(0)->Arg(1);
+BENCHMARK(BM_FindProjection)->Arg(0)->Arg(1);
+BENCHMARK(BM_FindSort)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateGroup)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateLookup)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateTimeseriesUnpack)->Arg(0)->Arg(1);
+BENCHMARK(BM_AggregateTimeseriesGroup)->Arg(0)->Arg(1);
+
+}  // namespace
+}  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
 #include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_interface.h"
@@ -180,6 +181,9 @@ string optionString(size_t options) {
             case QueryPlannerParams::RETURN_OWNED_DATA:
                 ss << "RETURN_OWNED_DATA ";
                 break;
+            case QueryPlannerParams::GENERATE_SKIP_SCANS:
+                ss << "GENERATE_SKIP_SCANS ";
+                break;
             case QueryPlannerParams::DEFAULT:
                 MONGO_UNREACHABLE;
                 break;
@@ -189,6 +193,26 @@ string optionString(size_t options) {
     return ss;
 }
 
+/**
+ * Returns true if the solution tree rooted at 'node' contains an index scan whose leading field is
+ * unbounded while a later field is not, that is, a scan which skips across the leading values.
+ */
+static bool hasSkipScan(const QuerySolutionNode* node) {
+    if (STAGE_IXSCAN == node->getType()) {
+        const auto& fields = static_cast<const IndexScanNode*>(node)->bounds.fields;
+        auto isUnbounded = [](const OrderedIntervalList& oil) {
+            return oil.intervals.size() == 1 &&
+                (oil.intervals[0].isMinToMax() || oil.intervals[0].isMaxToMin());
+        };
+        return !fields.empty() && isUnbounded(fields[0]) &&
+            !std::all_of(fields.begin(), fields.end(), isUnbounded);
+    }
+
+    return std::any_of(node->children.begin(), node->children.end(), [](const auto* child) {
+        return hasSkipScan(child);
+    });
+}
+
 static BSONObj getKeyFromQuery(const BSONObj& keyPattern, const BSONObj& query) {
     return query.extractFieldsUndotted(keyPattern);
 }
@@ -580,16 +604,31 @@ QueryPlanner::QueryPlannerResult QueryPlanner::plan(const CanonicalQuery& query,
     }
 
     std::unique_ptr<QuerySolutionNode> postMultiPlannedQSN = std::make_unique<SentinelNode>();
+    GroupNode* lastGroupNode = nullptr;
     for (auto& innerStage : query.pipeline()) {
+        if (auto unwindStage = dynamic_cast<DocumentSourceUnwind*>(innerStage->documentSource())) {
+            tassert(6170448,
+                    "Cannot push down an $unwind which does not follow a $group",
+                    lastGroupNode);
+            const auto& indexPath = unwindStage->indexPath();
+            lastGroupNode->unwinds.push_back(
+                {unwindStage->getUnwindPath(),
+                 unwindStage->preserveNullAndEmptyArrays(),
+                 indexPath ? boost::make_optional(indexPath->fullPath()) : boost::none});
+            continue;
+        }
+
         auto groupStage = dynamic_cast<DocumentSourceGroup*>(innerStage->documentSource());
         tassert(5842400,
-                "Cannot support pushdown of a stage other than $group at the moment",
+                "Cannot support pushdown of a stage other than $group or $unwind at the moment",
                 groupStage != nullptr);
 
-        postMultiPlannedQSN = std::make_unique<GroupNode>(std::move(postMultiPlannedQSN),
-                                                          groupStage->getIdFields(),
-                                                          groupStage->getAccumulatedFields(),
-                                                          groupStage->doingMerge());
+        auto groupNode = std::make_unique<GroupNode>(std::move(postMultiPlannedQSN),
+                                                     groupStage->getIdFields(),
+                                                     groupStage->getAccumulatedFields(),
+                                                     groupStage->doingMerge());
+        lastGroupNode = groupNode.get();
+        postMultiPlannedQSN = std::move(groupNode);
     }
     return {planForMultiPlanner(query, params), std::move(postMultiPlannedQSN)};
 }
@@ -877,6 +916,7 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::planForMul
         enumParams.indices = &relevantIndices;
         enumParams.enumerateOrChildrenLockstep =
             params.options & QueryPlannerParams::ENUMERATE_OR_CHILDREN_LOCKSTEP;
+        enumParams.generateSkipScans = params.options & QueryPlannerParams::GENERATE_SKIP_SCANS;
 
         PlanEnumerator planEnumerator(enumParams);
         uassertStatusOKWithContext(planEnumerator.init(), "failed to initialize plan enumerator");
@@ -1102,8 +1142,14 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::planForMul
         }
     }
 
-    // The caller can explicitly ask for a collscan.
-    bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
+    // The caller can explicitly ask for a collscan. A skip scan is only worthwhile when its leading
+    // fields have few distinct values, so when it is the only kind of indexed plan we also output a
+    // collscan for the multi-planner to race it against.
+    bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN) ||
+        ((params.options & QueryPlannerParams::GENERATE_SKIP_SCANS) && !out.empty() &&
+         std::all_of(out.begin(), out.end(), [](const auto& soln) {
+             return hasSkipScan(soln->root());
+         }));
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
     bool collScanRequired = 0 == out.size();
@@ -106,4 +106,23 @@ TEST_F(QueryPlannerGroupPushdownTest, PushdownOfOneGroupWithMultipleAccumulators
         "{sentinel: "
         "{}}}}");
 }
+
+TEST_F(QueryPlannerGroupPushdownTest, PushdownOfGroupFollowedByUnwinds) {
+    const std::vector<BSONObj> rawPipeline = {
+        fromjson("{$group: {_id: '$_id', xs: {$push: '$x'}, ys: {$push: '$y'}}}"),
+        fromjson("{$unwind: '$xs'}"),
+        fromjson("{$unwind: {path: '$ys', preserveNullAndEmptyArrays: true, "
+                 "includeArrayIndex: 'i'}}"),
+    };
+    auto pipeline = buildTestPipeline(rawPipeline);
+
+    runQueryWithPipeline(fromjson("{x: 1}"), makeInnerPipelineStages(*pipeline.get()));
+
+    ASSERT_EQUALS(getNumSolutions(), 1U);
+    assertPostMultiPlanSolutionMatches(
+        "{group: {key: {_id: '$_id'}, accs: [{xs: {$push: '$x'}}, {ys: {$push: '$y'}}], "
+        "unwinds: [{path: 'xs', preserveNullAndEmptyArrays: false}, "
+        "{path: 'ys', preserveNullAndEmptyArrays: true, includeArrayIndex: 'i'}], "
+        "node: {sentinel: {}}}}");
+}
 }  //  namespace
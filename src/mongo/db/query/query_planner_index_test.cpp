@@ -1501,5 +1501,45 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanUsedForPredicateOnNonLeadingFieldIfEnabled) {
+    params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    // The skip scan is the only indexed plan, so it is raced against a collection scan.
+    assertNumSolutions(2);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}, bounds: "
+        "{a: [['MinKey', 'MaxKey', true, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotUsedIfDisabled) {
+    params.options = QueryPlannerParams::DEFAULT;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotUsedWhenLeadingFieldHasPredicate) {
+    params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{a: {$gt: 1}, b: 5}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}, bounds: "
+        "{a: [[1, Infinity, false, true]], b: [[5, 5, true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotUsedOnMultikeyOrSparseIndex) {
+    params.options = QueryPlannerParams::GENERATE_SKIP_SCANS;
+    addIndex(BSON("a" << 1 << "b" << 1), true /* multikey */);
+    addIndex(BSON("c" << 1 << "b" << 1), false /* multikey */, true /* sparse */);
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+}
+
 }  // namespace
 }  // namespace mongo
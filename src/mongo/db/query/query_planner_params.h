@@ -118,6 +118,10 @@ struct QueryPlannerParams {
         // Ensure that any plan generated returns data that is "owned." That is, all BSONObjs are
         // in an "owned" state and are not pointing to data that belongs to the storage engine.
         RETURN_OWNED_DATA = 1 << 12,
+
+        // Set this to generate index scans over compound indexes whose leading fields have no
+        // predicates, which skip across the distinct values of those fields.
+        GENERATE_SKIP_SCANS = 1 << 13,
     };
 
     // See Options enum above.
@@ -1143,7 +1143,7 @@ Status QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
         }
 
         auto expectedGroupObj = expectedGroupElem.Obj();
-        invariant(bsonObjFieldsAreInSet(expectedGroupObj, {"key", "accs", "node"}));
+        invariant(bsonObjFieldsAreInSet(expectedGroupObj, {"key", "accs", "unwinds", "node"}));
 
         auto expectedGroupByElem = expectedGroupObj["key"];
         if (expectedGroupByElem.eoo() || !expectedGroupByElem.isABSONObj()) {
@@ -1181,6 +1181,27 @@ Status QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
                                   << expectedAccsObj << " Found: " << actualAccsObj};
         }
 
+        BSONArrayBuilder actualUnwinds;
+        for (auto& unwind : actualGroupNode->unwinds) {
+            BSONObjBuilder bob;
+            bob.append("path", unwind.fieldName);
+            bob.append("preserveNullAndEmptyArrays", unwind.preserveNullAndEmptyArrays);
+            if (unwind.indexFieldName) {
+                bob.append("includeArrayIndex", *unwind.indexFieldName);
+            }
+            actualUnwinds.append(bob.done());
+        }
+        auto expectedUnwindsElem = expectedGroupObj["unwinds"];
+        auto expectedUnwindsObj =
+            expectedUnwindsElem.eoo() ? BSONObj() : expectedUnwindsElem.Obj();
+        auto actualUnwindsObj = actualUnwinds.done();
+        if (!SimpleBSONObjComparator::kInstance.evaluate(expectedUnwindsObj == actualUnwindsObj)) {
+            return {ErrorCodes::Error{6170450},
+                    str::stream() << "found a group stage in the solution with "
+                                     "mismatching 'unwinds'. Expected: "
+                                  << expectedUnwindsObj << " Found: " << actualUnwindsObj};
+        }
+
         auto child = expectedGroupObj["node"];
         if (child.eoo() || !child.isABSONObj()) {
             return {ErrorCodes::Error{5842405},
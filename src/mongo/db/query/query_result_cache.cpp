@@ -0,0 +1,290 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/s/operation_sharding_state.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryResultCache = ServiceContext::declareDecoration<QueryResultCache>();
+
+class QueryResultCacheServerStatusSection final : public ServerStatusSection {
+public:
+    QueryResultCacheServerStatusSection() : ServerStatusSection("queryResultCache") {}
+
+    bool includeByDefault() const override {
+        return QueryResultCache::isEnabled();
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        QueryResultCache::get(opCtx->getServiceContext()).appendStats(&builder);
+        return builder.obj();
+    }
+} queryResultCacheServerStatusSection;
+
+}  // namespace
+
+QueryResultCache& QueryResultCache::get(ServiceContext* serviceContext) {
+    return getQueryResultCache(serviceContext);
+}
+
+bool QueryResultCache::isEnabled() {
+    return internalQueryEnableResultCache;
+}
+
+bool QueryResultCache::isEligible(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  const CanonicalQuery& cq) {
+    if (!isEnabled() || !collection || collection->isCapped() ||
+        !collection->ns().isReplicated()) {
+        // Capped deletes on unreplicated collections and writes to the local database are not
+        // observed by the OpObserver, so their results could never be invalidated.
+        return false;
+    }
+
+    if (opCtx->inMultiDocumentTransaction() ||
+        opCtx->recoveryUnit()->getTimestampReadSource() != RecoveryUnit::ReadSource::kNoTimestamp ||
+        OperationShardingState::isOperationVersioned(opCtx)) {
+        return false;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern ||
+        readConcernArgs.getArgsOpTime() || readConcernArgs.getArgsAfterClusterTime() ||
+        readConcernArgs.getArgsAtClusterTime()) {
+        return false;
+    }
+
+    // Secondaries apply writes in batches that do not all go through the OpObserver, so only
+    // serve from the cache while this node is primary.
+    if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor_UNSAFE(opCtx,
+                                                                             collection->ns())) {
+        return false;
+    }
+
+    const auto& findCommand = cq.getFindCommandRequest();
+    if (findCommand.getTailable() || findCommand.getLet() ||
+        findCommand.getLegacyRuntimeConstants()) {
+        return false;
+    }
+
+    // Aggregation expressions may refer to $$NOW, $$CLUSTER_TIME or $rand, so their results are
+    // not a function of the data alone.
+    if (cq.getProj() && cq.getProj()->hasExpressions()) {
+        return false;
+    }
+    return !QueryPlannerCommon::hasNode(cq.root(), MatchExpression::EXPRESSION) &&
+        !QueryPlannerCommon::hasNode(cq.root(), MatchExpression::WHERE);
+}
+
+BSONObj QueryResultCache::makeKey(const CanonicalQuery& cq) {
+    const auto& findCommand = cq.getFindCommandRequest();
+    BSONObjBuilder builder;
+    builder.append("filter", findCommand.getFilter());
+    builder.append("projection", findCommand.getProjection());
+    builder.append("sort", findCommand.getSort());
+    builder.append("hint", findCommand.getHint());
+    builder.append("collation", findCommand.getCollation());
+    builder.append("min", findCommand.getMin());
+    builder.append("max", findCommand.getMax());
+    if (auto skip = findCommand.getSkip()) {
+        builder.append("skip", static_cast<long long>(*skip));
+    }
+    if (auto limit = findCommand.getLimit()) {
+        builder.append("limit", static_cast<long long>(*limit));
+    }
+    if (auto batchSize = findCommand.getBatchSize()) {
+        builder.append("batchSize", static_cast<long long>(*batchSize));
+    }
+    if (auto ntoreturn = findCommand.getNtoreturn()) {
+        builder.append("ntoreturn", static_cast<long long>(*ntoreturn));
+    }
+    builder.append("singleBatch", static_cast<bool>(findCommand.getSingleBatch()));
+    builder.append("returnKey", static_cast<bool>(findCommand.getReturnKey()));
+    builder.append("showRecordId", static_cast<bool>(findCommand.getShowRecordId()));
+    return builder.obj();
+}
+
+boost::optional<std::vector<BSONObj>> QueryResultCache::lookup(const UUID& uuid,
+                                                               const BSONObj& key) {
+    const auto mapKey = _makeMapKey(uuid, key);
+    stdx::lock_guard<Latch> lk(_mutex);
+    Entry* entry;
+    if (!_results || !_results->get(mapKey, &entry).isOK()) {
+        _misses.fetchAndAddRelaxed(1);
+        return boost::none;
+    }
+
+    if (entry->readSequence < _getLastInvalidation_inlock(uuid)) {
+        _results->remove(mapKey).ignore();
+        _misses.fetchAndAddRelaxed(1);
+        return boost::none;
+    }
+
+    _hits.fetchAndAddRelaxed(1);
+    return entry->docs;
+}
+
+void QueryResultCache::add(const UUID& uuid,
+                           const BSONObj& key,
+                           uint64_t readSequence,
+                           std::vector<BSONObj> docs) {
+    auto mapKey = _makeMapKey(uuid, key);
+    size_t estimatedSizeBytes = sizeof(Entry) + 2 * mapKey.size();
+    for (auto&& doc : docs) {
+        estimatedSizeBytes += sizeof(BSONObj) + doc.objsize();
+    }
+
+    const auto maxSizeBytes = static_cast<size_t>(internalQueryResultCacheMaxSizeBytes);
+    if (estimatedSizeBytes > maxSizeBytes) {
+        // Adding the entry would evict everything else, including the entry itself.
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (readSequence < _getLastInvalidation_inlock(uuid)) {
+        // A write committed while the results were being computed.
+        return;
+    }
+
+    // The cache is built on first use, once the size limit has been parsed from the startup
+    // options.
+    if (!_results) {
+        _results = std::make_unique<ResultMap>(ResultMap::BudgetTracker(maxSizeBytes));
+    }
+    _results->add(std::move(mapKey),
+                  new Entry{readSequence, std::move(docs), estimatedSizeBytes});
+}
+
+void QueryResultCache::invalidate(const UUID& uuid) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _lastInvalidation[uuid] = _sequence.addAndFetch(1);
+    _invalidations.fetchAndAddRelaxed(1);
+    _pruneInvalidations_inlock();
+}
+
+void QueryResultCache::dropCollection(const UUID& uuid) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    // The collection can no longer be read, so its results can never be served again. A reader
+    // which was already running may still add results for it, which are evicted in time.
+    _lastInvalidation.erase(uuid);
+    if (!_results) {
+        return;
+    }
+
+    const auto prefix = uuid.toString();
+    std::vector<std::string> keys;
+    for (auto it = _results->begin(); it != _results->end(); ++it) {
+        if (StringData(it->first).startsWith(prefix)) {
+            keys.push_back(it->first);
+        }
+    }
+    for (auto&& key : keys) {
+        _results->remove(key).ignore();
+    }
+}
+
+void QueryResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Readers that are already running must not publish their results either. Every collection's
+    // last write is older than this, so they no longer need to be tracked.
+    _lastInvalidationOfAll = _sequence.addAndFetch(1);
+    _lastInvalidation.clear();
+    _pruneInvalidationsAtSize = kMinPruneInvalidationsSize;
+    if (_results) {
+        _results->clear();
+    }
+}
+
+void QueryResultCache::appendStats(BSONObjBuilder* builder) const {
+    builder->append("hits", _hits.load());
+    builder->append("misses", _misses.load());
+    builder->append("invalidations", _invalidations.load());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    builder->append("sizeEstimateBytes",
+                    static_cast<long long>(_results ? _results->size() : 0));
+}
+
+std::string QueryResultCache::_makeMapKey(const UUID& uuid, const BSONObj& key) {
+    std::string mapKey = uuid.toString();
+    mapKey.append(key.objdata(), key.objsize());
+    return mapKey;
+}
+
+uint64_t QueryResultCache::_getLastInvalidation_inlock(const UUID& uuid) const {
+    auto it = _lastInvalidation.find(uuid);
+    return it == _lastInvalidation.end() ? _lastInvalidationOfAll
+                                         : std::max(_lastInvalidationOfAll, it->second);
+}
+
+void QueryResultCache::_pruneInvalidations_inlock() {
+    if (_lastInvalidation.size() < _pruneInvalidationsAtSize) {
+        return;
+    }
+
+    // An invalidation that no cached result predates only matters to the readers still running.
+    // Folding it into '_lastInvalidationOfAll' keeps those readers from publishing stale results,
+    // at the cost of also turning away the results of some readers of other collections.
+    uint64_t oldestResult = _sequence.load();
+    if (_results) {
+        for (auto it = _results->begin(); it != _results->end(); ++it) {
+            oldestResult = std::min(oldestResult, it->second->readSequence);
+        }
+    }
+
+    for (auto it = _lastInvalidation.begin(); it != _lastInvalidation.end();) {
+        if (it->second <= oldestResult) {
+            _lastInvalidationOfAll = std::max(_lastInvalidationOfAll, it->second);
+            _lastInvalidation.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+    _pruneInvalidationsAtSize =
+        std::max(kMinPruneInvalidationsSize, 2 * _lastInvalidation.size());
+}
+
+}  // namespace mongo
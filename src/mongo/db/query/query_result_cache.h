@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/lru_key_value.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class CanonicalQuery;
+class CollectionPtr;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Opt-in, memory-bounded cache of the complete results of read-only find commands, keyed by the
+ * collection UUID and the parts of the find command that determine its result set.
+ *
+ * Every write to a collection that commits stamps the collection with the next value of a global
+ * sequence number (see QueryResultCacheOpObserver). A reader captures the sequence number before it
+ * opens its storage snapshot and tags its results with it, and results are only published or
+ * served while no write to the collection has been stamped after them. A result computed from a
+ * snapshot that predates a concurrent write is therefore never served once the write commits.
+ *
+ * This class is thread-safe.
+ */
+class QueryResultCache {
+public:
+    static QueryResultCache& get(ServiceContext* serviceContext);
+
+    /**
+     * Returns true if the cache was enabled at startup.
+     */
+    static bool isEnabled();
+
+    /**
+     * Returns true if the results of 'cq' against 'collection' may be cached or served from the
+     * cache. Only queries whose results are a function of the committed data alone are eligible:
+     * they must read the latest data on a primary with read concern "local" outside of a
+     * transaction, and must not depend on the current time, randomness or the shard version.
+     */
+    static bool isEligible(OperationContext* opCtx,
+                           const CollectionPtr& collection,
+                           const CanonicalQuery& cq);
+
+    /**
+     * Returns the key identifying the result set of 'cq'.
+     */
+    static BSONObj makeKey(const CanonicalQuery& cq);
+
+    /**
+     * Returns the sequence number to pass to add(). Must be called before the reader opens its
+     * storage snapshot.
+     */
+    uint64_t getReadSequence() const {
+        return _sequence.load();
+    }
+
+    /**
+     * Returns the cached results for 'key' against the collection 'uuid', if they are still
+     * current.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const UUID& uuid, const BSONObj& key);
+
+    /**
+     * Caches 'docs' as the results for 'key' against the collection 'uuid', unless a write to
+     * the collection has committed since 'readSequence' was obtained.
+     */
+    void add(const UUID& uuid,
+             const BSONObj& key,
+             uint64_t readSequence,
+             std::vector<BSONObj> docs);
+
+    /**
+     * Makes every cached result for the collection 'uuid' stale. Called once a write to the
+     * collection has committed.
+     */
+    void invalidate(const UUID& uuid);
+
+    /**
+     * Drops the cached results of the collection 'uuid', and stops tracking its writes. Called
+     * once the collection has been dropped.
+     */
+    void dropCollection(const UUID& uuid);
+
+    /**
+     * Drops all cached results, for example after a rollback.
+     */
+    void clear();
+
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        uint64_t readSequence;
+        std::vector<BSONObj> docs;
+        size_t estimatedSizeBytes;
+    };
+
+    struct BudgetEstimator {
+        size_t operator()(const Entry& entry) {
+            return entry.estimatedSizeBytes;
+        }
+    };
+
+    using ResultMap = LRUKeyValue<std::string, Entry, BudgetEstimator>;
+
+    static constexpr size_t kMinPruneInvalidationsSize = 1024;
+
+    static std::string _makeMapKey(const UUID& uuid, const BSONObj& key);
+
+    uint64_t _getLastInvalidation_inlock(const UUID& uuid) const;
+
+    /**
+     * Forgets the invalidations which no cached result predates, once '_lastInvalidation' has
+     * grown enough since it was last pruned.
+     */
+    void _pruneInvalidations_inlock();
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryResultCache::_mutex");
+
+    std::unique_ptr<ResultMap> _results;
+    // The sequence number of the last committed write to each collection, and the one which applies
+    // to all collections: that of the last call to clear(), or of the last write forgotten when
+    // '_lastInvalidation' was pruned, whichever is newer.
+    stdx::unordered_map<UUID, uint64_t, UUID::Hash> _lastInvalidation;
+    uint64_t _lastInvalidationOfAll = 0;
+    size_t _pruneInvalidationsAtSize = kMinPruneInvalidationsSize;
+
+    AtomicWord<uint64_t> _sequence{0};
+
+    AtomicWord<long long> _hits{0};
+    AtomicWord<long long> _misses{0};
+    AtomicWord<long long> _invalidations{0};
+};
+
+}  // namespace mongo
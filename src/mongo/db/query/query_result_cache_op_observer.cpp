@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache_op_observer.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_result_cache.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Invalidates the cached results of the collection 'uuid' when the current WriteUnitOfWork, or
+ * the multi-document transaction it belongs to, commits. Invalidating any earlier would let a
+ * reader whose snapshot predates the commit publish results that are already stale.
+ */
+void invalidateOnCommit(OperationContext* opCtx, OptionalCollectionUUID uuid) {
+    if (!uuid) {
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [serviceContext = opCtx->getServiceContext(), uuid = *uuid](boost::optional<Timestamp>) {
+            QueryResultCache::get(serviceContext).invalidate(uuid);
+        });
+}
+
+/**
+ * Drops the cached results of the collection 'uuid' once its drop commits.
+ */
+void dropOnCommit(OperationContext* opCtx, OptionalCollectionUUID uuid) {
+    if (!uuid) {
+        return;
+    }
+    opCtx->recoveryUnit()->onCommit(
+        [serviceContext = opCtx->getServiceContext(), uuid = *uuid](boost::optional<Timestamp>) {
+            QueryResultCache::get(serviceContext).dropCollection(uuid);
+        });
+}
+
+}  // namespace
+
+void QueryResultCacheOpObserver::onInserts(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           OptionalCollectionUUID uuid,
+                                           std::vector<InsertStatement>::const_iterator first,
+                                           std::vector<InsertStatement>::const_iterator last,
+                                           bool fromMigrate) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+void QueryResultCacheOpObserver::onUpdate(OperationContext* opCtx,
+                                          const OplogUpdateEntryArgs& args) {
+    invalidateOnCommit(opCtx, args.uuid);
+}
+
+void QueryResultCacheOpObserver::onDelete(OperationContext* opCtx,
+                                          const NamespaceString& nss,
+                                          OptionalCollectionUUID uuid,
+                                          StmtId stmtId,
+                                          const OplogDeleteEntryArgs& args) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+repl::OpTime QueryResultCacheOpObserver::onDropCollection(OperationContext* opCtx,
+                                                          const NamespaceString& collectionName,
+                                                          OptionalCollectionUUID uuid,
+                                                          std::uint64_t numRecords,
+                                                          CollectionDropType dropType) {
+    dropOnCommit(opCtx, uuid);
+    return {};
+}
+
+void QueryResultCacheOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                    const NamespaceString& fromCollection,
+                                                    const NamespaceString& toCollection,
+                                                    OptionalCollectionUUID uuid,
+                                                    OptionalCollectionUUID dropTargetUUID,
+                                                    std::uint64_t numRecords,
+                                                    bool stayTemp) {
+    invalidateOnCommit(opCtx, uuid);
+    dropOnCommit(opCtx, dropTargetUUID);
+}
+
+void QueryResultCacheOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                      const NamespaceString& fromCollection,
+                                                      const NamespaceString& toCollection,
+                                                      OptionalCollectionUUID uuid,
+                                                      OptionalCollectionUUID dropTargetUUID,
+                                                      bool stayTemp) {
+    invalidateOnCommit(opCtx, uuid);
+    dropOnCommit(opCtx, dropTargetUUID);
+}
+
+void QueryResultCacheOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                               const NamespaceString& collectionName,
+                                               OptionalCollectionUUID uuid) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+void QueryResultCacheOpObserver::onReplicationRollback(OperationContext* opCtx,
+                                                       const RollbackObserverInfo& rbInfo) {
+    QueryResultCache::get(opCtx->getServiceContext()).clear();
+}
+
+}  // namespace mongo
@@ -1350,6 +1350,10 @@ void TextOrNode::appendToString(str::stream* ss, int indent) const {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString() << '\n';
     }
+    if (limit) {
+        addIndent(ss, indent + 1);
+        *ss << "limit = " << limit << '\n';
+    }
     addCommon(ss, indent);
     for (size_t i = 0; i < children.size(); ++i) {
         addIndent(ss, indent + 1);
@@ -1363,6 +1367,7 @@ QuerySolutionNode* TextOrNode::clone() const {
     auto copy = std::make_unique<TextOrNode>();
     cloneBaseData(copy.get());
     copy->dedup = this->dedup;
+    copy->limit = this->limit;
     return copy.release();
 }
 
@@ -1430,6 +1435,23 @@ void GroupNode::appendToString(str::stream* ss, int indent) const {
             << acc.expr.argument->serialize(true).toString() << "}}";
     }
     *ss << "]" << '\n';
+    if (!unwinds.empty()) {
+        addIndent(ss, indent + 1);
+        *ss << "unwinds = [";
+        for (size_t idx = 0; idx < unwinds.size(); ++idx) {
+            if (idx > 0) {
+                *ss << ", ";
+            }
+            auto& unwind = unwinds[idx];
+            *ss << "{path: " << unwind.fieldName
+                << ", preserveNullAndEmptyArrays: " << unwind.preserveNullAndEmptyArrays;
+            if (unwind.indexFieldName) {
+                *ss << ", includeArrayIndex: " << *unwind.indexFieldName;
+            }
+            *ss << "}";
+        }
+        *ss << "]" << '\n';
+    }
     addCommon(ss, indent);
     addIndent(ss, indent + 1);
     *ss << "Child:" << '\n';
@@ -1442,6 +1464,7 @@ QuerySolutionNode* GroupNode::clone() const {
                                     groupByExpressions,
                                     accumulators,
                                     doingMerge);
+    copy->unwinds = unwinds;
     return copy.release();
 }
 
@@ -1222,6 +1222,10 @@ struct TextOrNode : public OrNode {
 
     void appendToString(str::stream* ss, int indent) const override;
     QuerySolutionNode* clone() const override;
+
+    // If non-zero, only the 'limit' highest scoring documents are needed by the parent, so the
+    // remaining documents need not be fetched.
+    size_t limit = 0;
 };
 
 struct TextMatchNode : public QuerySolutionNodeWithSortSet {
@@ -1299,9 +1303,24 @@ struct GroupNode : public QuerySolutionNode {
 
     QuerySolutionNode* clone() const override;
 
+    /**
+     * An $unwind of a top-level field of this group's output, which directly followed the $group in
+     * the pipeline. Unwinding the group's output values before they are put into a document keeps
+     * the unwound field in place without building the intermediate document.
+     */
+    struct Unwind {
+        std::string fieldName;
+        bool preserveNullAndEmptyArrays;
+        // A top-level field which is not one of this group's output fields.
+        boost::optional<std::string> indexFieldName;
+    };
+
     StringMap<boost::intrusive_ptr<Expression>> groupByExpressions;
     std::vector<AccumulationStatement> accumulators;
     bool doingMerge;
+
+    // Applied in order to the output of the group.
+    std::vector<Unwind> unwinds;
 };
 
 struct SentinelNode : public QuerySolutionNode {
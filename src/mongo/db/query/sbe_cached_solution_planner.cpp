@@ -34,6 +34,8 @@
 
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
@@ -74,12 +76,51 @@ CandidatePlans CachedSolutionPlanner::plan(
     auto stats{candidate.root->getStats(false /* includeDebugInfo  */)};
     auto numReads{calculateNumberOfReads(stats.get())};
 
-    // If the cached plan hit EOF quickly enough, or still as efficient as before, then no need to
-    // replan. Finalize the cached plan and return it.
-    if (stats->common.isEOF || numReads <= maxReadsBeforeReplan) {
+    // If the cached plan hit EOF quickly enough, then no need to replan. Finalize the cached plan
+    // and return it.
+    if (stats->common.isEOF) {
         return {makeVector(finalizeExecutionPlan(std::move(stats), std::move(candidate))), 0};
     }
 
+    // If the cached plan is still within its budget of reads, record how productive it was during
+    // the trial period. Even though each execution stays within the budget, a plan which has become
+    // consistently much less productive than when it was ranked, for example because it was chosen
+    // for an unrepresentative parameter value on skewed data, is replanned.
+    if (numReads <= maxReadsBeforeReplan) {
+        PlanSummaryStats summaryStats;
+        explainer->getSummaryStats(&summaryStats);
+
+        auto cache = CollectionQueryInfo::get(_collection).getPlanCache();
+        auto runtimeStats = cache->recordRuntimeStats(_cq,
+                                                      summaryStats.totalKeysExamined,
+                                                      summaryStats.totalDocsExamined,
+                                                      stats->common.advances,
+                                                      numReads);
+        const double driftRatio = internalQueryCacheProductivityDriftRatio.load();
+        if (!runtimeStats ||
+            !runtimeStats->hasDrifted(internalQueryCacheMinExecutionsBeforeDriftCheck.load(),
+                                      driftRatio)) {
+            return {makeVector(finalizeExecutionPlan(std::move(stats), std::move(candidate))), 0};
+        }
+
+        LOGV2_DEBUG(5899100,
+                    1,
+                    "Evicting cache entry for a query and replanning it since the cached plan has "
+                    "become less productive than when it was ranked",
+                    "decisionProductivity"_attr = runtimeStats->decisionProductivity,
+                    "observedProductivity"_attr = runtimeStats->observedProductivity(),
+                    "numExecutions"_attr = runtimeStats->numExecutions,
+                    "query"_attr = redact(_cq.toStringShort()),
+                    "planSummary"_attr = explainer->getPlanSummary());
+        return replan(true,
+                      str::stream()
+                          << "cached plan was less productive than expected: expected "
+                          << runtimeStats->decisionProductivity
+                          << " documents returned per read but observed "
+                          << runtimeStats->observedProductivity() << " over "
+                          << runtimeStats->numExecutions << " executions");
+    }
+
     // If we're here, the trial period took more than 'maxReadsBeforeReplan' physical reads. This
     // plan may not be efficient any longer, so we replan from scratch.
     LOGV2_DEBUG(
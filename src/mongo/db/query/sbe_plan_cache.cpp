@@ -29,6 +29,8 @@
 
 #include "mongo/db/query/sbe_plan_cache.h"
 
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/server_options.h"
 
 namespace mongo {
@@ -37,13 +39,17 @@ namespace {
 const auto sbePlanCacheDecoration =
     ServiceContext::declareDecoration<std::unique_ptr<sbe::PlanCache>>();
 
+ServerStatusMetricField<Counter64> sbePlanCacheTotalSizeEstimateBytesMetric(
+    "query.sbePlanCacheTotalSizeEstimateBytes", &PlanCacheEntry::planCacheTotalSizeEstimateBytes);
+ServerStatusMetricField<Counter64> sbePlanCacheEvictionsMetric(
+    "query.sbePlanCacheEvictions", &PlanCacheEntry::planCacheEvictions);
+
 ServiceContext::ConstructorActionRegisterer planCacheRegisterer{
     "PlanCacheRegisterer", [](ServiceContext* serviceCtx) {
-        // Max memory size in bytes of the PlanCache.
-        constexpr size_t kQueryCacheMaxSizeInBytes = 100 * 1024 * 1024;
         if (feature_flags::gFeatureFlagSbePlanCache.isEnabledAndIgnoreFCV()) {
             auto& globalPlanCache = sbePlanCacheDecoration(serviceCtx);
-            globalPlanCache = std::make_unique<sbe::PlanCache>(kQueryCacheMaxSizeInBytes);
+            globalPlanCache = std::make_unique<sbe::PlanCache>(
+                static_cast<size_t>(internalQuerySBEPlanCacheMaxSizeBytes));
         }
     }};
 
@@ -51,12 +51,14 @@
 #include "mongo/db/exec/sbe/stages/traverse.h"
 #include "mongo/db/exec/sbe/stages/union.h"
 #include "mongo/db/exec/sbe/stages/unique.h"
+#include "mongo/db/exec/sbe/stages/unwind.h"
 #include "mongo/db/exec/sbe/values/sort_spec.h"
 #include "mongo/db/exec/shard_filterer.h"
 #include "mongo/db/fts/fts_index_format.h"
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/fts_access_method.h"
+#include "mongo/db/query/query_request_helper.h"
 #include "mongo/db/query/sbe_stage_builder_accumulator.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
 #include "mongo/db/query/sbe_stage_builder_expression.h"
@@ -706,8 +708,19 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
 
     auto csn = static_cast<const CollectionScanNode*>(root);
 
-    auto [stage, outputs] = generateCollScan(
-        _state, _collection, csn, _yieldPolicy, reqs.getIsTailableCollScanResumeBranch());
+    // A parallel scan does not return the documents in natural order, so it cannot be used if the
+    // query asks for this order explicitly.
+    const auto& findCommand = _cq.getFindCommandRequest();
+    const bool allowParallelScan =
+        !findCommand.getSort().hasField(query_request_helper::kNaturalSortField) &&
+        !findCommand.getHint().hasField(query_request_helper::kNaturalSortField);
+
+    auto [stage, outputs] = generateCollScan(_state,
+                                             _collection,
+                                             csn,
+                                             _yieldPolicy,
+                                             reqs.getIsTailableCollScanResumeBranch(),
+                                             allowParallelScan);
 
     if (reqs.has(kReturnKey)) {
         // Assign the 'returnKeySlot' to be the empty object.
@@ -1918,6 +1931,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                         innerCondSlots,
                                                         innerProjectSlots,
                                                         collatorSlot,
+                                                        _cq.getExpCtx()->allowDiskUse,
                                                         root->nodeId());
 
     // If there are more than 2 children, iterate all remaining children and hash
@@ -1940,6 +1954,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                        innerCondSlots,
                                                        innerProjectSlots,
                                                        collatorSlot,
+                                                       _cq.getExpCtx()->allowDiskUse,
                                                        root->nodeId());
     }
 
@@ -2243,6 +2258,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                       {groupBySlot},
                                       std::move(accSlotToExprMap),
                                       _state.env->getSlotIfExists("collator"_sd),
+                                      _cq.getExpCtx()->allowDiskUse,
                                       nodeId);
 
     tassert(
@@ -2273,13 +2289,49 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             "slots",
             finalSlots.size() == kGroupBySlots + accStmts.size());
 
+    // Applies the $unwind stages pushed down along with this group to its output slots, so that
+    // each unwound element takes the place of the array in the result object.
+    auto groupOutStage = std::move(groupFinalEvalStage.stage);
+    for (auto&& unwind : groupNode->unwinds) {
+        auto fieldIt = std::find(fieldNames.begin(), fieldNames.end(), unwind.fieldName);
+        tassert(6170449,
+                "An $unwind pushed down with a $group must unwind one of the group's fields",
+                fieldIt != fieldNames.end());
+        auto& fieldSlot = finalSlots[std::distance(fieldNames.begin(), fieldIt)];
+
+        auto unwoundSlot = _slotIdGenerator.generate();
+        auto indexSlot = _slotIdGenerator.generate();
+        groupOutStage = sbe::makeS<sbe::UnwindStage>(std::move(groupOutStage),
+                                                     fieldSlot,
+                                                     unwoundSlot,
+                                                     indexSlot,
+                                                     unwind.preserveNullAndEmptyArrays,
+                                                     nodeId);
+        fieldSlot = unwoundSlot;
+
+        if (unwind.indexFieldName) {
+            // Like the classic $unwind, output a null index for a value which did not come from an
+            // array, including a preserved empty array, for which the unwound value is Nothing.
+            auto indexFieldSlot = _slotIdGenerator.generate();
+            groupOutStage = sbe::makeProjectStage(
+                std::move(groupOutStage),
+                nodeId,
+                indexFieldSlot,
+                sbe::makeE<sbe::EIf>(makeFunction("exists", makeVariable(unwoundSlot)),
+                                     makeFillEmptyNull(makeVariable(indexSlot)),
+                                     makeConstant(sbe::value::TypeTags::Null, 0)));
+            fieldNames.push_back(*unwind.indexFieldName);
+            finalSlots.push_back(indexFieldSlot);
+        }
+    }
+
     // Builds a stage to create a result object out of a group-by slot and gathered accumulator
     // result slots.
     PlanStageSlots outputs;
     outputs.set(kResult, _slotIdGenerator.generate());
     // This mkbson stage combines 'finalSlots' into a bsonObject result slot which has 'fieldNames'
     // fields.
-    auto outStage = sbe::makeS<sbe::MakeBsonObjStage>(std::move(groupFinalEvalStage.stage),
+    auto outStage = sbe::makeS<sbe::MakeBsonObjStage>(std::move(groupOutStage),
                                                       outputs.get(kResult),        // objSlot
                                                       boost::none,                 // rootSlot
                                                       boost::none,                 // fieldBehavior
@@ -615,6 +615,102 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
 
     return {std::move(stage), std::move(outputs)};
 }
+
+/**
+ * Returns true if the collection scan described by 'csn' may be split across several threads by
+ * 'generateParallelCollScan()'. This is an opt-in mode which is only applicable to plain forward
+ * scans over large enough collections, as the documents are returned in no particular order, by
+ * reads at a point in time.
+ */
+bool canUseParallelCollScan(StageBuilderState& state,
+                            const CollectionPtr& collection,
+                            const CollectionScanNode* csn,
+                            bool isTailableResumeBranch) {
+    if (internalQuerySlotBasedExecutionParallelCollScanDegree.load() < 2) {
+        return false;
+    }
+
+    // The producers do not see the writes of a multi-document transaction. Cloning an exchange for
+    // the SBE plan cache would make the clone share the producers of the original plan.
+    if (state.opCtx->inMultiDocumentTransaction() ||
+        feature_flags::gFeatureFlagSbePlanCache.isEnabledAndIgnoreFCV()) {
+        return false;
+    }
+
+    if (csn->direction != CollectionScanParams::FORWARD || csn->tailable ||
+        isTailableResumeBranch || csn->resumeAfterRecordId || csn->requestResumeToken ||
+        csn->shouldTrackLatestOplogTimestamp || csn->shouldWaitForOplogVisibility ||
+        collection->ns().isOplog() || collection->isClustered()) {
+        return false;
+    }
+
+    if (collection->numRecords(state.opCtx) <
+        internalQuerySlotBasedExecutionParallelCollScanMinRecords.load()) {
+        return false;
+    }
+
+    // The producers only see the same snapshot of the collection if they read at a timestamp,
+    // which is not the case of local reads on a primary or a standalone.
+    return state.opCtx->recoveryUnit()->getPointInTimeReadTimestamp(state.opCtx).has_value();
+}
+
+/**
+ * Generates a collection scan sub-tree which splits the collection into RecordId ranges and scans
+ * them, applying the filter if there is one, on several threads:
+ *
+ *   exchange [resultSlot, recordIdSlot] degree round
+ *     filter? pscan resultSlot recordIdSlot
+ *
+ * The ranges are handed out to the producers by the shared state of the 'ParallelScanStage'. Each
+ * producer reads at the same point in time as the consumer and holds an intent lock on the
+ * collection, which it only releases while it waits for the consumer to catch up.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateParallelCollScan(
+    StageBuilderState& state, const CollectionPtr& collection, const CollectionScanNode* csn) {
+    auto resultSlot = state.slotId();
+    auto recordIdSlot = state.slotId();
+
+    std::unique_ptr<sbe::PlanStage> stage =
+        sbe::makeS<sbe::ParallelScanStage>(collection->uuid(),
+                                           resultSlot,
+                                           recordIdSlot,
+                                           boost::none /* snapshotIdSlot */,
+                                           boost::none /* indexIdSlot */,
+                                           boost::none /* indexKeySlot */,
+                                           boost::none /* keyPatternSlot */,
+                                           std::vector<std::string>{},
+                                           sbe::makeSV(),
+                                           nullptr /* yieldPolicy */,
+                                           csn->nodeId(),
+                                           sbe::ScanCallbacks{});
+
+    if (csn->filter) {
+        auto relevantSlots = sbe::makeSV(resultSlot, recordIdSlot);
+
+        auto [_, outputStage] = generateFilter(state,
+                                               csn->filter.get(),
+                                               {std::move(stage), std::move(relevantSlots)},
+                                               resultSlot,
+                                               csn->nodeId());
+        stage = std::move(outputStage.stage);
+    }
+
+    stage = sbe::makeS<sbe::ExchangeConsumer>(
+        std::move(stage),
+        internalQuerySlotBasedExecutionParallelCollScanDegree.load(),
+        sbe::makeSV(resultSlot, recordIdSlot),
+        sbe::ExchangePolicy::roundrobin,
+        nullptr /* partition */,
+        nullptr /* orderLess */,
+        NamespaceStringOrUUID{collection->ns().db().toString(), collection->uuid()},
+        csn->nodeId());
+
+    PlanStageSlots outputs;
+    outputs.set(PlanStageSlots::kResult, resultSlot);
+    outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
+
+    return {std::move(stage), std::move(outputs)};
+}
 }  // namespace
 
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
@@ -622,10 +718,14 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     const CollectionPtr& collection,
     const CollectionScanNode* csn,
     PlanYieldPolicy* yieldPolicy,
-    bool isTailableResumeBranch) {
+    bool isTailableResumeBranch,
+    bool allowParallelScan) {
     if (csn->minRecord || csn->maxRecord || csn->stopApplyingFilterAfterFirstMatch) {
         return generateOptimizedOplogScan(
             state, collection, csn, yieldPolicy, isTailableResumeBranch);
+    } else if (allowParallelScan &&
+               canUseParallelCollScan(state, collection, csn, isTailableResumeBranch)) {
+        return generateParallelCollScan(state, collection, csn);
     } else {
         return generateGenericCollScan(state, collection, csn, yieldPolicy, isTailableResumeBranch);
     }
@@ -50,6 +50,9 @@ class PlanStageSlots;
  *     were requested to track this data.
  *   * A generated PlanStage sub-tree.
  *
+ * If 'allowParallelScan' is true, the scan may be split across several threads and return the
+ * documents in no particular order [see internalQuerySlotBasedExecutionParallelCollScanDegree].
+ *
  * In cases of an error, throws.
  */
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
@@ -57,6 +60,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     const CollectionPtr& collection,
     const CollectionScanNode* csn,
     PlanYieldPolicy* yieldPolicy,
-    bool isTailableResumeBranch);
+    bool isTailableResumeBranch,
+    bool allowParallelScan);
 
 }  // namespace mongo::stage_builder
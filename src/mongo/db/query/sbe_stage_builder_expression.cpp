@@ -462,6 +462,7 @@ public:
     void visit(const ExpressionSetField* expr) final {}
     void visit(const ExpressionTsSecond* expr) final {}
     void visit(const ExpressionTsIncrement* expr) final {}
+    void visit(const ExpressionSharedSubexpression* expr) final {}
 
 private:
     void visitMultiBranchLogicExpression(const Expression* expr, sbe::EPrimBinary::Op logicOp) {
@@ -669,6 +670,7 @@ public:
     void visit(const ExpressionSetField* expr) final {}
     void visit(const ExpressionTsSecond* expr) final {}
     void visit(const ExpressionTsIncrement* expr) final {}
+    void visit(const ExpressionSharedSubexpression* expr) final {}
 
 private:
     void visitMultiBranchLogicExpression(const Expression* expr, sbe::EPrimBinary::Op logicOp) {
@@ -1142,6 +1144,7 @@ public:
                                       sbe::makeSV(),
                                       sbe::makeEM(groupSlot, std::move(addToArrayExpr)),
                                       collatorSlot,
+                                      false /* allowDiskUse */,
                                       _context->planNodeId);
 
         // Build subtree to handle nulls. If an input is null, return null. Otherwise, unwind the
@@ -1170,6 +1173,7 @@ public:
                         sbe::makeSV(),
                         sbe::makeEM(finalGroupSlot, std::move(finalAddToArrayExpr)),
                         collatorSlot,
+                        false /* allowDiskUse */,
                         _context->planNodeId);
 
         // Create a branch stage to select between the branch that produces one null if any elements
@@ -2803,6 +2807,10 @@ public:
         _context->pushExpr(std::move(tsIncrementExpr));
     }
 
+    void visit(const ExpressionSharedSubexpression* expr) final {
+        unsupportedExpression("$internalSharedSubexpression");
+    }
+
 private:
     /**
      * Shared logic for $and, $or. Converts each child into an EExpression that evaluates to Boolean
@@ -448,6 +448,7 @@ EvalStage makeHashAgg(EvalStage stage,
                       sbe::value::SlotVector gbs,
                       sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs,
                       boost::optional<sbe::value::SlotId> collatorSlot,
+                      bool allowDiskUse,
                       PlanNodeId planNodeId) {
     stage.outSlots = gbs;
     for (auto& [slot, _] : aggs) {
@@ -459,6 +460,7 @@ EvalStage makeHashAgg(EvalStage stage,
                                                 sbe::makeSV(),
                                                 true /* optimized close */,
                                                 collatorSlot,
+                                                allowDiskUse,
                                                 planNodeId);
     return stage;
 }
@@ -344,6 +344,7 @@ EvalStage makeHashAgg(EvalStage stage,
                       sbe::value::SlotVector gbs,
                       sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs,
                       boost::optional<sbe::value::SlotId> collatorSlot,
+                      bool allowDiskUse,
                       PlanNodeId planNodeId);
 
 EvalStage makeMkBsonObj(EvalStage stage,
@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/string_data.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/index_build_entry_helpers.h"
 #include "mongo/db/index_builds_coordinator.h"
@@ -39,11 +40,13 @@
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/database_cloner_gen.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
 #include "mongo/db/wire_version.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 
 namespace mongo {
 namespace repl {
@@ -96,7 +99,14 @@ CollectionCloner::CollectionCloner(const NamespaceString& sourceNss,
           _dbWorkTaskRunner.schedule(std::move(task));
           return executor::TaskExecutor::CallbackHandle();
       }),
-      _dbWorkTaskRunner(dbPool) {
+      _dbWorkTaskRunner(dbPool),
+      _createRangeClientFn([this] {
+          auto conn = std::make_unique<DBClientConnection>(true /* autoReconnect */);
+          uassertStatusOK(conn->connect(getSource(), StringData(), boost::none));
+          uassertStatusOK(replAuthenticate(conn.get()).withContext(
+              str::stream() << "Failed to authenticate to " << getSource()));
+          return conn;
+      }) {
     invariant(sourceNss.isValid());
     invariant(collectionOptions.uuid);
     _sourceDbAndUuid = NamespaceStringOrUUID(sourceNss.db().toString(), *collectionOptions.uuid);
@@ -236,7 +246,15 @@ BaseCloner::AfterStageBehavior CollectionCloner::createCollectionStage() {
 }
 
 BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
-    runQuery();
+    if (!_idRangesComputed) {
+        computeIdRanges();
+        _idRangesComputed = true;
+    }
+    if (_idRanges.empty()) {
+        runQuery();
+    } else {
+        runIdRangeQueries();
+    }
     waitForDatabaseWorkToComplete();
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
@@ -371,6 +389,174 @@ void CollectionCloner::runQuery() {
     }
 }
 
+void CollectionCloner::computeIdRanges() {
+    const long long maxRanges = collectionClonerParallelIdRanges.load();
+    if (maxRanges <= 1 || _idIndexSpec.isEmpty() || _collectionOptions.capped ||
+        _collectionOptions.clusteredIndex) {
+        return;
+    }
+
+    long long bytesToCopy;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        bytesToCopy = _stats.bytesToCopy;
+    }
+    if (bytesToCopy <= 0 || bytesToCopy < collectionClonerParallelIdRangesMinBytes.load()) {
+        return;
+    }
+
+    // 'splitVector' aims for chunks of half the requested maximum size.
+    BSONObj res;
+    getClient()->runCommand(
+        _sourceNss.db().toString(),
+        BSON("splitVector" << _sourceNss.ns() << "keyPattern" << BSON("_id" << 1)
+                           << "maxChunkSizeBytes" << std::max(2 * bytesToCopy / maxRanges, 1LL)
+                           << "maxSplitPoints" << maxRanges - 1),
+        res);
+    if (auto status = getStatusFromCommandResult(res); !status.isOK()) {
+        LOGV2(6010600,
+              "Could not split collection into _id ranges, cloning it with a single query",
+              "namespace"_attr = _sourceNss,
+              "error"_attr = status);
+        return;
+    }
+
+    BSONObj min;
+    for (auto&& splitKey : res.getField("splitKeys").Array()) {
+        auto max = splitKey.Obj().getOwned();
+        _idRanges.push_back({min, max});
+        min = max;
+    }
+    if (_idRanges.empty()) {
+        return;
+    }
+    _idRanges.push_back({min, BSONObj()});
+
+    LOGV2(6010601,
+          "Cloning collection in concurrent _id ranges",
+          "namespace"_attr = _sourceNss,
+          "numRanges"_attr = _idRanges.size());
+}
+
+void CollectionCloner::runIdRangeQueries() {
+    ThreadPool::Options options;
+    options.poolName = "CollectionClonerIdRanges";
+    options.minThreads = 0;
+    options.maxThreads = _idRanges.size();
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    ThreadPool pool(options);
+    pool.startup();
+
+    // Each range query reports into its own slot, which is read only once the pool has joined.
+    std::vector<Status> statuses(_idRanges.size(), Status::OK());
+    _idRangeQueryFailed.store(false);
+    for (size_t i = 0; i < _idRanges.size(); ++i) {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_idRanges[i].done) {
+                continue;
+            }
+        }
+        pool.schedule([this, i, &statuses](auto status) {
+            try {
+                uassertStatusOK(status);
+                auto conn = _createRangeClientFn();
+                runIdRangeQuery(conn.get(), i);
+            } catch (...) {
+                statuses[i] = exceptionToStatus();
+                _idRangeQueryFailed.store(true);
+            }
+        });
+    }
+    pool.shutdown();
+    pool.join();
+
+    // A dropped collection takes precedence, as it ends the clone cleanly.
+    Status firstError = Status::OK();
+    for (auto&& status : statuses) {
+        if (status == ErrorCodes::NamespaceNotFound) {
+            uassertStatusOK(status);
+        }
+        if (firstError.isOK()) {
+            firstError = status;
+        }
+    }
+    uassertStatusOK(firstError);
+}
+
+void CollectionCloner::runIdRangeQuery(DBClientConnection* conn, size_t rangeIndex) {
+    BSONObjBuilder bounds;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        const auto& range = _idRanges[rangeIndex];
+        // A retried range restarts at the last document it delivered, which is then skipped.
+        const auto& min = range.lastId ? *range.lastId : range.min;
+        if (!min.isEmpty()) {
+            bounds.append("$min", min);
+        }
+        if (!range.max.isEmpty()) {
+            bounds.append("$max", range.max);
+        }
+    }
+    Query query;
+    query.hint(BSON("_id" << 1)).appendElements(bounds.obj());
+
+    conn->query(
+        [this, rangeIndex](DBClientCursorBatchIterator& iter) {
+            handleNextIdRangeBatch(iter, rangeIndex);
+        },
+        _sourceDbAndUuid,
+        BSONObj{},
+        query,
+        nullptr /* fieldsToReturn */,
+        QueryOption_NoCursorTimeout | QueryOption_SecondaryOk,
+        _collectionClonerBatchSize,
+        ReadConcernArgs::kImplicitDefault);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _idRanges[rangeIndex].done = true;
+}
+
+void CollectionCloner::handleNextIdRangeBatch(DBClientCursorBatchIterator& iter,
+                                              size_t rangeIndex) {
+    {
+        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
+        if (!getSharedData()->getStatus(lk).isOK()) {
+            uasserted(ErrorCodes::CallbackCanceled,
+                      str::stream() << "Collection cloning cancelled due to initial sync failure: "
+                                    << getSharedData()->getStatus(lk));
+        }
+    }
+    uassert(ErrorCodes::CallbackCanceled,
+            "Collection cloning cancelled due to the failure of another _id range",
+            !_idRangeQueryFailed.load());
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stats.receivedBatches++;
+        auto& range = _idRanges[rangeIndex];
+        BSONElement lastId;
+        while (iter.moreInCurrentBatch()) {
+            auto doc = iter.nextSafe();
+            if (range.lastId && doc["_id"].woCompare(range.lastId->firstElement(), false) == 0) {
+                continue;
+            }
+            _documentsToInsert.emplace_back(doc);
+            lastId = _documentsToInsert.back()["_id"];
+        }
+        if (!lastId.eoo()) {
+            range.lastId = lastId.wrap();
+        }
+    }
+
+    auto&& scheduleResult = _scheduleDbWorkFn(
+        [=](const executor::TaskExecutor::CallbackArgs& cbd) { insertDocumentsCallback(cbd); });
+    if (!scheduleResult.isOK()) {
+        uassertStatusOK(scheduleResult.getStatus().withContext(
+            str::stream() << "Error cloning collection '" << _sourceNss.ns() << "'"));
+    }
+}
+
 void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
     {
         stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
@@ -77,6 +77,12 @@ public:
     using ScheduleDbWorkFn = unique_function<StatusWith<executor::TaskExecutor::CallbackHandle>(
         executor::TaskExecutor::CallbackFn)>;
 
+    /**
+     * Type of function to create the additional, authenticated connections to the sync source used
+     * to clone '_id' ranges of a collection concurrently.
+     */
+    using CreateRangeClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
     CollectionCloner(const NamespaceString& ns,
                      const CollectionOptions& collectionOptions,
                      InitialSyncSharedData* sharedData,
@@ -122,6 +128,15 @@ public:
         _scheduleDbWorkFn = std::move(scheduleDbWorkFn);
     }
 
+    /**
+     * Overrides how the connections used to clone '_id' ranges concurrently are created.
+     *
+     * For testing only.
+     */
+    void setCreateRangeClientFn_forTest(CreateRangeClientFn createRangeClientFn) {
+        _createRangeClientFn = std::move(createRangeClientFn);
+    }
+
 protected:
     ClonerStages getStages() final;
 
@@ -130,6 +145,20 @@ protected:
 private:
     friend class CollectionClonerTest;
 
+    /**
+     * A contiguous range of the '_id' index of the collection, cloned by its own query.
+     */
+    struct IdRange {
+        // Inclusive lower and exclusive upper bound, in the '{_id: <value>}' form accepted by the
+        // 'min' and 'max' options of find. Empty when the range is unbounded on that side.
+        BSONObj min;
+        BSONObj max;
+        // The '_id' of the last document handed to the bulk loader, if any. A retried query on
+        // this range resumes right after it.
+        boost::optional<BSONObj> lastId;
+        bool done = false;
+    };
+
     class CollectionClonerStage : public ClonerStage<CollectionCloner> {
     public:
         CollectionClonerStage(std::string name, CollectionCloner* cloner, ClonerRunFn stageFunc)
@@ -226,6 +255,30 @@ private:
      */
     void runQuery();
 
+    /**
+     * Splits the '_id' index of the collection into at most 'collectionClonerParallelIdRanges'
+     * ranges of roughly equal size, using the 'splitVector' command of the sync source. Leaves
+     * '_idRanges' empty if the collection does not qualify for range cloning or cannot be split,
+     * in which case it is cloned by a single query.
+     */
+    void computeIdRanges();
+
+    /**
+     * Clones every unfinished range of '_idRanges' concurrently, each over its own connection.
+     * Throws the first error encountered once all the range queries have stopped.
+     */
+    void runIdRangeQueries();
+
+    /**
+     * Runs the query of a single range to completion over 'conn'.
+     */
+    void runIdRangeQuery(DBClientConnection* conn, size_t rangeIndex);
+
+    /**
+     * Queues the documents of a range query batch for insertion and records the last '_id' seen.
+     */
+    void handleNextIdRangeBatch(DBClientCursorBatchIterator& iter, size_t rangeIndex);
+
     /**
      * Used to terminate the clone when we encounter a fatal error during a non-resumable query.
      * Throws.
@@ -282,6 +335,19 @@ private:
     // Signifies that there were changes to the collection on the sync source that resulted in
     // our remote cursor getting killed.
     bool _lostNonResumableCursor = false;  // (X)
+
+    // Whether computeIdRanges() already ran. Ranges are computed once, so that a retried query
+    // stage resumes the ranges it started instead of splitting the collection again.
+    bool _idRangesComputed = false;  // (X)
+
+    // The '_id' ranges cloned concurrently. Empty if the collection is cloned by a single query.
+    // The bounds are (X), 'lastId' and 'done' are (M).
+    std::vector<IdRange> _idRanges;
+
+    // Set once any range query fails, to stop the other ones early.
+    AtomicWord<bool> _idRangeQueryFailed{false};  // (S)
+
+    CreateRangeClientFn _createRangeClientFn;  // (R)
 };
 
 }  // namespace repl
@@ -425,6 +425,84 @@ TEST_F(CollectionClonerTestResumable, InsertDocumentsMultipleBatches) {
     ASSERT_EQUALS(2u, stats.receivedBatches);
 }
 
+TEST_F(CollectionClonerTestResumable, InsertDocumentsInConcurrentIdRanges) {
+    auto rangesDefault = collectionClonerParallelIdRanges.load();
+    auto minBytesDefault = collectionClonerParallelIdRangesMinBytes.load();
+    collectionClonerParallelIdRanges.store(2);
+    collectionClonerParallelIdRangesMinBytes.store(0);
+    ON_BLOCK_EXIT([&]() {
+        collectionClonerParallelIdRanges.store(rangesDefault);
+        collectionClonerParallelIdRangesMinBytes.store(minBytesDefault);
+    });
+
+    // Set up data for preliminary stages.
+    setMockServerReplies(BSON("size" << 40),
+                         createCountResponse(4),
+                         createCursorResponse(_nss.ns(), BSON_ARRAY(_idIndexSpec)));
+    _mockServer->setCommandReply("splitVector",
+                                 BSON("splitKeys" << BSON_ARRAY(BSON("_id" << 3)) << "ok" << 1));
+
+    // The mock server does not apply the range bounds, so each range is served by its own server
+    // holding only the documents of that range.
+    std::vector<std::unique_ptr<MockRemoteDBServer>> rangeServers;
+    for (int i = 0; i < 2; ++i) {
+        rangeServers.push_back(std::make_unique<MockRemoteDBServer>(_source.toString()));
+        rangeServers.back()->assignCollectionUuid(_nss.ns(), _collUuid);
+        rangeServers.back()->insert(_nss.ns(), BSON("_id" << 2 * i + 1));
+        rangeServers.back()->insert(_nss.ns(), BSON("_id" << 2 * i + 2));
+    }
+    AtomicWord<int> numRangeClients{0};
+
+    auto cloner = makeCollectionCloner();
+    cloner->setCreateRangeClientFn_forTest([&]() -> std::unique_ptr<DBClientConnection> {
+        auto server = rangeServers[numRangeClients.fetchAndAdd(1)].get();
+        return std::make_unique<MockDBClientConnection>(server);
+    });
+    ASSERT_OK(cloner->run());
+
+    ASSERT_EQUALS(2, numRangeClients.load());
+    ASSERT_EQUALS(4, _collectionStats->insertCount);
+    ASSERT_TRUE(_collectionStats->commitCalled);
+    // The main connection is not used to query documents.
+    ASSERT_EQUALS(0u, _mockServer->getQueryCount());
+    for (auto&& server : rangeServers) {
+        ASSERT_EQUALS(1u, server->getQueryCount());
+    }
+
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(4u, stats.documentsCopied);
+    ASSERT_EQUALS(2u, stats.receivedBatches);
+}
+
+TEST_F(CollectionClonerTestResumable, InsertDocumentsWithSingleQueryWhenSplitVectorFails) {
+    auto rangesDefault = collectionClonerParallelIdRanges.load();
+    auto minBytesDefault = collectionClonerParallelIdRangesMinBytes.load();
+    collectionClonerParallelIdRanges.store(2);
+    collectionClonerParallelIdRangesMinBytes.store(0);
+    ON_BLOCK_EXIT([&]() {
+        collectionClonerParallelIdRanges.store(rangesDefault);
+        collectionClonerParallelIdRangesMinBytes.store(minBytesDefault);
+    });
+
+    // Set up data for preliminary stages.
+    setMockServerReplies(BSON("size" << 20),
+                         createCountResponse(2),
+                         createCursorResponse(_nss.ns(), BSON_ARRAY(_idIndexSpec)));
+    _mockServer->setCommandReply("splitVector", Status(ErrorCodes::OperationFailed, ""));
+
+    _mockServer->insert(_nss.ns(), BSON("_id" << 1));
+    _mockServer->insert(_nss.ns(), BSON("_id" << 2));
+
+    auto cloner = makeCollectionCloner();
+    cloner->setCreateRangeClientFn_forTest([]() -> std::unique_ptr<DBClientConnection> {
+        MONGO_UNREACHABLE;
+    });
+    ASSERT_OK(cloner->run());
+
+    ASSERT_EQUALS(2, _collectionStats->insertCount);
+    ASSERT_TRUE(_collectionStats->commitCalled);
+}
+
 TEST_F(CollectionClonerTestResumable, InsertDocumentsScheduleDBWorkFailed) {
     // Set up data for preliminary stages
     setMockServerReplies(BSON("size" << 10),
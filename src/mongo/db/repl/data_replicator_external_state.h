@@ -103,6 +103,13 @@ public:
                                                       const OpTime& previousOpTimeFetched,
                                                       const OpTime& lastOpTimeFetched) = 0;
 
+    /**
+     * Records that fetching a batch of 'bytes' bytes of oplog from 'source' took 'elapsed'.
+     */
+    virtual void recordFetchStats(const HostAndPort& source,
+                                  std::size_t bytes,
+                                  Milliseconds elapsed) = 0;
+
     /**
      * This function creates an oplog buffer of the type specified at server startup.
      */
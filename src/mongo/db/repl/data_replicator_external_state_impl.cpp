@@ -118,6 +118,12 @@ ChangeSyncSourceAction DataReplicatorExternalStateImpl::shouldStopFetching(
     return changeSyncSourceAction;
 }
 
+void DataReplicatorExternalStateImpl::recordFetchStats(const HostAndPort& source,
+                                                       std::size_t bytes,
+                                                       Milliseconds elapsed) {
+    _replicationCoordinator->recordSyncSourceFetchStats(source, bytes, elapsed);
+}
+
 std::unique_ptr<OplogBuffer> DataReplicatorExternalStateImpl::makeInitialSyncOplogBuffer(
     OperationContext* opCtx) const {
     if (initialSyncOplogBuffer == kCollectionOplogBufferName) {
@@ -61,6 +61,10 @@ public:
                                               const OpTime& previousOpTimeFetched,
                                               const OpTime& lastOpTimeFetched) override;
 
+    void recordFetchStats(const HostAndPort& source,
+                          std::size_t bytes,
+                          Milliseconds elapsed) override;
+
     std::unique_ptr<OplogBuffer> makeInitialSyncOplogBuffer(OperationContext* opCtx) const override;
 
     /**
@@ -105,6 +105,12 @@ ChangeSyncSourceAction DataReplicatorExternalStateMock::shouldStopFetching(
     return shouldStopFetchingResult;
 }
 
+void DataReplicatorExternalStateMock::recordFetchStats(const HostAndPort& source,
+                                                       std::size_t bytes,
+                                                       Milliseconds elapsed) {
+    fetchStatsBytesRecorded += bytes;
+}
+
 std::unique_ptr<OplogBuffer> DataReplicatorExternalStateMock::makeInitialSyncOplogBuffer(
     OperationContext* opCtx) const {
     return std::make_unique<OplogBufferBlockingQueue>();
@@ -58,6 +58,10 @@ public:
                                               const OpTime& previousOpTimeFetched,
                                               const OpTime& lastOpTimeFetched) override;
 
+    void recordFetchStats(const HostAndPort& source,
+                          std::size_t bytes,
+                          Milliseconds elapsed) override;
+
     std::unique_ptr<OplogBuffer> makeInitialSyncOplogBuffer(OperationContext* opCtx) const override;
 
     std::unique_ptr<OplogApplier> makeOplogApplier(
@@ -90,6 +94,9 @@ public:
     // Returned by shouldStopFetching.
     ChangeSyncSourceAction shouldStopFetchingResult = ChangeSyncSourceAction::kContinueSyncing;
 
+    // Total of the byte counts passed to recordFetchStats.
+    std::size_t fetchStatsBytesRecorded = 0;
+
     // Override to change applyOplogBatch behavior.
     using ApplyOplogBatchFn = std::function<StatusWith<OpTime>(
         OperationContext*, std::vector<OplogEntry>, OplogApplier::Observer*)>;
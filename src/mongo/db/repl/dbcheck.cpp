@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <third_party/murmurhash3/MurmurHash3.h>
+
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
@@ -43,6 +45,7 @@
 #include "mongo/db/repl/dbcheck_gen.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/optime.h"
+#include "mongo/util/hex.h"
 
 namespace mongo {
 
@@ -156,12 +159,18 @@ std::unique_ptr<HealthLogEntry> dbCheckBatchEntry(const NamespaceString& nss,
                                                   const std::string& foundHash,
                                                   const BSONKey& minKey,
                                                   const BSONKey& maxKey,
-                                                  const repl::OpTime& optime) {
+                                                  const repl::OpTime& optime,
+                                                  DbCheckHashTypeEnum hashType) {
     auto hashes = expectedFound(expectedHash, foundHash);
 
-    auto data = BSON("success" << true << "count" << count << "bytes" << bytes << "md5"
-                               << hashes.second << "minKey" << minKey.elem() << "maxKey"
-                               << maxKey.elem() << "optime" << optime);
+    BSONObjBuilder builder;
+    builder << "success" << true << "count" << count << "bytes" << bytes << "md5" << hashes.second
+            << "minKey" << minKey.elem() << "maxKey" << maxKey.elem() << "optime" << optime;
+    // Entries hashed with MD5 keep their original format.
+    if (hashType != DbCheckHashTypeEnum::kMd5) {
+        builder << "hashType" << DbCheckHashType_serializer(hashType);
+    }
+    auto data = builder.obj();
 
     auto severity = hashes.first ? SeverityEnum::Info : SeverityEnum::Error;
     std::string msg =
@@ -175,8 +184,13 @@ DbCheckHasher::DbCheckHasher(OperationContext* opCtx,
                              const BSONKey& start,
                              const BSONKey& end,
                              int64_t maxCount,
-                             int64_t maxBytes)
-    : _opCtx(opCtx), _maxKey(end), _maxCount(maxCount), _maxBytes(maxBytes) {
+                             int64_t maxBytes,
+                             DbCheckHashTypeEnum hashType)
+    : _opCtx(opCtx),
+      _hashType(hashType),
+      _maxKey(end),
+      _maxCount(maxCount),
+      _maxBytes(maxBytes) {
 
     // Get the MD5 hasher set up.
     md5_init(&_state);
@@ -300,7 +314,7 @@ Status DbCheckHasher::hashAll(void) {
         _bytesSeen += currentObj.objsize();
         _countSeen += 1;
 
-        md5_append(&_state, md5Cast(currentObj.objdata()), currentObj.objsize());
+        _append(currentObj);
     }
 
     // If we got to the end of the collection, set the last key to MaxKey.
@@ -311,11 +325,42 @@ Status DbCheckHasher::hashAll(void) {
     return Status::OK();
 }
 
+void DbCheckHasher::_append(const BSONObj& obj) {
+    switch (_hashType) {
+        case DbCheckHashTypeEnum::kMd5:
+            md5_append(&_state, md5Cast(obj.objdata()), obj.objsize());
+            return;
+        case DbCheckHashTypeEnum::kMurmur3: {
+            static constexpr uint64_t kMultiplier = 0x9E3779B97F4A7C15ULL;
+            uint64_t hash[2];
+            MurmurHash3_x64_128(obj.objdata(), obj.objsize(), 0, hash);
+            _murmurState[0] = _murmurState[0] * kMultiplier + hash[0];
+            _murmurState[1] = _murmurState[1] * kMultiplier + hash[1];
+            return;
+        }
+    }
+
+    MONGO_UNREACHABLE;
+}
+
 std::string DbCheckHasher::total(void) {
-    md5digest digest;
-    md5_finish(&_state, digest);
+    switch (_hashType) {
+        case DbCheckHashTypeEnum::kMd5: {
+            md5digest digest;
+            md5_finish(&_state, digest);
 
-    return digestToString(digest);
+            return digestToString(digest);
+        }
+        case DbCheckHashTypeEnum::kMurmur3: {
+            // Mix the running state once more, so that the total is not linear in the hashes of
+            // the individual documents.
+            uint64_t digest[2];
+            MurmurHash3_x64_128(_murmurState.data(), sizeof(_murmurState), 0, digest);
+            return hexblob::encodeLower(digest, sizeof(digest));
+        }
+    }
+
+    MONGO_UNREACHABLE;
 }
 
 BSONKey DbCheckHasher::lastKey(void) const {
@@ -405,6 +450,7 @@ Status dbCheckBatchOnSecondary(OperationContext* opCtx,
                                const DbCheckOplogBatch& entry) {
     AutoGetCollectionForDbCheck collection(opCtx, entry.getNss(), entry.getType());
     std::string msg = "replication consistency check";
+    auto hashType = entry.getHashType().value_or(DbCheckHashTypeEnum::kMd5);
 
     if (!collection) {
         return Status::OK();
@@ -414,7 +460,13 @@ Status dbCheckBatchOnSecondary(OperationContext* opCtx,
     Status status = Status::OK();
     boost::optional<DbCheckHasher> hasher;
     try {
-        hasher.emplace(opCtx, collection.getCollection(), entry.getMinKey(), entry.getMaxKey());
+        hasher.emplace(opCtx,
+                       collection.getCollection(),
+                       entry.getMinKey(),
+                       entry.getMaxKey(),
+                       std::numeric_limits<int64_t>::max(),
+                       std::numeric_limits<int64_t>::max(),
+                       hashType);
     } catch (const DBException& exception) {
         auto logEntry = dbCheckErrorHealthLogEntry(
             entry.getNss(), msg, OplogEntriesEnum::Batch, exception.toStatus());
@@ -445,7 +497,8 @@ Status dbCheckBatchOnSecondary(OperationContext* opCtx,
                                       found,
                                       entry.getMinKey(),
                                       hasher->lastKey(),
-                                      optime);
+                                      optime,
+                                      hashType);
 
     HealthLog::get(opCtx).log(*logEntry);
 
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 
 #include "mongo/db/catalog/health_log_gen.h"
@@ -66,7 +67,8 @@ std::unique_ptr<HealthLogEntry> dbCheckBatchEntry(const NamespaceString& nss,
                                                   const std::string& foundHash,
                                                   const BSONKey& minKey,
                                                   const BSONKey& maxKey,
-                                                  const repl::OpTime& optime);
+                                                  const repl::OpTime& optime,
+                                                  DbCheckHashTypeEnum hashType);
 
 /**
  * The collection metadata dbCheck sends between nodes.
@@ -98,10 +100,10 @@ std::unique_ptr<HealthLogEntry> dbCheckCollectionEntry(const NamespaceString& ns
 /**
  * Hashing collections and plans.
  *
- * Provides MD5-based hashing of ranges of documents.  Note that this class does *not* provide
- * synchronization: clients must, for example, lock the database to ensure that named collections
- * exist, and hold at least a MODE_IS lock before asking a `DbCheckHasher` to retrieve any
- * documents.
+ * Provides MD5-based or MurmurHash3-based hashing of ranges of documents.  Note that this class
+ * does *not* provide synchronization: clients must, for example, lock the database to ensure that
+ * named collections exist, and hold at least a MODE_IS lock before asking a `DbCheckHasher` to
+ * retrieve any documents.
  */
 class DbCheckHasher {
 public:
@@ -117,13 +119,16 @@ public:
      * @param end The last key to hash (inclusive).
      * @param maxCount The maximum number of documents to hash.
      * @param maxBytes The maximum number of bytes to hash.
+     * @param hashType The hash function to use. MurmurHash3 is much cheaper than MD5, and is
+     *                 enough to detect accidental inconsistencies.
      */
     DbCheckHasher(OperationContext* opCtx,
                   const CollectionPtr& collection,
                   const BSONKey& start,
                   const BSONKey& end,
                   int64_t maxCount = std::numeric_limits<int64_t>::max(),
-                  int64_t maxBytes = std::numeric_limits<int64_t>::max());
+                  int64_t maxBytes = std::numeric_limits<int64_t>::max(),
+                  DbCheckHashTypeEnum hashType = DbCheckHashTypeEnum::kMd5);
 
     /**
      * Hash all of our documents.
@@ -152,9 +157,19 @@ private:
      */
     bool _canHash(const BSONObj& obj);
 
+    /**
+     * Add `obj` to the running hash.
+     */
+    void _append(const BSONObj& obj);
+
     OperationContext* _opCtx;
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> _exec;
+
+    DbCheckHashTypeEnum _hashType;
     md5_state_t _state;
+    // The running MurmurHash3 state: each document's 128-bit hash is folded in by multiplying by
+    // an odd constant and adding, so that the result depends on the order of the documents.
+    std::array<uint64_t, 2> _murmurState{0, 0};
 
     BSONKey _maxKey;
     BSONKey _last = BSONKey::min();
@@ -50,6 +50,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/repl/all_database_cloner.h"
+#include "mongo/db/repl/initial_sync_method.h"
 #include "mongo/db/repl/initial_sync_state.h"
 #include "mongo/db/repl/initial_syncer_factory.h"
 #include "mongo/db/repl/member_state.h"
@@ -210,7 +211,7 @@ ServiceContext::ConstructorActionRegisterer initialSyncerRegisterer(
     {"InitialSyncerFactoryRegisterer"} /* dependency list */,
     [](ServiceContext* service) {
         InitialSyncerFactory::get(service)->registerInitialSyncer(
-            "logical",
+            kLogicalInitialSyncMethod.toString(),
             [](InitialSyncerInterface::Options opts,
                std::unique_ptr<DataReplicatorExternalState> dataReplicatorExternalState,
                ThreadPool* writerPool,
@@ -173,6 +173,11 @@ public:
     void denylistSyncSource(const HostAndPort& host, Date_t until) override {
         _syncSourceSelector->denylistSyncSource(host, until);
     }
+    void recordSyncSourceFetchStats(const HostAndPort& host,
+                                    std::size_t bytes,
+                                    Milliseconds elapsed) override {
+        _syncSourceSelector->recordSyncSourceFetchStats(host, bytes, elapsed);
+    }
     ChangeSyncSourceAction shouldChangeSyncSource(const HostAndPort& currentSource,
                                                   const rpc::ReplSetMetadata& replMetadata,
                                                   const rpc::OplogQueryMetadata& oqMetadata,
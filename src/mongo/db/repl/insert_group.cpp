@@ -62,6 +62,7 @@ InsertGroup::InsertGroup(std::vector<const OplogEntry*>* ops,
                          const bool isDataConsistent,
                          ApplyFunc applyOplogEntryOrGroupedInserts)
     : _doNotGroupBeforePoint(ops->cbegin()),
+      _retryEnd(ops->cbegin()),
       _end(ops->cend()),
       _opCtx(opCtx),
       _mode(mode),
@@ -89,8 +90,9 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
                       "Cannot group an insert operation that we previously attempted to group.");
     }
 
-    // Attempt to group 'insert' ops if possible.
-    std::vector<BSONObj> toInsert;
+    // Ops left over from a failed group are grouped again in smaller groups.
+    const bool isRetry = it < _retryEnd;
+    const std::size_t maxOpCount = isRetry ? _retryMaxOpCount : kInsertGroupMaxOpCount;
 
     // Make sure to include the first op in the group size.
     size_t groupSize = entry.getObject().objsize();
@@ -121,7 +123,7 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
             return nextEntry->getOpType() != OpTypeEnum::kInsert  // Must be an insert.
                 || opNamespace != groupNamespace                  // Must be in the same namespace.
                 || groupSize > kInsertGroupMaxGroupSize  // Must not create too large an object.
-                || opCount > kInsertGroupMaxOpCount;     // Limit number of ops in a single group.
+                || opCount > maxOpCount;                 // Limit number of ops in a single group.
         });
 
     // See if we were able to create a group that contains more than a single op.
@@ -145,9 +147,11 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
             "Error applying inserts in bulk. Trying first insert as a lone insert";
         auto status = exceptionToStatus();
 
-        // It's not an error during initial sync to encounter DuplicateKey errors.
-        if (Mode::kInitialSync == _mode &&
-            (ErrorCodes::DuplicateKey == status || ErrorCodes::NamespaceNotFound == status)) {
+        // It's not an error during initial sync to encounter DuplicateKey errors. Failures of
+        // the smaller groups retried after a failed group were already reported with it.
+        if (isRetry ||
+            (Mode::kInitialSync == _mode &&
+             (ErrorCodes::DuplicateKey == status || ErrorCodes::NamespaceNotFound == status))) {
             LOGV2_DEBUG(21203,
                         2,
                         message,
@@ -162,9 +166,12 @@ StatusWith<InsertGroup::ConstIterator> InsertGroup::groupAndApplyInserts(
                         "firstInsert"_attr = redact(entry.toBSONForLogging()));
         }
 
-        // Avoid quadratic run time from failed insert by not retrying until we
-        // are beyond this group of ops.
-        _doNotGroupBeforePoint = endOfGroupableOpsIterator - 1;
+        // Apply the first op of the group alone, and regroup the rest of it in groups of half its
+        // size. This avoids quadratic run time from a bad insert while still grouping its
+        // neighbours.
+        _doNotGroupBeforePoint = it;
+        _retryEnd = std::max(_retryEnd, endOfGroupableOpsIterator);
+        _retryMaxOpCount = std::distance(it, endOfGroupableOpsIterator) / 2;
 
         return status;
     }
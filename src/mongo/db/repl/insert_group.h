@@ -68,10 +68,17 @@ public:
     StatusWith<ConstIterator> groupAndApplyInserts(ConstIterator oplogEntriesIterator) noexcept;
 
 private:
-    // _doNotGroupBeforePoint is used to prevent retrying bad group inserts by marking the final op
-    // of a failed group and not allowing further group inserts until that op has been processed.
+    // _doNotGroupBeforePoint is used to prevent retrying a bad group insert from the same op, by
+    // marking the first op of a failed group so that it is applied as a lone insert.
     ConstIterator _doNotGroupBeforePoint;
 
+    // After a group insert fails, the remaining ops of the group, up to _retryEnd, are grouped
+    // again in groups of at most _retryMaxOpCount ops, half the size of the group that failed.
+    // Halving on every failure bounds the work spent on a bad op to about twice the size of the
+    // first group that contained it, instead of applying all of its neighbours one by one.
+    ConstIterator _retryEnd;
+    std::size_t _retryMaxOpCount = 0;
+
     // Used for constructing search bounds when grouping inserts.
     ConstIterator _end;
 
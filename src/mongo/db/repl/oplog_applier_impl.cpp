@@ -115,7 +115,8 @@ void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
                                       std::vector<std::vector<OplogEntry>>* derivedOps,
                                       OplogEntry* op,
                                       CachedCollectionProperties* collPropertiesCache,
-                                      std::vector<std::vector<const OplogEntry*>>* writerVectors) {
+                                      std::vector<std::vector<const OplogEntry*>>* writerVectors,
+                                      WriterAssignments* writerAssignments) {
     std::vector<OplogEntry> txnOps;
     bool shouldSerialize = false;
     std::tie(txnOps, shouldSerialize) =
@@ -124,8 +125,12 @@ void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
     partialTxnList->clear();
 
     // Transaction entries cannot have different session updates.
-    OplogApplierUtils::addDerivedOps(
-        opCtx, &derivedOps->back(), writerVectors, collPropertiesCache, shouldSerialize);
+    OplogApplierUtils::addDerivedOps(opCtx,
+                                     &derivedOps->back(),
+                                     writerVectors,
+                                     collPropertiesCache,
+                                     shouldSerialize,
+                                     writerAssignments);
 }
 
 }  // namespace
@@ -613,13 +618,16 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
  *      and instructions for updating the transactions table.  Required if processing oplogs
  *      with transactions.
  * sessionUpdateTracker - if provided, keeps track of session info from ops.
+ * writerAssignments - if provided, chooses the writer of each op by its conflict key instead of
+ *      hashing the key onto a fixed writer. Must be shared by every call made for the same batch.
  */
 void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
     OperationContext* opCtx,
     std::vector<OplogEntry>* ops,
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps,
-    SessionUpdateTracker* sessionUpdateTracker) noexcept {
+    SessionUpdateTracker* sessionUpdateTracker,
+    WriterAssignments* writerAssignments) noexcept {
 
     LogicalSessionIdMap<std::vector<OplogEntry*>> partialTxnOps;
     CachedCollectionProperties collPropertiesCache;
@@ -642,7 +650,8 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                                                  &derivedOps->back(),
                                                  writerVectors,
                                                  &collPropertiesCache,
-                                                 false /*serial*/);
+                                                 false /*serial*/,
+                                                 writerAssignments);
             }
         }
 
@@ -678,8 +687,13 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                 // oplog and fill writers with those operations.
                 // Flush partialTxnList operations for current transaction.
                 auto& partialTxnList = partialTxnOps[*logicalSessionId];
-                _addOplogChainOpsToWriterVectors(
-                    opCtx, &partialTxnList, derivedOps, &op, &collPropertiesCache, writerVectors);
+                _addOplogChainOpsToWriterVectors(opCtx,
+                                                 &partialTxnList,
+                                                 derivedOps,
+                                                 &op,
+                                                 &collPropertiesCache,
+                                                 writerVectors,
+                                                 writerAssignments);
             } else {
                 // The applyOps entry was not generated as part of a transaction.
                 invariant(!op.getPrevWriteOpTimeInTransaction());
@@ -691,7 +705,8 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                                                  &derivedOps->back(),
                                                  writerVectors,
                                                  &collPropertiesCache,
-                                                 false /*serial*/);
+                                                 false /*serial*/,
+                                                 writerAssignments);
             }
             continue;
         }
@@ -702,8 +717,13 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
         if (op.isPreparedCommit() && (getOptions().mode == OplogApplication::Mode::kInitialSync)) {
             auto logicalSessionId = op.getSessionId();
             auto& partialTxnList = partialTxnOps[*logicalSessionId];
-            _addOplogChainOpsToWriterVectors(
-                opCtx, &partialTxnList, derivedOps, &op, &collPropertiesCache, writerVectors);
+            _addOplogChainOpsToWriterVectors(opCtx,
+                                             &partialTxnList,
+                                             derivedOps,
+                                             &op,
+                                             &collPropertiesCache,
+                                             writerVectors,
+                                             writerAssignments);
             continue;
         }
 
@@ -711,8 +731,12 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
         // migration and access blocker states.
         if (op.getNss() == NamespaceString::kTenantMigrationDonorsNamespace ||
             op.getNss() == NamespaceString::kTenantMigrationRecipientsNamespace) {
-            auto writerId = OplogApplierUtils::addToWriterVector(
-                opCtx, &op, writerVectors, &collPropertiesCache, tenantMigrationsWriterId);
+            auto writerId = OplogApplierUtils::addToWriterVector(opCtx,
+                                                                 &op,
+                                                                 writerVectors,
+                                                                 &collPropertiesCache,
+                                                                 tenantMigrationsWriterId,
+                                                                 writerAssignments);
             if (!tenantMigrationsWriterId) {
                 tenantMigrationsWriterId.emplace(writerId);
             } else {
@@ -720,7 +744,8 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
             }
             continue;
         }
-        OplogApplierUtils::addToWriterVector(opCtx, &op, writerVectors, &collPropertiesCache);
+        OplogApplierUtils::addToWriterVector(
+            opCtx, &op, writerVectors, &collPropertiesCache, boost::none, writerAssignments);
     }
 }
 
@@ -730,14 +755,23 @@ void OplogApplierImpl::fillWriterVectors(
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps) noexcept {
 
+    // Both passes below must share the assignments, as the session updates flushed at the end of
+    // the batch may conflict with the ones derived while filling the writer vectors.
+    boost::optional<WriterAssignments> writerAssignments;
+    if (oplogApplicationBalanceWriters.load()) {
+        writerAssignments.emplace(writerVectors->size());
+    }
+    auto writerAssignmentsPtr = writerAssignments ? &*writerAssignments : nullptr;
+
     SessionUpdateTracker sessionUpdateTracker;
-    _deriveOpsAndFillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    _deriveOpsAndFillWriterVectors(
+        opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker, writerAssignmentsPtr);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
         _deriveOpsAndFillWriterVectors(
-            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr, writerAssignmentsPtr);
     }
 }
 
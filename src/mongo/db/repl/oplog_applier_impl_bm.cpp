@@ -0,0 +1,327 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/logical_session_id.h"
+#include "mongo/db/repl/oplog_applier_impl.h"
+#include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_entry_test_helpers.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/platform/random.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+constexpr size_t kBatchSize = 1000;
+constexpr int kOpsPerTransaction = 10;
+constexpr int kNumSessions = 16;
+constexpr int kPayloadSize = 128;
+
+enum class Workload { kInsert, kUpdate, kDelete, kTransaction, kMixed };
+
+/**
+ * Generates synthetic oplog entries against a set of collections, keeping track of which _ids are
+ * live so that every update and delete it produces applies to an existing document.
+ */
+class OplogGenerator {
+public:
+    OplogGenerator(std::vector<NamespaceString> namespaces, int numIndexes)
+        : _numIndexes(numIndexes), _payload(kPayloadSize, 'x') {
+        for (auto&& nss : namespaces) {
+            _collections.push_back({std::move(nss)});
+        }
+        for (int i = 0; i < kNumSessions; ++i) {
+            _sessions.push_back({makeLogicalSessionIdForTest(), 0});
+        }
+    }
+
+    std::vector<OplogEntry> makeBatch(Workload workload) {
+        std::vector<OplogEntry> batch;
+        for (size_t i = 0; i < kBatchSize; ++i) {
+            batch.push_back(_makeOp(workload));
+        }
+        return batch;
+    }
+
+    /**
+     * Returns a batch of inserts that brings every collection up to at least 'numDocs' live
+     * documents, or an empty batch if none are needed.
+     */
+    std::vector<OplogEntry> makeRefillBatch(long long numDocs) {
+        std::vector<OplogEntry> batch;
+        for (auto&& coll : _collections) {
+            while (coll.nextId - coll.firstLiveId < numDocs) {
+                batch.push_back(_insert(coll));
+            }
+        }
+        return batch;
+    }
+
+private:
+    struct Collection {
+        NamespaceString nss;
+        long long firstLiveId = 0;
+        long long nextId = 0;
+    };
+
+    struct Session {
+        LogicalSessionId lsid;
+        TxnNumber txnNumber;
+    };
+
+    OpTime _nextOpTime() {
+        ++_count;
+        return OpTime(Timestamp(Seconds(100 + _count / 1000000), _count % 1000000), 1);
+    }
+
+    BSONObj _makeDoc(long long id) {
+        BSONObjBuilder bob;
+        bob.append("_id", id);
+        for (int i = 0; i < _numIndexes; ++i) {
+            bob.append("f" + std::to_string(i), _random.nextInt64());
+        }
+        bob.append("counter", 0);
+        bob.append("payload", _payload);
+        return bob.obj();
+    }
+
+    Collection& _pickCollection() {
+        return _collections[_random.nextInt32(_collections.size())];
+    }
+
+    OplogEntry _insert(Collection& coll) {
+        return makeInsertDocumentOplogEntry(_nextOpTime(), coll.nss, _makeDoc(coll.nextId++));
+    }
+
+    OplogEntry _update(Collection& coll) {
+        auto id = coll.firstLiveId + _random.nextInt64(coll.nextId - coll.firstLiveId);
+        BSONObjBuilder diff;
+        diff.append("counter", _count);
+        if (_numIndexes > 0) {
+            diff.append("f0", _random.nextInt64());
+        }
+        return makeUpdateDocumentOplogEntry(_nextOpTime(),
+                                            coll.nss,
+                                            BSON("_id" << id),
+                                            BSON("$v" << 2 << "diff" << BSON("u" << diff.obj())));
+    }
+
+    OplogEntry _delete(Collection& coll) {
+        return makeDeleteDocumentOplogEntry(
+            _nextOpTime(), coll.nss, BSON("_id" << coll.firstLiveId++));
+    }
+
+    /**
+     * An unprepared transaction that commits in a single applyOps entry.
+     */
+    OplogEntry _transaction() {
+        BSONArrayBuilder ops;
+        for (int i = 0; i < kOpsPerTransaction; ++i) {
+            auto& coll = _pickCollection();
+            ops.append(BSON("op"
+                            << "i"
+                            << "ns" << coll.nss.ns() << "o" << _makeDoc(coll.nextId++)));
+        }
+        auto& session = _sessions[_random.nextInt32(_sessions.size())];
+        return makeCommandOplogEntryWithSessionInfoAndStmtIds(
+            _nextOpTime(),
+            NamespaceString("admin", "$cmd"),
+            BSON("applyOps" << ops.arr()),
+            session.lsid,
+            session.txnNumber++,
+            {StmtId(0)},
+            OpTime());
+    }
+
+    OplogEntry _makeOp(Workload workload) {
+        auto& coll = _pickCollection();
+        bool hasLiveDocs = coll.nextId > coll.firstLiveId;
+        switch (workload) {
+            case Workload::kInsert:
+                return _insert(coll);
+            case Workload::kUpdate:
+                return hasLiveDocs ? _update(coll) : _insert(coll);
+            case Workload::kDelete:
+                return hasLiveDocs ? _delete(coll) : _insert(coll);
+            case Workload::kTransaction:
+                return _transaction();
+            case Workload::kMixed: {
+                // 50% inserts, 30% updates, 15% deletes and 5% transactions.
+                auto roll = _random.nextInt32(100);
+                if (roll < 5) {
+                    return _transaction();
+                } else if (roll < 55 || !hasLiveDocs) {
+                    return _insert(coll);
+                } else if (roll < 85) {
+                    return _update(coll);
+                }
+                return _delete(coll);
+            }
+        }
+        MONGO_UNREACHABLE;
+    }
+
+    const int _numIndexes;
+    const std::string _payload;
+    std::vector<Collection> _collections;
+    std::vector<Session> _sessions;
+    PseudoRandom _random{1};
+    long long _count = 0;
+};
+
+/**
+ * Runs a secondary's OplogApplierImpl on the WiredTiger storage engine. Batches are pushed into
+ * an OplogBuffer, cut by the OplogBatcher and applied by the writer pool, as in steady state
+ * replication.
+ */
+class OplogApplierBenchmarkFixture : public OplogApplierImplTest {
+public:
+    OplogApplierBenchmarkFixture(int numCollections, int numIndexes)
+        : OplogApplierImplTest("wiredTiger") {
+        setUp();
+        invariant(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+
+        std::vector<NamespaceString> namespaces;
+        for (int i = 0; i < numCollections; ++i) {
+            NamespaceString nss("bm", "coll" + std::to_string(i));
+            auto uuid = createCollectionWithUuid(_opCtx.get(), nss);
+            for (int j = 0; j < numIndexes; ++j) {
+                auto field = "f" + std::to_string(j);
+                createIndex(_opCtx.get(),
+                            nss,
+                            uuid,
+                            BSON("v" << int(IndexDescriptor::kLatestIndexVersion) << "key"
+                                     << BSON(field << 1) << "name" << (field + "_1")));
+            }
+            namespaces.push_back(std::move(nss));
+        }
+        _generator = std::make_unique<OplogGenerator>(std::move(namespaces), numIndexes);
+
+        _writerPool = makeReplWriterPool();
+        _applier = std::make_unique<OplogApplierImpl>(nullptr,  // executor
+                                                      &_buffer,
+                                                      &noopOplogApplierObserver,
+                                                      getReplCoord(),
+                                                      getConsistencyMarkers(),
+                                                      getStorageInterface(),
+                                                      OplogApplier::Options(
+                                                          OplogApplication::Mode::kSecondary),
+                                                      _writerPool.get());
+    }
+
+    ~OplogApplierBenchmarkFixture() {
+        _applier.reset();
+        _writerPool->shutdown();
+        _writerPool->join();
+        tearDown();
+    }
+
+    void run(benchmark::State& state, Workload workload) {
+        long long enqueueMicros = 0;
+        long long batchMicros = 0;
+        long long applyMicros = 0;
+        long long opsApplied = 0;
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            if (workload == Workload::kUpdate || workload == Workload::kDelete) {
+                // Keep enough documents around that the batch never runs out of targets.
+                _apply(_generator->makeRefillBatch(kBatchSize));
+            }
+            auto ops = _generator->makeBatch(workload);
+            state.ResumeTiming();
+
+            Timer timer;
+            _applier->enqueue(_opCtx.get(), ops.cbegin(), ops.cend());
+            enqueueMicros += timer.micros();
+
+            while (!_buffer.isEmpty()) {
+                timer.reset();
+                auto batch = uassertStatusOK(_applier->getNextApplierBatch(_opCtx.get(), _limits));
+                batchMicros += timer.micros();
+
+                timer.reset();
+                opsApplied += batch.size();
+                uassertStatusOK(_applier->applyOplogBatch(_opCtx.get(), std::move(batch)));
+                applyMicros += timer.micros();
+            }
+        }
+
+        using benchmark::Counter;
+        state.counters["opsPerSecond"] = Counter(opsApplied, Counter::kIsRate);
+        state.counters["enqueueMicros"] = Counter(enqueueMicros, Counter::kAvgIterations);
+        state.counters["batchMicros"] = Counter(batchMicros, Counter::kAvgIterations);
+        state.counters["applyMicros"] = Counter(applyMicros, Counter::kAvgIterations);
+    }
+
+private:
+    void _doTest() override {}
+
+    void _apply(std::vector<OplogEntry> ops) {
+        if (!ops.empty()) {
+            uassertStatusOK(_applier->applyOplogBatch(_opCtx.get(), std::move(ops)));
+        }
+    }
+
+    std::unique_ptr<OplogGenerator> _generator;
+    OplogBufferBlockingQueue _buffer;
+    std::unique_ptr<ThreadPool> _writerPool;
+    std::unique_ptr<OplogApplierImpl> _applier;
+    OplogApplier::BatchLimits _limits{std::numeric_limits<size_t>::max(), kBatchSize};
+};
+
+template <Workload workload>
+void BM_OplogApplier(benchmark::State& state) {
+    OplogApplierBenchmarkFixture fixture(state.range(0), state.range(1));
+    fixture.run(state, workload);
+}
+
+// Each benchmark runs with {number of collections, number of secondary indexes per collection}.
+void applierArgs(benchmark::internal::Benchmark* bm) {
+    bm->Args({1, 0})->Args({1, 4})->Args({16, 0})->Args({16, 4})->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_OplogApplier, Workload::kInsert)->Apply(applierArgs);
+BENCHMARK_TEMPLATE(BM_OplogApplier, Workload::kUpdate)->Apply(applierArgs);
+BENCHMARK_TEMPLATE(BM_OplogApplier, Workload::kDelete)->Apply(applierArgs);
+BENCHMARK_TEMPLATE(BM_OplogApplier, Workload::kTransaction)->Apply(applierArgs);
+BENCHMARK_TEMPLATE(BM_OplogApplier, Workload::kMixed)->Apply(applierArgs);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -54,8 +54,10 @@
 #include "mongo/db/repl/bgsync.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/idempotency_test_fixture.h"
+#include "mongo/db/repl/insert_group.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/oplog_entry_test_helpers.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -539,6 +541,154 @@ TEST_F(OplogApplierImplTest,
                   secondDerivedOp.getObject()["lastWriteOpTime"]["ts"].timestamp());
 }
 
+TEST_F(OplogApplierImplTest, FillWriterVectorsAppliesOpsOnTheSameDocumentOnOneWriter) {
+    const NamespaceString nss("test", "foo");
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 8; ++i) {
+        ops.push_back(
+            makeInsertDocumentOplogEntry({Timestamp(1, i + 1), 1}, nss, BSON("_id" << i)));
+    }
+    for (int i = 0; i < 8; ++i) {
+        ops.push_back(makeUpdateDocumentOplogEntry(
+            {Timestamp(2, i + 1), 1}, nss, BSON("_id" << i), BSON("$set" << BSON("x" << 1))));
+    }
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    std::vector<std::vector<const OplogEntry*>> writerVectors(4);
+    std::vector<std::vector<OplogEntry>> derivedOps;
+    oplogApplier.fillWriterVectors_forTest(_opCtx.get(), &ops, &writerVectors, &derivedOps);
+
+    // Every writer gets the insert and the update of two documents, in oplog order.
+    for (const auto& writer : writerVectors) {
+        ASSERT_EQUALS(4U, writer.size());
+        ASSERT(writer[0]->getOpType() == OpTypeEnum::kInsert);
+        ASSERT(writer[1]->getOpType() == OpTypeEnum::kInsert);
+        ASSERT(writer[2]->getOpType() == OpTypeEnum::kUpdate);
+        ASSERT(writer[3]->getOpType() == OpTypeEnum::kUpdate);
+        ASSERT_BSONOBJ_EQ(writer[0]->getObject(), *writer[2]->getObject2());
+        ASSERT_BSONOBJ_EQ(writer[1]->getObject(), *writer[3]->getObject2());
+    }
+}
+
+TEST_F(OplogApplierImplTest, FillWriterVectorsKeepsOtherOpsAwayFromAHotDocument) {
+    const NamespaceString nss("test", "foo");
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 10; ++i) {
+        ops.push_back(makeUpdateDocumentOplogEntry(
+            {Timestamp(1, i + 1), 1}, nss, BSON("_id" << 0), BSON("$inc" << BSON("x" << 1))));
+    }
+    for (int i = 1; i < 10; ++i) {
+        ops.push_back(makeInsertDocumentOplogEntry({Timestamp(2, i), 1}, nss, BSON("_id" << i)));
+    }
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    std::vector<std::vector<const OplogEntry*>> writerVectors(4);
+    std::vector<std::vector<OplogEntry>> derivedOps;
+    oplogApplier.fillWriterVectors_forTest(_opCtx.get(), &ops, &writerVectors, &derivedOps);
+
+    // All the updates of the hot document are applied by one writer, and the inserts of the other
+    // documents are spread evenly over the remaining writers.
+    ASSERT_EQUALS(10U, writerVectors[0].size());
+    for (const auto* op : writerVectors[0]) {
+        ASSERT(op->getOpType() == OpTypeEnum::kUpdate);
+    }
+    for (size_t i = 1; i < writerVectors.size(); ++i) {
+        ASSERT_EQUALS(3U, writerVectors[i].size());
+        for (const auto* op : writerVectors[i]) {
+            ASSERT(op->getOpType() == OpTypeEnum::kInsert);
+        }
+    }
+}
+
+TEST(WriterAssignmentsTest, ForcedWriterBecomesTheWriterOfANewKey) {
+    WriterAssignments assignments(4);
+    ASSERT_EQUALS(0U, assignments.assign(1));
+    ASSERT_EQUALS(2U, assignments.assign(2, 2U));
+    // Key 2 stays on the writer it was forced to, and new keys go to the least loaded writers.
+    ASSERT_EQUALS(2U, assignments.assign(2));
+    ASSERT_EQUALS(1U, assignments.assign(3));
+    ASSERT_EQUALS(3U, assignments.assign(4));
+    ASSERT_EQUALS(0U, assignments.assign(5));
+    // A key already assigned to a writer is still applied by the forced writer.
+    ASSERT_EQUALS(1U, assignments.assign(1, 1U));
+    ASSERT_EQUALS(0U, assignments.assign(1));
+}
+
+TEST(InsertGroupTest, FailedGroupIsRegroupedInSmallerGroups) {
+    const NamespaceString nss("test.t");
+    std::vector<OplogEntry> entries;
+    for (int i = 0; i < 100; ++i) {
+        entries.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i + 1), 1LL}, nss, BSON("_id" << i)));
+    }
+    std::vector<const OplogEntry*> ops;
+    for (const auto& entry : entries) {
+        ops.push_back(&entry);
+    }
+    const OplogEntry* badOp = ops[40];
+
+    // Any group containing 'badOp' fails, the way a group fails on a single duplicate key.
+    std::vector<int> timesApplied(ops.size(), 0);
+    std::vector<const OplogEntry*> loneInserts;
+    InsertGroup insertGroup(&ops,
+                            nullptr,
+                            OplogApplication::Mode::kSecondary,
+                            true,
+                            [&](OperationContext*,
+                                const OplogEntryOrGroupedInserts& groupedInserts,
+                                OplogApplication::Mode,
+                                bool) {
+                                const auto& group = groupedInserts.getGroupedInserts();
+                                if (std::find(group.begin(), group.end(), badOp) != group.end()) {
+                                    return Status(ErrorCodes::DuplicateKey, "bad op in group");
+                                }
+                                for (const auto* op : group) {
+                                    timesApplied[op - &entries.front()]++;
+                                }
+                                return Status::OK();
+                            });
+
+    // Same as the loop applying a writer vector: an op that could not be grouped is applied alone.
+    for (auto it = ops.cbegin(); it != ops.cend(); ++it) {
+        auto status = insertGroup.groupAndApplyInserts(it);
+        if (status.isOK()) {
+            it = status.getValue();
+            continue;
+        }
+        loneInserts.push_back(*it);
+        timesApplied[*it - &entries.front()]++;
+    }
+
+    for (size_t i = 0; i < ops.size(); ++i) {
+        ASSERT_EQUALS(1, timesApplied[i]) << i;
+    }
+    ASSERT(std::find(loneInserts.begin(), loneInserts.end(), badOp) != loneInserts.end());
+    // The ops around the bad op are still grouped instead of all being applied one by one.
+    ASSERT_LESS_THAN(loneInserts.size(), 10U);
+}
+
 class MultiOplogEntryOplogApplierImplTest : public OplogApplierImplTest {
 public:
     MultiOplogEntryOplogApplierImplTest()
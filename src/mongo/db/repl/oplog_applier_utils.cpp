@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/document_validation.h"
@@ -101,12 +103,30 @@ void OplogApplierUtils::processCrudOp(OperationContext* opCtx,
     }
 }
 
+uint32_t WriterAssignments::assign(uint32_t hash, boost::optional<uint32_t> forceWriterId) {
+    uint32_t writerId;
+    if (forceWriterId) {
+        writerId = *forceWriterId;
+        _writerByKey.emplace(hash, writerId);
+    } else if (auto it = _writerByKey.find(hash); it != _writerByKey.end()) {
+        writerId = it->second;
+    } else {
+        writerId = std::distance(
+            _numOpsPerWriter.begin(),
+            std::min_element(_numOpsPerWriter.begin(), _numOpsPerWriter.end()));
+        _writerByKey.emplace(hash, writerId);
+    }
+    ++_numOpsPerWriter[writerId];
+    return writerId;
+}
+
 uint32_t OplogApplierUtils::addToWriterVector(
     OperationContext* opCtx,
     OplogEntry* op,
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     CachedCollectionProperties* collPropertiesCache,
-    boost::optional<uint32_t> forceWriterId) {
+    boost::optional<uint32_t> forceWriterId,
+    WriterAssignments* writerAssignments) {
     auto hashedNs = StringMapHasher().hashed_key(op->getNss().ns());
 
     // Reduce the hash from 64bit down to 32bit, just to allow combinations with murmur3 later
@@ -118,7 +138,8 @@ uint32_t OplogApplierUtils::addToWriterVector(
         processCrudOp(opCtx, op, &hash, &hashedNs, collPropertiesCache);
 
     const uint32_t numWriters = writerVectors->size();
-    auto writerId = (forceWriterId ? *forceWriterId : hash) % numWriters;
+    auto writerId = writerAssignments ? writerAssignments->assign(hash, forceWriterId)
+                                      : (forceWriterId ? *forceWriterId : hash) % numWriters;
     auto& writer = (*writerVectors)[writerId];
     if (writer.empty()) {
         writer.reserve(8);  // Skip a few growth rounds
@@ -148,13 +169,14 @@ void OplogApplierUtils::addDerivedOps(OperationContext* opCtx,
                                       std::vector<OplogEntry>* derivedOps,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors,
                                       CachedCollectionProperties* collPropertiesCache,
-                                      bool serial) {
+                                      bool serial,
+                                      WriterAssignments* writerAssignments) {
     boost::optional<uint32_t>
         serialWriterId;  // Used to determine which writer vector to assign serial ops.
 
     for (auto&& op : *derivedOps) {
-        auto writerId =
-            addToWriterVector(opCtx, &op, writerVectors, collPropertiesCache, serialWriterId);
+        auto writerId = addToWriterVector(
+            opCtx, &op, writerVectors, collPropertiesCache, serialWriterId, writerAssignments);
         if (serial && !serialWriterId) {
             serialWriterId.emplace(writerId);
         }
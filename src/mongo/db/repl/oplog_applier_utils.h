@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/db/repl/insert_group.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 class CollatorInterface;
@@ -58,6 +61,33 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+/**
+ * Tracks which writer vector each conflict key of a batch has been assigned to. A conflict key is
+ * the hash computed for an op by OplogApplierUtils::addToWriterVector: the namespace and '_id' for
+ * CRUD ops on uncapped collections, and only the namespace otherwise. Ops sharing a key must be
+ * applied in order by the same writer, but a key seen for the first time in a batch can go to any
+ * writer, so it is given to the writer with the fewest ops assigned so far. This keeps hot keys and
+ * capped collections from piling up behind the same writer as unrelated ops, which shortens the
+ * time the other writers spend idle at the end-of-batch barrier.
+ *
+ * A single instance must be used for the whole batch and must not be shared between batches.
+ */
+class WriterAssignments {
+public:
+    explicit WriterAssignments(size_t numWriters) : _numOpsPerWriter(numWriters, 0) {}
+
+    /**
+     * Returns the writer that the op with conflict key 'hash' must be applied by, and accounts
+     * the op against that writer. If 'forceWriterId' is set the op is assigned to that writer, and
+     * it becomes the writer of 'hash' if the key has not been seen yet.
+     */
+    uint32_t assign(uint32_t hash, boost::optional<uint32_t> forceWriterId = boost::none);
+
+private:
+    stdx::unordered_map<uint32_t, uint32_t> _writerByKey;
+    std::vector<size_t> _numOpsPerWriter;
+};
+
 /**
  * This class contains some static methods common to ordinary oplog application and oplog
  * application as part of tenant migration.
@@ -85,13 +115,15 @@ public:
 
     /**
      * Adds a single oplog entry to the appropriate writer vector.  Returns the index of the
-     * writer vector the entry was written to.
+     * writer vector the entry was written to. If 'writerAssignments' is provided, the writer is
+     * chosen by it instead of by the hash modulo the number of writers.
      */
     static uint32_t addToWriterVector(OperationContext* opCtx,
                                       OplogEntry* op,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors,
                                       CachedCollectionProperties* collPropertiesCache,
-                                      boost::optional<uint32_t> forceWriterId = boost::none);
+                                      boost::optional<uint32_t> forceWriterId = boost::none,
+                                      WriterAssignments* writerAssignments = nullptr);
     /**
      * Adds a set of derivedOps to writerVectors.
      * If `serial` is true, assign all derived operations to the writer vector corresponding to the
@@ -101,7 +133,8 @@ public:
                               std::vector<OplogEntry>* derivedOps,
                               std::vector<std::vector<const OplogEntry*>>* writerVectors,
                               CachedCollectionProperties* collPropertiesCache,
-                              bool serial);
+                              bool serial,
+                              WriterAssignments* writerAssignments = nullptr);
 
     /**
      * Returns the namespace string for this oplogEntry; if it has a UUID it looks up the
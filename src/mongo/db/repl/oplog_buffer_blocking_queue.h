@@ -40,6 +40,9 @@ namespace repl {
  */
 class OplogBufferBlockingQueue final : public OplogBuffer {
 public:
+    // Limit buffer to 256MB
+    static constexpr std::size_t kMaxSize = 256 * 1024 * 1024;
+
     OplogBufferBlockingQueue();
     explicit OplogBufferBlockingQueue(Counters* counters);
 
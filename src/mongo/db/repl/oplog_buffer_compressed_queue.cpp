@@ -0,0 +1,249 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/repl/oplog_buffer_compressed_queue.h"
+
+#include <snappy.h>
+
+#include "mongo/bson/util/builder.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace repl {
+
+OplogBufferCompressedQueue::OplogBufferCompressedQueue(std::size_t maxSize, Counters* counters)
+    : _maxSize(maxSize), _counters(counters) {}
+
+void OplogBufferCompressedQueue::startup(OperationContext*) {
+    // Update server status metric to reflect the current oplog buffer's max size.
+    if (_counters) {
+        _counters->setMaxSize(getMaxSize());
+    }
+}
+
+void OplogBufferCompressedQueue::shutdown(OperationContext* opCtx) {
+    clear(opCtx);
+}
+
+void OplogBufferCompressedQueue::push(OperationContext*,
+                                      Batch::const_iterator begin,
+                                      Batch::const_iterator end) {
+    if (begin == end) {
+        return;
+    }
+
+    Segment segment;
+    for (auto it = begin; it != end; ++it) {
+        segment.size += static_cast<std::size_t>(it->objsize());
+    }
+    const std::size_t count = std::distance(begin, end);
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    invariant(!_drainMode);
+    if (_segments.empty()) {
+        segment.docs.assign(begin, end);
+    } else {
+        // Compress outside of the mutex, so that the consumer can keep popping meanwhile.
+        lk.unlock();
+        BufBuilder concatenated(segment.size);
+        for (auto it = begin; it != end; ++it) {
+            concatenated.appendBuf(it->objdata(), it->objsize());
+        }
+        segment.compressed =
+            SharedBuffer::allocate(snappy::MaxCompressedLength(concatenated.len()));
+        snappy::RawCompress(concatenated.buf(),
+                            concatenated.len(),
+                            segment.compressed.get(),
+                            &segment.compressedSize);
+        invariant(segment.compressedSize > 0);
+        lk.lock();
+    }
+
+    // Wait for room for the segment as it is held, like the blocking queue waits for its entries.
+    _notFullCv.wait(lk, [&] {
+        return _segments.empty() || _memorySize + segment.memorySize() <= _maxSize;
+    });
+
+    const bool wasEmpty = _segments.empty();
+    _lastObjectPushed = std::prev(end)->copy();
+    _memorySize += segment.memorySize();
+    _size += segment.size;
+    _count += count;
+    _segments.push_back(std::move(segment));
+    if (wasEmpty) {
+        _notEmptyCv.notify_one();
+    }
+    lk.unlock();
+
+    if (_counters) {
+        for (auto it = begin; it != end; ++it) {
+            _counters->increment(*it);
+        }
+    }
+}
+
+void OplogBufferCompressedQueue::waitForSpace(OperationContext*, std::size_t size) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _notFullCv.wait(lk, [&] { return _segments.empty() || _memorySize + size <= _maxSize; });
+}
+
+bool OplogBufferCompressedQueue::isEmpty() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _segments.empty();
+}
+
+std::size_t OplogBufferCompressedQueue::getMaxSize() const {
+    return _maxSize;
+}
+
+std::size_t OplogBufferCompressedQueue::getSize() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _size;
+}
+
+std::size_t OplogBufferCompressedQueue::getCount() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _count;
+}
+
+std::size_t OplogBufferCompressedQueue::getMemorySize() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _memorySize;
+}
+
+void OplogBufferCompressedQueue::clear(OperationContext*) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _segments.clear();
+    _memorySize = 0;
+    _size = 0;
+    _count = 0;
+    _lastObjectPushed = BSONObj();
+    _notFullCv.notify_all();
+    if (_counters) {
+        _counters->clear();
+    }
+}
+
+void OplogBufferCompressedQueue::_uncompressFront(WithLock) {
+    auto& segment = _segments.front();
+    if (!segment.isCompressed()) {
+        return;
+    }
+
+    std::size_t uncompressedSize;
+    invariant(snappy::GetUncompressedLength(
+        segment.compressed.get(), segment.compressedSize, &uncompressedSize));
+    invariant(uncompressedSize == segment.size);
+    auto buffer = SharedBuffer::allocate(uncompressedSize);
+    invariant(
+        snappy::RawUncompress(segment.compressed.get(), segment.compressedSize, buffer.get()));
+
+    for (std::size_t offset = 0; offset < uncompressedSize;) {
+        BSONObj doc(buffer.get() + offset);
+        offset += doc.objsize();
+        segment.docs.push_back(doc.shareOwnershipWith(buffer));
+    }
+
+    _memorySize -= segment.compressedSize;
+    segment.compressed = {};
+    segment.compressedSize = 0;
+    _memorySize += segment.size;
+}
+
+bool OplogBufferCompressedQueue::tryPop(OperationContext*, Value* value) {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_segments.empty()) {
+            return false;
+        }
+        _uncompressFront(lk);
+
+        auto& segment = _segments.front();
+        *value = std::move(segment.docs[segment.pos++]);
+        const auto size = static_cast<std::size_t>(value->objsize());
+        segment.size -= size;
+        _memorySize -= size;
+        _size -= size;
+        --_count;
+        if (segment.pos == segment.docs.size()) {
+            _segments.pop_front();
+        }
+        _notFullCv.notify_one();
+    }
+
+    if (_counters) {
+        _counters->decrement(*value);
+    }
+    return true;
+}
+
+bool OplogBufferCompressedQueue::waitForData(Seconds waitDuration) {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _notEmptyCv.wait_for(lk, waitDuration.toSystemDuration(), [&] {
+        return _drainMode || !_segments.empty();
+    });
+    return !_segments.empty();
+}
+
+bool OplogBufferCompressedQueue::peek(OperationContext*, Value* value) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_segments.empty()) {
+        return false;
+    }
+    _uncompressFront(lk);
+
+    const auto& segment = _segments.front();
+    *value = segment.docs[segment.pos];
+    return true;
+}
+
+boost::optional<OplogBuffer::Value> OplogBufferCompressedQueue::lastObjectPushed(
+    OperationContext*) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_segments.empty()) {
+        return boost::none;
+    }
+    return _lastObjectPushed;
+}
+
+void OplogBufferCompressedQueue::enterDrainMode() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drainMode = true;
+    _notEmptyCv.notify_one();
+}
+
+void OplogBufferCompressedQueue::exitDrainMode() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _drainMode = false;
+}
+
+}  // namespace repl
+}  // namespace mongo
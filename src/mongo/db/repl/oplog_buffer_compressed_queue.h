@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "mongo/db/repl/oplog_buffer.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/shared_buffer.h"
+
+namespace mongo {
+namespace repl {
+
+/**
+ * In-memory oplog buffer which keeps the batches it holds snappy-compressed while they wait to be
+ * applied, so that a lagging secondary can buffer more oplog history in the same amount of memory.
+ *
+ * Each call to push() becomes a segment. A segment pushed into an empty buffer is kept as the
+ * fetched documents themselves, which still share the buffer of the reply they were received in,
+ * since it is likely to be consumed right away. Segments pushed behind other ones are compressed,
+ * and are only decompressed once they reach the front of the buffer.
+ *
+ * The maximum size is enforced on the memory held by the segments, i.e. their compressed size,
+ * while getSize() reports the uncompressed size of the buffered entries like the other buffers.
+ */
+class OplogBufferCompressedQueue final : public OplogBuffer {
+public:
+    explicit OplogBufferCompressedQueue(std::size_t maxSize, Counters* counters = nullptr);
+
+    void startup(OperationContext* opCtx) override;
+    void shutdown(OperationContext* opCtx) override;
+    void push(OperationContext* opCtx,
+              Batch::const_iterator begin,
+              Batch::const_iterator end) override;
+    void waitForSpace(OperationContext* opCtx, std::size_t size) override;
+    bool isEmpty() const override;
+    std::size_t getMaxSize() const override;
+    std::size_t getSize() const override;
+    std::size_t getCount() const override;
+    void clear(OperationContext* opCtx) override;
+    bool tryPop(OperationContext* opCtx, Value* value) override;
+    bool waitForData(Seconds waitDuration) override;
+    bool peek(OperationContext* opCtx, Value* value) override;
+    boost::optional<Value> lastObjectPushed(OperationContext* opCtx) const override;
+
+    void enterDrainMode() final;
+    void exitDrainMode() final;
+
+    /**
+     * Returns the memory held by the buffered segments, which is what the maximum size limits.
+     */
+    std::size_t getMemorySize() const;
+
+private:
+    struct Segment {
+        // The concatenated entries of the segment, while it is compressed.
+        SharedBuffer compressed;
+        std::size_t compressedSize = 0;
+
+        // The entries of the segment once it is uncompressed, and the position of the next one to
+        // be popped.
+        std::vector<BSONObj> docs;
+        std::size_t pos = 0;
+
+        // The total BSONObj::objsize() of the entries of the segment that are not popped yet.
+        std::size_t size = 0;
+
+        bool isCompressed() const {
+            return compressedSize > 0;
+        }
+
+        std::size_t memorySize() const {
+            return isCompressed() ? compressedSize : size;
+        }
+    };
+
+    /**
+     * Decompresses the front segment if needed. The buffer must not be empty.
+     */
+    void _uncompressFront(WithLock);
+
+    const std::size_t _maxSize;
+    Counters* const _counters;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogBufferCompressedQueue::_mutex");
+    stdx::condition_variable _notEmptyCv;
+    stdx::condition_variable _notFullCv;
+
+    std::deque<Segment> _segments;
+    std::size_t _memorySize = 0;
+    std::size_t _size = 0;
+    std::size_t _count = 0;
+
+    // A standalone copy of the last pushed entry, so that it does not keep its whole compressed
+    // segment or reply buffer alive.
+    BSONObj _lastObjectPushed;
+
+    bool _drainMode = false;
+};
+
+}  // namespace repl
+}  // namespace mongo
@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/repl/oplog_buffer_compressed_queue.h"
+#include "mongo/unittest/unittest.h"
+
+namespace {
+
+using namespace mongo;
+using namespace mongo::repl;
+
+const std::size_t kMaxSize = 1024 * 1024;
+
+OplogBuffer::Batch makeBatch(int first, int count) {
+    OplogBuffer::Batch batch;
+    for (int i = first; i < first + count; ++i) {
+        batch.push_back(BSON("ts" << Timestamp(1, i) << "op"
+                                  << "n"
+                                  << "o" << BSON("msg" << std::string(100, 'x'))));
+    }
+    return batch;
+}
+
+void assertPopsInOrder(OplogBufferCompressedQueue* buffer, int first, int count) {
+    for (int i = first; i < first + count; ++i) {
+        OplogBuffer::Value peeked, popped;
+        ASSERT_TRUE(buffer->peek(nullptr, &peeked));
+        ASSERT_TRUE(buffer->tryPop(nullptr, &popped));
+        ASSERT_BSONOBJ_EQ(peeked, popped);
+        ASSERT_EQUALS(Timestamp(1, i), popped["ts"].timestamp());
+    }
+}
+
+TEST(OplogBufferCompressedQueueTest, PushIntoEmptyBufferIsNotCompressed) {
+    OplogBufferCompressedQueue buffer(kMaxSize);
+    auto batch = makeBatch(1, 10);
+    buffer.push(nullptr, batch.cbegin(), batch.cend());
+
+    ASSERT_EQUALS(10U, buffer.getCount());
+    ASSERT_EQUALS(buffer.getSize(), buffer.getMemorySize());
+    assertPopsInOrder(&buffer, 1, 10);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0U, buffer.getMemorySize());
+}
+
+TEST(OplogBufferCompressedQueueTest, BatchesBehindOthersAreCompressedUntilReachingTheFront) {
+    OplogBufferCompressedQueue buffer(kMaxSize);
+    for (int i = 0; i < 3; ++i) {
+        auto batch = makeBatch(1 + 10 * i, 10);
+        buffer.push(nullptr, batch.cbegin(), batch.cend());
+    }
+
+    ASSERT_EQUALS(30U, buffer.getCount());
+    ASSERT_LESS_THAN(buffer.getMemorySize(), buffer.getSize());
+    ASSERT_BSONOBJ_EQ(makeBatch(30, 1).front(), *buffer.lastObjectPushed(nullptr));
+
+    assertPopsInOrder(&buffer, 1, 30);
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getSize());
+    ASSERT_EQUALS(0U, buffer.getMemorySize());
+    ASSERT_FALSE(buffer.lastObjectPushed(nullptr));
+}
+
+TEST(OplogBufferCompressedQueueTest, PoppedEntriesOutliveTheirSegment) {
+    OplogBufferCompressedQueue buffer(kMaxSize);
+    auto first = makeBatch(1, 1);
+    auto second = makeBatch(2, 2);
+    buffer.push(nullptr, first.cbegin(), first.cend());
+    buffer.push(nullptr, second.cbegin(), second.cend());
+
+    std::vector<OplogBuffer::Value> popped(3);
+    for (auto& value : popped) {
+        ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+    }
+    buffer.clear(nullptr);
+
+    ASSERT_BSONOBJ_EQ(first[0], popped[0]);
+    ASSERT_BSONOBJ_EQ(second[0], popped[1]);
+    ASSERT_BSONOBJ_EQ(second[1], popped[2]);
+}
+
+TEST(OplogBufferCompressedQueueTest, ClearEmptiesTheBuffer) {
+    OplogBufferCompressedQueue buffer(kMaxSize);
+    for (int i = 0; i < 2; ++i) {
+        auto batch = makeBatch(1 + 10 * i, 10);
+        buffer.push(nullptr, batch.cbegin(), batch.cend());
+    }
+    buffer.clear(nullptr);
+
+    OplogBuffer::Value value;
+    ASSERT_TRUE(buffer.isEmpty());
+    ASSERT_EQUALS(0U, buffer.getCount());
+    ASSERT_EQUALS(0U, buffer.getMemorySize());
+    ASSERT_FALSE(buffer.peek(nullptr, &value));
+    ASSERT_FALSE(buffer.tryPop(nullptr, &value));
+    ASSERT_FALSE(buffer.waitForData(Seconds(0)));
+}
+
+TEST(OplogBufferCompressedQueueTest, WaitForDataReturnsImmediatelyInDrainMode) {
+    OplogBufferCompressedQueue buffer(kMaxSize);
+    buffer.enterDrainMode();
+    ASSERT_FALSE(buffer.waitForData(Seconds(60)));
+    buffer.exitDrainMode();
+
+    auto batch = makeBatch(1, 1);
+    buffer.push(nullptr, batch.cbegin(), batch.cend());
+    ASSERT_TRUE(buffer.waitForData(Seconds(60)));
+}
+
+TEST(OplogBufferCompressedQueueTest, CountersTrackUncompressedSize) {
+    OplogBuffer::Counters counters;
+    OplogBufferCompressedQueue buffer(kMaxSize, &counters);
+    buffer.startup(nullptr);
+    ASSERT_EQUALS(kMaxSize, counters.maxSize.get());
+
+    for (int i = 0; i < 2; ++i) {
+        auto batch = makeBatch(1 + 10 * i, 10);
+        buffer.push(nullptr, batch.cbegin(), batch.cend());
+    }
+    ASSERT_EQUALS(20U, counters.count.get());
+    ASSERT_EQUALS(buffer.getSize(), counters.size.get());
+
+    OplogBuffer::Value value;
+    ASSERT_TRUE(buffer.tryPop(nullptr, &value));
+    ASSERT_EQUALS(19U, counters.count.get());
+    ASSERT_EQUALS(buffer.getSize(), counters.size.get());
+
+    buffer.shutdown(nullptr);
+    ASSERT_EQUALS(0U, counters.count.get());
+    ASSERT_EQUALS(0U, counters.size.get());
+}
+
+}  // namespace
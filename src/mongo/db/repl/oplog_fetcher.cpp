@@ -896,6 +896,13 @@ Status OplogFetcher::_onSuccessfulBatch(const Documents& documents) {
 
     oplogBatchStats.recordMillis(_lastBatchElapsedMS, documents.empty());
 
+    // Only batches that the sync source could serve without waiting for new writes say how fast it
+    // serves oplog. When we are caught up, the elapsed time is spent in the awaitData wait.
+    if (info.networkDocumentBytes > 0 && oqMetadata.getLastOpApplied() > lastDocOpTime) {
+        _dataReplicatorExternalState->recordFetchStats(
+            _config.source, info.networkDocumentBytes, Milliseconds(_lastBatchElapsedMS));
+    }
+
     if (_cursor->getPostBatchResumeToken()) {
         auto pbrt = ResumeTokenOplogTimestamp::parse(
             IDLParserErrorContext("OplogFetcher PostBatchResumeToken"),
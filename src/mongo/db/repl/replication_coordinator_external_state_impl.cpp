@@ -70,6 +70,7 @@
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier_impl.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_buffer_compressed_queue.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/repl_settings.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -219,10 +220,15 @@ void ReplicationCoordinatorExternalStateImpl::startSteadyStateReplication(
         return;
 
     invariant(replCoord);
-    _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+    if (bgSyncOplogBufferCompression) {
+        _oplogBuffer = std::make_unique<OplogBufferCompressedQueue>(
+            OplogBufferBlockingQueue::kMaxSize, &bufferGauge);
+    } else {
+        _oplogBuffer = std::make_unique<OplogBufferBlockingQueue>(&bufferGauge);
+    }
 
-    // No need to log OplogBuffer::startup because the blocking queue implementation
-    // does not start any threads or access the storage layer.
+    // No need to log OplogBuffer::startup because the in-memory implementations do not start any
+    // threads or access the storage layer.
     _oplogBuffer->startup(opCtx);
 
     invariant(!_oplogApplier);
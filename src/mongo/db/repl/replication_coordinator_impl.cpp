@@ -69,6 +69,7 @@
 #include "mongo/db/repl/check_quorum_for_config_change.h"
 #include "mongo/db/repl/data_replicator_external_state_initial_sync.h"
 #include "mongo/db/repl/hello_response.h"
+#include "mongo/db/repl/initial_sync_method.h"
 #include "mongo/db/repl/initial_syncer_factory.h"
 #include "mongo/db/repl/isself.h"
 #include "mongo/db/repl/last_vote.h"
@@ -207,22 +208,42 @@ constexpr StringData kQuiesceModeShutdownMessage =
 
 }  // namespace
 
+ReplicationCoordinatorImpl::WaiterList::WriteConcernKey
+ReplicationCoordinatorImpl::WaiterList::_makeKey(const boost::optional<WriteConcernOptions>& wc) {
+    if (!wc) {
+        return {};
+    }
+    return {wc->wNumNodes,
+            wc->wMode,
+            static_cast<int>(wc->syncMode),
+            static_cast<int>(wc->checkCondition)};
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
                                                         SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
+    auto& waiters = _waiters[_makeKey(waiter->writeConcern)];
+    waiters.emplace(opTime, std::move(waiter));
 }
 
 SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
     const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
     auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
+    add_inlock(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
     return std::move(pf.future);
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
-    for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
+    auto group = _waiters.find(_makeKey(waiter->writeConcern));
+    if (group == _waiters.end()) {
+        return false;
+    }
+    auto& waiters = group->second;
+    for (auto iter = waiters.begin(); iter != waiters.end(); iter++) {
         if (iter->second == waiter) {
-            _waiters.erase(iter);
+            waiters.erase(iter);
+            if (waiters.empty()) {
+                _waiters.erase(group);
+            }
             return true;
         }
     }
@@ -230,35 +251,62 @@ bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle wa
 }
 
 template <typename Func>
-void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
-                                                               boost::optional<OpTime> opTime) {
-    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
+void ReplicationCoordinatorImpl::WaiterList::_setValueIf(
+    std::multimap<OpTime, SharedWaiterHandle>& waiters,
+    Func&& func,
+    boost::optional<OpTime> opTime,
+    bool monotonic) {
+    for (auto it = waiters.begin(); it != waiters.end() && (!opTime || it->first <= *opTime);) {
         const auto& waiter = it->second;
         try {
             if (func(it->first, waiter)) {
                 waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
+                it = waiters.erase(it);
+            } else if (monotonic) {
+                break;
             } else {
                 ++it;
             }
         } catch (const DBException& e) {
             waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
+            it = waiters.erase(it);
         }
     }
 }
 
+template <typename Func>
+void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
+                                                               boost::optional<OpTime> opTime) {
+    for (auto group = _waiters.begin(); group != _waiters.end();) {
+        _setValueIf(group->second, func, opTime, false /* monotonic */);
+        group = group->second.empty() ? _waiters.erase(group) : std::next(group);
+    }
+}
+
+template <typename Func>
+void ReplicationCoordinatorImpl::WaiterList::setValueIfMonotonic_inlock(
+    Func&& func, boost::optional<OpTime> opTime) {
+    for (auto group = _waiters.begin(); group != _waiters.end();) {
+        _setValueIf(group->second, func, opTime, true /* monotonic */);
+        group = group->second.empty() ? _waiters.erase(group) : std::next(group);
+    }
+}
+
 void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.emplaceValue();
+    for (auto& [key, waiters] : _waiters) {
+        for (auto& [opTime, waiter] : waiters) {
+            waiter->promise.emplaceValue();
+        }
     }
     _waiters.clear();
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
     invariant(!status.isOK());
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.setError(status);
+    for (auto& [key, waiters] : _waiters) {
+        for (auto& [opTime, waiter] : waiters) {
+            waiter->promise.setError(status);
+        }
     }
     _waiters.clear();
 }
@@ -802,17 +850,17 @@ void ReplicationCoordinatorImpl::_startDataReplication(OperationContext* opCtx,
             if (repl::feature_flags::gFileCopyBasedInitialSync.isEnabledAndIgnoreFCV()) {
                 auto swInitialSyncer = createInitialSyncer(initialSyncMethod);
                 if (swInitialSyncer.getStatus().code() == ErrorCodes::NotImplemented &&
-                    initialSyncMethod != "logical") {
+                    initialSyncMethod != kLogicalInitialSyncMethod) {
                     LOGV2_WARNING(58154,
                                   "No such initial sync method was available. Falling back to "
                                   "logical initial sync.",
                                   "initialSyncMethod"_attr = initialSyncMethod,
                                   "error"_attr = swInitialSyncer.getStatus().reason());
-                    swInitialSyncer = createInitialSyncer(std::string("logical"));
+                    swInitialSyncer = createInitialSyncer(kLogicalInitialSyncMethod.toString());
                 }
                 initialSyncerCopy = uassertStatusOK(swInitialSyncer);
             } else {
-                auto swInitialSyncer = createInitialSyncer(std::string("logical"));
+                auto swInitialSyncer = createInitialSyncer(kLogicalInitialSyncMethod.toString());
                 initialSyncerCopy = uassertStatusOK(swInitialSyncer);
             }
             _initialSyncer = initialSyncerCopy;
@@ -1016,8 +1064,7 @@ ReplicationCoordinator::Mode ReplicationCoordinatorImpl::getReplicationMode() co
 }
 
 MemberState ReplicationCoordinatorImpl::getMemberState() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-    return _getMemberState_inlock();
+    return MemberState(_memberStateShadow.load());
 }
 
 std::vector<MemberData> ReplicationCoordinatorImpl::getMemberData() const {
@@ -1386,7 +1433,7 @@ void ReplicationCoordinatorImpl::_setMyLastAppliedOpTimeAndWallTime(
     _externalState->updateLastAppliedSnapshot(opTime);
 
     // Signal anyone waiting on optime changes.
-    _opTimeWaiterList.setValueIf_inlock(
+    _opTimeWaiterList.setValueIfMonotonic_inlock(
         [opTime](const OpTime& waitOpTime, const SharedWaiterHandle& waiter) {
             return waitOpTime <= opTime;
         },
@@ -4258,6 +4305,7 @@ ReplicationCoordinatorImpl::_updateMemberStateFromTopologyCoordinator(WithLock l
           "newState"_attr = newState,
           "oldState"_attr = _memberState);
     _memberState = newState;
+    _memberStateShadow.store(newState.s);
 
     _cancelAndRescheduleElectionTimeout_inlock();
 
@@ -4725,7 +4773,10 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
-    _replicationWaiterList.setValueIf_inlock(
+    // Whether a write concern is satisfied only depends on how far the nodes have replicated, so
+    // once a waiter is not yet satisfied, neither are the later waiters with the same write
+    // concern.
+    _replicationWaiterList.setValueIfMonotonic_inlock(
         [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
             return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
@@ -4914,6 +4965,13 @@ void ReplicationCoordinatorImpl::denylistSyncSource(const HostAndPort& host, Dat
     });
 }
 
+void ReplicationCoordinatorImpl::recordSyncSourceFetchStats(const HostAndPort& host,
+                                                            std::size_t bytes,
+                                                            Milliseconds elapsed) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _topCoord->recordSyncSourceFetchStats(host, bytes, elapsed, _replExecutor->now());
+}
+
 void ReplicationCoordinatorImpl::resetLastOpTimesFromOplog(OperationContext* opCtx) {
     auto lastOpTimeAndWallTimeStatus = _externalState->loadLastOpTimeAndWallTime(opCtx);
     OpTimeAndWallTime lastOpTimeAndWallTime = {OpTime(), Date_t()};
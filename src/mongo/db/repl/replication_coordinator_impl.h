@@ -31,6 +31,8 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -311,6 +313,10 @@ public:
 
     virtual void denylistSyncSource(const HostAndPort& host, Date_t until) override;
 
+    virtual void recordSyncSourceFetchStats(const HostAndPort& host,
+                                            std::size_t bytes,
+                                            Milliseconds elapsed) override;
+
     virtual void resetLastOpTimesFromOplog(OperationContext* opCtx) override;
 
     virtual ChangeSyncSourceAction shouldChangeSyncSource(const HostAndPort& currentSource,
@@ -698,14 +704,34 @@ private:
         // condition in func.
         template <typename Func>
         void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+        // Like setValueIf_inlock(), but func must be monotonic in the opTime of waiters with the
+        // same write concern: if it is not satisfied for a waiter, it is not satisfied for any
+        // later waiter with the same write concern either. This allows stopping at the first
+        // unsatisfied waiter of each write concern instead of visiting every waiter.
+        template <typename Func>
+        void setValueIfMonotonic_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
         // Signals all waiters from the list and fulfills promises with OK status.
         void setValueAll_inlock();
         // Signals all waiters from the list and fulfills promises with Error status.
         void setErrorAll_inlock(Status status);
 
     private:
-        // Waiters sorted by OpTime.
-        std::multimap<OpTime, SharedWaiterHandle> _waiters;
+        // Identifies the write concerns that are satisfied by the same set of nodes, which is all
+        // of a write concern except for its timeout. Waiters without a write concern share the
+        // default key.
+        using WriteConcernKey = std::tuple<int, std::string, int, int>;
+        static WriteConcernKey _makeKey(const boost::optional<WriteConcernOptions>& wc);
+
+        // Signals the waiters of 'waiters' whose opTime is <= the given opTime (if any) that
+        // satisfy the condition in func, stopping at the first unsatisfied one if 'monotonic'.
+        template <typename Func>
+        static void _setValueIf(std::multimap<OpTime, SharedWaiterHandle>& waiters,
+                                Func&& func,
+                                boost::optional<OpTime> opTime,
+                                bool monotonic);
+
+        // Waiters grouped by write concern, each group sorted by OpTime. Empty groups are removed.
+        std::map<WriteConcernKey, std::multimap<OpTime, SharedWaiterHandle>> _waiters;
     };
 
     enum class HeartbeatState { kScheduled = 0, kSent = 1 };
@@ -776,6 +802,10 @@ private:
          *      _writeLastVoteForMyElection()
          *      _requestVotesForRealElection()
          *      _onVoteRequestComplete()
+         *
+         * With pipelineElectionVoteRequests, _startRealElection() requests the votes itself and
+         * the last vote write proceeds alongside them; whichever of the two finishes last calls
+         * _finishRealElection().
          */
         void start(WithLock lk, StartElectionReasonEnum reason);
 
@@ -843,12 +873,27 @@ private:
          */
         void _onVoteRequestComplete(long long originalTerm, StartElectionReasonEnum reason);
 
+        /**
+         * Decides the outcome of the real election once the VoteRequester has completed and, if
+         * the vote requests were pipelined, the last vote write has finished.
+         */
+        void _finishRealElection(WithLock lk,
+                                 long long originalTerm,
+                                 StartElectionReasonEnum reason);
+
         // Not owned.
         ReplicationCoordinatorImpl* _repl;
         // The VoteRequester used to start and gather results from the election voting process.
         std::unique_ptr<VoteRequester> _voteRequester;
         // Flag that indicates whether the election has been canceled.
         bool _isCanceled = false;
+        // Set when the real election's votes were requested before this node's vote for itself
+        // was durable.
+        bool _voteRequestsPipelined = false;
+        // Set when the pipelined vote requests complete before the last vote write does.
+        bool _voteRequestsComplete = false;
+        // Result of the last vote write, once it has finished. Only set for pipelined elections.
+        boost::optional<Status> _lastVoteWriteStatus;
         // Event that the election code will signal when the in-progress election completes.
         executor::TaskExecutor::EventHandle _electionFinishedEvent;
 
@@ -1068,6 +1113,19 @@ private:
      */
     Milliseconds _getRandomizedElectionOffset_inlock();
 
+    /**
+     * Records a successful heartbeat response from the primary at "now", updating the statistics
+     * of the spacing between such responses.
+     */
+    void _recordPrimaryHeartbeat_inlock(Date_t now);
+
+    /**
+     * Returns how long to wait without hearing from the primary before calling an election. This
+     * is the config's election timeout unless adaptiveElectionTimeoutFloorMillis is set, in which
+     * case it is derived from the observed spacing of heartbeat responses from the primary.
+     */
+    Milliseconds _getElectionTimeoutPeriod_inlock() const;
+
     /**
      * Starts a heartbeat for each member in the current config.  Called while holding _mutex.
      */
@@ -1593,6 +1651,12 @@ private:
     // Current ReplicaSet state.
     MemberState _memberState;  // (M)
 
+    // Atomic-synchronized copy of _memberState, for use by the public getMemberState() function,
+    // which command dispatch calls on every read on a secondary.
+    // This variable must be written immediately after _memberState, and thus its value can lag.
+    // Reading this value does not require the replication coordinator mutex to be locked.
+    AtomicWord<int> _memberStateShadow{MemberState::RS_STARTUP};  // (S)
+
     // Used to signal threads waiting for changes to _memberState.
     stdx::condition_variable _drainFinishedCond;  // (M)
 
@@ -1650,6 +1714,18 @@ private:
     // Used for testing only.
     Date_t _handleElectionTimeoutWhen;  // (M)
 
+    // When this node last received a successful heartbeat response from the primary, and the term
+    // of that primary. Date_t() if it has not heard from a primary.
+    Date_t _lastPrimaryHeartbeatDate;                                  // (M)
+    long long _lastPrimaryHeartbeatTerm = OpTime::kUninitializedTerm;  // (M)
+
+    // Exponentially weighted mean and variance of the spacing between successful heartbeat
+    // responses from the primary of _lastPrimaryHeartbeatTerm, and the number of samples taken
+    // (which stops counting once there are enough to derive a timeout from).
+    double _primaryHeartbeatIntervalMeanMillis = 0;      // (M)
+    double _primaryHeartbeatIntervalVarianceMillis = 0;  // (M)
+    int _numPrimaryHeartbeatIntervals = 0;               // (M)
+
     // Callback Handle used to cancel a scheduled PriorityTakeover callback.
     executor::TaskExecutor::CallbackHandle _priorityTakeoverCbh;  // (M)
 
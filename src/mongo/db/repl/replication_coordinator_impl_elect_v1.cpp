@@ -33,6 +33,7 @@
 
 #include <memory>
 
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator_impl.h"
 #include "mongo/db/repl/replication_metrics.h"
 #include "mongo/db/repl/topology_coordinator.h"
@@ -280,6 +281,13 @@ void ReplicationCoordinatorImpl::ElectionState::_startRealElection(WithLock lk,
     const boost::optional<int> priorPrimaryMemberId = (priorPrimaryIndex == -1)
         ? boost::none
         : boost::make_optional(rsConfig.getMemberAt(priorPrimaryIndex).getId().getData());
+    // Only an election timeout means the prior primary became unreachable, so only those elections
+    // measure how long the set went without a primary.
+    const boost::optional<Date_t> lastPrimaryContactDate =
+        (reason == StartElectionReasonEnum::kElectionTimeout &&
+         _repl->_lastPrimaryHeartbeatDate != Date_t())
+        ? boost::make_optional(_repl->_lastPrimaryHeartbeatDate)
+        : boost::none;
 
     ReplicationMetrics::get(_repl->getServiceContext())
         .setElectionCandidateMetrics(reason,
@@ -290,7 +298,8 @@ void ReplicationCoordinatorImpl::ElectionState::_startRealElection(WithLock lk,
                                      numVotesNeeded,
                                      priorityAtElection,
                                      electionTimeoutMillis,
-                                     priorPrimaryMemberId);
+                                     priorPrimaryMemberId,
+                                     lastPrimaryContactDate);
     ReplicationMetrics::get(_repl->getServiceContext())
         .incrementNumElectionsCalledForReason(reason);
 
@@ -317,6 +326,14 @@ void ReplicationCoordinatorImpl::ElectionState::_startRealElection(WithLock lk,
         return;
     }
     fassert(34421, cbStatus.getStatus());
+
+    if (pipelineElectionVoteRequests.load()) {
+        // Voters can only grant us their vote in the new term, in which we have already voted for
+        // ourself, so the requests need not wait for that vote to be durable. We still do not
+        // become primary until it is.
+        _voteRequestsPipelined = true;
+        _requestVotesForRealElection(lk, newTerm, reason);
+    }
     lossGuard.dismiss();
 }
 
@@ -343,6 +360,24 @@ void ReplicationCoordinatorImpl::ElectionState::_writeLastVoteForMyElection(
         hangInWritingLastVoteForDryRun.pauseWhileSet();
     }
     stdx::lock_guard<Latch> lk(_repl->_mutex);
+    if (_voteRequestsPipelined) {
+        // The vote requests are already outstanding, so the election is decided once both they
+        // and this write have finished. A failed write cancels the requests and loses then.
+        if (!status.isOK() && status != ErrorCodes::CallbackCanceled) {
+            LOGV2(6170453,
+                  "Failed to store LastVote document when voting for myself",
+                  "error"_attr = status);
+        }
+        _lastVoteWriteStatus = status;
+        _replExecutor->signalEvent(_electionDryRunFinishedEvent);
+        if (_voteRequestsComplete) {
+            _finishRealElection(lk, lastVote.getTerm(), reason);
+        } else if (!status.isOK()) {
+            _voteRequester->cancel();
+        }
+        return;
+    }
+
     LoseElectionDryRunGuardV1 lossGuard(_repl);
     if (status == ErrorCodes::CallbackCanceled) {
         return;
@@ -380,6 +415,8 @@ void ReplicationCoordinatorImpl::ElectionState::_requestVotesForRealElection(
     StatusWith<executor::TaskExecutor::EventHandle> nextPhaseEvh =
         _startVoteRequester(lk, newTerm, false, lastAppliedOpTime, -1);
     if (nextPhaseEvh.getStatus() == ErrorCodes::ShutdownInProgress) {
+        // Nothing is outstanding, so let the last vote write end the election on its own.
+        _voteRequestsPipelined = false;
         return;
     }
     fassert(28643, nextPhaseEvh.getStatus());
@@ -396,9 +433,26 @@ MONGO_FAIL_POINT_DEFINE(electionHangsBeforeUpdateMemberState);
 void ReplicationCoordinatorImpl::ElectionState::_onVoteRequestComplete(
     long long newTerm, StartElectionReasonEnum reason) {
     stdx::lock_guard<Latch> lk(_repl->_mutex);
+    if (_voteRequestsPipelined && !_lastVoteWriteStatus) {
+        // _writeLastVoteForMyElection() finishes the election once our vote is durable.
+        _voteRequestsComplete = true;
+        return;
+    }
+    _finishRealElection(lk, newTerm, reason);
+}
+
+void ReplicationCoordinatorImpl::ElectionState::_finishRealElection(
+    WithLock lk, long long newTerm, StartElectionReasonEnum reason) {
     LoseElectionGuardV1 lossGuard(_repl);
     invariant(_voteRequester != nullptr);
 
+    if (_lastVoteWriteStatus && !_lastVoteWriteStatus->isOK()) {
+        LOGV2(6170454,
+              "Not becoming primary, we could not store our vote for ourself",
+              "error"_attr = *_lastVoteWriteStatus);
+        return;
+    }
+
     if (_topCoord->getTerm() != newTerm) {
         LOGV2(21447,
               "not becoming primary, we have been superseded already during election. election "
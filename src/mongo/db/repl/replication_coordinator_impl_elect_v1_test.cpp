@@ -46,6 +46,7 @@
 #include "mongo/db/repl/vote_requester.h"
 #include "mongo/executor/mock_network_fixture.h"
 #include "mongo/executor/network_interface_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/log_test.h"
@@ -2451,6 +2452,70 @@ TEST_F(ReplCoordTest, NodeCancelsElectionWhenWritingLastVoteInDryRun) {
     ASSERT(TopologyCoordinator::Role::kFollower == getTopoCoord().getRole());
 }
 
+TEST_F(ReplCoordTest, PipelinedElectionRequestsVotesBeforeLastVoteIsDurable) {
+    RAIIServerParameterControllerForTest pipelineController{"pipelineElectionVoteRequests", true};
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "protocolVersion" << 1 << "members"
+                            << BSON_ARRAY(BSON("_id" << 1 << "host"
+                                                     << "node1:12345")
+                                          << BSON("_id" << 3 << "host"
+                                                        << "node3:12345")
+                                          << BSON("_id" << 2 << "host"
+                                                        << "node2:12345"))
+                            << "settings" << BSON("heartbeatIntervalMillis" << 100)),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTime(Timestamp(100, 1), 0), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTime(Timestamp(100, 1), 0), Date_t() + Seconds(100));
+    simulateEnoughHeartbeatsForAllNodesUp();
+
+    // Hold the last vote write so that we can observe what happens before it is durable.
+    const auto hangInWritingLastVoteForDryRun =
+        globalFailPointRegistry().find("hangInWritingLastVoteForDryRun");
+    const auto timesEnteredFailPoint = hangInWritingLastVoteForDryRun->setMode(FailPoint::alwaysOn);
+    stdx::thread electionThread([&] { simulateSuccessfulDryRun(); });
+    hangInWritingLastVoteForDryRun->waitForTimesEntered(timesEnteredFailPoint + 1);
+
+    // The real election's vote requests are already out. Grant all of them.
+    int realVoteRequests = 0;
+    NetworkInterfaceMock* net = getNet();
+    net->enterNetwork();
+    while (net->hasReadyRequests()) {
+        const NetworkInterfaceMock::NetworkOperationIterator noi = net->getNextReadyRequest();
+        const RemoteCommandRequest& request = noi->getRequest();
+        if (request.cmdObj.firstElement().fieldNameStringData() != "replSetRequestVotes") {
+            net->blackHole(noi);
+        } else {
+            ASSERT_FALSE(request.cmdObj.getBoolField("dryRun"));
+            ASSERT_EQUALS(1, request.cmdObj["term"].Long());
+            ++realVoteRequests;
+            net->scheduleResponse(
+                noi,
+                net->now(),
+                makeResponseStatus(BSON("ok" << 1 << "term" << 1 << "voteGranted" << true
+                                             << "reason"
+                                             << "")));
+        }
+        net->runReadyNetworkOperations();
+    }
+    net->exitNetwork();
+    ASSERT_EQUALS(2, realVoteRequests);
+
+    // Having the votes is not enough to become primary while our own vote is not durable.
+    ASSERT(TopologyCoordinator::Role::kCandidate == getTopoCoord().getRole());
+
+    hangInWritingLastVoteForDryRun->setMode(FailPoint::off, 0);
+    electionThread.join();
+    getReplCoord()->waitForElectionFinish_forTest();
+
+    auto lastVote = getExternalState()->loadLocalLastVoteDocument(nullptr);
+    ASSERT_OK(lastVote.getStatus());
+    ASSERT_EQ(1, lastVote.getValue().getTerm());
+    ASSERT(getReplCoord()->getMemberState().primary())
+        << getReplCoord()->getMemberState().toString();
+}
+
 TEST_F(ReplCoordTest, MemberHbDataIsRestartedUponWinningElection) {
     auto replAllSeverityGuard = unittest::MinimumLoggedSeverityGuard{
         logv2::LogComponent::kReplication, logv2::LogSeverity::Debug(3)};
@@ -38,6 +38,7 @@
 #include "mongo/platform/basic.h"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 
 #include "mongo/base/status.h"
@@ -77,6 +78,20 @@ MONGO_FAIL_POINT_DEFINE(blockHeartbeatReconfigFinish);
 MONGO_FAIL_POINT_DEFINE(hangAfterTrackingNewHandleInHandleHeartbeatResponseForTest);
 MONGO_FAIL_POINT_DEFINE(waitForPostActionCompleteInHbReconfig);
 
+// Weight given to each new sample of the spacing between heartbeat responses from the primary.
+constexpr double kPrimaryHeartbeatIntervalWeight = 0.1;
+
+// Adaptive election timeouts are only used once this many intervals have been observed.
+constexpr int kMinPrimaryHeartbeatIntervals = 10;
+
+// The primary is timed out once a heartbeat response is this many standard deviations later than
+// the mean spacing, which corresponds to a phi-accrual suspicion level of about 8.
+constexpr double kPrimaryHeartbeatDeviations = 5.6;
+
+// Lower bound on the standard deviation, as a fraction of the mean, so that perfectly regular
+// heartbeats do not produce a timeout equal to the heartbeat interval itself.
+constexpr double kMinPrimaryHeartbeatDeviationFraction = 0.1;
+
 }  // namespace
 
 using executor::RemoteCommandRequest;
@@ -94,6 +109,46 @@ Milliseconds ReplicationCoordinatorImpl::_getRandomizedElectionOffset_inlock() {
     return Milliseconds{_nextRandomInt64_inlock(randomOffsetUpperBound)};
 }
 
+void ReplicationCoordinatorImpl::_recordPrimaryHeartbeat_inlock(Date_t now) {
+    const long long term = _topCoord->getTerm();
+    if (term != _lastPrimaryHeartbeatTerm) {
+        // Heartbeats from a previous primary say nothing about how regularly this one responds.
+        _lastPrimaryHeartbeatTerm = term;
+        _numPrimaryHeartbeatIntervals = 0;
+    } else if (_lastPrimaryHeartbeatDate != Date_t()) {
+        const double interval = durationCount<Milliseconds>(now - _lastPrimaryHeartbeatDate);
+        if (_numPrimaryHeartbeatIntervals == 0) {
+            _primaryHeartbeatIntervalMeanMillis = interval;
+            _primaryHeartbeatIntervalVarianceMillis = 0;
+        } else {
+            const double delta = interval - _primaryHeartbeatIntervalMeanMillis;
+            _primaryHeartbeatIntervalMeanMillis += kPrimaryHeartbeatIntervalWeight * delta;
+            _primaryHeartbeatIntervalVarianceMillis = (1 - kPrimaryHeartbeatIntervalWeight) *
+                (_primaryHeartbeatIntervalVarianceMillis +
+                 kPrimaryHeartbeatIntervalWeight * delta * delta);
+        }
+        _numPrimaryHeartbeatIntervals =
+            std::min(_numPrimaryHeartbeatIntervals + 1, kMinPrimaryHeartbeatIntervals);
+    }
+    _lastPrimaryHeartbeatDate = now;
+}
+
+Milliseconds ReplicationCoordinatorImpl::_getElectionTimeoutPeriod_inlock() const {
+    const Milliseconds configured = _rsConfig.getElectionTimeoutPeriod();
+    const Milliseconds floor{adaptiveElectionTimeoutFloorMillis.load()};
+    if (floor == Milliseconds(0) || _numPrimaryHeartbeatIntervals < kMinPrimaryHeartbeatIntervals ||
+        _lastPrimaryHeartbeatTerm != _topCoord->getTerm()) {
+        return configured;
+    }
+
+    const double deviation =
+        std::max(std::sqrt(_primaryHeartbeatIntervalVarianceMillis),
+                 kMinPrimaryHeartbeatDeviationFraction * _primaryHeartbeatIntervalMeanMillis);
+    const Milliseconds adaptive{static_cast<long long>(
+        _primaryHeartbeatIntervalMeanMillis + kPrimaryHeartbeatDeviations * deviation)};
+    return std::min(configured, std::max(floor, adaptive));
+}
+
 void ReplicationCoordinatorImpl::_doMemberHeartbeat(executor::TaskExecutor::CallbackArgs cbData,
                                                     const HostAndPort& target) {
     stdx::lock_guard<Latch> lk(_mutex);
@@ -284,6 +339,7 @@ void ReplicationCoordinatorImpl::_handleHeartbeatResponse(
             hbResponse.getTerm() == _topCoord->getTerm()) {
             LOGV2_FOR_ELECTION(
                 4615659, 4, "Postponing election timeout due to heartbeat from primary");
+            _recordPrimaryHeartbeat_inlock(now);
             _cancelAndRescheduleElectionTimeout_inlock();
         }
     } else {
@@ -1098,7 +1154,7 @@ void ReplicationCoordinatorImpl::_cancelAndRescheduleElectionTimeout_inlock() {
         return;
 
     Milliseconds randomOffset = _getRandomizedElectionOffset_inlock();
-    auto when = now + _rsConfig.getElectionTimeoutPeriod() + randomOffset;
+    auto when = now + _getElectionTimeoutPeriod_inlock() + randomOffset;
     invariant(when > now);
     if (wasActive) {
         // The log level here is 4 once per second, otherwise 5.
@@ -999,6 +999,133 @@ TEST_F(
     ASSERT_EQUALS(ErrorCodes::WriteConcernFailed, statusAndDur.status);
 }
 
+TEST_F(ReplCoordTest, ReplicationWaitersWithMixedWriteConcernsAreWokenWhenSatisfied) {
+    assertStartSuccess(
+        BSON("_id"
+             << "mySet"
+             << "version" << 2 << "members"
+             << BSON_ARRAY(BSON("_id" << 0 << "host"
+                                      << "node0"
+                                      << "tags"
+                                      << BSON("dc"
+                                              << "NA"
+                                              << "rack"
+                                              << "rackNA1"))
+                           << BSON("_id" << 1 << "host"
+                                         << "node1"
+                                         << "tags"
+                                         << BSON("dc"
+                                                 << "NA"
+                                                 << "rack"
+                                                 << "rackNA2"))
+                           << BSON("_id" << 2 << "host"
+                                         << "node2"
+                                         << "tags"
+                                         << BSON("dc"
+                                                 << "NA"
+                                                 << "rack"
+                                                 << "rackNA3"))
+                           << BSON("_id" << 3 << "host"
+                                         << "node3"
+                                         << "tags"
+                                         << BSON("dc"
+                                                 << "EU"
+                                                 << "rack"
+                                                 << "rackEU1"))
+                           << BSON("_id" << 4 << "host"
+                                         << "node4"
+                                         << "tags"
+                                         << BSON("dc"
+                                                 << "EU"
+                                                 << "rack"
+                                                 << "rackEU2")))
+             << "settings"
+             << BSON("getLastErrorModes" << BSON("multiDC" << BSON("dc" << 2) << "multiDCAndRack"
+                                                           << BSON("dc" << 2 << "rack" << 3)))),
+        HostAndPort("node0"));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTime(Timestamp(100, 1), 0), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTime(Timestamp(100, 1), 0), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTime time1(Timestamp(100, 2), 1);
+    OpTime time2(Timestamp(100, 3), 1);
+    replCoordSetMyLastAppliedOpTime(time2, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time2, Date_t() + Seconds(100));
+
+    auto makeWriteConcern = [](int wNumNodes,
+                               std::string wMode,
+                               WriteConcernOptions::SyncMode syncMode) {
+        WriteConcernOptions writeConcern;
+        writeConcern.wTimeout = WriteConcernOptions::kNoTimeout;
+        writeConcern.wNumNodes = wNumNodes;
+        writeConcern.wMode = std::move(wMode);
+        writeConcern.syncMode = syncMode;
+        return writeConcern;
+    };
+    const auto none = WriteConcernOptions::SyncMode::NONE;
+    const auto journal = WriteConcernOptions::SyncMode::JOURNAL;
+
+    // Waiters with different write concerns are interleaved by optime, so that every write concern
+    // has waiters that are satisfied at different times.
+    auto w2Time1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(
+        time1, makeWriteConcern(2, "", none));
+    auto w3Time1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(
+        time1, makeWriteConcern(3, "", none));
+    auto multiDCTime1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(
+        time1, makeWriteConcern(0, "multiDC", none));
+    auto w2JournalTime1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(
+        time1, makeWriteConcern(2, "", journal));
+    auto multiRackTime1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(
+        time1, makeWriteConcern(0, "multiDCAndRack", none));
+    auto w2Time2 = getReplCoord()->awaitReplicationAsyncNoWTimeout(
+        time2, makeWriteConcern(2, "", none));
+    auto w3Time2 = getReplCoord()->awaitReplicationAsyncNoWTimeout(
+        time2, makeWriteConcern(3, "", none));
+    auto multiDCTime2 = getReplCoord()->awaitReplicationAsyncNoWTimeout(
+        time2, makeWriteConcern(0, "multiDC", none));
+
+    auto assertReady = [](std::vector<SharedSemiFuture<void>*> ready,
+                          std::vector<SharedSemiFuture<void>*> notReady) {
+        for (auto future : ready) {
+            ASSERT_TRUE(future->isReady());
+            ASSERT_OK(future->getNoThrow());
+        }
+        for (auto future : notReady) {
+            ASSERT_FALSE(future->isReady());
+        }
+    };
+    assertReady({},
+                {&w2Time1,
+                 &w3Time1,
+                 &multiDCTime1,
+                 &w2JournalTime1,
+                 &multiRackTime1,
+                 &w2Time2,
+                 &w3Time2,
+                 &multiDCTime2});
+
+    // node1 has applied, but not yet journaled, both optimes. Only the w:2 waiters that do not
+    // need journaling are satisfied.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    assertReady(
+        {&w2Time1, &w2Time2},
+        {&w3Time1, &multiDCTime1, &w2JournalTime1, &multiRackTime1, &w3Time2, &multiDCTime2});
+
+    // Journaling on node1 satisfies the w:2 waiter with j:true.
+    ASSERT_OK(getReplCoord()->setLastDurableOptime_forTest(2, 1, time2));
+    assertReady({&w2JournalTime1},
+                {&w3Time1, &multiDCTime1, &multiRackTime1, &w3Time2, &multiDCTime2});
+
+    // A node in the EU data center at time1 satisfies every waiter at time1, but none at time2.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 3, time1));
+    assertReady({&w3Time1, &multiDCTime1, &multiRackTime1}, {&w3Time2, &multiDCTime2});
+
+    // Once it reaches time2, the remaining waiters are satisfied as well.
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 3, time2));
+    assertReady({&w3Time2, &multiDCTime2}, {});
+}
+
 /**
  * Used to wait for replication in a separate thread without blocking execution of the test.
  * To use, set the optime and write concern to be passed to awaitReplication and then call
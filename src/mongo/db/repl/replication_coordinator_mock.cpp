@@ -559,6 +559,10 @@ HostAndPort ReplicationCoordinatorMock::chooseNewSyncSource(const OpTime& lastOp
 
 void ReplicationCoordinatorMock::denylistSyncSource(const HostAndPort& host, Date_t until) {}
 
+void ReplicationCoordinatorMock::recordSyncSourceFetchStats(const HostAndPort& host,
+                                                            std::size_t bytes,
+                                                            Milliseconds elapsed) {}
+
 void ReplicationCoordinatorMock::resetLastOpTimesFromOplog(OperationContext* opCtx) {
     stdx::lock_guard<Mutex> lk(_mutex);
 
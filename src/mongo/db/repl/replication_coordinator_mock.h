@@ -273,6 +273,10 @@ public:
 
     virtual void denylistSyncSource(const HostAndPort& host, Date_t until);
 
+    virtual void recordSyncSourceFetchStats(const HostAndPort& host,
+                                            std::size_t bytes,
+                                            Milliseconds elapsed);
+
     virtual void resetLastOpTimesFromOplog(OperationContext* opCtx);
 
     bool lastOpTimesWereReset() const;
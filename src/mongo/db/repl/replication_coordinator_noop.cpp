@@ -446,6 +446,12 @@ void ReplicationCoordinatorNoOp::denylistSyncSource(const HostAndPort&, Date_t)
     MONGO_UNREACHABLE;
 }
 
+void ReplicationCoordinatorNoOp::recordSyncSourceFetchStats(const HostAndPort&,
+                                                            std::size_t,
+                                                            Milliseconds) {
+    MONGO_UNREACHABLE;
+}
+
 void ReplicationCoordinatorNoOp::resetLastOpTimesFromOplog(OperationContext*) {
     MONGO_UNREACHABLE;
 }
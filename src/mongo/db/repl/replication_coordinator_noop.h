@@ -238,6 +238,8 @@ public:
 
     void denylistSyncSource(const HostAndPort&, Date_t) final;
 
+    void recordSyncSourceFetchStats(const HostAndPort&, std::size_t, Milliseconds) final;
+
     void resetLastOpTimesFromOplog(OperationContext*) final;
 
     ChangeSyncSourceAction shouldChangeSyncSource(const HostAndPort&,
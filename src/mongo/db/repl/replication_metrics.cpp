@@ -270,7 +270,8 @@ void ReplicationMetrics::setElectionCandidateMetrics(
     const int numVotesNeeded,
     const double priorityAtElection,
     const Milliseconds electionTimeout,
-    const boost::optional<int> priorPrimaryMemberId) {
+    const boost::optional<int> priorPrimaryMemberId,
+    const boost::optional<Date_t> lastPrimaryContactDate) {
 
     stdx::lock_guard<Latch> lk(_mutex);
 
@@ -285,6 +286,7 @@ void ReplicationMetrics::setElectionCandidateMetrics(
     long long electionTimeoutMillis = durationCount<Milliseconds>(electionTimeout);
     _electionCandidateMetrics.setElectionTimeoutMillis(electionTimeoutMillis);
     _electionCandidateMetrics.setPriorPrimaryMemberId(priorPrimaryMemberId);
+    _electionCandidateMetrics.setLastPrimaryContactDate(lastPrimaryContactDate);
 }
 
 void ReplicationMetrics::setTargetCatchupOpTime(OpTime opTime) {
@@ -303,6 +305,17 @@ void ReplicationMetrics::setNumCatchUpOps(long numCatchUpOps) {
 void ReplicationMetrics::setCandidateNewTermStartDate(Date_t newTermStartDate) {
     stdx::lock_guard<Latch> lk(_mutex);
     _electionCandidateMetrics.setNewTermStartDate(newTermStartDate);
+
+    // The new term oplog entry is the first point at which this node can accept writes, so the
+    // failover ends here.
+    if (auto lastPrimaryContactDate = _electionCandidateMetrics.getLastPrimaryContactDate()) {
+        const long long failoverDurationMillis =
+            durationCount<Milliseconds>(newTermStartDate - *lastPrimaryContactDate);
+        _electionCandidateMetrics.setFailoverDurationMillis(failoverDurationMillis);
+        _electionMetrics.setNumFailoversMeasured(_electionMetrics.getNumFailoversMeasured() + 1);
+        _electionMetrics.setTotalFailoverDurationMillis(
+            _electionMetrics.getTotalFailoverDurationMillis() + failoverDurationMillis);
+    }
 }
 
 void ReplicationMetrics::setWMajorityWriteAvailabilityDate(Date_t wMajorityWriteAvailabilityDate) {
@@ -334,6 +347,8 @@ void ReplicationMetrics::clearElectionCandidateMetrics() {
     _electionCandidateMetrics.setNumCatchUpOps(boost::none);
     _electionCandidateMetrics.setNewTermStartDate(boost::none);
     _electionCandidateMetrics.setWMajorityWriteAvailabilityDate(boost::none);
+    _electionCandidateMetrics.setLastPrimaryContactDate(boost::none);
+    _electionCandidateMetrics.setFailoverDurationMillis(boost::none);
     _nodeIsCandidateOrPrimary = false;
 }
 
@@ -89,7 +89,8 @@ public:
                                      int numVotesNeeded,
                                      double priorityAtElection,
                                      Milliseconds electionTimeoutMillis,
-                                     boost::optional<int> priorPrimary);
+                                     boost::optional<int> priorPrimary,
+                                     boost::optional<Date_t> lastPrimaryContactDate);
     void setTargetCatchupOpTime(OpTime opTime);
     void setNumCatchUpOps(long numCatchUpOps);
     void setCandidateNewTermStartDate(Date_t newTermStartDate);
@@ -36,6 +36,7 @@
 #include "mongo/db/repl/replication_recovery.h"
 
 #include "mongo/db/catalog/document_validation.h"
+#include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/namespace_string.h"
@@ -56,6 +57,9 @@
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -74,6 +78,9 @@ const auto kRecoveryOperationLogLevel = logv2::LogSeverity::Debug(3);
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    RecoveryOplogApplierStats(const Timestamp& startPoint, const Timestamp& endPoint)
+        : _startPoint(startPoint), _endPoint(endPoint) {}
+
     void onBatchBegin(const std::vector<OplogEntry>& batch) final {
         _numBatches++;
         LOGV2_FOR_RECOVERY(24098,
@@ -107,7 +114,32 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>&) final {}
+    void onBatchEnd(const StatusWith<OpTime>& lastOpTimeApplied,
+                    const std::vector<OplogEntry>&) final {
+        if (!lastOpTimeApplied.isOK() ||
+            _progressTimer.seconds() < recoveryProgressLogIntervalSecs.load()) {
+            return;
+        }
+        _progressTimer.reset();
+
+        // Estimate how far along we are from the position of the last applied entry between the
+        // start and end points, since the number of entries left to apply is not known up front.
+        const auto lastApplied = lastOpTimeApplied.getValue().getTimestamp();
+        const double range = static_cast<double>(_endPoint.asULL() - _startPoint.asULL());
+        const double done = static_cast<double>(lastApplied.asULL() - _startPoint.asULL());
+        const auto elapsedMillis = _totalTimer.millis();
+        LOGV2(6170431,
+              "Replication recovery oplog application progress",
+              "numOpsApplied"_attr = _numOpsApplied,
+              "numBatches"_attr = _numBatches,
+              "lastAppliedTimestamp"_attr = lastApplied,
+              "endPoint"_attr = _endPoint,
+              "percentComplete"_attr = range > 0 ? static_cast<int>(100 * done / range) : 100,
+              "opsPerSecond"_attr = elapsedMillis > 0
+                  ? static_cast<long long>(_numOpsApplied) * 1000 / elapsedMillis
+                  : 0,
+              "durationMillis"_attr = elapsedMillis);
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
@@ -116,12 +148,20 @@ public:
               "Completed oplog application for recovery",
               "numOpsApplied"_attr = _numOpsApplied,
               "numBatches"_attr = _numBatches,
-              "applyThroughOpTime"_attr = applyThroughOpTime);
+              "applyThroughOpTime"_attr = applyThroughOpTime,
+              "durationMillis"_attr = _totalTimer.millis());
     }
 
 private:
+    const Timestamp _startPoint;
+    const Timestamp _endPoint;
+
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
+
+    // Measures the whole of oplog application, and the time since progress was last logged.
+    Timer _totalTimer;
+    Timer _progressTimer;
 };
 
 /**
@@ -245,6 +285,126 @@ private:
     std::unique_ptr<DBClientCursor> _cursor;
 };
 
+/**
+ * Reads applier batches from an OplogBufferLocalOplog on a dedicated thread, one batch ahead of
+ * the batch being applied, so that reading the oplog overlaps with applying it. The buffer is
+ * started up and shut down on the dedicated thread, as its cursor is bound to the operation
+ * context it was started up with. At most one batch is read ahead.
+ */
+class RecoveryBatchPrefetcher {
+    RecoveryBatchPrefetcher(const RecoveryBatchPrefetcher&) = delete;
+    RecoveryBatchPrefetcher& operator=(const RecoveryBatchPrefetcher&) = delete;
+
+public:
+    RecoveryBatchPrefetcher(OplogApplier* oplogApplier,
+                            OplogBufferLocalOplog* oplogBuffer,
+                            OplogApplier::BatchLimits batchLimits)
+        : _oplogApplier(oplogApplier), _oplogBuffer(oplogBuffer), _batchLimits(batchLimits) {}
+
+    ~RecoveryBatchPrefetcher() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _inShutdown = true;
+            _cv.notify_all();
+        }
+        if (_thread) {
+            _thread->join();
+        }
+    }
+
+    /**
+     * Starts up the oplog buffer on the dedicated thread and waits until it has been started up.
+     */
+    void startup() {
+        _thread = std::make_unique<stdx::thread>([this] { _run(); });
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        _cv.wait(lk, [&] { return _started; });
+        uassertStatusOK(_status);
+    }
+
+    /**
+     * Returns the next batch to apply, waiting for it to be read if necessary. Returns an empty
+     * batch once the oplog buffer is exhausted.
+     */
+    std::vector<OplogEntry> getNextBatch() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _cv.wait(lk, [&] { return _nextBatch || _exhausted || !_status.isOK(); });
+        uassertStatusOK(_status);
+        if (!_nextBatch) {
+            return {};
+        }
+
+        auto batch = std::move(*_nextBatch);
+        _nextBatch.reset();
+        _cv.notify_all();
+        return batch;
+    }
+
+private:
+    void _run() {
+        Client::initThread("ReplRecoveryBatcher");
+        auto opCtx = cc().makeOperationContext();
+
+        auto setStatus = [&](Status status) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _status = std::move(status);
+            _started = true;
+            _cv.notify_all();
+        };
+
+        try {
+            _oplogBuffer->startup(opCtx.get());
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                _started = true;
+                _cv.notify_all();
+            }
+
+            while (true) {
+                auto batch = fassert(
+                    6170459, _oplogApplier->getNextApplierBatch(opCtx.get(), _batchLimits));
+
+                stdx::unique_lock<Latch> lk(_mutex);
+                if (batch.empty()) {
+                    _exhausted = true;
+                    _cv.notify_all();
+                    break;
+                }
+
+                _nextBatch = std::move(batch);
+                _cv.notify_all();
+
+                // Wait for the batch to be taken before reading the next one.
+                _cv.wait(lk, [&] { return !_nextBatch || _inShutdown; });
+                if (_inShutdown) {
+                    break;
+                }
+            }
+        } catch (const DBException& ex) {
+            setStatus(ex.toStatus());
+        }
+
+        _oplogBuffer->shutdown(opCtx.get());
+    }
+
+    OplogApplier* const _oplogApplier;
+    OplogBufferLocalOplog* const _oplogBuffer;
+    const OplogApplier::BatchLimits _batchLimits;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("RecoveryBatchPrefetcher::_mutex");
+    stdx::condition_variable _cv;
+
+    // The following are protected by '_mutex'.
+    bool _started = false;
+    bool _exhausted = false;
+    bool _inShutdown = false;
+    Status _status = Status::OK();
+    boost::optional<std::vector<OplogEntry>> _nextBatch;
+
+    std::unique_ptr<stdx::thread> _thread;
+};
+
 boost::optional<Timestamp> recoverFromOplogPrecursor(OperationContext* opCtx,
                                                      StorageInterface* storageInterface) {
     if (!storageInterface->supportsRecoveryTimestamp(opCtx->getServiceContext())) {
@@ -666,9 +826,8 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
           "endPoint"_attr = endPoint);
 
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
-    oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    RecoveryOplogApplierStats stats(startPoint, endPoint);
 
     auto writerPool = makeReplWriterPool();
     auto* replCoord = ReplicationCoordinator::get(opCtx);
@@ -685,6 +844,22 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     batchLimits.bytes = getBatchLimitOplogBytes(opCtx, _storageInterface);
     batchLimits.ops = getBatchLimitOplogEntries();
 
+    // Either read each batch on this thread right before applying it, or have the prefetcher read
+    // it on its own thread while the previous batch is being applied.
+    boost::optional<RecoveryBatchPrefetcher> prefetcher;
+    if (recoveryPrefetchOplogBatches.load()) {
+        prefetcher.emplace(&oplogApplier, &oplogBuffer, batchLimits);
+        prefetcher->startup();
+    } else {
+        oplogBuffer.startup(opCtx);
+    }
+    auto getNextBatch = [&] {
+        if (prefetcher) {
+            return prefetcher->getNextBatch();
+        }
+        return fassert(50763, oplogApplier.getNextApplierBatch(opCtx, batchLimits));
+    };
+
     // If we're doing unstable checkpoints during the recovery process (as we do during the special
     // startupRecoveryForRestore mode), we need to advance the consistency marker for each batch so
     // the next time we recover we won't start all the way over.  Further, we can advance the oldest
@@ -700,8 +875,7 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
 
     OpTime applyThroughOpTime;
     std::vector<OplogEntry> batch;
-    while (
-        !(batch = fassert(50763, oplogApplier.getNextApplierBatch(opCtx, batchLimits))).empty()) {
+    while (!(batch = getNextBatch()).empty()) {
         if (advanceTimestampsEachBatch && applyThroughOpTime.isNull()) {
             // We must set appliedThrough before applying anything at all, so we know
             // any unstable checkpoints we take are "dirty".  A null appliedThrough indicates
@@ -717,11 +891,16 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
         }
     }
     stats.complete(applyThroughOpTime);
-    invariant(oplogBuffer.isEmpty(),
-              str::stream() << "Oplog buffer not empty after applying operations. Last operation "
-                               "applied with optime: "
-                            << applyThroughOpTime.toBSON());
-    oplogBuffer.shutdown(opCtx);
+    if (prefetcher) {
+        // The prefetcher only reports the buffer exhausted once it is empty, and shuts it down.
+        prefetcher.reset();
+    } else {
+        invariant(oplogBuffer.isEmpty(),
+                  str::stream() << "Oplog buffer not empty after applying operations. Last "
+                                   "operation applied with optime: "
+                                << applyThroughOpTime.toBSON());
+        oplogBuffer.shutdown(opCtx);
+    }
 
     // The applied up to timestamp will be null if no oplog entries were applied.
     if (applyThroughOpTime.isNull()) {
@@ -54,6 +54,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/transaction_participant.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
@@ -680,6 +681,23 @@ TEST_F(ReplicationRecoveryTest,
     testRecoveryAppliesDocumentsWhenAppliedThroughIsBehind(hasStableTimestamp, hasStableCheckpoint);
 }
 
+TEST_F(ReplicationRecoveryTest, RecoveryAppliesDocumentsInPrefetchedBatches) {
+    // Apply one op per batch so that the prefetcher reads several batches ahead of application.
+    RAIIServerParameterControllerForTest batchLimit{"replBatchLimitOperations", 1};
+    RAIIServerParameterControllerForTest prefetch{"recoveryPrefetchOplogBatches", true};
+    bool hasStableTimestamp = true;
+    bool hasStableCheckpoint = false;
+    testRecoveryAppliesDocumentsWhenAppliedThroughIsBehind(hasStableTimestamp, hasStableCheckpoint);
+}
+
+TEST_F(ReplicationRecoveryTest, RecoveryAppliesDocumentsWithoutPrefetchingBatches) {
+    RAIIServerParameterControllerForTest batchLimit{"replBatchLimitOperations", 1};
+    RAIIServerParameterControllerForTest prefetch{"recoveryPrefetchOplogBatches", false};
+    bool hasStableTimestamp = true;
+    bool hasStableCheckpoint = false;
+    testRecoveryAppliesDocumentsWhenAppliedThroughIsBehind(hasStableTimestamp, hasStableCheckpoint);
+}
+
 void ReplicationRecoveryTest::testRecoveryToStableAppliesDocumentsWithNoAppliedThrough(
     bool hasStableTimestamp) {
     ReplicationRecoveryImpl recovery(getStorageInterface(), getConsistencyMarkers());
@@ -58,12 +58,14 @@ Reporter::Reporter(executor::TaskExecutor* executor,
                    PrepareReplSetUpdatePositionCommandFn prepareReplSetUpdatePositionCommandFn,
                    const HostAndPort& target,
                    Milliseconds keepAliveInterval,
-                   Milliseconds updatePositionTimeout)
+                   Milliseconds updatePositionTimeout,
+                   bool eagerUpdates)
     : _executor(executor),
       _prepareReplSetUpdatePositionCommandFn(prepareReplSetUpdatePositionCommandFn),
       _target(target),
       _keepAliveInterval(keepAliveInterval),
-      _updatePositionTimeout(updatePositionTimeout) {
+      _updatePositionTimeout(updatePositionTimeout),
+      _eagerUpdates(eagerUpdates) {
     uassert(ErrorCodes::BadValue, "null task executor", executor);
     uassert(ErrorCodes::BadValue,
             "null function to create replSetUpdatePosition command object",
@@ -106,6 +108,16 @@ void Reporter::shutdown() {
 
     _isWaitingToSendReporter = false;
 
+    if (_eagerCommandCallbackHandle.isValid()) {
+        _executor->cancel(_eagerCommandCallbackHandle);
+    }
+
+    if (!_remoteCommandCallbackHandle.isValid() &&
+        !_prepareAndSendCommandCallbackHandle.isValid()) {
+        // Only an eager command was in progress.
+        return;
+    }
+
     executor::TaskExecutor::CallbackHandle handle;
     if (_remoteCommandCallbackHandle.isValid()) {
         invariant(!_prepareAndSendCommandCallbackHandle.isValid());
@@ -140,6 +152,11 @@ Status Reporter::trigger() {
         _executor->cancel(_prepareAndSendCommandCallbackHandle);
         return Status::OK();
     } else if (_isActive_inlock()) {
+        if (_eagerUpdates && _remoteCommandCallbackHandle.isValid() &&
+            !_eagerCommandCallbackHandle.isValid()) {
+            _scheduleEagerCommand_inlock();
+            return Status::OK();
+        }
         _isWaitingToSendReporter = true;
         return Status::OK();
     }
@@ -334,6 +351,78 @@ void Reporter::_prepareAndSendCommandCallback(const executor::TaskExecutor::Call
     _keepAliveTimeoutWhen = Date_t();
 }
 
+void Reporter::_scheduleEagerCommand_inlock() {
+    auto scheduleResult =
+        _executor->scheduleWork([this](const executor::TaskExecutor::CallbackArgs& args) {
+            _prepareAndSendEagerCommandCallback(args);
+        });
+    if (!scheduleResult.isOK()) {
+        // The regular command will carry this progress once its response arrives.
+        _isWaitingToSendReporter = true;
+        return;
+    }
+
+    _eagerCommandCallbackHandle = scheduleResult.getValue();
+}
+
+void Reporter::_prepareAndSendEagerCommandCallback(
+    const executor::TaskExecutor::CallbackArgs& args) {
+    // Must call without holding the lock. Failures are not recorded in '_status' because the
+    // regular command is still in progress and owns the state of the reporter.
+    auto prepareResult = args.status.isOK() ? _prepareReplSetUpdatePositionCommandFn()
+                                            : StatusWith<BSONObj>(args.status);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (!_status.isOK() || !prepareResult.isOK()) {
+        _eagerCommandCallbackHandle = executor::TaskExecutor::CallbackHandle();
+        _condition.notify_all();
+        return;
+    }
+
+    LOGV2_DEBUG(5970400,
+                2,
+                "Reporter sending eager oplog progress to upstream updater {target}: "
+                "{commandRequest}",
+                "Reporter sending eager oplog progress to upstream updater",
+                "target"_attr = _target,
+                "commandRequest"_attr = prepareResult.getValue());
+
+    auto scheduleResult = _executor->scheduleRemoteCommand(
+        executor::RemoteCommandRequest(
+            _target, "admin", prepareResult.getValue(), nullptr, _updatePositionTimeout),
+        [this](const executor::TaskExecutor::RemoteCommandCallbackArgs& rcbd) {
+            _processEagerResponseCallback(rcbd);
+        });
+    if (!scheduleResult.isOK()) {
+        _eagerCommandCallbackHandle = executor::TaskExecutor::CallbackHandle();
+        _condition.notify_all();
+        return;
+    }
+
+    numUpdatePosition.increment(1);
+
+    _eagerCommandCallbackHandle = scheduleResult.getValue();
+}
+
+void Reporter::_processEagerResponseCallback(
+    const executor::TaskExecutor::RemoteCommandCallbackArgs& rcbd) {
+    auto status = rcbd.response.status;
+    if (status.isOK()) {
+        status = getStatusFromCommandResult(rcbd.response.data);
+    }
+    if (!status.isOK()) {
+        LOGV2_DEBUG(5970401,
+                    2,
+                    "Reporter eager update command failed: {error}",
+                    "Reporter eager update command failed",
+                    "error"_attr = status);
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _eagerCommandCallbackHandle = executor::TaskExecutor::CallbackHandle();
+    _condition.notify_all();
+}
+
 void Reporter::_onShutdown_inlock() {
     _isWaitingToSendReporter = false;
     _remoteCommandCallbackHandle = executor::TaskExecutor::CallbackHandle();
@@ -348,7 +437,8 @@ bool Reporter::isActive() const {
 }
 
 bool Reporter::_isActive_inlock() const {
-    return _remoteCommandCallbackHandle.isValid() || _prepareAndSendCommandCallbackHandle.isValid();
+    return _remoteCommandCallbackHandle.isValid() ||
+        _prepareAndSendCommandCallbackHandle.isValid() || _eagerCommandCallbackHandle.isValid();
 }
 
 bool Reporter::isWaitingToSendReport() const {
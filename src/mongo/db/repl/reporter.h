@@ -62,6 +62,12 @@ namespace repl {
  *
  * Calling trigger() while it is in state 3 sends a command upstream and cancels the current
  * keep alive timeout, resetting the keep alive schedule.
+ *
+ * If the reporter is constructed with 'eagerUpdates', calling trigger() while a command is in
+ * progress sends a second, eager command right away instead of waiting for the response, so new
+ * progress does not sit behind a full round trip to the sync source. At most one eager command is
+ * in progress at a time; further triggers fall back to the behavior above. Errors from eager
+ * commands are only logged, since the regular command reports the same failures.
  */
 class Reporter {
     Reporter(const Reporter&) = delete;
@@ -80,7 +86,8 @@ public:
              PrepareReplSetUpdatePositionCommandFn prepareReplSetUpdatePositionCommandFn,
              const HostAndPort& target,
              Milliseconds keepAliveInterval,
-             Milliseconds updatePositionTimeout);
+             Milliseconds updatePositionTimeout,
+             bool eagerUpdates = false);
 
     virtual ~Reporter();
 
@@ -166,6 +173,23 @@ private:
     void _prepareAndSendCommandCallback(const executor::TaskExecutor::CallbackArgs& args,
                                         bool fromTrigger);
 
+    /**
+     * Schedules a task that prepares and sends an eager command while the regular remote command
+     * is still in progress.
+     */
+    void _scheduleEagerCommand_inlock();
+
+    /**
+     * Callback for preparing and sending an eager remote command.
+     */
+    void _prepareAndSendEagerCommandCallback(const executor::TaskExecutor::CallbackArgs& args);
+
+    /**
+     * Callback for processing the response to an eager remote command.
+     */
+    void _processEagerResponseCallback(
+        const executor::TaskExecutor::RemoteCommandCallbackArgs& rcbd);
+
     /**
      * Signals end of Reporter work and notifies waiters.
      */
@@ -187,6 +211,9 @@ private:
     // The network timeout used when sending an updatePosition command to our sync source.
     const Milliseconds _updatePositionTimeout;
 
+    // Whether to send an eager command when triggered while a remote command is in progress.
+    const bool _eagerUpdates;
+
     // Protects member data of this Reporter declared below.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("Reporter::_mutex");
 
@@ -205,6 +232,10 @@ private:
     // Callback handle to the scheduled task for preparing and sending the remote command.
     executor::TaskExecutor::CallbackHandle _prepareAndSendCommandCallbackHandle;
 
+    // Callback handle to the eager command, or to the task preparing it. Valid only while an eager
+    // command is being prepared or is in progress.
+    executor::TaskExecutor::CallbackHandle _eagerCommandCallbackHandle;
+
     // Keep alive timeout callback will not run before this time.
     // If this date is Date_t(), the callback is either unscheduled or canceled.
     // Used for testing only.
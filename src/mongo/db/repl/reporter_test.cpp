@@ -389,6 +389,61 @@ TEST_F(ReporterTestNoTriggerAtSetUp, IsNotActiveAfterUpdatePositionTimeoutExpire
     ASSERT_TRUE(ErrorCodes::isExceededTimeLimitError(testReporter.getStatus_forTest().code()));
 }
 
+TEST_F(ReporterTestNoTriggerAtSetUp, EagerUpdateIsSentWhileCommandRequestIsInProgress) {
+    auto prepareReplSetUpdatePositionCommandFn = [updater = posUpdater.get()] {
+        return updater->prepareReplSetUpdatePositionCommand();
+    };
+
+    // Create a new test Reporter so we can enable eager updates.
+    Reporter testReporter(&getExecutor(),
+                          prepareReplSetUpdatePositionCommandFn,
+                          HostAndPort("h1"),
+                          Milliseconds(1000),
+                          Milliseconds(5000),
+                          true);
+
+    ASSERT_OK(testReporter.trigger());
+
+    auto net = getNet();
+    net->enterNetwork();
+    auto firstRequest = net->getNextReadyRequest();
+    net->exitNetwork();
+
+    // Progress made while the first command is in progress is sent right away.
+    posUpdater->updateMap(0, OpTime({4, 0}, 1), OpTime({4, 0}, 1));
+    ASSERT_OK(testReporter.trigger());
+    ASSERT_FALSE(testReporter.isWaitingToSendReport());
+
+    net->enterNetwork();
+    auto eagerRequest = net->getNextReadyRequest();
+    UpdatePositionArgs args;
+    ASSERT_OK(args.initialize(eagerRequest->getRequest().cmdObj));
+    ASSERT_EQUALS(OpTime({4, 0}, 1), args.updatesBegin()->appliedOpTime);
+
+    // Only one eager command is in progress at a time.
+    ASSERT_OK(testReporter.trigger());
+    ASSERT_TRUE(testReporter.isWaitingToSendReport());
+
+    net->scheduleSuccessfulResponse(eagerRequest, RemoteCommandResponse(BSON("ok" << 1), {}));
+    net->scheduleSuccessfulResponse(firstRequest, RemoteCommandResponse(BSON("ok" << 1), {}));
+    net->runReadyNetworkOperations();
+
+    // The pending trigger is sent once the first command completes.
+    ASSERT_TRUE(net->hasReadyRequests());
+    net->exitNetwork();
+    ASSERT_TRUE(testReporter.isActive());
+    ASSERT_FALSE(testReporter.isWaitingToSendReport());
+
+    testReporter.shutdown();
+
+    net->enterNetwork();
+    net->runReadyNetworkOperations();
+    net->exitNetwork();
+
+    ASSERT_EQUALS(ErrorCodes::CallbackCanceled, testReporter.join());
+    ASSERT_FALSE(testReporter.isActive());
+}
+
 // If an error is returned, it should be recorded in the Reporter and not run again.
 TEST_F(ReporterTest, TaskExecutorAndNetworkErrorsStopTheReporter) {
     ASSERT_OK(reporter->trigger());
@@ -35,6 +35,7 @@
 
 #include "mongo/db/client.h"
 #include "mongo/db/repl/bgsync.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/repl_set_config.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/reporter.h"
@@ -238,7 +239,8 @@ void SyncSourceFeedback::run(executor::TaskExecutor* executor,
                           makePrepareReplSetUpdatePositionCommandFn(replCoord, syncTarget, bgsync),
                           syncTarget,
                           keepAliveInterval,
-                          syncSourceFeedbackNetworkTimeoutSecs);
+                          syncSourceFeedbackNetworkTimeoutSecs,
+                          syncSourceFeedbackEagerUpdates.load());
         {
             stdx::lock_guard<Latch> lock(_mtx);
             if (_shutdownSignaled) {
@@ -331,6 +331,12 @@ void SyncSourceResolver::_firstOplogEntryFetcherCallback(
     }
 
     const auto& queryResponse = queryResult.getValue();
+
+    // The probe only returns a single projected entry, so it measures the latency of an oplog
+    // query on the candidate rather than how fast it serves oplog.
+    _syncSourceSelector->recordSyncSourceFetchStats(
+        candidate, 0, duration_cast<Milliseconds>(queryResponse.elapsed));
+
     const auto remoteEarliestOpTime = _parseRemoteEarliestOpTime(candidate, queryResponse);
     if (remoteEarliestOpTime.isNull()) {
         _chooseAndProbeNextSyncSource(earliestOpTimeSeen).transitional_ignore();
@@ -80,6 +80,15 @@ public:
      */
     virtual void denylistSyncSource(const HostAndPort& host, Date_t until) = 0;
 
+    /**
+     * Records that a request for 'bytes' bytes of oplog from 'host' took 'elapsed', so that how
+     * fast 'host' serves oplog can be considered when choosing a sync source. A 'bytes' of 0
+     * records the latency of the request only.
+     */
+    virtual void recordSyncSourceFetchStats(const HostAndPort& host,
+                                            std::size_t bytes,
+                                            Milliseconds elapsed) = 0;
+
     /**
      * Determines if a new sync source should be chosen, if a better candidate sync source is
      * available.  If the current sync source's last optime (visibleOpTime or appliedOpTime of
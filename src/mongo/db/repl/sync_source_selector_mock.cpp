@@ -51,6 +51,10 @@ void SyncSourceSelectorMock::denylistSyncSource(const HostAndPort& host, Date_t
     _lastDenylistExpiration = until;
 }
 
+void SyncSourceSelectorMock::recordSyncSourceFetchStats(const HostAndPort& host,
+                                                        std::size_t bytes,
+                                                        Milliseconds elapsed) {}
+
 void SyncSourceSelectorMock::setChooseNewSyncSourceHook_forTest(
     const ChooseNewSyncSourceHook& hook) {
     _chooseNewSyncSourceHook = hook;
@@ -53,6 +53,9 @@ public:
     void clearSyncSourceDenylist() override;
     HostAndPort chooseNewSyncSource(const OpTime& ot) override;
     void denylistSyncSource(const HostAndPort& host, Date_t until) override;
+    void recordSyncSourceFetchStats(const HostAndPort& host,
+                                    std::size_t bytes,
+                                    Milliseconds elapsed) override;
     ChangeSyncSourceAction shouldChangeSyncSource(const HostAndPort&,
                                                   const rpc::ReplSetMetadata&,
                                                   const rpc::OplogQueryMetadata& oqMetadata,
@@ -211,6 +211,12 @@ public:
         return ChangeSyncSourceAction::kContinueSyncing;
     }
 
+    // The donor is not a member of our replica set, so its fetch stats are not used to choose a
+    // sync source.
+    void recordFetchStats(const HostAndPort& source,
+                          std::size_t bytes,
+                          Milliseconds elapsed) final {}
+
     // The oplog fetcher should never call the rest of the methods.
     std::unique_ptr<OplogBuffer> makeInitialSyncOplogBuffer(OperationContext* opCtx) const final {
         MONGO_UNREACHABLE;
@@ -905,6 +905,11 @@ std::vector<std::vector<const OplogEntry*>> TenantOplogApplier::_fillWriterVecto
         _writerPool->getStats().options.maxThreads);
     CachedCollectionProperties collPropertiesCache;
 
+    boost::optional<WriterAssignments> writerAssignments;
+    if (oplogApplicationBalanceWriters.load()) {
+        writerAssignments.emplace(writerVectors.size());
+    }
+
     for (auto&& op : batch->ops) {
         // If the operation's optime is before or the same as the beginApplyingAfterOpTime we don't
         // want to apply it, so don't include it in writerVectors.
@@ -938,11 +943,16 @@ std::vector<std::vector<const OplogEntry*>> TenantOplogApplier::_fillWriterVecto
                                              expansions,
                                              &writerVectors,
                                              &collPropertiesCache,
-                                             isTransactionWithCommand /* serial */);
+                                             isTransactionWithCommand /* serial */,
+                                             writerAssignments.get_ptr());
         } else {
             // Add a single op to the writer vectors.
-            OplogApplierUtils::addToWriterVector(
-                opCtx, &op.entry, &writerVectors, &collPropertiesCache);
+            OplogApplierUtils::addToWriterVector(opCtx,
+                                                 &op.entry,
+                                                 &writerVectors,
+                                                 &collPropertiesCache,
+                                                 boost::none /* forceWriterId */,
+                                                 writerAssignments.get_ptr());
         }
     }
     return writerVectors;
@@ -80,6 +80,10 @@ MONGO_FAIL_POINT_DEFINE(disableMaxSyncSourceLagSecs);
 
 constexpr Milliseconds TopologyCoordinator::PingStats::UninitializedPingTime;
 
+// Oplog fetch stats older than this are not used to rank sync source candidates, since the load on
+// the member they were taken from may have changed since.
+constexpr Minutes kSyncSourceFetchStatsExpiration{10};
+
 // Tracks the number of times we decide to change sync sources in order to sync from a significantly
 // closer node.
 Counter64 numSyncSourceChangesDueToSignificantlyCloserNode;
@@ -180,6 +184,22 @@ void TopologyCoordinator::PingStats::miss() {
     }
 }
 
+void TopologyCoordinator::SyncSourceFetchStats::record(std::size_t bytes,
+                                                      Milliseconds elapsed,
+                                                      Date_t now) {
+    // Guard against dividing by zero for batches that were served within the clock resolution.
+    elapsed = std::max(elapsed, Milliseconds(1));
+
+    _latency = _count == 0 ? elapsed : Milliseconds((_latency * 4 + elapsed) / 5);
+    if (bytes > 0) {
+        const double bytesPerMillis = double(bytes) / durationCount<Milliseconds>(elapsed);
+        _bytesPerMillis = _bytesPerMillis == 0 ? bytesPerMillis
+                                               : (_bytesPerMillis * 4 + bytesPerMillis) / 5;
+    }
+    _lastUpdated = now;
+    ++_count;
+}
+
 bool TopologyCoordinator::RecentSyncSourceChanges::changedTooOftenRecently(Date_t now) {
     size_t maxSize = maxNumSyncSourceChangesPerHour.load();
 
@@ -318,7 +338,7 @@ HostAndPort TopologyCoordinator::_chooseNearbySyncSource(Date_t now,
     // We should have handled PrimaryOnly before calling this.
     invariant(readPreference != ReadPreference::PrimaryOnly);
 
-    // find the member with the lowest ping time that is ahead of me
+    // find the member with the lowest sync source cost that is ahead of me
 
     int closestIndex = -1;
 
@@ -351,17 +371,20 @@ HostAndPort TopologyCoordinator::_chooseNearbySyncSource(Date_t now,
             const auto closestNode = _rsConfig.getMemberAt(closestIndex).getHostAndPort();
 
             // Do not update 'closestIndex' if the candidate is not the closest node we've seen.
-            auto syncSourceCandidatePing = _getPing(syncSourceCandidate);
-            auto closestPing = _getPing(closestNode);
-            if (syncSourceCandidatePing > closestPing) {
+            // Besides the ping, the cost accounts for how fast each node has recently served us
+            // oplog, so that a nearby but overloaded node does not win over a faster one.
+            auto syncSourceCandidateCost = _getSyncSourceCost(syncSourceCandidate, now);
+            auto closestCost = _getSyncSourceCost(closestNode, now);
+            if (syncSourceCandidateCost > closestCost) {
                 LOGV2_DEBUG(3873114,
                             2,
-                            "Cannot select sync source with higher latency than the best "
-                            "candidate",
+                            "Cannot select sync source with higher cost than the best candidate",
                             "syncSourceCandidate"_attr = syncSourceCandidate,
-                            "syncSourceCandidatePing"_attr = syncSourceCandidatePing,
+                            "syncSourceCandidatePing"_attr = _getPing(syncSourceCandidate),
+                            "syncSourceCandidateCost"_attr = syncSourceCandidateCost,
                             "closestNode"_attr = closestNode,
-                            "closestPing"_attr = closestPing);
+                            "closestPing"_attr = _getPing(closestNode),
+                            "closestCost"_attr = closestCost);
                 continue;
             }
             closestIndex = candidateIndex;
@@ -1951,6 +1974,21 @@ void TopologyCoordinator::prepareStatusResponse(const ReplSetStatusArgs& rsStatu
             bb.appendDate("lastHeartbeatRecv", it->getLastHeartbeatRecv());
             Milliseconds ping = _getPing(itConfig.getHostAndPort());
             bb.append("pingMs", durationCount<Milliseconds>(ping));
+            auto fetchStatsIt = _syncSourceFetchStats.find(itConfig.getHostAndPort());
+            if (fetchStatsIt != _syncSourceFetchStats.end()) {
+                const auto& fetchStats = fetchStatsIt->second;
+                BSONObjBuilder fetchStatsBuilder(bb.subobjStart("syncSourceFetchStats"));
+                fetchStatsBuilder.append("latencyMs",
+                                         durationCount<Milliseconds>(fetchStats.getLatency()));
+                fetchStatsBuilder.append("bytesPerMs", fetchStats.getBytesPerMillis());
+                fetchStatsBuilder.append("numRequests",
+                                         static_cast<long long>(fetchStats.getCount()));
+                fetchStatsBuilder.appendDate("lastUpdated", fetchStats.getLastUpdated());
+                fetchStatsBuilder.append(
+                    "costMs",
+                    durationCount<Milliseconds>(
+                        _getSyncSourceCost(itConfig.getHostAndPort(), now)));
+            }
             bb.append("lastHeartbeatMessage", it->getLastHeartbeatMsg());
             if (it->hasAuthIssue()) {
                 bb.append("authenticated", false);
@@ -2509,6 +2547,30 @@ Milliseconds TopologyCoordinator::_getPing(const HostAndPort& host) {
     return _pings[host].getMillis();
 }
 
+void TopologyCoordinator::recordSyncSourceFetchStats(const HostAndPort& host,
+                                                     std::size_t bytes,
+                                                     Milliseconds elapsed,
+                                                     Date_t now) {
+    _syncSourceFetchStats[host].record(bytes, elapsed, now);
+}
+
+Milliseconds TopologyCoordinator::_getSyncSourceCost(const HostAndPort& host, Date_t now) {
+    const auto ping = _getPing(host);
+    auto it = _syncSourceFetchStats.find(host);
+    if (it == _syncSourceFetchStats.end() ||
+        now - it->second.getLastUpdated() > kSyncSourceFetchStatsExpiration) {
+        return ping;
+    }
+
+    const auto& fetchStats = it->second;
+    auto cost = std::max(ping, fetchStats.getLatency());
+    if (fetchStats.getBytesPerMillis() > 0) {
+        cost += Milliseconds(static_cast<long long>(BSONObjMaxUserSize /
+                                                    fetchStats.getBytesPerMillis()));
+    }
+    return cost;
+}
+
 void TopologyCoordinator::setPing_forTest(const HostAndPort& host, const Milliseconds ping) {
     PingStats& pingStats = _pings[host];
     pingStats.set_forTest(ping);
@@ -3225,6 +3287,12 @@ bool TopologyCoordinator::shouldChangeSyncSourceDueToPingTime(const HostAndPort&
             continue;
         }
 
+        // Do not go back to a closer node that has recently served us oplog slower than our
+        // current sync source does.
+        if (_getSyncSourceCost(candidateNode, now) > _getSyncSourceCost(currentSource, now)) {
+            continue;
+        }
+
         if (_isEligibleSyncSource(candidateIndex,
                                   now,
                                   previousOpTimeFetched,
@@ -255,6 +255,16 @@ public:
      */
     void clearSyncSourceDenylist();
 
+    /**
+     * Records that a request for 'bytes' bytes of oplog from 'host' took 'elapsed'. The resulting
+     * latency and throughput estimates are used, in addition to ping times, to rank sync source
+     * candidates. A 'bytes' of 0 records the latency of the request only.
+     */
+    void recordSyncSourceFetchStats(const HostAndPort& host,
+                                    std::size_t bytes,
+                                    Milliseconds elapsed,
+                                    Date_t now);
+
     /**
      * Determines if a new sync source should be chosen, if a better candidate sync source is
      * available.  If the current sync source's last optime ("syncSourceLastOpTime" under
@@ -842,6 +852,7 @@ public:
 private:
     typedef int UnelectableReasonMask;
     class PingStats;
+    class SyncSourceFetchStats;
 
     /**
      * Different modes a node can be in while still reporting itself as in state PRIMARY.
@@ -938,6 +949,12 @@ private:
     // Returns the current "ping" value for the given member by their address.
     Milliseconds _getPing(const HostAndPort& host);
 
+    // Returns the estimated cost of syncing from the given member by their address: the higher of
+    // its ping and the latency of our recent oplog queries to it, plus the time it would take to
+    // serve a full batch of oplog at the throughput of recent fetches from it. Falls back to the
+    // ping alone if the member has not served us oplog recently.
+    Milliseconds _getSyncSourceCost(const HostAndPort& host, Date_t now);
+
     // Returns the index of the member with the matching id, or -1 if none match.
     int _getMemberIndex(int id) const;
 
@@ -1118,6 +1135,10 @@ private:
     // current config.
     int pingsInConfig = 0;
 
+    typedef std::map<HostAndPort, SyncSourceFetchStats> SyncSourceFetchStatsMap;
+    // Oplog fetch stats for each member we have synced from, by HostAndPort.
+    SyncSourceFetchStatsMap _syncSourceFetchStats;
+
     // V1 last vote info for elections
     LastVote _lastVote{OpTime::kInitialTerm, -1};
 
@@ -1274,6 +1295,56 @@ private:
     int _numFailuresSinceLastStart = UninitializedCount;
 };
 
+/**
+ * A SyncSourceFetchStats object stores data about the batches of oplog fetched from a particular
+ * sync source: the throughput at which the batches were served and the latency of the requests
+ * that fetched them. Both are averages weighted 80% to the old value and 20% to the new value,
+ * like the heartbeat latency in PingStats.
+ */
+class TopologyCoordinator::SyncSourceFetchStats {
+public:
+    /**
+     * Records that a request for 'bytes' bytes took 'elapsed'. Only the latency is updated if
+     * 'bytes' is 0.
+     */
+    void record(std::size_t bytes, Milliseconds elapsed, Date_t now);
+
+    /**
+     * Gets the weighted average number of bytes fetched per millisecond. Returns 0 if no batch
+     * with data has been recorded yet.
+     */
+    double getBytesPerMillis() const {
+        return _bytesPerMillis;
+    }
+
+    /**
+     * Gets the weighted average time taken by a request for a batch.
+     */
+    Milliseconds getLatency() const {
+        return _latency;
+    }
+
+    /**
+     * Gets the date at which the last batch was recorded.
+     */
+    Date_t getLastUpdated() const {
+        return _lastUpdated;
+    }
+
+    /**
+     * Gets the number of batches recorded.
+     */
+    unsigned int getCount() const {
+        return _count;
+    }
+
+private:
+    double _bytesPerMillis = 0;
+    Milliseconds _latency{0};
+    Date_t _lastUpdated;
+    unsigned int _count = 0;
+};
+
 //
 // Convenience method for unittest code. Please use accessors otherwise.
 //
@@ -571,6 +571,54 @@ TEST_F(TopoCoordTest, NodeReturnsClosestValidSyncSourceAsSyncSource) {
     ASSERT(getTopoCoord().getSyncSourceAddress().empty());
 }
 
+TEST_F(TopoCoordTest, NodeChoosesFasterSyncSourceOverCloserSlowerOne) {
+    updateConfig(BSON("_id"
+                      << "rs0"
+                      << "version" << 1 << "members"
+                      << BSON_ARRAY(BSON("_id" << 10 << "host"
+                                               << "hself")
+                                    << BSON("_id" << 20 << "host"
+                                                  << "hnear")
+                                    << BSON("_id" << 30 << "host"
+                                                  << "hfar"))),
+                 0);
+
+    setSelfMemberState(MemberState::RS_SECONDARY);
+    OpTime lastOpTimeWeApplied = OpTime(Timestamp(100, 0), 0);
+
+    // Record 2 rounds of pings to allow choosing a new sync source.
+    for (int i = 0; i < 2; ++i) {
+        heartbeatFromMember(HostAndPort("hnear"),
+                            "rs0",
+                            MemberState::RS_SECONDARY,
+                            OpTime(Timestamp(501, 0), 0),
+                            Milliseconds(10));
+        heartbeatFromMember(HostAndPort("hfar"),
+                            "rs0",
+                            MemberState::RS_SECONDARY,
+                            OpTime(Timestamp(501, 0), 0),
+                            Milliseconds(100));
+    }
+
+    // Without fetch stats, the closest node is chosen.
+    getTopoCoord().chooseNewSyncSource(now()++, lastOpTimeWeApplied, ReadPreference::Nearest);
+    ASSERT_EQUALS(HostAndPort("hnear"), getTopoCoord().getSyncSourceAddress());
+
+    // The closer node serves a full batch of oplog in about 1.6 seconds, the farther one in about
+    // 160 milliseconds, so the farther one is chosen.
+    getTopoCoord().recordSyncSourceFetchStats(
+        HostAndPort("hnear"), BSONObjMaxUserSize, Milliseconds(1600), now());
+    getTopoCoord().recordSyncSourceFetchStats(
+        HostAndPort("hfar"), BSONObjMaxUserSize, Milliseconds(160), now());
+    getTopoCoord().chooseNewSyncSource(now()++, lastOpTimeWeApplied, ReadPreference::Nearest);
+    ASSERT_EQUALS(HostAndPort("hfar"), getTopoCoord().getSyncSourceAddress());
+
+    // Once the fetch stats expire, the closest node is chosen again.
+    now() += Minutes(11);
+    getTopoCoord().chooseNewSyncSource(now()++, lastOpTimeWeApplied, ReadPreference::Nearest);
+    ASSERT_EQUALS(HostAndPort("hnear"), getTopoCoord().getSyncSourceAddress());
+}
+
 TEST_F(TopoCoordTest, NodeWontChooseSyncSourceFromOlderTerm) {
     updateConfig(BSON("_id"
                       << "rs0"
@@ -37,6 +37,7 @@
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_session_id.h"
 #include "mongo/db/s/migration_source_manager.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 
@@ -50,7 +51,7 @@ const auto getRegistry = ServiceContext::declareDecoration<ActiveMigrationsRegis
 ActiveMigrationsRegistry::ActiveMigrationsRegistry() = default;
 
 ActiveMigrationsRegistry::~ActiveMigrationsRegistry() {
-    invariant(!_activeMoveChunkState);
+    invariant(_activeMoveChunkStates.empty());
 }
 
 ActiveMigrationsRegistry& ActiveMigrationsRegistry::get(ServiceContext* service) {
@@ -74,7 +75,7 @@ void ActiveMigrationsRegistry::lock(OperationContext* opCtx, StringData reason)
 
     // Wait for any ongoing chunk modifications to complete
     opCtx->waitForConditionOrInterrupt(_chunkOperationsStateChangedCV, lock, [this] {
-        return !(_activeMoveChunkState || _activeReceiveChunkState);
+        return _activeMoveChunkStates.empty() && !_activeReceiveChunkState;
     });
 }
 
@@ -99,32 +100,52 @@ StatusWith<ScopedDonateChunk> ActiveMigrationsRegistry::registerDonateChunk(
         return _activeReceiveChunkState->constructErrorStatus();
     }
 
-    if (_activeMoveChunkState) {
-        if (_activeMoveChunkState->args == args) {
+    const auto logConflict = [&](const ActiveMoveChunkState& active) {
+        LOGV2(5004700,
+              "registerDonateChunk",
+              "currentKeys"_attr =
+                  ChunkRange(active.args.getMinKey(), active.args.getMaxKey()).toString(),
+              "currentToShardId"_attr = active.args.getToShardId(),
+              "currentNs"_attr = active.args.getNss().ns(),
+              "newKeys"_attr = ChunkRange(args.getMinKey(), args.getMaxKey()).toString(),
+              "newToShardId"_attr = args.getToShardId(),
+              "ns"_attr = args.getNss().ns());
+    };
+
+    auto it = _activeMoveChunkStates.find(args.getNss());
+    if (it != _activeMoveChunkStates.end()) {
+        if (it->second.args == args) {
             LOGV2(5004704,
                   "registerDonateChunk ",
                   "keys"_attr = ChunkRange(args.getMinKey(), args.getMaxKey()).toString(),
                   "toShardId"_attr = args.getToShardId(),
                   "ns"_attr = args.getNss().ns());
-            return {ScopedDonateChunk(nullptr, false, _activeMoveChunkState->notification)};
+            return {ScopedDonateChunk(nullptr, false, it->second.notification, args.getNss())};
         }
 
-        LOGV2(5004700,
-              "registerDonateChunk",
-              "currentKeys"_attr = ChunkRange(_activeMoveChunkState->args.getMinKey(),
-                                              _activeMoveChunkState->args.getMaxKey())
-                                       .toString(),
-              "currentToShardId"_attr = _activeMoveChunkState->args.getToShardId(),
-              "newKeys"_attr = ChunkRange(args.getMinKey(), args.getMaxKey()).toString(),
-              "newToShardId"_attr = args.getToShardId(),
-              "ns"_attr = args.getNss().ns());
+        logConflict(it->second);
+        return it->second.constructErrorStatus();
+    }
 
-        return _activeMoveChunkState->constructErrorStatus();
+    // The recipient can only receive one chunk at a time, so there is no point in starting a
+    // second migration towards it
+    for (const auto& [nss, active] : _activeMoveChunkStates) {
+        if (active.args.getToShardId() == args.getToShardId()) {
+            logConflict(active);
+            return active.constructErrorStatus();
+        }
+    }
+
+    if (_activeMoveChunkStates.size() >=
+        static_cast<size_t>(maxConcurrentChunkDonationsPerShard.load())) {
+        const auto& active = _activeMoveChunkStates.begin()->second;
+        logConflict(active);
+        return active.constructErrorStatus();
     }
 
-    _activeMoveChunkState.emplace(args);
+    it = _activeMoveChunkStates.emplace(args.getNss(), ActiveMoveChunkState(args)).first;
 
-    return {ScopedDonateChunk(this, true, _activeMoveChunkState->notification)};
+    return {ScopedDonateChunk(this, true, it->second.notification, args.getNss())};
 }
 
 StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
@@ -141,15 +162,15 @@ StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
         return _activeReceiveChunkState->constructErrorStatus();
     }
 
-    if (_activeMoveChunkState) {
+    if (!_activeMoveChunkStates.empty()) {
+        const auto& active = _activeMoveChunkStates.begin()->second;
         LOGV2(5004701,
               "registerReceiveChunk ",
-              "currentKeys"_attr = ChunkRange(_activeMoveChunkState->args.getMinKey(),
-                                              _activeMoveChunkState->args.getMaxKey())
-                                       .toString(),
-              "currentToShardId"_attr = _activeMoveChunkState->args.getToShardId(),
-              "ns"_attr = _activeMoveChunkState->args.getNss().ns());
-        return _activeMoveChunkState->constructErrorStatus();
+              "currentKeys"_attr =
+                  ChunkRange(active.args.getMinKey(), active.args.getMaxKey()).toString(),
+              "currentToShardId"_attr = active.args.getToShardId(),
+              "ns"_attr = active.args.getNss().ns());
+        return active.constructErrorStatus();
     }
 
     _activeReceiveChunkState.emplace(nss, chunkRange, fromShardId);
@@ -162,8 +183,7 @@ StatusWith<ScopedSplitMergeChunk> ActiveMigrationsRegistry::registerSplitOrMerge
     stdx::unique_lock<Latch> ul(_mutex);
 
     opCtx->waitForConditionOrInterrupt(_chunkOperationsStateChangedCV, ul, [&] {
-        return !(_activeMoveChunkState && _activeMoveChunkState->args.getNss() == nss) &&
-            !_activeSplitMergeChunkStates.count(nss);
+        return !_activeMoveChunkStates.count(nss) && !_activeSplitMergeChunkStates.count(nss);
     });
 
     auto [it, inserted] =
@@ -173,13 +193,15 @@ StatusWith<ScopedSplitMergeChunk> ActiveMigrationsRegistry::registerSplitOrMerge
     return {ScopedSplitMergeChunk(this, nss)};
 }
 
-boost::optional<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNss() {
+std::vector<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNss() {
     stdx::lock_guard<Latch> lk(_mutex);
-    if (_activeMoveChunkState) {
-        return _activeMoveChunkState->args.getNss();
+    std::vector<NamespaceString> namespaces;
+    namespaces.reserve(_activeMoveChunkStates.size());
+    for (const auto& entry : _activeMoveChunkStates) {
+        namespaces.push_back(entry.first);
     }
 
-    return boost::none;
+    return namespaces;
 }
 
 BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContext* opCtx) {
@@ -187,8 +209,10 @@ BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContex
     {
         stdx::lock_guard<Latch> lk(_mutex);
 
-        if (_activeMoveChunkState) {
-            nss = _activeMoveChunkState->args.getNss();
+        for (const auto& entry : _activeMoveChunkStates) {
+            if (!nss || entry.first < *nss) {
+                nss = entry.first;
+            }
         }
     }
 
@@ -210,16 +234,17 @@ BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContex
     return BSONObj();
 }
 
-void ActiveMigrationsRegistry::_clearDonateChunk() {
+void ActiveMigrationsRegistry::_clearDonateChunk(const NamespaceString& nss) {
     stdx::lock_guard<Latch> lk(_mutex);
-    invariant(_activeMoveChunkState);
+    auto it = _activeMoveChunkStates.find(nss);
+    invariant(it != _activeMoveChunkStates.end());
     LOGV2(5004702,
           "clearDonateChunk ",
-          "currentKeys"_attr = ChunkRange(_activeMoveChunkState->args.getMinKey(),
-                                          _activeMoveChunkState->args.getMaxKey())
-                                   .toString(),
-          "currentToShardId"_attr = _activeMoveChunkState->args.getToShardId());
-    _activeMoveChunkState.reset();
+          "currentKeys"_attr =
+              ChunkRange(it->second.args.getMinKey(), it->second.args.getMaxKey()).toString(),
+          "currentToShardId"_attr = it->second.args.getToShardId(),
+          "ns"_attr = nss.ns());
+    _activeMoveChunkStates.erase(it);
     _chunkOperationsStateChangedCV.notify_all();
 }
 
@@ -260,16 +285,18 @@ Status ActiveMigrationsRegistry::ActiveReceiveChunkState::constructErrorStatus()
 
 ScopedDonateChunk::ScopedDonateChunk(ActiveMigrationsRegistry* registry,
                                      bool shouldExecute,
-                                     std::shared_ptr<Notification<Status>> completionNotification)
+                                     std::shared_ptr<Notification<Status>> completionNotification,
+                                     NamespaceString nss)
     : _registry(registry),
       _shouldExecute(shouldExecute),
-      _completionNotification(std::move(completionNotification)) {}
+      _completionNotification(std::move(completionNotification)),
+      _nss(std::move(nss)) {}
 
 ScopedDonateChunk::~ScopedDonateChunk() {
     if (_registry && _shouldExecute) {
         // If this is a newly started migration the caller must always signal on completion
         invariant(*_completionNotification);
-        _registry->_clearDonateChunk();
+        _registry->_clearDonateChunk(_nss);
     }
 }
 
@@ -283,6 +310,7 @@ ScopedDonateChunk& ScopedDonateChunk::operator=(ScopedDonateChunk&& other) {
         other._registry = nullptr;
         _shouldExecute = other._shouldExecute;
         _completionNotification = std::move(other._completionNotification);
+        _nss = std::move(other._nss);
     }
 
     return *this;
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <vector>
 
 #include "mongo/db/s/migration_session_id.h"
 #include "mongo/platform/mutex.h"
@@ -50,8 +51,12 @@ class ScopedSplitMergeChunk;
  * It implements a non-fair lock manager, which provides the following guarantees:
  *
  *   - Move || Move (same chunk): The second move will join the first
- *   - Move || Move (different chunks or collections): The second move will result in a
- *                                                     ConflictingOperationInProgress error
+ *   - Move || Move (different chunks of the same collection, or to the same recipient): The
+ *                  second move will result in a ConflictingOperationInProgress error
+ *   - Move || Move (different collections, different recipients): The second move can proceed
+ *                  concurrently as long as fewer than 'maxConcurrentChunkDonationsPerShard'
+ *                  moves are active, otherwise it results in a ConflictingOperationInProgress
+ *                  error
  *   - Move || Split/Merge (same collection): The second operation will block behind the first
  *   - Move/Split/Merge || Split/Merge (for different collections): Can proceed concurrently
  */
@@ -76,7 +81,9 @@ public:
     void unlock(StringData reason);
 
     /**
-     * If there are no migrations or split/merges running on this shard, registers an active
+     * If there is no incoming migration on this shard, no split/merge or migration for the same
+     * collection, no migration to the same recipient and fewer than
+     * 'maxConcurrentChunkDonationsPerShard' migrations already running, registers an active
      * migration with the specified arguments. Returns a ScopedDonateChunk, which must be signaled
      * by the caller before it goes out of scope.
      *
@@ -112,16 +119,17 @@ public:
                                                                 const ChunkRange& chunkRange);
 
     /**
-     * If a migration has been previously registered through a call to registerDonateChunk, returns
-     * that namespace. Otherwise returns boost::none.
+     * Returns the namespaces of all the migrations which have been previously registered through
+     * a call to registerDonateChunk and are still active. The result is empty if there are none.
      */
-    boost::optional<NamespaceString> getActiveDonateChunkNss();
+    std::vector<NamespaceString> getActiveDonateChunkNss();
 
     /**
-     * Returns a report on the active migration if there currently is one. Otherwise, returns an
-     * empty BSONObj.
+     * Returns a report on an active migration if there currently is one. Otherwise, returns an
+     * empty BSONObj. If several migrations are active, the one for the namespace which sorts first
+     * is reported.
      *
-     * Takes an IS lock on the namespace of the active migration, if one is active.
+     * Takes an IS lock on the namespace of the reported migration, if one is active.
      */
     BSONObj getActiveMigrationStatusReport(OperationContext* opCtx);
 
@@ -182,9 +190,9 @@ private:
 
     /**
      * Unregisters a previously registered namespace with an ongoing migration. Must only be called
-     * if a previous call to registerDonateChunk has succeeded.
+     * if a previous call to registerDonateChunk for that namespace has succeeded.
      */
-    void _clearDonateChunk();
+    void _clearDonateChunk(const NamespaceString& nss);
 
     /**
      * Unregisters a previously registered incoming migration. Must only be called if a previous
@@ -209,8 +217,9 @@ private:
     // migration ongoing. Used during recovery and FCV changes.
     bool _migrationsBlocked{false};
 
-    // If there is an active moveChunk operation, this field contains the original request
-    boost::optional<ActiveMoveChunkState> _activeMoveChunkState;
+    // Contains an entry with the original request for every active moveChunk operation, keyed by
+    // the namespace being migrated
+    stdx::unordered_map<NamespaceString, ActiveMoveChunkState> _activeMoveChunkStates;
 
     // If there is an active chunk receive operation, this field contains the original session id
     boost::optional<ActiveReceiveChunkState> _activeReceiveChunkState;
@@ -252,7 +261,8 @@ class ScopedDonateChunk {
 public:
     ScopedDonateChunk(ActiveMigrationsRegistry* registry,
                       bool shouldExecute,
-                      std::shared_ptr<Notification<Status>> completionNotification);
+                      std::shared_ptr<Notification<Status>> completionNotification,
+                      NamespaceString nss);
     ~ScopedDonateChunk();
 
     ScopedDonateChunk(ScopedDonateChunk&&);
@@ -293,6 +303,9 @@ private:
 
     // This is the future, which will be signaled at the end of a migration
     std::shared_ptr<Notification<Status>> _completionNotification;
+
+    // Namespace of the migration, used to unregister it
+    NamespaceString _nss;
 };
 
 /**
@@ -34,6 +34,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/s/active_migrations_registry.h"
 #include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/s/request_types/move_chunk_request.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/unittest.h"
@@ -58,7 +59,8 @@ protected:
     ServiceContext::UniqueOperationContext _opCtx;
 };
 
-MoveChunkRequest createMoveChunkRequest(const NamespaceString& nss) {
+MoveChunkRequest createMoveChunkRequest(const NamespaceString& nss,
+                                        const ShardId& toShardId = ShardId("shard0002")) {
     const ChunkVersion chunkVersion(1, 2, OID::gen(), Timestamp());
 
     BSONObjBuilder builder;
@@ -67,7 +69,7 @@ MoveChunkRequest createMoveChunkRequest(const NamespaceString& nss) {
         nss,
         chunkVersion,
         ShardId("shard0001"),
-        ShardId("shard0002"),
+        toShardId,
         ChunkRange(BSON("Key" << -100), BSON("Key" << 100)),
         1024,
         MigrationSecondaryThrottleOptions::create(MigrationSecondaryThrottleOptions::kOff),
@@ -92,14 +94,16 @@ TEST_F(MoveChunkRegistration, ScopedDonateChunkMoveConstructorAndAssignment) {
 }
 
 TEST_F(MoveChunkRegistration, GetActiveMigrationNamespace) {
-    ASSERT(!_registry.getActiveDonateChunkNss());
+    ASSERT(_registry.getActiveDonateChunkNss().empty());
 
     const NamespaceString nss("TestDB", "TestColl");
 
     auto originalScopedDonateChunk =
         assertGet(_registry.registerDonateChunk(operationContext(), createMoveChunkRequest(nss)));
 
-    ASSERT_EQ(nss.ns(), _registry.getActiveDonateChunkNss()->ns());
+    const auto activeNss = _registry.getActiveDonateChunkNss();
+    ASSERT_EQ(1U, activeNss.size());
+    ASSERT_EQ(nss.ns(), activeNss.front().ns());
 
     // Need to signal the registered migration so the destructor doesn't invariant
     originalScopedDonateChunk.signalComplete(Status::OK());
@@ -117,6 +121,45 @@ TEST_F(MoveChunkRegistration, SecondMigrationReturnsConflictingOperationInProgre
     originalScopedDonateChunk.signalComplete(Status::OK());
 }
 
+TEST_F(MoveChunkRegistration, ConcurrentMigrationsOfDifferentCollectionsToDifferentShards) {
+    RAIIServerParameterControllerForTest controller("maxConcurrentChunkDonationsPerShard", 2);
+
+    auto firstScopedDonateChunk = assertGet(_registry.registerDonateChunk(
+        operationContext(),
+        createMoveChunkRequest(NamespaceString("TestDB", "TestColl1"), ShardId("shard0002"))));
+    ASSERT(firstScopedDonateChunk.mustExecute());
+
+    auto secondScopedDonateChunk = assertGet(_registry.registerDonateChunk(
+        operationContext(),
+        createMoveChunkRequest(NamespaceString("TestDB", "TestColl2"), ShardId("shard0003"))));
+    ASSERT(secondScopedDonateChunk.mustExecute());
+    ASSERT_EQ(2U, _registry.getActiveDonateChunkNss().size());
+
+    // Over the limit
+    auto thirdScopedDonateChunkStatus = _registry.registerDonateChunk(
+        operationContext(),
+        createMoveChunkRequest(NamespaceString("TestDB", "TestColl3"), ShardId("shard0004")));
+    ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
+              thirdScopedDonateChunkStatus.getStatus());
+
+    firstScopedDonateChunk.signalComplete(Status::OK());
+    secondScopedDonateChunk.signalComplete(Status::OK());
+}
+
+TEST_F(MoveChunkRegistration, ConcurrentMigrationsToTheSameShardConflict) {
+    RAIIServerParameterControllerForTest controller("maxConcurrentChunkDonationsPerShard", 2);
+
+    auto originalScopedDonateChunk = assertGet(_registry.registerDonateChunk(
+        operationContext(), createMoveChunkRequest(NamespaceString("TestDB", "TestColl1"))));
+
+    auto secondScopedDonateChunkStatus = _registry.registerDonateChunk(
+        operationContext(), createMoveChunkRequest(NamespaceString("TestDB", "TestColl2")));
+    ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
+              secondScopedDonateChunkStatus.getStatus());
+
+    originalScopedDonateChunk.signalComplete(Status::OK());
+}
+
 TEST_F(MoveChunkRegistration, SecondMigrationWithSameArgumentsJoinsFirst) {
     auto originalScopedDonateChunk = assertGet(_registry.registerDonateChunk(
         operationContext(), createMoveChunkRequest(NamespaceString("TestDB", "TestColl"))));
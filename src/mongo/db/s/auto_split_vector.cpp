@@ -44,13 +44,19 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 namespace {
 
 constexpr int estimatedAdditionalBytesPerItemInBSONArray{2};
 
+// Minimum number of sampled keys which must fall in each chunk resulting from a sampling-based
+// split, for the split points to be placed with reasonable accuracy.
+constexpr long long kMinSamplesPerSplittedChunk{10};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
@@ -130,6 +136,100 @@ auto orderShardKeyFields(const BSONObj& keyPattern, BSONObj& key) {
         prettyKey(keyPattern, key.getOwned()), keyPattern);
 }
 
+/*
+ * Estimates the split points of the range [min, max) from 'sampleSize' documents drawn at random
+ * from the collection, rather than from a scan of the shard key index. The fraction of samples
+ * falling in the range estimates its number of documents, which determines the number of chunks
+ * to create, and the split points are then placed at evenly spaced quantiles of the sampled keys.
+ *
+ * Returns boost::none if the storage engine doesn't support random cursors, if the range is not
+ * estimated to be worth more than one chunk, or if too few samples fell in the range. The caller
+ * must scan the index in those cases.
+ */
+boost::optional<std::vector<BSONObj>> sampleSplitKeys(OperationContext* opCtx,
+                                                      const CollectionPtr& collection,
+                                                      const BSONObj& keyPattern,
+                                                      const BSONObj& min,
+                                                      const BSONObj& max,
+                                                      long long totalLocalCollDocuments,
+                                                      long long maxDocsPerSplittedChunk,
+                                                      int sampleSize,
+                                                      BSONObjSet* tooFrequentKeys) {
+    auto randomCursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!randomCursor) {
+        return boost::none;
+    }
+
+    const ShardKeyPattern shardKeyPattern(keyPattern);
+    std::vector<BSONObj> sampledKeys;
+    long long numSamples = 0;
+    for (; numSamples < sampleSize; ++numSamples) {
+        if (numSamples % 128 == 0) {
+            opCtx->checkForInterrupt();
+        }
+
+        auto record = randomCursor->next();
+        if (!record) {
+            break;
+        }
+
+        auto key = shardKeyPattern.extractShardKeyFromDoc(record->data.toBson());
+        if (key.isEmpty() || key.woCompare(min) < 0 ||
+            (!max.isEmpty() && key.woCompare(max) >= 0)) {
+            continue;
+        }
+        sampledKeys.push_back(key.getOwned());
+    }
+
+    const long long numSamplesInRange = sampledKeys.size();
+    if (numSamplesInRange == 0) {
+        return boost::none;
+    }
+
+    // Each resulting chunk holds between maxDocsPerSplittedChunk and twice as many documents.
+    const long long estimatedDocsInRange = totalLocalCollDocuments * numSamplesInRange / numSamples;
+    const long long numChunks = estimatedDocsInRange / maxDocsPerSplittedChunk;
+
+    LOGV2_DEBUG(6170451,
+                2,
+                "Estimated number of documents in range from random samples",
+                "namespace"_attr = collection->ns(),
+                "numSamples"_attr = numSamples,
+                "numSamplesInRange"_attr = numSamplesInRange,
+                "estimatedDocsInRange"_attr = estimatedDocsInRange);
+
+    if (numChunks < 2 || numSamplesInRange < numChunks * kMinSamplesPerSplittedChunk) {
+        return boost::none;
+    }
+
+    std::sort(
+        sampledKeys.begin(), sampledKeys.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    std::vector<BSONObj> splitKeys;
+    std::size_t resultArraySize = 0;
+    for (long long i = 1; i < numChunks; ++i) {
+        const auto& splitKey = sampledKeys[i * numSamplesInRange / numChunks];
+        const auto& previousSplitPoint = splitKeys.empty() ? min : splitKeys.back();
+        if (splitKey.woCompare(previousSplitPoint) == 0) {
+            // Do not add again the same split point in case of frequent shard key.
+            tooFrequentKeys->insert(splitKey);
+            continue;
+        }
+
+        const auto additionalKeySize =
+            splitKey.objsize() + estimatedAdditionalBytesPerItemInBSONArray;
+        if (resultArraySize + additionalKeySize > BSONObjMaxUserSize) {
+            break;
+        }
+
+        resultArraySize += additionalKeySize;
+        splitKeys.push_back(splitKey);
+        LOGV2_DEBUG(6170452, 4, "Picked a sampled split key", "key"_attr = redact(splitKey));
+    }
+
+    return splitKeys;
+}
+
 }  // namespace
 
 std::vector<BSONObj> autoSplitVector(OperationContext* opCtx,
@@ -234,8 +334,27 @@ std::vector<BSONObj> autoSplitVector(OperationContext* opCtx,
 
         Timer timer;  // To measure time elapsed while searching split points
 
+        // When sampling is enabled, try to estimate the split points from random documents first,
+        // and only scan the index if the estimate can't be trusted.
+        bool usedSampling = false;
+        if (const auto sampleSize = autoSplitVectorSampleSize.load(); sampleSize > 0) {
+            if (auto sampledSplitKeys = sampleSplitKeys(opCtx,
+                                                        collection.getCollection(),
+                                                        keyPattern,
+                                                        min,
+                                                        max,
+                                                        totalLocalCollDocuments,
+                                                        maxDocsPerSplittedChunk,
+                                                        sampleSize,
+                                                        &tooFrequentKeys)) {
+                splitKeys = std::move(*sampledSplitKeys);
+                usedSampling = true;
+            }
+        }
+
         // Traverse the index and add the maxDocsPerSplittedChunk-th key to the result vector
-        while (forwardIdxScanner->getNext(&currentKey, nullptr) == PlanExecutor::ADVANCED) {
+        while (!usedSampling &&
+               forwardIdxScanner->getNext(&currentKey, nullptr) == PlanExecutor::ADVANCED) {
             numScannedKeys++;
 
             if (numScannedKeys > maxDocsPerSplittedChunk) {
@@ -274,7 +393,7 @@ std::vector<BSONObj> autoSplitVector(OperationContext* opCtx,
         // -- IF the right-most new chunk would be at least 90% full, further split by adding its
         // the middle key as last split point
         // -- ELSE keep a bigger last chunk (maxDocsPerSplittedChunk <= size < 90% maxDocsPerChunk)
-        if (!splitKeys.empty() && !reachedMaxBSONSize) {
+        if (!usedSampling && !splitKeys.empty() && !reachedMaxBSONSize) {
             splitKeys.pop_back();
 
             const auto lastChunkNumberOfDocs = numScannedKeys + maxDocsPerSplittedChunk;
@@ -72,6 +72,14 @@ namespace mongo {
  * that is equivalent to 90% `maxNumberOfDocsPerChunk`: choose the middle key `134` as split point .
  *
  * Returned split points: [49, 99, 134].
+ *
+ * SAMPLING
+ *
+ * If the `autoSplitVectorSampleSize` server parameter is set, a number of random documents is first
+ * drawn from the collection. The share of them whose shard key falls in `C` estimates the number
+ * of documents in `C`, hence the number of chunks to create, and the split points are placed at
+ * evenly spaced quantiles of the sampled shard keys. The index is scanned as described above only
+ * if random cursors are not supported or the samples are too few for the estimate to be accurate.
  */
 std::vector<BSONObj> autoSplitVector(OperationContext* opCtx,
                                      const NamespaceString& nss,
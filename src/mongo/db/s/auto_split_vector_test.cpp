@@ -39,6 +39,7 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/shard_server_test_fixture.h"
 #include "mongo/db/s/split_vector.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo {
 namespace {
@@ -177,6 +178,20 @@ TEST_F(AutoSplitVectorTest, FairLastSplitPoint) {
     ASSERT_BSONOBJ_EQ(splitKeys.at(0), expectedSplitPoint);
 }
 
+// Fall back to scanning the index when sampling is enabled but the storage engine doesn't support
+// random cursors.
+TEST_F(AutoSplitVectorTest, SamplingFallsBackToIndexScan) {
+    RAIIServerParameterControllerForTest sampleSize("autoSplitVectorSampleSize", 1000);
+
+    std::vector<BSONObj> splitKeys = autoSplit(operationContext(), 20 /* maxChunkSizeMB */);
+    ASSERT_EQ(splitKeys.size(), 9);
+    auto expectedSplitPoint = 9;
+    for (const auto& splitPoint : splitKeys) {
+        ASSERT_EQ(splitPoint.getIntField(kPattern), expectedSplitPoint);
+        expectedSplitPoint += 10;
+    }
+}
+
 // Throw exception upon calling autoSplitVector on dropped/unexisting collection
 TEST_F(AutoSplitVectorTest, NoCollection) {
     ASSERT_THROWS_CODE(autoSplitVector(operationContext(),
@@ -34,6 +34,7 @@
 #include "mongo/db/s/balancer/balancer_chunk_selection_policy_impl.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -62,10 +63,10 @@ namespace {
  * distribution and chunk placement information which is needed by the balancer policy.
  */
 StatusWith<DistributionStatus> createCollectionDistributionStatus(
-    OperationContext* opCtx,
     const NamespaceString& nss,
     const ShardStatisticsVector& allShards,
-    const ChunkManager& chunkMgr) {
+    const ChunkManager& chunkMgr,
+    const std::vector<TagsType>& collectionTags) {
     ShardToChunksMap shardToChunksMap;
 
     // Makes sure there is an entry in shardToChunksMap for every shard, so empty shards will also
@@ -88,14 +89,6 @@ StatusWith<DistributionStatus> createCollectionDistributionStatus(
         return true;
     });
 
-    const auto swCollectionTags =
-        Grid::get(opCtx)->catalogClient()->getTagsForCollection(opCtx, nss);
-    if (!swCollectionTags.isOK()) {
-        return swCollectionTags.getStatus().withContext(
-            str::stream() << "Unable to load tags for collection " << nss);
-    }
-    const auto& collectionTags = swCollectionTags.getValue();
-
     DistributionStatus distribution(nss, std::move(shardToChunksMap));
 
     // Cache the collection tags
@@ -115,6 +108,53 @@ StatusWith<DistributionStatus> createCollectionDistributionStatus(
     return {std::move(distribution)};
 }
 
+StatusWith<DistributionStatus> createCollectionDistributionStatus(
+    OperationContext* opCtx,
+    const NamespaceString& nss,
+    const ShardStatisticsVector& allShards,
+    const ChunkManager& chunkMgr) {
+    const auto swCollectionTags =
+        Grid::get(opCtx)->catalogClient()->getTagsForCollection(opCtx, nss);
+    if (!swCollectionTags.isOK()) {
+        return swCollectionTags.getStatus().withContext(
+            str::stream() << "Unable to load tags for collection " << nss);
+    }
+
+    return createCollectionDistributionStatus(
+        nss, allShards, chunkMgr, swCollectionTags.getValue());
+}
+
+/**
+ * Summarizes everything the balancer policy bases its migration decisions for a collection on,
+ * except for the chunks themselves. Any change of chunk ownership bumps the collection version, so
+ * if the summary has not changed, neither has the decision.
+ */
+BSONObj summarizeBalancingInputs(const ChunkManager& chunkMgr,
+                                 const std::vector<TagsType>& collectionTags,
+                                 const ShardStatisticsVector& allShards,
+                                 bool attemptToBalanceJumboChunks) {
+    BSONObjBuilder builder;
+    chunkMgr.getVersion().appendLegacyWithField(&builder, "version");
+    {
+        BSONArrayBuilder tagsBuilder(builder.subarrayStart("tags"));
+        for (const auto& tag : collectionTags) {
+            tagsBuilder.append(tag.toBSON());
+        }
+    }
+    {
+        BSONArrayBuilder shardsBuilder(builder.subarrayStart("shards"));
+        for (const auto& stat : allShards) {
+            BSONObjBuilder shardBuilder(shardsBuilder.subobjStart());
+            shardBuilder.append("id", stat.shardId.toString());
+            shardBuilder.append("draining", stat.isDraining);
+            shardBuilder.append("sizeMaxed", stat.isSizeMaxed());
+            shardBuilder.append("tags", stat.shardTags);
+        }
+    }
+    builder.append("attemptToBalanceJumboChunks", attemptToBalanceJumboChunks);
+    return builder.obj();
+}
+
 /**
  * Helper class used to accumulate the split points for the same chunk together so they can be
  * submitted to the shard as a single call versus multiple. This is necessary in order to avoid
@@ -275,6 +315,19 @@ BalancerChunkSelectionPolicyImpl::BalancerChunkSelectionPolicyImpl(ClusterStatis
 
 BalancerChunkSelectionPolicyImpl::~BalancerChunkSelectionPolicyImpl() = default;
 
+void BalancerChunkSelectionPolicyImpl::_pruneBalancedCollections(
+    const std::vector<CollectionType>& collections) {
+    stdx::lock_guard<Latch> lk(_balancedCollectionsMutex);
+    std::map<NamespaceString, BSONObj> stillPresent;
+    for (const auto& coll : collections) {
+        auto it = _balancedCollections.find(coll.getNss());
+        if (it != _balancedCollections.end()) {
+            stillPresent.emplace(coll.getNss(), std::move(it->second));
+        }
+    }
+    _balancedCollections = std::move(stillPresent);
+}
+
 StatusWith<SplitInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToSplit(
     OperationContext* opCtx) {
     auto shardStatsStatus = _clusterStats->getStats(opCtx);
@@ -363,13 +416,22 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
     }
 
     auto collections = Grid::get(opCtx)->catalogClient()->getCollections(opCtx, {});
+    _pruneBalancedCollections(collections);
     if (collections.empty()) {
         return MigrateInfoVector{};
     }
 
     MigrateInfoVector candidateChunks;
+
+    // Shards which can neither donate nor receive any more chunks in this round
     std::set<ShardId> usedShards;
 
+    // Shards which are donating chunks, but can still donate a chunk of another collection to
+    // another recipient
+    std::set<ShardId> donatingShards;
+    std::map<ShardId, int> numDonationsPerShard;
+    const int maxDonationsPerShard = balancerMaxConcurrentDonationsPerShard.load();
+
     std::shuffle(collections.begin(), collections.end(), _random);
 
     for (const auto& coll : collections) {
@@ -387,8 +449,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
-        auto candidatesStatus =
-            _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
+        auto candidatesStatus = _getMigrateCandidatesForCollection(
+            opCtx, nss, shardStats, &usedShards, donatingShards);
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
             // Namespace got dropped before we managed to get to it, so just skip it
             continue;
@@ -401,6 +463,17 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
+        // The balancer policy marks donors as used, so release the ones which are allowed to
+        // donate more chunks concurrently
+        for (const auto& migration : candidatesStatus.getValue()) {
+            if (++numDonationsPerShard[migration.from] < maxDonationsPerShard) {
+                usedShards.erase(migration.from);
+                donatingShards.insert(migration.from);
+            } else {
+                donatingShards.erase(migration.from);
+            }
+        }
+
         candidateChunks.insert(candidateChunks.end(),
                                std::make_move_iterator(candidatesStatus.getValue().begin()),
                                std::make_move_iterator(candidatesStatus.getValue().end()));
@@ -550,7 +623,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
     OperationContext* opCtx,
     const NamespaceString& nss,
     const ShardStatisticsVector& shardStats,
-    std::set<ShardId>* usedShards) {
+    std::set<ShardId>* usedShards,
+    const std::set<ShardId>& donatingShards) {
     auto routingInfoStatus =
         Grid::get(opCtx)->catalogCache()->getShardedCollectionRoutingInfoWithRefresh(opCtx, nss);
     if (!routingInfoStatus.isOK()) {
@@ -561,7 +635,37 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
 
     const auto& shardKeyPattern = cm.getShardKeyPattern().getKeyPattern();
 
-    const auto collInfoStatus = createCollectionDistributionStatus(opCtx, nss, shardStats, cm);
+    const auto swCollectionTags =
+        Grid::get(opCtx)->catalogClient()->getTagsForCollection(opCtx, nss);
+    if (!swCollectionTags.isOK()) {
+        return swCollectionTags.getStatus().withContext(
+            str::stream() << "Unable to load tags for collection " << nss);
+    }
+    const auto& collectionTags = swCollectionTags.getValue();
+
+    const bool attemptToBalanceJumboChunks =
+        Grid::get(opCtx)->getBalancerConfiguration()->attemptToBalanceJumboChunks();
+    const auto balancingInputs =
+        summarizeBalancingInputs(cm, collectionTags, shardStats, attemptToBalanceJumboChunks);
+
+    // Only a decision made with every shard available is worth remembering, since busy shards are
+    // the only other reason for the policy to find nothing to move.
+    const bool canUseBalancedCache = usedShards->empty() && donatingShards.empty();
+    if (canUseBalancedCache) {
+        stdx::lock_guard<Latch> lk(_balancedCollectionsMutex);
+        auto it = _balancedCollections.find(nss);
+        if (it != _balancedCollections.end() && it->second.binaryEqual(balancingInputs)) {
+            LOGV2_DEBUG(6170457,
+                        2,
+                        "Skipping collection whose chunk distribution has not changed since it was "
+                        "last found balanced",
+                        "namespace"_attr = nss);
+            return MigrateInfoVector{};
+        }
+    }
+
+    const auto collInfoStatus =
+        createCollectionDistributionStatus(nss, shardStats, cm, collectionTags);
     if (!collInfoStatus.isOK()) {
         return collInfoStatus.getStatus();
     }
@@ -603,11 +707,19 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
         }
     }
 
-    return BalancerPolicy::balance(
-        shardStats,
-        distribution,
-        usedShards,
-        Grid::get(opCtx)->getBalancerConfiguration()->attemptToBalanceJumboChunks());
+    auto migrations = BalancerPolicy::balance(
+        shardStats, distribution, usedShards, attemptToBalanceJumboChunks, donatingShards);
+
+    if (canUseBalancedCache) {
+        stdx::lock_guard<Latch> lk(_balancedCollectionsMutex);
+        if (migrations.empty()) {
+            _balancedCollections[nss] = balancingInputs;
+        } else {
+            _balancedCollections.erase(nss);
+        }
+    }
+
+    return migrations;
 }
 
 }  // namespace mongo
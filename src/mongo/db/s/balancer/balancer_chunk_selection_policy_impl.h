@@ -31,10 +31,12 @@
 
 #include "mongo/db/s/balancer/balancer_chunk_selection_policy.h"
 #include "mongo/db/s/balancer/balancer_random.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
 class ClusterStatistics;
+class CollectionType;
 
 class BalancerChunkSelectionPolicyImpl final : public BalancerChunkSelectionPolicy {
 public:
@@ -70,13 +72,20 @@ private:
 
     /**
      * Synchronous method, which iterates the collection's chunks and uses the cluster statistics to
-     * figure out where to place them.
+     * figure out where to place them. The shards in 'donatingShards' may still donate, but must
+     * not receive chunks.
      */
     StatusWith<MigrateInfoVector> _getMigrateCandidatesForCollection(
         OperationContext* opCtx,
         const NamespaceString& nss,
         const ShardStatisticsVector& shardStats,
-        std::set<ShardId>* usedShards);
+        std::set<ShardId>* usedShards,
+        const std::set<ShardId>& donatingShards = {});
+
+    /**
+     * Forgets the balancing decisions of collections which are not in 'collections' anymore.
+     */
+    void _pruneBalancedCollections(const std::vector<CollectionType>& collections);
 
     // Source for obtaining cluster statistics. Not owned and must not be destroyed before the
     // policy object is destroyed.
@@ -84,6 +93,13 @@ private:
 
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // For the collections which the policy last found to need no migrations, a summary of the
+    // inputs to that decision. While the summary stays the same, the collection's chunks do not
+    // have to be read again.
+    Mutex _balancedCollectionsMutex =
+        MONGO_MAKE_LATCH("BalancerChunkSelectionPolicyImpl::_balancedCollectionsMutex");
+    std::map<NamespaceString, BSONObj> _balancedCollections;
 };
 
 }  // namespace mongo
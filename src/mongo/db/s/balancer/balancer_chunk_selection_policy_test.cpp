@@ -329,5 +329,55 @@ TEST_F(BalancerChunkSelectionTest, ShardedTimeseriesCollectionsCannotBeBalanced)
     future.default_timed_get();
 }
 
+TEST_F(BalancerChunkSelectionTest, BalancedCollectionIsReevaluatedWhenShardStartsDraining) {
+    // Set up two shards in the metadata.
+    ASSERT_OK(catalogClient()->insertConfigDocument(
+        operationContext(), ShardType::ConfigNS, kShard0, kMajorityWriteConcern));
+    ASSERT_OK(catalogClient()->insertConfigDocument(
+        operationContext(), ShardType::ConfigNS, kShard1, kMajorityWriteConcern));
+
+    // Set up a database and a sharded collection whose chunks are spread evenly over both shards.
+    const auto collUUID = UUID::gen();
+    ChunkVersion version(2, 0, OID::gen(), Timestamp(42));
+    setUpDatabase(kDbName, kShardId0);
+    setUpCollection(kNamespace, collUUID, version);
+
+    setUpChunk(
+        kNamespace, collUUID, kKeyPattern.globalMin(), BSON(kPattern << 0), kShardId0, version);
+    version.incMinor();
+    setUpChunk(
+        kNamespace, collUUID, BSON(kPattern << 0), kKeyPattern.globalMax(), kShardId1, version);
+
+    auto future = launchAsync([this] {
+        ThreadClient tc(getServiceContext());
+        auto opCtx = Client::getCurrent()->makeOperationContext();
+
+        shardTargeterMock(opCtx.get(), kShardId0)->setFindHostReturnValue(kShardHost0);
+        shardTargeterMock(opCtx.get(), kShardId1)->setFindHostReturnValue(kShardHost1);
+
+        auto candidateChunksStatus = _chunkSelectionPolicy.get()->selectChunksToMove(opCtx.get());
+        ASSERT_OK(candidateChunksStatus.getStatus());
+        ASSERT_EQUALS(0, candidateChunksStatus.getValue().size());
+
+        // The collection's chunks have not changed, but a draining shard must still be emptied.
+        ASSERT_OK(catalogClient()->updateConfigDocument(
+            opCtx.get(),
+            ShardType::ConfigNS,
+            BSON(ShardType::name(kShardId1.toString())),
+            BSON("$set" << BSON(ShardType::draining(true))),
+            false,
+            kMajorityWriteConcern));
+
+        candidateChunksStatus = _chunkSelectionPolicy.get()->selectChunksToMove(opCtx.get());
+        ASSERT_OK(candidateChunksStatus.getStatus());
+        ASSERT_EQUALS(1, candidateChunksStatus.getValue().size());
+        ASSERT_EQUALS(kShardId1, candidateChunksStatus.getValue()[0].from);
+    });
+
+    expectGetStatsCommands(2);
+    expectGetStatsCommands(2);
+    future.default_timed_get();
+}
+
 }  // namespace
 }  // namespace mongo
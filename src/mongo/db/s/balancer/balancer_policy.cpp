@@ -254,12 +254,13 @@ Status BalancerPolicy::isShardSuitableReceiver(const ClusterStatistics::ShardSta
 ShardId BalancerPolicy::_getLeastLoadedReceiverShard(const ShardStatisticsVector& shardStats,
                                                      const DistributionStatus& distribution,
                                                      const string& tag,
-                                                     const set<ShardId>& excludedShards) {
+                                                     const set<ShardId>& excludedShards,
+                                                     const set<ShardId>& donatingShards) {
     ShardId best;
     unsigned minChunks = numeric_limits<unsigned>::max();
 
     for (const auto& stat : shardStats) {
-        if (excludedShards.count(stat.shardId))
+        if (excludedShards.count(stat.shardId) || donatingShards.count(stat.shardId))
             continue;
 
         auto status = isShardSuitableReceiver(stat, tag);
@@ -370,7 +371,8 @@ MigrateInfo chooseRandomMigration(const ShardStatisticsVector& shardStats,
 vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             std::set<ShardId>* usedShards,
-                                            bool forceJumbo) {
+                                            bool forceJumbo,
+                                            const std::set<ShardId>& donatingShards) {
     vector<MigrateInfo> migrations;
 
     if (MONGO_unlikely(balancerShouldReturnRandomMigrations.shouldFail()) &&
@@ -412,8 +414,8 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
 
                 const string tag = distribution.getTagForChunk(chunk);
 
-                const ShardId to =
-                    _getLeastLoadedReceiverShard(shardStats, distribution, tag, *usedShards);
+                const ShardId to = _getLeastLoadedReceiverShard(
+                    shardStats, distribution, tag, *usedShards, donatingShards);
                 if (!to.isValid()) {
                     if (migrations.empty()) {
                         LOGV2_WARNING(21889,
@@ -472,8 +474,8 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                     continue;
                 }
 
-                const ShardId to =
-                    _getLeastLoadedReceiverShard(shardStats, distribution, tag, *usedShards);
+                const ShardId to = _getLeastLoadedReceiverShard(
+                    shardStats, distribution, tag, *usedShards, donatingShards);
                 if (!to.isValid()) {
                     if (migrations.empty()) {
                         LOGV2_WARNING(21892,
@@ -544,6 +546,7 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
                                   idealNumberOfChunksPerShardForTag,
                                   &migrations,
                                   usedShards,
+                                  donatingShards,
                                   forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
                                              : MoveChunkRequest::ForceJumbo::kDoNotForce))
             ;
@@ -574,6 +577,7 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
                                         size_t idealNumberOfChunksPerShardForTag,
                                         vector<MigrateInfo>* migrations,
                                         set<ShardId>* usedShards,
+                                        const set<ShardId>& donatingShards,
                                         MoveChunkRequest::ForceJumbo forceJumbo) {
     const ShardId from = _getMostOverloadedShard(shardStats, distribution, tag, *usedShards);
     if (!from.isValid())
@@ -585,7 +589,8 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     if (max <= idealNumberOfChunksPerShardForTag)
         return false;
 
-    const ShardId to = _getLeastLoadedReceiverShard(shardStats, distribution, tag, *usedShards);
+    const ShardId to =
+        _getLeastLoadedReceiverShard(shardStats, distribution, tag, *usedShards, donatingShards);
     if (!to.isValid()) {
         if (migrations->empty()) {
             LOGV2(21882,
@@ -235,11 +235,16 @@ public:
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
      * shard.
+     *
+     * The donatingShards parameter contains shards, which are already donating a chunk but have
+     * capacity to donate another one concurrently. They may be chosen as donors, but never as
+     * recipients, since a shard cannot receive a chunk while it is donating.
      */
     static std::vector<MigrateInfo> balance(const ShardStatisticsVector& shardStats,
                                             const DistributionStatus& distribution,
                                             std::set<ShardId>* usedShards,
-                                            bool forceJumbo);
+                                            bool forceJumbo,
+                                            const std::set<ShardId>& donatingShards = {});
 
     /**
      * Using the specified distribution information, returns a suggested better location for the
@@ -252,12 +257,13 @@ public:
 private:
     /**
      * Return the shard with the specified tag, which has the least number of chunks. If the tag is
-     * empty, considers all shards.
+     * empty, considers all shards. Shards in either excludedShards or donatingShards are skipped.
      */
     static ShardId _getLeastLoadedReceiverShard(const ShardStatisticsVector& shardStats,
                                                 const DistributionStatus& distribution,
                                                 const std::string& tag,
-                                                const std::set<ShardId>& excludedShards);
+                                                const std::set<ShardId>& excludedShards,
+                                                const std::set<ShardId>& donatingShards = {});
 
     /**
      * Return the shard which has the least number of chunks with the specified tag. If the tag is
@@ -286,6 +292,7 @@ private:
                                    size_t idealNumberOfChunksPerShardForTag,
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards,
+                                   const std::set<ShardId>& donatingShards,
                                    MoveChunkRequest::ForceJumbo forceJumbo);
 };
 
@@ -279,6 +279,30 @@ TEST(BalancerPolicy, ParallelBalancingNotSchedulingOnInUseSourceShardsWithMoveNo
     ASSERT_EQ(0U, migrations.size());
 }
 
+TEST(BalancerPolicy, ParallelBalancingSchedulesOnDonatingShardsOnlyAsSource) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 8, false, emptyTagSet, emptyShardVersion), 8},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0},
+         {ShardStatistics(kShardId2, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId3, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    // Here kShardId0 and kShardId1 are donating chunks of other collections
+    std::set<ShardId> usedShards;
+    const std::set<ShardId> donatingShards{kShardId0, kShardId1};
+    const auto migrations(BalancerPolicy::balance(cluster.first,
+                                                  DistributionStatus(kNamespace, cluster.second),
+                                                  &usedShards,
+                                                  false,
+                                                  donatingShards));
+    ASSERT_EQ(1U, migrations.size());
+
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId2, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(cluster.second[kShardId0][0].getMax(), migrations[0].maxKey);
+    ASSERT_EQ(MigrateInfo::chunksImbalance, migrations[0].reason);
+}
+
 TEST(BalancerPolicy, ParallelBalancingNotSchedulingOnInUseDestinationShards) {
     auto cluster = generateCluster(
         {{ShardStatistics(kShardId0, kNoMaxSize, 4, false, emptyTagSet, emptyShardVersion), 4},
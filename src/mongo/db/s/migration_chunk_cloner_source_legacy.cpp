@@ -49,6 +49,7 @@
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/s/start_chunk_clone_request.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/executor/task_executor.h"
@@ -655,38 +656,24 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
-
-    for (; iter != _cloneLocs.end(); ++iter) {
-        // We must always make progress in this method by at least one document because empty
-        // return indicates there is no more initial clone data.
-        if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
-            break;
-        }
-
-        auto nextRecordId = *iter;
+    auto cursor = collection->getCursor(opCtx);
 
-        lk.unlock();
-
-        Snapshotted<BSONObj> doc;
-        if (collection->findDoc(opCtx, nextRecordId, &doc)) {
-            // Use the builder size instead of accumulating the document sizes directly so
-            // that we take into consideration the overhead of BSONArray indices.
-            if (arrBuilder->arrSize() &&
-                (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
-
-                break;
-            }
-
-            arrBuilder->append(doc.value());
-            ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(1);
-        }
+    stdx::unique_lock<Latch> lk(_mutex);
+    const auto averageObjectSize = _averageObjectSizeForCloneLocs;
+    lk.unlock();
 
-        lk.lock();
-    }
+    // This is the only thread which modifies _cloneLocs, so it can be read without the mutex. The
+    // mutex is only needed to modify it, since other threads read its size.
+    const auto numArrayElementsBefore = arrBuilder->arrSize();
+    const auto numConsumed =
+        xferCloneLocs(arrBuilder, _cloneLocs, cursor.get(), averageObjectSize, [&] {
+            return tracker.intervalHasElapsed();
+        });
+    ShardingStatistics::get(opCtx).countDocsClonedOnDonor.addAndFetch(arrBuilder->arrSize() -
+                                                                      numArrayElementsBefore);
 
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
+    lk.lock();
+    _cloneLocs.erase(_cloneLocs.begin(), std::next(_cloneLocs.begin(), numConsumed));
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
@@ -999,6 +986,56 @@ long long xferMods(BSONArrayBuilder* arr,
     return totalSize;
 }
 
+size_t xferCloneLocs(BSONArrayBuilder* arr,
+                     const std::set<RecordId>& cloneLocs,
+                     SeekableRecordCursor* cursor,
+                     uint64_t averageObjectSize,
+                     std::function<bool()> shouldStopFn) {
+    const size_t kMaxLookupGroupSize = 128;
+
+    size_t numConsumed = 0;
+    auto iter = cloneLocs.begin();
+    while (iter != cloneLocs.end()) {
+        // Only look up about as many documents as are expected to fit in the rest of the batch, so
+        // that little work is wasted on documents which will not be sent
+        const int64_t remainingBytes = std::max(BSONObjMaxUserSize - arr->len(), 0);
+        const auto expectedDocs = remainingBytes / std::max<int64_t>(averageObjectSize, 1);
+        const size_t groupSize =
+            std::min<size_t>(std::max<int64_t>(expectedDocs, 1), kMaxLookupGroupSize);
+
+        std::vector<RecordId> ids;
+        ids.reserve(groupSize);
+        for (; iter != cloneLocs.end() && ids.size() < groupSize; ++iter) {
+            ids.push_back(*iter);
+        }
+
+        const auto records = cursor->seekExactBatch(ids);
+        for (const auto& record : records) {
+            // We must always make progress in this method by at least one document because empty
+            // return indicates there is no more initial clone data.
+            if (arr->arrSize() && shouldStopFn()) {
+                return numConsumed;
+            }
+
+            if (record) {
+                const auto doc = record->data.toBson();
+
+                // Use the builder size instead of accumulating the document sizes directly so
+                // that we take into consideration the overhead of BSONArray indices.
+                if (arr->arrSize() && (arr->len() + doc.objsize() + 1024) > BSONObjMaxUserSize) {
+                    return numConsumed;
+                }
+
+                arr->append(doc);
+            }
+
+            ++numConsumed;
+        }
+    }
+
+    return numConsumed;
+}
+
 Status MigrationChunkClonerSourceLegacy::_checkRecipientCloningStatus(OperationContext* opCtx,
                                                                       Milliseconds maxTimeToWait) {
     const auto startTime = Date_t::now();
@@ -55,6 +55,7 @@ class Collection;
 class CollectionPtr;
 class Database;
 class RecordId;
+class SeekableRecordCursor;
 
 // Overhead to prevent mods buffers from being too large
 const long long kFixedCommandOverhead = 32 * 1024;
@@ -397,4 +398,19 @@ long long xferMods(BSONArrayBuilder* arr,
                    long long initialSize,
                    std::function<bool(BSONObj, BSONObj*)> extractDocToAppendFn);
 
+/**
+ * Appends to the builder the documents for the record ids in 'cloneLocs', in increasing record id
+ * order, until the builder is full or 'shouldStopFn' returns true. The documents are looked up
+ * through 'cursor' in groups sized after 'averageObjectSize', so that consecutive lookups can reuse
+ * the position of the cursor. At least one document is appended if 'cloneLocs' has any that still
+ * exists. Does not modify 'cloneLocs'.
+ * Returns the number of record ids from the start of 'cloneLocs' which were consumed, either
+ * because their document was appended or because it no longer exists.
+ */
+size_t xferCloneLocs(BSONArrayBuilder* arr,
+                     const std::set<RecordId>& cloneLocs,
+                     SeekableRecordCursor* cursor,
+                     uint64_t averageObjectSize,
+                     std::function<bool()> shouldStopFn);
+
 }  // namespace mongo
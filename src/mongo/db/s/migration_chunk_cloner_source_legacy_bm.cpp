@@ -32,6 +32,7 @@
 #include <benchmark/benchmark.h>
 
 #include "migration_chunk_cloner_source_legacy.h"
+#include "mongo/db/storage/record_store.h"
 
 namespace mongo {
 namespace {
@@ -75,5 +76,81 @@ void BM_xferDeletes(benchmark::State& state) {
 
 BENCHMARK(BM_xferDeletes)->ArgsProduct({{0, 25, 50, 75, 100}, {1, 1024, 2048}});
 
+/**
+ * Record cursor over an in-memory map of documents, used to measure the cost of the clone batch
+ * building loop without a storage engine.
+ */
+class InMemoryRecordCursor : public SeekableRecordCursor {
+public:
+    explicit InMemoryRecordCursor(const std::map<RecordId, BSONObj>& records)
+        : _records(records), _it(_records.end()) {}
+
+    boost::optional<Record> next() override {
+        if (_it == _records.end() || ++_it == _records.end())
+            return boost::none;
+        return _current();
+    }
+
+    boost::optional<Record> seekExact(const RecordId& id) override {
+        _it = _records.find(id);
+        if (_it == _records.end())
+            return boost::none;
+        return _current();
+    }
+
+    boost::optional<Record> seekNear(const RecordId& start) override {
+        _it = _records.lower_bound(start);
+        if (_it == _records.end())
+            return boost::none;
+        return _current();
+    }
+
+    void save() override {}
+    bool restore() override {
+        return true;
+    }
+    void detachFromOperationContext() override {}
+    void reattachToOperationContext(OperationContext* opCtx) override {}
+
+private:
+    Record _current() const {
+        return {_it->first, RecordData(_it->second.objdata(), _it->second.objsize())};
+    }
+
+    const std::map<RecordId, BSONObj>& _records;
+    std::map<RecordId, BSONObj>::const_iterator _it;
+};
+
+void BM_xferCloneLocs(benchmark::State& state) {
+    const int numDocs = 2000;
+    int percentInChunk = state.range(0);
+    int docSizeInBytes = state.range(1);
+
+    std::map<RecordId, BSONObj> records;
+    std::set<RecordId> cloneLocs;
+    for (int i = 0; i < numDocs; i++) {
+        records.emplace(RecordId(i + 1), createCollectionDocumentWithSize(i, docSizeInBytes));
+        if (i % 100 < percentInChunk) {
+            cloneLocs.insert(RecordId(i + 1));
+        }
+    }
+
+    for (auto _ : state) {
+        InMemoryRecordCursor cursor(records);
+        BSONObjBuilder builder;
+        BSONArrayBuilder arr(builder.subarrayStart("objects"));
+        auto start = mongo::stdx::chrono::high_resolution_clock::now();
+        benchmark::DoNotOptimize(
+            xferCloneLocs(&arr, cloneLocs, &cursor, docSizeInBytes, [] { return false; }));
+        auto end = mongo::stdx::chrono::high_resolution_clock::now();
+        auto elapsed_seconds =
+            mongo::stdx::chrono::duration_cast<mongo::stdx::chrono::nanoseconds>(end - start);
+        state.SetIterationTime(elapsed_seconds.count());
+        arr.done();
+    }
+}
+
+BENCHMARK(BM_xferCloneLocs)->ArgsProduct({{10, 50, 100}, {1, 1024, 2048}});
+
 }  // namespace
 }  // namespace mongo
@@ -53,7 +53,7 @@ namespace {
 
 /**
  * Shortcut class to perform the appropriate checks and acquire the cloner associated with the
- * currently active migration. Uses the currently registered migration for this shard and ensures
+ * currently active migration. Uses the migrations currently registered for this shard and ensures
  * the session ids match.
  */
 class AutoGetActiveCloner {
@@ -64,18 +64,27 @@ public:
     AutoGetActiveCloner(OperationContext* opCtx,
                         const MigrationSessionId& migrationSessionId,
                         const bool holdCollectionLock) {
-        const auto nss = ActiveMigrationsRegistry::get(opCtx).getActiveDonateChunkNss();
-        uassert(ErrorCodes::NotYetInitialized, "No active migrations were found", nss);
-
-        // Once the collection is locked, the migration status cannot change
-        _autoColl.emplace(opCtx, *nss, MODE_IS);
+        const auto activeNss = ActiveMigrationsRegistry::get(opCtx).getActiveDonateChunkNss();
+        uassert(
+            ErrorCodes::NotYetInitialized, "No active migrations were found", !activeNss.empty());
+
+        // Several migrations for different collections may be active at the same time, so look for
+        // the one whose cloner owns the requested session
+        for (const auto& nss : activeNss) {
+            // Once the collection is locked, the migration status cannot change
+            _autoColl.emplace(opCtx, nss, MODE_IS);
+
+            // A migration which is being torn down must not prevent finding the other ones
+            const bool mayBeOtherMigration = activeNss.size() > 1;
+            if (!_autoColl->getCollection() && mayBeOtherMigration) {
+                continue;
+            }
 
-        uassert(ErrorCodes::NamespaceNotFound,
-                str::stream() << "Collection " << nss->ns() << " does not exist",
-                _autoColl->getCollection());
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << nss.ns() << " does not exist",
+                    _autoColl->getCollection());
 
-        {
-            auto csr = CollectionShardingRuntime::get(opCtx, *nss);
+            auto csr = CollectionShardingRuntime::get(opCtx, nss);
             auto csrLock = CollectionShardingRuntime::CSRLock::lockShared(opCtx, csr);
 
             if (auto msm = MigrationSourceManager::get(csr, csrLock)) {
@@ -84,13 +93,22 @@ public:
                     std::dynamic_pointer_cast<MigrationChunkClonerSourceLegacy,
                                               MigrationChunkClonerSource>(msm->getCloner());
                 invariant(_chunkCloner);
-            } else {
+
+                if (migrationSessionId.matches(_chunkCloner->getSessionId())) {
+                    break;
+                }
+            } else if (!mayBeOtherMigration) {
                 uasserted(ErrorCodes::IllegalOperation,
                           str::stream()
-                              << "No active migrations were found for collection " << nss->ns());
+                              << "No active migrations were found for collection " << nss.ns());
             }
         }
 
+        uassert(ErrorCodes::NotYetInitialized,
+                str::stream() << "No active migration was found for session id "
+                              << migrationSessionId.toString(),
+                _chunkCloner);
+
         // Ensure the session ids are correct
         uassert(ErrorCodes::IllegalOperation,
                 str::stream() << "Requested migration session id " << migrationSessionId.toString()
@@ -98,7 +116,6 @@ public:
                               << _chunkCloner->getSessionId().toString(),
                 migrationSessionId.matches(_chunkCloner->getSessionId()));
 
-
         if (!holdCollectionLock)
             _autoColl = boost::none;
     }
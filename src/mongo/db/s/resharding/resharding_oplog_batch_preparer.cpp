@@ -37,6 +37,8 @@
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/repl/apply_ops.h"
+#include "mongo/db/repl/oplog_applier_utils.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/s/resharding/resharding_server_parameters_gen.h"
 #include "mongo/logv2/redaction.h"
 #include "mongo/util/assert_util.h"
@@ -104,10 +106,11 @@ WriterVectors ReshardingOplogBatchPreparer::makeCrudOpWriterVectors(
     invariant(derivedOps.empty());
 
     auto writerVectors = _makeEmptyWriterVectors();
+    auto writerAssignments = _makeWriterAssignments(writerVectors);
 
     for (const auto& op : batch) {
         if (op.isCrudOpType()) {
-            _appendCrudOpToWriterVector(&op, writerVectors);
+            _appendCrudOpToWriterVector(&op, writerVectors, writerAssignments.get_ptr());
         } else if (op.isCommand()) {
             throwIfUnsupportedCommandOp(op);
 
@@ -137,7 +140,8 @@ WriterVectors ReshardingOplogBatchPreparer::makeCrudOpWriterVectors(
 
                 // `&derivedOp` is guaranteed to remain stable while we append more derived oplog
                 // entries because `derivedOps` is a std::list.
-                _appendCrudOpToWriterVector(&derivedOp, writerVectors);
+                _appendCrudOpToWriterVector(
+                    &derivedOp, writerVectors, writerAssignments.get_ptr());
             }
         } else {
             invariant(repl::OpTypeEnum::kNoop == op.getOpType());
@@ -196,9 +200,10 @@ WriterVectors ReshardingOplogBatchPreparer::makeSessionOpWriterVectors(
         }
     }
 
+    auto writerAssignments = _makeWriterAssignments(writerVectors);
     for (auto& [lsid, opList] : sessionTracker) {
         for (auto& op : opList.ops) {
-            _appendSessionOpToWriterVector(lsid, op, writerVectors);
+            _appendSessionOpToWriterVector(lsid, op, writerVectors, writerAssignments.get_ptr());
         }
     }
 
@@ -209,8 +214,18 @@ WriterVectors ReshardingOplogBatchPreparer::_makeEmptyWriterVectors() const {
     return WriterVectors(size_t(resharding::gReshardingOplogBatchTaskCount.load()));
 }
 
-void ReshardingOplogBatchPreparer::_appendCrudOpToWriterVector(const OplogEntry* op,
-                                                               WriterVectors& writerVectors) const {
+boost::optional<repl::WriterAssignments> ReshardingOplogBatchPreparer::_makeWriterAssignments(
+    const WriterVectors& writerVectors) const {
+    if (!repl::oplogApplicationBalanceWriters.load()) {
+        return boost::none;
+    }
+    return repl::WriterAssignments(writerVectors.size());
+}
+
+void ReshardingOplogBatchPreparer::_appendCrudOpToWriterVector(
+    const OplogEntry* op,
+    WriterVectors& writerVectors,
+    repl::WriterAssignments* writerAssignments) const {
     BSONElementComparator elementHasher{BSONElementComparator::FieldNamesMode::kIgnore,
                                         _defaultCollator.get()};
 
@@ -219,19 +234,26 @@ void ReshardingOplogBatchPreparer::_appendCrudOpToWriterVector(const OplogEntry*
     uint32_t hash = 0;
     MurmurHash3_x86_32(&idHash, sizeof(idHash), hash, &hash);
 
-    _appendOpToWriterVector(hash, op, writerVectors);
+    _appendOpToWriterVector(hash, op, writerVectors, writerAssignments);
 }
 
 void ReshardingOplogBatchPreparer::_appendSessionOpToWriterVector(
-    const LogicalSessionId& lsid, const OplogEntry* op, WriterVectors& writerVectors) const {
+    const LogicalSessionId& lsid,
+    const OplogEntry* op,
+    WriterVectors& writerVectors,
+    repl::WriterAssignments* writerAssignments) const {
     LogicalSessionIdHash lsidHasher;
-    _appendOpToWriterVector(lsidHasher(lsid), op, writerVectors);
+    _appendOpToWriterVector(lsidHasher(lsid), op, writerVectors, writerAssignments);
 }
 
-void ReshardingOplogBatchPreparer::_appendOpToWriterVector(std::uint32_t hash,
-                                                           const OplogEntry* op,
-                                                           WriterVectors& writerVectors) const {
-    auto& writer = writerVectors[hash % writerVectors.size()];
+void ReshardingOplogBatchPreparer::_appendOpToWriterVector(
+    std::uint32_t hash,
+    const OplogEntry* op,
+    WriterVectors& writerVectors,
+    repl::WriterAssignments* writerAssignments) const {
+    auto writerId =
+        writerAssignments ? writerAssignments->assign(hash) : hash % writerVectors.size();
+    auto& writer = writerVectors[writerId];
     if (writer.empty()) {
         // Skip a few growth rounds in anticipation that we'll be appending more.
         writer.reserve(8U);
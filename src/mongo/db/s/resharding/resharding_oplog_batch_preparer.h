@@ -41,6 +41,10 @@ namespace mongo {
 class CollatorInterface;
 class LogicalSessionId;
 
+namespace repl {
+class WriterAssignments;
+}  // namespace repl
+
 /**
  * Converts a batch of oplog entries to be applied into multiple batches of oplog entries that may
  * be applied concurrently by different threads.
@@ -93,15 +97,26 @@ public:
 private:
     WriterVectors _makeEmptyWriterVectors() const;
 
-    void _appendCrudOpToWriterVector(const OplogEntry* op, WriterVectors& writerVectors) const;
+    /**
+     * Returns the assignments of conflict keys to writers to use while filling 'writerVectors', or
+     * boost::none if ops are to be assigned by hashing their key onto a fixed writer.
+     */
+    boost::optional<repl::WriterAssignments> _makeWriterAssignments(
+        const WriterVectors& writerVectors) const;
+
+    void _appendCrudOpToWriterVector(const OplogEntry* op,
+                                     WriterVectors& writerVectors,
+                                     repl::WriterAssignments* writerAssignments) const;
 
     void _appendSessionOpToWriterVector(const LogicalSessionId& lsid,
                                         const OplogEntry* op,
-                                        WriterVectors& writerVectors) const;
+                                        WriterVectors& writerVectors,
+                                        repl::WriterAssignments* writerAssignments) const;
 
     void _appendOpToWriterVector(std::uint32_t hash,
                                  const OplogEntry* op,
-                                 WriterVectors& writerVectors) const;
+                                 WriterVectors& writerVectors,
+                                 repl::WriterAssignments* writerAssignments) const;
 
     const std::unique_ptr<CollatorInterface> _defaultCollator;
 };
@@ -188,6 +188,31 @@ TEST_F(ReshardingOplogBatchPreparerTest, DistributesCrudOpsToWriterVectorsFairly
     ASSERT_EQ(writerVectors[0].size() + writerVectors[1].size(), numOps);
 }
 
+TEST_F(ReshardingOplogBatchPreparerTest, BalancesCrudOpsAroundHotDocument) {
+    RAIIServerParameterControllerForTest balanceWriters{"oplogApplicationBalanceWriters", true};
+    OplogBatch batch;
+
+    int numOps = 10;
+    for (int i = 0; i < numOps; ++i) {
+        batch.emplace_back(makeUpdateOp(BSON("_id" << 0 << "n" << i)));
+    }
+    for (int i = 1; i <= numOps; ++i) {
+        batch.emplace_back(makeUpdateOp(BSON("_id" << i)));
+    }
+
+    std::list<repl::OplogEntry> derivedOps;
+    auto writerVectors = _batchPreparer.makeCrudOpWriterVectors(batch, derivedOps);
+    ASSERT_EQ(writerVectors.size(), kNumWriterVectors);
+
+    // All updates to the hot document go to the first writer, so the documents seen after it are
+    // all given to the other writer.
+    ASSERT_EQ(writerVectors[0].size(), numOps);
+    ASSERT_EQ(writerVectors[1].size(), numOps);
+    for (int i = 0; i < numOps; ++i) {
+        ASSERT_BSONOBJ_BINARY_EQ(writerVectors[0][i]->getObject(), BSON("_id" << 0 << "n" << i));
+    }
+}
+
 TEST_F(ReshardingOplogBatchPreparerTest, CreatesDerivedCrudOpsForApplyOps) {
     OplogBatch batch;
 
@@ -80,6 +80,7 @@
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/transaction_coordinator_factory.h"
 #include "mongo/db/service_entry_point_common.h"
+#include "mongo/db/service_entry_point_common_gen.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/api_version_metrics.h"
 #include "mongo/db/stats/counters.h"
@@ -105,10 +106,12 @@
 #include "mongo/transport/hello_metrics.h"
 #include "mongo/transport/service_executor.h"
 #include "mongo/transport/session.h"
+#include "mongo/util/cpu_profiler.h"
 #include "mongo/util/duration.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/future_util.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -132,12 +135,146 @@ Counter64 notPrimaryUnackWrites;
 ServerStatusMetricField<Counter64> displayNotPrimaryUnackWrites(
     "repl.network.notPrimaryUnacknowledgedWrites", &notPrimaryUnackWrites);
 
+// Tracks the number of client commands rejected by ingress admission control.
+Counter64 admissionControlRejectedCommands;
+ServerStatusMetricField<Counter64> displayAdmissionControlRejectedCommands(
+    "network.admissionControl.rejected", &admissionControlRejectedCommands);
+
 namespace {
 
 using namespace fmt::literals;
 
+/**
+ * Sheds client commands before they run once more commands than ingressAdmissionControlMaxInFlight
+ * have been in progress for longer than ingressAdmissionControlIntervalMillis. Like CoDel, this
+ * lets bursts above the limit through and only reacts to a standing backlog. Rejecting a command
+ * costs little more than parsing it, since no locks, tickets or storage resources are held yet.
+ * Commands from direct and internal clients, the commands drivers use to monitor the server and the
+ * commands which release resources are always admitted. Getmores of tailable cursors are admitted
+ * too, and commands stop counting as in progress once they wait for write concern.
+ */
+class IngressAdmissionControl {
+public:
+    // Holds a command's place among the commands in progress until it is destroyed.
+    class Admission {
+    public:
+        Admission() = default;
+        explicit Admission(IngressAdmissionControl* control) : _control(control) {}
+        Admission(Admission&& other) : _control(std::exchange(other._control, nullptr)) {}
+        Admission& operator=(Admission&& other) {
+            if (this != &other) {
+                release();
+                _control = std::exchange(other._control, nullptr);
+            }
+            return *this;
+        }
+
+        ~Admission() {
+            release();
+        }
+
+        // Stops counting the command as in progress.
+        void release() {
+            if (auto control = std::exchange(_control, nullptr)) {
+                control->_inFlight.fetchAndSubtract(1);
+            }
+        }
+
+    private:
+        IngressAdmissionControl* _control = nullptr;
+    };
+
+    static IngressAdmissionControl& get(ServiceContext* svcCtx);
+
+    StatusWith<Admission> admit(OperationContext* opCtx, const OpMsgRequest& request) {
+        const auto maxInFlight = gIngressAdmissionControlMaxInFlight.load();
+        if (maxInFlight <= 0 || _isExempt(opCtx, request)) {
+            return Admission();
+        }
+
+        const auto inFlight = _inFlight.addAndFetch(1);
+        Admission admission(this);
+        if (inFlight <= maxInFlight) {
+            _overLimitSince.store(0);
+            return std::move(admission);
+        }
+
+        const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+        auto overLimitSince = _overLimitSince.load();
+        if (overLimitSince == 0) {
+            _overLimitSince.compareAndSwap(&overLimitSince, now.toMillisSinceEpoch());
+            return std::move(admission);
+        }
+
+        const auto interval = Milliseconds(gIngressAdmissionControlIntervalMillis.load());
+        if (now - Date_t::fromMillisSinceEpoch(overLimitSince) < interval) {
+            return std::move(admission);
+        }
+
+        admissionControlRejectedCommands.increment();
+        return Status(ErrorCodes::ExceededTimeLimit,
+                      "Command rejected by admission control: {} commands in progress exceed the "
+                      "limit of {}"_format(inFlight - 1, maxInFlight));
+    }
+
+private:
+    static bool _isExempt(OperationContext* opCtx, const OpMsgRequest& request) {
+        auto client = opCtx->getClient();
+        if (client->isInDirectClient() || !client->session() ||
+            (client->session()->getTags() & transport::Session::kInternalClient)) {
+            return true;
+        }
+
+        // Besides the commands drivers use to monitor the server, the commands which end cursors,
+        // sessions and transactions are admitted, since rejecting them would leave behind the
+        // resources they release.
+        static const StringDataSet kExemptCommands{"abortTransaction",
+                                                   "commitTransaction",
+                                                   "endSessions",
+                                                   "hello",
+                                                   "isMaster",
+                                                   "ismaster",
+                                                   "killCursors",
+                                                   "ping"};
+        const auto commandName = request.getCommandName();
+        if (kExemptCommands.count(commandName)) {
+            return true;
+        }
+
+        // A getMore of a tailable cursor may wait for new results for as long as its client allows,
+        // and would hold its place among the commands in progress while doing no work.
+        if (commandName == "getMore"_sd) {
+            auto cursorElem = request.body.firstElement();
+            return cursorElem.type() == NumberLong &&
+                CursorManager::get(opCtx)->isTailable(cursorElem.Long());
+        }
+        return false;
+    }
+
+    AtomicWord<int> _inFlight{0};
+
+    // When the commands in progress went above the limit, in milliseconds since the epoch, or 0 if
+    // they are not above the limit.
+    AtomicWord<long long> _overLimitSince{0};
+};
+
+const auto getIngressAdmissionControl =
+    ServiceContext::declareDecoration<IngressAdmissionControl>();
+
+IngressAdmissionControl& IngressAdmissionControl::get(ServiceContext* svcCtx) {
+    return getIngressAdmissionControl(svcCtx);
+}
+
+// The admission of the command run by an operation.
+const auto getIngressAdmission =
+    OperationContext::declareDecoration<IngressAdmissionControl::Admission>();
+
 Future<void> runCommandInvocation(std::shared_ptr<RequestExecutionContext> rec,
                                   std::shared_ptr<CommandInvocation> invocation) {
+    // Only covers the part of the command that runs on this thread before the future is returned,
+    // which is all of it for commands that run synchronously.
+    cpu_profiler::ScopedAttribution cpuProfilerAttribution(invocation->definition()->getName(),
+                                                           invocation->ns().ns());
     auto threadingModel = [client = rec->getOpCtx()->getClient()] {
         if (auto context = transport::ServiceExecutorContext::get(client); context) {
             return context->getThreadingModel();
@@ -998,7 +1135,7 @@ void RunCommandImpl::_prologue() {
     auto execContext = _ecd->getExecutionContext();
     auto opCtx = execContext->getOpCtx();
     const Command* command = _ecd->getInvocation()->definition();
-    auto bytesToReserve = command->reserveBytesForReply();
+    auto bytesToReserve = _ecd->getInvocation()->reserveBytesForReply();
 // SERVER-22100: In Windows DEBUG builds, the CRT heap debugging overhead, in conjunction with the
 // additional memory pressure introduced by reply buffer pre-allocation, causes the concurrency
 // suite to run extremely slowly. As a workaround we do not pre-allocate in Windows DEBUG builds.
@@ -1128,6 +1265,10 @@ void RunCommandAndWaitForWriteConcern::_waitForWriteConcern(BSONObjBuilder& bb)
         return;
     }
 
+    // Waiting for write concern uses no resources of this node, so the command no longer counts
+    // towards admission control.
+    getIngressAdmission(opCtx).release();
+
     CurOp::get(opCtx)->debug().writeConcern.emplace(opCtx->getWriteConcern());
     _execContext->behaviors->waitForWriteConcern(opCtx, invocation, _lastOpBeforeRun.get(), bb);
 }
@@ -1863,7 +2004,21 @@ Future<DbResponse> receivedCommands(std::shared_ptr<HandleRequest::ExecutionCont
     execContext->setReplyBuilder(
         rpc::makeReplyBuilder(rpc::protocolForMessage(execContext->getMessage())));
     return parseCommand(execContext)
-        .then([execContext]() mutable { return executeCommand(std::move(execContext)); })
+        .then([execContext]() mutable -> Future<void> {
+            auto opCtx = execContext->getOpCtx();
+            auto admission = IngressAdmissionControl::get(opCtx->getServiceContext())
+                                 .admit(opCtx, execContext->getRequest());
+            if (!admission.isOK()) {
+                return admission.getStatus();
+            }
+
+            // Keep the command counted as in progress until it has finished executing, or until it
+            // starts waiting for write concern.
+            getIngressAdmission(opCtx) = std::move(admission.getValue());
+            return executeCommand(std::move(execContext)).tapAll([opCtx](const Status&) {
+                getIngressAdmission(opCtx).release();
+            });
+        })
         .onError([execContext](Status status) {
             if (ErrorCodes::isConnectionFatalMessageParseError(status.code())) {
                 // If this error needs to fail the connection, propagate it out.
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -98,7 +99,8 @@ public:
      * NOTE: Since this method runs with the session catalog mutex, the work done by 'workerFn' is
      * not allowed to block, perform I/O or acquire any lock manager locks.
      * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
-     * SessionCatalog.
+     * SessionCatalog one partition at a time, so sessions in partitions which have already been
+     * visited may change before the scan completes.
      */
     using ScanSessionsCallbackFn = std::function<void(ObservableSession&)>;
     void scanSession(const LogicalSessionId& lsid, const ScanSessionsCallbackFn& workerFn);
@@ -136,6 +138,21 @@ private:
     };
     using SessionRuntimeInfoMap = LogicalSessionIdMap<std::unique_ptr<SessionRuntimeInfo>>;
 
+    // One slice of the catalog. A child session hashes to the same partition as its parent
+    // session, so that both can be checked out and waited on under a single mutex.
+    struct Partition {
+        // Protects the state below
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(4), "SessionCatalog::Partition::mutex");
+
+        // Owns the Session objects for all current Sessions which hash to this partition.
+        SessionRuntimeInfoMap sessions;
+    };
+
+    // Number of partitions the catalog is split into. The partition mutexes are never held at the
+    // same time, so operations on unrelated sessions only contend when their ids collide here.
+    static constexpr size_t kNumPartitions = 16;
+
     /**
      * Blocking method, which checks-out the session with the given 'lsid'.
      */
@@ -153,16 +170,27 @@ private:
     ScopedCheckedOutSession _checkOutSession(OperationContext* opCtx);
 
     /**
-     * Returns the session runtime info for 'lsid' from the '_sessions' map. The returned pointer
-     * is guaranteed to be linked on the map for as long as the mutex is held.
+     * Returns the partition which owns 'lsid' and all of its child sessions.
      */
-    SessionRuntimeInfo* _getSessionRuntimeInfo(WithLock lk, const LogicalSessionId& lsid);
+    Partition& _getPartition(const LogicalSessionId& lsid);
 
     /**
-     * Creates or returns the session runtime info for 'lsid' from the '_sessions' map. The
-     * returned pointer is guaranteed to be linked on the map for as long as the mutex is held.
+     * Returns the session runtime info for 'lsid' from the sessions map of 'partition', which must
+     * be the partition owning 'lsid'. The returned pointer is guaranteed to be linked on the map
+     * for as long as the partition's mutex is held.
      */
-    SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock lk, const LogicalSessionId& lsid);
+    SessionRuntimeInfo* _getSessionRuntimeInfo(WithLock lk,
+                                               Partition& partition,
+                                               const LogicalSessionId& lsid);
+
+    /**
+     * Creates or returns the session runtime info for 'lsid' from the sessions map of 'partition'.
+     * The returned pointer is guaranteed to be linked on the map for as long as the partition's
+     * mutex is held.
+     */
+    SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock lk,
+                                                       Partition& partition,
+                                                       const LogicalSessionId& lsid);
 
     /**
      * Makes a session, previously checked out through 'checkoutSession', available again.
@@ -171,12 +199,8 @@ private:
                          SessionRuntimeInfo* parentSri,
                          boost::optional<KillToken> killToken);
 
-    // Protects the state below
-    mutable Mutex _mutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(4), "SessionCatalog::_mutex");
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    // Owns the Session objects for all current Sessions, split by the hash of their session id.
+    std::array<Partition, kNumPartitions> _partitions;
 };
 
 /**
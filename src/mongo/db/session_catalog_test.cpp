@@ -399,6 +399,50 @@ TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessions) {
                        ErrorCodes::InvalidOptions);
 }
 
+TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsVisitsSessionsInAllPartitions) {
+    // Enough sessions that every partition of the catalog is very likely to own some of them
+    const size_t kNumSessions = 200;
+    std::vector<LogicalSessionId> lsids;
+    for (size_t i = 0; i < kNumSessions; ++i) {
+        lsids.push_back(makeLogicalSessionIdForTest());
+    }
+
+    stdx::async(stdx::launch::async,
+                [this, &lsids] {
+                    ThreadClient tc(getServiceContext());
+                    for (const auto& lsid : lsids) {
+                        auto opCtx = makeOperationContext();
+                        opCtx->setLogicalSessionId(lsid);
+                        OperationContextSession ocs(opCtx.get());
+                    }
+                })
+        .get();
+    ASSERT_EQ(kNumSessions, catalog()->size());
+
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(_opCtx)});
+
+    LogicalSessionIdSet lsidsFound;
+    catalog()->scanSessions(matcherAllSessions, [&](const ObservableSession& session) {
+        ASSERT(lsidsFound.insert(session.getSessionId()).second);
+    });
+    ASSERT_EQ(kNumSessions, lsidsFound.size());
+
+    for (const auto& lsid : lsids) {
+        ASSERT(lsidsFound.count(lsid));
+        bool visited = false;
+        catalog()->scanSession(lsid, [&](const ObservableSession& session) {
+            ASSERT_EQ(lsid, session.getSessionId());
+            visited = true;
+        });
+        ASSERT(visited);
+    }
+
+    catalog()->scanSessions(matcherAllSessions,
+                            [&](ObservableSession& session) { session.markForReap(); });
+    ASSERT_EQ(0UL, catalog()->size());
+}
+
 TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReap) {
     // Create sessions in the catalog.
     const auto lsids = []() -> std::vector<LogicalSessionId> {
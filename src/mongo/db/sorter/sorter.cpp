@@ -52,15 +52,19 @@
 #include <snappy.h>
 #include <vector>
 
+#include "mongo/base/data_view.h"
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/operation_wait_stats.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
@@ -269,21 +273,38 @@ private:
     /**
      * Tries to read from disk and places any results in _bufferReader. If there is no more data to
      * read, then _done is set to true and the function returns immediately.
+     *
+     * Each block is preceded by its size. Unless the block is the last one in the range, the size
+     * of the following block is read together with the block itself, so that refilling the buffer
+     * costs a single seek and read rather than one for the size and another for the data.
      */
     void _fillBufferFromDisk() {
         int32_t rawSize;
-        _read(&rawSize, sizeof(rawSize));
-        if (_done)
-            return;
+        if (_nextBlockSize) {
+            rawSize = *_nextBlockSize;
+            _nextBlockSize = boost::none;
+        } else {
+            _read(&rawSize, sizeof(rawSize));
+            if (_done)
+                return;
+        }
 
         // negative size means compressed
         const bool compressed = rawSize < 0;
         int32_t blockSize = std::abs(rawSize);
 
-        _buffer.reset(new char[blockSize]);
-        _read(_buffer.get(), blockSize);
+        const bool readNextBlockSize =
+            _fileEndOffset - _fileCurrentOffset >= std::streamoff(blockSize + sizeof(rawSize));
+        const size_t bytesToRead = blockSize + (readNextBlockSize ? sizeof(rawSize) : 0);
+
+        _buffer.reset(new char[bytesToRead]);
+        _read(_buffer.get(), bytesToRead);
         uassert(16816, "file too short?", !_done);
 
+        if (readNextBlockSize) {
+            _nextBlockSize = ConstDataView(_buffer.get() + blockSize).read<int32_t>();
+        }
+
         if (auto encryptionHooks = getEncryptionHooksIfEnabled()) {
             std::unique_ptr<char[]> out(new char[blockSize]);
             size_t outLen;
@@ -345,6 +366,7 @@ private:
 
     std::unique_ptr<char[]> _buffer;
     std::unique_ptr<BufReader> _bufferReader;
+    boost::optional<int32_t> _nextBlockSize;  // Size of the next block, if already read.
     std::shared_ptr<typename Sorter<Key, Value>::File>
         _file;                          // File containing the sorted data range.
     std::streamoff _fileStartOffset;    // File offset at which the sorted data range starts.
@@ -508,6 +530,118 @@ private:
     STLComparator _greater;                      // named so calls make sense
 };
 
+/**
+ * Drains an input iterator on a background thread, handing its data to the consumer in batches
+ * through a bounded queue. Used to merge groups of spilled ranges concurrently, leaving only the
+ * merge of the groups to the consuming thread.
+ */
+template <typename Key, typename Value>
+class BackgroundMergeIterator : public SortIteratorInterface<Key, Value> {
+public:
+    typedef SortIteratorInterface<Key, Value> Input;
+    typedef std::pair<Key, Value> Data;
+
+    // Each background thread merges at least this many inputs.
+    static constexpr size_t kMinInputsPerThread = 8;
+
+    explicit BackgroundMergeIterator(std::unique_ptr<Input> input)
+        : _input(std::move(input)), _thread([this] { _produce(); }) {}
+
+    ~BackgroundMergeIterator() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _cancelled = true;
+        }
+        _cv.notify_all();
+        _thread.join();
+    }
+
+    void openSource() {}
+    void closeSource() {}
+
+    bool more() {
+        _fillBatchIfNeeded();
+        return _pos < _batch.size();
+    }
+
+    Data next() {
+        _fillBatchIfNeeded();
+        invariant(_pos < _batch.size());
+        return std::move(_batch[_pos++]);
+    }
+
+private:
+    static constexpr size_t kBatchSize = 1024;
+    static constexpr size_t kMaxQueuedBatches = 2;
+
+    /**
+     * Waits for the next batch if the current one has been consumed. Leaves the current batch
+     * empty once the input is exhausted, and rethrows any error the background thread hit.
+     */
+    void _fillBatchIfNeeded() {
+        if (_pos < _batch.size())
+            return;
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        _cv.wait(lk, [&] { return !_queue.empty() || _producerDone; });
+
+        _batch.clear();
+        _pos = 0;
+        if (_queue.empty()) {
+            uassertStatusOK(_producerStatus);
+            return;
+        }
+
+        _batch = std::move(_queue.front());
+        _queue.pop_front();
+        lk.unlock();
+        _cv.notify_all();
+    }
+
+    void _produce() {
+        Status status = Status::OK();
+        try {
+            while (_input->more()) {
+                std::vector<Data> batch;
+                batch.reserve(kBatchSize);
+                while (batch.size() < kBatchSize && _input->more())
+                    batch.push_back(_input->next());
+
+                stdx::unique_lock<Latch> lk(_mutex);
+                _cv.wait(lk, [&] { return _cancelled || _queue.size() < kMaxQueuedBatches; });
+                if (_cancelled)
+                    return;
+
+                _queue.push_back(std::move(batch));
+                lk.unlock();
+                _cv.notify_all();
+            }
+        } catch (...) {
+            status = exceptionToStatus();
+        }
+
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _producerDone = true;
+            _producerStatus = std::move(status);
+        }
+        _cv.notify_all();
+    }
+
+    std::unique_ptr<Input> _input;  // Only used by the background thread.
+    std::vector<Data> _batch;       // Batch being consumed.
+    size_t _pos = 0;                // Position of the next datum in _batch.
+
+    Mutex _mutex = MONGO_MAKE_LATCH("BackgroundMergeIterator::_mutex");
+    stdx::condition_variable _cv;
+    std::deque<std::vector<Data>> _queue;
+    bool _cancelled = false;
+    bool _producerDone = false;
+    Status _producerStatus = Status::OK();
+
+    stdx::thread _thread;  // Declared last so that it starts after all other members.
+};
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -993,6 +1127,9 @@ Sorter<Key, Value>::File::~File() {
 
 template <typename Key, typename Value>
 void Sorter<Key, Value>::File::read(std::streamoff offset, std::streamsize size, void* out) {
+    ScopedWaitTimer waitTimer(OperationWaitStats::WaitState::kSpillIO);
+    stdx::lock_guard<Latch> lk(_mutex);
+
     if (!_file.is_open()) {
         _open();
     }
@@ -1028,6 +1165,7 @@ void Sorter<Key, Value>::File::read(std::streamoff offset, std::streamsize size,
 
 template <typename Key, typename Value>
 void Sorter<Key, Value>::File::write(const char* data, std::streamsize size) {
+    ScopedWaitTimer waitTimer(OperationWaitStats::WaitState::kSpillIO);
     _ensureOpenForWriting();
 
     try {
@@ -1187,7 +1325,27 @@ SortIteratorInterface<Key, Value>* SortIteratorInterface<Key, Value>::merge(
     const std::vector<std::shared_ptr<SortIteratorInterface>>& iters,
     const SortOptions& opts,
     const Comparator& comp) {
-    return new sorter::MergeIterator<Key, Value, Comparator>(iters, opts, comp);
+    typedef sorter::BackgroundMergeIterator<Key, Value> BackgroundMergeIterator;
+    typedef sorter::MergeIterator<Key, Value, Comparator> MergeIterator;
+
+    const size_t numGroups =
+        std::min(opts.mergeThreads, iters.size() / BackgroundMergeIterator::kMinInputsPerThread);
+    if (numGroups < 2)
+        return new MergeIterator(iters, opts, comp);
+
+    // Merge contiguous groups of the inputs on background threads, then merge the groups. Since
+    // ties are broken by input position at both levels, the output order is the same as that of a
+    // single merge over all of the inputs.
+    std::vector<std::shared_ptr<SortIteratorInterface>> groups;
+    groups.reserve(numGroups);
+    for (size_t i = 0; i < numGroups; i++) {
+        std::vector<std::shared_ptr<SortIteratorInterface>> group(
+            iters.begin() + iters.size() * i / numGroups,
+            iters.begin() + iters.size() * (i + 1) / numGroups);
+        groups.push_back(std::make_shared<BackgroundMergeIterator>(
+            std::make_unique<MergeIterator>(group, opts, comp)));
+    }
+    return new MergeIterator(groups, opts, comp);
 }
 
 template <typename Key, typename Value>
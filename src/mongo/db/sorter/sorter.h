@@ -41,6 +41,7 @@
 
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/sorter/sorter_gen.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/util/bufreader.h"
 
 /**
@@ -119,11 +120,16 @@ struct SortOptions {
     // instead of copying.
     bool moveSortedDataIntoIterator;
 
+    // The number of threads that merge the spilled ranges, including the thread consuming the
+    // merged data. With more than one, groups of ranges are merged on background threads.
+    size_t mergeThreads;
+
     SortOptions()
         : limit(0),
           maxMemoryUsageBytes(64 * 1024 * 1024),
           extSortAllowed(false),
-          moveSortedDataIntoIterator(false) {}
+          moveSortedDataIntoIterator(false),
+          mergeThreads(1) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -156,6 +162,11 @@ struct SortOptions {
         moveSortedDataIntoIterator = newMoveSortedDataIntoIterator;
         return *this;
     }
+
+    SortOptions& MergeThreads(size_t newMergeThreads) {
+        mergeThreads = newMergeThreads;
+        return *this;
+    }
 };
 
 /**
@@ -276,7 +287,7 @@ public:
 
         /**
          * Reads the requested data from the file. Cannot write more to the file once this has been
-         * called.
+         * called. May be called concurrently by iterators that merge on separate threads.
          */
         void read(std::streamoff offset, std::streamsize size, void* out);
 
@@ -296,6 +307,9 @@ public:
         void _ensureOpenForWriting();
 
         boost::filesystem::path _path;
+
+        // Serializes reads, which seek the shared stream before reading from it.
+        Mutex _mutex = MONGO_MAKE_LATCH("Sorter::File::_mutex");
         std::fstream _file;
 
         // The current offset of the end of the file, or -1 if the file either has not yet been
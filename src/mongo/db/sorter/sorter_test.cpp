@@ -358,6 +358,16 @@ public:
                 mergeIterators(iterators, ASC, SortOptions().Limit(10)),
                 std::make_shared<LimitIterator>(10, std::make_shared<IntIterator>(0, 20, 1)));
         }
+        {  // test merging groups of inputs on background threads
+            const int numInputs = 50;
+            std::vector<std::shared_ptr<IWIterator>> vec;
+            for (int i = 0; i < numInputs; i++)
+                vec.push_back(std::make_shared<IntIterator>(i, 100 * 1000, numInputs));
+
+            std::shared_ptr<IWIterator> mergeIter(
+                IWIterator::merge(vec, SortOptions().MergeThreads(4), IWComparator()));
+            ASSERT_ITERATORS_EQUIVALENT(mergeIter, std::make_shared<IntIterator>(0, 100 * 1000));
+        }
     }
 };
 
@@ -651,6 +661,13 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+template <bool Random = true>
+class LotsOfDataLittleMemoryParallelMerge : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts).MergeThreads(4);
+    }
+};
 }  // namespace SorterTests
 
 class SorterSuite : public mongo::unittest::OldStyleSuiteSpecification {
@@ -669,6 +686,8 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataLittleMemoryParallelMerge</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemoryParallelMerge</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
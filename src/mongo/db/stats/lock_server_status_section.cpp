@@ -109,6 +109,9 @@ class LockStatsServerStatusSection : public ServerStatusSection {
 public:
     LockStatsServerStatusSection() : ServerStatusSection("locks") {}
 
+    // Number of resources with the most lock wait time to report.
+    static constexpr size_t kNumHotResources = 10;
+
     bool includeByDefault() const override {
         return true;
     }
@@ -122,6 +125,14 @@ public:
 
         stats.report(&ret);
 
+        bool includeHotResources = true;
+        if (configElement.type() == BSONType::Object) {
+            includeHotResources = configElement.Obj()["includeHotResources"].trueValue();
+        }
+        if (includeHotResources) {
+            reportGlobalResourceWaitStats(&ret, kNumHotResources);
+        }
+
         return ret.obj();
     }
 
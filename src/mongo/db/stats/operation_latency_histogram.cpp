@@ -206,4 +206,58 @@ void OperationLatencyHistogram::increment(uint64_t latency, Command::ReadWriteTy
     }
 }
 
+size_t ConcurrentOperationLatencyHistogram::_getShardIndex() {
+    static AtomicWord<size_t> nextShardIndex{0};
+    thread_local const size_t shardIndex = nextShardIndex.fetchAndAddRelaxed(1) % kNumShards;
+    return shardIndex;
+}
+
+void ConcurrentOperationLatencyHistogram::increment(uint64_t latency,
+                                                    Command::ReadWriteType type) {
+    auto& shard = _shards[_getShardIndex()];
+    HistogramData* data;
+    switch (type) {
+        case Command::ReadWriteType::kRead:
+            data = &shard.reads;
+            break;
+        case Command::ReadWriteType::kWrite:
+            data = &shard.writes;
+            break;
+        case Command::ReadWriteType::kCommand:
+            data = &shard.commands;
+            break;
+        case Command::ReadWriteType::kTransaction:
+            data = &shard.transactions;
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+
+    data->buckets[OperationLatencyHistogram::_getBucket(latency)].fetchAndAddRelaxed(1);
+    data->entryCount.fetchAndAddRelaxed(1);
+    data->sum.fetchAndAddRelaxed(latency);
+}
+
+void ConcurrentOperationLatencyHistogram::_mergeData(
+    const HistogramData& data, OperationLatencyHistogram::HistogramData* merged) {
+    for (size_t i = 0; i < OperationLatencyHistogram::kMaxBuckets; i++) {
+        merged->buckets[i] += data.buckets[i].loadRelaxed();
+    }
+    merged->entryCount += data.entryCount.loadRelaxed();
+    merged->sum += data.sum.loadRelaxed();
+}
+
+void ConcurrentOperationLatencyHistogram::append(bool includeHistograms,
+                                                 bool slowMSBucketsOnly,
+                                                 BSONObjBuilder* builder) const {
+    OperationLatencyHistogram merged;
+    for (auto&& shard : _shards) {
+        _mergeData(shard.reads, &merged._reads);
+        _mergeData(shard.writes, &merged._writes);
+        _mergeData(shard.commands, &merged._commands);
+        _mergeData(shard.transactions, &merged._transactions);
+    }
+    merged.append(includeHistograms, slowMSBucketsOnly, builder);
+}
+
 }  // namespace mongo
@@ -31,6 +31,7 @@
 #include <array>
 
 #include "mongo/db/commands.h"
+#include "mongo/platform/atomic_word.h"
 
 namespace mongo {
 
@@ -60,6 +61,8 @@ public:
     void append(bool includeHistograms, bool slowMSBucketsOnly, BSONObjBuilder* builder) const;
 
 private:
+    friend class ConcurrentOperationLatencyHistogram;
+
     struct HistogramData {
         std::array<uint64_t, kMaxBuckets> buckets{};
         uint64_t entryCount = 0;
@@ -80,4 +83,46 @@ private:
 
     HistogramData _reads, _writes, _commands, _transactions;
 };
+
+/**
+ * A thread-safe OperationLatencyHistogram, for histograms that every operation increments.
+ *
+ * Increments are lock-free. Each thread increments one of several shards with relaxed atomic
+ * operations, and the shards are merged when the histogram is appended. Shards are assigned to
+ * threads round-robin and are cache line aligned, so that threads running on different cores
+ * rarely write to the same cache lines.
+ */
+class ConcurrentOperationLatencyHistogram {
+public:
+    /**
+     * Increments the bucket of the histogram based on the operation type.
+     */
+    void increment(uint64_t latency, Command::ReadWriteType type);
+
+    /**
+     * Appends the four histograms with latency totals and operation counts. The result may miss
+     * increments that happen concurrently.
+     */
+    void append(bool includeHistograms, bool slowMSBucketsOnly, BSONObjBuilder* builder) const;
+
+private:
+    static constexpr size_t kNumShards = 16;
+
+    struct HistogramData {
+        std::array<AtomicWord<uint64_t>, OperationLatencyHistogram::kMaxBuckets> buckets{};
+        AtomicWord<uint64_t> entryCount{0};
+        AtomicWord<uint64_t> sum{0};
+    };
+
+    struct alignas(64) Shard {
+        HistogramData reads, writes, commands, transactions;
+    };
+
+    static size_t _getShardIndex();
+
+    static void _mergeData(const HistogramData& data,
+                           OperationLatencyHistogram::HistogramData* merged);
+
+    std::array<Shard, kNumShards> _shards;
+};
 }  // namespace mongo
@@ -38,6 +38,7 @@
 
 #include "mongo/db/commands.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -134,4 +135,51 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatencySlowBuckets) {
         ASSERT_EQUALS(bucket["count"].Long(), 83);
     }
 }
+
+TEST(ConcurrentOperationLatencyHistogram, MatchesOperationLatencyHistogram) {
+    OperationLatencyHistogram hist;
+    ConcurrentOperationLatencyHistogram concurrentHist;
+    const std::vector<Command::ReadWriteType> types = {Command::ReadWriteType::kRead,
+                                                       Command::ReadWriteType::kWrite,
+                                                       Command::ReadWriteType::kCommand,
+                                                       Command::ReadWriteType::kTransaction};
+    for (int i = 0; i < kMaxBuckets; i++) {
+        for (auto type : types) {
+            hist.increment(kLowerBounds[i] + i, type);
+            concurrentHist.increment(kLowerBounds[i] + i, type);
+        }
+    }
+
+    BSONObjBuilder expectedBuilder;
+    hist.append(true, false, &expectedBuilder);
+    BSONObjBuilder outBuilder;
+    concurrentHist.append(true, false, &outBuilder);
+    ASSERT_BSONOBJ_EQ(outBuilder.obj(), expectedBuilder.obj());
+}
+
+TEST(ConcurrentOperationLatencyHistogram, ConcurrentIncrementsAreAllCounted) {
+    ConcurrentOperationLatencyHistogram hist;
+    const int kNumThreads = 32;
+    const int kIncrementsPerThread = 1000;
+
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < kNumThreads; t++) {
+        threads.emplace_back([&hist, t] {
+            for (int i = 0; i < kIncrementsPerThread; i++) {
+                hist.increment(t, Command::ReadWriteType::kRead);
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    BSONObjBuilder outBuilder;
+    hist.append(false, false, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["ops"].Long(), kNumThreads * kIncrementsPerThread);
+    ASSERT_EQUALS(out["reads"]["latency"].Long(),
+                  kIncrementsPerThread * (kNumThreads * (kNumThreads - 1) / 2));
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), 0);
+}
 }  // namespace mongo
@@ -0,0 +1,181 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <cmath>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/query_shape_stats_gen.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryShapeStats = ServiceContext::declareDecoration<QueryShapeStats>();
+
+/**
+ * Returns the histogram bucket of a latency. Bucket 0 counts latencies of 0, and bucket i > 0
+ * those in [2^(i-1), 2^i) microseconds, except for the last bucket which has no upper bound.
+ */
+size_t latencyBucket(Microseconds latency) {
+    const auto micros = static_cast<uint64_t>(std::max<int64_t>(0, latency.count()));
+    if (micros == 0) {
+        return 0;
+    }
+    return std::min<size_t>(64 - countLeadingZeros64(micros),
+                            QueryShapeStats::Entry::kNumLatencyBuckets - 1);
+}
+
+Microseconds latencyBucketUpperBound(size_t bucket) {
+    return Microseconds(1LL << bucket);
+}
+
+}  // namespace
+
+void QueryShapeStats::Entry::add(const Sample& sample) {
+    ++_count;
+    _totalLatency += sample.latency;
+    _maxLatency = std::max(_maxLatency, sample.latency);
+    ++_latencyBuckets[latencyBucket(sample.latency)];
+    _keysExamined += sample.keysExamined;
+    _docsExamined += sample.docsExamined;
+    _nreturned += sample.nreturned;
+    _bytesReturned += sample.bytesReturned;
+
+    if (auto metrics = sample.resourceMetrics) {
+        ++_resourceMetricsCount;
+        _readMetrics += metrics->readMetrics;
+        _writeMetrics += metrics->writeMetrics;
+        if (metrics->cpuTimer) {
+            _cpuTime += metrics->cpuTimer->getElapsed();
+        }
+    }
+}
+
+Microseconds QueryShapeStats::Entry::latencyPercentile(double percentile) const {
+    invariant(percentile > 0 && percentile <= 100);
+
+    const auto rank = static_cast<long long>(std::ceil(_count * percentile / 100));
+    long long seen = 0;
+    for (size_t bucket = 0; bucket < kNumLatencyBuckets; ++bucket) {
+        seen += _latencyBuckets[bucket];
+        if (seen >= rank) {
+            return std::min(latencyBucketUpperBound(bucket), _maxLatency);
+        }
+    }
+    return _maxLatency;
+}
+
+void QueryShapeStats::Entry::append(BSONObjBuilder* builder) const {
+    builder->appendNumber("count", _count);
+    builder->appendNumber("totalExecMicros", durationCount<Microseconds>(_totalLatency));
+    builder->appendNumber("maxExecMicros", durationCount<Microseconds>(_maxLatency));
+    builder->appendNumber("p50ExecMicros", durationCount<Microseconds>(latencyPercentile(50)));
+    builder->appendNumber("p99ExecMicros", durationCount<Microseconds>(latencyPercentile(99)));
+    {
+        BSONArrayBuilder histogramBuilder(builder->subarrayStart("execMicrosHistogram"));
+        for (size_t bucket = 0; bucket < kNumLatencyBuckets; ++bucket) {
+            if (_latencyBuckets[bucket] == 0) {
+                continue;
+            }
+            BSONObjBuilder bucketBuilder(histogramBuilder.subobjStart());
+            bucketBuilder.appendNumber(
+                "micros", durationCount<Microseconds>(latencyBucketUpperBound(bucket)));
+            bucketBuilder.appendNumber("count", _latencyBuckets[bucket]);
+        }
+    }
+    builder->appendNumber("keysExamined", _keysExamined);
+    builder->appendNumber("docsExamined", _docsExamined);
+    builder->appendNumber("nreturned", _nreturned);
+    builder->appendNumber("bytesReturned", _bytesReturned);
+
+    if (_resourceMetricsCount > 0) {
+        BSONObjBuilder metricsBuilder(builder->subobjStart("resourceMetrics"));
+        metricsBuilder.appendNumber("count", _resourceMetricsCount);
+        _readMetrics.toBson(&metricsBuilder);
+        _writeMetrics.toBson(&metricsBuilder);
+        metricsBuilder.appendNumber("cpuNanos", durationCount<Nanoseconds>(_cpuTime));
+    }
+}
+
+QueryShapeStats& QueryShapeStats::get(ServiceContext* service) {
+    return getQueryShapeStats(service);
+}
+
+QueryShapeStats& QueryShapeStats::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void QueryShapeStats::record(uint32_t queryHash, const Sample& sample) {
+    const size_t maxEntries = std::max(0, gQueryShapeStatsMaxEntries.load());
+    if (maxEntries == 0) {
+        return;
+    }
+    const size_t maxEntriesPerPartition = (maxEntries + kNumPartitions - 1) / kNumPartitions;
+
+    auto& partition = _partitions[queryHash % kNumPartitions];
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto it = partition.entries.find(queryHash);
+    if (it == partition.entries.end()) {
+        if (partition.entries.size() >= maxEntriesPerPartition) {
+            return;
+        }
+        it = partition.entries.emplace(queryHash, Entry()).first;
+    }
+    it->second.add(sample);
+}
+
+std::vector<std::pair<uint32_t, QueryShapeStats::Entry>> QueryShapeStats::getStats() const {
+    std::vector<std::pair<uint32_t, Entry>> stats;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        stats.insert(stats.end(), partition.entries.begin(), partition.entries.end());
+    }
+    return stats;
+}
+
+std::vector<std::pair<uint32_t, QueryShapeStats::Entry>> QueryShapeStats::getAndClearStats() {
+    std::vector<std::pair<uint32_t, Entry>> stats;
+    for (auto&& partition : _partitions) {
+        stdx::unordered_map<uint32_t, Entry> entries;
+        {
+            stdx::lock_guard<Latch> lk(partition.mutex);
+            entries.swap(partition.entries);
+        }
+        stats.insert(stats.end(), entries.begin(), entries.end());
+    }
+    return stats;
+}
+
+}  // namespace mongo
@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Aggregates the execution statistics of operations by the shape of their query, as identified by
+ * the query hash. This makes it possible to tell which query shapes drive the workload without
+ * enabling the profiler.
+ *
+ * The statistics are kept in memory, in a hash table that is split into partitions with a mutex
+ * each so that concurrent operations rarely contend. The number of tracked shapes is bounded by the
+ * 'queryShapeStatsMaxEntries' server parameter; once it is reached, operations with a query shape
+ * that is not yet tracked are not recorded until the statistics are cleared.
+ */
+class QueryShapeStats {
+public:
+    /**
+     * The statistics of one operation.
+     */
+    struct Sample {
+        Microseconds latency{0};
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        long long nreturned = 0;
+        long long bytesReturned = 0;
+
+        // Only set if resource consumption metrics were collected for the operation.
+        const ResourceConsumption::OperationMetrics* resourceMetrics = nullptr;
+    };
+
+    /**
+     * The statistics accumulated for one query shape. Latencies are also counted in a histogram
+     * with power-of-two buckets, from which approximate percentiles are derived. The histogram is
+     * reported too, so that the statistics of several nodes can be merged.
+     */
+    class Entry {
+    public:
+        static constexpr size_t kNumLatencyBuckets = 32;
+
+        void add(const Sample& sample);
+
+        long long count() const {
+            return _count;
+        }
+
+        /**
+         * Returns the upper bound of the histogram bucket containing the given percentile of the
+         * latencies, which must be in (0, 100].
+         */
+        Microseconds latencyPercentile(double percentile) const;
+
+        void append(BSONObjBuilder* builder) const;
+
+    private:
+        long long _count = 0;
+        Microseconds _totalLatency{0};
+        Microseconds _maxLatency{0};
+        std::array<long long, kNumLatencyBuckets> _latencyBuckets{};
+        long long _keysExamined = 0;
+        long long _docsExamined = 0;
+        long long _nreturned = 0;
+        long long _bytesReturned = 0;
+
+        // Only counts the operations for which resource consumption metrics were collected.
+        long long _resourceMetricsCount = 0;
+        ResourceConsumption::ReadMetrics _readMetrics;
+        ResourceConsumption::WriteMetrics _writeMetrics;
+        Nanoseconds _cpuTime{0};
+    };
+
+    static constexpr size_t kNumPartitions = 16;
+
+    static QueryShapeStats& get(ServiceContext* service);
+    static QueryShapeStats& get(OperationContext* opCtx);
+
+    /**
+     * Records the statistics of an operation against its query shape.
+     */
+    void record(uint32_t queryHash, const Sample& sample);
+
+    /**
+     * Returns the statistics of every tracked query shape, optionally clearing them.
+     */
+    std::vector<std::pair<uint32_t, Entry>> getStats() const;
+    std::vector<std::pair<uint32_t, Entry>> getAndClearStats();
+
+private:
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("QueryShapeStats::Partition::mutex");
+        stdx::unordered_map<uint32_t, Entry> entries;
+    };
+
+    std::array<Partition, kNumPartitions> _partitions;
+};
+
+}  // namespace mongo
@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+QueryShapeStats::Sample makeSample(Microseconds latency, long long nreturned = 0) {
+    QueryShapeStats::Sample sample;
+    sample.latency = latency;
+    sample.keysExamined = 2 * nreturned;
+    sample.docsExamined = nreturned;
+    sample.nreturned = nreturned;
+    return sample;
+}
+
+const QueryShapeStats::Entry* findEntry(
+    const std::vector<std::pair<uint32_t, QueryShapeStats::Entry>>& stats, uint32_t queryHash) {
+    for (auto&& [hash, entry] : stats) {
+        if (hash == queryHash) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+TEST(QueryShapeStatsTest, AggregatesOperationsByQueryShape) {
+    QueryShapeStats stats;
+    stats.record(1, makeSample(Microseconds(10), 5));
+    stats.record(1, makeSample(Microseconds(30), 7));
+    stats.record(2, makeSample(Microseconds(20), 1));
+
+    auto entries = stats.getStats();
+    ASSERT_EQ(entries.size(), 2U);
+
+    auto entry = findEntry(entries, 1);
+    ASSERT(entry);
+    ASSERT_EQ(entry->count(), 2);
+
+    BSONObjBuilder builder;
+    entry->append(&builder);
+    auto obj = builder.obj();
+    ASSERT_EQ(obj["totalExecMicros"].numberLong(), 40);
+    ASSERT_EQ(obj["maxExecMicros"].numberLong(), 30);
+    ASSERT_EQ(obj["keysExamined"].numberLong(), 24);
+    ASSERT_EQ(obj["docsExamined"].numberLong(), 12);
+    ASSERT_EQ(obj["nreturned"].numberLong(), 12);
+    ASSERT_FALSE(obj.hasField("resourceMetrics"));
+
+    entry = findEntry(entries, 2);
+    ASSERT(entry);
+    ASSERT_EQ(entry->count(), 1);
+}
+
+TEST(QueryShapeStatsTest, PercentilesAreUpperBoundsOfHistogramBuckets) {
+    QueryShapeStats stats;
+    for (int i = 0; i < 98; ++i) {
+        stats.record(1, makeSample(Microseconds(10)));
+    }
+    stats.record(1, makeSample(Microseconds(100)));
+    stats.record(1, makeSample(Microseconds(1000)));
+
+    auto entries = stats.getStats();
+    auto entry = findEntry(entries, 1);
+    ASSERT(entry);
+    ASSERT_EQ(entry->latencyPercentile(50), Microseconds(16));
+    ASSERT_EQ(entry->latencyPercentile(98), Microseconds(16));
+    ASSERT_EQ(entry->latencyPercentile(99), Microseconds(128));
+    ASSERT_EQ(entry->latencyPercentile(100), Microseconds(1000));
+}
+
+TEST(QueryShapeStatsTest, NewQueryShapesAreNotTrackedBeyondTheLimit) {
+    RAIIServerParameterControllerForTest controller{"queryShapeStatsMaxEntries",
+                                                    int(QueryShapeStats::kNumPartitions)};
+    QueryShapeStats stats;
+
+    // Both hashes fall into the same partition, which can only track one query shape.
+    stats.record(0, makeSample(Microseconds(10)));
+    stats.record(QueryShapeStats::kNumPartitions, makeSample(Microseconds(10)));
+    stats.record(0, makeSample(Microseconds(10)));
+
+    auto entries = stats.getStats();
+    ASSERT_EQ(entries.size(), 1U);
+    auto entry = findEntry(entries, 0);
+    ASSERT(entry);
+    ASSERT_EQ(entry->count(), 2);
+}
+
+TEST(QueryShapeStatsTest, ZeroMaxEntriesDisablesTheStats) {
+    RAIIServerParameterControllerForTest controller{"queryShapeStatsMaxEntries", 0};
+    QueryShapeStats stats;
+    stats.record(1, makeSample(Microseconds(10)));
+    ASSERT(stats.getStats().empty());
+}
+
+TEST(QueryShapeStatsTest, GetAndClearStatsResetsTheStats) {
+    QueryShapeStats stats;
+    stats.record(1, makeSample(Microseconds(10)));
+    ASSERT_EQ(stats.getAndClearStats().size(), 1U);
+    ASSERT(stats.getStats().empty());
+
+    stats.record(1, makeSample(Microseconds(10)));
+    auto entries = stats.getStats();
+    auto entry = findEntry(entries, 1);
+    ASSERT(entry);
+    ASSERT_EQ(entry->count(), 1);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -112,6 +112,8 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
     result->appendNumber("storageSize", storageSize / scale);
     result->appendNumber("freeStorageSize",
                          static_cast<long long>(recordStore->freeStorageSize(opCtx)) / scale);
+    result->appendNumber("cacheUsageSize",
+                         static_cast<long long>(recordStore->cacheUsageSize(opCtx)) / scale);
 
     const bool isCapped = collection->isCapped();
     result->appendBool("capped", isCapped);
@@ -203,29 +203,33 @@ void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
     if (!opCtx->shouldIncrementLatencyStats())
         return;
 
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    // The global histogram is thread-safe, so this does not need to take '_lock'.
+    if (_isUserOperation(opCtx)) {
+        _globalHistogramStats.increment(latency, readWriteType);
+    }
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms,
                                    bool slowMSBucketsOnly,
                                    BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
     _globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder);
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
     _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
+bool Top::_isUserOperation(OperationContext* opCtx) {
+    Client* client = opCtx->getClient();
+    return client->isFromUserConnection() && !client->isInDirectClient();
+}
+
 void Top::_incrementHistogram(OperationContext* opCtx,
                               long long latency,
                               OperationLatencyHistogram* histogram,
                               Command::ReadWriteType readWriteType) {
     // Only update histogram if operation came from a user.
-    Client* client = opCtx->getClient();
-    if (client->isFromUserConnection() && !client->isInDirectClient()) {
+    if (_isUserOperation(opCtx)) {
         histogram->increment(latency, readWriteType);
     }
 }
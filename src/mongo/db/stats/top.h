@@ -148,13 +148,15 @@ private:
                  long long micros,
                  Command::ReadWriteType readWriteType);
 
+    static bool _isUserOperation(OperationContext* opCtx);
+
     void _incrementHistogram(OperationContext* opCtx,
                              long long latency,
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
     mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
+    ConcurrentOperationLatencyHistogram _globalHistogramStats;  // Not guarded by '_lock'.
     UsageMap _usage;
 };
 
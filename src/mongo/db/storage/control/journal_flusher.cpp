@@ -33,14 +33,22 @@
 
 #include "mongo/db/storage/control/journal_flusher.h"
 
+#include <algorithm>
+#include <array>
+
+#include "mongo/base/counter.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -51,6 +59,51 @@ const auto getJournalFlusher = ServiceContext::declareDecoration<std::unique_ptr
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherBeforeFlush);
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherThread);
 
+using namespace fmt::literals;
+
+/**
+ * Reports how long callers of waitForJournalFlush() wait, from their request until the flush that
+ * covers it completes, as serverStatus().metrics.journalFlush.wait.
+ */
+class JournalFlushWaitMetrics : public ServerStatusMetric {
+public:
+    // Upper bounds of the wait time histogram buckets. The last bucket has no upper bound.
+    static constexpr std::array<long long, 5> kWaitMicrosBounds{
+        100, 1000, 10'000, 100'000, 1'000'000};
+
+    JournalFlushWaitMetrics() : ServerStatusMetric("journalFlush.wait") {}
+
+    void record(long long waitMicros) {
+        _count.increment();
+        _totalMicros.increment(waitMicros);
+        auto bucket =
+            std::upper_bound(kWaitMicrosBounds.begin(), kWaitMicrosBounds.end(), waitMicros);
+        _buckets[bucket - kWaitMicrosBounds.begin()].increment();
+    }
+
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        BSONObjBuilder waitBuilder(b.subobjStart(_leafName));
+        waitBuilder.append("count", _count.get());
+        waitBuilder.append("totalMicros", _totalMicros.get());
+
+        BSONObjBuilder histogramBuilder(waitBuilder.subobjStart("micros"));
+        for (size_t i = 0; i < _buckets.size(); ++i) {
+            auto key = i < kWaitMicrosBounds.size() ? "lt{}"_format(kWaitMicrosBounds[i])
+                                                    : "gte{}"_format(kWaitMicrosBounds.back());
+            histogramBuilder.append(key, _buckets[i].get());
+        }
+    }
+
+private:
+    Counter64 _count;
+    Counter64 _totalMicros;
+    std::array<Counter64, kWaitMicrosBounds.size() + 1> _buckets;
+} journalFlushWaitMetrics;
+
+Counter64 journalFlushRounds;
+ServerStatusMetricField<Counter64> displayJournalFlushRounds("journalFlush.rounds",
+                                                             &journalFlushRounds);
+
 }  // namespace
 
 JournalFlusher* JournalFlusher::get(ServiceContext* serviceCtx) {
@@ -112,6 +165,7 @@ void JournalFlusher::run() {
             });
 
             _uniqueCtx->get()->recoveryUnit()->waitUntilDurable(_uniqueCtx->get());
+            journalFlushRounds.increment();
 
             // Signal the waiters that a round completed.
             _currentSharedPromise->emplaceValue();
@@ -159,6 +213,15 @@ void JournalFlusher::run() {
             });
         }
 
+        // A round requested by a caller may wait a little longer for others to request one too, so
+        // that a single flush covers them all.
+        const auto coalescingDelay = Microseconds(gJournalFlushCoalescingDelayMicros.load());
+        if (_flushJournalNow && coalescingDelay > Microseconds(0)) {
+            _flushJournalNowCV.wait_for(lk, coalescingDelay.toSystemDuration(), [&] {
+                return _needToPause || _shuttingDown;
+            });
+        }
+
         if (_needToPause) {
             _state = States::Paused;
             _stateChangeCV.notify_all();
@@ -232,6 +295,9 @@ void JournalFlusher::triggerJournalFlush() {
 }
 
 void JournalFlusher::waitForJournalFlush() {
+    Timer timer;
+    ON_BLOCK_EXIT([&] { journalFlushWaitMetrics.record(timer.micros()); });
+
     while (true) {
         try {
             _waitForJournalFlushNoRetry();
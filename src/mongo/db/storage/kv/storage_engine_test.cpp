@@ -48,6 +48,7 @@
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/storage_engine_impl.h"
 #include "mongo/db/storage/storage_engine_test_fixture.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/unittest.h"
@@ -112,6 +113,31 @@ TEST_F(StorageEngineTest, LoadCatalogDropsOrphansAfterUncleanShutdown) {
     ASSERT(!collectionExists(opCtx.get(), collNs));
 }
 
+TEST_F(StorageEngineTest, LoadCatalogOpensEveryCollectionConcurrently) {
+    auto opCtx = cc().makeOperationContext();
+
+    // Create more collections than there are catalog loading threads, so that each thread opens
+    // several record stores.
+    std::vector<NamespaceString> namespaces;
+    for (int i = 0; i < 3 * gStorageEngineCatalogLoadThreads; ++i) {
+        namespaces.emplace_back("db.coll" + std::to_string(i));
+        ASSERT_OK(createCollection(opCtx.get(), namespaces.back()).getStatus());
+    }
+
+    {
+        Lock::GlobalWrite writeLock(opCtx.get(), Date_t::max(), Lock::InterruptBehavior::kThrow);
+        _storageEngine->closeCatalog(opCtx.get());
+        _storageEngine->loadCatalog(opCtx.get(), StorageEngine::LastShutdownState::kClean);
+    }
+
+    for (const auto& nss : namespaces) {
+        ASSERT(collectionExists(opCtx.get(), nss));
+        auto coll =
+            CollectionCatalog::get(opCtx.get())->lookupCollectionByNamespace(opCtx.get(), nss);
+        ASSERT(coll->getRecordStore());
+    }
+}
+
 TEST_F(StorageEngineTest, ReconcileDropsTemporary) {
     auto opCtx = cc().makeOperationContext();
 
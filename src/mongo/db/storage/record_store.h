@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/optional.hpp>
+#include <numeric>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -175,6 +178,40 @@ public:
      */
     virtual boost::optional<Record> seekExact(const RecordId& id) = 0;
 
+    /**
+     * Looks up the Records with the provided ids, as seekExact() would, and returns them in the
+     * order of 'ids'. Ids without a matching Record yield boost::none. Unlike the Record returned
+     * by seekExact(), the returned Records own their data, so they remain valid after the cursor
+     * moves.
+     *
+     * The lookups are done in increasing RecordId order, regardless of the order of 'ids', so
+     * that consecutive lookups land close to each other in the underlying storage and can reuse
+     * the position of the cursor. Storage engines may override this for a more efficient
+     * implementation.
+     *
+     * The resulting position of the cursor is unspecified.
+     */
+    virtual std::vector<boost::optional<Record>> seekExactBatch(const std::vector<RecordId>& ids) {
+        std::vector<size_t> lookupOrder(ids.size());
+        std::iota(lookupOrder.begin(), lookupOrder.end(), 0);
+        std::sort(lookupOrder.begin(), lookupOrder.end(), [&](size_t lhs, size_t rhs) {
+            return ids[lhs] < ids[rhs];
+        });
+
+        std::vector<boost::optional<Record>> records(ids.size());
+        for (size_t i = 0; i < lookupOrder.size(); ++i) {
+            const auto pos = lookupOrder[i];
+            if (i > 0 && ids[pos] == ids[lookupOrder[i - 1]]) {
+                records[pos] = records[lookupOrder[i - 1]];
+                continue;
+            }
+            if (auto record = seekExact(ids[pos])) {
+                records[pos] = Record{record->id, record->data.getOwned()};
+            }
+        }
+        return records;
+    }
+
     /**
      * Positions this cursor near 'start' or an adjacent record if 'start' does not exist. If there
      * is not an exact match, the cursor is positioned on the directionally previous Record. If no
@@ -295,6 +332,24 @@ public:
         return 0;
     }
 
+    /**
+     * @return bytes of this record store currently held in the storage engine's cache
+     * A return value of zero can mean either nothing is cached, or that the real value is unknown.
+     */
+    virtual int64_t cacheUsageSize(OperationContext* opCtx) const {
+        return 0;
+    }
+
+    /**
+     * Asks the storage engine to exempt this record store from cache eviction, or to stop doing so.
+     * The setting is kept in the storage engine's own metadata and takes effect immediately,
+     * independently of any WriteUnitOfWork.
+     */
+    virtual Status setCacheResident(OperationContext* opCtx, bool cacheResident) {
+        return {ErrorCodes::CommandNotSupported,
+                "The storage engine does not support cache resident collections"};
+    }
+
     // CRUD related
 
     /**
@@ -473,6 +528,18 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * Like compact(), but gives up once 'maxTime' has been spent compacting. Returns true if there
+     * was nothing left to compact, or false if the time limit was reached first. The space
+     * reclaimed before reaching the time limit is kept, so this can be called repeatedly to compact
+     * this RecordStore in small steps.
+     *
+     * Only called if compactSupported() returns true.
+     */
+    virtual StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds maxTime) {
+        MONGO_UNREACHABLE;
+    }
+
     /**
      * Performs record store specific validation to ensure consistency of underlying data
      * structures. If corruption is found, details of the errors will be in the results parameter.
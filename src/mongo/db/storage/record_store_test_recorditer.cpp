@@ -479,5 +479,58 @@ TEST(RecordStoreTestHarness, SeekExactForMissingRecordReturnsNone) {
     ASSERT_FALSE(recordStore->findRecord(opCtx.get(), recordIds[1], &outputData));
 }
 
+// seekExactBatch() must return the records in the order of the requested ids, with boost::none
+// for ids which do not exist.
+TEST(RecordStoreTestHarness, SeekExactBatchReturnsRecordsInRequestedOrder) {
+    const auto harnessHelper{newRecordStoreHarnessHelper()};
+    auto recordStore = harnessHelper->newNonCappedRecordStore();
+    ServiceContext::UniqueOperationContext opCtx{harnessHelper->newOperationContext()};
+
+    const int nToInsert = 5;
+    RecordId recordIds[nToInsert];
+    string datas[nToInsert];
+    for (int i = 0; i < nToInsert; ++i) {
+        StringBuilder sb;
+        sb << "record " << i;
+        datas[i] = sb.str();
+
+        WriteUnitOfWork uow{opCtx.get()};
+        auto res = recordStore->insertRecord(
+            opCtx.get(), datas[i].c_str(), datas[i].size() + 1, Timestamp{});
+        ASSERT_OK(res.getStatus());
+        recordIds[i] = res.getValue();
+        uow.commit();
+    }
+
+    // Delete the third record.
+    {
+        WriteUnitOfWork uow{opCtx.get()};
+        recordStore->deleteRecord(opCtx.get(), recordIds[2]);
+        uow.commit();
+    }
+
+    // Request the records out of order, including a duplicate and the deleted record.
+    std::vector<RecordId> ids{recordIds[4], recordIds[0], recordIds[2], recordIds[4], recordIds[1]};
+    std::vector<boost::optional<int>> expected{4, 0, boost::none, 4, 1};
+    for (bool direction : {true, false}) {
+        auto cursor = recordStore->getCursor(opCtx.get(), direction);
+        auto records = cursor->seekExactBatch(ids);
+        ASSERT_EQ(ids.size(), records.size());
+
+        // Move the cursor, which must not invalidate the returned records.
+        cursor->seekExact(recordIds[3]);
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (!expected[i]) {
+                ASSERT_FALSE(records[i]);
+                continue;
+            }
+            ASSERT(records[i]);
+            ASSERT_EQ(recordIds[*expected[i]], records[i]->id);
+            ASSERT_EQ(datas[*expected[i]], records[i]->data.data());
+        }
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -32,6 +32,7 @@
 #include "mongo/db/storage/storage_engine_impl.h"
 
 #include <algorithm>
+#include <set>
 
 #include "mongo/db/audit.h"
 #include "mongo/db/catalog/catalog_control.h"
@@ -47,12 +48,14 @@
 #include "mongo/db/storage/durable_history_pin.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/kv/temporary_kv_record_store.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/storage/storage_util.h"
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
@@ -180,12 +183,13 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
         // a repair context, if we can't find an ident in the catalog, we generate a catalog entry
         // 'local.orphan.xxxxx' for it. However, in a nonrepair context, the orphaned idents
         // will be dropped in reconcileCatalogAndIdents().
+        std::set<std::string> identsInCatalog;
+        for (const auto& entry : catalogEntries) {
+            identsInCatalog.insert(entry.ident);
+        }
         for (const auto& ident : identsKnownToStorageEngine) {
             if (_catalog->isCollectionIdent(ident)) {
-                bool isOrphan = !std::any_of(
-                    catalogEntries.begin(),
-                    catalogEntries.end(),
-                    [this, &ident](DurableCatalog::Entry entry) { return entry.ident == ident; });
+                bool isOrphan = identsInCatalog.find(ident) == identsInCatalog.end();
                 if (isOrphan) {
                     // If the catalog does not have information about this
                     // collection, we create an new entry for it.
@@ -227,6 +231,8 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
 
     const auto loadingFromUncleanShutdownOrRepair =
         lastShutdownState == LastShutdownState::kUnclean || _options.forRepair;
+    std::vector<CollectionToInit> collectionsToInit;
+    collectionsToInit.reserve(catalogEntries.size());
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
             // If we are loading the catalog after an unclean shutdown or during repair, it's
@@ -301,13 +307,15 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, LastShutdownState l
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs);
+        collectionsToInit.push_back({entry.catalogId, entry.nss, minVisibleTs});
 
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248, "Orphaned collection found", "namespace"_attr = entry.nss);
         }
     }
 
+    _initCollections(opCtx, collectionsToInit, _options.forRepair);
+
     opCtx->recoveryUnit()->abandonSnapshot();
 }
 
@@ -333,6 +341,100 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
         invariant(rs);
     }
 
+    _registerCollection(opCtx, catalogId, nss, std::move(md), std::move(rs), minVisibleTs);
+}
+
+void StorageEngineImpl::_initCollections(OperationContext* opCtx,
+                                         const std::vector<CollectionToInit>& collections,
+                                         bool forRepair) {
+    const size_t numCollections = collections.size();
+
+    std::vector<std::shared_ptr<BSONCollectionCatalogEntry::MetaData>> metadata;
+    std::vector<std::string> idents;
+    metadata.reserve(numCollections);
+    idents.reserve(numCollections);
+    for (const auto& coll : collections) {
+        auto md = _catalog->getMetaData(opCtx, coll.catalogId);
+        uassert(ErrorCodes::MustDowngrade,
+                str::stream() << "Collection does not have UUID in KVCatalog. Collection: "
+                              << coll.nss,
+                md->options.uuid);
+        metadata.push_back(std::move(md));
+        idents.push_back(_catalog->getEntry(coll.catalogId).ident);
+    }
+
+    // Using NULL record stores when repairing, since we don't want to open them before they have
+    // been repaired.
+    std::vector<std::unique_ptr<RecordStore>> recordStores(numCollections);
+    const size_t numThreads =
+        std::min(static_cast<size_t>(gStorageEngineCatalogLoadThreads), numCollections);
+    if (!forRepair && numThreads > 1) {
+        // Opening a record store checks and possibly alters the table's storage engine metadata,
+        // and is independent of every other record store, so spread the work across a pool. The
+        // oplog is left to this thread, since opening it also sets up oplog truncation.
+        ThreadPool::Options options;
+        options.poolName = "CatalogLoaderThreadPool";
+        options.threadNamePrefix = "CatalogLoader-";
+        options.maxThreads = numThreads;
+        options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+        ThreadPool pool(options);
+        pool.startup();
+
+        AtomicWord<size_t> nextCollection{0};
+        auto errorMutex = MONGO_MAKE_LATCH("StorageEngineImpl::_initCollections");
+        Status openStatus = Status::OK();
+        for (size_t i = 0; i < numThreads; ++i) {
+            pool.schedule([&](Status status) {
+                invariant(status);
+                auto workerOpCtx = cc().makeOperationContext();
+                for (size_t idx = nextCollection.fetchAndAdd(1); idx < numCollections;
+                     idx = nextCollection.fetchAndAdd(1)) {
+                    const auto& nss = collections[idx].nss;
+                    if (nss.isOplog()) {
+                        continue;
+                    }
+                    try {
+                        recordStores[idx] = _engine->getRecordStore(
+                            workerOpCtx.get(), nss.ns(), idents[idx], metadata[idx]->options);
+                        invariant(recordStores[idx]);
+                    } catch (const DBException& ex) {
+                        stdx::lock_guard<Latch> lk(errorMutex);
+                        if (openStatus.isOK()) {
+                            openStatus = ex.toStatus();
+                        }
+                        return;
+                    }
+                }
+            });
+        }
+        pool.shutdown();
+        pool.join();
+        uassertStatusOK(openStatus);
+    }
+
+    for (size_t i = 0; i < numCollections; ++i) {
+        const auto& coll = collections[i];
+        if (!forRepair && !recordStores[i]) {
+            recordStores[i] =
+                _engine->getRecordStore(opCtx, coll.nss.ns(), idents[i], metadata[i]->options);
+            invariant(recordStores[i]);
+        }
+        _registerCollection(opCtx,
+                            coll.catalogId,
+                            coll.nss,
+                            std::move(metadata[i]),
+                            std::move(recordStores[i]),
+                            coll.minVisibleTs);
+    }
+}
+
+void StorageEngineImpl::_registerCollection(
+    OperationContext* opCtx,
+    RecordId catalogId,
+    const NamespaceString& nss,
+    std::shared_ptr<BSONCollectionCatalogEntry::MetaData> md,
+    std::unique_ptr<RecordStore> rs,
+    Timestamp minVisibleTs) {
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, md, std::move(rs));
     collection->setMinimumVisibleSnapshot(minVisibleTs);
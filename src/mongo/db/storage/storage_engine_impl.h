@@ -33,6 +33,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/base/string_data.h"
@@ -361,6 +362,37 @@ private:
                          bool forRepair,
                          Timestamp minVisibleTs);
 
+    /**
+     * A collection found in the catalog by loadCatalog(), which is to be registered in the
+     * CollectionCatalog.
+     */
+    struct CollectionToInit {
+        RecordId catalogId;
+        NamespaceString nss;
+        Timestamp minVisibleTs;
+    };
+
+    /**
+     * Does the work of _initCollection() for every collection in 'collections'. The record stores
+     * of the collections are opened concurrently by up to 'storageEngineCatalogLoadThreads'
+     * threads, each with its own OperationContext, while the collections are registered in the
+     * CollectionCatalog by the calling thread.
+     */
+    void _initCollections(OperationContext* opCtx,
+                          const std::vector<CollectionToInit>& collections,
+                          bool forRepair);
+
+    /**
+     * Registers a collection whose metadata has been read and whose record store, if any, has
+     * been opened in the CollectionCatalog.
+     */
+    void _registerCollection(OperationContext* opCtx,
+                             RecordId catalogId,
+                             const NamespaceString& nss,
+                             std::shared_ptr<BSONCollectionCatalogEntry::MetaData> md,
+                             std::unique_ptr<RecordStore> rs,
+                             Timestamp minVisibleTs);
+
     Status _dropCollectionsNoTimestamp(OperationContext* opCtx, const std::vector<UUID>& toDrop);
 
     /**
@@ -34,6 +34,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 
 #include "mongo/logv2/log.h"
+#include "mongo/util/str.h"
 
 namespace moe = mongo::optionenvironment;
 
@@ -64,6 +65,30 @@ Status WiredTigerGlobalOptions::store(const moe::Environment& params) {
               "option"_attr = wiredTigerGlobalOptions.indexConfig);
     }
 
+    if (wiredTigerGlobalOptions.isTieredStorageEnabled()) {
+        if (wiredTigerGlobalOptions.tieredStorageBucket.empty()) {
+            return {ErrorCodes::BadValue,
+                    "A tiered storage bucket must be configured along with its storage source"};
+        }
+
+        // These are passed to wiredtiger_open() as quoted strings, which cannot contain quotes.
+        for (auto&& value : {wiredTigerGlobalOptions.tieredStorageSource,
+                             wiredTigerGlobalOptions.tieredStorageExtensionPath,
+                             wiredTigerGlobalOptions.tieredStorageBucket,
+                             wiredTigerGlobalOptions.tieredStorageBucketPrefix}) {
+            if (value.find('"') != std::string::npos) {
+                return {ErrorCodes::BadValue,
+                        str::stream() << "Tiered storage options cannot contain '\"': " << value};
+            }
+        }
+
+        LOGV2(6170446,
+              "Tiered storage enabled",
+              "storageSource"_attr = wiredTigerGlobalOptions.tieredStorageSource,
+              "bucket"_attr = wiredTigerGlobalOptions.tieredStorageBucket,
+              "bucketPrefix"_attr = wiredTigerGlobalOptions.tieredStorageBucketPrefix);
+    }
+
     return Status::OK();
 }
 
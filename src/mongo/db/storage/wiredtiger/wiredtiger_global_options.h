@@ -46,6 +46,7 @@ public:
           zstdCompressorLevel(0),
           directoryForIndexes(false),
           maxCacheOverflowFileSizeGBDeprecated(0),
+          tieredStorageLocalRetentionSecs(0),
           useCollectionPrefixCompression(false),
           useIndexPrefixCompression(false){};
 
@@ -59,14 +60,28 @@ public:
     double maxCacheOverflowFileSizeGBDeprecated;
     std::string engineConfig;
 
+    std::string tieredStorageSource;
+    std::string tieredStorageExtensionPath;
+    std::string tieredStorageBucket;
+    std::string tieredStorageBucketPrefix;
+    int tieredStorageLocalRetentionSecs;
+
     std::string collectionBlockCompressor;
     bool useCollectionPrefixCompression;
+    std::string indexBlockCompressor;
     bool useIndexPrefixCompression;
     std::string collectionConfig;
     std::string indexConfig;
 
     static Status validateWiredTigerCompressor(const std::string&);
 
+    /**
+     * Returns true if checkpointed table data is flushed to a tiered storage source.
+     */
+    bool isTieredStorageEnabled() const {
+        return !tieredStorageSource.empty();
+    }
+
     /**
      * Returns current history file size limit in MB.
      * Always returns 0 for unbounded.
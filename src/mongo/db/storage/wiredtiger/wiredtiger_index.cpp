@@ -173,6 +173,12 @@ StatusWith<std::string> WiredTigerIndex::generateCreateString(
         ss << "prefix_compression=true,";
     }
 
+    // Prefix compression only removes the prefix a key shares with the previous key on its page.
+    // Block compression additionally compresses the pages on disk, which helps compound indexes
+    // whose leading fields repeat long values, at the cost of decompressing pages read into the
+    // cache.
+    ss << "block_compressor=" << wiredTigerGlobalOptions.indexBlockCompressor << ",";
+
     ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())
               ->getTableCreateConfig(collectionNamespace.ns());
     ss << sysIndexConfig << ",";
@@ -496,6 +502,36 @@ Status WiredTigerIndex::compact(OperationContext* opCtx) {
     return Status::OK();
 }
 
+StatusWith<bool> WiredTigerIndex::compactIncrementally(OperationContext* opCtx, Seconds maxTime) {
+    dassert(opCtx->lockState()->isWriteLocked());
+    invariant(maxTime > Seconds(0));
+    WiredTigerSessionCache* cache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    if (cache->isEphemeral()) {
+        return true;
+    }
+
+    WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
+    opCtx->recoveryUnit()->abandonSnapshot();
+    const std::string config = str::stream() << "timeout=" << durationCount<Seconds>(maxTime);
+    int ret = s->compact(s, uri().c_str(), config.c_str());
+    if (MONGO_unlikely(WTCompactIndexEBUSY.shouldFail())) {
+        ret = EBUSY;
+    }
+
+    if (ret == EBUSY) {
+        return Status(ErrorCodes::Interrupted,
+                      str::stream() << "Compaction interrupted on " << uri().c_str()
+                                    << " due to cache eviction pressure");
+    }
+
+    // The passes completed before the timeout are checkpointed, so their work is not lost.
+    if (ret == ETIMEDOUT) {
+        return false;
+    }
+    invariantWTOK(ret);
+    return true;
+}
+
 KeyString::Version WiredTigerIndex::_handleVersionInfo(OperationContext* ctx,
                                                        const std::string& uri,
                                                        const IndexDescriptor* desc,
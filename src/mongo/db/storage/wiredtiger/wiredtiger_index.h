@@ -125,6 +125,8 @@ public:
 
     Status compact(OperationContext* opCtx) override;
 
+    StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds maxTime) override;
+
     const std::string& uri() const {
         return _uri;
     }
@@ -44,6 +44,7 @@
 #include "mongo/db/storage/storage_engine_lock_file.h"
 #include "mongo/db/storage/storage_engine_metadata.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -100,6 +101,14 @@ public:
                               "RAM. See http://dochub.mongodb.org/core/faq-memory-diagnostics-wt");
             }
         }
+        if (wiredTigerGlobalOptions.isTieredStorageEnabled() &&
+            !wiredTigerGlobalOptions.tieredStorageExtensionPath.empty()) {
+            WiredTigerExtensions::get(getGlobalServiceContext())
+                ->addExtension(str::stream()
+                               << "\"" << wiredTigerGlobalOptions.tieredStorageExtensionPath
+                               << "\"");
+        }
+
         const bool ephemeral = false;
         auto kv =
             std::make_unique<WiredTigerKVEngine>(getCanonicalName().toString(),
@@ -41,6 +41,7 @@
 #define NVALGRIND
 #endif
 
+#include <algorithm>
 #include <fmt/format.h>
 #include <iomanip>
 #include <memory>
@@ -262,6 +263,160 @@ TicketHolder openWriteTransaction(128);
 TicketHolder openReadTransaction(128);
 }  // namespace
 
+/**
+ * Adjusts the number of read and write tickets, so that they need not be tuned by hand for each
+ * hardware shape. Like flow control, it increases additively and decreases multiplicatively: a
+ * ticket holder grows while callers had to queue for tickets and the cache keeps up, and every
+ * holder shrinks while the cache is under eviction pressure, since more concurrent transactions
+ * then only pin more dirty data.
+ */
+class WiredTigerKVEngine::WiredTigerTicketController : public BackgroundJob {
+public:
+    explicit WiredTigerTicketController(WiredTigerSessionCache* sessionCache)
+        : BackgroundJob(false /* deleteSelf */), _sessionCache(sessionCache) {}
+
+    virtual string name() const {
+        return "WTTicketController";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(6170400, 1, "starting {name} thread", "name"_attr = name());
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                // Check once a second whether adjustment has been enabled.
+                const auto intervalMillis =
+                    gWiredTigerConcurrentTransactionsAdjustmentIntervalMillis.load();
+                _condvar.wait_for(lock,
+                                  stdx::chrono::milliseconds(intervalMillis > 0 ? intervalMillis
+                                                                                : 1000));
+            }
+
+            if (_shuttingDown.load() ||
+                gWiredTigerConcurrentTransactionsAdjustmentIntervalMillis.load() <= 0) {
+                continue;
+            }
+
+            const bool cachePressure = _isCacheUnderEvictionPressure();
+            if (cachePressure) {
+                _cachePressureIntervals.fetchAndAdd(1);
+            }
+            _adjust(&_write, cachePressure);
+            _adjust(&_read, cachePressure);
+        }
+        LOGV2_DEBUG(6170401, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+    void appendStats(BSONObjBuilder& b) const {
+        BSONObjBuilder bb(b.subobjStart("adjustment"));
+        bb.append("cachePressureIntervals", _cachePressureIntervals.load());
+        for (const auto* state : {&_write, &_read}) {
+            BSONObjBuilder holderBuilder(bb.subobjStart(state->name));
+            holderBuilder.append("increases", state->increases.load());
+            holderBuilder.append("decreases", state->decreases.load());
+        }
+    }
+
+private:
+    struct HolderState {
+        HolderState(StringData name, TicketHolder* holder) : name(name), holder(holder) {}
+
+        const StringData name;
+        TicketHolder* const holder;
+        long long lastTotalQueued = 0;
+        AtomicWord<long long> increases;
+        AtomicWord<long long> decreases;
+    };
+
+    // The cache fill ratios at which WiredTiger makes application threads help with eviction,
+    // using the defaults of its eviction_trigger and eviction_dirty_trigger settings.
+    static constexpr double kCacheUsedPressureRatio = 0.95;
+    static constexpr double kCacheDirtyPressureRatio = 0.20;
+
+    bool _isCacheUnderEvictionPressure() {
+        auto session = _sessionCache->getSession();
+        auto getStat = [&](int key) {
+            return WiredTigerUtil::getStatisticsValue(
+                session->getSession(), "statistics:", "statistics=(fast)", key);
+        };
+
+        auto maxBytes = getStat(WT_STAT_CONN_CACHE_BYTES_MAX);
+        auto usedBytes = getStat(WT_STAT_CONN_CACHE_BYTES_INUSE);
+        auto dirtyBytes = getStat(WT_STAT_CONN_CACHE_BYTES_DIRTY);
+        if (!maxBytes.isOK() || !usedBytes.isOK() || !dirtyBytes.isOK() ||
+            maxBytes.getValue() <= 0) {
+            return false;
+        }
+
+        const double max = maxBytes.getValue();
+        return usedBytes.getValue() / max > kCacheUsedPressureRatio ||
+            dirtyBytes.getValue() / max > kCacheDirtyPressureRatio;
+    }
+
+    void _adjust(HolderState* state, bool cachePressure) {
+        const auto totalQueued = state->holder->totalQueued();
+        const bool queued = totalQueued > state->lastTotalQueued;
+        state->lastTotalQueued = totalQueued;
+
+        const int minTickets = gWiredTigerConcurrentTransactionsAdjustmentMin.load();
+        const int maxTickets =
+            std::max(minTickets, gWiredTigerConcurrentTransactionsAdjustmentMax.load());
+        const int current = state->holder->outof();
+
+        int target = current;
+        if (cachePressure) {
+            target = current - current / 4;
+        } else if (queued) {
+            target = current + std::max(1, current / 10);
+        }
+        target = std::clamp(target, minTickets, maxTickets);
+        if (target == current) {
+            return;
+        }
+
+        auto status = state->holder->resize(target);
+        if (!status.isOK()) {
+            LOGV2_WARNING(6170402,
+                          "Failed to adjust WiredTiger tickets",
+                          "tickets"_attr = state->name,
+                          "target"_attr = target,
+                          "error"_attr = status);
+            return;
+        }
+
+        (target > current ? state->increases : state->decreases).fetchAndAdd(1);
+        LOGV2_DEBUG(6170403,
+                    2,
+                    "Adjusted WiredTiger tickets",
+                    "tickets"_attr = state->name,
+                    "from"_attr = current,
+                    "to"_attr = target,
+                    "cachePressure"_attr = cachePressure);
+    }
+
+    WiredTigerSessionCache* _sessionCache;
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketController::_mutex");  // protects _condvar
+    stdx::condition_variable _condvar;
+
+    HolderState _write{"write"_sd, &openWriteTransaction};
+    HolderState _read{"read"_sd, &openReadTransaction};
+    AtomicWord<long long> _cachePressureIntervals;
+};
+
 OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
     : ServerParameter(name, spt), _data(&openWriteTransaction) {}
 
@@ -325,6 +480,8 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
       _ephemeral(ephemeral),
       _inRepairMode(repair),
       _readOnly(readOnly),
+      _tieredStorageEnabled(!ephemeral && !readOnly &&
+                            wiredTigerGlobalOptions.isTieredStorageEnabled()),
       _keepDataHistory(serverGlobalParams.enableMajorityReadConcern) {
     _pinnedOplogTimestamp.store(Timestamp::max().asULL());
     boost::filesystem::path journalPath = path;
@@ -379,6 +536,16 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
        << ",close_handle_minimum=" << gWiredTigerFileHandleCloseMinimum << "),";
     ss << "statistics_log=(wait=" << wiredTigerGlobalOptions.statisticsLogDelaySecs << "),";
 
+    if (_tieredStorageEnabled) {
+        // The values are quoted, as for the extension path, since bucket names and prefixes may
+        // contain characters which are special in configuration strings, such as '/' or ':'.
+        ss << "tiered_storage=(name=\"" << wiredTigerGlobalOptions.tieredStorageSource
+           << "\",bucket=\"" << wiredTigerGlobalOptions.tieredStorageBucket
+           << "\",bucket_prefix=\"" << wiredTigerGlobalOptions.tieredStorageBucketPrefix
+           << "\",local_retention=" << wiredTigerGlobalOptions.tieredStorageLocalRetentionSecs
+           << "),";
+    }
+
     if (shouldLog(::mongo::logv2::LogComponent::kStorageRecovery, logv2::LogSeverity::Debug(3))) {
         ss << "verbose=[recovery_progress,checkpoint_progress,compact_progress,recovery],";
     } else {
@@ -525,6 +692,9 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    _ticketController = std::make_unique<WiredTigerTicketController>(_sessionCache.get());
+    _ticketController->go();
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -610,18 +780,17 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
     BSONObjBuilder bb(b.subobjStart("concurrentTransactions"));
     {
         BSONObjBuilder bbb(bb.subobjStart("write"));
-        bbb.append("out", openWriteTransaction.used());
-        bbb.append("available", openWriteTransaction.available());
-        bbb.append("totalTickets", openWriteTransaction.outof());
+        openWriteTransaction.appendStats(bbb);
         bbb.done();
     }
     {
         BSONObjBuilder bbb(bb.subobjStart("read"));
-        bbb.append("out", openReadTransaction.used());
-        bbb.append("available", openReadTransaction.available());
-        bbb.append("totalTickets", openReadTransaction.outof());
+        openReadTransaction.appendStats(bbb);
         bbb.done();
     }
+    if (_ticketController) {
+        _ticketController->appendStats(bb);
+    }
     bb.done();
 }
 
@@ -732,6 +901,9 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_ticketController) {
+        _ticketController->shutdown();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps.",
@@ -1872,6 +2044,16 @@ void WiredTigerKVEngine::checkpoint() {
                 // Now that the checkpoint is durable, publish the oplog needed to recover from it.
                 _oplogNeededForCrashRecovery.store(oplogNeededForRollback.getValue().asULL());
             }
+
+            if (_tieredStorageEnabled) {
+                // Hand the newly checkpointed data to the storage source. WiredTiger uploads the
+                // objects on its own thread, so the checkpoint thread does not wait on them.
+                if (auto ret = s->flush_tier(s, "sync=off"); ret != 0) {
+                    LOGV2_WARNING(6170447,
+                                  "Failed to flush checkpointed data to tiered storage",
+                                  "error"_attr = wtRCToStatus(ret));
+                }
+            }
         }
     } catch (const WriteConflictException&) {
         LOGV2_WARNING(22346, "Checkpoint encountered a write conflict exception.");
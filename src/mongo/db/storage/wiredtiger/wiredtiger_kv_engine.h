@@ -297,7 +297,7 @@ public:
         return _oplogManager.get();
     }
 
-    static void appendGlobalStats(BSONObjBuilder& b);
+    void appendGlobalStats(BSONObjBuilder& b);
 
     Timestamp getStableTimestamp() const override;
     Timestamp getOldestTimestamp() const override;
@@ -362,6 +362,7 @@ public:
 
 private:
     class WiredTigerSessionSweeper;
+    class WiredTigerTicketController;
 
     struct IdentToDrop {
         std::string uri;
@@ -447,6 +448,9 @@ private:
     const bool _inRepairMode;
     bool _readOnly;
 
+    // Whether checkpointed table data is flushed to the configured tiered storage source.
+    const bool _tieredStorageEnabled;
+
     // If _keepDataHistory is true, then the storage engine keeps all history after the stable
     // timestamp, and WiredTigerKVEngine is responsible for advancing the oldest timestamp. If
     // _keepDataHistory is false (i.e. majority reads are disabled), then we only keep history after
@@ -455,6 +459,7 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerTicketController> _ticketController;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -82,6 +82,7 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
                                           WiredTigerRecoveryUnit::get(opCtx)->getSessionCache(),
                                           oplogRecordStore);
 
+    _oplogRecordStore = oplogRecordStore;
     _isRunning = true;
     _shuttingDown = false;
 }
@@ -102,6 +103,7 @@ void WiredTigerOplogManager::haltVisibilityThread() {
 
         _shuttingDown = true;
         _isRunning = false;
+        _oplogRecordStore = nullptr;
     }
 
     if (_oplogVisibilityThread.joinable()) {
@@ -115,6 +117,10 @@ void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
     if (!_triggerOplogVisibilityUpdate) {
         _triggerOplogVisibilityUpdate = true;
         _oplogVisibilityThreadCV.notify_one();
+    } else if (_oplogRecordStore && _oplogRecordStore->haveCappedWaiters()) {
+        // An update is already pending, but may be delayed for batching. Cut the delay short now
+        // that awaitData cursors are waiting for new oplog entries.
+        _oplogVisibilityThreadCV.notify_one();
     }
 }
 
@@ -149,6 +155,7 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     ++_opsWaitingForOplogVisibilityUpdate;
     invariant(_opsWaitingForOplogVisibilityUpdate > 0);
     ScopeGuard exitGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
+    _oplogVisibilityThreadCV.notify_one();
 
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
     // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
@@ -200,21 +207,13 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
 
             // If we are not shutting down and nobody is actively waiting for the oplog to become
             // visible, delay a bit to batch more requests into one update and reduce system load.
-            auto now = Date_t::now();
-            auto deadline = now + Milliseconds(kDelayMillis);
-
-            auto wakeUpEarlyForWaitersPredicate = [&] {
+            // Callers that start waiting for visibility, and commits while awaitData cursors wait
+            // on the oplog, signal this thread to end the delay, so there is no need to poll.
+            auto deadline = Date_t::now() + Milliseconds(kDelayMillis);
+            _oplogVisibilityThreadCV.wait_until(lk, deadline.toSystemTimePoint(), [&] {
                 return _shuttingDown || _opsWaitingForOplogVisibilityUpdate ||
                     oplogRecordStore->haveCappedWaiters();
-            };
-
-            // Check once a millisecond, up to the delay deadline, whether the delay should be
-            // preempted because of waiting callers or shutdown.
-            while (now < deadline &&
-                   !_oplogVisibilityThreadCV.wait_until(
-                       lk, now.toSystemTimePoint(), wakeUpEarlyForWaitersPredicate)) {
-                now += Milliseconds(1);
-            }
+            });
         }
 
         while (!_shuttingDown && MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail())) {
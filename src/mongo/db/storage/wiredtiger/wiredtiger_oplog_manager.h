@@ -44,7 +44,9 @@ class WiredTigerSessionCache;
  * Manages oplog visibility.
  *
  * On demand, queries WiredTiger's all_durable timestamp value and updates the oplog read timestamp.
- * This is done asynchronously on a thread that startVisibilityThread() will set up.
+ * This is done asynchronously on a thread that startVisibilityThread() will set up. The thread
+ * runs when oplog writes commit, and batches updates unless there are callers waiting for
+ * visibility, in which case it runs as soon as they start waiting or new writes commit.
  *
  * The WT all_durable timestamp is the in-memory timestamp behind which there are no oplog holes
  * in-memory. Note, all_durable is the timestamp that has no holes in-memory, which may NOT be
@@ -125,6 +127,9 @@ private:
     bool _isRunning = false;
     bool _shuttingDown = false;
 
+    // The oplog whose visibility is managed, while the visibility thread is running.
+    WiredTigerRecordStore* _oplogRecordStore = nullptr;
+
     // Triggers an oplog visibility update -- can be delayed if no callers are waiting for an
     // update, per the _opsWaitingForOplogVisibility counter.
     bool _triggerOplogVisibilityUpdate = false;
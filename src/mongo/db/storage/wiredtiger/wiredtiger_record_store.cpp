@@ -295,6 +295,29 @@ bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
     return currRetentionHours >= minRetentionHours;
 }
 
+void WiredTigerRecordStore::OplogStones::getOplogStonesStats(BSONObjBuilder& builder) const {
+    builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
+    builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+    if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
+        builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
+    }
+
+    // Report how far truncation is lagging behind the configured oplog window, so that operators
+    // can tell whether the reclaim thread is keeping up with the write rate.
+    stdx::lock_guard<Latch> lk(_mutex);
+    int64_t totalBytes = 0;
+    for (auto&& stone : _stones) {
+        totalBytes += stone.bytes;
+    }
+    builder.append("numStones", static_cast<long long>(_stones.size()));
+    builder.append("bytesPendingTruncation",
+                   static_cast<long long>(std::max<int64_t>(totalBytes - *_rs->_oplogMaxSize, 0)));
+    if (!_stones.empty()) {
+        auto retentionMS = durationCount<Milliseconds>(Date_t::now() - _stones.front().wallTime);
+        builder.append("oldestStoneAgeHours", retentionMS / kNumMSInHour);
+    }
+}
+
 boost::optional<WiredTigerRecordStore::OplogStones::Stone>
 WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
     stdx::lock_guard<Latch> lk(_mutex);
@@ -1031,6 +1054,21 @@ int64_t WiredTigerRecordStore::freeStorageSize(OperationContext* opCtx) const {
     return WiredTigerUtil::getIdentReuseSize(session->getSession(), getURI());
 }
 
+int64_t WiredTigerRecordStore::cacheUsageSize(OperationContext* opCtx) const {
+    invariant(opCtx->lockState()->isReadLocked());
+
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSessionNoTxn();
+    auto result = WiredTigerUtil::getStatisticsValue(session->getSession(),
+                                                     "statistics:" + getURI(),
+                                                     "statistics=(fast)",
+                                                     WT_STAT_DSRC_CACHE_BYTES_INUSE);
+    return result.isOK() ? result.getValue() : 0;
+}
+
+Status WiredTigerRecordStore::setCacheResident(OperationContext* opCtx, bool cacheResident) {
+    return WiredTigerUtil::setTableCacheResident(opCtx, getURI(), cacheResident);
+}
+
 // Retrieve the value from a positioned cursor.
 RecordData WiredTigerRecordStore::_getData(const WiredTigerCursor& cursor) const {
     WT_ITEM value;
@@ -1620,6 +1658,38 @@ Status WiredTigerRecordStore::compact(OperationContext* opCtx) {
     return Status::OK();
 }
 
+StatusWith<bool> WiredTigerRecordStore::compactIncrementally(OperationContext* opCtx,
+                                                             Seconds maxTime) {
+    dassert(opCtx->lockState()->isWriteLocked());
+    invariant(maxTime > Seconds(0));
+
+    WiredTigerSessionCache* cache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    if (cache->isEphemeral()) {
+        return true;
+    }
+
+    WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
+    opCtx->recoveryUnit()->abandonSnapshot();
+    const std::string config = str::stream() << "timeout=" << durationCount<Seconds>(maxTime);
+    int ret = s->compact(s, getURI().c_str(), config.c_str());
+    if (MONGO_unlikely(WTCompactRecordStoreEBUSY.shouldFail())) {
+        ret = EBUSY;
+    }
+
+    if (ret == EBUSY) {
+        return Status(ErrorCodes::Interrupted,
+                      str::stream() << "Compaction interrupted on " << getURI().c_str()
+                                    << " due to cache eviction pressure");
+    }
+
+    // The passes completed before the timeout are checkpointed, so their work is not lost.
+    if (ret == ETIMEDOUT) {
+        return false;
+    }
+    invariantWTOK(ret);
+    return true;
+}
+
 void WiredTigerRecordStore::validate(OperationContext* opCtx,
                                      ValidateResults* results,
                                      BSONObjBuilder* output) {
@@ -1795,9 +1865,7 @@ public:
     virtual void rollback() {
         LOGV2_DEBUG(
             22404, 3, "WiredTigerRecordStore: rolling back NumRecordsChange", "diff"_attr = -_diff);
-        if (_rs->_sizeInfo->numRecords.addAndFetch(-_diff) < 0) {
-            _rs->_sizeInfo->numRecords.store(0);
-        }
+        _rs->_sizeInfo->numRecords.add(-_diff);
     }
 
 private:
@@ -1815,8 +1883,7 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
     }
 
     opCtx->recoveryUnit()->registerChange(std::make_unique<NumRecordsChange>(this, diff));
-    if (_sizeInfo->numRecords.addAndFetch(diff) < 0)
-        _sizeInfo->numRecords.store(0);
+    _sizeInfo->numRecords.add(diff);
 }
 
 class WiredTigerRecordStore::DataSizeChange : public RecoveryUnit::Change {
@@ -1844,8 +1911,7 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
     if (opCtx)
         opCtx->recoveryUnit()->registerChange(std::make_unique<DataSizeChange>(this, amount));
 
-    if (_sizeInfo->dataSize.fetchAndAdd(amount) < 0)
-        _sizeInfo->dataSize.store(std::max(amount, int64_t(0)));
+    _sizeInfo->dataSize.add(amount);
 
     if (_sizeStorer)
         _sizeStorer->store(_uri, _sizeInfo);
@@ -142,6 +142,10 @@ public:
 
     virtual int64_t freeStorageSize(OperationContext* opCtx) const;
 
+    int64_t cacheUsageSize(OperationContext* opCtx) const override;
+
+    Status setCacheResident(OperationContext* opCtx, bool cacheResident) override;
+
     // CRUD related
 
     virtual bool findRecord(OperationContext* opCtx, const RecordId& id, RecordData* out) const;
@@ -183,6 +187,8 @@ public:
 
     virtual Status compact(OperationContext* opCtx) final;
 
+    StatusWith<bool> compactIncrementally(OperationContext* opCtx, Seconds maxTime) final;
+
     virtual void validate(OperationContext* opCtx,
                           ValidateResults* results,
                           BSONObjBuilder* output);
@@ -0,0 +1,311 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store_test_harness.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/random.h"
+
+namespace mongo {
+namespace {
+
+// The number of entries loaded before the read and update benchmarks run.
+constexpr int kNumEntries = 10000;
+constexpr int kLoadBatchSize = 1000;
+
+/**
+ * Returns a value of 'size' bytes that is unique for each 'i'.
+ */
+std::string makeValue(int64_t i, int64_t size) {
+    auto value = std::to_string(i);
+    value.resize(std::max<size_t>(size, value.size()), 'x');
+    return value;
+}
+
+/**
+ * Opens a fresh WiredTigerKVEngine in a temporary directory for each benchmark. The directory is
+ * created under TMPDIR, so running with TMPDIR pointing at a tmpfs mount keeps disk latency out
+ * of the results.
+ */
+class WiredTigerBenchmarkHelper {
+public:
+    WiredTigerBenchmarkHelper() : _opCtx(_harness.newOperationContext()) {}
+
+    OperationContext* opCtx() const {
+        return _opCtx.get();
+    }
+
+    WiredTigerRecoveryUnit* recoveryUnit() const {
+        return WiredTigerRecoveryUnit::get(_opCtx.get());
+    }
+
+    std::unique_ptr<RecordStore> newRecordStore() {
+        return _harness.newNonCappedRecordStore("bm.records");
+    }
+
+    std::unique_ptr<SortedDataInterface> newIndex() {
+        const NamespaceString nss("bm.records");
+        auto spec = BSON("key" << BSON("a" << 1) << "name"
+                               << "a_1"
+                               << "v" << static_cast<int>(IndexDescriptor::kLatestIndexVersion));
+        _desc = std::make_unique<IndexDescriptor>("", spec);
+
+        auto config = WiredTigerIndex::generateCreateString(
+            std::string(kWiredTigerEngineName), "", "", nss, *_desc);
+        invariant(config.getStatus());
+
+        const std::string uri = WiredTigerKVEngine::kTableUriPrefix + "bm.index";
+        invariantWTOK(WiredTigerIndex::Create(_opCtx.get(), uri, config.getValue()));
+        return std::make_unique<WiredTigerIndexStandard>(
+            _opCtx.get(), uri, "bm.index", KeyFormat::Long, _desc.get());
+    }
+
+    /**
+     * Inserts kNumEntries records of 'size' bytes and returns their ids in insertion order.
+     */
+    std::vector<RecordId> loadRecords(RecordStore* rs, int64_t size) {
+        std::vector<RecordId> ids;
+        for (int i = 0; i < kNumEntries; i += kLoadBatchSize) {
+            WriteUnitOfWork wuow(opCtx());
+            for (int j = i; j < std::min(i + kLoadBatchSize, kNumEntries); ++j) {
+                auto value = makeValue(j, size);
+                ids.push_back(uassertStatusOK(
+                    rs->insertRecord(opCtx(), value.c_str(), value.size(), Timestamp())));
+            }
+            wuow.commit();
+        }
+        recoveryUnit()->abandonSnapshot();
+        return ids;
+    }
+
+    /**
+     * Inserts kNumEntries keys of 'size' bytes and returns them, without RecordIds, in key order.
+     */
+    std::vector<BSONObj> loadKeys(SortedDataInterface* index, int64_t size) {
+        std::vector<BSONObj> keys;
+        for (int i = 0; i < kNumEntries; i += kLoadBatchSize) {
+            WriteUnitOfWork wuow(opCtx());
+            for (int j = i; j < std::min(i + kLoadBatchSize, kNumEntries); ++j) {
+                keys.push_back(BSON("" << makeValue(j, size)));
+                uassertStatusOK(index->insert(opCtx(), makeKey(index, keys.back(), j + 1), true));
+            }
+            wuow.commit();
+        }
+        recoveryUnit()->abandonSnapshot();
+        std::sort(keys.begin(), keys.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+        return keys;
+    }
+
+    static KeyString::Value makeKey(SortedDataInterface* index,
+                                    const BSONObj& key,
+                                    boost::optional<int64_t> recordId) {
+        KeyString::Builder builder(index->getKeyStringVersion(), key, index->getOrdering());
+        if (recordId) {
+            builder.appendRecordId(RecordId(*recordId));
+        }
+        return builder.getValueCopy();
+    }
+
+private:
+    WiredTigerHarnessHelper _harness;
+    ServiceContext::UniqueOperationContext _opCtx;
+    std::unique_ptr<IndexDescriptor> _desc;
+};
+
+void BM_RecordStoreInsert(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto rs = helper.newRecordStore();
+
+    int64_t i = 0;
+    for (auto _ : state) {
+        auto value = makeValue(i++, state.range(0));
+        WriteUnitOfWork wuow(helper.opCtx());
+        benchmark::DoNotOptimize(
+            rs->insertRecord(helper.opCtx(), value.c_str(), value.size(), Timestamp()));
+        wuow.commit();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RecordStoreUpdate(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto rs = helper.newRecordStore();
+    auto ids = helper.loadRecords(rs.get(), state.range(0));
+
+    int64_t i = 0;
+    for (auto _ : state) {
+        auto value = makeValue(-i, state.range(0));
+        WriteUnitOfWork wuow(helper.opCtx());
+        invariant(rs->updateRecord(
+            helper.opCtx(), ids[i++ % ids.size()], value.c_str(), value.size()));
+        wuow.commit();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_RecordStoreSeek(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto rs = helper.newRecordStore();
+    auto ids = helper.loadRecords(rs.get(), state.range(0));
+
+    PseudoRandom random(1);
+    auto cursor = rs->getCursor(helper.opCtx());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cursor->seekExact(ids[random.nextInt32(ids.size())]));
+    }
+}
+
+void BM_RecordStoreScan(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto rs = helper.newRecordStore();
+    helper.loadRecords(rs.get(), state.range(0));
+
+    for (auto _ : state) {
+        auto cursor = rs->getCursor(helper.opCtx());
+        while (auto record = cursor->next()) {
+            benchmark::DoNotOptimize(record);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumEntries);
+}
+
+void BM_IndexInsert(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto index = helper.newIndex();
+
+    int64_t i = 0;
+    for (auto _ : state) {
+        auto key = WiredTigerBenchmarkHelper::makeKey(
+            index.get(), BSON("" << makeValue(i, state.range(0))), i + 1);
+        ++i;
+        WriteUnitOfWork wuow(helper.opCtx());
+        invariant(index->insert(helper.opCtx(), key, true));
+        wuow.commit();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void BM_IndexSeek(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto index = helper.newIndex();
+    auto keys = helper.loadKeys(index.get(), state.range(0));
+
+    std::vector<KeyString::Value> seekKeys;
+    for (auto&& key : keys) {
+        seekKeys.push_back(WiredTigerBenchmarkHelper::makeKey(index.get(), key, boost::none));
+    }
+
+    PseudoRandom random(1);
+    auto cursor = index->newCursor(helper.opCtx());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cursor->seekExact(seekKeys[random.nextInt32(seekKeys.size())]));
+    }
+}
+
+void BM_IndexScan(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto index = helper.newIndex();
+    auto keys = helper.loadKeys(index.get(), state.range(0));
+    auto start = WiredTigerBenchmarkHelper::makeKey(index.get(), keys.front(), boost::none);
+
+    for (auto _ : state) {
+        auto cursor = index->newCursor(helper.opCtx());
+        for (auto entry = cursor->seek(start); entry; entry = cursor->next()) {
+            benchmark::DoNotOptimize(entry);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumEntries);
+}
+
+/**
+ * Opens a cursor that is returned to the session's cursor cache when destroyed, so every
+ * iteration after the first reuses a cached cursor.
+ */
+void BM_CursorCacheHit(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto rs = checked_cast<WiredTigerRecordStore*>(helper.newRecordStore().release());
+    std::unique_ptr<RecordStore> owner(rs);
+
+    for (auto _ : state) {
+        WiredTigerCursor cursor(rs->getURI(), rs->tableId(), false, helper.opCtx());
+        benchmark::DoNotOptimize(cursor.get());
+    }
+}
+
+/**
+ * Opens and closes an uncached cursor on each iteration, which is the cost of a cursor cache miss.
+ */
+void BM_CursorCacheMiss(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    auto rs = checked_cast<WiredTigerRecordStore*>(helper.newRecordStore().release());
+    std::unique_ptr<RecordStore> owner(rs);
+
+    auto session = helper.recoveryUnit()->getSession();
+    for (auto _ : state) {
+        auto cursor = session->getNewCursor(rs->getURI());
+        benchmark::DoNotOptimize(cursor);
+        session->closeCursor(cursor);
+    }
+}
+
+void BM_RecoveryUnitBeginCommit(benchmark::State& state) {
+    WiredTigerBenchmarkHelper helper;
+    for (auto _ : state) {
+        WriteUnitOfWork wuow(helper.opCtx());
+        // Opens the WiredTiger transaction, which is otherwise deferred until first use.
+        benchmark::DoNotOptimize(helper.recoveryUnit()->getSession());
+        wuow.commit();
+    }
+}
+
+BENCHMARK(BM_RecordStoreInsert)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+BENCHMARK(BM_RecordStoreUpdate)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+BENCHMARK(BM_RecordStoreSeek)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+BENCHMARK(BM_RecordStoreScan)->Arg(64)->Arg(1024)->Arg(16 * 1024);
+BENCHMARK(BM_IndexInsert)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(BM_IndexSeek)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(BM_IndexScan)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(BM_CursorCacheHit);
+BENCHMARK(BM_CursorCacheMiss);
+BENCHMARK(BM_RecoveryUnitBeginCommit);
+
+}  // namespace
+}  // namespace mongo
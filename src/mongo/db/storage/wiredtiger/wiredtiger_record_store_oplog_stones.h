@@ -65,13 +65,7 @@ public:
 
     void awaitHasExcessStonesOrDead();
 
-    void getOplogStonesStats(BSONObjBuilder& builder) const {
-        builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
-        if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
-            builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
-        }
-    }
+    void getOplogStonesStats(BSONObjBuilder& builder) const;
 
     boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/error_codes.h"
@@ -45,6 +46,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -192,7 +194,14 @@ void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
 
 namespace {
 AtomicWord<unsigned long long> nextTableId(WiredTigerSession::kLastTableId);
+
+// Upper bound on the number of partitions of idle sessions, regardless of the number of cores.
+constexpr size_t kMaxSessionCachePartitions = 64;
+
+size_t numSessionCachePartitions() {
+    return std::clamp<size_t>(ProcessInfo::getNumAvailableCores(), 1, kMaxSessionCachePartitions);
 }
+}  // namespace
 // static
 uint64_t WiredTigerSession::genTableId() {
     return nextTableId.fetchAndAdd(1);
@@ -204,6 +213,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
+      _numPartitions(numSessionCachePartitions()),
+      _partitions(std::make_unique<CacheAligned<SessionPartition>[]>(_numPartitions)),
       _shuttingDown(0),
       _prepareCommitOrAbortCounter(0) {}
 
@@ -211,6 +222,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
     : _engine(nullptr),
       _conn(conn),
       _clockSource(cs),
+      _numPartitions(numSessionCachePartitions()),
+      _partitions(std::make_unique<CacheAligned<SessionPartition>[]>(_numPartitions)),
       _shuttingDown(0),
       _prepareCommitOrAbortCounter(0) {}
 
@@ -376,26 +389,65 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 }
 
 
-void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+template <typename SessionFunc>
+void WiredTigerSessionCache::_forEachIdleSessionUnlocked(SessionFunc&& func) {
+    // A concurrent caller would not see the sessions taken out of a partition here, and could
+    // return while they still have the cursors it meant to close.
+    stdx::lock_guard<Latch> walkLock(_idleSessionsWalkMutex);
+
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        SessionCache sessions;
+        {
+            stdx::lock_guard<SpinLock> lock(partition.lock);
+            sessions.swap(partition.sessions);
+            partition.idleSessionsCount.store(0);
+        }
+
+        // Closing cursors is expensive, so do it while the sessions are out of the partition rather
+        // than while spinning other threads on the partition lock.
+        for (auto session : sessions) {
+            func(session);
+        }
+
+        SessionCache staleSessions;
+        {
+            stdx::lock_guard<SpinLock> lock(partition.lock);
+            // closeAll() may have run meanwhile, in which case these sessions must not be cached.
+            auto stale = std::stable_partition(sessions.begin(), sessions.end(), [&](auto session) {
+                return session->_getEpoch() == _epoch.load();
+            });
+            staleSessions.assign(stale, sessions.end());
+            // These sessions became idle before any released meanwhile, so they go to the front
+            // to keep the most recently used sessions at the back.
+            partition.sessions.insert(partition.sessions.begin(), sessions.begin(), stale);
+            partition.idleSessionsCount.store(partition.sessions.size());
+        }
+
+        for (auto session : staleSessions) {
+            delete session;
+        }
     }
 }
 
+void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
+    _forEachIdleSessionUnlocked([&](WiredTigerSession* session) { session->closeAllCursors(uri); });
+}
+
 void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
-    }
+    _forEachIdleSessionUnlocked(
+        [&](WiredTigerSession* session) { session->closeCursorsForQueuedDrops(_engine); });
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        count += _partitions[i].idleSessionsCount.load();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -407,36 +459,43 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<SpinLock> lock(partition.lock);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = partition.sessions.erase(it);
                 sessionsToClose.push_back(session);
             } else {
                 ++it;
             }
         }
+        partition.idleSessionsCount.store(partition.sessions.size());
     }
 
-    // Closing expired idle sessions is expensive, so do it outside of the cache mutex. This helps
-    // to avoid periodic operation latency spikes as seen in SERVER-52879.
+    // Closing expired idle sessions is expensive, so do it outside of the partition locks. This
+    // helps to avoid periodic operation latency spikes as seen in SERVER-52879.
     for (auto session : sessionsToClose) {
         delete session;
     }
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. This must happen
+    // before draining the partitions: releaseSession() rechecks the epoch under the partition lock,
+    // so any session it caches after this point is either caught below or deleted on release.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    SessionCache swap;
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<SpinLock> lock(partition.lock);
+        swap.insert(swap.end(), partition.sessions.begin(), partition.sessions.end());
+        partition.sessions.clear();
+        partition.idleSessionsCount.store(0);
     }
 
     for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
@@ -453,20 +512,28 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Start with this thread's own partition, then steal from the others. Partitions without idle
+    // sessions are skipped without taking their lock.
+    const size_t ownPartition = _getPartitionIndexForThisThread();
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[(ownPartition + i) % _numPartitions];
+        if (partition.idleSessionsCount.load() == 0)
+            continue;
+
+        stdx::lock_guard<SpinLock> lock(partition.lock);
+        if (!partition.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
+            partition.idleSessionsCount.store(partition.sessions.size());
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
-    // Outside of the cache partition lock, but on release will be put back on the cache
+    // Outside of the cache partition locks, but on release will be put back on the cache
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
@@ -521,10 +588,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& partition = _partitions[_getPartitionIndexForThisThread()];
+        stdx::lock_guard<SpinLock> lock(partition.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
+            partition.idleSessionsCount.store(partition.sessions.size());
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -547,6 +616,13 @@ void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     _journalListener = jl;
 }
 
+size_t WiredTigerSessionCache::_getPartitionIndexForThisThread() const {
+    // Threads are assigned partitions round-robin the first time they use any session cache.
+    static AtomicWord<unsigned> nextThreadIndex{0};
+    static thread_local const unsigned threadIndex = nextThreadIndex.fetchAndAdd(1);
+    return threadIndex % _numPartitions;
+}
+
 bool WiredTigerSessionCache::isEngineCachingCursors() {
     return gWiredTigerCursorCacheSize.load() <= 0;
 }
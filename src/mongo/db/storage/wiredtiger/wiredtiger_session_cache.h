@@ -30,7 +30,9 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -39,6 +41,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -379,9 +382,25 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // Idle sessions are spread over several partitions, each protected by its own spin lock, so
+    // that concurrent operations taking and returning sessions do not serialize on a single mutex.
+    // A thread releases sessions into its own partition and prefers to take sessions from it,
+    // stealing from the other partitions only when its own is empty.
+    struct SessionPartition {
+        SpinLock lock;
+        SessionCache sessions;
+
+        // The size of 'sessions'. Only modified while holding 'lock', but can be read without it.
+        AtomicWord<size_t> idleSessionsCount{0};
+    };
+    const size_t _numPartitions;
+    std::unique_ptr<CacheAligned<SessionPartition>[]> _partitions;
+
+    // Serializes the callers of _forEachIdleSessionUnlocked().
+    Mutex _idleSessionsWalkMutex =
+        MONGO_MAKE_LATCH("WiredTigerSessionCache::_idleSessionsWalkMutex");
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -418,6 +437,19 @@ private:
      * session and releasing it, the session is directly released. This method is thread safe.
      */
     void releaseSession(WiredTigerSession* session);
+
+    /**
+     * Returns the index of the partition the calling thread releases its sessions into.
+     */
+    size_t _getPartitionIndexForThisThread() const;
+
+    /**
+     * Calls 'func' on every idle session, without holding the lock of its partition. The sessions
+     * of a partition are taken out of the cache for the duration of the calls and put back
+     * afterwards, unless closeAll() ran in the meantime.
+     */
+    template <typename SessionFunc>
+    void _forEachIdleSessionUnlocked(SessionFunc&& func);
 };
 
 /**
@@ -29,13 +29,16 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -114,4 +117,57 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, ReuseSessionReleasedByAnotherThread) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Release sessions from several threads, which may put them in partitions other than the one
+    // used by this thread.
+    const size_t numThreads = 4;
+    std::vector<WiredTigerSession*> released;
+    {
+        std::vector<UniqueWiredTigerSession> sessions;
+        for (size_t i = 0; i < numThreads; ++i) {
+            sessions.push_back(sessionCache->getSession());
+            released.push_back(sessions.back().get());
+        }
+
+        std::vector<stdx::thread> threads;
+        for (auto& session : sessions) {
+            threads.emplace_back([&session] { session.reset(); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), numThreads);
+
+    // All of the cached sessions can be taken by this thread before any new one gets created.
+    std::vector<UniqueWiredTigerSession> reused;
+    for (size_t i = 0; i < numThreads; ++i) {
+        reused.push_back(sessionCache->getSession());
+        ASSERT(std::find(released.begin(), released.end(), reused.back().get()) != released.end());
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    // Sessions released after closeAll() belong to an old epoch and are not cached.
+    sessionCache->closeAll();
+    reused.clear();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, CloseAllCursorsKeepsIdleSessionsCached) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    {
+        UniqueWiredTigerSession first = sessionCache->getSession();
+        UniqueWiredTigerSession second = sessionCache->getSession();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 2U);
+
+    // The sessions are only out of the cache while their cursors are being closed.
+    sessionCache->closeAllCursors("table:test");
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 2U);
+}
+
 }  // namespace mongo
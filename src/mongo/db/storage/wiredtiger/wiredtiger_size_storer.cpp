@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include <wiredtiger.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -47,6 +49,49 @@
 
 namespace mongo {
 
+namespace {
+/**
+ * Returns the stripe of a SizeInfo the calling thread adds to. Threads are assigned stripes
+ * round-robin the first time they update any SizeInfo.
+ */
+size_t stripeForThisThread(size_t numStripes) {
+    static AtomicWord<unsigned> nextThreadIndex{0};
+    static thread_local const unsigned threadIndex = nextThreadIndex.fetchAndAdd(1);
+    return threadIndex % numStripes;
+}
+}  // namespace
+
+long long WiredTigerSizeStorer::SizeInfo::Counter::load() const {
+    long long total = 0;
+    for (const auto& stripe : *_stripes) {
+        total += (stripe.*_field).load();
+    }
+    return std::max(total, 0ll);
+}
+
+void WiredTigerSizeStorer::SizeInfo::Counter::store(long long value) {
+    for (auto& stripe : *_stripes) {
+        (stripe.*_field).store(0);
+    }
+    ((*_stripes)[0].*_field).store(value);
+}
+
+void WiredTigerSizeStorer::SizeInfo::Counter::add(long long delta) {
+    auto& stripe = (*_stripes)[stripeForThisThread(kNumStripes)];
+    // The total can only be negative if some stripe is, so only fold the stripes in that case.
+    if ((stripe.*_field).addAndFetch(delta) >= 0) {
+        return;
+    }
+
+    long long total = 0;
+    for (const auto& s : *_stripes) {
+        total += (s.*_field).load();
+    }
+    if (total < 0) {
+        store(0);
+    }
+}
+
 WiredTigerSizeStorer::WiredTigerSizeStorer(WT_CONNECTION* conn,
                                            const std::string& storageUri,
                                            bool readOnly)
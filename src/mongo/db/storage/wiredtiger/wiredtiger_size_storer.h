@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <wiredtiger.h>
@@ -38,6 +39,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -60,16 +62,68 @@ public:
      * ownership. The SizeInfo may still be updated after it is stored in the SizeStorer.
      * The 'dirty' field is used by the size storer to cheaply merge duplicate stores of the same
      * SizeInfo.
+     *
+     * Both counters are striped over a few cache lines, and each thread adds to its own stripe, so
+     * that concurrent inserts and deletes on the same collection do not contend on a single cache
+     * line. The stripes are only folded together when a value is read.
      */
     struct SizeInfo {
+    private:
+        static constexpr size_t kNumStripes = 8;
+
+        struct Stripe {
+            AtomicWord<long long> numRecords{0};
+            AtomicWord<long long> dataSize{0};
+        };
+        using Stripes = std::array<CacheAligned<Stripe>, kNumStripes>;
+
+    public:
+        /**
+         * A single striped counter of this SizeInfo. The value is never negative.
+         */
+        class Counter {
+        public:
+            Counter(Stripes* stripes, AtomicWord<long long> Stripe::*field)
+                : _stripes(stripes), _field(field) {}
+
+            /**
+             * Returns the sum of all stripes, folded without any synchronization with concurrent
+             * updates.
+             */
+            long long load() const;
+
+            /**
+             * Resets the counter to 'value'. Concurrent calls to add() may be lost.
+             */
+            void store(long long value);
+
+            /**
+             * Adds 'delta' to the stripe of the calling thread. If this makes the total negative,
+             * the counter is reset to zero.
+             */
+            void add(long long delta);
+
+        private:
+            Stripes* const _stripes;
+            AtomicWord<long long> Stripe::*const _field;
+        };
+
         SizeInfo() = default;
-        SizeInfo(long long records, long long size) : numRecords(records), dataSize(size) {}
+        SizeInfo(long long records, long long size) {
+            numRecords.store(records);
+            dataSize.store(size);
+        }
 
         ~SizeInfo() {
             invariant(!_dirty.load());
         }
-        AtomicWord<long long> numRecords;
-        AtomicWord<long long> dataSize;
+
+    private:
+        Stripes _stripes;
+
+    public:
+        Counter numRecords{&_stripes, &Stripe::numRecords};
+        Counter dataSize{&_stripes, &Stripe::dataSize};
 
     private:
         friend WiredTigerSizeStorer;
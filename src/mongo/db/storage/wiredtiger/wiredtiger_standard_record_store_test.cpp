@@ -33,6 +33,7 @@
 #include <sstream>
 #include <string>
 #include <time.h>
+#include <vector>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
@@ -46,6 +47,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
@@ -200,5 +202,40 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(), val);
 }
 
+// Updates made from different threads land in different stripes, but are all accounted for.
+TEST(WiredTigerSizeStorerTest, SizeInfoFoldsUpdatesFromAllThreads) {
+    WiredTigerSizeStorer::SizeInfo sizeInfo(10, 100);
+
+    const int numThreads = 16;
+    const int numUpdatesPerThread = 1000;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < numUpdatesPerThread; ++j) {
+                sizeInfo.numRecords.add(1);
+                sizeInfo.dataSize.add(2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQUALS(10 + numThreads * numUpdatesPerThread, sizeInfo.numRecords.load());
+    ASSERT_EQUALS(100 + 2 * numThreads * numUpdatesPerThread, sizeInfo.dataSize.load());
+
+    sizeInfo.numRecords.store(3);
+    ASSERT_EQUALS(3, sizeInfo.numRecords.load());
+}
+
+// The counters never go negative, and continue counting from zero after being clamped.
+TEST(WiredTigerSizeStorerTest, SizeInfoIsNeverNegative) {
+    WiredTigerSizeStorer::SizeInfo sizeInfo(2, 0);
+    sizeInfo.numRecords.add(-5);
+    ASSERT_EQUALS(0, sizeInfo.numRecords.load());
+    sizeInfo.numRecords.add(4);
+    ASSERT_EQUALS(4, sizeInfo.numRecords.load());
+}
+
 }  // namespace
 }  // namespace mongo
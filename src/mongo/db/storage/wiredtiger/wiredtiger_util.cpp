@@ -868,6 +868,27 @@ Status WiredTigerUtil::_setTableLogging(WT_SESSION* session, const std::string&
     return Status::OK();
 }
 
+Status WiredTigerUtil::setTableCacheResident(OperationContext* opCtx,
+                                             const std::string& uri,
+                                             bool on) {
+    invariant(!storageGlobalParams.readOnly);
+
+    // Altering a table requires exclusive access to it, so close any cached cursors first.
+    WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(uri);
+    WiredTigerSessionCache* sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    sessionCache->closeAllCursors(uri);
+
+    const std::string setting = on ? "cache_resident=true" : "cache_resident=false";
+    LOGV2_DEBUG(
+        6170456, 1, "Changing table cache residency", "uri"_attr = uri, "cacheResident"_attr = on);
+
+    // Use a dedicated session for alter operations to avoid transaction issues.
+    WiredTigerSession session(sessionCache->conn());
+    WT_SESSION* s = session.getSession();
+    return wtRCToStatus(s->alter(s, uri.c_str(), setting.c_str()),
+                        "Failed to change table cache residency:");
+}
+
 Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
                                          const std::string& uri,
                                          const std::string& config,
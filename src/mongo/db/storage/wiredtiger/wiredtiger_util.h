@@ -293,6 +293,12 @@ public:
 
     static Status setTableLogging(WT_SESSION* session, const std::string& uri, bool on);
 
+    /**
+     * Alters the table so that its pages are never (or are again) evicted from the cache. Returns
+     * ObjectIsBusy if the table is in use by another session.
+     */
+    static Status setTableCacheResident(OperationContext* opCtx, const std::string& uri, bool on);
+
     /**
      * Casts unsigned 64-bit statistics value to T.
      * If original value exceeds maximum value of T, return max(T).
@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_bloom_filter.h"
+
+#include <cstring>
+
+#include "mongo/db/hasher.h"
+
+namespace mongo::timeseries {
+
+namespace {
+
+/**
+ * Calls 'f' with the bit index of each of the filter's hash functions for 'hash', which are
+ * derived from the two halves of the 64-bit hash by double hashing.
+ */
+template <typename F>
+void forEachBit(long long hash, F&& f) {
+    auto h = static_cast<uint64_t>(hash);
+    auto h1 = static_cast<uint32_t>(h);
+    auto h2 = static_cast<uint32_t>(h >> 32) | 1;
+    for (int i = 0; i < BucketBloomFilter::kNumHashes; ++i) {
+        f((h1 + static_cast<uint64_t>(i) * h2) % BucketBloomFilter::kNumBits);
+    }
+}
+
+}  // namespace
+
+boost::optional<BucketBloomFilter> BucketBloomFilter::parse(const BSONElement& elem) {
+    int len = 0;
+    if (elem.type() != BSONType::BinData || elem.binDataType() != BinDataGeneral) {
+        return boost::none;
+    }
+    auto data = elem.binData(len);
+    if (static_cast<size_t>(len) != kNumBytes) {
+        return boost::none;
+    }
+
+    BucketBloomFilter filter;
+    std::memcpy(filter._bits.data(), data, kNumBytes);
+    return filter;
+}
+
+long long BucketBloomFilter::hash(const BSONElement& value) {
+    return BSONElementHasher::hash64(value, BSONElementHasher::DEFAULT_HASH_SEED);
+}
+
+bool BucketBloomFilter::mayContain(const BSONElement& filter, long long hash) {
+    int len = 0;
+    if (filter.type() != BSONType::BinData || filter.binDataType() != BinDataGeneral) {
+        return true;
+    }
+    auto data = filter.binData(len);
+    if (static_cast<size_t>(len) != kNumBytes) {
+        return true;
+    }
+    return _mayContain(reinterpret_cast<const uint8_t*>(data), hash);
+}
+
+bool BucketBloomFilter::add(const BSONElement& elem) {
+    bool changed = _addHash(hash(elem));
+    if (elem.type() == BSONType::Array) {
+        for (auto&& arrayElem : elem.Obj()) {
+            changed |= _addHash(hash(arrayElem));
+        }
+    }
+    return changed;
+}
+
+bool BucketBloomFilter::mayContain(long long hash) const {
+    return _mayContain(_bits.data(), hash);
+}
+
+void BucketBloomFilter::merge(const BucketBloomFilter& other) {
+    for (size_t i = 0; i < kNumBytes; ++i) {
+        _bits[i] |= other._bits[i];
+    }
+}
+
+void BucketBloomFilter::appendTo(BSONObjBuilder* builder, StringData fieldName) const {
+    builder->appendBinData(fieldName, kNumBytes, BinDataGeneral, _bits.data());
+}
+
+bool BucketBloomFilter::_mayContain(const uint8_t* bits, long long hash) {
+    bool contains = true;
+    forEachBit(hash, [&](size_t bit) { contains &= (bits[bit / 8] >> (bit % 8)) & 1; });
+    return contains;
+}
+
+bool BucketBloomFilter::_addHash(long long hash) {
+    bool changed = false;
+    forEachBit(hash, [&](size_t bit) {
+        uint8_t mask = 1 << (bit % 8);
+        changed |= !(_bits[bit / 8] & mask);
+        _bits[bit / 8] |= mask;
+    });
+    return changed;
+}
+
+}  // namespace mongo::timeseries
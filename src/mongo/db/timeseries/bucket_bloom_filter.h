@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <boost/optional.hpp>
+#include <cstdint>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo::timeseries {
+
+/**
+ * A fixed-size bloom filter of the values of one measurement field in a bucket, stored as BinData
+ * in 'control.bloom.<field>'. It allows equality queries on the field to skip buckets which cannot
+ * contain the value without unpacking them.
+ *
+ * Values are hashed with BSONElementHasher, which is stable across versions and platforms and
+ * squashes numeric types, so that values which compare equal have the same hash.
+ */
+class BucketBloomFilter {
+public:
+    static constexpr size_t kNumBytes = 1024;
+    static constexpr size_t kNumBits = kNumBytes * 8;
+    static constexpr int kNumHashes = 4;
+
+    /**
+     * Returns the filter stored in 'elem', or boost::none if 'elem' is not a filter.
+     */
+    static boost::optional<BucketBloomFilter> parse(const BSONElement& elem);
+
+    /**
+     * Returns the hash under which 'value' is added to and looked up in a filter.
+     */
+    static long long hash(const BSONElement& value);
+
+    /**
+     * Returns false if the filter stored in 'filter' definitely does not contain a value with the
+     * given hash. Returns true if it may, or if 'filter' is not a filter.
+     */
+    static bool mayContain(const BSONElement& filter, long long hash);
+
+    /**
+     * Adds the value of 'elem' to the filter. An array value is added both as a whole and element
+     * by element, since an equality predicate matches either. Returns whether the filter changed.
+     */
+    bool add(const BSONElement& elem);
+
+    bool mayContain(long long hash) const;
+
+    /**
+     * Adds all values of 'other' to this filter.
+     */
+    void merge(const BucketBloomFilter& other);
+
+    void appendTo(BSONObjBuilder* builder, StringData fieldName) const;
+
+private:
+    static bool _mayContain(const uint8_t* bits, long long hash);
+
+    bool _addHash(long long hash);
+
+    std::array<uint8_t, kNumBytes> _bits{};
+};
+
+}  // namespace mongo::timeseries
@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_bloom_filter.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::timeseries {
+namespace {
+
+long long hashOf(const BSONObj& obj) {
+    return BucketBloomFilter::hash(obj.firstElement());
+}
+
+TEST(BucketBloomFilter, ContainsAddedValues) {
+    BucketBloomFilter filter;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(filter.add(BSON("" << i).firstElement()));
+    }
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(filter.mayContain(hashOf(BSON("" << i))));
+    }
+
+    // Adding a value again does not change the filter.
+    ASSERT_FALSE(filter.add(BSON("" << 0).firstElement()));
+}
+
+TEST(BucketBloomFilter, EmptyFilterContainsNothing) {
+    BucketBloomFilter filter;
+    ASSERT_FALSE(filter.mayContain(hashOf(BSON("" << 1))));
+    ASSERT_FALSE(filter.mayContain(hashOf(BSON("" << "abc"))));
+}
+
+TEST(BucketBloomFilter, NumericTypesHashTheSame) {
+    BucketBloomFilter filter;
+    filter.add(BSON("" << 7).firstElement());
+    ASSERT_TRUE(filter.mayContain(hashOf(BSON("" << 7LL))));
+    ASSERT_TRUE(filter.mayContain(hashOf(BSON("" << 7.0))));
+    ASSERT_TRUE(filter.mayContain(hashOf(BSON("" << Decimal128(7)))));
+}
+
+TEST(BucketBloomFilter, ArraysAddTheirElements) {
+    BucketBloomFilter filter;
+    filter.add(BSON("" << BSON_ARRAY(1 << "x")).firstElement());
+    ASSERT_TRUE(filter.mayContain(hashOf(BSON("" << BSON_ARRAY(1 << "x")))));
+    ASSERT_TRUE(filter.mayContain(hashOf(BSON("" << 1))));
+    ASSERT_TRUE(filter.mayContain(hashOf(BSON("" << "x"))));
+}
+
+TEST(BucketBloomFilter, RoundTripsThroughBSON) {
+    BucketBloomFilter filter;
+    filter.add(BSON("" << "trace-1").firstElement());
+
+    BSONObjBuilder builder;
+    filter.appendTo(&builder, "a");
+    auto obj = builder.obj();
+
+    ASSERT_TRUE(BucketBloomFilter::mayContain(obj["a"], hashOf(BSON("" << "trace-1"))));
+    ASSERT_FALSE(BucketBloomFilter::mayContain(obj["a"], hashOf(BSON("" << "trace-2"))));
+
+    auto parsed = BucketBloomFilter::parse(obj["a"]);
+    ASSERT(parsed);
+    ASSERT_TRUE(parsed->mayContain(hashOf(BSON("" << "trace-1"))));
+}
+
+TEST(BucketBloomFilter, MalformedFilterMayContainAnything) {
+    auto obj = BSON("a" << 1 << "b" << BSONBinData("abc", 3, BinDataGeneral));
+    for (auto&& elem : obj) {
+        ASSERT_FALSE(BucketBloomFilter::parse(elem));
+        ASSERT_TRUE(BucketBloomFilter::mayContain(elem, hashOf(BSON("" << 1))));
+    }
+}
+
+TEST(BucketBloomFilter, MergeContainsValuesOfBoth) {
+    BucketBloomFilter filter1;
+    filter1.add(BSON("" << 1).firstElement());
+    BucketBloomFilter filter2;
+    filter2.add(BSON("" << 2).firstElement());
+
+    filter1.merge(filter2);
+    ASSERT_TRUE(filter1.mayContain(hashOf(BSON("" << 1))));
+    ASSERT_TRUE(filter1.mayContain(hashOf(BSON("" << 2))));
+}
+
+}  // namespace
+}  // namespace mongo::timeseries
@@ -38,6 +38,9 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/platform/compiler.h"
@@ -155,11 +158,68 @@ BSONObj buildControlMinTimestampDoc(StringData timeField, Date_t roundedTime) {
     builder.append(timeField, roundedTime);
     return builder.obj();
 }
+
+/**
+ * Returns whether a measurement with the given metadata and time can be inserted into the given
+ * uncompressed bucket document without it immediately being full.
+ */
+bool isBucketReopenable(const BSONObj& bucketDoc,
+                        const BSONElement& metadata,
+                        const Date_t& time,
+                        const TimeseriesOptions& options) {
+    if (bucketDoc.objsize() >= gTimeseriesBucketMaxSize ||
+        bucketDoc[timeseries::kBucketIdFieldName].type() != BSONType::jstOID ||
+        !bucketDoc[timeseries::kBucketMetaFieldName].binaryEqualValues(metadata)) {
+        return false;
+    }
+
+    auto control = bucketDoc[timeseries::kBucketControlFieldName];
+    auto data = bucketDoc[timeseries::kBucketDataFieldName];
+    if (control.type() != BSONType::Object || data.type() != BSONType::Object) {
+        return false;
+    }
+
+    auto version = control.Obj()[timeseries::kBucketControlVersionFieldName];
+    if (!version.isNumber() ||
+        version.numberInt() != timeseries::kTimeseriesControlDefaultVersion) {
+        return false;
+    }
+
+    auto min = control.Obj()[timeseries::kBucketControlMinFieldName];
+    auto max = control.Obj()[timeseries::kBucketControlMaxFieldName];
+    auto times = data.Obj()[options.getTimeField()];
+    if (min.type() != BSONType::Object || max.type() != BSONType::Object ||
+        times.type() != BSONType::Object ||
+        times.Obj().nFields() >= gTimeseriesBucketMaxCount) {
+        return false;
+    }
+
+    auto minTime = min.Obj()[options.getTimeField()];
+    auto maxTime = max.Obj()[options.getTimeField()];
+    return minTime.type() == BSONType::Date && maxTime.type() == BSONType::Date &&
+        time >= minTime.Date() &&
+        time - minTime.Date() < Seconds(*options.getBucketMaxSpanSeconds());
+}
 }  // namespace
 
 const std::shared_ptr<BucketCatalog::ExecutionStats> BucketCatalog::kEmptyStats{
     std::make_shared<BucketCatalog::ExecutionStats>()};
 
+BucketCatalog::ExecutionStats::Counters& BucketCatalog::ExecutionStats::local() {
+    // Threads are assigned partitions round-robin the first time they update any statistics.
+    static AtomicWord<unsigned> nextThreadIndex{0};
+    static thread_local const unsigned threadIndex = nextThreadIndex.fetchAndAdd(1);
+    return _partitions[threadIndex % kNumPartitions];
+}
+
+long long BucketCatalog::ExecutionStats::sum(AtomicWord<long long> Counters::*counter) const {
+    long long total = 0;
+    for (const auto& partition : _partitions) {
+        total += (partition.*counter).load();
+    }
+    return total;
+}
+
 BucketCatalog& BucketCatalog::get(ServiceContext* svcCtx) {
     return getBucketCatalog(svcCtx);
 }
@@ -183,7 +243,8 @@ StatusWith<BucketCatalog::InsertResult> BucketCatalog::insert(
     const StringData::ComparatorInterface* comparator,
     const TimeseriesOptions& options,
     const BSONObj& doc,
-    CombineWithInsertsFromOtherClients combine) {
+    CombineWithInsertsFromOtherClients combine,
+    const BucketFinder& findBucketToReopen) {
 
     BSONElement metadata;
     auto metaFieldName = options.getMetaField();
@@ -205,6 +266,14 @@ StatusWith<BucketCatalog::InsertResult> BucketCatalog::insert(
     auto time = timeElem.Date();
 
     ClosedBuckets closedBuckets;
+    if (findBucketToReopen && metadata && metadata.type() != BSONType::Array &&
+        gTimeseriesBucketReopening.load() &&
+        !feature_flags::gTimeseriesBucketCompression.isEnabledAndIgnoreFCV()) {
+        // Closed buckets are compressed when bucket compression is enabled, so there is nothing to
+        // reopen.
+        _reopenBucket(key, time, options, stats.get(), &closedBuckets, findBucketToReopen);
+    }
+
     BucketAccess bucket{this, key, options, stats.get(), &closedBuckets, time};
     invariant(bucket);
 
@@ -219,21 +288,21 @@ StatusWith<BucketCatalog::InsertResult> BucketCatalog::insert(
 
     auto isBucketFull = [&](BucketAccess* bucket) -> bool {
         if ((*bucket)->_numMeasurements == static_cast<std::uint64_t>(gTimeseriesBucketMaxCount)) {
-            stats->numBucketsClosedDueToCount.fetchAndAddRelaxed(1);
+            stats->local().numBucketsClosedDueToCount.fetchAndAddRelaxed(1);
             return true;
         }
         if ((*bucket)->_size + sizeToBeAdded >
             static_cast<std::uint64_t>(gTimeseriesBucketMaxSize)) {
-            stats->numBucketsClosedDueToSize.fetchAndAddRelaxed(1);
+            stats->local().numBucketsClosedDueToSize.fetchAndAddRelaxed(1);
             return true;
         }
         auto bucketTime = (*bucket).getTime();
         if (time - bucketTime >= Seconds(*options.getBucketMaxSpanSeconds())) {
-            stats->numBucketsClosedDueToTimeForward.fetchAndAddRelaxed(1);
+            stats->local().numBucketsClosedDueToTimeForward.fetchAndAddRelaxed(1);
             return true;
         }
         if (time < bucketTime) {
-            stats->numBucketsClosedDueToTimeBackward.fetchAndAddRelaxed(1);
+            stats->local().numBucketsClosedDueToTimeBackward.fetchAndAddRelaxed(1);
             return true;
         }
         return false;
@@ -320,16 +389,17 @@ boost::optional<BucketCatalog::ClosedBucket> BucketCatalog::finish(
     }
 
     auto& stats = batch->_stats;
-    stats->numCommits.fetchAndAddRelaxed(1);
+    stats->local().numCommits.fetchAndAddRelaxed(1);
     if (batch->numPreviouslyCommittedMeasurements() == 0) {
-        stats->numBucketInserts.fetchAndAddRelaxed(1);
+        stats->local().numBucketInserts.fetchAndAddRelaxed(1);
     } else {
-        stats->numBucketUpdates.fetchAndAddRelaxed(1);
+        stats->local().numBucketUpdates.fetchAndAddRelaxed(1);
     }
 
-    stats->numMeasurementsCommitted.fetchAndAddRelaxed(batch->measurements().size());
+    stats->local().numMeasurementsCommitted.fetchAndAddRelaxed(batch->measurements().size());
     if (bucket) {
         bucket->_numCommittedMeasurements += batch->measurements().size();
+        _compressCommittedMeasurements(bucket, *batch);
     }
 
     if (!bucket) {
@@ -351,8 +421,10 @@ boost::optional<BucketCatalog::ClosedBucket> BucketCatalog::finish(
             bucket.release();
             auto lk = _lockExclusive();
 
-            closedBucket =
-                ClosedBucket{ptr->_id, ptr->getTimeField().toString(), ptr->numMeasurements()};
+            closedBucket = ClosedBucket{ptr->_id,
+                                        ptr->getTimeField().toString(),
+                                        ptr->numMeasurements(),
+                                        std::move(ptr->_compressor)};
 
             // Only remove from _allBuckets and _idleBuckets. If it was marked full, we know that
             // happened in BucketAccess::rollover, and that there is already a new open bucket for
@@ -363,6 +435,7 @@ boost::optional<BucketCatalog::ClosedBucket> BucketCatalog::finish(
                 _bucketStates.erase(ptr->_id);
             }
             _allBuckets.erase(ptr);
+            _bucketChangeEpoch.fetchAndAdd(1);
         } else {
             _markBucketIdle(bucket);
         }
@@ -408,6 +481,21 @@ void BucketCatalog::clear(const OID& oid) {
     }
 }
 
+void BucketCatalog::clearForDirectWrite(OperationContext* opCtx, const OID& oid) {
+    clear(oid);
+
+    _numDirectWritesInProgress.fetchAndAdd(1);
+    auto finishDirectWrite = [this] {
+        // Change the epoch first, so that there is no point at which a reopening could miss this
+        // write.
+        _bucketChangeEpoch.fetchAndAdd(1);
+        _numDirectWritesInProgress.fetchAndSubtract(1);
+    };
+    opCtx->recoveryUnit()->onCommit(
+        [finishDirectWrite](boost::optional<Timestamp>) { finishDirectWrite(); });
+    opCtx->recoveryUnit()->onRollback(finishDirectWrite);
+}
+
 void BucketCatalog::clear(const std::function<bool(const NamespaceString&)>& shouldClear) {
     auto lk = _lockExclusive();
     auto statsLk = _statsMutex.lockExclusive();
@@ -437,22 +525,26 @@ void BucketCatalog::clear(StringData dbName) {
 void BucketCatalog::appendExecutionStats(const NamespaceString& ns, BSONObjBuilder* builder) const {
     const auto stats = _getExecutionStats(ns);
 
-    builder->appendNumber("numBucketInserts", stats->numBucketInserts.load());
-    builder->appendNumber("numBucketUpdates", stats->numBucketUpdates.load());
+    using Counters = ExecutionStats::Counters;
+    builder->appendNumber("numBucketInserts", stats->sum(&Counters::numBucketInserts));
+    builder->appendNumber("numBucketUpdates", stats->sum(&Counters::numBucketUpdates));
     builder->appendNumber("numBucketsOpenedDueToMetadata",
-                          stats->numBucketsOpenedDueToMetadata.load());
-    builder->appendNumber("numBucketsClosedDueToCount", stats->numBucketsClosedDueToCount.load());
-    builder->appendNumber("numBucketsClosedDueToSize", stats->numBucketsClosedDueToSize.load());
+                          stats->sum(&Counters::numBucketsOpenedDueToMetadata));
+    builder->appendNumber("numBucketsReopened", stats->sum(&Counters::numBucketsReopened));
+    builder->appendNumber("numBucketsClosedDueToCount",
+                          stats->sum(&Counters::numBucketsClosedDueToCount));
+    builder->appendNumber("numBucketsClosedDueToSize",
+                          stats->sum(&Counters::numBucketsClosedDueToSize));
     builder->appendNumber("numBucketsClosedDueToTimeForward",
-                          stats->numBucketsClosedDueToTimeForward.load());
+                          stats->sum(&Counters::numBucketsClosedDueToTimeForward));
     builder->appendNumber("numBucketsClosedDueToTimeBackward",
-                          stats->numBucketsClosedDueToTimeBackward.load());
+                          stats->sum(&Counters::numBucketsClosedDueToTimeBackward));
     builder->appendNumber("numBucketsClosedDueToMemoryThreshold",
-                          stats->numBucketsClosedDueToMemoryThreshold.load());
-    auto commits = stats->numCommits.load();
+                          stats->sum(&Counters::numBucketsClosedDueToMemoryThreshold));
+    auto commits = stats->sum(&Counters::numCommits);
     builder->appendNumber("numCommits", commits);
-    builder->appendNumber("numWaits", stats->numWaits.load());
-    auto measurementsCommitted = stats->numMeasurementsCommitted.load();
+    builder->appendNumber("numWaits", stats->sum(&Counters::numWaits));
+    auto measurementsCommitted = stats->sum(&Counters::numMeasurementsCommitted);
     builder->appendNumber("numMeasurementsCommitted", measurementsCommitted);
     if (commits) {
         builder->appendNumber("avgNumMeasurementsPerCommit", measurementsCommitted / commits);
@@ -521,6 +613,7 @@ bool BucketCatalog::_removeBucket(Bucket* bucket, bool expiringBuckets) {
         _bucketStates.erase(bucket->_id);
     }
     _allBuckets.erase(it);
+    _bucketChangeEpoch.fetchAndAdd(1);
 
     return true;
 }
@@ -563,21 +656,62 @@ void BucketCatalog::_abort(stdx::unique_lock<Mutex>& lk,
     }
 }
 
+void BucketCatalog::_compressCommittedMeasurements(Bucket* bucket, const WriteBatch& batch) {
+    // Only start compressing with the first batch, which creates the bucket document, so that the
+    // compressor has seen every measurement in the bucket. Whether the compressed bucket is used
+    // is decided with the FCV when the bucket is closed.
+    if (batch.numPreviouslyCommittedMeasurements() == 0 &&
+        feature_flags::gTimeseriesBucketCompression.isEnabledAndIgnoreFCV()) {
+        bucket->_compressor = std::make_shared<timeseries::IncrementalBucketCompressor>(
+            bucket->getTimeField(), bucket->_metadata.getMetaField());
+        bucket->_memoryUsage += bucket->_compressor->memoryUsage();
+        _memoryUsage.fetchAndAdd(bucket->_compressor->memoryUsage());
+    }
+
+    auto& compressor = bucket->_compressor;
+    if (!compressor) {
+        return;
+    }
+
+    auto prevMemoryUsage = compressor->memoryUsage();
+    for (const auto& doc : batch.measurements()) {
+        compressor->append(doc);
+    }
+
+    if (compressor->valid()) {
+        bucket->_memoryUsage += compressor->memoryUsage() - prevMemoryUsage;
+        _memoryUsage.fetchAndAdd(compressor->memoryUsage() - prevMemoryUsage);
+    } else {
+        bucket->_memoryUsage -= prevMemoryUsage;
+        _memoryUsage.fetchAndSubtract(prevMemoryUsage);
+        compressor.reset();
+    }
+}
+
 void BucketCatalog::_markBucketIdle(Bucket* bucket) {
     invariant(bucket);
-    stdx::lock_guard lk{_idleMutex};
-    _idleBuckets.push_front(bucket);
-    bucket->_idleListEntry = _idleBuckets.begin();
+
+    // Threads are assigned partitions round-robin the first time they mark a bucket idle.
+    static AtomicWord<unsigned> nextThreadIndex{0};
+    static thread_local const unsigned threadIndex = nextThreadIndex.fetchAndAdd(1);
+
+    auto& partition = _idleBuckets[threadIndex % kNumIdlePartitions];
+    stdx::lock_guard lk{partition.mutex};
+    partition.buckets.push_front(bucket);
+    bucket->_idleListEntry = partition.buckets.begin();
+    bucket->_idlePartition = threadIndex % kNumIdlePartitions;
+    bucket->_idleSequence = _idleSequence.fetchAndAdd(1);
 }
 
 void BucketCatalog::_markBucketNotIdle(Bucket* bucket, bool locked) {
     invariant(bucket);
     if (bucket->_idleListEntry) {
+        auto& partition = _idleBuckets[bucket->_idlePartition];
         stdx::unique_lock<Mutex> guard;
         if (!locked) {
-            guard = stdx::unique_lock{_idleMutex};
+            guard = stdx::unique_lock{partition.mutex};
         }
-        _idleBuckets.erase(*bucket->_idleListEntry);
+        partition.buckets.erase(*bucket->_idleListEntry);
         bucket->_idleListEntry = boost::none;
     }
 }
@@ -592,20 +726,43 @@ void BucketCatalog::_verifyBucketIsUnused(Bucket* bucket) const {
 void BucketCatalog::_expireIdleBuckets(ExecutionStats* stats,
                                        std::vector<BucketCatalog::ClosedBucket>* closedBuckets) {
     // Must hold an exclusive lock on _bucketMutex from outside.
-    stdx::lock_guard lk{_idleMutex};
+    auto needsSpace = [&] {
+        return _memoryUsage.load() >
+            static_cast<std::uint64_t>(gTimeseriesIdleBucketExpiryMemoryUsageThreshold);
+    };
+    if (!needsSpace()) {
+        return;
+    }
+
+    std::array<stdx::unique_lock<Mutex>, kNumIdlePartitions> locks;
+    for (std::size_t i = 0; i < kNumIdlePartitions; ++i) {
+        locks[i] = stdx::unique_lock{_idleBuckets[i].mutex};
+    }
+
+    // Returns the bucket which has been idle the longest, across all partitions.
+    auto leastRecentlyIdle = [&]() -> Bucket* {
+        Bucket* oldest = nullptr;
+        for (auto&& partition : _idleBuckets) {
+            if (!partition.buckets.empty() &&
+                (!oldest || partition.buckets.back()->_idleSequence < oldest->_idleSequence)) {
+                oldest = partition.buckets.back();
+            }
+        }
+        return oldest;
+    };
 
     // As long as we still need space and have entries and remaining attempts, close idle buckets.
     int32_t numClosed = 0;
-    while (!_idleBuckets.empty() &&
-           _memoryUsage.load() >
-               static_cast<std::uint64_t>(gTimeseriesIdleBucketExpiryMemoryUsageThreshold) &&
-           numClosed <= gTimeseriesIdleBucketExpiryMaxCountPerAttempt) {
-        Bucket* bucket = _idleBuckets.back();
+    Bucket* bucket;
+    while (needsSpace() && numClosed <= gTimeseriesIdleBucketExpiryMaxCountPerAttempt &&
+           (bucket = leastRecentlyIdle())) {
         _verifyBucketIsUnused(bucket);
-        ClosedBucket closed{
-            bucket->id(), bucket->getTimeField().toString(), bucket->numMeasurements()};
+        ClosedBucket closed{bucket->id(),
+                            bucket->getTimeField().toString(),
+                            bucket->numMeasurements(),
+                            bucket->_compressor};
         if (_removeBucket(bucket, true /* expiringBuckets */)) {
-            stats->numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(1);
+            stats->local().numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(1);
             closedBuckets->push_back(closed);
             ++numClosed;
         }
@@ -613,8 +770,12 @@ void BucketCatalog::_expireIdleBuckets(ExecutionStats* stats,
 }
 
 std::size_t BucketCatalog::_numberOfIdleBuckets() const {
-    stdx::lock_guard lk{_idleMutex};
-    return _idleBuckets.size();
+    std::size_t numIdleBuckets = 0;
+    for (auto&& partition : _idleBuckets) {
+        stdx::lock_guard lk{partition.mutex};
+        numIdleBuckets += partition.buckets.size();
+    }
+    return numIdleBuckets;
 }
 
 BucketCatalog::Bucket* BucketCatalog::_allocateBucket(const BucketKey& key,
@@ -630,13 +791,119 @@ BucketCatalog::Bucket* BucketCatalog::_allocateBucket(const BucketKey& key,
     _setIdTimestamp(bucket, time, options);
     _openBuckets[key] = bucket;
 
+    if (auto fields = options.getBloomFilterFields()) {
+        for (auto&& field : *fields) {
+            bucket->_bloomFilters.emplace(field, timeseries::BucketBloomFilter{});
+        }
+        bucket->_memoryUsage += fields->size() * sizeof(timeseries::BucketBloomFilter);
+    }
+
     if (openedDuetoMetadata) {
-        stats->numBucketsOpenedDueToMetadata.fetchAndAddRelaxed(1);
+        stats->local().numBucketsOpenedDueToMetadata.fetchAndAddRelaxed(1);
     }
 
     return bucket;
 }
 
+void BucketCatalog::_reopenBucket(const BucketKey& key,
+                                  const Date_t& time,
+                                  const TimeseriesOptions& options,
+                                  ExecutionStats* stats,
+                                  ClosedBuckets* closedBuckets,
+                                  const BucketFinder& findBucketToReopen) {
+    auto normalizedKey = key;
+    normalizedKey.metadata.normalize();
+    {
+        auto lk = _lockShared();
+        if (_openBuckets.contains(normalizedKey)) {
+            return;
+        }
+    }
+
+    // A direct write that is in progress may not be visible to the lookup below, and one that
+    // starts after it may change the bucket document before the bucket is added to the catalog.
+    // Only use the bucket document if neither happened, and if no bucket was removed from the
+    // catalog in between, which would mean its last commit may not be visible either.
+    if (_numDirectWritesInProgress.load() > 0) {
+        return;
+    }
+    auto epoch = _bucketChangeEpoch.load();
+
+    auto metadata = normalizedKey.metadata.getMetaElement();
+    auto bucketDoc = findBucketToReopen(metadata, time);
+    if (!bucketDoc || !isBucketReopenable(*bucketDoc, metadata, time, options)) {
+        return;
+    }
+
+    auto control = bucketDoc->getObjectField(timeseries::kBucketControlFieldName);
+    auto data = bucketDoc->getObjectField(timeseries::kBucketDataFieldName);
+
+    auto bucket = std::make_unique<Bucket>();
+    bucket->_id = bucketDoc->getField(timeseries::kBucketIdFieldName).OID();
+    bucket->_ns = key.ns;
+    bucket->_metadata = normalizedKey.metadata;
+    bucket->_timeField = options.getTimeField().toString();
+    for (auto&& elem : data) {
+        bucket->_fieldNames.emplace(elem.fieldName());
+    }
+    bucket->_size = bucketDoc->objsize();
+    bucket->_numMeasurements = data.getObjectField(options.getTimeField()).nFields();
+    bucket->_numCommittedMeasurements = bucket->_numMeasurements;
+
+    // Seed the minimum and maximum with the control fields, which are the bounds of every field in
+    // the bucket. Reading them back clears the updates, so that the next commit only updates the
+    // fields that change.
+    auto controlMin = control.getObjectField(timeseries::kBucketControlMinFieldName);
+    auto controlMax = control.getObjectField(timeseries::kBucketControlMaxFieldName);
+    bucket->_minmax.update(
+        controlMin, bucket->_metadata.getMetaField(), bucket->_metadata.getComparator());
+    bucket->_minmax.update(
+        controlMax, bucket->_metadata.getMetaField(), bucket->_metadata.getComparator());
+    bucket->_memoryUsage += bucket->_minmax.min().objsize() + bucket->_minmax.max().objsize();
+    bucket->_latestTime = controlMax.getField(options.getTimeField()).Date();
+
+    // Keep maintaining the bloom filters the bucket was written with. A filter which is missing
+    // cannot be rebuilt without the values already in the bucket, so it stays missing.
+    if (auto fields = options.getBloomFilterFields()) {
+        auto controlBloom = control.getObjectField(timeseries::kBucketControlBloomFieldName);
+        for (auto&& field : *fields) {
+            if (auto filter = timeseries::BucketBloomFilter::parse(controlBloom[field])) {
+                bucket->_bloomFilters.emplace(field, *filter);
+            }
+        }
+        bucket->_memoryUsage +=
+            bucket->_bloomFilters.size() * sizeof(timeseries::BucketBloomFilter);
+    }
+
+    // See the accounting for newly created buckets in insert().
+    bucket->_memoryUsage += (key.ns.size() * 2) + (bucket->_metadata.toBSON().objsize() * 2) +
+        sizeof(Bucket) + sizeof(std::unique_ptr<Bucket>) + (sizeof(Bucket*) * 2);
+
+    auto lk = _lockExclusive();
+    if (_numDirectWritesInProgress.load() > 0 || _bucketChangeEpoch.load() != epoch ||
+        _openBuckets.contains(normalizedKey)) {
+        return;
+    }
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        auto [_, inserted] = _bucketStates.emplace(bucket->_id, BucketState::kNormal);
+        if (!inserted) {
+            // The bucket is still in the catalog, e.g. because it is full but not yet committed.
+            return;
+        }
+    }
+
+    // This may remove buckets and change the epoch, which is fine now that the bucket is
+    // registered.
+    _expireIdleBuckets(stats, closedBuckets);
+
+    Bucket* ptr = bucket.get();
+    _openBuckets[normalizedKey] = ptr;
+    _allBuckets.insert(std::move(bucket));
+    _memoryUsage.fetchAndAdd(ptr->_memoryUsage);
+    stats->local().numBucketsReopened.fetchAndAddRelaxed(1);
+}
+
 std::shared_ptr<BucketCatalog::ExecutionStats> BucketCatalog::_getExecutionStats(
     const NamespaceString& ns) {
     {
@@ -1095,8 +1362,10 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
         if (_bucket->allCommitted()) {
             // The bucket does not contain any measurements that are yet to be committed, so we can
             // remove it now. Otherwise, we must keep the bucket around until it is committed.
-            closedBuckets->push_back(ClosedBucket{
-                _bucket->id(), _bucket->getTimeField().toString(), _bucket->numMeasurements()});
+            closedBuckets->push_back(ClosedBucket{_bucket->id(),
+                                                  _bucket->getTimeField().toString(),
+                                                  _bucket->numMeasurements(),
+                                                  std::move(_bucket->_compressor)});
 
             oldBucket = _bucket;
             release();
@@ -1130,7 +1399,7 @@ bool BucketCatalog::WriteBatch::claimCommitRights() {
 
 StatusWith<BucketCatalog::CommitInfo> BucketCatalog::WriteBatch::getResult() const {
     if (!_promise.getFuture().isReady()) {
-        _stats->numWaits.fetchAndAddRelaxed(1);
+        _stats->local().numWaits.fetchAndAddRelaxed(1);
     }
     return _promise.getFuture().getNoThrow();
 }
@@ -1154,6 +1423,11 @@ const BSONObj& BucketCatalog::WriteBatch::max() const {
     return _max;
 }
 
+const BSONObj& BucketCatalog::WriteBatch::bloomFilters() const {
+    invariant(!_active);
+    return _bloomFilters;
+}
+
 const StringMap<std::size_t>& BucketCatalog::WriteBatch::newFieldNamesToBeInserted() const {
     invariant(!_active);
     return _newFieldNamesToBeInserted;
@@ -1215,12 +1489,25 @@ void BucketCatalog::WriteBatch::_prepareCommit() {
         ++it;
     }
 
+    bool bloomFiltersChanged = false;
     for (const auto& doc : _measurements) {
         _bucket->_minmax.update(
             doc, _bucket->_metadata.getMetaField(), _bucket->_metadata.getComparator());
+        for (auto&& [field, filter] : _bucket->_bloomFilters) {
+            if (auto elem = doc[field]) {
+                bloomFiltersChanged |= filter.add(elem);
+            }
+        }
     }
 
     const bool isUpdate = _numPreviouslyCommittedMeasurements > 0;
+    if (!isUpdate || bloomFiltersChanged) {
+        BSONObjBuilder builder;
+        for (auto&& [field, filter] : _bucket->_bloomFilters) {
+            filter.appendTo(&builder, field);
+        }
+        _bloomFilters = builder.obj();
+    }
     if (isUpdate) {
         _min = _bucket->_minmax.minUpdates();
         _max = _bucket->_minmax.maxUpdates();
@@ -30,18 +30,22 @@
 #pragma once
 
 #include <boost/container/small_vector.hpp>
+#include <array>
 #include <boost/container/static_vector.hpp>
 #include <queue>
 
 #include "mongo/bson/unordered_fields_bsonobj_comparator.h"
 #include "mongo/db/ops/single_write_result_gen.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/timeseries/bucket_bloom_filter.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/timeseries/minmax.h"
 #include "mongo/db/timeseries/timeseries_gen.h"
 #include "mongo/db/views/view.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -72,6 +76,9 @@ public:
         OID bucketId;
         std::string timeField;
         uint32_t numMeasurements;
+
+        // The bucket's measurements compressed as they were committed, if that was possible.
+        std::shared_ptr<timeseries::IncrementalBucketCompressor> compressor;
     };
     using ClosedBuckets = std::vector<ClosedBucket>;
 
@@ -111,6 +118,13 @@ public:
         const std::vector<BSONObj>& measurements() const;
         const BSONObj& min() const;
         const BSONObj& max() const;
+
+        /**
+         * The bloom filters of the bucket, to be stored in 'control.bloom'. Full if first batch,
+         * empty if no filter changed otherwise.
+         */
+        const BSONObj& bloomFilters() const;
+
         const StringMap<std::size_t>& newFieldNamesToBeInserted() const;
         uint32_t numPreviouslyCommittedMeasurements() const;
 
@@ -165,6 +179,7 @@ public:
         std::vector<BSONObj> _measurements;
         BSONObj _min;  // Batch-local min; full if first batch, updates otherwise.
         BSONObj _max;  // Batch-local max; full if first batch, updates otherwise.
+        BSONObj _bloomFilters;
         uint32_t _numPreviouslyCommittedMeasurements = 0;
         StringMap<std::size_t> _newFieldNamesToBeInserted;  // Value is hash of string key
 
@@ -183,6 +198,14 @@ public:
         ClosedBuckets closedBuckets;
     };
 
+    /**
+     * Looks up the most recent bucket document on disk for the given normalized metadata whose
+     * time range may contain the given time. Returns boost::none if there is no such bucket or if
+     * the lookup is not possible. Called without holding any locks on the catalog.
+     */
+    using BucketFinder =
+        std::function<boost::optional<BSONObj>(const BSONElement& metadata, Date_t time)>;
+
     static BucketCatalog& get(ServiceContext* svcCtx);
     static BucketCatalog& get(OperationContext* opCtx);
 
@@ -205,13 +228,18 @@ public:
      * Returns the WriteBatch into which the document was inserted and optional information about a
      * bucket if one was closed. Any caller who receives the same batch may commit or abort the
      * batch after claiming commit rights. See WriteBatch for more details.
+     *
+     * If there is no open bucket for the document's metadata, 'findBucketToReopen' is used to
+     * look up a bucket on disk that the document can be inserted into, see
+     * 'timeseriesBucketReopening'.
      */
     StatusWith<InsertResult> insert(OperationContext* opCtx,
                                     const NamespaceString& ns,
                                     const StringData::ComparatorInterface* comparator,
                                     const TimeseriesOptions& options,
                                     const BSONObj& doc,
-                                    CombineWithInsertsFromOtherClients combine);
+                                    CombineWithInsertsFromOtherClients combine,
+                                    const BucketFinder& findBucketToReopen = nullptr);
 
     /**
      * Prepares a batch for commit, transitioning it to an inactive state. Caller must already have
@@ -242,6 +270,13 @@ public:
      */
     void clear(const OID& oid);
 
+    /**
+     * Same as clear(oid), for a write to the bucket document that does not come from the catalog.
+     * Buckets are not reopened until the write unit of work of 'opCtx' commits or rolls back, as
+     * a concurrent lookup of the bucket document may not see the write.
+     */
+    void clearForDirectWrite(OperationContext* opCtx, const OID& oid);
+
     /**
      * Clears any bucket whose namespace satisfies the predicate.
      */
@@ -425,6 +460,14 @@ public:
         // The minimum and maximum values for each field in the bucket.
         timeseries::MinMax _minmax;
 
+        // The bloom filters of the values of the fields in the collection's 'bloomFilterFields'.
+        // Empty for a reopened bucket which was written without them.
+        StringMap<timeseries::BucketBloomFilter> _bloomFilters;
+
+        // Compresses the committed measurements, so that the bucket can be compressed cheaply when
+        // it is closed. Unset if bucket compression is disabled or no longer possible.
+        std::shared_ptr<timeseries::IncrementalBucketCompressor> _compressor;
+
         // The latest time that has been inserted into the bucket.
         Date_t _latestTime;
 
@@ -450,26 +493,53 @@ public:
         // Batches, per operation, that haven't been committed or aborted yet.
         stdx::unordered_map<OperationId, std::shared_ptr<WriteBatch>> _batches;
 
-        // If the bucket is in _idleBuckets, then its position is recorded here.
+        // If the bucket is in one of the _idleBuckets partitions, then the partition, its position
+        // in it and the order in which the bucket became idle are recorded here.
         boost::optional<IdleList::iterator> _idleListEntry = boost::none;
+        std::size_t _idlePartition = 0;
+        uint64_t _idleSequence = 0;
 
         // Approximate memory usage of this bucket.
         uint64_t _memoryUsage = sizeof(*this);
     };
 
 private:
-    struct ExecutionStats {
-        AtomicWord<long long> numBucketInserts;
-        AtomicWord<long long> numBucketUpdates;
-        AtomicWord<long long> numBucketsOpenedDueToMetadata;
-        AtomicWord<long long> numBucketsClosedDueToCount;
-        AtomicWord<long long> numBucketsClosedDueToSize;
-        AtomicWord<long long> numBucketsClosedDueToTimeForward;
-        AtomicWord<long long> numBucketsClosedDueToTimeBackward;
-        AtomicWord<long long> numBucketsClosedDueToMemoryThreshold;
-        AtomicWord<long long> numCommits;
-        AtomicWord<long long> numWaits;
-        AtomicWord<long long> numMeasurementsCommitted;
+    /**
+     * The statistics of a namespace. Each thread updates the counters of one of several
+     * cache-aligned partitions, so that concurrent writers to the same namespace do not contend on
+     * the same cache lines. The partitions are summed up when the statistics are read.
+     */
+    class ExecutionStats {
+    public:
+        struct Counters {
+            AtomicWord<long long> numBucketInserts;
+            AtomicWord<long long> numBucketUpdates;
+            AtomicWord<long long> numBucketsOpenedDueToMetadata;
+            AtomicWord<long long> numBucketsReopened;
+            AtomicWord<long long> numBucketsClosedDueToCount;
+            AtomicWord<long long> numBucketsClosedDueToSize;
+            AtomicWord<long long> numBucketsClosedDueToTimeForward;
+            AtomicWord<long long> numBucketsClosedDueToTimeBackward;
+            AtomicWord<long long> numBucketsClosedDueToMemoryThreshold;
+            AtomicWord<long long> numCommits;
+            AtomicWord<long long> numWaits;
+            AtomicWord<long long> numMeasurementsCommitted;
+        };
+
+        /**
+         * Returns the counters to be updated by the calling thread.
+         */
+        Counters& local();
+
+        /**
+         * Returns the value of the given counter, summed over all partitions.
+         */
+        long long sum(AtomicWord<long long> Counters::*counter) const;
+
+    private:
+        static constexpr size_t kNumPartitions = 16;
+
+        std::array<CacheAligned<Counters>, kNumPartitions> _partitions;
     };
 
     enum class BucketState {
@@ -694,6 +764,12 @@ private:
                 std::shared_ptr<WriteBatch> batch,
                 const boost::optional<Status>& status);
 
+    /**
+     * Adds the measurements of a batch that was just committed to the bucket's compressor. Must be
+     * called with the bucket locked.
+     */
+    void _compressCommittedMeasurements(Bucket* bucket, const WriteBatch& batch);
+
     /**
      * Adds the bucket to a list of idle buckets to be expired at a later date
      */
@@ -701,7 +777,7 @@ private:
 
     /**
      * Remove the bucket from the list of idle buckets. The second parameter encodes whether the
-     * caller holds a lock on _idleMutex.
+     * caller holds the lock on the bucket's partition of _idleBuckets.
      */
     void _markBucketNotIdle(Bucket* bucket, bool locked);
 
@@ -726,6 +802,18 @@ private:
                             ClosedBuckets* closedBuckets,
                             bool openedDuetoMetadata);
 
+    /**
+     * Looks up a bucket on disk for 'key' using 'findBucketToReopen' and adds it to the catalog as
+     * the open bucket for 'key', if there is no open bucket for it yet and no bucket document was
+     * changed outside of the catalog in the meantime. Must be called without any catalog locks.
+     */
+    void _reopenBucket(const BucketKey& key,
+                       const Date_t& time,
+                       const TimeseriesOptions& options,
+                       ExecutionStats* stats,
+                       ClosedBuckets* closedBuckets,
+                       const BucketFinder& findBucketToReopen);
+
     std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns);
     const std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns) const;
 
@@ -770,12 +858,19 @@ private:
         MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "BucketCatalog::_statesMutex");
     stdx::unordered_map<OID, BucketState, OID::Hasher> _bucketStates;
 
-    // This mutex protects access to _idleBuckets
-    mutable Mutex _idleMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "BucketCatalog::_idleMutex");
+    // Buckets that do not have any writers, most recently idle first. Buckets are added to the
+    // partition of the thread marking them idle, so that writers to different buckets do not
+    // serialize on a single mutex.
+    struct IdlePartition {
+        // This mutex protects access to 'buckets'.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("BucketCatalog::IdlePartition::mutex");
+        IdleList buckets;
+    };
+    static constexpr std::size_t kNumIdlePartitions = StripedMutex::kNumStripes;
+    std::array<CacheAligned<IdlePartition>, kNumIdlePartitions> _idleBuckets;
 
-    // Buckets that do not have any writers.
-    IdleList _idleBuckets;
+    // Orders the buckets across the partitions of _idleBuckets by when they became idle.
+    AtomicWord<uint64_t> _idleSequence{0};
 
     /**
      * This mutex protects access to the _executionStats map. Once you complete your lookup, you
@@ -795,5 +890,14 @@ private:
 
     // Approximate memory usage of the bucket catalog.
     AtomicWord<uint64_t> _memoryUsage;
+
+    // Number of writes to bucket documents from outside of the catalog that have not yet committed
+    // or rolled back.
+    AtomicWord<uint64_t> _numDirectWritesInProgress;
+
+    // Incremented whenever a bucket is removed from the catalog or a direct write to a bucket
+    // document finishes. A bucket document read for reopening is only used if this has not changed
+    // since before the read, as the document may otherwise be stale.
+    AtomicWord<uint64_t> _bucketChangeEpoch;
 };
 }  // namespace mongo
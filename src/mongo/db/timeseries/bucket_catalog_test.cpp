@@ -33,8 +33,10 @@
 #include "mongo/db/catalog/create_collection.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/death_test.h"
@@ -900,5 +902,167 @@ TEST_F(BucketCatalogTest, DuplicateNewFieldNamesAcrossConcurrentBatches) {
     _bucketCatalog->finish(batch1, {});
 }
 
+TEST_F(BucketCatalogTest, ReopenBucket) {
+    RAIIServerParameterControllerForTest controller{"timeseriesBucketReopening", true};
+
+    auto bucketId = OID::gen();
+    auto minTime = bucketId.asDateT();
+    auto bucketDoc =
+        BSON("_id" << bucketId << "control"
+                   << BSON("version" << 1 << "min" << BSON(_timeField << minTime << "a" << 1)
+                                     << "max"
+                                     << BSON(_timeField << minTime + Seconds(1) << "a" << 3))
+                   << "meta" << 1 << "data"
+                   << BSON(_timeField << BSON("0" << minTime << "1" << minTime + Seconds(1))
+                                      << "a" << BSON("0" << 1 << "1" << 3)));
+
+    int numLookups = 0;
+    auto findBucketToReopen = [&](const BSONElement& metadata, Date_t) {
+        ++numLookups;
+        ASSERT_EQ(metadata.numberInt(), 1);
+        return boost::make_optional(bucketDoc);
+    };
+
+    auto batch = _bucketCatalog
+                     ->insert(_opCtx,
+                              _ns1,
+                              _getCollator(_ns1),
+                              _getTimeseriesOptions(_ns1),
+                              BSON(_timeField << minTime + Seconds(2) << _metaField << 1 << "a"
+                                              << 2),
+                              BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                              findBucketToReopen)
+                     .getValue()
+                     .batch;
+    ASSERT_EQ(numLookups, 1);
+    ASSERT_EQ(batch->bucket()->id(), bucketId);
+
+    // The measurement is appended to the measurements on disk, and neither adds fields nor changes
+    // the minimum and maximum of the existing fields other than the time.
+    ASSERT(batch->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch);
+    ASSERT_EQ(batch->numPreviouslyCommittedMeasurements(), 2);
+    ASSERT(batch->newFieldNamesToBeInserted().empty());
+    ASSERT(batch->min().isEmpty());
+    ASSERT_FALSE(batch->max().isEmpty());
+    _bucketCatalog->finish(batch, {});
+
+    // The bucket is open now, so it is not looked up again.
+    batch = _bucketCatalog
+                ->insert(_opCtx,
+                         _ns1,
+                         _getCollator(_ns1),
+                         _getTimeseriesOptions(_ns1),
+                         BSON(_timeField << minTime + Seconds(3) << _metaField << 1),
+                         BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                         findBucketToReopen)
+                .getValue()
+                .batch;
+    ASSERT_EQ(numLookups, 1);
+    ASSERT_EQ(batch->bucket()->id(), bucketId);
+    _commit(batch, 3);
+
+    BSONObjBuilder builder;
+    _bucketCatalog->appendExecutionStats(_ns1, &builder);
+    ASSERT_EQ(builder.obj().getIntField("numBucketsReopened"), 1);
+}
+
+TEST_F(BucketCatalogTest, MaintainBloomFilters) {
+    auto options = _getTimeseriesOptions(_ns1);
+    options.setBloomFilterFields(std::vector<StringData>{"a"_sd});
+    auto insert = [&](const BSONObj& doc) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     options,
+                     doc,
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
+            .getValue()
+            .batch;
+    };
+    auto mayContain = [](const BSONObj& bloomFilters, const BSONObj& value) {
+        return timeseries::BucketBloomFilter::mayContain(
+            bloomFilters["a"], timeseries::BucketBloomFilter::hash(value.firstElement()));
+    };
+
+    // The first commit writes the filters.
+    auto batch = insert(BSON(_timeField << Date_t::now() << _metaField << 1 << "a" << 5));
+    ASSERT(batch->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch);
+    ASSERT_EQ(batch->bloomFilters().nFields(), 1);
+    ASSERT_TRUE(mayContain(batch->bloomFilters(), BSON("" << 5)));
+    ASSERT_FALSE(mayContain(batch->bloomFilters(), BSON("" << 6)));
+    _bucketCatalog->finish(batch, {});
+
+    // A commit which does not change the filters does not write them.
+    batch = insert(BSON(_timeField << Date_t::now() << _metaField << 1 << "a" << 5 << "b" << 1));
+    ASSERT(batch->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch);
+    ASSERT_EQ(batch->numPreviouslyCommittedMeasurements(), 1);
+    ASSERT(batch->bloomFilters().isEmpty());
+    _bucketCatalog->finish(batch, {});
+
+    // Otherwise the commit writes the full filters.
+    batch = insert(BSON(_timeField << Date_t::now() << _metaField << 1 << "a" << BSON_ARRAY(6)));
+    ASSERT(batch->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch);
+    ASSERT_TRUE(mayContain(batch->bloomFilters(), BSON("" << 5)));
+    ASSERT_TRUE(mayContain(batch->bloomFilters(), BSON("" << 6)));
+    _bucketCatalog->finish(batch, {});
+}
+
+TEST_F(BucketCatalogTest, DoNotReopenIneligibleBucket) {
+    RAIIServerParameterControllerForTest controller{"timeseriesBucketReopening", true};
+
+    auto bucketId = OID::gen();
+    auto minTime = bucketId.asDateT();
+    auto makeBucketDoc = [&](int version) {
+        return BSON("_id" << bucketId << "control"
+                          << BSON("version" << version << "min" << BSON(_timeField << minTime)
+                                            << "max" << BSON(_timeField << minTime))
+                          << "meta" << 1 << "data"
+                          << BSON(_timeField << BSON("0" << minTime)));
+    };
+
+    auto insert = [&](const BSONObj& bucketDoc, Date_t time) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     _getTimeseriesOptions(_ns1),
+                     BSON(_timeField << time << _metaField << 1),
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                     [&](const BSONElement&, Date_t) { return boost::make_optional(bucketDoc); })
+            .getValue()
+            .batch;
+    };
+
+    // Compressed buckets and measurements before the bucket's time range cannot be reopened.
+    for (auto&& [bucketDoc, time] : {std::make_pair(makeBucketDoc(2), minTime),
+                                     std::make_pair(makeBucketDoc(1), minTime - Seconds(1))}) {
+        auto batch = insert(bucketDoc, time);
+        ASSERT_NE(batch->bucket()->id(), bucketId);
+        ASSERT(batch->claimCommitRights());
+        _bucketCatalog->abort(batch);
+    }
+
+    // Buckets cannot be reopened while a bucket document is being written outside of the catalog.
+    {
+        auto [client, opCtx] = _makeOperationContext();
+        WriteUnitOfWork wuow{opCtx.get()};
+        _bucketCatalog->clearForDirectWrite(opCtx.get(), OID::gen());
+
+        auto batch = insert(makeBucketDoc(1), minTime);
+        ASSERT_NE(batch->bucket()->id(), bucketId);
+        ASSERT(batch->claimCommitRights());
+        _bucketCatalog->abort(batch);
+    }
+
+    auto batch = insert(makeBucketDoc(1), minTime);
+    ASSERT_EQ(batch->bucket()->id(), bucketId);
+    _commit(batch, 1);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -41,6 +41,38 @@ namespace mongo {
 
 namespace timeseries {
 
+namespace {
+
+/**
+ * Appends the control field of a compressed bucket, which is the control field of the uncompressed
+ * bucket with the compressed version.
+ */
+void appendCompressedControl(BSONObjBuilder* builder, const BSONElement& controlElem) {
+    BSONObjBuilder control(builder->subobjStart(kBucketControlFieldName));
+
+    // Set right version, leave other control fields unchanged
+    bool versionSet = false;
+    for (const auto& controlField : controlElem.Obj()) {
+        if (controlField.fieldNameStringData() == kBucketControlVersionFieldName) {
+            control.append(kBucketControlVersionFieldName, kTimeseriesControlCompressedVersion);
+            versionSet = true;
+        } else {
+            control.append(controlField);
+        }
+    }
+
+    // Set version if it was missing from uncompressed bucket
+    if (!versionSet) {
+        control.append(kBucketControlVersionFieldName, kTimeseriesControlCompressedVersion);
+    }
+}
+
+// Approximate memory used by a column builder before anything is appended to it, including the
+// initial allocation of its buffer.
+constexpr uint64_t kColumnBuilderMemoryUsage = sizeof(BSONColumnBuilder) + 512;
+
+}  // namespace
+
 boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData timeFieldName) try {
     // Helper for uncompressed measurements
     struct Measurement {
@@ -58,25 +90,7 @@ boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData tim
     for (auto& elem : bucketDoc) {
         // Control field is left as-is except for the version field.
         if (elem.fieldNameStringData() == kBucketControlFieldName) {
-            BSONObjBuilder control(builder.subobjStart(kBucketControlFieldName));
-
-            // Set right version, leave other control fields unchanged
-            bool versionSet = false;
-            for (const auto& controlField : elem.Obj()) {
-                if (controlField.fieldNameStringData() == kBucketControlVersionFieldName) {
-                    control.append(kBucketControlVersionFieldName,
-                                   kTimeseriesControlCompressedVersion);
-                    versionSet = true;
-                } else {
-                    control.append(controlField);
-                }
-            }
-
-            // Set version if it was missing from uncompressed bucket
-            if (!versionSet) {
-                control.append(kBucketControlVersionFieldName, kTimeseriesControlCompressedVersion);
-            }
-
+            appendCompressedControl(&builder, elem);
             continue;
         }
 
@@ -199,5 +213,138 @@ boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData tim
     return boost::none;
 }
 
+IncrementalBucketCompressor::IncrementalBucketCompressor(StringData timeFieldName,
+                                                         StringData metaFieldName)
+    : _timeFieldName(timeFieldName.toString()),
+      _metaFieldName(metaFieldName.toString()),
+      _timeColumn(std::make_unique<BSONColumnBuilder>(timeFieldName)),
+      _memoryUsage(sizeof(*this) + kColumnBuilderMemoryUsage) {}
+
+IncrementalBucketCompressor::~IncrementalBucketCompressor() = default;
+
+void IncrementalBucketCompressor::append(const BSONObj& measurement) {
+    invariant(_finalized.isEmpty());
+    if (!_timeColumn) {
+        return;
+    }
+
+    try {
+        auto time = measurement[_timeFieldName];
+        if (time.type() != Date || time.date() < _latestTime) {
+            _giveUp();
+            return;
+        }
+        _latestTime = time.date();
+
+        for (const auto& elem : measurement) {
+            auto fieldName = elem.fieldNameStringData();
+            if (fieldName == _timeFieldName ||
+                (!_metaFieldName.empty() && fieldName == _metaFieldName)) {
+                continue;
+            }
+
+            auto& column = _columns[fieldName];
+            if (!column) {
+                column = std::make_unique<BSONColumnBuilder>(fieldName);
+                _memoryUsage += kColumnBuilderMemoryUsage + fieldName.size();
+            }
+
+            // A field seen for the first time, or missing from earlier measurements, is skipped
+            // for those measurements. A field that already has a value for this measurement is a
+            // duplicate, which the bucket document cannot represent as a column.
+            if (column->size() > _numMeasurements) {
+                _giveUp();
+                return;
+            }
+            while (column->size() < _numMeasurements) {
+                column->skip();
+            }
+            column->append(elem);
+        }
+
+        _timeColumn->append(time);
+        ++_numMeasurements;
+    } catch (const DBException&) {
+        // Values such as MinKey and MaxKey cannot be compressed.
+        _giveUp();
+    }
+}
+
+boost::optional<BSONObj> IncrementalBucketCompressor::compress(const BSONObj& bucketDoc) try {
+    if (_timeColumn) {
+        _finalize();
+    }
+    if (_finalized.isEmpty()) {
+        return boost::none;
+    }
+
+    BSONObjBuilder builder;
+    for (const auto& elem : bucketDoc) {
+        if (elem.fieldNameStringData() == kBucketControlFieldName) {
+            appendCompressedControl(&builder, elem);
+            continue;
+        }
+
+        if (elem.fieldNameStringData() != kBucketDataFieldName) {
+            builder.append(elem);
+            continue;
+        }
+
+        // The columns must hold exactly the measurements in the bucket document: the same number
+        // of measurements and the same data fields.
+        const auto data = elem.Obj();
+        const auto time = data[_timeFieldName];
+        if (time.type() != Object ||
+            static_cast<size_t>(time.Obj().nFields()) != _numMeasurements ||
+            data.nFields() != _finalized.nFields()) {
+            return boost::none;
+        }
+
+        BSONObjBuilder dataBuilder(builder.subobjStart(kBucketDataFieldName));
+        dataBuilder.append(_finalized.firstElement());
+        for (const auto& columnElem : data) {
+            if (columnElem.fieldNameStringData() == _timeFieldName) {
+                continue;
+            }
+            auto column = _finalized[columnElem.fieldNameStringData()];
+            if (!column) {
+                return boost::none;
+            }
+            dataBuilder.append(column);
+        }
+    }
+
+    return builder.obj();
+} catch (...) {
+    LOGV2_DEBUG(6170410,
+                1,
+                "Exception when compressing timeseries bucket incrementally",
+                "error"_attr = exceptionToStatus());
+    return boost::none;
+}
+
+void IncrementalBucketCompressor::_giveUp() {
+    _timeColumn.reset();
+    _columns.clear();
+    _memoryUsage = sizeof(*this);
+}
+
+void IncrementalBucketCompressor::_finalize() {
+    BSONObjBuilder builder;
+    builder.append(_timeFieldName, _timeColumn->finalize());
+    for (auto& [fieldName, column] : _columns) {
+        // Measurements that are missing the field at the end of the bucket are skipped as well.
+        while (column->size() < _numMeasurements) {
+            column->skip();
+        }
+        builder.append(fieldName, column->finalize());
+    }
+    _finalized = builder.obj();
+
+    _timeColumn.reset();
+    _columns.clear();
+    _memoryUsage = sizeof(*this) + _finalized.objsize();
+}
+
 }  // namespace timeseries
 }  // namespace mongo
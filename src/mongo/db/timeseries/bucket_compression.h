@@ -30,12 +30,17 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <memory>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONColumnBuilder;
+
 namespace timeseries {
 
 /**
@@ -46,5 +51,74 @@ namespace timeseries {
  */
 boost::optional<BSONObj> compressBucket(const BSONObj& bucketDoc, StringData timeFieldName);
 
+/**
+ * Compresses the measurements of an open bucket as they are committed, so that the compressed
+ * bucket can be built when the bucket is closed without reading, sorting and compressing all of its
+ * measurements again.
+ *
+ * The compressed format stores measurements in time order, so this only works for buckets whose
+ * measurements are committed in time order. Once a measurement arrives out of order, or cannot be
+ * compressed, the compressor gives up and compressBucket() must be used instead.
+ *
+ * Not thread-safe.
+ */
+class IncrementalBucketCompressor {
+public:
+    IncrementalBucketCompressor(StringData timeFieldName, StringData metaFieldName);
+    ~IncrementalBucketCompressor();
+
+    /**
+     * Appends a committed measurement, in the order it was written to the bucket document.
+     */
+    void append(const BSONObj& measurement);
+
+    /**
+     * Whether the measurements appended so far could all be compressed.
+     */
+    bool valid() const {
+        return bool(_timeColumn) || !_finalized.isEmpty();
+    }
+
+    /**
+     * Approximate number of bytes used by the compressor.
+     */
+    uint64_t memoryUsage() const {
+        return _memoryUsage;
+    }
+
+    /**
+     * Returns the compressed form of 'bucketDoc', the uncompressed bucket document holding the
+     * appended measurements, in the same format as compressBucket(). Returns boost::none if the
+     * compressor gave up or if its columns do not match the measurements in 'bucketDoc'.
+     *
+     * No measurements may be appended after this has been called.
+     */
+    boost::optional<BSONObj> compress(const BSONObj& bucketDoc);
+
+private:
+    void _giveUp();
+    void _finalize();
+
+    const std::string _timeFieldName;
+    const std::string _metaFieldName;
+
+    // The time of the latest measurement appended.
+    Date_t _latestTime = Date_t::min();
+
+    // Column builders for the time field and for the other data fields. Reset when the compressor
+    // gives up or is finalized.
+    std::unique_ptr<BSONColumnBuilder> _timeColumn;
+    StringMap<std::unique_ptr<BSONColumnBuilder>> _columns;
+
+    // The number of measurements appended.
+    size_t _numMeasurements = 0;
+
+    // The finalized columns, as BinData fields named after the data fields, once compress() has
+    // been called. The time field comes first.
+    BSONObj _finalized;
+
+    uint64_t _memoryUsage = 0;
+};
+
 }  // namespace timeseries
 }  // namespace mongo
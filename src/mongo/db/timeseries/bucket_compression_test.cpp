@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::timeseries {
+namespace {
+
+/**
+ * Builds the uncompressed bucket document that the bucket catalog writes for 'measurements'.
+ */
+BSONObj makeBucket(const std::vector<BSONObj>& measurements, StringData metaField) {
+    StringDataMap<BSONObjBuilder> dataBuilders;
+    std::vector<std::string> fieldOrder;
+    for (size_t i = 0; i < measurements.size(); ++i) {
+        for (const auto& elem : measurements[i]) {
+            auto key = elem.fieldNameStringData();
+            if (key == metaField) {
+                continue;
+            }
+            if (!dataBuilders.count(key)) {
+                fieldOrder.push_back(key.toString());
+            }
+            dataBuilders[key].appendAs(elem, std::to_string(i));
+        }
+    }
+
+    BSONObjBuilder builder;
+    builder.append("_id", OID::gen());
+    builder.append("control", BSON("version" << 1));
+    builder.appendAs(measurements.front()[metaField], "meta");
+    BSONObjBuilder dataBuilder(builder.subobjStart("data"));
+    for (const auto& field : fieldOrder) {
+        dataBuilder.append(field, dataBuilders[field].obj());
+    }
+    dataBuilder.done();
+    return builder.obj();
+}
+
+std::vector<BSONObj> makeMeasurements() {
+    return {BSON("time" << Date_t::fromMillisSinceEpoch(1) << "tag" << BSON("a" << 1) << "x" << 1),
+            BSON("time" << Date_t::fromMillisSinceEpoch(2) << "tag" << BSON("a" << 1) << "y"
+                        << "b"),
+            BSON("time" << Date_t::fromMillisSinceEpoch(3) << "tag" << BSON("a" << 1) << "x" << 3
+                        << "y"
+                        << "c"),
+            BSON("time" << Date_t::fromMillisSinceEpoch(4) << "tag" << BSON("a" << 1) << "z"
+                        << 4.5)};
+}
+
+TEST(IncrementalBucketCompressor, MatchesCompressBucket) {
+    auto measurements = makeMeasurements();
+    auto bucket = makeBucket(measurements, "tag"_sd);
+
+    IncrementalBucketCompressor compressor("time"_sd, "tag"_sd);
+    for (const auto& measurement : measurements) {
+        compressor.append(measurement);
+    }
+    ASSERT(compressor.valid());
+
+    auto compressed = compressor.compress(bucket);
+    ASSERT(compressed);
+    ASSERT_BSONOBJ_EQ(*compressed, *compressBucket(bucket, "time"_sd));
+
+    // Compressing again, e.g. when the update is retried, gives the same result.
+    ASSERT_BSONOBJ_EQ(*compressor.compress(bucket), *compressed);
+
+    // Fields missing from the last measurements are skipped for them.
+    BSONColumn x(compressed->getObjectField("data")["x"]);
+    ASSERT_EQ(x.size(), measurements.size());
+}
+
+TEST(IncrementalBucketCompressor, GivesUpOnMeasurementsOutOfTimeOrder) {
+    auto measurements = makeMeasurements();
+    std::swap(measurements[1], measurements[2]);
+
+    IncrementalBucketCompressor compressor("time"_sd, "tag"_sd);
+    for (const auto& measurement : measurements) {
+        compressor.append(measurement);
+    }
+    ASSERT_FALSE(compressor.valid());
+    ASSERT_FALSE(compressor.compress(makeBucket(measurements, "tag"_sd)));
+}
+
+TEST(IncrementalBucketCompressor, RejectsBucketWithOtherMeasurements) {
+    auto measurements = makeMeasurements();
+
+    IncrementalBucketCompressor compressor("time"_sd, "tag"_sd);
+    for (size_t i = 0; i + 1 < measurements.size(); ++i) {
+        compressor.append(measurements[i]);
+    }
+    ASSERT(compressor.valid());
+
+    // The bucket document holds a measurement the compressor has not seen.
+    ASSERT_FALSE(compressor.compress(makeBucket(measurements, "tag"_sd)));
+}
+
+}  // namespace
+}  // namespace mongo::timeseries
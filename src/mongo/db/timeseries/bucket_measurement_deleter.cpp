@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_measurement_deleter.h"
+
+#include "mongo/db/exec/bucket_unpacker.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/minmax.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo::timeseries {
+
+DeleteStageParams::PartialDeleteResult deleteMatchingMeasurements(
+    const BSONObj& bucketDoc,
+    const MatchExpression& predicate,
+    StringData timeField,
+    boost::optional<StringData> metaField,
+    const StringData::ComparatorInterface* comparator) {
+    BucketUnpacker unpacker{
+        BucketSpec{timeField.toString(),
+                   metaField ? boost::make_optional(metaField->toString()) : boost::none},
+        BucketUnpacker::Behavior::kExclude};
+    unpacker.reset(bucketDoc.getOwned());
+
+    DeleteStageParams::PartialDeleteResult result;
+    std::vector<BSONObj> remaining;
+    while (unpacker.hasNext()) {
+        auto measurement = unpacker.getNextBson();
+        if (predicate.matchesBSON(measurement)) {
+            ++result.numDeleted;
+        } else {
+            remaining.push_back(std::move(measurement));
+        }
+    }
+    if (result.numDeleted == 0 || remaining.empty()) {
+        return result;
+    }
+
+    MinMax minmax;
+    std::vector<std::string> fieldNames;
+    StringSet seenFieldNames;
+    for (const auto& measurement : remaining) {
+        minmax.update(measurement, metaField, comparator);
+        for (auto&& elem : measurement) {
+            auto fieldName = elem.fieldNameStringData();
+            if (fieldName != metaField && seenFieldNames.insert(fieldName.toString()).second) {
+                fieldNames.push_back(fieldName.toString());
+            }
+        }
+    }
+
+    auto control = bucketDoc.getObjectField(kBucketControlFieldName);
+    BSONObjBuilder builder;
+    builder.append(bucketDoc[kBucketIdFieldName]);
+    {
+        BSONObjBuilder controlBuilder(builder.subobjStart(kBucketControlFieldName));
+        controlBuilder.append(kBucketControlVersionFieldName, kTimeseriesControlDefaultVersion);
+        {
+            // The minimum time of a bucket is rounded down when the bucket is opened, and queries
+            // rely on that, so it is kept rather than recomputed.
+            auto minTime = control.getObjectField(kBucketControlMinFieldName)[timeField];
+            BSONObjBuilder minBuilder(controlBuilder.subobjStart(kBucketControlMinFieldName));
+            for (auto&& elem : minmax.min()) {
+                minBuilder.append(elem.fieldNameStringData() == timeField && minTime ? minTime
+                                                                                     : elem);
+            }
+        }
+        controlBuilder.append(kBucketControlMaxFieldName, minmax.max());
+        for (auto&& elem : control) {
+            auto fieldName = elem.fieldNameStringData();
+            if (fieldName != kBucketControlVersionFieldName &&
+                fieldName != kBucketControlMinFieldName &&
+                fieldName != kBucketControlMaxFieldName) {
+                controlBuilder.append(elem);
+            }
+        }
+    }
+    if (auto metadata = bucketDoc[kBucketMetaFieldName]) {
+        builder.append(metadata);
+    }
+    {
+        BSONObjBuilder data(builder.subobjStart(kBucketDataFieldName));
+        for (const auto& fieldName : fieldNames) {
+            BSONObjBuilder column(data.subobjStart(fieldName));
+            for (size_t i = 0; i < remaining.size(); ++i) {
+                if (auto elem = remaining[i][fieldName]) {
+                    column.appendAs(elem, std::to_string(i));
+                }
+            }
+        }
+    }
+    result.remainingDoc = builder.obj();
+
+    if (control.getIntField(kBucketControlVersionFieldName) ==
+        kTimeseriesControlCompressedVersion) {
+        if (auto compressed = compressBucket(*result.remainingDoc, timeField)) {
+            result.remainingDoc = std::move(*compressed);
+        }
+    }
+    return result;
+}
+
+DeleteStageParams::PartialDeleter makeMeasurementDeleter(
+    boost::intrusive_ptr<ExpressionContext> expCtx,
+    std::unique_ptr<MatchExpression> predicate,
+    const TimeseriesOptions& options,
+    std::unique_ptr<CollatorInterface> collator) {
+    return [expCtx = std::move(expCtx),
+            predicate = std::shared_ptr<const MatchExpression>(std::move(predicate)),
+            timeField = options.getTimeField().toString(),
+            metaField = options.getMetaField()
+                ? boost::make_optional(options.getMetaField()->toString())
+                : boost::none,
+            collator = std::shared_ptr<const CollatorInterface>(std::move(collator))](
+               const BSONObj& bucketDoc) {
+        return deleteMatchingMeasurements(bucketDoc,
+                                          *predicate,
+                                          timeField,
+                                          metaField ? boost::make_optional(StringData(*metaField))
+                                                    : boost::none,
+                                          collator.get());
+    };
+}
+
+}  // namespace mongo::timeseries
@@ -0,0 +1,70 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/delete.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
+
+namespace mongo::timeseries {
+
+/**
+ * Deletes the measurements matching 'predicate' from the given bucket. Returns the bucket holding
+ * the remaining measurements, which keeps the _id, metadata and compression of the original, or
+ * boost::none if no measurements remain. 'comparator' is the default collation of the collection,
+ * which is used to recompute control.min and control.max.
+ */
+DeleteStageParams::PartialDeleteResult deleteMatchingMeasurements(
+    const BSONObj& bucketDoc,
+    const MatchExpression& predicate,
+    StringData timeField,
+    boost::optional<StringData> metaField,
+    const StringData::ComparatorInterface* comparator);
+
+/**
+ * Returns the function with which a delete stage on the buckets collection deletes the
+ * measurements matching 'predicate' from each bucket; see deleteMatchingMeasurements(). The
+ * function keeps 'expCtx', which 'predicate' was parsed with, alive. 'collator' is the default
+ * collation of the collection.
+ */
+DeleteStageParams::PartialDeleter makeMeasurementDeleter(
+    boost::intrusive_ptr<ExpressionContext> expCtx,
+    std::unique_ptr<MatchExpression> predicate,
+    const TimeseriesOptions& options,
+    std::unique_ptr<CollatorInterface> collator);
+
+}  // namespace mongo::timeseries
@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/bucket_unpacker.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/bucket_measurement_deleter.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::timeseries {
+namespace {
+
+const BSONObj kBucket = fromjson(
+    R"({_id: {$oid: "629e1e680958e279dc29a517"},
+        control: {version: 1,
+                  min: {time: {$date: 0}, a: 1},
+                  max: {time: {$date: 3000}, a: 3},
+                  closed: false},
+        meta: "x",
+        data: {time: {"0": {$date: 1000}, "1": {$date: 2000}, "2": {$date: 3000}},
+               a: {"0": 1, "1": 2, "2": 3}}})");
+
+DeleteStageParams::PartialDeleteResult deleteMeasurements(const BSONObj& bucket,
+                                                          const BSONObj& query) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto predicate = uassertStatusOK(MatchExpressionParser::parse(query, expCtx));
+    return deleteMatchingMeasurements(bucket, *predicate, "time", "tag"_sd, nullptr);
+}
+
+TEST(BucketMeasurementDeleter, DeleteSomeMeasurements) {
+    auto result = deleteMeasurements(kBucket, fromjson("{a: 1}"));
+    ASSERT_EQ(result.numDeleted, 1U);
+    ASSERT(result.remainingDoc);
+
+    // The rounded down minimum time is kept.
+    ASSERT_BSONOBJ_EQ(*result.remainingDoc,
+                      fromjson(R"({_id: {$oid: "629e1e680958e279dc29a517"},
+        control: {version: 1,
+                  min: {time: {$date: 0}, a: 2},
+                  max: {time: {$date: 3000}, a: 3},
+                  closed: false},
+        meta: "x",
+        data: {time: {"0": {$date: 2000}, "1": {$date: 3000}},
+               a: {"0": 2, "1": 3}}})"));
+}
+
+TEST(BucketMeasurementDeleter, DeleteByMetaAndMeasurementFields) {
+    auto result = deleteMeasurements(kBucket, fromjson("{tag: 'x', a: {$gte: 2}}"));
+    ASSERT_EQ(result.numDeleted, 2U);
+    ASSERT(result.remainingDoc);
+    ASSERT_EQ(BucketUnpacker::computeMeasurementCount(*result.remainingDoc, "time"), 1);
+
+    ASSERT_EQ(deleteMeasurements(kBucket, fromjson("{tag: 'y', a: 1}")).numDeleted, 0U);
+}
+
+TEST(BucketMeasurementDeleter, DeleteAllMeasurements) {
+    auto result = deleteMeasurements(kBucket, fromjson("{a: {$gte: 1}}"));
+    ASSERT_EQ(result.numDeleted, 3U);
+    ASSERT_FALSE(result.remainingDoc);
+}
+
+TEST(BucketMeasurementDeleter, DeleteNoMeasurements) {
+    auto result = deleteMeasurements(kBucket, fromjson("{a: 5}"));
+    ASSERT_EQ(result.numDeleted, 0U);
+    ASSERT_FALSE(result.remainingDoc);
+}
+
+TEST(BucketMeasurementDeleter, DeleteFromCompressedBucket) {
+    auto compressed = compressBucket(kBucket, "time");
+    ASSERT(compressed);
+
+    auto result = deleteMeasurements(*compressed, fromjson("{a: 2}"));
+    ASSERT_EQ(result.numDeleted, 1U);
+    ASSERT(result.remainingDoc);
+
+    auto control = result.remainingDoc->getObjectField("control");
+    ASSERT_EQ(control.getIntField("version"), 2);
+    ASSERT_BSONOBJ_EQ(control.getObjectField("min"), fromjson("{time: {$date: 0}, a: 1}"));
+    ASSERT_BSONOBJ_EQ(control.getObjectField("max"), fromjson("{time: {$date: 3000}, a: 3}"));
+    ASSERT_EQ(BucketUnpacker::computeMeasurementCount(*result.remainingDoc, "time"), 2);
+}
+
+}  // namespace
+}  // namespace mongo::timeseries
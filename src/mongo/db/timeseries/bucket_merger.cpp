@@ -0,0 +1,582 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_merger.h"
+
+#include "mongo/base/counter.h"
+#include "mongo/base/parse_number.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/throttle_cursor.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/lock_state.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/op_observer.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/internal_plans.h"
+#include "mongo/db/record_id_helpers.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/db/timeseries/bucket_bloom_filter.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/catalog_helper.h"
+#include "mongo/db/timeseries/minmax.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class TimeseriesBucketMerger;
+
+namespace {
+
+const auto getBucketMerger =
+    ServiceContext::declareDecoration<std::unique_ptr<TimeseriesBucketMerger>>();
+
+Counter64 bucketMergePasses;
+Counter64 bucketMerges;
+Counter64 bucketsMerged;
+
+ServerStatusMetricField<Counter64> bucketMergePassesDisplay("timeseries.bucketMerge.passes",
+                                                            &bucketMergePasses);
+ServerStatusMetricField<Counter64> bucketMergesDisplay("timeseries.bucketMerge.merges",
+                                                       &bucketMerges);
+ServerStatusMetricField<Counter64> bucketsMergedDisplay("timeseries.bucketMerge.bucketsMerged",
+                                                        &bucketsMerged);
+
+/**
+ * The properties of an uncompressed bucket which decide whether it can be merged with the buckets
+ * next to it.
+ */
+struct BucketSummary {
+    BSONElement metadata;
+    Date_t minTime;
+    Date_t maxTime;
+    int numMeasurements;
+};
+
+/**
+ * Returns the summary of the given bucket, or boost::none if the bucket cannot be merged because
+ * it is compressed, has no metadata, or is malformed.
+ */
+boost::optional<BucketSummary> summarizeBucket(const BSONObj& bucketDoc, StringData timeField) {
+    auto metadata = bucketDoc[timeseries::kBucketMetaFieldName];
+    auto control = bucketDoc[timeseries::kBucketControlFieldName];
+    auto data = bucketDoc[timeseries::kBucketDataFieldName];
+    if (!metadata || bucketDoc[timeseries::kBucketIdFieldName].type() != BSONType::jstOID ||
+        control.type() != BSONType::Object || data.type() != BSONType::Object) {
+        return boost::none;
+    }
+
+    auto version = control.Obj()[timeseries::kBucketControlVersionFieldName];
+    if (!version.isNumber() ||
+        version.numberInt() != timeseries::kTimeseriesControlDefaultVersion) {
+        return boost::none;
+    }
+
+    auto minTime = control.Obj()[timeseries::kBucketControlMinFieldName].Obj()[timeField];
+    auto maxTime = control.Obj()[timeseries::kBucketControlMaxFieldName].Obj()[timeField];
+    auto times = data.Obj()[timeField];
+    if (minTime.type() != BSONType::Date || maxTime.type() != BSONType::Date ||
+        times.type() != BSONType::Object) {
+        return boost::none;
+    }
+
+    return BucketSummary{metadata, minTime.Date(), maxTime.Date(), times.Obj().nFields()};
+}
+
+/**
+ * Returns a bound for a scan of the index with the given key pattern, starting with the given
+ * metadata and time if set. The remaining fields are the lowest or highest possible values.
+ */
+BSONObj makeIndexBound(const BSONObj& keyPattern,
+                       const BSONElement& metadata,
+                       boost::optional<Date_t> time,
+                       bool low) {
+    BSONObjBuilder builder;
+    size_t i = 0;
+    for (auto&& field : keyPattern) {
+        if (i == 0 && metadata) {
+            builder.appendAs(metadata, "");
+        } else if (i == 1 && time) {
+            builder.append("", *time);
+        } else if (low == (field.number() >= 0)) {
+            builder.appendMinKey("");
+        } else {
+            builder.appendMaxKey("");
+        }
+        ++i;
+    }
+    return builder.obj();
+}
+
+/**
+ * A set of buckets to merge and the resulting bucket.
+ */
+struct BucketMerge {
+    std::vector<BSONObj> buckets;
+    BSONObj merged;
+};
+
+}  // namespace
+
+namespace timeseries {
+
+BSONObj mergeBuckets(const std::vector<BSONObj>& buckets,
+                     StringData timeField,
+                     const StringData::ComparatorInterface* comparator) {
+    invariant(!buckets.empty());
+
+    MinMax minmax;
+    std::vector<std::string> fieldNames;
+    StringSet seenFieldNames;
+
+    // A bloom filter is only kept for the merged bucket if every bucket has one for the field.
+    std::vector<std::pair<std::string, BucketBloomFilter>> bloomFilters;
+    for (auto&& elem : buckets.front()
+                           .getObjectField(kBucketControlFieldName)
+                           .getObjectField(kBucketControlBloomFieldName)) {
+        if (auto filter = BucketBloomFilter::parse(elem)) {
+            bloomFilters.emplace_back(elem.fieldName(), *filter);
+        }
+    }
+
+    for (const auto& bucket : buckets) {
+        auto control = bucket.getObjectField(kBucketControlFieldName);
+        minmax.update(control.getObjectField(kBucketControlMinFieldName), boost::none, comparator);
+        minmax.update(control.getObjectField(kBucketControlMaxFieldName), boost::none, comparator);
+        auto controlBloom = control.getObjectField(kBucketControlBloomFieldName);
+        for (auto it = bloomFilters.begin(); it != bloomFilters.end();) {
+            if (auto filter = BucketBloomFilter::parse(controlBloom[it->first])) {
+                it->second.merge(*filter);
+                ++it;
+            } else {
+                it = bloomFilters.erase(it);
+            }
+        }
+        for (auto&& column : bucket.getObjectField(kBucketDataFieldName)) {
+            if (seenFieldNames.insert(column.fieldName()).second) {
+                fieldNames.push_back(column.fieldName());
+            }
+        }
+    }
+
+    BSONObjBuilder builder;
+    builder.append(buckets.front()[kBucketIdFieldName]);
+    {
+        BSONObjBuilder control(builder.subobjStart(kBucketControlFieldName));
+        control.append(kBucketControlVersionFieldName, kTimeseriesControlDefaultVersion);
+        control.append(kBucketControlMinFieldName, minmax.min());
+        control.append(kBucketControlMaxFieldName, minmax.max());
+        if (!bloomFilters.empty()) {
+            BSONObjBuilder bloom(control.subobjStart(kBucketControlBloomFieldName));
+            for (const auto& [field, filter] : bloomFilters) {
+                filter.appendTo(&bloom, field);
+            }
+        }
+    }
+    if (auto metadata = buckets.front()[kBucketMetaFieldName]) {
+        builder.append(metadata);
+    }
+    {
+        // Shift the measurement indexes of each bucket by the number of measurements in the buckets
+        // before it.
+        BSONObjBuilder data(builder.subobjStart(kBucketDataFieldName));
+        for (const auto& fieldName : fieldNames) {
+            BSONObjBuilder column(data.subobjStart(fieldName));
+            uint32_t offset = 0;
+            for (const auto& bucket : buckets) {
+                auto bucketData = bucket.getObjectField(kBucketDataFieldName);
+                for (auto&& elem : bucketData.getObjectField(fieldName)) {
+                    uint32_t index;
+                    uassertStatusOK(NumberParser{}(elem.fieldNameStringData(), &index));
+                    column.appendAs(elem, std::to_string(offset + index));
+                }
+                offset += bucketData.getObjectField(timeField).nFields();
+            }
+        }
+    }
+    return builder.obj();
+}
+
+}  // namespace timeseries
+
+class TimeseriesBucketMerger : public BackgroundJob {
+public:
+    TimeseriesBucketMerger() : BackgroundJob(false /* selfDelete */) {}
+
+    static TimeseriesBucketMerger* get(ServiceContext* serviceCtx) {
+        return getBucketMerger(serviceCtx).get();
+    }
+
+    static void set(ServiceContext* serviceCtx, std::unique_ptr<TimeseriesBucketMerger> merger) {
+        auto& bucketMerger = getBucketMerger(serviceCtx);
+        if (bucketMerger) {
+            invariant(!bucketMerger->running(),
+                      "Tried to reset the TimeseriesBucketMerger without shutting down the "
+                      "original instance.");
+        }
+
+        invariant(merger);
+        bucketMerger = std::move(merger);
+    }
+
+    std::string name() const {
+        return "TimeseriesBucketMerger";
+    }
+
+    void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+
+        {
+            stdx::lock_guard<Client> lk(*tc.get());
+            tc.get()->setSystemOperationKillableByStepdown(lk);
+        }
+
+        while (true) {
+            {
+                auto deadline = Date_t::now() + Seconds(gTimeseriesBucketMergeSleepSecs.load());
+                stdx::unique_lock<Latch> lk(_stateMutex);
+
+                MONGO_IDLE_THREAD_BLOCK;
+                _shuttingDownCV.wait_until(
+                    lk, deadline.toSystemTimePoint(), [&] { return _shuttingDown; });
+
+                if (_shuttingDown) {
+                    return;
+                }
+            }
+
+            if (!gTimeseriesBucketMergeEnabled.load() || lockedForWriting()) {
+                continue;
+            }
+
+            try {
+                _doPass();
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>& interruption) {
+                LOGV2_DEBUG(6170420,
+                            1,
+                            "Time-series bucket merger was interrupted",
+                            "error"_attr = interruption);
+            }
+        }
+    }
+
+    /**
+     * Signals the thread to quit and then waits until it does.
+     */
+    void shutdown() {
+        LOGV2(6170421, "Shutting down time-series bucket merger thread");
+        {
+            stdx::lock_guard<Latch> lk(_stateMutex);
+            _shuttingDown = true;
+            _shuttingDownCV.notify_one();
+        }
+        wait();
+        LOGV2(6170422, "Finished shutting down time-series bucket merger thread");
+    }
+
+private:
+    /**
+     * Merges buckets in every time-series collection that this node can write to.
+     */
+    void _doPass() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext* opCtx = opCtxPtr.get();
+
+        // Merging is background work, so let user operations have tickets first.
+        ScopedTicketPriority ticketPriority(opCtx, TicketHolder::Priority::kLow);
+
+        DataThrottle dataThrottle(opCtx, [] { return gTimeseriesBucketMergeMaxMBPerSec.load(); });
+
+        ON_BLOCK_EXIT([&] { bucketMergePasses.increment(); });
+
+        auto catalog = CollectionCatalog::get(opCtx);
+        for (const auto& dbName : catalog->getAllDbNames()) {
+            for (const auto& nss : catalog->getAllCollectionNamesFromDb(opCtx, dbName)) {
+                if (!nss.isTimeseriesBucketsCollection() ||
+                    !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss)) {
+                    continue;
+                }
+
+                try {
+                    for (const auto& merge : _findMerges(opCtx, nss, &dataThrottle)) {
+                        if (_commitMerge(opCtx, nss, merge)) {
+                            bucketMerges.increment();
+                            bucketsMerged.increment(merge.buckets.size());
+                        }
+                    }
+                } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                    throw;
+                } catch (const DBException& ex) {
+                    LOGV2_DEBUG(6170423,
+                                1,
+                                "Failed to merge time-series buckets",
+                                "namespace"_attr = nss,
+                                "error"_attr = ex);
+                }
+            }
+        }
+    }
+
+    /**
+     * Scans the buckets of the given collection in metadata and time order, starting where the
+     * previous pass stopped, and returns the runs of adjacent buckets that together fit into one
+     * bucket.
+     */
+    std::vector<BucketMerge> _findMerges(OperationContext* opCtx,
+                                         const NamespaceString& bucketsNs,
+                                         DataThrottle* dataThrottle) {
+        std::vector<BucketMerge> merges;
+
+        AutoGetCollectionForRead coll(opCtx, bucketsNs);
+        if (!coll || !coll->getTimeseriesOptions()) {
+            return merges;
+        }
+
+        const auto& options = *coll->getTimeseriesOptions();
+        if (!options.getMetaField()) {
+            return merges;
+        }
+
+        auto index = timeseries::findMetaTimeIndex(opCtx, coll.getCollection(), options);
+        if (!index) {
+            return merges;
+        }
+
+        auto& resumeKey = _resumeKeys[bucketsNs];
+        auto startKey = !resumeKey.isEmpty()
+            ? resumeKey
+            : makeIndexBound(index->keyPattern(), BSONElement(), boost::none, true /* low */);
+        auto endKey = makeIndexBound(index->keyPattern(), BSONElement(), boost::none, false);
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               &coll.getCollection(),
+                                               index,
+                                               startKey,
+                                               endKey,
+                                               BoundInclusion::kIncludeBothStartAndEndKeys,
+                                               PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                               InternalPlanner::FORWARD,
+                                               InternalPlanner::IXSCAN_FETCH);
+
+        auto timeField = options.getTimeField();
+        auto maxSpan = Seconds(*options.getBucketMaxSpanSeconds());
+        auto comparator = coll->getDefaultCollator();
+
+        // Buckets which may still be open in the bucket catalog are left alone.
+        auto maxTimeToMerge = Date_t::now() - maxSpan;
+
+        std::vector<BSONObj> group;
+        boost::optional<BucketSummary> groupSummary;
+        int groupSize = 0;
+        auto flushGroup = [&] {
+            if (group.size() > 1) {
+                merges.push_back({group, timeseries::mergeBuckets(group, timeField, comparator)});
+            }
+            group.clear();
+            groupSummary.reset();
+            groupSize = 0;
+        };
+
+        BSONObj bucketDoc;
+        boost::optional<BucketSummary> lastSummary;
+        int numScanned = 0;
+        int maxScanned = gTimeseriesBucketMergeMaxBucketsScannedPerPass.load();
+        while (numScanned < maxScanned &&
+               exec->getNext(&bucketDoc, nullptr) == PlanExecutor::ADVANCED) {
+            ++numScanned;
+            dataThrottle->awaitIfNeeded(opCtx, bucketDoc.objsize());
+
+            bucketDoc = bucketDoc.getOwned();
+            auto summary = summarizeBucket(bucketDoc, timeField);
+            lastSummary = summary;
+            if (!summary || summary->maxTime >= maxTimeToMerge ||
+                summary->numMeasurements >= gTimeseriesBucketMaxCount ||
+                bucketDoc.objsize() >= gTimeseriesBucketMaxSize) {
+                flushGroup();
+                continue;
+            }
+
+            // The bucket can be added to the current group if it has the same metadata, does not
+            // overlap the previous bucket, and the merged bucket stays within the bucket limits.
+            if (groupSummary &&
+                (!summary->metadata.binaryEqualValues(groupSummary->metadata) ||
+                 summary->minTime < groupSummary->maxTime ||
+                 summary->maxTime - groupSummary->minTime >= maxSpan ||
+                 groupSummary->numMeasurements + summary->numMeasurements >
+                     gTimeseriesBucketMaxCount ||
+                 groupSize + bucketDoc.objsize() > gTimeseriesBucketMaxSize)) {
+                flushGroup();
+            }
+
+            if (!groupSummary) {
+                groupSummary = summary;
+                groupSummary->numMeasurements = 0;
+            }
+            group.push_back(bucketDoc);
+            groupSummary->metadata = group.front()[timeseries::kBucketMetaFieldName];
+            groupSummary->maxTime = summary->maxTime;
+            groupSummary->numMeasurements += summary->numMeasurements;
+            groupSize += bucketDoc.objsize();
+        }
+        flushGroup();
+
+        // Continue with the last bucket in the next pass, unless the scan reached the end.
+        resumeKey = numScanned == maxScanned && lastSummary
+            ? makeIndexBound(
+                  index->keyPattern(), lastSummary->metadata, lastSummary->minTime, true /* low */)
+            : BSONObj();
+
+        return merges;
+    }
+
+    /**
+     * Replaces the first bucket of the merge with the merged bucket, compressed if possible, and
+     * deletes the other buckets. The writes are replicated as a single applyOps oplog entry, so
+     * that they are applied atomically on secondaries as well. Returns false, without writing
+     * anything, if any of the buckets changed since it was read.
+     */
+    bool _commitMerge(OperationContext* opCtx,
+                      const NamespaceString& bucketsNs,
+                      const BucketMerge& merge) {
+        auto merged = merge.merged;
+        if (feature_flags::gTimeseriesBucketCompression.isEnabledAndIgnoreFCV()) {
+            auto timeField = merge.buckets.front()
+                                 .getObjectField(timeseries::kBucketControlFieldName)
+                                 .getObjectField(timeseries::kBucketControlMinFieldName)
+                                 .firstElementFieldNameStringData();
+            auto compressed = timeseries::compressBucket(merged, timeField);
+            if (compressed && compressed->objsize() < merged.objsize()) {
+                merged = *compressed;
+            }
+        }
+
+        return writeConflictRetry(opCtx, "timeseriesBucketMerge", bucketsNs.ns(), [&] {
+            AutoGetCollection coll(opCtx, bucketsNs, MODE_IX);
+            if (!coll || !coll->isClustered() ||
+                !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, bucketsNs)) {
+                return false;
+            }
+
+            WriteUnitOfWork wuow(opCtx);
+
+            std::vector<std::pair<RecordId, Snapshotted<BSONObj>>> originals;
+            for (const auto& bucket : merge.buckets) {
+                auto recordId =
+                    record_id_helpers::keyForOID(bucket[timeseries::kBucketIdFieldName].OID());
+                Snapshotted<BSONObj> original;
+                if (!coll->findDoc(opCtx, recordId, &original) ||
+                    !original.value().binaryEqual(bucket)) {
+                    return false;
+                }
+                originals.emplace_back(recordId, std::move(original));
+            }
+
+            BSONArrayBuilder ops;
+            {
+                // Replicate the writes together below, like an atomic applyOps command.
+                repl::UnreplicatedWritesBlock uwb(opCtx);
+
+                const auto& [recordId, original] = originals.front();
+                CollectionUpdateArgs args;
+                args.preImageDoc = original.value();
+                args.update = merged;
+                args.criteria = BSON(timeseries::kBucketIdFieldName
+                                     << original.value()[timeseries::kBucketIdFieldName]);
+                coll->updateDocument(
+                    opCtx, recordId, original, merged, true /* indexesAffected */, nullptr, &args);
+                ops.append(BSON("op"
+                                << "u"
+                                << "ns" << bucketsNs.ns() << "ui" << coll->uuid() << "o" << merged
+                                << "o2" << args.criteria));
+
+                for (auto it = std::next(originals.begin()); it != originals.end(); ++it) {
+                    coll->deleteDocument(
+                        opCtx, it->second, kUninitializedStmtId, it->first, nullptr);
+                    auto id = it->second.value()[timeseries::kBucketIdFieldName];
+                    ops.append(BSON("op"
+                                    << "d"
+                                    << "ns" << bucketsNs.ns() << "ui" << coll->uuid() << "o"
+                                    << BSON(timeseries::kBucketIdFieldName << id)));
+                }
+            }
+
+            opCtx->getServiceContext()->getOpObserver()->onApplyOps(
+                opCtx, bucketsNs.db().toString(), BSON("applyOps" << ops.arr()));
+            wuow.commit();
+            return true;
+        });
+    }
+
+    // Protects the state below.
+    mutable Mutex _stateMutex = MONGO_MAKE_LATCH("TimeseriesBucketMerger::_stateMutex");
+
+    // Signaled to wake up the thread, if the thread is waiting. The thread will check whether
+    // _shuttingDown is set and stop accordingly.
+    mutable stdx::condition_variable _shuttingDownCV;
+
+    bool _shuttingDown = false;
+
+    // Where the next pass continues for each collection, as a start key for its meta/time index.
+    // Only accessed by the merger thread.
+    stdx::unordered_map<NamespaceString, BSONObj> _resumeKeys;
+};
+
+void startTimeseriesBucketMerger(ServiceContext* serviceContext) {
+    auto merger = std::make_unique<TimeseriesBucketMerger>();
+    merger->go();
+    TimeseriesBucketMerger::set(serviceContext, std::move(merger));
+}
+
+void shutdownTimeseriesBucketMerger(ServiceContext* serviceContext) {
+    auto merger = TimeseriesBucketMerger::get(serviceContext);
+    // The merger may not be set if shutdown happens before it was started.
+    if (merger) {
+        merger->shutdown();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,66 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+namespace timeseries {
+
+/**
+ * Merges the given uncompressed buckets, which must have the same metadata and be ordered by time,
+ * into a single uncompressed bucket with the _id of the first one. The measurements keep their
+ * order, and the control.min and control.max fields of the result cover all of the buckets.
+ */
+BSONObj mergeBuckets(const std::vector<BSONObj>& buckets,
+                     StringData timeField,
+                     const StringData::ComparatorInterface* comparator);
+
+}  // namespace timeseries
+
+/**
+ * Starts the background job which merges adjacent, underfilled buckets of time-series collections
+ * that have the same metadata, see 'timeseriesBucketMergeEnabled'. Safe to call again after
+ * shutdownTimeseriesBucketMerger() has been called.
+ */
+void startTimeseriesBucketMerger(ServiceContext* serviceContext);
+
+/**
+ * Shuts down the background bucket merger if it is running. Safe to call multiple times.
+ */
+void shutdownTimeseriesBucketMerger(ServiceContext* serviceContext);
+
+}  // namespace mongo
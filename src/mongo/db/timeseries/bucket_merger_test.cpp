@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/timeseries/bucket_merger.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::timeseries {
+namespace {
+
+TEST(BucketMerger, MergeBuckets) {
+    auto first = fromjson(
+        R"({_id: {$oid: "629e1e680958e279dc29a517"},
+            control: {version: 1,
+                      min: {time: {$date: 1000}, a: 1},
+                      max: {time: {$date: 2000}, a: 3}},
+            meta: "x",
+            data: {time: {"0": {$date: 1000}, "1": {$date: 2000}},
+                   a: {"0": 1, "1": 3}}})");
+    auto second = fromjson(
+        R"({_id: {$oid: "629e1e680958e279dc29a518"},
+            control: {version: 1,
+                      min: {time: {$date: 3000}, a: 0, b: "z"},
+                      max: {time: {$date: 4000}, a: 0, b: "z"}},
+            meta: "x",
+            data: {time: {"0": {$date: 3000}, "1": {$date: 4000}},
+                   a: {"0": 0},
+                   b: {"1": "z"}}})");
+
+    auto merged = mergeBuckets({first, second}, "time", nullptr);
+    ASSERT_BSONOBJ_EQ(merged,
+                      fromjson(R"({_id: {$oid: "629e1e680958e279dc29a517"},
+            control: {version: 1,
+                      min: {time: {$date: 1000}, a: 0, b: "z"},
+                      max: {time: {$date: 4000}, a: 3, b: "z"}},
+            meta: "x",
+            data: {time: {"0": {$date: 1000}, "1": {$date: 2000},
+                          "2": {$date: 3000}, "3": {$date: 4000}},
+                   a: {"0": 1, "1": 3, "2": 0},
+                   b: {"3": "z"}}})"));
+}
+
+TEST(BucketMerger, MergeSingleBucket) {
+    auto bucket = fromjson(
+        R"({_id: {$oid: "629e1e680958e279dc29a517"},
+            control: {version: 1,
+                      min: {time: {$date: 1000}, a: 1},
+                      max: {time: {$date: 2000}, a: 3}},
+            meta: {m: 1},
+            data: {time: {"0": {$date: 1000}, "1": {$date: 2000}},
+                   a: {"0": 1, "1": 3}}})");
+
+    ASSERT_BSONOBJ_EQ(mergeBuckets({bucket}, "time", nullptr), bucket);
+}
+
+}  // namespace
+}  // namespace mongo::timeseries
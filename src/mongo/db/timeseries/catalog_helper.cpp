@@ -32,6 +32,10 @@
 #include "mongo/db/timeseries/catalog_helper.h"
 
 #include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 
@@ -48,5 +52,30 @@ boost::optional<TimeseriesOptions> getTimeseriesOptions(OperationContext* opCtx,
     return bucketsColl->getTimeseriesOptions();
 }
 
+const IndexDescriptor* findMetaTimeIndex(OperationContext* opCtx,
+                                         const CollectionPtr& bucketsColl,
+                                         const TimeseriesOptions& options) {
+    std::string controlMinTimeField = str::stream()
+        << kControlMinFieldNamePrefix << options.getTimeField();
+    auto it =
+        bucketsColl->getIndexCatalog()->getIndexIterator(opCtx, false /* includeUnfinished */);
+    while (it->more()) {
+        auto descriptor = it->next()->descriptor();
+        if (descriptor->isPartial() || !descriptor->collation().isEmpty()) {
+            continue;
+        }
+
+        BSONObjIterator keyIt(descriptor->keyPattern());
+        auto metaKey = keyIt.next();
+        auto timeKey = keyIt.more() ? keyIt.next() : BSONElement();
+        if (metaKey.fieldNameStringData() == kBucketMetaFieldName && metaKey.isNumber() &&
+            metaKey.number() == 1 && timeKey.fieldNameStringData() == controlMinTimeField &&
+            timeKey.isNumber() && timeKey.number() == 1) {
+            return descriptor;
+        }
+    }
+    return nullptr;
+}
+
 }  // namespace timeseries
 }  // namespace mongo
@@ -33,6 +33,8 @@
 
 namespace mongo {
 
+class CollectionPtr;
+class IndexDescriptor;
 class NamespaceString;
 class OperationContext;
 
@@ -48,5 +50,16 @@ namespace timeseries {
 boost::optional<TimeseriesOptions> getTimeseriesOptions(OperationContext* opCtx,
                                                         const NamespaceString& nss);
 
+/**
+ * Returns an index of the buckets collection 'bucketsColl' whose key pattern starts with the
+ * metadata field and the control.min time field, both ascending, so that it orders the buckets
+ * for each metadata value by time. Partial indexes and indexes with a collation are not returned,
+ * as they cannot be used to look up every bucket by its metadata. Returns nullptr if there is no
+ * such index.
+ */
+const IndexDescriptor* findMetaTimeIndex(OperationContext* opCtx,
+                                         const CollectionPtr& bucketsColl,
+                                         const TimeseriesOptions& options);
+
 }  // namespace timeseries
 }  // namespace mongo
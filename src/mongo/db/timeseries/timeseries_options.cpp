@@ -145,7 +145,8 @@ bool optionsAreEqual(const TimeseriesOptions& option1, const TimeseriesOptions&
     return option1.getTimeField() == option1.getTimeField() &&
         option1.getMetaField() == option2.getMetaField() &&
         option1.getGranularity() == option2.getGranularity() &&
-        option1BucketSpan == option2BucketSpan;
+        option1BucketSpan == option2BucketSpan &&
+        option1.getBloomFilterFields() == option2.getBloomFilterFields();
 }
 
 namespace {
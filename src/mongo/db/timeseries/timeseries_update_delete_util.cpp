@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/bucket_unpacker.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/util/str.h"
 
 namespace mongo::timeseries {
 namespace {
@@ -133,6 +134,64 @@ void replaceQueryMetaFieldName(mutablebson::Element elem,
             child, metaField, shouldReplaceFieldValue, isTopLevelField, parentIsArray);
     }
 }
+
+/**
+ * Appends the predicates on the control.min and control.max time of a bucket implied by the given
+ * predicate on the timeField. Only comparisons with dates are translated, since every measurement
+ * has a date in the timeField. The control.min time is rounded down, so it only bounds from below.
+ */
+void appendTimePredicates(const BSONElement& predicate,
+                          StringData timeField,
+                          BSONArrayBuilder* predicates) {
+    std::string minTimeField = str::stream() << kControlMinFieldNamePrefix << timeField;
+    std::string maxTimeField = str::stream() << kControlMaxFieldNamePrefix << timeField;
+    if (predicate.type() == BSONType::Date) {
+        predicates->append(BSON(minTimeField << BSON("$lte" << predicate.date())));
+        predicates->append(BSON(maxTimeField << BSON("$gte" << predicate.date())));
+        return;
+    }
+    if (predicate.type() != BSONType::Object) {
+        return;
+    }
+    for (auto&& op : predicate.Obj()) {
+        if (op.type() != BSONType::Date) {
+            continue;
+        }
+        auto opName = op.fieldNameStringData();
+        if (opName == "$eq"_sd) {
+            predicates->append(BSON(minTimeField << BSON("$lte" << op.date())));
+            predicates->append(BSON(maxTimeField << BSON("$gte" << op.date())));
+        } else if (opName == "$gt"_sd || opName == "$gte"_sd) {
+            predicates->append(BSON(maxTimeField << BSON(opName << op.date())));
+        } else if (opName == "$lt"_sd || opName == "$lte"_sd) {
+            predicates->append(BSON(minTimeField << BSON(opName << op.date())));
+        }
+    }
+}
+
+/**
+ * Appends the bucket-level predicates for the top-level conjuncts of the given query, descending
+ * into $and. See getBucketLevelQuery().
+ */
+void appendBucketLevelPredicates(const BSONObj& query,
+                                 StringData timeField,
+                                 boost::optional<StringData> metaField,
+                                 BSONArrayBuilder* predicates) {
+    for (auto&& elem : query) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "$and"_sd && elem.type() == BSONType::Array) {
+            for (auto&& child : elem.Obj()) {
+                if (child.type() == BSONType::Object) {
+                    appendBucketLevelPredicates(child.Obj(), timeField, metaField, predicates);
+                }
+            }
+        } else if (metaField && isMetaFieldFirstElementOfDottedPathField(fieldName, *metaField)) {
+            predicates->append(translateQuery(elem.wrap(), *metaField));
+        } else if (fieldName == timeField) {
+            appendTimePredicates(elem, timeField, predicates);
+        }
+    }
+}
 }  // namespace
 
 bool queryOnlyDependsOnMetaField(boost::optional<StringData> metaField,
@@ -231,6 +290,17 @@ write_ops::UpdateModification translateUpdate(const write_ops::UpdateModificatio
     return write_ops::UpdateModification::parseFromClassicUpdate(updateDoc.getObject());
 }
 
+BSONObj getBucketLevelQuery(const BSONObj& query,
+                            StringData timeField,
+                            boost::optional<StringData> metaField) {
+    BSONArrayBuilder predicates;
+    appendBucketLevelPredicates(query, timeField, metaField, &predicates);
+    if (predicates.arrSize() == 0) {
+        return BSONObj();
+    }
+    return BSON("$and" << predicates.arr());
+}
+
 std::function<size_t(const BSONObj&)> numMeasurementsForBucketCounter(StringData timeField) {
     return [timeField = timeField.toString()](const BSONObj& bucket) {
         return BucketUnpacker::computeMeasurementCount(bucket, timeField);
@@ -62,6 +62,16 @@ bool updateOnlyModifiesMetaField(OperationContext* opCtx,
  */
 BSONObj translateQuery(const BSONObj& query, StringData metaField);
 
+/**
+ * Returns a query on the time-series collection's underlying buckets collection which matches every
+ * bucket holding a measurement that matches the given query, and possibly other buckets too. It is
+ * built from the top-level conjuncts of the query on the metaField and those comparing the
+ * timeField with a date; the other conjuncts are left to be applied to the measurements.
+ */
+BSONObj getBucketLevelQuery(const BSONObj& query,
+                            StringData timeField,
+                            boost::optional<StringData> metaField);
+
 
 /**
  * Translates the given update on the time-series collection to an update on the time-series
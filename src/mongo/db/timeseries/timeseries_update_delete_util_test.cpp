@@ -30,6 +30,7 @@
 
 #include "mongo/base/error_codes.h"
 #include "mongo/bson/bsonobj.h"
+#include "mongo/bson/json.h"
 #include "mongo/db/pipeline/document_source_merge_gen.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/legacy_runtime_constants_gen.h"
@@ -516,6 +517,32 @@ TEST_F(TimeseriesUpdateDeleteUtilTest, TranslateUpdate) {
                                << "meta.tag.a")));
 }
 
+TEST_F(TimeseriesUpdateDeleteUtilTest, GetBucketLevelQuery) {
+    ASSERT_BSONOBJ_EQ(timeseries::getBucketLevelQuery(fromjson("{a: 1}"), "time", _metaField),
+                      BSONObj());
+    ASSERT_BSONOBJ_EQ(
+        timeseries::getBucketLevelQuery(fromjson("{tag: 'A', a: 1}"), "time", _metaField),
+        fromjson("{$and: [{meta: 'A'}]}"));
+    ASSERT_BSONOBJ_EQ(timeseries::getBucketLevelQuery(
+                          fromjson("{$and: [{'tag.b': {$gt: 1}}, {time: {$gte: {$date: 1000}, "
+                                   "$lt: {$date: 2000}}}]}"),
+                          "time",
+                          _metaField),
+                      fromjson("{$and: [{'meta.b': {$gt: 1}}, "
+                               "{'control.max.time': {$gte: {$date: 1000}}}, "
+                               "{'control.min.time': {$lt: {$date: 2000}}}]}"));
+    ASSERT_BSONOBJ_EQ(
+        timeseries::getBucketLevelQuery(fromjson("{time: {$date: 1000}}"), "time", boost::none),
+        fromjson("{$and: [{'control.min.time': {$lte: {$date: 1000}}}, "
+                 "{'control.max.time': {$gte: {$date: 1000}}}]}"));
+
+    // Disjunctions and comparisons of the timeField with other types are not translated.
+    ASSERT_BSONOBJ_EQ(
+        timeseries::getBucketLevelQuery(
+            fromjson("{$or: [{tag: 'A'}, {a: 1}], time: {$gt: 5}}"), "time", _metaField),
+        BSONObj());
+}
+
 // Translate an update with an empty metaField, which violates the translation method's
 // precondition.
 DEATH_TEST_F(TimeseriesUpdateDeleteUtilTest,
@@ -31,8 +31,28 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/base/string_data.h"
+#include "mongo/util/time_support.h"
+
 namespace mongo {
 
+// A message read from a traffic recording, see TrafficRecorder. Views into the buffer it was read
+// into.
+struct TrafficReaderPacket {
+    uint64_t id;
+    StringData local;
+    StringData remote;
+    Date_t date;
+    uint64_t order;
+    MsgData::ConstView message;
+};
+
+// Reads the next packet of the recording open as 'fd' into 'buf', which must hold at least
+// MaxMessageSizeBytes. Returns boost::none at the end of the recording.
+boost::optional<TrafficReaderPacket> readPacket(char* buf, int fd);
+
 // Method for testing, takes the recorded traffic and returns a BSONArray
 BSONArray trafficRecordingFileToBSONArr(const std::string& inputFile);
 
@@ -0,0 +1,307 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/traffic_replay.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <set>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/client/dbclient_base.h"
+#include "mongo/db/client.h"
+#include "mongo/db/traffic_reader.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/rpc/factory.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/message.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/rpc/reply_interface.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+using namespace fmt::literals;
+
+// The connections to the target authenticate with their own credentials.
+const std::set<std::string> kSkippedCommands = {
+    "authenticate", "logout", "saslContinue", "saslStart"};
+
+long long percentile(const std::vector<long long>& sorted, double p) {
+    auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+/**
+ * Replays the requests of one recorded connection, in order, on a thread of its own.
+ */
+class ReplaySession {
+public:
+    ReplaySession(uint64_t id, const TrafficReplayOptions& options)
+        : _options(options), _thread([this, id] {
+              Client::initThread("TrafficReplay-{}"_format(id));
+              _run();
+          }) {}
+
+    void push(std::string command, Message message) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _queue.emplace_back(std::move(command), std::move(message));
+        _cv.notify_one();
+    }
+
+    /**
+     * Waits for the queued requests to be replayed.
+     */
+    void finish() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _finished = true;
+            _cv.notify_one();
+        }
+        _thread.join();
+    }
+
+    const TrafficReplayStats& stats() const {
+        return _stats;
+    }
+
+private:
+    void _run() {
+        std::unique_ptr<DBClientBase> conn;
+        while (true) {
+            std::pair<std::string, Message> request;
+            {
+                stdx::unique_lock<Latch> lk(_mutex);
+                _cv.wait(lk, [&] { return _finished || !_queue.empty(); });
+                if (_queue.empty()) {
+                    return;
+                }
+                request = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            auto& [command, message] = request;
+
+            if (!conn) {
+                try {
+                    conn = _options.connect();
+                } catch (const DBException& ex) {
+                    LOGV2_WARNING(6170429, "Failed to connect to the target", "error"_attr = ex);
+                    _stats.recordUnsent(command);
+                    continue;
+                }
+            }
+
+            Timer timer;
+            bool ok = true;
+            try {
+                if (OpMsg::isFlagSet(message, OpMsg::kMoreToCome)) {
+                    conn->say(message);
+                } else {
+                    Message response;
+                    conn->call(message, response);
+                    auto reply = rpc::makeReply(&response);
+                    ok = getStatusFromCommandResult(reply->getCommandReply()).isOK();
+                }
+            } catch (const DBException&) {
+                // Open a new connection for the next request.
+                ok = false;
+                conn.reset();
+            }
+            _stats.record(command, timer.elapsed(), ok);
+        }
+    }
+
+    const TrafficReplayOptions& _options;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ReplaySession::_mutex");
+    stdx::condition_variable _cv;
+    std::deque<std::pair<std::string, Message>> _queue;
+    bool _finished = false;
+
+    // Only accessed by the thread of the session until it is joined.
+    TrafficReplayStats _stats;
+
+    stdx::thread _thread;
+};
+
+/**
+ * Returns the request to replay for a recorded OP_MSG request.
+ */
+Message makeReplayRequest(const TrafficReaderPacket& packet, std::string* command) {
+    Message recorded;
+    recorded.setData(dbMsg, packet.message.data(), packet.message.dataLen());
+    // The header of the recorded message is not kept, so the checksum won't match.
+    OpMsg::removeChecksum(&recorded);
+
+    auto request = OpMsgRequest::parse(recorded);
+    *command = request.getCommandName().toString();
+    request.body = request.body.removeField("$clusterTime");
+
+    // Serializing drops the exhaustAllowed flag, so that every request gets a single response.
+    auto message = request.serialize();
+    if (OpMsg::isFlagSet(recorded, OpMsg::kMoreToCome)) {
+        OpMsg::setFlag(&message, OpMsg::kMoreToCome);
+    }
+    return message;
+}
+
+}  // namespace
+
+void TrafficReplayStats::record(StringData command, Microseconds latency, bool ok) {
+    auto& stats = _commands[command.toString()];
+    stats.latencyMicros.push_back(durationCount<Microseconds>(latency));
+    if (!ok) {
+        ++stats.errors;
+    }
+}
+
+void TrafficReplayStats::recordUnsent(StringData command) {
+    ++_commands[command.toString()].errors;
+}
+
+void TrafficReplayStats::merge(const TrafficReplayStats& other) {
+    for (const auto& [command, otherStats] : other._commands) {
+        auto& stats = _commands[command];
+        stats.latencyMicros.insert(stats.latencyMicros.end(),
+                                   otherStats.latencyMicros.begin(),
+                                   otherStats.latencyMicros.end());
+        stats.errors += otherStats.errors;
+    }
+}
+
+void TrafficReplayStats::append(BSONObjBuilder* builder) const {
+    for (const auto& [command, stats] : _commands) {
+        BSONObjBuilder commandBuilder(builder->subobjStart(command));
+        auto latencies = stats.latencyMicros;
+        commandBuilder.append("count", static_cast<long long>(latencies.size()));
+        commandBuilder.append("errors", stats.errors);
+        if (latencies.empty()) {
+            continue;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        long long total = 0;
+        for (auto latency : latencies) {
+            total += latency;
+        }
+        commandBuilder.append("meanMicros", total / static_cast<long long>(latencies.size()));
+        commandBuilder.append("minMicros", latencies.front());
+        commandBuilder.append("p50Micros", percentile(latencies, 0.5));
+        commandBuilder.append("p90Micros", percentile(latencies, 0.9));
+        commandBuilder.append("p99Micros", percentile(latencies, 0.99));
+        commandBuilder.append("maxMicros", latencies.back());
+    }
+}
+
+BSONObj replayTrafficRecording(int inputFd, const TrafficReplayOptions& options) {
+    uassert(ErrorCodes::BadValue, "The replay speed must be positive", options.speed > 0);
+
+    stdx::unordered_map<uint64_t, std::unique_ptr<ReplaySession>> sessions;
+    long long replayed = 0;
+    long long skipped = 0;
+    Microseconds maxLag{0};
+    boost::optional<Date_t> firstDate;
+    Timer timer;
+
+    auto buf = SharedBuffer::allocate(MaxMessageSizeBytes);
+    while (auto packet = readPacket(buf.get(), inputFd)) {
+        // Responses are recorded as well.
+        if (packet->message.getResponseToMsgId() != 0) {
+            continue;
+        }
+
+        std::string command;
+        Message message;
+        try {
+            uassert(ErrorCodes::UnsupportedFormat,
+                    "Only OP_MSG requests are replayed",
+                    packet->message.getNetworkOp() == dbMsg);
+            message = makeReplayRequest(*packet, &command);
+        } catch (const DBException&) {
+            ++skipped;
+            continue;
+        }
+        if (kSkippedCommands.count(command)) {
+            ++skipped;
+            continue;
+        }
+
+        if (!firstDate) {
+            firstDate = packet->date;
+            timer.reset();
+        }
+        auto scheduled = Microseconds(static_cast<long long>(
+            durationCount<Microseconds>(packet->date - *firstDate) / options.speed));
+        auto now = timer.elapsed();
+        if (now < scheduled) {
+            sleepFor(scheduled - now);
+        } else {
+            maxLag = std::max(maxLag, now - scheduled);
+        }
+
+        auto& session = sessions[packet->id];
+        if (!session) {
+            session = std::make_unique<ReplaySession>(packet->id, options);
+        }
+        session->push(std::move(command), std::move(message));
+        ++replayed;
+    }
+
+    TrafficReplayStats stats;
+    for (auto& [id, session] : sessions) {
+        session->finish();
+        stats.merge(session->stats());
+    }
+
+    BSONObjBuilder builder;
+    builder.append("durationMillis", durationCount<Milliseconds>(timer.elapsed()));
+    builder.append("connections", static_cast<long long>(sessions.size()));
+    builder.append("replayed", replayed);
+    builder.append("skipped", skipped);
+    builder.append("maxLagMillis", durationCount<Milliseconds>(maxLag));
+    {
+        BSONObjBuilder commandsBuilder(builder.subobjStart("commands"));
+        stats.append(&commandsBuilder);
+    }
+    return builder.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class DBClientBase;
+
+/**
+ * Latencies and errors of replayed commands, by command name.
+ */
+class TrafficReplayStats {
+public:
+    /**
+     * Records a command that was sent and took 'latency' to complete. A command is not 'ok' if
+     * it failed, or if the connection failed while it was running.
+     */
+    void record(StringData command, Microseconds latency, bool ok);
+
+    /**
+     * Records a command that could not be sent, because no connection could be opened.
+     */
+    void recordUnsent(StringData command);
+
+    void merge(const TrafficReplayStats& other);
+
+    /**
+     * Appends a subobject for each command with the number of replays and of errors, and the
+     * mean, minimum, maximum and 50th, 90th and 99th percentiles of the latencies.
+     */
+    void append(BSONObjBuilder* builder) const;
+
+private:
+    struct CommandStats {
+        std::vector<long long> latencyMicros;
+        long long errors = 0;
+    };
+
+    std::map<std::string, CommandStats> _commands;
+};
+
+struct TrafficReplayOptions {
+    // How many times faster than recorded to replay the requests. Must be positive.
+    double speed = 1.0;
+
+    // Opens a connection to the target. Called from the thread that replays each recorded
+    // connection.
+    std::function<std::unique_ptr<DBClientBase>()> connect;
+};
+
+/**
+ * Replays the requests of the traffic recording open as 'inputFd' against a target, see
+ * TrafficRecorder.
+ *
+ * Each recorded connection is replayed on its own connection to the target, by its own thread, so
+ * that requests of a connection are sent in order, and only once the previous one completed. Each
+ * request is sent at the time at which it was received in the recording, relative to the first,
+ * divided by the speed, unless its connection is still waiting on a previous request.
+ *
+ * Only OP_MSG requests are replayed. Authentication commands are skipped, since the connections
+ * to the target authenticate on their own, and gossiped cluster times are removed, since they are
+ * signed with the keys of the recorded cluster.
+ *
+ * Returns a report with the number of requests replayed and skipped, how late the requests were
+ * sent compared to their schedule at most, and the latencies of the replayed requests by command.
+ */
+BSONObj replayTrafficRecording(int inputFd, const TrafficReplayOptions& options);
+
+}  // namespace mongo
@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/traffic_replay.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj toBSON(const TrafficReplayStats& stats) {
+    BSONObjBuilder builder;
+    stats.append(&builder);
+    return builder.obj();
+}
+
+BSONObj latencies(long long count,
+                  long long errors,
+                  long long mean,
+                  long long min,
+                  long long p50,
+                  long long p90,
+                  long long p99,
+                  long long max) {
+    return BSON("count" << count << "errors" << errors << "meanMicros" << mean << "minMicros"
+                        << min << "p50Micros" << p50 << "p90Micros" << p90 << "p99Micros" << p99
+                        << "maxMicros" << max);
+}
+
+TEST(TrafficReplayStatsTest, ReportsLatencyPercentilesByCommand) {
+    TrafficReplayStats stats;
+    for (int i = 100; i >= 1; --i) {
+        stats.record("find", Microseconds(i), i != 50);
+    }
+    stats.record("insert", Microseconds(7), true);
+
+    ASSERT_BSONOBJ_EQ(toBSON(stats),
+                      BSON("find" << latencies(100, 1, 50, 1, 50, 90, 99, 100) << "insert"
+                                  << latencies(1, 0, 7, 7, 7, 7, 7, 7)));
+}
+
+TEST(TrafficReplayStatsTest, MergesStatsAndCountsUnsentCommands) {
+    TrafficReplayStats stats;
+    stats.record("find", Microseconds(10), true);
+
+    TrafficReplayStats other;
+    other.record("find", Microseconds(30), false);
+    other.recordUnsent("update");
+    stats.merge(other);
+
+    ASSERT_BSONOBJ_EQ(toBSON(stats),
+                      BSON("find" << latencies(2, 1, 20, 10, 10, 30, 30, 30) << "update"
+                                  << BSON("count" << 0LL << "errors" << 1LL)));
+}
+
+}  // namespace
+}  // namespace mongo
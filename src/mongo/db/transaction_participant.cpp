@@ -1356,7 +1356,9 @@ void TransactionParticipant::Participant::clearOperationsInMemory(OperationConte
               str::stream() << "Current state: " << o().txnState);
     invariant(p().autoCommit);
     p().transactionOperationBytes = 0;
-    p().transactionOperations.clear();
+    // Release the vector's storage as well, so that a session which once ran a large transaction
+    // does not keep its capacity allocated while idle.
+    std::vector<repl::ReplOperation>().swap(p().transactionOperations);
     p().numberOfPreImagesToWrite = 0;
 }
 
@@ -1365,7 +1367,10 @@ void TransactionParticipant::Participant::commitUnpreparedTransaction(OperationC
             "commitTransaction must provide commitTimestamp to prepared transaction.",
             !o().txnState.isPrepared());
 
-    auto txnOps = retrieveCompletedTransactionOperations(opCtx);
+    // Refer to the operations in place rather than copying them, since a large transaction would
+    // otherwise hold two copies of all of its operations for the duration of the commit. Nothing
+    // below reads 'txnOps' after clearOperationsInMemory().
+    auto& txnOps = retrieveCompletedTransactionOperations(opCtx);
     auto opObserver = opCtx->getServiceContext()->getOpObserver();
     invariant(opObserver);
 
@@ -1375,11 +1380,14 @@ void TransactionParticipant::Participant::commitUnpreparedTransaction(OperationC
     // committed. For local read concern this is to match majority read concern. For both local and
     // majority read concerns we do an untimestamped read, so we have no read timestamp to wait on.
     // Instead, we write a noop which is guaranteed to have a greater OpTime than any writes we
-    // read.
+    // read. The OpTime is only consulted when waiting for other nodes, so write concerns like
+    // {w: 1} or {w: 1, j: true} skip the noop, which would otherwise cost an oplog write per
+    // read-only transaction.
     //
     // TODO (SERVER-41165): Snapshot read concern should wait on the read timestamp instead.
     auto wc = opCtx->getWriteConcern();
-    auto needsNoopWrite = txnOps.empty() && !opCtx->getWriteConcern().usedDefaultConstructedWC;
+    auto needsNoopWrite =
+        txnOps.empty() && !wc.usedDefaultConstructedWC && wc.needToWaitForOtherNodes();
 
     const size_t operationCount = p().transactionOperations.size();
     const size_t oplogOperationBytes = p().transactionOperationBytes;
@@ -41,15 +41,17 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
-#include "mongo/db/exec/delete.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/insert.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/record_id_helpers.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/tenant_migration_access_blocker_registry.h"
 #include "mongo/db/service_context.h"
@@ -58,9 +60,11 @@
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/db/ttl_gen.h"
 #include "mongo/db/views/view_catalog.h"
+#include "mongo/db/worker_pool.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/log_with_sampling.h"
 
 namespace mongo {
@@ -76,13 +80,109 @@ const auto getTTLMonitor = ServiceContext::declareDecoration<std::unique_ptr<TTL
 MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
 
 Counter64 ttlPasses;
+Counter64 ttlSubPasses;
 Counter64 ttlDeletedDocuments;
 
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
+ServerStatusMetricField<Counter64> ttlSubPassesDisplay("ttl.subPasses", &ttlSubPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
 using MtabType = TenantMigrationAccessBlocker::BlockerType;
 
+namespace {
+
+/**
+ * Tracks how far the TTL monitor is from having deleted every expired document of each collection,
+ * which the "ttl" serverStatus section reports.
+ */
+class TTLCollectionProgress {
+public:
+    /**
+     * Records a sub-pass over one TTL index of a collection, which deleted 'numDeleted' documents
+     * and left expired documents behind if 'behind' is set.
+     */
+    void recordSubPass(const UUID& uuid,
+                       const NamespaceString& nss,
+                       StringData indexName,
+                       long long numDeleted,
+                       Milliseconds duration,
+                       bool behind) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& entry = _entries[uuid];
+        entry.ns = nss.ns();
+        entry.deletedDocuments += numDeleted;
+        entry.subPasses += 1;
+        entry.lastSubPassMillis = durationCount<Milliseconds>(duration);
+        entry.lastSubPassEnd = Date_t::now();
+        if (behind) {
+            entry.indexesBehind.insert(indexName.toString());
+        } else {
+            entry.indexesBehind.erase(indexName.toString());
+        }
+    }
+
+    /**
+     * Forgets the collections which no longer have TTL indexes.
+     */
+    void prune(const TTLCollectionCache::InfoMap& ttlInfos) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto it = _entries.begin(); it != _entries.end();) {
+            if (ttlInfos.find(it->first) == ttlInfos.end()) {
+                _entries.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void appendTo(BSONObjBuilder* builder) const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        BSONObjBuilder collections(builder->subobjStart("collections"));
+        for (const auto& [uuid, entry] : _entries) {
+            BSONObjBuilder collection(collections.subobjStart(entry.ns));
+            collection.append("deletedDocuments", entry.deletedDocuments);
+            collection.append("subPasses", entry.subPasses);
+            collection.append("lastSubPassMillis", entry.lastSubPassMillis);
+            collection.append("lastSubPassEnd", entry.lastSubPassEnd);
+            collection.append("caughtUp", entry.indexesBehind.empty());
+        }
+    }
+
+private:
+    struct Entry {
+        std::string ns;
+        long long deletedDocuments = 0;
+        long long subPasses = 0;
+        long long lastSubPassMillis = 0;
+        Date_t lastSubPassEnd;
+        // The TTL indexes whose last sub-pass ended before all expired documents were deleted.
+        std::set<std::string> indexesBehind;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("TTLCollectionProgress::_mutex");
+    stdx::unordered_map<UUID, Entry, UUID::Hash> _entries;
+};
+
+TTLCollectionProgress ttlCollectionProgress;
+
+class TTLServerStatusSection : public ServerStatusSection {
+public:
+    TTLServerStatusSection() : ServerStatusSection("ttl") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        ttlCollectionProgress.appendTo(&builder);
+        return builder.obj();
+    }
+} ttlServerStatusSection;
+
+}  // namespace
+
 class TTLMonitor : public BackgroundJob {
 public:
     explicit TTLMonitor() : BackgroundJob(false /* selfDelete */) {}
@@ -115,6 +215,19 @@ public:
             tc.get()->setSystemOperationKillableByStepdown(lk);
         }
 
+        // Runs the operations which delete expired documents alongside this thread.
+        ThreadPool::Options options;
+        options.poolName = "TTLMonitorWorkers";
+        options.threadNamePrefix = "TTLMonitorWorker";
+        options.minThreads = 0;
+        options.maxThreads = 64;
+        ThreadPool workers(options);
+        workers.startup();
+        ON_BLOCK_EXIT([&] {
+            workers.shutdown();
+            workers.join();
+        });
+
         while (true) {
             {
                 // Wait until either ttlMonitorSleepSecs passes or a shutdown is requested.
@@ -145,7 +258,7 @@ public:
             }
 
             try {
-                doTTLPass();
+                doTTLPass(&workers);
             } catch (const WriteConflictException&) {
                 LOGV2_DEBUG(22531, 1, "got WriteConflictException");
             } catch (const ExceptionForCat<ErrorCategory::Interruption>& interruption) {
@@ -172,13 +285,24 @@ public:
     }
 
 private:
+    /**
+     * A TTL index, or the clustered _id of a collection, to delete expired documents from.
+     */
+    struct TTLWork {
+        UUID uuid;
+        TTLCollectionCache::Info info;
+    };
+
     /**
      * Gets all TTL specifications for every collection and deletes expired documents.
      */
-    void doTTLPass() {
+    void doTTLPass(ThreadPool* workers) {
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
         OperationContext* opCtx = opCtxPtr.get();
 
+        // TTL deletions are background work, so let user operations have tickets first.
+        ScopedTicketPriority ticketPriority(opCtx, TicketHolder::Priority::kLow);
+
         // If part of replSet but not in a readable state (e.g. during initial sync), skip.
         if (repl::ReplicationCoordinator::get(opCtx)->getReplicationMode() ==
                 repl::ReplicationCoordinator::modeReplSet &&
@@ -187,62 +311,152 @@ private:
 
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         auto ttlInfos = ttlCollectionCache.getTTLInfos();
+        ttlCollectionProgress.prune(ttlInfos);
 
         // Increment the metric after the TTL work has been finished.
         ON_BLOCK_EXIT([&] { ttlPasses.increment(); });
 
-        // Perform a pass for every collection and index described as being TTL.
+        std::vector<TTLWork> work;
         for (const auto& [uuid, infos] : ttlInfos) {
             for (const auto& info : infos) {
-                // Skip collections that have not been made visible yet. The TTLCollectionCache
-                // already has the index information available, so we want to avoid removing it
-                // until the collection is visible.
-                auto collectionCatalog = CollectionCatalog::get(opCtx);
-                if (collectionCatalog->isCollectionAwaitingVisibility(uuid)) {
-                    continue;
-                }
+                work.push_back({uuid, info});
+            }
+        }
 
-                // The collection was dropped.
-                auto nss = collectionCatalog->lookupNSSByUUID(opCtx, uuid);
-                if (!nss) {
-                    ttlCollectionCache.deregisterTTLInfo(uuid, info);
-                    continue;
+        // Each sub-pass deletes expired documents from every TTL index for a bounded time, so that
+        // an index with a large backlog of expired documents does not hold up the others. The
+        // indexes which still have expired documents are visited again by the next sub-pass.
+        while (!work.empty()) {
+            {
+                stdx::lock_guard<Latch> lk(_stateMutex);
+                if (_shuttingDown) {
+                    return;
                 }
+            }
+            if (!ttlMonitorEnabled.load()) {
+                return;
+            }
 
-                try {
-                    deleteExpired(opCtx, &ttlCollectionCache, uuid, *nss, info);
-                } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
-                    LOGV2_WARNING(22537,
-                                  "TTLMonitor was interrupted, waiting before doing another pass",
-                                  "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+            ttlSubPasses.increment();
+            auto status = doTTLSubPass(opCtx, workers, &work);
+            if (ErrorCodes::isA<ErrorCategory::Interruption>(status.code())) {
+                LOGV2_WARNING(22537,
+                              "TTLMonitor was interrupted, waiting before doing another pass",
+                              "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+                return;
+            }
+            uassertStatusOK(status);
+        }
+    }
+
+    /**
+     * Deletes expired documents from each TTL index in 'work' until 'ttlMonitorSubPassTargetSecs'
+     * have passed, on up to 'ttlMonitorMaxConcurrency' operations at once. Leaves in 'work' the
+     * indexes which still have expired documents.
+     */
+    Status doTTLSubPass(OperationContext* opCtx, ThreadPool* workers, std::vector<TTLWork>* work) {
+        const auto deadline = Date_t::now() + Seconds(ttlMonitorSubPassTargetSecs.load());
+        std::vector<char> behind(work->size(), false);
+        AtomicWord<unsigned long long> nextWork{0};
+
+        // Deletes expired documents from the TTL indexes which no other operation has taken yet.
+        auto runWork = [&](OperationContext* workOpCtx) {
+            for (auto i = nextWork.fetchAndAdd(1); i < work->size(); i = nextWork.fetchAndAdd(1)) {
+                behind[i] = deleteExpired(workOpCtx, (*work)[i], deadline);
+            }
+        };
+
+        const auto numOperations =
+            std::min(work->size(), static_cast<size_t>(ttlMonitorMaxConcurrency.load()));
+        auto status = runTasksConcurrently(
+            workers,
+            "TTLMonitorWorker",
+            opCtx,
+            numOperations,
+            [&](OperationContext* workerOpCtx, size_t workerId) {
+                if (workerId == 0) {
+                    runWork(workerOpCtx);
                     return;
-                } catch (const DBException& ex) {
-                    LOGV2_ERROR(5400703,
-                                "Error running TTL job on collection",
-                                logAttrs(*nss),
-                                "error"_attr = ex);
-                    continue;
                 }
+
+                auto client = workerOpCtx->getClient();
+                {
+                    stdx::lock_guard<Client> lk(*client);
+                    client->setSystemOperationKillableByStepdown(lk);
+                }
+                AuthorizationSession::get(client)->grantInternalAuthorization(client);
+                ScopedTicketPriority ticketPriority(workerOpCtx, TicketHolder::Priority::kLow);
+                runWork(workerOpCtx);
+            });
+
+        if (!status.isOK()) {
+            return status;
+        }
+
+        std::vector<TTLWork> remaining;
+        for (size_t i = 0; i < work->size(); ++i) {
+            if (behind[i]) {
+                remaining.push_back(std::move((*work)[i]));
             }
         }
+        *work = std::move(remaining);
+        return Status::OK();
+    }
+
+    /**
+     * Deletes expired documents for one TTL index until 'deadline'. Returns true if expired
+     * documents are left. Errors other than interruptions are logged, and skip the index for the
+     * rest of the pass.
+     */
+    bool deleteExpired(OperationContext* opCtx, const TTLWork& work, Date_t deadline) {
+        TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
+
+        // Skip collections that have not been made visible yet. The TTLCollectionCache already has
+        // the index information available, so we want to avoid removing it until the collection is
+        // visible.
+        auto collectionCatalog = CollectionCatalog::get(opCtx);
+        if (collectionCatalog->isCollectionAwaitingVisibility(work.uuid)) {
+            return false;
+        }
+
+        // The collection was dropped.
+        auto nss = collectionCatalog->lookupNSSByUUID(opCtx, work.uuid);
+        if (!nss) {
+            ttlCollectionCache.deregisterTTLInfo(work.uuid, work.info);
+            return false;
+        }
+
+        try {
+            return deleteExpired(opCtx, &ttlCollectionCache, work.uuid, *nss, work.info, deadline);
+        } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+            throw;
+        } catch (const DBException& ex) {
+            LOGV2_ERROR(5400703,
+                        "Error running TTL job on collection",
+                        logAttrs(*nss),
+                        "error"_attr = ex);
+            return false;
+        }
     }
 
     /**
-     * Deletes expired data on the given collection with the provided information.
+     * Deletes expired data on the given collection with the provided information until 'deadline'.
+     * Returns true if expired documents are left.
      */
-    void deleteExpired(OperationContext* opCtx,
+    bool deleteExpired(OperationContext* opCtx,
                        TTLCollectionCache* ttlCollectionCache,
                        const UUID& uuid,
                        const NamespaceString& nss,
-                       const TTLCollectionCache::Info& info) {
+                       const TTLCollectionCache::Info& info,
+                       Date_t deadline) {
         if (nss.isTemporaryReshardingCollection()) {
             // For resharding, the donor shard primary is responsible for performing the TTL
             // deletions.
-            return;
+            return false;
         }
 
         if (nss.isDropPendingNamespace()) {
-            return;
+            return false;
         }
 
         uassertStatusOK(userAllowedWriteNS(opCtx, nss));
@@ -251,7 +465,7 @@ private:
         // The collection with `uuid` might be renamed before the lock and the wrong namespace would
         // be locked and looked up so we double check here.
         if (!coll || coll->uuid() != uuid)
-            return;
+            return false;
 
         // TTL indexes are not compatible with capped collections.
         invariant(!coll->isCapped());
@@ -264,7 +478,7 @@ private:
         }
 
         if (!repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss)) {
-            return;
+            return false;
         }
 
         std::shared_ptr<TenantMigrationAccessBlocker> mtab;
@@ -279,19 +493,21 @@ private:
                         "Postpone TTL of DB because of active tenant migration",
                         "tenantMigrationAccessBlocker"_attr = mtab->getDebugInfo().jsonString(),
                         "database"_attr = coll.getDb()->name());
-            return;
+            return false;
         }
 
         ResourceConsumption::ScopedMetricsCollector scopedMetrics(opCtx, nss.db().toString());
 
         const auto& collection = coll.getCollection();
-        stdx::visit(
+        return stdx::visit(
             visit_helper::Overloaded{
                 [&](const TTLCollectionCache::ClusteredId&) {
-                    deleteExpiredWithCollscan(opCtx, ttlCollectionCache, collection);
+                    return deleteExpiredWithCollscan(
+                        opCtx, ttlCollectionCache, collection, deadline);
                 },
                 [&](const TTLCollectionCache::IndexName& indexName) {
-                    deleteExpiredWithIndex(opCtx, ttlCollectionCache, collection, indexName);
+                    return deleteExpiredWithIndex(
+                        opCtx, ttlCollectionCache, collection, indexName, deadline);
                 }},
             info);
     }
@@ -317,27 +533,124 @@ private:
         return Date_t::now() - Seconds(expireAfterSeconds);
     }
 
+    /**
+     * Deletes the documents whose RecordIds 'exec' returns until it is exhausted or 'deadline'
+     * passes, skipping those which no longer match 'filter'. Each batch of up to
+     * 'ttlMonitorBatchedDeleteTargetDocs' documents is deleted in RecordId order in one
+     * WriteUnitOfWork, so that the storage engine and the indexes are written in key order.
+     * Returns true if it stopped at 'deadline'.
+     */
+    bool deleteInBatches(OperationContext* opCtx,
+                         const CollectionPtr& collection,
+                         PlanExecutor* exec,
+                         const MatchExpression* filter,
+                         Date_t deadline,
+                         long long* numDeleted) {
+        const auto& nss = collection->ns();
+        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+
+        // Every delete of a batch is timestamped with an OpTime reserved for it up front. The
+        // pre-image of a delete would be logged with an OpTime of its own after that, so the
+        // documents of collections which record pre-images are deleted one at a time, each logged
+        // with the OpTimes the OpObserver assigns.
+        const bool recordPreImages = collection->getRecordPreImages();
+        const bool reserveOpTimes = !recordPreImages && !replCoord->isOplogDisabledFor(opCtx, nss);
+        const size_t batchSize =
+            recordPreImages ? 1 : static_cast<size_t>(ttlMonitorBatchedDeleteTargetDocs.load());
+
+        std::vector<RecordId> batch;
+        batch.reserve(batchSize);
+        while (true) {
+            batch.clear();
+            RecordId rid;
+            bool exhausted = false;
+            while (batch.size() < batchSize) {
+                if (exec->getNext(static_cast<BSONObj*>(nullptr), &rid) !=
+                    PlanExecutor::ADVANCED) {
+                    exhausted = true;
+                    break;
+                }
+                batch.push_back(rid);
+            }
+
+            if (!batch.empty()) {
+                // The plan may have yielded, so check that this node is still primary.
+                uassert(ErrorCodes::PrimarySteppedDown,
+                        "Demoted from primary while removing expired documents",
+                        replCoord->canAcceptWritesFor(opCtx, nss));
+
+                std::sort(batch.begin(), batch.end());
+                exec->saveState();
+                writeConflictRetry(opCtx, "ttlBatchedDelete", nss.ns(), [&] {
+                    WriteUnitOfWork wuow(opCtx);
+                    std::vector<OplogSlot> oplogSlots;
+                    if (reserveOpTimes) {
+                        oplogSlots = repl::getNextOpTimes(opCtx, batch.size());
+                    }
+
+                    long long batchDeleted = 0;
+                    for (size_t i = 0; i < batch.size(); ++i) {
+                        // The document may have changed since the plan returned it.
+                        Snapshotted<BSONObj> doc;
+                        if (!collection->findDoc(opCtx, batch[i], &doc) ||
+                            (filter && !filter->matchesBSON(doc.value()))) {
+                            continue;
+                        }
+
+                        boost::optional<OplogSlot> oplogSlot;
+                        if (reserveOpTimes) {
+                            oplogSlot = oplogSlots[i];
+                            uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(
+                                oplogSlot->getTimestamp()));
+                        }
+                        collection->deleteDocument(opCtx,
+                                                   doc,
+                                                   kUninitializedStmtId,
+                                                   batch[i],
+                                                   nullptr /* opDebug */,
+                                                   false /* fromMigrate */,
+                                                   false /* noWarn */,
+                                                   Collection::StoreDeletedDoc::Off,
+                                                   oplogSlot);
+                        ++batchDeleted;
+                    }
+                    wuow.commit();
+                    *numDeleted += batchDeleted;
+                });
+                exec->restoreState(&collection);
+            }
+
+            if (exhausted) {
+                return false;
+            }
+            if (Date_t::now() >= deadline) {
+                return true;
+            }
+        }
+    }
+
     /**
      * Removes documents from the collection using the specified TTL index after a sufficient
      * amount of time has passed according to its expiry specification.
      */
-    void deleteExpiredWithIndex(OperationContext* opCtx,
+    bool deleteExpiredWithIndex(OperationContext* opCtx,
                                 TTLCollectionCache* ttlCollectionCache,
                                 const CollectionPtr& collection,
-                                std::string indexName) {
+                                std::string indexName,
+                                Date_t deadline) {
         if (!collection->isIndexPresent(indexName)) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(), indexName);
-            return;
+            return false;
         }
 
         BSONObj spec = collection->getIndexSpec(indexName);
         if (!spec.hasField(IndexDescriptor::kExpireAfterSecondsFieldName)) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(), indexName);
-            return;
+            return false;
         }
 
         if (!collection->isIndexReady(indexName)) {
-            return;
+            return false;
         }
 
         const BSONObj key = spec["key"].Obj();
@@ -346,7 +659,7 @@ private:
             LOGV2_ERROR(22540,
                         "key for ttl index can only have 1 field, skipping TTL job",
                         "index"_attr = spec);
-            return;
+            return false;
         }
 
         LOGV2_DEBUG(22533,
@@ -359,14 +672,14 @@ private:
         const IndexDescriptor* desc = collection->getIndexCatalog()->findIndexByName(opCtx, name);
         if (!desc) {
             LOGV2_DEBUG(22535, 1, "index not found; skipping ttl job", "index"_attr = spec);
-            return;
+            return false;
         }
 
         if (IndexType::INDEX_BTREE != IndexNames::nameToType(desc->getAccessMethodName())) {
             LOGV2_ERROR(22541,
                         "special index can't be used as a TTL index, skipping TTL job",
                         "index"_attr = spec);
-            return;
+            return false;
         }
 
         BSONElement secondsExpireElt = spec[IndexDescriptor::kExpireAfterSecondsFieldName];
@@ -376,7 +689,7 @@ private:
                         "field"_attr = IndexDescriptor::kExpireAfterSecondsFieldName,
                         "type"_attr = typeName(secondsExpireElt.type()),
                         "index"_attr = spec);
-            return;
+            return false;
         }
 
         const Date_t kDawnOfTime =
@@ -391,9 +704,9 @@ private:
             ? InternalPlanner::Direction::FORWARD
             : InternalPlanner::Direction::BACKWARD;
 
-        // We need to pass into the DeleteStageParams (below) a CanonicalQuery with a BSONObj that
-        // queries for the expired documents correctly so that we do not delete documents that are
-        // not actually expired when our snapshot changes during deletion.
+        // The documents are checked against a query for the expired documents before they are
+        // deleted, so that we do not delete documents that are not actually expired when our
+        // snapshot changes during deletion.
         const char* keyFieldName = key.firstElement().fieldName();
         BSONObj query =
             BSON(keyFieldName << BSON("$gte" << kDawnOfTime << "$lte" << expirationDate));
@@ -402,51 +715,56 @@ private:
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(findCommand));
         invariant(canonicalQuery.getStatus());
 
-        auto params = std::make_unique<DeleteStageParams>();
-        params->isMulti = true;
-        params->canonicalQuery = canonicalQuery.getValue().get();
-
         Timer timer;
-        auto exec =
-            InternalPlanner::deleteWithIndexScan(opCtx,
-                                                 &collection,
-                                                 std::move(params),
-                                                 desc,
-                                                 startKey,
-                                                 endKey,
-                                                 BoundInclusion::kIncludeBothStartAndEndKeys,
-                                                 PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
-                                                 direction);
-
+        auto exec = InternalPlanner::indexScan(opCtx,
+                                               &collection,
+                                               desc,
+                                               startKey,
+                                               endKey,
+                                               BoundInclusion::kIncludeBothStartAndEndKeys,
+                                               PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                               direction);
+
+        long long numDeleted = 0;
+        bool behind = false;
         try {
-            const auto numDeleted = exec->executeDelete();
-            ttlDeletedDocuments.increment(numDeleted);
-
-            const auto duration = Milliseconds(timer.millis());
-            if (shouldLogSlowOpWithSampling(opCtx,
-                                            logv2::LogComponent::kIndex,
-                                            duration,
-                                            Milliseconds(serverGlobalParams.slowMS))
-                    .first) {
-                LOGV2(5479200,
-                      "Deleted expired documents using index",
-                      logAttrs(collection->ns()),
-                      "index"_attr = name,
-                      "numDeleted"_attr = numDeleted,
-                      "duration"_attr = duration);
-            }
+            behind = deleteInBatches(opCtx,
+                                     collection,
+                                     exec.get(),
+                                     canonicalQuery.getValue()->root(),
+                                     deadline,
+                                     &numDeleted);
         } catch (const ExceptionFor<ErrorCodes::QueryPlanKilled>&) {
             // It is expected that a collection drop can kill a query plan while the TTL monitor
             // is deleting an old document, so ignore this error.
         }
+        ttlDeletedDocuments.increment(numDeleted);
+
+        const auto duration = Milliseconds(timer.millis());
+        ttlCollectionProgress.recordSubPass(
+            collection->uuid(), collection->ns(), name, numDeleted, duration, behind);
+        if (shouldLogSlowOpWithSampling(opCtx,
+                                        logv2::LogComponent::kIndex,
+                                        duration,
+                                        Milliseconds(serverGlobalParams.slowMS))
+                .first) {
+            LOGV2(5479200,
+                  "Deleted expired documents using index",
+                  logAttrs(collection->ns()),
+                  "index"_attr = name,
+                  "numDeleted"_attr = numDeleted,
+                  "duration"_attr = duration);
+        }
+        return behind;
     }
 
     /*
      * Removes expired documents from a collection clustered by _id using a bounded collection scan.
      */
-    void deleteExpiredWithCollscan(OperationContext* opCtx,
+    bool deleteExpiredWithCollscan(OperationContext* opCtx,
                                    TTLCollectionCache* ttlCollectionCache,
-                                   const CollectionPtr& collection) {
+                                   const CollectionPtr& collection,
+                                   Date_t deadline) {
         const auto& collOptions = collection->getCollectionOptions();
         uassert(5400701,
                 "collection is not clustered by _id but is described as being TTL",
@@ -457,7 +775,7 @@ private:
         if (!expireAfterSeconds) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(),
                                                   TTLCollectionCache::ClusteredId{});
-            return;
+            return false;
         }
 
         LOGV2_DEBUG(5400704,
@@ -474,41 +792,43 @@ private:
 
         const auto endId = record_id_helpers::keyForOID(endOID);
 
-        auto params = std::make_unique<DeleteStageParams>();
-        params->isMulti = true;
-
         // Deletes records using a bounded collection scan from the beginning of time to the
         // expiration time (inclusive).
         Timer timer;
-        auto exec =
-            InternalPlanner::deleteWithCollectionScan(opCtx,
-                                                      &collection,
-                                                      std::move(params),
-                                                      PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
-                                                      InternalPlanner::Direction::FORWARD,
-                                                      boost::none /* minRecord */,
-                                                      endId);
-
+        auto exec = InternalPlanner::collectionScan(opCtx,
+                                                    &collection,
+                                                    PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                                    InternalPlanner::Direction::FORWARD,
+                                                    boost::none /* resumeAfterRecordId */,
+                                                    boost::none /* minRecord */,
+                                                    endId);
+
+        long long numDeleted = 0;
+        bool behind = false;
         try {
-            const auto numDeleted = exec->executeDelete();
-            ttlDeletedDocuments.increment(numDeleted);
-
-            const auto duration = Milliseconds(timer.millis());
-            if (shouldLogSlowOpWithSampling(opCtx,
-                                            logv2::LogComponent::kIndex,
-                                            duration,
-                                            Milliseconds(serverGlobalParams.slowMS))
-                    .first) {
-                LOGV2(5400702,
-                      "Deleted expired documents using collection scan",
-                      logAttrs(collection->ns()),
-                      "numDeleted"_attr = numDeleted,
-                      "duration"_attr = duration);
-            }
+            behind = deleteInBatches(
+                opCtx, collection, exec.get(), nullptr /* filter */, deadline, &numDeleted);
         } catch (const ExceptionFor<ErrorCodes::QueryPlanKilled>&) {
             // It is expected that a collection drop can kill a query plan while the TTL monitor
             // is deleting an old document, so ignore this error.
         }
+        ttlDeletedDocuments.increment(numDeleted);
+
+        const auto duration = Milliseconds(timer.millis());
+        ttlCollectionProgress.recordSubPass(
+            collection->uuid(), collection->ns(), "_id"_sd, numDeleted, duration, behind);
+        if (shouldLogSlowOpWithSampling(opCtx,
+                                        logv2::LogComponent::kIndex,
+                                        duration,
+                                        Milliseconds(serverGlobalParams.slowMS))
+                .first) {
+            LOGV2(5400702,
+                  "Deleted expired documents using collection scan",
+                  logAttrs(collection->ns()),
+                  "numDeleted"_attr = numDeleted,
+                  "duration"_attr = duration);
+        }
+        return behind;
     }
 
     // Protects the state below.
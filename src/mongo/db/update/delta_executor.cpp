@@ -32,13 +32,207 @@
 #include "mongo/db/update/delta_executor.h"
 
 #include "mongo/bson/mutable/document.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/update/object_replace_executor.h"
+#include "mongo/db/update/storage_validation.h"
 #include "mongo/db/update/update_oplog_entry_serialization.h"
+#include "mongo/stdx/variant.h"
+#include "mongo/util/visit_helper.h"
 
 namespace mongo {
+namespace {
+
+// Counts how $v:2 deltas were applied: as in-place value replacements on the pre-image, or by
+// materializing a new post-image document.
+Counter64 deltasAppliedInPlace;
+Counter64 deltasRematerialized;
+ServerStatusMetricField<Counter64> displayDeltasAppliedInPlace("repl.apply.deltas.inPlace",
+                                                               &deltasAppliedInPlace);
+ServerStatusMetricField<Counter64> displayDeltasRematerialized("repl.apply.deltas.rematerialized",
+                                                               &deltasRematerialized);
+
+// A value in the pre-image which the diff overwrites with a new value of the same size.
+struct ValueReplacement {
+    mutablebson::Element target;
+    BSONElement newValue;
+};
+
+/**
+ * Collects the changes 'reader' makes to 'element' into 'out', provided the diff does nothing
+ * but replace existing values with values of the same size. Such a diff leaves the layout of the
+ * document untouched, so it can be applied without building a new post-image. Returns false as
+ * soon as the diff deletes, inserts, or resizes anything, or otherwise depends on the fix-ups
+ * applyDiff() performs when re-applying an entry.
+ */
+bool collectSameSizeReplacements(mutablebson::Element element,
+                                 doc_diff::DocumentDiffReader* reader,
+                                 FieldRef* path,
+                                 const UpdateIndexData* indexData,
+                                 bool* indexesAffected,
+                                 std::vector<ValueReplacement>* out);
+
+bool collectSameSizeReplacement(mutablebson::Element target,
+                                const BSONElement& newValue,
+                                FieldRef* path,
+                                const UpdateIndexData* indexData,
+                                bool* indexesAffected,
+                                std::vector<ValueReplacement>* out) {
+    if (!target.ok() || !target.hasValue() ||
+        target.getValue().valuesize() != newValue.valuesize()) {
+        return false;
+    }
+    if (indexData && !*indexesAffected) {
+        *indexesAffected = indexData->mightBeIndexed(*path);
+    }
+    out->push_back({target, newValue});
+    return true;
+}
+
+bool collectSameSizeReplacementsInArray(mutablebson::Element element,
+                                        doc_diff::ArrayDiffReader* reader,
+                                        FieldRef* path,
+                                        const UpdateIndexData* indexData,
+                                        bool* indexesAffected,
+                                        std::vector<ValueReplacement>* out) {
+    if (const auto newSize = reader->newSize(); newSize && *newSize != element.countChildren()) {
+        return false;
+    }
+
+    for (auto mod = reader->next(); mod; mod = reader->next()) {
+        auto target = element.findNthChild(mod->first);
+        auto idxAsStr = std::to_string(mod->first);
+        FieldRef::FieldRefTempAppend tempAppend(*path, idxAsStr);
+
+        const bool collected = stdx::visit(
+            visit_helper::Overloaded{
+                [&](const BSONElement& update) {
+                    return collectSameSizeReplacement(
+                        target, update, path, indexData, indexesAffected, out);
+                },
+                [&](doc_diff::DocumentDiffReader subReader) {
+                    return target.ok() && target.getType() == BSONType::Object &&
+                        collectSameSizeReplacements(
+                               target, &subReader, path, indexData, indexesAffected, out);
+                },
+                [&](doc_diff::ArrayDiffReader subReader) {
+                    return target.ok() && target.getType() == BSONType::Array &&
+                        collectSameSizeReplacementsInArray(
+                               target, &subReader, path, indexData, indexesAffected, out);
+                },
+            },
+            mod->second);
+        if (!collected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool collectSameSizeReplacements(mutablebson::Element element,
+                                 doc_diff::DocumentDiffReader* reader,
+                                 FieldRef* path,
+                                 const UpdateIndexData* indexData,
+                                 bool* indexesAffected,
+                                 std::vector<ValueReplacement>* out) {
+    if (reader->nextDelete() || reader->nextInsert()) {
+        return false;
+    }
+
+    for (auto update = reader->nextUpdate(); update; update = reader->nextUpdate()) {
+        FieldRef::FieldRefTempAppend tempAppend(*path, update->fieldNameStringData());
+        if (!collectSameSizeReplacement(element[update->fieldNameStringData()],
+                                        *update,
+                                        path,
+                                        indexData,
+                                        indexesAffected,
+                                        out)) {
+            return false;
+        }
+    }
+
+    for (auto subDiff = reader->nextSubDiff(); subDiff; subDiff = reader->nextSubDiff()) {
+        auto target = element[subDiff->first];
+        FieldRef::FieldRefTempAppend tempAppend(*path, subDiff->first);
+
+        const bool collected = stdx::visit(
+            visit_helper::Overloaded{
+                [&](doc_diff::DocumentDiffReader subReader) {
+                    return target.ok() && target.getType() == BSONType::Object &&
+                        collectSameSizeReplacements(
+                               target, &subReader, path, indexData, indexesAffected, out);
+                },
+                [&](doc_diff::ArrayDiffReader subReader) {
+                    return target.ok() && target.getType() == BSONType::Array &&
+                        collectSameSizeReplacementsInArray(
+                               target, &subReader, path, indexData, indexesAffected, out);
+                },
+            },
+            subDiff->second);
+        if (!collected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+boost::optional<DeltaExecutor::ApplyResult> DeltaExecutor::_tryApplyInPlace(
+    const ApplyParams& applyParams) const {
+    auto& doc = applyParams.element.getDocument();
+    if (doc.getCurrentInPlaceMode() != mutablebson::Document::kInPlaceEnabled ||
+        !applyParams.immutablePaths.empty()) {
+        return boost::none;
+    }
+
+    doc_diff::DocumentDiffReader reader(_diff);
+    std::vector<ValueReplacement> replacements;
+    FieldRef path;
+    bool indexesAffected = false;
+    if (!collectSameSizeReplacements(applyParams.element,
+                                     &reader,
+                                     &path,
+                                     applyParams.indexData,
+                                     &indexesAffected,
+                                     &replacements)) {
+        return boost::none;
+    }
+
+    bool modified = false;
+    for (auto&& replacement : replacements) {
+        const auto oldValue = replacement.target.getValue();
+        if (oldValue.type() == replacement.newValue.type() &&
+            oldValue.binaryEqualValues(replacement.newValue)) {
+            continue;
+        }
+        // Same-size replacements of serialized values are recorded as damages against the
+        // pre-image rather than forcing the document to be rebuilt.
+        uassertStatusOK(replacement.target.setValueBSONElement(replacement.newValue));
+        modified = true;
+    }
+    if (!modified) {
+        return ApplyResult::noopResult();
+    }
+
+    ApplyResult result;
+    storage_validation::storageValid(doc,
+                                     false /* allowTopLevelDollarPrefixes */,
+                                     applyParams.validateForStorage,
+                                     &result.containsDotsAndDollarsField);
+    result.indexesAffected = indexesAffected;
+    result.oplogEntry = _outputOplogEntry;
+    return result;
+}
 
 DeltaExecutor::ApplyResult DeltaExecutor::applyUpdate(
     UpdateExecutor::ApplyParams applyParams) const {
+    if (auto result = _tryApplyInPlace(applyParams)) {
+        deltasAppliedInPlace.increment();
+        return *result;
+    }
+    deltasRematerialized.increment();
+
     const auto originalDoc = applyParams.element.getDocument().getObject();
 
     auto applyDiffOutput = doc_diff::applyDiff(
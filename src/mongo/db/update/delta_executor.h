@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/update/update_executor.h"
 
 #include "mongo/db/update/document_diff_applier.h"
@@ -60,6 +62,14 @@ public:
     }
 
 private:
+    /**
+     * Applies the diff directly to the elements of 'applyParams.element' when it only replaces
+     * existing values with values of the same size, which lets the caller write the change as
+     * damages rather than as a whole new document. Returns boost::none, without modifying the
+     * document, when the diff changes the layout of the document and needs a full post-image.
+     */
+    boost::optional<ApplyResult> _tryApplyInPlace(const ApplyParams& applyParams) const;
+
     doc_diff::Diff _diff;
 
     // Although the delta executor is only used for applying $v:2 oplog entries on secondaries, it
@@ -384,5 +384,69 @@ TEST(DeltaExecutorTest, ArraysAfterIndexPath) {
     }
 }
 
+TEST(DeltaExecutorTest, SameSizeReplacementsAreAppliedInPlace) {
+    BSONObj preImage(fromjson("{f1: {a: {b: [1, 2], c: 1}}, f2: 'abc'}"));
+    UpdateIndexData indexData;
+    constexpr bool mustCheckExistenceForInsertOperations = true;
+    indexData.addPath(FieldRef("f1.a.b"));
+    FieldRefSet fieldRefSet;
+    {
+        // Replacing values without changing their size produces damages.
+        mutablebson::Document doc(preImage, mutablebson::Document::kInPlaceEnabled);
+        UpdateExecutor::ApplyParams params(doc.root(), fieldRefSet);
+        params.indexData = &indexData;
+        DeltaExecutor test(fromjson("{u: {f2: 'xyz'}, sf1: {sa: {u: {c: 5}}}}"),
+                           mustCheckExistenceForInsertOperations);
+        auto result = test.applyUpdate(params);
+        ASSERT_BSONOBJ_BINARY_EQ(doc.getObject(),
+                                 fromjson("{f1: {a: {b: [1, 2], c: 5}}, f2: 'xyz'}"));
+        ASSERT(!result.noop);
+        ASSERT(!result.indexesAffected);
+
+        mutablebson::DamageVector damages;
+        const char* source = nullptr;
+        ASSERT(doc.getInPlaceUpdates(&damages, &source));
+        ASSERT_FALSE(damages.empty());
+    }
+    {
+        // Replacing an indexed array element in place still reports the index as affected.
+        mutablebson::Document doc(preImage, mutablebson::Document::kInPlaceEnabled);
+        UpdateExecutor::ApplyParams params(doc.root(), fieldRefSet);
+        params.indexData = &indexData;
+        DeltaExecutor test(fromjson("{sf1: {sa: {sb: {a: true, u1: 3}}}}"),
+                           mustCheckExistenceForInsertOperations);
+        auto result = test.applyUpdate(params);
+        ASSERT_BSONOBJ_BINARY_EQ(doc.getObject(),
+                                 fromjson("{f1: {a: {b: [1, 3], c: 1}}, f2: 'abc'}"));
+        ASSERT(result.indexesAffected);
+
+        mutablebson::DamageVector damages;
+        const char* source = nullptr;
+        ASSERT(doc.getInPlaceUpdates(&damages, &source));
+    }
+    {
+        // Rewriting a value with its current contents is a no-op.
+        mutablebson::Document doc(preImage, mutablebson::Document::kInPlaceEnabled);
+        UpdateExecutor::ApplyParams params(doc.root(), fieldRefSet);
+        DeltaExecutor test(fromjson("{u: {f2: 'abc'}}"), mustCheckExistenceForInsertOperations);
+        auto result = test.applyUpdate(params);
+        ASSERT(result.noop);
+    }
+    {
+        // Changing the size of a value falls back to materializing the post image.
+        mutablebson::Document doc(preImage, mutablebson::Document::kInPlaceEnabled);
+        UpdateExecutor::ApplyParams params(doc.root(), fieldRefSet);
+        DeltaExecutor test(fromjson("{u: {f2: 'abcd'}, i: {f3: 1}}"),
+                           mustCheckExistenceForInsertOperations);
+        test.applyUpdate(params);
+        ASSERT_BSONOBJ_BINARY_EQ(doc.getObject(),
+                                 fromjson("{f1: {a: {b: [1, 2], c: 1}}, f2: 'abcd', f3: 1}"));
+
+        mutablebson::DamageVector damages;
+        const char* source = nullptr;
+        ASSERT_FALSE(doc.getInPlaceUpdates(&damages, &source));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -33,7 +33,7 @@
 
 #include "mongo/bson/mutable/document.h"
 #include "mongo/db/bson/dotted_path_support.h"
-#include "mongo/db/pipeline/document_source_queue.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/pipeline/variable_validation.h"
 #include "mongo/db/query/query_feature_flags_gen.h"
@@ -85,18 +85,24 @@ PipelineExecutor::PipelineExecutor(const boost::intrusive_ptr<ExpressionContext>
         invariant(stageConstraints.requiredPosition ==
                   StageConstraints::PositionRequirement::kNone);
         invariant(!stageConstraints.isIndependentOfAnyCollection);
-    }
 
-    _pipeline->addInitialSource(DocumentSourceQueue::create(expCtx));
+        // Only stages which transform one document into another are allowed within an update.
+        auto transformation =
+            dynamic_cast<DocumentSourceSingleDocumentTransformation*>(stage.get());
+        invariant(transformation);
+        _transformers.push_back(&transformation->getTransformer());
+    }
 }
 
 UpdateExecutor::ApplyResult PipelineExecutor::applyUpdate(ApplyParams applyParams) const {
     const auto originalDoc = applyParams.element.getDocument().getObject();
 
-    DocumentSourceQueue* queueStage = static_cast<DocumentSourceQueue*>(_pipeline->peekFront());
-    queueStage->emplace_back(Document{originalDoc});
+    Document doc{originalDoc};
+    for (auto&& transformer : _transformers) {
+        doc = transformer->applyTransformation(doc);
+    }
 
-    const auto transformedDoc = _pipeline->getNext()->toBson();
+    const auto transformedDoc = doc.toBson();
     const auto transformedDocHasIdField = transformedDoc.hasField(kIdFieldName);
 
     // Replace the pre-image document in applyParams with the post image we got from running the
@@ -140,15 +146,6 @@ UpdateExecutor::ApplyResult PipelineExecutor::applyUpdate(ApplyParams applyParam
 Value PipelineExecutor::serialize() const {
     std::vector<Value> valueArray;
     for (const auto& stage : _pipeline->getSources()) {
-        // The queue stage we add to adapt the pull-based '_pipeline' to our use case should not
-        // be serialized out. Firstly, this was not part of the user's pipeline and is just an
-        // implementation detail. It wouldn't have much value in exposing. Secondly, supporting
-        // a serialization that we can later re-parse is non trivial. See the comment in
-        // DocumentSourceQueue for more details.
-        if (typeid(*stage) == typeid(DocumentSourceQueue)) {
-            continue;
-        }
-
         stage->serializeToArray(valueArray);
     }
 
@@ -37,6 +37,7 @@
 
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/pipeline/transformer_interface.h"
 #include "mongo/db/update/update_executor.h"
 
 namespace mongo {
@@ -67,6 +68,10 @@ public:
 private:
     boost::intrusive_ptr<ExpressionContext> _expCtx;
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
+
+    // The transformations of the stages of '_pipeline', in order. Every document is updated by
+    // applying them directly, rather than by pulling it through '_pipeline'.
+    std::vector<TransformerInterface*> _transformers;
 };
 
 }  // namespace mongo
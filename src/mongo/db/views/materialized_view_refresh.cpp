@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_refresh.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Returns the expression operator which combines two final values of the accumulator 'name', or
+ * boost::none if its final values cannot be combined.
+ */
+boost::optional<StringData> getCombiningOperator(StringData name) {
+    if (name == AccumulatorSum::kName) {
+        return "$add"_sd;
+    } else if (name == AccumulatorMin::kName) {
+        return "$min"_sd;
+    } else if (name == AccumulatorMax::kName) {
+        return "$max"_sd;
+    } else if (name == AccumulatorAddToSet::kName) {
+        return "$setUnion"_sd;
+    } else if (name == AccumulatorPush::kName) {
+        return "$concatArrays"_sd;
+    }
+    return boost::none;
+}
+
+/**
+ * Builds the 'whenMatched' pipeline of the $merge which combines the results of a refresh, in
+ * '$$new', with those stored in the backing collection.
+ */
+BSONArray makeCombiningPipeline(const DocumentSourceGroup& group) {
+    BSONObjBuilder setBuilder;
+    for (auto&& accumulatedField : group.getAccumulatedFields()) {
+        auto combiningOperator = getCombiningOperator(accumulatedField.expr.name);
+        uassert(5899703,
+                str::stream() << "Accumulator " << accumulatedField.expr.name << " of field '"
+                              << accumulatedField.fieldName
+                              << "' cannot be maintained incrementally",
+                combiningOperator);
+        setBuilder.append(accumulatedField.fieldName,
+                          BSON(*combiningOperator << BSON_ARRAY("$" + accumulatedField.fieldName
+                                                                << "$$new." +
+                                                                    accumulatedField.fieldName)));
+    }
+    return BSON_ARRAY(BSON("$set" << setBuilder.obj()));
+}
+
+}  // namespace
+
+std::vector<BSONObj> makeMaterializedViewRefreshPipeline(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const std::vector<BSONObj>& viewPipeline,
+    const NamespaceString& backingNss,
+    const MaterializedViewRefreshBounds& bounds) {
+    uassert(5899704,
+            "The upper bound of a materialized view refresh must not be missing",
+            !bounds.upperBound.missing());
+
+    std::vector<BSONObj> refreshPipeline;
+    refreshPipeline.reserve(viewPipeline.size() + 2);
+
+    // Only the new documents of the source collection are folded into the view.
+    BSONObjBuilder boundsBuilder;
+    {
+        BSONObjBuilder watermarkBuilder(boundsBuilder.subobjStart(bounds.watermarkField));
+        if (bounds.lowerBound) {
+            bounds.lowerBound->addToBsonObj(&watermarkBuilder, "$gt");
+        }
+        bounds.upperBound.addToBsonObj(&watermarkBuilder, "$lte");
+    }
+    refreshPipeline.push_back(BSON("$match" << boundsBuilder.obj()));
+
+    boost::optional<BSONArray> combiningPipeline;
+    for (auto&& stage : viewPipeline) {
+        uassert(5899700,
+                str::stream() << "Stage " << stage.firstElementFieldNameStringData()
+                              << " must be the last stage of an incrementally maintained view",
+                !combiningPipeline);
+
+        auto sources = DocumentSource::parse(expCtx, stage);
+        const auto& source = sources.front();
+        if (sources.size() == 1) {
+            if (auto group = dynamic_cast<DocumentSourceGroup*>(source.get())) {
+                combiningPipeline = makeCombiningPipeline(*group);
+            }
+        }
+        uassert(5899701,
+                str::stream() << "Stage " << stage.firstElementFieldNameStringData()
+                              << " is not supported by incrementally maintained views",
+                sources.size() == 1 &&
+                    (combiningPipeline || dynamic_cast<DocumentSourceMatch*>(source.get()) ||
+                     dynamic_cast<DocumentSourceSingleDocumentTransformation*>(source.get())));
+
+        refreshPipeline.push_back(stage.getOwned());
+    }
+    uassert(5899702, "An incrementally maintained view must end with a $group", combiningPipeline);
+
+    refreshPipeline.push_back(BSON(
+        "$merge" << BSON("into" << BSON("db" << backingNss.db() << "coll" << backingNss.coll())
+                                << "on"
+                                << "_id"
+                                << "whenMatched" << *combiningPipeline << "whenNotMatched"
+                                << "insert")));
+    return refreshPipeline;
+}
+
+}  // namespace mongo
@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/expression_context.h"
+
+namespace mongo {
+
+/**
+ * The documents of the source collection of a materialized view which a refresh folds into the
+ * view: those whose 'watermarkField' is greater than 'lowerBound', if there is one, and at most
+ * 'upperBound'. The field must only ever increase for newly inserted documents, like an insertion
+ * timestamp or an ObjectId, so that successive refreshes see every document exactly once.
+ */
+struct MaterializedViewRefreshBounds {
+    std::string watermarkField;
+    boost::optional<Value> lowerBound;
+    Value upperBound;
+};
+
+/**
+ * Returns the pipeline which incrementally refreshes a materialized view whose results are stored
+ * in 'backingNss'. When run against the source collection of the view, the pipeline computes the
+ * view's results over the documents within 'bounds' only, and combines them with the results
+ * already stored in the backing collection through a $merge.
+ *
+ * This requires that 'viewPipeline' consists of any number of $match and single document
+ * transformation stages (such as $project or $set), followed by a $group whose accumulators can be
+ * combined from their final values: $sum, $min, $max, $addToSet and $push. Throws if that is not
+ * the case. Removing or updating documents of the source collection is not reflected by a refresh,
+ * the view has to be recomputed from scratch instead. Run by the refreshMaterializedView command.
+ */
+std::vector<BSONObj> makeMaterializedViewRefreshPipeline(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const std::vector<BSONObj>& viewPipeline,
+    const NamespaceString& backingNss,
+    const MaterializedViewRefreshBounds& bounds);
+
+}  // namespace mongo
@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/views/materialized_view_refresh.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString backingNss("testdb.dailyTotals");
+
+std::vector<BSONObj> makeRefreshPipeline(const std::vector<BSONObj>& viewPipeline,
+                                         MaterializedViewRefreshBounds bounds = {
+                                             "ts", Value(10), Value(20)}) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    return makeMaterializedViewRefreshPipeline(expCtx, viewPipeline, backingNss, bounds);
+}
+
+void assertPipelineEq(const std::vector<BSONObj>& expected, const std::vector<BSONObj>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(expected[i], actual[i]);
+    }
+}
+
+TEST(MaterializedViewRefreshTest, FoldsNewDocumentsIntoBackingCollection) {
+    auto refreshPipeline = makeRefreshPipeline(
+        {fromjson("{$match: {status: 'A'}}"),
+         fromjson("{$project: {day: {$dateTrunc: {date: '$date', unit: 'day'}}, amount: 1}}"),
+         fromjson("{$group: {_id: '$day', total: {$sum: '$amount'}, orders: {$count: {}}, "
+                  "largest: {$max: '$amount'}, smallest: {$min: '$amount'}, "
+                  "amounts: {$push: '$amount'}, distinctAmounts: {$addToSet: '$amount'}}}")});
+
+    assertPipelineEq(
+        {fromjson("{$match: {ts: {$gt: 10, $lte: 20}}}"),
+         fromjson("{$match: {status: 'A'}}"),
+         fromjson("{$project: {day: {$dateTrunc: {date: '$date', unit: 'day'}}, amount: 1}}"),
+         fromjson("{$group: {_id: '$day', total: {$sum: '$amount'}, orders: {$count: {}}, "
+                  "largest: {$max: '$amount'}, smallest: {$min: '$amount'}, "
+                  "amounts: {$push: '$amount'}, distinctAmounts: {$addToSet: '$amount'}}}"),
+         fromjson("{$merge: {into: {db: 'testdb', coll: 'dailyTotals'}, on: '_id', whenMatched: "
+                  "[{$set: {total: {$add: ['$total', '$$new.total']}, "
+                  "orders: {$add: ['$orders', '$$new.orders']}, "
+                  "largest: {$max: ['$largest', '$$new.largest']}, "
+                  "smallest: {$min: ['$smallest', '$$new.smallest']}, "
+                  "amounts: {$concatArrays: ['$amounts', '$$new.amounts']}, "
+                  "distinctAmounts: {$setUnion: ['$distinctAmounts', '$$new.distinctAmounts']}}}], "
+                  "whenNotMatched: 'insert'}}")},
+        refreshPipeline);
+}
+
+TEST(MaterializedViewRefreshTest, FirstRefreshHasNoLowerBound) {
+    auto refreshPipeline = makeRefreshPipeline({fromjson("{$group: {_id: '$k'}}")},
+                                               {"ts", boost::none, Value(20)});
+    assertPipelineEq({fromjson("{$match: {ts: {$lte: 20}}}"),
+                      fromjson("{$group: {_id: '$k'}}"),
+                      fromjson("{$merge: {into: {db: 'testdb', coll: 'dailyTotals'}, on: '_id', "
+                               "whenMatched: [{$set: {}}], whenNotMatched: 'insert'}}")},
+                     refreshPipeline);
+}
+
+TEST(MaterializedViewRefreshTest, RejectsAccumulatorsWhichCannotBeCombined) {
+    ASSERT_THROWS_CODE(
+        makeRefreshPipeline({fromjson("{$group: {_id: '$k', avg: {$avg: '$x'}}}")}),
+        AssertionException,
+        5899703);
+    ASSERT_THROWS_CODE(
+        makeRefreshPipeline({fromjson("{$group: {_id: '$k', first: {$first: '$x'}}}")}),
+        AssertionException,
+        5899703);
+}
+
+TEST(MaterializedViewRefreshTest, RejectsUnsupportedPipelines) {
+    // The pipeline must end with a $group.
+    ASSERT_THROWS_CODE(
+        makeRefreshPipeline({fromjson("{$match: {x: 1}}")}), AssertionException, 5899702);
+    ASSERT_THROWS_CODE(makeRefreshPipeline({fromjson("{$group: {_id: '$k'}}"),
+                                            fromjson("{$match: {_id: 1}}")}),
+                       AssertionException,
+                       5899700);
+
+    // Only $match and single document transformations may precede the $group.
+    ASSERT_THROWS_CODE(makeRefreshPipeline({fromjson("{$sort: {x: 1}}"),
+                                            fromjson("{$group: {_id: '$k'}}")}),
+                       AssertionException,
+                       5899701);
+    ASSERT_THROWS_CODE(makeRefreshPipeline({fromjson("{$unwind: '$x'}"),
+                                            fromjson("{$group: {_id: '$k'}}")}),
+                       AssertionException,
+                       5899701);
+
+    ASSERT_THROWS_CODE(makeRefreshPipeline({fromjson("{$group: {_id: '$k'}}")},
+                                           {"ts", Value(10), Value()}),
+                       AssertionException,
+                       5899704);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,259 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/worker_pool.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/static_immortal.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Keeps track of the worker operations of one runTasksConcurrently() call, so that they can be
+ * interrupted together once one of the tasks fails.
+ */
+class WorkerOperations {
+public:
+    /**
+     * Registers 'opCtx' to be interrupted by killAll(). Returns false if killAll() was already
+     * called, in which case the worker must not run.
+     */
+    bool add(OperationContext* opCtx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_killed) {
+            return false;
+        }
+        _opCtxs.push_back(opCtx);
+        return true;
+    }
+
+    void remove(OperationContext* opCtx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _opCtxs.erase(std::remove(_opCtxs.begin(), _opCtxs.end(), opCtx), _opCtxs.end());
+    }
+
+    /**
+     * Interrupts all registered operations. The caller reports its own error, so the operations
+     * are always killed with ErrorCodes::Interrupted, which unlike other error codes is valid for
+     * any kill.
+     */
+    void killAll() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _killed = true;
+        for (auto opCtx : _opCtxs) {
+            stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(clientLock, opCtx, ErrorCodes::Interrupted);
+        }
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("WorkerOperations::_mutex");
+    std::vector<OperationContext*> _opCtxs;
+    bool _killed = false;
+};
+
+struct WorkerPoolSpec {
+    std::string name;
+    size_t maxThreads;
+};
+
+// The pools declared during static initialization, indexed by WorkerPool id.
+std::vector<WorkerPoolSpec>& declaredPools() {
+    static StaticImmortal<std::vector<WorkerPoolSpec>> pools;
+    return *pools;
+}
+
+struct WorkerPools {
+    Mutex mutex = MONGO_MAKE_LATCH("WorkerPools::mutex");
+    std::vector<std::unique_ptr<ThreadPool>> pools;
+    bool shutDown = false;
+};
+
+const auto getWorkerPools = ServiceContext::declareDecoration<WorkerPools>();
+
+ServiceContext::ConstructorActionRegisterer workerPoolsRegisterer{
+    "WorkerPools",
+    [](ServiceContext* serviceContext) {
+        auto& workerPools = getWorkerPools(serviceContext);
+        for (auto&& spec : declaredPools()) {
+            ThreadPool::Options options;
+            options.poolName = spec.name + "ThreadPool";
+            options.threadNamePrefix = spec.name;
+            options.minThreads = 0;
+            options.maxThreads = spec.maxThreads;
+            workerPools.pools.push_back(std::make_unique<ThreadPool>(options));
+            workerPools.pools.back()->startup();
+        }
+    },
+    [](ServiceContext* serviceContext) { shutdownWorkerPools(serviceContext); }};
+
+}  // namespace
+
+Status runTasksConcurrently(ThreadPool* pool,
+                            StringData clientName,
+                            OperationContext* opCtx,
+                            size_t numTasks,
+                            const std::function<void(OperationContext*, size_t)>& task) {
+    WorkerOperations workerOperations;
+    std::vector<Future<void>> workerResults;
+    for (size_t taskId = 1; taskId < numTasks; ++taskId) {
+        auto pf = makePromiseFuture<void>();
+        pool->schedule([&,
+                        taskId,
+                        serviceContext = opCtx->getServiceContext(),
+                        promise = std::move(pf.promise)](auto status) mutable {
+            if (!status.isOK()) {
+                promise.setError(status);
+                return;
+            }
+
+            // The operation and client are destroyed before the promise is fulfilled, since the
+            // caller's state may not be used after that.
+            Status result = [&]() -> Status {
+                auto client = serviceContext->makeClient(clientName.toString());
+                AlternativeClientRegion acr(client);
+                auto workerOpCtx = cc().makeOperationContext();
+                if (!workerOperations.add(workerOpCtx.get())) {
+                    return Status(ErrorCodes::Interrupted,
+                                  str::stream() << clientName << " was interrupted");
+                }
+                ON_BLOCK_EXIT([&] { workerOperations.remove(workerOpCtx.get()); });
+
+                try {
+                    task(workerOpCtx.get(), taskId);
+                    return Status::OK();
+                } catch (...) {
+                    return exceptionToStatus();
+                }
+            }();
+            promise.setFrom(std::move(result));
+        });
+        workerResults.push_back(std::move(pf.future));
+    }
+
+    Status status = Status::OK();
+    if (numTasks > 0) {
+        try {
+            task(opCtx, 0);
+        } catch (...) {
+            status = exceptionToStatus();
+        }
+    }
+
+    // Interrupting 'opCtx' while waiting, or any task failing, interrupts the other workers.
+    for (auto&& result : workerResults) {
+        if (status.isOK()) {
+            if (auto waitStatus = result.waitNoThrow(opCtx); !waitStatus.isOK()) {
+                status = waitStatus;
+            }
+        }
+        if (!status.isOK()) {
+            workerOperations.killAll();
+        }
+        if (auto workerStatus = result.getNoThrow(); !workerStatus.isOK() && status.isOK()) {
+            status = workerStatus;
+            workerOperations.killAll();
+        }
+    }
+    return status;
+}
+
+WorkerPool::WorkerPool(std::string name, size_t maxThreads)
+    : _clientName(name + "Worker"), _id(declaredPools().size()) {
+    declaredPools().push_back({std::move(name), maxThreads});
+}
+
+Status WorkerPool::runTasks(OperationContext* opCtx,
+                            size_t numTasks,
+                            const std::function<void(OperationContext*, size_t)>& task) const {
+    return runTasksConcurrently(
+        _getPool(opCtx->getServiceContext()), _clientName, opCtx, numTasks, task);
+}
+
+void WorkerPool::schedule(ServiceContext* serviceContext,
+                          unique_function<void(OperationContext*)> task) const {
+    _getPool(serviceContext)
+        ->schedule([serviceContext, clientName = _clientName, task = std::move(task)](
+                       auto status) mutable {
+            if (!status.isOK()) {
+                return;
+            }
+
+            try {
+                auto client = serviceContext->makeClient(clientName);
+                AlternativeClientRegion acr(client);
+                auto opCtx = cc().makeOperationContext();
+                task(opCtx.get());
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(6170460,
+                            2,
+                            "Worker task failed",
+                            "client"_attr = clientName,
+                            "error"_attr = redact(ex.toStatus()));
+            }
+        });
+}
+
+ThreadPool* WorkerPool::_getPool(ServiceContext* serviceContext) const {
+    return getWorkerPools(serviceContext).pools[_id].get();
+}
+
+void shutdownWorkerPools(ServiceContext* serviceContext) {
+    auto& workerPools = getWorkerPools(serviceContext);
+    stdx::lock_guard<Latch> lk(workerPools.mutex);
+    if (workerPools.shutDown) {
+        return;
+    }
+    workerPools.shutDown = true;
+    for (auto&& pool : workerPools.pools) {
+        pool->shutdown();
+    }
+    for (auto&& pool : workerPools.pools) {
+        pool->join();
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/util/functional.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+class ThreadPool;
+
+/**
+ * Runs 'task(opCtx, taskId)' for every 'taskId' in [0, numTasks). Task 0 runs on this thread with
+ * 'opCtx', the others on 'pool', each with its own Client named 'clientName' and its own
+ * OperationContext. Tasks with a nonzero 'taskId' run on a worker operation, which they may set up
+ * from 'opCtx' before doing their work.
+ *
+ * The tasks usually refer to the caller's state, so this waits for all of them even if one fails.
+ * The first error, including an interruption of 'opCtx', interrupts the remaining worker operations
+ * and is returned.
+ */
+Status runTasksConcurrently(ThreadPool* pool,
+                            StringData clientName,
+                            OperationContext* opCtx,
+                            size_t numTasks,
+                            const std::function<void(OperationContext*, size_t)>& task);
+
+/**
+ * A pool of threads on which operations run parts of their work concurrently. Pools are declared
+ * at namespace scope, during static initialization:
+ *
+ *     const WorkerPool facetWorkers("Facet", 64);
+ *
+ * Every ServiceContext then has its own threads for each declared pool. They are started with the
+ * ServiceContext, and shut down by shutdownWorkerPools() or, at the latest, when the ServiceContext
+ * is destroyed.
+ */
+class WorkerPool {
+public:
+    WorkerPool(std::string name, size_t maxThreads);
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Runs 'numTasks' tasks through runTasksConcurrently() on the threads of this pool.
+     */
+    Status runTasks(OperationContext* opCtx,
+                    size_t numTasks,
+                    const std::function<void(OperationContext*, size_t)>& task) const;
+
+    /**
+     * Runs 'task' on a thread of this pool, with its own Client and OperationContext, and returns
+     * without waiting for it. Errors thrown by 'task' are logged and otherwise ignored. If the pool
+     * has already been shut down, 'task' is destroyed without running.
+     */
+    void schedule(ServiceContext* serviceContext,
+                  unique_function<void(OperationContext*)> task) const;
+
+private:
+    ThreadPool* _getPool(ServiceContext* serviceContext) const;
+
+    const std::string _clientName;
+    const size_t _id;
+};
+
+/**
+ * Shuts down every WorkerPool of 'serviceContext' and waits for their threads to finish. Work
+ * scheduled afterwards fails with ShutdownInProgress. Safe to call multiple times.
+ */
+void shutdownWorkerPools(ServiceContext* serviceContext);
+
+}  // namespace mongo
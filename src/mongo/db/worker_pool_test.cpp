@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/db/client.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/db/worker_pool.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const WorkerPool testWorkers("WorkerPoolTest", 4);
+
+using WorkerPoolTest = ServiceContextTest;
+
+TEST_F(WorkerPoolTest, RunsEveryTaskAndTheFirstOnTheCallingOperation) {
+    auto opCtx = makeOperationContext();
+    std::vector<OperationContext*> opCtxs(4, nullptr);
+    ASSERT_OK(testWorkers.runTasks(
+        opCtx.get(), opCtxs.size(), [&](OperationContext* taskOpCtx, size_t taskId) {
+            opCtxs[taskId] = taskOpCtx;
+        }));
+
+    ASSERT_EQ(opCtxs[0], opCtx.get());
+    for (size_t taskId = 1; taskId < opCtxs.size(); ++taskId) {
+        ASSERT(opCtxs[taskId]);
+        ASSERT_NE(opCtxs[taskId], opCtx.get());
+    }
+}
+
+TEST_F(WorkerPoolTest, ReturnsTheErrorOfAFailedTask) {
+    auto opCtx = makeOperationContext();
+    AtomicWord<int> numRun{0};
+    auto status = testWorkers.runTasks(opCtx.get(), 3, [&](OperationContext*, size_t taskId) {
+        numRun.fetchAndAdd(1);
+        uassert(ErrorCodes::InternalError, "task failed", taskId != 2);
+    });
+    ASSERT_EQ(status, ErrorCodes::InternalError);
+    ASSERT_EQ(numRun.load(), 3);
+}
+
+TEST_F(WorkerPoolTest, TasksFailAfterShutdown) {
+    shutdownWorkerPools(getServiceContext());
+    shutdownWorkerPools(getServiceContext());
+
+    auto opCtx = makeOperationContext();
+    auto status = testWorkers.runTasks(opCtx.get(), 2, [](OperationContext*, size_t) {});
+    ASSERT_EQ(status, ErrorCodes::ShutdownInProgress);
+}
+
+}  // namespace
+}  // namespace mongo
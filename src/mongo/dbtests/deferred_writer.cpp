@@ -334,6 +334,32 @@ public:
     }
 };
 
+/**
+ * Test that documents buffered together are still written when one of them cannot be inserted.
+ */
+class DeferredWriterTestBatchWithFailure : public DeferredWriterTestBase {
+public:
+    void run(void) {
+        int nDocs = 100;
+        ensureEmpty();
+        {
+            auto gw = getWriter();
+            auto writer = gw.get();
+
+            // Buffer everything, so that the worker writes it as a single batch.
+            Lock::GlobalWrite lock(_opCtx.get());
+            auto duplicate = getObj();
+            ASSERT(writer->insertDocument(duplicate));
+            for (int i = 1; i < nDocs; ++i) {
+                ASSERT(writer->insertDocument(getObj()));
+            }
+            // Fails with a duplicate key error when written.
+            ASSERT(writer->insertDocument(duplicate));
+        }
+        ASSERT_EQ((size_t)nDocs, readCollection().size());
+    }
+};
+
 /**
  * Test that the inserts are sometimes actually executed without flushing.
  */
@@ -380,6 +406,7 @@ public:
         add<DeferredWriterTestConsistent>();
         add<DeferredWriterTestNoDeadlock>();
         add<DeferredWriterTestCap>();
+        add<DeferredWriterTestBatchWithFailure>();
         add<DeferredWriterTestAsync>();
     }
 };
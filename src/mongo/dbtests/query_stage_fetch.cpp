@@ -46,7 +46,9 @@
 #include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace QueryStageFetch {
 
@@ -226,6 +228,66 @@ public:
     }
 };
 
+//
+// Test that reading ahead of the fetched documents returns them in the order of the child.
+//
+class FetchStageReadAhead : public QueryStageFetchBase {
+public:
+    void run() {
+        RAIIServerParameterControllerForTest controller{"internalQueryFetchReadAheadWindowSize",
+                                                        4};
+
+        const int numDocs = 10;
+        for (int i = 0; i < numDocs; ++i) {
+            insert(BSON("foo" << i));
+        }
+
+        AutoGetCollectionForReadCommand ctx(&_opCtx, nss());
+        const CollectionPtr& coll = ctx.getCollection();
+        ASSERT(coll);
+
+        // Queue the records in reverse order, so that the order of the results is not that of
+        // the RecordIds.
+        std::vector<RecordId> recordIds;
+        auto cursor = coll->getCursor(&_opCtx);
+        while (auto record = cursor->next()) {
+            recordIds.push_back(record->id);
+        }
+        ASSERT_EQUALS(size_t(numDocs), recordIds.size());
+
+        WorkingSet ws;
+        auto mockStage = std::make_unique<QueuedDataStage>(_expCtx.get(), &ws);
+        for (auto it = recordIds.rbegin(); it != recordIds.rend(); ++it) {
+            WorkingSetID id = ws.allocate();
+            ws.get(id)->recordId = *it;
+            ws.transitionToRecordIdAndIdx(id);
+            mockStage->pushBack(id);
+        }
+
+        auto fetchStage =
+            std::make_unique<FetchStage>(_expCtx.get(), &ws, std::move(mockStage), nullptr, coll);
+
+        std::vector<RecordId> results;
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        PlanStage::StageState state;
+        while ((state = fetchStage->work(&id)) != PlanStage::IS_EOF) {
+            ASSERT_NOT_EQUALS(PlanStage::NEED_YIELD, state);
+            if (PlanStage::ADVANCED != state) {
+                continue;
+            }
+
+            WorkingSetMember* member = ws.get(id);
+            ASSERT_TRUE(member->hasObj());
+            ASSERT_EQUALS(numDocs - 1 - static_cast<int>(results.size()),
+                          member->doc.value()["foo"].getInt());
+            results.push_back(member->recordId);
+            ws.free(id);
+        }
+        ASSERT_EQUALS(size_t(numDocs), results.size());
+        ASSERT(std::equal(results.begin(), results.end(), recordIds.rbegin()));
+    }
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_fetch") {}
@@ -233,6 +295,7 @@ public:
     void setupTests() {
         add<FetchStageAlreadyFetched>();
         add<FetchStageFilter>();
+        add<FetchStageReadAhead>();
     }
 };
 
@@ -3573,8 +3573,15 @@ public:
             auto record = cursor->next();
             invariant(record);
             WriteUnitOfWork wuow(_opCtx);
-            const auto statusWith = collection->updateDocumentWithDamages(
-                _opCtx, record->id, std::move(recordSnapshot), source, damages, &args);
+            const bool indexesAffected = false;
+            const auto statusWith = collection->updateDocumentWithDamages(_opCtx,
+                                                                          record->id,
+                                                                          std::move(recordSnapshot),
+                                                                          source,
+                                                                          damages,
+                                                                          indexesAffected,
+                                                                          nullptr /* opDebug */,
+                                                                          &args);
             wuow.commit();
             ASSERT_OK(statusWith.getStatus());
         }
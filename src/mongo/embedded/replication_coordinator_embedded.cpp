@@ -470,6 +470,12 @@ void ReplicationCoordinatorEmbedded::denylistSyncSource(const HostAndPort&, Date
     UASSERT_NOT_IMPLEMENTED;
 }
 
+void ReplicationCoordinatorEmbedded::recordSyncSourceFetchStats(const HostAndPort&,
+                                                                std::size_t,
+                                                                Milliseconds) {
+    UASSERT_NOT_IMPLEMENTED;
+}
+
 void ReplicationCoordinatorEmbedded::resetLastOpTimesFromOplog(OperationContext*) {
     UASSERT_NOT_IMPLEMENTED;
 }
@@ -247,6 +247,8 @@ public:
 
     void denylistSyncSource(const HostAndPort&, Date_t) override;
 
+    void recordSyncSourceFetchStats(const HostAndPort&, std::size_t, Milliseconds) override;
+
     void resetLastOpTimesFromOplog(OperationContext*) override;
 
     repl::ChangeSyncSourceAction shouldChangeSyncSource(const HostAndPort&,
@@ -36,6 +36,8 @@
 namespace mongo {
 namespace executor {
 
+using namespace fmt::literals;
+
 ConnectionStatsPer::ConnectionStatsPer(size_t nInUse,
                                        size_t nAvailable,
                                        size_t nCreated,
@@ -53,6 +55,16 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     return *this;
 }
 
+SendBatchStats& SendBatchStats::operator+=(const SendBatchStats& other) {
+    batches += other.batches;
+    requests += other.requests;
+    for (size_t i = 0; i < durationMicrosBuckets.size(); ++i) {
+        durationMicrosBuckets[i] += other.durationMicrosBuckets[i];
+    }
+
+    return *this;
+}
+
 void ConnectionPoolStats::updateStatsForHost(std::string pool,
                                              HostAndPort host,
                                              ConnectionStatsPer newStats) {
@@ -101,6 +113,23 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
     {
         if (strategy) {
             result.append("replicaSetMatchingStrategy", matchingStrategyToString(*strategy));
+            result.appendNumber("totalTargetGrowthLimited",
+                                static_cast<long long>(totalTargetGrowthLimited));
+        }
+
+        {
+            BSONObjBuilder batchBuilder(result.subobjStart("sendBatches"));
+            batchBuilder.appendNumber("batches", static_cast<long long>(sendBatches.batches));
+            batchBuilder.appendNumber("requests", static_cast<long long>(sendBatches.requests));
+
+            BSONObjBuilder durationBuilder(batchBuilder.subobjStart("durationMicros"));
+            const auto& bounds = SendBatchStats::kDurationMicrosBounds;
+            for (size_t i = 0; i < sendBatches.durationMicrosBuckets.size(); ++i) {
+                auto key = i < bounds.size() ? "lt{}"_format(bounds[i])
+                                             : "gte{}"_format(bounds.back());
+                durationBuilder.appendNumber(
+                    key, static_cast<long long>(sendBatches.durationMicrosBuckets[i]));
+            }
         }
 
         BSONObjBuilder poolBuilder(result.subobjStart("pools"));
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/s/sharding_task_executor_pool_controller.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/net/hostandport.h"
@@ -53,6 +55,21 @@ struct ConnectionStatsPer {
     size_t refreshing = 0u;
 };
 
+/**
+ * Counts the batches of requests that a NetworkInterfaceTL sent from a single reactor task, and
+ * buckets them by how long sending the whole batch took.
+ */
+struct SendBatchStats {
+    // Upper bounds, in microseconds, of all but the last duration bucket.
+    static constexpr std::array<long long, 3> kDurationMicrosBounds{100, 1000, 10000};
+
+    SendBatchStats& operator+=(const SendBatchStats& other);
+
+    size_t batches = 0u;
+    size_t requests = 0u;
+    std::array<size_t, kDurationMicrosBounds.size() + 1> durationMicrosBuckets{};
+};
+
 /**
  * Aggregates connection information for the connPoolStats command. Connection pools should
  * use the updateStatsForHost() method to append their host-specific information to this object.
@@ -67,6 +84,8 @@ struct ConnectionPoolStats {
     size_t totalAvailable = 0u;
     size_t totalCreated = 0u;
     size_t totalRefreshing = 0u;
+    size_t totalTargetGrowthLimited = 0u;
+    SendBatchStats sendBatches;
     boost::optional<ShardingTaskExecutorPoolController::MatchingStrategy> strategy;
 
     using StatsByHost = std::map<HostAndPort, ConnectionStatsPer>;
@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/executor/host_latency_tracker.h"
+
+#include <algorithm>
+
+#include "mongo/util/static_immortal.h"
+
+namespace mongo {
+namespace executor {
+
+HostLatencyTracker& HostLatencyTracker::get() {
+    static StaticImmortal<HostLatencyTracker> tracker;
+    return *tracker;
+}
+
+std::shared_ptr<HostLatencyTracker::HostStats> HostLatencyTracker::_getStats(
+    const HostAndPort& host) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& stats = _hosts[host];
+    if (!stats) {
+        stats = std::make_shared<HostStats>();
+    }
+    return stats;
+}
+
+void HostLatencyTracker::onRequestStarted(const HostAndPort& host) {
+    _getStats(host)->inFlight.addAndFetch(1);
+}
+
+void HostLatencyTracker::onRequestFinished(const HostAndPort& host,
+                                           boost::optional<Milliseconds> latency,
+                                           Date_t now) {
+    auto stats = _getStats(host);
+    stats->inFlight.subtractAndFetch(1);
+    if (!latency) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(stats->mutex);
+    stats->samples[stats->nextSample] = {now, *latency};
+    stats->nextSample = (stats->nextSample + 1) % kMaxSamples;
+    stats->numSamples = std::min(stats->numSamples + 1, kMaxSamples);
+}
+
+HostLatencyTracker::HostLoad HostLatencyTracker::getLoad(const HostAndPort& host,
+                                                         int percentile,
+                                                         Date_t now) const {
+    invariant(percentile >= 0 && percentile <= 100);
+    auto stats = _getStats(host);
+
+    HostLoad load;
+    load.inFlight = std::max(stats->inFlight.load(), 0);
+
+    std::array<Milliseconds, kMaxSamples> latencies;
+    size_t numLatencies = 0;
+    {
+        stdx::lock_guard<Latch> lk(stats->mutex);
+        for (size_t i = 0; i < stats->numSamples; ++i) {
+            if (stats->samples[i].when + kSampleExpiration > now) {
+                latencies[numLatencies++] = stats->samples[i].latency;
+            }
+        }
+    }
+
+    if (numLatencies > 0) {
+        auto nth = latencies.begin() + (numLatencies - 1) * percentile / 100;
+        std::nth_element(latencies.begin(), nth, latencies.begin() + numLatencies);
+        load.latency = *nth;
+    }
+    return load;
+}
+
+const HostAndPort& HostLatencyTracker::selectHost(const std::vector<HostAndPort>& candidates,
+                                                  int percentile,
+                                                  Date_t now,
+                                                  PseudoRandom& random) const {
+    invariant(!candidates.empty());
+    if (candidates.size() == 1) {
+        return candidates.front();
+    }
+
+    auto first = random.nextInt64(candidates.size());
+    auto second = random.nextInt64(candidates.size() - 1);
+    if (second >= first) {
+        ++second;
+    }
+
+    auto cost = [&](const HostAndPort& host) -> boost::optional<long long> {
+        auto load = getLoad(host, percentile, now);
+        if (!load.latency) {
+            return boost::none;
+        }
+        // Count a fast host as taking at least a millisecond, so that its commands in flight still
+        // weigh against it.
+        return std::max(durationCount<Milliseconds>(*load.latency), 1LL) * (load.inFlight + 1);
+    };
+
+    auto firstCost = cost(candidates[first]);
+    auto secondCost = cost(candidates[second]);
+    if (!firstCost) {
+        return candidates[first];
+    }
+    if (!secondCost) {
+        return candidates[second];
+    }
+    return *secondCost < *firstCost ? candidates[second] : candidates[first];
+}
+
+}  // namespace executor
+}  // namespace mongo
@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/net/hostandport.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace executor {
+
+/**
+ * Process-wide record of the latency of recent commands sent to each remote host, and of the number
+ * of commands currently in flight to it. Unlike the hello round trip time used by the replica set
+ * monitors, this reflects how long a host takes to serve operations while under load, which makes
+ * it suitable for choosing among hosts that are otherwise equally eligible.
+ *
+ * This class is thread-safe.
+ */
+class HostLatencyTracker {
+    HostLatencyTracker(const HostLatencyTracker&) = delete;
+    HostLatencyTracker& operator=(const HostLatencyTracker&) = delete;
+
+public:
+    // The number of most recent latencies kept for each host.
+    static constexpr size_t kMaxSamples = 64;
+
+    // Latencies older than this are ignored, so that a host which was avoided because it was slow
+    // is eventually tried again.
+    static constexpr Seconds kSampleExpiration{30};
+
+    struct HostLoad {
+        // The requested percentile of the unexpired latencies, or none if there are none.
+        boost::optional<Milliseconds> latency;
+        int inFlight = 0;
+    };
+
+    HostLatencyTracker() = default;
+
+    static HostLatencyTracker& get();
+
+    /**
+     * Called when a command is sent to 'host'. Every call must be followed by a call to
+     * onRequestFinished() for the same host.
+     */
+    void onRequestStarted(const HostAndPort& host);
+
+    /**
+     * Called when a command sent to 'host' completes. 'latency' is how long the command took, or
+     * none if it failed without a response, in which case it only stops counting as in flight.
+     */
+    void onRequestFinished(const HostAndPort& host,
+                           boost::optional<Milliseconds> latency,
+                           Date_t now);
+
+    /**
+     * Returns the 'percentile' latency of the commands 'host' completed recently, and the number of
+     * commands in flight to it.
+     */
+    HostLoad getLoad(const HostAndPort& host, int percentile, Date_t now) const;
+
+    /**
+     * Picks one of 'candidates' by the power of two choices: two distinct candidates are drawn at
+     * random and the one whose 'percentile' latency multiplied by its number of commands in flight
+     * plus one is lower wins. A candidate with no recent latency is preferred, so that it is
+     * probed. 'candidates' must not be empty.
+     */
+    const HostAndPort& selectHost(const std::vector<HostAndPort>& candidates,
+                                  int percentile,
+                                  Date_t now,
+                                  PseudoRandom& random) const;
+
+private:
+    struct Sample {
+        Date_t when;
+        Milliseconds latency;
+    };
+
+    struct HostStats {
+        AtomicWord<int> inFlight{0};
+
+        Mutex mutex = MONGO_MAKE_LATCH("HostLatencyTracker::HostStats::mutex");
+        std::array<Sample, kMaxSamples> samples;
+        size_t numSamples = 0;
+        size_t nextSample = 0;
+    };
+
+    std::shared_ptr<HostStats> _getStats(const HostAndPort& host) const;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("HostLatencyTracker::_mutex");
+    mutable stdx::unordered_map<HostAndPort, std::shared_ptr<HostStats>> _hosts;
+};
+
+}  // namespace executor
+}  // namespace mongo
@@ -0,0 +1,139 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/executor/host_latency_tracker.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace executor {
+namespace {
+
+const HostAndPort kFast("fast", 27017);
+const HostAndPort kSlow("slow", 27017);
+
+void recordLatencies(HostLatencyTracker& tracker,
+                     const HostAndPort& host,
+                     Milliseconds latency,
+                     int count,
+                     Date_t now) {
+    for (int i = 0; i < count; ++i) {
+        tracker.onRequestStarted(host);
+        tracker.onRequestFinished(host, latency, now);
+    }
+}
+
+TEST(HostLatencyTrackerTest, ReportsPercentileOfRecentLatencies) {
+    HostLatencyTracker tracker;
+    const auto now = Date_t::fromMillisSinceEpoch(100000);
+    for (int i = 1; i <= 10; ++i) {
+        tracker.onRequestStarted(kFast);
+        tracker.onRequestFinished(kFast, Milliseconds(i), now);
+    }
+
+    ASSERT_EQ(*tracker.getLoad(kFast, 0, now).latency, Milliseconds(1));
+    ASSERT_EQ(*tracker.getLoad(kFast, 50, now).latency, Milliseconds(5));
+    ASSERT_EQ(*tracker.getLoad(kFast, 100, now).latency, Milliseconds(10));
+    ASSERT_EQ(tracker.getLoad(kFast, 50, now).inFlight, 0);
+    ASSERT_FALSE(tracker.getLoad(kSlow, 50, now).latency);
+}
+
+TEST(HostLatencyTrackerTest, KeepsOnlyMostRecentSamples) {
+    HostLatencyTracker tracker;
+    const auto now = Date_t::fromMillisSinceEpoch(100000);
+    recordLatencies(tracker, kFast, Milliseconds(100), HostLatencyTracker::kMaxSamples, now);
+    recordLatencies(tracker, kFast, Milliseconds(1), HostLatencyTracker::kMaxSamples, now);
+    ASSERT_EQ(*tracker.getLoad(kFast, 100, now).latency, Milliseconds(1));
+}
+
+TEST(HostLatencyTrackerTest, IgnoresExpiredSamples) {
+    HostLatencyTracker tracker;
+    const auto now = Date_t::fromMillisSinceEpoch(100000);
+    recordLatencies(tracker, kSlow, Milliseconds(100), 5, now);
+    ASSERT_TRUE(tracker.getLoad(kSlow, 50, now).latency);
+    ASSERT_FALSE(
+        tracker.getLoad(kSlow, 50, now + HostLatencyTracker::kSampleExpiration).latency);
+}
+
+TEST(HostLatencyTrackerTest, CountsRequestsInFlight) {
+    HostLatencyTracker tracker;
+    const auto now = Date_t::fromMillisSinceEpoch(100000);
+    tracker.onRequestStarted(kFast);
+    tracker.onRequestStarted(kFast);
+    ASSERT_EQ(tracker.getLoad(kFast, 50, now).inFlight, 2);
+
+    // A request which failed without a response is no longer in flight, but has no latency.
+    tracker.onRequestFinished(kFast, boost::none, now);
+    ASSERT_EQ(tracker.getLoad(kFast, 50, now).inFlight, 1);
+    ASSERT_FALSE(tracker.getLoad(kFast, 50, now).latency);
+}
+
+TEST(HostLatencyTrackerTest, SelectsHostWithLowerLatency) {
+    HostLatencyTracker tracker;
+    PseudoRandom random(1);
+    const auto now = Date_t::fromMillisSinceEpoch(100000);
+    recordLatencies(tracker, kFast, Milliseconds(2), 10, now);
+    recordLatencies(tracker, kSlow, Milliseconds(200), 10, now);
+
+    const std::vector<HostAndPort> candidates{kSlow, kFast};
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQ(tracker.selectHost(candidates, 90, now, random), kFast);
+    }
+}
+
+TEST(HostLatencyTrackerTest, SelectsHostWithFewerRequestsInFlight) {
+    HostLatencyTracker tracker;
+    PseudoRandom random(1);
+    const auto now = Date_t::fromMillisSinceEpoch(100000);
+    recordLatencies(tracker, kFast, Milliseconds(10), 10, now);
+    recordLatencies(tracker, kSlow, Milliseconds(20), 10, now);
+    for (int i = 0; i < 5; ++i) {
+        tracker.onRequestStarted(kFast);
+    }
+
+    const std::vector<HostAndPort> candidates{kFast, kSlow};
+    ASSERT_EQ(tracker.selectHost(candidates, 90, now, random), kSlow);
+}
+
+TEST(HostLatencyTrackerTest, PrefersHostWithoutRecentLatencies) {
+    HostLatencyTracker tracker;
+    PseudoRandom random(1);
+    const auto now = Date_t::fromMillisSinceEpoch(100000);
+    recordLatencies(tracker, kFast, Milliseconds(1), 10, now);
+
+    const std::vector<HostAndPort> candidates{kFast, kSlow};
+    ASSERT_EQ(tracker.selectHost(candidates, 90, now, random), kSlow);
+}
+
+}  // namespace
+}  // namespace executor
+}  // namespace mongo
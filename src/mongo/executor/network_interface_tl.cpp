@@ -39,12 +39,14 @@
 #include "mongo/db/wire_version.h"
 #include "mongo/executor/connection_pool_tl.h"
 #include "mongo/executor/hedging_metrics.h"
+#include "mongo/executor/host_latency_tracker.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
 #include "mongo/transport/transport_layer_manager.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/testing_proctor.h"
+#include "mongo/util/timer.h"
 
 
 namespace mongo {
@@ -52,6 +54,7 @@ namespace executor {
 
 namespace {
 static inline const std::string kMaxTimeMSOpOnlyField = "maxTimeMSOpOnly";
+static inline const std::string kMaxAwaitTimeMSField = "maxAwaitTimeMS";
 
 Status appendMetadata(RemoteCommandRequestOnAny* request,
                       const std::unique_ptr<rpc::EgressMetadataHook>& hook) {
@@ -190,6 +193,14 @@ void NetworkInterfaceTL::appendConnectionStats(ConnectionPoolStats* stats) const
     }();
     if (pool)
         pool->appendConnectionStats(stats);
+
+    SendBatchStats sendBatches;
+    sendBatches.batches = _sendBatches.load();
+    sendBatches.requests = _sendBatchRequests.load();
+    for (size_t i = 0; i < sendBatches.durationMicrosBuckets.size(); ++i) {
+        sendBatches.durationMicrosBuckets[i] = _sendBatchDurationMicrosBuckets[i].load();
+    }
+    stats->sendBatches += sendBatches;
 }
 
 NetworkInterface::Counters NetworkInterfaceTL::getCounters() const {
@@ -557,9 +568,17 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
             continue;
         }
 
-        // Otherwise, schedule the request.
-        std::move(connFuture).thenRunOn(_reactor).getAsync([cmdState = cmdState, idx](auto swConn) {
-            cmdState->requestManager->trySend(std::move(swConn), idx);
+        // Otherwise, schedule the request. The continuation only queues the send for the reactor,
+        // so it may run inline wherever the connection pool completes the future.
+        auto inlineConnFuture = std::move(connFuture).unsafeToInlineFuture();
+        std::move(inlineConnFuture).getAsync([this, cmdState = cmdState, idx](auto swConn) mutable {
+            _scheduleSend([cmdState = std::move(cmdState), idx, swConn = std::move(swConn)](
+                              Status status) mutable {
+                if (!status.isOK()) {
+                    swConn = std::move(status);
+                }
+                cmdState->requestManager->trySend(std::move(swConn), idx);
+            });
         });
     }
 
@@ -568,6 +587,39 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
     return ex.toStatus();
 }
 
+void NetworkInterfaceTL::_scheduleSend(unique_function<void(Status)> send) {
+    {
+        stdx::lock_guard<Latch> lk(_pendingSendsMutex);
+        _pendingSends.push_back(std::move(send));
+        if (_pendingSends.size() > 1) {
+            // The reactor has yet to run the batch this send joined.
+            return;
+        }
+    }
+
+    _reactor->schedule([this](Status status) { _runSendBatch(std::move(status)); });
+}
+
+void NetworkInterfaceTL::_runSendBatch(Status status) {
+    std::vector<unique_function<void(Status)>> sends;
+    {
+        stdx::lock_guard<Latch> lk(_pendingSendsMutex);
+        sends.swap(_pendingSends);
+    }
+
+    Timer timer;
+    for (auto& send : sends) {
+        send(status);
+    }
+    const auto micros = timer.micros();
+
+    const auto& bounds = SendBatchStats::kDurationMicrosBounds;
+    auto bucket = std::upper_bound(bounds.begin(), bounds.end(), micros) - bounds.begin();
+    _sendBatchDurationMicrosBuckets[bucket].fetchAndAdd(1);
+    _sendBatchRequests.fetchAndAdd(sends.size());
+    _sendBatches.fetchAndAdd(1);
+}
+
 void NetworkInterfaceTL::testEgress(const HostAndPort& hostAndPort,
                                     transport::ConnectSSLMode sslMode,
                                     Milliseconds timeout,
@@ -582,11 +634,29 @@ void NetworkInterfaceTL::testEgress(const HostAndPort& hostAndPort,
 
 Future<RemoteCommandResponse> NetworkInterfaceTL::CommandState::sendRequest(
     std::shared_ptr<RequestState> requestState) {
+    // Awaitable commands, such as a hello which waits for a topology change or a getMore on a
+    // tailable cursor, take as long as they are told to wait and say nothing about the host's load.
+    const bool trackLatency = !requestState->request->cmdObj.hasField(kMaxAwaitTimeMSField);
+    if (trackLatency) {
+        HostLatencyTracker::get().onRequestStarted(requestState->host);
+    }
+
     return makeReadyFutureWith([this, requestState] {
                setTimer();
                return RequestState::getClient(requestState->conn)
                    ->runCommandRequest(*requestState->request, baton);
            })
+        .tapAll([requestState, trackLatency](const StatusWith<RemoteCommandResponse>& swr) {
+            if (!trackLatency) {
+                return;
+            }
+            boost::optional<Milliseconds> latency;
+            if (swr.isOK() && swr.getValue().isOK()) {
+                latency = requestState->stopwatch.elapsed();
+            }
+            HostLatencyTracker::get().onRequestFinished(
+                requestState->host, latency, requestState->stopwatch.now());
+        })
         .then([this, requestState](RemoteCommandResponse response) {
             doMetadataHook(RemoteCommandOnAnyResponse(requestState->host, response));
             return response;
@@ -1034,9 +1104,17 @@ Status NetworkInterfaceTL::startExhaustCommand(const TaskExecutor::CallbackHandl
             continue;
         }
 
-        // For every connection future we didn't have immediately ready, schedule
-        std::move(connFuture).thenRunOn(_reactor).getAsync([cmdState, idx](auto swConn) {
-            cmdState->requestManager->trySend(std::move(swConn), idx);
+        // For every connection future we didn't have immediately ready, schedule. As above, the
+        // continuation only queues the send, so it may run inline.
+        auto inlineConnFuture = std::move(connFuture).unsafeToInlineFuture();
+        std::move(inlineConnFuture).getAsync([this, cmdState, idx](auto swConn) mutable {
+            _scheduleSend([cmdState = std::move(cmdState), idx, swConn = std::move(swConn)](
+                              Status status) mutable {
+                if (!status.isOK()) {
+                    swConn = std::move(status);
+                }
+                cmdState->requestManager->trySend(std::move(swConn), idx);
+            });
         });
     }
 
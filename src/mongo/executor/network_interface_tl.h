@@ -29,11 +29,14 @@
 
 #pragma once
 
+#include <array>
 #include <deque>
+#include <vector>
 
 #include "mongo/client/async_client.h"
 #include "mongo/db/service_context.h"
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/connection_pool_stats.h"
 #include "mongo/executor/network_interface.h"
 #include "mongo/logv2/log_severity.h"
 #include "mongo/platform/mutex.h"
@@ -332,6 +335,14 @@ private:
 
     void _run();
 
+    /**
+     * Runs `send` on the reactor together with every other send that is queued before the reactor
+     * gets to it, so that a fan-out whose connections become ready together wakes the reactor
+     * once instead of once per target.
+     */
+    void _scheduleSend(unique_function<void(Status)> send);
+    void _runSendBatch(Status status);
+
     Status _killOperation(std::shared_ptr<RequestState> requestStateToKill);
 
     std::string _instanceName;
@@ -372,6 +383,14 @@ private:
 
     stdx::condition_variable _workReadyCond;
     bool _isExecutorRunnable = false;
+
+    Mutex _pendingSendsMutex = MONGO_MAKE_LATCH("NetworkInterfaceTL::_pendingSendsMutex");
+    std::vector<unique_function<void(Status)>> _pendingSends;
+
+    AtomicWord<size_t> _sendBatches;
+    AtomicWord<size_t> _sendBatchRequests;
+    std::array<AtomicWord<size_t>, SendBatchStats::kDurationMicrosBounds.size() + 1>
+        _sendBatchDurationMicrosBuckets;
 };
 
 }  // namespace executor
@@ -55,6 +55,10 @@ TaskExecutorCursor::TaskExecutorCursor(executor::TaskExecutor* executor,
     _runRemoteCommand(_createRequest(_rcr.opCtx, _rcr.cmdObj));
 }
 
+TaskExecutorCursor::TaskExecutorCursor(executor::TaskExecutor* executor,
+                                       const RemoteCommandRequest& rcr)
+    : TaskExecutorCursor(executor, rcr, Options{}) {}
+
 TaskExecutorCursor::~TaskExecutorCursor() {
     try {
         if (_cbHandle) {
@@ -80,6 +84,10 @@ TaskExecutorCursor::~TaskExecutorCursor() {
 
 boost::optional<BSONObj> TaskExecutorCursor::getNext(OperationContext* opCtx) {
     while (_batchIter == _batch.end() && _cursorId != kClosedCursorId) {
+        if (!_cbHandle) {
+            // The next batch was not pre-fetched
+            _scheduleGetMore(opCtx);
+        }
         _getNextBatch(opCtx);
     }
 
@@ -113,21 +121,34 @@ const RemoteCommandRequest& TaskExecutorCursor::_createRequest(OperationContext*
     return _rcr;
 }
 
-void TaskExecutorCursor::_runRemoteCommand(const RemoteCommandRequest& rcr) {
-    _cbHandle = uassertStatusOK(_executor->scheduleRemoteCommand(
-        rcr, [p = _pipe.producer](const TaskExecutor::RemoteCommandCallbackArgs& args) {
-            try {
-                if (args.response.isOK()) {
-                    p.push(args.response.data);
-                } else {
-                    p.push(args.response.status);
-                }
-            } catch (const DBException&) {
-                // If anything goes wrong, make sure we close the pipe to wake the caller of
-                // getNext()
-                p.close();
+void TaskExecutorCursor::_runRemoteCommand(const RemoteCommandRequest& rcr, bool exhaust) {
+    auto callback = [p = _pipe.producer](const TaskExecutor::RemoteCommandCallbackArgs& args) {
+        try {
+            if (args.response.isOK()) {
+                p.push(args.response.data);
+            } else {
+                p.push(args.response.status);
             }
-        }));
+        } catch (const DBException&) {
+            // If anything goes wrong, make sure we close the pipe to wake the caller of
+            // getNext()
+            p.close();
+        }
+    };
+
+    _cbHandle = uassertStatusOK(exhaust
+                                    ? _executor->scheduleExhaustRemoteCommand(rcr, callback)
+                                    : _executor->scheduleRemoteCommand(rcr, callback));
+    _exhaustInProgress = exhaust;
+}
+
+void TaskExecutorCursor::_scheduleGetMore(OperationContext* opCtx) {
+    invariant(_cursorId >= kMinLegalCursorId);
+    invariant(!_cbHandle);
+
+    GetMoreCommandRequest getMoreRequest(_cursorId, _ns.coll().toString());
+    getMoreRequest.setBatchSize(_options.batchSize);
+    _runRemoteCommand(_createRequest(opCtx, getMoreRequest.toBSON({})), _options.exhaust);
 }
 
 void TaskExecutorCursor::_getNextBatch(OperationContext* opCtx) {
@@ -150,11 +171,18 @@ void TaskExecutorCursor::_getNextBatch(OperationContext* opCtx) {
     }
 
     // if we've received a response from our last request (initial or getmore), our remote operation
-    // is done.
-    _cbHandle.reset();
+    // is done. An exhaust getMore instead stays outstanding until it returns a closed cursor.
+    if (!_exhaustInProgress) {
+        _cbHandle.reset();
+    }
 
     auto cr = uassertStatusOK(CursorResponse::parseFromBSON(out.getValue()));
 
+    if (_exhaustInProgress && cr.getCursorId() == kClosedCursorId) {
+        _cbHandle.reset();
+        _exhaustInProgress = false;
+    }
+
     // If this was our first batch
     if (_cursorId == kUnitializedCursorId) {
         _ns = cr.getNSS();
@@ -168,10 +196,8 @@ void TaskExecutorCursor::_getNextBatch(OperationContext* opCtx) {
     _batchIter = _batch.begin();
 
     // If we got a cursor id back, pre-fetch the next batch
-    if (_cursorId) {
-        GetMoreCommandRequest getMoreRequest(_cursorId, _ns.coll().toString());
-        getMoreRequest.setBatchSize(_options.batchSize);
-        _runRemoteCommand(_createRequest(opCtx, getMoreRequest.toBSON({})));
+    if (_cursorId && !_cbHandle && (_options.preFetchNextBatch || _options.exhaust)) {
+        _scheduleGetMore(opCtx);
     }
 }
 
@@ -52,8 +52,11 @@ namespace executor {
  *
  * The main differentiator for this type over DBClientCursor is the use of a task executor (which
  * provides access to a different connection pool, as well as interruptibility) and the ability to
- * overlap getMores.  This starts fetching the next batch as soon as one is exhausted (rather than
- * on a call to getNext()).
+ * overlap getMores.  By default this starts fetching the next batch as soon as one is received
+ * (rather than on a call to getNext() which exhausts it).
+ *
+ * With the 'exhaust' option, the first getMore is sent as an exhaust command and the remote keeps
+ * streaming batches until the cursor is exhausted, without a round trip per batch.
  */
 class TaskExecutorCursor {
 public:
@@ -67,6 +70,14 @@ public:
 
     struct Options {
         boost::optional<int64_t> batchSize;
+
+        // Whether to request the next batch while the current one is being consumed. Consumers
+        // which often abandon the cursor early can disable it to avoid fetching unused batches.
+        bool preFetchNextBatch{true};
+
+        // Whether to use the exhaust protocol for getMores. The remote then sends every remaining
+        // batch as soon as it is produced, which implies pre-fetching.
+        bool exhaust{false};
     };
 
     /**
@@ -79,7 +90,8 @@ public:
      */
     explicit TaskExecutorCursor(executor::TaskExecutor* executor,
                                 const RemoteCommandRequest& rcr,
-                                Options&& options = {});
+                                Options&& options);
+    explicit TaskExecutorCursor(executor::TaskExecutor* executor, const RemoteCommandRequest& rcr);
 
     /**
      * Asynchronously kills async ops and kills the underlying cursor on destruction.
@@ -113,9 +125,15 @@ public:
 
 private:
     /**
-     * Runs a remote command and pipes the output back to this object
+     * Runs a remote command and pipes the output back to this object. An exhaust command pipes
+     * back every reply until the remote indicates that no more are coming.
      */
-    void _runRemoteCommand(const RemoteCommandRequest& rcr);
+    void _runRemoteCommand(const RemoteCommandRequest& rcr, bool exhaust = false);
+
+    /**
+     * Sends the getMore for the next batch of the live remote cursor
+     */
+    void _scheduleGetMore(OperationContext* opCtx);
 
     /**
      * Gets the next batch with interruptibility via the opCtx
@@ -140,6 +158,9 @@ private:
     // Stash the callbackhandle for the current outstanding operation
     boost::optional<TaskExecutor::CallbackHandle> _cbHandle;
 
+    // Whether '_cbHandle' is an exhaust getMore which will keep delivering batches
+    bool _exhaustInProgress = false;
+
     CursorId _cursorId = kUnitializedCursorId;
 
     // Variables sent alongside the results in the cursor.
@@ -62,12 +62,10 @@ public:
         ThreadPoolExecutorTest::tearDown();
     }
 
-    BSONObj scheduleSuccessfulCursorResponse(StringData fieldName,
-                                             size_t start,
-                                             size_t end,
-                                             size_t cursorId) {
-        NetworkInterfaceMock::InNetworkGuard ing(getNet());
-
+    static BSONObj makeCursorResponse(StringData fieldName,
+                                      size_t start,
+                                      size_t end,
+                                      size_t cursorId) {
         BSONObjBuilder bob;
         {
             BSONObjBuilder cursor(bob.subobjStart("cursor"));
@@ -83,9 +81,18 @@ public:
             cursor.append("ns", "test.test");
         }
         bob.append("ok", int(1));
+        return bob.obj();
+    }
+
+    BSONObj scheduleSuccessfulCursorResponse(StringData fieldName,
+                                             size_t start,
+                                             size_t end,
+                                             size_t cursorId) {
+        NetworkInterfaceMock::InNetworkGuard ing(getNet());
 
         ASSERT(getNet()->hasReadyRequests());
-        auto rcr = getNet()->scheduleSuccessfulResponse(bob.obj());
+        auto rcr = getNet()->scheduleSuccessfulResponse(
+            makeCursorResponse(fieldName, start, end, cursorId));
         getNet()->runReadyNetworkOperations();
 
         return rcr.cmdObj.getOwned();
@@ -335,6 +342,104 @@ TEST_F(TaskExecutorCursorFixture, EmptyNonInitialBatch) {
     th.join();
 }
 
+/**
+ * Ensure that without pre-fetching, the getMore is only sent once the current batch is consumed
+ */
+TEST_F(TaskExecutorCursorFixture, NoPreFetchSendsGetMoreWhenBatchIsExhausted) {
+    const auto findCmd = BSON("find"
+                              << "test"
+                              << "batchSize" << 2);
+    const auto getMoreCmd = BSON("getMore" << 1LL << "collection"
+                                           << "test"
+                                           << "batchSize" << 3);
+
+    RemoteCommandRequest rcr(HostAndPort("localhost"), "test", findCmd, opCtx.get());
+
+    TaskExecutorCursor tec(&getExecutor(), rcr, [] {
+        TaskExecutorCursor::Options opts;
+        opts.batchSize = 3;
+        opts.preFetchNextBatch = false;
+        return opts;
+    }());
+
+    scheduleSuccessfulCursorResponse("firstBatch", 1, 2, 1 /* cursorId */);
+
+    ASSERT_EQUALS(tec.getNext(opCtx.get()).get()["x"].Int(), 1);
+    ASSERT_FALSE(hasReadyRequests());
+    ASSERT_EQUALS(tec.getNext(opCtx.get()).get()["x"].Int(), 2);
+    ASSERT_FALSE(hasReadyRequests());
+
+    stdx::thread th([&] {
+        // Wait for the getMore run by the getNext() below
+        while (!hasReadyRequests()) {
+            sleepmillis(10);
+        }
+
+        ASSERT_BSONOBJ_EQ(getMoreCmd,
+                          scheduleSuccessfulCursorResponse("nextBatch", 3, 3, 0 /* cursorId */));
+    });
+
+    ASSERT_EQUALS(tec.getNext(opCtx.get()).get()["x"].Int(), 3);
+    th.join();
+
+    ASSERT_FALSE(tec.getNext(opCtx.get()));
+}
+
+/**
+ * Ensure that a single exhaust getMore delivers all the remaining batches
+ */
+TEST_F(TaskExecutorCursorFixture, ExhaustGetMoreStreamsRemainingBatches) {
+    const auto findCmd = BSON("find"
+                              << "test"
+                              << "batchSize" << 2);
+    const CursorId cursorId = 1;
+
+    RemoteCommandRequest rcr(HostAndPort("localhost"), "test", findCmd, opCtx.get());
+
+    TaskExecutorCursor tec(&getExecutor(), rcr, [] {
+        TaskExecutorCursor::Options opts;
+        opts.batchSize = 2;
+        opts.exhaust = true;
+        return opts;
+    }());
+
+    scheduleSuccessfulCursorResponse("firstBatch", 1, 2, cursorId);
+
+    ASSERT_EQUALS(tec.getNext(opCtx.get()).get()["x"].Int(), 1);
+
+    {
+        NetworkInterfaceMock::InNetworkGuard ing(getNet());
+
+        ASSERT(getNet()->hasReadyRequests());
+        auto noi = getNet()->getNextReadyRequest();
+        ASSERT_BSONOBJ_EQ(BSON("getMore" << 1LL << "collection"
+                                         << "test"
+                                         << "batchSize" << 2),
+                          noi->getRequest().cmdObj);
+
+        const auto startTime = getNet()->now();
+        getNet()->scheduleResponse(
+            noi,
+            startTime,
+            RemoteCommandResponse(
+                makeCursorResponse("nextBatch", 3, 4, cursorId), Microseconds(), true));
+        getNet()->scheduleResponse(
+            noi,
+            startTime + Milliseconds(1),
+            RemoteCommandResponse(
+                makeCursorResponse("nextBatch", 5, 5, 0 /* cursorId */), Microseconds(), false));
+        getNet()->runUntil(startTime + Milliseconds(2));
+    }
+
+    for (int x = 2; x <= 5; ++x) {
+        ASSERT_EQUALS(tec.getNext(opCtx.get()).get()["x"].Int(), x);
+    }
+
+    // Both batches were delivered by the one getMore
+    ASSERT_FALSE(hasReadyRequests());
+    ASSERT_FALSE(tec.getNext(opCtx.get()));
+}
+
 /**
  * Ensure lsid is passed in all stages of querying
  */
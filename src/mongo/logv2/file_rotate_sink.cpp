@@ -33,13 +33,21 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
+#include <deque>
 #include <fmt/format.h>
 #include <fstream>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/string_map.h"
@@ -73,16 +81,53 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
 }  // namespace
 
 struct FileRotateSink::Impl {
-    Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
+    Impl(LogTimestampFormat tsFormat, boost::optional<AsyncOptions> async)
+        : timestampFormat(tsFormat), asyncOptions(std::move(async)) {}
     StringMap<boost::shared_ptr<stream_t>> files;
     LogTimestampFormat timestampFormat;
+
+    // Serializes writing to and replacing of the streams between the thread calling into the sink
+    // and the asynchronous writer thread. Always acquired before 'queueMutex'.
+    stdx::mutex writeMutex;  // NOLINT
+
+    boost::optional<AsyncOptions> asyncOptions;
+
+    // Protects the members below, which are only used when 'asyncOptions' is set
+    stdx::mutex queueMutex;  // NOLINT
+    stdx::condition_variable queueChanged;
+    std::deque<std::string> queue;
+    size_t queuedBytes{0};
+    bool shuttingDown{false};
+
+    AtomicWord<long long> droppedRecords{0};
+
+    // Drop count already reported in the log file. Only accessed under 'writeMutex'.
+    long long droppedRecordsReported{0};
+
+    stdx::thread writer;
 };
 
-FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
-    : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat,
+                               boost::optional<AsyncOptions> asyncOptions)
+    : _impl(std::make_unique<Impl>(timestampFormat, std::move(asyncOptions))) {
+    if (_impl->asyncOptions) {
+        _impl->writer = stdx::thread([this] { _asyncWriterThread(); });
+    }
+}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->writer.joinable()) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_impl->queueMutex);
+            _impl->shuttingDown = true;
+        }
+        _impl->queueChanged.notify_all();
+        _impl->writer.join();
+    }
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
+    stdx::lock_guard<stdx::mutex> lk(_impl->writeMutex);
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
         add_stream(statusWithFile.getValue());
@@ -92,6 +137,7 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    stdx::lock_guard<stdx::mutex> lk(_impl->writeMutex);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -102,6 +148,10 @@ void FileRotateSink::removeFile(const std::string& filename) {
 Status FileRotateSink::rotate(bool rename,
                               StringData renameSuffix,
                               std::function<void(Status)> onMinorError) {
+    // Records queued before the rotation belong to the file being rotated out
+    stdx::lock_guard<stdx::mutex> lk(_impl->writeMutex);
+    _writeQueuedRecords();
+
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -163,8 +213,116 @@ Status FileRotateSink::rotate(bool rename,
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
+    if (_impl->asyncOptions) {
+        using boost::log::extract;
+        auto severity = extract<LogSeverity>(attributes::severity(), rec);
+        if (!severity || severity.get() < LogSeverity::Error()) {
+            stdx::unique_lock<stdx::mutex> lk(_impl->queueMutex);
+            auto fits = [&] {
+                // An oversized record is still accepted into an empty queue
+                return _impl->queue.empty() ||
+                    _impl->queuedBytes + formatted_string.size() <=
+                    _impl->asyncOptions->maxQueuedBytes;
+            };
+            if (!fits()) {
+                if (_impl->asyncOptions->dropOnOverflow) {
+                    _impl->droppedRecords.fetchAndAdd(1);
+                    return;
+                }
+                _impl->queueChanged.wait(lk, fits);
+            }
+            _impl->queue.push_back(formatted_string);
+            _impl->queuedBytes += formatted_string.size();
+            lk.unlock();
+            _impl->queueChanged.notify_all();
+            return;
+        }
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_impl->writeMutex);
+    _writeQueuedRecords();
+    _write(formatted_string);
+    if (_impl->asyncOptions) {
+        boost::log::sinks::text_ostream_backend::flush();
+    }
+}
+
+void FileRotateSink::flush() {
+    stdx::lock_guard<stdx::mutex> lk(_impl->writeMutex);
+    _writeQueuedRecords();
+    boost::log::sinks::text_ostream_backend::flush();
+}
+
+long long FileRotateSink::droppedRecords() const {
+    return _impl->droppedRecords.load();
+}
+
+void FileRotateSink::_writeQueuedRecords() {
+    if (!_impl->asyncOptions) {
+        return;
+    }
+
+    std::deque<std::string> records;
+    {
+        stdx::lock_guard<stdx::mutex> lk(_impl->queueMutex);
+        records.swap(_impl->queue);
+        _impl->queuedBytes = 0;
+    }
+    _impl->queueChanged.notify_all();
+
+    auto dropped = _impl->droppedRecords.load();
+    if (dropped != _impl->droppedRecordsReported) {
+        DynamicAttributes attrs;
+        attrs.add("droppedRecords", dropped - _impl->droppedRecordsReported);
+
+        fmt::memory_buffer buffer;
+        JSONFormatter(nullptr, _impl->timestampFormat)
+            .format(buffer,
+                    LogSeverity::Warning(),
+                    LogComponent::kControl,
+                    Date_t::now(),
+                    6170441,
+                    getThreadName(),
+                    "Dropped log records because the asynchronous log queue was full",
+                    TypeErasedAttributeStorage(attrs),
+                    LogTag::kNone,
+                    nullptr /* tenantID */,
+                    LogTruncation::Disabled);
+        // Commented out log line below to get validation of the log id with the errorcodes
+        // linter LOGV2_WARNING(6170441, "Dropped log records");
+        _write(std::string(buffer.data(), buffer.size()));
+        _impl->droppedRecordsReported = dropped;
+    }
+
+    for (const auto& record : records) {
+        _write(record);
+    }
+}
+
+void FileRotateSink::_asyncWriterThread() {
+    setThreadName("LogFileWriter");
+
+    while (true) {
+        {
+            stdx::unique_lock<stdx::mutex> lk(_impl->queueMutex);
+            _impl->queueChanged.wait(
+                lk, [&] { return !_impl->queue.empty() || _impl->shuttingDown; });
+            if (_impl->queue.empty() && _impl->shuttingDown) {
+                return;
+            }
+        }
+
+        stdx::lock_guard<stdx::mutex> lk(_impl->writeMutex);
+        _writeQueuedRecords();
+        boost::log::sinks::text_ostream_backend::flush();
+    }
+}
+
+void FileRotateSink::_write(const string_type& formatted_string) {
     auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+    // The streams only need the formatted text, which lets queued records be written after the
+    // record they were formatted from is gone
+    boost::log::sinks::text_ostream_backend::consume(boost::log::record_view(), formatted_string);
     if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
         try {
             auto failedBegin =
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/optional.hpp>
 #include <memory>
 #include <string>
 
@@ -40,9 +41,23 @@ namespace mongo::logv2 {
 // boost::log backend sink to provide MongoDB style file rotation.
 // Uses custom stream type to open log files with shared access on Windows, somthing the built-in
 // boost file rotation sink does not do.
+//
+// When constructed with AsyncOptions, consume() only queues the formatted record and a dedicated
+// thread writes it to the files, so that a slow log device does not stall the logging thread.
+// Records of Error severity and above are still written before consume() returns, after everything
+// queued ahead of them, so that they are on disk if the process is about to terminate.
 class FileRotateSink : public boost::log::sinks::text_ostream_backend {
 public:
-    FileRotateSink(LogTimestampFormat timestampFormat);
+    struct AsyncOptions {
+        // Upper bound on the total size of the formatted records waiting to be written
+        size_t maxQueuedBytes;
+
+        // What consume() does when the queue is full: drop the record, or wait for the writer
+        bool dropOnOverflow;
+    };
+
+    FileRotateSink(LogTimestampFormat timestampFormat,
+                   boost::optional<AsyncOptions> asyncOptions = boost::none);
     ~FileRotateSink();
 
     Status addFile(const std::string& filename, bool append);
@@ -52,7 +67,21 @@ public:
 
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    /**
+     * Writes out all queued records and flushes the files.
+     */
+    void flush();
+
+    /**
+     * Number of records discarded because the asynchronous queue was full.
+     */
+    long long droppedRecords() const;
+
 private:
+    void _writeQueuedRecords();
+    void _write(const string_type& formatted_string);
+    void _asyncWriterThread();
+
     struct Impl;
     std::unique_ptr<Impl> _impl;
 };
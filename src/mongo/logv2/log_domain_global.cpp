@@ -161,8 +161,14 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
 #endif
 
     if (options.fileEnabled) {
+        boost::optional<FileRotateSink::AsyncOptions> asyncOptions;
+        if (options.fileAsyncQueueBytes > 0) {
+            asyncOptions = FileRotateSink::AsyncOptions{options.fileAsyncQueueBytes,
+                                                        options.fileAsyncDropOnOverflow};
+        }
+
         auto backend = boost::make_shared<RotatableFileBackend>(
-            boost::make_shared<FileRotateSink>(options.timestampFormat),
+            boost::make_shared<FileRotateSink>(options.timestampFormat, asyncOptions),
             boost::make_shared<RamLogSink>(RamLog::get("global")),
             boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")),
             boost::make_shared<UserAssertSink>());
@@ -171,7 +177,8 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
             options.fileOpenMode == ConfigurationOptions::OpenMode::kAppend ? true : false);
         if (!ret.isOK())
             return ret;
-        backend->lockedBackend<0>()->auto_flush(true);
+        // The asynchronous writer flushes once per batch of records instead
+        backend->lockedBackend<0>()->auto_flush(!asyncOptions);
         backend->setFilter<2>(
             TaggedSeverityFilter(_parent, {LogTag::kStartupWarnings}, LogSeverity::Log()));
 
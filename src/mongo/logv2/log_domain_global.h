@@ -45,6 +45,11 @@ public:
         std::string filePath;
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
+        // When non-zero, records for the log file are queued up to this many bytes and written
+        // by a dedicated thread instead of the thread which logs them.
+        size_t fileAsyncQueueBytes{0};
+        // Whether a record is dropped rather than waited on when the asynchronous queue is full.
+        bool fileAsyncDropOnOverflow{false};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
         bool syslogEnabled{false};
         int syslogFacility{-1};  // invalid facility by default, must be set
@@ -29,11 +29,13 @@
 
 #define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_domain_global.h"
 #include "mongo/logv2/text_formatter.h"
 #include "mongo/platform/basic.h"
+#include "mongo/util/str_escape.h"
 
 #include <benchmark/benchmark.h>
 #include <boost/iostreams/device/null.hpp>
@@ -97,6 +99,38 @@ private:
     bool _shouldInit;
 };
 
+// Routes the global log domain to a file sink writing to the null device. A non-zero
+// 'asyncQueueKB' makes the file sink asynchronous with a queue of that size.
+class ScopedLogV2FileBench {
+public:
+    ScopedLogV2FileBench(benchmark::State& state, int64_t asyncQueueKB) {
+        _shouldInit = state.thread_index == 0;
+        if (_shouldInit) {
+            logv2::LogDomainGlobal::ConfigurationOptions config;
+            config.consoleEnabled = false;
+            config.fileEnabled = true;
+#ifdef _WIN32
+            config.filePath = "NUL";
+#else
+            config.filePath = "/dev/null";
+#endif
+            config.fileOpenMode = logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kAppend;
+            config.fileAsyncQueueBytes = asyncQueueKB * 1024;
+            invariant(
+                logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
+        }
+    }
+
+    ~ScopedLogV2FileBench() {
+        if (_shouldInit) {
+            invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
+        }
+    }
+
+private:
+    bool _shouldInit;
+};
+
 // "Expensive" way to create a string.
 std::string createLongString() {
     return std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c') +
@@ -150,6 +184,38 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+void BM_EnabledLogV2BSONArg(benchmark::State& state) {
+    ScopedLogV2Bench init(state);
+    BSONObjBuilder builder;
+    for (int i = 0; i < 20; ++i)
+        builder.append("field" + std::to_string(i), createLongString().substr(0, 200));
+    BSONObj obj = builder.obj();
+
+    for (auto _ : state)
+        LOGV2(6170426, "enabled log {}", "obj"_attr = obj);
+}
+
+// Logging to a file, synchronously when state.range(0) is 0 and otherwise through an asynchronous
+// queue of state.range(0) KB.
+void BM_FileLogV2(benchmark::State& state) {
+    ScopedLogV2FileBench init(state, state.range(0));
+
+    for (auto _ : state)
+        LOGV2(6170442, "enabled log {}", "str"_attr = "short string attribute");
+}
+
+// Escaping a string that is mostly printable ASCII, as in typical log attributes.
+void BM_EscapeForJSON(benchmark::State& state) {
+    std::string str = createLongString() + "\n\"quoted\"";
+    fmt::memory_buffer buffer;
+    for (auto _ : state) {
+        buffer.clear();
+        str::escapeForJSON(buffer, str);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * str.size());
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
@@ -161,6 +227,9 @@ BENCHMARK(BM_NoopLogV2Arg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
+BENCHMARK(BM_EnabledLogV2BSONArg)->Apply(ThreadCounts);
+BENCHMARK(BM_FileLogV2)->Arg(0)->Arg(1024)->Apply(ThreadCounts);
+BENCHMARK(BM_EscapeForJSON);
 
 }  // namespace
 }  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
 #include "mongo/logv2/constants.h"
+#include "mongo/logv2/file_rotate_sink.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_capture_backend.h"
@@ -1721,6 +1722,49 @@ TEST_F(LogV2Test, FileLogging) {
     ASSERT(before_rotation == after_rotation);
 }
 
+TEST_F(LogV2Test, AsyncFileRotateSink) {
+    auto logv2_dir = std::make_unique<mongo::unittest::TempDir>("logv2");
+    std::string file_name = logv2_dir->path() + "/file.log";
+
+    auto backend = boost::make_shared<FileRotateSink>(
+        LogTimestampFormat::kISO8601UTC,
+        FileRotateSink::AsyncOptions{1024 * 1024, false /* dropOnOverflow */});
+    ASSERT_OK(backend->addFile(file_name, false));
+
+    auto sink = wrapInSynchronousSink(backend);
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    auto readFile = [&](std::string const& filename) {
+        std::vector<std::string> lines;
+        std::ifstream file(filename);
+        for (std::string line; std::getline(file, line, '\n');)
+            lines.push_back(std::move(line));
+        return lines;
+    };
+
+    // Records are written by the writer thread in the order they were logged
+    const size_t kNumRecords = 1000;
+    for (size_t i = 0; i < kNumRecords; ++i)
+        LOGV2(6170443, "async {i}", "i"_attr = i);
+    sink->flush();
+
+    auto lines = readFile(file_name);
+    ASSERT_EQ(kNumRecords, lines.size());
+    for (size_t i = 0; i < kNumRecords; ++i)
+        ASSERT_EQ("async " + std::to_string(i), lines[i]);
+
+    // An error is in the file as soon as it has been logged, behind the records queued before it
+    LOGV2(6170444, "queued");
+    LOGV2_ERROR(6170445, "error");
+    lines = readFile(file_name);
+    ASSERT_EQ(kNumRecords + 2, lines.size());
+    ASSERT_EQ("queued", lines[kNumRecords]);
+    ASSERT_EQ("error", lines.back());
+    ASSERT_EQ(0, backend->droppedRecords());
+}
+
 TEST_F(LogV2Test, UserAssert) {
     std::vector<std::string> lines;
     auto sink = wrapInSynchronousSink(wrapInCompositeBackend(
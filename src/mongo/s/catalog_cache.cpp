@@ -612,6 +612,9 @@ void CatalogCache::CollectionCache::Stats::report(BSONObjBuilder* builder) const
     builder->append("countFullRefreshesStarted", countFullRefreshesStarted.load());
 
     builder->append("countFailedRefreshes", countFailedRefreshes.load());
+
+    builder->append("totalRefreshFetchTimeMicros", totalRefreshFetchTimeMicros.load());
+    builder->append("totalRefreshApplyTimeMicros", totalRefreshApplyTimeMicros.load());
 }
 
 CatalogCache::CollectionCache::LookupResult CatalogCache::CollectionCache::_lookupCollection(
@@ -639,7 +642,12 @@ CatalogCache::CollectionCache::LookupResult CatalogCache::CollectionCache::_look
                                   "lookupSinceVersion"_attr = lookupVersion,
                                   "timeInStore"_attr = previousVersion.toBSONForLogging());
 
-        auto collectionAndChunks = _catalogCacheLoader.getChunksSince(nss, lookupVersion).get();
+        Timer fetchTimer;
+        auto collectionAndChunks = [&] {
+            ON_BLOCK_EXIT(
+                [&] { _stats.totalRefreshFetchTimeMicros.addAndFetch(fetchTimer.micros()); });
+            return _catalogCacheLoader.getChunksSince(nss, lookupVersion).get();
+        }();
 
         const auto maxChunkSize = [&]() -> boost::optional<uint64_t> {
             if (!collectionAndChunks.allowAutoSplit) {
@@ -654,7 +662,11 @@ CatalogCache::CollectionCache::LookupResult CatalogCache::CollectionCache::_look
             return boost::none;
         }();
 
+        Timer applyTimer;
         auto newRoutingHistory = [&] {
+            ON_BLOCK_EXIT(
+                [&] { _stats.totalRefreshApplyTimeMicros.addAndFetch(applyTimer.micros()); });
+
             // If we have routing info already and it's for the same collection epoch, we're
             // updating. Otherwise, we're making a whole new routing table.
             if (isIncremental &&
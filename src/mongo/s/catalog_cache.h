@@ -341,6 +341,14 @@ private:
             // failed for whatever reason
             AtomicWord<long long> countFailedRefreshes{0};
 
+            // Cumulative, always-increasing counter of how much time refreshes spent fetching the
+            // collection and its changed chunks from the catalog cache loader
+            AtomicWord<long long> totalRefreshFetchTimeMicros{0};
+
+            // Cumulative, always-increasing counter of how much time refreshes spent building the
+            // routing table from the fetched chunks
+            AtomicWord<long long> totalRefreshApplyTimeMicros{0};
+
             /**
              * Reports the accumulated statistics for serverStatus.
              */
@@ -318,5 +318,21 @@ TEST_F(CatalogCacheTest, LookupCollectionWithInvalidOptions) {
     ASSERT_EQUALS(swChunkManager.getStatus(), ErrorCodes::InvalidOptions);
 }
 
+TEST_F(CatalogCacheTest, RefreshReportsFetchAndApplyTime) {
+    const auto dbVersion = DatabaseVersion(UUID::gen(), Timestamp());
+    const auto version = ChunkVersion(1, 0, OID::gen(), Timestamp(42));
+
+    loadDatabases({DatabaseType(kNss.db().toString(), kShards[0], true, dbVersion)});
+    loadCollection(version);
+
+    BSONObjBuilder builder;
+    _catalogCache->report(&builder);
+    const auto report = builder.obj();
+    const auto stats = report["catalogCache"].Obj();
+    ASSERT_EQ(1, stats["countFullRefreshesStarted"].numberLong());
+    ASSERT_TRUE(stats.hasField("totalRefreshFetchTimeMicros"));
+    ASSERT_TRUE(stats.hasField("totalRefreshApplyTimeMicros"));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -211,6 +211,37 @@ std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardK
     return std::shared_ptr<ChunkInfo>();
 }
 
+std::vector<std::shared_ptr<ChunkInfo>> ChunkMap::findIntersectingChunks(
+    const std::vector<BSONObj>& shardKeys) const {
+    std::vector<std::pair<std::string, size_t>> shardKeyStrings;
+    shardKeyStrings.reserve(shardKeys.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        shardKeyStrings.emplace_back(ShardKeyPattern::toKeyString(shardKeys[i]), i);
+    }
+    std::sort(shardKeyStrings.begin(), shardKeyStrings.end());
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks(shardKeys.size());
+    auto it = _chunkMap.begin();
+    for (const auto& [shardKeyString, index] : shardKeyStrings) {
+        // The keys are visited in ascending order, so each one is either in the chunk of the
+        // previous key or in a chunk after it.
+        if (it != _chunkMap.end() && !(shardKeyString < (*it)->getMaxKeyString())) {
+            it = std::upper_bound(std::next(it),
+                                  _chunkMap.end(),
+                                  shardKeyString,
+                                  [](const std::string& keyString, const auto& chunkInfo) {
+                                      return keyString < chunkInfo->getMaxKeyString();
+                                  });
+        }
+        if (it == _chunkMap.end())
+            break;
+
+        chunks[index] = *it;
+    }
+
+    return chunks;
+}
+
 void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion& version) {
     uassert(ErrorCodes::ConflictingOperationInProgress,
             str::stream() << "Changed chunk " << chunk->toString()
@@ -222,41 +253,58 @@ void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion&
 
 ChunkMap ChunkMap::createMerged(
     const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const {
-    size_t chunkMapIndex = 0;
-    size_t changedChunkIndex = 0;
-
     ChunkMap updatedChunkMap(
         getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
 
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
-            validateChunk(changedChunks[changedChunkIndex], getVersion());
-            updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
-            continue;
-        }
+    // Every changed chunk is at least as new as the current collection version, so the version of
+    // the merged map can only grow from it. This lets the chunks which are not replaced be copied
+    // over in bulk, without comparing each of them against its predecessor.
+    updatedChunkMap._collectionVersion = _collectionVersion;
 
-        if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
-            continue;
+    // Copies the chunks in [first, last). Only the first of them can overlap a changed chunk which
+    // was just appended, because the chunks of the current map are contiguous and ordered by max.
+    auto appendUnchangedChunks = [&](ChunkVector::const_iterator first,
+                                     ChunkVector::const_iterator last) {
+        if (first == last)
+            return;
+        updatedChunkMap.appendChunk(*first);
+        updatedChunkMap._chunkMap.insert(updatedChunkMap._chunkMap.end(), std::next(first), last);
+    };
+
+    auto it = _chunkMap.begin();
+    for (const auto& changedChunk : changedChunks) {
+        validateChunk(changedChunk, getVersion());
+
+        // The chunks which end at or before the changed chunk's min bound are kept as they are.
+        const auto changedMinKeyString = ShardKeyPattern::toKeyString(changedChunk->getMin());
+        const auto overlapBegin =
+            std::upper_bound(it,
+                             _chunkMap.end(),
+                             changedMinKeyString,
+                             [](const std::string& keyString, const auto& chunkInfo) {
+                                 return keyString < chunkInfo->getMaxKeyString();
+                             });
+        appendUnchangedChunks(it, overlapBegin);
+
+        if (overlapBegin != _chunkMap.end() &&
+            (*overlapBegin)->getRange().overlaps(changedChunk->getRange())) {
+            auto bytesInReplacedChunk = (*overlapBegin)->getWritesTracker()->getBytesWritten();
+            changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
         }
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
+        updatedChunkMap.appendChunk(changedChunk);
 
-        if (overlap) {
-            auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
-
-            auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
-            changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
-
-            validateChunk(changedChunk, getVersion());
-            updatedChunkMap.appendChunk(changedChunk);
-        } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
-        }
+        // The chunks which end at or before the changed chunk's max bound are replaced by it.
+        it = std::upper_bound(overlapBegin,
+                              _chunkMap.end(),
+                              changedChunk->getMaxKeyString(),
+                              [](const std::string& keyString, const auto& chunkInfo) {
+                                  return keyString < chunkInfo->getMaxKeyString();
+                              });
     }
 
+    appendUnchangedChunks(it, _chunkMap.end());
+
     return updatedChunkMap;
 }
 
@@ -387,6 +435,23 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey,
     return Chunk(*chunkInfo, _clusterTime);
 }
 
+std::vector<boost::optional<Chunk>> ChunkManager::findIntersectingChunksWithSimpleCollation(
+    const std::vector<BSONObj>& shardKeys) const {
+    auto chunkInfos = _rt->optRt->findIntersectingChunks(shardKeys);
+
+    std::vector<boost::optional<Chunk>> chunks;
+    chunks.reserve(shardKeys.size());
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        if (chunkInfos[i] && chunkInfos[i]->containsKey(shardKeys[i])) {
+            chunks.emplace_back(Chunk(*chunkInfos[i], _clusterTime));
+        } else {
+            chunks.emplace_back(boost::none);
+        }
+    }
+
+    return chunks;
+}
+
 bool ChunkManager::keyBelongsToShard(const BSONObj& shardKey, const ShardId& shardId) const {
     if (shardKey.isEmpty())
         return false;
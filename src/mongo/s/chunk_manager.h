@@ -116,6 +116,14 @@ public:
     ShardVersionMap constructShardVersionMap() const;
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
+    /**
+     * Returns the chunk whose max bound is past each of 'shardKeys', in the order of the input, or
+     * nullptr for the keys which sort after the last chunk. The keys are sorted first so that all
+     * of them are resolved in a single forward walk over the chunks.
+     */
+    std::vector<std::shared_ptr<ChunkInfo>> findIntersectingChunks(
+        const std::vector<BSONObj>& shardKeys) const;
+
     void appendChunk(const std::shared_ptr<ChunkInfo>& chunk);
 
     ChunkMap createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const;
@@ -267,6 +275,11 @@ public:
         return _chunkMap.findIntersectingChunk(shardKey);
     }
 
+    std::vector<std::shared_ptr<ChunkInfo>> findIntersectingChunks(
+        const std::vector<BSONObj>& shardKeys) const {
+        return _chunkMap.findIntersectingChunks(shardKeys);
+    }
+
     /**
      * Returns the ids of all shards on which the collection has any chunks.
      */
@@ -629,6 +642,14 @@ public:
         return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
     }
 
+    /**
+     * Batched form of findIntersectingChunkWithSimpleCollation, for shard keys extracted from a
+     * batch of documents. Returns the chunk of each key in the order of 'shardKeys', or boost::none
+     * for the keys which findIntersectingChunkWithSimpleCollation would fail to target.
+     */
+    std::vector<boost::optional<Chunk>> findIntersectingChunksWithSimpleCollation(
+        const std::vector<BSONObj>& shardKeys) const;
+
     /**
      * Finds the shard id of the shard that owns the chunk minKey belongs to, assuming the simple
      * collation because shard keys do not support non-simple collations.
@@ -151,7 +151,30 @@ void BM_IncrementalRefreshOfPessimalBalancedDistribution(benchmark::State& state
 BENCHMARK(BM_IncrementalRefreshOfPessimalBalancedDistribution)
     ->Args({2, 50000})
     ->Args({2, 250000})
-    ->Args({2, 500000});
+    ->Args({2, 500000})
+    ->Args({2, 1200000});
+
+void BM_IncrementalRefreshOfOptimalBalancedDistribution(benchmark::State& state) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+    auto metadata = makeChunkManagerWithOptimalBalancedDistribution(nShards, nChunks);
+
+    auto postMoveVersion = metadata.getChunkManager()->getVersion();
+    auto const uuid = *metadata.getUUID();
+    std::vector<ChunkType> newChunks;
+    postMoveVersion.incMajor();
+    newChunks.emplace_back(uuid, getRangeForChunk(1, nChunks), postMoveVersion, ShardId("shard1"));
+
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(runIncrementalUpdate(metadata, newChunks));
+    }
+}
+
+BENCHMARK(BM_IncrementalRefreshOfOptimalBalancedDistribution)
+    ->Args({2, 50000})
+    ->Args({2, 250000})
+    ->Args({2, 500000})
+    ->Args({2, 1200000});
 
 template <typename ShardSelectorFn>
 auto BM_FullBuildOfChunkManager(benchmark::State& state, ShardSelectorFn selectShard) {
@@ -306,28 +306,36 @@ BSONObj ChunkManagerTargeter::extractBucketsShardKeyFromTimeseriesDoc(
     return pattern.extractShardKeyFromDoc(docWithShardKey);
 }
 
+BSONObj ChunkManagerTargeter::_extractShardKeyForInsert(const BSONObj& doc) const {
+    BSONObj shardKey;
+
+    const auto& shardKeyPattern = _cm.getShardKeyPattern();
+    if (_nss.isTimeseriesBucketsCollection()) {
+        auto tsFields = _cm.getTimeseriesFields();
+        tassert(5743701, "Missing timeseriesFields on buckets collection", tsFields);
+        shardKey = extractBucketsShardKeyFromTimeseriesDoc(
+            doc, shardKeyPattern, tsFields->getTimeseriesOptions());
+    } else {
+        shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
+    }
+
+    // The shard key would only be empty after extraction if we encountered an error case, such as
+    // the shard key possessing an array value or array descendants. If the shard key presented to
+    // the targeter was empty, we would emplace the missing fields, and the extracted key here would
+    // *not* be empty.
+    uassert(ErrorCodes::ShardKeyNotFound,
+            "Shard key cannot contain array values or array descendants.",
+            !shardKey.isEmpty());
+
+    return shardKey;
+}
+
 ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
                                                  const BSONObj& doc) const {
     BSONObj shardKey;
 
     if (_cm.isSharded()) {
-        const auto& shardKeyPattern = _cm.getShardKeyPattern();
-        if (_nss.isTimeseriesBucketsCollection()) {
-            auto tsFields = _cm.getTimeseriesFields();
-            tassert(5743701, "Missing timeseriesFields on buckets collection", tsFields);
-            shardKey = extractBucketsShardKeyFromTimeseriesDoc(
-                doc, shardKeyPattern, tsFields->getTimeseriesOptions());
-        } else {
-            shardKey = shardKeyPattern.extractShardKeyFromDoc(doc);
-        }
-
-        // The shard key would only be empty after extraction if we encountered an error case, such
-        // as the shard key possessing an array value or array descendants. If the shard key
-        // presented to the targeter was empty, we would emplace the missing fields, and the
-        // extracted key here would *not* be empty.
-        uassert(ErrorCodes::ShardKeyNotFound,
-                "Shard key cannot contain array values or array descendants.",
-                !shardKey.isEmpty());
+        shardKey = _extractShardKeyForInsert(doc);
     }
 
     // Target the shard key or database primary
@@ -343,6 +351,60 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
         _nss.isOnInternalDb() ? boost::optional<DatabaseVersion>() : _cm.dbVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    std::vector<StatusWith<ShardEndpoint>> endpoints;
+    endpoints.reserve(docs.size());
+
+    if (!_cm.isSharded()) {
+        for (const auto& doc : docs) {
+            endpoints.emplace_back(targetInsert(opCtx, doc));
+        }
+        return endpoints;
+    }
+
+    // Extract the shard keys of the whole batch first, so that they are all resolved against the
+    // routing table together.
+    std::vector<BSONObj> shardKeys;
+    shardKeys.reserve(docs.size());
+    std::vector<size_t> shardKeyIndexes;
+    shardKeyIndexes.reserve(docs.size());
+    for (const auto& doc : docs) {
+        try {
+            shardKeys.push_back(_extractShardKeyForInsert(doc));
+            shardKeyIndexes.push_back(endpoints.size());
+            endpoints.emplace_back(Status(ErrorCodes::InternalError, "Insert not targeted"));
+        } catch (const DBException& ex) {
+            endpoints.emplace_back(ex.toStatus());
+        }
+    }
+
+    const auto chunks = _cm.findIntersectingChunksWithSimpleCollation(shardKeys);
+
+    // Most batches only reach a few shards, so the version of each one is only looked up once.
+    stdx::unordered_map<ShardId, ShardEndpoint, ShardId::Hasher> shardEndpoints;
+    for (size_t i = 0; i < shardKeys.size(); ++i) {
+        auto& endpoint = endpoints[shardKeyIndexes[i]];
+        if (!chunks[i]) {
+            endpoint = Status(ErrorCodes::ShardKeyNotFound,
+                              str::stream() << "Cannot target single shard using key "
+                                            << shardKeys[i] << " for namespace " << _nss);
+            continue;
+        }
+
+        const auto& shardId = chunks[i]->getShardId();
+        auto it = shardEndpoints.find(shardId);
+        if (it == shardEndpoints.end()) {
+            it = shardEndpoints
+                     .emplace(shardId, ShardEndpoint(shardId, _cm.getVersion(shardId), boost::none))
+                     .first;
+        }
+        endpoint = it->second;
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
@@ -79,6 +79,9 @@ public:
 
     ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const override;
 
+    std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override;
+
     std::vector<ShardEndpoint> targetUpdate(OperationContext* opCtx,
                                             const BatchItemRef& itemRef) const override;
 
@@ -147,6 +150,12 @@ private:
     StatusWith<ShardEndpoint> _targetShardKey(const BSONObj& shardKey,
                                               const BSONObj& collation) const;
 
+    /**
+     * Returns the shard key of a document to insert into the sharded collection, or throws
+     * ShardKeyNotFound if the document's shard key cannot be targeted.
+     */
+    BSONObj _extractShardKeyForInsert(const BSONObj& doc) const;
+
     // Full namespace of the collection for this targeter
     NamespaceString _nss;
 
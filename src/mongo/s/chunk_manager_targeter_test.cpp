@@ -120,6 +120,37 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertWithRangePrefixHashedShardKey) {
                        ErrorCodes::ShardKeyNotFound);
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsInBatchMatchesTargetInsert) {
+    std::vector<BSONObj> splitPoints = {
+        BSON("a.b" << BSONNULL), BSON("a.b" << -100), BSON("a.b" << 0), BSON("a.b" << 100)};
+    auto cmTargeter = prepare(BSON("a.b" << 1 << "c.d"
+                                         << "hashed"),
+                              splitPoints);
+
+    // The documents are not in shard key order and include ones that cannot be targeted.
+    std::vector<BSONObj> docs = {fromjson("{a: {b: 1000}, c: null, d: {}}"),
+                                 fromjson("{a: {b: -111}, c: {d: '1'}}"),
+                                 fromjson("{a: [1,2]}"),
+                                 fromjson("{a: {b: 0}, c: {d: 4}}"),
+                                 fromjson("{a: {b: -10}}"),
+                                 BSONObj(),
+                                 fromjson("{a: {b: -10}, c: {d: 5}}")};
+
+    auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(docs.size(), endpoints.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        try {
+            auto expected = cmTargeter.targetInsert(operationContext(), docs[i]);
+            ASSERT_OK(endpoints[i].getStatus());
+            ASSERT_EQ(expected.shardName, endpoints[i].getValue().shardName);
+            ASSERT_EQ(*expected.shardVersion, *endpoints[i].getValue().shardVersion);
+        } catch (const DBException& ex) {
+            ASSERT_EQ(ex.code(), endpoints[i].getStatus().code());
+        }
+    }
+    ASSERT_EQ(ErrorCodes::ShardKeyNotFound, endpoints[2].getStatus());
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetInsertsWithVaryingHashedPrefixAndConstantRangedSuffix) {
     // Create 4 chunks and 4 shards such that shardId '0' has chunk [MinKey, -2^62), '1' has chunk
     // [-2^62, 0), '2' has chunk ['0', 2^62) and '3' has chunk [2^62, MaxKey).
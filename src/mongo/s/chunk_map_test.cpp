@@ -170,4 +170,61 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestMergeReplacesOnlyOverlappingChunks) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, Timestamp()};
+
+    const auto firstChunk =
+        std::make_shared<ChunkInfo>(ChunkType{uuid(),
+                                              ChunkRange{getShardKeyPattern().globalMin(),
+                                                         BSON("a" << 0)},
+                                              ChunkVersion{1, 0, epoch, Timestamp()},
+                                              kThisShard});
+    chunkMap = chunkMap.createMerged(
+        {firstChunk,
+         std::make_shared<ChunkInfo>(ChunkType{uuid(),
+                                               ChunkRange{BSON("a" << 0), BSON("a" << 100)},
+                                               ChunkVersion{1, 1, epoch, Timestamp()},
+                                               kThisShard}),
+         std::make_shared<ChunkInfo>(ChunkType{uuid(),
+                                               ChunkRange{BSON("a" << 100), BSON("a" << 200)},
+                                               ChunkVersion{1, 2, epoch, Timestamp()},
+                                               kThisShard}),
+         std::make_shared<ChunkInfo>(
+             ChunkType{uuid(),
+                       ChunkRange{BSON("a" << 200), getShardKeyPattern().globalMax()},
+                       ChunkVersion{1, 3, epoch, Timestamp()},
+                       kThisShard})});
+    ASSERT_EQ(chunkMap.size(), 4);
+
+    // Split [0, 100) and merge [100, 200) with [200, MaxKey).
+    auto newChunkMap = chunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(ChunkType{uuid(),
+                                               ChunkRange{BSON("a" << 0), BSON("a" << 50)},
+                                               ChunkVersion{2, 0, epoch, Timestamp()},
+                                               kThisShard}),
+         std::make_shared<ChunkInfo>(ChunkType{uuid(),
+                                               ChunkRange{BSON("a" << 50), BSON("a" << 100)},
+                                               ChunkVersion{2, 1, epoch, Timestamp()},
+                                               kThisShard}),
+         std::make_shared<ChunkInfo>(
+             ChunkType{uuid(),
+                       ChunkRange{BSON("a" << 100), getShardKeyPattern().globalMax()},
+                       ChunkVersion{2, 2, epoch, Timestamp()},
+                       kThisShard})});
+
+    ASSERT_EQ(newChunkMap.size(), 4);
+    ASSERT_EQ(newChunkMap.getVersion(), (ChunkVersion{2, 2, epoch, Timestamp()}));
+    ASSERT_EQ(newChunkMap.findIntersectingChunk(BSON("a" << -50)), firstChunk);
+
+    std::vector<BSONObj> expectedMaxes{
+        BSON("a" << 0), BSON("a" << 50), BSON("a" << 100), getShardKeyPattern().globalMax()};
+    size_t i = 0;
+    newChunkMap.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMax(), expectedMaxes[i++]);
+        return true;
+    });
+    ASSERT_EQ(i, expectedMaxes.size());
+}
+
 }  // namespace mongo
@@ -45,6 +45,56 @@ const std::set<std::string> supportedCmds{"collStats",
                                           "listCollections",
                                           "listIndexes",
                                           "planCacheListFilters"};
+
+// Aggregation stages which write, or which read from other collections or make the receiving node
+// open cursors on other nodes, and therefore make an aggregate unsafe to hedge.
+const std::set<StringData> unsupportedAggStages{"$changeStream"_sd,
+                                                "$graphLookup"_sd,
+                                                "$lookup"_sd,
+                                                "$merge"_sd,
+                                                "$mergeCursors"_sd,
+                                                "$out"_sd,
+                                                "$unionWith"_sd};
+
+/**
+ * Returns whether every stage of 'pipelineElem', including those of the sub-pipelines of $facet,
+ * only reads from the local node.
+ */
+bool isHedgeablePipeline(const BSONElement& pipelineElem) {
+    if (pipelineElem.type() != Array) {
+        return false;
+    }
+
+    for (auto&& stageElem : pipelineElem.Obj()) {
+        if (stageElem.type() != Object || stageElem.Obj().isEmpty()) {
+            return false;
+        }
+
+        auto stageSpec = stageElem.Obj().firstElement();
+        if (unsupportedAggStages.count(stageSpec.fieldNameStringData())) {
+            return false;
+        }
+        if (stageSpec.fieldNameStringData() == "$facet"_sd) {
+            if (stageSpec.type() != Object) {
+                return false;
+            }
+            for (auto&& facetElem : stageSpec.Obj()) {
+                if (!isHedgeablePipeline(facetElem)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns whether the given aggregate command can be hedged, which is the case when its pipeline
+ * only reads from the local node.
+ */
+bool isHedgeableAggregate(const BSONObj& cmdObj) {
+    return !cmdObj.hasField("exchange") && isHedgeablePipeline(cmdObj["pipeline"]);
+}
 }  // namespace
 
 boost::optional<executor::RemoteCommandRequestOnAny::HedgeOptions> extractHedgeOptions(
@@ -56,7 +106,7 @@ boost::optional<executor::RemoteCommandRequestOnAny::HedgeOptions> extractHedgeO
 
     auto cmdName(cmdObj.firstElement().fieldNameStringData().toString());
 
-    if (supportedCmds.count(cmdName)) {
+    if (supportedCmds.count(cmdName) || (cmdName == "aggregate" && isHedgeableAggregate(cmdObj))) {
         return executor::RemoteCommandRequestOnAny::HedgeOptions{1,
                                                                  gMaxTimeMSForHedgedReads.load()};
     }
@@ -124,8 +124,10 @@ TEST_F(HedgeOptionsUtilTestFixture, ImplicitOperationHedging) {
 
 TEST_F(HedgeOptionsUtilTestFixture, DenylistAggregate) {
     const auto parameters = BSONObj();
-    const auto cmdObj =
-        BSON("aggregate" << kCollName << "pipeline" << BSONObj() << "cursor" << BSONObj());
+    const auto cmdObj = BSON("aggregate" << kCollName << "pipeline"
+                                         << BSON_ARRAY(BSON("$out"
+                                                            << "targetColl"))
+                                         << "cursor" << BSONObj());
     const auto rspObj = BSON("mode"
                              << "nearest"
                              << "hedge" << BSONObj());
@@ -133,6 +135,63 @@ TEST_F(HedgeOptionsUtilTestFixture, DenylistAggregate) {
     checkHedgeOptions(parameters, cmdObj, rspObj, false);
 }
 
+TEST_F(HedgeOptionsUtilTestFixture, ReadOnlyAggregateHedging) {
+    const auto parameters = BSONObj();
+    const auto cmdObj = BSON("aggregate" << kCollName << "pipeline"
+                                         << BSON_ARRAY(BSON("$match" << BSON("x" << 1))
+                                                       << BSON("$group" << BSON("_id"
+                                                                                << "$y")))
+                                         << "cursor" << BSONObj());
+    const auto rspObj = BSON("mode"
+                             << "nearest"
+                             << "hedge" << BSONObj());
+
+    checkHedgeOptions(parameters, cmdObj, rspObj, true);
+}
+
+TEST_F(HedgeOptionsUtilTestFixture, DenylistAggregateWithWriteOrRemoteStages) {
+    const auto parameters = BSONObj();
+    const auto rspObj = BSON("mode"
+                             << "nearest"
+                             << "hedge" << BSONObj());
+
+    for (auto&& stage : {BSON("$out"
+                              << "targetColl"),
+                         BSON("$merge"
+                              << "targetColl"),
+                         BSON("$mergeCursors" << BSONObj()),
+                         BSON("$changeStream" << BSONObj()),
+                         BSON("$lookup" << BSON("from"
+                                                << "otherColl"
+                                                << "as"
+                                                << "joined"
+                                                << "pipeline" << BSONArray())),
+                         BSON("$graphLookup" << BSON("from"
+                                                     << "otherColl"
+                                                     << "startWith"
+                                                     << "$x"
+                                                     << "connectFromField"
+                                                     << "x"
+                                                     << "connectToField"
+                                                     << "y"
+                                                     << "as"
+                                                     << "graph")),
+                         BSON("$unionWith"
+                              << "otherColl"),
+                         BSON("$facet" << BSON("joined" << BSON_ARRAY(BSON("$unionWith"
+                                                                           << "otherColl"))))}) {
+        const auto cmdObj = BSON("aggregate" << kCollName << "pipeline"
+                                             << BSON_ARRAY(BSON("$match" << BSONObj()) << stage)
+                                             << "cursor" << BSONObj());
+        checkHedgeOptions(parameters, cmdObj, rspObj, false);
+    }
+
+    const auto exchangeCmdObj = BSON("aggregate" << kCollName << "pipeline" << BSONArray()
+                                                 << "exchange" << BSONObj() << "cursor"
+                                                 << BSONObj());
+    checkHedgeOptions(parameters, exchangeCmdObj, rspObj, false);
+}
+
 TEST_F(HedgeOptionsUtilTestFixture, DenylistMapReduce) {
     const auto parameters = BSONObj();
     const auto rspObj = BSON("mode"
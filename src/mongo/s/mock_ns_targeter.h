@@ -70,6 +70,19 @@ public:
         return endpoints.front();
     }
 
+    std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const override {
+        std::vector<StatusWith<ShardEndpoint>> endpoints;
+        for (const auto& doc : docs) {
+            try {
+                endpoints.emplace_back(targetInsert(opCtx, doc));
+            } catch (const DBException& ex) {
+                endpoints.emplace_back(ex.toStatus());
+            }
+        }
+        return endpoints;
+    }
+
     /**
      * Returns the first ShardEndpoint for the query from the mock ranges.  Only can handle
      * queries of the form { field : { $gte : <value>, $lt : <value> } }.
@@ -66,6 +66,7 @@
 #include "mongo/db/startup_warnings_common.h"
 #include "mongo/db/vector_clock_metadata_hook.h"
 #include "mongo/db/wire_version.h"
+#include "mongo/db/worker_pool.h"
 #include "mongo/executor/task_executor_pool.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/process_id.h"
@@ -351,6 +352,9 @@ void cleanupTask(const ShutdownTaskArgs& shutdownArgs) {
             }
         }
 
+        // The operations which used the worker thread pools are gone with the service entry point.
+        shutdownWorkerPools(serviceContext);
+
         // Shutdown Full-Time Data Capture
         stopMongoSFTDC();
     }
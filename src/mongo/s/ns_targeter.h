@@ -78,6 +78,13 @@ public:
      */
     virtual ShardEndpoint targetInsert(OperationContext* opCtx, const BSONObj& doc) const = 0;
 
+    /**
+     * Batched form of targetInsert. Returns the ShardEndpoint for each of 'docs', in the same
+     * order, or the error targetInsert would have thrown for it.
+     */
+    virtual std::vector<StatusWith<ShardEndpoint>> targetInserts(
+        OperationContext* opCtx, const std::vector<BSONObj>& docs) const = 0;
+
     /**
      * Returns a vector of ShardEndpoints for a potentially multi-shard update or throws
      * ShardKeyNotFound if 'updateOp' misses a shard key, but the type of update requires it.
@@ -57,7 +57,7 @@ namespace {
 const int kMaxNumFailedHostRetryAttempts = 3;
 
 /**
- * Returns the sort key out of the $sortKey metadata field in 'obj'. The sort key should be
+ * Returns the sort key held in the $sortKey metadata field 'key'. The sort key should be
  * formatted as an array with one value per field of the sort pattern:
  *  {..., $sortKey: [<firstSortKeyComponent>, <secondSortKeyComponent>, ...], ...}
  *
@@ -74,8 +74,7 @@ const int kMaxNumFailedHostRetryAttempts = 3;
  * and 'compareWholeSortKey'=true, this function will return
  *   {"": <value>}
  */
-BSONObj extractSortKey(BSONObj obj, bool compareWholeSortKey) {
-    auto key = obj[AsyncResultsMerger::kSortKeyField];
+BSONObj extractSortKey(BSONElement key, bool compareWholeSortKey) {
     invariant(key);
     if (compareWholeSortKey) {
         return key.wrap();
@@ -107,8 +106,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeQueue(MergingComparator(_remotes, _params.getSort().value_or(BSONObj()))),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
@@ -320,9 +318,7 @@ bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
     }
 
     auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
-    auto keyWeWantToReturn =
-        extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
+    const auto& keyWeWantToReturn = _remotes[smallestRemote].sortKeyBuffer.front();
     // We should always have a minPromisedSortKey from every shard in the sorted tailable case.
     auto minPromisedSortKey = _getMinPromisedSortKey(lk);
     invariant(minPromisedSortKey);
@@ -363,7 +359,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
@@ -378,7 +374,9 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     invariant(_remotes[smallestRemote].status.isOK());
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
+    BSONObj frontSortKey = _remotes[smallestRemote].sortKeyBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    _remotes[smallestRemote].sortKeyBuffer.pop();
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
@@ -389,11 +387,12 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
         if (_remotes[smallestRemote].eligibleForHighWaterMark) {
-            _highWaterMark =
-                extractSortKey(*front.getResult(), _params.getCompareWholeSortKey()).getOwned();
+            _highWaterMark = frontSortKey.getOwned();
         }
     }
 
+    _prefetchNextBatchIfLow(lk, smallestRemote);
+
     return front;
 }
 
@@ -487,6 +486,20 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
     return Status::OK();
 }
 
+void AsyncResultsMerger::_prefetchNextBatchIfLow(WithLock lk, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+    if (_tailableMode != TailableModeEnum::kNormal || _lifecycleState != kAlive || !_opCtx ||
+        remote.exhausted() || remote.cbHandle.isValid()) {
+        return;
+    }
+
+    if (remote.docBuffer.size() > remote.lastBatchSize / 2) {
+        return;
+    }
+
+    remote.status = _askForNextBatch(lk, remoteIndex);
+}
+
 Status AsyncResultsMerger::scheduleGetMores() {
     stdx::lock_guard<Latch> lk(_mutex);
     return _scheduleGetMores(lk);
@@ -732,10 +745,10 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
     // the error to the user. In order to avoid polluting the user's error message, we ignore such
     // errors with the expectation that all outstanding cursors will be closed promptly.
     if (_params.getAllowPartialResults() || remote.status == ErrorCodes::ExchangePassthrough) {
-        // Clear the results buffer and cursor id, and set 'partialResultsReturned' if appropriate.
+        // Clear the cursor id, and set 'partialResultsReturned' if appropriate. Any results still
+        // buffered from a batch that was prefetched before this failure are left in place to be
+        // returned; for a sorted merge, this remote may still be on the merge queue.
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
-        std::queue<ClusterQueryResult> emptyBuffer;
-        std::swap(remote.docBuffer, emptyBuffer);
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -791,6 +804,7 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
     _updateRemoteMetadata(lk, remoteIndex, response);
+    const bool wasEmpty = !remote.hasNext();
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
         if (_params.getSort()) {
@@ -808,16 +822,19 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                          << "' was not of type Object in document: " << obj);
                 return false;
             }
+            remote.sortKeyBuffer.push(extractSortKey(key, _params.getCompareWholeSortKey()));
         }
 
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
         ++remote.fetchedCount;
     }
+    remote.lastBatchSize = response.getBatch().size();
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
+    // queue. A remote which already had buffered results is in the queue already; appending to its
+    // buffer does not change its front result, so its position in the queue remains valid.
+    if (_params.getSort() && wasEmpty && remote.hasNext()) {
         _mergeQueue.push(remoteIndex);
     }
     return true;
@@ -925,12 +942,8 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 //
 
 bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
-
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+    return compareSortKeys(
+               _remotes[lhs].sortKeyBuffer.front(), _remotes[rhs].sortKeyBuffer.front(), _sort) > 0;
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
@@ -306,6 +306,15 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // For sorted merges, the sort key of each result in 'docBuffer', in the same order. These
+        // are extracted once when the batch is buffered so that the merging comparator does not
+        // have to search each document for its $sortKey on every comparison.
+        std::queue<BSONObj> sortKeyBuffer;
+
+        // The number of results in the most recently received batch. Used to decide when to
+        // prefetch the next batch for a sorted merge.
+        size_t lastBatchSize = 0;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -323,10 +332,8 @@ private:
 
     class MergingComparator {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+        MergingComparator(const std::vector<RemoteCursorData>& remotes, const BSONObj& sort)
+            : _remotes(remotes), _sort(sort) {}
 
         bool operator()(const size_t& lhs, const size_t& rhs);
 
@@ -334,11 +341,6 @@ private:
         const std::vector<RemoteCursorData>& _remotes;
 
         const BSONObj _sort;
-
-        // When '_compareWholeSortKey' is true, $sortKey is a scalar value, rather than an object.
-        // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
-        // be {$sortKey: 1}.
-        const bool _compareWholeSortKey;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -373,6 +375,16 @@ private:
      */
     Status _askForNextBatch(WithLock, size_t remoteIndex);
 
+    /**
+     * For non-tailable sorted merges, schedules the next getMore for the remote at 'remoteIndex'
+     * once its buffer has drained to half of its last batch, rather than waiting for it to empty.
+     * A sorted merge cannot return anything while any non-exhausted remote has an empty buffer, so
+     * fetching ahead keeps the slowest shard from stalling the whole merge on each batch boundary.
+     *
+     * Any error scheduling the request is stored in the remote's status.
+     */
+    void _prefetchNextBatchIfLow(WithLock, size_t remoteIndex);
+
     /**
      * Checks whether or not the remote cursors are all exhausted.
      */
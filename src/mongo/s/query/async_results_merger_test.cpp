@@ -440,6 +440,61 @@ TEST_F(AsyncResultsMergerTest, CompoundSortKey) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SortedMergePrefetchesBeforeBufferDrains) {
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<BSONObj> firstBatch = {fromjson("{$sortKey: [1]}"),
+                                       fromjson("{$sortKey: [2]}"),
+                                       fromjson("{$sortKey: [3]}"),
+                                       fromjson("{$sortKey: [4]}")};
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, std::move(firstBatch))));
+    cursors.push_back(makeRemoteCursor(kTestShardIds[1],
+                                       kTestShardHosts[1],
+                                       CursorResponse(kTestNss, 0, {fromjson("{$sortKey: [10]}")})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+
+    // With three of the four results still buffered, nothing is requested yet.
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // Once the buffer has drained to half of the batch, the next getMore is sent even though there
+    // are still results left to return.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [2]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_TRUE(arm->ready());
+
+    // The prefetched batch is appended behind the results which are still buffered.
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch = {fromjson("{$sortKey: [5]}"), fromjson("{$sortKey: [11]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch);
+    scheduleNetworkResponses(std::move(responses));
+
+    for (int expected : {3, 4}) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("$sortKey" << BSON_ARRAY(expected)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+
+    // Wait for the prefetched batch to be processed. No further getMore is needed.
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+    executor()->waitForEvent(readyEvent);
+    ASSERT_FALSE(networkHasReadyRequests());
+    ASSERT_TRUE(arm->remotesExhausted());
+    for (int expected : {5, 10, 11}) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("$sortKey" << BSON_ARRAY(expected)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
 TEST_F(AsyncResultsMergerTest, SortedButNoSortKey) {
     BSONObj findCmd = fromjson("{find: 'testcoll', sort: {a: -1, b: 1}}");
     std::vector<RemoteCursor> cursors;
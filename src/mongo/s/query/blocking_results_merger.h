@@ -84,6 +84,14 @@ public:
         _arm.addNewShardCursors(std::move(newCursors));
     }
 
+    /**
+     * Asks every remote which has no buffered results to start producing its next batch, without
+     * waiting for the responses. A later call to next() picks up the buffered batches.
+     */
+    Status scheduleGetMores() {
+        return _arm.scheduleGetMores();
+    }
+
     /**
      * Blocks until '_arm' has been killed, which involves cleaning up any remote cursors managed
      * by this results merger.
@@ -34,6 +34,7 @@
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
 
+#include <algorithm>
 #include <set>
 
 #include "mongo/db/curop.h"
@@ -159,12 +160,15 @@ ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
 ClusterCursorManager::~ClusterCursorManager() {
     invariant(_cursorIdPrefixToNamespaceMap.empty());
     invariant(_namespaceToContainerMap.empty());
+    invariant(_cursorEntries.empty());
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
     {
+        // Registration checks the flag under '_mutex', so once it is set here no new cursor can
+        // make it into '_cursorEntries' behind the back of killAllCursors().
         stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
+        _inShutdown.store(true);
     }
     killAllCursors(opCtx);
 }
@@ -182,7 +186,7 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     stdx::unique_lock<Latch> lk(_mutex);
     _log.push({LogEvent::Type::kRegisterAttempt, boost::none, now, nss});
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         lk.unlock();
         cursor->kill(opCtx);
         return Status(ErrorCodes::ShutdownInProgress,
@@ -216,30 +220,39 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
 
         nsToContainerIt = emplaceResult.first;
     } else {
-        invariant(!nsToContainerIt->second.entryMap.empty());  // If exists, shouldn't be empty.
+        invariant(nsToContainerIt->second.numCursors > 0);  // If exists, shouldn't be empty.
     }
     CursorEntryContainer& container = nsToContainerIt->second;
 
-    // Generate a CursorId (which can't be the invalid value zero).
-    CursorEntryMap& entryMap = container.entryMap;
-    CursorId cursorId = 0;
-    do {
+    // Generate a CursorId (which can't be the invalid value zero). Holding '_mutex' keeps other
+    // registrations out, and the partition lock is held from the uniqueness check until the new
+    // CursorEntry is inserted.
+    while (true) {
         const uint32_t cursorSuffix = static_cast<uint32_t>(_pseudoRandom.nextInt32());
-        cursorId = createCursorId(container.containerPrefix, cursorSuffix);
-    } while (cursorId == 0 || entryMap.count(cursorId) > 0);
+        const CursorId cursorId = createCursorId(container.containerPrefix, cursorSuffix);
+        if (cursorId == 0) {
+            continue;
+        }
 
-    // Create a new CursorEntry and register it in the CursorEntryContainer's map.
-    auto emplaceResult = entryMap.emplace(cursorId,
-                                          CursorEntry(std::move(cursor),
-                                                      cursorType,
-                                                      cursorLifetime,
-                                                      now,
-                                                      authenticatedUsers,
-                                                      opCtx->getOperationKey()));
-    invariant(emplaceResult.second);
-    _log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
+        auto partition = _cursorEntries.lockOnePartition(cursorId);
+        if (partition->count(cursorId) > 0) {
+            continue;
+        }
 
-    return cursorId;
+        auto emplaceResult = partition->emplace(cursorId,
+                                                CursorEntry(std::move(cursor),
+                                                            nss,
+                                                            cursorType,
+                                                            cursorLifetime,
+                                                            now,
+                                                            authenticatedUsers,
+                                                            opCtx->getOperationKey()));
+        invariant(emplaceResult.second);
+        ++container.numCursors;
+        _log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
+
+        return cursorId;
+    }
 }
 
 StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCursor(
@@ -248,17 +261,13 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     OperationContext* opCtx,
     AuthzCheckFn authChecker,
     AuthCheck checkSessionAuth) {
-    const auto now = _clockSource->now();
-
-    stdx::lock_guard<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
-
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    auto partition = _cursorEntries.lockOnePartition(cursorId);
+    CursorEntry* entry = _getEntry(partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -297,7 +306,6 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
 
     CurOp::get(opCtx)->debug().queryHash = cursorGuard->getQueryHash();
 
-    _log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
     return PinnedCursor(this, std::move(cursorGuard), nss, cursorId);
 }
 
@@ -315,10 +323,8 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckInAttempt, cursorId, now, nss});
-
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    auto partition = _cursorEntries.lockOnePartition(cursorId);
+    CursorEntry* entry = _getEntry(partition, nss, cursorId);
     invariant(entry);
 
     // killPending will be true if killCursor() was called while the cursor was in use.
@@ -328,22 +334,21 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     entry->returnCursor(std::move(cursor));
 
     if (cursorState == CursorState::NotExhausted && !killPending) {
-        _log.push({LogEvent::Type::kCheckInCompleteCursorSaved, cursorId, now, nss});
         // The caller may need the cursor again.
         return;
     }
 
     // After detaching the cursor, the entry will be destroyed.
     entry = nullptr;
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(partition), opCtx, cursorId);
 }
 
 Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      const NamespaceString& nss,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
-    auto entry = _getEntry(lk, nss, cursorId);
+    auto partition = _cursorEntries.lockOnePartition(cursorId);
+    auto entry = _getEntry(partition, nss, cursorId);
 
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
@@ -354,7 +359,7 @@ Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
     return authChecker(entry->getAuthenticatedUsers());
 }
 
-void ClusterCursorManager::killOperationUsingCursor(WithLock, CursorEntry* entry) {
+void ClusterCursorManager::killOperationUsingCursor(CursorEntry* entry) {
     invariant(entry->getOperationUsingCursor());
     // Interrupt any operation currently using the cursor.
     OperationContext* opUsingCursor = entry->getOperationUsingCursor();
@@ -370,12 +375,8 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
                                         CursorId cursorId) {
     invariant(opCtx);
 
-    const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    _log.push({LogEvent::Type::kKillCursorAttempt, cursorId, now, nss});
-
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    auto partition = _cursorEntries.lockOnePartition(cursorId);
+    CursorEntry* entry = _getEntry(partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -385,34 +386,46 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     if (opUsingCursor) {
         // The caller shouldn't need to call killCursor on their own cursor.
         invariant(opUsingCursor != opCtx, "Cannot call killCursor() on your own cursor");
-        killOperationUsingCursor(lk, entry);
+        killOperationUsingCursor(entry);
         return Status::OK();
     }
 
     // No one is using the cursor, so we destroy it.
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(partition), opCtx, cursorId);
 
     // We no longer hold the lock here.
 
     return Status::OK();
 }
 
-void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
+void ClusterCursorManager::detachAndKillCursor(PartitionedCursorEntryMap::OnePartition&& partition,
                                                OperationContext* opCtx,
-                                               const NamespaceString& nss,
                                                CursorId cursorId) {
-    auto detachedCursorGuard = _detachCursor(lk, opCtx, nss, cursorId);
-    invariant(detachedCursorGuard.getStatus());
+    auto [nss, cursorGuard] = [&] {
+        // Take over the partition lock so that it is released at the end of this scope.
+        auto lockedPartition = std::move(partition);
+        auto it = lockedPartition->find(cursorId);
+        invariant(it != lockedPartition->end());
+
+        // Transfer ownership away from the entry, then destroy the entry.
+        auto nss = it->second.getNamespace();
+        auto cursorGuard = it->second.releaseCursor(opCtx);
+        lockedPartition->erase(it);
+        return std::make_pair(std::move(nss), std::move(cursorGuard));
+    }();
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _releaseNamespaces(lk, {nss});
+    }
 
     // Deletion of the cursor can happen out of the lock.
-    lk.unlock();
-    detachedCursorGuard.getValue()->kill(opCtx);
+    cursorGuard->kill(opCtx);
 }
 
 std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContext* opCtx,
                                                                  Date_t cutoff) {
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
 
     auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
         if (entry.getLifetimeType() == CursorLifetime::Immortal ||
@@ -433,35 +446,29 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    return killCursorsSatisfying(opCtx, std::move(pred), now);
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
     auto pred = [](CursorId, const CursorEntry&) -> bool { return true; };
 
-    killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    killCursorsSatisfying(opCtx, std::move(pred), now);
 }
 
 std::size_t ClusterCursorManager::killCursorsSatisfying(
-    stdx::unique_lock<Latch> lk,
     OperationContext* opCtx,
     std::function<bool(CursorId, const CursorEntry&)> pred,
     Date_t now) {
     invariant(opCtx);
-    invariant(lk.owns_lock());
     std::size_t nKilled = 0;
 
-    _log.push(
-        {LogEvent::Type::kRemoveCursorsSatisfyingPredicateAttempt, boost::none, now, boost::none});
-
     std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto nsContainerIt = _namespaceToContainerMap.begin();
-    while (nsContainerIt != _namespaceToContainerMap.end()) {
-        auto&& entryMap = nsContainerIt->second.entryMap;
-        auto cursorIdEntryIt = entryMap.begin();
-        while (cursorIdEntryIt != entryMap.end()) {
+    std::vector<NamespaceString> namespacesToRelease;
+    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _cursorEntries.lockOnePartitionById(partitionId);
+        auto cursorIdEntryIt = partition->begin();
+        while (cursorIdEntryIt != partition->end()) {
             auto cursorId = cursorIdEntryIt->first;
             auto& entry = cursorIdEntryIt->second;
 
@@ -474,44 +481,32 @@ std::size_t ClusterCursorManager::killCursorsSatisfying(
 
             if (entry.getOperationUsingCursor()) {
                 // Mark the OperationContext using the cursor as killed, and move on.
-                killOperationUsingCursor(lk, &entry);
+                killOperationUsingCursor(&entry);
                 ++cursorIdEntryIt;
                 continue;
             }
 
-            _log.push({LogEvent::Type::kCursorMarkedForDeletionBySatisfyingPredicate,
-                       cursorId,
-                       // While we collected 'now' above, we ran caller-provided predicates which
-                       // may have been expensive. To avoid re-reading from the clock while the
-                       // lock is held, we do not provide a value for 'now' in this log entry.
-                       boost::none,
-                       nsContainerIt->first});
-
+            namespacesToRelease.push_back(entry.getNamespace());
             cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
 
             // Destroy the entry and set the iterator to the next element.
-            entryMap.erase(cursorIdEntryIt++);
-        }
-
-        if (entryMap.empty()) {
-            nsContainerIt = eraseContainer(nsContainerIt);
-        } else {
-            ++nsContainerIt;
+            partition->erase(cursorIdEntryIt++);
         }
     }
 
-    _log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
-               boost::none,
-               // While we collected 'now' above, we ran caller-provided predicates which may have
-               // been expensive. To avoid re-reading from the clock while the lock is held, we do
-               // not provide a value for 'now' in this log entry.
-               boost::none,
-               boost::none});
+    if (!namespacesToRelease.empty()) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
+                   boost::none,
+                   // While we collected 'now' above, we ran caller-provided predicates which may
+                   // have been expensive, so this entry is not given a time either.
+                   boost::none,
+                   boost::none});
+        _releaseNamespaces(lk, namespacesToRelease);
+    }
 
     // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
     // finish.
-    lk.unlock();
-
     for (auto&& cursorGuard : cursorsToDestroy) {
         invariant(cursorGuard);
         cursorGuard->kill(opCtx);
@@ -521,12 +516,11 @@ std::size_t ClusterCursorManager::killCursorsSatisfying(
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     Stats stats;
 
-    for (auto& nsContainerPair : _namespaceToContainerMap) {
-        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _cursorEntries.lockOnePartitionById(partitionId);
+        for (auto& cursorIdEntryPair : *partition) {
             const CursorEntry& entry = cursorIdEntryPair.second;
 
             if (entry.isKillPending()) {
@@ -554,10 +548,9 @@ ClusterCursorManager::Stats ClusterCursorManager::stats() const {
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _cursorEntries.lockOnePartitionById(partitionId);
+        for (const auto& cursorIdEntryPair : *partition) {
             const CursorEntry& entry = cursorIdEntryPair.second;
 
             if (entry.isKillPending()) {
@@ -573,12 +566,11 @@ void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) cons
     }
 }
 
-GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(
-    CursorId cursorId, const NamespaceString& ns) const {
+GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(CursorId cursorId) const {
     invariant(_cursor);
     GenericCursor gc;
     gc.setCursorId(cursorId);
-    gc.setNs(ns);
+    gc.setNs(_nss);
     gc.setCreatedDate(_cursor->getCreatedDate());
     gc.setLastAccessDate(_cursor->getLastUseDate());
     gc.setLsid(_cursor->getLsid());
@@ -595,12 +587,11 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
-
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _cursorEntries.lockOnePartitionById(partitionId);
+        for (const auto& cursorIdEntryPair : *partition) {
 
             const CursorEntry& entry = cursorIdEntryPair.second;
             // If auth is enabled, and userMode is allUsers, check if the current user has
@@ -615,8 +606,7 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
                 continue;
             }
 
-            cursors.emplace_back(
-                entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
+            cursors.emplace_back(entry.cursorToGenericCursor(cursorIdEntryPair.first));
         }
     }
 
@@ -644,12 +634,11 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& nsContainerPair : _namespaceToContainerMap) {
-        for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
+    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _cursorEntries.lockOnePartitionById(partitionId);
+        for (auto&& [cursorId, entry] : *partition) {
             if (entry.isKillPending()) {
                 // Don't include sessions for killed cursors.
                 continue;
@@ -667,24 +656,22 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
     std::vector<OperationKey> opKeys) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
     // While we could maintain a cached mapping of OperationKey to CursorID to increase performance,
     // this approach was chosen given that 1) mongos will not have as many open cursors as a shard
     // and 2) mongos performance has historically not been a bottleneck.
-    for (auto&& opKey : opKeys) {
-        for (auto&& nsContainerPair : _namespaceToContainerMap) {
-            for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
-                if (entry.isKillPending()) {
-                    // Don't include any killed cursors.
-                    continue;
-                }
-
-                if (opKey == entry.getOperationKey()) {
-                    cursorIds.insert(cursorId);
-                }
+    for (size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _cursorEntries.lockOnePartitionById(partitionId);
+        for (auto&& [cursorId, entry] : *partition) {
+            if (entry.isKillPending()) {
+                // Don't include any killed cursors.
+                continue;
+            }
+
+            auto opKey = entry.getOperationKey();
+            if (opKey && std::find(opKeys.begin(), opKeys.end(), *opKey) != opKeys.end()) {
+                cursorIds.insert(cursorId);
             }
         }
     }
@@ -703,27 +690,34 @@ boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     return it->second;
 }
 
-auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, CursorId cursorId)
-    -> CursorEntry* {
-
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
-        return nullptr;
-    }
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
-    auto entryMapIt = entryMap.find(cursorId);
-    if (entryMapIt == entryMap.end()) {
+auto ClusterCursorManager::_getEntry(const PartitionedCursorEntryMap::OnePartition& partition,
+                                     const NamespaceString& nss,
+                                     CursorId cursorId) -> CursorEntry* {
+    auto entryMapIt = partition->find(cursorId);
+    if (entryMapIt == partition->end() || entryMapIt->second.getNamespace() != nss) {
         return nullptr;
     }
 
     return &entryMapIt->second;
 }
 
-auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
+void ClusterCursorManager::_releaseNamespaces(WithLock lk,
+                                              const std::vector<NamespaceString>& namespaces) {
+    for (auto&& nss : namespaces) {
+        auto nsToContainerIt = _namespaceToContainerMap.find(nss);
+        invariant(nsToContainerIt != _namespaceToContainerMap.end());
+        auto& numCursors = nsToContainerIt->second.numCursors;
+        invariant(numCursors > 0);
+        if (--numCursors == 0) {
+            eraseContainer(lk, nsToContainerIt);
+        }
+    }
+}
+
+auto ClusterCursorManager::eraseContainer(WithLock, NssToCursorContainerMap::iterator it)
     -> NssToCursorContainerMap::iterator {
     auto&& container = it->second;
-    auto&& entryMap = container.entryMap;
-    invariant(entryMap.empty());
+    invariant(container.numCursors == 0);
 
     // This was the last cursor remaining in the given namespace.  Erase all state associated
     // with this namespace.
@@ -753,38 +747,6 @@ auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
     return it;
 }
 
-StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLock lk,
-                                                                         OperationContext* opCtx,
-                                                                         const NamespaceString& nss,
-                                                                         CursorId cursorId) {
-    _log.push({LogEvent::Type::kDetachAttempt, cursorId, boost::none, nss});
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
-    if (!entry) {
-        return cursorNotFoundStatus(nss, cursorId);
-    }
-
-    if (entry->getOperationUsingCursor()) {
-        return cursorInUseStatus(nss, cursorId);
-    }
-
-    // Transfer ownership away from the entry.
-    ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
-
-    // Destroy the entry.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    invariant(nsToContainerIt != _namespaceToContainerMap.end());
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
-    size_t eraseResult = entryMap.erase(cursorId);
-    invariant(1 == eraseResult);
-    if (entryMap.empty()) {
-        eraseContainer(nsToContainerIt);
-    }
-
-    _log.push({LogEvent::Type::kDetachComplete, cursorId, boost::none, nss});
-
-    return std::move(cursor);
-}
-
 void ClusterCursorManager::logCursorManagerInfo() const {
     LOGV2_ERROR_OPTIONS(4786900,
                         logv2::LogTruncation::Disabled,
@@ -802,16 +764,8 @@ std::string ClusterCursorManager::LogEvent::typeToString(ClusterCursorManager::L
     const static stdx::unordered_map<LogEvent::Type, std::string> kMap = {
         {Type::kRegisterAttempt, "registerAttempt"},
         {Type::kRegisterComplete, "registerComplete"},
-        {Type::kCheckoutAttempt, "checkoutAttempt"},
-        {Type::kCheckoutComplete, "checkoutComplete"},
-        {Type::kCheckInAttempt, "checkInAttempt"},
-        {Type::kCheckInCompleteCursorSaved, "checkInCompleteCursorSaved"},
-        {Type::kDetachAttempt, "detachAttempt"},
-        {Type::kDetachComplete, "detachComplete"},
         {Type::kNamespaceEntryMapErased, "namespaceEntryMapErased"},
-        {Type::kRemoveCursorsSatisfyingPredicateAttempt, "killCursorsSatisfyingPredicateAttempt"},
         {Type::kRemoveCursorsSatisfyingPredicateComplete, "killCursorsSatisfyingPredicateComplete"},
-        {Type::kKillCursorAttempt, "killCursorAttempt"},
     };
 
     if (auto it = kMap.find(t); it != kMap.end()) {
@@ -829,12 +783,7 @@ BSONObj ClusterCursorManager::dumpNssToContainerMap() const {
             BSONObjBuilder nssBob(nssToContainer.subobjStart(nss.toString()));
             nssBob.appendNumber("containerPrefix",
                                 static_cast<long long>(cursorContainer.containerPrefix));
-            BSONArrayBuilder cursors(nssBob.subarrayStart("cursors"));
-            for (auto&& [cursorId, cursorEntry] : cursorContainer.entryMap) {
-                BSONObjBuilder cursorBob(cursors.subobjStart());
-                cursorBob.appendNumber("id", cursorId);
-                cursorBob.append("lastActive", cursorEntry.getLastActive());
-            }
+            nssBob.appendNumber("numCursors", static_cast<long long>(cursorContainer.numCursors));
         }
     }
     return bob.obj();
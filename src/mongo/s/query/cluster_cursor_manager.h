@@ -33,11 +33,13 @@
 #include <utility>
 #include <vector>
 
+#include "mongo/db/catalog/util/partitioned.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/generic_cursor.h"
 #include "mongo/db/kill_sessions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
@@ -68,6 +70,11 @@ class StatusWith;
  * The manager supports killing of registered cursors, either through the PinnedCursor object or
  * with the kill*() suite of methods.
  *
+ * Registered cursors are kept in a map that is partitioned by cursor id, and each partition is
+ * protected by its own latch, so that checking cursors in and out on different partitions does not
+ * contend. A separate mutex protects cursor id generation and the per-namespace bookkeeping, and is
+ * only taken when a cursor is registered or destroyed.
+ *
  * No public methods throw exceptions, and all public methods are thread-safe.
  */
 class ClusterCursorManager {
@@ -389,44 +396,26 @@ public:
 private:
     class CursorEntry;
     struct CursorEntryContainer;
+
+    static constexpr std::size_t kNumPartitions = 16;
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
+    using PartitionedCursorEntryMap = Partitioned<CursorEntryMap, kNumPartitions>;
     using NssToCursorContainerMap = stdx::unordered_map<NamespaceString, CursorEntryContainer>;
 
     // Internal, fixed size log of events cursor manager. This has been added to help diagnose
-    // SERVER-27796.
+    // SERVER-27796. Only events which happen under '_mutex' are recorded, so checking cursors in
+    // and out does not touch the log.
     struct LogEvent {
         enum class Type {
             kRegisterAttempt,   // Any attempt to create a cursor.
             kRegisterComplete,  // A cursor actually being created.
 
-            // Checking out a cursor.
-            kCheckoutAttempt,
-            kCheckoutComplete,
-
-            // Caller attempts to check a cursor in. This event may be followed by a
-            // kCheckInCompleteCursorSaved, or by events which indicate the cursor is deleted.
-            kCheckInAttempt,
-
-            // Logged when the check-in is successful and the cursor is kept.
-            kCheckInCompleteCursorSaved,
-
-            // Detaching a cursor (and erasing associated namespace).
-            kDetachAttempt,
-            kDetachComplete,
+            // The last cursor on a namespace was destroyed, and the namespace was erased.
             kNamespaceEntryMapErased,
 
-            // These mark the beginning and end of the period where
-            // killCursorsSatisfyingPredicate() holds a lock.
-            kRemoveCursorsSatisfyingPredicateAttempt,
+            // killCursorsSatisfying() releases the namespaces of the cursors it destroyed.
             kRemoveCursorsSatisfyingPredicateComplete,
 
-            // Any call to killCursor().
-            kKillCursorAttempt,
-
-            // Represents each time killCursorsSatisfyingPredicate() detaches a cursor that it
-            // intends to destroy.
-            kCursorMarkedForDeletionBySatisfyingPredicate,
-
             //
             // NOTE: If you ever add to this enum be sure to update the typeToString() method
             // below.
@@ -477,48 +466,43 @@ private:
                        CursorState cursorState);
 
     /**
-     * Will detach a cursor, release the lock and then call kill() on it.
+     * De-registers the given cursor, which must be registered in 'partition' and must not be
+     * pinned, releases the partition lock and then calls kill() on it.
      */
-    void detachAndKillCursor(stdx::unique_lock<Latch> lk,
+    void detachAndKillCursor(PartitionedCursorEntryMap::OnePartition&& partition,
                              OperationContext* opCtx,
-                             const NamespaceString& nss,
                              CursorId cursorId);
 
     /**
-     * Returns a pointer to the CursorEntry for the given cursor.  If the given cursor is not
-     * registered, returns null.
-     *
-     * Not thread-safe.
+     * Returns a pointer to the CursorEntry for the given cursor, looked up in the locked
+     * 'partition' which 'cursorId' maps to.  If the given cursor is not registered on 'nss',
+     * returns null.
      */
-    CursorEntry* _getEntry(WithLock, NamespaceString const& nss, CursorId cursorId);
+    CursorEntry* _getEntry(const PartitionedCursorEntryMap::OnePartition& partition,
+                           const NamespaceString& nss,
+                           CursorId cursorId);
 
     /**
-     * De-registers the given cursor, and returns an owned pointer to the underlying
-     * ClusterClientCursor object.
-     *
-     * If the given cursor is pinned, returns an error Status with code CursorInUse.  If the given
-     * cursor is not registered, returns an error Status with code CursorNotFound.
-     *
-     * Not thread-safe.
+     * Drops one cursor from the count of each namespace in 'namespaces', erasing the namespace once
+     * it has no cursors left. Must be called after the cursors have been removed from their
+     * partitions, and without holding any partition lock.
      */
-    StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
-                                                       OperationContext* opCtx,
-                                                       const NamespaceString& nss,
-                                                       CursorId cursorId);
+    void _releaseNamespaces(WithLock, const std::vector<NamespaceString>& namespaces);
 
     /**
-     * Flags the OperationContext that's using the given cursor as interrupted.
+     * Flags the OperationContext that's using the given cursor as interrupted. The caller must
+     * hold the lock on the partition which owns 'entry'.
      */
-    void killOperationUsingCursor(WithLock, CursorEntry* entry);
+    void killOperationUsingCursor(CursorEntry* entry);
 
     /**
-     * Kill the cursors satisfying the given predicate. Assumes that 'lk' is held upon entry. The
-     * 'now' parameter is only used for the internal logging mechansim.
+     * Kill the cursors satisfying the given predicate. Partitions are locked and swept one at a
+     * time, so the sweep never blocks operations on more than one partition at once. The 'now'
+     * parameter is only used for the internal logging mechansim.
      *
      * Returns the number of cursors killed.
      */
-    std::size_t killCursorsSatisfying(stdx::unique_lock<Latch> lk,
-                                      OperationContext* opCtx,
+    std::size_t killCursorsSatisfying(OperationContext* opCtx,
                                       std::function<bool(CursorId, const CursorEntry&)> pred,
                                       Date_t now);
 
@@ -533,12 +517,14 @@ private:
         CursorEntry() = default;
 
         CursorEntry(std::unique_ptr<ClusterClientCursor> cursor,
+                    NamespaceString nss,
                     CursorType cursorType,
                     CursorLifetime cursorLifetime,
                     Date_t lastActive,
                     UserNameIterator authenticatedUsersIter,
                     boost::optional<OperationKey> opKey)
             : _cursor(std::move(cursor)),
+              _nss(std::move(nss)),
               _cursorType(cursorType),
               _cursorLifetime(cursorLifetime),
               _lastActive(lastActive),
@@ -564,6 +550,10 @@ private:
             return _operationUsingCursor->isKillPending();
         }
 
+        const NamespaceString& getNamespace() const {
+            return _nss;
+        }
+
         CursorType getCursorType() const {
             return _cursorType;
         }
@@ -602,11 +592,11 @@ private:
 
         /**
          * Creates a generic cursor from the cursor inside this entry. Should only be called on
-         * idle cursors. The caller must supply the cursorId and namespace because the CursorEntry
-         * does not have access to them.  Cannot be called if this CursorEntry does not own an
-         * underlying ClusterClientCursor.
+         * idle cursors. The caller must supply the cursorId because the CursorEntry does not have
+         * access to it.  Cannot be called if this CursorEntry does not own an underlying
+         * ClusterClientCursor.
          */
-        GenericCursor cursorToGenericCursor(CursorId cursorId, const NamespaceString& ns) const;
+        GenericCursor cursorToGenericCursor(CursorId cursorId) const;
 
         OperationContext* getOperationUsingCursor() const {
             return _operationUsingCursor;
@@ -635,6 +625,7 @@ private:
 
     private:
         std::unique_ptr<ClusterClientCursor> _cursor;
+        NamespaceString _nss;
         CursorType _cursorType = CursorType::SingleTarget;
         CursorLifetime _cursorLifetime = CursorLifetime::Mortal;
         Date_t _lastActive;
@@ -651,8 +642,9 @@ private:
     };
 
     /**
-     * CursorEntryContainer is a moveable, non-copyable container for a set of cursors, where all
-     * contained cursors share the same 32-bit prefix of their cursor id.
+     * CursorEntryContainer is a moveable, non-copyable record of the cursors registered on one
+     * namespace, all of which share the same 32-bit prefix of their cursor id. The cursors
+     * themselves live in '_cursorEntries'.
      */
     struct CursorEntryContainer {
         CursorEntryContainer(const CursorEntryContainer&) = delete;
@@ -666,15 +658,16 @@ private:
         // Common cursor id prefix for all cursors in this container.
         uint32_t containerPrefix;
 
-        // Map from cursor id to cursor entry.
-        CursorEntryMap entryMap;
+        // Number of registered cursors on this namespace.
+        size_t numCursors = 0;
     };
 
     /**
      * Erase the container that 'it' points to and return an iterator to the next one. Assumes 'it'
      * is an iterator in '_namespaceToContainerMap'.
      */
-    NssToCursorContainerMap::iterator eraseContainer(NssToCursorContainerMap::iterator it);
+    NssToCursorContainerMap::iterator eraseContainer(WithLock,
+                                                     NssToCursorContainerMap::iterator it);
 
     /**
      * Functions which dump the state/history of the cursor manager into a BSONObj for debug
@@ -694,10 +687,16 @@ private:
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
+    // Map from cursor id to cursor entry, partitioned by cursor id. Each partition is protected by
+    // its own latch.
+    mutable PartitionedCursorEntryMap _cursorEntries;
+
+    // Synchronizes access to the private state variables below, except '_inShutdown' which is only
+    // written with '_mutex' held. Lock ordering: '_mutex' may be acquired before a partition of
+    // '_cursorEntries', but must never be acquired while holding a partition lock.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
 
-    bool _inShutdown{false};
+    AtomicWord<bool> _inShutdown{false};
 
     // Randomness source.  Used for cursor id generation.
     const int64_t _randomSeed;
@@ -791,6 +791,35 @@ TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdMultipleCursorsDifferent
     }
 }
 
+// Test that sweeping cursors spread over many namespaces, and hence over every partition, kills
+// each of them and forgets the namespaces once their last cursor is gone.
+TEST_F(ClusterCursorManagerTest, KillMortalCursorsInactiveSinceReleasesNamespaces) {
+    const size_t numNamespaces = 20;
+    const size_t numCursorsPerNamespace = 5;
+    std::vector<CursorId> cursorIds;
+    for (size_t i = 0; i < numNamespaces; ++i) {
+        NamespaceString cursorNamespace(std::string(str::stream() << "test.collection" << i));
+        for (size_t j = 0; j < numCursorsPerNamespace; ++j) {
+            cursorIds.push_back(assertGet(
+                getManager()->registerCursor(_opCtx.get(),
+                                             allocateMockCursor(),
+                                             cursorNamespace,
+                                             ClusterCursorManager::CursorType::SingleTarget,
+                                             ClusterCursorManager::CursorLifetime::Mortal,
+                                             UserNameIterator())));
+        }
+    }
+    ASSERT_EQ(numNamespaces * numCursorsPerNamespace, getManager()->stats().cursorsSingleTarget);
+
+    ASSERT_EQ(numNamespaces * numCursorsPerNamespace,
+              getManager()->killMortalCursorsInactiveSince(_opCtx.get(), getClockSource()->now()));
+    for (size_t i = 0; i < cursorIds.size(); ++i) {
+        ASSERT(isMockCursorKilled(i));
+        ASSERT_FALSE(getManager()->getNamespaceForCursorId(cursorIds[i]));
+    }
+    ASSERT_EQ(0U, getManager()->stats().cursorsSingleTarget);
+}
+
 // Test that getting the namespace for an unknown cursor returns boost::none.
 TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdUnknown) {
     boost::optional<NamespaceString> cursorNamespace = getManager()->getNamespaceForCursorId(5);
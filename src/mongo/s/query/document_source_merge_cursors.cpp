@@ -94,6 +94,13 @@ void DocumentSourceMergeCursors::populateMerger() {
     _ownCursors = false;
 }
 
+void DocumentSourceMergeCursors::prefetch() {
+    if (!_blockingResultsMerger) {
+        populateMerger();
+    }
+    uassertStatusOK(_blockingResultsMerger->scheduleGetMores());
+}
+
 std::unique_ptr<RouterStageMerge> DocumentSourceMergeCursors::convertToRouterStage() {
     invariant(!_blockingResultsMerger, "Expected conversion to happen before execution");
     return std::make_unique<RouterStageMerge>(
@@ -118,6 +118,13 @@ public:
 
     bool remotesExhausted() const;
 
+    /**
+     * Starts fetching the next batch from each remote cursor without blocking, so that the shards
+     * can do their work before this stage is first iterated. Populates the underlying
+     * BlockingResultsMerger if necessary, which assumes ownership of the remote cursors.
+     */
+    void prefetch();
+
     Status setAwaitDataTimeout(Milliseconds awaitDataTimeout) {
         if (!_blockingResultsMerger) {
             // In cases where a cursor was established with a batchSize of 0, the first getMore
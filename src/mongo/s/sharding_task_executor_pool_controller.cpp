@@ -222,10 +222,17 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
 
     const size_t minConns = gParameters.minConnections.load();
     const size_t maxConns = gParameters.maxConnections.load();
+    const size_t maxGrowth = gParameters.maxTargetGrowth.load();
 
     // Update the target for just the pool first
+    const auto lastTarget = poolData.target;
     poolData.target = stats.requests + stats.active;
 
+    if (maxGrowth > 0 && poolData.target > lastTarget + maxGrowth) {
+        poolData.target = lastTarget + maxGrowth;
+        _targetGrowthLimited.fetchAndAdd(1);
+    }
+
     if (poolData.target < minConns) {
         poolData.target = minConns;
     } else if (poolData.target > maxConns) {
@@ -322,6 +329,7 @@ Milliseconds ShardingTaskExecutorPoolController::toRefreshTimeout() const {
 void ShardingTaskExecutorPoolController::updateConnectionPoolStats(
     executor::ConnectionPoolStats* cps) const {
     cps->strategy = gParameters.matchingStrategy.load();
+    cps->totalTargetGrowthLimited += _targetGrowthLimited.load();
 }
 
 }  // namespace mongo
@@ -59,6 +59,11 @@ namespace mongo {
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * The target for each pool follows its in-flight demand (queued requests plus checked out
+ * connections). When maxTargetGrowth is set, that target may only rise by that many connections
+ * per update. A latency spike then makes pools grow gradually and queue the excess requests,
+ * instead of every pool opening connections to the host at once.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -95,6 +100,7 @@ public:
         AtomicWord<int> minConnections;
         AtomicWord<int> maxConnections;
         AtomicWord<int> maxConnecting;
+        AtomicWord<int> maxTargetGrowth;
 
         AtomicWord<int> hostTimeoutMS;
         AtomicWord<int> pendingTimeoutMS;
@@ -210,6 +216,9 @@ private:
 
     std::shared_ptr<ReplicaSetChangeNotifier::Listener> _listener;
 
+    // The number of updates where a pool's target was held back by maxTargetGrowth
+    AtomicWord<size_t> _targetGrowthLimited{0};
+
     Mutex _mutex = MONGO_MAKE_LATCH("ShardingTaskExecutorPoolController::_mutex");
 
     // Entires to _poolDatas are added by addHost() and removed by removeHost()
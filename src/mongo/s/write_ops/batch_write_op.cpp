@@ -60,6 +60,9 @@ struct WriteErrorDetailComp {
 const int kEstUpdateOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 const int kEstDeleteOverheadBytes = (BSONObjMaxInternalSize - BSONObjMaxUserSize) / 100;
 
+// The number of ready inserts targeted together in the first window of a targeting round.
+const size_t kInitialInsertTargetingWindowSize = 16;
+
 /**
  * Returns a new write concern that has the copy of every field from the original
  * document but with a w set to 1. This is intended for upgrading { w: 0 } write
@@ -310,6 +313,36 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // Inserts are targeted a window of ready ops at a time, with a single call to the targeter
+    // which resolves all their shard keys together. The window doubles each time, so that the ops
+    // targeted but left for a later round when the batch ends early stay proportional to the ops
+    // actually sent.
+    const bool isInsert = _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert;
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> insertEndpoints;
+    size_t insertWindowBegin = 0;
+    size_t insertWindowSize = kInitialInsertTargetingWindowSize;
+
+    auto targetInsertWindow = [&](size_t begin) {
+        const size_t end = std::min(numWriteOps, begin + insertWindowSize);
+
+        std::vector<BSONObj> docs;
+        for (size_t i = begin; i < end; ++i) {
+            if (_writeOps[i].getWriteState() == WriteOpState_Ready)
+                docs.push_back(_writeOps[i].getWriteItem().getDocument());
+        }
+        auto endpoints = targeter.targetInserts(_opCtx, docs);
+
+        insertEndpoints.clear();
+        insertEndpoints.resize(end - begin);
+        auto endpointIt = endpoints.begin();
+        for (size_t i = begin; i < end; ++i) {
+            if (_writeOps[i].getWriteState() == WriteOpState_Ready)
+                insertEndpoints[i - begin] = std::move(*endpointIt++);
+        }
+        insertWindowBegin = begin;
+        insertWindowSize *= 2;
+    };
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -327,7 +360,16 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
         Status targetStatus = Status::OK();
         try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
+            if (isInsert) {
+                if (i >= insertWindowBegin + insertEndpoints.size()) {
+                    targetInsertWindow(i);
+                }
+                auto& swEndpoint = insertEndpoints[i - insertWindowBegin];
+                invariant(swEndpoint);
+                writeOp.targetWrites(_opCtx, uassertStatusOK(std::move(*swEndpoint)), &writes);
+            } else {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            }
         } catch (const DBException& ex) {
             targetStatus = ex.toStatus();
         }
@@ -403,6 +445,13 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
                 writes, std::max(writeSizeBytes, errorResponsePotentialSizeBytes), batchMap)) {
             invariant(!batchMap.empty());
             writeOp.cancelWrites(nullptr);
+
+            // An unordered write which does not fit waits for the next round, but the writes after
+            // it may still fit in the batches to other shards. Filling those up means fewer rounds,
+            // each of which waits for the slowest shard.
+            if (!ordered)
+                continue;
+
             break;
         }
 
@@ -1538,6 +1538,58 @@ TEST_F(BatchWriteOpLimitTests, OneBigOneSmall) {
     ASSERT(batchOp.isFinished());
 }
 
+// Unordered big doc which does not fit in its shard's batch - the docs after it still go through
+// to the other shard in the same round
+TEST_F(BatchWriteOpLimitTests, UnorderedBigDocDoesNotHoldBackOtherShards) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED(), boost::none);
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED(), boost::none);
+
+    auto targeter = initTargeterSplitRange(nss, endpointA, endpointB);
+
+    // Create a BSONObj (slightly) bigger than the maximum size by including a max-size string
+    const std::string bigString(BSONObjMaxUserSize, 'x');
+
+    BatchedCommandRequest request([&] {
+        write_ops::InsertCommandRequest insertOp(nss);
+        insertOp.setWriteCommandRequestBase([] {
+            write_ops::WriteCommandRequestBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        insertOp.setDocuments({BSON("x" << -1 << "data" << bigString),
+                               BSON("x" << -2 << "data" << bigString),
+                               BSON("x" << 1)});
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    verifyTargetedBatches({{endpointA.shardName, 1u}, {endpointB.shardName, 1u}}, targeted);
+
+    BatchedCommandResponse response;
+    buildResponse(1, &response);
+
+    for (auto it = targeted.begin(); it != targeted.end(); ++it) {
+        batchOp.noteBatchResponse(*it->second, response, nullptr);
+    }
+    ASSERT(!batchOp.isFinished());
+
+    targetedOwned.clear();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    verifyTargetedBatches({{endpointA.shardName, 1u}}, targeted);
+
+    batchOp.noteBatchResponse(*targeted.begin()->second, response, nullptr);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT_EQUALS(clientResponse.getN(), 3);
+}
+
 class BatchWriteOpTransactionTest : public ShardingTestFixture {
 public:
     const TxnNumber kTxnNumber = 5;
@@ -123,6 +123,14 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as targetWrites, for an insert which was already targeted to 'endpoint' as part of a
+     * batch through NSTargeter::targetInserts.
+     */
+    void targetWrites(OperationContext* opCtx,
+                      ShardEndpoint endpoint,
+                      std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -161,6 +169,13 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates a TargetedWrite for each of the 'endpoints' the op was not already successful on.
+     */
+    void _addTargetedWrites(OperationContext* opCtx,
+                            std::vector<ShardEndpoint> endpoints,
+                            std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
@@ -42,6 +42,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/scripting/dbdirectclient_factory.h"
 #include "mongo/util/ctype.h"
 #include "mongo/util/fail_point.h"
@@ -351,6 +352,10 @@ void Scope::execCoreFiles() {
 }
 
 namespace {
+// Scopes older than this are not kept for reuse, so that long-lived scopes don't accumulate
+// garbage from operation after operation.
+constexpr Seconds kMaxScopeReuseTime = Seconds(10);
+
 class ScopeCache {
 public:
     void release(const string& poolName, const std::shared_ptr<Scope>& scope) {
@@ -411,7 +416,6 @@ private:
 
     // Note: if these numbers change, reconsider choice of datastructure for _pools
     static const unsigned kMaxPoolSize = 10;
-    constexpr static inline Seconds kMaxScopeReuseTime = Seconds(10);
 
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
     Pools _pools;                            // protected by _mutex
@@ -419,10 +423,99 @@ private:
 };
 
 ScopeCache scopeCache;
+
+// Bounds the Scopes kept by all threads through releaseScopeForCurrentThread(), like the scopes in
+// 'scopeCache'.
+constexpr int kMaxThreadScopes = 10;
+AtomicWord<int> numThreadScopes{0};
+
+// Incremented by dropScopeCache(), so that every thread drops the Scope it keeps the next time it
+// gets or releases one.
+AtomicWord<unsigned long long> threadScopesGeneration{0};
+
+/**
+ * Holds the Scope last released by an operation on this thread. Unlike the scopes in 'scopeCache',
+ * scopes created for the current thread can only run on that thread, so each thread keeps its own,
+ * and only that thread can destroy it.
+ */
+struct ThreadScopeCache {
+    ~ThreadScopeCache() {
+        clear();
+    }
+
+    /**
+     * Returns the kept Scope, if any, and stops counting it against 'kMaxThreadScopes'.
+     */
+    std::unique_ptr<Scope> take() {
+        if (scope) {
+            numThreadScopes.fetchAndSubtract(1);
+        }
+        return std::move(scope);
+    }
+
+    void clear() {
+        auto taken = take();
+        // The engine which created the scope may already be gone, in which case the scope can no
+        // longer be destroyed safely.
+        if (taken && engine != getGlobalScriptEngine()) {
+            taken.release();
+        }
+    }
+
+    std::unique_ptr<Scope> scope;
+    ScriptEngine* engine = nullptr;
+    std::string poolName;
+    boost::optional<int> jsHeapLimitMB;
+    unsigned long long generation = 0;
+};
+
+thread_local ThreadScopeCache threadScopeCache;  // NOLINT
 }  // anonymous namespace
 
 void ScriptEngine::dropScopeCache() {
     scopeCache.clear();
+    threadScopesGeneration.fetchAndAdd(1);
+    threadScopeCache.clear();
+}
+
+unique_ptr<Scope> ScriptEngine::getPooledScopeForCurrentThread(
+    const string& poolName, boost::optional<int> jsHeapLimitMB) {
+    auto& cache = threadScopeCache;
+    if (cache.scope && cache.engine == this && cache.poolName == poolName &&
+        cache.jsHeapLimitMB == jsHeapLimitMB &&
+        cache.generation == threadScopesGeneration.load() &&
+        Date_t::now() - cache.scope->getCreateTime() <= kMaxScopeReuseTime) {
+        auto scope = cache.take();
+        scope->reset();
+        return scope;
+    }
+
+    // A kept Scope which can't be reused is not kept any longer either.
+    cache.clear();
+    return unique_ptr<Scope>(newScopeForCurrentThread(jsHeapLimitMB));
+}
+
+void ScriptEngine::releaseScopeForCurrentThread(const string& poolName,
+                                                boost::optional<int> jsHeapLimitMB,
+                                                unique_ptr<Scope> scope) {
+    auto& cache = threadScopeCache;
+    cache.clear();
+    if (scope->hasOutOfMemoryException() || !scope->getError().empty() ||
+        Date_t::now() - scope->getCreateTime() > kMaxScopeReuseTime) {
+        return;
+    }
+
+    if (numThreadScopes.fetchAndAdd(1) >= kMaxThreadScopes) {
+        numThreadScopes.fetchAndSubtract(1);
+        return;
+    }
+
+    scope->reset();
+    cache.scope = std::move(scope);
+    cache.engine = this;
+    cache.poolName = poolName;
+    cache.jsHeapLimitMB = jsHeapLimitMB;
+    cache.generation = threadScopesGeneration.load();
 }
 
 class PooledScope : public Scope {
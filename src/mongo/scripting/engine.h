@@ -225,6 +225,26 @@ public:
         return newScopeForCurrentThread(boost::none);
     }
 
+    /**
+     * Like newScopeForCurrentThread(), but reuses the Scope last released on this thread through
+     * releaseScopeForCurrentThread() if it was released under the same 'poolName' and heap limit.
+     * A reused Scope keeps its JavaScript runtime and the functions it already compiled, so
+     * operations which run the same code over and over don't pay to set these up every time.
+     * 'poolName' must identify the database and the authenticated users, as for getPooledScope().
+     */
+    std::unique_ptr<Scope> getPooledScopeForCurrentThread(const std::string& poolName,
+                                                          boost::optional<int> jsHeapLimitMB);
+
+    /**
+     * Keeps 'scope', which must have been returned by getPooledScopeForCurrentThread() on this
+     * thread, for reuse by the next operation on this thread. Scopes which hit an error or ran out
+     * of memory are destroyed instead, as are scopes which have been in use for too long, and
+     * scopes released while the threads already keep as many scopes as the scope pool does.
+     */
+    void releaseScopeForCurrentThread(const std::string& poolName,
+                                      boost::optional<int> jsHeapLimitMB,
+                                      std::unique_ptr<Scope> scope);
+
     virtual void runTest() = 0;
 
     virtual bool utf8Ok() const = 0;
@@ -244,6 +264,11 @@ public:
      * ignored.
      */
     static void setup(bool disableLoadStored = true);
+
+    /**
+     * Destroys the pooled scopes and the scope kept by this thread. Every other thread destroys
+     * the scope it keeps the next time it gets or releases one, since only that thread may.
+     */
     static void dropScopeCache();
 
     /** gets a scope from the pool or a new one if pool is empty
@@ -38,6 +38,7 @@
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/transport/baton.h"
@@ -254,13 +255,20 @@ public:
                 func(status);
             });
 
-        if (_inPoll) {
+        if (_inPoll.load()) {
             efd().notify();
         }
     }
 
     void notify() noexcept override {
-        efd().notify();
+        // Only a thread blocked in ::poll needs the eventfd to wake up. Otherwise it is enough to
+        // make the next call to run() return without polling, which saves both the eventfd write
+        // and the read which follows the wakeup. This must not take _mutex, because alarms set by
+        // run() while holding it may fire synchronously.
+        _notificationPending.store(true);
+        if (_inPoll.load()) {
+            efd().notify();
+        }
     }
 
     /**
@@ -344,14 +352,19 @@ public:
                 deadline.reset();
             }
 
-            _inPoll = true;
+            _inPoll.store(true);
             lk.unlock();
-            rval = ::poll(_pollSet.data(),
-                          _pollSet.size(),
-                          deadline ? Milliseconds(*deadline - now).count() : -1);
+
+            // Either we see here a notification which came in while we were not in poll, or
+            // notify() sees that we are in poll and wakes us up through the eventfd
+            if (!_notificationPending.swap(false)) {
+                rval = ::poll(_pollSet.data(),
+                              _pollSet.size(),
+                              deadline ? Milliseconds(*deadline - now).count() : -1);
+            }
             auto savedErrno = errno;
             lk.lock();
-            _inPoll = false;
+            _inPoll.store(false);
 
             // If poll failed, it better be in EINTR
             if (rval < 0 && savedErrno != EINTR) {
@@ -487,7 +500,7 @@ private:
             uassertStatusOK(kDetached);
         }
 
-        if (_inPoll) {
+        if (_inPoll.load()) {
             _scheduled.push_back(std::forward<Callback>(job));
 
             efd().notify();
@@ -504,7 +517,12 @@ private:
 
     OperationContext* _opCtx;
 
-    bool _inPoll = false;
+    // Only modified under _mutex, but also read by notify() without it
+    AtomicWord<bool> _inPoll{false};
+
+    // Set by notify() and consumed by the next run(), so that a notification received while we
+    // are not in poll does not need to go through the eventfd
+    AtomicWord<bool> _notificationPending{false};
 
     // This map stores the sessions we need to poll on. We unwind it into a pollset for every
     // blocking call to run
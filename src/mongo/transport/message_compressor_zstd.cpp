@@ -30,14 +30,72 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <vector>
 
 #include <zstd.h>
 
 #include "mongo/base/init.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+
+// ZSTD_compress() and ZSTD_decompress() set up and tear down a fresh context, including its
+// workspace allocation, on every call. Messages are small and frequent, so contexts are reused
+// across messages instead, from pools shared by all threads. Every message is still a standalone
+// frame.
+struct ZstdContextDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+// Idle contexts beyond this many are freed rather than pooled, which bounds the memory held by
+// contexts to those in use plus this many.
+constexpr size_t kMaxIdleContexts = 64;
+
+template <typename Context, Context* (*createContext)()>
+class ZstdContextPool {
+public:
+    using ContextPtr = std::unique_ptr<Context, ZstdContextDeleter>;
+
+    ContextPtr acquire() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (!_idleContexts.empty()) {
+                auto ctx = std::move(_idleContexts.back());
+                _idleContexts.pop_back();
+                return ctx;
+            }
+        }
+
+        ContextPtr ctx{createContext()};
+        invariant(ctx);
+        return ctx;
+    }
+
+    void release(ContextPtr ctx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_idleContexts.size() < kMaxIdleContexts) {
+            _idleContexts.push_back(std::move(ctx));
+        }
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("ZstdContextPool::_mutex");
+    std::vector<ContextPtr> _idleContexts;
+};
+
+ZstdContextPool<ZSTD_CCtx, ZSTD_createCCtx> compressionContexts;
+ZstdContextPool<ZSTD_DCtx, ZSTD_createDCtx> decompressionContexts;
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +105,14 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    auto ctx = compressionContexts.acquire();
+    size_t ret = ZSTD_compressCCtx(ctx.get(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
+    compressionContexts.release(std::move(ctx));
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +124,13 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    auto ctx = decompressionContexts.acquire();
+    size_t ret = ZSTD_decompressDCtx(ctx.get(),
+                                     const_cast<char*>(output.data()),
+                                     output.length(),
+                                     input.data(),
+                                     input.length());
+    decompressionContexts.release(std::move(ctx));
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
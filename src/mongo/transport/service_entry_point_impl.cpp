@@ -37,11 +37,13 @@
 #include <vector>
 
 #include "mongo/db/auth/restriction_environment.h"
+#include "mongo/db/client.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/transport/hello_metrics.h"
 #include "mongo/transport/service_executor.h"
 #include "mongo/transport/service_executor_gen.h"
+#include "mongo/transport/service_executor_utils.h"
 #include "mongo/transport/service_state_machine.h"
 #include "mongo/transport/session.h"
 #include "mongo/util/processinfo.h"
@@ -222,8 +224,17 @@ void ServiceEntryPointImpl::startSession(transport::SessionHandle session) {
         _sessionsCV.notify_one();
     });
 
+    // Past the configured number of connections, start new connections on the borrowed executor so
+    // that they do not each hold a thread while they sit idle.
+    auto threadingModel = transport::ServiceExecutor::getInitialThreadingModel();
+    const auto dedicatedLimit = transport::dedicatedServiceExecutorConnectionLimit.load();
+    if (threadingModel == transport::ServiceExecutor::ThreadingModel::kDedicated &&
+        dedicatedLimit > 0 && connectionCount > static_cast<size_t>(dedicatedLimit)) {
+        threadingModel = transport::ServiceExecutor::ThreadingModel::kBorrowed;
+    }
+
     auto seCtx = transport::ServiceExecutorContext{};
-    seCtx.setThreadingModel(transport::ServiceExecutor::getInitialThreadingModel());
+    seCtx.setThreadingModel(threadingModel);
     seCtx.setCanUseReserved(canOverrideMaxConns);
     ssmIt->start(std::move(seCtx));
 }
@@ -334,6 +345,22 @@ void ServiceEntryPointImpl::appendStats(BSONObjBuilder* bob) const {
         BSONObjBuilder section(bob->subobjStart("adminConnections"));
         adminExec->appendStats(&section);
     }
+
+    {
+        // Estimate of the memory held by connections whether or not they are running a request.
+        // Message buffers are not included, as they are only allocated while a request is read
+        // and handled.
+        BSONObjBuilder section(bob->subobjStart("memory"));
+        const long long clientBytes = sizeof(Client) + Client::getDecorationBufferSizeBytes();
+        const long long sessionBytes = transport::Session::getDecorationBufferSizeBytes();
+        const long long threadStackBytes = getServiceWorkerThreadStackSize();
+        section.append("clientBytesPerConnection", clientBytes);
+        section.append("sessionDecorationBytesPerConnection", sessionBytes);
+        section.append("threadStackBytesPerDedicatedConnection", threadStackBytes);
+        section.append("estimatedTotalBytes",
+                       static_cast<long long>(sessionCount) * (clientBytes + sessionBytes) +
+                           static_cast<long long>(seStats.usesDedicated) * threadStackBytes);
+    }
 }
 
 }  // namespace mongo
@@ -31,6 +31,9 @@
 
 #include "mongo/transport/service_executor_fixed.h"
 
+#include <algorithm>
+#include <fmt/format.h>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/logv2/log.h"
 #include "mongo/transport/service_executor_gen.h"
@@ -38,12 +41,15 @@
 #include "mongo/transport/transport_layer.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/testing_proctor.h"
 #include "mongo/util/thread_safety_context.h"
 
 namespace mongo::transport {
 namespace {
 
+using namespace fmt::literals;
+
 MONGO_FAIL_POINT_DEFINE(hangBeforeSchedulingServiceExecutorFixedTask);
 MONGO_FAIL_POINT_DEFINE(hangAfterServiceExecutorFixedExecutorThreadsStart);
 MONGO_FAIL_POINT_DEFINE(hangBeforeServiceExecutorFixedLastExecutorThreadReturns);
@@ -79,9 +85,18 @@ const auto getHandle = ServiceContext::declareDecoration<std::unique_ptr<Handle>
 
 const auto serviceExecutorFixedRegisterer = ServiceContext::ConstructorActionRegisterer{
     "ServiceExecutorFixed", [](ServiceContext* ctx) {
+        size_t numRunQueues = fixedServiceExecutorRunQueues > 0
+            ? static_cast<size_t>(fixedServiceExecutorRunQueues)
+            : ProcessInfo::getNumAvailableCores();
         getHandle(ctx) = std::make_unique<Handle>(std::make_shared<ServiceExecutorFixed>(
-            ctx, ThreadPool::Limits{0, static_cast<size_t>(fixedServiceExecutorThreadLimit)}));
+            ctx,
+            ThreadPool::Limits{0, static_cast<size_t>(fixedServiceExecutorThreadLimit)},
+            numRunQueues));
     }};
+
+// Used by threads outside of the executor to spread their tasks across the run queues, and by all
+// threads to pick which other run queue to look at when their preferred one has a backlog.
+thread_local size_t runQueueCursor = 0;
 }  // namespace
 
 struct ServiceExecutorFixed::Stats {
@@ -126,7 +141,7 @@ struct ServiceExecutorFixed::Stats {
 
 class ServiceExecutorFixed::ExecutorThreadContext {
 public:
-    ExecutorThreadContext(ServiceExecutorFixed* serviceExecutor);
+    ExecutorThreadContext(ServiceExecutorFixed* serviceExecutor, size_t runQueue);
     ~ExecutorThreadContext();
 
     ExecutorThreadContext(ExecutorThreadContext&&) = delete;
@@ -155,14 +170,19 @@ public:
         return _recursionDepth;
     }
 
+    size_t getRunQueue() const {
+        return _runQueue;
+    }
+
 private:
     ServiceExecutorFixed* const _executor;
+    const size_t _runQueue;
     int _recursionDepth = 0;
 };
 
 ServiceExecutorFixed::ExecutorThreadContext::ExecutorThreadContext(
-    ServiceExecutorFixed* serviceExecutor)
-    : _executor(serviceExecutor) {
+    ServiceExecutorFixed* serviceExecutor, size_t runQueue)
+    : _executor(serviceExecutor), _runQueue(runQueue) {
     _executor->_stats->threadsStarted.fetchAndAdd(1);
     hangAfterServiceExecutorFixedExecutorThreadsStart.pauseWhileSet();
 }
@@ -178,18 +198,39 @@ ServiceExecutorFixed::ExecutorThreadContext::~ExecutorThreadContext() {
 thread_local std::unique_ptr<ServiceExecutorFixed::ExecutorThreadContext>
     ServiceExecutorFixed::_executorContext;
 
-ServiceExecutorFixed::ServiceExecutorFixed(ServiceContext* ctx, ThreadPool::Limits limits)
-    : _stats{std::make_unique<Stats>()},
-      _svcCtx{ctx},
-      _options{[&] {
+ServiceExecutorFixed::ServiceExecutorFixed(ServiceContext* ctx,
+                                           ThreadPool::Limits limits,
+                                           size_t numRunQueues)
+    : _stats{std::make_unique<Stats>()}, _svcCtx{ctx}, _options{[&] {
           ThreadPool::Options opt(std::move(limits));
           opt.poolName = "ServiceExecutorFixed";
-          opt.onCreateThread = [this](const auto&) {
-              _executorContext = std::make_unique<ExecutorThreadContext>(this);
-          };
           return opt;
-      }()},
-      _threadPool{std::make_shared<ThreadPool>(_options)} {}
+      }()} {
+    invariant(numRunQueues > 0);
+
+    // Every run queue needs at least one thread, and the threads of all run queues together must
+    // stay within the limits of the executor.
+    numRunQueues = std::min(numRunQueues, std::max<size_t>(_options.maxThreads, 1));
+    auto shareOfRunQueue = [&](size_t threads, size_t i) {
+        return threads / numRunQueues + (i < threads % numRunQueues ? 1 : 0);
+    };
+
+    for (size_t i = 0; i < numRunQueues; ++i) {
+        ThreadPool::Options opt = _options;
+        opt.minThreads = shareOfRunQueue(_options.minThreads, i);
+        opt.maxThreads = std::max<size_t>(shareOfRunQueue(_options.maxThreads, i), 1);
+        if (numRunQueues > 1) {
+            opt.poolName = "{}-{}"_format(_options.poolName, i);
+        }
+        opt.onCreateThread = [this, i](const auto&) {
+            _executorContext = std::make_unique<ExecutorThreadContext>(this, i);
+        };
+
+        auto runQueue = std::make_unique<RunQueue>();
+        runQueue->threadPool = std::make_shared<ThreadPool>(std::move(opt));
+        _runQueues.push_back(std::move(runQueue));
+    }
+}
 
 ServiceExecutorFixed::~ServiceExecutorFixed() {
     _finalize();
@@ -201,15 +242,21 @@ void ServiceExecutorFixed::_finalize() noexcept {
                 "Joining fixed thread-pool service executor",
                 "name"_attr = _options.poolName);
 
-    if (std::shared_ptr<ThreadPool> pool = [&] {
-            auto lk = stdx::unique_lock(_mutex);
-            _beginShutdown();
-            _waitForStop(lk, {});
-            return std::exchange(_threadPool, nullptr);
-        }()) {
+    std::vector<std::shared_ptr<ThreadPool>> pools;
+    {
+        auto lk = stdx::unique_lock(_mutex);
+        _beginShutdown();
+        _waitForStop(lk, {});
+        for (auto& runQueue : _runQueues) {
+            if (auto pool = std::exchange(runQueue->threadPool, nullptr))
+                pools.push_back(std::move(pool));
+        }
+    }
+
+    for (auto& pool : pools)
         pool->shutdown();
+    for (auto& pool : pools)
         pool->join();
-    }
 
     invariant(_stats->threadsRunning() == 0);
     invariant(_stats->tasksRunning() == 0);
@@ -237,7 +284,8 @@ Status ServiceExecutorFixed::start() {
                 "Starting fixed thread-pool service executor",
                 "name"_attr = _options.poolName);
 
-    _threadPool->startup();
+    for (auto& runQueue : _runQueues)
+        runQueue->threadPool->startup();
 
     if (!_svcCtx) {
         // For some tests, we do not have a ServiceContext.
@@ -254,7 +302,7 @@ Status ServiceExecutorFixed::start() {
 
     auto reactor = tl->getReactor(TransportLayer::WhichReactor::kIngress);
     invariant(reactor);
-    _threadPool->schedule([this, reactor](Status) {
+    _runQueues.front()->threadPool->schedule([this, reactor](Status) {
         {
             // Check to make sure we haven't been shutdown already. Note that there is still a brief
             // race that immediately follows this check. ASIOReactor::stop() is not permanent, thus
@@ -399,17 +447,49 @@ Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) try {
 
     hangBeforeSchedulingServiceExecutorFixedTask.pauseWhileSet();
 
-    _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
-        invariant(status);
-        _executorContext->run([&] { task(); });
-    });
+    auto& runQueue = *_runQueues[_pickRunQueue(boost::none)];
+    runQueue.tasksQueued.fetchAndAdd(1);
+    runQueue.threadPool->schedule(
+        [this, &runQueue, task = std::move(task)](Status status) mutable {
+            invariant(status);
+            runQueue.tasksQueued.fetchAndSubtract(1);
+            _executorContext->run([&] { task(); });
+        });
 
     return Status::OK();
 } catch (DBException& e) {
     return e.toStatus();
 }
 
-void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task) noexcept {
+size_t ServiceExecutorFixed::_pickRunQueue(boost::optional<size_t> preferred) const {
+    const auto numRunQueues = _runQueues.size();
+    if (numRunQueues == 1)
+        return 0;
+
+    size_t home;
+    if (preferred) {
+        home = *preferred % numRunQueues;
+    } else if (_executorContext) {
+        home = _executorContext->getRunQueue() % numRunQueues;
+    } else {
+        home = runQueueCursor++ % numRunQueues;
+    }
+
+    // Only look at other run queues if the preferred one has tasks waiting for a thread. Comparing
+    // against a single other run queue keeps the common case cheap while still moving work away
+    // from run queues that fall behind.
+    auto homeQueued = _runQueues[home]->tasksQueued.loadRelaxed();
+    if (homeQueued == 0)
+        return home;
+
+    auto other = (home + 1 + runQueueCursor++ % (numRunQueues - 1)) % numRunQueues;
+    if (_runQueues[other]->tasksQueued.loadRelaxed() < homeQueued)
+        return other;
+    return home;
+}
+
+void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task,
+                                     boost::optional<size_t> preferredRunQueue) noexcept {
     {
         auto lk = stdx::unique_lock(_mutex);
         if (_state != State::kRunning) {
@@ -421,9 +501,13 @@ void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task) noexcept {
         _stats->tasksScheduled.fetchAndAdd(1);
     }
 
-    _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
-        _executorContext->run([&] { task(std::move(status)); });
-    });
+    auto& runQueue = *_runQueues[_pickRunQueue(preferredRunQueue)];
+    runQueue.tasksQueued.fetchAndAdd(1);
+    runQueue.threadPool->schedule(
+        [this, &runQueue, task = std::move(task)](Status status) mutable {
+            runQueue.tasksQueued.fetchAndSubtract(1);
+            _executorContext->run([&] { task(std::move(status)); });
+        });
 }
 
 size_t ServiceExecutorFixed::getRunningThreads() const {
@@ -448,17 +532,26 @@ void ServiceExecutorFixed::runOnDataAvailable(const SessionHandle& session,
 
     lk.unlock();
 
+    // Keep each session on the same run queue across its waits for data.
+    auto runQueue = static_cast<size_t>(session->id());
     auto anchor = shared_from_this();
-    session->asyncWaitForData().thenRunOn(anchor).getAsync([this, anchor, it](Status status) {
-        // Remove our waiter from the list.
-        auto lk = stdx::unique_lock(_mutex);
-        auto waiter = std::exchange(*it, {});
-        _waiters.erase(it);
-        _stats->waitersEnded.fetchAndAdd(1);
-        lk.unlock();
-
-        waiter.session = nullptr;
-        waiter.onCompletionCallback(std::move(status));
+    session->asyncWaitForData().getAsync([this, anchor, it, runQueue](Status status) {
+        _schedule(
+            [this, anchor, it, status = std::move(status)](Status scheduleStatus) mutable {
+                if (!scheduleStatus.isOK())
+                    status = std::move(scheduleStatus);
+
+                // Remove our waiter from the list.
+                auto lk = stdx::unique_lock(_mutex);
+                auto waiter = std::exchange(*it, {});
+                _waiters.erase(it);
+                _stats->waitersEnded.fetchAndAdd(1);
+                lk.unlock();
+
+                waiter.session = nullptr;
+                waiter.onCompletionCallback(std::move(status));
+            },
+            runQueue);
     });
 }
 
@@ -31,6 +31,7 @@
 
 #include <boost/optional.hpp>
 #include <memory>
+#include <vector>
 
 #include "mongo/base/status.h"
 #include "mongo/db/service_context.h"
@@ -52,15 +53,29 @@ namespace transport {
  * A service executor that uses a fixed (configurable) number of threads to execute tasks.
  * This executor always yields before executing scheduled tasks, and never yields before scheduling
  * new tasks (i.e., `ScheduleFlags::kMayYieldBeforeSchedule` is a no-op for this executor).
+ *
+ * The threads are split across a number of run queues (typically one per core), each backed by its
+ * own thread pool, so that executor threads do not contend on a single queue. Tasks scheduled from
+ * an executor thread stay on that thread's run queue, and the tasks of a session that was waiting
+ * for data always return to the same run queue. When the preferred run queue has a backlog, the
+ * task is handed to a less loaded run queue instead.
+ *
+ * Idle threads do not steal tasks that are already queued on another run queue, so a task may wait
+ * behind a blocked task while threads of other run queues are idle.
  */
 class ServiceExecutorFixed final : public ServiceExecutor,
                                    public std::enable_shared_from_this<ServiceExecutorFixed> {
     static constexpr auto kDiagnosticLogLevel = 3;
 
 public:
-    explicit ServiceExecutorFixed(ServiceContext* ctx, ThreadPool::Limits limits);
-    explicit ServiceExecutorFixed(ThreadPool::Limits limits)
-        : ServiceExecutorFixed(nullptr, std::move(limits)) {}
+    /**
+     * The thread limits apply to the executor as a whole and are divided evenly between the
+     * `numRunQueues` run queues, so the threads of all run queues together stay within them. There
+     * are never more run queues than `limits.maxThreads`.
+     */
+    ServiceExecutorFixed(ServiceContext* ctx, ThreadPool::Limits limits, size_t numRunQueues = 1);
+    explicit ServiceExecutorFixed(ThreadPool::Limits limits, size_t numRunQueues = 1)
+        : ServiceExecutorFixed(nullptr, std::move(limits), numRunQueues) {}
     virtual ~ServiceExecutorFixed();
 
     static ServiceExecutorFixed* get(ServiceContext* ctx);
@@ -99,6 +114,13 @@ private:
         OutOfLineExecutor::Task onCompletionCallback;
     };
 
+    struct RunQueue {
+        std::shared_ptr<ThreadPool> threadPool;
+
+        // The number of tasks handed to `threadPool` that have not started running yet.
+        AtomicWord<size_t> tasksQueued{0};
+    };
+
     const std::string& _name() const;
 
     /** Requires `_mutex` locked. */
@@ -107,7 +129,14 @@ private:
     /** Requires `_mutex` locked. */
     void _beginShutdown();
 
-    void _schedule(OutOfLineExecutor::Task task) noexcept;
+    /**
+     * Returns the index of the run queue that should receive the next task. Unless `preferred` is
+     * set, tasks scheduled from an executor thread prefer the run queue of that thread.
+     */
+    size_t _pickRunQueue(boost::optional<size_t> preferred) const;
+
+    void _schedule(OutOfLineExecutor::Task task,
+                   boost::optional<size_t> preferredRunQueue = boost::none) noexcept;
 
     void _finalize() noexcept;
 
@@ -127,7 +156,7 @@ private:
     SharedPromise<void> _shutdownComplete;
 
     ThreadPool::Options _options;
-    std::shared_ptr<ThreadPool> _threadPool;
+    std::vector<std::unique_ptr<RunQueue>> _runQueues;
 
     std::list<Waiter> _waiters;
 
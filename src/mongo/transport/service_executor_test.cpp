@@ -52,6 +52,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/future.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 #include <asio.hpp>
 
@@ -159,7 +160,9 @@ public:
 
     class Handle {
     public:
-        Handle() = default;
+        explicit Handle(size_t numRunQueues = 1)
+            : _executor{std::make_shared<ServiceExecutorFixed>(
+                  ThreadPool::Limits{kExecutorThreads, kExecutorThreads}, numRunQueues)} {}
         Handle(const Handle&) = delete;
         Handle& operator=(const Handle&) = delete;
 
@@ -184,8 +187,7 @@ public:
         }
 
     private:
-        std::shared_ptr<ServiceExecutorFixed> _executor{std::make_shared<ServiceExecutorFixed>(
-            ThreadPool::Limits{kExecutorThreads, kExecutorThreads})};
+        std::shared_ptr<ServiceExecutorFixed> _executor;
     };
 };
 
@@ -249,6 +251,62 @@ TEST_F(ServiceExecutorFixedTest, FlattenRecursiveScheduledTasks) {
     barrier.countDownAndWait();
 }
 
+TEST_F(ServiceExecutorFixedTest, TasksRunOnSeveralRunQueues) {
+    static constexpr int kTasks = 100;
+    unittest::Barrier barrier(2);
+    Handle handle(kExecutorThreads);
+    handle.start();
+    AtomicWord<int> tasksLeft{kTasks};
+
+    // Half of the tasks are scheduled from the main thread, and the other half from the executor
+    // threads, so both ways of choosing a run queue are exercised.
+    auto task = [&] {
+        if (tasksLeft.subtractAndFetch(1) == 0)
+            barrier.countDownAndWait();
+    };
+    for (int i = 0; i < kTasks / 2; ++i) {
+        ASSERT_OK(handle->scheduleTask(
+            [&] {
+                task();
+                ASSERT_OK(handle->scheduleTask(task, {}));
+            },
+            {}));
+    }
+    barrier.countDownAndWait();
+}
+
+TEST_F(ServiceExecutorFixedTest, RunQueuesShareTheThreadLimit) {
+    static constexpr size_t kTasks = 4 * kExecutorThreads;
+    Handle handle(kTasks);
+    handle.start();
+    AtomicWord<size_t> tasksRunning{0};
+    AtomicWord<size_t> tasksDone{0};
+    SharedPromise<void> mayReturn;
+    SharedPromise<void> allDone;
+
+    for (size_t i = 0; i < kTasks; ++i) {
+        ASSERT_OK(handle->scheduleTask(
+            [&] {
+                tasksRunning.fetchAndAdd(1);
+                mayReturn.getFuture().get();
+                tasksRunning.fetchAndSubtract(1);
+                if (tasksDone.addAndFetch(1) == kTasks)
+                    allDone.emplaceValue();
+            },
+            {}));
+    }
+
+    // Having more run queues than threads must not let the executor exceed its thread limit.
+    while (tasksRunning.load() < kExecutorThreads)
+        sleepmillis(10);
+    sleepmillis(100);
+    ASSERT_EQ(tasksRunning.load(), kExecutorThreads);
+    ASSERT_LTE(handle->getRunningThreads(), kExecutorThreads);
+
+    mayReturn.emplaceValue();
+    allDone.getFuture().get();
+}
+
 TEST_F(ServiceExecutorFixedTest, ShutdownTimeLimit) {
     SharedPromise<void> invoked;
     SharedPromise<void> mayReturn;
@@ -65,8 +65,32 @@ void* runFunc(void* ctx) {
 
     return nullptr;
 }
+
+#if !defined(_WIN32)
+const rlim_t kStackSize = 1024 * 1024;  // if we change this we need to update the warning
+#endif
 }  // namespace
 
+size_t getServiceWorkerThreadStackSize() noexcept {
+#if defined(_WIN32)
+    return 0;
+#else
+    struct rlimit limits;
+    invariant(getrlimit(RLIMIT_STACK, &limits) == 0);
+    if (limits.rlim_cur <= kStackSize) {
+        // The threads are left with the default stack size, which is the soft limit.
+        return limits.rlim_cur;
+    }
+
+    size_t stackSize = kStackSize;
+#if !__has_feature(address_sanitizer) && !__has_feature(thread_sanitizer)
+    if (kDebugBuild)
+        stackSize /= 2;
+#endif
+    return stackSize;
+#endif
+}
+
 Status launchServiceWorkerThread(unique_function<void()> task) noexcept {
 
     try {
@@ -78,18 +102,10 @@ Status launchServiceWorkerThread(unique_function<void()> task) noexcept {
         ScopeGuard attrsGuard([&attrs] { pthread_attr_destroy(&attrs); });
         pthread_attr_setdetachstate(&attrs, PTHREAD_CREATE_DETACHED);
 
-        static const rlim_t kStackSize =
-            1024 * 1024;  // if we change this we need to update the warning
-
         struct rlimit limits;
         invariant(getrlimit(RLIMIT_STACK, &limits) == 0);
         if (limits.rlim_cur > kStackSize) {
-            size_t stackSizeToSet = kStackSize;
-#if !__has_feature(address_sanitizer) && !__has_feature(thread_sanitizer)
-            if (kDebugBuild)
-                stackSizeToSet /= 2;
-#endif
-            int failed = pthread_attr_setstacksize(&attrs, stackSizeToSet);
+            int failed = pthread_attr_setstacksize(&attrs, getServiceWorkerThreadStackSize());
             if (failed) {
                 const auto ewd = errnoWithDescription(failed);
                 LOGV2_WARNING(22949,
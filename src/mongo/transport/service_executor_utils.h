@@ -42,6 +42,12 @@ class ServiceExecutor;
 
 Status launchServiceWorkerThread(unique_function<void()> task) noexcept;
 
+/**
+ * Returns the stack size in bytes of the threads started by launchServiceWorkerThread(), or 0 if it
+ * is left to the platform.
+ */
+size_t getServiceWorkerThreadStackSize() noexcept;
+
 /* The default implementation for "ServiceExecutor::runOnDataAvailable()", which blocks the caller
  * thread until data is available for reading. On success, it schedules "callback" on "executor".
  * Other implementations (e.g., "ServiceExecutorFixed") may provide asynchronous variants.
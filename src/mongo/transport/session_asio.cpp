@@ -368,15 +368,14 @@ auto TransportLayerASIO::ASIOSession::getSocket() -> GenericSocket& {
 Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHandle& baton) {
     static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
 
-    auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
-    auto ptr = headerBuffer.get();
-    return read(asio::buffer(ptr, kHeaderSize), baton)
-        .then([headerBuffer = std::move(headerBuffer), this, baton]() mutable {
-            if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
+    auto headerPtr = _headerBuffer.data();
+    return read(asio::buffer(headerPtr, kHeaderSize), baton)
+        .then([headerPtr, this, baton]() mutable {
+            if (checkForHTTPRequest(asio::buffer(headerPtr, kHeaderSize))) {
                 return sendHTTPResponse(baton);
             }
 
-            const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
+            const auto msgLen = size_t(MSGHEADER::View(headerPtr).getMessageLength());
             if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
                 StringBuilder sb;
                 sb << "recv(): message msgLen " << msgLen << " is invalid. "
@@ -392,17 +391,17 @@ Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHa
                 return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
             }
 
+            auto buffer = SharedBuffer::allocate(msgLen);
+            memcpy(buffer.get(), headerPtr, kHeaderSize);
+
             if (msgLen == kHeaderSize) {
                 // This probably isn't a real case since all (current) messages have bodies.
                 if (_isIngressSession) {
                     networkCounter.hitPhysicalIn(msgLen);
                 }
-                return Future<Message>::makeReady(Message(std::move(headerBuffer)));
+                return Future<Message>::makeReady(Message(std::move(buffer)));
             }
 
-            auto buffer = SharedBuffer::allocate(msgLen);
-            memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
-
             MsgData::View msgView(buffer.get());
             return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
                 .then([this, buffer = std::move(buffer), msgLen]() mutable {
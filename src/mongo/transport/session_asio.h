@@ -29,11 +29,13 @@
 
 #pragma once
 
+#include <array>
 #include <utility>
 
 #include "mongo/base/system_error.h"
 #include "mongo/config.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/rpc/message.h"
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/ssl_connection_context.h"
@@ -245,6 +247,10 @@ private:
     boost::optional<Milliseconds> _configuredTimeout;
     boost::optional<Milliseconds> _socketTimeout;
 
+    // Receives the header of each incoming message, so that only one buffer needs to be allocated
+    // per message. Only one sourceMessage() may be in progress at a time on a session.
+    std::array<char, sizeof(MSGHEADER::Value)> _headerBuffer;
+
     GenericSocket _socket;
 #ifdef MONGO_CONFIG_SSL
     boost::optional<asio::ssl::stream<decltype(_socket)>> _sslSocket;
@@ -213,6 +213,10 @@ private:
     // Count of idle threads.
     size_t _numIdleThreads = 0;
 
+    // Count of idle threads that are blocked on _workAvailable. Scheduling only needs to signal
+    // _workAvailable when this is non-zero.
+    size_t _numWaitingThreads = 0;
+
     // Id counter for assigning thread names
     size_t _nextThreadId = 0;
 
@@ -363,6 +367,13 @@ void ThreadPool::Impl::schedule(Task task) {
     if (_numIdleThreads <= _pendingTasks.size()) {
         _lastFullUtilizationDate = Date_t::now();
     }
+    if (_numWaitingThreads == 0) {
+        // Every idle thread is between tasks and will find this one before it waits.
+        return;
+    }
+
+    // Signal after releasing the mutex, so that the woken thread does not immediately block on it.
+    lk.unlock();
     _workAvailable.notify_one();
 }
 
@@ -465,11 +476,13 @@ void ThreadPool::Impl::_consumeTasks() {
 
         auto wake = [&] { return _state != running || !_pendingTasks.empty(); };
         MONGO_IDLE_THREAD_BLOCK;
+        ++_numWaitingThreads;
         if (waitDeadline) {
             _workAvailable.wait_until(lk, waitDeadline->toSystemTimePoint(), wake);
         } else {
             _workAvailable.wait(lk, wake);
         }
+        --_numWaitingThreads;
     }
 
     // We still hold the lock, but this thread is retiring. If the whole pool is shutting down, this
@@ -33,10 +33,14 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
+#include <sstream>
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -61,14 +65,6 @@ void check(int ret) {
         return;
     failWithErrno(errno);
 }
-
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
 }  // namespace
 
 TicketHolder::TicketHolder(int num) : _outof(num) {
@@ -79,7 +75,7 @@ TicketHolder::~TicketHolder() {
     check(sem_destroy(&_sem));
 }
 
-bool TicketHolder::tryAcquire() {
+bool TicketHolder::_tryAcquireTicket() {
     while (0 != sem_trywait(&_sem)) {
         if (errno == EAGAIN)
             return false;
@@ -89,47 +85,7 @@ bool TicketHolder::tryAcquire() {
     return true;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
-    if (sem_trywait(&_sem) == 0) {
-        return true;
-    }
-
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
-        }
-
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
-    }
-    return true;
-}
-
-void TicketHolder::release() {
+void TicketHolder::_releaseTicket() {
     check(sem_post(&_sem));
 }
 
@@ -165,59 +121,30 @@ int TicketHolder::available() const {
     return val;
 }
 
-int TicketHolder::used() const {
-    return outof() - available();
-}
-
-int TicketHolder::outof() const {
-    return _outof.load();
-}
-
 #else
 
 TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
 
 TicketHolder::~TicketHolder() = default;
 
-bool TicketHolder::tryAcquire() {
-    stdx::lock_guard<Latch> lk(_mutex);
-    return _tryAcquire();
-}
-
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+bool TicketHolder::_tryAcquireTicket() {
+    auto num = _num.load();
+    while (num > 0) {
+        if (_num.compareAndSwap(&num, num - 1)) {
+            return true;
+        }
     }
+    return false;
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
-    } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
-    }
-}
-
-void TicketHolder::release() {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
-    }
-    _newTicket.notify_one();
+void TicketHolder::_releaseTicket() {
+    _num.fetchAndAdd(1);
 }
 
 Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::lock_guard<Latch> lk(_resizeMutex);
 
-    int used = _outof.load() - _num;
+    int used = _outof.load() - _num.load();
     if (used > newSize) {
         std::stringstream ss;
         ss << "can't resize since we're using (" << used << ") "
@@ -228,35 +155,152 @@ Status TicketHolder::resize(int newSize) {
         return Status(ErrorCodes::BadValue, errmsg);
     }
 
-    _outof.store(newSize);
-    _num = _outof.load() - used;
-
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
+    const int added = newSize - _outof.swap(newSize);
+    _num.fetchAndAdd(added);
+    if (added > 0 && _numWaiters.load() > 0) {
+        _handOffTickets();
+    }
     return Status::OK();
 }
 
 int TicketHolder::available() const {
-    return _num;
+    return _num.load();
+}
+#endif
+
+bool TicketHolder::tryAcquire() {
+    return _tryAcquireTicket();
+}
+
+void TicketHolder::waitForTicket(OperationContext* opCtx, Priority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
+}
+
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until, Priority priority) {
+    // Take a ticket without queueing unless someone is already waiting for one, so that newcomers
+    // do not overtake queued callers.
+    if (_numWaiters.load() == 0 && _tryAcquireTicket()) {
+        return true;
+    }
+
+    Timer timer;
+    Waiter waiter;
+    stdx::unique_lock<Latch> lk(_queueMutex);
+
+    // Count this waiter before trying again, so that a release() which misses this attempt is
+    // guaranteed to see the waiter and hand its ticket over.
+    _numWaiters.fetchAndAdd(1);
+    if (_tryAcquireTicket()) {
+        _numWaiters.fetchAndSubtract(1);
+        return true;
+    }
+
+    auto& queue = _queues[static_cast<size_t>(priority)];
+    waiter.position = queue.insert(queue.end(), &waiter);
+
+    auto& laneStats = _laneStats[static_cast<size_t>(priority)];
+    laneStats.queued.fetchAndAdd(1);
+    ON_BLOCK_EXIT([&] {
+        laneStats.queued.fetchAndSubtract(1);
+        laneStats.totalQueued.fetchAndAdd(1);
+        laneStats.totalTimeQueuedMicros.fetchAndAdd(timer.micros());
+    });
+
+    // Granted waiters have already been removed from their queue by _handOffTickets().
+    auto leaveQueue = [&] {
+        if (!waiter.granted) {
+            queue.erase(waiter.position);
+            _numWaiters.fetchAndSubtract(1);
+        }
+    };
+
+    bool granted;
+    try {
+        if (opCtx) {
+            granted = opCtx->waitForConditionOrInterruptUntil(
+                waiter.cv, lk, until, [&] { return waiter.granted; });
+        } else if (until == Date_t::max()) {
+            waiter.cv.wait(lk, [&] { return waiter.granted; });
+            granted = true;
+        } else {
+            granted = waiter.cv.wait_until(
+                lk, until.toSystemTimePoint(), [&] { return waiter.granted; });
+        }
+    } catch (...) {
+        const bool hadTicket = waiter.granted;
+        leaveQueue();
+        lk.unlock();
+        if (hadTicket) {
+            release();
+        }
+        throw;
+    }
+
+    leaveQueue();
+    return granted;
+}
+
+void TicketHolder::release() {
+    _releaseTicket();
+
+    // A waiter counts itself before its last attempt to take a ticket, so if none is counted here,
+    // any waiter to come will find the ticket just released.
+    if (_numWaiters.load() > 0) {
+        _handOffTickets();
+    }
+}
+
+void TicketHolder::_handOffTickets() {
+    stdx::lock_guard<Latch> lk(_queueMutex);
+    auto& normalQueue = _queues[static_cast<size_t>(Priority::kNormal)];
+    auto& lowQueue = _queues[static_cast<size_t>(Priority::kLow)];
+    while (!normalQueue.empty() || !lowQueue.empty()) {
+        if (!_tryAcquireTicket()) {
+            return;
+        }
+
+        const bool serveLow = !lowQueue.empty() &&
+            (normalQueue.empty() || _lowPriorityBypasses >= kMaxLowPriorityBypasses);
+        _lowPriorityBypasses = (serveLow || lowQueue.empty()) ? 0 : _lowPriorityBypasses + 1;
+
+        auto& queue = serveLow ? lowQueue : normalQueue;
+        auto waiter = queue.front();
+        queue.pop_front();
+        _numWaiters.fetchAndSubtract(1);
+        waiter->granted = true;
+        waiter->cv.notify_one();
+    }
 }
 
 int TicketHolder::used() const {
-    return outof() - _num;
+    return outof() - available();
 }
 
 int TicketHolder::outof() const {
     return _outof.load();
 }
 
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
-        }
-        return false;
+long long TicketHolder::totalQueued() const {
+    long long total = 0;
+    for (const auto& laneStats : _laneStats) {
+        total += laneStats.totalQueued.load() + laneStats.queued.load();
+    }
+    return total;
+}
+
+void TicketHolder::appendStats(BSONObjBuilder& b) const {
+    b.append("out", used());
+    b.append("available", available());
+    b.append("totalTickets", outof());
+
+    static constexpr std::array<StringData, kNumPriorities> kLaneNames{"normal"_sd, "low"_sd};
+    BSONObjBuilder queuesBuilder(b.subobjStart("queues"));
+    for (size_t i = 0; i < kNumPriorities; ++i) {
+        const auto& laneStats = _laneStats[i];
+        BSONObjBuilder laneBuilder(queuesBuilder.subobjStart(kLaneNames[i]));
+        laneBuilder.append("queued", laneStats.queued.load());
+        laneBuilder.append("totalQueued", laneStats.totalQueued.load());
+        laneBuilder.append("totalTimeQueuedMicros", laneStats.totalTimeQueuedMicros.load());
     }
-    _num--;
-    return true;
 }
-#endif
 }  // namespace mongo
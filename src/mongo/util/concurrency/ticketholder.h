@@ -32,7 +32,10 @@
 #include <semaphore.h>
 #endif
 
-#include "mongo/db/operation_context.h"
+#include <array>
+#include <list>
+
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/concurrency/mutex.h"
@@ -41,11 +44,36 @@
 
 namespace mongo {
 
+class BSONObjBuilder;
+class OperationContext;
+
+/**
+ * A counting semaphore that hands out a fixed number of tickets. Callers that cannot get a ticket
+ * right away wait in one of several priority lanes. A released ticket goes straight to the longest
+ * waiting caller in the highest priority lane that has waiters, which is woken alone, so waiters
+ * are served in FIFO order within a lane and there is no thundering herd on release.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
 
 public:
+    /**
+     * Queueing lanes, from the highest priority to the lowest. A lane is only served once every
+     * higher priority lane is empty.
+     */
+    enum class Priority {
+        kNormal,
+        kLow,
+    };
+    static constexpr size_t kNumPriorities = 2;
+
+    /**
+     * How many tickets in a row may be handed to the normal priority lane while the low priority
+     * lane has waiters. The next ticket goes to the low priority lane, so it cannot be starved.
+     */
+    static constexpr int kMaxLowPriorityBypasses = 8;
+
     explicit TicketHolder(int num);
     ~TicketHolder();
 
@@ -56,7 +84,7 @@ public:
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx, Priority priority = Priority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,7 +96,9 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            Priority priority = Priority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -82,22 +112,67 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns how many callers have had to wait in a queue for a ticket, across all lanes.
+     */
+    long long totalQueued() const;
+
+    /**
+     * Appends the ticket counts and, for each priority lane, how many callers are waiting and how
+     * long callers have spent waiting.
+     */
+    void appendStats(BSONObjBuilder& b) const;
+
 private:
+    struct Waiter {
+        stdx::condition_variable cv;
+        bool granted = false;
+        std::list<Waiter*>::iterator position;
+    };
+
+    struct LaneStats {
+        AtomicWord<int> queued;
+        AtomicWord<long long> totalQueued;
+        AtomicWord<long long> totalTimeQueuedMicros;
+    };
+
+    /**
+     * Takes or returns a ticket without regard for the queues.
+     */
+    bool _tryAcquireTicket();
+    void _releaseTicket();
+
+    /**
+     * Moves available tickets to the front waiters of the highest priority lanes.
+     */
+    void _handOffTickets();
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicWord<int> _outof;
     Mutex _resizeMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "TicketHolder::_resizeMutex");
 #else
-    bool _tryAcquire();
-
     AtomicWord<int> _outof;
-    int _num;
-    Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
+    AtomicWord<int> _num;
+    Mutex _resizeMutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "TicketHolder::_resizeMutex");
 #endif
+
+    // Callers waiting for a ticket, one FIFO queue per priority lane. Only release() and callers
+    // that fail to get a ticket right away take _queueMutex, and only when there are waiters.
+    // resize() hands out tickets while holding _resizeMutex, so this latch sits below it.
+    Mutex _queueMutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_queueMutex");
+    std::array<std::list<Waiter*>, kNumPriorities> _queues;
+    AtomicWord<int> _numWaiters;
+    // Tickets handed to the normal priority lane since the low priority lane was last served while
+    // it had waiters. Guarded by _queueMutex.
+    int _lowPriorityBypasses = 0;
+
+    std::array<LaneStats, kNumPriorities> _laneStats;
 };
 
 class ScopedTicket {
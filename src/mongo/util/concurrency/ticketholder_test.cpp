@@ -32,8 +32,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 using namespace mongo;
@@ -72,4 +79,155 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+TEST(TicketholderTest, NormalPriorityWaitersGoBeforeLowPriorityWaiters) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto waitUntilQueued = [&](StringData lane) {
+        while (true) {
+            BSONObjBuilder b;
+            holder.appendStats(b);
+            if (b.obj()["queues"][lane]["queued"].numberInt() > 0) {
+                return;
+            }
+            sleepmillis(1);
+        }
+    };
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> order;
+    auto acquireAndRelease = [&](TicketHolder::Priority priority, std::string name) {
+        holder.waitForTicket(nullptr, priority);
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            order.push_back(name);
+        }
+        holder.release();
+    };
+
+    stdx::thread low(acquireAndRelease, TicketHolder::Priority::kLow, "low");
+    waitUntilQueued("low");
+    stdx::thread normal(acquireAndRelease, TicketHolder::Priority::kNormal, "normal");
+    waitUntilQueued("normal");
+
+    holder.release();
+    low.join();
+    normal.join();
+
+    ASSERT_EQ(order.size(), 2u);
+    ASSERT_EQ(order[0], "normal");
+    ASSERT_EQ(order[1], "low");
+    ASSERT_EQ(holder.used(), 0);
+}
+
+TEST(TicketholderTest, WaitersOfTheSamePriorityAreServedInOrder) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto waitUntilQueued = [&](int count) {
+        while (true) {
+            BSONObjBuilder b;
+            holder.appendStats(b);
+            if (b.obj()["queues"]["normal"]["queued"].numberInt() >= count) {
+                return;
+            }
+            sleepmillis(1);
+        }
+    };
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<int> order;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            holder.waitForTicket();
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                order.push_back(i);
+            }
+            holder.release();
+        });
+        waitUntilQueued(i + 1);
+    }
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(order.size(), threads.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        ASSERT_EQ(order[i], static_cast<int>(i));
+    }
+}
+
+TEST(TicketholderTest, LowPriorityWaitersAreNotStarved) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    auto waitUntilQueued = [&](StringData lane, int count) {
+        while (true) {
+            BSONObjBuilder b;
+            holder.appendStats(b);
+            if (b.obj()["queues"][lane]["queued"].numberInt() >= count) {
+                return;
+            }
+            sleepmillis(1);
+        }
+    };
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<std::string> order;
+    auto acquireAndRelease = [&](TicketHolder::Priority priority, std::string name) {
+        holder.waitForTicket(nullptr, priority);
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            order.push_back(name);
+        }
+        holder.release();
+    };
+
+    std::vector<stdx::thread> threads;
+    threads.emplace_back(acquireAndRelease, TicketHolder::Priority::kLow, "low");
+    waitUntilQueued("low", 1);
+    const int numNormal = TicketHolder::kMaxLowPriorityBypasses + 2;
+    for (int i = 0; i < numNormal; ++i) {
+        threads.emplace_back(acquireAndRelease, TicketHolder::Priority::kNormal, "normal");
+        waitUntilQueued("normal", i + 1);
+    }
+
+    holder.release();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(order.size(), threads.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        const bool isLow = i == static_cast<size_t>(TicketHolder::kMaxLowPriorityBypasses);
+        ASSERT_EQ(order[i], isLow ? "low" : "normal");
+    }
+}
+
+TEST(TicketholderTest, ResizeHandsNewTicketsToQueuedWaiters) {
+    TicketHolder holder(5);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+
+    stdx::thread waiter([&] { holder.waitForTicket(); });
+    while (true) {
+        BSONObjBuilder b;
+        holder.appendStats(b);
+        if (b.obj()["queues"]["normal"]["queued"].numberInt() > 0) {
+            break;
+        }
+        sleepmillis(1);
+    }
+
+    ASSERT_OK(holder.resize(6));
+    waiter.join();
+    ASSERT_EQ(holder.used(), 6);
+    ASSERT_EQ(holder.available(), 0);
+}
 }  // namespace
@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * Hash map whose copies share their contents until one of them is modified. The entries are
+ * spread over a fixed number of shards, and a modification only copies the shard it touches if
+ * that shard is still shared. Copying the map is therefore O(kNumShards) and modifying a copy costs
+ * O(size() / kNumShards), which keeps copy-on-write snapshots of large maps cheap to publish.
+ *
+ * A map may be read concurrently with modifications to its copies, but, like the standard
+ * containers, not concurrently with modifications to itself.
+ */
+template <typename Key,
+          typename Value,
+          typename Hasher = DefaultHasher<Key>,
+          size_t kNumShards = 256>
+class CopyOnWriteHashMap {
+    static_assert((kNumShards & (kNumShards - 1)) == 0, "kNumShards must be a power of two");
+
+public:
+    using Shard = stdx::unordered_map<Key, Value, Hasher>;
+
+    /**
+     * Returns the value for 'key', or nullptr if there is none.
+     */
+    const Value* find(const Key& key) const {
+        const auto& shard = _shards[_shardFor(key)];
+        if (!shard) {
+            return nullptr;
+        }
+        auto it = shard->find(key);
+        return it == shard->end() ? nullptr : &it->second;
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != nullptr;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Calls 'f' with the key and value of every entry, in no particular order.
+     */
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const auto& shard : _shards) {
+            if (!shard) {
+                continue;
+            }
+            for (const auto& [key, value] : *shard) {
+                f(key, value);
+            }
+        }
+    }
+
+    /**
+     * Returns the value for 'key' for modification, or nullptr if there is none.
+     */
+    Value* findForWrite(const Key& key) {
+        const auto shardIdx = _shardFor(key);
+        if (!_shards[shardIdx] || !_shards[shardIdx]->contains(key)) {
+            return nullptr;
+        }
+        return &_writableShard(shardIdx).find(key)->second;
+    }
+
+    /**
+     * Returns the value for 'key' for modification, inserting a default constructed one if there
+     * is none.
+     */
+    Value& operator[](const Key& key) {
+        auto& shard = _writableShard(_shardFor(key));
+        auto [it, inserted] = shard.try_emplace(key);
+        if (inserted) {
+            ++_size;
+        }
+        return it->second;
+    }
+
+    /**
+     * Removes the entry for 'key'. Returns whether there was one.
+     */
+    bool erase(const Key& key) {
+        const auto shardIdx = _shardFor(key);
+        if (!_shards[shardIdx] || !_shards[shardIdx]->contains(key)) {
+            return false;
+        }
+        _writableShard(shardIdx).erase(key);
+        --_size;
+        return true;
+    }
+
+    void clear() {
+        _shards = {};
+        _size = 0;
+    }
+
+private:
+    static size_t _shardFor(const Key& key) {
+        // Fibonacci hashing spreads every bit of the hash into the top bits used for the shard,
+        // which leaves the low bits the shard's own table relies on independent of the shard.
+        if constexpr (kShardBits == 0) {
+            return 0;
+        } else {
+            const uint64_t hash = Hasher{}(key);
+            return (hash * 0x9E3779B97F4A7C15ULL) >> (64 - kShardBits);
+        }
+    }
+
+    Shard& _writableShard(size_t shardIdx) {
+        auto& shard = _shards[shardIdx];
+        if (!shard) {
+            shard = std::make_shared<Shard>();
+        } else if (shard.use_count() > 1) {
+            // Only a copy of this map can share the shard, and nothing can make another copy of
+            // this map while it is being modified, so a count of one means the shard is ours.
+            shard = std::make_shared<Shard>(*shard);
+        }
+        return *shard;
+    }
+
+    static constexpr int kShardBits = [] {
+        int bits = 0;
+        while ((size_t{1} << bits) < kNumShards) {
+            ++bits;
+        }
+        return bits;
+    }();
+
+    std::array<std::shared_ptr<Shard>, kNumShards> _shards;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
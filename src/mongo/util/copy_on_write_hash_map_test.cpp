@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/copy_on_write_hash_map.h"
+
+namespace mongo {
+namespace {
+
+using Map = CopyOnWriteHashMap<int, std::string>;
+
+TEST(CopyOnWriteHashMapTest, InsertFindErase) {
+    Map map;
+    ASSERT(map.empty());
+    ASSERT(!map.find(1));
+
+    map[1] = "one";
+    map[2] = "two";
+    ASSERT_EQ(map.size(), 2U);
+    ASSERT_EQ(*map.find(1), "one");
+    ASSERT(map.contains(2));
+
+    *map.findForWrite(2) = "deux";
+    ASSERT_EQ(*map.find(2), "deux");
+    ASSERT(!map.findForWrite(3));
+
+    ASSERT(map.erase(1));
+    ASSERT(!map.erase(1));
+    ASSERT(!map.contains(1));
+    ASSERT_EQ(map.size(), 1U);
+
+    map.clear();
+    ASSERT(map.empty());
+    ASSERT(!map.contains(2));
+}
+
+TEST(CopyOnWriteHashMapTest, CopiesAreIndependent) {
+    Map original;
+    for (int i = 0; i < 1000; ++i) {
+        original[i] = std::to_string(i);
+    }
+
+    Map copy = original;
+    copy[0] = "changed";
+    copy.erase(1);
+    copy[1000] = "added";
+
+    ASSERT_EQ(original.size(), 1000U);
+    ASSERT_EQ(*original.find(0), "0");
+    ASSERT_EQ(*original.find(1), "1");
+    ASSERT(!original.contains(1000));
+
+    ASSERT_EQ(copy.size(), 1000U);
+    ASSERT_EQ(*copy.find(0), "changed");
+    ASSERT(!copy.contains(1));
+    ASSERT_EQ(*copy.find(1000), "added");
+
+    // Only the shards that were modified are copied, the others remain shared.
+    ASSERT_NE(original.find(0), copy.find(0));
+    int shared = 0;
+    for (int i = 2; i < 1000; ++i) {
+        if (original.find(i) == copy.find(i)) {
+            ++shared;
+        }
+    }
+    ASSERT_GT(shared, 900);
+}
+
+TEST(CopyOnWriteHashMapTest, ForEachVisitsEveryEntry) {
+    Map map;
+    for (int i = 0; i < 100; ++i) {
+        map[i] = std::to_string(i);
+    }
+
+    int count = 0;
+    int sum = 0;
+    map.forEach([&](int key, const std::string& value) {
+        ASSERT_EQ(value, std::to_string(key));
+        ++count;
+        sum += key;
+    });
+    ASSERT_EQ(count, 100);
+    ASSERT_EQ(sum, 99 * 100 / 2);
+}
+
+}  // namespace
+}  // namespace mongo
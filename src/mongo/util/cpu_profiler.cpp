@@ -0,0 +1,466 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kControl
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/cpu_profiler.h"
+
+#include <algorithm>
+#include <atomic>  // NOLINT
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/hex.h"
+#include "mongo/util/stacktrace.h"
+#include "mongo/util/str.h"
+#include "mongo/util/time_support.h"
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+#include <cxxabi.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+namespace mongo {
+namespace cpu_profiler {
+namespace {
+
+// Read by the signal handler, so it is only ever pointed at complete Names.
+thread_local const ScopedAttribution::Names* currentAttribution = nullptr;
+
+template <size_t N>
+void copyTruncated(StringData from, std::array<char, N>* to) {
+    // The last character is left zero, which terminates the string.
+    std::copy_n(from.begin(), std::min(from.size(), N - 1), to->begin());
+}
+
+}  // namespace
+
+ScopedAttribution::ScopedAttribution(StringData command, StringData ns)
+    : _previous(currentAttribution) {
+    copyTruncated(command, &_names.command);
+    copyTruncated(ns, &_names.ns);
+    // AtomicWord has no signal fences, which are all the signal handler on this thread needs.
+    std::atomic_signal_fence(std::memory_order_release);  // NOLINT
+    currentAttribution = &_names;
+}
+
+ScopedAttribution::~ScopedAttribution() {
+    currentAttribution = _previous;
+    std::atomic_signal_fence(std::memory_order_release);  // See the constructor. NOLINT
+}
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+namespace {
+
+constexpr size_t kMaxFrames = 64;
+constexpr size_t kNumSampleSlots = 4096;
+constexpr Milliseconds kDrainPeriod{100};
+
+// Bounds the memory used by the aggregated samples. Samples of the stacks beyond the limit are
+// counted under kOtherStacks.
+constexpr size_t kMaxStacksPerWindow = 10000;
+constexpr size_t kMaxStacksReported = 1000;
+constexpr auto kOtherStacks = "(other)"_sd;
+constexpr auto kNoAttribution = "(none)"_sd;
+
+/**
+ * A sample captured by the signal handler. The handler only claims free slots, and the drainer
+ * only reads ready ones, so the contents of a slot are never accessed concurrently.
+ */
+struct SampleSlot {
+    enum State : int { kFree, kWriting, kReady };
+
+    std::atomic<int> state{kFree};  // NOLINT
+    bool hasNames;
+    ScopedAttribution::Names names;
+    size_t numFrames;
+    std::array<void*, kMaxFrames> frames;
+};
+
+void cpuProfilerSignalAction(int, siginfo_t*, void*);
+
+class Profiler {
+public:
+    /**
+     * Called from the signal handler, so must be async-signal-safe.
+     */
+    void onSignal() {
+        auto slots = _slots.load(std::memory_order_acquire);
+        if (!slots || !_sampling.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        auto& slot = slots[_nextSlot.fetch_add(1, std::memory_order_relaxed) % kNumSampleSlots];
+        int expected = SampleSlot::kFree;
+        if (!slot.state.compare_exchange_strong(
+                expected, SampleSlot::kWriting, std::memory_order_acquire)) {
+            _droppedSamples.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto names = currentAttribution;
+        // Pairs with the signal fences of ScopedAttribution, which AtomicWord does not provide.
+        std::atomic_signal_fence(std::memory_order_acquire);  // NOLINT
+        slot.hasNames = names != nullptr;
+        if (names) {
+            slot.names = *names;
+        }
+        slot.numFrames = rawBacktrace(slot.frames.data(), slot.frames.size());
+        slot.state.store(SampleSlot::kReady, std::memory_order_release);
+    }
+
+    Status start(Microseconds interval) {
+        stdx::lock_guard<Latch> lk(_mutex);
+
+        if (!_slots.load()) {
+            // Never freed, since a signal may still be delivered after the profiler stops.
+            _slots.store(new SampleSlot[kNumSampleSlots]);
+        }
+
+        if (!_signalActionInstalled) {
+            struct sigaction sa {};
+            sigemptyset(&sa.sa_mask);
+            sa.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+            sa.sa_sigaction = cpuProfilerSignalAction;
+            if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+                return Status(ErrorCodes::InternalError,
+                              str::stream() << "Failed to install the SIGPROF handler: "
+                                            << errnoWithDescription());
+            }
+            _signalActionInstalled = true;
+        }
+
+        _sampling.store(true);
+        auto count = durationCount<Microseconds>(interval);
+        struct itimerval timer {};
+        timer.it_interval.tv_sec = count / 1000000;
+        timer.it_interval.tv_usec = count % 1000000;
+        timer.it_value = timer.it_interval;
+        if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+            _sampling.store(_running);
+            return Status(ErrorCodes::InternalError,
+                          str::stream() << "Failed to start the profiling timer: "
+                                        << errnoWithDescription());
+        }
+        _interval = interval;
+
+        if (!_running) {
+            _running = true;
+            _drainer = stdx::thread([this] {
+                setThreadName("CPUProfiler");
+                _drainLoop();
+            });
+        }
+
+        LOGV2(6170427, "Started the CPU profiler", "interval"_attr = interval);
+        return Status::OK();
+    }
+
+    void stop() {
+        stdx::thread drainer;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (!_running) {
+                return;
+            }
+
+            struct itimerval timer {};
+            setitimer(ITIMER_PROF, &timer, nullptr);
+            _sampling.store(false);
+            _running = false;
+            _cv.notify_all();
+            drainer = std::move(_drainer);
+        }
+        drainer.join();
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        _drain(lk);
+        LOGV2(6170428, "Stopped the CPU profiler");
+    }
+
+    bool isRunning() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _running;
+    }
+
+    void appendProfile(BSONObjBuilder* builder) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _drain(lk);
+
+        builder->append("running", _running);
+        if (_running) {
+            builder->append("intervalMicros", durationCount<Microseconds>(_interval));
+        }
+
+        long long samples = 0;
+        stdx::unordered_map<std::string, long long> stacks;
+        for (const auto& window : _windows) {
+            samples += window.samples;
+            for (const auto& [stack, count] : window.stacks) {
+                stacks[stack] += count;
+            }
+        }
+        builder->append("samples", samples);
+        builder->append("droppedSamples",
+                        static_cast<long long>(_droppedSamples.load(std::memory_order_relaxed)));
+        if (!_windows.empty()) {
+            builder->append("since", _windows.front().start);
+        }
+
+        std::vector<std::pair<StringData, long long>> sorted(stacks.begin(), stacks.end());
+        auto numReported = std::min(sorted.size(), kMaxStacksReported);
+        std::partial_sort(sorted.begin(),
+                          sorted.begin() + numReported,
+                          sorted.end(),
+                          [](const auto& a, const auto& b) { return a.second > b.second; });
+
+        BSONArrayBuilder stacksBuilder(builder->subarrayStart("stacks"));
+        for (size_t i = 0; i < numReported; ++i) {
+            BSONObjBuilder stackBuilder(stacksBuilder.subobjStart());
+            stackBuilder.append("stack", sorted[i].first);
+            stackBuilder.append("count", sorted[i].second);
+        }
+    }
+
+    void clear() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _drain(lk);
+        _windows.clear();
+        _droppedSamples.store(0);
+    }
+
+private:
+    struct Window {
+        Date_t start;
+        long long samples = 0;
+        stdx::unordered_map<std::string, long long> stacks;
+    };
+
+    void _drainLoop() {
+        stdx::unique_lock<Latch> lk(_mutex);
+        while (_running) {
+            _cv.wait_for(lk, kDrainPeriod.toSystemDuration(), [&] { return !_running; });
+            _drain(lk);
+        }
+    }
+
+    void _drain(WithLock) {
+        auto slots = _slots.load();
+        if (!slots) {
+            return;
+        }
+
+        for (size_t i = 0; i < kNumSampleSlots; ++i) {
+            auto& slot = slots[i];
+            if (slot.state.load(std::memory_order_acquire) != SampleSlot::kReady) {
+                continue;
+            }
+            _record(_fold(slot));
+            slot.state.store(SampleSlot::kFree, std::memory_order_release);
+        }
+    }
+
+    void _record(std::string stack) {
+        auto now = Date_t::now();
+        if (_windows.empty() || now - _windows.back().start >= kWindowDuration) {
+            _windows.push_back({now});
+            while (_windows.size() > kNumWindows) {
+                _windows.pop_front();
+            }
+        }
+
+        auto& window = _windows.back();
+        ++window.samples;
+        if (window.stacks.size() >= kMaxStacksPerWindow && !window.stacks.count(stack)) {
+            stack = kOtherStacks.toString();
+        }
+        ++window.stacks[stack];
+    }
+
+    std::string _fold(const SampleSlot& slot) {
+        std::string folded;
+        if (slot.hasNames) {
+            folded.append(slot.names.command.data()).append(";");
+            folded.append(slot.names.ns.data());
+        } else {
+            folded.append(kNoAttribution.rawData(), kNoAttribution.size()).append(";");
+            folded.append(kNoAttribution.rawData(), kNoAttribution.size());
+        }
+
+        // Skip the frames of the signal handler, and the signal trampoline that called it.
+        size_t first = 0;
+        for (size_t i = 0; i < slot.numFrames; ++i) {
+            if (_symbolize(slot.frames[i]).isHandler) {
+                first = i + 2;
+                break;
+            }
+        }
+
+        for (size_t i = slot.numFrames; i > first; --i) {
+            folded.append(";").append(_symbolize(slot.frames[i - 1]).name);
+        }
+        return folded;
+    }
+
+    struct Symbol {
+        std::string name;
+        bool isHandler = false;
+    };
+
+    const Symbol& _symbolize(void* address) {
+        auto it = _symbols.find(address);
+        if (it != _symbols.end()) {
+            return it->second;
+        }
+
+        Symbol symbol;
+        const auto& meta = _metaGen.load(address);
+        if (meta.symbol()) {
+            symbol.isHandler =
+                meta.symbol().base() == reinterpret_cast<uintptr_t>(&cpuProfilerSignalAction);
+            int status;
+            char* demangled = abi::__cxa_demangle(
+                meta.symbol().name().toString().c_str(), nullptr, nullptr, &status);
+            if (demangled) {
+                symbol.name = demangled;
+                free(demangled);  // allocated by abi::__cxa_demangle
+            } else {
+                symbol.name = meta.symbol().name().toString();
+            }
+        } else if (meta.file()) {
+            symbol.name = str::stream()
+                << meta.file().name() << "+0x" << unsignedHex(meta.address() - meta.file().base());
+        } else {
+            symbol.name = str::stream() << "0x" << unsignedHex(meta.address());
+        }
+        return _symbols.emplace(address, std::move(symbol)).first->second;
+    }
+
+    // Written by the signal handler.
+    std::atomic<SampleSlot*> _slots{nullptr};  // NOLINT
+    std::atomic<bool> _sampling{false};        // NOLINT
+    std::atomic<uint64_t> _nextSlot{0};        // NOLINT
+    std::atomic<uint64_t> _droppedSamples{0};  // NOLINT
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CPUProfiler::_mutex");
+    stdx::condition_variable _cv;
+    bool _signalActionInstalled = false;
+    bool _running = false;
+    Microseconds _interval;
+    stdx::thread _drainer;
+    std::deque<Window> _windows;
+
+    StackTraceAddressMetadataGenerator _metaGen;
+    stdx::unordered_map<void*, Symbol> _symbols;
+};
+
+Profiler profiler;
+
+MONGO_COMPILER_NOINLINE void cpuProfilerSignalAction(int, siginfo_t*, void*) {
+    auto savedErrno = errno;
+    profiler.onSignal();
+    errno = savedErrno;
+}
+
+}  // namespace
+
+Status start(Microseconds interval) {
+    return profiler.start(interval);
+}
+
+void stop() {
+    profiler.stop();
+}
+
+bool isRunning() {
+    return profiler.isRunning();
+}
+
+void appendProfile(BSONObjBuilder* builder) {
+    profiler.appendProfile(builder);
+}
+
+void clear() {
+    profiler.clear();
+}
+
+#else  // !defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+Status start(Microseconds interval) {
+    return Status(ErrorCodes::IllegalOperation,
+                  "The CPU profiler is not supported on this platform");
+}
+
+void stop() {}
+
+bool isRunning() {
+    return false;
+}
+
+void appendProfile(BSONObjBuilder* builder) {
+    builder->append("running", false);
+}
+
+void clear() {}
+
+#endif  // defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+Status validateSampleInterval(const int& value) {
+    if (value != 0 && (value < kMinSampleInterval.count() || value > kMaxSampleInterval.count())) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "cpuProfilerSampleIntervalMicros must be 0 or between "
+                                    << kMinSampleInterval.count() << " and "
+                                    << kMaxSampleInterval.count());
+    }
+    return Status::OK();
+}
+
+Status onUpdateSampleInterval(const int& value) {
+    if (value == 0) {
+        stop();
+        return Status::OK();
+    }
+    return start(Microseconds(value));
+}
+
+}  // namespace cpu_profiler
+}  // namespace mongo
@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <array>
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A sampling CPU profiler, which attributes its samples to the command that the sampled thread
+ * was running.
+ *
+ * While it runs, the process CPU time interval timer delivers SIGPROF to whichever thread is
+ * using CPU every sampling interval. The signal handler captures the backtrace of that thread,
+ * together with the command and namespace it was running, into a fixed size buffer. A background
+ * thread symbolizes the samples and aggregates them into folded stacks, which are kept for
+ * kNumWindows windows of kWindowDuration.
+ *
+ * Only available where backtraces can be captured from a signal handler, see
+ * MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS.
+ */
+namespace cpu_profiler {
+
+constexpr Seconds kWindowDuration{60};
+constexpr size_t kNumWindows = 10;
+
+constexpr Microseconds kMinSampleInterval{1000};
+constexpr Microseconds kMaxSampleInterval{1000000};
+
+/**
+ * Charges the samples taken on the current thread during the lifetime of this object to
+ * 'command' and 'ns'. Nests: the previous attribution of the thread is restored on destruction.
+ * The names are truncated to fit fixed size buffers, so that the signal handler can copy them.
+ */
+class ScopedAttribution {
+    ScopedAttribution(const ScopedAttribution&) = delete;
+    ScopedAttribution& operator=(const ScopedAttribution&) = delete;
+
+public:
+    struct Names {
+        std::array<char, 48> command{};
+        std::array<char, 128> ns{};
+    };
+
+    ScopedAttribution(StringData command, StringData ns);
+    ~ScopedAttribution();
+
+private:
+    Names _names;
+    const Names* _previous;
+};
+
+/**
+ * Starts sampling every 'interval' of CPU time, or changes the interval if already started.
+ * Returns ErrorCodes::IllegalOperation if the profiler is not available on this platform.
+ */
+Status start(Microseconds interval);
+
+/**
+ * Stops sampling. Keeps the samples already aggregated.
+ */
+void stop();
+
+bool isRunning();
+
+/**
+ * Appends the state of the profiler and the folded stacks of the samples in the retained
+ * windows, with the number of samples of each. A folded stack has the form
+ * "command;namespace;outermostFrame;...;innermostFrame".
+ */
+void appendProfile(BSONObjBuilder* builder);
+
+/**
+ * Drops all aggregated samples.
+ */
+void clear();
+
+/**
+ * Server parameter hooks for cpuProfilerSampleIntervalMicros, where 0 stops the profiler.
+ */
+Status validateSampleInterval(const int& value);
+Status onUpdateSampleInterval(const int& value);
+
+}  // namespace cpu_profiler
+}  // namespace mongo
@@ -132,6 +132,13 @@ public:
         return Decoration<T>(getRegistry()->template declareDecoration<T>());
     }
 
+    /**
+     * Returns the size of the block allocated for the decorations of each instance of D.
+     */
+    static size_t getDecorationBufferSizeBytes() {
+        return getRegistry()->getDecorationBufferSizeBytes();
+    }
+
 protected:
     Decorable() : _decorations(this, getRegistry()) {}
     ~Decorable() = default;
@@ -39,6 +39,7 @@
 #include "mongo/config.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/heap_profiler.h"
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/tcmalloc_parameters_gen.h"
 
@@ -432,6 +433,10 @@ private:
         if (accountedLen == 0)
             return;
 
+        // Attribute the sample, e.g. to the operation running on this thread, before taking the
+        // lock since the observer may allocate.
+        heap_profiler::notifySampleObserver(accountedLen);
+
         // Get backtrace.
         Stack tempStack;
         tempStack.numFrames = rawBacktrace(tempStack.frames.data(), kMaxFramesPerStack);
@@ -0,0 +1,67 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace mongo {
+namespace heap_profiler {
+
+/**
+ * Receives the number of bytes that the sampling heap profiler charges to an allocation it has
+ * sampled. It is called on the allocating thread from within the allocator's hook, so it must not
+ * block, and should avoid allocating memory.
+ */
+using SampleObserver = void (*)(size_t bytes);
+
+namespace detail {
+inline std::atomic<SampleObserver> sampleObserver{nullptr};  // NOLINT
+}  // namespace detail
+
+/**
+ * Installs the observer of sampled allocations, replacing any previous one. Samples are only taken
+ * when the heap profiler was enabled at startup with 'heapProfilingEnabled'.
+ */
+inline void setSampleObserver(SampleObserver observer) {
+    detail::sampleObserver.store(observer);
+}
+
+/**
+ * Hands a sample to the installed observer, if any.
+ */
+inline void notifySampleObserver(size_t bytes) {
+    if (auto observer = detail::sampleObserver.load(std::memory_order_relaxed))
+        observer(bytes);
+}
+
+}  // namespace heap_profiler
+}  // namespace mongo
@@ -35,6 +35,7 @@
 #include <list>
 
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concepts.h"
 
 namespace mongo {
 
@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/ref_counted_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#include "mongo/util/allocator.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+thread_local RefCountedArena* currentArena = nullptr;
+
+// Allocations from a block are carved out of 16-byte aligned slots, each starting with a pointer
+// to its block. The allocation itself therefore starts 8 bytes past a 16-byte boundary, while heap
+// allocations are 16-byte aligned, which tells the two apart without a header on heap allocations.
+constexpr size_t kSlotAlignment = 16;
+constexpr uintptr_t kArenaAllocationBit = 8;
+static_assert(sizeof(void*) == kArenaAllocationBit);
+
+constexpr size_t slotSize(size_t size) {
+    return (sizeof(void*) + size + kSlotAlignment - 1) & ~(kSlotAlignment - 1);
+}
+
+bool isArenaAllocation(void* ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) & kArenaAllocationBit;
+}
+
+}  // namespace
+
+struct alignas(16) RefCountedArena::Block {
+    explicit Block(std::shared_ptr<AtomicWord<long long>> bytesAllocated)
+        : bytesAllocated(std::move(bytesAllocated)) {
+        this->bytesAllocated->fetchAndAdd(kBlockSize);
+    }
+
+    ~Block() {
+        bytesAllocated->fetchAndSubtract(kBlockSize);
+    }
+
+    char* begin() {
+        return reinterpret_cast<char*>(this + 1);
+    }
+
+    // The number of allocations from this block which are alive, plus one while the arena holds
+    // the block.
+    std::atomic<uint32_t> refs{1};  // NOLINT
+    char* next = begin();
+    char* const end = reinterpret_cast<char*>(this) + kBlockSize;
+
+    // The memory accounting of the arena which allocated this block.
+    const std::shared_ptr<AtomicWord<long long>> bytesAllocated;
+};
+
+RefCountedArena::Scope::Scope(RefCountedArena* arena)
+    : _previous(std::exchange(currentArena, arena)) {}
+
+RefCountedArena::Scope::~Scope() {
+    currentArena = _previous;
+}
+
+RefCountedArena::~RefCountedArena() {
+    if (_block) {
+        _releaseBlock(_block);
+    }
+}
+
+void* RefCountedArena::allocate(size_t size) {
+    if (currentArena && size <= kMaxAllocationSize) {
+        return currentArena->_allocate(size);
+    }
+
+    // The heap returns 16-byte aligned memory for allocations of at least 16 bytes.
+    void* ptr = mongoMalloc(std::max(size, kSlotAlignment));
+    invariant(!isArenaAllocation(ptr));
+    return ptr;
+}
+
+void RefCountedArena::release(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    if (isArenaAllocation(ptr)) {
+        _releaseBlock(*(static_cast<Block**>(ptr) - 1));
+    } else {
+        std::free(ptr);
+    }
+}
+
+void* RefCountedArena::_allocate(size_t size) {
+    const size_t bytesNeeded = slotSize(size);
+    if (!_block || static_cast<size_t>(_block->end - _block->next) < bytesNeeded) {
+        // Acquire pairs with the release in _releaseBlock(), so that nobody is still using the
+        // memory of the block when it is reused.
+        if (_block && _block->refs.load(std::memory_order_acquire) == 1) {
+            _block->next = _block->begin();
+        } else {
+            if (_block) {
+                _releaseBlock(_block);
+            }
+            _block = new (mongoMalloc(kBlockSize)) Block(_bytesAllocated);
+            ++_numBlocksAllocated;
+        }
+    }
+
+    auto slot = reinterpret_cast<Block**>(_block->next);
+    _block->next += bytesNeeded;
+    _block->refs.fetch_add(1, std::memory_order_relaxed);
+    *slot = _block;
+    return slot + 1;
+}
+
+void RefCountedArena::_releaseBlock(Block* block) {
+    if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        block->~Block();
+        std::free(block);
+    }
+}
+
+}  // namespace mongo
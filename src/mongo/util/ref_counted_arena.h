@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+/**
+ * A monotonic arena for the small, short-lived, reference-counted objects which are created in
+ * large numbers while processing documents, such as the storage of Documents and RCStrings.
+ *
+ * Allocations are carved out of fixed-size blocks by bumping a pointer. Each block counts the
+ * allocations from it which are still alive, and is freed once all of them have been released and
+ * the arena has moved on to another block. When the arena runs out of room in its current block
+ * and every allocation from that block has already been released, it reuses the block from the
+ * start. This way, a pipeline which releases its documents as it streams them keeps reusing the
+ * same memory, while any object which outlives its batch simply keeps its block alive.
+ *
+ * Objects opt in by allocating with allocate() and freeing with release(). These allocate from
+ * the arena installed on the current thread by a Scope, or from the heap if there is none, so an
+ * object allocated within a Scope may be released on any thread, after the arena is gone. Only
+ * allocations from an arena are preceded by a pointer to their block; heap allocations are plain
+ * mongoMalloc() allocations.
+ *
+ * An arena may only be used by one thread at a time.
+ */
+class RefCountedArena {
+    RefCountedArena(const RefCountedArena&) = delete;
+    RefCountedArena& operator=(const RefCountedArena&) = delete;
+
+public:
+    // The size of each block of the arena.
+    static constexpr size_t kBlockSize = 32 * 1024;
+
+    // Larger allocations come from the heap, so that one long-lived object cannot pin much memory.
+    static constexpr size_t kMaxAllocationSize = 2 * 1024;
+
+    /**
+     * Installs an arena as the one the current thread allocates from, for the lifetime of the
+     * Scope.
+     */
+    class Scope {
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    public:
+        explicit Scope(RefCountedArena* arena);
+        ~Scope();
+
+    private:
+        RefCountedArena* _previous;
+    };
+
+    RefCountedArena() = default;
+    ~RefCountedArena();
+
+    /**
+     * Returns 'size' bytes of memory aligned to 8 bytes, which must be freed with release().
+     */
+    static void* allocate(size_t size);
+
+    /**
+     * Frees memory returned by allocate(). Does nothing if 'ptr' is null.
+     */
+    static void release(void* ptr);
+
+    /**
+     * Returns the number of blocks this arena has allocated.
+     */
+    size_t numBlocksAllocated() const {
+        return _numBlocksAllocated;
+    }
+
+    /**
+     * Returns the memory held by the blocks of this arena, including the blocks which are only
+     * kept alive by allocations that outlived their batch.
+     */
+    long long bytesAllocated() const {
+        return _bytesAllocated->load();
+    }
+
+private:
+    struct Block;
+
+    static void _releaseBlock(Block* block);
+
+    void* _allocate(size_t size);
+
+    // The block allocations are currently carved out of. The arena holds a reference to it.
+    Block* _block = nullptr;
+
+    size_t _numBlocksAllocated = 0;
+
+    // Shared with the blocks, which may be freed after the arena is gone.
+    std::shared_ptr<AtomicWord<long long>> _bytesAllocated =
+        std::make_shared<AtomicWord<long long>>(0);
+};
+
+}  // namespace mongo
@@ -0,0 +1,160 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <cstring>
+#include <vector>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/allocator.h"
+#include "mongo/util/intrusive_counter.h"
+#include "mongo/util/ref_counted_arena.h"
+
+namespace mongo {
+namespace {
+
+bool isAligned(void* ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) % 8 == 0;
+}
+
+TEST(RefCountedArenaTest, AllocatesFromHeapWithoutScope) {
+    RefCountedArena arena;
+    void* ptr = RefCountedArena::allocate(10);
+    ASSERT(isAligned(ptr));
+    RefCountedArena::release(ptr);
+    ASSERT_EQ(arena.numBlocksAllocated(), 0U);
+    ASSERT_EQ(arena.bytesAllocated(), 0);
+}
+
+TEST(RefCountedArenaTest, HeapAllocationsHaveNoHeader) {
+    // Memory from the heap can be released as if it had come from allocate() without a Scope.
+    RefCountedArena::release(mongoMalloc(100));
+}
+
+TEST(RefCountedArenaTest, AllocatesFromArenaInScope) {
+    RefCountedArena arena;
+    std::vector<void*> ptrs;
+    {
+        RefCountedArena::Scope scope(&arena);
+        for (size_t size : {1, 15, 16, 100}) {
+            ptrs.push_back(RefCountedArena::allocate(size));
+            ASSERT(isAligned(ptrs.back()));
+            std::memset(ptrs.back(), 'x', size);
+        }
+    }
+    ASSERT_EQ(arena.numBlocksAllocated(), 1U);
+    ASSERT_EQ(arena.bytesAllocated(), static_cast<long long>(RefCountedArena::kBlockSize));
+
+    // Memory allocated in the scope can be released outside of it.
+    for (void* ptr : ptrs) {
+        RefCountedArena::release(ptr);
+    }
+}
+
+TEST(RefCountedArenaTest, LargeAllocationsComeFromHeap) {
+    RefCountedArena arena;
+    RefCountedArena::Scope scope(&arena);
+    RefCountedArena::release(RefCountedArena::allocate(RefCountedArena::kMaxAllocationSize + 1));
+    ASSERT_EQ(arena.numBlocksAllocated(), 0U);
+}
+
+TEST(RefCountedArenaTest, ReusesBlockOnceAllocationsAreReleased) {
+    RefCountedArena arena;
+    RefCountedArena::Scope scope(&arena);
+    for (size_t i = 0; i < 10 * RefCountedArena::kBlockSize / 64; ++i) {
+        RefCountedArena::release(RefCountedArena::allocate(48));
+    }
+    ASSERT_EQ(arena.numBlocksAllocated(), 1U);
+}
+
+TEST(RefCountedArenaTest, LiveAllocationKeepsBlockAlive) {
+    void* live;
+    {
+        RefCountedArena arena;
+        RefCountedArena::Scope scope(&arena);
+        live = RefCountedArena::allocate(8);
+        std::memset(live, 'x', 8);
+        for (size_t i = 0; i < 2 * RefCountedArena::kBlockSize / 64; ++i) {
+            RefCountedArena::release(RefCountedArena::allocate(48));
+        }
+        ASSERT_EQ(arena.numBlocksAllocated(), 2U);
+    }
+
+    // The block outlives the arena until its last allocation is released.
+    ASSERT_EQ(static_cast<char*>(live)[7], 'x');
+    RefCountedArena::release(live);
+}
+
+TEST(RefCountedArenaTest, CountsBlocksPinnedByLiveAllocations) {
+    RefCountedArena arena;
+    std::vector<void*> live;
+    {
+        RefCountedArena::Scope scope(&arena);
+        for (size_t i = 0; i < 3 * RefCountedArena::kBlockSize / 64; ++i) {
+            live.push_back(RefCountedArena::allocate(48));
+        }
+    }
+    ASSERT_EQ(arena.bytesAllocated(),
+              static_cast<long long>(arena.numBlocksAllocated() * RefCountedArena::kBlockSize));
+
+    // Only the block the arena still holds remains once all the allocations are released.
+    for (void* ptr : live) {
+        RefCountedArena::release(ptr);
+    }
+    ASSERT_EQ(arena.bytesAllocated(), static_cast<long long>(RefCountedArena::kBlockSize));
+}
+
+TEST(RefCountedArenaTest, ScopesNest) {
+    RefCountedArena outer;
+    RefCountedArena inner;
+    RefCountedArena::Scope outerScope(&outer);
+    {
+        RefCountedArena::Scope innerScope(&inner);
+        RefCountedArena::release(RefCountedArena::allocate(8));
+    }
+    RefCountedArena::release(RefCountedArena::allocate(8));
+    ASSERT_EQ(inner.numBlocksAllocated(), 1U);
+    ASSERT_EQ(outer.numBlocksAllocated(), 1U);
+}
+
+TEST(RefCountedArenaTest, RCStringUsesArena) {
+    RefCountedArena arena;
+    boost::intrusive_ptr<const RCString> str;
+    {
+        RefCountedArena::Scope scope(&arena);
+        str = RCString::create("abc");
+    }
+    ASSERT_EQ(arena.numBlocksAllocated(), 1U);
+    ASSERT_EQ(str->stringData(), "abc"_sd);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -31,10 +31,30 @@
 #include "mongo/util/regex_util.h"
 
 #include "mongo/base/error_codes.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 namespace regex_util {
+namespace {
+// Enough for the distinct patterns of a busy workload, while bounding the memory held by compiled
+// patterns that are no longer in use.
+constexpr size_t kMaxCachedPatterns = 1000;
+
+struct CompiledPatternCache {
+    Mutex mutex = MONGO_MAKE_LATCH("CompiledPatternCache::mutex");
+    LRUCache<std::string, std::shared_ptr<const pcre>> patterns{kMaxCachedPatterns};
+};
+
+// Patterns may be compiled during static initialization, so the cache is constructed on first use.
+CompiledPatternCache& getCompiledPatternCache() {
+    static StaticImmortal<CompiledPatternCache> cache;
+    return *cache;
+}
+}  // namespace
+
 pcrecpp::RE_Options flagsToPcreOptions(StringData optionFlags, StringData opName) {
     pcrecpp::RE_Options opt;
     opt.set_utf8(true);
@@ -64,5 +84,34 @@ pcrecpp::RE_Options flagsToPcreOptions(StringData optionFlags, StringData opName
     }
     return opt;
 }
+
+std::shared_ptr<const pcre> compilePattern(const std::string& pattern,
+                                           int options,
+                                           const char** errorOut) {
+    // PCRE stops reading the pattern at the first NUL byte, so the options can follow it.
+    std::string key = str::stream() << pattern.c_str() << '\0' << options;
+    auto& cache = getCompiledPatternCache();
+    {
+        stdx::lock_guard<Latch> lk(cache.mutex);
+        auto it = cache.patterns.find(key);
+        if (it != cache.patterns.end()) {
+            return it->second;
+        }
+    }
+
+    // Compile outside of the mutex, as compiling can be expensive. Threads racing to compile the
+    // same pattern each produce an equivalent result.
+    int errorOffset;
+    std::shared_ptr<const pcre> compiled(
+        pcre_compile(pattern.c_str(), options, errorOut, &errorOffset, nullptr),
+        [](const pcre* re) { (*pcre_free)(const_cast<pcre*>(re)); });
+    if (!compiled) {
+        return nullptr;
+    }
+
+    stdx::lock_guard<Latch> lk(cache.mutex);
+    cache.patterns.add(std::move(key), compiled);
+    return compiled;
+}
 }  // namespace regex_util
 }  // namespace mongo
@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include <memory>
 #include <pcrecpp.h>
+#include <string>
 
 #include "mongo/base/string_data.h"
 
@@ -40,5 +42,17 @@ namespace regex_util {
  * throws uassert on invalid flags.
  */
 pcrecpp::RE_Options flagsToPcreOptions(StringData optionFlags, StringData opName = "");
+
+/**
+ * Returns 'pattern' compiled with the PCRE compile-time 'options'. Compiled patterns are shared
+ * through a bounded, process-wide cache of the most recently used (pattern, options) pairs, so that
+ * queries and expressions which repeatedly use the same pattern only compile it once. On failure,
+ * returns nullptr and sets 'errorOut' to PCRE's static description of the error.
+ *
+ * The returned pattern may be used concurrently by several threads.
+ */
+std::shared_ptr<const pcre> compilePattern(const std::string& pattern,
+                                           int options,
+                                           const char** errorOut);
 }  // namespace regex_util
 }  // namespace mongo
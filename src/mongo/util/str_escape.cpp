@@ -33,10 +33,42 @@
 #include <array>
 #include <iterator>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "mongo/platform/bits.h"
+
 namespace mongo::str {
 namespace {
 constexpr char kHexChar[] = "0123456789abcdef";
 
+// Returns the number of bytes at the beginning of [it, end) that are printable ASCII other than a
+// backslash or double quote. Such bytes are never escaped by any of the escapers, so they can be
+// skipped without dispatching on each of them. Only whole 16-byte blocks are examined, the
+// remaining bytes are left to the byte-wise loop.
+inline size_t countUnescapedPrefix(const char* it, const char* end) {
+    size_t count = 0;
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i del = _mm_set1_epi8(0x7f);
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i quote = _mm_set1_epi8('"');
+    while (end - it >= 16) {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+        // Signed comparison, so bytes with the high bit set (non-ASCII) count as special too.
+        auto special = _mm_or_si128(
+            _mm_or_si128(_mm_cmplt_epi8(block, space), _mm_cmpeq_epi8(block, del)),
+            _mm_or_si128(_mm_cmpeq_epi8(block, backslash), _mm_cmpeq_epi8(block, quote)));
+        if (uint32_t mask = _mm_movemask_epi8(special))
+            return count + countTrailingZeros64(mask);
+        it += 16;
+        count += 16;
+    }
+#endif
+    return count;
+}
+
 // 'singleHandler' Function to write a valid single byte UTF-8 sequence with desired escaping.
 // 'invalidByteHandler' Function to write a byte of invalid UTF-8 encoding
 // 'twoEscaper' Function to write a valid two byte UTF-8 sequence with desired escaping, for C1
@@ -61,6 +93,9 @@ void escape(fmt::memory_buffer& buffer,
     auto it = str.begin();
     auto end = str.end();
 
+    // Most input is written unmodified, so size the output once up front.
+    buffer.reserve(buffer.size() + str.size());
+
     // Writes an escaped sequence to output after flushing pending input that does not need to be
     // escaped. 'it' is assumed to be at the beginning of the input sequence represented by the
     // escaped data.
@@ -99,6 +134,10 @@ void escape(fmt::memory_buffer& buffer,
 
 
     while (it != end) {
+        it += countUnescapedPrefix(it, end);
+        if (it == end)
+            break;
+
         uint8_t c = *it;
         bool bit7 = (c >> 7) & 1;
         if (MONGO_likely(!bit7)) {
@@ -33,9 +33,73 @@
 
 #include <cmath>
 
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
+template <typename Integer>
+size_t DoubleDoubleSummation::_addIntegersExactly(const Integer* x, size_t count) {
+    // This also rejects NaNs, as they never compare equal to _special.
+    if (_addend != 0.0 || _special != _sum || std::trunc(_sum) != _sum ||
+        std::abs(_sum) > kExactIntegerSumLimit)
+        return 0;
+
+    long long sum = static_cast<long long>(_sum);
+    size_t i = 0;
+    for (; i < count; ++i) {
+        long long next;
+        if (overflow::add(sum, static_cast<long long>(x[i]), &next) ||
+            next > kExactIntegerSumLimit || next < -kExactIntegerSumLimit)
+            break;
+        sum = next;
+    }
+
+    // Every compensated step would have been exact, so the error term would have ended up as a
+    // positive zero and the simple sum would match the rounded one.
+    if (i > 0) {
+        _sum = static_cast<double>(sum);
+        _addend = 0.0;
+        _special = _sum;
+    }
+    return i;
+}
+
+void DoubleDoubleSummation::addDoubles(const double* x, size_t count) {
+    // Same steps as addDouble(), with the state held in locals: stores to the members could alias
+    // 'x', which would otherwise force a reload of the state for every value.
+    double sum = _sum;
+    double addend = _addend;
+    double special = _special;
+    for (size_t i = 0; i < count; ++i) {
+        double value = x[i];
+        special += value;
+        std::tie(value, addend) = _fast2Sum(value, addend);
+        std::tie(sum, value) = _2Sum(sum, value);
+        addend += value;
+    }
+    _sum = sum;
+    _addend = addend;
+    _special = special;
+}
+
+void DoubleDoubleSummation::addLongs(const long long* x, size_t count) {
+    size_t i = 0;
+    while (i < count) {
+        i += _addIntegersExactly(x + i, count - i);
+        if (i < count)
+            addLong(x[i++]);
+    }
+}
+
+void DoubleDoubleSummation::addInts(const int* x, size_t count) {
+    size_t i = 0;
+    while (i < count) {
+        i += _addIntegersExactly(x + i, count - i);
+        if (i < count)
+            addInt(x[i++]);
+    }
+}
+
 void DoubleDoubleSummation::addLong(long long x) {
     // Split 64-bit integers into two doubles, so the sum remains exact.
     int64_t high = x / (1ll << 32) * (1ll << 32);
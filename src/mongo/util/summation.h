@@ -80,6 +80,16 @@ public:
         addDouble(x);
     }
 
+    /**
+     * Batch variants of addDouble(), addLong() and addInt(): the result is bit-for-bit the same as
+     * adding each of the 'count' values at 'x' in order. Integers are summed exactly in 64-bit
+     * arithmetic for as long as the running sum is small enough that every double-double step
+     * would have been exact, falling back to the compensated path otherwise.
+     */
+    void addDoubles(const double* x, size_t count);
+    void addLongs(const long long* x, size_t count);
+    void addInts(const int* x, size_t count);
+
     /**
      * Returns the double nearest to the accumulated sum.
      */
@@ -123,6 +133,20 @@ public:
     long long getLong() const;
 
 private:
+    /**
+     * Largest magnitude of the running sum for which the integer fast path of addLongs() and
+     * addInts() is used. Below it, each step of addLong() is exact, leaving a zero _addend, and
+     * the low half of a long added first cannot carry the sum past 2**53.
+     */
+    static constexpr long long kExactIntegerSumLimit = 1LL << 52;
+
+    /**
+     * Adds integers to the sum exactly while it stays within kExactIntegerSumLimit, returning the
+     * number of values consumed. Consumes nothing unless the sum is currently an exact integer.
+     */
+    template <typename Integer>
+    size_t _addIntegersExactly(const Integer* x, size_t count);
+
     /**
      * Assuming |b| <= |a|, returns exact unevaluated sum of a and b, where the first member is the
      * double nearest the sum (ties to even) and the second member is the remainder.
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include <cmath>
+#include <cstring>
 #include <limits>
 #include <vector>
 
@@ -98,6 +99,17 @@ std::vector<double> specialValues = {-std::numeric_limits<double>::infinity(),
                                      std::numeric_limits<double>::infinity(),
                                      std::numeric_limits<double>::quiet_NaN()};
 
+/**
+ * Checks that both sums have exactly the same representation, including the signs of zeros.
+ */
+void assertIdenticalSums(const DoubleDoubleSummation& expected,
+                         const DoubleDoubleSummation& actual) {
+    auto expectedParts = expected.getDoubleDouble();
+    auto actualParts = actual.getDoubleDouble();
+    ASSERT_EQ(std::memcmp(&expectedParts.first, &actualParts.first, sizeof(double)), 0);
+    ASSERT_EQ(std::memcmp(&expectedParts.second, &actualParts.second, sizeof(double)), 0);
+    ASSERT_EQ(expected.getDecimal().toString(), actual.getDecimal().toString());
+}
 }  // namespace
 
 TEST(Summation, AddLongs) {
@@ -205,6 +217,70 @@ TEST(Summation, AddDoubles) {
     ASSERT(straightSum != sum.getDouble());
 }
 
+TEST(Summation, BatchAddLongsMatchesAddLong) {
+    // Exercise the integer fast path on its own, around its limit, and after a fractional or
+    // overflowing sum has forced the compensated path.
+    std::vector<std::vector<long long>> batches = {
+        longValues,
+        {1, 2, 3, -4, 5},
+        {(1LL << 52) - 2, 1, 1, 1, -3, -1},
+        {-(1LL << 52) + 1, -1, -1, 2},
+        {limits::max(), limits::max(), -limits::max(), 7}};
+    for (double start : {0.0, -0.0, 0.5, 1e300}) {
+        for (auto&& batch : batches) {
+            DoubleDoubleSummation expected;
+            DoubleDoubleSummation actual;
+            expected.addDouble(start);
+            actual.addDouble(start);
+
+            for (auto x : batch) {
+                expected.addLong(x);
+            }
+            actual.addLongs(batch.data(), batch.size());
+            assertIdenticalSums(expected, actual);
+        }
+    }
+}
+
+TEST(Summation, BatchAddIntsMatchesAddInt) {
+    std::vector<int> batch;
+    for (auto x : longValues) {
+        batch.push_back(static_cast<int>(x));
+    }
+    batch.push_back(std::numeric_limits<int>::max());
+    batch.push_back(std::numeric_limits<int>::min());
+
+    for (double start : {0.0, 0.25, static_cast<double>(1LL << 52)}) {
+        DoubleDoubleSummation expected;
+        DoubleDoubleSummation actual;
+        expected.addDouble(start);
+        actual.addDouble(start);
+
+        for (auto x : batch) {
+            expected.addInt(x);
+        }
+        actual.addInts(batch.data(), batch.size());
+        assertIdenticalSums(expected, actual);
+    }
+}
+
+TEST(Summation, BatchAddDoublesMatchesAddDouble) {
+    DoubleDoubleSummation expected;
+    DoubleDoubleSummation actual;
+    expected.addLong(42);
+    actual.addLong(42);
+
+    for (auto x : doubleValues) {
+        expected.addDouble(x);
+    }
+    actual.addDoubles(doubleValues.data(), doubleValues.size());
+    assertIdenticalSums(expected, actual);
+    ASSERT_EQUALS(actual.getDouble(), doubleValuesSum + 42);
+
+    actual.addDoubles(specialValues.data(), specialValues.size());
+    ASSERT(std::isnan(actual.getDouble()));
+}
+
 TEST(Summation, ConvertInfinityToDecimal) {
     constexpr double infinity = std::numeric_limits<double>::infinity();
     DoubleDoubleSummation sum;